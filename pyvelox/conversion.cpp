@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <pybind11/numpy.h>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,160 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+// Keeps the Python object that owns the memory of a BufferView alive until
+// the last copy of the releaser is destroyed. Dropping the Python reference
+// requires the GIL, which Velox may not hold when it frees the buffer.
+class PyObjectReleaser {
+ public:
+  explicit PyObjectReleaser(py::object owner)
+      : owner_(new py::object(std::move(owner)), [](py::object* object) {
+          py::gil_scoped_acquire gil;
+          delete object;
+        }) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  std::shared_ptr<py::object> owner_;
+};
+
+// Wraps the values of a 1-dimensional NumPy array in a FlatVector without
+// copying. Non-contiguous arrays are made contiguous first.
+template <typename T>
+VectorPtr numpyToFlatVector(
+    const py::array& input,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  auto array = py::array_t<T, py::array::c_style>::ensure(input);
+  if (!array) {
+    throw py::type_error("Cannot convert the array to a contiguous array");
+  }
+  if (array.ndim() != 1) {
+    throw py::value_error("Only 1-dimensional arrays can be converted");
+  }
+  const auto size = array.size();
+  auto values = BufferView<PyObjectReleaser>::create(
+      reinterpret_cast<const uint8_t*>(array.data()),
+      array.nbytes(),
+      PyObjectReleaser(array));
+  return std::make_shared<FlatVector<T>>(
+      pool,
+      type,
+      nullptr,
+      size,
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+// NumPy stores one byte per bool while Velox packs them in bits, so booleans
+// are copied.
+VectorPtr numpyToBoolVector(const py::array& input, memory::MemoryPool* pool) {
+  auto array = py::array_t<bool, py::array::c_style>::ensure(input);
+  if (!array) {
+    throw py::type_error("Cannot convert the array to a contiguous array");
+  }
+  if (array.ndim() != 1) {
+    throw py::value_error("Only 1-dimensional arrays can be converted");
+  }
+  auto result = BaseVector::create<FlatVector<bool>>(
+      BOOLEAN(), array.size(), pool);
+  auto* rawValues = result->mutableRawValues<uint64_t>();
+  const auto* data = array.data();
+  for (auto i = 0; i < array.size(); ++i) {
+    bits::setBit(rawValues, i, data[i]);
+  }
+  return result;
+}
+
+VectorPtr numpyToVector(const py::array& array, memory::MemoryPool* pool) {
+  const auto dtype = array.dtype();
+  switch (dtype.kind()) {
+    case 'b':
+      return numpyToBoolVector(array, pool);
+    case 'i':
+      switch (dtype.itemsize()) {
+        case 1:
+          return numpyToFlatVector<int8_t>(array, TINYINT(), pool);
+        case 2:
+          return numpyToFlatVector<int16_t>(array, SMALLINT(), pool);
+        case 4:
+          return numpyToFlatVector<int32_t>(array, INTEGER(), pool);
+        case 8:
+          return numpyToFlatVector<int64_t>(array, BIGINT(), pool);
+      }
+      break;
+    case 'f':
+      switch (dtype.itemsize()) {
+        case 4:
+          return numpyToFlatVector<float>(array, REAL(), pool);
+        case 8:
+          return numpyToFlatVector<double>(array, DOUBLE(), pool);
+      }
+      break;
+  }
+  throw py::type_error(
+      "Unsupported NumPy dtype: " + py::str(dtype).cast<std::string>());
+}
+
+// Returns a read-only NumPy array over the values of a flat vector without
+// nulls. The array keeps the vector alive. Other encodings are flattened
+// first.
+template <TypeKind Kind>
+py::object vectorToNumpy(const VectorPtr& input) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto vector = BaseVector::loadedVectorShared(input);
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    auto flat =
+        BaseVector::create(vector->type(), vector->size(), vector->pool());
+    flat->copy(vector.get(), 0, 0, vector->size());
+    vector = std::move(flat);
+  }
+  auto* flat = vector->asFlatVector<T>();
+  if (flat->mayHaveNulls() &&
+      BaseVector::countNulls(flat->nulls(), flat->size()) > 0) {
+    throw py::value_error(
+        "Vectors with nulls cannot be converted to NumPy, "
+        "use export_to_arrow instead");
+  }
+  const auto* rawValues = flat->rawValues();
+  auto* owner = new VectorPtr(std::move(vector));
+  py::capsule base(owner, [](void* vector) {
+    delete reinterpret_cast<VectorPtr*>(vector);
+  });
+  py::array_t<T> result(
+      {static_cast<py::ssize_t>((*owner)->size())},
+      {static_cast<py::ssize_t>(sizeof(T))},
+      rawValues,
+      base);
+  result.attr("setflags")(py::arg("write") = false);
+  return std::move(result);
+}
+
+py::object toNumpy(const VectorPtr& vector) {
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      return vectorToNumpy<TypeKind::TINYINT>(vector);
+    case TypeKind::SMALLINT:
+      return vectorToNumpy<TypeKind::SMALLINT>(vector);
+    case TypeKind::INTEGER:
+      return vectorToNumpy<TypeKind::INTEGER>(vector);
+    case TypeKind::BIGINT:
+      return vectorToNumpy<TypeKind::BIGINT>(vector);
+    case TypeKind::REAL:
+      return vectorToNumpy<TypeKind::REAL>(vector);
+    case TypeKind::DOUBLE:
+      return vectorToNumpy<TypeKind::DOUBLE>(vector);
+    default:
+      throw py::type_error(
+          "Unsupported type for NumPy conversion: " +
+          vector->type()->toString());
+  }
+}
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +204,22 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def(
+      "from_numpy",
+      [](const py::array& array) {
+        return numpyToVector(
+            array, PyVeloxContext::getSingletonInstance().pool());
+      },
+      "Wraps a 1-dimensional numeric NumPy array in a flat vector. The "
+      "values are not copied, except for booleans.",
+      py::arg("array"));
+
+  m.def(
+      "to_numpy",
+      [](const VectorPtr& vector) { return toNumpy(vector); },
+      "Returns a read-only NumPy array over the values of a numeric vector "
+      "without nulls. Flat vectors are not copied.",
+      py::arg("vector"));
 }
 } // namespace facebook::velox::py
@@ -234,6 +234,48 @@ static VectorPtr evaluateExpression(
   return result[0];
 }
 
+namespace {
+// Expressions compiled once for an input type and evaluated over many
+// batches. Expression.evaluate compiles on every call, which dominates the
+// run time when data arrives in batches.
+struct CompiledExpressions {
+  RowTypePtr inputType;
+  std::shared_ptr<exec::ExprSet> exprSet;
+
+  std::vector<VectorPtr> evaluate(const RowVectorPtr& input) const {
+    if (!input->type()->equivalent(*inputType)) {
+      throw py::type_error(
+          "Expected a batch of type " + inputType->toString() + ", got " +
+          input->type()->toString());
+    }
+    auto* execCtx = PyVeloxContext::getSingletonInstance().execCtx();
+    exec::EvalCtx evalCtx(execCtx, exprSet.get(), input.get());
+    SelectivityVector rows(input->size());
+    std::vector<VectorPtr> result;
+    exprSet->eval(rows, evalCtx, result);
+    return result;
+  }
+};
+
+// Python iterator that pulls RowVectors from 'input' one at a time and
+// returns the results of evaluating 'expressions' over each.
+struct BatchIterator {
+  CompiledExpressions expressions;
+  py::object input;
+
+  std::vector<VectorPtr> next() {
+    auto batch = py::reinterpret_steal<py::object>(PyIter_Next(input.ptr()));
+    if (!batch) {
+      if (PyErr_Occurred()) {
+        throw py::error_already_set();
+      }
+      throw py::stop_iteration();
+    }
+    return expressions.evaluate(batch.cast<RowVectorPtr>());
+  }
+};
+} // namespace
+
 static void addExpressionBindings(
     py::module& m,
     bool asModuleLocalDefinitions) {
@@ -294,6 +336,50 @@ static void addExpressionBindings(
         parse::ParseOptions opts;
         return IExprWrapper{parse::parseExpr(str, opts)};
       });
+
+  py::class_<CompiledExpressions>(
+      m, "CompiledExpressions", py::module_local(asModuleLocalDefinitions))
+      .def(
+          "evaluate",
+          &CompiledExpressions::evaluate,
+          "Evaluates the expressions over a RowVector of the input type",
+          py::arg("batch"))
+      .def(
+          "evaluate_batches",
+          [](const CompiledExpressions& expressions,
+             const py::iterable& batches) {
+            return BatchIterator{expressions, py::iter(batches)};
+          },
+          "Returns an iterator over the results of evaluating the "
+          "expressions over each RowVector of 'batches'. Batches are pulled "
+          "one at a time.",
+          py::arg("batches"));
+
+  py::class_<BatchIterator>(
+      m, "BatchIterator", py::module_local(asModuleLocalDefinitions))
+      .def("__iter__", [](BatchIterator& it) -> BatchIterator& { return it; })
+      .def("__next__", &BatchIterator::next);
+
+  m.def(
+      "compile",
+      [](const std::vector<IExprWrapper>& exprs,
+         const std::shared_ptr<RowType>& inputType) {
+        auto* pool = PyVeloxContext::getSingletonInstance().pool();
+        std::vector<core::TypedExprPtr> typedExprs;
+        typedExprs.reserve(exprs.size());
+        for (const auto& expr : exprs) {
+          typedExprs.push_back(
+              core::Expressions::inferTypes(expr.expr, inputType, pool));
+        }
+        return CompiledExpressions{
+            inputType,
+            std::make_shared<exec::ExprSet>(
+                std::move(typedExprs),
+                PyVeloxContext::getSingletonInstance().execCtx())};
+      },
+      "Compiles expressions once for batches of 'input_type'",
+      py::arg("expressions"),
+      py::arg("input_type"));
 }
 
 #ifdef CREATE_PYVELOX_MODULE
@@ -125,3 +125,30 @@ class TestVeloxExpression(unittest.TestCase):
         self.assertEqual(b[3], "many")
         self.assertEqual(b[4], "many")
         self.assertEqual(b[5], "one")
+
+    def test_evaluate_batches(self):
+        exprs = [
+            pv.Expression.from_string("a + b"),
+            pv.Expression.from_string("a * 2"),
+        ]
+        input_type = pv.RowType(["a", "b"], [pv.BigintType(), pv.BigintType()])
+        compiled = pv.compile(exprs, input_type)
+
+        def batches():
+            for i in range(3):
+                yield pv.row_vector(
+                    ["a", "b"],
+                    [pv.from_list([i, i + 1]), pv.from_list([10, 20])],
+                )
+
+        results = list(compiled.evaluate_batches(batches()))
+        self.assertEqual(len(results), 3)
+        for i, result in enumerate(results):
+            self.assertEqual(len(result), 2)
+            self.assertEqual(result[0][0], i + 10)
+            self.assertEqual(result[0][1], i + 21)
+            self.assertEqual(result[1][0], i * 2)
+            self.assertEqual(result[1][1], (i + 1) * 2)
+
+        with self.assertRaises(TypeError):
+            compiled.evaluate(pv.row_vector(["a"], [pv.from_list([1, 2])]))
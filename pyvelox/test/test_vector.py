@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -392,6 +393,59 @@ class TestVeloxVector(unittest.TestCase):
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
 
+    def test_from_numpy(self):
+        test_cases = [
+            (np.array([1, 2, 3], dtype=np.int8), pv.TypeKind.TINYINT),
+            (np.array([1, 2, 3], dtype=np.int16), pv.TypeKind.SMALLINT),
+            (np.array([1, 2, 3], dtype=np.int32), pv.TypeKind.INTEGER),
+            (np.array([1, 2, 3], dtype=np.int64), pv.TypeKind.BIGINT),
+            (np.array([0.5, 1.5], dtype=np.float32), pv.TypeKind.REAL),
+            (np.array([0.5, 1.5], dtype=np.float64), pv.TypeKind.DOUBLE),
+            (np.array([True, False, True]), pv.TypeKind.BOOLEAN),
+        ]
+        for array, expected_kind in test_cases:
+            with self.subTest(array=array):
+                vector = pv.from_numpy(array)
+                self.assertEqual(vector.typeKind(), expected_kind)
+                self.assertEqual(vector.size(), len(array))
+                for i in range(0, len(array)):
+                    self.assertEqual(vector[i], array[i])
+
+        # Strided arrays are made contiguous.
+        vector = pv.from_numpy(np.arange(10, dtype=np.int64)[::2])
+        self.assertEqual([vector[i] for i in range(5)], [0, 2, 4, 6, 8])
+
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.zeros((2, 2), dtype=np.int64))
+        with self.assertRaises(TypeError):
+            pv.from_numpy(np.array([1, 2], dtype=np.uint32))
+
+    def test_numpy_zero_copy(self):
+        array = np.arange(1000, dtype=np.int64)
+        vector = pv.from_numpy(array)
+        # The vector shares the memory of the array.
+        array[0] = 17
+        self.assertEqual(vector[0], 17)
+
+        # The array outlives its vector, and the other way around.
+        result = pv.to_numpy(vector)
+        del vector
+        del array
+        self.assertEqual(result[0], 17)
+        self.assertEqual(result[999], 999)
+        self.assertFalse(result.flags.writeable)
+
+    def test_to_numpy(self):
+        vector = pv.from_list([1.5, 2.5, 3.5])
+        np.testing.assert_array_equal(pv.to_numpy(vector), np.array([1.5, 2.5, 3.5]))
+        np.testing.assert_array_equal(
+            pv.to_numpy(pv.constant_vector(7, 3)), np.array([7, 7, 7])
+        )
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.from_list([1, None]))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.from_list(["a", "b"]))
+
     def test_row_vector_basic(self):
         vals = [
             pv.from_list([1, 2, 3]),
@@ -183,8 +183,9 @@ setup(
         "tabulate",
         "typing-inspect",
         "pyarrow",
+        "numpy",
     ],
-    extras_require={"tests": ["pyarrow"]},
+    extras_require={"tests": ["pyarrow", "numpy"]},
     python_requires=">=3.7",
     classifiers=[
         "Intended Audience :: Developers",
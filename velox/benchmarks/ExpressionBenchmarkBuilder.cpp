@@ -16,9 +16,55 @@
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
 #include <folly/Benchmark.h>
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/ReaderFactory.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 namespace facebook::velox {
+namespace {
+
+// Reads the first 'maxRows' rows of the file at 'path' in batches of
+// 'batchSize' rows, the way a table scan reads them.
+std::vector<RowVectorPtr> readFile(
+    const std::string& path,
+    dwio::common::FileFormat format,
+    vector_size_t batchSize,
+    int64_t maxRows,
+    memory::MemoryPool* pool) {
+  dwio::common::ReaderOptions readerOptions(pool);
+  readerOptions.setFileFormat(format);
+  auto file = filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+  auto reader = dwio::common::getReaderFactory(format)->createReader(
+      std::make_unique<dwio::common::BufferedInput>(std::move(file), *pool),
+      readerOptions);
+  const auto& rowType = reader->rowType();
+  auto scanSpec = std::make_shared<common::ScanSpec>("");
+  scanSpec->addAllChildFields(*rowType);
+  dwio::common::RowReaderOptions rowReaderOptions;
+  rowReaderOptions.setScanSpec(scanSpec);
+  rowReaderOptions.setRequestedType(rowType);
+  auto rowReader = reader->createRowReader(rowReaderOptions);
+
+  std::vector<RowVectorPtr> batches;
+  int64_t numRows = 0;
+  while (numRows < maxRows) {
+    VectorPtr batch = BaseVector::create(rowType, 0, pool);
+    if (rowReader->next(batchSize, batch) == 0) {
+      break;
+    }
+    auto rowVector = std::dynamic_pointer_cast<RowVector>(batch);
+    for (auto& child : rowVector->children()) {
+      child = BaseVector::loadedVectorShared(child);
+    }
+    numRows += rowVector->size();
+    batches.push_back(std::move(rowVector));
+  }
+  VELOX_CHECK(!batches.empty(), "No rows in {}", path);
+  return batches;
+}
+
+} // namespace
 
 ExpressionBenchmarkSet& ExpressionBenchmarkSet::addExpression(
     const std::string& name,
@@ -36,13 +82,36 @@ ExpressionBenchmarkSet& ExpressionBenchmarkSet::addExpressions(
   return *this;
 }
 
+ExpressionBenchmarkBuilder::ExpressionBenchmarkBuilder(bool trackCpuUsage)
+    : FunctionBenchmarkBase() {
+  if (trackCpuUsage) {
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprTrackCpuUsage, "true"}});
+  }
+}
+
+ExpressionBenchmarkSet& ExpressionBenchmarkBuilder::addBenchmarkSet(
+    const std::string& name,
+    const std::string& path,
+    dwio::common::FileFormat format,
+    vector_size_t batchSize,
+    int64_t maxRows) {
+  VELOX_CHECK(!benchmarkSets_.count(name));
+  benchmarkSets_.emplace(
+      name,
+      ExpressionBenchmarkSet(
+          *this, readFile(path, format, batchSize, maxRows, pool())));
+  return benchmarkSets_.at(name);
+}
+
 // Make sure all input vectors are generated.
 void ExpressionBenchmarkBuilder::ensureInputVectors() {
   for (auto& [_, benchmarkSet] : benchmarkSets_) {
-    if (!benchmarkSet.inputRowVector_) {
+    if (benchmarkSet.inputRowVectors_.empty()) {
       VectorFuzzer fuzzer(benchmarkSet.fuzzerOptions_, pool());
-      benchmarkSet.inputRowVector_ = std::dynamic_pointer_cast<RowVector>(
-          fuzzer.fuzzFlat(benchmarkSet.inputType_));
+      benchmarkSet.inputRowVectors_.push_back(
+          std::dynamic_pointer_cast<RowVector>(
+              fuzzer.fuzzFlat(benchmarkSet.inputType_)));
     }
   }
 }
@@ -62,14 +131,16 @@ void ExpressionBenchmarkBuilder::testBenchmarks() {
     if (benchmarkSet.expressions_.size() == 0) {
       return;
     }
-    // Evaluate the first expression.
-    auto it = benchmarkSet.expressions_.begin();
-    auto refResult = evalExpression(it->second, benchmarkSet.inputRowVector_);
-    it++;
-    while (it != benchmarkSet.expressions_.end()) {
-      auto result = evalExpression(it->second, benchmarkSet.inputRowVector_);
-      test::assertEqualVectors(refResult, result);
+    for (auto& input : benchmarkSet.inputRowVectors_) {
+      // Evaluate the first expression.
+      auto it = benchmarkSet.expressions_.begin();
+      auto refResult = evalExpression(it->second, input);
       it++;
+      while (it != benchmarkSet.expressions_.end()) {
+        auto result = evalExpression(it->second, input);
+        test::assertEqualVectors(refResult, result);
+        it++;
+      }
     }
   };
 
@@ -86,31 +157,37 @@ void ExpressionBenchmarkBuilder::registerBenchmarks() {
   for (auto& [setName, benchmarkSet] : benchmarkSets_) {
     for (auto& [exprName, exprSet] : benchmarkSet.expressions_) {
       auto name = fmt::format("{}##{}", setName, exprName);
-      auto& inputVector = benchmarkSet.inputRowVector_;
+      auto& inputVectors = benchmarkSet.inputRowVectors_;
       auto times = benchmarkSet.iterations_;
       // The compiler does not allow capturing exprSet int the lambda.
       auto& exprSetLocal = exprSet;
       folly::addBenchmark(
-          __FILE__, name, [this, &inputVector, &exprSetLocal, times]() {
+          __FILE__, name, [this, &inputVectors, &exprSetLocal, times]() {
             int cnt = 0;
             folly::BenchmarkSuspender suspender;
             // TODO: shall we cache those.
-            exec::EvalCtx evalCtx(
-                &this->execCtx_, &exprSetLocal, inputVector.get());
-            SelectivityVector rows(inputVector->size());
+            std::vector<std::unique_ptr<exec::EvalCtx>> evalCtxs;
+            std::vector<SelectivityVector> rows;
+            for (auto& inputVector : inputVectors) {
+              evalCtxs.push_back(std::make_unique<exec::EvalCtx>(
+                  &this->execCtx_, &exprSetLocal, inputVector.get()));
+              rows.emplace_back(inputVector->size());
+            }
             suspender.dismiss();
 
             std::vector<VectorPtr> results(1);
             for (auto i = 0; i < times; i++) {
-              exprSetLocal.eval(rows, evalCtx, results);
+              for (auto j = 0; j < inputVectors.size(); ++j) {
+                exprSetLocal.eval(rows[j], *evalCtxs[j], results);
 
-              // TODO: add flag to enable/disable flattening.
-              BaseVector::flattenVector(results[0]);
+                // TODO: add flag to enable/disable flattening.
+                BaseVector::flattenVector(results[0]);
 
-              // TODO: add flag to enable/disable reuse.
-              results[0]->prepareForReuse();
+                // TODO: add flag to enable/disable reuse.
+                results[0]->prepareForReuse();
 
-              cnt += results[0]->size();
+                cnt += results[0]->size();
+              }
             }
             folly::doNotOptimizeAway(cnt);
             return 1;
@@ -120,4 +197,27 @@ void ExpressionBenchmarkBuilder::registerBenchmarks() {
     folly::addBenchmark(__FILE__, "-", []() -> unsigned { return 0; });
   }
 }
+
+void ExpressionBenchmarkBuilder::printExprStats(std::ostream& out) {
+  VELOX_CHECK(
+      queryCtx_->queryConfig().exprTrackCpuUsage(),
+      "CPU usage is not tracked");
+  for (auto& [setName, benchmarkSet] : benchmarkSets_) {
+    for (auto& [exprName, exprSet] : benchmarkSet.expressions_) {
+      out << fmt::format("{}##{}", setName, exprName) << std::endl;
+      for (const auto& [function, stats] : exprSet.stats()) {
+        out << fmt::format(
+                   "  {}: {} CPU, {} per row, {} rows in {} batches",
+                   function,
+                   succinctNanos(stats.timing.cpuNanos),
+                   succinctNanos(
+                       stats.timing.cpuNanos /
+                       std::max<uint64_t>(1, stats.numProcessedRows)),
+                   stats.numProcessedRows,
+                   stats.numProcessedVectors)
+            << std::endl;
+      }
+    }
+  }
+}
 } // namespace facebook::velox
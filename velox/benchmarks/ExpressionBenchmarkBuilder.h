@@ -17,6 +17,7 @@
 
 #include <string>
 
+#include "velox/dwio/common/Options.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -29,7 +30,8 @@ class ExpressionBenchmarkBuilder;
 // if testing is not disabled for the set.
 // Users can pass the inputVector explicitly, if not passed a flat vector will
 // be fuzzed with some default fuzzer options. Users can also pass fuzzer
-// config to be used.
+// config to be used. The input can also be read from a file, in which case
+// it is a list of batches with the encodings the file reader produces.
 class ExpressionBenchmarkSet {
  public:
   ExpressionBenchmarkSet& addExpression(
@@ -47,7 +49,7 @@ class ExpressionBenchmarkSet {
   ExpressionBenchmarkSet& withFuzzerOptions(
       const VectorFuzzer::Options& options) {
     VELOX_CHECK(
-        !inputRowVector_,
+        inputRowVectors_.empty(),
         "input row vector is already passed, fuzzer wont be used");
     fuzzerOptions_ = options;
     return *this;
@@ -62,8 +64,15 @@ class ExpressionBenchmarkSet {
   ExpressionBenchmarkSet(
       ExpressionBenchmarkBuilder& builder,
       const RowVectorPtr& inputRowVector)
-      : inputRowVector_(inputRowVector),
-        inputType_(inputRowVector_->type()),
+      : inputRowVectors_({inputRowVector}),
+        inputType_(inputRowVector->type()),
+        builder_(builder) {}
+
+  ExpressionBenchmarkSet(
+      ExpressionBenchmarkBuilder& builder,
+      std::vector<RowVectorPtr> inputRowVectors)
+      : inputRowVectors_(std::move(inputRowVectors)),
+        inputType_(inputRowVectors_.front()->type()),
         builder_(builder) {}
 
   ExpressionBenchmarkSet(
@@ -74,9 +83,10 @@ class ExpressionBenchmarkSet {
   // All the expressions that belongs to this set.
   std::vector<std::pair<std::string, exec::ExprSet>> expressions_;
 
-  // The input that will be used for benchmarking expressions. If not set,
-  // a flat input vector is fuzzed using fuzzerOptions_.
-  RowVectorPtr inputRowVector_;
+  // The input batches that will be used for benchmarking expressions. Each
+  // iteration evaluates the expression on all of them. If not set, a flat
+  // input vector is fuzzed using fuzzerOptions_.
+  std::vector<RowVectorPtr> inputRowVectors_;
 
   // The type of the input that will be used for all the expressions
   // benchmarked.
@@ -84,7 +94,7 @@ class ExpressionBenchmarkSet {
 
   // User can provide fuzzer options for the input row vector used for this
   // benchmark. Note that the fuzzer will be used to generate a flat input row
-  // vector if inputRowVector_ is nullptr.
+  // vector if inputRowVectors_ is empty.
   VectorFuzzer::Options fuzzerOptions_{.vectorSize = 10000, .nullRatio = 0};
 
   // Number of times to run each benchmark.
@@ -101,7 +111,9 @@ class ExpressionBenchmarkSet {
 class ExpressionBenchmarkBuilder
     : public functions::test::FunctionBenchmarkBase {
  public:
-  explicit ExpressionBenchmarkBuilder() : FunctionBenchmarkBase() {}
+  // If 'trackCpuUsage' is true, the CPU time of each function in the
+  // expressions is collected, see printExprStats().
+  explicit ExpressionBenchmarkBuilder(bool trackCpuUsage = false);
 
   // Register all the benchmarks, so that they would run when
   // folly::runBenchmarks() is called.
@@ -111,6 +123,11 @@ class ExpressionBenchmarkBuilder
   // If disableTesting=true for a group set, testing is skipped.
   void testBenchmarks();
 
+  // Prints the CPU time per row of each benchmark and of the functions in
+  // it, from the ExprStats collected while running the benchmarks. Requires
+  // the builder to be created with trackCpuUsage=true.
+  void printExprStats(std::ostream& out);
+
   test::VectorMaker& vectorMaker() {
     return vectorMaker_;
   }
@@ -131,6 +148,19 @@ class ExpressionBenchmarkBuilder
     return benchmarkSets_.at(name);
   }
 
+  // Adds a set whose input is the first 'maxRows' rows of the file at
+  // 'path' in 'format', in batches of 'batchSize' rows. The batches keep the
+  // encodings the reader produces, e.g. dictionaries and constants, and the
+  // value distribution of the file. Lazy columns are loaded, since they can
+  // only be loaded until the reader reads the next batch. The reader factory
+  // of 'format' and the file system of 'path' must be registered.
+  ExpressionBenchmarkSet& addBenchmarkSet(
+      const std::string& name,
+      const std::string& path,
+      dwio::common::FileFormat format,
+      vector_size_t batchSize = 10'000,
+      int64_t maxRows = 1'000'000);
+
  private:
   void ensureInputVectors();
 
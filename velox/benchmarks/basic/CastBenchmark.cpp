@@ -38,6 +38,14 @@ int main(int argc, char** argv) {
       vectorSize, [](auto /*row*/) { return "$"; });
   auto validDoubleStringInput = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("{}.12345678910", row); });
+  auto validExponentInput = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return fmt::format("{}12345678910e-11", row); });
+  auto validBigintInput = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) { return std::to_string(row * 1'234'567'891); });
+  auto paddedBigintInput = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return fmt::format(" {}", row * 1'234'567'891); });
   auto validNaNInput = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto /*row*/) { return "NaN"; });
   auto validInfinityInput = vectorMaker.flatVector<std::string>(
@@ -117,23 +125,36 @@ int main(int argc, char** argv) {
           vectorMaker.rowVector({"timestamp"}, {timestampInput}))
       .addExpression("cast", "cast (timestamp as varchar)");
 
+  // Plain integers are parsed by the fast path, padded ones by the general
+  // conversion.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_as_bigint",
+          vectorMaker.rowVector(
+              {"valid", "padded"}, {validBigintInput, paddedBigintInput}))
+      .addExpression("cast_valid", "cast (valid as bigint)")
+      .addExpression("try_cast_padded", "try_cast (padded as bigint)");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_varchar_as_double",
           vectorMaker.rowVector(
               {"valid",
+               "valid_exponent",
                "valid_nan",
                "valid_infinity",
                "invalid_nan",
                "invalid_infinity",
                "space"},
               {validDoubleStringInput,
+               validExponentInput,
                validNaNInput,
                validInfinityInput,
                invalidNaNInput,
                invalidInfinityInput,
                spaceInput}))
       .addExpression("cast_valid", "cast (valid as double)")
+      .addExpression("cast_valid_exponent", "cast (valid_exponent as double)")
       .addExpression("cast_valid_nan", "cast (valid_nan as double)")
       .addExpression("cast_valid_infinity", "cast (valid_infinity as double)")
       .addExpression("try_cast_invalid_nan", "try_cast (invalid_nan as double)")
@@ -17,6 +17,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include <gflags/gflags.h>
+#include <cmath>
 
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
@@ -45,6 +46,21 @@ struct PlusFunction {
   }
 };
 
+// Greater-than that spends time on every row like an expensive function, e.g.
+// json_extract_scalar or regexp_extract, would.
+template <typename T>
+struct CostlyGtFunction {
+  FOLLY_ALWAYS_INLINE void
+  call(bool& result, const double& a, const double& b) {
+    double sum = 0;
+    for (auto i = 0; i < 50; ++i) {
+      sum += std::sqrt(i + std::abs(a));
+    }
+    folly::doNotOptimizeAway(sum);
+    result = a > b;
+  }
+};
+
 class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   explicit ComparisonBenchmark(size_t vectorSize) : FunctionBenchmarkBase() {
@@ -55,6 +71,7 @@ class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
     registerBinaryScalar<LteFunction, bool>({"lte"});
     registerBinaryScalar<GteFunction, bool>({"gte"});
     registerFunction<BetweenFunction, bool, double, double, double>({"btw"});
+    registerFunction<CostlyGtFunction, bool, double, double>({"costly_gt"});
 
     // Use it as a baseline.
     registerFunction<PlusFunction, double, double, double>({"plus"});
@@ -95,8 +112,15 @@ class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
   }
 
   // Runs `expression` `times` times.
-  size_t run(const std::string& expression, size_t times = 100) {
+  size_t run(
+      const std::string& expression,
+      size_t times = 100,
+      bool adaptiveFilterReordering = true) {
     folly::BenchmarkSuspender suspender;
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kAdaptiveFilterReorderingEnabled,
+         adaptiveFilterReordering ? "true" : "false"},
+    });
     auto exprSet = compileExpression(expression, inputType_);
     suspender.dismiss();
     // For functions like eq, the construction if the selectivity vector is
@@ -172,6 +196,36 @@ BENCHMARK(conjunctsNested) {
   benchmark->run("(d OR e) AND ((d AND (neq(d, (d OR e)))) OR (eq(a, b)))");
 }
 
+BENCHMARK_DRAW_LINE();
+
+// A cheap and a costly conjunct that drop about half of the rows each. The
+// cheap one should run first whichever order they are written in.
+BENCHMARK(mixedCostCheapFirst) {
+  benchmark->run("gt(a, b) AND costly_gt(b, c)", 100, false);
+}
+
+BENCHMARK_RELATIVE(mixedCostCostlyFirst) {
+  benchmark->run("costly_gt(b, c) AND gt(a, b)", 100, false);
+}
+
+BENCHMARK_RELATIVE(mixedCostCostlyFirstReordered) {
+  benchmark->run("costly_gt(b, c) AND gt(a, b)");
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(mixedCostOrCheapFirst) {
+  benchmark->run("gt(a, b) OR costly_gt(b, c)", 100, false);
+}
+
+BENCHMARK_RELATIVE(mixedCostOrCostlyFirst) {
+  benchmark->run("costly_gt(b, c) OR gt(a, b)", 100, false);
+}
+
+BENCHMARK_RELATIVE(mixedCostOrCostlyFirstReordered) {
+  benchmark->run("costly_gt(b, c) OR gt(a, b)");
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+DEFINE_string(path, "", "File with the input of the expressions");
+DEFINE_string(format, "parquet", "Format of --path: dwrf or parquet");
+DEFINE_string(
+    expressions,
+    "",
+    "Expressions to benchmark separated by ';'. They refer to the columns "
+    "of --path by name");
+DEFINE_int32(batch_size, 10'000, "Rows per input batch");
+DEFINE_int64(max_rows, 1'000'000, "Maximum number of rows to read");
+DEFINE_int32(iterations, 10, "Evaluations of each expression per run");
+DEFINE_bool(
+    expr_stats,
+    true,
+    "Print the CPU time of each function after the benchmarks");
+
+using namespace facebook::velox;
+
+// Benchmarks expressions on the data of a DWRF or Parquet file, e.g.
+//
+//   velox_expression_file_benchmark --path=/data/lineitem.parquet
+//     --expressions="l_extendedprice * (1 - l_discount);upper(l_comment)"
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  VELOX_USER_CHECK(!FLAGS_path.empty(), "--path must be set");
+  memory::MemoryManager::initialize({});
+  filesystems::registerLocalFileSystem();
+  dwrf::registerDwrfReaderFactory();
+  parquet::registerParquetReaderFactory();
+  functions::prestosql::registerAllScalarFunctions();
+
+  ExpressionBenchmarkBuilder benchmarkBuilder(FLAGS_expr_stats);
+  auto& benchmarkSet = benchmarkBuilder
+                           .addBenchmarkSet(
+                               "file",
+                               FLAGS_path,
+                               dwio::common::toFileFormat(FLAGS_format),
+                               FLAGS_batch_size,
+                               FLAGS_max_rows)
+                           .withIterations(FLAGS_iterations)
+                           .disableTesting();
+  std::vector<std::string> expressions;
+  folly::split(';', FLAGS_expressions, expressions, true);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    benchmarkSet.addExpression(fmt::format("e{}", i), expressions[i]);
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  folly::runBenchmarks();
+  if (FLAGS_expr_stats) {
+    benchmarkBuilder.printExprStats(std::cout);
+  }
+  return 0;
+}
@@ -35,11 +35,38 @@ int main(int argc, char** argv) {
   VectorFuzzer fuzzer(options, pool);
   auto vectorMaker = benchmarkBuilder.vectorMaker();
 
-  benchmarkBuilder
-      .addBenchmarkSet(
-          "Benchmark format_datetime",
-          vectorMaker.rowVector({fuzzer.fuzz(TIMESTAMP())}))
-      .addExpression("", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
+  // Non-constant formats alternate between two patterns. Strings to parse are
+  // formatted timestamps.
+  const std::vector<std::string> formats = {
+      "yyyy-MM-dd HH:mm:ss", "yyyy-MM-dd'T'HH:mm:ss.SSS"};
+  const auto data = vectorMaker.rowVector({
+      fuzzer.fuzz(TIMESTAMP()),
+      vectorMaker.flatVector<std::string>(
+          options.vectorSize, [&](auto row) { return formats[row % 2]; }),
+      vectorMaker.flatVector<std::string>(
+          options.vectorSize,
+          [](auto row) {
+            return fmt::format(
+                "20{:02}-{:02}-{:02} {:02}:{:02}:{:02}",
+                row % 100,
+                row % 12 + 1,
+                row % 28 + 1,
+                row % 24,
+                row % 60,
+                (row * 7) % 60);
+          }),
+  });
+
+  benchmarkBuilder.addBenchmarkSet("Benchmark format_datetime", data)
+      .addExpression(
+          "fixed_width", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
+      .addExpression(
+          "variable_width", "format_datetime(c0, 'yyyy-MMM-d h:mm:ss a')")
+      .addExpression("non_constant_format", "format_datetime(c0, c1)")
+      .addExpression("date_format", "date_format(c0, '%Y-%m-%d %H:%i:%s')")
+      .addExpression("date_parse", "date_parse(c2, '%Y-%m-%d %H:%i:%s')")
+      .addExpression(
+          "parse_datetime", "parse_datetime(c2, 'yyyy-MM-dd HH:mm:ss')")
       .disableTesting();
 
   benchmarkBuilder.registerBenchmarks();
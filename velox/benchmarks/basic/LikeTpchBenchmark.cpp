@@ -100,6 +100,13 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
         auto fixedPatternString = inputString.substr(fixedPatternStartIdx, 10);
         return generateRandomString(kAnyWildcardCharacter) + fixedPatternString;
       }
+      case PatternKind::kSubstring: {
+        auto fixedPatternStartIdx = inputString.size() / 4;
+        auto fixedPatternString =
+            inputString.substr(fixedPatternStartIdx, inputString.size() / 2);
+        return generateRandomString(kAnyWildcardCharacter) +
+            fixedPatternString + generateRandomString(kAnyWildcardCharacter);
+      }
       default:
         return inputString;
     }
@@ -208,6 +215,10 @@ BENCHMARK(suffixPattern) {
   benchmark->run(PatternKind::kSuffix);
 }
 
+BENCHMARK(substringPattern) {
+  benchmark->run(PatternKind::kSubstring);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(tpchQuery2) {
@@ -222,6 +233,11 @@ BENCHMARK(tpchQuery13) {
   benchmark->run(TpchBenchmarkCase::TpchQuery13, "%special%requests%");
 }
 
+// Substring search over the longer order comments.
+BENCHMARK(tpchQuery13Substring) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery13, "%requests%");
+}
+
 BENCHMARK(tpchQuery14) {
   benchmark->run(TpchBenchmarkCase::TpchQuery14, "PROMO%");
 }
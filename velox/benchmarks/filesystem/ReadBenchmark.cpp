@@ -114,10 +114,11 @@ void ReadBenchmark::initialize() {
     }
     auto fs = filesystems::getFileSystem(FLAGS_path, config);
     readFile_ = fs->openFileForRead(FLAGS_path);
-    fileSize_ = readFile_->size();
-    if (FLAGS_file_size_gb) {
-      fileSize_ = std::min<uint64_t>(FLAGS_file_size_gb << 30, fileSize_);
-    }
+  }
+  // A LocalReadFile made from a file descriptor does not know its size.
+  fileSize_ = FLAGS_odirect ? lseek(fd_, 0, SEEK_END) : readFile_->size();
+  if (FLAGS_file_size_gb) {
+    fileSize_ = std::min<uint64_t>(FLAGS_file_size_gb << 30, fileSize_);
   }
 
   if (fileSize_ <= FLAGS_measurement_size) {
@@ -237,6 +237,58 @@ class ReadBenchmark {
               << std::endl;
   }
 
+  // Measures the throughput of preadvAsync from a single thread that keeps
+  // 'queueDepth' reads in flight. Compares io_uring, i.e.
+  // --velox_local_file_io_uring, with the pread and O_DIRECT modes above.
+  void asyncReads(
+      int32_t size,
+      int32_t gap,
+      int32_t count,
+      int32_t repeats,
+      int32_t queueDepth) {
+    clearCache();
+    uint64_t usec = 0;
+    {
+      MicrosecondTimer timer(&usec);
+      const int32_t rangeSize = size * count + gap * (count - 1);
+      // A buffer per read in flight.
+      std::vector<std::string> buffers(queueDepth);
+      std::vector<folly::SemiFuture<uint64_t>> futures;
+      for (auto i = 0; i < queueDepth; ++i) {
+        futures.push_back(folly::SemiFuture<uint64_t>::makeEmpty());
+      }
+      for (auto repeat = 0; repeat < repeats; ++repeat) {
+        const auto slot = repeat % queueDepth;
+        if (futures[slot].valid()) {
+          std::move(futures[slot]).get();
+        }
+        auto& buffer = buffers[slot];
+        buffer.resize(rangeSize);
+        std::vector<folly::Range<char*>> ranges;
+        for (auto start = 0; start < rangeSize; start += size + gap) {
+          ranges.push_back(folly::Range<char*>(buffer.data() + start, size));
+          if (gap && start + gap < rangeSize) {
+            ranges.push_back(folly::Range<char*>(nullptr, gap));
+          }
+        }
+        const int64_t offset =
+            folly::Random::rand64(rng_) % (fileSize_ - rangeSize);
+        futures[slot] = readFile_->preadvAsync(offset, ranges);
+      }
+      for (auto& future : futures) {
+        if (future.valid()) {
+          std::move(future).get();
+        }
+      }
+    }
+    std::cout << fmt::format(
+                     "{} MB/s preadvAsync qd {} {}",
+                     (static_cast<float>(count) * size * repeats) / usec,
+                     queueDepth,
+                     readFile_->hasPreadvAsync() ? "async" : "sync")
+              << std::endl;
+  }
+
   void modes(int32_t size, int32_t gap, int32_t count) {
     int repeats =
         std::max<int32_t>(3, (FLAGS_measurement_size) / (size * count));
@@ -253,6 +305,9 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    for (auto queueDepth : {1, 8, 32, 128}) {
+      asyncReads(size, gap, count, repeats, queueDepth);
+    }
   }
 
   void run();
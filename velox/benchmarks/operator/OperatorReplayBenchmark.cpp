@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/operator/OperatorReplayer.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/Timer.h"
+#include "velox/core/Expressions.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/type/Filter.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+DEFINE_string(
+    replay_path,
+    "",
+    "Directory written by OperatorReplayer::save() or the trace directory "
+    "of a plan node written with query_trace_enabled, with the plan and the "
+    "saved batches to replay");
+
+DEFINE_int32(num_drivers, 1, "Number of drivers");
+DEFINE_int32(num_repeats, 5, "Number of timed runs");
+
+DEFINE_int32(
+    repeat_inputs,
+    1,
+    "Number of times each driver of a Values node produces the saved "
+    "batches. Use to make short inputs run long enough to measure");
+
+DEFINE_string(
+    query_configs,
+    "",
+    "Comma separated query configs of the runs, e.g. "
+    "'max_output_batch_rows=1024,preferred_output_batch_rows=1024'. These "
+    "override the saved query config of a trace");
+
+DEFINE_bool(
+    include_custom_stats,
+    false,
+    "Include custom statistics along with execution statistics");
+
+namespace {
+
+std::unordered_map<std::string, std::string> parseQueryConfigs(
+    const std::string& configs) {
+  std::unordered_map<std::string, std::string> result;
+  std::vector<std::string> pairs;
+  folly::split(',', configs, pairs, true);
+  for (const auto& pair : pairs) {
+    std::string key;
+    std::string value;
+    VELOX_USER_CHECK(
+        folly::split('=', pair, key, value),
+        "Query config must be key=value: {}",
+        pair);
+    result[key] = value;
+  }
+  return result;
+}
+
+std::shared_ptr<Task> runOnce(
+    const core::PlanNodePtr& plan,
+    const std::unordered_map<std::string, std::string>& queryConfigs) {
+  CursorParameters params;
+  params.planNode = plan;
+  params.maxDrivers = FLAGS_num_drivers;
+  params.queryConfigs = queryConfigs;
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  auto task = cursor->task();
+  VELOX_CHECK(waitForTaskCompletion(task.get()));
+  return task;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::SetUsageMessage(
+      "Replays the saved input of a plan fragment and reports the "
+      "throughput and the stats of each operator. Each driver of a Values "
+      "node produces all the saved batches, so the input of a run is the "
+      "saved batches times --num_drivers times --repeat_inputs. Run "
+      "'velox_operator_replay_benchmark -helpon=OperatorReplayBenchmark' "
+      "for available options.\n");
+  folly::Init init{&argc, &argv, false};
+  VELOX_USER_CHECK(!FLAGS_replay_path.empty(), "--replay_path must be set");
+
+  memory::initializeMemoryManager({});
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  core::PlanNode::registerSerDe();
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  parse::registerTypeResolver();
+
+  auto pool = memory::memoryManager()->addLeafPool("replay");
+  OperatorReplayer replayer(FLAGS_replay_path, FLAGS_repeat_inputs, pool.get());
+  auto queryConfigs = replayer.queryConfigs();
+  for (const auto& [key, value] : parseQueryConfigs(FLAGS_query_configs)) {
+    queryConfigs[key] = value;
+  }
+  const auto numRows = replayer.numInputRows() * FLAGS_num_drivers;
+  const auto bytes = replayer.inputBytes() * FLAGS_num_drivers;
+  std::cout << replayer.plan()->toString(true, true) << std::endl;
+  std::cout << fmt::format(
+                   "Input: {} rows, {} per run", numRows, succinctBytes(bytes))
+            << std::endl;
+
+  // Warms up caches and the memory allocator before the timed runs.
+  runOnce(replayer.plan(), queryConfigs);
+  std::shared_ptr<Task> task;
+  for (auto i = 0; i < FLAGS_num_repeats; ++i) {
+    uint64_t micros = 0;
+    {
+      MicrosecondTimer timer(&micros);
+      task = runOnce(replayer.plan(), queryConfigs);
+    }
+    const auto seconds = std::max<uint64_t>(micros, 1) / 1'000'000.0;
+    std::cout << fmt::format(
+                     "Run {}: {} {:.0f} rows/s {}/s",
+                     i,
+                     succinctMicros(micros),
+                     numRows / seconds,
+                     succinctBytes(static_cast<uint64_t>(bytes / seconds)))
+              << std::endl;
+  }
+  if (task) {
+    std::cout << printPlanWithStats(
+                     *replayer.plan(),
+                     task->taskStats(),
+                     FLAGS_include_custom_stats)
+              << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/benchmarks/operator/OperatorReplayer.h"
+
+#include <folly/json.h>
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox {
+namespace {
+
+// Returns the batches in the files 0, 1, 2, ... of 'directory' one after
+// the other, which is how ValuesNode serializes its data.
+std::string readBatches(const std::string& directory) {
+  std::string data;
+  for (auto i = 0;; ++i) {
+    const auto path = fmt::format("{}/{}", directory, i);
+    if (!fs::exists(path)) {
+      break;
+    }
+    data += restoreStringFromFile(path.c_str());
+  }
+  VELOX_CHECK(!data.empty(), "No saved batches in {}", directory);
+  return data;
+}
+
+// Replaces 'node' or the nodes under it that have their id in 'batches' by
+// Values nodes that produce the saved batches. Returns the number of
+// replaced nodes.
+int32_t replaceWithValues(
+    folly::dynamic& node,
+    const std::unordered_map<std::string, std::string>& batches,
+    int32_t repeatTimes) {
+  const auto id = node["id"].asString();
+  auto it = batches.find(id);
+  if (it != batches.end()) {
+    folly::dynamic values = folly::dynamic::object;
+    values["name"] = "ValuesNode";
+    values["id"] = id;
+    values["data"] =
+        encoding::Base64::encode(it->second.data(), it->second.size());
+    values["parallelizable"] = true;
+    values["repeatTimes"] = repeatTimes;
+    node = std::move(values);
+    return 1;
+  }
+  if (!node.count("sources")) {
+    return 0;
+  }
+  auto& sources = node["sources"];
+  if (!sources.isArray()) {
+    return replaceWithValues(sources, batches, repeatTimes);
+  }
+  int32_t numReplaced = 0;
+  for (auto& source : sources) {
+    numReplaced += replaceWithValues(source, batches, repeatTimes);
+  }
+  return numReplaced;
+}
+
+// Adds the rows and bytes of the Values nodes in the tree of 'node'.
+void addInputSize(
+    const core::PlanNode& node,
+    int64_t& numRows,
+    int64_t& bytes) {
+  if (auto values = dynamic_cast<const core::ValuesNode*>(&node)) {
+    for (const auto& vector : values->values()) {
+      numRows += vector->size() * values->repeatTimes();
+      bytes += vector->retainedSize() * values->repeatTimes();
+    }
+  }
+  for (const auto& source : node.sources()) {
+    addInputSize(*source, numRows, bytes);
+  }
+}
+
+} // namespace
+
+// static
+void OperatorReplayer::save(
+    const core::PlanNodePtr& plan,
+    const std::unordered_map<core::PlanNodeId, std::vector<RowVectorPtr>>&
+        inputs,
+    const std::string& directory) {
+  fs::create_directories(directory);
+  saveStringToFile(
+      folly::toJson(plan->serialize()),
+      fmt::format("{}/{}", directory, kPlanFileName).c_str());
+  for (const auto& [id, batches] : inputs) {
+    const auto nodeDirectory = fmt::format("{}/{}", directory, id);
+    fs::create_directories(nodeDirectory);
+    for (auto i = 0; i < batches.size(); ++i) {
+      saveVectorToFile(
+          batches[i].get(), fmt::format("{}/{}", nodeDirectory, i).c_str());
+    }
+  }
+}
+
+OperatorReplayer::OperatorReplayer(
+    const std::string& directory,
+    int32_t repeatTimes,
+    memory::MemoryPool* pool) {
+  auto json = folly::parseJson(restoreStringFromFile(
+      fmt::format("{}/{}", directory, kPlanFileName).c_str()));
+  std::unordered_map<std::string, std::string> batches;
+  for (const auto& entry : fs::directory_iterator(directory)) {
+    if (entry.is_directory()) {
+      batches[entry.path().filename().string()] =
+          readBatches(entry.path().string());
+    }
+  }
+  const auto numReplaced = replaceWithValues(json, batches, repeatTimes);
+  VELOX_CHECK_EQ(
+      numReplaced,
+      batches.size(),
+      "Saved batches in {} are for nodes that are not in the plan",
+      directory);
+  plan_ = ISerializable::deserialize<core::PlanNode>(json, pool);
+  addInputSize(*plan_, numInputRows_, inputBytes_);
+
+  const auto configPath = fmt::format("{}/{}", directory, kQueryConfigFileName);
+  if (fs::exists(configPath)) {
+    auto configs = folly::parseJson(restoreStringFromFile(configPath.c_str()));
+    for (const auto& [key, value] : configs.items()) {
+      queryConfigs_[key.asString()] = value.asString();
+    }
+  }
+}
+
+} // namespace facebook::velox
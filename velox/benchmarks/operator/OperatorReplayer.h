@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox {
+
+/// Saves the input of a fragment of a plan and replays the fragment on it,
+/// so that a slow operator of a production query, e.g. a HashAggregation, a
+/// HashProbe or a FilterProject, can be benchmarked in isolation.
+///
+/// A replay directory has 'plan.json' with the serialized plan and, for each
+/// node whose output is saved, a subdirectory named after the plan node id.
+/// The subdirectory has the output batches of the node in files 0, 1, 2, ...
+/// written by saveVectorToFile(). When replayed, each such node and the
+/// nodes below it are replaced by a Values node that produces the saved
+/// batches. An optional 'query_config.json' has the query config of the
+/// runs. The traces written by exec::QueryTracer have this layout.
+class OperatorReplayer {
+ public:
+  static constexpr const char* kPlanFileName = "plan.json";
+  static constexpr const char* kQueryConfigFileName = "query_config.json";
+
+  /// Saves 'plan' and 'inputs' to 'directory'. 'inputs' maps the id of a
+  /// node of 'plan' to the batches it produced.
+  static void save(
+      const core::PlanNodePtr& plan,
+      const std::unordered_map<core::PlanNodeId, std::vector<RowVectorPtr>>&
+          inputs,
+      const std::string& directory);
+
+  /// Loads the plan in 'directory' and replaces the nodes with saved batches
+  /// by Values nodes. Each driver of a Values node produces all the batches
+  /// 'repeatTimes' times. The batches are allocated from 'pool'. Requires
+  /// the serde of types, expressions and plan nodes to be registered.
+  OperatorReplayer(
+      const std::string& directory,
+      int32_t repeatTimes,
+      memory::MemoryPool* pool);
+
+  const core::PlanNodePtr& plan() const {
+    return plan_;
+  }
+
+  /// Returns the query config in 'query_config.json'. Empty if there is no
+  /// such file.
+  const std::unordered_map<std::string, std::string>& queryConfigs() const {
+    return queryConfigs_;
+  }
+
+  /// Returns the number of rows that one driver of each Values node
+  /// produces, summed over the Values nodes.
+  int64_t numInputRows() const {
+    return numInputRows_;
+  }
+
+  /// Returns the bytes of the batches that one driver of each Values node
+  /// produces, summed over the Values nodes.
+  int64_t inputBytes() const {
+    return inputBytes_;
+  }
+
+ private:
+  core::PlanNodePtr plan_;
+  std::unordered_map<std::string, std::string> queryConfigs_;
+  int64_t numInputRows_{0};
+  int64_t inputBytes_{0};
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+DEFINE_double(scale_factor, 1, "TPC-DS scale factor of the generated data");
+
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+
+DEFINE_bool(
+    include_custom_stats,
+    false,
+    "Include custom statistics along with execution statistics");
+DEFINE_bool(include_results, false, "Include results in the output");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_splits, 16, "Number of splits per table scan");
+DEFINE_int32(num_repeats, 1, "Number of times to run each query");
+
+DEFINE_int32(
+    memory_gb,
+    0,
+    "GB of memory for queries. If non-0, queries over it spill if "
+    "--spill_path is set and fail otherwise");
+
+DEFINE_string(
+    spill_path,
+    "",
+    "Directory for spill files. If set, joins, aggregations, order by and "
+    "window spill under memory pressure");
+
+namespace {
+
+// The connector id the TPC-DS table scans of PlanBuilder use.
+const std::string kTpcdsConnectorId = "test-tpcds";
+
+void printResults(const std::vector<RowVectorPtr>& results, std::ostream& out) {
+  out << "Results:" << std::endl;
+  bool printType = true;
+  for (const auto& vector : results) {
+    // Print RowType only once.
+    if (printType) {
+      out << vector->type()->asRow().toString() << std::endl;
+      printType = false;
+    }
+    for (vector_size_t i = 0; i < vector->size(); ++i) {
+      out << vector->toString(i) << std::endl;
+    }
+  }
+}
+
+// Prints one line per operator with its CPU and wall time, peak memory and
+// spilled bytes, summed over its drivers. These are the numbers to compare
+// between runs to find regressions in a join, aggregation or window.
+void printOperatorStats(const TaskStats& stats, std::ostream& out) {
+  constexpr const char* kFormat =
+      "{:>5} {:<24} {:>7} {:>10} {:>10} {:>10} {:>10} {:>10}";
+  out << fmt::format(
+             kFormat,
+             "Node",
+             "Operator",
+             "Drivers",
+             "CPU",
+             "Wall",
+             "Blocked",
+             "Peak mem",
+             "Spilled")
+      << std::endl;
+  for (const auto& pipeline : stats.pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      CpuWallTiming timing;
+      timing.add(op.addInputTiming);
+      timing.add(op.getOutputTiming);
+      timing.add(op.finishTiming);
+      out << fmt::format(
+                 kFormat,
+                 op.planNodeId,
+                 op.operatorType,
+                 op.numDrivers,
+                 succinctNanos(timing.cpuNanos),
+                 succinctNanos(timing.wallNanos),
+                 succinctNanos(op.blockedWallNanos),
+                 succinctBytes(op.memoryStats.peakTotalMemoryReservation),
+                 succinctBytes(op.spilledBytes))
+          << std::endl;
+    }
+  }
+}
+
+} // namespace
+
+class TpcdsBenchmark {
+ public:
+  void initialize() {
+    memory::MemoryManagerOptions options;
+    if (FLAGS_memory_gb) {
+      memory::SharedArbitrator::registerFactory();
+      options.allocatorCapacity = FLAGS_memory_gb * (1LL << 30);
+      options.arbitratorCapacity = options.allocatorCapacity;
+      options.arbitratorKind = "SHARED";
+    }
+    memory::MemoryManager::testingSetInstance(options);
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    window::prestosql::registerAllWindowFunctions();
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+    queryBuilder_ = std::make_unique<TpcdsQueryBuilder>(FLAGS_scale_factor);
+  }
+
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
+      const TpcdsPlan& tpcdsPlan) {
+    int32_t repeat = 0;
+    try {
+      for (;;) {
+        CursorParameters params;
+        params.maxDrivers = FLAGS_num_drivers;
+        params.planNode = tpcdsPlan.plan;
+        if (!FLAGS_spill_path.empty()) {
+          params.spillDirectory = FLAGS_spill_path;
+          for (auto config :
+               {core::QueryConfig::kSpillEnabled,
+                core::QueryConfig::kJoinSpillEnabled,
+                core::QueryConfig::kAggregationSpillEnabled,
+                core::QueryConfig::kOrderBySpillEnabled,
+                core::QueryConfig::kWindowSpillEnabled}) {
+            params.queryConfigs[config] = "true";
+          }
+        }
+
+        bool noMoreSplits = false;
+        auto addSplits = [&](exec::Task* task) {
+          if (!noMoreSplits) {
+            for (const auto& nodeId : tpcdsPlan.scanNodeIds) {
+              for (auto i = 0; i < FLAGS_num_splits; ++i) {
+                task->addSplit(
+                    nodeId,
+                    exec::Split(
+                        std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+                            kTpcdsConnectorId, FLAGS_num_splits, i)));
+              }
+              task->noMoreSplits(nodeId);
+            }
+          }
+          noMoreSplits = true;
+        };
+        auto result = readCursor(params, addSplits);
+        VELOX_CHECK(waitForTaskCompletion(result.first->task().get()));
+        if (++repeat >= FLAGS_num_repeats) {
+          return result;
+        }
+      }
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Query terminated with: " << e.what();
+      return {nullptr, std::vector<RowVectorPtr>()};
+    }
+  }
+
+  void runMain(std::ostream& out) {
+    if (FLAGS_run_query_verbose == -1) {
+      folly::runBenchmarks();
+      return;
+    }
+    const auto queryPlan = queryBuilder_->getQueryPlan(FLAGS_run_query_verbose);
+    auto [cursor, actualResults] = run(queryPlan);
+    if (!cursor) {
+      LOG(ERROR) << "Query terminated with error. Exiting";
+      exit(1);
+    }
+    auto task = cursor->task();
+    if (FLAGS_include_results) {
+      printResults(actualResults, out);
+      out << std::endl;
+    }
+    const auto stats = task->taskStats();
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << fmt::format(
+               "Peak memory: {}", succinctBytes(task->pool()->peakBytes()))
+        << std::endl;
+    out << printPlanWithStats(
+               *queryPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
+    printOperatorStats(stats, out);
+  }
+
+  const TpcdsQueryBuilder& queryBuilder() const {
+    return *queryBuilder_;
+  }
+
+ private:
+  std::unique_ptr<TpcdsQueryBuilder> queryBuilder_;
+};
+
+TpcdsBenchmark benchmark;
+
+BENCHMARK(q3) {
+  benchmark.run(benchmark.queryBuilder().getQueryPlan(3));
+}
+
+BENCHMARK(q27) {
+  benchmark.run(benchmark.queryBuilder().getQueryPlan(27));
+}
+
+BENCHMARK(q42) {
+  benchmark.run(benchmark.queryBuilder().getQueryPlan(42));
+}
+
+BENCHMARK(q55) {
+  benchmark.run(benchmark.queryBuilder().getQueryPlan(55));
+}
+
+BENCHMARK(q98) {
+  benchmark.run(benchmark.queryBuilder().getQueryPlan(98));
+}
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "This program benchmarks TPC-DS queries over generated data. Run "
+      "'velox_tpcds_benchmark -helpon=TpcdsBenchmark' for available "
+      "options.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+  benchmark.initialize();
+  benchmark.runMain(std::cout);
+  return 0;
+}
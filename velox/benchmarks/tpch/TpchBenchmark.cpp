@@ -19,7 +19,9 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -28,6 +30,7 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/memory/SharedArbitrator.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/dwio/common/Options.h"
@@ -184,6 +187,30 @@ DEFINE_int32(
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
+DEFINE_int64(
+    query_memory_mb,
+    0,
+    "MB of memory for each query. If non-0, a query over it spills if "
+    "--spill_path is set and fails otherwise");
+
+DEFINE_string(
+    spill_path,
+    "",
+    "Directory for spill files. If set, joins, aggregations, order by and "
+    "window spill under memory pressure");
+
+DEFINE_int32(
+    max_drivers_sweep,
+    0,
+    "If non-0, runs each combination of --test_flags_file with 1, 2, 4, ... "
+    "up to this many drivers");
+
+DEFINE_string(
+    json_stats_file,
+    "",
+    "If set, appends one JSON object per run to this file. The object has the "
+    "flags of the run, its time and the stats of each plan node");
+
 struct RunStats {
   std::map<std::string, std::string> flags;
   int64_t micros{0};
@@ -191,6 +218,8 @@ struct RunStats {
   int64_t userNanos{0};
   int64_t systemNanos{0};
   std::string output;
+  // Stats of each plan node by plan node id.
+  folly::dynamic planStats;
 
   std::string toString(bool detail) {
     std::stringstream out;
@@ -220,11 +249,16 @@ std::shared_ptr<TpchQueryBuilder> queryBuilder;
 class TpchBenchmark {
  public:
   void initialize() {
+    // Queries capped by --query_memory_mb get memory by arbitration, which
+    // spills them when they are at their cap.
+    memory::SharedArbitrator::registerFactory();
+    memory::MemoryManagerOptions options;
+    options.arbitratorKind = "SHARED";
     if (FLAGS_cache_gb) {
-      memory::MemoryManagerOptions options;
       int64_t memoryBytes = FLAGS_cache_gb * (1LL << 30);
       options.useMmapAllocator = true;
       options.allocatorCapacity = memoryBytes;
+      options.arbitratorCapacity = memoryBytes;
       options.useMmapArena = true;
       options.mmapArenaCapacityRatio = 1;
       memory::MemoryManager::testingSetInstance(options);
@@ -246,7 +280,7 @@ class TpchBenchmark {
           memory::memoryManager()->allocator(), std::move(ssdCache));
       cache::AsyncDataCache::setInstance(cache_.get());
     } else {
-      memory::MemoryManager::testingSetInstance({});
+      memory::MemoryManager::testingSetInstance(options);
     }
     functions::prestosql::registerAllScalarFunctions();
     aggregate::prestosql::registerAllAggregateFunctions();
@@ -255,6 +289,8 @@ class TpchBenchmark {
 
     ioExecutor_ =
         std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    queryExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::thread::hardware_concurrency());
 
     // Add new values into the hive configuration...
     auto configurationValues = std::unordered_map<std::string, std::string>();
@@ -290,6 +326,28 @@ class TpchBenchmark {
         params.planNode = tpchPlan.plan;
         params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
             std::to_string(FLAGS_split_preload_per_driver);
+        if (FLAGS_query_memory_mb) {
+          static std::atomic<int32_t> queryId{0};
+          params.queryCtx = core::QueryCtx::create(
+              queryExecutor_.get(),
+              core::QueryConfig({}),
+              {},
+              cache::AsyncDataCache::getInstance(),
+              memory::memoryManager()->addRootPool(
+                  fmt::format("tpch_{}", ++queryId),
+                  FLAGS_query_memory_mb << 20));
+        }
+        if (!FLAGS_spill_path.empty()) {
+          params.spillDirectory = FLAGS_spill_path;
+          for (auto config :
+               {core::QueryConfig::kSpillEnabled,
+                core::QueryConfig::kJoinSpillEnabled,
+                core::QueryConfig::kAggregationSpillEnabled,
+                core::QueryConfig::kOrderBySpillEnabled,
+                core::QueryConfig::kWindowSpillEnabled}) {
+            params.queryConfigs[config] = "true";
+          }
+        }
         const int numSplitsPerFile = FLAGS_num_splits_per_file;
 
         bool noMoreSplits = false;
@@ -348,6 +406,7 @@ class TpchBenchmark {
         }
       }
       runStats.rawInputBytes = rawInputBytes;
+      runStats.planStats = toPlanStatsJson(stats);
       out << fmt::format(
                  "Execution time: {}",
                  succinctMillis(
@@ -364,7 +423,46 @@ class TpchBenchmark {
     }
   }
 
+  // Appends 'stats' as a line of JSON to --json_stats_file.
+  void writeJsonStats(const RunStats& stats) {
+    if (FLAGS_json_stats_file.empty()) {
+      return;
+    }
+    folly::dynamic flags = folly::dynamic::object;
+    for (auto& [flag, value] : stats.flags) {
+      flags[flag] = value;
+    }
+    for (auto flag : {"num_drivers", "query_memory_mb", "spill_path"}) {
+      std::string value;
+      gflags::GetCommandLineOption(flag, &value);
+      flags[flag] = value;
+    }
+    folly::dynamic json = folly::dynamic::object;
+    json["query"] = FLAGS_io_meter_column_pct > 0
+        ? "io_meter"
+        : std::to_string(FLAGS_run_query_verbose);
+    json["flags"] = std::move(flags);
+    json["micros"] = stats.micros;
+    json["rawInputBytes"] = stats.rawInputBytes;
+    json["userNanos"] = stats.userNanos;
+    json["systemNanos"] = stats.systemNanos;
+    json["planStats"] = stats.planStats;
+    std::ofstream out(FLAGS_json_stats_file, std::ios::app);
+    out << folly::toJson(json) << std::endl;
+  }
+
   void readCombinations() {
+    if (FLAGS_max_drivers_sweep) {
+      ParameterDim dim{"num_drivers", {}};
+      for (auto i = 1; i < FLAGS_max_drivers_sweep; i *= 2) {
+        dim.values.push_back(std::to_string(i));
+      }
+      dim.values.push_back(std::to_string(FLAGS_max_drivers_sweep));
+      parameters_.push_back(std::move(dim));
+    }
+    if (FLAGS_test_flags_file.empty()) {
+      return;
+    }
     std::ifstream file(FLAGS_test_flags_file);
     std::string line;
     while (std::getline(file, line)) {
@@ -443,6 +541,7 @@ class TpchBenchmark {
         gflags::GetCommandLineOption(parameters_[i].flag.c_str(), &name);
         stats.flags[parameters_[i].flag] = name;
       }
+      writeJsonStats(stats);
       runStats_.push_back(std::move(stats));
     } else {
       auto& flag = parameters_[level].flag;
@@ -480,6 +579,8 @@ class TpchBenchmark {
 
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
+  // Runs the queries that have a memory cap.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> queryExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
   std::shared_ptr<cache::AsyncDataCache> cache_;
   // Parameter combinations to try. Each element specifies a flag and possible
@@ -506,6 +607,11 @@ BENCHMARK(q3) {
   benchmark.run(planContext);
 }
 
+BENCHMARK(q4) {
+  const auto planContext = queryBuilder->getQueryPlan(4);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q5) {
   const auto planContext = queryBuilder->getQueryPlan(5);
   benchmark.run(planContext);
@@ -601,9 +707,15 @@ int tpchBenchmarkMain() {
   queryBuilder =
       std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
   queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
-    RunStats ignore;
-    benchmark.runMain(std::cout, ignore);
+  if (FLAGS_test_flags_file.empty() && FLAGS_max_drivers_sweep == 0) {
+    RunStats stats;
+    uint64_t micros = 0;
+    {
+      MicrosecondTimer timer(&micros);
+      benchmark.runMain(std::cout, stats);
+    }
+    stats.micros = micros;
+    benchmark.writeJsonStats(stats);
   } else {
     benchmark.runAllCombinations();
   }
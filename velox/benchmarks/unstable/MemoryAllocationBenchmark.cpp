@@ -15,6 +15,7 @@
  */
 
 #include <deque>
+#include <thread>
 
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
@@ -33,6 +34,14 @@ DEFINE_int64(
     memory_free_every_n_operations,
     5,
     "Specifies memory free for every N operations. If it is 5, then we free one of existing memory allocation for every 5 memory operations");
+DEFINE_int32(
+    memory_allocation_threads,
+    16,
+    "The number of threads allocating from the same leaf memory pool");
+DEFINE_int64(
+    memory_pool_reservation_cache_bytes,
+    64 << 10,
+    "The per-thread reservation cache bytes of the leaf memory pool");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -432,6 +441,57 @@ BENCHMARK_RELATIVE_MULTI(MmapReallocateMix64) {
   MemoryPoolAllocationBenchMark benchmark(Type::kMmap, 64, 128, 32 << 20);
   return benchmark.runReallocate();
 }
+
+// Allocates and frees small buffers from 'FLAGS_memory_allocation_threads'
+// threads through one shared leaf memory pool with the specified per-thread
+// 'reservationCacheBytes'.
+size_t runConcurrentAllocate(int64_t reservationCacheBytes) {
+  constexpr size_t kMinSize = 128;
+  constexpr size_t kMaxSize = 3072;
+  constexpr size_t kMaxAllocations = 1'000;
+
+  folly::BenchmarkSuspender suspender;
+  MemoryManager manager{
+      MemoryManagerOptions{.poolReservationCacheBytes = reservationCacheBytes}};
+  auto pool = manager.addLeafPool("ConcurrentAllocationBenchMark");
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_memory_allocation_threads);
+  suspender.dismiss();
+
+  for (int32_t i = 0; i < FLAGS_memory_allocation_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(FLAGS_allocation_size_seed + i);
+      std::deque<std::pair<void*, size_t>> allocations;
+      for (auto iter = 0; iter < FLAGS_memory_allocation_count; ++iter) {
+        if ((iter % FLAGS_memory_free_every_n_operations == 0 &&
+             !allocations.empty()) ||
+            allocations.size() >= kMaxAllocations) {
+          pool->free(allocations.front().first, allocations.front().second);
+          allocations.pop_front();
+        }
+        const size_t size =
+            kMinSize + folly::Random::rand32(kMaxSize - kMinSize + 1, rng);
+        allocations.emplace_back(pool->allocate(size), size);
+      }
+      for (const auto& [buffer, size] : allocations) {
+        pool->free(buffer, size);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return FLAGS_memory_allocation_count * FLAGS_memory_allocation_threads;
+}
+
+// Concurrent allocations from a leaf pool shared by multiple threads.
+BENCHMARK_MULTI(ConcurrentAllocateSmall) {
+  return runConcurrentAllocate(0);
+}
+
+BENCHMARK_RELATIVE_MULTI(ConcurrentAllocateSmallReservationCache) {
+  return runConcurrentAllocate(FLAGS_memory_pool_reservation_cache_bytes);
+}
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/memory/MemoryPoolTracer.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+
+DEFINE_string(
+    trace_file,
+    "",
+    "The memory pool trace recorded by MemoryPoolTracer to replay. If empty, "
+    "replays a synthetic trace");
+DEFINE_int32(
+    synthetic_queries,
+    64,
+    "The number of queries in the synthetic trace");
+DEFINE_int64(synthetic_seed, 12345, "Seed for the synthetic trace generator");
+DEFINE_int64(
+    arbitrator_capacity_mb,
+    4096,
+    "The memory capacity shared by the replayed queries");
+DEFINE_string(
+    memory_pool_init_capacity_mb,
+    "128,512",
+    "Comma separated list of the initial query memory pool capacities to "
+    "replay with");
+DEFINE_string(
+    memory_pool_transfer_capacity_mb,
+    "32,128",
+    "Comma separated list of the memory pool transfer capacities to replay "
+    "with");
+DEFINE_string(
+    global_arbitration,
+    "false,true",
+    "Comma separated list of the global arbitration settings to replay with");
+DEFINE_int32(
+    spillable_pct,
+    80,
+    "The percentage of the used memory of a query which can be reclaimed by "
+    "spilling");
+DEFINE_bool(print_queries, false, "If true, prints the result of each query");
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace {
+
+using Event = MemoryPoolTracer::Event;
+
+struct Config {
+  uint64_t poolInitCapacity;
+  uint64_t poolTransferCapacity;
+  bool globalArbitration;
+
+  std::string toString() const {
+    return fmt::format(
+        "initCapacity {} transferCapacity {} globalArbitration {}",
+        succinctBytes(poolInitCapacity),
+        succinctBytes(poolTransferCapacity),
+        globalArbitration);
+  }
+};
+
+struct QueryResult {
+  std::string name;
+  /// The time spent in the reservations which needed to grow the capacity of
+  /// the query memory pool.
+  uint64_t waitTimeUs{0};
+  uint64_t numArbitrations{0};
+  uint64_t spilledBytes{0};
+  bool aborted{false};
+};
+
+class ReplayQuery;
+
+// Reclaims from a replayed query by spilling, i.e. freeing, its most recent
+// allocations.
+class ReplayReclaimer : public MemoryReclaimer {
+ public:
+  explicit ReplayReclaimer(ReplayQuery* query) : query_(query) {}
+
+  bool reclaimableBytes(const MemoryPool& pool, uint64_t& reclaimableBytes)
+      const override;
+
+  uint64_t reclaim(
+      MemoryPool* pool,
+      uint64_t targetBytes,
+      uint64_t maxWaitMs,
+      Stats& stats) override;
+
+  void abort(MemoryPool* pool, const std::exception_ptr& error) override;
+
+ private:
+  ReplayQuery* const query_;
+};
+
+// The replayed state of a traced query. Each traced reservation increase is
+// replayed as an allocation from the query's leaf memory pool, and each
+// decrease frees the most recent allocations. The allocations are never
+// touched so that replaying a trace doesn't need the traced amount of physical
+// memory.
+class ReplayQuery {
+ public:
+  ReplayQuery(MemoryManager& manager, const std::string& name) {
+    result_.name = name;
+    root_ = manager.addRootPool(
+        name, kMaxMemory, std::make_unique<ReplayReclaimer>(this));
+    leaf_ = root_->addLeafChild("replay");
+  }
+
+  ~ReplayQuery() {
+    freeAll();
+  }
+
+  void reserve(uint64_t bytes) {
+    if (result_.aborted) {
+      return;
+    }
+    const bool needsArbitration = bytes > root_->freeBytes();
+    uint64_t reserveTimeUs{0};
+    try {
+      MicrosecondTimer timer(&reserveTimeUs);
+      void* buffer = leaf_->allocate(bytes);
+      allocations_.emplace_back(buffer, bytes);
+      usedBytes_ += bytes;
+    } catch (const VeloxRuntimeError&) {
+      // Either aborted by the arbitrator or failed with exceeded capacity.
+      abort();
+    }
+    if (needsArbitration) {
+      result_.waitTimeUs += reserveTimeUs;
+      ++result_.numArbitrations;
+    }
+  }
+
+  void release(uint64_t bytes) {
+    if (result_.aborted) {
+      return;
+    }
+    // The traced release of spilled memory has nothing left to free.
+    const uint64_t spilledBytes = std::min(bytes, spilledBytes_);
+    spilledBytes_ -= spilledBytes;
+    bytes -= spilledBytes;
+    while (bytes > 0 && !allocations_.empty()) {
+      auto& [buffer, size] = allocations_.back();
+      leaf_->free(buffer, size);
+      usedBytes_ -= size;
+      if (size > bytes) {
+        // Replaces the allocation with a smaller one instead of reallocating
+        // to not touch the allocated memory.
+        size -= bytes;
+        buffer = leaf_->allocate(size);
+        usedBytes_ += size;
+        break;
+      }
+      bytes -= size;
+      allocations_.pop_back();
+    }
+  }
+
+  uint64_t reclaimableBytes() const {
+    if (result_.aborted) {
+      return 0;
+    }
+    return usedBytes_ - nonSpillableBytes();
+  }
+
+  uint64_t spill(uint64_t targetBytes) {
+    if (result_.aborted) {
+      return 0;
+    }
+    const uint64_t nonSpillable = nonSpillableBytes();
+    uint64_t freedBytes{0};
+    while (!allocations_.empty() &&
+           (targetBytes == 0 || freedBytes < targetBytes)) {
+      const auto [buffer, size] = allocations_.back();
+      if (usedBytes_ - size < nonSpillable) {
+        break;
+      }
+      leaf_->free(buffer, size);
+      allocations_.pop_back();
+      usedBytes_ -= size;
+      freedBytes += size;
+    }
+    spilledBytes_ += freedBytes;
+    result_.spilledBytes += freedBytes;
+    return freedBytes;
+  }
+
+  void abort() {
+    result_.aborted = true;
+    freeAll();
+  }
+
+  const QueryResult& result() const {
+    return result_;
+  }
+
+ private:
+  uint64_t nonSpillableBytes() const {
+    return usedBytes_ * (100 - FLAGS_spillable_pct) / 100;
+  }
+
+  void freeAll() {
+    for (const auto& [buffer, size] : allocations_) {
+      leaf_->free(buffer, size);
+    }
+    allocations_.clear();
+    usedBytes_ = 0;
+    spilledBytes_ = 0;
+  }
+
+  std::shared_ptr<MemoryPool> root_;
+  std::shared_ptr<MemoryPool> leaf_;
+  std::vector<std::pair<void*, uint64_t>> allocations_;
+  uint64_t usedBytes_{0};
+  // The traced reservations which have been spilled but not yet released by
+  // the trace.
+  uint64_t spilledBytes_{0};
+  QueryResult result_;
+};
+
+bool ReplayReclaimer::reclaimableBytes(
+    const MemoryPool& /*unused*/,
+    uint64_t& reclaimableBytes) const {
+  reclaimableBytes = query_->reclaimableBytes();
+  return true;
+}
+
+uint64_t ReplayReclaimer::reclaim(
+    MemoryPool* /*unused*/,
+    uint64_t targetBytes,
+    uint64_t /*unused*/,
+    Stats& stats) {
+  const uint64_t reclaimedBytes = query_->spill(targetBytes);
+  stats.reclaimedBytes += reclaimedBytes;
+  return reclaimedBytes;
+}
+
+void ReplayReclaimer::abort(
+    MemoryPool* /*unused*/,
+    const std::exception_ptr& /*unused*/) {
+  query_->abort();
+}
+
+// Generates queries arriving every 100ms, each of which grows its memory in
+// steps of up to 64MB with occasional releases.
+std::vector<Event> syntheticTrace() {
+  std::mt19937 rng(FLAGS_synthetic_seed);
+  std::vector<Event> events;
+  for (int i = 0; i < FLAGS_synthetic_queries; ++i) {
+    const std::string name = fmt::format("query.{}", i);
+    uint64_t timeUs = i * 100'000 + rng() % 50'000;
+    events.push_back(Event{Event::Type::kCreate, timeUs, name});
+    int64_t reservedBytes{0};
+    const int numSteps = 10 + rng() % 90;
+    for (int step = 0; step < numSteps; ++step) {
+      timeUs += 1'000 + rng() % 10'000;
+      int64_t bytes;
+      if (reservedBytes > 0 && rng() % 4 == 0) {
+        const uint64_t releaseMb = 1 + rng() % (reservedBytes >> 20);
+        bytes = -static_cast<int64_t>(releaseMb << 20);
+      } else {
+        bytes = static_cast<int64_t>((1 + rng() % 64) << 20);
+      }
+      reservedBytes += bytes;
+      events.push_back(
+          Event{Event::Type::kReservation, timeUs, name, bytes});
+    }
+    timeUs += 1'000;
+    if (reservedBytes > 0) {
+      events.push_back(
+          Event{Event::Type::kReservation, timeUs, name, -reservedBytes});
+    }
+    events.push_back(Event{Event::Type::kDestroy, timeUs, name});
+  }
+  std::stable_sort(
+      events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.timeUs < rhs.timeUs;
+      });
+  return events;
+}
+
+// Replays 'events' in order on a single thread against a memory manager with
+// a shared arbitrator configured by 'config'. Events of pools created before
+// the trace started are ignored.
+std::vector<QueryResult> replay(
+    const std::vector<Event>& events,
+    const Config& config,
+    std::string& arbitratorStats) {
+  MemoryManagerOptions options;
+  options.allocatorCapacity = FLAGS_arbitrator_capacity_mb << 20;
+  options.arbitratorCapacity = FLAGS_arbitrator_capacity_mb << 20;
+  options.arbitratorKind = "SHARED";
+  options.memoryPoolInitCapacity = config.poolInitCapacity;
+  options.memoryPoolTransferCapacity = config.poolTransferCapacity;
+  options.globalArbitrationEnabled = config.globalArbitration;
+  MemoryManager manager{options};
+
+  std::vector<QueryResult> results;
+  std::unordered_map<std::string, std::unique_ptr<ReplayQuery>> queries;
+  for (const auto& event : events) {
+    if (event.type == Event::Type::kCreate) {
+      VELOX_USER_CHECK_EQ(
+          queries.count(event.pool), 0, "Duplicate pool {}", event.pool);
+      queries.emplace(
+          event.pool, std::make_unique<ReplayQuery>(manager, event.pool));
+      continue;
+    }
+    auto it = queries.find(event.pool);
+    if (it == queries.end()) {
+      continue;
+    }
+    if (event.type == Event::Type::kReservation) {
+      if (event.bytes > 0) {
+        it->second->reserve(event.bytes);
+      } else {
+        it->second->release(-event.bytes);
+      }
+      continue;
+    }
+    results.push_back(it->second->result());
+    queries.erase(it);
+  }
+  for (const auto& [name, query] : queries) {
+    results.push_back(query->result());
+  }
+  queries.clear();
+  arbitratorStats = manager.arbitrator()->stats().toString();
+  return results;
+}
+
+void report(
+    const Config& config,
+    const std::vector<QueryResult>& results,
+    const std::string& arbitratorStats) {
+  uint64_t totalWaitTimeUs{0};
+  uint64_t maxWaitTimeUs{0};
+  uint64_t numArbitrations{0};
+  uint64_t spilledBytes{0};
+  uint64_t numAborted{0};
+  for (const auto& result : results) {
+    totalWaitTimeUs += result.waitTimeUs;
+    maxWaitTimeUs = std::max(maxWaitTimeUs, result.waitTimeUs);
+    numArbitrations += result.numArbitrations;
+    spilledBytes += result.spilledBytes;
+    numAborted += result.aborted;
+  }
+  std::cout << config.toString() << "\n"
+            << fmt::format(
+                   "  queries {} aborted {} arbitrations {} spilled {} wait "
+                   "total {} max {}\n",
+                   results.size(),
+                   numAborted,
+                   numArbitrations,
+                   succinctBytes(spilledBytes),
+                   succinctMicros(totalWaitTimeUs),
+                   succinctMicros(maxWaitTimeUs))
+            << "  " << arbitratorStats << "\n";
+  if (!FLAGS_print_queries) {
+    return;
+  }
+  for (const auto& result : results) {
+    std::cout << fmt::format(
+        "    {} wait {} arbitrations {} spilled {}{}\n",
+        result.name,
+        succinctMicros(result.waitTimeUs),
+        result.numArbitrations,
+        succinctBytes(result.spilledBytes),
+        result.aborted ? " aborted" : "");
+  }
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& list) {
+  std::vector<std::string> values;
+  folly::split(',', list, values, true);
+  VELOX_USER_CHECK(!values.empty(), "Empty list: {}", list);
+  std::vector<T> result;
+  for (const auto& value : values) {
+    result.push_back(folly::to<T>(folly::trimWhitespace(value)));
+  }
+  return result;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  VELOX_USER_CHECK_GE(FLAGS_spillable_pct, 0);
+  VELOX_USER_CHECK_LE(FLAGS_spillable_pct, 100);
+  SharedArbitrator::registerFactory();
+
+  const auto events = FLAGS_trace_file.empty()
+      ? syntheticTrace()
+      : MemoryPoolTracer::read(FLAGS_trace_file);
+  for (const uint64_t initCapacityMb :
+       parseList<uint64_t>(FLAGS_memory_pool_init_capacity_mb)) {
+    for (const uint64_t transferCapacityMb :
+         parseList<uint64_t>(FLAGS_memory_pool_transfer_capacity_mb)) {
+      for (const bool globalArbitration :
+           parseList<bool>(FLAGS_global_arbitration)) {
+        const Config config{
+            initCapacityMb << 20, transferCapacityMb << 20, globalArbitration};
+        std::string arbitratorStats;
+        const auto results = replay(events, config, arbitratorStats);
+        report(config, results, arbitratorStats);
+      }
+    }
+  }
+  return 0;
+}
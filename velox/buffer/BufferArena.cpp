@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/buffer/BufferArena.h"
+
+namespace facebook::velox {
+namespace {
+thread_local BufferArena* currentArena{nullptr};
+
+// Alignment of the buffer headers in a chunk.
+constexpr uint64_t kHeaderAlignment = 64;
+
+// Max number of unreferenced chunks kept for reuse after reset().
+constexpr int32_t kMaxFreeChunks = 4;
+} // namespace
+
+// A Buffer whose header and data are in a chunk of the arena. Releasing the
+// last reference drops the reference to the chunk instead of freeing to the
+// pool.
+class BufferArena::ArenaBuffer : public Buffer {
+ public:
+  ArenaBuffer(Chunk* chunk, uint8_t* data, uint64_t capacity)
+      : Buffer(chunk->pool, data, capacity, true), chunk_(chunk) {
+    chunk_->addRef();
+  }
+
+ protected:
+  void freeToPool() override {
+    auto* chunk = chunk_;
+    this->~ArenaBuffer();
+    chunk->release();
+  }
+
+ private:
+  Chunk* const chunk_;
+};
+
+void BufferArena::Chunk::release() {
+  if (refs.fetch_sub(1) == 1) {
+    auto* chunkPool = pool;
+    this->~Chunk();
+    chunkPool->free(this, kChunkSize);
+  }
+}
+
+BufferArena::~BufferArena() {
+  for (auto* chunk : usedChunks_) {
+    chunk->release();
+  }
+  for (auto* chunk : freeChunks_) {
+    chunk->release();
+  }
+  if (current_ != nullptr) {
+    current_->release();
+  }
+}
+
+BufferPtr BufferArena::allocate(uint64_t capacity) {
+  if (capacity > kMaxBufferSize) {
+    return nullptr;
+  }
+  constexpr uint64_t kHeaderSize = bits::roundUp(sizeof(ArenaBuffer), 16);
+  const uint64_t bytes = kHeaderSize + capacity + simd::kPadding;
+  uint64_t begin = bits::roundUp(offset_, kHeaderAlignment);
+  if (current_ == nullptr || begin + bytes > kChunkSize) {
+    newChunk(bytes);
+    begin = bits::roundUp(offset_, kHeaderAlignment);
+  }
+  auto* header = current_->begin() + begin;
+  auto* data = reinterpret_cast<uint8_t*>(header + kHeaderSize);
+  auto* buffer = new (header) ArenaBuffer(current_, data, capacity);
+  offset_ = begin + bytes;
+  ++stats_.numAllocations;
+  return BufferPtr(buffer);
+}
+
+void BufferArena::newChunk(uint64_t bytes) {
+  VELOX_CHECK_LE(
+      bits::roundUp(sizeof(Chunk), kHeaderAlignment) + bytes, kChunkSize);
+  if (current_ != nullptr) {
+    usedChunks_.push_back(current_);
+  }
+  if (!freeChunks_.empty()) {
+    current_ = freeChunks_.back();
+    freeChunks_.pop_back();
+  } else {
+    current_ = new (pool_->allocate(kChunkSize)) Chunk(pool_);
+    ++stats_.numChunks;
+  }
+  offset_ = sizeof(Chunk);
+}
+
+void BufferArena::reset() {
+  // A chunk with one reference is referenced only by 'this'. The reference
+  // count of a chunk only goes down from other threads, so the check is
+  // stable.
+  for (auto* chunk : usedChunks_) {
+    if (chunk->refs == 1 && freeChunks_.size() < kMaxFreeChunks) {
+      freeChunks_.push_back(chunk);
+      ++stats_.numReusedChunks;
+    } else {
+      chunk->release();
+    }
+  }
+  usedChunks_.clear();
+  if (current_ == nullptr) {
+    return;
+  }
+  if (current_->refs == 1) {
+    if (offset_ > sizeof(Chunk)) {
+      offset_ = sizeof(Chunk);
+      ++stats_.numReusedChunks;
+    }
+  } else {
+    current_->release();
+    current_ = nullptr;
+  }
+}
+
+// static
+BufferArena* BufferArena::current() {
+  return currentArena;
+}
+
+BufferArena::Scope::Scope(BufferArena* arena) : previous_(currentArena) {
+  currentArena = arena;
+}
+
+BufferArena::Scope::~Scope() {
+  currentArena = previous_;
+}
+
+} // namespace facebook::velox
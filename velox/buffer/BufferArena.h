@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+
+namespace facebook::velox {
+
+/// Bump allocator for short-lived Buffers, e.g. the string buffers of the
+/// intermediate results of expression evaluation. Memory is taken from the
+/// pool in chunks of kChunkSize bytes, so the pool's allocator and memory
+/// accounting are called once per chunk instead of once per buffer. The
+/// Buffer header is placed in the chunk next to its data.
+///
+/// Each buffer holds a reference to its chunk, so buffers may outlive a batch
+/// or the arena itself. reset() rewinds the chunks that no buffer references
+/// and lets go of the others, which are freed with their last buffer.
+///
+/// Not thread-safe. Buffers may be released from any thread.
+class BufferArena {
+ public:
+  static constexpr uint64_t kChunkSize = 256 << 10;
+
+  /// Larger buffers are not allocated from the arena.
+  static constexpr uint64_t kMaxBufferSize = kChunkSize / 4;
+
+  struct Stats {
+    /// Number of buffers allocated from the arena.
+    uint64_t numAllocations{0};
+    /// Number of chunks allocated from the pool.
+    uint64_t numChunks{0};
+    /// Number of chunks rewound by reset() for reuse.
+    uint64_t numReusedChunks{0};
+  };
+
+  explicit BufferArena(memory::MemoryPool* pool) : pool_(pool) {}
+
+  ~BufferArena();
+
+  memory::MemoryPool* pool() const {
+    return pool_;
+  }
+
+  /// Returns a mutable buffer with a capacity of at least 'capacity' bytes and
+  /// a size of 0. Returns nullptr if 'capacity' is over kMaxBufferSize.
+  BufferPtr allocate(uint64_t capacity);
+
+  /// Rewinds the chunks that are not referenced by any buffer so that the
+  /// next allocations reuse them.
+  void reset();
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  /// Returns the arena installed for the calling thread by a Scope or nullptr.
+  static BufferArena* current();
+
+  /// Installs 'arena' as current() for the lifetime of 'this' and restores
+  /// the previous arena on destruction.
+  class Scope {
+   public:
+    explicit Scope(BufferArena* arena);
+
+    ~Scope();
+
+   private:
+    BufferArena* const previous_;
+  };
+
+ private:
+  // Header at the start of each chunk. The arena and each buffer in the chunk
+  // hold a reference.
+  struct Chunk {
+    std::atomic<int32_t> refs{1};
+    memory::MemoryPool* const pool;
+
+    explicit Chunk(memory::MemoryPool* _pool) : pool(_pool) {}
+
+    char* begin() {
+      return reinterpret_cast<char*>(this);
+    }
+
+    void addRef() {
+      refs.fetch_add(1);
+    }
+
+    void release();
+  };
+
+  class ArenaBuffer;
+
+  // Makes 'current_' a chunk with at least 'bytes' free bytes.
+  void newChunk(uint64_t bytes);
+
+  memory::MemoryPool* const pool_;
+
+  // The chunk allocations are carved from. nullptr before the first
+  // allocation.
+  Chunk* current_{nullptr};
+
+  // Offset of the first free byte of 'current_'.
+  uint64_t offset_{0};
+
+  // Chunks rewound by reset() that are not referenced by any buffer.
+  std::vector<Chunk*> freeChunks_;
+
+  // The chunks other than 'current_' that have buffers carved out of them
+  // since the last reset().
+  std::vector<Chunk*> usedChunks_;
+
+  Stats stats_;
+};
+
+} // namespace facebook::velox
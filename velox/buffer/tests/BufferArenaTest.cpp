@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/buffer/BufferArena.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox {
+namespace {
+
+class BufferArenaTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    pool_ = memoryManager_.addLeafPool("BufferArenaTest");
+  }
+
+  memory::MemoryManager memoryManager_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(BufferArenaTest, allocate) {
+  BufferArena arena(pool_.get());
+  std::vector<BufferPtr> buffers;
+  for (auto i = 0; i < 10; ++i) {
+    auto buffer = arena.allocate(1'000 + i);
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(buffer->size(), 0);
+    EXPECT_GE(buffer->capacity(), 1'000 + i);
+    EXPECT_TRUE(buffer->isMutable());
+    EXPECT_EQ(buffer->pool(), pool_.get());
+    buffer->setSize(1'000 + i);
+    memset(buffer->asMutable<char>(), i, buffer->size());
+    buffers.push_back(std::move(buffer));
+  }
+  for (auto i = 0; i < buffers.size(); ++i) {
+    const auto* data = buffers[i]->as<char>();
+    for (auto j = 0; j < buffers[i]->size(); ++j) {
+      ASSERT_EQ(data[j], i);
+    }
+  }
+  EXPECT_EQ(arena.stats().numAllocations, 10);
+  EXPECT_EQ(arena.stats().numChunks, 1);
+  // The pool sees one allocation of the chunk size.
+  EXPECT_EQ(pool_->stats().numAllocs, 1);
+
+  // Buffers over the max size are not allocated from the arena.
+  EXPECT_EQ(arena.allocate(BufferArena::kMaxBufferSize + 1), nullptr);
+
+  // Filling up a chunk starts a new one.
+  for (auto i = 0; i < 8; ++i) {
+    buffers.push_back(arena.allocate(BufferArena::kMaxBufferSize));
+  }
+  EXPECT_EQ(arena.stats().numChunks, 3);
+}
+
+TEST_F(BufferArenaTest, reset) {
+  BufferArena arena(pool_.get());
+  auto buffer = arena.allocate(100);
+  arena.reset();
+  // 'buffer' keeps its chunk alive.
+  EXPECT_EQ(arena.stats().numReusedChunks, 0);
+  EXPECT_GT(pool_->usedBytes(), 0);
+
+  auto other = arena.allocate(100);
+  EXPECT_EQ(arena.stats().numChunks, 2);
+  buffer = nullptr;
+  other = nullptr;
+
+  // The chunk of 'other' is reused after reset().
+  arena.reset();
+  EXPECT_EQ(arena.stats().numReusedChunks, 1);
+  other = arena.allocate(100);
+  EXPECT_EQ(arena.stats().numChunks, 2);
+}
+
+TEST_F(BufferArenaTest, outliveArena) {
+  BufferPtr buffer;
+  {
+    BufferArena arena(pool_.get());
+    buffer = arena.allocate(100);
+    buffer->setSize(5);
+    memcpy(buffer->asMutable<char>(), "arena", 5);
+  }
+  EXPECT_EQ(std::string_view(buffer->as<char>(), buffer->size()), "arena");
+  EXPECT_GT(pool_->usedBytes(), 0);
+  buffer = nullptr;
+  EXPECT_EQ(pool_->usedBytes(), 0);
+}
+
+TEST_F(BufferArenaTest, scope) {
+  BufferArena arena(pool_.get());
+  BufferArena other(pool_.get());
+  EXPECT_EQ(BufferArena::current(), nullptr);
+  {
+    BufferArena::Scope scope(&arena);
+    EXPECT_EQ(BufferArena::current(), &arena);
+    {
+      BufferArena::Scope otherScope(&other);
+      EXPECT_EQ(BufferArena::current(), &other);
+    }
+    EXPECT_EQ(BufferArena::current(), &arena);
+  }
+  EXPECT_EQ(BufferArena::current(), nullptr);
+}
+
+} // namespace
+} // namespace facebook::velox
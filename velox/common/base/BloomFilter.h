@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -61,6 +63,56 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Adds the 'size' hashed values in 'hashes'. Same as insert() for each
+  // value, but computes the masks and word indices a SIMD batch at a time.
+  void insert(const uint64_t* hashes, int32_t size) {
+    constexpr int32_t kBatch = xsimd::batch<int64_t>::size;
+    const auto bloomSize = bits_.size();
+    int32_t i = 0;
+    for (; i + kBatch <= size; i += kBatch) {
+      auto batch = loadHashes(hashes + i);
+      int64_t masks[kBatch];
+      int64_t indices[kBatch];
+      bloomMask(batch).store_unaligned(masks);
+      bloomIndex(bloomSize, batch).store_unaligned(indices);
+      // Lanes may set bits in the same word, so the words are updated one at a
+      // time.
+      for (auto lane = 0; lane < kBatch; ++lane) {
+        bits_[indices[lane]] |= masks[lane];
+      }
+    }
+    for (; i < size; ++i) {
+      set(bits_.data(), bloomSize, hashes[i]);
+    }
+  }
+
+  // Sets bit 'i' of 'result' to mayContain(hashes[i]) for the 'size' hashed
+  // values in 'hashes' and clears the other bits of the last word. The words
+  // of the filter are gathered a SIMD batch at a time.
+  void mayContain(const uint64_t* hashes, int32_t size, uint64_t* result)
+      const {
+    constexpr int32_t kBatch = xsimd::batch<int64_t>::size;
+    static_assert(64 % kBatch == 0);
+    std::fill(result, result + bits::nwords(size), 0);
+    const auto* bloom = reinterpret_cast<const int64_t*>(bits_.data());
+    const auto bloomSize = bits_.size();
+    int32_t i = 0;
+    for (; i + kBatch <= size; i += kBatch) {
+      auto batch = loadHashes(hashes + i);
+      auto mask = bloomMask(batch);
+      int64_t indices[kBatch];
+      bloomIndex(bloomSize, batch).store_unaligned(indices);
+      auto words = simd::gather(bloom, indices);
+      const uint64_t found = simd::toBitMask((words & mask) == mask);
+      result[i / 64] |= found << (i % 64);
+    }
+    for (; i < size; ++i) {
+      if (test(bits_.data(), bloomSize, hashes[i])) {
+        bits::setBit(result, i);
+      }
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -113,6 +165,29 @@ class BloomFilter {
     return ((hashCode >> 24) & (bloomSize - 1));
   }
 
+  // Batch versions of the above. The hashes are handled as signed so that all
+  // operations have SIMD support.
+  inline static xsimd::batch<int64_t> loadHashes(const uint64_t* hashes) {
+    return xsimd::batch<int64_t>::load_unaligned(
+        reinterpret_cast<const int64_t*>(hashes));
+  }
+
+  inline static xsimd::batch<int64_t> bloomMask(
+      xsimd::batch<int64_t> hashCodes) {
+    const xsimd::batch<int64_t> one(1);
+    const xsimd::batch<int64_t> bitMask(63);
+    return (one << (hashCodes & bitMask)) |
+        (one << ((hashCodes >> 6) & bitMask)) |
+        (one << ((hashCodes >> 12) & bitMask)) |
+        (one << ((hashCodes >> 18) & bitMask));
+  }
+
+  inline static xsimd::batch<int64_t> bloomIndex(
+      uint32_t bloomSize,
+      xsimd::batch<int64_t> hashCodes) {
+    return (hashCodes >> 24) & xsimd::batch<int64_t>(bloomSize - 1);
+  }
+
   inline static void
   set(uint64_t* bloom, int32_t bloomSize, uint64_t hashCode) {
     auto mask = bloomMask(hashCode);
@@ -253,9 +253,69 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricSsdCacheCheckpointsWritten, facebook::velox::StatType::SUM);
 
+  // Total number of batches of entry additions and evictions written to the
+  // delta log between checkpoints.
+  DEFINE_METRIC(
+      kMetricSsdCacheDeltaLogsWritten, facebook::velox::StatType::SUM);
+
   // Total number of cache regions evicted.
   DEFINE_METRIC(kMetricSsdCacheRegionsEvicted, facebook::velox::StatType::SUM);
 
+  // Total number of entries offered for SSD write that the admission policy
+  // accepted.
+  DEFINE_METRIC(kMetricSsdCacheAdmittedEntries, facebook::velox::StatType::SUM);
+
+  // Total number of entries offered for SSD write that the admission policy
+  // rejected.
+  DEFINE_METRIC(kMetricSsdCacheRejectedEntries, facebook::velox::StatType::SUM);
+
+  /// ================== Cache Heat Map Counters ==================
+  /// Reported if the periodic stats reporter is given an enabled heat map.
+
+  // Bytes that scans planned to read.
+  DEFINE_METRIC(
+      kMetricCacheHeatMapReferencedBytes, facebook::velox::StatType::SUM);
+
+  // Bytes that scans read.
+  DEFINE_METRIC(kMetricCacheHeatMapReadBytes, facebook::velox::StatType::SUM);
+
+  // Bytes that scans found in the memory cache.
+  DEFINE_METRIC(kMetricCacheHeatMapRamBytes, facebook::velox::StatType::SUM);
+
+  // Bytes that scans loaded from the SSD cache.
+  DEFINE_METRIC(kMetricCacheHeatMapSsdBytes, facebook::velox::StatType::SUM);
+
+  // Bytes that scans loaded from remote storage.
+  DEFINE_METRIC(
+      kMetricCacheHeatMapStorageBytes, facebook::velox::StatType::SUM);
+
+  // Bytes that scans loaded ahead of use from SSD or storage.
+  DEFINE_METRIC(
+      kMetricCacheHeatMapPrefetchBytes, facebook::velox::StatType::SUM);
+
+  // Prefetched bytes that scans used.
+  DEFINE_METRIC(
+      kMetricCacheHeatMapPrefetchHitBytes, facebook::velox::StatType::SUM);
+
+  // Prefetched bytes that were evicted from the memory cache before use.
+  DEFINE_METRIC(
+      kMetricCacheHeatMapPrefetchWastedBytes, facebook::velox::StatType::SUM);
+
+  /// ================== Cache Warm Counters ==================
+  /// Reported by the Hive connector's CacheWarmer.
+
+  // Files whose predicted columns were loaded into the cache.
+  DEFINE_METRIC(kMetricCacheWarmFiles, facebook::velox::StatType::COUNT);
+
+  // Files not warmed because too many files were pending.
+  DEFINE_METRIC(kMetricCacheWarmSkippedFiles, facebook::velox::StatType::COUNT);
+
+  // Bytes read from storage to warm the cache.
+  DEFINE_METRIC(kMetricCacheWarmBytes, facebook::velox::StatType::SUM);
+
+  // Bytes of warmed cache entries that queries found in the memory cache.
+  DEFINE_METRIC(kMetricCacheWarmHitBytes, facebook::velox::StatType::SUM);
+
   /// ================== Memory Arbitration Counters =================
 
   // The number of arbitration requests.
@@ -354,6 +414,37 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricArbitratorWaitTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
 
+  // The distributions of the arbitration wait time as above for the
+  // arbitration requests from low, normal and high priority queries
+  // respectively.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorLowPriorityWaitTimeMs,
+      30'000,
+      0,
+      600'000,
+      50,
+      90,
+      99,
+      100);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorNormalPriorityWaitTimeMs,
+      30'000,
+      0,
+      600'000,
+      50,
+      90,
+      99,
+      100);
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorHighPriorityWaitTimeMs,
+      30'000,
+      0,
+      600'000,
+      50,
+      90,
+      99,
+      100);
+
   // The distribution of the amount of time it takes to complete a single
   // arbitration request stays queued in range of [0, 600s] with 20
   // buckets. It is configured to report the latency at P50, P90, P99,
@@ -487,5 +578,28 @@ void registerVeloxMetrics() {
   // percentiles.
   DEFINE_HISTOGRAM_METRIC(
       kMetricExchangeDataSize, 1L << 20, 0, 128L << 20, 50, 90, 99, 100);
+
+  // The bytes uploaded to object stores by the parallel part uploads of GCS
+  // and ABFS files.
+  DEFINE_METRIC(
+      kMetricObjectStoreUploadedBytes, facebook::velox::StatType::SUM);
+
+  // The distribution of the time to upload a part or block of a GCS or ABFS
+  // file in range of [0, 60s] with 60 buckets. It is configured to report the
+  // latency at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricObjectStorePartUploadTimeMs, 1'000, 0, 60'000, 50, 90, 99, 100);
+
+  // The distribution of the upload bandwidth of GCS and ABFS files in MB per
+  // second from open to close in range of [0, 2000] with 100 buckets. It is
+  // configured to report the bandwidth at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricObjectStoreUploadMBPerSec, 20, 0, 2'000, 50, 90, 99, 100);
+
+  // The distribution of the latency of reads from remote storage that missed
+  // the memory and SSD caches in range of [0, 2s] with 100 buckets. It is
+  // configured to report latency at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricStorageReadLatencyMs, 20, 0, 2'000, 50, 90, 99, 100);
 }
 } // namespace facebook::velox
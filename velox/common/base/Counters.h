@@ -94,6 +94,15 @@ constexpr folly::StringPiece kMetricArbitratorArbitrationTimeMs{
 constexpr folly::StringPiece kMetricArbitratorWaitTimeMs{
     "velox.arbitrator_wait_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorLowPriorityWaitTimeMs{
+    "velox.arbitrator_low_priority_wait_time_ms"};
+
+constexpr folly::StringPiece kMetricArbitratorNormalPriorityWaitTimeMs{
+    "velox.arbitrator_normal_priority_wait_time_ms"};
+
+constexpr folly::StringPiece kMetricArbitratorHighPriorityWaitTimeMs{
+    "velox.arbitrator_high_priority_wait_time_ms"};
+
 constexpr folly::StringPiece kMetricArbitratorFreeCapacityBytes{
     "velox.arbitrator_free_capacity_bytes"};
 
@@ -290,9 +299,52 @@ constexpr folly::StringPiece kMetricSsdCacheCheckpointsRead{
 constexpr folly::StringPiece kMetricSsdCacheCheckpointsWritten{
     "velox.ssd_cache_checkpoints_written"};
 
+constexpr folly::StringPiece kMetricSsdCacheDeltaLogsWritten{
+    "velox.ssd_cache_delta_logs_written"};
+
 constexpr folly::StringPiece kMetricSsdCacheRegionsEvicted{
     "velox.ssd_cache_regions_evicted"};
 
+constexpr folly::StringPiece kMetricSsdCacheAdmittedEntries{
+    "velox.ssd_cache_admitted_entries"};
+
+constexpr folly::StringPiece kMetricSsdCacheRejectedEntries{
+    "velox.ssd_cache_rejected_entries"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapReferencedBytes{
+    "velox.cache_heat_map_referenced_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapReadBytes{
+    "velox.cache_heat_map_read_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapRamBytes{
+    "velox.cache_heat_map_ram_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapSsdBytes{
+    "velox.cache_heat_map_ssd_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapStorageBytes{
+    "velox.cache_heat_map_storage_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapPrefetchBytes{
+    "velox.cache_heat_map_prefetch_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapPrefetchHitBytes{
+    "velox.cache_heat_map_prefetch_hit_bytes"};
+
+constexpr folly::StringPiece kMetricCacheHeatMapPrefetchWastedBytes{
+    "velox.cache_heat_map_prefetch_wasted_bytes"};
+
+constexpr folly::StringPiece kMetricCacheWarmFiles{"velox.cache_warm_files"};
+
+constexpr folly::StringPiece kMetricCacheWarmSkippedFiles{
+    "velox.cache_warm_skipped_files"};
+
+constexpr folly::StringPiece kMetricCacheWarmBytes{"velox.cache_warm_bytes"};
+
+constexpr folly::StringPiece kMetricCacheWarmHitBytes{
+    "velox.cache_warm_hit_bytes"};
+
 constexpr folly::StringPiece kMetricExchangeDataTimeMs{
     "velox.exchange_data_time_ms"};
 
@@ -304,4 +356,16 @@ constexpr folly::StringPiece kMetricExchangeDataBytes{
 
 constexpr folly::StringPiece kMetricExchangeDataSize{
     "velox.exchange_data_size"};
+
+constexpr folly::StringPiece kMetricObjectStoreUploadedBytes{
+    "velox.object_store_uploaded_bytes"};
+
+constexpr folly::StringPiece kMetricObjectStorePartUploadTimeMs{
+    "velox.object_store_part_upload_time_ms"};
+
+constexpr folly::StringPiece kMetricObjectStoreUploadMBPerSec{
+    "velox.object_store_upload_mb_per_sec"};
+
+constexpr folly::StringPiece kMetricStorageReadLatencyMs{
+    "velox.storage_read_latency_ms"};
 } // namespace facebook::velox
@@ -63,6 +63,7 @@ PeriodicStatsReporter::PeriodicStatsReporter(const Options& options)
       cache_(options.cache),
       arbitrator_(options.arbitrator),
       spillMemoryPool_(options.spillMemoryPool),
+      cacheHeatMap_(options.cacheHeatMap),
       options_(options) {}
 
 void PeriodicStatsReporter::start() {
@@ -84,6 +85,10 @@ void PeriodicStatsReporter::start() {
       "report_spill_stats",
       [this]() { reportSpillStats(); },
       options_.spillStatsIntervalMs);
+  addTask(
+      "report_cache_heat_map_stats",
+      [this]() { reportCacheHeatMapStats(); },
+      options_.cacheHeatMapStatsIntervalMs);
 }
 
 void PeriodicStatsReporter::stop() {
@@ -218,12 +223,18 @@ void PeriodicStatsReporter::reportCacheStats() {
         kMetricSsdCacheCheckpointsRead, deltaSsdStats.checkpointsRead);
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheCheckpointsWritten, deltaSsdStats.checkpointsWritten);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheDeltaLogsWritten, deltaSsdStats.deltaLogsWritten);
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheRegionsEvicted, deltaSsdStats.regionsEvicted);
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheAgedOutEntries, deltaSsdStats.entriesAgedOut)
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheAgedOutRegions, deltaSsdStats.regionsAgedOut);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheAdmittedEntries, deltaSsdStats.entriesAdmitted);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheRejectedEntries, deltaSsdStats.entriesRejected);
   }
 
   // TTL controler snapshot stats.
@@ -249,4 +260,27 @@ void PeriodicStatsReporter::reportSpillStats() {
   RECORD_METRIC_VALUE(kMetricSpillPeakMemoryBytes, spillMemoryStats.peakBytes);
 }
 
+void PeriodicStatsReporter::reportCacheHeatMapStats() {
+  if (cacheHeatMap_ == nullptr || !cacheHeatMap_->enabled()) {
+    return;
+  }
+  const auto totals = cacheHeatMap_->totals();
+  const auto delta = totals - lastHeatMapTotals_;
+  if (delta == cache::HeatMapCounters{}) {
+    return;
+  }
+  REPORT_IF_NOT_ZERO(kMetricCacheHeatMapReferencedBytes, delta.referencedBytes);
+  REPORT_IF_NOT_ZERO(kMetricCacheHeatMapReadBytes, delta.readBytes);
+  REPORT_IF_NOT_ZERO(kMetricCacheHeatMapRamBytes, delta.ramBytes);
+  REPORT_IF_NOT_ZERO(kMetricCacheHeatMapSsdBytes, delta.ssdBytes);
+  REPORT_IF_NOT_ZERO(kMetricCacheHeatMapStorageBytes, delta.storageBytes);
+  REPORT_IF_NOT_ZERO(kMetricCacheHeatMapPrefetchBytes, delta.prefetchBytes);
+  REPORT_IF_NOT_ZERO(
+      kMetricCacheHeatMapPrefetchHitBytes, delta.prefetchHitBytes);
+  REPORT_IF_NOT_ZERO(
+      kMetricCacheHeatMapPrefetchWastedBytes, delta.prefetchWastedBytes);
+  LOG(INFO) << cacheHeatMap_->toString(options_.cacheHeatMapLogEntries);
+  lastHeatMapTotals_ = totals;
+}
+
 } // namespace facebook::velox
@@ -18,6 +18,7 @@
 
 #include <folly/experimental/ThreadedRepeatingFunctionRunner.h>
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/caching/SsdFile.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 
@@ -53,14 +54,23 @@ class PeriodicStatsReporter {
     const memory::MemoryPool* spillMemoryPool{nullptr};
     uint64_t spillStatsIntervalMs{60'000};
 
+    /// Usually cache::cacheHeatMap(), which must be enabled for scans to
+    /// record in it.
+    const velox::cache::CacheHeatMap* cacheHeatMap{nullptr};
+    uint64_t cacheHeatMapStatsIntervalMs{60'000};
+    /// Number of the hottest file group and column pairs that are logged.
+    int32_t cacheHeatMapLogEntries{20};
+
     std::string toString() const {
       return fmt::format(
           "allocatorStatsIntervalMs:{}, cacheStatsIntervalMs:{}, "
-          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}",
+          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}, "
+          "cacheHeatMapStatsIntervalMs:{}",
           allocatorStatsIntervalMs,
           cacheStatsIntervalMs,
           arbitratorStatsIntervalMs,
-          spillStatsIntervalMs);
+          spillStatsIntervalMs,
+          cacheHeatMapStatsIntervalMs);
     }
   };
 
@@ -95,14 +105,17 @@ class PeriodicStatsReporter {
   void reportAllocatorStats();
   void reportArbitratorStats();
   void reportSpillStats();
+  void reportCacheHeatMapStats();
 
   const velox::memory::MemoryAllocator* const allocator_{nullptr};
   const velox::cache::AsyncDataCache* const cache_{nullptr};
   const velox::memory::MemoryArbitrator* const arbitrator_{nullptr};
   const velox::memory::MemoryPool* const spillMemoryPool_{nullptr};
+  const velox::cache::CacheHeatMap* const cacheHeatMap_{nullptr};
   const Options options_;
 
   cache::CacheStats lastCacheStats_;
+  cache::HeatMapCounters lastHeatMapTotals_;
 
   folly::ThreadedRepeatingFunctionRunner scheduler_;
 };
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace facebook::velox::common {
+
+/// Specifies the config for prefix-sort.
+struct PrefixSortConfig {
+  PrefixSortConfig(
+      uint32_t maxNormalizedKeySize,
+      uint32_t threshold = 130,
+      uint32_t maxStringPrefixLength = 16,
+      uint32_t radixSortMinRows = 1024,
+      uint32_t radixSortMaxKeySize = 32)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        maxStringPrefixLength(maxStringPrefixLength),
+        radixSortMinRows(radixSortMinRows),
+        radixSortMaxKeySize(radixSortMaxKeySize) {}
+
+  /// Max number of bytes can store normalized keys in prefix-sort buffer per
+  /// entry.
+  uint32_t maxNormalizedKeySize;
+
+  /// PrefixSort will have performance regression when the dateset is too small.
+  /// The threshold is set to 100 according to the benchmark test results by
+  /// default.
+  int64_t threshold;
+
+  /// Number of leading bytes of a string key that are normalized into the
+  /// prefix. Rows whose string prefixes are equal are compared on the full
+  /// values.
+  uint32_t maxStringPrefixLength;
+
+  /// Minimum number of rows to sort the normalized keys with a radix sort
+  /// instead of a quick sort. Radix sort is not used if this is 0.
+  uint32_t radixSortMinRows;
+
+  /// Maximum number of bytes of normalized keys per row, including padding, to
+  /// sort them with a radix sort. Each byte of the keys may take one pass over
+  /// the rows.
+  uint32_t radixSortMaxKeySize;
+};
+} // namespace facebook::velox::common
@@ -16,22 +16,116 @@
 
 #include <folly/ThreadLocal.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/SuccinctPrinter.h"
 
 namespace facebook::velox {
 
+// static
+int32_t RuntimeHistogram::bucket(int64_t value) {
+  if (value < kNumSubBuckets) {
+    return std::max<int64_t>(value, 0);
+  }
+  const int32_t exponent = 63 - __builtin_clzll(value);
+  const int32_t subBucket =
+      (value >> (exponent - kSubBucketBits)) & (kNumSubBuckets - 1);
+  return kNumSubBuckets + (exponent - kSubBucketBits) * kNumSubBuckets +
+      subBucket;
+}
+
+// static
+int64_t RuntimeHistogram::lowerBound(int32_t bucket) {
+  if (bucket < kNumSubBuckets) {
+    return bucket;
+  }
+  const int32_t shift = (bucket - kNumSubBuckets) / kNumSubBuckets;
+  const int64_t subBucket = (bucket - kNumSubBuckets) % kNumSubBuckets;
+  return (kNumSubBuckets + subBucket) << shift;
+}
+
+void RuntimeHistogram::merge(const RuntimeHistogram& other) {
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+}
+
+int64_t RuntimeHistogram::percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto rank = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(percentile / 100 * count_)));
+  int64_t numBelow = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    numBelow += counts_[i];
+    if (numBelow >= rank) {
+      if (i == kNumBuckets - 1) {
+        return lowerBound(i);
+      }
+      return lowerBound(i) + (lowerBound(i + 1) - 1 - lowerBound(i)) / 2;
+    }
+  }
+  VELOX_UNREACHABLE();
+}
+
+RuntimeMetric::RuntimeMetric(const RuntimeMetric& other)
+    : unit(other.unit),
+      sum(other.sum),
+      count(other.count),
+      min(other.min),
+      max(other.max),
+      histogram(
+          other.histogram
+              ? std::make_unique<RuntimeHistogram>(*other.histogram)
+              : nullptr) {}
+
+RuntimeMetric& RuntimeMetric::operator=(const RuntimeMetric& other) {
+  if (this != &other) {
+    unit = other.unit;
+    sum = other.sum;
+    count = other.count;
+    min = other.min;
+    max = other.max;
+    histogram = other.histogram
+        ? std::make_unique<RuntimeHistogram>(*other.histogram)
+        : nullptr;
+  }
+  return *this;
+}
+
 void RuntimeMetric::addValue(int64_t value) {
   sum += value;
   count++;
   min = std::min(min, value);
   max = std::max(max, value);
+  if (histogram != nullptr) {
+    histogram->add(value);
+  }
+}
+
+int64_t RuntimeMetric::percentile(double percentile) const {
+  VELOX_CHECK_NOT_NULL(histogram);
+  if (count == 0) {
+    return 0;
+  }
+  if (percentile <= 0) {
+    return min;
+  }
+  if (percentile >= 100) {
+    return max;
+  }
+  return std::clamp(histogram->percentile(percentile), min, max);
 }
 
 void RuntimeMetric::aggregate() {
   count = std::min(count, static_cast<int64_t>(1));
   min = max = sum;
+  histogram = nullptr;
 }
 
 void RuntimeMetric::merge(const RuntimeMetric& other)
@@ -46,6 +140,10 @@ void RuntimeMetric::merge(const RuntimeMetric& other)
   count += other.count;
   min = std::min(min, other.min);
   max = std::max(max, other.max);
+  if (other.histogram != nullptr) {
+    enableHistogram();
+    histogram->merge(*other.histogram);
+  }
 }
 
 void RuntimeMetric::printMetric(std::stringstream& stream) const {
@@ -54,16 +152,30 @@ void RuntimeMetric::printMetric(std::stringstream& stream) const {
       stream << " sum: " << succinctNanos(sum) << ", count: " << count
              << ", min: " << succinctNanos(min)
              << ", max: " << succinctNanos(max);
+      if (histogram != nullptr) {
+        stream << ", p50: " << succinctNanos(percentile(50))
+               << ", p90: " << succinctNanos(percentile(90))
+               << ", p99: " << succinctNanos(percentile(99));
+      }
       break;
     case RuntimeCounter::Unit::kBytes:
       stream << " sum: " << succinctBytes(sum) << ", count: " << count
              << ", min: " << succinctBytes(min)
              << ", max: " << succinctBytes(max);
+      if (histogram != nullptr) {
+        stream << ", p50: " << succinctBytes(percentile(50))
+               << ", p90: " << succinctBytes(percentile(90))
+               << ", p99: " << succinctBytes(percentile(99));
+      }
       break;
     case RuntimeCounter::Unit::kNone:
     default:
       stream << " sum: " << sum << ", count: " << count << ", min: " << min
              << ", max: " << max;
+      if (histogram != nullptr) {
+        stream << ", p50: " << percentile(50) << ", p90: " << percentile(90)
+               << ", p99: " << percentile(99);
+      }
   }
 }
 
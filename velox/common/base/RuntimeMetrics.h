@@ -18,7 +18,9 @@
 
 #include <fmt/format.h>
 #include <folly/CppAttributes.h>
+#include <array>
 #include <limits>
+#include <memory>
 #include <sstream>
 
 namespace facebook::velox {
@@ -27,9 +29,51 @@ struct RuntimeCounter {
   enum class Unit { kNone, kNanos, kBytes };
   int64_t value;
   Unit unit{Unit::kNone};
+  // If true, the metric of the stat keeps the distribution of the values,
+  // e.g. of the latencies of single reads.
+  bool histogram{false};
+
+  explicit RuntimeCounter(
+      int64_t _value,
+      Unit _unit = Unit::kNone,
+      bool _histogram = false)
+      : value(_value), unit(_unit), histogram(_histogram) {}
+};
+
+/// Counts values in log-linear buckets: each power of 2 is split in 4
+/// buckets of equal width, so that a percentile is within 25% of the exact
+/// value. Uses a fixed 2KB and merges by adding the counts.
+class RuntimeHistogram {
+ public:
+  static constexpr int32_t kSubBucketBits = 2;
+  static constexpr int32_t kNumSubBuckets = 1 << kSubBucketBits;
+  static constexpr int32_t kNumBuckets =
+      kNumSubBuckets + (63 - kSubBucketBits) * kNumSubBuckets;
+
+  /// Adds 'value'. Negative values are counted as 0.
+  void add(int64_t value) {
+    ++counts_[bucket(value)];
+    ++count_;
+  }
+
+  void merge(const RuntimeHistogram& other);
+
+  int64_t count() const {
+    return count_;
+  }
+
+  /// Returns the middle of the bucket that has the 'percentile' (0 - 100)
+  /// value. 0 if empty.
+  int64_t percentile(double percentile) const;
+
+  static int32_t bucket(int64_t value);
 
-  explicit RuntimeCounter(int64_t _value, Unit _unit = Unit::kNone)
-      : value(_value), unit(_unit) {}
+  /// Returns the smallest value in 'bucket'.
+  static int64_t lowerBound(int32_t bucket);
+
+ private:
+  std::array<int64_t, kNumBuckets> counts_{};
+  int64_t count_{0};
 };
 
 struct RuntimeMetric {
@@ -39,6 +83,8 @@ struct RuntimeMetric {
   int64_t count{0};
   int64_t min{std::numeric_limits<int64_t>::max()};
   int64_t max{std::numeric_limits<int64_t>::min()};
+  // The distribution of the values if enabled by enableHistogram().
+  std::unique_ptr<RuntimeHistogram> histogram;
 
   explicit RuntimeMetric(
       RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
@@ -49,10 +95,29 @@ struct RuntimeMetric {
       RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
       : unit(_unit), sum{value}, count{1}, min{value}, max{value} {}
 
+  RuntimeMetric(const RuntimeMetric& other);
+
+  RuntimeMetric(RuntimeMetric&& other) = default;
+
+  RuntimeMetric& operator=(const RuntimeMetric& other);
+
+  RuntimeMetric& operator=(RuntimeMetric&& other) = default;
+
   void addValue(int64_t value);
 
+  /// Starts keeping the distribution of the values added after this.
+  void enableHistogram() {
+    if (histogram == nullptr) {
+      histogram = std::make_unique<RuntimeHistogram>();
+    }
+  }
+
+  /// Returns the 'percentile' (0 - 100) value within the accuracy of
+  /// RuntimeHistogram, clamped to [min, max]. Requires the histogram.
+  int64_t percentile(double percentile) const;
+
   /// Aggregate sets 'min' and 'max' to 'sum', also sets 'count' to 1 if
-  /// positive.
+  /// positive. Drops the histogram.
   void aggregate();
 
   void printMetric(std::stringstream& stream) const;
@@ -60,6 +125,17 @@ struct RuntimeMetric {
   void merge(const RuntimeMetric& other);
 
   std::string toString() const {
+    if (histogram != nullptr) {
+      return fmt::format(
+          "sum:{}, count:{}, min:{}, max:{}, p50:{}, p90:{}, p99:{}",
+          sum,
+          count,
+          min,
+          max,
+          percentile(50),
+          percentile(90),
+          percentile(99));
+    }
     return fmt::format(
         "sum:{}, count:{}, min:{}, max:{}", sum, count, min, max);
   }
@@ -18,6 +18,7 @@
 
 #include <folly/chrono/Hardware.h>
 #include <cstdint>
+#include <limits>
 
 namespace facebook {
 namespace velox {
@@ -35,6 +36,17 @@ class SelectivityInfo {
     return timeClocks_ / static_cast<float>(numIn_ - numOut_);
   }
 
+  /// Returns timeToDropValue(), i.e. cost / (1 - selectivity), for ordering
+  /// filters. The lower the value, the earlier a filter should run. A filter
+  /// that has dropped no rows gets the largest value, so that it is ordered
+  /// after all filters that drop rows.
+  float costPerDroppedRow() const {
+    if (numIn_ <= numOut_) {
+      return std::numeric_limits<float>::max();
+    }
+    return timeToDropValue();
+  }
+
   bool operator<(const SelectivityInfo& right) const {
     return timeToDropValue() < right.timeToDropValue();
   }
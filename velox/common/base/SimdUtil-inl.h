@@ -15,6 +15,7 @@
  */
 
 #include <numeric>
+#include <type_traits>
 
 #if XSIMD_WITH_NEON
 namespace xsimd::types {
@@ -185,6 +186,11 @@ int32_t indicesOfSetBits(
   if (end <= begin) {
     return 0;
   }
+  if constexpr (std::is_same_v<A, xsimd::default_arch>) {
+    if (detail::useAvx512Compress) {
+      return detail::indicesOfSetBitsAvx512(bits, begin, end, result);
+    }
+  }
   int32_t row = begin & ~63;
   auto originalResult = result;
   int32_t endWord = bits::roundUp(end, 64) / 64;
@@ -1436,4 +1442,58 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+size_t simdStrstr(
+    const char* data,
+    size_t size,
+    const char* needle,
+    size_t needleSize,
+    const A&) {
+  if (needleSize == 0) {
+    return 0;
+  }
+  if (needleSize > size) {
+    return std::string_view::npos;
+  }
+  if (needleSize == 1) {
+    auto* found = std::memchr(data, needle[0], size);
+    return found ? static_cast<const char*>(found) - data
+                 : std::string_view::npos;
+  }
+
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr size_t kBatch = Batch::size;
+  const auto first = Batch::broadcast(static_cast<uint8_t>(needle[0]));
+  const auto last =
+      Batch::broadcast(static_cast<uint8_t>(needle[needleSize - 1]));
+  auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  size_t offset = 0;
+  // Candidate positions 'offset' to 'offset + kBatch - 1' are checked at once.
+  // The loads of the last needle byte end at 'offset + kBatch + needleSize -
+  // 1', which must be within 'size'.
+  for (; offset + needleSize - 1 + kBatch <= size; offset += kBatch) {
+    const auto matchFirst = first == Batch::load_unaligned(bytes + offset);
+    const auto matchLast =
+        last == Batch::load_unaligned(bytes + offset + needleSize - 1);
+    const auto mask = toBitMask(matchFirst & matchLast);
+    // toBitMask returns a signed int for some architectures.
+    uint64_t candidates =
+        static_cast<std::make_unsigned_t<decltype(mask)>>(mask);
+    while (candidates) {
+      const auto position = offset + __builtin_ctzll(candidates);
+      if (std::memcmp(data + position + 1, needle + 1, needleSize - 2) == 0) {
+        return position;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  for (; offset + needleSize <= size; ++offset) {
+    if (data[offset] == needle[0] &&
+        std::memcmp(data + offset + 1, needle + 1, needleSize - 1) == 0) {
+      return offset;
+    }
+  }
+  return std::string_view::npos;
+}
+
 } // namespace facebook::velox::simd
@@ -17,6 +17,11 @@
 #include "velox/common/base/SimdUtil.h"
 #include <folly/Preprocessor.h>
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VELOX_AVX512_DISPATCH 1
+#endif
+
 namespace facebook::velox::simd {
 
 void gatherBits(
@@ -62,6 +67,63 @@ const LeadingMask<int64_t, xsimd::default_arch> leadingMask64;
 const FromBitMask<int32_t, xsimd::default_arch> fromBitMask32;
 const FromBitMask<int64_t, xsimd::default_arch> fromBitMask64;
 
+bool useAvx512Compress = false;
+
+#ifdef VELOX_AVX512_DISPATCH
+__attribute__((target("avx512f"))) int32_t indicesOfSetBitsAvx512(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* result) {
+  const auto iota = _mm512_setr_epi32(
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  auto* originalResult = result;
+  const int32_t firstWord = begin / 64;
+  const int32_t endWord = bits::roundUp(end, 64) / 64;
+  for (auto wordIndex = firstWord; wordIndex < endWord; ++wordIndex) {
+    uint64_t word = bits[wordIndex];
+    if (wordIndex == firstWord && begin != firstWord * 64) {
+      word &= bits::highMask(64 - (begin - firstWord * 64));
+    }
+    if (wordIndex == endWord - 1 && end - wordIndex * 64 < 64) {
+      word &= bits::lowMask(end - wordIndex * 64);
+    }
+    if (!word) {
+      continue;
+    }
+    const int32_t row = wordIndex * 64;
+    if (__builtin_popcountll(word) < 4) {
+      do {
+        *result++ = __builtin_ctzll(word) + row;
+        word &= word - 1;
+      } while (word);
+      continue;
+    }
+    // Writes the row numbers of the set bits of each 16 bit lane with a
+    // single compress store.
+    for (auto lane = 0; lane < 4; ++lane) {
+      const auto mask = static_cast<__mmask16>(word >> (lane * 16));
+      if (mask) {
+        _mm512_mask_compressstoreu_epi32(
+            result,
+            mask,
+            _mm512_add_epi32(iota, _mm512_set1_epi32(row + lane * 16)));
+        result += __builtin_popcount(mask);
+      }
+    }
+  }
+  return result - originalResult;
+}
+#else
+int32_t indicesOfSetBitsAvx512(
+    const uint64_t* /*bits*/,
+    int32_t /*begin*/,
+    int32_t /*end*/,
+    int32_t* /*result*/) {
+  VELOX_UNREACHABLE();
+}
+#endif
+
 } // namespace detail
 
 namespace {
@@ -106,6 +168,9 @@ bool initializeSimdUtil() {
   }
   initByteSetBits();
   initPermute4x64Indices();
+#ifdef VELOX_AVX512_DISPATCH
+  detail::useAvx512Compress = __builtin_cpu_supports("avx512f");
+#endif
   inited = true;
   return true;
 }
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string_view>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -57,7 +59,20 @@ int32_t indicesOfSetBits(
 
 namespace detail {
 extern int32_t byteSetBits[256][8];
-}
+
+// True if the host supports AVX-512 compress stores. Detected at startup so
+// that binaries built for AVX2 still use them on AVX-512 hosts. Tests and
+// benchmarks may clear this to exercise the portable path.
+extern bool useAvx512Compress;
+
+// indicesOfSetBits() with AVX-512 compress stores. Only called if
+// 'useAvx512Compress' is set.
+int32_t indicesOfSetBitsAvx512(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* indices);
+} // namespace detail
 
 // Offsets of set bits in a byte. For example, for byte 42 it returns
 // {1, 3, 5, 3, 4, 5, 6, 7}, because 42 has bits 1, 3 and 5 set. The
@@ -497,6 +512,20 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of the 'needleSize' bytes at
+// 'needle' in the 'size' bytes at 'data' or std::string_view::npos if there is
+// none. An empty needle is found at offset 0. Compares the first and last
+// bytes of the needle against a full SIMD width of candidate positions at a
+// time and verifies only the candidates where both match. Does not read past
+// 'data + size'.
+template <typename A = xsimd::default_arch>
+size_t simdStrstr(
+    const char* data,
+    size_t size,
+    const char* needle,
+    size_t needleSize,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
@@ -42,6 +43,21 @@ using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 /// bytes exceed the set limit.
 using UpdateAndCheckSpillLimitCB = std::function<void(uint64_t)>;
 
+/// Specifies a remote spill tier, e.g. an object store or HDFS path served by a
+/// file system from the FileSystem registry. New spill files are written to the
+/// remote tier instead of the local spill directory when the local file system
+/// runs low on free space.
+struct RemoteSpillConfig {
+  /// A callback function that returns the remote spill directory path.
+  /// Implementations can use it to ensure the path exists before returning.
+  GetSpillDirectoryPathCB getSpillDirPathCb;
+
+  /// The min free bytes of the file system of the local spill directory to
+  /// create a new spill file locally. If the free space is lower, the file is
+  /// created in the remote spill directory.
+  uint64_t minLocalFreeBytes{0};
+};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig() = default;
@@ -61,7 +77,9 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _columnarFormat = false,
+      std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -138,5 +156,16 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, sorted spill files store the sort keys and the other columns of
+  /// each batch in separate streams. See SpillFileInfo::columnarFormat.
+  bool columnarFormat{false};
+
+  /// If set, the rows of sorted spill runs are sorted with prefix sort.
+  std::optional<PrefixSortConfig> prefixSortConfig;
+
+  /// If set, spill files are written to the remote tier when the local spill
+  /// directory runs low on free space.
+  std::optional<RemoteSpillConfig> remoteSpillConfig;
 };
 } // namespace facebook::velox::common
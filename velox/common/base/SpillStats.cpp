@@ -42,16 +42,20 @@ SpillStats::SpillStats(
     uint64_t _spilledRows,
     uint32_t _spilledPartitions,
     uint64_t _spilledFiles,
+    uint64_t _spilledRemoteBytes,
+    uint64_t _spilledRemoteFiles,
     uint64_t _spillFillTimeUs,
     uint64_t _spillSortTimeUs,
     uint64_t _spillSerializationTimeUs,
     uint64_t _spillWrites,
     uint64_t _spillFlushTimeUs,
     uint64_t _spillWriteTimeUs,
+    uint64_t _spillWriteWaitTimeUs,
     uint64_t _spillMaxLevelExceededCount,
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
     uint64_t _spillReadTimeUs,
+    uint64_t _spillReadWaitTimeUs,
     uint64_t _spillDeserializationTimeUs)
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
@@ -59,16 +63,20 @@ SpillStats::SpillStats(
       spilledRows(_spilledRows),
       spilledPartitions(_spilledPartitions),
       spilledFiles(_spilledFiles),
+      spilledRemoteBytes(_spilledRemoteBytes),
+      spilledRemoteFiles(_spilledRemoteFiles),
       spillFillTimeUs(_spillFillTimeUs),
       spillSortTimeUs(_spillSortTimeUs),
       spillSerializationTimeUs(_spillSerializationTimeUs),
       spillWrites(_spillWrites),
       spillFlushTimeUs(_spillFlushTimeUs),
       spillWriteTimeUs(_spillWriteTimeUs),
+      spillWriteWaitTimeUs(_spillWriteWaitTimeUs),
       spillMaxLevelExceededCount(_spillMaxLevelExceededCount),
       spillReadBytes(_spillReadBytes),
       spillReads(_spillReads),
       spillReadTimeUs(_spillReadTimeUs),
+      spillReadWaitTimeUs(_spillReadWaitTimeUs),
       spillDeserializationTimeUs(_spillDeserializationTimeUs) {}
 
 SpillStats& SpillStats::operator+=(const SpillStats& other) {
@@ -78,16 +86,20 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spilledRows += other.spilledRows;
   spilledPartitions += other.spilledPartitions;
   spilledFiles += other.spilledFiles;
+  spilledRemoteBytes += other.spilledRemoteBytes;
+  spilledRemoteFiles += other.spilledRemoteFiles;
   spillFillTimeUs += other.spillFillTimeUs;
   spillSortTimeUs += other.spillSortTimeUs;
   spillSerializationTimeUs += other.spillSerializationTimeUs;
   spillWrites += other.spillWrites;
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
+  spillWriteWaitTimeUs += other.spillWriteWaitTimeUs;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
   spillReadBytes += other.spillReadBytes;
   spillReads += other.spillReads;
   spillReadTimeUs += other.spillReadTimeUs;
+  spillReadWaitTimeUs += other.spillReadWaitTimeUs;
   spillDeserializationTimeUs += other.spillDeserializationTimeUs;
   return *this;
 }
@@ -100,6 +112,8 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spilledRows = spilledRows - other.spilledRows;
   result.spilledPartitions = spilledPartitions - other.spilledPartitions;
   result.spilledFiles = spilledFiles - other.spilledFiles;
+  result.spilledRemoteBytes = spilledRemoteBytes - other.spilledRemoteBytes;
+  result.spilledRemoteFiles = spilledRemoteFiles - other.spilledRemoteFiles;
   result.spillFillTimeUs = spillFillTimeUs - other.spillFillTimeUs;
   result.spillSortTimeUs = spillSortTimeUs - other.spillSortTimeUs;
   result.spillSerializationTimeUs =
@@ -107,11 +121,14 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWrites = spillWrites - other.spillWrites;
   result.spillFlushTimeUs = spillFlushTimeUs - other.spillFlushTimeUs;
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
+  result.spillWriteWaitTimeUs =
+      spillWriteWaitTimeUs - other.spillWriteWaitTimeUs;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
   result.spillReadBytes = spillReadBytes - other.spillReadBytes;
   result.spillReads = spillReads - other.spillReads;
   result.spillReadTimeUs = spillReadTimeUs - other.spillReadTimeUs;
+  result.spillReadWaitTimeUs = spillReadWaitTimeUs - other.spillReadWaitTimeUs;
   result.spillDeserializationTimeUs =
       spillDeserializationTimeUs - other.spillDeserializationTimeUs;
   return result;
@@ -135,16 +152,20 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spilledRows);
   UPDATE_COUNTER(spilledPartitions);
   UPDATE_COUNTER(spilledFiles);
+  UPDATE_COUNTER(spilledRemoteBytes);
+  UPDATE_COUNTER(spilledRemoteFiles);
   UPDATE_COUNTER(spillFillTimeUs);
   UPDATE_COUNTER(spillSortTimeUs);
   UPDATE_COUNTER(spillSerializationTimeUs);
   UPDATE_COUNTER(spillWrites);
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
+  UPDATE_COUNTER(spillWriteWaitTimeUs);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
   UPDATE_COUNTER(spillReadBytes);
   UPDATE_COUNTER(spillReads);
   UPDATE_COUNTER(spillReadTimeUs);
+  UPDATE_COUNTER(spillReadWaitTimeUs);
   UPDATE_COUNTER(spillDeserializationTimeUs);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
@@ -175,16 +196,20 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spilledRows,
              spilledPartitions,
              spilledFiles,
+             spilledRemoteBytes,
+             spilledRemoteFiles,
              spillFillTimeUs,
              spillSortTimeUs,
              spillSerializationTimeUs,
              spillWrites,
              spillFlushTimeUs,
              spillWriteTimeUs,
+             spillWriteWaitTimeUs,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
              spillReadTimeUs,
+             spillReadWaitTimeUs,
              spillDeserializationTimeUs) ==
       std::tie(
              other.spillRuns,
@@ -193,16 +218,20 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spilledRows,
              other.spilledPartitions,
              other.spilledFiles,
+             other.spilledRemoteBytes,
+             other.spilledRemoteFiles,
              other.spillFillTimeUs,
              other.spillSortTimeUs,
              other.spillSerializationTimeUs,
              other.spillWrites,
              other.spillFlushTimeUs,
              other.spillWriteTimeUs,
+             other.spillWriteWaitTimeUs,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
              spillReadTimeUs,
+             other.spillReadWaitTimeUs,
              spillDeserializationTimeUs);
 }
 
@@ -213,26 +242,32 @@ void SpillStats::reset() {
   spilledRows = 0;
   spilledPartitions = 0;
   spilledFiles = 0;
+  spilledRemoteBytes = 0;
+  spilledRemoteFiles = 0;
   spillFillTimeUs = 0;
   spillSortTimeUs = 0;
   spillSerializationTimeUs = 0;
   spillWrites = 0;
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
+  spillWriteWaitTimeUs = 0;
   spillMaxLevelExceededCount = 0;
   spillReadBytes = 0;
   spillReads = 0;
   spillReadTimeUs = 0;
+  spillReadWaitTimeUs = 0;
   spillDeserializationTimeUs = 0;
 }
 
 std::string SpillStats::toString() const {
   return fmt::format(
       "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
-      "spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] "
+      "spilledPartitions[{}] spilledFiles[{}] spilledRemoteBytes[{}] "
+      "spilledRemoteFiles[{}] spillFillTimeUs[{}] "
       "spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] "
-      "spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] "
-      "spillReadBytes[{}] spillReads[{}] spillReadTime[{}] "
+      "spillFlushTime[{}] spillWriteTime[{}] spillWriteWaitTime[{}] "
+      "maxSpillExceededLimitCount[{}] spillReadBytes[{}] spillReads[{}] "
+      "spillReadTime[{}] spillReadWaitTime[{}] "
       "spillReadDeserializationTime[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
@@ -240,16 +275,20 @@ std::string SpillStats::toString() const {
       spilledRows,
       spilledPartitions,
       spilledFiles,
+      succinctBytes(spilledRemoteBytes),
+      spilledRemoteFiles,
       succinctMicros(spillFillTimeUs),
       succinctMicros(spillSortTimeUs),
       succinctMicros(spillSerializationTimeUs),
       spillWrites,
       succinctMicros(spillFlushTimeUs),
       succinctMicros(spillWriteTimeUs),
+      succinctMicros(spillWriteWaitTimeUs),
       spillMaxLevelExceededCount,
       succinctBytes(spillReadBytes),
       spillReads,
       succinctMicros(spillReadTimeUs),
+      succinctMicros(spillReadWaitTimeUs),
       succinctMicros(spillDeserializationTimeUs));
 }
 
@@ -298,6 +337,10 @@ void updateGlobalSpillWriteStats(
   statsLocked->spillWriteTimeUs += writeTimeUs;
 }
 
+void updateGlobalSpillWriteWaitTime(uint64_t waitTimeUs) {
+  localSpillStats().wlock()->spillWriteWaitTimeUs += waitTimeUs;
+}
+
 void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeUs) {
@@ -307,6 +350,10 @@ void updateGlobalSpillReadStats(
   statsLocked->spillReadTimeUs += spillRadTimeUs;
 }
 
+void updateGlobalSpillReadWaitTime(uint64_t waitTimeUs) {
+  localSpillStats().wlock()->spillReadWaitTimeUs += waitTimeUs;
+}
+
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   RECORD_METRIC_VALUE(kMetricSpilledInputBytes, spilledInputBytes);
   auto statsLocked = localSpillStats().wlock();
@@ -16,6 +16,7 @@
 #pragma once
 #include <stdint.h>
 #include <string.h>
+#include <algorithm>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/compression/Compression.h"
@@ -38,6 +39,12 @@ struct SpillStats {
   uint32_t spilledPartitions{0};
   /// The number of spilled files.
   uint64_t spilledFiles{0};
+  /// The number of bytes spilled to the remote spill tier. These are also
+  /// counted in 'spilledBytes'. See RemoteSpillConfig.
+  uint64_t spilledRemoteBytes{0};
+  /// The number of spilled files on the remote spill tier. These are also
+  /// counted in 'spilledFiles'.
+  uint64_t spilledRemoteFiles{0};
   /// The time spent on filling rows for spilling.
   uint64_t spillFillTimeUs{0};
   /// The time spent on sorting rows for spilling.
@@ -52,6 +59,10 @@ struct SpillStats {
   uint64_t spillFlushTimeUs{0};
   /// The time spent on writing spilled rows to disk.
   uint64_t spillWriteTimeUs{0};
+  /// The time the spilling thread is blocked on the completion of a disk write
+  /// which runs in the background. The rest of 'spillWriteTimeUs' overlaps with
+  /// serialization.
+  uint64_t spillWriteWaitTimeUs{0};
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
@@ -62,6 +73,10 @@ struct SpillStats {
   uint64_t spillReads{0};
   /// The time spent on read data from spilled files.
   uint64_t spillReadTimeUs{0};
+  /// The time the reading thread is blocked on the completion of a read-ahead.
+  /// The rest of 'spillReadTimeUs' overlaps with the processing of the
+  /// previously read data.
+  uint64_t spillReadWaitTimeUs{0};
   /// The time spent on deserializing rows read from spilled files.
   uint64_t spillDeserializationTimeUs{0};
 
@@ -72,16 +87,20 @@ struct SpillStats {
       uint64_t _spilledRows,
       uint32_t _spilledPartitions,
       uint64_t _spilledFiles,
+      uint64_t _spilledRemoteBytes,
+      uint64_t _spilledRemoteFiles,
       uint64_t _spillFillTimeUs,
       uint64_t _spillSortTimeUs,
       uint64_t _spillSerializationTimeUs,
       uint64_t _spillWrites,
       uint64_t _spillFlushTimeUs,
       uint64_t _spillWriteTimeUs,
+      uint64_t _spillWriteWaitTimeUs,
       uint64_t _spillMaxLevelExceededCount,
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
       uint64_t _spillReadTimeUs,
+      uint64_t _spillReadWaitTimeUs,
       uint64_t _spillDeserializationTimeUs);
 
   SpillStats() = default;
@@ -90,6 +109,18 @@ struct SpillStats {
     return spilledBytes == 0;
   }
 
+  /// Returns the fraction of the disk write time that overlaps with other
+  /// work on the spilling thread.
+  double spillWriteOverlapRatio() const {
+    return overlapRatio(spillWriteTimeUs, spillWriteWaitTimeUs);
+  }
+
+  /// Returns the fraction of the disk read time that overlaps with other work
+  /// on the reading thread.
+  double spillReadOverlapRatio() const {
+    return overlapRatio(spillReadTimeUs, spillReadWaitTimeUs);
+  }
+
   SpillStats& operator+=(const SpillStats& other);
   SpillStats operator-(const SpillStats& other) const;
   bool operator==(const SpillStats& other) const;
@@ -104,6 +135,14 @@ struct SpillStats {
   void reset();
 
   std::string toString() const;
+
+ private:
+  static double overlapRatio(uint64_t timeUs, uint64_t waitTimeUs) {
+    if (timeUs == 0) {
+      return 0;
+    }
+    return 1.0 - static_cast<double>(std::min(timeUs, waitTimeUs)) / timeUs;
+  }
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -139,12 +178,18 @@ void updateGlobalSpillWriteStats(
     uint64_t flushTimeUs,
     uint64_t writeTimeUs);
 
+/// Updates the time the spilling thread is blocked on background disk writes.
+void updateGlobalSpillWriteWaitTime(uint64_t waitTimeUs);
+
 /// Updates the stats for disk read including the number of disk reads, the
 /// amount of data read in bytes, and the time it takes to read from the disk.
 void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeUs);
 
+/// Updates the time the reading thread is blocked on spill read-aheads.
+void updateGlobalSpillReadWaitTime(uint64_t waitTimeUs);
+
 /// Increments the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
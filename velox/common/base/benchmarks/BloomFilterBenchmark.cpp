@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Hash.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::test {
+namespace {
+constexpr int32_t kNumHashes = 10'000;
+
+// Filters with 8K and 8M expected values. The larger one does not fit in
+// cache, so that inserts and tests are bound by memory latency.
+struct BloomFilterBenchmark {
+  explicit BloomFilterBenchmark(int32_t capacity) {
+    for (auto i = 0; i < kNumHashes; ++i) {
+      hashes.push_back(folly::hasher<int64_t>()(i * 7));
+    }
+    filter.reset(capacity);
+    filter.insert(hashes.data(), kNumHashes / 2);
+    result.resize(bits::nwords(kNumHashes));
+  }
+
+  std::vector<uint64_t> hashes;
+  BloomFilter<> filter;
+  std::vector<uint64_t> result;
+};
+
+BloomFilterBenchmark& small() {
+  static BloomFilterBenchmark benchmark(8 << 10);
+  return benchmark;
+}
+
+BloomFilterBenchmark& large() {
+  static BloomFilterBenchmark benchmark(8 << 20);
+  return benchmark;
+}
+
+int64_t insertByValue(BloomFilterBenchmark& benchmark) {
+  for (auto hash : benchmark.hashes) {
+    benchmark.filter.insert(hash);
+  }
+  return kNumHashes;
+}
+
+int64_t insertBatch(BloomFilterBenchmark& benchmark) {
+  benchmark.filter.insert(benchmark.hashes.data(), kNumHashes);
+  return kNumHashes;
+}
+
+int64_t testByValue(BloomFilterBenchmark& benchmark) {
+  int64_t count = 0;
+  for (auto hash : benchmark.hashes) {
+    count += benchmark.filter.mayContain(hash);
+  }
+  folly::doNotOptimizeAway(count);
+  return kNumHashes;
+}
+
+int64_t testBatch(BloomFilterBenchmark& benchmark) {
+  benchmark.filter.mayContain(
+      benchmark.hashes.data(), kNumHashes, benchmark.result.data());
+  folly::doNotOptimizeAway(benchmark.result);
+  return kNumHashes;
+}
+
+BENCHMARK_MULTI(insertSmall) {
+  return insertByValue(small());
+}
+
+BENCHMARK_RELATIVE_MULTI(insertBatchSmall) {
+  return insertBatch(small());
+}
+
+BENCHMARK_MULTI(insertLarge) {
+  return insertByValue(large());
+}
+
+BENCHMARK_RELATIVE_MULTI(insertBatchLarge) {
+  return insertBatch(large());
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(testSmall) {
+  return testByValue(small());
+}
+
+BENCHMARK_RELATIVE_MULTI(testBatchSmall) {
+  return testBatch(small());
+}
+
+BENCHMARK_MULTI(testLarge) {
+  return testByValue(large());
+}
+
+BENCHMARK_RELATIVE_MULTI(testBatchLarge) {
+  return testBatch(large());
+}
+} // namespace
+} // namespace facebook::velox::test
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
@@ -78,6 +78,41 @@ class FromBitMask {
   uint64_t inputs_[kSize];
 };
 
+class IndicesOfSetBits {
+ public:
+  IndicesOfSetBits(
+      const char* name,
+      std::default_random_engine& gen,
+      int32_t onesPer1000,
+      bool avx512)
+      : avx512_(avx512) {
+    std::uniform_int_distribution<> dist(0, 999);
+    for (int i = 0; i < kSize * 64; ++i) {
+      if (dist(gen) < onesPer1000) {
+        bits::setBit(bits_, i);
+      }
+    }
+    if (!avx512_ || simd::detail::useAvx512Compress) {
+      folly::addBenchmark(__FILE__, name, [this] { return run(); });
+    }
+  }
+
+ private:
+  unsigned run() {
+    const auto saved = simd::detail::useAvx512Compress;
+    simd::detail::useAvx512Compress = avx512_;
+    auto numSet = simd::indicesOfSetBits(bits_, 0, kSize * 64, indices_);
+    simd::detail::useAvx512Compress = saved;
+    folly::doNotOptimizeAway(numSet);
+    return kSize;
+  }
+
+  static constexpr int kSize = 1 << 8;
+  const bool avx512_;
+  uint64_t bits_[kSize]{};
+  int32_t indices_[kSize * 64];
+};
+
 } // namespace
 } // namespace facebook::velox
 
@@ -89,6 +124,10 @@ int main(int argc, char* argv[]) {
   VELOX_BENCHMARK(LeadingMask<int64_t>, leadingMaskInt64, gen);
   VELOX_BENCHMARK(FromBitMask<int32_t>, fromBitMaskInt32, gen);
   VELOX_BENCHMARK(FromBitMask<int64_t>, fromBitMaskInt64, gen);
+  VELOX_BENCHMARK(IndicesOfSetBits, indicesOfSetBits10, gen, 10, false);
+  VELOX_BENCHMARK(IndicesOfSetBits, indicesOfSetBits10Avx512, gen, 10, true);
+  VELOX_BENCHMARK(IndicesOfSetBits, indicesOfSetBits500, gen, 500, false);
+  VELOX_BENCHMARK(IndicesOfSetBits, indicesOfSetBits500Avx512, gen, 500, true);
   folly::runBenchmarks();
   return 0;
 }
@@ -90,3 +90,40 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batch) {
+  constexpr int32_t kSize = 1'000;
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < kSize; ++i) {
+    hashes.push_back(folly::hasher<int32_t>()(i));
+  }
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  BloomFilter batchBloom;
+  batchBloom.reset(kSize);
+  for (auto hash : hashes) {
+    bloom.insert(hash);
+  }
+  // Sizes that are not a multiple of the SIMD width leave a scalar tail.
+  batchBloom.insert(hashes.data(), 7);
+  batchBloom.insert(hashes.data() + 7, kSize - 7);
+
+  std::string data(bloom.serializedSize(), '\0');
+  std::string batchData(batchBloom.serializedSize(), '\0');
+  bloom.serialize(data.data());
+  batchBloom.serialize(batchData.data());
+  EXPECT_EQ(data, batchData);
+
+  // Tests the inserted values and as many values that were not inserted.
+  std::vector<uint64_t> probes = hashes;
+  for (auto i = 0; i < kSize; ++i) {
+    probes.push_back(folly::hasher<int32_t>()(kSize + i));
+  }
+  std::vector<uint64_t> result(bits::nwords(probes.size() - 3), ~0UL);
+  bloom.mayContain(probes.data() + 3, probes.size() - 3, result.data());
+  for (auto i = 0; i < probes.size() - 3; ++i) {
+    EXPECT_EQ(bits::isBitSet(result.data(), i), bloom.mayContain(probes[i + 3]))
+        << i;
+  }
+  EXPECT_EQ(0, result.back() & ~bits::lowMask((probes.size() - 3) % 64));
+}
@@ -73,4 +73,78 @@ TEST_F(RuntimeMetricsTest, basic) {
   testMetric(rm3, 0, 0, 0, 0);
 };
 
+TEST_F(RuntimeMetricsTest, histogramBuckets) {
+  EXPECT_EQ(RuntimeHistogram::bucket(-1), 0);
+  for (int64_t value = 0; value < RuntimeHistogram::kNumSubBuckets; ++value) {
+    EXPECT_EQ(RuntimeHistogram::bucket(value), value);
+  }
+  for (auto value : {5L, 100L, 12'345L, 1L << 40, 987'654'321'987L}) {
+    const auto bucket = RuntimeHistogram::bucket(value);
+    EXPECT_LE(RuntimeHistogram::lowerBound(bucket), value);
+    EXPECT_GT(RuntimeHistogram::lowerBound(bucket + 1), value);
+  }
+  EXPECT_EQ(
+      RuntimeHistogram::bucket(std::numeric_limits<int64_t>::max()),
+      RuntimeHistogram::kNumBuckets - 1);
+}
+
+TEST_F(RuntimeMetricsTest, histogram) {
+  RuntimeMetric metric(RuntimeCounter::Unit::kNanos);
+  metric.enableHistogram();
+  for (int64_t i = 1; i <= 1'000; ++i) {
+    metric.addValue(i * 1'000);
+  }
+  testMetric(metric, 500'500'000, 1'000, 1'000, 1'000'000);
+  ASSERT_EQ(metric.histogram->count(), 1'000);
+  for (auto [percentile, expected] :
+       std::vector<std::pair<double, int64_t>>{
+           {50, 500'000}, {90, 900'000}, {99, 990'000}}) {
+    const auto value = metric.percentile(percentile);
+    EXPECT_GE(value, expected * 0.75) << percentile;
+    EXPECT_LE(value, expected * 1.25) << percentile;
+  }
+  EXPECT_EQ(metric.percentile(100), 1'000'000);
+  EXPECT_EQ(metric.percentile(0), 1'000);
+  EXPECT_EQ(
+      fmt::format(
+          "sum:{}, count:{}, min:{}, max:{}, p50:{}, p90:{}, p99:{}",
+          metric.sum,
+          metric.count,
+          metric.min,
+          metric.max,
+          metric.percentile(50),
+          metric.percentile(90),
+          metric.percentile(99)),
+      metric.toString());
+
+  // Copies are deep.
+  RuntimeMetric copy = metric;
+  copy.addValue(10);
+  EXPECT_EQ(copy.histogram->count(), 1'001);
+  EXPECT_EQ(metric.histogram->count(), 1'000);
+
+  // Merging adds the distributions, also into a metric without one.
+  RuntimeMetric other(RuntimeCounter::Unit::kNanos);
+  for (int64_t i = 0; i < 9'000; ++i) {
+    other.addValue(2'000'000);
+  }
+  other.merge(metric);
+  ASSERT_NE(other.histogram, nullptr);
+  EXPECT_EQ(other.histogram->count(), 1'000);
+  metric.merge(other);
+  EXPECT_EQ(metric.histogram->count(), 2'000);
+  EXPECT_EQ(metric.count, 11'000);
+
+  metric.aggregate();
+  EXPECT_EQ(metric.histogram, nullptr);
+  EXPECT_EQ(
+      fmt::format(
+          "sum:{}, count:{}, min:{}, max:{}",
+          metric.sum,
+          metric.count,
+          metric.min,
+          metric.max),
+      metric.toString());
+}
+
 } // namespace facebook::velox
@@ -129,6 +129,16 @@ TEST_F(SimdUtilTest, bitIndices) {
   testIndices(999);
 }
 
+TEST_F(SimdUtilTest, bitIndicesPortable) {
+  // Covers the portable path on hosts that dispatch to AVX-512.
+  const auto saved = simd::detail::useAvx512Compress;
+  simd::detail::useAvx512Compress = false;
+  testIndices(1);
+  testIndices(100);
+  testIndices(999);
+  simd::detail::useAvx512Compress = saved;
+}
+
 TEST_F(SimdUtilTest, gather32) {
   int32_t indices8[8] = {7, 6, 5, 4, 3, 2, 1, 0};
   int32_t indices6[8] = {7, 6, 5, 4, 3, 2, 1 << 31, 1 << 31};
@@ -453,6 +463,46 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, simdStrstr) {
+  auto find = [](const std::string& data, const std::string& needle) {
+    return simd::simdStrstr(
+        data.data(), data.size(), needle.data(), needle.size());
+  };
+  EXPECT_EQ(find("", ""), 0);
+  EXPECT_EQ(find("abc", ""), 0);
+  EXPECT_EQ(find("", "a"), std::string_view::npos);
+  EXPECT_EQ(find("ab", "abc"), std::string_view::npos);
+  EXPECT_EQ(find("abc", "abc"), 0);
+  EXPECT_EQ(find("abcabc", "c"), 2);
+
+  // Needles of different sizes at every offset of haystacks that are shorter
+  // and longer than a SIMD width. Partial matches that share the first and
+  // last byte of the needle precede the match.
+  for (auto needleSize = 1; needleSize < 40; ++needleSize) {
+    std::string needle;
+    for (auto i = 0; i < needleSize; ++i) {
+      needle.push_back('a' + i % 26);
+    }
+    std::string decoy = needle;
+    if (needleSize > 2) {
+      decoy[needleSize / 2] = '-';
+    }
+    for (auto size = needleSize; size < 150; size += 7) {
+      for (auto offset = 0; offset + needleSize <= size; ++offset) {
+        std::string data(size, '.');
+        if (needleSize > 2 && offset >= needleSize) {
+          data.replace(0, needleSize, decoy);
+        }
+        data.replace(offset, needleSize, needle);
+        ASSERT_EQ(find(data, needle), std::string_view(data).find(needle))
+            << needleSize << " " << size << " " << offset;
+      }
+      std::string data(size, '.');
+      ASSERT_EQ(find(data, needle), std::string_view::npos);
+    }
+  }
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
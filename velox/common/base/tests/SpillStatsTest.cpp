@@ -29,7 +29,10 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spilledBytes = 1024;
   stats1.spilledPartitions = 1024;
   stats1.spilledFiles = 1023;
+  stats1.spilledRemoteBytes = 256;
+  stats1.spilledRemoteFiles = 1;
   stats1.spillWriteTimeUs = 1023;
+  stats1.spillWriteWaitTimeUs = 23;
   stats1.spillFlushTimeUs = 1023;
   stats1.spillWrites = 1023;
   stats1.spillSortTimeUs = 1023;
@@ -40,6 +43,7 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spillReadBytes = 1024;
   stats1.spillReads = 10;
   stats1.spillReadTimeUs = 100;
+  stats1.spillReadWaitTimeUs = 100;
   stats1.spillDeserializationTimeUs = 100;
   ASSERT_FALSE(stats1.empty());
   SpillStats stats2;
@@ -48,7 +52,10 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spilledBytes = 1024;
   stats2.spilledPartitions = 1025;
   stats2.spilledFiles = 1026;
+  stats2.spilledRemoteBytes = 512;
+  stats2.spilledRemoteFiles = 2;
   stats2.spillWriteTimeUs = 1026;
+  stats2.spillWriteWaitTimeUs = 26;
   stats2.spillFlushTimeUs = 1027;
   stats2.spillWrites = 1028;
   stats2.spillSortTimeUs = 1029;
@@ -59,6 +66,7 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spillReadBytes = 2048;
   stats2.spillReads = 10;
   stats2.spillReadTimeUs = 100;
+  stats2.spillReadWaitTimeUs = 100;
   stats2.spillDeserializationTimeUs = 100;
   ASSERT_TRUE(stats1 < stats2);
   ASSERT_TRUE(stats1 <= stats2);
@@ -79,7 +87,10 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spilledBytes, 0);
   ASSERT_EQ(delta.spilledPartitions, 1);
   ASSERT_EQ(delta.spilledFiles, 3);
+  ASSERT_EQ(delta.spilledRemoteBytes, 256);
+  ASSERT_EQ(delta.spilledRemoteFiles, 1);
   ASSERT_EQ(delta.spillWriteTimeUs, 3);
+  ASSERT_EQ(delta.spillWriteWaitTimeUs, 3);
   ASSERT_EQ(delta.spillFlushTimeUs, 4);
   ASSERT_EQ(delta.spillWrites, 5);
   ASSERT_EQ(delta.spillSortTimeUs, 6);
@@ -95,7 +106,10 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(delta.spilledBytes, 0);
   ASSERT_EQ(delta.spilledPartitions, -1);
   ASSERT_EQ(delta.spilledFiles, -3);
+  ASSERT_EQ(delta.spilledRemoteBytes, -256);
+  ASSERT_EQ(delta.spilledRemoteFiles, -1);
   ASSERT_EQ(delta.spillWriteTimeUs, -3);
+  ASSERT_EQ(delta.spillWriteWaitTimeUs, -3);
   ASSERT_EQ(delta.spillFlushTimeUs, -4);
   ASSERT_EQ(delta.spillWrites, -5);
   ASSERT_EQ(delta.spillSortTimeUs, -6);
@@ -123,19 +137,38 @@ TEST(SpillStatsTest, spillStats) {
       stats2.toString(),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
+      "spilledRemoteBytes[512B] spilledRemoteFiles[2] "
       "spillFillTimeUs[1.03ms] spillSortTime[1.03ms] "
       "spillSerializationTime[1.03ms] spillWrites[1028] spillFlushTime[1.03ms] "
-      "spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] "
-      "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
+      "spillWriteTime[1.03ms] spillWriteWaitTime[26us] "
+      "maxSpillExceededLimitCount[4] spillReadBytes[2.00KB] spillReads[10] "
+      "spillReadTime[100us] spillReadWaitTime[100us] "
       "spillReadDeserializationTime[100us]");
   ASSERT_EQ(
       fmt::format("{}", stats2),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
       "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
+      "spilledRemoteBytes[512B] spilledRemoteFiles[2] "
       "spillFillTimeUs[1.03ms] spillSortTime[1.03ms] "
       "spillSerializationTime[1.03ms] spillWrites[1028] "
       "spillFlushTime[1.03ms] spillWriteTime[1.03ms] "
-      "maxSpillExceededLimitCount[4] "
+      "spillWriteWaitTime[26us] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
-      "spillReadDeserializationTime[100us]");
+      "spillReadWaitTime[100us] spillReadDeserializationTime[100us]");
+}
+
+TEST(SpillStatsTest, overlapRatio) {
+  SpillStats stats;
+  ASSERT_EQ(stats.spillWriteOverlapRatio(), 0);
+  ASSERT_EQ(stats.spillReadOverlapRatio(), 0);
+  stats.spillWriteTimeUs = 1'000;
+  stats.spillWriteWaitTimeUs = 250;
+  ASSERT_DOUBLE_EQ(stats.spillWriteOverlapRatio(), 0.75);
+  stats.spillWriteWaitTimeUs = 2'000;
+  ASSERT_DOUBLE_EQ(stats.spillWriteOverlapRatio(), 0);
+  stats.spillReadTimeUs = 100;
+  stats.spillReadWaitTimeUs = 100;
+  ASSERT_DOUBLE_EQ(stats.spillReadOverlapRatio(), 0);
+  stats.spillReadWaitTimeUs = 0;
+  ASSERT_DOUBLE_EQ(stats.spillReadOverlapRatio(), 1);
 }
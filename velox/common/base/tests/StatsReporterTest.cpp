@@ -25,6 +25,7 @@
 #include "velox/common/base/PeriodicStatsReporter.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/caching/CacheTTLController.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/MmapAllocator.h"
@@ -492,9 +493,12 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadCheckpointErrors.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheCheckpointsRead.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheCheckpointsWritten.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheDeltaLogsWritten.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRegionsEvicted.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheAdmittedEntries.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheRejectedEntries.str()), 0);
     ASSERT_EQ(counterMap.size(), 22);
   }
 
@@ -503,12 +507,15 @@ TEST_F(PeriodicStatsReporterTest, basic) {
   newSsdStats->entriesWritten = 10;
   newSsdStats->bytesWritten = 10;
   newSsdStats->checkpointsWritten = 10;
+  newSsdStats->deltaLogsWritten = 10;
   newSsdStats->entriesRead = 10;
   newSsdStats->bytesRead = 10;
   newSsdStats->checkpointsRead = 10;
   newSsdStats->entriesAgedOut = 10;
   newSsdStats->regionsAgedOut = 10;
   newSsdStats->regionsEvicted = 10;
+  newSsdStats->entriesAdmitted = 10;
+  newSsdStats->entriesRejected = 10;
   newSsdStats->numPins = 10;
   newSsdStats->openFileErrors = 10;
   newSsdStats->openCheckpointErrors = 10;
@@ -569,10 +576,50 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadCheckpointErrors.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheCheckpointsRead.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheCheckpointsWritten.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheDeltaLogsWritten.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRegionsEvicted.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
-    ASSERT_EQ(counterMap.size(), 51);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheAdmittedEntries.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheRejectedEntries.str()), 1);
+    ASSERT_EQ(counterMap.size(), 54);
+  }
+}
+
+TEST_F(PeriodicStatsReporterTest, cacheHeatMap) {
+  cache::CacheHeatMap heatMap;
+  heatMap.setEnabled(true);
+  heatMap.recordRead(1, cache::TrackingId(32), 1'000);
+  heatMap.recordLoad(
+      1, cache::TrackingId(32), cache::CacheHeatMap::Source::kSsd, 800, true);
+  heatMap.recordPrefetchHit(1, cache::TrackingId(32), 600);
+  PeriodicStatsReporter::Options options;
+  options.cacheHeatMap = &heatMap;
+  options.cacheHeatMapStatsIntervalMs = 4'000;
+  PeriodicStatsReporter periodicReporter(options);
+
+  periodicReporter.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2'000));
+  const auto& counterMap = reporter_->counterMap;
+  {
+    std::lock_guard<std::mutex> l(reporter_->m);
+    ASSERT_EQ(counterMap.at(kMetricCacheHeatMapReadBytes.str()), 1'000);
+    ASSERT_EQ(counterMap.at(kMetricCacheHeatMapSsdBytes.str()), 800);
+    ASSERT_EQ(counterMap.at(kMetricCacheHeatMapPrefetchBytes.str()), 800);
+    ASSERT_EQ(counterMap.at(kMetricCacheHeatMapPrefetchHitBytes.str()), 600);
+    // Zero deltas are not reported.
+    ASSERT_EQ(counterMap.count(kMetricCacheHeatMapStorageBytes.str()), 0);
+    ASSERT_EQ(counterMap.size(), 4);
+  }
+
+  // The next report adds the change since the first one.
+  heatMap.recordRead(1, cache::TrackingId(32), 500);
+  std::this_thread::sleep_for(std::chrono::milliseconds(4'000));
+  periodicReporter.stop();
+  {
+    std::lock_guard<std::mutex> l(reporter_->m);
+    ASSERT_EQ(counterMap.at(kMetricCacheHeatMapReadBytes.str()), 1'500);
+    ASSERT_EQ(counterMap.at(kMetricCacheHeatMapSsdBytes.str()), 800);
   }
 }
 
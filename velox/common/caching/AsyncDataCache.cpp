@@ -15,6 +15,8 @@
  */
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/CacheHeatMap.h"
+#include "velox/common/caching/CompressedCacheTier.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/SsdFile.h"
@@ -43,7 +45,7 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -105,6 +107,7 @@ memory::MachinePageCount AsyncDataCacheEntry::setPrefetch(bool flag) {
 void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
+  ssdRejected_ = false;
   key_ = std::move(key);
   auto* cache = shard_->cache();
   ClockTimer t(shard_->allocClocks());
@@ -160,9 +163,13 @@ CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (auto pin = findShared(key, size); !pin.empty()) {
+    return pin;
+  }
+
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -224,12 +231,38 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->isWarm_ = false;
   }
   return initEntry(key, entryToInit);
 }
 
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* foundEntry = it->second;
+  // Exclusive, prefetched and too small entries change state on access and
+  // are handled under the exclusive lock. Readers may concurrently pin shared
+  // entries but no entry becomes exclusive or leaves 'entryMap_' while the
+  // shared lock is held.
+  if (foundEntry->isExclusive() || foundEntry->isPrefetch() ||
+      foundEntry->size() < size) {
+    return CachePin();
+  }
+  ++eventCounter_;
+  foundEntry->touch();
+  ++numHit_;
+  hitBytes_ += foundEntry->size();
+  ++foundEntry->numPins_;
+  CachePin pin;
+  pin.setEntry(foundEntry);
+  return pin;
+}
+
 void CacheShard::makeEvictable(RawFileCacheKey key) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it == entryMap_.end()) {
     return;
@@ -238,7 +271,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -260,6 +293,12 @@ CachePin CacheShard::initEntry(
   cache_->incrementNew(entry->size());
   CachePin pin;
   pin.setEntry(entry);
+  auto* compressedTier = cache_->compressedTier();
+  if (compressedTier != nullptr && compressedTier->get(*entry)) {
+    // The data was evicted to the compressed tier and is now back. The entry
+    // is returned in shared mode like a hit.
+    entry->setExclusiveToShared();
+  }
   return pin;
 }
 
@@ -312,21 +351,24 @@ bool CoalescedLoad::loadOrFuture(
   return true;
 }
 
-void CoalescedLoad::setEndState(State endState) {
+CoalescedLoad::State CoalescedLoad::setEndState(State endState) {
   std::unique_ptr<folly::SharedPromise<bool>> promise;
+  State previousState;
   {
     std::lock_guard<std::mutex> l(mutex_);
+    previousState = state_;
     state_ = endState;
     promise.swap(promise_);
   }
   if (promise != nullptr) {
     promise->setValue(true);
   }
+  return previousState;
 }
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -343,6 +385,8 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   }
   entry->setSsdFile(nullptr, 0);
   if (entry->isPrefetch()) {
+    cacheHeatMap().recordPrefetchWasted(
+        entry->groupId_, entry->trackingId_, entry->size_);
     entry->setPrefetch(false);
   }
   // An entry can have data allocated if we remove it after failing
@@ -366,13 +410,26 @@ uint64_t CacheShard::evict(
     memory::Allocation& acquired) {
   auto* ssdCache = cache_->ssdCache();
   const bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
+  // Emergency evictions free memory without moving it to the compressed tier.
+  auto* compressedTier = evictAllUnpinned ? nullptr : cache_->compressedTier();
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  // Evicted entries to compress into 'compressedTier' outside of 'mutex_'.
+  struct CompressCandidate {
+    FileCacheKey key;
+    int32_t size;
+    memory::Allocation data;
+    SsdFile* ssdFile;
+    uint64_t ssdOffset;
+    // True if 'data' goes to 'acquired' after compressing.
+    bool acquire;
+  };
+  std::vector<CompressCandidate> toCompress;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
   int32_t evictSaveableSkipped = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
@@ -415,7 +472,22 @@ uint64_t CacheShard::evict(
           continue;
         }
         largeEvicted += candidate->data_.byteSize();
-        if (pagesToAcquire > 0) {
+        if (compressedTier != nullptr && candidate->key_.fileNum.hasValue() &&
+            !candidate->data_.empty()) {
+          toCompress.push_back(
+              {candidate->key_,
+               candidate->size_,
+               std::move(candidate->data()),
+               candidate->ssdFile_,
+               candidate->ssdOffset_,
+               pagesToAcquire > 0});
+          if (pagesToAcquire > 0) {
+            const auto candidatePages = toCompress.back().data.numPages();
+            pagesToAcquire = candidatePages > pagesToAcquire
+                ? 0
+                : pagesToAcquire - candidatePages;
+          }
+        } else if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
           pagesToAcquire = candidatePages > pagesToAcquire
               ? 0
@@ -428,8 +500,8 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
-        candidate->size_ = 0;
 
+        // Resets 'size_' after accounting for a prefetch that was not hit.
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
         tryAddFreeEntry(std::move(*iter));
@@ -444,6 +516,20 @@ uint64_t CacheShard::evict(
     }
   }
 
+  for (auto& candidate : toCompress) {
+    compressedTier->put(
+        candidate.key,
+        candidate.size,
+        candidate.data,
+        candidate.ssdFile,
+        candidate.ssdOffset);
+    if (candidate.acquire) {
+      acquired.appendMove(candidate.data);
+    } else {
+      toFree.push_back(std::move(candidate.data));
+    }
+  }
+
   ClockTimer t(allocClocks_);
   freeAllocations(toFree);
   cache_->incrementCachedPages(
@@ -503,7 +589,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -542,7 +628,7 @@ void CacheShard::updateStats(CacheStats& stats) {
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add entries to a write batch more than maxWriteRatio_. If SSD save
   // is slower than storage read, we must not have a situation where SSD save
   // pins everything and stops reading.
@@ -552,6 +638,13 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   for (auto& entry : entries_) {
     if (entry && (entry->ssdFile_ == nullptr) && !entry->isExclusive() &&
         entry->ssdSaveable()) {
+      if (!cache_->ssdCache()->admit(
+              {entry->key().fileNum.id(),
+               static_cast<uint64_t>(entry->offset())},
+              entry->ssdRejected_)) {
+        entry->ssdRejected_ = true;
+        continue;
+      }
       CachePin pin;
       ++entry->numPins_;
       pin.setEntry(entry.get());
@@ -565,6 +658,18 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   }
 }
 
+void CacheShard::appendFilled(std::vector<CachePin>& pins) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  for (auto& entry : entries_) {
+    if (entry && !entry->isExclusive() && entry->key_.fileNum.hasValue()) {
+      CachePin pin;
+      ++entry->numPins_;
+      pin.setEntry(entry.get());
+      pins.push_back(std::move(pin));
+    }
+  }
+}
+
 bool CacheShard::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -576,7 +681,7 @@ bool CacheShard::removeFileEntries(
   int64_t pagesRemoved = 0;
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
 
     auto entryIndex = -1;
     for (auto& cacheEntry : entries_) {
@@ -625,6 +730,12 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numCompressedPut = numCompressedPut - other.numCompressedPut;
+  result.numCompressedRejected =
+      numCompressedRejected - other.numCompressedRejected;
+  result.numCompressedHit = numCompressedHit - other.numCompressedHit;
+  result.compressedHitBytes = compressedHitBytes - other.compressedHitBytes;
+  result.numCompressedEvict = numCompressedEvict - other.numCompressedEvict;
   if (ssdStats != nullptr && other.ssdStats != nullptr) {
     result.ssdStats =
         std::make_shared<SsdCacheStats>(*ssdStats - *other.ssdStats);
@@ -644,6 +755,11 @@ AsyncDataCache::AsyncDataCache(
     : opts_(options),
       allocator_(allocator),
       ssdCache_(std::move(ssdCache)),
+      compressedTier_(
+          opts_.compressedTierBytes > 0
+              ? std::make_unique<CompressedCacheTier>(
+                    opts_.compressedTierBytes, opts_.compressedTierKind)
+              : nullptr),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
@@ -686,6 +802,9 @@ void AsyncDataCache::shutdown() {
   for (auto& shard : shards_) {
     shard->shutdown();
   }
+  if (compressedTier_) {
+    compressedTier_->clear();
+  }
 }
 
 void CacheShard::shutdown() {
@@ -697,6 +816,9 @@ CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (ssdCache_ != nullptr) {
+    ssdCache_->recordAccess(key);
+  }
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
   return shards_[shard]->findOrCreate(key, size, wait);
 }
@@ -909,6 +1031,14 @@ void AsyncDataCache::saveToSsd() {
   ssdCache_->write(std::move(pins));
 }
 
+std::vector<CachePin> AsyncDataCache::pinFilledEntries() {
+  std::vector<CachePin> pins;
+  for (auto& shard : shards_) {
+    shard->appendFilled(pins);
+  }
+  return pins;
+}
+
 bool AsyncDataCache::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -924,6 +1054,9 @@ bool AsyncDataCache::removeFileEntries(
     }
   }
 
+  if (compressedTier_) {
+    compressedTier_->removeFileEntries(filesToRemove);
+  }
   if (ssdCache_) {
     success &= ssdCache_->removeFileEntries(filesToRemove, filesRetained);
   }
@@ -935,6 +1068,17 @@ CacheStats AsyncDataCache::refreshStats() const {
   for (auto& shard : shards_) {
     shard->updateStats(stats);
   }
+  if (compressedTier_ != nullptr) {
+    const auto tierStats = compressedTier_->stats();
+    stats.numCompressedEntries = tierStats.numEntries;
+    stats.compressedBytes = tierStats.compressedBytes;
+    stats.compressedUncompressedBytes = tierStats.uncompressedBytes;
+    stats.numCompressedPut = tierStats.numPuts;
+    stats.numCompressedRejected = tierStats.numRejected;
+    stats.numCompressedHit = tierStats.numHit;
+    stats.compressedHitBytes = tierStats.hitBytes;
+    stats.numCompressedEvict = tierStats.numEvict;
+  }
   if (ssdCache_ != nullptr) {
     stats.ssdStats = std::make_shared<SsdCacheStats>(ssdCache_->stats());
   }
@@ -1002,9 +1146,20 @@ std::string CacheStats::toString() const {
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
-      << "\n"
-      // Cache timing stats.
-      << "Alloc Megaclocks " << (allocClocks >> 20);
+      << "\n";
+  if (numCompressedPut > 0) {
+    // Compressed tier stats.
+    out << "Compressed entries: " << numCompressedEntries
+        << " bytes: " << succinctBytes(compressedBytes)
+        << " holding: " << succinctBytes(compressedUncompressedBytes)
+        << " hit: " << numCompressedHit
+        << " hit bytes: " << succinctBytes(compressedHitBytes)
+        << " puts: " << numCompressedPut
+        << " rejected: " << numCompressedRejected
+        << " eviction: " << numCompressedEvict << "\n";
+  }
+  // Cache timing stats.
+  out << "Alloc Megaclocks " << (allocClocks >> 20);
   return out.str();
 }
 
@@ -1059,7 +1214,7 @@ CoalesceIoStats readPins(
 
 std::vector<AsyncDataCacheEntry*> CacheShard::testingCacheEntries() const {
   std::vector<AsyncDataCacheEntry*> entries;
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   entries.reserve(entries_.size());
   for (const auto& entry : entries_) {
     entries.push_back(entry.get());
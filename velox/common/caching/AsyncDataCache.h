@@ -19,6 +19,7 @@
 #include <deque>
 
 #include <fmt/format.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
@@ -30,6 +31,7 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
@@ -43,6 +45,7 @@ namespace facebook::velox::cache {
 
 class AsyncDataCache;
 class CacheShard;
+class CompressedCacheTier;
 class SsdCache;
 struct SsdCacheStats;
 class SsdFile;
@@ -61,9 +64,10 @@ inline AccessTime accessTime() {
   return folly::hardware_timestamp() >> 21;
 }
 
+/// Updated by concurrent readers of a cache entry, hence the relaxed atomics.
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  std::atomic<AccessTime> lastUse{0};
+  std::atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -88,8 +92,8 @@ struct AccessStats {
 
   // Updates the last access.
   void touch() {
-    lastUse = accessTime();
-    ++numUses;
+    lastUse.store(accessTime(), std::memory_order_relaxed);
+    numUses.fetch_add(1, std::memory_order_relaxed);
   }
 };
 
@@ -223,6 +227,17 @@ class AsyncDataCacheEntry {
     return value;
   }
 
+  /// Marks 'this' as loaded by a cache warming read. See
+  /// io::ReaderOptions::setCacheWarm().
+  void setWarm() {
+    isWarm_ = true;
+  }
+
+  /// Returns true on the first call after setWarm().
+  bool getAndClearWarmFlag() {
+    return isWarm_.exchange(false);
+  }
+
   /// If 'ssdSavable' is true, marks the loaded cache entry as ssdSavable if it
   /// is not loaded from ssd.
   void setExclusiveToShared(bool ssdSavable = true);
@@ -249,10 +264,18 @@ class AsyncDataCacheEntry {
     trackingId_ = id;
   }
 
+  TrackingId trackingId() const {
+    return trackingId_;
+  }
+
   void setGroupId(uint64_t groupId) {
     groupId_ = groupId;
   }
 
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -301,7 +324,8 @@ class AsyncDataCacheEntry {
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this from 0 to 1 requires owning shard_->mutex_ at least in
+  // shared mode. Setting this to kExclusive requires owning it exclusively.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -316,6 +340,9 @@ class AsyncDataCacheEntry {
   // statistics only.
   std::atomic<bool> isFirstUse_{false};
 
+  // True if loaded by a cache warming read and not yet hit by another reader.
+  std::atomic<bool> isWarm_{false};
+
   // Group id. Used for deciding if 'this' should be written to SSD.
   uint64_t groupId_{0};
 
@@ -335,6 +362,10 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // True if the SSD admission policy has rejected this. Accessed under the
+  // shard mutex.
+  bool ssdRejected_{false};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -446,8 +477,10 @@ class CoalescedLoad {
     return state_;
   }
 
-  void cancel() {
-    setEndState(State::kCancelled);
+  /// Cancels 'this'. Returns true if the load had not started, i.e. its IO
+  /// was avoided.
+  bool cancel() {
+    return setEndState(State::kCancelled) == State::kPlanned;
   }
 
   /// Returns the cache space 'this' will occupy after loaded.
@@ -466,8 +499,9 @@ class CoalescedLoad {
   // visible to other users of the cache.
   virtual std::vector<CachePin> loadData(bool prefetch) = 0;
 
-  // Sets a final state and resumes waiting threads.
-  void setEndState(State endState);
+  // Sets a final state and resumes waiting threads. Returns the previous
+  // state.
+  State setEndState(State endState);
 
   // Serializes access to all members.
   mutable std::mutex mutex_;
@@ -539,6 +573,19 @@ struct CacheStats {
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
 
+  /// Stats of the compressed memory tier, if enabled. Hits in this tier are
+  /// not counted in 'numHit'. 'numCompressedEntries', 'compressedBytes' and
+  /// 'compressedUncompressedBytes' are snapshot stats, the others are
+  /// cumulative.
+  int64_t numCompressedEntries{0};
+  int64_t compressedBytes{0};
+  int64_t compressedUncompressedBytes{0};
+  int64_t numCompressedPut{0};
+  int64_t numCompressedRejected{0};
+  int64_t numCompressedHit{0};
+  int64_t compressedHitBytes{0};
+  int64_t numCompressedEvict{0};
+
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
@@ -572,7 +619,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -609,6 +656,9 @@ class CacheShard {
   /// calling this a second time.
   void appendSsdSaveable(std::vector<CachePin>& pins);
 
+  /// Appends a read pin on each filled entry of 'this' to 'pins'.
+  void appendFilled(std::vector<CachePin>& pins);
+
   /// Remove cache entries from this shard for files in the fileNum set
   /// 'filesToRemove'. If successful, return true, and 'filesRetained' contains
   /// entries that should not be removed, ex., in exclusive mode or in shared
@@ -639,6 +689,11 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Returns a pin on the shared entry for 'key' if it is readable without
+  // changing its state. Holds 'mutex_' in shared mode so that concurrent
+  // hits do not serialize. Returns an empty pin otherwise.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
@@ -646,7 +701,9 @@ class CacheShard {
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
 
-  mutable std::mutex mutex_;
+  // Held in shared mode for cache hits and exclusively for anything that
+  // changes 'entryMap_' or makes entries exclusive.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -659,13 +716,13 @@ class CacheShard {
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
   // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  std::atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
   // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  std::atomic<uint64_t> numHit_{0};
   // Cumulative Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -693,10 +750,15 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        uint64_t _compressedTierBytes = 0,
+        common::CompressionKind _compressedTierKind =
+            common::CompressionKind_LZ4)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          compressedTierBytes(_compressedTierBytes),
+          compressedTierKind(_compressedTierKind){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -715,6 +777,14 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// Budget in compressed bytes of the tier that keeps compressed copies of
+    /// evicted entries in memory. 0 disables the tier. See
+    /// CompressedCacheTier.
+    uint64_t compressedTierBytes;
+
+    /// Codec of the compressed tier.
+    common::CompressionKind compressedTierKind;
   };
 
   AsyncDataCache(
@@ -802,6 +872,11 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Returns the compressed memory tier or nullptr if it is not enabled.
+  CompressedCacheTier* compressedTier() const {
+    return compressedTier_.get();
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -844,6 +919,11 @@ class AsyncDataCache : public memory::Cache {
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
   void saveToSsd();
 
+  /// Returns read pins on the filled entries of all shards. The pinned
+  /// entries are not evicted until the pins are dropped. Used for saving the
+  /// cache contents, see CacheSnapshot.
+  std::vector<CachePin> pinFilledEntries();
+
   tsan_atomic<int32_t>& numSkippedSaves() {
     return numSkippedSaves_;
   }
@@ -882,6 +962,9 @@ class AsyncDataCache : public memory::Cache {
   const Options opts_;
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  // Holds compressed copies of evicted entries. Must be destructed after
+  // 'shards_' since these add to it on eviction.
+  std::unique_ptr<CompressedCacheTier> compressedTier_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
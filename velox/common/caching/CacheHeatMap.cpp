@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheHeatMap.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+void HeatMapCounters::add(const HeatMapCounters& other) {
+  referencedBytes += other.referencedBytes;
+  readBytes += other.readBytes;
+  ramBytes += other.ramBytes;
+  ssdBytes += other.ssdBytes;
+  storageBytes += other.storageBytes;
+  prefetchBytes += other.prefetchBytes;
+  prefetchHitBytes += other.prefetchHitBytes;
+  prefetchWastedBytes += other.prefetchWastedBytes;
+}
+
+HeatMapCounters HeatMapCounters::operator-(
+    const HeatMapCounters& other) const {
+  HeatMapCounters result;
+  result.referencedBytes = referencedBytes - other.referencedBytes;
+  result.readBytes = readBytes - other.readBytes;
+  result.ramBytes = ramBytes - other.ramBytes;
+  result.ssdBytes = ssdBytes - other.ssdBytes;
+  result.storageBytes = storageBytes - other.storageBytes;
+  result.prefetchBytes = prefetchBytes - other.prefetchBytes;
+  result.prefetchHitBytes = prefetchHitBytes - other.prefetchHitBytes;
+  result.prefetchWastedBytes = prefetchWastedBytes - other.prefetchWastedBytes;
+  return result;
+}
+
+bool HeatMapCounters::operator==(const HeatMapCounters& other) const {
+  return referencedBytes == other.referencedBytes &&
+      readBytes == other.readBytes && ramBytes == other.ramBytes &&
+      ssdBytes == other.ssdBytes && storageBytes == other.storageBytes &&
+      prefetchBytes == other.prefetchBytes &&
+      prefetchHitBytes == other.prefetchHitBytes &&
+      prefetchWastedBytes == other.prefetchWastedBytes;
+}
+
+int32_t HeatMapCounters::prefetchHitPct() const {
+  if (prefetchBytes == 0) {
+    return 100;
+  }
+  return std::min<int64_t>(100, 100 * prefetchHitBytes / prefetchBytes);
+}
+
+std::string HeatMapCounters::toString() const {
+  return fmt::format(
+      "referenced {} read {} ram {} ssd {} storage {} prefetch {} "
+      "prefetch hit {}% prefetch wasted {}",
+      succinctBytes(referencedBytes),
+      succinctBytes(readBytes),
+      succinctBytes(ramBytes),
+      succinctBytes(ssdBytes),
+      succinctBytes(storageBytes),
+      succinctBytes(prefetchBytes),
+      prefetchHitPct(),
+      succinctBytes(prefetchWastedBytes));
+}
+
+void CacheHeatMap::recordLoad(
+    uint64_t groupId,
+    TrackingId trackingId,
+    Source source,
+    int64_t bytes,
+    bool prefetch) {
+  if (!enabled_) {
+    return;
+  }
+  update(groupId, trackingId, [&](auto& counters) {
+    switch (source) {
+      case Source::kRam:
+        counters.ramBytes += bytes;
+        break;
+      case Source::kSsd:
+        counters.ssdBytes += bytes;
+        break;
+      case Source::kStorage:
+        counters.storageBytes += bytes;
+        break;
+    }
+    if (prefetch) {
+      counters.prefetchBytes += bytes;
+    }
+  });
+}
+
+HeatMapCounters CacheHeatMap::totals() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return totals_;
+}
+
+std::vector<CacheHeatMap::Entry> CacheHeatMap::entries(
+    int32_t maxEntries) const {
+  std::vector<Entry> result;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    result.reserve(entries_.size());
+    for (const auto& [key, counters] : entries_) {
+      result.push_back({key.groupId, key.column, counters});
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.counters.readBytes > b.counters.readBytes;
+  });
+  if (result.size() > static_cast<size_t>(maxEntries)) {
+    result.resize(maxEntries);
+  }
+  return result;
+}
+
+void CacheHeatMap::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  totals_ = HeatMapCounters{};
+}
+
+std::string CacheHeatMap::toString(int32_t maxEntries) const {
+  std::stringstream out;
+  out << "CacheHeatMap: " << totals().toString() << std::endl;
+  for (const auto& entry : entries(maxEntries)) {
+    out << fileIds().string(entry.groupId) << " column " << entry.column
+        << ": " << entry.counters.toString() << std::endl;
+  }
+  return out.str();
+}
+
+CacheHeatMap& cacheHeatMap() {
+  static CacheHeatMap* heatMap = new CacheHeatMap();
+  return *heatMap;
+}
+
+} // namespace facebook::velox::cache
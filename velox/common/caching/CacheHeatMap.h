@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/ScanTracker.h"
+
+namespace facebook::velox::cache {
+
+/// Bytes accessed in a column of a file group, e.g. a Hive partition.
+struct HeatMapCounters {
+  /// Bytes that scans planned to read. See ScanTracker::recordReference().
+  int64_t referencedBytes{0};
+  /// Bytes that scans read. See ScanTracker::recordRead().
+  int64_t readBytes{0};
+  /// Bytes found in the memory cache.
+  int64_t ramBytes{0};
+  /// Bytes loaded from the SSD cache.
+  int64_t ssdBytes{0};
+  /// Bytes loaded from remote storage.
+  int64_t storageBytes{0};
+  /// Bytes loaded ahead of use. These are also counted in 'ssdBytes' or
+  /// 'storageBytes'.
+  int64_t prefetchBytes{0};
+  /// Prefetched bytes that were used.
+  int64_t prefetchHitBytes{0};
+  /// Prefetched bytes that were removed from the memory cache before use.
+  int64_t prefetchWastedBytes{0};
+
+  void add(const HeatMapCounters& other);
+
+  HeatMapCounters operator-(const HeatMapCounters& other) const;
+
+  bool operator==(const HeatMapCounters& other) const;
+
+  /// Returns the percentage of prefetched bytes that were used. 100 if
+  /// nothing was prefetched.
+  int32_t prefetchHitPct() const;
+
+  std::string toString() const;
+};
+
+/// Counts the bytes that scans reference and read per column and file group,
+/// and where the bytes come from: memory cache, SSD cache or storage. This
+/// shows how much memory and SSD cache a working set needs and which columns
+/// are worth clustering. Recording is a no-op unless enabled, so that the
+/// cost of the mutex is only paid when the heat map is exported.
+class CacheHeatMap {
+ public:
+  static constexpr int32_t kDefaultMaxEntries = 100'000;
+
+  enum class Source { kRam, kSsd, kStorage };
+
+  struct Entry {
+    uint64_t groupId;
+    int32_t column;
+    HeatMapCounters counters;
+  };
+
+  /// Keeps at most 'maxEntries' distinct group and column pairs. Accesses to
+  /// further pairs are only counted in totals().
+  explicit CacheHeatMap(int32_t maxEntries = kDefaultMaxEntries)
+      : maxEntries_(maxEntries) {}
+
+  void setEnabled(bool enabled) {
+    enabled_ = enabled;
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  void recordReference(uint64_t groupId, TrackingId trackingId, int64_t bytes) {
+    if (enabled_) {
+      update(groupId, trackingId, [&](auto& counters) {
+        counters.referencedBytes += bytes;
+      });
+    }
+  }
+
+  void recordRead(uint64_t groupId, TrackingId trackingId, int64_t bytes) {
+    if (enabled_) {
+      update(groupId, trackingId, [&](auto& counters) {
+        counters.readBytes += bytes;
+      });
+    }
+  }
+
+  /// Records that 'bytes' were found in or loaded from 'source'. 'prefetch'
+  /// is true if the load is ahead of use.
+  void recordLoad(
+      uint64_t groupId,
+      TrackingId trackingId,
+      Source source,
+      int64_t bytes,
+      bool prefetch = false);
+
+  void recordPrefetchHit(
+      uint64_t groupId,
+      TrackingId trackingId,
+      int64_t bytes) {
+    if (enabled_) {
+      update(groupId, trackingId, [&](auto& counters) {
+        counters.prefetchHitBytes += bytes;
+      });
+    }
+  }
+
+  void recordPrefetchWasted(
+      uint64_t groupId,
+      TrackingId trackingId,
+      int64_t bytes) {
+    if (enabled_) {
+      update(groupId, trackingId, [&](auto& counters) {
+        counters.prefetchWastedBytes += bytes;
+      });
+    }
+  }
+
+  /// Returns the sum of the counters of all accesses since the last clear().
+  HeatMapCounters totals() const;
+
+  /// Returns at most 'maxEntries' entries, the ones with the most read bytes
+  /// first.
+  std::vector<Entry> entries(
+      int32_t maxEntries = std::numeric_limits<int32_t>::max()) const;
+
+  /// Resets the counters. PeriodicStatsReporter reports the change of
+  /// totals() since its last report, so this is not for use while it runs.
+  void clear();
+
+  /// Returns the totals and the 'maxEntries' hottest entries, one per line.
+  /// Groups are named by their path in fileIds().
+  std::string toString(int32_t maxEntries) const;
+
+  /// Returns the column of 'trackingId', i.e. the node in the file schema
+  /// without the stream kind. -1 if 'trackingId' is empty.
+  static int32_t column(TrackingId trackingId) {
+    return trackingId.empty() ? -1 : trackingId.id() >> kStreamKindBits;
+  }
+
+ private:
+  // The low bits of a TrackingId that give the stream kind.
+  static constexpr int32_t kStreamKindBits = 5;
+
+  struct Key {
+    uint64_t groupId;
+    int32_t column;
+
+    bool operator==(const Key& other) const {
+      return groupId == other.groupId && column == other.column;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(key.groupId, key.column);
+    }
+  };
+
+  template <typename Func>
+  void update(uint64_t groupId, TrackingId trackingId, Func func) {
+    std::lock_guard<std::mutex> l(mutex_);
+    func(totals_);
+    const Key key{groupId, column(trackingId)};
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      if (entries_.size() >= static_cast<size_t>(maxEntries_)) {
+        return;
+      }
+      it = entries_.try_emplace(key).first;
+    }
+    func(it->second);
+  }
+
+  const int32_t maxEntries_;
+  std::atomic<bool> enabled_{false};
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<Key, HeatMapCounters, KeyHasher> entries_;
+  HeatMapCounters totals_;
+};
+
+/// Returns the process-wide heat map that scans record in.
+CacheHeatMap& cacheHeatMap();
+
+} // namespace facebook::velox::cache
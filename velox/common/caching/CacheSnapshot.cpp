@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheSnapshot.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/Crc.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Bytes after the index: the position of the index and the magic number.
+constexpr int32_t kFooterSize = sizeof(uint64_t) + sizeof(int32_t);
+
+// Writes smaller than this are buffered.
+constexpr int64_t kMaxBufferedWrite = 64 << 10;
+constexpr int64_t kWriteBufferSize = 1 << 20;
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readNumber(const char*& ptr, const char* end) {
+  VELOX_CHECK_LE(ptr + sizeof(T), end, "Truncated cache snapshot");
+  T value;
+  ::memcpy(&value, ptr, sizeof(T));
+  ptr += sizeof(T);
+  return value;
+}
+
+// Calls 'func' with the consecutive ranges holding the data of 'entry'.
+template <typename Func>
+void forEachRange(AsyncDataCacheEntry& entry, Func func) {
+  if (entry.tinyData() != nullptr) {
+    func(entry.tinyData(), entry.size());
+    return;
+  }
+  const auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+    func(run.data<char>(), bytes);
+    bytesLeft -= bytes;
+  }
+}
+
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(const std::string& path) : path_(path) {
+    fd_ = ::open(
+        path_.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+    VELOX_CHECK_GE(
+        fd_,
+        0,
+        "Cannot create cache snapshot {}: {}",
+        path_,
+        folly::errnoStr(errno));
+    buffer_.reserve(kWriteBufferSize);
+  }
+
+  ~SnapshotWriter() {
+    ::close(fd_);
+  }
+
+  void write(const char* data, int64_t size) {
+    if (size < kMaxBufferedWrite) {
+      buffer_.append(data, size);
+      if (buffer_.size() >= kWriteBufferSize) {
+        flush();
+      }
+    } else {
+      flush();
+      writeFully(data, size);
+    }
+    position_ += size;
+  }
+
+  void flush() {
+    writeFully(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+
+  void sync() {
+    flush();
+    VELOX_CHECK_EQ(
+        ::fsync(fd_),
+        0,
+        "Cannot sync cache snapshot {}: {}",
+        path_,
+        folly::errnoStr(errno));
+  }
+
+  uint64_t position() const {
+    return position_;
+  }
+
+ private:
+  void writeFully(const char* data, int64_t size) {
+    while (size > 0) {
+      const auto written = ::write(fd_, data, size);
+      VELOX_CHECK_GT(
+          written,
+          0,
+          "Cannot write cache snapshot {}: {}",
+          path_,
+          folly::errnoStr(errno));
+      data += written;
+      size -= written;
+    }
+  }
+
+  const std::string path_;
+  int32_t fd_;
+  std::string buffer_;
+  uint64_t position_{0};
+};
+} // namespace
+
+CacheSnapshot::Stats CacheSnapshot::save(
+    AsyncDataCache& cache,
+    const std::string& path) {
+  const auto startUs = getCurrentTimeMicro();
+  Stats stats;
+  const auto tempPath = path + ".tmp";
+  {
+    SnapshotWriter writer(tempPath);
+    std::string header;
+    appendNumber(header, kMagic);
+    appendNumber(header, kVersion);
+    writer.write(header.data(), header.size());
+
+    // Index in 'names' for each file id.
+    folly::F14FastMap<uint64_t, int32_t> fileIndices;
+    std::string names;
+    std::string index;
+    auto pins = cache.pinFilledEntries();
+    for (auto& pin : pins) {
+      auto* entry = pin.checkedEntry();
+      const auto fileNum = entry->key().fileNum.id();
+      auto it = fileIndices.find(fileNum);
+      if (it == fileIndices.end()) {
+        it = fileIndices.emplace(fileNum, fileIndices.size()).first;
+        const auto name = fileIds().string(fileNum);
+        appendNumber<int32_t>(names, name.size());
+        names.append(name);
+      }
+      const auto position = writer.position();
+      bits::Crc32 crc;
+      forEachRange(*entry, [&](const char* data, int64_t size) {
+        crc.process_bytes(data, size);
+        writer.write(data, size);
+      });
+      appendNumber(index, it->second);
+      appendNumber<uint64_t>(index, entry->offset());
+      appendNumber<int64_t>(index, entry->size());
+      appendNumber(index, crc.checksum());
+      appendNumber(index, position);
+      ++stats.numEntries;
+      stats.bytes += entry->size();
+    }
+    pins.clear();
+
+    const uint64_t indexPosition = writer.position();
+    std::string trailer;
+    appendNumber<int32_t>(trailer, fileIndices.size());
+    trailer.append(names);
+    appendNumber(trailer, stats.numEntries);
+    trailer.append(index);
+    appendNumber(trailer, indexPosition);
+    appendNumber(trailer, kMagic);
+    writer.write(trailer.data(), trailer.size());
+    writer.sync();
+  }
+  VELOX_CHECK_EQ(
+      ::rename(tempPath.c_str(), path.c_str()),
+      0,
+      "Cannot rename cache snapshot {}: {}",
+      tempPath,
+      folly::errnoStr(errno));
+  stats.elapsedUs = getCurrentTimeMicro() - startUs;
+  VELOX_CACHE_LOG(INFO) << "Saved " << stats.numEntries << " entries, "
+                        << succinctBytes(stats.bytes) << " to " << path
+                        << " in " << succinctMicros(stats.elapsedUs);
+  return stats;
+}
+
+CacheSnapshot::Stats CacheSnapshot::load(
+    AsyncDataCache& cache,
+    const std::string& path,
+    const std::function<bool(const std::string& fileName)>& validateFile) {
+  const auto startUs = getCurrentTimeMicro();
+  Stats stats;
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+  VELOX_CHECK_GE(
+      fd, 0, "Cannot open cache snapshot {}: {}", path, folly::errnoStr(errno));
+  SCOPE_EXIT {
+    ::close(fd);
+  };
+  struct stat fileStat;
+  VELOX_CHECK_EQ(::fstat(fd, &fileStat), 0);
+  const uint64_t size = fileStat.st_size;
+  VELOX_CHECK_GE(
+      size,
+      2 * sizeof(int32_t) + kFooterSize,
+      "Truncated cache snapshot {}",
+      path);
+  // The data is copied from the mapped file to the cache without going
+  // through a read buffer.
+  void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  VELOX_CHECK(
+      mapped != MAP_FAILED,
+      "Cannot map cache snapshot {}: {}",
+      path,
+      folly::errnoStr(errno));
+  SCOPE_EXIT {
+    ::munmap(mapped, size);
+  };
+  ::madvise(mapped, size, MADV_SEQUENTIAL);
+
+  const char* const begin = static_cast<const char*>(mapped);
+  const char* const indexEnd = begin + size - kFooterSize;
+  const char* ptr = begin;
+  VELOX_CHECK_EQ(
+      readNumber<int32_t>(ptr, indexEnd),
+      kMagic,
+      "Not a cache snapshot: {}",
+      path);
+  VELOX_CHECK_EQ(readNumber<int32_t>(ptr, indexEnd), kVersion);
+  const char* footer = indexEnd;
+  const auto indexPosition = readNumber<uint64_t>(footer, begin + size);
+  VELOX_CHECK_EQ(
+      readNumber<int32_t>(footer, begin + size),
+      kMagic,
+      "Incomplete cache snapshot {}",
+      path);
+  VELOX_CHECK_LE(indexPosition, size - kFooterSize);
+
+  ptr = begin + indexPosition;
+  const auto numFiles = readNumber<int32_t>(ptr, indexEnd);
+  // A lease on the id of each valid file. Files that fail validation have an
+  // empty lease.
+  std::vector<StringIdLease> files(numFiles);
+  for (auto i = 0; i < numFiles; ++i) {
+    const auto length = readNumber<int32_t>(ptr, indexEnd);
+    VELOX_CHECK_LE(ptr + length, indexEnd, "Truncated cache snapshot");
+    std::string name(ptr, length);
+    ptr += length;
+    if (validateFile == nullptr || validateFile(name)) {
+      files[i] = StringIdLease(fileIds(), name);
+    }
+  }
+
+  const auto numEntries = readNumber<int64_t>(ptr, indexEnd);
+  for (auto i = 0; i < numEntries; ++i) {
+    const auto fileIndex = readNumber<int32_t>(ptr, indexEnd);
+    const auto offset = readNumber<uint64_t>(ptr, indexEnd);
+    const auto entrySize = readNumber<int64_t>(ptr, indexEnd);
+    const auto checksum = readNumber<uint32_t>(ptr, indexEnd);
+    const auto position = readNumber<uint64_t>(ptr, indexEnd);
+    VELOX_CHECK_LT(fileIndex, numFiles);
+    VELOX_CHECK_LE(position + entrySize, indexPosition);
+    const auto& file = files[fileIndex];
+    if (!file.hasValue()) {
+      ++stats.numSkipped;
+      continue;
+    }
+
+    CachePin pin;
+    try {
+      pin = cache.findOrCreate({file.id(), offset}, entrySize, nullptr);
+    } catch (const VeloxRuntimeError& e) {
+      if (e.errorCode() != error_code::kNoCacheSpace) {
+        throw;
+      }
+      stats.numSkipped += numEntries - i;
+      break;
+    }
+    // The entry is already in the cache or being loaded.
+    if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+      ++stats.numSkipped;
+      continue;
+    }
+
+    const char* data = begin + position;
+    bits::Crc32 crc;
+    crc.process_bytes(data, entrySize);
+    if (crc.checksum() != checksum) {
+      // Dropping the exclusive pin removes the entry.
+      ++stats.numSkipped;
+      continue;
+    }
+    auto* entry = pin.checkedEntry();
+    forEachRange(*entry, [&](char* range, int64_t bytes) {
+      ::memcpy(range, data, bytes);
+      data += bytes;
+    });
+    // The entries came from storage or SSD before the restart. SsdCache has
+    // its own checkpoint, so these are not written to SSD again.
+    entry->setExclusiveToShared(false);
+    ++stats.numEntries;
+    stats.bytes += entrySize;
+  }
+  stats.elapsedUs = getCurrentTimeMicro() - startUs;
+  VELOX_CACHE_LOG(INFO) << "Loaded " << stats.numEntries << " entries, "
+                        << succinctBytes(stats.bytes) << " from " << path
+                        << " in " << succinctMicros(stats.elapsedUs)
+                        << ", skipped " << stats.numSkipped;
+  return stats;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Saves the contents of an AsyncDataCache to a file and loads them back, so
+/// that a restarted process starts with the data its predecessor had in memory
+/// instead of fetching it again from storage. The file is meant to be on a
+/// memory backed file system like tmpfs or a DAX device, which survives a
+/// process restart. It is memory mapped for loading.
+///
+/// The file has the data of the entries, followed by an index of the file names
+/// and of {file, offset, size, checksum, position of data} for each entry, and
+/// a footer with the position of the index. Entries are keyed by file name
+/// since file ids are not stable across processes.
+class CacheSnapshot {
+ public:
+  struct Stats {
+    /// Number of entries saved or loaded.
+    int64_t numEntries{0};
+    /// Bytes of data saved or loaded.
+    int64_t bytes{0};
+    /// Entries not loaded because their file failed validation, their data
+    /// did not match the checksum, the key was already in the cache or the
+    /// cache was full.
+    int64_t numSkipped{0};
+    /// Wall time of the save or load.
+    uint64_t elapsedUs{0};
+  };
+
+  /// Writes the filled entries of 'cache' to 'path'. Entries being loaded are
+  /// skipped. The file is written under a temporary name and renamed to 'path'
+  /// when complete. Meant for a graceful shutdown: the saved entries are
+  /// pinned, and so not evictable, while this runs.
+  static Stats save(AsyncDataCache& cache, const std::string& path);
+
+  /// Adds the entries saved in 'path' to 'cache'. 'validateFile' is called
+  /// once for each file name in the snapshot and returns false if the file
+  /// may have changed since the snapshot was made. The entries of such files
+  /// are not loaded. Stops at the first entry for which the cache has no
+  /// space. Throws if 'path' is not a complete snapshot.
+  static Stats load(
+      AsyncDataCache& cache,
+      const std::string& path,
+      const std::function<bool(const std::string& fileName)>& validateFile =
+          nullptr);
+
+ private:
+  // Magic number at the start and end of a snapshot.
+  static constexpr int32_t kMagic = 0x53434456; // "VDCS"
+  static constexpr int32_t kVersion = 1;
+};
+
+} // namespace facebook::velox::cache
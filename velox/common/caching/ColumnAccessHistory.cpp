@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/ColumnAccessHistory.h"
+
+#include <folly/json.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/caching/CacheHeatMap.h"
+
+namespace facebook::velox::cache {
+
+void ColumnAccessHistory::recordScan(ScanTracker& tracker) {
+  if (!enabled_ || tracker.table().empty()) {
+    return;
+  }
+  folly::F14FastMap<int32_t, int64_t> columnReadBytes;
+  for (const auto& [id, data] : tracker.allTrackingData()) {
+    if (data.readBytes > 0 && !id.empty()) {
+      columnReadBytes[CacheHeatMap::column(id)] += data.readBytes;
+    }
+  }
+  recordScan(tracker.table(), columnReadBytes);
+}
+
+void ColumnAccessHistory::recordScan(
+    std::string_view table,
+    const folly::F14FastMap<int32_t, int64_t>& columnReadBytes) {
+  if (!enabled_ || columnReadBytes.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tables_.find(std::string(table));
+  if (it == tables_.end()) {
+    if (tables_.size() >= static_cast<size_t>(maxTables_)) {
+      return;
+    }
+    it = tables_.try_emplace(std::string(table)).first;
+  }
+  auto& history = it->second;
+  history.numScans = history.numScans * kDecay + 1;
+  for (auto& [column, stats] : history.columns) {
+    stats.numScans *= kDecay;
+    stats.readBytes *= kDecay;
+  }
+  for (const auto& [column, bytes] : columnReadBytes) {
+    auto& stats = history.columns[column];
+    stats.numScans += 1;
+    stats.readBytes += bytes;
+  }
+}
+
+std::vector<int32_t> ColumnAccessHistory::predictColumns(
+    std::string_view table,
+    int32_t minScanPct) const {
+  std::vector<std::pair<int32_t, double>> hot;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = tables_.find(std::string(table));
+    if (it == tables_.end()) {
+      return {};
+    }
+    const auto& history = it->second;
+    for (const auto& [column, stats] : history.columns) {
+      if (100 * stats.numScans >= minScanPct * history.numScans) {
+        hot.emplace_back(column, stats.readBytes);
+      }
+    }
+  }
+  std::sort(hot.begin(), hot.end(), [](const auto& left, const auto& right) {
+    return left.second > right.second ||
+        (left.second == right.second && left.first < right.first);
+  });
+  std::vector<int32_t> columns;
+  columns.reserve(hot.size());
+  for (const auto& [column, bytes] : hot) {
+    columns.push_back(column);
+  }
+  return columns;
+}
+
+std::optional<ColumnAccessHistory::TableHistory>
+ColumnAccessHistory::tableHistory(std::string_view table) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tables_.find(std::string(table));
+  if (it == tables_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+int32_t ColumnAccessHistory::numTables() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return tables_.size();
+}
+
+std::string ColumnAccessHistory::serialize() const {
+  folly::dynamic tables = folly::dynamic::object;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& [name, history] : tables_) {
+      folly::dynamic columns = folly::dynamic::array;
+      for (const auto& [column, stats] : history.columns) {
+        columns.push_back(
+            folly::dynamic::array(column, stats.numScans, stats.readBytes));
+      }
+      tables[name] = folly::dynamic::object("numScans", history.numScans)(
+          "columns", std::move(columns));
+    }
+  }
+  return folly::toJson(tables);
+}
+
+void ColumnAccessHistory::deserialize(std::string_view json) {
+  const auto tables = folly::parseJson(json);
+  VELOX_CHECK(tables.isObject(), "Column access history is not an object");
+  folly::F14FastMap<std::string, TableHistory> newTables;
+  for (const auto& [name, table] : tables.items()) {
+    auto& history = newTables[name.asString()];
+    history.numScans = table["numScans"].asDouble();
+    for (const auto& column : table["columns"]) {
+      VELOX_CHECK_EQ(column.size(), 3);
+      history.columns[column[0].asInt()] =
+          ColumnStats{column[1].asDouble(), column[2].asDouble()};
+    }
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  tables_ = std::move(newTables);
+}
+
+void ColumnAccessHistory::save(const std::string& path) const {
+  const auto json = serialize();
+  std::ofstream out(path, std::ios::trunc);
+  out << json;
+  out.close();
+  VELOX_CHECK(!out.fail(), "Failed to write column access history {}", path);
+}
+
+void ColumnAccessHistory::load(const std::string& path) {
+  std::ifstream in(path);
+  VELOX_CHECK(in.good(), "Failed to open column access history {}", path);
+  std::stringstream json;
+  json << in.rdbuf();
+  deserialize(json.str());
+}
+
+void ColumnAccessHistory::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  tables_.clear();
+}
+
+ColumnAccessHistory& columnAccessHistory() {
+  static ColumnAccessHistory history;
+  return history;
+}
+
+} // namespace facebook::velox::cache
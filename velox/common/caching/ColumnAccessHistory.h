@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "velox/common/caching/ScanTracker.h"
+
+namespace facebook::velox::cache {
+
+/// Column access frequencies per table, aggregated over finished scans. A
+/// ScanTracker only informs the prefetch of its own scan. Recurring queries
+/// read the same columns from each newly added partition, so the history of
+/// the table predicts which columns of a new file will be read before any
+/// query reads them. Columns are nodes in the file schema as given by
+/// CacheHeatMap::column(). Recording is a no-op unless enabled.
+class ColumnAccessHistory {
+ public:
+  /// Weight of the earlier scans of a table when a scan is recorded, so that
+  /// the history follows changes in the queries.
+  static constexpr double kDecay = 0.9;
+
+  static constexpr int32_t kDefaultMaxTables = 10'000;
+
+  struct ColumnStats {
+    /// Number of scans that read the column, each weighted by kDecay to the
+    /// power of the number of later scans of the table.
+    double numScans{0};
+    /// Bytes read per scan, weighted like 'numScans'.
+    double readBytes{0};
+  };
+
+  struct TableHistory {
+    /// Number of scans of the table, weighted like ColumnStats::numScans.
+    double numScans{0};
+    folly::F14FastMap<int32_t, ColumnStats> columns;
+  };
+
+  /// Keeps the history of at most 'maxTables' tables. Scans of further tables
+  /// are not recorded.
+  explicit ColumnAccessHistory(int32_t maxTables = kDefaultMaxTables)
+      : maxTables_(maxTables) {}
+
+  void setEnabled(bool enabled) {
+    enabled_ = enabled;
+  }
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  /// Records the columns read by the scan of 'tracker'. No-op if the table of
+  /// 'tracker' is not known.
+  void recordScan(ScanTracker& tracker);
+
+  /// Records a scan of 'table' that read 'readBytes' from each of 'columns'.
+  void recordScan(
+      std::string_view table,
+      const folly::F14FastMap<int32_t, int64_t>& columnReadBytes);
+
+  /// Returns the columns of 'table' that at least 'minScanPct' % of the
+  /// recent scans read, the most read first. Empty if 'table' has no history.
+  std::vector<int32_t> predictColumns(
+      std::string_view table,
+      int32_t minScanPct) const;
+
+  /// Returns the history of 'table' or std::nullopt if it has none.
+  std::optional<TableHistory> tableHistory(std::string_view table) const;
+
+  int32_t numTables() const;
+
+  /// Returns the history as JSON for persisting it across restarts.
+  std::string serialize() const;
+
+  /// Replaces the history with the one in 'json', as returned by serialize().
+  void deserialize(std::string_view json);
+
+  /// Writes serialize() to the local file at 'path'.
+  void save(const std::string& path) const;
+
+  /// Reads the history written by save() from 'path'.
+  void load(const std::string& path);
+
+  void clear();
+
+ private:
+  const int32_t maxTables_;
+  std::atomic<bool> enabled_{false};
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, TableHistory> tables_;
+};
+
+/// Returns the process wide history that ScanTrackers record into when they
+/// are destroyed.
+ColumnAccessHistory& columnAccessHistory();
+
+} // namespace facebook::velox::cache
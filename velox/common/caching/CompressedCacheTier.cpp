@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CompressedCacheTier.h"
+
+#include <folly/io/IOBuf.h>
+
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+CompressedCacheTier::CompressedCacheTier(
+    uint64_t capacityBytes,
+    common::CompressionKind kind)
+    : capacityBytes_(capacityBytes), kind_(kind) {
+  VELOX_CHECK_NE(kind_, common::CompressionKind_NONE);
+}
+
+bool CompressedCacheTier::put(
+    const FileCacheKey& key,
+    int32_t size,
+    const memory::Allocation& data,
+    SsdFile* ssdFile,
+    uint64_t ssdOffset) {
+  // Compress outside of 'mutex_'.
+  std::unique_ptr<folly::IOBuf> input;
+  int64_t bytesLeft = size;
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), bytes);
+    if (input == nullptr) {
+      input = std::move(buffer);
+    } else {
+      input->prependChain(std::move(buffer));
+    }
+    bytesLeft -= bytes;
+  }
+  std::string compressed;
+  if (input != nullptr && bytesLeft == 0) {
+    auto codec = common::compressionKindToCodec(kind_);
+    auto output = codec->compress(input.get());
+    const auto compressedSize = output->computeChainDataLength();
+    if (compressedSize * 100 <
+            static_cast<uint64_t>(size) * kMaxCompressedPct &&
+        compressedSize <= capacityBytes_) {
+      compressed.reserve(compressedSize);
+      for (const auto& range : *output) {
+        compressed.append(
+            reinterpret_cast<const char*>(range.data()), range.size());
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  if (compressed.empty()) {
+    ++stats_.numRejected;
+    return false;
+  }
+  const RawFileCacheKey rawKey{key.fileNum.id(), key.offset};
+  auto it = entries_.find(rawKey);
+  if (it != entries_.end()) {
+    removeLocked(it);
+  }
+  while (!lru_.empty() &&
+         compressedBytes_ + compressed.size() > capacityBytes_) {
+    removeLocked(entries_.find(lru_.back()));
+    ++stats_.numEvict;
+  }
+  lru_.push_front(rawKey);
+  compressedBytes_ += compressed.size();
+  uncompressedBytes_ += size;
+  Entry entry{
+      key.fileNum,
+      size,
+      std::move(compressed),
+      ssdFile,
+      ssdOffset,
+      lru_.begin()};
+  entries_.emplace(rawKey, std::move(entry));
+  ++stats_.numPuts;
+  return true;
+}
+
+bool CompressedCacheTier::get(AsyncDataCacheEntry& entry) {
+  VELOX_CHECK(entry.isExclusive());
+  const RawFileCacheKey key{
+      entry.key().fileNum.id(), static_cast<uint64_t>(entry.offset())};
+  std::string compressed;
+  SsdFile* ssdFile;
+  uint64_t ssdOffset;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return false;
+    }
+    if (it->second.size != entry.size()) {
+      // The entry is superseded by a different size for the same key.
+      removeLocked(it);
+      return false;
+    }
+    compressed.swap(it->second.data);
+    compressedBytes_ -= compressed.size();
+    ssdFile = it->second.ssdFile;
+    ssdOffset = it->second.ssdOffset;
+    removeLocked(it);
+    ++stats_.numHit;
+    stats_.hitBytes += entry.size();
+  }
+
+  auto codec = common::compressionKindToCodec(kind_);
+  const auto data =
+      codec->uncompress(folly::StringPiece(compressed), entry.size());
+  VELOX_CHECK_EQ(data.size(), entry.size());
+  if (entry.tinyData() != nullptr) {
+    ::memcpy(entry.tinyData(), data.data(), entry.size());
+  } else {
+    const auto& allocation = entry.data();
+    uint64_t offset = 0;
+    for (auto i = 0; i < allocation.numRuns() && offset < data.size(); ++i) {
+      const auto run = allocation.runAt(i);
+      const auto bytes =
+          std::min<uint64_t>(data.size() - offset, run.numBytes());
+      ::memcpy(run.data<char>(), data.data() + offset, bytes);
+      offset += bytes;
+    }
+  }
+  entry.setSsdFile(ssdFile, ssdOffset);
+  return true;
+}
+
+void CompressedCacheTier::removeFileEntries(
+    const folly::F14FastSet<uint64_t>& filesToRemove) {
+  if (filesToRemove.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<RawFileCacheKey> toRemove;
+  for (const auto& [key, entry] : entries_) {
+    if (filesToRemove.count(key.fileNum) != 0) {
+      toRemove.push_back(key);
+    }
+  }
+  for (const auto& key : toRemove) {
+    removeLocked(entries_.find(key));
+  }
+}
+
+CompressedCacheTier::Stats CompressedCacheTier::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  stats.compressedBytes = compressedBytes_;
+  stats.uncompressedBytes = uncompressedBytes_;
+  return stats;
+}
+
+void CompressedCacheTier::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  compressedBytes_ = 0;
+  uncompressedBytes_ = 0;
+}
+
+void CompressedCacheTier::removeLocked(
+    folly::F14FastMap<RawFileCacheKey, Entry>::iterator it) {
+  VELOX_CHECK(it != entries_.end());
+  compressedBytes_ -= it->second.data.size();
+  uncompressedBytes_ -= it->second.size;
+  lru_.erase(it->second.lruPosition);
+  entries_.erase(it);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/compression/Compression.h"
+
+namespace facebook::velox::cache {
+
+/// Tier of AsyncDataCache between its uncompressed entries and SsdCache.
+/// Holds compressed copies of entries evicted from the memory cache, within a
+/// budget of compressed bytes. An entry that is looked up again is
+/// decompressed into a new cache entry instead of being read from SSD or
+/// storage and leaves the tier. The least recently stored entries are dropped
+/// when the tier is over its budget.
+///
+/// The compressed copies are allocated from the heap and not from the
+/// MemoryAllocator of the cache, so that evicting into the tier frees the
+/// allocator memory the cache asked for. The budget should be accounted for
+/// when sizing the process. Thread safe.
+class CompressedCacheTier {
+ public:
+  /// An entry is stored only if it compresses to less than this percentage of
+  /// its size.
+  static constexpr int32_t kMaxCompressedPct = 80;
+
+  struct Stats {
+    /// ============= Snapshot stats =============
+    int64_t numEntries{0};
+    /// Compressed bytes held.
+    int64_t compressedBytes{0};
+    /// Size of the held entries when uncompressed.
+    int64_t uncompressedBytes{0};
+
+    /// ============= Cumulative stats =============
+    /// Number of entries stored.
+    int64_t numPuts{0};
+    /// Number of evicted entries that did not compress well enough or did not
+    /// fit in the budget.
+    int64_t numRejected{0};
+    /// Number of lookups that found an entry.
+    int64_t numHit{0};
+    /// Uncompressed size of the entries counted in 'numHit'.
+    int64_t hitBytes{0};
+    /// Number of entries dropped to stay within the budget.
+    int64_t numEvict{0};
+  };
+
+  CompressedCacheTier(
+      uint64_t capacityBytes,
+      common::CompressionKind kind = common::CompressionKind_LZ4);
+
+  /// Stores the first 'size' bytes of 'data' for 'key'. 'ssdFile' and
+  /// 'ssdOffset' are the SSD location of the entry, if any, and are restored
+  /// on a hit. Returns false if the data is not stored.
+  bool put(
+      const FileCacheKey& key,
+      int32_t size,
+      const memory::Allocation& data,
+      SsdFile* ssdFile,
+      uint64_t ssdOffset);
+
+  /// Fills 'entry' from the entry for its key, if any, and removes it from
+  /// 'this'. 'entry' must be exclusive and have space for its size. Returns
+  /// false if there is no entry of the same size.
+  bool get(AsyncDataCacheEntry& entry);
+
+  /// Drops the entries of files in 'filesToRemove'.
+  void removeFileEntries(const folly::F14FastSet<uint64_t>& filesToRemove);
+
+  Stats stats() const;
+
+  uint64_t capacityBytes() const {
+    return capacityBytes_;
+  }
+
+  /// Drops all entries.
+  void clear();
+
+ private:
+  struct Entry {
+    // Keeps the file number from being reused while the entry exists.
+    StringIdLease fileNum;
+    int32_t size;
+    std::string data;
+    SsdFile* ssdFile;
+    uint64_t ssdOffset;
+    std::list<RawFileCacheKey>::iterator lruPosition;
+  };
+
+  // Removes the entry in 'it'. Requires 'mutex_'.
+  void removeLocked(folly::F14FastMap<RawFileCacheKey, Entry>::iterator it);
+
+  const uint64_t capacityBytes_;
+  const common::CompressionKind kind_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<RawFileCacheKey, Entry> entries_;
+  // Keys of 'entries_', most recently stored first.
+  std::list<RawFileCacheKey> lru_;
+  uint64_t compressedBytes_{0};
+  uint64_t uncompressedBytes_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::cache
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/caching/ScanTracker.h"
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/caching/FileGroupStats.h"
 
 #include <sstream>
@@ -31,6 +32,7 @@ void ScanTracker::recordReference(
   if (fileGroupStats_) {
     fileGroupStats_->recordReference(fileId, groupId, id, bytes);
   }
+  cacheHeatMap().recordReference(groupId, id, bytes);
   std::lock_guard<std::mutex> l(mutex_);
   data_[id].incrementReference(bytes, loadQuantum_);
   sum_.incrementReference(bytes, loadQuantum_);
@@ -44,6 +46,7 @@ void ScanTracker::recordRead(
   if (fileGroupStats_) {
     fileGroupStats_->recordRead(fileId, groupId, id, bytes);
   }
+  cacheHeatMap().recordRead(groupId, id, bytes);
   std::lock_guard<std::mutex> l(mutex_);
   data_[id].incrementRead(bytes);
   sum_.incrementRead(bytes);
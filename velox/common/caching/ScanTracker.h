@@ -19,6 +19,7 @@
 #include <folly/container/F14Map.h>
 #include <cstdint>
 #include <mutex>
+#include <vector>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
@@ -113,13 +114,15 @@ class ScanTracker {
   /// and will be referenced from a map from id to weak_ptr to 'this'.
   /// 'unregisterer' is supplied so that the destructor can remove the weak_ptr
   /// from the map of pending trackers. 'loadQuantum' is the largest single IO
-  /// size for read.
+  /// size for read. 'table' is the name of the scanned table, if known.
   ScanTracker(
       std::string_view id,
       std::function<void(ScanTracker*)> unregisterer,
       int32_t loadQuantum,
-      FileGroupStats* fileGroupStats = nullptr)
+      FileGroupStats* fileGroupStats = nullptr,
+      std::string_view table = {})
       : id_(id),
+        table_(table),
         unregisterer_(std::move(unregisterer)),
         loadQuantum_(loadQuantum),
         fileGroupStats_(fileGroupStats) {}
@@ -167,10 +170,20 @@ class ScanTracker {
     return data_[id];
   }
 
+  /// Returns the tracking data of all streams referenced or read so far.
+  std::vector<std::pair<TrackingId, TrackingData>> allTrackingData() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return {data_.begin(), data_.end()};
+  }
+
   std::string_view id() const {
     return id_;
   }
 
+  const std::string& table() const {
+    return table_;
+  }
+
   FileGroupStats* fileGroupStats() const {
     return fileGroupStats_;
   }
@@ -180,6 +193,8 @@ class ScanTracker {
  private:
   // Id of query + scan operator to track.
   const std::string id_;
+  // Name of the scanned table. Empty if not known.
+  const std::string table_;
   const std::function<void(ScanTracker*)> unregisterer_{nullptr};
   // Maximum size of a read. 10MB would count as two references if the quantum
   // were 8MB. At the same time this would count as a single 10MB reference for
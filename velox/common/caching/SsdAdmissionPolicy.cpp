@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+TinyLfuSsdAdmissionPolicy::TinyLfuSsdAdmissionPolicy(
+    uint64_t numCounters,
+    uint8_t minFrequency)
+    : minFrequency_(minFrequency),
+      rowMask_(
+          bits::nextPowerOfTwo(std::max<uint64_t>(numCounters / kNumRows, 64)) -
+          1),
+      sampleSize_(10 * kNumRows * (rowMask_ + 1)),
+      counters_(new std::atomic<uint8_t>[kNumRows * (rowMask_ + 1)]) {
+  VELOX_CHECK_GT(minFrequency_, 0);
+  VELOX_CHECK_LE(minFrequency_, kMaxCount);
+  for (uint64_t i = 0; i < kNumRows * (rowMask_ + 1); ++i) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+uint64_t TinyLfuSsdAdmissionPolicy::index(uint64_t hash, int32_t row) const {
+  // Double hashing with an odd step gives independent enough rows.
+  const uint64_t step = (hash >> 32) | 1;
+  return row * (rowMask_ + 1) + ((hash + row * step) & rowMask_);
+}
+
+void TinyLfuSsdAdmissionPolicy::recordAccess(
+    uint64_t fileNum,
+    uint64_t offset) {
+  const auto hash = bits::hashMix(fileNum, offset);
+  // Conservative update: only the smallest counters are incremented, which
+  // reduces the overestimate from collisions.
+  const auto current = frequency(fileNum, offset);
+  if (current < kMaxCount) {
+    for (auto row = 0; row < kNumRows; ++row) {
+      auto& counter = counters_[index(hash, row)];
+      uint8_t expected = current;
+      counter.compare_exchange_strong(
+          expected,
+          static_cast<uint8_t>(current + 1),
+          std::memory_order_relaxed);
+    }
+  }
+  if (numAccesses_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+      sampleSize_) {
+    age();
+  }
+}
+
+uint8_t TinyLfuSsdAdmissionPolicy::frequency(uint64_t fileNum, uint64_t offset)
+    const {
+  const auto hash = bits::hashMix(fileNum, offset);
+  uint8_t result = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    result = std::min(
+        result, counters_[index(hash, row)].load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+void TinyLfuSsdAdmissionPolicy::age() {
+  for (uint64_t i = 0; i < kNumRows * (rowMask_ + 1); ++i) {
+    counters_[i].store(
+        counters_[i].load(std::memory_order_relaxed) >> 1,
+        std::memory_order_relaxed);
+  }
+  numAccesses_.fetch_sub(sampleSize_ / 2, std::memory_order_relaxed);
+  ++numAgings_;
+}
+
+std::string TinyLfuSsdAdmissionPolicy::toString() const {
+  return fmt::format(
+      "TinyLFU admission: {} counters, min frequency {}, {} agings",
+      kNumRows * (rowMask_ + 1),
+      static_cast<int32_t>(minFrequency_),
+      numAgings_.load());
+}
+
+} // namespace facebook::velox::cache
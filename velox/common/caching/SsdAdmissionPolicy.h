@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Decides which entries of AsyncDataCache are written to SsdCache. Entries
+/// are identified by the file number and offset of their FileCacheKey. Must
+/// be thread safe.
+class SsdAdmissionPolicy {
+ public:
+  virtual ~SsdAdmissionPolicy() = default;
+
+  /// Records a lookup of the entry at 'offset' of 'fileNum' in
+  /// AsyncDataCache, whether it is a hit or a miss.
+  virtual void recordAccess(uint64_t fileNum, uint64_t offset) = 0;
+
+  /// Returns true if the entry at 'offset' of 'fileNum' may be written to SSD.
+  virtual bool admit(uint64_t fileNum, uint64_t offset) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// TinyLFU admission. The access frequency of entries is estimated by a
+/// count-min sketch of 4 rows of counters that saturate at 15. An entry is
+/// admitted once it has been accessed at least 'minFrequency' times, so that
+/// the entries of one-off scans do not push the working set of repeated
+/// queries out of SSD. The counters are halved after every
+/// 10 * 'numCounters' accesses, so that old accesses are discounted.
+class TinyLfuSsdAdmissionPolicy : public SsdAdmissionPolicy {
+ public:
+  /// 'numCounters' is rounded up to a power of 2. It should be a few times
+  /// the number of distinct entries accessed over the time the counters are
+  /// halved. Each counter takes 1 byte.
+  explicit TinyLfuSsdAdmissionPolicy(
+      uint64_t numCounters,
+      uint8_t minFrequency = 2);
+
+  void recordAccess(uint64_t fileNum, uint64_t offset) override;
+
+  bool admit(uint64_t fileNum, uint64_t offset) override {
+    return frequency(fileNum, offset) >= minFrequency_;
+  }
+
+  /// Returns the estimated number of accesses to the entry at 'offset' of
+  /// 'fileNum', at most 15.
+  uint8_t frequency(uint64_t fileNum, uint64_t offset) const;
+
+  std::string toString() const override;
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Returns the index of the counter of 'hash' in 'row'.
+  uint64_t index(uint64_t hash, int32_t row) const;
+
+  // Halves all counters.
+  void age();
+
+  const uint8_t minFrequency_;
+  // Number of counters in each row minus 1.
+  const uint64_t rowMask_;
+  // Accesses between halvings of the counters.
+  const uint64_t sampleSize_;
+  // 'kNumRows' rows of 'rowMask_' + 1 counters.
+  std::unique_ptr<std::atomic<uint8_t>[]> counters_;
+  // Accesses since the last halving, plus half of the accesses before it.
+  std::atomic<uint64_t> numAccesses_{0};
+  std::atomic<uint64_t> numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -33,6 +33,7 @@ SsdCache::SsdCache(const Config& config)
     : filePrefix_(config.filePrefix),
       numShards_(config.numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
+      admissionPolicy_(config.admissionPolicy),
       executor_(config.executor) {
   // Make sure the given path of Ssd files has the prefix for local file system.
   // Local file system would be derived based on the prefix.
@@ -68,7 +69,8 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        config.compressionKind);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
@@ -78,6 +80,21 @@ SsdFile& SsdCache::file(uint64_t fileId) {
   return *files_[index];
 }
 
+bool SsdCache::admit(const RawFileCacheKey& key, bool rejectedBefore) {
+  if (admissionPolicy_ == nullptr) {
+    ++numAdmitted_;
+    return true;
+  }
+  if (admissionPolicy_->admit(key.fileNum, key.offset)) {
+    ++numAdmitted_;
+    return true;
+  }
+  if (!rejectedBefore) {
+    ++numRejected_;
+  }
+  return false;
+}
+
 bool SsdCache::startWrite() {
   std::lock_guard<std::mutex> l(mutex_);
   checkNotShutdownLocked();
@@ -172,6 +189,8 @@ SsdCacheStats SsdCache::stats() const {
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.entriesAdmitted = numAdmitted_;
+  stats.entriesRejected = numRejected_;
   return stats;
 }
 
@@ -182,8 +201,17 @@ std::string SsdCache::toString() const {
   out << "Ssd cache IO: Write " << succinctBytes(data.bytesWritten) << " read "
       << succinctBytes(data.bytesRead) << " Size " << succinctBytes(capacity)
       << " Occupied " << succinctBytes(data.bytesCached);
+  if (data.entriesCompressed > 0) {
+    out << " holding " << succinctBytes(data.uncompressedBytesCached)
+        << " uncompressed";
+  }
   out << " " << (data.entriesCached >> 10) << "K entries.";
   out << "\nGroupStats: " << groupStats_->toString(capacity);
+  if (admissionPolicy_ != nullptr) {
+    out << "\n"
+        << admissionPolicy_->toString() << ", admitted "
+        << data.entriesAdmitted << " rejected " << data.entriesRejected;
+  }
   return out.str();
 }
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/SsdAdmissionPolicy.h"
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -37,7 +38,10 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        std::shared_ptr<SsdAdmissionPolicy> _admissionPolicy = nullptr,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -45,7 +49,9 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          admissionPolicy(std::move(_admissionPolicy)),
+          compressionKind(_compressionKind){};
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -64,18 +70,28 @@ class SsdCache {
     /// If true, checksum read verification from SSD is enabled.
     bool checksumReadVerificationEnabled;
 
-    /// Executor for async fsync in checkpoint.
+    /// Executor for async fsync in checkpoint and for making checkpoints and
+    /// delta logs in the background.
     folly::Executor* executor;
 
+    /// Selects the entries to write. If nullptr, all the entries that
+    /// AsyncDataCache offers are written.
+    std::shared_ptr<SsdAdmissionPolicy> admissionPolicy;
+
+    /// Codec for new entries. See SsdFile::Config::compressionKind.
+    common::CompressionKind compressionKind;
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, admission {}, compression {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          (admissionPolicy ? admissionPolicy->toString() : "ALL"),
+          common::compressionKindToString(compressionKind));
     }
   };
 
@@ -134,6 +150,19 @@ class SsdCache {
     return *groupStats_;
   }
 
+  /// Records a lookup of 'key' in AsyncDataCache for the admission policy.
+  void recordAccess(const RawFileCacheKey& key) {
+    if (admissionPolicy_ != nullptr) {
+      admissionPolicy_->recordAccess(key.fileNum, key.offset);
+    }
+  }
+
+  /// Returns true if the entry for 'key' may be written. Counts the admitted
+  /// and rejected entries in stats(). 'rejectedBefore' is true if the entry
+  /// was rejected by an earlier write, in which case it is not counted as
+  /// rejected again.
+  bool admit(const RawFileCacheKey& key, bool rejectedBefore = false);
+
   /// Stops writing to the cache files and waits for pending writes to finish.
   /// If checkpointing is on, makes a checkpoint.
   void shutdown();
@@ -171,6 +200,9 @@ class SsdCache {
   const int32_t numShards_;
   // Stats for selecting entries to save from AsyncDataCache.
   const std::unique_ptr<FileGroupStats> groupStats_;
+  const std::shared_ptr<SsdAdmissionPolicy> admissionPolicy_;
+  std::atomic_uint64_t numAdmitted_{0};
+  std::atomic_uint64_t numRejected_{0};
   folly::Executor* const executor_;
   mutable std::mutex mutex_;
 
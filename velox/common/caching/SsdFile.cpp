@@ -137,6 +137,7 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      compressionKind_(config.compressionKind),
       shardId_(config.shardId),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
@@ -174,12 +175,21 @@ SsdFile::SsdFile(const Config& config)
   tracker_.resize(maxRegions_);
   regionSizes_.resize(maxRegions_, 0);
   erasedRegionSizes_.resize(maxRegions_, 0);
+  regionUncompressedSizes_.resize(maxRegions_, 0);
   regionPins_.resize(maxRegions_, 0);
   if (checkpointEnabled()) {
     initializeCheckpoint();
   }
 }
 
+SsdFile::~SsdFile() {
+  // A queued checkpoint or delta log write references 'this'.
+  std::lock_guard<std::mutex> l(checkpointFutureMutex_);
+  if (checkpointFuture_.valid()) {
+    checkpointFuture_.wait();
+  }
+}
+
 void SsdFile::pinRegion(uint64_t offset) {
   std::lock_guard<std::shared_mutex> l(mutex_);
   pinRegionLocked(offset);
@@ -232,8 +242,11 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  // Indices of the entries stored as is. The others are compressed.
+  std::vector<int32_t> uncompressedIndices;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto& run = ssdPins[i].run();
+    const auto runSize = run.uncompressedSize();
     auto* entry = pins[i].checkedEntry();
     if (FOLLY_UNLIKELY(runSize < entry->size())) {
       ++stats_.readSsdErrors;
@@ -242,30 +255,75 @@ CoalesceIoStats SsdFile::load(
           succinctBytes(runSize),
           succinctBytes(entry->size()));
     }
+    if (run.compressionKind() == common::CompressionKind_NONE) {
+      uncompressedIndices.push_back(i);
+    }
     totalPayloadBytes += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    regionRead(regionIndex(run.offset()), run.size());
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
   }
 
+  // The uncompressed entries are read directly into their cache entries with
+  // coalesced IO.
+  const bool allUncompressed = uncompressedIndices.size() == pins.size();
+  std::vector<CachePin> uncompressedPins;
+  if (!allUncompressed) {
+    for (auto index : uncompressedIndices) {
+      uncompressedPins.push_back(pins[index]);
+    }
+  }
+  const auto& pinsToRead = allUncompressed ? pins : uncompressedPins;
+
+  // With asynchronous reads, e.g. io_uring, all the coalesced reads are
+  // submitted before waiting for any of them.
+  const bool asyncRead = readFile_->hasPreadvAsync();
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
-      pins,
-      totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  if (!pinsToRead.empty()) {
+    stats = readPins(
+        pinsToRead,
+        totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry are
+        // under 12 ranges. If a system has a limit of 1K ranges, coalesce
+        // limit of 1000 is safe.
+        900,
+        [&](int32_t index) {
+          return ssdPins[uncompressedIndices[index]].run().offset();
+        },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          if (asyncRead) {
+            process::TraceContext trace("SsdFile::read");
+            reads.push_back(readFile_->preadvAsync(offset, buffers));
+          } else {
+            read(offset, buffers);
+          }
+        });
+  }
+
+  // The compressed entries are read one by one and decompressed.
+  if (!allUncompressed) {
+    for (auto i = 0; i < pins.size(); ++i) {
+      const auto& run = ssdPins[i].run();
+      if (run.compressionKind() == common::CompressionKind_NONE) {
+        continue;
+      }
+      loadCompressed(run, *pins[i].checkedEntry());
+      ++stats.numIos;
+      stats.payloadBytes += run.size();
+    }
+  }
+  for (auto& read : reads) {
+    std::move(read).get();
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -283,8 +341,65 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+// static
+std::unique_ptr<folly::IOBuf> SsdFile::compressEntry(
+    folly::io::Codec& codec,
+    const AsyncDataCacheEntry& entry) {
+  std::unique_ptr<folly::IOBuf> input;
+  if (entry.tinyData() != nullptr) {
+    input = folly::IOBuf::wrapBuffer(entry.tinyData(), entry.size());
+  } else {
+    const auto& data = entry.data();
+    int64_t bytesLeft = entry.size();
+    for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+      const auto run = data.runAt(i);
+      const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+      auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), bytes);
+      if (input == nullptr) {
+        input = std::move(buffer);
+      } else {
+        input->prependChain(std::move(buffer));
+      }
+      bytesLeft -= bytes;
+    }
+  }
+  auto result = codec.compress(input.get());
+  if (result->computeChainDataLength() * 100 >=
+      static_cast<uint64_t>(entry.size()) * kMaxCompressedPct) {
+    return nullptr;
+  }
+  result->coalesce();
+  return result;
+}
+
+std::string SsdFile::readUncompressed(const SsdRun& run) {
+  std::string compressed(run.size(), '\0');
+  read(run.offset(), {folly::Range<char*>(compressed.data(), run.size())});
+  auto codec = common::compressionKindToCodec(run.compressionKind());
+  return codec->uncompress(
+      folly::StringPiece(compressed), run.uncompressedSize());
+}
+
+void SsdFile::loadCompressed(const SsdRun& run, AsyncDataCacheEntry& entry) {
+  const auto data = readUncompressed(run);
+  VELOX_CHECK_GE(data.size(), entry.size());
+  if (entry.tinyData() != nullptr) {
+    ::memcpy(entry.tinyData(), data.data(), entry.size());
+    return;
+  }
+  const auto& allocation = entry.data();
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < entry.size(); ++i) {
+    const auto pageRun = allocation.runAt(i);
+    const auto bytes =
+        std::min<uint64_t>(entry.size() - offset, pageRun.numBytes());
+    ::memcpy(pageRun.data<char>(), data.data() + offset, bytes);
+    offset += bytes;
+  }
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -299,13 +414,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -330,6 +444,7 @@ bool SsdFile::growOrEvictLocked() {
       writableRegions_.push_back(numRegions_);
       regionSizes_[numRegions_] = 0;
       erasedRegionSizes_[numRegions_] = 0;
+      regionUncompressedSizes_[numRegions_] = 0;
       ++numRegions_;
       return true;
     }
@@ -372,6 +487,7 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
     tracker_.regionCleared(region);
     regionSizes_[region] = 0;
     erasedRegionSizes_[region] = 0;
+    regionUncompressedSizes_[region] = 0;
   }
 }
 
@@ -385,9 +501,26 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The compressed bytes of each entry, nullptr for the entries stored as
+  // is, and the sizes on SSD.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  std::vector<uint32_t> sizes(pins.size());
+  std::unique_ptr<folly::io::Codec> codec;
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    codec = common::compressionKindToCodec(compressionKind_);
+  }
+  for (auto i = 0; i < pins.size(); ++i) {
+    const auto* entry = pins[i].checkedEntry();
+    if (codec != nullptr) {
+      compressed[i] = compressEntry(*codec, *entry);
+    }
+    sizes[i] = compressed[i] != nullptr ? compressed[i]->length()
+                                        : entry->size();
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(sizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -401,8 +534,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = sizes[i];
+      const auto numIovecs =
+          compressed[i] != nullptr ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -419,7 +553,12 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        writeIovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -441,29 +580,70 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = sizes[i];
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        const SsdRun run = compressed[i] != nullptr
+            ? SsdRun(offset, size, checksum, compressionKind_, entry->size())
+            : SsdRun(offset, size, checksum);
+        if (checkpointEnabled()) {
+          addDeltaLocked(key, run);
+        }
+        entries_[std::move(key)] = run;
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
         }
+        regionUncompressedSizes_[regionIndex(offset)] += entry->size();
         offset += size;
         ++stats_.entriesWritten;
         stats_.bytesWritten += size;
+        stats_.uncompressedBytesWritten += entry->size();
+        if (compressed[i] != nullptr) {
+          ++stats_.entriesCompressed;
+        }
         bytesAfterCheckpoint_ += size;
+        bytesAfterDeltaLog_ += size;
       }
     }
     writeIndex += numWrittenEntries;
   }
 
   if (checkpointEnabled()) {
-    checkpoint();
+    maybeCheckpoint();
+  }
+}
+
+void SsdFile::maybeCheckpoint() {
+  if (!needCheckpoint(false) && !needDeltaLog()) {
+    return;
+  }
+  const auto run = [this]() {
+    if (needCheckpoint(false)) {
+      checkpoint();
+    } else {
+      writeDeltaLog();
+    }
+  };
+  if (executor_ == nullptr) {
+    run();
+    return;
   }
+  std::lock_guard<std::mutex> l(checkpointFutureMutex_);
+  if (checkpointFuture_.valid() && !checkpointFuture_.isReady()) {
+    return;
+  }
+  auto [promise, future] =
+      makeVeloxContinuePromiseContract("SsdFile::maybeCheckpoint");
+  checkpointFuture_ = std::move(future);
+  // If 'run' throws, the destroyed promise completes the future with an error.
+  executor_->add([run, promise = std::move(promise)]() mutable {
+    run();
+    promise.setValue();
+  });
 }
 
 bool SsdFile::write(
@@ -496,11 +676,18 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
-  auto testData = std::make_unique<char[]>(entry.size());
-  const auto rc = ::pread(fd_, testData.get(), entry.size(), ssdRun.offset());
-  VELOX_CHECK_EQ(rc, entry.size());
+  std::string testData;
+  if (ssdRun.compressionKind() == common::CompressionKind_NONE) {
+    testData.resize(entry.size());
+    const auto rc =
+        ::pread(fd_, testData.data(), entry.size(), ssdRun.offset());
+    VELOX_CHECK_EQ(rc, entry.size());
+  } else {
+    testData = readUncompressed(ssdRun);
+    VELOX_CHECK_EQ(testData.size(), entry.size());
+  }
   if (entry.tinyData() != nullptr) {
-    if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
+    if (::memcmp(testData.data(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
     }
   } else {
@@ -511,7 +698,7 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
       const auto run = data.runAt(i);
       const auto compareSize = std::min<int64_t>(bytesLeft, run.numBytes());
       const auto badIndex = indexOfFirstMismatch(
-          run.data<char>(), testData.get() + offset, compareSize);
+          run.data<char>(), testData.data() + offset, compareSize);
       VELOX_CHECK_EQ(badIndex, -1, "Bad read back");
       bytesLeft -= run.numBytes();
       offset += run.numBytes();
@@ -528,14 +715,19 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   std::shared_lock<std::shared_mutex> l(mutex_);
   stats.entriesWritten += stats_.entriesWritten;
   stats.bytesWritten += stats_.bytesWritten;
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.uncompressedBytesWritten += stats_.uncompressedBytesWritten;
   stats.checkpointsWritten += stats_.checkpointsWritten;
+  stats.deltaLogsWritten += stats_.deltaLogsWritten;
   stats.entriesRead += stats_.entriesRead;
   stats.bytesRead += stats_.bytesRead;
   stats.checkpointsRead += stats_.checkpointsRead;
+  stats.deltaEntriesRecovered += stats_.deltaEntriesRecovered;
   stats.entriesCached += entries_.size();
   stats.regionsCached += numRegions_;
   for (auto i = 0; i < numRegions_; i++) {
     stats.bytesCached += (regionSizes_[i] - erasedRegionSizes_[i]);
+    stats.uncompressedBytesCached += regionUncompressedSizes_[i];
   }
   stats.entriesAgedOut += stats_.entriesAgedOut;
   stats.regionsAgedOut += stats_.regionsAgedOut;
@@ -561,6 +753,9 @@ void SsdFile::testingClear() {
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
+  std::fill(
+      regionUncompressedSizes_.begin(), regionUncompressedSizes_.end(), 0);
+  pendingDeltas_.clear();
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
   tracker_.testingClear();
@@ -615,6 +810,8 @@ bool SsdFile::removeFileEntries(
 
     ++entriesAgedOut;
     erasedRegionSizes_[region] += ssdRun.size();
+    regionUncompressedSizes_[region] -= std::min<uint64_t>(
+        regionUncompressedSizes_[region], ssdRun.uncompressedSize());
 
     it = entries_.erase(it);
   }
@@ -656,16 +853,64 @@ bool SsdFile::removeFileEntries(
   return true;
 }
 
+namespace {
+template <typename T>
+inline char* asChar(T ptr) {
+  return reinterpret_cast<char*>(ptr);
+}
+
+template <typename T>
+inline const char* asChar(const T* ptr) {
+  return reinterpret_cast<const char*>(ptr);
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+  out.append(asChar(&value), sizeof(T));
+}
+
+int32_t checkRc(int32_t rc, const std::string& errMsg) {
+  if (rc < 0) {
+    VELOX_FAIL("{} with rc {} :{}", errMsg, rc, folly::errnoStr(errno));
+  }
+  return rc;
+}
+
+// An entry of a checkpoint, copied out of 'entries_' to be written without
+// holding the mutex.
+struct CheckpointEntry {
+  uint64_t fileNum;
+  uint64_t offset;
+  SsdRun run;
+};
+} // namespace
+
 void SsdFile::logEviction(const std::vector<int32_t>& regions) {
   if (checkpointEnabled()) {
     const int32_t rc = ::write(
         evictLogFd_, regions.data(), regions.size() * sizeof(regions[0]));
     if (rc != regions.size() * sizeof(regions[0])) {
       checkpointError(rc, "Failed to log eviction");
+      return;
+    }
+    for (const auto region : regions) {
+      appendNumber(pendingDeltas_, kDeltaEvict);
+      appendNumber(pendingDeltas_, region);
     }
   }
 }
 
+void SsdFile::addDeltaLocked(const FileCacheKey& key, const SsdRun& run) {
+  const auto name = fileIds().string(key.fileNum.id());
+  appendNumber(pendingDeltas_, kDeltaAdd);
+  appendNumber<int32_t>(pendingDeltas_, name.size());
+  pendingDeltas_.append(name);
+  appendNumber(pendingDeltas_, key.offset);
+  appendNumber(pendingDeltas_, run.fileBits());
+  appendNumber(pendingDeltas_, run.checksum());
+  appendNumber(pendingDeltas_, run.compressionBits());
+}
+
 void SsdFile::deleteCheckpoint(bool keepLog) {
   if (checkpointDeleted_) {
     return;
@@ -680,12 +925,25 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
       evictLogFd_ = -1;
     }
   }
+  if (deltaLogFd_ >= 0) {
+    if (keepLog) {
+      ::ftruncate(deltaLogFd_, 0);
+      ::fsync(deltaLogFd_);
+    } else {
+      ::close(deltaLogFd_);
+      deltaLogFd_ = -1;
+    }
+  }
+  pendingDeltas_.clear();
 
   checkpointDeleted_ = true;
   const auto logPath = getEvictLogFilePath();
   int32_t logRc = 0;
   if (!keepLog) {
     logRc = ::unlink(logPath.c_str());
+    // The delta log is not there if the checkpoint was made by a version
+    // without delta logs.
+    ::unlink(getDeltaLogFilePath().c_str());
   }
   const auto checkpointPath = getCheckpointFilePath();
   const auto checkpointRc = ::unlink(checkpointPath.c_str());
@@ -705,41 +963,59 @@ void SsdFile::checkpointError(int32_t rc, const std::string& error) {
   checkpointIntervalBytes_ = 0;
 }
 
-namespace {
-template <typename T>
-inline char* asChar(T ptr) {
-  return reinterpret_cast<char*>(ptr);
-}
-
-template <typename T>
-inline const char* asChar(const T* ptr) {
-  return reinterpret_cast<const char*>(ptr);
-}
-} // namespace
-
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
-  std::lock_guard<std::shared_mutex> l(mutex_);
-  if (!needCheckpoint(force)) {
-    return;
-  }
-
-  VELOX_SSD_CACHE_LOG(INFO)
-      << "Checkpointing shard " << shardId_ << ", force: " << force
-      << " bytesAfterCheckpoint: " << succinctBytes(bytesAfterCheckpoint_)
-      << " checkpointIntervalBytes: "
-      << succinctBytes(checkpointIntervalBytes_);
+  std::lock_guard<std::mutex> checkpointLock(checkpointMutex_);
+
+  // The state is copied under 'mutex_' and written out after releasing it so
+  // that writes and reads of this file are not held up by the checkpoint IO.
+  int32_t numRegions{0};
+  std::vector<double> scores;
+  std::vector<std::pair<uint64_t, std::string>> files;
+  std::vector<CheckpointEntry> entries;
+  bool withCompression{false};
+  off_t evictLogSize{0};
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    if (!needCheckpoint(force)) {
+      return;
+    }
 
-  checkpointDeleted_ = false;
-  bytesAfterCheckpoint_ = 0;
-  try {
-    const auto checkRc = [&](int32_t rc, const std::string& errMsg) {
-      if (rc < 0) {
-        VELOX_FAIL("{} with rc {} :{}", errMsg, rc, folly::errnoStr(errno));
+    VELOX_SSD_CACHE_LOG(INFO)
+        << "Checkpointing shard " << shardId_ << ", force: " << force
+        << " bytesAfterCheckpoint: " << succinctBytes(bytesAfterCheckpoint_)
+        << " checkpointIntervalBytes: "
+        << succinctBytes(checkpointIntervalBytes_);
+
+    checkpointDeleted_ = false;
+    bytesAfterCheckpoint_ = 0;
+    bytesAfterDeltaLog_ = 0;
+    // The pending deltas are included in the copied state.
+    pendingDeltas_.clear();
+    numRegions = numRegions_;
+    // Copy the region scores before writing out for tsan.
+    scores = tracker_.copyScores();
+    // Entries read from a checkpoint keep their codec if compression has
+    // since been turned off.
+    withCompression = compressionKind_ != common::CompressionKind_NONE ||
+        std::any_of(entries_.begin(), entries_.end(), [](const auto& pair) {
+          return pair.second.compressionBits() != 0;
+        });
+    std::unordered_set<uint64_t> fileNums;
+    entries.reserve(entries_.size());
+    for (const auto& [key, run] : entries_) {
+      const auto fileNum = key.fileNum.id();
+      if (fileNums.insert(fileNum).second) {
+        files.emplace_back(fileNum, fileIds().string(fileNum));
       }
-      return rc;
-    };
+      entries.push_back({fileNum, key.offset, run});
+    }
+    // Evictions logged after this are not reflected in the copied state and
+    // are kept in the eviction log after the checkpoint.
+    evictLogSize = ::lseek(evictLogFd_, 0, SEEK_CUR);
+  }
 
+  try {
     // We schedule the potentially long fsync of the cache file on another
     // thread of the cache write executor, if available. If there is none, we do
     // the sync on this thread at the end.
@@ -749,11 +1025,15 @@ void SsdFile::checkpoint(bool force) {
       executor_->add([fileSync]() { fileSync->prepare(); });
     }
 
+    // The checkpoint is written to a temporary file and renamed over the
+    // previous one when complete, so that a crash while writing leaves the
+    // previous checkpoint usable.
     std::ofstream state;
     const auto checkpointPath = getCheckpointFilePath();
+    const auto tempPath = checkpointPath + ".tmp";
     try {
       state.exceptions(std::ofstream::failbit);
-      state.open(checkpointPath, std::ios_base::out | std::ios_base::trunc);
+      state.open(tempPath, std::ios_base::out | std::ios_base::trunc);
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
       // int32_t maxRegions,
@@ -761,39 +1041,35 @@ void SsdFile::checkpoint(bool force) {
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {fileId, offset, SSdRun} triples. SsdRun has the checksum and then
+      // the compression bits if present in the version,
       // kEndMarker.
-      state.write(checkpointVersion().data(), sizeof(int32_t));
+      state.write(checkpointVersion(withCompression).data(), sizeof(int32_t));
       state.write(asChar(&maxRegions_), sizeof(maxRegions_));
-      state.write(asChar(&numRegions_), sizeof(numRegions_));
-
-      // Copy the region scores before writing out for tsan.
-      const auto scoresCopy = tracker_.copyScores();
-      state.write(asChar(scoresCopy.data()), maxRegions_ * sizeof(uint64_t));
-      std::unordered_set<uint64_t> fileNums;
-      for (const auto& entry : entries_) {
-        const auto fileNum = entry.first.fileNum.id();
-        if (fileNums.insert(fileNum).second) {
-          state.write(asChar(&fileNum), sizeof(fileNum));
-          const auto name = fileIds().string(fileNum);
-          const int32_t length = name.size();
-          state.write(asChar(&length), sizeof(length));
-          state.write(name.data(), length);
-        }
+      state.write(asChar(&numRegions), sizeof(numRegions));
+      state.write(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
+      for (const auto& [fileNum, name] : files) {
+        state.write(asChar(&fileNum), sizeof(fileNum));
+        const int32_t length = name.size();
+        state.write(asChar(&length), sizeof(length));
+        state.write(name.data(), length);
       }
 
       const auto mapMarker = kCheckpointMapMarker;
       state.write(asChar(&mapMarker), sizeof(mapMarker));
-      for (auto& pair : entries_) {
-        const auto id = pair.first.fileNum.id();
-        state.write(asChar(&id), sizeof(id));
-        state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
-        const auto offsetAndSize = pair.second.fileBits();
+      for (const auto& entry : entries) {
+        state.write(asChar(&entry.fileNum), sizeof(entry.fileNum));
+        state.write(asChar(&entry.offset), sizeof(entry.offset));
+        const auto offsetAndSize = entry.run.fileBits();
         state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
         if (checksumEnabled_) {
-          const auto checksum = pair.second.checksum();
+          const auto checksum = entry.run.checksum();
           state.write(asChar(&checksum), sizeof(checksum));
         }
+        if (withCompression) {
+          const auto compressionBits = entry.run.compressionBits();
+          state.write(asChar(&compressionBits), sizeof(compressionBits));
+        }
       }
     } catch (const std::exception& e) {
       fileSync->close();
@@ -819,8 +1095,7 @@ void SsdFile::checkpoint(bool force) {
     // Sync checkpoint data file. ofstream does not have a sync method, so open
     // as fd and sync that.
     const auto checkpointFd = checkRc(
-        ::open(checkpointPath.c_str(), O_WRONLY),
-        "Open of checkpoint file for sync");
+        ::open(tempPath.c_str(), O_WRONLY), "Open of checkpoint file for sync");
     // TODO: add this as file open option after we migrate to use velox
     // filesystem for ssd file access.
     if (disableFileCow_) {
@@ -830,12 +1105,111 @@ void SsdFile::checkpoint(bool force) {
     checkRc(::fsync(checkpointFd), "Sync of checkpoint file");
     ::close(checkpointFd);
 
-    // NOTE: we shall truncate eviction log after checkpoint file sync
-    // completes so that we never recover from an old checkpoint file without
-    // log evictions. The latter might lead to data consistent issue.
-    checkRc(::ftruncate(evictLogFd_, 0), "Truncate of event log");
-    checkRc(::fsync(evictLogFd_), "Sync of evict log");
+    // The checkpoint is installed and the logs are truncated under 'mutex_'
+    // so that these do not race with logging evictions or with deleting the
+    // checkpoint after an error.
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    if (!checkpointEnabled()) {
+      ::unlink(tempPath.c_str());
+      return;
+    }
+    checkRc(
+        ::rename(tempPath.c_str(), checkpointPath.c_str()),
+        "Rename of checkpoint file");
+
+    // NOTE: we shall truncate the logs after checkpoint file sync completes so
+    // that we never recover from an old checkpoint file without log
+    // evictions. The latter might lead to data consistent issue. The delta log
+    // goes first: its entries are only recovered if the eviction log has no
+    // later eviction of their region, which holds while the eviction log is
+    // complete.
+    checkRc(::ftruncate(deltaLogFd_, 0), "Truncate of delta log");
+    checkRc(::fsync(deltaLogFd_), "Sync of delta log");
+
+    // Keep the evictions logged while the checkpoint was written. The
+    // eviction log is replaced by a file with only these.
+    const auto logSize = ::lseek(evictLogFd_, 0, SEEK_CUR);
+    VELOX_CHECK_GE(logSize, evictLogSize);
+    std::string tail(logSize - evictLogSize, '\0');
+    if (::pread(evictLogFd_, tail.data(), tail.size(), evictLogSize) !=
+        tail.size()) {
+      checkRc(-1, "Read of evict log");
+    }
+    const auto logPath = getEvictLogFilePath();
+    const auto tempLogPath = logPath + ".tmp";
+    const auto logFd = checkRc(
+        ::open(
+            tempLogPath.c_str(),
+            O_CREAT | O_TRUNC | O_RDWR,
+            S_IRUSR | S_IWUSR),
+        "Open of evict log");
+    if (disableFileCow_) {
+      disableCow(logFd);
+    }
+    if (::write(logFd, tail.data(), tail.size()) != tail.size()) {
+      ::close(logFd);
+      checkRc(-1, "Write of evict log");
+    }
+    checkRc(::fsync(logFd), "Sync of evict log");
+    checkRc(
+        ::rename(tempLogPath.c_str(), logPath.c_str()), "Rename of evict log");
+    ::close(evictLogFd_);
+    evictLogFd_ = logFd;
+  } catch (const std::exception& e) {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    try {
+      checkpointError(-1, e.what());
+    } catch (const std::exception&) {
+    }
+    // Ignore nested exception.
+  }
+}
+
+void SsdFile::writeDeltaLog() {
+  process::TraceContext trace("SsdFile::writeDeltaLog");
+  std::lock_guard<std::mutex> checkpointLock(checkpointMutex_);
+  std::string deltas;
+  {
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    if (!checkpointEnabled()) {
+      return;
+    }
+    bytesAfterDeltaLog_ = 0;
+    deltas.swap(pendingDeltas_);
+  }
+  if (deltas.empty()) {
+    return;
+  }
+
+  try {
+    // The logged entries must not be recovered before their data is durable.
+    checkRc(::fsync(fd_), "Sync of cache data file");
+
+    // The records are preceded by their size and checksum so that recovery
+    // can tell an incompletely written batch.
+    bits::Crc32 crc;
+    crc.process_bytes(deltas.data(), deltas.size());
+    std::string batch;
+    batch.reserve(2 * sizeof(uint32_t) + deltas.size());
+    appendNumber<uint32_t>(batch, deltas.size());
+    appendNumber(batch, crc.checksum());
+    batch.append(deltas);
+    int32_t logFd;
+    {
+      // The delta log is closed when the checkpoint is deleted after an error.
+      std::lock_guard<std::shared_mutex> l(mutex_);
+      if (!checkpointEnabled()) {
+        return;
+      }
+      logFd = deltaLogFd_;
+      if (::write(logFd, batch.data(), batch.size()) != batch.size()) {
+        checkRc(-1, "Write of delta log");
+      }
+    }
+    checkRc(::fsync(logFd), "Sync of delta log");
+    ++stats_.deltaLogsWritten;
   } catch (const std::exception& e) {
+    std::lock_guard<std::shared_mutex> l(mutex_);
     try {
       checkpointError(-1, e.what());
     } catch (const std::exception&) {
@@ -874,6 +1248,24 @@ void SsdFile::initializeCheckpoint() {
         evictLogFd_,
         folly::errnoStr(errno));
   }
+  const auto deltaLogPath = getDeltaLogFilePath();
+  deltaLogFd_ = ::open(
+      deltaLogPath.c_str(), O_CREAT | O_RDWR | O_APPEND, S_IRUSR | S_IWUSR);
+  if (deltaLogFd_ < 0) {
+    ++stats_.openLogErrors;
+    VELOX_FAIL(
+        "Could not open delta log {}, rc {}: {}",
+        deltaLogPath,
+        deltaLogFd_,
+        folly::errnoStr(errno));
+  }
+  if (disableFileCow_) {
+    disableCow(deltaLogFd_);
+  }
+  if (!hasCheckpoint) {
+    // Deltas apply only on top of the checkpoint they follow.
+    ::ftruncate(deltaLogFd_, 0);
+  }
 
   try {
     if (hasCheckpoint) {
@@ -886,6 +1278,7 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
       deleteCheckpoint(true);
     } catch (const std::exception&) {
     }
@@ -916,13 +1309,13 @@ void SsdFile::maybeVerifyChecksum(
   if (!checksumReadVerificationEnabled_) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
-  if (ssdRun.size() != entry.size()) {
+  VELOX_DCHECK_EQ(ssdRun.uncompressedSize(), entry.size());
+  if (ssdRun.uncompressedSize() != entry.size()) {
     RECORD_METRIC_VALUE(kMetricSsdCacheReadWithoutChecksum);
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
         << "SSD read without checksum due to cache request size mismatch, SSD cache size "
-        << ssdRun.size() << " request size " << entry.size()
+        << ssdRun.uncompressedSize() << " request size " << entry.size()
         << ", cache request: " << entry.toString();
     return;
   }
@@ -963,6 +1356,14 @@ T readNumber(std::ifstream& stream) {
   stream.read(asChar(&data), sizeof(T));
   return data;
 }
+
+template <typename T>
+T readNumber(const char*& ptr) {
+  T data;
+  ::memcpy(&data, ptr, sizeof(T));
+  ptr += sizeof(T);
+  return data;
+}
 } // namespace
 
 void SsdFile::readCheckpoint(std::ifstream& state) {
@@ -970,6 +1371,8 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
   state.read(versionMagic, sizeof(versionMagic));
   const auto checkpoinHasChecksum =
       isChecksumEnabledOnCheckpointVersion(std::string(versionMagic, 4));
+  const auto checkpointHasCompression =
+      isCompressionOnCheckpointVersion(std::string(versionMagic, 4));
   if (checksumEnabled_ && !checkpoinHasChecksum) {
     VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
         "Starting shard {} without checkpoint: checksum is enabled but the checkpoint was made without checksum, so skip the checkpoint recovery.",
@@ -1002,9 +1405,9 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
   std::vector<uint32_t> evicted(logSize / sizeof(uint32_t));
   const auto rc = ::pread(evictLogFd_, evicted.data(), logSize, 0);
   VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
-  std::unordered_set<uint32_t> evictedMap;
+  std::unordered_map<int32_t, int32_t> evictCounts;
   for (auto region : evicted) {
-    evictedMap.insert(region);
+    ++evictCounts[region];
   }
   for (;;) {
     const auto fileNum = readNumber<uint64_t>(state);
@@ -1017,9 +1420,13 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(state);
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t compressionBits = 0;
+    if (checkpointHasCompression) {
+      compressionBits = readNumber<uint32_t>(state);
+    }
+    const auto run = SsdRun(fileBits, checksum, compressionBits);
     // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
+    if (evictCounts.count(regionIndex(run.offset())) == 0) {
       // The file may have a different id on restore.
       auto it = idMap.find(fileNum);
       VELOX_CHECK(it != idMap.end());
@@ -1027,24 +1434,128 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       entries_[std::move(key)] = run;
     }
   }
+  std::unordered_set<int32_t> writable;
+  for (const auto& [region, count] : evictCounts) {
+    writable.insert(region);
+  }
+  const auto numCheckpointEntries = entries_.size();
+  replayDeltaLog(evictCounts, writable);
   ++stats_.checkpointsRead;
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
   // Set the writable regions by deduplicated evicted regions.
-  writableRegions_.clear();
-  for (auto region : evictedMap) {
-    writableRegions_.push_back(region);
-  }
+  writableRegions_.assign(writable.begin(), writable.end());
   tracker_.setRegionScores(scores);
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} regions with {} free, with checksum write {}, read verification {}.",
+      "Starting shard {} from checkpoint with {} entries and {} from delta log, {} regions with {} free, with checksum write {}, read verification {}.",
       shardId_,
-      entries_.size(),
+      numCheckpointEntries,
+      entries_.size() - numCheckpointEntries,
       numRegions_,
       writableRegions_.size(),
       checksumEnabled_ ? "enabled" : "disabled",
       checksumReadVerificationEnabled_ ? "enabled" : "disabled");
 }
 
+void SsdFile::replayDeltaLog(
+    const std::unordered_map<int32_t, int32_t>& evictCounts,
+    std::unordered_set<int32_t>& writable) {
+  const auto logSize = ::lseek(deltaLogFd_, 0, SEEK_END);
+  std::string log(logSize, '\0');
+  const auto rc = ::pread(deltaLogFd_, log.data(), logSize, 0);
+  VELOX_CHECK_EQ(logSize, rc, "Failed to read delta log");
+
+  const auto numEvictions = [&](int32_t region) {
+    const auto it = evictCounts.find(region);
+    return it == evictCounts.end() ? 0 : it->second;
+  };
+  const int32_t numFileRegions = fileSize_ / kRegionSize;
+  std::unordered_map<std::string, StringIdLease> leases;
+  std::unordered_map<int32_t, int32_t> evictionsSeen;
+  // The keys of the recovered entries of each region, to drop if the region
+  // is evicted later in the log.
+  std::unordered_map<int32_t, std::vector<FileCacheKey>> regionKeys;
+  constexpr int32_t kBatchHeaderSize = 2 * sizeof(uint32_t);
+  size_t batchOffset = 0;
+  while (batchOffset + kBatchHeaderSize <= log.size()) {
+    const char* ptr = log.data() + batchOffset;
+    const auto batchSize = readNumber<uint32_t>(ptr);
+    const auto checksum = readNumber<uint32_t>(ptr);
+    if (batchOffset + kBatchHeaderSize + batchSize > log.size()) {
+      break;
+    }
+    bits::Crc32 crc;
+    crc.process_bytes(ptr, batchSize);
+    if (crc.checksum() != checksum) {
+      break;
+    }
+    const char* end = ptr + batchSize;
+    while (ptr < end) {
+      const auto kind = readNumber<int32_t>(ptr);
+      if (kind == kDeltaEvict) {
+        const auto region = readNumber<int32_t>(ptr);
+        VELOX_CHECK_LT(region, maxRegions_);
+        ++evictionsSeen[region];
+        auto it = regionKeys.find(region);
+        if (it != regionKeys.end()) {
+          for (const auto& key : it->second) {
+            // The key may have been logged again in another region.
+            auto entryIt = entries_.find(key);
+            if (entryIt != entries_.end() &&
+                regionIndex(entryIt->second.offset()) == region) {
+              entries_.erase(entryIt);
+            }
+          }
+          regionKeys.erase(it);
+        }
+        regionSizes_[region] = 0;
+        continue;
+      }
+      VELOX_CHECK_EQ(kind, kDeltaAdd, "Bad delta log record");
+      const auto length = readNumber<int32_t>(ptr);
+      std::string name(ptr, length);
+      ptr += length;
+      const auto offset = readNumber<uint64_t>(ptr);
+      const auto fileBits = readNumber<uint64_t>(ptr);
+      const auto entryChecksum = readNumber<uint32_t>(ptr);
+      const auto compressionBits = readNumber<uint32_t>(ptr);
+      const SsdRun run(fileBits, entryChecksum, compressionBits);
+      const auto region = regionIndex(run.offset());
+      // Skips entries past the end of the file and entries whose region was
+      // evicted, and possibly overwritten, after they were logged.
+      if (region >= numFileRegions ||
+          evictionsSeen[region] != numEvictions(region)) {
+        continue;
+      }
+      auto leaseIt = leases.find(name);
+      if (leaseIt == leases.end()) {
+        leaseIt = leases.emplace(name, StringIdLease(fileIds(), name)).first;
+      }
+      FileCacheKey key{leaseIt->second, offset};
+      entries_[key] = run;
+      regionKeys[region].push_back(std::move(key));
+      regionSizes_[region] = std::max<uint32_t>(
+          regionSizes_[region],
+          run.offset() - region * kRegionSize + run.size());
+      // The file grew after the checkpoint. The new regions were writable.
+      for (; numRegions_ <= region; ++numRegions_) {
+        writable.insert(numRegions_);
+      }
+    }
+    VELOX_CHECK(ptr == end, "Bad delta log batch");
+    batchOffset = end - log.data();
+  }
+
+  if (batchOffset < log.size()) {
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Dropping incomplete delta log batch at " << batchOffset << " of "
+        << log.size() << " bytes in shard " << shardId_;
+    ::ftruncate(deltaLogFd_, batchOffset);
+  }
+  for (const auto& [region, keys] : regionKeys) {
+    stats_.deltaEntriesRecovered += keys.size();
+  }
+}
+
 } // namespace facebook::velox::cache
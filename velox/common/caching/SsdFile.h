@@ -18,7 +18,9 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
+#include "velox/common/future/VeloxPromise.h"
 
 #include <gflags/gflags.h>
 
@@ -35,15 +37,31 @@ class SsdRun {
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
+  /// 'size' is the number of bytes on SSD. If 'compressionKind' is not
+  /// CompressionKind_NONE, these are the compressed bytes of an entry of
+  /// 'uncompressedSize' bytes.
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      uint32_t uncompressedSize = 0)
       : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
+    if (compressionKind != common::CompressionKind_NONE) {
+      VELOX_CHECK_NE(uncompressedSize, 0);
+      VELOX_CHECK_LE(uncompressedSize, 1 << kSizeBits);
+      compressionBits_ = (static_cast<uint32_t>(compressionKind) << kSizeBits) |
+          (uncompressedSize - 1);
+    }
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t compressionBits = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        compressionBits_(compressionBits) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -51,10 +69,12 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    compressionBits_ = other.compressionBits_;
   }
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    compressionBits_ = other.compressionBits_;
   }
 
   uint64_t offset() const {
@@ -65,7 +85,21 @@ class SsdRun {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
-  /// Returns the checksum computed with crc32.
+  /// Returns the codec of the bytes on SSD.
+  common::CompressionKind compressionKind() const {
+    return static_cast<common::CompressionKind>(compressionBits_ >> kSizeBits);
+  }
+
+  /// Returns the size of the entry after decompression, i.e. size() if the
+  /// entry is not compressed.
+  uint32_t uncompressedSize() const {
+    if (compressionBits_ == 0) {
+      return size();
+    }
+    return (compressionBits_ & ((1 << kSizeBits) - 1)) + 1;
+  }
+
+  /// Returns the checksum computed with crc32 over the uncompressed bytes.
   uint32_t checksum() const {
     return checksum_;
   }
@@ -75,10 +109,17 @@ class SsdRun {
     return fileBits_;
   }
 
+  /// Returns raw bits for codec and uncompressed size for serialization.
+  uint32_t compressionBits() const {
+    return compressionBits_;
+  }
+
  private:
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  // Contains the codec and uncompressed size. 0 if not compressed.
+  uint32_t compressionBits_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -140,15 +181,22 @@ struct SsdCacheStats {
     entriesWritten = tsanAtomicValue(other.entriesWritten);
     bytesWritten = tsanAtomicValue(other.bytesWritten);
     checkpointsWritten = tsanAtomicValue(other.checkpointsWritten);
+    deltaLogsWritten = tsanAtomicValue(other.deltaLogsWritten);
     entriesRead = tsanAtomicValue(other.entriesRead);
     bytesRead = tsanAtomicValue(other.bytesRead);
     checkpointsRead = tsanAtomicValue(other.checkpointsRead);
+    deltaEntriesRecovered = tsanAtomicValue(other.deltaEntriesRecovered);
     entriesCached = tsanAtomicValue(other.entriesCached);
     regionsCached = tsanAtomicValue(other.regionsCached);
     bytesCached = tsanAtomicValue(other.bytesCached);
     entriesAgedOut = tsanAtomicValue(other.entriesAgedOut);
     regionsAgedOut = tsanAtomicValue(other.regionsAgedOut);
     regionsEvicted = tsanAtomicValue(other.regionsEvicted);
+    uncompressedBytesCached = tsanAtomicValue(other.uncompressedBytesCached);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    uncompressedBytesWritten = tsanAtomicValue(other.uncompressedBytesWritten);
+    entriesAdmitted = tsanAtomicValue(other.entriesAdmitted);
+    entriesRejected = tsanAtomicValue(other.entriesRejected);
     numPins = tsanAtomicValue(other.numPins);
 
     openFileErrors = tsanAtomicValue(other.openFileErrors);
@@ -171,12 +219,20 @@ struct SsdCacheStats {
     result.entriesWritten = entriesWritten - other.entriesWritten;
     result.bytesWritten = bytesWritten - other.bytesWritten;
     result.checkpointsWritten = checkpointsWritten - other.checkpointsWritten;
+    result.deltaLogsWritten = deltaLogsWritten - other.deltaLogsWritten;
     result.entriesRead = entriesRead - other.entriesRead;
     result.bytesRead = bytesRead - other.bytesRead;
     result.checkpointsRead = checkpointsRead - other.checkpointsRead;
+    result.deltaEntriesRecovered =
+        deltaEntriesRecovered - other.deltaEntriesRecovered;
     result.entriesAgedOut = entriesAgedOut - other.entriesAgedOut;
     result.regionsAgedOut = regionsAgedOut - other.regionsAgedOut;
     result.regionsEvicted = regionsEvicted - other.regionsEvicted;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.uncompressedBytesWritten =
+        uncompressedBytesWritten - other.uncompressedBytesWritten;
+    result.entriesAdmitted = entriesAdmitted - other.entriesAdmitted;
+    result.entriesRejected = entriesRejected - other.entriesRejected;
     result.openFileErrors = openFileErrors - other.openFileErrors;
     result.openCheckpointErrors =
         openCheckpointErrors - other.openCheckpointErrors;
@@ -201,18 +257,35 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> entriesCached{0};
   tsan_atomic<uint64_t> regionsCached{0};
   tsan_atomic<uint64_t> bytesCached{0};
+  /// Size of the cached entries after decompression. The ratio to
+  /// 'bytesCached' is the gain in capacity from compression.
+  tsan_atomic<uint64_t> uncompressedBytesCached{0};
   tsan_atomic<int32_t> numPins{0};
 
   /// Cumulative stats
   tsan_atomic<uint64_t> entriesWritten{0};
   tsan_atomic<uint64_t> bytesWritten{0};
+  /// Entries written compressed and the size before compression of all the
+  /// entries written. 'bytesWritten' is the size on SSD.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  tsan_atomic<uint64_t> uncompressedBytesWritten{0};
   tsan_atomic<uint64_t> checkpointsWritten{0};
+  /// Batches of entry additions and evictions appended to the delta log
+  /// between full checkpoints.
+  tsan_atomic<uint64_t> deltaLogsWritten{0};
   tsan_atomic<uint64_t> entriesRead{0};
   tsan_atomic<uint64_t> bytesRead{0};
   tsan_atomic<uint64_t> checkpointsRead{0};
+  /// Entries recovered from the delta log on top of the checkpoint.
+  tsan_atomic<uint64_t> deltaEntriesRecovered{0};
   tsan_atomic<uint64_t> entriesAgedOut{0};
   tsan_atomic<uint64_t> regionsAgedOut{0};
   tsan_atomic<uint64_t> regionsEvicted{0};
+  /// Entries offered for writing that the admission policy accepted or
+  /// rejected. A rejected entry may be offered again in a later write but is
+  /// counted as rejected once.
+  tsan_atomic<uint64_t> entriesAdmitted{0};
+  tsan_atomic<uint64_t> entriesRejected{0};
   tsan_atomic<uint32_t> openFileErrors{0};
   tsan_atomic<uint32_t> openCheckpointErrors{0};
   tsan_atomic<uint32_t> openLogErrors{0};
@@ -233,6 +306,13 @@ struct SsdCacheStats {
 /// pin count and an read count. Cache replacement takes place region by region,
 /// preferring regions with a smaller read count. Entries do not span regions.
 /// Otherwise entries are consecutive byte ranges inside their region.
+///
+/// With checkpointing on, the state is made durable as a full checkpoint every
+/// 'checkpointIntervalBytes' written, plus a delta log of the entries added and
+/// the regions evicted since. The delta log is appended every
+/// 'checkpointIntervalBytes' / kDeltaLogsPerCheckpoint written. Both are
+/// written on 'executor' if there is one, so that SsdFile::write does not wait
+/// for them. Recovery reads the checkpoint and replays the delta log.
 class SsdFile {
  public:
   struct Config {
@@ -244,7 +324,9 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -253,7 +335,8 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -277,16 +360,32 @@ class SsdFile {
     /// If true, checksum read verification from SSD is enabled.
     bool checksumReadVerificationEnabled;
 
-    /// Executor for async fsync in checkpoint.
+    /// Executor for async fsync in checkpoint and for making checkpoints and
+    /// delta logs in the background.
     folly::Executor* executor;
+
+    /// Codec for new entries. An entry is stored uncompressed if it does not
+    /// compress to under kMaxCompressedPct of its size. Entries written with
+    /// any codec can be read regardless of this.
+    common::CompressionKind compressionKind;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
+  /// An entry is stored compressed only if that takes under this percentage
+  /// of its uncompressed size.
+  static constexpr int32_t kMaxCompressedPct = 90;
+
+  /// Number of delta log appends between consecutive full checkpoints.
+  static constexpr int32_t kDeltaLogsPerCheckpoint = 8;
+
   /// Constructs a cache backed by filename. Discards any previous contents of
   /// filename.
   SsdFile(const Config& config);
 
+  /// Waits for a background checkpoint or delta log write to finish.
+  ~SsdFile();
+
   /// Adds entries of 'pins' to this file. 'pins' must be in read mode and
   /// those pins that are successfully added to SSD are marked as being on SSD.
   /// The file of the entries must be a file that is backed by 'this'.
@@ -347,14 +446,20 @@ class SsdFile {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
-  /// Writes a checkpoint state that can be recovered from. The
-  /// checkpoint is serialized on 'mutex_'. If 'force' is false,
-  /// rechecks that at least 'checkpointIntervalBytes_' have been
+  /// Writes a checkpoint state that can be recovered from. The state is
+  /// copied under 'mutex_' and written out without holding it. Checkpoints
+  /// and delta log writes are serialized on 'checkpointMutex_'. If 'force' is
+  /// false, rechecks that at least 'checkpointIntervalBytes_' have been
   /// written since last checkpoint and silently returns if not.
   void checkpoint(bool force = false);
 
+  /// Appends the entries added and regions evicted since the last checkpoint
+  /// or delta log write to the delta log. Syncs the cache file first so that
+  /// the logged entries are durable.
+  void writeDeltaLog();
+
   /// Deletes checkpoint files. If 'keepLog' is true, truncates and syncs the
-  /// eviction log and leaves this open.
+  /// eviction and delta logs and leaves these open.
   void deleteCheckpoint(bool keepLog = false);
 
   /// Returns the SSD file path.
@@ -372,6 +477,11 @@ class SsdFile {
     return fileName_ + kCheckpointExtension;
   }
 
+  /// Returns the delta log file path.
+  std::string getDeltaLogFilePath() const {
+    return fileName_ + kDeltaLogExtension;
+  }
+
   /// Deletes the backing file. Used in testing.
   void testingDeleteFile();
 
@@ -410,9 +520,17 @@ class SsdFile {
 
   static constexpr int kMaxErasedSizePct = 50;
 
+  // Record types in the delta log.
+  static constexpr int32_t kDeltaAdd = 1;
+  static constexpr int32_t kDeltaEvict = 2;
+
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
-  std::string checkpointVersion() const {
+  // if checksum write is enabled or not and if the entries have a codec and
+  // uncompressed size.
+  std::string checkpointVersion(bool withCompression) const {
+    if (withCompression) {
+      return checksumEnabled_ ? "CPT4" : "CPT3";
+    }
     return checksumEnabled_ ? "CPT2" : "CPT1";
   }
 
@@ -426,8 +544,9 @@ class SsdFile {
   // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
   // if there is no space. The space does not necessarily cover all the pins, so
   // multiple calls starting at the first unwritten pin may be needed.
+  // 'sizes' are the sizes on SSD of the entries of the pins.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
       int32_t begin);
 
   // Removes all 'entries_' that reference data in regions described by
@@ -441,6 +560,19 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Returns the compressed bytes of 'entry' or nullptr if the entry does not
+  // compress well with 'codec'.
+  static std::unique_ptr<folly::IOBuf> compressEntry(
+      folly::io::Codec& codec,
+      const AsyncDataCacheEntry& entry);
+
+  // Reads the compressed entry at 'run' and decompresses its first
+  // 'entry.size()' bytes into 'entry'.
+  void loadCompressed(const SsdRun& run, AsyncDataCacheEntry& entry);
+
+  // Returns the uncompressed bytes of the entry at 'run'.
+  std::string readUncompressed(const SsdRun& run);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -449,6 +581,23 @@ class SsdFile {
   // checkpoint and leaves the log truncated open.
   void readCheckpoint(std::ifstream& state);
 
+  // Applies the delta log to the state read from the checkpoint.
+  // 'evictCounts' is the number of times each region appears in the eviction
+  // log. An added entry is recovered only if all evictions of its region are
+  // before it in the delta log, i.e. the data was not overwritten later.
+  // Adds the regions the file grew by after the checkpoint to 'writable'.
+  void replayDeltaLog(
+      const std::unordered_map<int32_t, int32_t>& evictCounts,
+      std::unordered_set<int32_t>& writable);
+
+  // Starts a checkpoint or delta log write if due. Runs on 'executor_' if set
+  // and no previous one is pending, else on the calling thread.
+  void maybeCheckpoint();
+
+  // Appends a kDeltaAdd record for 'key' and 'run' to 'pendingDeltas_'.
+  // Caller must hold 'mutex_'.
+  void addDeltaLocked(const FileCacheKey& key, const SsdRun& run);
+
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
@@ -466,7 +615,7 @@ class SsdFile {
   write(uint64_t offset, uint64_t length, const std::vector<iovec>& iovecs);
 
   // Synchronously logs that 'regions' are no longer valid in a possibly
-  // existing checkpoint.
+  // existing checkpoint. Also adds the evictions to 'pendingDeltas_'.
   void logEviction(const std::vector<int32_t>& regions);
 
   // Computes the checksum of data in cache 'entry'.
@@ -485,6 +634,15 @@ class SsdFile {
     return force || (bytesAfterCheckpoint_ >= checkpointIntervalBytes_);
   }
 
+  // Returns true if a delta log write is needed.
+  bool needDeltaLog() const {
+    if (!checkpointEnabled()) {
+      return false;
+    }
+    return bytesAfterDeltaLog_ >=
+        checkpointIntervalBytes_ / kDeltaLogsPerCheckpoint;
+  }
+
   void maybeVerifyChecksum(
       const AsyncDataCacheEntry& entry,
       const SsdRun& ssdRun);
@@ -492,11 +650,18 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPT4";
+  }
+
+  // Returns true if the entries of the given version have compression bits.
+  static bool isCompressionOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPT3" || checkpointVersion == "CPT4";
   }
 
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
+  static constexpr const char* kDeltaLogExtension = ".dlt";
 
   // Name of cache file, used as prefix for checkpoint files.
   const std::string fileName_;
@@ -513,6 +678,9 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // Codec for new entries.
+  const common::CompressionKind compressionKind_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
@@ -534,6 +702,9 @@ class SsdFile {
 
   std::vector<uint32_t> erasedRegionSizes_;
 
+  // Uncompressed size of the live entries in each region. For stats.
+  std::vector<uint64_t> regionUncompressedSizes_;
+
   // Indices of regions available for writing new entries.
   std::vector<int32_t> writableRegions_;
 
@@ -568,9 +739,28 @@ class SsdFile {
   // Count of bytes written after last checkpoint.
   std::atomic<uint64_t> bytesAfterCheckpoint_{0};
 
+  // Count of bytes written after last delta log write or checkpoint.
+  std::atomic<uint64_t> bytesAfterDeltaLog_{0};
+
   // fd for logging evictions.
   int32_t evictLogFd_{-1};
 
+  // fd of the delta log. Opened in append mode.
+  int32_t deltaLogFd_{-1};
+
+  // Serialized delta records not yet in the delta log. Guarded by 'mutex_'.
+  std::string pendingDeltas_;
+
+  // Serializes checkpoints and delta log writes.
+  std::mutex checkpointMutex_;
+
+  // Guards 'checkpointFuture_'.
+  std::mutex checkpointFutureMutex_;
+
+  // Completes when the checkpoint or delta log write last queued on
+  // 'executor_' is done. Empty if none was queued.
+  ContinueFuture checkpointFuture_{ContinueFuture::makeEmpty()};
+
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
 };
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/caching/CacheSnapshot.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_string(
+    snapshot_dir,
+    "/dev/shm",
+    "Directory for the snapshot and the source file. Use tmpfs or a DAX "
+    "mount to measure restart from persistent memory.");
+DEFINE_int32(cache_mb, 1024, "Bytes of cached data in MB");
+DEFINE_int32(entry_kb, 1024, "Size of a cache entry in KB");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+// Compares the time to warm an empty cache from a snapshot against
+// reading the same data from a file, as after a restart without a
+// snapshot.
+namespace {
+
+std::string sourcePath() {
+  return FLAGS_snapshot_dir + "/cache_snapshot_benchmark.data";
+}
+
+std::string snapshotPath() {
+  return FLAGS_snapshot_dir + "/cache_snapshot_benchmark.snapshot";
+}
+
+int64_t entrySize() {
+  return FLAGS_entry_kb << 10;
+}
+
+int32_t numEntries() {
+  return (static_cast<int64_t>(FLAGS_cache_mb) << 20) / entrySize();
+}
+
+std::shared_ptr<AsyncDataCache> makeCache() {
+  return AsyncDataCache::create(memory::memoryManager()->allocator());
+}
+
+// Fills 'cache' with the contents of the source file.
+void loadFromFile(AsyncDataCache& cache) {
+  const auto fd = ::open(sourcePath().c_str(), O_RDONLY);
+  VELOX_CHECK_GE(fd, 0);
+  StringIdLease file(fileIds(), sourcePath());
+  for (auto i = 0; i < numEntries(); ++i) {
+    const uint64_t offset = i * entrySize();
+    auto pin = cache.findOrCreate({file.id(), offset}, entrySize());
+    auto* entry = pin.checkedEntry();
+    auto& data = entry->data();
+    uint64_t position = offset;
+    for (auto j = 0; j < data.numRuns(); ++j) {
+      const auto run = data.runAt(j);
+      const auto bytes = std::min<uint64_t>(
+          run.numBytes(), offset + entrySize() - position);
+      VELOX_CHECK_EQ(::pread(fd, run.data(), bytes, position), bytes);
+      position += bytes;
+    }
+    entry->setExclusiveToShared(false);
+  }
+  ::close(fd);
+}
+
+void setUp() {
+  memory::MemoryManager::initialize({});
+  const auto fd =
+      ::open(sourcePath().c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+  VELOX_CHECK_GE(fd, 0);
+  std::string buffer(entrySize(), 0);
+  for (auto i = 0; i < numEntries(); ++i) {
+    std::fill(buffer.begin(), buffer.end(), static_cast<char>(i));
+    VELOX_CHECK_EQ(::write(fd, buffer.data(), buffer.size()), buffer.size());
+  }
+  ::close(fd);
+
+  auto cache = makeCache();
+  loadFromFile(*cache);
+  CacheSnapshot::save(*cache, snapshotPath());
+  cache->shutdown();
+}
+
+void tearDown() {
+  ::unlink(sourcePath().c_str());
+  ::unlink(snapshotPath().c_str());
+}
+
+} // namespace
+
+BENCHMARK(warmFromFile) {
+  std::shared_ptr<AsyncDataCache> cache;
+  BENCHMARK_SUSPEND {
+    cache = makeCache();
+  }
+  loadFromFile(*cache);
+  BENCHMARK_SUSPEND {
+    cache->shutdown();
+    cache.reset();
+  }
+}
+
+BENCHMARK_RELATIVE(warmFromSnapshot) {
+  std::shared_ptr<AsyncDataCache> cache;
+  BENCHMARK_SUSPEND {
+    cache = makeCache();
+  }
+  CacheSnapshot::load(*cache, snapshotPath());
+  BENCHMARK_SUSPEND {
+    cache->shutdown();
+    cache.reset();
+  }
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  setUp();
+  folly::runBenchmarks();
+  tearDown();
+  return 0;
+}
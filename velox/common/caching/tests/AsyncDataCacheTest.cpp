@@ -113,7 +113,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
       uint64_t maxBytes,
       int64_t ssdBytes = 0,
       uint64_t checkpointIntervalBytes = 0,
-      AsyncDataCache::Options cacheOptions = {}) {
+      AsyncDataCache::Options cacheOptions = {},
+      std::shared_ptr<SsdAdmissionPolicy> admissionPolicy = nullptr) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -137,7 +138,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
           checkpointIntervalBytes > 0 ? checkpointIntervalBytes : ssdBytes / 20,
           false,
           GetParam().checksumEnabled,
-          GetParam().checksumVerificationEnabled);
+          GetParam().checksumVerificationEnabled,
+          std::move(admissionPolicy));
       ssdCache = std::make_unique<SsdCache>(config);
     }
 
@@ -1018,6 +1020,47 @@ TEST_P(AsyncDataCacheTest, staleEntry) {
   ASSERT_EQ(stats.numHit, 1);
 }
 
+TEST_P(AsyncDataCacheTest, concurrentHits) {
+  constexpr uint64_t kRamBytes = 1UL << 30;
+  constexpr int32_t kNumEntries = 10;
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumHitsPerThread = 1'000;
+  constexpr uint64_t kSize = 100;
+  initializeCache(kRamBytes, 0, 0);
+  StringIdLease file(fileIds(), std::string_view("concurrentHits"));
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate({file.id(), i * kSize}, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    pin.entry()->setExclusiveToShared();
+  }
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < kNumHitsPerThread; ++j) {
+        const uint64_t offset = (j % kNumEntries) * kSize;
+        auto pin = cache_->findOrCreate({file.id(), offset}, kSize, nullptr);
+        EXPECT_FALSE(pin.empty());
+        if (!pin.empty()) {
+          EXPECT_TRUE(pin.entry()->isShared());
+          EXPECT_EQ(pin.entry()->offset(), static_cast<int64_t>(offset));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numEntries, kNumEntries);
+  ASSERT_EQ(stats.numHit, kNumThreads * kNumHitsPerThread);
+  for (auto* entry : cache_->testingCacheEntries()) {
+    ASSERT_EQ(entry->numPins(), 0);
+  }
+}
+
 TEST_P(AsyncDataCacheTest, shrinkCache) {
   constexpr uint64_t kRamBytes = 128UL << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -1422,6 +1465,85 @@ TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, compressedTier) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 128 << 10;
+  constexpr int32_t kNumEntries = 256;
+  initializeCache(
+      kMaxBytes, 0, 0, AsyncDataCache::Options(0.7, 0.125, 1 << 24, 32 << 20));
+  ASSERT_NE(cache_->compressedTier(), nullptr);
+  const auto fileNum = filenames_[0].id();
+  for (uint64_t i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate({fileNum, i * kSize}, kSize, nullptr);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    initializeContents(fileNum + pin.entry()->offset(), pin.entry()->data());
+    pin.entry()->setExclusiveToShared(false);
+    cache_->makeEvictable({fileNum, i * kSize});
+  }
+
+  // An allocation that does not fit next to the cache evicts entries into
+  // the compressed tier.
+  memory::Allocation allocation;
+  ASSERT_TRUE(allocator_->allocateNonContiguous(
+      memory::AllocationTraits::numPages(48 << 20), allocation));
+  allocator_->freeNonContiguous(allocation);
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numCompressedPut, 0);
+  ASSERT_EQ(stats.numCompressedEntries, stats.numCompressedPut);
+  ASSERT_LT(stats.compressedBytes, stats.compressedUncompressedBytes);
+  ASSERT_EQ(stats.compressedUncompressedBytes, stats.numCompressedPut * kSize);
+  ASSERT_EQ(stats.numCompressedEvict, 0);
+  ASSERT_EQ(stats.numCompressedHit, 0);
+
+  // All entries are found, either in memory or in the compressed tier.
+  const auto numHit = stats.numHit;
+  for (uint64_t i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate({fileNum, i * kSize}, kSize, nullptr);
+    ASSERT_TRUE(pin.entry()->isShared());
+    checkContents(*pin.entry());
+  }
+  const auto numCompressedPut = stats.numCompressedPut;
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numCompressedHit, numCompressedPut);
+  ASSERT_EQ(stats.compressedHitBytes, numCompressedPut * kSize);
+  ASSERT_EQ(stats.numHit - numHit + stats.numCompressedHit, kNumEntries);
+  ASSERT_EQ(stats.numCompressedEntries, 0);
+  ASSERT_EQ(stats.compressedBytes, 0);
+}
+
+TEST_P(AsyncDataCacheTest, ssdAdmissionRejectedOnce) {
+  constexpr int64_t kRamBytes = 32 << 20;
+  constexpr int64_t kSsdBytes = 64 << 20;
+  constexpr int32_t kSize = 16 << 10;
+  constexpr int32_t kNumEntries = 16;
+  // Entries accessed once are not admitted.
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      0,
+      {},
+      std::make_shared<TinyLfuSsdAdmissionPolicy>(1024, 2));
+  const auto fileNum = filenames_[0].id();
+  for (uint64_t i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate({fileNum, i * kSize}, kSize, nullptr);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    initializeContents(fileNum + pin.entry()->offset(), pin.entry()->data());
+    pin.entry()->setExclusiveToShared();
+  }
+
+  // The entries stay in memory and are offered again by every write but are
+  // counted as rejected once.
+  for (auto i = 0; i < 3; ++i) {
+    waitForSsdWriteToFinish(cache_->ssdCache());
+    ASSERT_TRUE(cache_->ssdCache()->startWrite());
+    cache_->saveToSsd();
+    waitForSsdWriteToFinish(cache_->ssdCache());
+    const auto stats = cache_->ssdCache()->stats();
+    ASSERT_EQ(stats.entriesAdmitted, 0);
+    ASSERT_EQ(stats.entriesRejected, kNumEntries);
+  }
+}
+
 // TODO: add concurrent fuzzer test.
 
 INSTANTIATE_TEST_SUITE_P(
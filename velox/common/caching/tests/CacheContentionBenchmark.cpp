@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include <thread>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+
+DEFINE_int32(num_entries, 1'024, "Number of cached entries looked up");
+DEFINE_int32(entry_size, 64 << 10, "Size of each cached entry in bytes");
+DEFINE_int32(num_lookups, 100'000, "Number of lookups per thread");
+
+/// Measures cache hits on a set of hot entries from many threads, as when many
+/// Drivers scan the same cached data.
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+class CacheContentionBenchmark {
+ public:
+  CacheContentionBenchmark()
+      : fileId_(fileIds(), "cache_contention_benchmark") {
+    memory::MemoryManagerOptions options;
+    options.useMmapAllocator = true;
+    options.allocatorCapacity = 4UL << 30;
+    options.arbitratorCapacity = options.allocatorCapacity;
+    manager_ = std::make_unique<memory::MemoryManager>(options);
+    cache_ = AsyncDataCache::create(manager_->allocator());
+
+    for (auto i = 0; i < FLAGS_num_entries; ++i) {
+      auto pin = cache_->findOrCreate(key(i), FLAGS_entry_size, nullptr);
+      VELOX_CHECK(!pin.empty());
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  }
+
+  ~CacheContentionBenchmark() {
+    cache_->shutdown();
+  }
+
+  void run(int32_t numThreads) {
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (auto i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&]() {
+        for (auto j = 0; j < FLAGS_num_lookups; ++j) {
+          const auto index = folly::Random::rand32() % FLAGS_num_entries;
+          auto pin =
+              cache_->findOrCreate(key(index), FLAGS_entry_size, nullptr);
+          VELOX_CHECK(!pin.empty() && pin.checkedEntry()->isShared());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+ private:
+  RawFileCacheKey key(int32_t index) const {
+    return RawFileCacheKey{
+        fileId_.id(), static_cast<uint64_t>(index) * FLAGS_entry_size};
+  }
+
+  const StringIdLease fileId_;
+  std::unique_ptr<memory::MemoryManager> manager_;
+  std::shared_ptr<AsyncDataCache> cache_;
+};
+
+std::unique_ptr<CacheContentionBenchmark> benchmark;
+
+void hits(uint32_t iters, int32_t numThreads) {
+  for (uint32_t i = 0; i < iters; ++i) {
+    benchmark->run(numThreads);
+  }
+}
+
+BENCHMARK_NAMED_PARAM(hits, 1_thread, 1);
+BENCHMARK_NAMED_PARAM(hits, 8_threads, 8);
+BENCHMARK_NAMED_PARAM(hits, 32_threads, 32);
+BENCHMARK_NAMED_PARAM(hits, 64_threads, 64);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  benchmark = std::make_unique<CacheContentionBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
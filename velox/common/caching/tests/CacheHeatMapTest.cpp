@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheHeatMap.h"
+#include "velox/common/caching/FileIds.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+// Returns the TrackingId of the data stream of 'column' in the encoding of
+// DWRF stream identifiers.
+TrackingId dataStream(int32_t column, int32_t kind = 1) {
+  return TrackingId((column << 5) | kind);
+}
+} // namespace
+
+TEST(CacheHeatMapTest, disabled) {
+  CacheHeatMap heatMap;
+  ASSERT_FALSE(heatMap.enabled());
+  heatMap.recordRead(1, dataStream(1), 100);
+  heatMap.recordLoad(1, dataStream(1), CacheHeatMap::Source::kStorage, 100);
+  EXPECT_EQ(heatMap.totals(), HeatMapCounters{});
+  EXPECT_TRUE(heatMap.entries().empty());
+}
+
+TEST(CacheHeatMapTest, basic) {
+  CacheHeatMap heatMap;
+  heatMap.setEnabled(true);
+  // The streams of a column are counted together.
+  heatMap.recordReference(1, dataStream(2, 0), 1'000);
+  heatMap.recordReference(1, dataStream(2, 1), 1'000);
+  heatMap.recordRead(1, dataStream(2, 0), 500);
+  heatMap.recordRead(1, dataStream(2, 1), 1'000);
+  heatMap.recordLoad(1, dataStream(2), CacheHeatMap::Source::kRam, 200);
+  heatMap.recordLoad(1, dataStream(2), CacheHeatMap::Source::kSsd, 300);
+  heatMap.recordLoad(
+      1, dataStream(2), CacheHeatMap::Source::kStorage, 1'000, true);
+  heatMap.recordPrefetchHit(1, dataStream(2), 600);
+  heatMap.recordPrefetchWasted(1, dataStream(2), 400);
+
+  heatMap.recordRead(1, dataStream(3), 2'000);
+  heatMap.recordRead(2, dataStream(2), 100);
+  heatMap.recordRead(2, TrackingId(), 10);
+
+  const auto entries = heatMap.entries();
+  ASSERT_EQ(entries.size(), 4);
+  EXPECT_EQ(entries[0].groupId, 1);
+  EXPECT_EQ(entries[0].column, 3);
+  EXPECT_EQ(entries[0].counters.readBytes, 2'000);
+
+  EXPECT_EQ(entries[1].groupId, 1);
+  EXPECT_EQ(entries[1].column, 2);
+  const auto& counters = entries[1].counters;
+  EXPECT_EQ(counters.referencedBytes, 2'000);
+  EXPECT_EQ(counters.readBytes, 1'500);
+  EXPECT_EQ(counters.ramBytes, 200);
+  EXPECT_EQ(counters.ssdBytes, 300);
+  EXPECT_EQ(counters.storageBytes, 1'000);
+  EXPECT_EQ(counters.prefetchBytes, 1'000);
+  EXPECT_EQ(counters.prefetchHitBytes, 600);
+  EXPECT_EQ(counters.prefetchWastedBytes, 400);
+  EXPECT_EQ(counters.prefetchHitPct(), 60);
+
+  EXPECT_EQ(entries[2].groupId, 2);
+  EXPECT_EQ(entries[2].column, 2);
+  EXPECT_EQ(entries[3].column, -1);
+
+  const auto totals = heatMap.totals();
+  EXPECT_EQ(totals.readBytes, 3'610);
+  EXPECT_EQ(totals.storageBytes, 1'000);
+  EXPECT_EQ(totals.prefetchHitPct(), 60);
+  EXPECT_EQ(HeatMapCounters{}.prefetchHitPct(), 100);
+
+  EXPECT_EQ(heatMap.entries(1).size(), 1);
+
+  heatMap.clear();
+  EXPECT_EQ(heatMap.totals(), HeatMapCounters{});
+  EXPECT_TRUE(heatMap.entries().empty());
+}
+
+TEST(CacheHeatMapTest, maxEntries) {
+  CacheHeatMap heatMap(2);
+  heatMap.setEnabled(true);
+  for (auto column = 0; column < 10; ++column) {
+    heatMap.recordRead(1, dataStream(column), 100);
+  }
+  EXPECT_EQ(heatMap.entries().size(), 2);
+  EXPECT_EQ(heatMap.totals().readBytes, 1'000);
+  // Known entries are still updated.
+  heatMap.recordRead(1, dataStream(1), 100);
+  EXPECT_EQ(heatMap.entries(1)[0].counters.readBytes, 200);
+}
+
+TEST(CacheHeatMapTest, toString) {
+  StringIdLease group(fileIds(), "/warehouse/table/ds=2024-01-01");
+  CacheHeatMap heatMap;
+  heatMap.setEnabled(true);
+  heatMap.recordRead(group.id(), dataStream(4), 1 << 20);
+  heatMap.recordLoad(
+      group.id(), dataStream(4), CacheHeatMap::Source::kStorage, 1 << 20);
+  EXPECT_EQ(
+      heatMap.toString(10),
+      "CacheHeatMap: referenced 0B read 1.00MB ram 0B ssd 0B storage 1.00MB "
+      "prefetch 0B prefetch hit 100% prefetch wasted 0B\n"
+      "/warehouse/table/ds=2024-01-01 column 4: referenced 0B read 1.00MB "
+      "ram 0B ssd 0B storage 1.00MB prefetch 0B prefetch hit 100% prefetch "
+      "wasted 0B\n");
+}
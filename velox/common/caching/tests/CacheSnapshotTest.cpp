@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheSnapshot.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+class CacheSnapshotTest : public testing::Test {
+ protected:
+  // Entry sizes covering tiny entries and entries of several runs.
+  static constexpr std::array<int32_t, 4> kSizes{100, 4'000, 100'000, 1 << 20};
+
+  void SetUp() override {
+    memory::MemoryManager::testingSetInstance({});
+    cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
+    tempDirectory_ = exec::test::TempDirectoryPath::create();
+    path_ = tempDirectory_->getPath() + "/snapshot";
+  }
+
+  void TearDown() override {
+    cache_->shutdown();
+    cache_.reset();
+    fileIds().testingReset();
+  }
+
+  // Replaces 'cache_' with an empty cache.
+  void restart() {
+    cache_->shutdown();
+    cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
+  }
+
+  static void forEachByte(
+      AsyncDataCacheEntry& entry,
+      const std::function<void(char&, int64_t)>& func) {
+    if (entry.tinyData() != nullptr) {
+      for (auto i = 0; i < entry.size(); ++i) {
+        func(entry.tinyData()[i], i);
+      }
+      return;
+    }
+    int64_t offset = 0;
+    for (auto i = 0; i < entry.data().numRuns(); ++i) {
+      const auto run = entry.data().runAt(i);
+      for (auto j = 0; j < run.numBytes() && offset < entry.size(); ++j) {
+        func(run.data<char>()[j], offset++);
+      }
+    }
+  }
+
+  // Adds an entry of each of 'kSizes' for 'fileName' to 'cache_'.
+  void addEntries(const std::string& fileName) {
+    StringIdLease file(fileIds(), fileName);
+    for (auto i = 0; i < kSizes.size(); ++i) {
+      auto pin = cache_->findOrCreate({file.id(), offset(i)}, kSizes[i]);
+      ASSERT_TRUE(pin.checkedEntry()->isExclusive());
+      forEachByte(*pin.checkedEntry(), [&](char& byte, int64_t position) {
+        byte = expectedByte(fileName, i, position);
+      });
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  }
+
+  // Returns the number of entries of 'fileName' found in 'cache_' and checks
+  // their contents.
+  int32_t checkEntries(const std::string& fileName) {
+    StringIdLease file(fileIds(), fileName);
+    int32_t numFound = 0;
+    for (auto i = 0; i < kSizes.size(); ++i) {
+      auto pin = cache_->findOrCreate({file.id(), offset(i)}, kSizes[i]);
+      if (pin.checkedEntry()->isExclusive()) {
+        continue;
+      }
+      ++numFound;
+      EXPECT_EQ(pin.checkedEntry()->size(), kSizes[i]);
+      forEachByte(*pin.checkedEntry(), [&](char& byte, int64_t position) {
+        ASSERT_EQ(byte, expectedByte(fileName, i, position));
+      });
+    }
+    return numFound;
+  }
+
+  static uint64_t offset(int32_t index) {
+    return index * (10 << 20);
+  }
+
+  static char expectedByte(
+      const std::string& fileName,
+      int32_t index,
+      int64_t position) {
+    return fileName.back() + index * 7 + position;
+  }
+
+  int64_t totalBytes() const {
+    return std::accumulate(kSizes.begin(), kSizes.end(), 0L);
+  }
+
+  std::shared_ptr<AsyncDataCache> cache_;
+  std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
+  std::string path_;
+};
+
+TEST_F(CacheSnapshotTest, saveAndLoad) {
+  addEntries("file1");
+  addEntries("file2");
+  auto stats = CacheSnapshot::save(*cache_, path_);
+  EXPECT_EQ(stats.numEntries, 2 * kSizes.size());
+  EXPECT_EQ(stats.bytes, 2 * totalBytes());
+
+  // Entries of files that fail validation are not loaded.
+  restart();
+  stats = CacheSnapshot::load(*cache_, path_, [](const std::string& name) {
+    return name != "file2";
+  });
+  EXPECT_EQ(stats.numEntries, kSizes.size());
+  EXPECT_EQ(stats.bytes, totalBytes());
+  EXPECT_EQ(stats.numSkipped, kSizes.size());
+  EXPECT_EQ(checkEntries("file1"), kSizes.size());
+  EXPECT_EQ(checkEntries("file2"), 0);
+
+  // Entries already in the cache are kept.
+  stats = CacheSnapshot::load(*cache_, path_);
+  EXPECT_EQ(stats.numEntries, kSizes.size());
+  EXPECT_EQ(stats.numSkipped, kSizes.size());
+  EXPECT_EQ(checkEntries("file2"), kSizes.size());
+}
+
+TEST_F(CacheSnapshotTest, corruption) {
+  addEntries("file1");
+  CacheSnapshot::save(*cache_, path_);
+  restart();
+
+  // An entry whose data does not match its checksum is skipped.
+  const auto fd = ::open(path_.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  const char byte = 0;
+  // The first entry is right after the 8 byte header.
+  ASSERT_EQ(::pwrite(fd, &byte, 1, 8 + 10), 1);
+  auto stats = CacheSnapshot::load(*cache_, path_);
+  EXPECT_EQ(stats.numEntries, kSizes.size() - 1);
+  EXPECT_EQ(stats.numSkipped, 1);
+
+  // A snapshot without its footer is rejected.
+  restart();
+  const auto size = ::lseek(fd, 0, SEEK_END);
+  ASSERT_EQ(::ftruncate(fd, size - 1), 0);
+  ::close(fd);
+  VELOX_ASSERT_THROW(
+      CacheSnapshot::load(*cache_, path_), "Incomplete cache snapshot");
+  EXPECT_EQ(checkEntries("file1"), 0);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/ColumnAccessHistory.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+// Returns the TrackingId of the data stream of 'column' in the encoding of
+// DWRF stream identifiers.
+TrackingId dataStream(int32_t column, int32_t kind = 1) {
+  return TrackingId((column << 5) | kind);
+}
+} // namespace
+
+TEST(ColumnAccessHistoryTest, disabled) {
+  ColumnAccessHistory history;
+  ASSERT_FALSE(history.enabled());
+  history.recordScan("t", {{1, 100}});
+  EXPECT_EQ(history.numTables(), 0);
+  EXPECT_TRUE(history.predictColumns("t", 0).empty());
+}
+
+TEST(ColumnAccessHistoryTest, predict) {
+  ColumnAccessHistory history;
+  history.setEnabled(true);
+  for (auto i = 0; i < 10; ++i) {
+    // Column 1 is read by every scan, column 2 by every other and column 3 by
+    // the first scan only.
+    folly::F14FastMap<int32_t, int64_t> columns{{1, 100}};
+    if (i % 2 == 0) {
+      columns[2] = 1'000;
+    }
+    if (i == 0) {
+      columns[3] = 10;
+    }
+    history.recordScan("t", columns);
+  }
+  EXPECT_EQ(history.numTables(), 1);
+  // The most read columns come first.
+  EXPECT_EQ(history.predictColumns("t", 40), (std::vector<int32_t>{2, 1}));
+  EXPECT_EQ(history.predictColumns("t", 100), (std::vector<int32_t>{1}));
+  // The first scan has decayed to under 10% of the weight.
+  EXPECT_EQ(history.predictColumns("t", 0), (std::vector<int32_t>{2, 1, 3}));
+  EXPECT_EQ(history.predictColumns("t", 10), (std::vector<int32_t>{2, 1}));
+  EXPECT_TRUE(history.predictColumns("other", 0).empty());
+
+  const auto table = history.tableHistory("t");
+  ASSERT_TRUE(table.has_value());
+  EXPECT_NEAR(table->numScans, (1 - std::pow(0.9, 10)) / 0.1, 1e-9);
+  EXPECT_DOUBLE_EQ(table->columns.at(1).numScans, table->numScans);
+  EXPECT_FALSE(history.tableHistory("other").has_value());
+}
+
+TEST(ColumnAccessHistoryTest, scanTracker) {
+  ColumnAccessHistory history;
+  history.setEnabled(true);
+  ScanTracker tracker("scan", nullptr, 1 << 20, nullptr, "t");
+  tracker.recordReference(dataStream(1, 0), 100, 1, 1);
+  tracker.recordReference(dataStream(1, 1), 100, 1, 1);
+  tracker.recordReference(dataStream(2), 100, 1, 1);
+  tracker.recordRead(dataStream(1, 0), 50, 1, 1);
+  tracker.recordRead(dataStream(1, 1), 100, 1, 1);
+  history.recordScan(tracker);
+  // The streams of a column count together and referenced columns that were
+  // not read do not count.
+  const auto table = history.tableHistory("t");
+  ASSERT_TRUE(table.has_value());
+  ASSERT_EQ(table->columns.size(), 1);
+  EXPECT_EQ(table->columns.at(1).readBytes, 150);
+
+  // Scans of unknown tables are not recorded.
+  ScanTracker anonymous("scan2", nullptr, 1 << 20);
+  anonymous.recordRead(dataStream(1), 100, 1, 1);
+  history.recordScan(anonymous);
+  EXPECT_EQ(history.numTables(), 1);
+}
+
+TEST(ColumnAccessHistoryTest, maxTables) {
+  ColumnAccessHistory history(2);
+  history.setEnabled(true);
+  history.recordScan("t1", {{1, 100}});
+  history.recordScan("t2", {{1, 100}});
+  history.recordScan("t3", {{1, 100}});
+  history.recordScan("t1", {{2, 100}});
+  EXPECT_EQ(history.numTables(), 2);
+  EXPECT_TRUE(history.predictColumns("t3", 0).empty());
+  EXPECT_EQ(history.predictColumns("t1", 0), (std::vector<int32_t>{2, 1}));
+}
+
+TEST(ColumnAccessHistoryTest, persist) {
+  ColumnAccessHistory history;
+  history.setEnabled(true);
+  history.recordScan("t1", {{1, 100}, {2, 200}});
+  history.recordScan("t1", {{1, 100}});
+  history.recordScan("t2", {{5, 10}});
+
+  ColumnAccessHistory copy;
+  copy.deserialize(history.serialize());
+  EXPECT_EQ(copy.numTables(), 2);
+  for (const auto* table : {"t1", "t2"}) {
+    for (const auto pct : {0, 60, 100}) {
+      EXPECT_EQ(
+          copy.predictColumns(table, pct), history.predictColumns(table, pct));
+    }
+  }
+
+  auto tempFile = exec::test::TempFilePath::create();
+  history.save(tempFile->getPath());
+  ColumnAccessHistory loaded;
+  loaded.recordScan("old", {{1, 1}});
+  loaded.load(tempFile->getPath());
+  EXPECT_EQ(loaded.numTables(), 2);
+  EXPECT_EQ(loaded.serialize(), history.serialize());
+
+  VELOX_ASSERT_THROW(
+      loaded.load("/nonexistent/history.json"),
+      "Failed to open column access history");
+  VELOX_ASSERT_THROW(loaded.deserialize("[1]"), "is not an object");
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(SsdAdmissionPolicyTest, admitOnReuse) {
+  TinyLfuSsdAdmissionPolicy policy(1024);
+  ASSERT_EQ(policy.frequency(1, 0), 0);
+  ASSERT_FALSE(policy.admit(1, 0));
+  policy.recordAccess(1, 0);
+  ASSERT_FALSE(policy.admit(1, 0));
+  policy.recordAccess(1, 0);
+  ASSERT_TRUE(policy.admit(1, 0));
+  ASSERT_EQ(policy.frequency(1, 0), 2);
+
+  // A scan that reads each entry once admits next to nothing. Collisions in
+  // all the rows of the sketch are possible but rare.
+  int32_t numAdmitted = 0;
+  for (auto offset = 0; offset < 200; ++offset) {
+    policy.recordAccess(2, offset * 1'000'000);
+  }
+  for (auto offset = 0; offset < 200; ++offset) {
+    numAdmitted += policy.admit(2, offset * 1'000'000);
+  }
+  ASSERT_LT(numAdmitted, 5);
+  ASSERT_TRUE(policy.admit(1, 0));
+
+  // Counters saturate.
+  for (auto i = 0; i < 100; ++i) {
+    policy.recordAccess(3, 0);
+  }
+  ASSERT_EQ(policy.frequency(3, 0), 15);
+}
+
+TEST(SsdAdmissionPolicyTest, aging) {
+  // 4 rows of 256 counters, halved every 10240 accesses.
+  TinyLfuSsdAdmissionPolicy policy(1024, 3);
+  for (auto i = 0; i < 4; ++i) {
+    policy.recordAccess(1, 0);
+  }
+  ASSERT_EQ(policy.frequency(1, 0), 4);
+  ASSERT_TRUE(policy.admit(1, 0));
+
+  for (auto i = 0; i < 10'240 - 4; ++i) {
+    policy.recordAccess(2, 0);
+  }
+  ASSERT_EQ(policy.frequency(1, 0), 2);
+  ASSERT_EQ(policy.frequency(2, 0), 7);
+  ASSERT_FALSE(policy.admit(1, 0));
+  policy.recordAccess(1, 0);
+  ASSERT_TRUE(policy.admit(1, 0));
+  ASSERT_EQ(
+      policy.toString(),
+      "TinyLFU admission: 1024 counters, min frequency 3, 1 agings");
+}
@@ -21,6 +21,7 @@
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -63,7 +64,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -74,7 +76,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -82,7 +85,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -90,7 +94,9 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         disableFileCow,
         checksumEnabled,
-        checksumReadVerificationEnabled);
+        checksumReadVerificationEnabled,
+        nullptr, // executor
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
   }
 
@@ -374,6 +380,47 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  FLAGS_ssd_verify_write = true;
+  initializeCache(
+      kSsdSize,
+      0,
+      /*checksumEnabled=*/true,
+      /*checksumReadVerificationEnabled=*/true,
+      false,
+      common::CompressionKind_LZ4);
+
+  // The contents from initializeContents() are consecutive integers which
+  // compress well.
+  std::vector<TestEntry> allEntries;
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+  ssdFile_->write(pins);
+  for (auto& pin : pins) {
+    EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    allEntries.emplace_back(
+        pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+  }
+  readAndCheckPins(pins);
+  pins.clear();
+  // Drops the entries from memory so that checkEntries() loads them from SSD.
+  cache_->testingClear();
+
+  auto stats = ssdFile_->testingStats();
+  ASSERT_GT(stats.entriesCompressed, 0);
+  ASSERT_GT(stats.uncompressedBytesWritten, stats.bytesWritten);
+  ASSERT_GT(stats.uncompressedBytesCached, stats.bytesCached);
+  ASSERT_EQ(stats.readSsdCorruptions, 0);
+
+  // The codec and the uncompressed sizes are recovered from the checkpoint.
+  // The file is reopened without compression, which must still read the
+  // compressed entries.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(kSsdSize, 0, true, true);
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+  ASSERT_EQ(ssdFile_->testingStats().readSsdCorruptions, 0);
+}
+
 TEST_F(SsdFileTest, checkpoint) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -468,6 +515,83 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, deltaLog) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  // A delta log is written every 2 regions and full checkpoints are only made
+  // when forced.
+  const uint64_t checkpointIntervalBytes =
+      SsdFile::kDeltaLogsPerCheckpoint * 2 * SsdFile::kRegionSize;
+  const auto fileNameAlt = StringIdLease(fileIds(), "fileInStorageAlt");
+  initializeCache(kSsdSize, checkpointIntervalBytes);
+  // The delta log applies on top of a checkpoint.
+  ssdFile_->checkpoint(true);
+
+  const auto writeRegions = [&](uint64_t fileId, int32_t numRegions) {
+    std::vector<TestEntry> entries;
+    for (auto i = 0; i < numRegions; ++i) {
+      auto pins = makePins(
+          fileId, i * SsdFile::kRegionSize, 4096, 2048 * 1025, 62 * kMB);
+      ssdFile_->write(pins);
+      for (auto& pin : pins) {
+        EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+        entries.emplace_back(
+            pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+      }
+    }
+    return entries;
+  };
+
+  auto entries = writeRegions(fileName_.id(), 6);
+  auto stats = ssdFile_->testingStats();
+  EXPECT_EQ(stats.checkpointsWritten, 1);
+  EXPECT_GE(stats.deltaLogsWritten, 1);
+  ssdFile_->writeDeltaLog();
+
+  // All the entries written after the checkpoint are recovered from the delta
+  // log.
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  stats = ssdFile_->testingStats();
+  EXPECT_EQ(stats.checkpointsRead, 1);
+  EXPECT_EQ(stats.deltaEntriesRecovered, entries.size());
+  EXPECT_EQ(checkEntries(entries), entries.size());
+
+  // Evict all the regions and write other entries in their place.
+  folly::F14FastSet<uint64_t> filesToRemove{fileName_.id()};
+  folly::F14FastSet<uint64_t> filesRetained;
+  ssdFile_->removeFileEntries(filesToRemove, filesRetained);
+  EXPECT_TRUE(filesRetained.empty());
+  const auto altEntries = writeRegions(fileNameAlt.id(), 2);
+  ssdFile_->writeDeltaLog();
+
+  // A partially written batch at the end of the delta log is ignored.
+  const auto deltaLogPath = ssdFile_->getDeltaLogFilePath();
+  const auto fd = ::open(deltaLogPath.c_str(), O_WRONLY | O_APPEND);
+  ASSERT_GE(fd, 0);
+  const int64_t garbage = 1234;
+  ASSERT_EQ(::write(fd, &garbage, sizeof(garbage)), sizeof(garbage));
+  const auto logSize = ::lseek(fd, 0, SEEK_END);
+  ::close(fd);
+
+  // The evicted entries are not recovered and the entries written after the
+  // eviction are.
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  stats = ssdFile_->testingStats();
+  EXPECT_EQ(stats.deltaEntriesRecovered, altEntries.size());
+  EXPECT_EQ(checkEntries(entries), 0);
+  EXPECT_EQ(checkEntries(altEntries), altEntries.size());
+  struct stat logStat;
+  ASSERT_EQ(::stat(deltaLogPath.c_str(), &logStat), 0);
+  EXPECT_EQ(logStat.st_size, logSize - sizeof(garbage));
+
+  // A full checkpoint empties the delta log.
+  ssdFile_->checkpoint(true);
+  ASSERT_EQ(::stat(deltaLogPath.c_str(), &logStat), 0);
+  EXPECT_EQ(logStat.st_size, 0);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes);
+  EXPECT_EQ(ssdFile_->testingStats().deltaEntriesRecovered, 0);
+  EXPECT_EQ(checkEntries(altEntries), altEntries.size());
+}
+
 TEST_F(SsdFileTest, fileCorruption) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
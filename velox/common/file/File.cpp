@@ -23,10 +23,44 @@
 #include <stdexcept>
 
 #include <fcntl.h>
+#include <folly/experimental/io/Liburing.h>
+#include <folly/experimental/io/SimpleAsyncIO.h>
 #include <folly/portability/SysUio.h>
+#include <gflags/gflags.h>
+
+DEFINE_bool(
+    velox_local_file_io_uring,
+    false,
+    "Read local files through io_uring. Has no effect if folly is built "
+    "without liburing");
+DEFINE_int32(
+    velox_local_file_io_uring_queue_depth,
+    256,
+    "Max number of io_uring reads in flight for local files");
 
 namespace facebook::velox {
 
+namespace {
+bool useIoUring() {
+#if FOLLY_HAS_LIBURING
+  return FLAGS_velox_local_file_io_uring;
+#else
+  return false;
+#endif
+}
+
+// Returns the io_uring shared by all LocalReadFiles. A read blocks in
+// submission while the queue is full. Completions run on the event base
+// thread of the instance.
+folly::SimpleAsyncIO& ioUring() {
+  static folly::SimpleAsyncIO ioUring(
+      folly::SimpleAsyncIO::Config()
+          .setMaxRequests(FLAGS_velox_local_file_io_uring_queue_depth)
+          .setMode(folly::SimpleAsyncIO::IOURING));
+  return ioUring;
+}
+} // namespace
+
 #define RETURN_IF_ERROR(func, result) \
   result = func;                      \
   if (result < 0) {                   \
@@ -101,7 +135,8 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
+LocalReadFile::LocalReadFile(std::string_view path)
+    : path_(path), useIoUring_(useIoUring()) {
   fd_ = open(path_.c_str(), O_RDONLY);
   if (fd_ < 0) {
     if (errno == ENOENT) {
@@ -125,7 +160,8 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
   size_ = rc;
 }
 
-LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
+LocalReadFile::LocalReadFile(int32_t fd)
+    : fd_(fd), useIoUring_(useIoUring()) {}
 
 LocalReadFile::~LocalReadFile() {
   const int ret = close(fd_);
@@ -156,6 +192,9 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (useIoUring_) {
+    return preadvAsync(offset, buffers).get();
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -209,6 +248,82 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (!useIoUring_) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  struct State {
+    folly::Promise<uint64_t> promise;
+    std::atomic<int32_t> numPending{0};
+    // End offset of the bytes read. Lowered by a short read.
+    std::atomic<uint64_t> end;
+    // The first error, as a negative errno.
+    std::atomic<int32_t> error{0};
+  };
+  auto state = std::make_shared<State>();
+  auto future = state->promise.getSemiFuture();
+  uint64_t end = offset;
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      ++state->numPending;
+    }
+    end += range.size();
+  }
+  state->end = end;
+
+  // Fulfills the promise once the last read completes.
+  auto finish = [offset](State& state) {
+    if (--state.numPending > 0) {
+      return;
+    }
+    const auto error = state.error.load();
+    if (error == 0) {
+      state.promise.setValue(state.end - offset);
+      return;
+    }
+    try {
+      VELOX_FAIL(
+          "io_uring read failure in LocalReadFile::preadvAsync: {}.",
+          folly::errnoStr(-error));
+    } catch (const std::exception&) {
+      state.promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+    }
+  };
+  // Holds back the completion until all reads are submitted.
+  ++state->numPending;
+  uint64_t rangeOffset = offset;
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      ioUring().pread(
+          fd_,
+          range.data(),
+          range.size(),
+          rangeOffset,
+          [state, finish, rangeEnd = rangeOffset + range.size(), rangeOffset](
+              int rc) {
+            if (rc < 0) {
+              int32_t expected = 0;
+              state->error.compare_exchange_strong(expected, rc);
+            } else if (rangeOffset + rc < rangeEnd) {
+              // Short read at the end of the file.
+              auto current = state->end.load();
+              while (rangeOffset + rc < current &&
+                     !state->end.compare_exchange_weak(
+                         current, rangeOffset + rc)) {
+              }
+            }
+            finish(*state);
+          });
+    }
+    rangeOffset += range.size();
+  }
+  finish(*state);
+  return future;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
@@ -30,6 +30,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -101,6 +102,14 @@ class ReadFile {
     return false;
   }
 
+  // Returns how many of the 'length' bytes at 'offset' are stored on the local
+  // host, or std::nullopt if the file does not know where its data is stored.
+  virtual std::optional<uint64_t> localBytes(
+      uint64_t /*offset*/,
+      uint64_t /*length*/) const {
+    return std::nullopt;
+  }
+
   // Whether preads should be coalesced where possible. E.g. remote disk would
   // set to true, in-memory to false.
   virtual bool shouldCoalesce() const = 0;
@@ -241,10 +250,23 @@ class LocalReadFile final : public ReadFile {
 
   uint64_t size() const final;
 
+  /// With velox_local_file_io_uring, the non-skipped ranges are read by
+  /// concurrent io_uring requests and the call waits for all of them.
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  /// With velox_local_file_io_uring, submits one io_uring request per
+  /// non-skipped range of 'buffers' and returns without waiting. The ranges
+  /// and this file must stay alive until the returned future is fulfilled.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return useIoUring_;
+  }
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -268,6 +290,9 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  // True if reads go through io_uring. Set from velox_local_file_io_uring at
+  // construction.
+  const bool useIoUring_;
 };
 
 class LocalWriteFile final : public WriteFile {
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/FileMetadataCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::filesystems {
+
+std::string FileMetadataCache::Stats::toString() const {
+  return fmt::format(
+      "numHits {} numMisses {} numExpired {} numEvicted {} numEntries {}",
+      numHits,
+      numMisses,
+      numExpired,
+      numEvicted,
+      numEntries);
+}
+
+FileMetadataCache::FileMetadataCache(size_t maxEntries, uint64_t ttlMs)
+    : maxEntries_(maxEntries), ttlMs_(ttlMs) {}
+
+std::optional<FileMetadata> FileMetadataCache::get(std::string_view path) {
+  if (!enabled()) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(path);
+  if (it == entries_.end()) {
+    ++stats_.numMisses;
+    return std::nullopt;
+  }
+  if (getCurrentTimeMs() - it->second.addTimeMs >= ttlMs_) {
+    ++stats_.numMisses;
+    ++stats_.numExpired;
+    eraseLocked(it);
+    return std::nullopt;
+  }
+  ++stats_.numHits;
+  return it->second.metadata;
+}
+
+FileOptions FileMetadataCache::withCachedFileSize(
+    std::string_view path,
+    const FileOptions& options) {
+  auto result = options;
+  if (!result.fileSize.has_value()) {
+    if (auto metadata = get(path)) {
+      result.fileSize = metadata->size;
+    }
+  }
+  return result;
+}
+
+void FileMetadataCache::put(std::string_view path, FileMetadata metadata) {
+  if (!enabled()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(path);
+  if (it != entries_.end()) {
+    eraseLocked(it);
+  }
+  while (entries_.size() >= maxEntries_) {
+    eraseLocked(entries_.find(order_.front()));
+    ++stats_.numEvicted;
+  }
+  order_.emplace_back(path);
+  entries_.emplace(
+      std::string(path),
+      Entry{std::move(metadata), getCurrentTimeMs(), std::prev(order_.end())});
+}
+
+void FileMetadataCache::invalidate(std::string_view path) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(path);
+  if (it != entries_.end()) {
+    eraseLocked(it);
+  }
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  order_.clear();
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  return stats;
+}
+
+void FileMetadataCache::eraseLocked(
+    folly::F14FastMap<std::string, Entry>::iterator it) {
+  order_.erase(it->second.position);
+  entries_.erase(it);
+}
+
+} // namespace facebook::velox::filesystems
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/file/FileSystems.h"
+
+namespace facebook::velox::filesystems {
+
+/// Metadata of a file in an object store as returned by a HEAD-style request.
+struct FileMetadata {
+  int64_t size{0};
+  /// Entity tag of the object. Empty if the store did not return one.
+  std::string etag;
+};
+
+/// Caches FileMetadata by path for the object store FileSystems so that
+/// opening a file does not need a metadata request each time. Files are
+/// assumed not to change while their entry is cached: an entry expires
+/// 'ttlMs' after it was added and the FileSystem invalidates the entries of
+/// the files it writes, removes or renames. At most 'maxEntries' are kept,
+/// the oldest are evicted first. The cache is disabled if either limit is 0.
+/// Thread-safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    /// Lookups that found an entry older than the TTL. Included in
+    /// 'numMisses'.
+    uint64_t numExpired{0};
+    uint64_t numEvicted{0};
+    size_t numEntries{0};
+
+    std::string toString() const;
+  };
+
+  FileMetadataCache(size_t maxEntries, uint64_t ttlMs);
+
+  bool enabled() const {
+    return maxEntries_ > 0 && ttlMs_ > 0;
+  }
+
+  /// Returns the metadata of 'path' if cached and not expired.
+  std::optional<FileMetadata> get(std::string_view path);
+
+  /// Returns 'options' with the size of 'path' from the cache if 'options'
+  /// has no file size. The caller adds the metadata of 'path' after opening
+  /// the file if the returned options still have no file size.
+  FileOptions withCachedFileSize(
+      std::string_view path,
+      const FileOptions& options);
+
+  /// Adds or replaces the metadata of 'path'.
+  void put(std::string_view path, FileMetadata metadata);
+
+  void invalidate(std::string_view path);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    FileMetadata metadata;
+    uint64_t addTimeMs;
+    // Position in 'order_'.
+    std::list<std::string>::iterator position;
+  };
+
+  void eraseLocked(folly::F14FastMap<std::string, Entry>::iterator it);
+
+  const size_t maxEntries_;
+  const uint64_t ttlMs_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  // Paths of 'entries_', oldest first.
+  std::list<std::string> order_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::filesystems
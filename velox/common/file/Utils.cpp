@@ -35,4 +35,74 @@ bool CoalesceIfDistanceLE::operator()(
   return shouldCoalesce;
 }
 
+std::vector<RangeRead> planRangeReads(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t maxCoalesceGap) {
+  std::vector<RangeRead> reads;
+  uint64_t position = offset;
+  uint64_t gap = 0;
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      gap += range.size();
+      position += range.size();
+      continue;
+    }
+    if (!reads.empty() && gap <= maxCoalesceGap) {
+      auto& read = reads.back();
+      if (gap > 0) {
+        read.buffers.emplace_back(static_cast<char*>(nullptr), gap);
+      }
+      read.buffers.push_back(range);
+      read.length += gap + range.size();
+    } else {
+      reads.push_back(RangeRead{position, range.size(), {range}});
+    }
+    gap = 0;
+    position += range.size();
+  }
+  return reads;
+}
+
+void scatterRangeRead(const RangeRead& read, const char* data) {
+  for (const auto& range : read.buffers) {
+    if (range.data() != nullptr) {
+      memcpy(range.data(), data, range.size());
+    }
+    data += range.size();
+  }
+}
+
+folly::SemiFuture<uint64_t> readRangesAsync(
+    std::vector<RangeRead> reads,
+    uint64_t length,
+    folly::Executor* executor,
+    std::function<void(uint64_t, uint64_t, char*)> readRange) {
+  VELOX_CHECK_NOT_NULL(executor);
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(reads.size());
+  for (auto& read : reads) {
+    futures.push_back(
+        folly::via(
+            folly::getKeepAliveToken(executor),
+            [read = std::move(read), readRange]() {
+              if (read.buffers.size() == 1) {
+                readRange(read.offset, read.length, read.buffers[0].data());
+                return;
+              }
+              std::string staging(read.length, '\0');
+              readRange(read.offset, read.length, staging.data());
+              scatterRangeRead(read, staging.data());
+            })
+            .semi());
+  }
+  return folly::collectAll(std::move(futures))
+      .deferValue([length](std::vector<folly::Try<folly::Unit>>&& results) {
+        for (auto& result : results) {
+          result.throwUnlessValue();
+        }
+        return length;
+      });
+}
+
 } // namespace facebook::velox::file::utils
@@ -17,7 +17,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
 #include "folly/io/Cursor.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
@@ -166,4 +169,36 @@ class ReadToIOBufs {
   Reader reader_;
 };
 
+/// A read of a contiguous byte range of a file that fills one or more of the
+/// buffers of a preadv. The buffers with null data are gaps that are read and
+/// dropped.
+struct RangeRead {
+  uint64_t offset;
+  uint64_t length{0};
+  std::vector<folly::Range<char*>> buffers;
+};
+
+/// Groups the non-gap ranges of the preadv of 'buffers' at 'offset' into
+/// RangeReads. Gaps of up to 'maxCoalesceGap' bytes between ranges are read
+/// through. Leading and trailing gaps are not read.
+std::vector<RangeRead> planRangeReads(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t maxCoalesceGap);
+
+/// Copies the bytes of 'read' in 'data' to its buffers.
+void scatterRangeRead(const RangeRead& read, const char* data);
+
+/// Reads each of 'reads' by a task on 'executor'. 'readRange(offset, length,
+/// position)' synchronously reads 'length' bytes at 'offset' into 'position'.
+/// A read that fills a single buffer reads directly into it, one that spans
+/// gaps goes through a staging buffer. The returned future is realized with
+/// 'length' after all reads have finished, so that no task writes into the
+/// buffers after that, or with the first error.
+folly::SemiFuture<uint64_t> readRangesAsync(
+    std::vector<RangeRead> reads,
+    uint64_t length,
+    folly::Executor* executor,
+    std::function<void(uint64_t, uint64_t, char*)> readRange);
+
 } // namespace facebook::velox::file::utils
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::filesystems;
+
+TEST(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(10, 60'000);
+  ASSERT_TRUE(cache.enabled());
+  ASSERT_FALSE(cache.get("s3://bucket/a").has_value());
+  cache.put("s3://bucket/a", {100, "etag-a"});
+  auto metadata = cache.get("s3://bucket/a");
+  ASSERT_TRUE(metadata.has_value());
+  ASSERT_EQ(metadata->size, 100);
+  ASSERT_EQ(metadata->etag, "etag-a");
+
+  FileOptions options;
+  ASSERT_EQ(cache.withCachedFileSize("s3://bucket/a", options).fileSize, 100);
+  options.fileSize = 50;
+  ASSERT_EQ(cache.withCachedFileSize("s3://bucket/a", options).fileSize, 50);
+  ASSERT_FALSE(cache.withCachedFileSize("s3://bucket/b", {})
+                   .fileSize.has_value());
+
+  cache.put("s3://bucket/a", {200, ""});
+  ASSERT_EQ(cache.get("s3://bucket/a")->size, 200);
+
+  cache.invalidate("s3://bucket/a");
+  ASSERT_FALSE(cache.get("s3://bucket/a").has_value());
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numHits, 3);
+  ASSERT_EQ(stats.numMisses, 3);
+  ASSERT_EQ(stats.numEntries, 0);
+}
+
+TEST(FileMetadataCacheTest, evict) {
+  FileMetadataCache cache(2, 60'000);
+  cache.put("a", {1, ""});
+  cache.put("b", {2, ""});
+  cache.put("c", {3, ""});
+  ASSERT_FALSE(cache.get("a").has_value());
+  ASSERT_EQ(cache.get("b")->size, 2);
+  ASSERT_EQ(cache.get("c")->size, 3);
+
+  // Replacing an entry makes it the newest.
+  cache.put("b", {4, ""});
+  cache.put("d", {5, ""});
+  ASSERT_FALSE(cache.get("c").has_value());
+  ASSERT_EQ(cache.get("b")->size, 4);
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numEvicted, 2);
+  ASSERT_EQ(stats.numEntries, 2);
+
+  cache.clear();
+  ASSERT_EQ(cache.stats().numEntries, 0);
+}
+
+TEST(FileMetadataCacheTest, expire) {
+  FileMetadataCache cache(10, 10);
+  cache.put("a", {1, ""});
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_FALSE(cache.get("a").has_value());
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numExpired, 1);
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numEntries, 0);
+}
+
+TEST(FileMetadataCacheTest, disabled) {
+  for (const auto& [maxEntries, ttlMs] :
+       std::vector<std::pair<size_t, uint64_t>>{{0, 60'000}, {10, 0}}) {
+    FileMetadataCache cache(maxEntries, ttlMs);
+    ASSERT_FALSE(cache.enabled());
+    cache.put("a", {1, ""});
+    ASSERT_FALSE(cache.get("a").has_value());
+    ASSERT_EQ(cache.stats().numEntries, 0);
+  }
+}
@@ -25,6 +25,8 @@
 
 #include "gtest/gtest.h"
 
+DECLARE_bool(velox_local_file_io_uring);
+
 using namespace facebook::velox;
 using facebook::velox::common::Region;
 using namespace facebook::velox::tests::utils;
@@ -176,6 +178,43 @@ TEST_P(LocalFileTest, viaRegistry) {
   fs->remove(filename);
 }
 
+TEST_P(LocalFileTest, ioUring) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_local_file_io_uring = true;
+  auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  auto readFile = fs->openFileForRead(filename);
+  readData(readFile.get());
+
+  // Several reads in flight, each with a skipped range. The tail of the last
+  // one is past the end of the file.
+  char heads[3][5];
+  char tails[3][5];
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  for (auto i = 0; i < 3; ++i) {
+    std::vector<folly::Range<char*>> buffers = {
+        folly::Range<char*>(heads[i], sizeof(heads[i])),
+        folly::Range<char*>(nullptr, (char*)(uint64_t)kOneMB),
+        folly::Range<char*>(tails[i], sizeof(tails[i]))};
+    futures.push_back(readFile->preadvAsync(5 * i, buffers));
+  }
+  ASSERT_EQ(std::move(futures[0]).get(), kOneMB + 10);
+  ASSERT_EQ(std::move(futures[1]).get(), kOneMB + 10);
+  ASSERT_EQ(std::move(futures[2]).get(), kOneMB + 5);
+  ASSERT_EQ(std::string_view(heads[0], 5), "aaaaa");
+  ASSERT_EQ(std::string_view(heads[1], 5), "bbbbb");
+  ASSERT_EQ(std::string_view(heads[2], 5), "ccccc");
+  ASSERT_EQ(std::string_view(tails[0], 5), "ccccc");
+  ASSERT_EQ(std::string_view(tails[1], 5), "ddddd");
+}
+
 TEST_P(LocalFileTest, rename) {
   const auto tempFolder = ::exec::test::TempDirectoryPath::create(useFaultyFs_);
   const auto a = fmt::format("{}/a", tempFolder->getPath());
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/Utils.h"
 #include "velox/common/file/tests/TestUtils.h"
 
@@ -289,3 +291,54 @@ INSTANTIATE_TEST_SUITE_P(
     ReadToIOBufsTest,
     ValuesIn(
         std::vector<bool /* Should generated chained IOBuf */>({false, true})));
+
+TEST(RangeReadsTest, planAndRead) {
+  const std::string data = "0123456789abcdefghij";
+  std::string first(2, '\0');
+  std::string second(3, '\0');
+  std::string third(4, '\0');
+  // Reads "23", "567" and "ghij" with gaps of 1 and 8 between them, after a
+  // leading gap of 2.
+  std::vector<folly::Range<char*>> buffers = {
+      {static_cast<char*>(nullptr), 2},
+      {first.data(), 2},
+      {static_cast<char*>(nullptr), 1},
+      {second.data(), 3},
+      {static_cast<char*>(nullptr), 8},
+      {third.data(), 4}};
+
+  auto reads = planRangeReads(0, buffers, 4);
+  ASSERT_EQ(reads.size(), 2);
+  EXPECT_EQ(reads[0].offset, 2);
+  EXPECT_EQ(reads[0].length, 6);
+  EXPECT_EQ(reads[0].buffers.size(), 3);
+  EXPECT_EQ(reads[1].offset, 16);
+  EXPECT_EQ(reads[1].length, 4);
+  EXPECT_EQ(reads[1].buffers.size(), 1);
+  EXPECT_EQ(planRangeReads(0, buffers, 0).size(), 3);
+
+  folly::CPUThreadPoolExecutor executor(2);
+  std::atomic<int32_t> numReads{0};
+  auto readRange = [&](uint64_t offset, uint64_t length, char* position) {
+    ++numReads;
+    memcpy(position, data.data() + offset, length);
+  };
+  EXPECT_EQ(
+      readRangesAsync(std::move(reads), 20, &executor, readRange).get(), 20);
+  EXPECT_EQ(numReads, 2);
+  EXPECT_EQ(first, "23");
+  EXPECT_EQ(second, "567");
+  EXPECT_EQ(third, "ghij");
+
+  reads = planRangeReads(0, buffers, 0);
+  VELOX_ASSERT_THROW(
+      readRangesAsync(
+          std::move(reads),
+          20,
+          &executor,
+          [](uint64_t offset, uint64_t /*length*/, char* /*position*/) {
+            VELOX_CHECK_NE(offset, 5, "Read failed");
+          })
+          .get(),
+      "Read failed");
+}
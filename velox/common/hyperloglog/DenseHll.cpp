@@ -143,6 +143,32 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  // Computes the buckets and values of a batch of hashes in a loop the
+  // compiler vectorizes, then applies them. Once the HLL has seen a few
+  // thousand values, most values do not raise their bucket and are rejected
+  // by one compare with the bucket's delta.
+  constexpr int32_t kBatchSize = 64;
+  uint32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  const int32_t indexShift = 64 - indexBitLength_;
+  const uint64_t stopBit = 1UL << (indexBitLength_ - 1);
+  for (int32_t begin = 0; begin < numHashes; begin += kBatchSize) {
+    const auto size = std::min(kBatchSize, numHashes - begin);
+    const auto* batch = hashes + begin;
+    for (auto i = 0; i < size; ++i) {
+      indices[i] = batch[i] >> indexShift;
+      values[i] = __builtin_clzl((batch[i] << indexBitLength_) | stopBit) + 1;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (values[i] - baseline_ <= getDelta(indices[i])) {
+        continue;
+      }
+      insert(indices[i], values[i]);
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
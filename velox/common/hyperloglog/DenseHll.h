@@ -48,6 +48,9 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Same as calling insertHash() for each of 'numHashes' 'hashes'.
+  void insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
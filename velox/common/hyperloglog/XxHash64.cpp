@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/hyperloglog/XxHash64.h"
+
+#include <xsimd/xsimd.hpp>
+
+namespace facebook::velox::common::hll {
+namespace {
+
+// The XXH64 primes.
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+// XXH64 of an input shorter than 32 bytes with seed 0 starts from kPrime5 plus
+// the length of the input. The steps below follow XXH64_finalize() and
+// XXH64_avalanche() for inputs of exactly 8 and exactly 4 bytes. They are
+// written once for scalars and SIMD batches.
+template <typename T>
+inline T rotateLeft(T value, int32_t bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+template <typename T>
+inline T avalanche(T hash) {
+  hash ^= hash >> 33;
+  hash *= T(kPrime2);
+  hash ^= hash >> 29;
+  hash *= T(kPrime3);
+  hash ^= hash >> 32;
+  return hash;
+}
+
+template <typename T>
+inline T hash8(T value) {
+  T hash = T(kPrime5 + 8);
+  value *= T(kPrime2);
+  value = rotateLeft(value, 31);
+  value *= T(kPrime1);
+  hash ^= value;
+  hash = rotateLeft(hash, 27) * T(kPrime1) + T(kPrime4);
+  return avalanche(hash);
+}
+
+// 'value' holds the 4 byte input zero-extended to 64 bits.
+template <typename T>
+inline T hash4(T value) {
+  T hash = T(kPrime5 + 4);
+  hash ^= value * T(kPrime1);
+  hash = rotateLeft(hash, 23) * T(kPrime2) + T(kPrime3);
+  return avalanche(hash);
+}
+
+using Batch = xsimd::batch<uint64_t>;
+
+} // namespace
+
+void xxHash64(const uint64_t* values, int32_t numValues, uint64_t* hashes) {
+  int32_t i = 0;
+  for (; i + Batch::size <= numValues; i += Batch::size) {
+    hash8(Batch::load_unaligned(values + i)).store_unaligned(hashes + i);
+  }
+  for (; i < numValues; ++i) {
+    hashes[i] = hash8(values[i]);
+  }
+}
+
+void xxHash64(const uint32_t* values, int32_t numValues, uint64_t* hashes) {
+  int32_t i = 0;
+  alignas(Batch::arch_type::alignment()) uint64_t widened[Batch::size];
+  for (; i + Batch::size <= numValues; i += Batch::size) {
+    for (auto j = 0; j < Batch::size; ++j) {
+      widened[j] = values[i + j];
+    }
+    hash4(Batch::load_aligned(widened)).store_unaligned(hashes + i);
+  }
+  for (; i < numValues; ++i) {
+    hashes[i] = hash4<uint64_t>(values[i]);
+  }
+}
+
+} // namespace facebook::velox::common::hll
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::common::hll {
+
+/// Sets 'hashes[i]' to XXH64(&values[i], sizeof(uint64_t), 0) for 'numValues'
+/// values. Hashes several values at a time in SIMD lanes.
+void xxHash64(const uint64_t* values, int32_t numValues, uint64_t* hashes);
+
+/// Sets 'hashes[i]' to XXH64(&values[i], sizeof(uint32_t), 0) for 'numValues'
+/// values. Hashes several values at a time in SIMD lanes.
+void xxHash64(const uint32_t* values, int32_t numValues, uint64_t* hashes);
+
+} // namespace facebook::velox::common::hll
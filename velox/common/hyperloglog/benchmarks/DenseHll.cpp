@@ -16,6 +16,7 @@
 #include "velox/common/hyperloglog/DenseHll.h"
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
+#include "velox/common/hyperloglog/XxHash64.h"
 #include "velox/common/memory/HashStringAllocator.h"
 
 #define XXH_INLINE_ALL
@@ -45,6 +46,10 @@ class DenseHllBenchmark {
     }
   }
 
+  memory::MemoryPool* pool() const {
+    return pool_;
+  }
+
   void run(int hashBits) {
     folly::BenchmarkSuspender suspender;
 
@@ -88,6 +93,41 @@ class DenseHllBenchmark {
 
 std::unique_ptr<DenseHllBenchmark> benchmark;
 
+// Compares hashing and inserting 1M values one at a time with batched SIMD
+// hashing and DenseHll::insertHashes().
+constexpr int32_t kNumValues = 1 << 20;
+constexpr int32_t kBatchSize = 1'024;
+
+BENCHMARK(insertHash) {
+  folly::BenchmarkSuspender suspender;
+  HashStringAllocator allocator(benchmark->pool());
+  common::hll::DenseHll hll(11, &allocator);
+  suspender.dismiss();
+
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    hll.insertHash(hashOne(i));
+  }
+  folly::doNotOptimizeAway(hll.cardinality());
+}
+
+BENCHMARK_RELATIVE(insertHashes) {
+  folly::BenchmarkSuspender suspender;
+  HashStringAllocator allocator(benchmark->pool());
+  common::hll::DenseHll hll(11, &allocator);
+  std::vector<uint64_t> values(kBatchSize);
+  std::vector<uint64_t> hashes(kBatchSize);
+  suspender.dismiss();
+
+  for (int64_t i = 0; i < kNumValues; i += kBatchSize) {
+    for (auto j = 0; j < kBatchSize; ++j) {
+      values[j] = i + j;
+    }
+    common::hll::xxHash64(values.data(), kBatchSize, hashes.data());
+    hll.insertHashes(hashes.data(), kBatchSize);
+  }
+  folly::doNotOptimizeAway(hll.cardinality());
+}
+
 BENCHMARK(mergeSerialized11) {
   benchmark->run(11);
 }
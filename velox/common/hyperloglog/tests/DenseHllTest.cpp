@@ -24,6 +24,7 @@
 #include <xxhash.h>
 
 #include "velox/common/encode/Base64.h"
+#include "velox/common/hyperloglog/XxHash64.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::common::hll;
@@ -225,6 +226,52 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  // Values repeat to exercise hashes that do not change any register.
+  std::vector<uint64_t> values;
+  for (auto i = 0; i < 100'000; ++i) {
+    values.push_back(i % 30'000);
+  }
+  std::vector<uint64_t> hashes(values.size());
+  xxHash64(values.data(), values.size(), hashes.data());
+
+  DenseHll expected{indexBitLength, &allocator_};
+  for (auto value : values) {
+    expected.insertHash(hashOne(value));
+  }
+
+  DenseHll hll{indexBitLength, &allocator_};
+  // Inserts in batches of varying size.
+  for (auto i = 0; i < hashes.size();) {
+    auto numHashes = std::min<int32_t>(1 + i % 333, hashes.size() - i);
+    hll.insertHashes(hashes.data() + i, numHashes);
+    i += numHashes;
+  }
+  ASSERT_EQ(serialize(expected), serialize(hll));
+}
+
+TEST(XxHash64Test, matchesXxHash) {
+  std::vector<uint64_t> values64;
+  std::vector<uint32_t> values32;
+  for (auto i = 0; i < 1'001; ++i) {
+    values64.push_back(i * 0x9E3779B97F4A7C15ULL);
+    values32.push_back(i * 0x9E3779B9U);
+  }
+  std::vector<uint64_t> hashes(values64.size());
+
+  xxHash64(values64.data(), values64.size(), hashes.data());
+  for (auto i = 0; i < values64.size(); ++i) {
+    ASSERT_EQ(hashOne(values64[i]), hashes[i]) << i;
+  }
+
+  xxHash64(values32.data(), values32.size(), hashes.data());
+  for (auto i = 0; i < values32.size(); ++i) {
+    ASSERT_EQ(hashOne(values32[i]), hashes[i]) << i;
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
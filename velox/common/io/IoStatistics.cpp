@@ -111,6 +111,14 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  decompressAhead_.merge(other.decompressAhead_);
+  fileTailParse_.merge(other.fileTailParse_);
+  fileTailCacheHit_.merge(other.fileTailCacheHit_);
+  splitPreload_.merge(other.splitPreload_);
+  localStorageRead_.merge(other.localStorageRead_);
+  remoteStorageRead_.merge(other.remoteStorageRead_);
+  adaptiveCoalesceDistance_.merge(other.adaptiveCoalesceDistance_);
+  cancelledPrefetch_.merge(other.cancelledPrefetch_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
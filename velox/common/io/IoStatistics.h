@@ -125,6 +125,38 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& decompressAhead() {
+    return decompressAhead_;
+  }
+
+  IoCounter& fileTailParse() {
+    return fileTailParse_;
+  }
+
+  IoCounter& fileTailCacheHit() {
+    return fileTailCacheHit_;
+  }
+
+  IoCounter& splitPreload() {
+    return splitPreload_;
+  }
+
+  IoCounter& localStorageRead() {
+    return localStorageRead_;
+  }
+
+  IoCounter& remoteStorageRead() {
+    return remoteStorageRead_;
+  }
+
+  IoCounter& adaptiveCoalesceDistance() {
+    return adaptiveCoalesceDistance_;
+  }
+
+  IoCounter& cancelledPrefetch() {
+    return cancelledPrefetch_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -168,6 +200,37 @@ class IoStatistics {
   // or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Time in microseconds spent decompressing streams ahead of their use, on
+  // IO threads or on the query thread if it got to the stream first.
+  IoCounter decompressAhead_;
+
+  // Time in microseconds spent reading and parsing file footers and other
+  // file level metadata.
+  IoCounter fileTailParse_;
+
+  // Footers found in FileTailCache. The sum is the time in microseconds the
+  // hits saved, i.e. the time it took to read and parse them when they were
+  // cached.
+  IoCounter fileTailCacheHit_;
+
+  // Bytes of the first stripe or row group of a preloaded split that were
+  // scheduled for read-ahead against the split preload budget instead of
+  // being read on first use.
+  IoCounter splitPreload_;
+
+  // Bytes read from files that know where their data is stored, e.g. HDFS,
+  // split by whether the data was stored on the local host.
+  IoCounter localStorageRead_;
+  IoCounter remoteStorageRead_;
+
+  // Coalesce distances in bytes chosen by adaptive coalescing, one per batch
+  // of coalesced loads.
+  IoCounter adaptiveCoalesceDistance_;
+
+  // Bytes of planned coalesced loads that were cancelled before their IO
+  // started, e.g. when a scan stopped early because a limit was reached.
+  IoCounter cancelledPrefetch_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::io {
@@ -104,6 +106,15 @@ class ReaderOptions {
     return *this;
   }
 
+  /// If true, the maximum coalesce distance and bytes are chosen from the
+  /// latency and bandwidth observed on the storage of the file and the above
+  /// limits apply only until enough reads have been observed. See
+  /// dwio::common::AdaptiveCoalescer.
+  ReaderOptions& setAdaptiveCoalesce(bool adaptiveCoalesce) {
+    adaptiveCoalesce_ = adaptiveCoalesce;
+    return *this;
+  }
+
   /// Modifies the number of row groups to prefetch.
   ReaderOptions& setPrefetchRowGroups(int32_t numPrefetch) {
     prefetchRowGroups_ = numPrefetch;
@@ -135,6 +146,10 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
+
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
@@ -147,6 +162,44 @@ class ReaderOptions {
     noCacheRetention_ = noCacheRetention;
   }
 
+  /// If true, buffered inputs with an executor decompress the streams they
+  /// return on the executor ahead of their use.
+  ReaderOptions& setDecompressAhead(bool decompressAhead) {
+    decompressAhead_ = decompressAhead;
+    return *this;
+  }
+
+  bool decompressAhead() const {
+    return decompressAhead_;
+  }
+
+  /// Sets the number of bytes that buffered inputs may schedule for read-ahead
+  /// on their executor even if the access history of the streams would have
+  /// them read on first use. Loads deduct their size from 'budget', which is
+  /// shared by all copies of these options. Used to read the first stripe or
+  /// row group of a split in the background while the split is preloaded.
+  ReaderOptions& setPreloadBudget(
+      std::shared_ptr<std::atomic<int64_t>> budget) {
+    preloadBudget_ = std::move(budget);
+    return *this;
+  }
+
+  const std::shared_ptr<std::atomic<int64_t>>& preloadBudget() const {
+    return preloadBudget_;
+  }
+
+  /// If true, the reads only warm the cache for later queries. Cache entries
+  /// loaded with these options are marked so that the first hit on them by
+  /// another reader counts as a cache warm hit.
+  ReaderOptions& setCacheWarm(bool cacheWarm) {
+    cacheWarm_ = cacheWarm;
+    return *this;
+  }
+
+  bool cacheWarm() const {
+    return cacheWarm_;
+  }
+
  protected:
   velox::memory::MemoryPool* memoryPool_;
   uint64_t autoPreloadLength_;
@@ -154,7 +207,11 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  bool adaptiveCoalesce_{false};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool noCacheRetention_{false};
+  bool decompressAhead_{false};
+  std::shared_ptr<std::atomic<int64_t>> preloadBudget_;
+  bool cacheWarm_{false};
 };
 } // namespace facebook::velox::io
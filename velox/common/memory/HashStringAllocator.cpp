@@ -88,6 +88,7 @@ HashStringAllocator::~HashStringAllocator() {
 void HashStringAllocator::clear() {
   numFree_ = 0;
   freeBytes_ = 0;
+  fragmentedBytes_ = 0;
   std::fill(std::begin(freeNonEmpty_), std::end(freeNonEmpty_), 0);
   for (auto& pair : allocationsFromPool_) {
     const auto size = pair.second;
@@ -345,11 +346,27 @@ void HashStringAllocator::removeFromFreeList(Header* header) {
   header->clearFree();
   const auto index = freeListIndex(header->size());
   reinterpret_cast<CompactDoubleList*>(header->begin())->remove();
+  if (header->size() < kMinContiguous) {
+    fragmentedBytes_ -= header->size() + sizeof(Header);
+  }
   if (free_[index].empty()) {
     bits::clearBit(freeNonEmpty_, index);
   }
 }
 
+HashStringAllocator::Header* HashStringAllocator::allocateSizeClass(
+    int32_t size) {
+  const auto classSize = sizeClass(size);
+  const auto index = freeListIndex(classSize);
+  if (bits::isBitSet(freeNonEmpty_, index)) {
+    return allocateFromFreeList(classSize, true, true, index);
+  }
+  if (!free_[kNumFreeLists - 1].empty()) {
+    return allocateFromFreeList(classSize, true, true, kNumFreeLists - 1);
+  }
+  return allocate(classSize, true);
+}
+
 HashStringAllocator::Header* HashStringAllocator::allocate(
     int32_t size,
     bool exactSize) {
@@ -458,6 +475,9 @@ void HashStringAllocator::free(Header* header) {
         ++numFree_;
       }
       const auto freedSize = headerToFree->size();
+      if (freedSize < kMinContiguous) {
+        fragmentedBytes_ += freedSize + sizeof(Header);
+      }
       const auto freeIndex = freeListIndex(freedSize);
       bits::setBit(freeNonEmpty_, freeIndex);
       free_[freeIndex].insert(
@@ -661,6 +681,7 @@ int64_t HashStringAllocator::checkConsistency() const {
 
   uint64_t numFree = 0;
   uint64_t freeBytes = 0;
+  uint64_t fragmentedBytes = 0;
   int64_t allocatedBytes = 0;
   for (auto i = 0; i < pool_.numRanges(); ++i) {
     auto topRange = pool_.rangeAt(i);
@@ -698,6 +719,9 @@ int64_t HashStringAllocator::checkConsistency() const {
           }
           ++numFree;
           freeBytes += sizeof(Header) + header->size();
+          if (header->size() < kMinContiguous) {
+            fragmentedBytes += sizeof(Header) + header->size();
+          }
         } else if (header->isContinued()) {
           // If the content of the header is continued, check the continued
           // header is readable and not free.
@@ -715,6 +739,7 @@ int64_t HashStringAllocator::checkConsistency() const {
 
   VELOX_CHECK_EQ(numFree, numFree_);
   VELOX_CHECK_EQ(freeBytes, freeBytes_);
+  VELOX_CHECK_EQ(fragmentedBytes, fragmentedBytes_);
   uint64_t numInFreeList = 0;
   uint64_t bytesInFreeList = 0;
   for (auto i = 0; i < kNumFreeLists; ++i) {
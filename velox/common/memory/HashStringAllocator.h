@@ -200,11 +200,15 @@ class HashStringAllocator : public StreamArena {
   static StringView contiguousString(StringView view, std::string& storage);
 
   /// Allocates 'size' contiguous bytes preceded by a Header. Returns the
-  /// address of Header.
+  /// address of Header. Sizes up to kMaxSizeClass are rounded up to a size
+  /// class, see allocateSizeClass().
   Header* allocate(int32_t size) {
     VELOX_CHECK_NULL(
         currentHeader_, "Do not call allocate() when a write is in progress");
-    return allocate(std::max(size, kMinAlloc), true);
+    if (size <= kMaxSizeClass) {
+      return allocateSizeClass(size);
+    }
+    return allocate(size, true);
   }
 
   /// Allocates a block that is independently freeable but is freed on
@@ -310,6 +314,14 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  /// Returns the bytes in free blocks smaller than kMinContiguous, including
+  /// their headers. These are free but can only be used by allocations of
+  /// their size or smaller and not as ranges of a write, so a large value
+  /// relative to freeSpace() indicates fragmentation.
+  uint64_t fragmentedBytes() const {
+    return fragmentedBytes_;
+  }
+
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
@@ -343,6 +355,18 @@ class HashStringAllocator : public StreamArena {
   static constexpr int32_t kMinContiguous = 48;
   static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
 
+  // Allocations of up to this many bytes are rounded up to a size class.
+  static constexpr int32_t kMaxSizeClass = 512;
+
+  // Returns the size class for an allocation of 'size' bytes. The classes are
+  // multiples of 8 up to 128 bytes and multiples of 32 above that.
+  static int32_t sizeClass(int32_t size) {
+    if (size <= 128) {
+      return std::max<int32_t>(kMinAlloc, bits::roundUp(size, 8));
+    }
+    return bits::roundUp(size, 32);
+  }
+
   void newRange(
       int32_t bytes,
       ByteRange* lastRange,
@@ -356,6 +380,13 @@ class HashStringAllocator : public StreamArena {
 
   void removeFromFreeList(Header* header);
 
+  // Allocates a block of the size class of 'size'. Takes a free block of
+  // exactly that size if there is one. Otherwise the block is cut from the
+  // front of a block in the largest free list, so that small blocks are packed
+  // together in large pages instead of leaving odd sized remainders in free
+  // blocks of intermediate size. Falls back to allocate(size, true).
+  Header* allocateSizeClass(int32_t size);
+
   // Allocates a block of specified size. If exactSize is false, the block may
   // be smaller or larger. Checks free list before allocating new memory.
   Header* allocate(int32_t size, bool exactSize);
@@ -405,6 +436,10 @@ class HashStringAllocator : public StreamArena {
   // Sum of the size of blocks in 'free_', excluding headers.
   uint64_t freeBytes_ = 0;
 
+  // Sum of the size of blocks in 'free_' smaller than kMinContiguous,
+  // including headers.
+  uint64_t fragmentedBytes_ = 0;
+
   // Counter of allocated bytes. The difference of two point in time values
   // tells how much memory has been consumed by activity between these points in
   // time. Incremented by allocation and decremented by free. Used for tracking
@@ -51,6 +51,9 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.capacity = options.allocatorCapacity;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numNumaNodes = options.numNumaNodes;
+    mmapOptions.adviseHighWatermarkPct = options.mmapAdviseHighWatermarkPct;
+    mmapOptions.adviseLowWatermarkPct = options.mmapAdviseLowWatermarkPct;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -99,6 +102,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      poolReservationCacheBytes_(options.poolReservationCacheBytes),
+      poolTraceListener_(options.poolTraceListener),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -119,7 +124,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .reservationCacheBytes = options.poolReservationCacheBytes})},
       spillPool_{addLeafPool("__sys_spilling__")},
       sharedLeafPools_(createSharedLeafMemoryPools(*sysRoot_)) {
   VELOX_CHECK_NOT_NULL(allocator_);
@@ -226,6 +232,8 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.reservationCacheBytes = poolReservationCacheBytes_;
+  options.traceListener = poolTraceListener_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
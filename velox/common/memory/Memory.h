@@ -81,6 +81,12 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// Specifies the max bytes of the unused reservation cached per thread slot
+  /// by the thread-safe leaf memory pools to account small allocations
+  /// without taking the pool lock. Zero disables the reservation cache. See
+  /// MemoryPool::Options::reservationCacheBytes for details.
+  int64_t poolReservationCacheBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -105,6 +111,20 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If greater than 1, MmapAllocator keeps separate size classes per NUMA node
+  /// and serves allocations from the node of the allocating thread.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t numNumaNodes{1};
+
+  /// If not zero, MmapAllocator advises away the free size class pages in a
+  /// background thread once they exceed this percent of the capacity, down to
+  /// 'mmapAdviseLowWatermarkPct'. See MmapAllocator::Options for details.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  uint32_t mmapAdviseHighWatermarkPct{0};
+  uint32_t mmapAdviseLowWatermarkPct{0};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -188,6 +208,11 @@ struct MemoryManagerOptions {
   /// potential deadlock when reclaim memory from the task of the request memory
   /// pool.
   MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
+
+  /// If not null, notified of the reservation changes of the root memory pools
+  /// created by addRootPool(), e.g. to record a trace for offline replay with
+  /// MemoryPoolTracer.
+  std::shared_ptr<MemoryPoolTraceListener> poolTraceListener{nullptr};
 };
 
 /// 'MemoryManager' is responsible for creating allocator, arbitrator and
@@ -315,6 +340,10 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t poolReservationCacheBytes_;
+  // If not null, set as the trace listener of the root memory pools created by
+  // addRootPool().
+  const std::shared_ptr<MemoryPoolTraceListener> poolTraceListener_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
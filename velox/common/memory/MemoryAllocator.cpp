@@ -358,6 +358,13 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numRemoteNumaFrees = numRemoteNumaFrees - other.numRemoteNumaFrees;
+  result.backgroundAdvisedBytes =
+      backgroundAdvisedBytes - other.backgroundAdvisedBytes;
+  // Gauges, not cumulative counts.
+  result.hugePageBytes = hugePageBytes;
+  result.smallPageBytes = smallPageBytes;
+  result.deferredAdviseBytes = deferredAdviseBytes;
   return result;
 }
 
@@ -417,10 +424,19 @@ void MemoryAllocator::useHugePages(
   if (rc != 0) {
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
+    return;
   }
+  const int64_t bytes = maybeRange.value().size();
+  numHugePageBytes_ += enable ? bytes : -bytes;
 #endif
 }
 
+void MemoryAllocator::setPageBytes(Stats& stats) const {
+  stats.hugePageBytes = numHugePageBytes_;
+  stats.smallPageBytes = std::max<int64_t>(
+      0, static_cast<int64_t>(totalUsedBytes()) - stats.hugePageBytes);
+}
+
 void MemoryAllocator::setAllocatorFailureMessage(std::string message) {
   allocatorFailureMessage() = std::move(message);
 }
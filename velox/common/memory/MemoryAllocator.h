@@ -136,6 +136,26 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Cumulative count of pages freed on another NUMA node than the one they
+  /// were allocated on, if the allocator is NUMA aware. A high count means
+  /// that memory is mostly accessed from remote nodes.
+  int64_t numRemoteNumaFrees{0};
+
+  /// Bytes of contiguous allocations that are currently advised to be backed
+  /// by huge pages, see FLAGS_velox_memory_use_hugepages.
+  int64_t hugePageBytes{0};
+
+  /// Bytes in use that are not advised to be backed by huge pages.
+  int64_t smallPageBytes{0};
+
+  /// Bytes of free pages which are still backed by memory, i.e. whose advise
+  /// away is deferred, if the allocator exposes this.
+  int64_t deferredAdviseBytes{0};
+
+  /// Cumulative bytes of free pages advised away by a background thread of the
+  /// allocator off the allocation path.
+  int64_t backgroundAdvisedBytes{0};
 };
 
 class MemoryAllocator;
@@ -342,7 +362,9 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   virtual MachinePageCount numMapped() const = 0;
 
   virtual Stats stats() const {
-    return stats_;
+    auto stats = stats_;
+    setPageBytes(stats);
+    return stats;
   }
 
   virtual std::string toString() const = 0;
@@ -480,6 +502,9 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // for the address range.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Sets the huge and small page bytes of 'stats'.
+  void setPageBytes(Stats& stats) const;
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
@@ -498,6 +523,9 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // system by 'this' (via madvise calls).
   std::atomic<MachinePageCount> numMapped_{0};
 
+  // Bytes of the ranges advised to be backed by huge pages by useHugePages().
+  std::atomic<int64_t> numHugePageBytes_{0};
+
   // Indicates if the failure injection is persistent or transient.
   //
   // NOTE: this is only used for testing purpose.
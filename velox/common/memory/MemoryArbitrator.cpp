@@ -16,6 +16,7 @@
 
 #include "velox/common/memory/MemoryArbitrator.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "velox/common/base/Counters.h"
@@ -174,6 +175,35 @@ void MemoryArbitrator::unregisterFactory(const std::string& kind) {
   return pool->shrink(targetBytes);
 }
 
+std::string arbitrationPriorityName(ArbitrationPriority priority) {
+  switch (priority) {
+    case ArbitrationPriority::kLow:
+      return "LOW";
+    case ArbitrationPriority::kNormal:
+      return "NORMAL";
+    case ArbitrationPriority::kHigh:
+      return "HIGH";
+    default:
+      return fmt::format("UNKNOWN: {}", static_cast<int32_t>(priority));
+  }
+}
+
+ArbitrationPriority arbitrationPriorityFromName(const std::string& name) {
+  std::string upperName = name;
+  std::transform(
+      upperName.begin(), upperName.end(), upperName.begin(), ::toupper);
+  if (upperName == "LOW") {
+    return ArbitrationPriority::kLow;
+  }
+  if (upperName == "NORMAL") {
+    return ArbitrationPriority::kNormal;
+  }
+  if (upperName == "HIGH") {
+    return ArbitrationPriority::kHigh;
+  }
+  VELOX_USER_FAIL("Unknown arbitration priority: {}", name);
+}
+
 std::unique_ptr<MemoryReclaimer> MemoryReclaimer::create() {
   return std::unique_ptr<MemoryReclaimer>(new MemoryReclaimer());
 }
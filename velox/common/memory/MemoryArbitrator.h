@@ -292,6 +292,22 @@ FOLLY_ALWAYS_INLINE std::ostream& operator<<(
   return o << stats.toString();
 }
 
+/// The priority classes of queries in memory arbitration. The arbitrator
+/// reclaims memory from lower priority queries first, and aborts a higher
+/// priority query only if there is no lower priority one left to abort.
+enum class ArbitrationPriority : int32_t {
+  kLow = 0,
+  kNormal = 1,
+  kHigh = 2,
+};
+
+/// Returns the name of 'priority', e.g. "LOW".
+std::string arbitrationPriorityName(ArbitrationPriority priority);
+
+/// Returns the priority class of 'name', e.g. "low". The match is case
+/// insensitive. Throws for an unknown name.
+ArbitrationPriority arbitrationPriorityFromName(const std::string& name);
+
 /// The memory reclaimer interface is used by memory pool to participate in
 /// the memory arbitration execution (enter/leave arbitration process) as well
 /// as reclaim memory from the associated query object. We have default
@@ -382,6 +398,13 @@ class MemoryReclaimer {
       uint64_t maxWaitMs,
       Stats& stats);
 
+  /// Returns the priority class of the query of this reclaimer's pool. The
+  /// memory arbitrator only uses the priority of a root memory pool's
+  /// reclaimer.
+  virtual ArbitrationPriority priority() const {
+    return ArbitrationPriority::kNormal;
+  }
+
   /// Invoked by the memory arbitrator to abort memory 'pool' and the associated
   /// query execution when encounters non-recoverable memory reclaim error or
   /// fails to reclaim enough free capacity. The abort is a synchronous
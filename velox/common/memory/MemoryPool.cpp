@@ -421,16 +421,26 @@ MemoryPoolImpl::MemoryPoolImpl(
       allocator_{manager_->allocator()},
       growCapacityCb_(std::move(growCapacityCb)),
       destructionCb_(std::move(destructionCb)),
+      traceListener_(parent_ == nullptr ? options.traceListener : nullptr),
       debugPoolNameRegex_(debugEnabled_ ? *(debugPoolNameRegex().rlock()) : ""),
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
       // actually used memory arbitration policy.
-      capacity_(parent_ != nullptr ? kMaxMemory : 0) {
+      capacity_(parent_ != nullptr ? kMaxMemory : 0),
+      reservationCacheBytes_(options.reservationCacheBytes) {
   VELOX_CHECK(options.threadSafe || isLeaf());
+  VELOX_CHECK_GE(reservationCacheBytes_, 0);
+  if (isLeaf() && threadSafe_ && trackUsage_ && reservationCacheBytes_ > 0) {
+    reservationCache_ =
+        std::make_unique<ReservationCacheSlot[]>(kNumReservationCacheSlots);
+  }
   VELOX_CHECK(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
       name_);
+  if (traceListener_ != nullptr) {
+    traceListener_->onCreate(*this);
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
@@ -440,6 +450,14 @@ MemoryPoolImpl::~MemoryPoolImpl() {
   }
 
   if (isLeaf()) {
+    if (reservationCache_ != nullptr) {
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        flushReservationCacheLocked();
+      }
+      releaseThreadSafe(0, false);
+    }
+
     if (usedReservationBytes_ > 0) {
       VELOX_MEM_LOG(ERROR) << "Memory leak (Used memory): " << toString();
       RECORD_METRIC_VALUE(
@@ -463,6 +481,10 @@ MemoryPoolImpl::~MemoryPoolImpl() {
         kMetricMemoryPoolCapacityGrowCount, numCapacityGrowths_);
   }
 
+  if (traceListener_ != nullptr) {
+    traceListener_->onDestroy(*this);
+  }
+
   if (destructionCb_ != nullptr) {
     destructionCb_(this);
   }
@@ -479,6 +501,12 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
   stats.reservedBytes = reservationBytes_;
   stats.peakBytes = peakBytes_;
   stats.cumulativeBytes = cumulativeBytes_;
+  if (reservationCache_ != nullptr) {
+    for (size_t i = 0; i < kNumReservationCacheSlots; ++i) {
+      stats.cumulativeBytes +=
+          reservationCache_[i].cumulativeBytes.load(std::memory_order_relaxed);
+    }
+  }
   stats.numAllocs = numAllocs_;
   stats.numFrees = numFrees_;
   stats.numReserves = numReserves_;
@@ -690,7 +718,13 @@ int64_t MemoryPoolImpl::capacity() const {
 
 int64_t MemoryPoolImpl::usedBytes() const {
   if (isLeaf()) {
-    return usedReservationBytes_;
+    if (reservationCache_ == nullptr) {
+      return usedReservationBytes_;
+    }
+    // NOTE: the cached bytes are read without holding 'mutex_' and might be
+    // updated concurrently.
+    return std::max<int64_t>(
+        0, usedReservationBytes_ - cachedReservationBytes());
   }
   if (reservedBytes() == 0) {
     return 0;
@@ -707,7 +741,9 @@ int64_t MemoryPoolImpl::releasableReservation() const {
   if (isLeaf()) {
     std::lock_guard<std::mutex> l(mutex_);
     return std::max<int64_t>(
-        0, reservationBytes_ - quantizedSize(usedReservationBytes_));
+        0,
+        reservationBytes_ -
+            quantizedSize(usedReservationBytes_ - cachedReservationBytes()));
   }
   if (reservedBytes() == 0) {
     return 0;
@@ -739,7 +775,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .reservationCacheBytes = reservationCacheBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -780,19 +817,30 @@ void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
 void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   VELOX_CHECK(isLeaf());
 
+  if (reservationCache_ != nullptr && !reserveOnly && tryReserveCached(size)) {
+    return;
+  }
+
   int32_t numAttempts = 0;
   int64_t increment = 0;
   for (;; ++numAttempts) {
     {
       std::lock_guard<std::mutex> l(mutex_);
       increment = reservationSizeLocked(size);
+      if (increment != 0 && flushReservationCacheLocked() != 0) {
+        // Reuse the reservation cached by the other threads before growing
+        // the reservation from the parent.
+        increment = reservationSizeLocked(size);
+      }
       if (increment == 0) {
         if (reserveOnly) {
           minReservationBytes_ = tsanAtomicValue(reservationBytes_);
         } else {
           usedReservationBytes_ += size;
           cumulativeBytes_ += size;
-          maybeUpdatePeakBytesLocked(usedReservationBytes_);
+          maybeUpdatePeakBytesLocked(
+              usedReservationBytes_ - cachedReservationBytes());
+          refillReservationCacheLocked();
         }
         sanityCheckLocked();
         break;
@@ -821,6 +869,71 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
   }
 }
 
+bool MemoryPoolImpl::tryReserveCached(uint64_t size) {
+  auto& slot = reservationCacheSlot();
+  int64_t cached = slot.bytes.load(std::memory_order_relaxed);
+  while (cached >= static_cast<int64_t>(size)) {
+    if (slot.bytes.compare_exchange_weak(
+            cached, cached - size, std::memory_order_relaxed)) {
+      slot.cumulativeBytes.fetch_add(size, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MemoryPoolImpl::tryReleaseCached(uint64_t size) {
+  auto& slot = reservationCacheSlot();
+  int64_t cached = slot.bytes.load(std::memory_order_relaxed);
+  while (cached + static_cast<int64_t>(size) <= reservationCacheBytes_) {
+    if (slot.bytes.compare_exchange_weak(
+            cached, cached + size, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MemoryPoolImpl::refillReservationCacheLocked() {
+  if (reservationCache_ == nullptr) {
+    return;
+  }
+  auto& slot = reservationCacheSlot();
+  // Only carve the refill out of the already reserved bytes so that caching
+  // never grows the reservation from the parent.
+  const int64_t refill = std::min<int64_t>(
+      reservationCacheBytes_ - slot.bytes.load(std::memory_order_relaxed),
+      availableReservationLocked());
+  if (refill <= 0) {
+    return;
+  }
+  usedReservationBytes_ += refill;
+  slot.bytes.fetch_add(refill, std::memory_order_relaxed);
+}
+
+int64_t MemoryPoolImpl::flushReservationCacheLocked() {
+  if (reservationCache_ == nullptr) {
+    return 0;
+  }
+  int64_t flushedBytes{0};
+  for (size_t i = 0; i < kNumReservationCacheSlots; ++i) {
+    flushedBytes += reservationCache_[i].bytes.exchange(0);
+  }
+  usedReservationBytes_ -= flushedBytes;
+  return flushedBytes;
+}
+
+int64_t MemoryPoolImpl::cachedReservationBytes() const {
+  if (reservationCache_ == nullptr) {
+    return 0;
+  }
+  int64_t cachedBytes{0};
+  for (size_t i = 0; i < kNumReservationCacheSlots; ++i) {
+    cachedBytes += reservationCache_[i].bytes.load(std::memory_order_relaxed);
+  }
+  return cachedBytes;
+}
+
 bool MemoryPoolImpl::incrementReservationThreadSafe(
     MemoryPool* requestor,
     uint64_t size) {
@@ -888,6 +1001,9 @@ void MemoryPoolImpl::incrementReservationLocked(uint64_t bytes) {
     cumulativeBytes_ += bytes;
     maybeUpdatePeakBytesLocked(reservationBytes_);
   }
+  if (traceListener_ != nullptr) {
+    traceListener_->onReservation(*this, bytes);
+  }
 }
 
 void MemoryPoolImpl::release() {
@@ -909,13 +1025,20 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   VELOX_CHECK(isLeaf());
   VELOX_DCHECK_NOT_NULL(parent_);
 
+  // NOTE: a zero 'size' release is used to free up the unused reservation so
+  // it always goes through the locked path.
+  if (reservationCache_ != nullptr && size != 0 && tryReleaseCached(size)) {
+    return;
+  }
+
   int64_t freeable = 0;
   {
     std::lock_guard<std::mutex> l(mutex_);
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      const auto flushedBytes = flushReservationCacheLocked();
+      if (minReservationBytes_ == 0 && flushedBytes == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -946,6 +1069,9 @@ void MemoryPoolImpl::decrementReservation(uint64_t size) noexcept {
   std::lock_guard<std::mutex> l(mutex_);
   reservationBytes_ -= size;
   sanityCheckLocked();
+  if (traceListener_ != nullptr) {
+    traceListener_->onReservation(*this, -static_cast<int64_t>(size));
+  }
 }
 
 std::string MemoryPoolImpl::treeMemoryUsage(bool skipEmptyPool) const {
@@ -21,8 +21,10 @@
 #include <memory>
 #include <optional>
 #include <queue>
+#include <thread>
 
 #include <fmt/format.h>
+#include <folly/lang/Align.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -30,6 +32,7 @@
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/MemoryPoolTracer.h"
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
@@ -160,6 +163,18 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If positive, a thread-safe leaf memory pool keeps up to this many bytes
+    /// of its unused reservation cached per thread slot so that small
+    /// allocations and frees from concurrent threads can be accounted without
+    /// taking the pool mutex. The cached bytes are counted as used reservation
+    /// until they are flushed back on release() or before the pool grows its
+    /// reservation. Zero disables the cache.
+    int64_t reservationCacheBytes{0};
+
+    /// If not null, notified of the reservation changes of this memory pool.
+    /// Only applies to the root memory pool.
+    std::shared_ptr<MemoryPoolTraceListener> traceListener{nullptr};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -823,6 +838,34 @@ class MemoryPoolImpl : public MemoryPool {
 
   void reserveThreadSafe(uint64_t size, bool reserveOnly = false);
 
+  // Tries to account an allocation of 'size' bytes against the reservation
+  // cached in the calling thread's slot of 'reservationCache_' without holding
+  // 'mutex_'. Returns false if the slot doesn't cache enough bytes.
+  bool tryReserveCached(uint64_t size);
+
+  // Tries to return a free of 'size' bytes to the calling thread's slot of
+  // 'reservationCache_' without holding 'mutex_'. Returns false if the slot
+  // would cache more than 'reservationCacheBytes_'.
+  bool tryReleaseCached(uint64_t size);
+
+  // Moves up to 'reservationCacheBytes_' of the unused reservation into the
+  // calling thread's slot. The moved bytes are accounted as used reservation.
+  void refillReservationCacheLocked();
+
+  // Returns the bytes cached by all the slots to the unused reservation and
+  // returns the number of returned bytes.
+  int64_t flushReservationCacheLocked();
+
+  // Returns the number of bytes cached by all the slots.
+  int64_t cachedReservationBytes() const;
+
+  // Returns the calling thread's slot in 'reservationCache_'.
+  FOLLY_ALWAYS_INLINE auto& reservationCacheSlot() {
+    const size_t hash =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return reservationCache_[hash & (kNumReservationCacheSlots - 1)];
+  }
+
   // Increments the reservation and checks against limits at root tracker. Calls
   // root tracker's 'growCallback_' if it is set and limit exceeded. Should be
   // called without holding 'mutex_'. This function returns true if reservation
@@ -1005,6 +1048,9 @@ class MemoryPoolImpl : public MemoryPool {
   MemoryAllocator* const allocator_;
   const GrowCapacityCallback growCapacityCb_;
   const DestructionCallback destructionCb_;
+  // If not null, notified of the reservation changes of this root memory
+  // pool.
+  const std::shared_ptr<MemoryPoolTraceListener> traceListener_;
 
   // Regex for filtering on 'name_' when debug mode is enabled. This allows us
   // to only track the callsites of memory allocations for memory pools whose
@@ -1042,6 +1088,30 @@ class MemoryPoolImpl : public MemoryPool {
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
+  // The number of slots in 'reservationCache_'. A thread picks its slot by the
+  // hash of its thread id.
+  static constexpr size_t kNumReservationCacheSlots{32};
+
+  struct alignas(folly::hardware_destructive_interference_size)
+      ReservationCacheSlot {
+    // The bytes accounted in 'usedReservationBytes_' but not used by any
+    // allocation yet.
+    std::atomic<int64_t> bytes{0};
+    // The bytes allocated from 'bytes' which are added to 'cumulativeBytes_'
+    // in the reported stats.
+    std::atomic<int64_t> cumulativeBytes{0};
+  };
+
+  // The max number of bytes cached by each slot of 'reservationCache_'.
+  const int64_t reservationCacheBytes_;
+
+  // The per-thread reservation cache of a thread-safe leaf memory pool which
+  // serves the small allocations and frees without holding 'mutex_'. Null if
+  // 'reservationCacheBytes_' is zero. The peak usage is only updated on the
+  // reservations made under 'mutex_' so it might lag behind by the cached
+  // bytes.
+  std::unique_ptr<ReservationCacheSlot[]> reservationCache_;
+
   // Stats counters.
   // The number of memory allocations.
   std::atomic_uint64_t numAllocs_{0};
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/memory/MemoryPoolTracer.h"
+
+#include <cinttypes>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::memory {
+
+std::string MemoryPoolTracer::Event::toString() const {
+  // The pool name goes last as it may contain spaces.
+  return fmt::format(
+      "{} {} {} {}", static_cast<char>(type), timeUs, bytes, pool);
+}
+
+MemoryPoolTracer::MemoryPoolTracer() : startTimeUs_(getCurrentTimeMicro()) {}
+
+void MemoryPoolTracer::onCreate(const MemoryPool& pool) {
+  record(Event::Type::kCreate, pool, 0);
+}
+
+void MemoryPoolTracer::onReservation(const MemoryPool& pool, int64_t bytes) {
+  record(Event::Type::kReservation, pool, bytes);
+}
+
+void MemoryPoolTracer::onDestroy(const MemoryPool& pool) {
+  record(Event::Type::kDestroy, pool, 0);
+}
+
+void MemoryPoolTracer::record(
+    Event::Type type,
+    const MemoryPool& pool,
+    int64_t bytes) {
+  const uint64_t nowUs = getCurrentTimeMicro();
+  std::lock_guard<std::mutex> l(mutex_);
+  events_.push_back(
+      Event{type, nowUs - std::min(nowUs, startTimeUs_), pool.name(), bytes});
+}
+
+std::vector<MemoryPoolTracer::Event> MemoryPoolTracer::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return events_;
+}
+
+void MemoryPoolTracer::write(const std::string& path) const {
+  const auto events = this->events();
+  std::ofstream out(path);
+  VELOX_CHECK(out.good(), "Failed to open memory pool trace file {}", path);
+  for (const auto& event : events) {
+    out << event.toString() << "\n";
+  }
+  out.close();
+  VELOX_CHECK(!out.fail(), "Failed to write memory pool trace file {}", path);
+}
+
+std::vector<MemoryPoolTracer::Event> MemoryPoolTracer::read(
+    const std::string& path) {
+  std::ifstream in(path);
+  VELOX_USER_CHECK(in.good(), "Failed to open memory pool trace file {}", path);
+  std::vector<Event> events;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    char type;
+    uint64_t timeUs;
+    int64_t bytes;
+    int nameOffset{0};
+    VELOX_USER_CHECK_EQ(
+        std::sscanf(
+            line.c_str(),
+            "%c %" SCNu64 " %" SCNd64 " %n",
+            &type,
+            &timeUs,
+            &bytes,
+            &nameOffset),
+        3,
+        "Bad memory pool trace line: {}",
+        line);
+    VELOX_USER_CHECK(
+        type == static_cast<char>(Event::Type::kCreate) ||
+            type == static_cast<char>(Event::Type::kReservation) ||
+            type == static_cast<char>(Event::Type::kDestroy),
+        "Bad memory pool trace event type: {}",
+        line);
+    VELOX_USER_CHECK_LT(
+        static_cast<size_t>(nameOffset),
+        line.size(),
+        "Missing pool name in memory pool trace line: {}",
+        line);
+    events.push_back(Event{
+        static_cast<Event::Type>(type),
+        timeUs,
+        line.substr(nameOffset),
+        bytes});
+  }
+  return events;
+}
+
+} // namespace facebook::velox::memory
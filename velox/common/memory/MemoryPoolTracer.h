@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::memory {
+
+class MemoryPool;
+
+/// Optional listener of the reservation changes of the root memory pools. It
+/// is set through MemoryManagerOptions::poolTraceListener and only invoked for
+/// the root pools created by MemoryManager::addRootPool(). The callbacks are
+/// invoked on the memory reservation path, some of them with the pool's mutex
+/// held, so that an implementation must be cheap and must not call back into
+/// the memory pool.
+class MemoryPoolTraceListener {
+ public:
+  virtual ~MemoryPoolTraceListener() = default;
+
+  /// Invoked on the creation of root memory 'pool'.
+  virtual void onCreate(const MemoryPool& pool) = 0;
+
+  /// Invoked after the reservation of root memory 'pool' has changed by
+  /// 'bytes'. 'bytes' is negative on a release.
+  virtual void onReservation(const MemoryPool& pool, int64_t bytes) = 0;
+
+  /// Invoked on the destruction of root memory 'pool'.
+  virtual void onDestroy(const MemoryPool& pool) = 0;
+};
+
+/// Records the reservation changes of the root memory pools as a trace which
+/// can be saved to a file and replayed offline against different memory
+/// arbitration configurations, e.g. by the memory arbitration replay
+/// benchmark.
+class MemoryPoolTracer : public MemoryPoolTraceListener {
+ public:
+  struct Event {
+    enum class Type : char {
+      kCreate = 'C',
+      kReservation = 'R',
+      kDestroy = 'D',
+    };
+
+    Type type;
+    /// The time of the event in microseconds since the creation of the tracer.
+    uint64_t timeUs;
+    /// The name of the root memory pool.
+    std::string pool;
+    /// The reservation change in bytes. Only set for kReservation.
+    int64_t bytes{0};
+
+    bool operator==(const Event& other) const {
+      return type == other.type && timeUs == other.timeUs &&
+          pool == other.pool && bytes == other.bytes;
+    }
+
+    std::string toString() const;
+  };
+
+  MemoryPoolTracer();
+
+  void onCreate(const MemoryPool& pool) override;
+
+  void onReservation(const MemoryPool& pool, int64_t bytes) override;
+
+  void onDestroy(const MemoryPool& pool) override;
+
+  /// Returns the recorded events in the order they happened.
+  std::vector<Event> events() const;
+
+  /// Writes the recorded events to 'path', one event per line.
+  void write(const std::string& path) const;
+
+  /// Reads the events written by write() from 'path'.
+  static std::vector<Event> read(const std::string& path);
+
+ private:
+  void record(Event::Type type, const MemoryPool& pool, int64_t bytes);
+
+  const uint64_t startTimeUs_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+};
+
+} // namespace facebook::velox::memory
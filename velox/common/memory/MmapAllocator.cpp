@@ -17,15 +17,78 @@
 #include "velox/common/memory/MmapAllocator.h"
 
 #include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
 
+DECLARE_bool(velox_memory_use_hugepages);
+
 namespace facebook::velox::memory {
+namespace {
+// Makes the pages of [address, address + bytes) prefer the memory of
+// 'numaNode' when they are first touched. This is best effort and a no-op on
+// systems without NUMA support.
+void preferNumaNode(void* address, size_t bytes, int32_t numaNode) {
+#ifdef __linux__
+  // MPOL_PREFERRED from <numaif.h>, which comes with libnuma.
+  constexpr int32_t kPreferredPolicy = 1;
+  uint64_t nodeMask = 1UL << numaNode;
+  if (syscall(
+          SYS_mbind,
+          address,
+          bytes,
+          kPreferredPolicy,
+          &nodeMask,
+          sizeof(nodeMask) * 8,
+          0) != 0) {
+    VELOX_MEM_LOG_EVERY_MS(WARNING, 1000)
+        << "mbind to NUMA node " << numaNode
+        << " failed: " << folly::errnoStr(errno);
+  }
+#endif
+}
+
+// Maps 'bytes' at an address aligned to the huge page size, so that all of the
+// range and not only its aligned interior can be backed by huge pages. Returns
+// MAP_FAILED on failure.
+void* mmapHugePageAligned(size_t bytes) {
+  constexpr auto kHugePageSize = AllocationTraits::kHugePageSize;
+  const auto mapBytes = bytes + kHugePageSize;
+  void* ptr = ::mmap(
+      nullptr,
+      mapBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (ptr == MAP_FAILED) {
+    return ptr;
+  }
+  const auto begin = reinterpret_cast<uintptr_t>(ptr);
+  const auto alignedBegin = bits::roundUp(begin, kHugePageSize);
+  const auto alignedEnd = alignedBegin + bytes;
+  // Unmaps the unaligned head and the tail past 'bytes', so that the mapping
+  // is freed with a single munmap of 'bytes' like a plain mmap.
+  if (alignedBegin > begin) {
+    ::munmap(ptr, alignedBegin - begin);
+  }
+  if (begin + mapBytes > alignedEnd) {
+    ::munmap(
+        reinterpret_cast<void*>(alignedEnd), begin + mapBytes - alignedEnd);
+  }
+  return reinterpret_cast<void*>(alignedBegin);
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
+      numNumaNodes_(options.numNumaNodes),
       useMmapArena_(options.useMmapArena),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
@@ -34,9 +97,20 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      adviseHighWatermarkPages_(
+          capacity_ * options.adviseHighWatermarkPct / 100),
+      adviseLowWatermarkPages_(capacity_ * options.adviseLowWatermarkPct / 100),
+      adviseInterval_(options.adviseIntervalMs) {
+  VELOX_CHECK_GE(numNumaNodes_, 1);
+  VELOX_CHECK_LE(numNumaNodes_, 64);
+  VELOX_CHECK_LE(options.adviseHighWatermarkPct, 100);
+  VELOX_CHECK_LE(options.adviseLowWatermarkPct, options.adviseHighWatermarkPct);
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : kNoNumaNode));
+    }
   }
 
   if (useMmapArena_) {
@@ -46,9 +120,21 @@ MmapAllocator::MmapAllocator(const Options& options)
     managedArenas_ = std::make_unique<ManagedMmapArenas>(
         std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
   }
+
+  if (options.adviseHighWatermarkPct > 0) {
+    adviseThread_ = std::thread([this]() { adviseLoop(); });
+  }
 }
 
 MmapAllocator::~MmapAllocator() {
+  if (adviseThread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> l(adviseMutex_);
+      adviseStop_ = true;
+    }
+    adviseCv_.notify_one();
+    adviseThread_.join();
+  }
   VELOX_CHECK(
       (numAllocated_ == 0) && (numExternalMapped_ == 0), "{}", toString());
 }
@@ -91,14 +177,17 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
   MachinePageCount newMapsNeeded = 0;
+  // Each size class can hold the whole capacity, so that the size classes of
+  // the current node never run out.
+  const auto numaNode = currentNumaNode();
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(numaNode, sizeMix.sizeIndices[i])
+                        .allocate(sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -165,9 +254,60 @@ bool MmapAllocator::ensureEnoughMappedPages(int32_t newMappedNeeded) {
 int64_t MmapAllocator::freeNonContiguous(Allocation& allocation) {
   const auto numFreed = freeNonContiguousInternal(allocation);
   numAllocated_.fetch_sub(numFreed);
+  maybeScheduleAdvise();
   return AllocationTraits::pageBytes(numFreed);
 }
 
+void MmapAllocator::maybeScheduleAdvise() {
+  if (adviseHighWatermarkPages_ == 0 ||
+      numFreeMapped() <= static_cast<int64_t>(adviseHighWatermarkPages_) ||
+      adviseScheduled_.exchange(true)) {
+    return;
+  }
+  {
+    // Synchronizes with the wait of 'adviseThread_' to not lose the wakeup.
+    std::lock_guard<std::mutex> l(adviseMutex_);
+  }
+  adviseCv_.notify_one();
+}
+
+void MmapAllocator::adviseLoop() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> l(adviseMutex_);
+      adviseCv_.wait_for(l, adviseInterval_, [&]() {
+        return adviseStop_ || adviseScheduled_;
+      });
+      if (adviseStop_) {
+        return;
+      }
+    }
+    adviseScheduled_ = false;
+    backgroundAdvise();
+  }
+}
+
+void MmapAllocator::backgroundAdvise() {
+  if (numFreeMapped() <= static_cast<int64_t>(adviseHighWatermarkPages_)) {
+    return;
+  }
+  for (;;) {
+    std::lock_guard<std::mutex> l(sizeClassBalanceMutex_);
+    const int64_t excess =
+        numFreeMapped() - static_cast<int64_t>(adviseLowWatermarkPages_);
+    if (excess <= 0) {
+      return;
+    }
+    const auto numAdvised = adviseAway(
+        std::min<MachinePageCount>(excess, kAdviseBatchPages));
+    if (numAdvised == 0) {
+      return;
+    }
+    numMapped_.fetch_sub(numAdvised);
+    numBackgroundAdvisedPages_ += numAdvised;
+  }
+}
+
 MachinePageCount MmapAllocator::unmap(MachinePageCount targetPages) {
   std::lock_guard<std::mutex> l(sizeClassBalanceMutex_);
   const auto numAdvised = adviseAway(targetPages);
@@ -182,6 +322,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
     return numFreed;
   }
 
+  const auto numaNode = currentNumaNode();
   for (auto i = 0; i < sizeClasses_.size(); ++i) {
     auto& sizeClass = sizeClasses_[i];
     int32_t pages = 0;
@@ -190,14 +331,18 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       ClockTimer timer(clocks);
       pages = sizeClass->free(allocation);
     }
+    const auto numSizes = sizeClassSizes_.size();
     if ((pages > 0) && FLAGS_velox_time_allocations) {
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(
+          AllocationTraits::pageBytes(sizeClassSizes_[i % numSizes]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
+    if (pages > 0 && static_cast<int32_t>(i / numSizes) != numaNode) {
+      numRemoteNumaFreedPages_ += pages;
+    }
     numFreed += pages;
   }
   allocation.clear();
@@ -328,6 +473,13 @@ bool MmapAllocator::allocateContiguousImpl(
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
+    } else if (
+        FLAGS_velox_memory_use_hugepages &&
+        AllocationTraits::pageBytes(maxPages) >=
+            AllocationTraits::kHugePageSize) {
+      // Large allocations, e.g. hash tables, are aligned so that they are
+      // fully backed by huge pages with fewer TLB misses.
+      data = mmapHugePageAligned(AllocationTraits::pageBytes(maxPages));
     } else {
       data = ::mmap(
           nullptr,
@@ -508,7 +660,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -537,6 +692,9 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode != kNoNumaNode) {
+    preferNumaNode(address_, byteSize_, numaNode);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -954,6 +1112,20 @@ bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
 
+int32_t MmapAllocator::currentNumaNode() const {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+#ifdef __linux__
+  uint32_t cpu;
+  uint32_t node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node % numNumaNodes_;
+  }
+#endif
+  return 0;
+}
+
 std::string MmapAllocator::toString() const {
   std::stringstream out;
   out << "Memory Allocator[" << kindString(kind_) << " total capacity "
@@ -964,7 +1136,12 @@ std::string MmapAllocator::toString() const {
               : succinctBytes(
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_;
+  if (numNumaNodes_ > 1) {
+    out << " NUMA nodes " << numNumaNodes_ << " remote NUMA freed pages "
+        << numRemoteNumaFreedPages_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
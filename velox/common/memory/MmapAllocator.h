@@ -18,10 +18,13 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_set>
 
 #include <folly/ThreadCachedInt.h>
@@ -78,6 +81,31 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If greater than 1, each NUMA node has its own set of size classes,
+    /// whose address ranges prefer the memory of that node. Allocations are
+    /// served from the size classes of the node of the allocating thread.
+    ///
+    /// NOTE: the placement is a preference, so that the kernel falls back to
+    /// other nodes if a node runs out of memory. Contiguous allocations are not
+    /// NUMA aware.
+    int32_t numNumaNodes = 1;
+
+    /// If not zero, a background thread advises away the free size class pages
+    /// which are still backed by memory once they exceed
+    /// 'adviseHighWatermarkPct'% of the capacity, until they drop to
+    /// 'adviseLowWatermarkPct'%. This batches the madvise calls off the driver
+    /// threads, which otherwise advise away pages synchronously on allocation
+    /// when the mapped memory reaches the capacity.
+    uint32_t adviseHighWatermarkPct = 0;
+
+    /// The free mapped memory in percent of the capacity that the background
+    /// advise keeps. Must not exceed 'adviseHighWatermarkPct'.
+    uint32_t adviseLowWatermarkPct = 0;
+
+    /// The interval at which the background thread checks the free mapped
+    /// memory if not woken up earlier by a free crossing the high watermark.
+    uint32_t adviseIntervalMs = 1'000;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -154,19 +182,32 @@ class MmapAllocator : public MemoryAllocator {
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
+    stats.numRemoteNumaFrees = numRemoteNumaFreedPages_;
+    stats.deferredAdviseBytes =
+        AllocationTraits::pageBytes(std::max<int64_t>(0, numFreeMapped()));
+    stats.backgroundAdvisedBytes =
+        AllocationTraits::pageBytes(numBackgroundAdvisedPages_);
+    setPageBytes(stats);
     return stats;
   }
 
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
   std::string toString() const override;
 
  private:
   static constexpr uint64_t kAllSet = 0xffffffffffffffff;
+  static constexpr int32_t kNoNumaNode = -1;
 
   // Represents a range of virtual addresses used for allocating entries of
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // If 'numaNode' is not kNoNumaNode, the address range prefers the memory
+    // of that node.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -368,10 +409,40 @@ class MmapAllocator : public MemoryAllocator {
   // advises them away. Returns the number of pages advised away.
   MachinePageCount adviseAway(MachinePageCount target);
 
+  // Returns the number of mapped pages which are not allocated.
+  int64_t numFreeMapped() const {
+    return static_cast<int64_t>(numMapped_.load()) - numAllocated_.load();
+  }
+
+  // Wakes up 'adviseThread_' if the free mapped pages exceed
+  // 'adviseHighWatermarkPages_'. Called after frees.
+  void maybeScheduleAdvise();
+
+  // The loop of 'adviseThread_'.
+  void adviseLoop();
+
+  // If the free mapped pages exceed 'adviseHighWatermarkPages_', advises them
+  // away down to 'adviseLowWatermarkPages_' in batches of at most
+  // 'kAdviseBatchPages' per hold of 'sizeClassBalanceMutex_' so that the
+  // concurrent allocations are not blocked for long.
+  void backgroundAdvise();
+
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node of the size classes to allocate from on the calling
+  // thread.
+  int32_t currentNumaNode() const;
+
+  // Returns the size class for the 'sizeIndex'th size of 'sizeClassSizes_' on
+  // 'numaNode'.
+  SizeClass& sizeClass(int32_t numaNode, int32_t sizeIndex) {
+    return *sizeClasses_[numaNode * sizeClassSizes_.size() + sizeIndex];
+  }
+
   const Kind kind_;
 
+  const int32_t numNumaNodes_;
+
   // If set true, allocations larger than the largest size class size will be
   // delegated to ManagedMmapArena. Otherwise, a system mmap call will be
   // issued for each such allocation.
@@ -406,13 +477,21 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // The size classes of all the NUMA nodes, 'sizeClassSizes_.size()' per node
+  // in node order.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  // Pages freed by a thread running on another NUMA node than the one they
+  // were allocated on.
+  std::atomic<uint64_t> numRemoteNumaFreedPages_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
+  // Pages advised away by 'adviseThread_'. These are also counted in
+  // 'numAdvisedPages_'.
+  std::atomic<uint64_t> numBackgroundAdvisedPages_ = 0;
 
   // Allocations that are larger than largest size classes will be delegated to
   // ManagedMmapArenas, to avoid calling mmap on every allocation.
@@ -420,6 +499,28 @@ class MmapAllocator : public MemoryAllocator {
   std::unique_ptr<ManagedMmapArenas> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
+
+  // The max number of machine pages advised away by 'adviseThread_' per hold
+  // of 'sizeClassBalanceMutex_'.
+  static constexpr MachinePageCount kAdviseBatchPages = 4'096;
+
+  // Free mapped pages above which 'adviseThread_' advises away pages down to
+  // 'adviseLowWatermarkPages_'.
+  const MachinePageCount adviseHighWatermarkPages_;
+  const MachinePageCount adviseLowWatermarkPages_;
+  const std::chrono::milliseconds adviseInterval_;
+
+  // Serializes the wakeups and the stop of 'adviseThread_'.
+  std::mutex adviseMutex_;
+  std::condition_variable adviseCv_;
+  bool adviseStop_{false};
+  // Set by a free which crosses the high watermark until 'adviseThread_'
+  // picks it up.
+  std::atomic_bool adviseScheduled_{false};
+
+  // Advises away the free mapped pages in the background. Not joinable if
+  // 'Options::adviseHighWatermarkPct' is zero.
+  std::thread adviseThread_;
 };
 
 } // namespace facebook::velox::memory
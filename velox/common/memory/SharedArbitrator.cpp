@@ -16,6 +16,7 @@
 
 #include "velox/common/memory/SharedArbitrator.h"
 #include <mutex>
+#include <optional>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
@@ -85,6 +86,9 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -100,13 +104,26 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reservedBytes > rhs.reservedBytes;
       });
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
-// capacity for comparison including its current capacity and the capacity to
-// grow.
+// Returns the priority class of the query of root memory 'pool'.
+ArbitrationPriority poolPriority(const MemoryPool& pool) {
+  const auto* reclaimer = pool.reclaimer();
+  if (reclaimer == nullptr) {
+    return ArbitrationPriority::kNormal;
+  }
+  return reclaimer->priority();
+}
+
+// Finds the candidate with the largest capacity among the ones with the lowest
+// priority. For 'requestor', the capacity for comparison including its current
+// capacity and the capacity to grow. The candidates without capacity are
+// skipped as aborting them frees no memory.
 const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes,
@@ -120,11 +137,27 @@ const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
+    if ((capacity == 0) != (maxCapacity == 0)) {
+      if (capacity != 0) {
+        candidateIdx = i;
+        maxCapacity = capacity;
+      }
+      continue;
+    }
+    const auto priority = candidates[i].priority;
+    const auto maxPriority = candidates[candidateIdx].priority;
+    if (priority != maxPriority) {
+      if (priority < maxPriority) {
+        candidateIdx = i;
+        maxCapacity = capacity;
+      }
+      continue;
+    }
     if (capacity < maxCapacity) {
       continue;
     }
@@ -153,10 +186,11 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] PRIORITY[{}]]",
       pool->root()->name(),
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      arbitrationPriorityName(priority));
 }
 
 SharedArbitrator::~SharedArbitrator() {
@@ -186,7 +220,8 @@ void SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->reservedBytes(),
-         pool.get()});
+         pool.get(),
+         poolPriority(*pool)});
   }
 }
 
@@ -685,8 +720,10 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
   uint64_t reclaimedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(reclaimedBytes, reclaimTargetBytes);
+    // NOTE: the candidates are sorted by priority first, so a candidate with
+    // nothing to reclaim might be followed by a higher priority one which has.
     if (candidate.reclaimableBytes == 0) {
-      break;
+      continue;
     }
     reclaimedBytes +=
         reclaim(candidate.pool, reclaimTargetBytes - reclaimedBytes, false);
@@ -704,10 +741,17 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
   sortCandidatesByUsage(op->candidates);
 
   uint64_t freedBytes{0};
+  // The priority class whose remaining candidates are not aborted as they are
+  // sorted after one without capacity.
+  std::optional<ArbitrationPriority> exhaustedPriority;
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(freedBytes, reclaimTargetBytes);
+    if (exhaustedPriority == candidate.priority) {
+      continue;
+    }
     if (candidate.pool->capacity() == 0) {
-      break;
+      exhaustedPriority = candidate.priority;
+      continue;
     }
     try {
       VELOX_MEM_POOL_ABORTED(fmt::format(
@@ -889,7 +933,8 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
       kMetricArbitratorArbitrationTimeMs, arbitrationTimeUs / 1'000);
   addThreadLocalRuntimeStat(
       kMemoryArbitrationWallNanos,
-      RuntimeCounter(arbitrationTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+      RuntimeCounter(
+          arbitrationTimeUs * 1'000, RuntimeCounter::Unit::kNanos, true));
   if (operation_->localArbitrationQueueTimeUs != 0) {
     addThreadLocalRuntimeStat(
         kLocalArbitrationQueueWallNanos,
@@ -917,6 +962,22 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
   if (waitTimeUs != 0) {
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricArbitratorWaitTimeMs, waitTimeUs / 1'000);
+    if (operation_->requestRoot != nullptr) {
+      switch (poolPriority(*operation_->requestRoot)) {
+        case ArbitrationPriority::kLow:
+          RECORD_HISTOGRAM_METRIC_VALUE(
+              kMetricArbitratorLowPriorityWaitTimeMs, waitTimeUs / 1'000);
+          break;
+        case ArbitrationPriority::kNormal:
+          RECORD_HISTOGRAM_METRIC_VALUE(
+              kMetricArbitratorNormalPriorityWaitTimeMs, waitTimeUs / 1'000);
+          break;
+        case ArbitrationPriority::kHigh:
+          RECORD_HISTOGRAM_METRIC_VALUE(
+              kMetricArbitratorHighPriorityWaitTimeMs, waitTimeUs / 1'000);
+          break;
+      }
+    }
     arbitrator_->waitTimeUs_ += waitTimeUs;
   }
 }
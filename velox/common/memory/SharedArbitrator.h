@@ -32,7 +32,9 @@ namespace facebook::velox::memory {
 /// memory. For Prestissimo, we can configure it to reclaim memory by
 /// aborting a query. For Prestissimo-on-Spark, we can configure it to
 /// reclaim from a running query through techniques such as disk-spilling,
-/// partial aggregation or persistent shuffle data flushes.
+/// partial aggregation or persistent shuffle data flushes. The arbitrator
+/// spills and aborts the queries with the lowest ArbitrationPriority first, as
+/// reported by the reclaimers of their root memory pools.
 class SharedArbitrator : public memory::MemoryArbitrator {
  public:
   explicit SharedArbitrator(const Config& config);
@@ -70,6 +72,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t freeBytes{0};
     int64_t reservedBytes{0};
     MemoryPool* pool;
+    /// The priority class of the query of 'pool'. The lower priority
+    /// candidates are reclaimed from and aborted first.
+    ArbitrationPriority priority{ArbitrationPriority::kNormal};
 
     std::string toString() const;
   };
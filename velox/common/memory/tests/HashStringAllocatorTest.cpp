@@ -548,6 +548,37 @@ TEST_F(HashStringAllocatorTest, freeLists) {
   ASSERT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(30));
 }
 
+TEST_F(HashStringAllocatorTest, sizeClasses) {
+  auto* small = allocator_->allocate(17);
+  EXPECT_EQ(24, small->size());
+  auto* medium = allocator_->allocate(130);
+  EXPECT_EQ(160, medium->size());
+  auto* large = allocator_->allocate(1'000);
+  EXPECT_EQ(1'000, large->size());
+
+  // A free block of the size class is reused.
+  allocator_->free(small);
+  EXPECT_EQ(small, allocator_->allocate(20));
+
+  // Without a free block of the size class, the block is cut from the largest
+  // free block and not from the free block of 'medium'.
+  allocator_->free(medium);
+  auto* other = allocator_->allocate(40);
+  EXPECT_GT(reinterpret_cast<char*>(other), reinterpret_cast<char*>(large));
+  EXPECT_EQ(0, allocator_->fragmentedBytes());
+
+  std::vector<HSA::Header*> headers;
+  for (auto i = 0; i < 3; ++i) {
+    headers.push_back(allocator_->allocate(16));
+  }
+  allocator_->free(headers[1]);
+  EXPECT_EQ(16 + sizeof(HSA::Header), allocator_->fragmentedBytes());
+  allocator_->checkConsistency();
+  EXPECT_EQ(headers[1], allocator_->allocate(10));
+  EXPECT_EQ(0, allocator_->fragmentedBytes());
+  allocator_->checkConsistency();
+}
+
 TEST_F(HashStringAllocatorTest, strings) {
   constexpr uint64_t kMagic1 = 0x133788a07;
   constexpr uint64_t kMagic2 = 0xe7ababe11e;
@@ -35,6 +35,7 @@
 #endif // linux
 
 DECLARE_bool(velox_memory_leak_check_enabled);
+DECLARE_bool(velox_memory_use_hugepages);
 
 using namespace facebook::velox::common::testutil;
 
@@ -474,6 +475,116 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaNodes) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numNumaNodes = 0;
+  VELOX_ASSERT_THROW(std::make_shared<MmapAllocator>(options), "");
+
+  options.numNumaNodes = 2;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(mmapAllocator->numNumaNodes(), 2);
+  std::vector<std::unique_ptr<Allocation>> allocations;
+  MachinePageCount numPages{0};
+  for (auto i = 0; i < 10; ++i) {
+    allocations.push_back(std::make_unique<Allocation>());
+    ASSERT_TRUE(mmapAllocator->allocateNonContiguous(
+        100 + i * 10, *allocations.back()));
+    numPages += allocations.back()->numPages();
+  }
+  ASSERT_EQ(mmapAllocator->numAllocated(), numPages);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+
+  // Frees from another thread, which may run on another node.
+  std::thread([&]() {
+    for (auto& allocation : allocations) {
+      mmapAllocator->freeNonContiguous(*allocation);
+    }
+  }).join();
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+  ASSERT_LE(mmapAllocator->stats().numRemoteNumaFrees, numPages);
+}
+
+TEST_P(MemoryAllocatorTest, mmapAllocatorBackgroundAdvise) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.adviseHighWatermarkPct = 10;
+  options.adviseLowWatermarkPct = 5;
+  options.adviseIntervalMs = 10;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  const int64_t capacity = mmapAllocator->capacity();
+
+  std::vector<std::unique_ptr<Allocation>> allocations;
+  int64_t numBytes{0};
+  while (numBytes < capacity / 4) {
+    allocations.push_back(std::make_unique<Allocation>());
+    ASSERT_TRUE(mmapAllocator->allocateNonContiguous(256, *allocations.back()));
+    numBytes += allocations.back()->byteSize();
+  }
+  ASSERT_EQ(mmapAllocator->stats().deferredAdviseBytes, 0);
+
+  // The free mapped memory below the high watermark is kept.
+  int64_t freedBytes{0};
+  while (freedBytes < capacity / 20) {
+    freedBytes += allocations.back()->byteSize();
+    mmapAllocator->freeNonContiguous(*allocations.back());
+    allocations.pop_back();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_EQ(mmapAllocator->stats().deferredAdviseBytes, freedBytes);
+  ASSERT_EQ(mmapAllocator->stats().backgroundAdvisedBytes, 0);
+
+  // Crossing the high watermark advises away down to the low watermark.
+  for (auto& allocation : allocations) {
+    mmapAllocator->freeNonContiguous(*allocation);
+  }
+  const auto lowWatermarkBytes = capacity * options.adviseLowWatermarkPct / 100;
+  for (int32_t i = 0; i < 1'000; ++i) {
+    if (mmapAllocator->stats().deferredAdviseBytes <= lowWatermarkBytes) {
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  const auto stats = mmapAllocator->stats();
+  ASSERT_LE(stats.deferredAdviseBytes, lowWatermarkBytes);
+  ASSERT_GE(stats.backgroundAdvisedBytes, numBytes - lowWatermarkBytes);
+  ASSERT_EQ(
+      stats.numAdvise,
+      AllocationTraits::numPages(stats.backgroundAdvisedBytes));
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
+TEST_P(MemoryAllocatorTest, hugePageAlignedContiguousAllocation) {
+  if (!useMmap_ || !FLAGS_velox_memory_use_hugepages) {
+    return;
+  }
+  const auto numPages = 3 * AllocationTraits::numPagesInHugePage() + 5;
+  ContiguousAllocation allocation;
+  ASSERT_TRUE(instance_->allocateContiguous(numPages, nullptr, allocation));
+  ASSERT_EQ(
+      reinterpret_cast<uintptr_t>(allocation.data()) %
+          AllocationTraits::kHugePageSize,
+      0);
+  memset(allocation.data(), 1, allocation.size());
+  // The whole aligned range is advised unless the kernel has no transparent
+  // huge page support.
+  const auto stats = instance_->stats();
+  if (stats.hugePageBytes != 0) {
+    ASSERT_EQ(stats.hugePageBytes, 3 * AllocationTraits::kHugePageSize);
+  }
+  ASSERT_GE(stats.smallPageBytes, 5 * AllocationTraits::kPageSize);
+  instance_->freeContiguous(allocation);
+  ASSERT_EQ(instance_->stats().hugePageBytes, 0);
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -24,6 +24,7 @@
 #include "velox/common/memory/MallocAllocator.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/SharedArbitrator.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
 
 DECLARE_int32(velox_memory_num_shared_leaf_pools);
 DECLARE_bool(velox_enable_memory_usage_track_in_default_memory_pool);
@@ -627,4 +628,45 @@ TEST_F(MemoryManagerTest, quotaEnforcement) {
     }
   }
 }
+
+TEST_F(MemoryManagerTest, poolTraceListener) {
+  auto tracer = std::make_shared<MemoryPoolTracer>();
+  MemoryManagerOptions options;
+  options.poolTraceListener = tracer;
+  {
+    MemoryManager manager{options};
+    // Leaf pools are not traced.
+    auto sysLeafPool = manager.addLeafPool("sysLeaf");
+    void* sysBuffer = sysLeafPool->allocate(1 << 20);
+    sysLeafPool->free(sysBuffer, 1 << 20);
+
+    auto rootPool = manager.addRootPool("traced root", kMaxMemory);
+    auto leafPool = rootPool->addLeafChild("leaf");
+    void* buffer = leafPool->allocate(1 << 20);
+    leafPool->free(buffer, 1 << 20);
+  }
+  const auto events = tracer->events();
+  ASSERT_EQ(events.size(), 4);
+  ASSERT_EQ(events[0].type, MemoryPoolTracer::Event::Type::kCreate);
+  ASSERT_EQ(events[1].type, MemoryPoolTracer::Event::Type::kReservation);
+  ASSERT_EQ(events[1].bytes, 1 << 20);
+  ASSERT_EQ(events[2].type, MemoryPoolTracer::Event::Type::kReservation);
+  ASSERT_EQ(events[2].bytes, -(1 << 20));
+  ASSERT_EQ(events[3].type, MemoryPoolTracer::Event::Type::kDestroy);
+  for (int i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(events[i].pool, "traced root");
+    if (i > 0) {
+      ASSERT_GE(events[i].timeUs, events[i - 1].timeUs);
+    }
+  }
+
+  auto traceFile = exec::test::TempFilePath::create();
+  tracer->write(traceFile->getPath());
+  ASSERT_EQ(MemoryPoolTracer::read(traceFile->getPath()), events);
+
+  traceFile->append("X 1 2 pool\n");
+  VELOX_ASSERT_THROW(
+      MemoryPoolTracer::read(traceFile->getPath()),
+      "Bad memory pool trace event type");
+}
 } // namespace facebook::velox::memory
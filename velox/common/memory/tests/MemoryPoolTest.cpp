@@ -2433,6 +2433,84 @@ TEST_P(MemoryPoolTest, concurrentUpdatesToTheSamePool) {
   ASSERT_EQ(root->stats().usedBytes, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationCache) {
+  if (!isLeafThreadSafe_) {
+    return;
+  }
+  constexpr int64_t kCacheBytes = 64 * KB;
+  setupMemory(
+      {.poolReservationCacheBytes = kCacheBytes,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity,
+       .arbitratorReservedCapacity = 1LL << 30});
+  auto root = manager_->addRootPool("reservationCache");
+  auto leaf = root->addLeafChild("reservationCache", true);
+
+  // The first allocation reserves under the lock and caches part of the unused
+  // reservation for the calling thread.
+  void* first = leaf->allocate(KB);
+  ASSERT_EQ(leaf->usedBytes(), KB);
+  ASSERT_EQ(leaf->reservedBytes(), MB);
+  ASSERT_EQ(leaf->availableReservation(), MB - KB - kCacheBytes);
+
+  // The following small allocations and frees are served by the cache.
+  std::vector<void*> buffers;
+  for (int32_t i = 0; i < 8; ++i) {
+    buffers.push_back(leaf->allocate(KB));
+  }
+  ASSERT_EQ(leaf->usedBytes(), 9 * KB);
+  ASSERT_EQ(leaf->availableReservation(), MB - KB - kCacheBytes);
+  ASSERT_EQ(leaf->stats().cumulativeBytes, 9 * KB);
+  for (auto* buffer : buffers) {
+    leaf->free(buffer, KB);
+  }
+  ASSERT_EQ(leaf->usedBytes(), KB);
+  ASSERT_EQ(leaf->availableReservation(), MB - KB - kCacheBytes);
+
+  // A large allocation flushes the cache before growing the reservation.
+  void* large = leaf->allocate(2 * MB);
+  ASSERT_EQ(leaf->usedBytes(), 2 * MB + KB);
+  ASSERT_EQ(leaf->reservedBytes(), 3 * MB);
+  leaf->free(large, 2 * MB);
+  ASSERT_EQ(leaf->usedBytes(), KB);
+  ASSERT_EQ(leaf->reservedBytes(), MB);
+  leaf->free(first, KB);
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), MB);
+
+  // The cached reservation is returned on explicit release.
+  leaf->release();
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  const int32_t kNumThreads = 8;
+  const int32_t kNumAllocsPerThread = 1'000;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (int32_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      std::vector<void*> allocations;
+      for (int32_t j = 0; j < kNumAllocsPerThread; ++j) {
+        allocations.push_back(leaf->allocate(256));
+      }
+      for (auto* buffer : allocations) {
+        leaf->free(buffer, 256);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(
+      leaf->stats().cumulativeBytes,
+      2 * MB + 9 * KB + kNumThreads * kNumAllocsPerThread * 256);
+  leaf->release();
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, concurrentUpdateToSharedPools) {
   // under some conditions bug.
   constexpr int64_t kMaxMemory = 10 * GB;
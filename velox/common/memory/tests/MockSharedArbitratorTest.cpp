@@ -104,6 +104,14 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
       memory::MemoryReclaimer::abort(pool, error);
     }
 
+    ArbitrationPriority priority() const override {
+      auto task = task_.lock();
+      if (task == nullptr) {
+        return ArbitrationPriority::kNormal;
+      }
+      return task->priority();
+    }
+
    private:
     std::weak_ptr<MockTask> task_;
   };
@@ -146,6 +154,14 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
     error_ = error;
   }
 
+  ArbitrationPriority priority() const {
+    return priority_;
+  }
+
+  void setPriority(ArbitrationPriority priority) {
+    priority_ = priority;
+  }
+
  private:
   inline static std::atomic<int64_t> poolId_{0};
   std::shared_ptr<MemoryPool> root_;
@@ -153,6 +169,7 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
   std::vector<std::shared_ptr<MemoryPool>> pools_;
   std::vector<std::shared_ptr<MockMemoryOperator>> ops_;
   std::exception_ptr error_{nullptr};
+  std::atomic<ArbitrationPriority> priority_{ArbitrationPriority::kNormal};
 };
 
 class MockMemoryOperator {
@@ -2120,6 +2137,70 @@ TEST_F(MockSharedArbitrationTest, failedArbitration) {
   ASSERT_GE(arbitrator_->stats().queueTimeUs, 0);
 }
 
+TEST_F(MockSharedArbitrationTest, reclaimFromLowPriorityFirst) {
+  const uint64_t memCapacity = 256 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  const int allocateSize = 8 * MB;
+  setupMemory(memCapacity, 0, minPoolCapacity, 0);
+  auto lowTask = addTask();
+  lowTask->setPriority(ArbitrationPriority::kLow);
+  auto* lowOp = addMemoryOp(lowTask);
+  auto normalTask = addTask();
+  auto* normalOp = addMemoryOp(normalTask);
+  auto* arbitrateOp = addMemoryOp();
+  // The low priority query uses less memory than the normal priority one, so
+  // that it is not the first to spill by reclaimable bytes alone.
+  for (int i = 0; i < 4; ++i) {
+    lowOp->allocate(allocateSize);
+  }
+  for (int i = 0; i < 8; ++i) {
+    normalOp->allocate(allocateSize);
+  }
+  ASSERT_EQ(lowOp->capacity(), 32 * MB);
+  ASSERT_EQ(normalOp->capacity(), 64 * MB);
+
+  // Needs 16MB more than the free capacity of the arbitrator.
+  arbitrateOp->allocate(176 * MB);
+  ASSERT_EQ(lowOp->reclaimer()->stats().numReclaims, 1);
+  ASSERT_EQ(normalOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(lowOp->pool()->usedBytes(), 16 * MB);
+  ASSERT_EQ(normalOp->pool()->usedBytes(), 64 * MB);
+  ASSERT_EQ(lowTask->error(), nullptr);
+  ASSERT_EQ(normalTask->error(), nullptr);
+  ASSERT_EQ(arbitrator_->stats().numFailures, 0);
+}
+
+TEST_F(MockSharedArbitrationTest, abortLowPriorityFirst) {
+  const uint64_t memCapacity = 256 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  const int allocateSize = 8 * MB;
+  setupMemory(memCapacity, 0, minPoolCapacity, 0);
+  auto lowTask = addTask();
+  lowTask->setPriority(ArbitrationPriority::kLow);
+  auto* lowOp = addMemoryOp(lowTask, false);
+  auto normalTask = addTask();
+  auto* normalOp = addMemoryOp(normalTask, false);
+  auto highTask = addTask();
+  highTask->setPriority(ArbitrationPriority::kHigh);
+  auto* arbitrateOp = addMemoryOp(highTask);
+  for (int i = 0; i < 4; ++i) {
+    lowOp->allocate(allocateSize);
+  }
+  for (int i = 0; i < 8; ++i) {
+    normalOp->allocate(allocateSize);
+  }
+
+  // Nothing can be spilled, so the low priority query is aborted even though
+  // the normal priority one has the largest capacity.
+  arbitrateOp->allocate(176 * MB);
+  ASSERT_NE(lowTask->error(), nullptr);
+  ASSERT_TRUE(lowOp->pool()->aborted());
+  ASSERT_EQ(normalTask->error(), nullptr);
+  ASSERT_FALSE(normalOp->pool()->aborted());
+  ASSERT_EQ(arbitrator_->stats().numFailures, 0);
+  ASSERT_EQ(arbitrator_->stats().numAborted, 1);
+}
+
 TEST_F(MockSharedArbitrationTest, singlePoolGrowCapacityWithArbitration) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+// Opens a counter of the calling thread on any CPU. 'groupFd' is -1 for the
+// group leader, which starts disabled and is enabled with the group.
+int32_t openCounter(uint64_t config, int32_t groupFd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = groupFd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+} // namespace
+
+// static
+std::unique_ptr<PerfCounters> PerfCounters::open() {
+  std::vector<int32_t> fds;
+  for (auto config :
+       {PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES}) {
+    auto fd = openCounter(config, fds.empty() ? -1 : fds[0]);
+    if (fd < 0) {
+      LOG(WARNING) << "Cannot open hardware counters: " << strerror(errno);
+      for (auto opened : fds) {
+        close(opened);
+      }
+      return nullptr;
+    }
+    fds.push_back(fd);
+  }
+  ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return std::unique_ptr<PerfCounters>(new PerfCounters(std::move(fds)));
+}
+
+PerfCounters::~PerfCounters() {
+  for (auto fd : fds_) {
+    close(fd);
+  }
+}
+
+PerfCounts PerfCounters::read() const {
+  // The layout of a group read with PERF_FORMAT_GROUP.
+  struct {
+    uint64_t numCounters;
+    uint64_t values[4];
+  } data;
+  if (::read(fds_[0], &data, sizeof(data)) != sizeof(data)) {
+    return {};
+  }
+  return {data.values[0], data.values[1], data.values[2], data.values[3]};
+}
+#else
+// static
+std::unique_ptr<PerfCounters> PerfCounters::open() {
+  return nullptr;
+}
+
+PerfCounters::~PerfCounters() {}
+
+PerfCounts PerfCounters::read() const {
+  return {};
+}
+#endif
+
+// static
+PerfCounters* PerfCounters::forThread() {
+  thread_local bool opened = false;
+  thread_local std::unique_ptr<PerfCounters> counters;
+  if (!opened) {
+    opened = true;
+    counters = open();
+  }
+  return counters.get();
+}
+
+} // namespace facebook::velox::process
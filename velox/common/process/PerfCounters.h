@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Hardware event counts of a thread.
+struct PerfCounts {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  // Last level cache misses.
+  uint64_t cacheMisses{0};
+  uint64_t branchMisses{0};
+
+  PerfCounts operator-(const PerfCounts& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        cacheMisses - other.cacheMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+/// The hardware counters of the calling thread, opened with
+/// perf_event_open(2) as one group so that they count over the same
+/// intervals and their ratios, e.g. instructions per cycle, are exact. Only
+/// user space events are counted.
+class PerfCounters {
+ public:
+  /// Returns the counters of the calling thread, opening them on first use.
+  /// Returns nullptr if they cannot be opened, e.g. if not on Linux, if the
+  /// CPU has no such counters or if /proc/sys/kernel/perf_event_paranoid does
+  /// not allow it. The counters stay open until the thread exits.
+  static PerfCounters* forThread();
+
+  ~PerfCounters();
+
+  /// Returns the counts since the counters were opened. Each call is a
+  /// system call.
+  PerfCounts read() const;
+
+ private:
+  explicit PerfCounters(std::vector<int32_t> fds) : fds_(std::move(fds)) {}
+
+  // Opens the counters of the calling thread. Returns nullptr on failure.
+  static std::unique_ptr<PerfCounters> open();
+
+  // The file descriptors of cycles, instructions, cache misses and branch
+  // misses. The first is the group leader. Reading it reads all counters.
+  const std::vector<int32_t> fds_;
+};
+
+/// Passes the hardware counts of the calling thread from construction to
+/// destruction to a callback, like DeltaCpuWallTimer does for CPU and wall
+/// time.
+template <typename F>
+class DeltaPerfCounter {
+ public:
+  DeltaPerfCounter(const PerfCounters& counters, F&& func)
+      : counters_(counters), start_(counters.read()), func_(std::move(func)) {}
+
+  ~DeltaPerfCounter() {
+    func_(counters_.read() - start_);
+  }
+
+ private:
+  const PerfCounters& counters_;
+  const PerfCounts start_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <folly/Demangle.h>
+#include <fmt/format.h>
+#include <glog/logging.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "velox/common/process/ThreadDebugInfo.h"
+
+DEFINE_int32(
+    profiler_sampling_interval_us,
+    10'000,
+    "CPU time between stack samples of the sampling profiler. 0 disables "
+    "sampling");
+
+namespace facebook::velox::process {
+namespace {
+
+constexpr int32_t kNumSlots = 1024;
+constexpr int32_t kMaxFrames = 48;
+constexpr int32_t kMaxIdLength = 96;
+
+// Frames of the signal handler and the signal trampoline on top of each
+// sample.
+constexpr int32_t kNumHandlerFrames = 2;
+
+// Interval between draining the samples to the per task stacks.
+constexpr std::chrono::milliseconds kDrainInterval{100};
+
+enum SlotState : int32_t { kEmpty, kWriting, kFull };
+
+// One sample. Written by the signal handler and read by the drain thread.
+struct Slot {
+  std::atomic<int32_t> state{kEmpty};
+  char taskId[kMaxIdLength];
+  char planNodeId[kMaxIdLength];
+  char operatorType[kMaxIdLength];
+  int32_t numFrames;
+  void* frames[kMaxFrames];
+};
+
+Slot slots[kNumSlots];
+std::atomic<uint32_t> nextSlot{0};
+std::atomic<int64_t> numDropped{0};
+
+thread_local const std::string* threadPlanNodeId{nullptr};
+thread_local const std::string* threadOperatorType{nullptr};
+
+// Copies 'source' to 'target', truncating to kMaxIdLength - 1 characters.
+void copyId(const std::string* source, char* target) {
+  if (source == nullptr) {
+    target[0] = '\0';
+    return;
+  }
+  const auto length = std::min<size_t>(source->size(), kMaxIdLength - 1);
+  memcpy(target, source->data(), length);
+  target[length] = '\0';
+}
+
+void sampleSignalHandler(int /*signal*/) {
+  const auto savedErrno = errno;
+  const auto* debugInfo = GetThreadDebugInfo();
+  if (debugInfo != nullptr && !debugInfo->taskId_.empty()) {
+    auto& slot = slots[nextSlot.fetch_add(1) % kNumSlots];
+    int32_t expected = kEmpty;
+    if (slot.state.compare_exchange_strong(expected, kWriting)) {
+      copyId(&debugInfo->taskId_, slot.taskId);
+      copyId(threadPlanNodeId, slot.planNodeId);
+      copyId(threadOperatorType, slot.operatorType);
+      slot.numFrames = backtrace(slot.frames, kMaxFrames);
+      slot.state.store(kFull, std::memory_order_release);
+    } else {
+      numDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  errno = savedErrno;
+}
+
+struct State {
+  // Serializes start() and stop().
+  std::mutex startMutex;
+  std::atomic<bool> running{false};
+  struct sigaction previousAction;
+  std::thread drainThread;
+  std::mutex drainMutex;
+  std::condition_variable drainCv;
+
+  // Guards the members below.
+  std::mutex mutex;
+  // Folded stack to count, per task id.
+  std::unordered_map<std::string, std::map<std::string, int64_t>> stacks;
+  // Symbol name by return address.
+  std::unordered_map<void*, std::string> symbols;
+};
+
+State& state() {
+  static State* state = new State();
+  return *state;
+}
+
+// Returns the demangled name of the function containing 'address'. Called
+// with the mutex of state() held.
+const std::string& symbolize(void* address) {
+  auto& symbols = state().symbols;
+  auto it = symbols.find(address);
+  if (it != symbols.end()) {
+    return it->second;
+  }
+  std::string name;
+  Dl_info info;
+  if (dladdr(address, &info) == 0) {
+    name = fmt::format("{}", address);
+  } else if (info.dli_sname != nullptr) {
+    name = folly::demangle(info.dli_sname).toStdString();
+  } else if (info.dli_fname != nullptr) {
+    // Frames in the same library without symbols are one frame.
+    name = fmt::format("[{}]", info.dli_fname);
+  } else {
+    name = fmt::format("{}", address);
+  }
+  // ';' separates frames in a folded stack.
+  std::replace(name.begin(), name.end(), ';', ':');
+  return symbols.emplace(address, std::move(name)).first->second;
+}
+
+// Moves the full slots to the per task stacks.
+void drain() {
+  std::lock_guard<std::mutex> l(state().mutex);
+  for (auto& slot : slots) {
+    if (slot.state.load(std::memory_order_acquire) != kFull) {
+      continue;
+    }
+    std::string stack = slot.operatorType[0] == '\0'
+        ? std::string("Driver")
+        : fmt::format("{} {}", slot.operatorType, slot.planNodeId);
+    for (auto i = slot.numFrames - 1; i >= kNumHandlerFrames; --i) {
+      stack += ';';
+      stack += symbolize(slot.frames[i]);
+    }
+    ++state().stacks[slot.taskId][stack];
+    slot.state.store(kEmpty, std::memory_order_release);
+  }
+}
+
+void drainLoop() {
+  auto& s = state();
+  std::unique_lock<std::mutex> l(s.drainMutex);
+  while (s.running) {
+    s.drainCv.wait_for(l, kDrainInterval, [&]() { return !s.running; });
+    drain();
+  }
+}
+
+void setTimer(int32_t intervalUs) {
+  struct itimerval timer;
+  timer.it_interval.tv_sec = intervalUs / 1'000'000;
+  timer.it_interval.tv_usec = intervalUs % 1'000'000;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+} // namespace
+
+SamplingProfiler::OperatorScope::OperatorScope(
+    const std::string& planNodeId,
+    const std::string& operatorType)
+    : prevPlanNodeId_(threadPlanNodeId),
+      prevOperatorType_(threadOperatorType) {
+  threadPlanNodeId = &planNodeId;
+  threadOperatorType = &operatorType;
+}
+
+SamplingProfiler::OperatorScope::~OperatorScope() {
+  threadPlanNodeId = prevPlanNodeId_;
+  threadOperatorType = prevOperatorType_;
+}
+
+// static
+bool SamplingProfiler::start() {
+  auto& s = state();
+  std::lock_guard<std::mutex> l(s.startMutex);
+  if (s.running || FLAGS_profiler_sampling_interval_us <= 0) {
+    return false;
+  }
+  // The first backtrace() loads libgcc, which is not safe in a signal
+  // handler.
+  void* frames[1];
+  backtrace(frames, 1);
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = sampleSignalHandler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, &s.previousAction) != 0) {
+    LOG(ERROR) << "Cannot install SIGPROF handler: " << strerror(errno);
+    return false;
+  }
+  s.running = true;
+  s.drainThread = std::thread(drainLoop);
+  setTimer(FLAGS_profiler_sampling_interval_us);
+  LOG(INFO) << "Started sampling profiler every "
+            << FLAGS_profiler_sampling_interval_us << "us";
+  return true;
+}
+
+// static
+void SamplingProfiler::stop() {
+  auto& s = state();
+  std::lock_guard<std::mutex> l(s.startMutex);
+  if (!s.running) {
+    return;
+  }
+  setTimer(0);
+  sigaction(SIGPROF, &s.previousAction, nullptr);
+  {
+    std::lock_guard<std::mutex> drainLock(s.drainMutex);
+    s.running = false;
+  }
+  s.drainCv.notify_all();
+  s.drainThread.join();
+  drain();
+  LOG(INFO) << "Stopped sampling profiler";
+}
+
+// static
+bool SamplingProfiler::isRunning() {
+  return state().running;
+}
+
+// static
+std::string SamplingProfiler::foldedStacks(const std::string& taskId) {
+  drain();
+  std::lock_guard<std::mutex> l(state().mutex);
+  auto it = state().stacks.find(taskId);
+  if (it == state().stacks.end()) {
+    return "";
+  }
+  std::string result;
+  for (const auto& [stack, count] : it->second) {
+    result += fmt::format("{} {}\n", stack, count);
+  }
+  return result;
+}
+
+// static
+int64_t SamplingProfiler::numSamples(const std::string& taskId) {
+  drain();
+  std::lock_guard<std::mutex> l(state().mutex);
+  auto it = state().stacks.find(taskId);
+  if (it == state().stacks.end()) {
+    return 0;
+  }
+  int64_t count = 0;
+  for (const auto& [stack, n] : it->second) {
+    count += n;
+  }
+  return count;
+}
+
+// static
+void SamplingProfiler::clear(const std::string& taskId) {
+  std::lock_guard<std::mutex> l(state().mutex);
+  state().stacks.erase(taskId);
+}
+
+// static
+int64_t SamplingProfiler::numDroppedSamples() {
+  return numDropped;
+}
+
+} // namespace facebook::velox::process
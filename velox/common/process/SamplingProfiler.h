@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gflags/gflags.h>
+#include <cstdint>
+#include <string>
+
+DECLARE_int32(profiler_sampling_interval_us);
+
+namespace facebook::velox::process {
+
+/// Samples the stacks of the threads of the process and attributes each
+/// sample to the task and the operator the thread runs, so that the CPU of
+/// one query on a shared worker can be told apart. Driver threads are
+/// tagged with their query and task by ScopedThreadDebugInfo and with their
+/// operator by OperatorScope. Samples of threads without a task are
+/// dropped.
+///
+/// The samples of a task are kept as folded stacks, the input of flame
+/// graph tools: the operator, then the frames from the outermost, then the
+/// count, e.g. "HashProbe 3;Driver::run;HashProbe::getOutput 12".
+///
+/// A sample is taken every --profiler_sampling_interval_us of CPU time of
+/// the process with SIGPROF. The signal handler only copies the stack to a
+/// fixed size buffer. A background thread symbolizes and aggregates the
+/// samples. The overhead is proportional to the sampling rate. Samples are
+/// dropped if the buffer is full.
+class SamplingProfiler {
+ public:
+  /// Marks the calling thread as running the operator with 'planNodeId' and
+  /// 'operatorType' while in scope. The strings must outlive the scope.
+  class OperatorScope {
+   public:
+    OperatorScope(
+        const std::string& planNodeId,
+        const std::string& operatorType);
+
+    ~OperatorScope();
+
+   private:
+    const std::string* const prevPlanNodeId_;
+    const std::string* const prevOperatorType_;
+  };
+
+  /// Starts sampling. Returns false if sampling is already running or if
+  /// --profiler_sampling_interval_us is 0.
+  static bool start();
+
+  /// Stops sampling and aggregates the samples taken so far.
+  static void stop();
+
+  static bool isRunning();
+
+  /// Returns the folded stacks of the samples of 'taskId', one per line.
+  static std::string foldedStacks(const std::string& taskId);
+
+  /// Returns the number of samples of 'taskId'.
+  static int64_t numSamples(const std::string& taskId);
+
+  /// Drops the samples of 'taskId'.
+  static void clear(const std::string& taskId);
+
+  /// Returns the number of samples dropped because the buffer was full.
+  static int64_t numDroppedSamples();
+};
+
+} // namespace facebook::velox::process
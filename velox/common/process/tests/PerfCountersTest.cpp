@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+namespace {
+
+TEST(PerfCountersTest, basic) {
+  auto* counters = PerfCounters::forThread();
+  if (!counters) {
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  EXPECT_EQ(counters, PerfCounters::forThread());
+
+  PerfCounts delta;
+  volatile int64_t sum = 0;
+  {
+    DeltaPerfCounter counter(
+        *counters, [&](const PerfCounts& counts) { delta = counts; });
+    for (auto i = 0; i < 1'000'000; ++i) {
+      sum += i;
+    }
+  }
+  EXPECT_LT(1'000'000, delta.instructions);
+  EXPECT_LT(0, delta.cycles);
+
+  // Each thread has its own counters.
+  PerfCounters* otherCounters = nullptr;
+  std::thread([&]() { otherCounters = PerfCounters::forThread(); }).join();
+  EXPECT_NE(counters, otherCounters);
+}
+
+} // namespace
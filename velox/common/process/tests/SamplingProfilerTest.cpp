@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "velox/common/process/ThreadDebugInfo.h"
+
+using namespace facebook::velox::process;
+
+namespace {
+
+TEST(SamplingProfilerTest, basic) {
+  gflags::FlagSaver saver;
+  FLAGS_profiler_sampling_interval_us = 1'000;
+  ASSERT_TRUE(SamplingProfiler::start());
+  EXPECT_TRUE(SamplingProfiler::isRunning());
+  EXPECT_FALSE(SamplingProfiler::start());
+
+  const std::string planNodeId = "3";
+  const std::string operatorType = "HashProbe";
+  volatile double sum = 0;
+  std::thread worker([&]() {
+    ScopedThreadDebugInfo debugInfo(ThreadDebugInfo{"query", "task", {}});
+    SamplingProfiler::OperatorScope scope(planNodeId, operatorType);
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start <
+           std::chrono::milliseconds(300)) {
+      sum = sum + 1.0 / (sum + 1);
+    }
+  });
+  // Threads without a task are not sampled.
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start <
+         std::chrono::milliseconds(300)) {
+    sum = sum + 1.0 / (sum + 1);
+  }
+  worker.join();
+  SamplingProfiler::stop();
+  EXPECT_FALSE(SamplingProfiler::isRunning());
+
+  EXPECT_LT(0, SamplingProfiler::numSamples("task"));
+  auto stacks = SamplingProfiler::foldedStacks("task");
+  EXPECT_EQ(0, stacks.find("HashProbe 3;"));
+  EXPECT_EQ("", SamplingProfiler::foldedStacks("other"));
+
+  SamplingProfiler::clear("task");
+  EXPECT_EQ(0, SamplingProfiler::numSamples("task"));
+}
+
+TEST(SamplingProfilerTest, disabled) {
+  gflags::FlagSaver saver;
+  FLAGS_profiler_sampling_interval_us = 0;
+  EXPECT_FALSE(SamplingProfiler::start());
+  EXPECT_FALSE(SamplingProfiler::isRunning());
+}
+
+} // namespace
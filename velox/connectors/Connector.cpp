@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/Connector.h"
+#include "velox/common/caching/ColumnAccessHistory.h"
 
 namespace facebook::velox::connector {
 namespace {
@@ -32,14 +33,16 @@ std::unordered_map<std::string, std::shared_ptr<Connector>>& connectors() {
 } // namespace
 
 bool DataSink::Stats::empty() const {
-  return numWrittenBytes == 0 && numWrittenFiles == 0 && spillStats.empty();
+  return numWrittenBytes == 0 && numWrittenFiles == 0 &&
+      numWrittenIndexBytes == 0 && spillStats.empty();
 }
 
 std::string DataSink::Stats::toString() const {
   return fmt::format(
-      "numWrittenBytes {} numWrittenFiles {} {}",
+      "numWrittenBytes {} numWrittenFiles {} numWrittenIndexBytes {} {}",
       succinctBytes(numWrittenBytes),
       numWrittenFiles,
+      succinctBytes(numWrittenIndexBytes),
       spillStats.toString());
 }
 
@@ -107,24 +110,26 @@ folly::Synchronized<
 
 // static
 void Connector::unregisterTracker(cache::ScanTracker* tracker) {
+  cache::columnAccessHistory().recordScan(*tracker);
   trackers_.withWLock([&](auto& trackers) { trackers.erase(tracker->id()); });
 }
 
 std::shared_ptr<cache::ScanTracker> Connector::getTracker(
     const std::string& scanId,
-    int32_t loadQuantum) {
+    int32_t loadQuantum,
+    std::string_view table) {
   return trackers_.withWLock([&](auto& trackers) -> auto {
     auto it = trackers.find(scanId);
     if (it == trackers.end()) {
       auto newTracker = std::make_shared<cache::ScanTracker>(
-          scanId, unregisterTracker, loadQuantum);
+          scanId, unregisterTracker, loadQuantum, nullptr, table);
       trackers[newTracker->id()] = newTracker;
       return newTracker;
     }
     std::shared_ptr<cache::ScanTracker> tracker = it->second.lock();
     if (!tracker) {
       tracker = std::make_shared<cache::ScanTracker>(
-          scanId, unregisterTracker, loadQuantum);
+          scanId, unregisterTracker, loadQuantum, nullptr, table);
       trackers[tracker->id()] = tracker;
     }
     return tracker;
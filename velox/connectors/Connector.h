@@ -61,6 +61,22 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns the bucket of a bucketed table that the rows of the split belong
+  /// to, if any. The splits of the same bucket of tables bucketed alike can
+  /// be processed together as a split group in grouped execution.
+  virtual std::optional<int32_t> bucketId() const {
+    return std::nullopt;
+  }
+
+  /// Returns a key that identifies the rows of the split and the version of
+  /// the data these come from, e.g. the file, the range in it and the
+  /// modification time of the file. Splits with the same key produce the same
+  /// rows. Returns std::nullopt if there is no such key, in which case results
+  /// computed from the split are not cached. See exec::SplitResultCache.
+  virtual std::optional<std::string> cacheKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -146,6 +162,9 @@ class DataSink {
   struct Stats {
     uint64_t numWrittenBytes{0};
     uint32_t numWrittenFiles{0};
+    // Bytes of indexes and filters in the written files, e.g. Parquet page
+    // indexes and Bloom filters. Included in 'numWrittenBytes'.
+    uint64_t numWrittenIndexBytes{0};
     common::SpillStats spillStats;
 
     bool empty() const;
@@ -192,6 +211,18 @@ class DataSource {
       uint64_t size,
       velox::ContinueFuture& future) = 0;
 
+  /// Informs 'this' that no more rows of the current split are needed, e.g.
+  /// because a downstream limit has been reached. Drops the state of the split
+  /// and cancels its background reads that have not started. The next call
+  /// must be addSplit() or runtimeStats().
+  virtual void cancelSplit() {}
+
+  /// Returns true if next() may return fewer rows than it reads from the
+  /// split, e.g. because of filters. Used to size the reads for a limit.
+  virtual bool hasFilter() const {
+    return true;
+  }
+
   /// Add dynamically generated filter.
   /// @param outputChannel index into outputType specified in
   /// Connector::createDataSource() that identifies the column this filter
@@ -335,6 +366,19 @@ class ConnectorQueryCtx {
     return cancellationToken_;
   }
 
+  /// Sets the number of bytes of the first stripe or row group of the split
+  /// that the DataSource may read ahead. Set on the context of a split that is
+  /// preloaded on an executor while the driver scans earlier splits.
+  void setPreloadBytesLimit(uint64_t bytes) {
+    preloadBytesLimit_ = bytes;
+  }
+
+  /// Returns 0 if the split is not preloaded or the DataSource should only
+  /// open the file.
+  uint64_t preloadBytesLimit() const {
+    return preloadBytesLimit_;
+  }
+
  private:
   memory::MemoryPool* const operatorPool_;
   memory::MemoryPool* const connectorPool_;
@@ -348,6 +392,7 @@ class ConnectorQueryCtx {
   const int driverId_;
   const std::string planNodeId_;
   const folly::CancellationToken cancellationToken_;
+  uint64_t preloadBytesLimit_{0};
 };
 
 class Connector {
@@ -395,10 +440,12 @@ class Connector {
   /// Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   /// tracker and different threads will share the same
   /// instance. 'loadQuantum' is the largest single IO for the query
-  /// being tracked.
+  /// being tracked. If 'table' is given, the columns the scan read are
+  /// recorded in cache::columnAccessHistory() when the scan finishes.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      std::string_view table = {});
 
   virtual folly::Executor* executor() const {
     return nullptr;
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/CacheWarmer.h"
+
+#include <folly/container/F14Set.h>
+#include <thread>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/caching/ColumnAccessHistory.h"
+#include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive {
+namespace {
+
+// Returns true if 'node' or a node below it is in 'columns'.
+bool containsColumn(
+    const dwio::common::TypeWithId& node,
+    const folly::F14FastSet<int32_t>& columns) {
+  if (columns.count(node.id()) > 0) {
+    return true;
+  }
+  for (auto i = 0; i < node.size(); ++i) {
+    if (containsColumn(*node.childAt(i), columns)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+CacheWarmer::CacheWarmer(
+    cache::AsyncDataCache* cache,
+    std::shared_ptr<memory::MemoryPool> pool,
+    folly::Executor* executor,
+    const Options& options)
+    : cache_(cache),
+      pool_(std::move(pool)),
+      executor_(executor),
+      options_(options) {
+  VELOX_CHECK_NOT_NULL(cache_);
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(options_.bytesPerSecond, 0);
+  cache::columnAccessHistory().setEnabled(true);
+}
+
+CacheWarmer::~CacheWarmer() {
+  std::unique_lock<std::mutex> l(mutex_);
+  shutdown_ = true;
+  pending_.clear();
+  idle_.wait(l, [&]() { return !running_; });
+}
+
+bool CacheWarmer::warm(
+    const std::string& table,
+    const std::string& filePath,
+    dwio::common::FileFormat format) {
+  if (format != dwio::common::FileFormat::DWRF &&
+      format != dwio::common::FileFormat::ORC) {
+    return false;
+  }
+  auto columns =
+      cache::columnAccessHistory().predictColumns(table, options_.minScanPct);
+  if (columns.empty()) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!shutdown_);
+    if (pending_.size() >= static_cast<size_t>(options_.maxPendingFiles)) {
+      ++stats_.numSkippedFiles;
+      RECORD_METRIC_VALUE(kMetricCacheWarmSkippedFiles);
+      return false;
+    }
+    pending_.push_back({filePath, format, std::move(columns)});
+    if (running_) {
+      return true;
+    }
+    running_ = true;
+  }
+  executor_->add([this]() { drain(); });
+  return true;
+}
+
+void CacheWarmer::drain() {
+  process::TraceContext trace("CacheWarmer::drain");
+  for (;;) {
+    Request request;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (pending_.empty() || shutdown_) {
+        running_ = false;
+        idle_.notify_all();
+        return;
+      }
+      request = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    int64_t bytes = 0;
+    try {
+      bytes = warmFile(request);
+    } catch (const std::exception& e) {
+      // Warming is best effort. The file may have been removed or rewritten.
+      LOG(WARNING) << "Failed to warm the cache with " << request.filePath
+                   << ": " << e.what();
+      continue;
+    }
+    RECORD_METRIC_VALUE(kMetricCacheWarmFiles);
+    RECORD_METRIC_VALUE(kMetricCacheWarmBytes, bytes);
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numFiles;
+    stats_.bytes += bytes;
+  }
+}
+
+int64_t CacheWarmer::warmFile(const Request& request) {
+  auto fileHandle = FileHandleGenerator()(request.filePath, nullptr);
+  dwio::common::ReaderOptions readerOptions(pool_.get());
+  readerOptions.setFileFormat(request.format);
+  readerOptions.setCacheWarm(true);
+  auto ioStats = std::make_shared<io::IoStatistics>();
+  auto input = std::make_unique<dwio::common::CachedBufferedInput>(
+      fileHandle->file,
+      dwio::common::MetricsLog::voidLog(),
+      fileHandle->uuid.id(),
+      cache_,
+      nullptr,
+      fileHandle->groupId.id(),
+      ioStats,
+      nullptr,
+      readerOptions);
+  auto reader = dwio::common::getReaderFactory(request.format)
+                    ->createReader(std::move(input), readerOptions);
+
+  const folly::F14FastSet<int32_t> columns(
+      request.columns.begin(), request.columns.end());
+  const auto& fileType = reader->rowType();
+  const auto& typeWithId = reader->typeWithId();
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < fileType->size(); ++i) {
+    if (!containsColumn(*typeWithId->childAt(i), columns)) {
+      continue;
+    }
+    scanSpec->addFieldRecursively(
+        fileType->nameOf(i), *fileType->childAt(i), names.size());
+    names.push_back(fileType->nameOf(i));
+    types.push_back(fileType->childAt(i));
+  }
+  if (names.empty()) {
+    return 0;
+  }
+
+  dwio::common::RowReaderOptions rowReaderOptions;
+  rowReaderOptions.setScanSpec(scanSpec);
+  rowReaderOptions.setRequestedType(fileType);
+  auto rowReader = reader->createRowReader(rowReaderOptions);
+  VectorPtr batch = BaseVector::create(
+      ROW(std::move(names), std::move(types)), 0, pool_.get());
+  int64_t bytesRead = 0;
+  while (rowReader->next(options_.batchSize, batch) > 0) {
+    // Columns without filters come back lazy. Loading them reads them.
+    for (auto& child : batch->as<RowVector>()->children()) {
+      child->loadedVector();
+    }
+    const auto totalBytes = static_cast<int64_t>(ioStats->rawBytesRead());
+    throttle(totalBytes - bytesRead);
+    bytesRead = totalBytes;
+    std::lock_guard<std::mutex> l(mutex_);
+    if (shutdown_) {
+      break;
+    }
+  }
+  return bytesRead;
+}
+
+void CacheWarmer::throttle(int64_t bytes) {
+  const uint64_t nowUs = getCurrentTimeMicro();
+  const auto budgetUs = [&]() -> uint64_t {
+    return budgetBytes_ * 1'000'000 / options_.bytesPerSecond;
+  };
+  // Unused budget expires after a second so that warming after an idle
+  // period does not read in a burst.
+  if (nowUs > budgetStartUs_ + budgetUs() + 1'000'000) {
+    budgetStartUs_ = nowUs;
+    budgetBytes_ = 0;
+  }
+  budgetBytes_ += bytes;
+  const auto dueUs = budgetStartUs_ + budgetUs();
+  if (dueUs > nowUs) {
+    std::this_thread::sleep_for(std::chrono::microseconds(dueUs - nowUs));
+  }
+}
+
+void CacheWarmer::waitForIdle() {
+  std::unique_lock<std::mutex> l(mutex_);
+  idle_.wait(l, [&]() { return !running_; });
+}
+
+CacheWarmer::Stats CacheWarmer::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+} // namespace facebook::velox::connector::hive
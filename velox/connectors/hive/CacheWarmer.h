@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Loads the columns that recent scans of a table read from files newly added
+/// to the table into the AsyncDataCache, and through it the SsdCache, before
+/// a query reads them. Recurring queries, e.g. dashboards, read the same
+/// columns of each new partition, see cache::ColumnAccessHistory. Files are
+/// warmed one at a time on an executor and reads from storage are kept under
+/// a bandwidth budget so that warming does not compete with queries.
+class CacheWarmer {
+ public:
+  struct Options {
+    /// Upper limit for the rate of reads from storage.
+    int64_t bytesPerSecond{64 << 20};
+
+    /// The columns read by at least this % of the recent scans of a table are
+    /// warmed.
+    int32_t minScanPct{50};
+
+    /// Files to warm beyond this many waiting files are dropped.
+    int32_t maxPendingFiles{1'000};
+
+    /// Number of rows read at a time.
+    int32_t batchSize{10'000};
+  };
+
+  struct Stats {
+    int64_t numFiles{0};
+    int64_t numSkippedFiles{0};
+    int64_t bytes{0};
+  };
+
+  /// Warms 'cache' with reads on 'executor' that allocate from 'pool'. Enables
+  /// cache::columnAccessHistory() so that finished scans are recorded.
+  CacheWarmer(
+      cache::AsyncDataCache* cache,
+      std::shared_ptr<memory::MemoryPool> pool,
+      folly::Executor* executor,
+      const Options& options);
+
+  /// Drops the waiting files and waits for the file being warmed.
+  ~CacheWarmer();
+
+  /// Schedules warming of the predicted columns of 'filePath', a newly added
+  /// file of 'table'. Returns false if the file will not be warmed because
+  /// 'table' has no columns that qualify or too many files are waiting. Only
+  /// DWRF and ORC files are warmed since the columns in the history are nodes
+  /// of their file schema.
+  bool warm(
+      const std::string& table,
+      const std::string& filePath,
+      dwio::common::FileFormat format);
+
+  /// Waits until no file is waiting or being warmed.
+  void waitForIdle();
+
+  Stats stats() const;
+
+ private:
+  struct Request {
+    std::string filePath;
+    dwio::common::FileFormat format;
+    std::vector<int32_t> columns;
+  };
+
+  // Warms the waiting files one after the other. Runs on 'executor_'.
+  void drain();
+
+  // Reads the subtrees of the top level columns of the file of 'request' that
+  // contain a predicted column. Returns the bytes read from storage.
+  int64_t warmFile(const Request& request);
+
+  // Sleeps as long as needed to keep the reads, including 'bytes' more, under
+  // the bandwidth budget.
+  void throttle(int64_t bytes);
+
+  cache::AsyncDataCache* const cache_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  folly::Executor* const executor_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable idle_;
+  std::deque<Request> pending_;
+  bool running_{false};
+  bool shutdown_{false};
+  Stats stats_;
+
+  // Start of the interval the budget is counted over and the bytes read in it.
+  // Accessed only by the warming thread.
+  uint64_t budgetStartUs_{0};
+  int64_t budgetBytes_{0};
+};
+
+} // namespace facebook::velox::connector::hive
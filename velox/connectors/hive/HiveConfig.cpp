@@ -65,6 +65,20 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* session) const {
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 100));
 }
 
+uint32_t HiveConfig::maxOpenPartitionWriters(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenPartitionWritersSession,
+      config_->get<uint32_t>(kMaxOpenPartitionWriters, 0));
+}
+
+uint64_t HiveConfig::maxTargetFileSizeBytes(const Config* session) const {
+  return toCapacity(
+      session->get<std::string>(
+          kMaxTargetFileSizeSession,
+          config_->get<std::string>(kMaxTargetFileSize, "0B")),
+      core::CapacityUnit::BYTE);
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -130,6 +144,14 @@ std::optional<std::string> HiveConfig::s3RetryMode() const {
       config_->get<std::string>(kS3RetryMode));
 }
 
+uint32_t HiveConfig::s3ReadMaxConcurrency() const {
+  return config_->get<uint32_t>(kS3ReadMaxConcurrency, 8);
+}
+
+uint64_t HiveConfig::s3ReadCoalesceGapBytes() const {
+  return config_->get<uint64_t>(kS3ReadCoalesceGapBytes, 1 << 20);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -151,6 +173,38 @@ std::optional<std::string> HiveConfig::gcsMaxRetryTime() const {
       config_->get<std::string>(kGCSMaxRetryTime));
 }
 
+uint32_t HiveConfig::hdfsReadMaxConcurrency() const {
+  return config_->get<uint32_t>(kHdfsReadMaxConcurrency, 16);
+}
+
+uint32_t HiveConfig::hdfsReadMaxConcurrencyPerDatanode() const {
+  return config_->get<uint32_t>(kHdfsReadMaxConcurrencyPerDatanode, 4);
+}
+
+bool HiveConfig::hdfsShortCircuitRead() const {
+  return config_->get<bool>(kHdfsShortCircuitRead, false);
+}
+
+std::string HiveConfig::hdfsDomainSocketPath() const {
+  return config_->get<std::string>(kHdfsDomainSocketPath, std::string(""));
+}
+
+uint32_t HiveConfig::gcsMaxConcurrency() const {
+  return config_->get<uint32_t>(kGCSMaxConcurrency, 8);
+}
+
+uint64_t HiveConfig::gcsUploadPartSize() const {
+  return config_->get<uint64_t>(kGCSUploadPartSize, 32 << 20);
+}
+
+uint32_t HiveConfig::abfsMaxConcurrency() const {
+  return config_->get<uint32_t>(kAbfsMaxConcurrency, 8);
+}
+
+uint64_t HiveConfig::abfsUploadBlockSize() const {
+  return config_->get<uint64_t>(kAbfsUploadBlockSize, 8 << 20);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const Config* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
@@ -178,6 +232,10 @@ int32_t HiveConfig::maxCoalescedDistanceBytes() const {
   return config_->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+bool HiveConfig::adaptiveCoalesce() const {
+  return config_->get<bool>(kAdaptiveCoalesce, false);
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
@@ -186,6 +244,10 @@ int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
 
+bool HiveConfig::decompressAhead() const {
+  return config_->get<bool>(kDecompressAhead, false);
+}
+
 int32_t HiveConfig::numCacheFileHandles() const {
   return config_->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
@@ -194,6 +256,14 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileMetadataCacheMaxEntries() const {
+  return config_->get<uint64_t>(kFileMetadataCacheMaxEntries, 100'000);
+}
+
+uint64_t HiveConfig::fileMetadataCacheTtlMs() const {
+  return config_->get<uint64_t>(kFileMetadataCacheTtlMs, 300'000);
+}
+
 uint64_t HiveConfig::orcWriterMaxStripeSize(const Config* session) const {
   return toCapacity(
       session->get<std::string>(
@@ -260,6 +330,23 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::sortWriterZOrder(const Config* session) const {
+  return session->get<bool>(
+      kSortWriterZOrderSession, config_->get<bool>(kSortWriterZOrder, false));
+}
+
+uint64_t HiveConfig::sortWriterStripeRows(const Config* session) const {
+  return session->get<uint64_t>(
+      kSortWriterStripeRowsSession,
+      config_->get<uint64_t>(kSortWriterStripeRows, 0));
+}
+
+bool HiveConfig::sortWriterPresortedInput(const Config* session) const {
+  return session->get<bool>(
+      kSortWriterPresortedInputSession,
+      config_->get<bool>(kSortWriterPresortedInput, false));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -283,10 +370,52 @@ uint8_t HiveConfig::parquetWriteTimestampUnit(const Config* session) const {
   return unit;
 }
 
+bool HiveConfig::parquetWriterPageIndexEnabled(const Config* session) const {
+  return session->get<bool>(
+      kParquetWriterPageIndexEnabledSession,
+      config_->get<bool>(kParquetWriterPageIndexEnabled, false));
+}
+
+std::vector<std::string> HiveConfig::parquetWriterBloomFilterColumns(
+    const Config* session) const {
+  const auto columns = session->get<std::string>(
+      kParquetWriterBloomFilterColumnsSession,
+      config_->get<std::string>(kParquetWriterBloomFilterColumns, ""));
+  std::vector<std::string> names;
+  if (columns.empty()) {
+    return names;
+  }
+  boost::algorithm::split(names, columns, boost::is_any_of(","));
+  for (auto& name : names) {
+    boost::algorithm::trim(name);
+  }
+  names.erase(std::remove(names.begin(), names.end(), ""), names.end());
+  return names;
+}
+
 bool HiveConfig::cacheNoRetention(const Config* session) const {
   return session->get<bool>(
       kCacheNoRetentionSession,
       config_->get<bool>(kCacheNoRetention, /*defaultValue=*/false));
 }
 
+bool HiveConfig::sharedScanEnabled(const Config* session) const {
+  return session->get<bool>(
+      kSharedScanEnabledSession, config_->get<bool>(kSharedScanEnabled, false));
+}
+
+int32_t HiveConfig::sharedScanMaxBufferedBatches() const {
+  return config_->get<int32_t>(kSharedScanMaxBufferedBatches, 8);
+}
+
+int64_t HiveConfig::sharedScanMaxMemoryBytes() const {
+  return config_->get<int64_t>(kSharedScanMaxMemoryBytes, 256 << 20);
+}
+
+bool HiveConfig::icebergDeleteBitmapCacheEnabled(const Config* session) const {
+  return session->get<bool>(
+      kIcebergDeleteBitmapCacheEnabledSession,
+      config_->get<bool>(kIcebergDeleteBitmapCacheEnabled, false));
+}
+
 } // namespace facebook::velox::connector::hive
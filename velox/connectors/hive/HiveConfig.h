@@ -52,6 +52,22 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of (bucketed) partition file writers a single table
+  /// writer instance keeps open. Rows of the partitions seen after the limit
+  /// is reached are buffered, spilled if needed, sorted by partition and
+  /// written at close with one writer open at a time. Zero means no limit.
+  static constexpr const char* kMaxOpenPartitionWriters =
+      "max-open-partition-writers";
+  static constexpr const char* kMaxOpenPartitionWritersSession =
+      "max_open_partition_writers";
+
+  /// Size after which the writer of a non-bucketed (partition of a) table
+  /// closes its file and continues in a new one. The size is checked after
+  /// each write, so files get larger by up to a stripe. Zero means no limit.
+  static constexpr const char* kMaxTargetFileSize = "max-target-file-size";
+  static constexpr const char* kMaxTargetFileSizeSession =
+      "max_target_file_size";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -104,6 +120,15 @@ class HiveConfig {
   /// Retry mode for a single http client.
   static constexpr const char* kS3RetryMode = "hive.s3.retry-mode";
 
+  /// Maximum number of concurrent GET requests of a single S3 file.
+  static constexpr const char* kS3ReadMaxConcurrency =
+      "hive.s3.read-max-concurrency";
+
+  /// Ranges of a multi-range S3 read that are at most this many bytes apart
+  /// are read by a single GET request.
+  static constexpr const char* kS3ReadCoalesceGapBytes =
+      "hive.s3.read-coalesce-gap-bytes";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -119,6 +144,42 @@ class HiveConfig {
   /// The GCS maximum time allowed to retry transient errors.
   static constexpr const char* kGCSMaxRetryTime = "hive.gcs.max-retry-time";
 
+  /// Maximum number of concurrent reads of an HDFS file system.
+  static constexpr const char* kHdfsReadMaxConcurrency =
+      "hive.hdfs.read-max-concurrency";
+
+  /// Maximum number of concurrent reads of an HDFS file system from a single
+  /// datanode.
+  static constexpr const char* kHdfsReadMaxConcurrencyPerDatanode =
+      "hive.hdfs.read-max-concurrency-per-datanode";
+
+  /// Whether HDFS reads of blocks stored on the local host bypass the datanode
+  /// and read the block files directly.
+  static constexpr const char* kHdfsShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// The UNIX domain socket shared with the local datanode for short-circuit
+  /// reads.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
+  /// Maximum number of concurrent requests of the ranged reads and part
+  /// uploads of a GCS file system.
+  static constexpr const char* kGCSMaxConcurrency = "hive.gcs.max-concurrency";
+
+  /// Size of the parts a GCS file is uploaded in. The parts are uploaded in
+  /// parallel and composed into the file on close.
+  static constexpr const char* kGCSUploadPartSize = "hive.gcs.upload-part-size";
+
+  /// Maximum number of concurrent requests of the ranged reads and block
+  /// appends of an ABFS file system.
+  static constexpr const char* kAbfsMaxConcurrency =
+      "hive.abfs.max-concurrency";
+
+  /// Size of the blocks an ABFS file is appended in.
+  static constexpr const char* kAbfsUploadBlockSize =
+      "hive.abfs.upload-block-size";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -145,6 +206,10 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Choose the max coalesce distance and bytes from the latency and
+  /// bandwidth observed on the storage of the files.
+  static constexpr const char* kAdaptiveCoalesce = "adaptive-coalesce";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
@@ -152,6 +217,11 @@ class HiveConfig {
   /// quantum size is supported when SSD cache is enabled.
   static constexpr const char* kLoadQuantum = "load-quantum";
 
+  /// Decompress the streams of a split on the IO executor ahead of their use
+  /// instead of on the thread decoding them. Applies to DWRF/ORC files read
+  /// through a cache or direct buffered input with an executor.
+  static constexpr const char* kDecompressAhead = "decompress-ahead";
+
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
@@ -159,6 +229,17 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Maximum number of entries in the file metadata cache of the object store
+  /// file systems, which saves the metadata request when a file is opened
+  /// without a known size.
+  static constexpr const char* kFileMetadataCacheMaxEntries =
+      "file-metadata-cache-max-entries";
+
+  /// Time in milliseconds after which an entry of the file metadata cache
+  /// expires.
+  static constexpr const char* kFileMetadataCacheTtlMs =
+      "file-metadata-cache-ttl-ms";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -216,6 +297,27 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Whether the sort writer clusters rows in Z-order of the sort columns.
+  static constexpr const char* kSortWriterZOrder = "sort-writer-z-order";
+  static constexpr const char* kSortWriterZOrderSession =
+      "sort_writer_z_order";
+
+  /// Target number of rows in a stripe or row group written by the sort
+  /// writer. 0 leaves stripe boundaries to the file writer.
+  static constexpr const char* kSortWriterStripeRows =
+      "sort-writer-stripe-rows";
+  static constexpr const char* kSortWriterStripeRowsSession =
+      "sort_writer_stripe_rows";
+
+  /// Whether the input of a sorted bucketed table write already arrives
+  /// sorted on the sort columns, e.g. from a merge exchange. The sort writer
+  /// then writes rows as they come. If the first batch of a file is out of
+  /// order, the file is sorted as usual.
+  static constexpr const char* kSortWriterPresortedInput =
+      "sort-writer-presorted-input";
+  static constexpr const char* kSortWriterPresortedInputSession =
+      "sort_writer_presorted_input";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -225,14 +327,52 @@ class HiveConfig {
   static constexpr const char* kParquetWriteTimestampUnitSession =
       "hive.parquet.writer.timestamp_unit";
 
+  /// Whether to write the ColumnIndex and OffsetIndex of Parquet column chunks.
+  static constexpr const char* kParquetWriterPageIndexEnabled =
+      "hive.parquet.writer.page-index-enabled";
+  static constexpr const char* kParquetWriterPageIndexEnabledSession =
+      "hive.parquet.writer.page_index_enabled";
+
+  /// Comma separated names of the columns to write Parquet Bloom filters for.
+  static constexpr const char* kParquetWriterBloomFilterColumns =
+      "hive.parquet.writer.bloom-filter-columns";
+  static constexpr const char* kParquetWriterBloomFilterColumnsSession =
+      "hive.parquet.writer.bloom_filter_columns";
+
   static constexpr const char* kCacheNoRetention = "cache.no_retention";
   static constexpr const char* kCacheNoRetentionSession = "cache.no_retention";
 
+  /// Whether concurrent scans of the same split decode it once.
+  static constexpr const char* kSharedScanEnabled = "shared-scan-enabled";
+  static constexpr const char* kSharedScanEnabledSession =
+      "shared_scan_enabled";
+
+  /// Maximum number of decoded batches a shared scan keeps for the scans that
+  /// have not read them.
+  static constexpr const char* kSharedScanMaxBufferedBatches =
+      "shared-scan-max-buffered-batches";
+
+  /// Maximum memory in bytes of the decoded batches and the reader of one
+  /// shared scan.
+  static constexpr const char* kSharedScanMaxMemoryBytes =
+      "shared-scan-max-memory-bytes";
+
+  /// Whether the positional deletes of an Iceberg data file are decoded once
+  /// into a bitmap that is cached for all the splits that read the file.
+  static constexpr const char* kIcebergDeleteBitmapCacheEnabled =
+      "iceberg.delete-bitmap-cache-enabled";
+  static constexpr const char* kIcebergDeleteBitmapCacheEnabledSession =
+      "iceberg.delete_bitmap_cache_enabled";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* session) const;
 
   uint32_t maxPartitionsPerWriters(const Config* session) const;
 
+  uint32_t maxOpenPartitionWriters(const Config* session) const;
+
+  uint64_t maxTargetFileSizeBytes(const Config* session) const;
+
   bool immutablePartitions() const;
 
   bool s3UseVirtualAddressing() const;
@@ -263,6 +403,10 @@ class HiveConfig {
 
   std::optional<std::string> s3RetryMode() const;
 
+  uint32_t s3ReadMaxConcurrency() const;
+
+  uint64_t s3ReadCoalesceGapBytes() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -273,6 +417,22 @@ class HiveConfig {
 
   std::optional<std::string> gcsMaxRetryTime() const;
 
+  uint32_t hdfsReadMaxConcurrency() const;
+
+  uint32_t hdfsReadMaxConcurrencyPerDatanode() const;
+
+  bool hdfsShortCircuitRead() const;
+
+  std::string hdfsDomainSocketPath() const;
+
+  uint32_t gcsMaxConcurrency() const;
+
+  uint64_t gcsUploadPartSize() const;
+
+  uint32_t abfsMaxConcurrency() const;
+
+  uint64_t abfsUploadBlockSize() const;
+
   bool isOrcUseColumnNames(const Config* session) const;
 
   bool isFileColumnNamesReadAsLowerCase(const Config* session) const;
@@ -285,14 +445,22 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes() const;
 
+  bool adaptiveCoalesce() const;
+
   int32_t prefetchRowGroups() const;
 
   int32_t loadQuantum() const;
 
+  bool decompressAhead() const;
+
   int32_t numCacheFileHandles() const;
 
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileMetadataCacheMaxEntries() const;
+
+  uint64_t fileMetadataCacheTtlMs() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   uint64_t orcWriterMaxStripeSize(const Config* session) const;
@@ -311,6 +479,12 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  bool sortWriterZOrder(const Config* session) const;
+
+  uint64_t sortWriterStripeRows(const Config* session) const;
+
+  bool sortWriterPresortedInput(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -321,6 +495,13 @@ class HiveConfig {
   /// through Arrow bridge. 0: second, 3: milli, 6: micro, 9: nano.
   uint8_t parquetWriteTimestampUnit(const Config* session) const;
 
+  /// Returns true if Parquet files are written with page indexes.
+  bool parquetWriterPageIndexEnabled(const Config* session) const;
+
+  /// Returns the names of the columns Parquet files have Bloom filters for.
+  std::vector<std::string> parquetWriterBloomFilterColumns(
+      const Config* session) const;
+
   /// Returns true to evict out a query scanned data out of in-memory cache
   /// right after the access, and also skip staging to the ssd cache. This helps
   /// to prevent the cache space pollution from the one-time table scan by large
@@ -328,6 +509,18 @@ class HiveConfig {
   /// locality.
   bool cacheNoRetention(const Config* session) const;
 
+  /// Returns true if concurrent scans of the same split share one decoding of
+  /// it, see SharedScan.
+  bool sharedScanEnabled(const Config* session) const;
+
+  int32_t sharedScanMaxBufferedBatches() const;
+
+  int64_t sharedScanMaxMemoryBytes() const;
+
+  /// Returns true if the positional deletes of Iceberg splits are read from
+  /// the process-wide DeletionBitmapCache.
+  bool icebergDeleteBitmapCacheEnabled(const Config* session) const;
+
   HiveConfig(std::shared_ptr<const Config> config) {
     VELOX_CHECK_NOT_NULL(
         config, "Config is null for HiveConfig initialization");
@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileProperties.h"
 #include "velox/connectors/hive/TableHandle.h"
@@ -62,6 +64,12 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   /// the file handle.
   std::optional<FileProperties> properties;
 
+  /// Reads only part 'stripePart' of 'numStripeParts' parts of each stripe in
+  /// the split's range. Splits over the same range with different parts let
+  /// several drivers share the decoding of large DWRF and ORC stripes.
+  uint32_t stripePart{0};
+  uint32_t numStripeParts{1};
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -102,10 +110,90 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  std::optional<int32_t> bucketId() const override {
+    return tableBucketNumber;
+  }
+
+  /// The file is identified by its path, size and modification time. Splits
+  /// without these properties, with a bucket conversion or with extra file
+  /// info, e.g. delete files, have no key.
+  std::optional<std::string> cacheKey() const override {
+    if (!properties.has_value() || !properties->fileSize.has_value() ||
+        !properties->modificationTime.has_value() ||
+        bucketConversion.has_value() || extraFileInfo != nullptr) {
+      return std::nullopt;
+    }
+    std::string key = fmt::format(
+        "{}:{}:{}:{}:{}:{}:{}/{}:{}",
+        filePath,
+        properties->fileSize.value(),
+        properties->modificationTime.value(),
+        start,
+        length,
+        static_cast<int>(fileFormat),
+        stripePart,
+        numStripeParts,
+        tableBucketNumber.has_value() ? tableBucketNumber.value() : -1);
+    // The values of these maps are added to the rows or change how these are
+    // read.
+    const std::map<std::string, std::optional<std::string>> sortedKeys(
+        partitionKeys.begin(), partitionKeys.end());
+    for (const auto& [name, value] : sortedKeys) {
+      key.append(fmt::format(":{}={}", name, value.value_or("<null>")));
+    }
+    for (const auto* values : {&infoColumns, &serdeParameters}) {
+      const std::map<std::string, std::string> sorted(
+          values->begin(), values->end());
+      for (const auto& [name, value] : sorted) {
+        key.append(fmt::format(":{}={}", name, value));
+      }
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
   }
 };
 
+/// Several small files read as one split. The files are read one after the
+/// other by the same HiveDataSource, which keeps the ScanSpec and its
+/// adaptation across the files and opens the file handles and reads the
+/// footers of the later files in the background while reading the first. This
+/// saves the per-split overhead of the driver and of opening each file on the
+/// query thread when a table has many tiny files. Each file keeps its own
+/// partition keys, info columns and properties.
+struct HiveMultiFileConnectorSplit : public connector::ConnectorSplit {
+  const std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+
+  HiveMultiFileConnectorSplit(
+      const std::string& connectorId,
+      std::vector<std::shared_ptr<HiveConnectorSplit>> _splits,
+      int64_t _splitWeight = 0)
+      : ConnectorSplit(connectorId, _splitWeight), splits(std::move(_splits)) {
+    VELOX_CHECK(!splits.empty(), "Multi-file split must have a file");
+    for (const auto& split : splits) {
+      VELOX_CHECK_NOT_NULL(split);
+      VELOX_CHECK_EQ(split->connectorId, connectorId);
+    }
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "Hive: {} files, first {}", splits.size(), splits[0]->toString());
+  }
+
+  /// The bucket of the files if all files are of the same bucket.
+  std::optional<int32_t> bucketId() const override {
+    const auto bucket = splits[0]->bucketId();
+    for (const auto& split : splits) {
+      if (split->bucketId() != bucket) {
+        return std::nullopt;
+      }
+    }
+    return bucket;
+  }
+};
+
 } // namespace facebook::velox::connector::hive
@@ -362,7 +362,8 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         infoColumns,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const std::vector<SubfieldFilters>& disjunctions) {
   auto spec = std::make_shared<common::ScanSpec>("root");
   folly::F14FastMap<std::string, std::vector<const common::Subfield*>>
       filterSubfields;
@@ -375,6 +376,11 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
       filterSubfields[getColumnName(subfield)].push_back(&subfield);
     }
   }
+  for (const auto& disjunction : disjunctions) {
+    for (auto& [subfield, _] : disjunction) {
+      filterSubfields[getColumnName(subfield)].push_back(&subfield);
+    }
+  }
 
   int numChildren = 0;
   // Process columns that will be projected out.
@@ -441,6 +447,16 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
     fieldSpec->addFilter(*pair.second);
   }
 
+  for (const auto& disjunction : disjunctions) {
+    std::vector<common::ScanSpec*> children;
+    for (auto& [subfield, filter] : disjunction) {
+      auto* fieldSpec = spec->getOrCreateChild(subfield);
+      fieldSpec->setFilter(filter->clone());
+      children.push_back(fieldSpec);
+    }
+    spec->addDisjunction(children);
+  }
+
   return spec;
 }
 
@@ -530,8 +546,10 @@ void configureReaderOptions(
     const std::shared_ptr<const HiveConnectorSplit>& hiveSplit,
     const std::unordered_map<std::string, std::string>& tableParameters) {
   readerOptions.setLoadQuantum(hiveConfig->loadQuantum());
+  readerOptions.setDecompressAhead(hiveConfig->decompressAhead());
   readerOptions.setMaxCoalesceBytes(hiveConfig->maxCoalescedBytes());
   readerOptions.setMaxCoalesceDistance(hiveConfig->maxCoalescedDistanceBytes());
+  readerOptions.setAdaptiveCoalesce(hiveConfig->adaptiveCoalesce());
   readerOptions.setFileColumnNamesReadAsLowerCase(
       hiveConfig->isFileColumnNamesReadAsLowerCase(sessionProperties));
   readerOptions.setUseColumnNamesForColumnMapping(
@@ -576,6 +594,15 @@ void configureRowReaderOptions(
   rowReaderOptions.setMetadataFilter(std::move(metadataFilter));
   rowReaderOptions.setRequestedType(rowType);
   rowReaderOptions.range(hiveSplit->start, hiveSplit->length);
+  if (hiveSplit->numStripeParts > 1) {
+    VELOX_USER_CHECK(
+        hiveSplit->fileFormat == dwio::common::FileFormat::DWRF ||
+            hiveSplit->fileFormat == dwio::common::FileFormat::ORC,
+        "Stripe parts are not supported for file format {}",
+        dwio::common::toString(hiveSplit->fileFormat));
+    rowReaderOptions.setStripePart(
+        hiveSplit->stripePart, hiveSplit->numStripeParts);
+  }
 }
 
 namespace {
@@ -616,6 +643,16 @@ bool applyPartitionFilter(
 
 } // namespace
 
+bool testPartitionFilter(
+    const TypePtr& type,
+    const std::optional<std::string>& partitionValue,
+    common::Filter* filter) {
+  if (!partitionValue.has_value()) {
+    return !filter->isDeterministic() || filter->testNull();
+  }
+  return applyPartitionFilter(type, partitionValue.value(), filter);
+}
+
 bool testFilters(
     const common::ScanSpec* scanSpec,
     const dwio::common::Reader* reader,
@@ -628,7 +665,9 @@ bool testFilters(
   const auto& fileTypeWithId = reader->typeWithId();
   const auto& rowType = reader->rowType();
   for (const auto& child : scanSpec->children()) {
-    if (child->filter()) {
+    // A member of a disjunction cannot skip the split on its own.
+    if (child->filter() &&
+        child->disjunction() == common::ScanSpec::kNoDisjunction) {
       const auto& name = child->fieldName();
       auto iter = partitionKey.find(name);
       // By design, the partition key columns for Iceberg tables are included in
@@ -639,11 +678,18 @@ bool testFilters(
           auto handlesIter = partitionKeysHandle.find(name);
           VELOX_CHECK(handlesIter != partitionKeysHandle.end());
 
-          // This is a non-null partition key
-          return applyPartitionFilter(
-              handlesIter->second->dataType(),
-              iter->second.value(),
-              child->filter());
+          // This is a non-null partition key. The filters on the other
+          // columns may still skip the split.
+          if (!applyPartitionFilter(
+                  handlesIter->second->dataType(),
+                  iter->second.value(),
+                  child->filter())) {
+            VLOG(1) << "Skipping " << filePath
+                    << " based on the value of partition key "
+                    << child->fieldName();
+            return false;
+          }
+          continue;
         }
         // Column is missing, most likely due to schema evolution. Or it's a
         // partition key but the partition value is NULL.
@@ -680,7 +726,8 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
-    folly::Executor* executor) {
+    folly::Executor* executor,
+    std::string_view table) {
   if (connectorQueryCtx->cache()) {
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
@@ -688,7 +735,7 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
         fileHandle.uuid.id(),
         connectorQueryCtx->cache(),
         Connector::getTracker(
-            connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+            connectorQueryCtx->scanId(), readerOpts.loadQuantum(), table),
         fileHandle.groupId.id(),
         ioStats,
         executor,
@@ -699,7 +746,7 @@ std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
       dwio::common::MetricsLog::voidLog(),
       fileHandle.uuid.id(),
       Connector::getTracker(
-          connectorQueryCtx->scanId(), readerOpts.loadQuantum()),
+          connectorQueryCtx->scanId(), readerOpts.loadQuantum(), table),
       fileHandle.groupId.id(),
       std::move(ioStats),
       executor,
@@ -47,6 +47,8 @@ void checkColumnNameLowerCase(
 
 void checkColumnNameLowerCase(const core::TypedExprPtr& typeExpr);
 
+/// Each of 'disjunctions' holds filters on whole columns that are not
+/// otherwise read, of which a row must pass at least one.
 std::shared_ptr<common::ScanSpec> makeScanSpec(
     const RowTypePtr& rowType,
     const folly::F14FastMap<std::string, std::vector<const common::Subfield*>>&
@@ -58,7 +60,8 @@ std::shared_ptr<common::ScanSpec> makeScanSpec(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         infoColumns,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    const std::vector<SubfieldFilters>& disjunctions = {});
 
 void configureReaderOptions(
     dwio::common::ReaderOptions& readerOptions,
@@ -83,6 +86,13 @@ void configureRowReaderOptions(
     const RowTypePtr& rowType,
     const std::shared_ptr<const HiveConnectorSplit>& hiveSplit);
 
+/// Returns false if no row of a split whose partition key of 'type' has
+/// 'partitionValue' can pass 'filter'. std::nullopt is a NULL partition value.
+bool testPartitionFilter(
+    const TypePtr& type,
+    const std::optional<std::string>& partitionValue,
+    common::Filter* filter);
+
 bool testFilters(
     const common::ScanSpec* scanSpec,
     const dwio::common::Reader* reader,
@@ -92,12 +102,15 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns the input for reading 'fileHandle'. 'table' names the table that
+/// the reads are tracked for in cache::columnAccessHistory(), if given.
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
     const ConnectorQueryCtx* connectorQueryCtx,
     std::shared_ptr<io::IoStatistics> ioStats,
-    folly::Executor* executor);
+    folly::Executor* executor,
+    std::string_view table = {});
 
 core::TypedExprPtr extractFiltersFromRemainingFilter(
     const core::TypedExprPtr& expr,
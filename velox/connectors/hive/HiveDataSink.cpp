@@ -366,6 +366,10 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      maxOpenPartitionWriters_(hiveConfig_->maxOpenPartitionWriters(
+          connectorQueryCtx->sessionProperties())),
+      maxTargetFileSize_(hiveConfig_->maxTargetFileSizeBytes(
+          connectorQueryCtx->sessionProperties())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -470,9 +474,14 @@ void HiveDataSink::appendData(RowVectorPtr input) {
         : exec::wrap(partitionSize, partitionRows_[index], input);
     write(index, writerInput);
   }
+
+  if (numDeferredRows_ > 0) {
+    deferRows(input);
+  }
 }
 
 void HiveDataSink::write(size_t index, RowVectorPtr input) {
+  index = maybeRotateWriter(index);
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   auto dataInput = makeDataInput(dataChannels_, input);
 
@@ -480,6 +489,22 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
   writerInfo_[index]->numWrittenRows += dataInput->size();
 }
 
+uint32_t HiveDataSink::maybeRotateWriter(uint32_t index) {
+  // Bucketed tables have one file per bucket.
+  if (maxTargetFileSize_ == 0 || isBucketed() ||
+      ioStats_[index]->rawBytesWritten() < maxTargetFileSize_) {
+    return index;
+  }
+  closeWriter(index);
+  return appendWriter(writerIds_[index]);
+}
+
+void HiveDataSink::closeWriter(uint32_t index) {
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+  writers_[index]->close();
+  writerInfo_[index]->closed = true;
+}
+
 std::string HiveDataSink::stateString(State state) {
   switch (state) {
     case State::kRunning:
@@ -521,6 +546,9 @@ DataSink::Stats HiveDataSink::stats() const {
   }
 
   stats.numWrittenFiles = writers_.size();
+  for (const auto& writer : writers_) {
+    stats.numWrittenIndexBytes += writer->indexBytesWritten();
+  }
   for (int i = 0; i < writerInfo_.size(); ++i) {
     const auto& info = writerInfo_.at(i);
     VELOX_CHECK_NOT_NULL(info);
@@ -529,6 +557,10 @@ DataSink::Stats HiveDataSink::stats() const {
       stats.spillStats += *spillStats;
     }
   }
+  const auto deferredSpillStats = deferredSpillStats_.rlock();
+  if (!deferredSpillStats->empty()) {
+    stats.spillStats += *deferredSpillStats;
+  }
   return stats;
 }
 
@@ -626,14 +658,20 @@ void HiveDataSink::closeInternal() {
 
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
-      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->close();
+      if (!writerInfo_[i]->closed) {
+        closeWriter(i);
+      }
     }
+    writeDeferredRows();
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writerInfo_[i]->closed) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
+    deferredBuffer_.reset();
   }
 }
 
@@ -645,12 +683,137 @@ uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   return appendWriter(id);
 }
 
+std::optional<int32_t> HiveDataSink::maybeDeferWriter(const HiveWriterId& id) {
+  if (writerIndexMap_.size() < maxOpenPartitionWriters_ ||
+      writerIndexMap_.find(id) != writerIndexMap_.end()) {
+    return std::nullopt;
+  }
+  auto it = deferredWriterIndexMap_.find(id);
+  if (it != deferredWriterIndexMap_.end()) {
+    return it->second;
+  }
+  const int32_t index = deferredWriterIds_.size();
+  deferredWriterIds_.push_back(id);
+  deferredWriterIndexMap_.emplace(id, index);
+  return index;
+}
+
+void HiveDataSink::deferRows(const RowVectorPtr& input) {
+  VELOX_CHECK_GT(numDeferredRows_, 0);
+  if (deferredBuffer_ == nullptr) {
+    const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+    auto names = dataType->names();
+    auto types = dataType->children();
+    names.push_back("$writer");
+    types.push_back(INTEGER());
+    deferredRowType_ = ROW(std::move(names), std::move(types));
+
+    auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+    deferredPool_ = connectorPool->addLeafChild(
+        fmt::format("{}.deferred", connectorPool->name()));
+    if (connectorPool->reclaimer() != nullptr) {
+      deferredPool_->setReclaimer(DeferredRowsReclaimer::create(this));
+    }
+    deferredBuffer_ = std::make_unique<exec::SortBuffer>(
+        deferredRowType_,
+        std::vector<column_index_t>{
+            static_cast<column_index_t>(dataType->size())},
+        std::vector<CompareFlags>{CompareFlags{}},
+        deferredPool_.get(),
+        &deferredNonReclaimableSection_,
+        spillConfig_,
+        &deferredSpillStats_);
+  }
+
+  auto dataInput = makeDataInput(
+      dataChannels_, exec::wrap(numDeferredRows_, deferredRows_, input));
+  auto children = dataInput->children();
+  children.push_back(std::make_shared<FlatVector<int32_t>>(
+      input->pool(),
+      INTEGER(),
+      nullptr,
+      numDeferredRows_,
+      deferredWriterIndices_,
+      std::vector<BufferPtr>{}));
+  memory::NonReclaimableSectionGuard guard(&deferredNonReclaimableSection_);
+  deferredBuffer_->addInput(std::make_shared<RowVector>(
+      input->pool(),
+      deferredRowType_,
+      nullptr,
+      numDeferredRows_,
+      std::move(children)));
+}
+
+bool HiveDataSink::canSpillDeferredRows() const {
+  return state_ == State::kRunning && deferredBuffer_ != nullptr &&
+      deferredBuffer_->canSpill();
+}
+
+void HiveDataSink::writeDeferredRows() {
+  if (deferredBuffer_ == nullptr) {
+    return;
+  }
+  const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+  const auto writerChannel = dataType->size();
+  const auto maxOutputRows = hiveConfig_->sortWriterMaxOutputRows(
+      connectorQueryCtx_->sessionProperties());
+  deferredBuffer_->noMoreInput();
+
+  // The deferred writer being written and its index in 'writers_'.
+  int32_t deferredIndex{-1};
+  uint32_t index{0};
+  for (auto output = deferredBuffer_->getOutput(maxOutputRows);
+       output != nullptr;
+       output = deferredBuffer_->getOutput(maxOutputRows)) {
+    const auto* writerIndices =
+        output->childAt(writerChannel)->asFlatVector<int32_t>()->rawValues();
+    vector_size_t begin = 0;
+    while (begin < output->size()) {
+      vector_size_t end = begin + 1;
+      while (end < output->size() &&
+             writerIndices[end] == writerIndices[begin]) {
+        ++end;
+      }
+      if (writerIndices[begin] != deferredIndex) {
+        if (deferredIndex >= 0) {
+          closeWriter(index);
+        }
+        deferredIndex = writerIndices[begin];
+        index = appendWriter(deferredWriterIds_[deferredIndex]);
+      }
+      index = maybeRotateWriter(index);
+
+      std::vector<VectorPtr> children;
+      children.reserve(writerChannel);
+      for (column_index_t i = 0; i < writerChannel; ++i) {
+        children.push_back(output->childAt(i)->slice(begin, end - begin));
+      }
+      {
+        WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+        writers_[index]->write(std::make_shared<RowVector>(
+            output->pool(),
+            dataType,
+            nullptr,
+            end - begin,
+            std::move(children)));
+      }
+      writerInfo_[index]->numWrittenRows += end - begin;
+      begin = end;
+    }
+  }
+  if (deferredIndex >= 0) {
+    closeWriter(index);
+  }
+  deferredBuffer_.reset();
+  deferredPool_->release();
+}
+
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  VELOX_CHECK_LE(writerIndexMap_.size(), writerInfo_.size());
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -695,6 +858,10 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       hiveConfig_->orcWriterMaxDictionaryMemory(connectorSessionProperties));
   options.parquetWriteTimestampUnit =
       hiveConfig_->parquetWriteTimestampUnit(connectorSessionProperties);
+  options.parquetEnablePageIndex =
+      hiveConfig_->parquetWriterPageIndexEnabled(connectorSessionProperties);
+  options.parquetBloomFilterColumns =
+      hiveConfig_->parquetWriterBloomFilterColumns(connectorSessionProperties);
   options.orcMinCompressionSize = std::optional(
       hiveConfig_->orcWriterMinCompressionSize(connectorSessionProperties));
   options.orcLinearStripeSizeHeuristics =
@@ -730,7 +897,8 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   partitionRows_.emplace_back(nullptr);
   rawPartitionRows_.emplace_back(nullptr);
 
-  writerIndexMap_.emplace(id, writers_.size() - 1);
+  writerIds_.push_back(id);
+  writerIndexMap_[id] = writers_.size() - 1;
   return writerIndexMap_[id];
 }
 
@@ -742,10 +910,34 @@ HiveDataSink::maybeCreateBucketSortWriter(
   }
   auto* sortPool = writerInfo_.back()->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
+  const auto* sessionProperties = connectorQueryCtx_->sessionProperties();
+  dwio::common::SortingWriter::ClusteringOptions clustering;
+  clustering.keyChannels = sortColumnIndices_;
+  clustering.zOrder = hiveConfig_->sortWriterZOrder(sessionProperties);
+  clustering.stripeRows = hiveConfig_->sortWriterStripeRows(sessionProperties);
+
+  auto sortInputType = getNonPartitionTypes(dataChannels_, inputType_);
+  auto sortColumnIndices = sortColumnIndices_;
+  auto sortCompareFlags = sortCompareFlags_;
+  if (clustering.zOrder) {
+    // Sorts by the Z-order key the sorting writer appends to the input.
+    auto names = sortInputType->names();
+    auto types = sortInputType->children();
+    names.push_back("$zorder");
+    types.push_back(VARBINARY());
+    sortColumnIndices = {static_cast<column_index_t>(names.size() - 1)};
+    sortCompareFlags = {CompareFlags{}};
+    sortInputType = ROW(std::move(names), std::move(types));
+  }
+  std::vector<CompareFlags> presortedCompareFlags;
+  if (!clustering.zOrder &&
+      hiveConfig_->sortWriterPresortedInput(sessionProperties)) {
+    presortedCompareFlags = sortCompareFlags_;
+  }
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
-      getNonPartitionTypes(dataChannels_, inputType_),
-      sortColumnIndices_,
-      sortCompareFlags_,
+      sortInputType,
+      sortColumnIndices,
+      sortCompareFlags,
       sortPool,
       writerInfo_.back()->nonReclaimableSectionHolder.get(),
       spillConfig_,
@@ -753,10 +945,10 @@ HiveDataSink::maybeCreateBucketSortWriter(
   return std::make_unique<dwio::common::SortingWriter>(
       std::move(writer),
       std::move(sortBuffer),
-      hiveConfig_->sortWriterMaxOutputRows(
-          connectorQueryCtx_->sessionProperties()),
-      hiveConfig_->sortWriterMaxOutputBytes(
-          connectorQueryCtx_->sessionProperties()));
+      hiveConfig_->sortWriterMaxOutputRows(sessionProperties),
+      hiveConfig_->sortWriterMaxOutputBytes(sessionProperties),
+      std::move(clustering),
+      std::move(presortedCompareFlags));
 }
 
 HiveWriterId HiveDataSink::getWriterId(size_t row) const {
@@ -783,8 +975,30 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
 
   const auto numRows =
       isPartitioned() ? partitionIds_.size() : bucketIds_.size();
+  numDeferredRows_ = 0;
+  vector_size_t* rawDeferredRows{nullptr};
+  int32_t* rawDeferredWriterIndices{nullptr};
+  if (maxOpenPartitionWriters_ != 0) {
+    if (deferredRows_ == nullptr ||
+        deferredRows_->capacity() < numRows * sizeof(vector_size_t)) {
+      auto* pool = connectorQueryCtx_->memoryPool();
+      deferredRows_ = allocateIndices(numRows, pool);
+      deferredWriterIndices_ = AlignedBuffer::allocate<int32_t>(numRows, pool);
+    }
+    rawDeferredRows = deferredRows_->asMutable<vector_size_t>();
+    rawDeferredWriterIndices = deferredWriterIndices_->asMutable<int32_t>();
+  }
+
   for (auto row = 0; row < numRows; ++row) {
     auto id = getWriterId(row);
+    if (maxOpenPartitionWriters_ != 0) {
+      if (const auto deferredIndex = maybeDeferWriter(id)) {
+        rawDeferredRows[numDeferredRows_] = row;
+        rawDeferredWriterIndices[numDeferredRows_] = deferredIndex.value();
+        ++numDeferredRows_;
+        continue;
+      }
+    }
     uint32_t index = ensureWriter(id);
 
     VELOX_DCHECK_LT(index, partitionSizes_.size());
@@ -807,6 +1021,10 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
       partitionRows_[i]->setSize(partitionSizes_[i] * sizeof(vector_size_t));
     }
   }
+  if (numDeferredRows_ != 0) {
+    deferredRows_->setSize(numDeferredRows_ * sizeof(vector_size_t));
+    deferredWriterIndices_->setSize(numDeferredRows_ * sizeof(int32_t));
+  }
 }
 
 HiveWriterParameters HiveDataSink::getWriterParameters(
@@ -970,6 +1188,51 @@ LocationHandlePtr LocationHandle::create(const folly::dynamic& obj) {
   return std::make_shared<LocationHandle>(targetPath, writePath, tableType);
 }
 
+std::unique_ptr<memory::MemoryReclaimer>
+HiveDataSink::DeferredRowsReclaimer::create(HiveDataSink* dataSink) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new HiveDataSink::DeferredRowsReclaimer(dataSink));
+}
+
+bool HiveDataSink::DeferredRowsReclaimer::reclaimableBytes(
+    const memory::MemoryPool& pool,
+    uint64_t& reclaimableBytes) const {
+  VELOX_CHECK_EQ(pool.name(), dataSink_->deferredPool_->name());
+  reclaimableBytes = 0;
+  if (!dataSink_->canSpillDeferredRows()) {
+    return false;
+  }
+  reclaimableBytes = pool.usedBytes();
+  return true;
+}
+
+uint64_t HiveDataSink::DeferredRowsReclaimer::reclaim(
+    memory::MemoryPool* pool,
+    uint64_t /*targetBytes*/,
+    uint64_t /*maxWaitMs*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK_EQ(pool->name(), dataSink_->deferredPool_->name());
+  if (!dataSink_->canSpillDeferredRows()) {
+    return 0;
+  }
+  if (dataSink_->deferredNonReclaimableSection_) {
+    RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+  return memory::MemoryReclaimer::run(
+      [&]() {
+        int64_t reclaimedBytes{0};
+        {
+          memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
+          dataSink_->deferredBuffer_->spill();
+          pool->release();
+        }
+        return reclaimedBytes;
+      },
+      stats);
+}
+
 std::unique_ptr<memory::MemoryReclaimer> HiveDataSink::WriterReclaimer::create(
     HiveDataSink* dataSink,
     HiveWriterInfo* writerInfo,
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::dwrf {
 class Writer;
@@ -369,6 +370,9 @@ struct HiveWriterInfo {
   const std::shared_ptr<memory::MemoryPool> sinkPool;
   const std::shared_ptr<memory::MemoryPool> sortPool;
   int64_t numWrittenRows = 0;
+  /// True once the file is closed. A file can be closed before the sink on
+  /// reaching the target file size.
+  bool closed{false};
 };
 
 /// Identifies a hive writer.
@@ -483,6 +487,31 @@ class HiveDataSink : public DataSink {
     io::IoStatistics* const ioStats_;
   };
 
+  // Spills the deferred rows of the partitions without an open writer.
+  class DeferredRowsReclaimer : public exec::MemoryReclaimer {
+   public:
+    static std::unique_ptr<memory::MemoryReclaimer> create(
+        HiveDataSink* dataSink);
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    explicit DeferredRowsReclaimer(HiveDataSink* dataSink)
+        : exec::MemoryReclaimer(), dataSink_(dataSink) {
+      VELOX_CHECK_NOT_NULL(dataSink_);
+    }
+
+    HiveDataSink* const dataSink_;
+  };
+
   FOLLY_ALWAYS_INLINE bool sortWrite() const {
     return !sortColumnIndices_.empty();
   }
@@ -525,6 +554,24 @@ class HiveDataSink : public DataSink {
   // returns the corresponding index in 'writers_'.
   uint32_t ensureWriter(const HiveWriterId& id);
 
+  // Returns the index of 'id' in 'deferredWriterIds_' if the rows of 'id' are
+  // deferred to close because 'maxOpenPartitionWriters_' writers are open and
+  // none of them is for 'id'. Returns std::nullopt if 'id' has or can get an
+  // open writer.
+  std::optional<int32_t> maybeDeferWriter(const HiveWriterId& id);
+
+  // Adds the 'numDeferredRows_' input rows in 'deferredRows_' with their
+  // writer indices in 'deferredWriterIndices_' to 'deferredBuffer_'.
+  void deferRows(const RowVectorPtr& input);
+
+  // Returns true if the deferred rows can be spilled to free memory.
+  bool canSpillDeferredRows() const;
+
+  // Writes the deferred rows sorted by writer in 'deferredBuffer_'. Each
+  // deferred writer is created, written and closed before the next one so
+  // that at most one of them is open at a time.
+  void writeDeferredRows();
+
   // Appends a new writer for the given 'id'. The function returns the index of
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
@@ -556,6 +603,14 @@ class HiveDataSink : public DataSink {
   // Invoked to write 'input' to the specified file writer.
   void write(size_t index, RowVectorPtr input);
 
+  // Closes the file of the writer at 'index' and appends a writer with a new
+  // file for the same writer id if the file has reached 'maxTargetFileSize_'.
+  // Returns the index of the writer to write the next input to. Invoked
+  // before a write so that no file is left empty.
+  uint32_t maybeRotateWriter(uint32_t index);
+
+  void closeWriter(uint32_t index);
+
   void closeInternal();
 
   const RowTypePtr inputType_;
@@ -565,6 +620,11 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  // Maximum number of writers open before close. 0 means no limit.
+  const uint32_t maxOpenPartitionWriters_;
+  // Size after which a file is closed and continued in a new one. 0 means no
+  // limit.
+  const uint64_t maxTargetFileSize_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -591,6 +651,9 @@ class HiveDataSink : public DataSink {
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
+  // The id of each writer. Several writers have the same id if their files
+  // were rotated, and 'writerIndexMap_' has the last of them.
+  std::vector<HiveWriterId> writerIds_;
 
   // Below are structures updated when processing current input. partitionIds_
   // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
@@ -602,6 +665,25 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  // Below are structures for the writers deferred to close once
+  // 'maxOpenPartitionWriters_' writers are open. The ids of the deferred
+  // writers in order of first appearance and the map from id to index.
+  std::vector<HiveWriterId> deferredWriterIds_;
+  folly::F14FastMap<HiveWriterId, int32_t, HiveWriterIdHasher, HiveWriterIdEq>
+      deferredWriterIndexMap_;
+  // The rows of the current input for the deferred writers and their indices
+  // in 'deferredWriterIds_'.
+  BufferPtr deferredRows_;
+  BufferPtr deferredWriterIndices_;
+  vector_size_t numDeferredRows_{0};
+  // Buffers the data columns of the deferred rows followed by their writer
+  // index, which is the sort key. Created on the first deferred row.
+  RowTypePtr deferredRowType_;
+  std::shared_ptr<memory::MemoryPool> deferredPool_;
+  std::unique_ptr<exec::SortBuffer> deferredBuffer_;
+  tsan_atomic<bool> deferredNonReclaimableSection_{false};
+  folly::Synchronized<common::SpillStats> deferredSpillStats_;
 };
 
 } // namespace facebook::velox::connector::hive
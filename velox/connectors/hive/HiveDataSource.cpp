@@ -19,10 +19,15 @@
 #include <string>
 #include <unordered_map>
 
+#include <folly/container/F14Set.h>
+
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/dwio/common/FileTailCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
+#include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -32,6 +37,108 @@ namespace facebook::velox::connector::hive {
 class HiveTableHandle;
 class HiveColumnHandle;
 
+namespace {
+
+// Appends the conjuncts of 'expr' to 'conjuncts', flattening nested ANDs.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+// Adds the names of the top level columns referenced in 'expr' to 'columns'.
+void collectColumns(
+    const core::TypedExprPtr& expr,
+    folly::F14FastSet<std::string>& columns) {
+  if (auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    if (field->isInputColumn()) {
+      columns.insert(field->name());
+      return;
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectColumns(input, columns);
+  }
+}
+
+core::TypedExprPtr makeConjunction(std::vector<core::TypedExprPtr> conjuncts) {
+  if (conjuncts.empty()) {
+    return nullptr;
+  }
+  if (conjuncts.size() == 1) {
+    return conjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(conjuncts), "and");
+}
+
+// Moves the conjuncts of 'remainingFilter' that are disjunctions of filters
+// on different columns, e.g. 'a = 1 OR b = 2', to 'disjunctions' and returns
+// the rest of the filter. A disjunction is only moved if its columns pass
+// 'isFilterOnly' and are not referenced by the rest of the filter, since the
+// scan does not read their values.
+core::TypedExprPtr extractDisjunctions(
+    const core::TypedExprPtr& remainingFilter,
+    const std::function<bool(const std::string&)>& isFilterOnly,
+    core::ExpressionEvaluator* evaluator,
+    std::vector<SubfieldFilters>& disjunctions) {
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(remainingFilter, conjuncts);
+  std::vector<folly::F14FastSet<std::string>> columns(conjuncts.size());
+  folly::F14FastMap<std::string, int32_t> numReferences;
+  for (auto i = 0; i < conjuncts.size(); ++i) {
+    collectColumns(conjuncts[i], columns[i]);
+    for (const auto& column : columns[i]) {
+      ++numReferences[column];
+    }
+  }
+  std::vector<core::TypedExprPtr> rest;
+  for (auto i = 0; i < conjuncts.size(); ++i) {
+    bool canExtract = columns[i].size() > 1;
+    for (const auto& column : columns[i]) {
+      canExtract &= numReferences[column] == 1 && isFilterOnly(column);
+    }
+    std::vector<std::pair<common::Subfield, std::unique_ptr<common::Filter>>>
+        filters;
+    if (canExtract) {
+      try {
+        filters = exec::toDisjunctiveSubfieldFilters(conjuncts[i], evaluator);
+      } catch (const VeloxException&) {
+        LOG(WARNING) << "Unexpected failure when extracting disjunction for: "
+                     << conjuncts[i]->toString();
+      }
+    }
+    // Each filter must be on a whole column for the scan to union the rows
+    // passing it with the others.
+    canExtract = filters.size() == columns[i].size();
+    for (const auto& [subfield, _] : filters) {
+      canExtract &= subfield.path().size() == 1;
+    }
+    if (!canExtract) {
+      rest.push_back(conjuncts[i]);
+      continue;
+    }
+    auto& disjunction = disjunctions.emplace_back();
+    for (auto& [subfield, filter] : filters) {
+      disjunction.emplace(std::move(subfield), std::move(filter));
+    }
+  }
+  if (disjunctions.empty()) {
+    return remainingFilter;
+  }
+  return makeConjunction(std::move(rest));
+}
+
+} // namespace
+
 HiveDataSource::HiveDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
@@ -48,7 +155,9 @@ HiveDataSource::HiveDataSource(
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       outputType_(outputType),
-      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
+      expressionEvaluator_(connectorQueryCtx->expressionEvaluator()),
+      sharedScanEnabled_(hiveConfig_->sharedScanEnabled(
+          connectorQueryCtx->sessionProperties())) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
     auto handle = std::dynamic_pointer_cast<HiveColumnHandle>(columnHandle);
@@ -73,6 +182,7 @@ HiveDataSource::HiveDataSource(
 
   std::vector<std::string> readColumnNames;
   auto readColumnTypes = outputType_->children();
+  std::vector<const HiveColumnHandle*> aggregatedColumns;
   for (const auto& outputName : outputType_->names()) {
     auto it = columnHandles.find(outputName);
     VELOX_CHECK(
@@ -81,6 +191,10 @@ HiveDataSource::HiveDataSource(
         outputName);
 
     auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+    if (handle->columnType() == HiveColumnHandle::ColumnType::kAggregated) {
+      aggregatedColumns.push_back(handle);
+      continue;
+    }
     readColumnNames.push_back(handle->name());
     for (auto& subfield : handle->requiredSubfields()) {
       VELOX_USER_CHECK_EQ(
@@ -94,6 +208,18 @@ HiveDataSource::HiveDataSource(
   hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
       hiveTableHandle_, "TableHandle must be an instance of HiveTableHandle");
+  if (!aggregatedColumns.empty()) {
+    VELOX_USER_CHECK_EQ(
+        aggregatedColumns.size(),
+        outputType_->size(),
+        "Aggregated columns cannot be mixed with other columns");
+    splitAggregates_ = std::make_unique<SplitAggregates>(
+        outputType_, aggregatedColumns, hiveTableHandle_->dataColumns());
+    // The aggregated data columns are read when the statistics of a split do
+    // not answer the aggregates.
+    readColumnNames = splitAggregates_->inputType()->names();
+    readColumnTypes = splitAggregates_->inputType()->children();
+  }
   if (hiveConfig_->isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->sessionProperties())) {
     checkColumnNameLowerCase(outputType_);
@@ -115,6 +241,26 @@ HiveDataSource::HiveDataSource(
     randomSkip_ = std::make_shared<random::RandomSkipTracker>(sampleRate);
   }
 
+  // The metadata filter also prunes on the disjunctions extracted below.
+  auto metadataFilterExpr = remainingFilter;
+  std::vector<SubfieldFilters> disjunctions;
+  if (remainingFilter) {
+    const auto& dataColumns = hiveTableHandle_->dataColumns();
+    folly::F14FastSet<std::string> otherColumns(
+        readColumnNames.begin(), readColumnNames.end());
+    for (const auto& [subfield, _] : filters_) {
+      otherColumns.insert(getColumnName(subfield));
+    }
+    auto isFilterOnly = [&](const std::string& name) {
+      return dataColumns != nullptr && dataColumns->containsChild(name) &&
+          otherColumns.count(name) == 0 && partitionKeys_.count(name) == 0 &&
+          infoColumns_.count(name) == 0 &&
+          !(rowIndexColumn_ && rowIndexColumn_->name() == name);
+    };
+    remainingFilter = extractDisjunctions(
+        remainingFilter, isFilterOnly, expressionEvaluator_, disjunctions);
+  }
+
   std::vector<common::Subfield> remainingFilterSubfields;
   if (remainingFilter) {
     remainingFilterExprSet_ = expressionEvaluator_->compile(remainingFilter);
@@ -135,6 +281,25 @@ HiveDataSource::HiveDataSource(
       readColumnNames.push_back(input->field());
       readColumnTypes.push_back(input->type());
     }
+    if (remainingFilterExpr->isDeterministic() &&
+        !multiReferencedFields_.empty()) {
+      std::vector<core::TypedExprPtr> conjuncts;
+      flattenConjuncts(remainingFilter, conjuncts);
+      if (conjuncts.size() > 1) {
+        folly::F14FastSet<column_index_t> loaded;
+        for (const auto& conjunct : conjuncts) {
+          RemainingFilterConjunct step;
+          step.exprSet = expressionEvaluator_->compile(conjunct);
+          for (auto& input : step.exprSet->expr(0)->distinctFields()) {
+            auto it = columnNames.find(input->field());
+            if (it != columnNames.end() && loaded.insert(it->second).second) {
+              step.loadFields.push_back(it->second);
+            }
+          }
+          remainingFilterConjuncts_.push_back(std::move(step));
+        }
+      }
+    }
     remainingFilterSubfields = remainingFilterExpr->extractSubfields();
     if (VLOG_IS_ON(1)) {
       VLOG(1) << fmt::format(
@@ -164,15 +329,21 @@ HiveDataSource::HiveDataSource(
       partitionKeys_,
       infoColumns_,
       rowIndexColumn_,
-      pool_);
-  if (remainingFilter) {
+      pool_,
+      disjunctions);
+  if (metadataFilterExpr) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
-        *scanSpec_, *remainingFilter, expressionEvaluator_);
+        *scanSpec_, *metadataFilterExpr, expressionEvaluator_);
   }
 
   ioStats_ = std::make_shared<io::IoStatistics>();
 }
 
+HiveDataSource::~HiveDataSource() {
+  clearPendingFiles();
+  detachSharedScan();
+}
+
 std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
   return SplitReader::create(
       split_,
@@ -241,8 +412,27 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK_NULL(
       split_,
       "Previous split has not been processed yet. Call next to process the split.");
-  split_ = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
-  VELOX_CHECK_NOT_NULL(split_, "Wrong type of split");
+  VELOX_CHECK(pendingFiles_.empty());
+  if (auto multiFileSplit =
+          std::dynamic_pointer_cast<HiveMultiFileConnectorSplit>(split)) {
+    VLOG(1) << "Adding split " << multiFileSplit->toString();
+    const auto& fileSplits = multiFileSplit->splits;
+    for (size_t i = 1; i < fileSplits.size(); ++i) {
+      pendingFiles_.push_back({fileSplits[i], nullptr});
+    }
+    numCoalescedFiles_ += fileSplits.size();
+    prefetchPendingFiles();
+    addFileSplit(fileSplits[0]);
+    return;
+  }
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  VELOX_CHECK_NOT_NULL(hiveSplit, "Wrong type of split");
+  addFileSplit(std::move(hiveSplit));
+}
+
+void HiveDataSource::addFileSplit(std::shared_ptr<HiveConnectorSplit> split) {
+  MicrosecondTimer timer(&splitSetupMicros_);
+  split_ = std::move(split);
 
   VLOG(1) << "Adding split " << split_->toString();
 
@@ -256,11 +446,123 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     partitionFunction_.reset();
   }
 
+  aggregatesState_ = AggregatesState::kStart;
   splitReader_ = createSplitReader();
   // Split reader subclasses may need to use the reader options in prepareSplit
   // so we initialize it beforehand.
   splitReader_->configureReaderOptions(randomSkip_);
+  if (!testDynamicPartitionFilters()) {
+    ++runtimeStats_.skippedSplitsByDynamicFilter;
+    splitReader_->skipSplit(runtimeStats_);
+    return;
+  }
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_, rowIndexColumn_);
+  // Attaching before the first next() lets the scans of the split that
+  // attach before decoding starts add their columns, e.g. a preloaded split.
+  if (!splitReader_->emptySplit()) {
+    maybeAttachSharedScan();
+  }
+}
+
+std::shared_ptr<AsyncSource<FileHandleCachedPtr>>
+HiveDataSource::makeFilePrefetch(
+    const std::shared_ptr<HiveConnectorSplit>& split) const {
+  // Captures no 'this' since the prefetch may be running while 'this' takes
+  // over the state of another data source in setFromDataSource().
+  return std::make_shared<AsyncSource<FileHandleCachedPtr>>(
+      [split,
+       fileHandleFactory = fileHandleFactory_,
+       executor = executor_,
+       connectorQueryCtx = connectorQueryCtx_,
+       ioStats = ioStats_,
+       tableName = hiveTableHandle_->tableName()]() {
+        std::unique_ptr<FileHandleCachedPtr> fileHandle;
+        try {
+          fileHandle =
+              std::make_unique<FileHandleCachedPtr>(fileHandleFactory->generate(
+                  split->filePath,
+                  split->properties.has_value() ? &*split->properties
+                                                : nullptr));
+          if (dwio::common::FileTailCache::getInstance() == nullptr ||
+              (split->fileFormat != dwio::common::FileFormat::DWRF &&
+               split->fileFormat != dwio::common::FileFormat::ORC)) {
+            return fileHandle;
+          }
+          // The reader puts the footer in FileTailCache, where the reader
+          // that reads the file finds it.
+          dwio::common::ReaderOptions readerOpts(
+              connectorQueryCtx->memoryPool());
+          readerOpts.setFileFormat(split->fileFormat);
+          readerOpts.setFileModificationTime(
+              split->properties.has_value()
+                  ? split->properties->modificationTime.value_or(0)
+                  : 0);
+          // Reads only the tail, not the whole of a small file.
+          readerOpts.setFilePreloadThreshold(0);
+          dwio::common::getReaderFactory(split->fileFormat)
+              ->createReader(
+                  createBufferedInput(
+                      **fileHandle,
+                      readerOpts,
+                      connectorQueryCtx,
+                      ioStats,
+                      executor,
+                      tableName),
+                  readerOpts);
+        } catch (const std::exception& e) {
+          VLOG(1) << "Failed to prefetch " << split->filePath << ": "
+                  << e.what();
+        }
+        return fileHandle;
+      });
+}
+
+void HiveDataSource::prefetchPendingFiles() {
+  if (executor_ == nullptr) {
+    return;
+  }
+  const auto numFiles =
+      std::min<size_t>(pendingFiles_.size(), kMaxPrefetchFiles);
+  for (size_t i = 0; i < numFiles; ++i) {
+    auto& file = pendingFiles_[i];
+    if (file.prefetch != nullptr) {
+      continue;
+    }
+    file.prefetch = makeFilePrefetch(file.split);
+    executor_->add([prefetch = file.prefetch]() { prefetch->prepare(); });
+  }
+}
+
+void HiveDataSource::clearPendingFiles() {
+  for (auto& file : pendingFiles_) {
+    if (file.prefetch != nullptr) {
+      file.prefetch->close();
+    }
+  }
+  pendingFiles_.clear();
+}
+
+bool HiveDataSource::testDynamicPartitionFilters() const {
+  for (const auto& name : dynamicPartitionFilterColumns_) {
+    const auto* fieldSpec = scanSpec_->childByName(name);
+    if (fieldSpec == nullptr || fieldSpec->filter() == nullptr ||
+        fieldSpec->disjunction() != common::ScanSpec::kNoDisjunction) {
+      continue;
+    }
+    auto it = split_->partitionKeys.find(name);
+    if (it == split_->partitionKeys.end()) {
+      continue;
+    }
+    if (!testPartitionFilter(
+            partitionKeys_.at(name)->dataType(),
+            it->second,
+            fieldSpec->filter())) {
+      VLOG(1) << "Skipping " << split_->filePath
+              << " because a dynamic filter rejects partition key " << name;
+      return false;
+    }
+  }
+  return true;
 }
 
 vector_size_t HiveDataSource::applyBucketConversion(
@@ -303,7 +605,28 @@ vector_size_t HiveDataSource::applyBucketConversion(
 
 std::optional<RowVectorPtr> HiveDataSource::next(
     uint64_t size,
-    velox::ContinueFuture& /*future*/) {
+    velox::ContinueFuture& future) {
+  for (;;) {
+    auto output = nextInFile(size, future);
+    if (!output.has_value() || output.value() != nullptr ||
+        pendingFiles_.empty()) {
+      return output;
+    }
+    auto file = std::move(pendingFiles_.front());
+    pendingFiles_.pop_front();
+    prefetchPendingFiles();
+    // Keeps the prefetched file handle cached until the SplitReader opens it.
+    std::unique_ptr<FileHandleCachedPtr> fileHandle;
+    if (file.prefetch != nullptr) {
+      fileHandle = file.prefetch->move();
+    }
+    addFileSplit(std::move(file.split));
+  }
+}
+
+std::optional<RowVectorPtr> HiveDataSource::nextInFile(
+    uint64_t size,
+    velox::ContinueFuture& future) {
   VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
@@ -315,11 +638,38 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (splitAggregates_) {
+    if (aggregatesState_ == AggregatesState::kDone) {
+      splitReader_->updateRuntimeStats(runtimeStats_);
+      resetSplit();
+      return nullptr;
+    }
+    if (aggregatesState_ == AggregatesState::kStart) {
+      aggregatesState_ = AggregatesState::kRows;
+      const auto* reader = splitReader_->statisticsReader();
+      if (reader && !hasRowFilter() &&
+          splitAggregates_->addStatistics(*reader)) {
+        ++numSplitsAggregatedFromStats_;
+        aggregatesState_ = AggregatesState::kDone;
+        return splitAggregates_->finish(pool_);
+      }
+    }
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
 
-  auto rowsScanned = splitReader_->next(size, output_);
+  uint64_t rowsScanned;
+  if (sharedScan_) {
+    const auto rows = nextFromSharedScan(size, future);
+    if (!rows.has_value()) {
+      return std::nullopt;
+    }
+    rowsScanned = *rows;
+  } else {
+    rowsScanned = splitReader_->next(size, output_);
+  }
   completedRows_ += rowsScanned;
 
   if (rowsScanned) {
@@ -365,6 +715,11 @@ std::optional<RowVectorPtr> HiveDataSource::next(
       }
     }
 
+    if (splitAggregates_) {
+      splitAggregates_->addInput(*rowVector, rowsRemaining, remainingIndices);
+      return getEmptyOutput();
+    }
+
     if (outputType_->size() == 0) {
       return exec::wrap(rowsRemaining, remainingIndices, rowVector);
     }
@@ -386,16 +741,105 @@ std::optional<RowVectorPtr> HiveDataSource::next(
         pool_, outputType_, BufferPtr(nullptr), rowsRemaining, outputColumns);
   }
 
+  if (splitAggregates_) {
+    aggregatesState_ = AggregatesState::kDone;
+    return splitAggregates_->finish(pool_);
+  }
+
   splitReader_->updateRuntimeStats(runtimeStats_);
   resetSplit();
   return nullptr;
 }
 
+void HiveDataSource::maybeAttachSharedScan() {
+  if (!sharedScanEnabled_ || randomSkip_ || rowIndexColumn_ ||
+      !splitReader_->supportsSharedScan()) {
+    return;
+  }
+  const auto& fileType = splitReader_->requestedType();
+  const auto columns = SharedScan::columnsToRead(*scanSpec_, *fileType);
+  if (!columns.has_value()) {
+    return;
+  }
+  std::tie(sharedScan_, sharedScanConsumer_) = sharedScans().attach(
+      splitReader_->sharedScanKey(),
+      fileType,
+      *columns,
+      hiveConfig_->sharedScanMaxBufferedBatches(),
+      hiveConfig_->sharedScanMaxMemoryBytes());
+  sharedScanSplitRows_ = 0;
+}
+
+std::optional<uint64_t> HiveDataSource::nextFromSharedScan(
+    uint64_t size,
+    velox::ContinueFuture& future) {
+  RowVectorPtr batch;
+  bool decoded;
+  switch (sharedScan_->next(
+      sharedScanConsumer_, size, *splitReader_, batch, decoded, future)) {
+    case SharedScan::Result::kBlocked:
+      return std::nullopt;
+    case SharedScan::Result::kAtEnd:
+      detachSharedScan();
+      return 0;
+    case SharedScan::Result::kDetached: {
+      // Reads the rest of the split on its own.
+      sharedScan_.reset();
+      ++numSharedScanDetached_;
+      const auto numSkipped = splitReader_->skip(sharedScanSplitRows_);
+      VELOX_CHECK_EQ(numSkipped, sharedScanSplitRows_);
+      return splitReader_->next(size, output_);
+    }
+    case SharedScan::Result::kBatch:
+      break;
+  }
+  sharedScanSplitRows_ += batch->size();
+  sharedScanRows_ += batch->size();
+  if (!decoded) {
+    sharedScanReusedRows_ += batch->size();
+    sharedScanReusedBytes_ += batch->retainedSize();
+  }
+  output_ = SharedScan::project(*batch, *scanSpec_, readerOutputType_, pool_);
+  return batch->size();
+}
+
+void HiveDataSource::detachSharedScan() {
+  if (sharedScan_) {
+    sharedScan_->detach(sharedScanConsumer_);
+    sharedScan_.reset();
+  }
+}
+
+bool HiveDataSource::hasRowFilter() const {
+  if (remainingFilterExprSet_ || randomSkip_ || partitionFunction_ ||
+      scanSpec_->numDisjunctions() > 0) {
+    return true;
+  }
+  // Filters on partition keys drop whole splits.
+  for (const auto& child : scanSpec_->children()) {
+    if (child->hasFilter() && partitionKeys_.count(child->fieldName()) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
+  // Remember how many rows the column had already dropped so that
+  // runtimeStats() reports only the rows dropped after the dynamic filter was
+  // added.
+  const auto& selectivity = fieldSpec.selectivity();
+  dynamicFilterBaselines_.emplace(
+      outputChannel, selectivity.numIn() - selectivity.numOut());
   fieldSpec.addFilter(*filter);
+  if (partitionKeys_.count(fieldSpec.fieldName()) > 0) {
+    // Splits of partitions that the filter rejects are skipped before their
+    // files are opened.
+    dynamicPartitionFilterColumns_.insert(fieldSpec.fieldName());
+  }
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
     splitReader_->resetFilterCaches();
@@ -439,9 +883,112 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  if (ioStats_->decompressAhead().count() > 0) {
+    res.insert(
+        {{"numDecompressAhead",
+          RuntimeCounter(ioStats_->decompressAhead().count())},
+         {"decompressAheadWallNanos",
+          RuntimeCounter(
+              ioStats_->decompressAhead().sum() * 1000,
+              RuntimeCounter::Unit::kNanos)}});
+  }
+  if (ioStats_->fileTailParse().count() > 0) {
+    res.insert(
+        {{"numFileTailParse",
+          RuntimeCounter(ioStats_->fileTailParse().count())},
+         {"fileTailParseWallNanos",
+          RuntimeCounter(
+              ioStats_->fileTailParse().sum() * 1000,
+              RuntimeCounter::Unit::kNanos)}});
+  }
+  if (ioStats_->fileTailCacheHit().count() > 0) {
+    res.insert(
+        {{"numFileTailCacheHit",
+          RuntimeCounter(ioStats_->fileTailCacheHit().count())},
+         {"fileTailCacheSavedWallNanos",
+          RuntimeCounter(
+              ioStats_->fileTailCacheHit().sum() * 1000,
+              RuntimeCounter::Unit::kNanos)}});
+  }
+  if (ioStats_->splitPreload().count() > 0) {
+    res.insert(
+        {{"numSplitPreloadLoads",
+          RuntimeCounter(ioStats_->splitPreload().count())},
+         {"splitPreloadBytes",
+          RuntimeCounter(
+              ioStats_->splitPreload().sum(), RuntimeCounter::Unit::kBytes)}});
+  }
+  if (ioStats_->localStorageRead().count() > 0 ||
+      ioStats_->remoteStorageRead().count() > 0) {
+    res.insert(
+        {{"localStorageReadBytes",
+          RuntimeCounter(
+              ioStats_->localStorageRead().sum(),
+              RuntimeCounter::Unit::kBytes)},
+         {"remoteStorageReadBytes",
+          RuntimeCounter(
+              ioStats_->remoteStorageRead().sum(),
+              RuntimeCounter::Unit::kBytes)}});
+  }
+  if (ioStats_->adaptiveCoalesceDistance().count() > 0) {
+    res.insert(
+        {"adaptiveCoalesceDistanceBytes",
+         RuntimeCounter(
+             ioStats_->adaptiveCoalesceDistance().sum() /
+                 ioStats_->adaptiveCoalesceDistance().count(),
+             RuntimeCounter::Unit::kBytes)});
+  }
+  if (ioStats_->cancelledPrefetch().count() > 0) {
+    res.insert(
+        {{"numCancelledPrefetch",
+          RuntimeCounter(ioStats_->cancelledPrefetch().count())},
+         {"cancelledPrefetchBytes",
+          RuntimeCounter(
+              ioStats_->cancelledPrefetch().sum(),
+              RuntimeCounter::Unit::kBytes)}});
+  }
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numSplitsAggregatedFromStats_ > 0) {
+    res.insert(
+        {"numSplitsAggregatedFromStats",
+         RuntimeCounter(numSplitsAggregatedFromStats_)});
+  }
+  if (numCoalescedFiles_ > 0) {
+    res.insert({"numCoalescedFiles", RuntimeCounter(numCoalescedFiles_)});
+  }
+  if (splitSetupMicros_ > 0) {
+    res.insert(
+        {"splitSetupWallNanos",
+         RuntimeCounter(
+             splitSetupMicros_ * 1000, RuntimeCounter::Unit::kNanos)});
+  }
+  if (remainingFilterDeferredColumns_ > 0) {
+    res.insert(
+        {{"remainingFilterDeferredColumns",
+          RuntimeCounter(remainingFilterDeferredColumns_)},
+         {"remainingFilterSkippedRows",
+          RuntimeCounter(remainingFilterSkippedRows_)}});
+  }
+  if (sharedScanRows_ > 0 || numSharedScanDetached_ > 0) {
+    res.insert(
+        {{"sharedScanRows", RuntimeCounter(sharedScanRows_)},
+         {"sharedScanReusedRows", RuntimeCounter(sharedScanReusedRows_)},
+         {"sharedScanReusedBytes",
+          RuntimeCounter(
+              sharedScanReusedBytes_, RuntimeCounter::Unit::kBytes)},
+         {"numSharedScanDetached", RuntimeCounter(numSharedScanDetached_)}});
+  }
+  if (!dynamicFilterBaselines_.empty()) {
+    uint64_t prunedRows = 0;
+    for (const auto& [channel, baseline] : dynamicFilterBaselines_) {
+      const auto& selectivity =
+          scanSpec_->getChildByChannel(channel).selectivity();
+      prunedRows += selectivity.numIn() - selectivity.numOut() - baseline;
+    }
+    res.insert({"dynamicFilterPrunedRows", RuntimeCounter(prunedRows)});
+  }
   return res;
 }
 
@@ -453,6 +1000,12 @@ void HiveDataSource::setFromDataSource(
   split_ = std::move(source->split_);
   runtimeStats_.skippedSplits += source->runtimeStats_.skippedSplits;
   runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
+  runtimeStats_.skippedSplitsByDynamicFilter +=
+      source->runtimeStats_.skippedSplitsByDynamicFilter;
+  runtimeStats_.deleteBitmapCacheHits +=
+      source->runtimeStats_.deleteBitmapCacheHits;
+  runtimeStats_.deleteBitmapCacheMisses +=
+      source->runtimeStats_.deleteBitmapCacheMisses;
   readerOutputType_ = std::move(source->readerOutputType_);
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
   scanSpec_ = std::move(source->scanSpec_);
@@ -463,7 +1016,28 @@ void HiveDataSource::setFromDataSource(
   source->ioStats_->merge(*ioStats_);
   ioStats_ = std::move(source->ioStats_);
   numBucketConversion_ += source->numBucketConversion_;
+  numSplitsAggregatedFromStats_ += source->numSplitsAggregatedFromStats_;
+  aggregatesState_ = AggregatesState::kStart;
+  remainingFilterDeferredColumns_ += source->remainingFilterDeferredColumns_;
+  remainingFilterSkippedRows_ += source->remainingFilterSkippedRows_;
   partitionFunction_ = std::move(source->partitionFunction_);
+  detachSharedScan();
+  sharedScan_ = std::move(source->sharedScan_);
+  sharedScanConsumer_ = source->sharedScanConsumer_;
+  sharedScanSplitRows_ = source->sharedScanSplitRows_;
+  numCoalescedFiles_ += source->numCoalescedFiles_;
+  splitSetupMicros_ += source->splitSetupMicros_;
+  // The prefetches of 'source' use its query context. Restart them with the
+  // context of this. The file handles they opened are in the cache.
+  clearPendingFiles();
+  for (auto& file : source->pendingFiles_) {
+    if (file.prefetch != nullptr) {
+      file.prefetch->close();
+    }
+    pendingFiles_.push_back({std::move(file.split), nullptr});
+  }
+  source->pendingFiles_.clear();
+  prefetchPendingFiles();
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
@@ -474,6 +1048,9 @@ int64_t HiveDataSource::estimatedRowSize() {
 }
 
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
+  if (!remainingFilterConjuncts_.empty()) {
+    return evaluateRemainingFilterConjuncts(rowVector);
+  }
   for (auto fieldIndex : multiReferencedFields_) {
     LazyVector::ensureLoadedRows(
         rowVector->childAt(fieldIndex),
@@ -492,7 +1069,99 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   return res;
 }
 
+vector_size_t HiveDataSource::evaluateRemainingFilterConjuncts(
+    const RowVectorPtr& rowVector) {
+  auto filterStartMicros = getCurrentTimeMicro();
+  const auto numInputRows = filterRows_.countSelected();
+  vector_size_t numRows = numInputRows;
+  for (auto i = 0; i < remainingFilterConjuncts_.size(); ++i) {
+    const auto& conjunct = remainingFilterConjuncts_[i];
+    for (auto fieldIndex : conjunct.loadFields) {
+      LazyVector::ensureLoadedRows(
+          rowVector->childAt(fieldIndex),
+          filterRows_,
+          filterLazyDecoded_,
+          filterLazyBaseRows_);
+    }
+    if (i > 0 && !conjunct.loadFields.empty()) {
+      remainingFilterDeferredColumns_ += conjunct.loadFields.size();
+      remainingFilterSkippedRows_ +=
+          (numInputRows - numRows) * conjunct.loadFields.size();
+    }
+    const auto* exprSet = conjunct.exprSet.get();
+    bool last = i + 1 == remainingFilterConjuncts_.size();
+    try {
+      expressionEvaluator_->evaluate(
+          exprSet, filterRows_, *rowVector, filterResult_);
+    } catch (const VeloxRuntimeError&) {
+      throw;
+    } catch (const std::exception&) {
+      // The conjunction discards errors on rows that a later conjunct is
+      // false for. Evaluate the rest of it as a whole on the remaining rows
+      // so that the same rows fail.
+      for (auto j = i + 1; j < remainingFilterConjuncts_.size(); ++j) {
+        for (auto fieldIndex : remainingFilterConjuncts_[j].loadFields) {
+          LazyVector::ensureLoadedRows(
+              rowVector->childAt(fieldIndex),
+              filterRows_,
+              filterLazyDecoded_,
+              filterLazyBaseRows_);
+        }
+      }
+      expressionEvaluator_->evaluate(
+          remainingFilterExprSet_.get(),
+          filterRows_,
+          *rowVector,
+          filterResult_);
+      last = true;
+    }
+    const auto numPassed = exec::processFilterResults(
+        filterResult_, filterRows_, filterEvalCtx_, pool_);
+    if (numPassed == 0) {
+      numRows = 0;
+      break;
+    }
+    if (numPassed < numRows) {
+      filterRows_.setFromBits(
+          filterEvalCtx_.selectedBits->as<uint64_t>(), filterRows_.size());
+      numRows = numPassed;
+    }
+    if (last) {
+      break;
+    }
+  }
+  if (numRows > 0 && numRows < rowVector->size()) {
+    auto* rawIndices =
+        filterEvalCtx_.getRawSelectedIndices(rowVector->size(), pool_);
+    vector_size_t numSelected = 0;
+    filterRows_.applyToSelected(
+        [&](vector_size_t row) { rawIndices[numSelected++] = row; });
+  }
+  totalRemainingFilterTime_.fetch_add(
+      (getCurrentTimeMicro() - filterStartMicros) * 1000,
+      std::memory_order_relaxed);
+  return numRows;
+}
+
+bool HiveDataSource::hasFilter() const {
+  return scanSpec_->hasFilter() || remainingFilterExprSet_ != nullptr ||
+      randomSkip_ != nullptr;
+}
+
+void HiveDataSource::cancelSplit() {
+  if (split_ == nullptr) {
+    return;
+  }
+  splitReader_->updateRuntimeStats(runtimeStats_);
+  clearPendingFiles();
+  detachSharedScan();
+  split_.reset();
+  // Destroying the readers cancels the loads they scheduled and not started.
+  splitReader_.reset();
+}
+
 void HiveDataSource::resetSplit() {
+  detachSharedScan();
   split_.reset();
   splitReader_->resetSplit();
   // Keep readers around to hold adaptation.
@@ -15,12 +15,18 @@
  */
 #pragma once
 
+#include <deque>
+
+#include <folly/container/F14Set.h>
+
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/SharedScan.h"
+#include "velox/connectors/hive/SplitAggregates.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/Statistics.h"
@@ -47,11 +53,17 @@ class HiveDataSource : public DataSource {
       const ConnectorQueryCtx* connectorQueryCtx,
       const std::shared_ptr<HiveConfig>& hiveConfig);
 
+  ~HiveDataSource() override;
+
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
   std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
       override;
 
+  void cancelSplit() override;
+
+  bool hasFilter() const override;
+
   void addDynamicFilter(
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
@@ -127,7 +139,38 @@ class HiveDataSource : public DataSource {
   std::shared_ptr<HiveColumnHandle> rowIndexColumn_;
 
  private:
+  // Maximum number of files of a HiveMultiFileConnectorSplit whose file
+  // handles and footers are read ahead of the file being read.
+  static constexpr int32_t kMaxPrefetchFiles = 16;
+
+  // Starts reading the single file of 'split'. Called by addSplit() and for
+  // each further file of a HiveMultiFileConnectorSplit by next().
+  void addFileSplit(std::shared_ptr<HiveConnectorSplit> split);
+
+  // Returns the next batch of the current file, nullptr at its end.
+  std::optional<RowVectorPtr> nextInFile(
+      uint64_t size,
+      velox::ContinueFuture& future);
+
+  // Opens the file handle of 'split' and, if the footers of its format are
+  // cached in FileTailCache, reads its footer into the cache. Errors are
+  // ignored and raised when the SplitReader opens the file.
+  std::shared_ptr<AsyncSource<FileHandleCachedPtr>> makeFilePrefetch(
+      const std::shared_ptr<HiveConnectorSplit>& split) const;
+
+  // Starts the prefetch of the first kMaxPrefetchFiles of 'pendingFiles_' on
+  // 'executor_'. Does nothing if there is no executor.
+  void prefetchPendingFiles();
+
+  // Drops 'pendingFiles_' after waiting for their prefetches in progress.
+  void clearPendingFiles();
+
   std::unique_ptr<HivePartitionFunction> setupBucketConversion();
+
+  // Returns false if the partition key values of 'split_' do not pass the
+  // dynamic filters on partition key columns.
+  bool testDynamicPartitionFilters() const;
+
   vector_size_t applyBucketConversion(
       const RowVectorPtr& rowVector,
       BufferPtr& indices);
@@ -138,10 +181,33 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Evaluates 'remainingFilterConjuncts_' one after the other, each on the
+  // rows that passed the previous ones, and narrows 'filterRows_' to the
+  // passing rows. Same contract as evaluateRemainingFilter().
+  vector_size_t evaluateRemainingFilterConjuncts(const RowVectorPtr& rowVector);
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
 
+  // Attaches to the SharedScan of the current split if shared scans are
+  // enabled and the scan can share the decoding of the split.
+  void maybeAttachSharedScan();
+
+  // Reads the next batch of the current split from 'sharedScan_' into
+  // 'output_'. Returns the number of rows scanned, or std::nullopt and sets
+  // 'future' if another scan is decoding the batch. Continues with
+  // 'splitReader_' if this is detached from 'sharedScan_'.
+  std::optional<uint64_t> nextFromSharedScan(
+      uint64_t size,
+      velox::ContinueFuture& future);
+
+  void detachSharedScan();
+
+  // Returns true if some rows of a split may be dropped by a filter, so that
+  // the file statistics do not describe the rows the scan returns.
+  bool hasRowFilter() const;
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -170,9 +236,66 @@ class HiveDataSource : public DataSource {
   // columns need to be materialized eagerly to avoid missing values in output.
   std::vector<column_index_t> multiReferencedFields_;
 
+  // A deterministic remaining filter that is a conjunction, split into its
+  // conjuncts. 'loadFields' are the fields in 'multiReferencedFields_' that
+  // are first referenced by the conjunct. These are loaded only for the rows
+  // that passed the conjuncts before it instead of for all rows. Empty if the
+  // remaining filter is not split.
+  struct RemainingFilterConjunct {
+    std::unique_ptr<exec::ExprSet> exprSet;
+    std::vector<column_index_t> loadFields;
+  };
+  std::vector<RemainingFilterConjunct> remainingFilterConjuncts_;
+
+  // Number of columns in 'multiReferencedFields_' loaded after the first
+  // conjunct and the number of their values that were not decoded because
+  // the rows failed an earlier conjunct.
+  uint64_t remainingFilterDeferredColumns_{0};
+  uint64_t remainingFilterSkippedRows_{0};
+
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
   int64_t numBucketConversion_ = 0;
+
+  // Computes the output of a scan of kAggregated columns, one row per split.
+  // Null if the scan has no aggregated columns.
+  std::unique_ptr<SplitAggregates> splitAggregates_;
+
+  // kStart until the statistics of the current split have been tried, kRows
+  // while the aggregates are computed from the rows of the split and kDone
+  // once the row of the split has been returned.
+  enum class AggregatesState { kStart, kRows, kDone };
+  AggregatesState aggregatesState_{AggregatesState::kStart};
+
+  // Number of splits whose aggregates were answered from file statistics.
+  int64_t numSplitsAggregatedFromStats_{0};
+
+  // The files of the current HiveMultiFileConnectorSplit after the one being
+  // read. 'prefetch' opens the file handle in the background and holds it
+  // until the file is read, so that the handle is not evicted from the cache
+  // before. Null if the prefetch has not been started.
+  struct PendingFile {
+    std::shared_ptr<HiveConnectorSplit> split;
+    std::shared_ptr<AsyncSource<FileHandleCachedPtr>> prefetch;
+  };
+  std::deque<PendingFile> pendingFiles_;
+
+  // Number of files read as part of a HiveMultiFileConnectorSplit.
+  uint64_t numCoalescedFiles_{0};
+
+  // Time spent in addFileSplit() on the query thread, e.g. opening the file,
+  // reading its footer and testing its statistics, summed over the files.
+  uint64_t splitSetupMicros_{0};
+
+  // Number of rows dropped by the filter on each column at the time the first
+  // dynamic filter was added to it, keyed on output channel. Used to report
+  // the rows pruned by dynamic filters. Keyed on channel because 'scanSpec_'
+  // is replaced in setFromDataSource() while the selectivity carries over.
+  folly::F14FastMap<column_index_t, uint64_t> dynamicFilterBaselines_;
+
+  // Partition key columns with a dynamic filter. Tested against the partition
+  // key values of each split before its file is opened.
+  folly::F14FastSet<std::string> dynamicPartitionFilterColumns_;
   std::unique_ptr<HivePartitionFunction> partitionFunction_;
   std::vector<uint32_t> partitions_;
 
@@ -183,6 +306,21 @@ class HiveDataSource : public DataSource {
   SelectivityVector filterLazyBaseRows_;
   exec::FilterEvalCtx filterEvalCtx_;
 
+  const bool sharedScanEnabled_;
+  // The SharedScan of the current split and the id of this in it. Null if
+  // the split is read only by 'splitReader_'.
+  std::shared_ptr<SharedScan> sharedScan_;
+  int32_t sharedScanConsumer_{0};
+  // Number of rows of the current split read from 'sharedScan_'.
+  uint64_t sharedScanSplitRows_{0};
+  // Number of rows read from shared scans, and the number of those rows and
+  // their bytes that were decoded by another scan.
+  uint64_t sharedScanRows_{0};
+  uint64_t sharedScanReusedRows_{0};
+  uint64_t sharedScanReusedBytes_{0};
+  // Number of times this fell behind a shared scan and read on its own.
+  uint64_t numSharedScanDetached_{0};
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
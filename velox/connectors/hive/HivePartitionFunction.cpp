@@ -108,12 +108,73 @@ inline uint32_t hashOne<TypeKind::UNKNOWN>(UnknownValue /*value*/) {
   VELOX_FAIL("Unknown values cannot be non-NULL");
 }
 
+void hashPrecomputed(
+    uint32_t precomputedHash,
+    vector_size_t numRows,
+    bool mix,
+    std::vector<uint32_t>& hashes) {
+  for (auto i = 0; i < numRows; ++i) {
+    hashes[i] = mix ? hashes[i] * 31 + precomputedHash : precomputedHash;
+  }
+}
+
+// Hashes all rows of a column without nulls reading the values buffer
+// directly. The per-row null and encoding checks of DecodedVector are hoisted
+// out of the loop so that the compiler can unroll and vectorize it. Returns
+// false if 'values' has nulls or not all rows are selected.
+template <TypeKind kind>
+bool hashPrimitiveNoNulls(
+    const DecodedVector& values,
+    const SelectivityVector& rows,
+    bool mix,
+    std::vector<uint32_t>& hashes) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::BOOLEAN || kind == TypeKind::UNKNOWN) {
+    // Booleans are bit-packed and unknowns are always null.
+    return false;
+  } else {
+    if (values.mayHaveNulls() || !rows.isAllSelected()) {
+      return false;
+    }
+    const vector_size_t numRows = rows.size();
+    if (values.isConstantMapping()) {
+      hashPrecomputed(
+          hashOne<kind>(values.valueAt<T>(0)), numRows, mix, hashes);
+      return true;
+    }
+
+    const T* rawValues = values.data<T>();
+    uint32_t* rawHashes = hashes.data();
+    auto hashRows = [&](auto getValue) INLINE_LAMBDA {
+      if (mix) {
+        for (auto i = 0; i < numRows; ++i) {
+          rawHashes[i] = rawHashes[i] * 31 + hashOne<kind>(getValue(i));
+        }
+      } else {
+        for (auto i = 0; i < numRows; ++i) {
+          rawHashes[i] = hashOne<kind>(getValue(i));
+        }
+      }
+    };
+    if (values.isIdentityMapping()) {
+      hashRows([&](auto row) { return rawValues[row]; });
+    } else {
+      const vector_size_t* indices = values.indices();
+      hashRows([&](auto row) { return rawValues[indices[row]]; });
+    }
+    return true;
+  }
+}
+
 template <TypeKind kind>
 void hashPrimitive(
     const DecodedVector& values,
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes) {
+  if (hashPrimitiveNoNulls<kind>(values, rows, mix, hashes)) {
+    return;
+  }
   if (rows.isAllSelected()) {
     // The compiler seems to be a little fickle with optimizations.
     // Although rows.applyToSelected should do roughly the same thing, doing
@@ -139,15 +200,6 @@ void hashPrimitive(
   }
 }
 
-void hashPrecomputed(
-    uint32_t precomputedHash,
-    vector_size_t numRows,
-    bool mix,
-    std::vector<uint32_t>& hashes) {
-  for (auto i = 0; i < numRows; ++i) {
-    hashes[i] = mix ? hashes[i] * 31 + precomputedHash : precomputedHash;
-  }
-}
 } // namespace
 
 template <>
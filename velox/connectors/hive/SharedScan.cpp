@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/SharedScan.h"
+
+#include "velox/common/memory/Memory.h"
+#include "velox/connectors/hive/SplitReader.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+namespace {
+
+bool isFilterSupported(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Clears the bits of the rows of 'rows' whose value in 'decoded' does not
+// pass 'filter'.
+template <TypeKind kind>
+void applyColumnFilter(
+    const common::Filter& filter,
+    const DecodedVector& decoded,
+    SelectivityVector& rows) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const SelectivityVector candidates = rows;
+  candidates.applyToSelected([&](vector_size_t row) {
+    const bool passed = decoded.isNullAt(row)
+        ? filter.testNull()
+        : common::applyFilter(filter, decoded.valueAt<T>(row));
+    if (!passed) {
+      rows.setValid(row, false);
+    }
+  });
+  rows.updateBounds();
+}
+
+// Copies the rows of 'source' in 'rows' to a new vector of 'pool'. Strings
+// are copied since the string buffers of 'source' are of another pool.
+VectorPtr copyRows(
+    const VectorPtr& source,
+    const SelectivityVector& rows,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  auto target = BaseVector::create(source->type(), numRows, pool);
+  std::vector<BaseVector::CopyRange> ranges;
+  rows.applyToSelected([&](vector_size_t row) {
+    if (!ranges.empty() &&
+        ranges.back().sourceIndex + ranges.back().count == row) {
+      ++ranges.back().count;
+    } else {
+      ranges.push_back(
+          {row,
+           ranges.empty() ? 0 : ranges.back().targetIndex + ranges.back().count,
+           1});
+    }
+  });
+  target->copyRanges(source.get(), ranges);
+  return target;
+}
+
+} // namespace
+
+// static
+std::optional<std::vector<std::string>> SharedScan::columnsToRead(
+    const common::ScanSpec& scanSpec,
+    const RowType& fileType) {
+  if (scanSpec.numDisjunctions() > 0) {
+    return std::nullopt;
+  }
+  std::vector<std::string> columns;
+  for (const auto& child : scanSpec.children()) {
+    if (child->isConstant()) {
+      continue;
+    }
+    const auto index = fileType.getChildIdxIfExists(child->fieldName());
+    if (!index.has_value() || child->isFlatMapAsStruct()) {
+      return std::nullopt;
+    }
+    if (child->filter() != nullptr) {
+      if (!isFilterSupported(*fileType.childAt(*index))) {
+        return std::nullopt;
+      }
+    } else if (child->hasFilter()) {
+      // A filter on a nested field.
+      return std::nullopt;
+    }
+    columns.push_back(child->fieldName());
+  }
+  return columns;
+}
+
+// static
+RowVectorPtr SharedScan::project(
+    const RowVector& batch,
+    const common::ScanSpec& scanSpec,
+    const RowTypePtr& outputType,
+    memory::MemoryPool* pool) {
+  const auto& batchType = batch.type()->asRow();
+  SelectivityVector rows(batch.size());
+  DecodedVector decoded;
+  for (const auto& child : scanSpec.children()) {
+    if (child->isConstant() || child->filter() == nullptr) {
+      continue;
+    }
+    const auto& column =
+        batch.childAt(batchType.getChildIdx(child->fieldName()));
+    decoded.decode(*column, rows);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        applyColumnFilter,
+        column->typeKind(),
+        *child->filter(),
+        decoded,
+        rows);
+    if (!rows.hasSelections()) {
+      break;
+    }
+  }
+
+  const auto numRows = rows.countSelected();
+  std::vector<VectorPtr> columns;
+  columns.reserve(outputType->size());
+  for (auto i = 0; i < outputType->size(); ++i) {
+    const auto& name = outputType->nameOf(i);
+    const auto* child = scanSpec.childByName(name);
+    VELOX_CHECK_NOT_NULL(child, "No scan spec for column {}", name);
+    if (child->isConstant()) {
+      columns.push_back(
+          BaseVector::wrapInConstant(numRows, 0, child->constantValue()));
+      continue;
+    }
+    columns.push_back(copyRows(
+        batch.childAt(batchType.getChildIdx(name)), rows, numRows, pool));
+  }
+  return std::make_shared<RowVector>(
+      pool, outputType, nullptr, numRows, std::move(columns));
+}
+
+SharedScan::SharedScan(int32_t maxBufferedBatches, int64_t maxMemoryBytes)
+    : maxBufferedBatches_(maxBufferedBatches),
+      maxMemoryBytes_(maxMemoryBytes) {
+  VELOX_CHECK_GT(maxBufferedBatches_, 0);
+  VELOX_CHECK_GT(maxMemoryBytes_, 0);
+}
+
+std::optional<int32_t> SharedScan::attach(
+    const RowTypePtr& fileType,
+    const std::vector<std::string>& columns) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (failed_ || atEnd_ || firstBatch_ > 0) {
+    return std::nullopt;
+  }
+  if (fileType_ == nullptr) {
+    fileType_ = fileType;
+  } else if (!fileType_->equivalent(*fileType)) {
+    return std::nullopt;
+  }
+  for (const auto& column : columns) {
+    if (std::find(columns_.begin(), columns_.end(), column) !=
+        columns_.end()) {
+      continue;
+    }
+    if (started_) {
+      return std::nullopt;
+    }
+    columns_.push_back(column);
+  }
+  const auto id = nextConsumerId_++;
+  consumers_[id] = 0;
+  ++stats_.numConsumers;
+  return id;
+}
+
+void SharedScan::detach(int32_t consumer) {
+  std::lock_guard<std::mutex> l(mutex_);
+  consumers_.erase(consumer);
+  trimLocked();
+}
+
+SharedScan::Result SharedScan::next(
+    int32_t consumer,
+    uint64_t size,
+    const SplitReader& splitReader,
+    RowVectorPtr& batch,
+    bool& decoded,
+    ContinueFuture& future) {
+  decoded = false;
+  std::unique_lock<std::mutex> l(mutex_);
+  auto it = consumers_.find(consumer);
+  if (it == consumers_.end()) {
+    return Result::kDetached;
+  }
+  if (it->second < firstBatch_ + static_cast<int64_t>(batches_.size())) {
+    batch = batches_[it->second - firstBatch_];
+    ++it->second;
+    trimLocked();
+    return Result::kBatch;
+  }
+  if (atEnd_) {
+    return Result::kAtEnd;
+  }
+  if (decoding_) {
+    auto [promise, semiFuture] =
+        makeVeloxContinuePromiseContract("SharedScan::next");
+    promises_.push_back(std::move(promise));
+    future = std::move(semiFuture);
+    return Result::kBlocked;
+  }
+  if (batches_.size() >= static_cast<size_t>(maxBufferedBatches_)) {
+    // The consumers that have not read the oldest batch continue on their
+    // own.
+    for (auto consumerIt = consumers_.begin();
+         consumerIt != consumers_.end();) {
+      if (consumerIt->second == firstBatch_) {
+        ++stats_.numDetached;
+        consumerIt = consumers_.erase(consumerIt);
+      } else {
+        ++consumerIt;
+      }
+    }
+    trimLocked();
+  }
+  started_ = true;
+  decoding_ = true;
+  l.unlock();
+
+  RowVectorPtr newBatch;
+  bool error = false;
+  try {
+    newBatch = decode(size, splitReader);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Shared scan failed, its scans continue on their own: "
+                 << e.what();
+    error = true;
+  }
+
+  std::vector<ContinuePromise> promises;
+  l.lock();
+  decoding_ = false;
+  promises.swap(promises_);
+  Result result = Result::kAtEnd;
+  if (error) {
+    // All consumers continue on their own with their own readers and memory.
+    failed_ = true;
+    stats_.numDetached += consumers_.size();
+    consumers_.clear();
+    batches_.clear();
+    result = Result::kDetached;
+  } else if (newBatch == nullptr) {
+    atEnd_ = true;
+  } else {
+    ++stats_.numBatches;
+    stats_.numRows += newBatch->size();
+    batches_.push_back(newBatch);
+    it = consumers_.find(consumer);
+    VELOX_CHECK(it != consumers_.end());
+    ++it->second;
+    trimLocked();
+    batch = std::move(newBatch);
+    decoded = true;
+    result = Result::kBatch;
+  }
+  l.unlock();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return result;
+}
+
+RowVectorPtr SharedScan::decode(
+    uint64_t size,
+    const SplitReader& splitReader) {
+  if (rowReader_ == nullptr) {
+    // 'columns_' does not change after 'started_' is set.
+    std::vector<TypePtr> types;
+    auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+    for (auto i = 0; i < columns_.size(); ++i) {
+      types.push_back(fileType_->findChild(columns_[i]));
+      scanSpec->addFieldRecursively(columns_[i], *types.back(), i);
+    }
+    rowType_ = ROW(std::vector<std::string>(columns_), std::move(types));
+    rootPool_ = memory::memoryManager()->addRootPool("", maxMemoryBytes_);
+    pool_ = rootPool_->addLeafChild("sharedScan");
+    ioStats_ = std::make_shared<io::IoStatistics>();
+    reader_ = splitReader.createSharedReader(pool_.get(), ioStats_);
+    rowReader_ =
+        reader_->createRowReader(splitReader.sharedRowReaderOptions(scanSpec));
+  }
+  VectorPtr output = BaseVector::create(rowType_, 0, pool_.get());
+  if (rowReader_->next(size, output) == 0) {
+    return nullptr;
+  }
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(output);
+  VELOX_CHECK_NOT_NULL(rowVector);
+  // The batch is read by other threads. Load the lazy columns here.
+  for (auto i = 0; i < rowVector->childrenSize(); ++i) {
+    rowVector->childAt(i) =
+        BaseVector::loadedVectorShared(rowVector->childAt(i));
+  }
+  return rowVector;
+}
+
+void SharedScan::trimLocked() {
+  int64_t minBatch = firstBatch_ + batches_.size();
+  for (const auto& [id, position] : consumers_) {
+    minBatch = std::min(minBatch, position);
+  }
+  while (firstBatch_ < minBatch) {
+    batches_.pop_front();
+    ++firstBatch_;
+  }
+}
+
+SharedScan::Stats SharedScan::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+std::pair<std::shared_ptr<SharedScan>, int32_t> SharedScanRegistry::attach(
+    const std::string& key,
+    const RowTypePtr& fileType,
+    const std::vector<std::string>& columns,
+    int32_t maxBufferedBatches,
+    int64_t maxMemoryBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (++numAttaches_ % 1'024 == 0) {
+    for (auto it = scans_.begin(); it != scans_.end();) {
+      if (it->second.expired()) {
+        it = scans_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  auto& entry = scans_[key];
+  if (auto scan = entry.lock()) {
+    if (auto consumer = scan->attach(fileType, columns)) {
+      return {std::move(scan), *consumer};
+    }
+  }
+  auto scan = std::make_shared<SharedScan>(maxBufferedBatches, maxMemoryBytes);
+  const auto consumer = scan->attach(fileType, columns);
+  VELOX_CHECK(consumer.has_value());
+  entry = scan;
+  return {std::move(scan), *consumer};
+}
+
+int32_t SharedScanRegistry::numScans() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  int32_t numScans = 0;
+  for (const auto& [key, scan] : scans_) {
+    numScans += !scan.expired();
+  }
+  return numScans;
+}
+
+SharedScanRegistry& sharedScans() {
+  static SharedScanRegistry* registry = new SharedScanRegistry();
+  return *registry;
+}
+
+} // namespace facebook::velox::connector::hive
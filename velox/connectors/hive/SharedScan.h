@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive {
+
+class SplitReader;
+
+/// Decodes a split once for concurrent scans of the same split, e.g. many
+/// dashboard queries over a newly added partition. Each scan is a consumer.
+/// Consumers that attach before the first batch is decoded add their columns
+/// to the columns the SharedScan reads. Batches are decoded without filters
+/// by whichever consumer first needs a batch, on its own thread, and are kept
+/// until every consumer has read them. Each consumer then applies its own
+/// filters and copies the passing rows of its columns to its own memory, see
+/// project().
+///
+/// The decoded batches outlive any one query and are allocated from a root
+/// pool of the SharedScan whose capacity is capped at 'maxMemoryBytes' and is
+/// granted by the memory arbitrator. When a consumer needs a new batch while
+/// 'maxBufferedBatches' are kept, the consumers that have not read the oldest
+/// batch are detached and continue reading the split on their own, so that a
+/// slow or blocked query neither holds memory nor stalls the others. The
+/// consumers are also detached if decoding fails, e.g. when the pool is out of
+/// capacity.
+class SharedScan {
+ public:
+  /// Returns the file columns a scan with 'scanSpec' reads from a file with
+  /// columns 'fileType', or std::nullopt if the scan cannot share the decoding
+  /// of the file. This is the case if the scan has filters other than on top
+  /// level columns of primitive types.
+  static std::optional<std::vector<std::string>> columnsToRead(
+      const common::ScanSpec& scanSpec,
+      const RowType& fileType);
+
+  /// Returns the rows of 'batch' that pass the filters of 'scanSpec' as a
+  /// vector of type 'outputType' allocated from 'pool'. Columns of 'scanSpec'
+  /// with a constant value, e.g. partition keys, are filled with it.
+  static RowVectorPtr project(
+      const RowVector& batch,
+      const common::ScanSpec& scanSpec,
+      const RowTypePtr& outputType,
+      memory::MemoryPool* pool);
+
+  SharedScan(int32_t maxBufferedBatches, int64_t maxMemoryBytes);
+
+  /// Adds a consumer that reads 'columns' of a split with file columns
+  /// 'fileType'. Returns the id of the consumer or std::nullopt if it cannot
+  /// be added, i.e. 'fileType' differs or decoding has started and has either
+  /// dropped batches or does not read all of 'columns'.
+  std::optional<int32_t> attach(
+      const RowTypePtr& fileType,
+      const std::vector<std::string>& columns);
+
+  /// Removes 'consumer'. The batches no other consumer needs are dropped.
+  void detach(int32_t consumer);
+
+  enum class Result {
+    /// 'batch' is set to the next batch of the consumer.
+    kBatch,
+    /// All rows of the split have been returned to the consumer.
+    kAtEnd,
+    /// Another consumer is decoding the next batch. 'future' is realized when
+    /// it is done.
+    kBlocked,
+    /// The consumer fell behind or decoding failed. The consumer is detached
+    /// and reads the rest of the split on its own.
+    kDetached,
+  };
+
+  /// Returns the next batch of 'consumer' in 'batch'. If no consumer has
+  /// decoded the batch yet, decodes up to 'size' rows and sets 'decoded' to
+  /// true. The reader of the split is made by 'splitReader' at the first
+  /// decode.
+  Result next(
+      int32_t consumer,
+      uint64_t size,
+      const SplitReader& splitReader,
+      RowVectorPtr& batch,
+      bool& decoded,
+      ContinueFuture& future);
+
+  struct Stats {
+    int32_t numConsumers{0};
+    int32_t numDetached{0};
+    int64_t numBatches{0};
+    int64_t numRows{0};
+  };
+
+  Stats stats() const;
+
+ private:
+  // Decodes the next batch of at most 'size' rows. Returns nullptr at the end
+  // of the split. Called by one consumer at a time without holding 'mutex_'.
+  RowVectorPtr decode(uint64_t size, const SplitReader& splitReader);
+
+  // Drops the batches that all consumers have read.
+  void trimLocked();
+
+  const int32_t maxBufferedBatches_;
+  const int64_t maxMemoryBytes_;
+
+  // The pools of the decoded batches and the readers, declared first so that
+  // they are destroyed after them.
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::shared_ptr<io::IoStatistics> ioStats_;
+  std::unique_ptr<dwio::common::Reader> reader_;
+  std::unique_ptr<dwio::common::RowReader> rowReader_;
+  RowTypePtr rowType_;
+
+  mutable std::mutex mutex_;
+  RowTypePtr fileType_;
+  // The union of the columns of the consumers, in order of first request.
+  std::vector<std::string> columns_;
+  // Number of the next batch of each consumer, keyed on consumer id.
+  folly::F14FastMap<int32_t, int64_t> consumers_;
+  int32_t nextConsumerId_{0};
+  // The batches not yet read by all consumers. The first one is batch number
+  // 'firstBatch_'.
+  std::deque<RowVectorPtr> batches_;
+  int64_t firstBatch_{0};
+  // True once the first decode has started. 'columns_' no longer changes.
+  bool started_{false};
+  // True while a consumer decodes a batch.
+  bool decoding_{false};
+  bool atEnd_{false};
+  bool failed_{false};
+  // Consumers waiting for the batch being decoded.
+  std::vector<ContinuePromise> promises_;
+  Stats stats_;
+};
+
+/// Finds the SharedScan of a split for a scan that starts reading it.
+class SharedScanRegistry {
+ public:
+  /// Attaches a consumer that reads 'columns' to the SharedScan of the split
+  /// identified by 'key', see SplitReader::sharedScanKey(). Starts a new
+  /// SharedScan for the split if the consumer cannot join the current one.
+  /// Returns the SharedScan and the id of the consumer in it.
+  std::pair<std::shared_ptr<SharedScan>, int32_t> attach(
+      const std::string& key,
+      const RowTypePtr& fileType,
+      const std::vector<std::string>& columns,
+      int32_t maxBufferedBatches,
+      int64_t maxMemoryBytes);
+
+  /// Returns the number of splits with a SharedScan in use.
+  int32_t numScans() const;
+
+ private:
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::weak_ptr<SharedScan>> scans_;
+  // Number of attach() calls. Entries of finished scans are removed every so
+  // many calls.
+  int64_t numAttaches_{0};
+};
+
+/// Returns the process wide registry of shared scans.
+SharedScanRegistry& sharedScans();
+
+} // namespace facebook::velox::connector::hive
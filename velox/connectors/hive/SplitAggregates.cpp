@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/SplitAggregates.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/Statistics.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+bool isIntegerKind(TypeKind kind) {
+  return kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+      kind == TypeKind::INTEGER || kind == TypeKind::BIGINT;
+}
+
+bool isFloatingPointKind(TypeKind kind) {
+  return kind == TypeKind::REAL || kind == TypeKind::DOUBLE;
+}
+
+// Returns 'value' as a variant of 'kind'. Statistics keep all integers as
+// int64_t and all floating point numbers as double.
+template <typename T>
+variant toVariant(TypeKind kind, T value) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return variant(static_cast<int8_t>(value));
+    case TypeKind::SMALLINT:
+      return variant(static_cast<int16_t>(value));
+    case TypeKind::INTEGER:
+      return variant(static_cast<int32_t>(value));
+    case TypeKind::BIGINT:
+      return variant(static_cast<int64_t>(value));
+    case TypeKind::REAL:
+      return variant(static_cast<float>(value));
+    case TypeKind::DOUBLE:
+      return variant(static_cast<double>(value));
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace
+
+SplitAggregates::SplitAggregates(
+    const RowTypePtr& outputType,
+    const std::vector<const HiveColumnHandle*>& handles,
+    const RowTypePtr& dataColumns)
+    : outputType_(outputType) {
+  VELOX_CHECK_EQ(outputType_->size(), handles.size());
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < handles.size(); ++i) {
+    const auto* handle = handles[i];
+    VELOX_CHECK(
+        handle->columnType() == HiveColumnHandle::ColumnType::kAggregated);
+    const auto& name = handle->name();
+    const auto& aggregation = handle->aggregation();
+    const auto& resultType = outputType_->childAt(i);
+    Aggregate aggregate;
+    aggregate.resultType = resultType;
+    if (aggregation == "count") {
+      aggregate.kind = Kind::kCount;
+    } else if (aggregation == "min") {
+      aggregate.kind = Kind::kMin;
+    } else if (aggregation == "max") {
+      aggregate.kind = Kind::kMax;
+    } else if (aggregation == "sum") {
+      aggregate.kind = Kind::kSum;
+    } else {
+      VELOX_USER_FAIL("Unsupported aggregation in table scan: {}", aggregation);
+    }
+
+    if (name.empty()) {
+      VELOX_USER_CHECK(
+          aggregate.kind == Kind::kCount,
+          "Only count can be computed without a column: {}",
+          aggregation);
+    } else {
+      VELOX_USER_CHECK(
+          dataColumns && dataColumns->containsChild(name),
+          "Aggregated column is not a data column: {}",
+          name);
+      const auto& type = dataColumns->findChild(name);
+      const auto kind = type->kind();
+      VELOX_USER_CHECK(
+          !type->isDecimal() &&
+              (isIntegerKind(kind) || isFloatingPointKind(kind) ||
+               (kind == TypeKind::VARCHAR && aggregate.kind != Kind::kSum)),
+          "Unsupported type for {} in table scan: {}",
+          aggregation,
+          type->toString());
+      auto it = std::find(names.begin(), names.end(), name);
+      aggregate.channel = it - names.begin();
+      if (it == names.end()) {
+        names.push_back(name);
+        types.push_back(type);
+      }
+      switch (aggregate.kind) {
+        case Kind::kMin:
+        case Kind::kMax:
+          VELOX_USER_CHECK(
+              resultType->equivalent(*type),
+              "{} of {} cannot return {}",
+              aggregation,
+              type->toString(),
+              resultType->toString());
+          break;
+        case Kind::kSum:
+          VELOX_USER_CHECK(
+              resultType->equivalent(
+                  isIntegerKind(kind) ? *BIGINT() : *DOUBLE()),
+              "sum of {} cannot return {}",
+              type->toString(),
+              resultType->toString());
+          break;
+        default:
+          break;
+      }
+    }
+    if (aggregate.kind == Kind::kCount) {
+      VELOX_USER_CHECK(
+          resultType->equivalent(*BIGINT()),
+          "count cannot return {}",
+          resultType->toString());
+    }
+    aggregate.value = variant::null(resultType->kind());
+    aggregates_.push_back(std::move(aggregate));
+  }
+  inputType_ = ROW(std::move(names), std::move(types));
+}
+
+bool SplitAggregates::addStatistics(const dwio::common::Reader& reader) {
+  const auto numRows = reader.numberOfRows();
+  if (!numRows.has_value()) {
+    return false;
+  }
+  const auto& fileType = reader.rowType();
+  std::vector<std::unique_ptr<dwio::common::ColumnStatistics>> stats(
+      inputType_->size());
+  for (auto i = 0; i < inputType_->size(); ++i) {
+    const auto index = fileType->getChildIdxIfExists(inputType_->nameOf(i));
+    if (!index.has_value() ||
+        fileType->childAt(*index)->kind() != inputType_->childAt(i)->kind()) {
+      return false;
+    }
+    stats[i] =
+        reader.columnStatistics(reader.typeWithId()->childAt(*index)->id());
+    if (!stats[i] || !stats[i]->getNumberOfValues().has_value()) {
+      return false;
+    }
+  }
+
+  std::vector<variant> values(aggregates_.size());
+  std::vector<int64_t> counts(aggregates_.size());
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    if (!aggregate.channel.has_value()) {
+      counts[i] = *numRows;
+      continue;
+    }
+    const auto& columnStats = *stats[*aggregate.channel];
+    counts[i] = *columnStats.getNumberOfValues();
+    if (aggregate.kind == Kind::kCount || counts[i] == 0) {
+      continue;
+    }
+    const auto kind = aggregate.kind == Kind::kSum
+        ? aggregate.resultType->kind()
+        : inputType_->childAt(*aggregate.channel)->kind();
+    if (auto* intStats =
+            dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+                &columnStats)) {
+      auto value = intStats->getSum();
+      if (aggregate.kind == Kind::kMin) {
+        value = intStats->getMinimum();
+      } else if (aggregate.kind == Kind::kMax) {
+        value = intStats->getMaximum();
+      }
+      if (!value.has_value()) {
+        return false;
+      }
+      values[i] = toVariant(kind, *value);
+    } else if (
+        auto* doubleStats =
+            dynamic_cast<const dwio::common::DoubleColumnStatistics*>(
+                &columnStats)) {
+      auto value = doubleStats->getSum();
+      if (aggregate.kind == Kind::kMin) {
+        value = doubleStats->getMinimum();
+      } else if (aggregate.kind == Kind::kMax) {
+        value = doubleStats->getMaximum();
+      }
+      if (!value.has_value()) {
+        return false;
+      }
+      values[i] = toVariant(kind, *value);
+    } else if (
+        auto* stringStats =
+            dynamic_cast<const dwio::common::StringColumnStatistics*>(
+                &columnStats)) {
+      const auto& value = aggregate.kind == Kind::kMin
+          ? stringStats->getMinimum()
+          : stringStats->getMaximum();
+      if (!value.has_value()) {
+        return false;
+      }
+      values[i] = variant(*value);
+    } else {
+      return false;
+    }
+  }
+
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& aggregate = aggregates_[i];
+    aggregate.count += counts[i];
+    if (!values[i].isNull()) {
+      merge(aggregate, values[i]);
+    }
+  }
+  return true;
+}
+
+void SplitAggregates::merge(Aggregate& aggregate, const variant& value) {
+  if (aggregate.value.isNull()) {
+    aggregate.value = value;
+    return;
+  }
+  switch (aggregate.kind) {
+    case Kind::kMin:
+      if (value < aggregate.value) {
+        aggregate.value = value;
+      }
+      break;
+    case Kind::kMax:
+      if (aggregate.value < value) {
+        aggregate.value = value;
+      }
+      break;
+    case Kind::kSum:
+      if (value.kind() == TypeKind::BIGINT) {
+        int64_t sum;
+        VELOX_USER_CHECK(
+            !__builtin_add_overflow(
+                aggregate.value.value<int64_t>(), value.value<int64_t>(), &sum),
+            "BIGINT overflow in sum");
+        aggregate.value = variant(sum);
+      } else {
+        aggregate.value =
+            variant(aggregate.value.value<double>() + value.value<double>());
+      }
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <TypeKind TKind>
+void SplitAggregates::addValues(
+    Aggregate& aggregate,
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    const vector_size_t* indices) {
+  using T = typename TypeTraits<TKind>::NativeType;
+  using SumType = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  std::optional<T> min;
+  std::optional<T> max;
+  SumType sum = 0;
+  int64_t count = 0;
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const auto row = indices ? indices[i] : i;
+    if (decoded.isNullAt(row)) {
+      continue;
+    }
+    const auto value = decoded.valueAt<T>(row);
+    ++count;
+    if (!min.has_value() || value < *min) {
+      min = value;
+    }
+    if (!max.has_value() || *max < value) {
+      max = value;
+    }
+    if constexpr (std::is_arithmetic_v<T>) {
+      if constexpr (std::is_integral_v<T>) {
+        VELOX_USER_CHECK(
+            !__builtin_add_overflow(sum, value, &sum),
+            "BIGINT overflow in sum");
+      } else {
+        sum += value;
+      }
+    }
+  }
+  aggregate.count += count;
+  if (count == 0 || aggregate.kind == Kind::kCount) {
+    return;
+  }
+  if (aggregate.kind == Kind::kSum) {
+    if constexpr (std::is_arithmetic_v<T>) {
+      merge(aggregate, variant(sum));
+    }
+    return;
+  }
+  const auto& value = aggregate.kind == Kind::kMin ? *min : *max;
+  if constexpr (std::is_same_v<T, StringView>) {
+    merge(aggregate, variant(std::string(value)));
+  } else {
+    merge(aggregate, variant(value));
+  }
+}
+
+void SplitAggregates::addInput(
+    const RowVector& input,
+    vector_size_t numRows,
+    const BufferPtr& indices) {
+  const auto* rawIndices = indices ? indices->as<vector_size_t>() : nullptr;
+  SelectivityVector rows;
+  if (rawIndices) {
+    rows.resize(rawIndices[numRows - 1] + 1, false);
+    for (auto i = 0; i < numRows; ++i) {
+      rows.setValid(rawIndices[i], true);
+    }
+    rows.updateBounds();
+  } else {
+    rows.resize(numRows);
+  }
+  std::vector<std::unique_ptr<DecodedVector>> decoded(input.childrenSize());
+  for (auto& aggregate : aggregates_) {
+    if (!aggregate.channel.has_value()) {
+      aggregate.count += numRows;
+      continue;
+    }
+    const auto channel = *aggregate.channel;
+    if (!decoded[channel]) {
+      decoded[channel] =
+          std::make_unique<DecodedVector>(*input.childAt(channel), rows);
+    }
+    const auto& column = *decoded[channel];
+    switch (inputType_->childAt(channel)->kind()) {
+      case TypeKind::TINYINT:
+        addValues<TypeKind::TINYINT>(aggregate, column, numRows, rawIndices);
+        break;
+      case TypeKind::SMALLINT:
+        addValues<TypeKind::SMALLINT>(aggregate, column, numRows, rawIndices);
+        break;
+      case TypeKind::INTEGER:
+        addValues<TypeKind::INTEGER>(aggregate, column, numRows, rawIndices);
+        break;
+      case TypeKind::BIGINT:
+        addValues<TypeKind::BIGINT>(aggregate, column, numRows, rawIndices);
+        break;
+      case TypeKind::REAL:
+        addValues<TypeKind::REAL>(aggregate, column, numRows, rawIndices);
+        break;
+      case TypeKind::DOUBLE:
+        addValues<TypeKind::DOUBLE>(aggregate, column, numRows, rawIndices);
+        break;
+      case TypeKind::VARCHAR:
+        addValues<TypeKind::VARCHAR>(aggregate, column, numRows, rawIndices);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+RowVectorPtr SplitAggregates::finish(memory::MemoryPool* pool) {
+  std::vector<VectorPtr> columns;
+  columns.reserve(aggregates_.size());
+  for (auto& aggregate : aggregates_) {
+    if (aggregate.kind == Kind::kCount) {
+      columns.push_back(BaseVector::createConstant(
+          aggregate.resultType, variant(aggregate.count), 1, pool));
+    } else if (aggregate.value.isNull()) {
+      columns.push_back(
+          BaseVector::createNullConstant(aggregate.resultType, 1, pool));
+    } else {
+      columns.push_back(BaseVector::createConstant(
+          aggregate.resultType, aggregate.value, 1, pool));
+    }
+    aggregate.count = 0;
+    aggregate.value = variant::null(aggregate.resultType->kind());
+  }
+  return std::make_shared<RowVector>(
+      pool, outputType_, nullptr, 1, std::move(columns));
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/type/Variant.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::dwio::common {
+class Reader;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::connector::hive {
+
+class HiveColumnHandle;
+
+/// Computes the kAggregated columns of a scan for one split. The supported
+/// aggregates are count(*), count(x), min(x), max(x) and sum(x) over columns
+/// of integer, floating point and, for min and max, varchar types. The
+/// aggregates are taken from the file statistics when these describe the rows
+/// of the split and are otherwise accumulated from the rows the scan reads.
+class SplitAggregates {
+ public:
+  /// 'handles' are the column handles of 'outputType', in order. 'dataColumns'
+  /// gives the types of the aggregated data columns.
+  SplitAggregates(
+      const RowTypePtr& outputType,
+      const std::vector<const HiveColumnHandle*>& handles,
+      const RowTypePtr& dataColumns);
+
+  /// The data columns to read when the aggregates are computed from rows.
+  const RowTypePtr& inputType() const {
+    return inputType_;
+  }
+
+  /// Sets the aggregates from the file statistics of 'reader'. Returns false
+  /// and leaves the state unchanged if some aggregate is not answered by the
+  /// statistics.
+  bool addStatistics(const dwio::common::Reader& reader);
+
+  /// Adds the first 'numRows' rows of 'input', or the rows in 'indices' if
+  /// these are given. 'input' has the columns of inputType().
+  void addInput(
+      const RowVector& input,
+      vector_size_t numRows,
+      const BufferPtr& indices);
+
+  /// Returns one row with the aggregates of the split and resets the state for
+  /// the next split.
+  RowVectorPtr finish(memory::MemoryPool* pool);
+
+ private:
+  enum class Kind { kCount, kMin, kMax, kSum };
+
+  struct Aggregate {
+    Kind kind;
+    // Channel of the aggregated column in 'inputType_'. Not set for count(*).
+    std::optional<column_index_t> channel;
+    TypePtr resultType;
+    int64_t count{0};
+    // Null if no non-null value was added.
+    variant value;
+  };
+
+  template <TypeKind TKind>
+  void addValues(
+      Aggregate& aggregate,
+      const DecodedVector& decoded,
+      vector_size_t numRows,
+      const vector_size_t* indices);
+
+  void merge(Aggregate& aggregate, const variant& value);
+
+  const RowTypePtr outputType_;
+  RowTypePtr inputType_;
+  std::vector<Aggregate> aggregates_;
+};
+
+} // namespace facebook::velox::connector::hive
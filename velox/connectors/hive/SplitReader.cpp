@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/DirectBufferedInput.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -149,10 +150,27 @@ void SplitReader::prepareSplit(
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
     VELOX_CHECK(emptySplit_);
+    endPreload();
     return;
   }
 
   createRowReader();
+  endPreload();
+}
+
+void SplitReader::skipSplit(dwio::common::RuntimeStatistics& runtimeStats) {
+  VELOX_CHECK_NULL(baseReader_);
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  emptySplit_ = true;
+}
+
+void SplitReader::endPreload() {
+  // The row reader has scheduled the loads of its first stripe or row group.
+  // Later loads are made as usual.
+  if (auto& budget = baseReaderOpts_.preloadBudget()) {
+    *budget = 0;
+  }
 }
 
 uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
@@ -198,11 +216,134 @@ bool SplitReader::allPrefetchIssued() const {
   return baseRowReader_ && baseRowReader_->allPrefetchIssued();
 }
 
+const dwio::common::Reader* SplitReader::statisticsReader() const {
+  if (!baseReader_ || hiveSplit_->start != 0 ||
+      hiveSplit_->length < fileSize_ || hiveSplit_->numStripeParts > 1) {
+    return nullptr;
+  }
+  return baseReader_.get();
+}
+
 void SplitReader::setConnectorQueryCtx(
     const ConnectorQueryCtx* connectorQueryCtx) {
   connectorQueryCtx_ = connectorQueryCtx;
 }
 
+bool SplitReader::supportsSharedScan() const {
+  return !baseReaderOpts_.randomSkip() &&
+      !baseRowReaderOpts_.getRowNumberColumnInfo().has_value() &&
+      hiveSplit_->numStripeParts == 1;
+}
+
+namespace {
+// Appends the entries of 'map' to 'key' in order of the keys.
+void appendSorted(
+    const std::unordered_map<std::string, std::string>& map,
+    std::string& key) {
+  std::vector<std::pair<std::string, std::string>> entries(
+      map.begin(), map.end());
+  std::sort(entries.begin(), entries.end());
+  for (const auto& [name, value] : entries) {
+    key += fmt::format("{}:{}={}:{};", name.size(), name, value.size(), value);
+  }
+  key += '|';
+}
+} // namespace
+
+std::string SplitReader::sharedScanKey() const {
+  const auto& properties = hiveSplit_->properties;
+  const auto optionalToString = [](const std::optional<int64_t>& value) {
+    return value.has_value() ? std::to_string(*value) : std::string();
+  };
+  auto key = fmt::format(
+      "{}:{}|{}:{}|{}|{}|{}|{}|{}|{}|",
+      hiveSplit_->connectorId.size(),
+      hiveSplit_->connectorId,
+      hiveSplit_->filePath.size(),
+      hiveSplit_->filePath,
+      hiveSplit_->start,
+      hiveSplit_->length,
+      dwio::common::toString(hiveSplit_->fileFormat),
+      properties.has_value() ? optionalToString(properties->fileSize) : "",
+      properties.has_value() ? optionalToString(properties->modificationTime)
+                             : "",
+      requestedType()->toString());
+  appendSorted(hiveSplit_->serdeParameters, key);
+  if (const auto* session = connectorQueryCtx_->sessionProperties()) {
+    appendSorted(session->valuesCopy(), key);
+  }
+  return key;
+}
+
+std::unique_ptr<dwio::common::Reader> SplitReader::createSharedReader(
+    memory::MemoryPool* pool,
+    const std::shared_ptr<io::IoStatistics>& ioStats) const {
+  auto fileHandle = fileHandleFactory_->generate(
+      hiveSplit_->filePath,
+      hiveSplit_->properties.has_value() ? &*hiveSplit_->properties : nullptr);
+  VELOX_CHECK_NOT_NULL(fileHandle.get());
+  auto readerOpts = baseReaderOpts_;
+  readerOpts.setMemoryPool(*pool);
+  readerOpts.setRandomSkip(nullptr);
+  readerOpts.setScanSpec(nullptr);
+  readerOpts.setPreloadBudget(nullptr);
+  // There is no scan tracker since the reads are not of one query.
+  std::unique_ptr<dwio::common::BufferedInput> input;
+  if (auto* cache = connectorQueryCtx_->cache()) {
+    input = std::make_unique<dwio::common::CachedBufferedInput>(
+        fileHandle->file,
+        dwio::common::MetricsLog::voidLog(),
+        fileHandle->uuid.id(),
+        cache,
+        nullptr,
+        fileHandle->groupId.id(),
+        ioStats,
+        executor_,
+        readerOpts);
+  } else {
+    input = std::make_unique<dwio::common::DirectBufferedInput>(
+        fileHandle->file,
+        dwio::common::MetricsLog::voidLog(),
+        fileHandle->uuid.id(),
+        nullptr,
+        fileHandle->groupId.id(),
+        ioStats,
+        executor_,
+        readerOpts);
+  }
+  return dwio::common::getReaderFactory(readerOpts.fileFormat())
+      ->createReader(std::move(input), readerOpts);
+}
+
+dwio::common::RowReaderOptions SplitReader::sharedRowReaderOptions(
+    const std::shared_ptr<common::ScanSpec>& scanSpec) const {
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(scanSpec);
+  options.setRequestedType(baseRowReaderOpts_.requestedType());
+  options.range(baseRowReaderOpts_.getOffset(), baseRowReaderOpts_.getLength());
+  options.setSkipRows(baseRowReaderOpts_.getSkipRows());
+  options.setTimestampPrecision(baseRowReaderOpts_.timestampPrecision());
+  return options;
+}
+
+uint64_t SplitReader::skip(uint64_t numRows) {
+  VectorPtr output = BaseVector::create(readerOutputType_, 0, pool_);
+  std::vector<uint64_t> deletedRows;
+  uint64_t numSkipped = 0;
+  while (numSkipped < numRows) {
+    const auto readSize = baseRowReader_->nextReadSize(numRows - numSkipped);
+    if (readSize == dwio::common::RowReader::kAtEnd) {
+      break;
+    }
+    // Rows marked deleted are not decoded.
+    deletedRows.assign(bits::nwords(readSize), ~0ULL);
+    dwio::common::Mutation mutation;
+    mutation.deletedRows = deletedRows.data();
+    numSkipped += baseRowReader_->next(readSize, output, &mutation);
+  }
+  return numSkipped;
+}
+
 std::string SplitReader::toString() const {
   std::string partitionKeys;
   std::for_each(
@@ -246,15 +387,25 @@ void SplitReader::createReader(
   // are generated, if CacheTTLController was created. Creator of
   // CacheTTLController needs to make sure a size control strategy was available
   // such as removing aged out entries.
+  fileSize_ = fileHandleCachePtr->file->size();
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  baseReaderOpts_.setFileModificationTime(
+      hiveSplit_->properties.has_value()
+          ? hiveSplit_->properties->modificationTime.value_or(0)
+          : 0);
+  if (const auto preloadBytes = connectorQueryCtx_->preloadBytesLimit()) {
+    baseReaderOpts_.setPreloadBudget(
+        std::make_shared<std::atomic<int64_t>>(preloadBytes));
+  }
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
       connectorQueryCtx_,
       ioStats_,
-      executor_);
+      executor_,
+      hiveTableHandle_->tableName());
 
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
@@ -94,6 +94,11 @@ class SplitReader {
       dwio::common::RuntimeStatistics& runtimeStats,
       const std::shared_ptr<HiveColumnHandle>& rowIndexColumn);
 
+  /// Marks the split as empty without opening its file, e.g. when its
+  /// partition key values do not pass a dynamic filter. Called instead of
+  /// prepareSplit().
+  void skipSplit(dwio::common::RuntimeStatistics& runtimeStats);
+
   virtual uint64_t next(uint64_t size, VectorPtr& output);
 
   void resetFilterCaches();
@@ -104,12 +109,53 @@ class SplitReader {
 
   int64_t estimatedRowSize() const;
 
-  void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const;
+  virtual void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& stats) const;
 
   bool allPrefetchIssued() const;
 
+  /// Returns the reader of the split's file if the file statistics describe
+  /// exactly the rows of the split, i.e. the split covers the whole file and
+  /// no rows of it are deleted. Returns nullptr otherwise.
+  virtual const dwio::common::Reader* statisticsReader() const;
+
   void setConnectorQueryCtx(const ConnectorQueryCtx* connectorQueryCtx);
 
+  /// Returns true if the rows of the split may be decoded once for several
+  /// scans, see SharedScan. Table formats that apply delete files to the rows
+  /// of the file return false.
+  virtual bool supportsSharedScan() const;
+
+  /// Returns a key that identifies the split together with everything the
+  /// reader of createSharedReader() depends on: the connector, the file and
+  /// its properties, the serde parameters, the columns of the file with the
+  /// types they are read as and the session properties, which may carry the
+  /// credentials of the file system. Scans of the split share a SharedScan
+  /// only if their keys are equal.
+  std::string sharedScanKey() const;
+
+  /// Returns the columns of the file with the types they are read as.
+  const RowTypePtr& requestedType() const {
+    return baseRowReaderOpts_.requestedType();
+  }
+
+  /// Returns a reader of the file of the split that allocates from 'pool' and
+  /// accounts its reads in 'ioStats'. The reader does not refer to the query
+  /// of 'this' and may outlive it. Used by SharedScan.
+  std::unique_ptr<dwio::common::Reader> createSharedReader(
+      memory::MemoryPool* pool,
+      const std::shared_ptr<io::IoStatistics>& ioStats) const;
+
+  /// Returns the options for reading all rows of the split with 'scanSpec',
+  /// without the filters and mutations of 'this'.
+  dwio::common::RowReaderOptions sharedRowReaderOptions(
+      const std::shared_ptr<common::ScanSpec>& scanSpec) const;
+
+  /// Moves past the next 'numRows' rows of the split without returning them.
+  /// Returns the number of rows skipped, less than 'numRows' at the end of the
+  /// split. Used to continue after the rows read from a SharedScan.
+  uint64_t skip(uint64_t numRows);
+
   std::string toString() const;
 
  protected:
@@ -140,6 +186,10 @@ class SplitReader {
   void setRowIndexColumn(
       const std::shared_ptr<HiveColumnHandle>& rowIndexColumn);
 
+  /// Exhausts the read-ahead budget of a preloaded split once its first stripe
+  /// or row group is scheduled.
+  void endPreload();
+
   void setPartitionValue(
       common::ScanSpec* spec,
       const std::string& partitionKey,
@@ -164,6 +214,7 @@ class SplitReader {
   std::unique_ptr<dwio::common::RowReader> baseRowReader_;
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
+  uint64_t fileSize_{0};
   bool emptySplit_;
 };
 
@@ -25,6 +25,7 @@ columnTypeNames() {
       {HiveColumnHandle::ColumnType::kPartitionKey, "PartitionKey"},
       {HiveColumnHandle::ColumnType::kRegular, "Regular"},
       {HiveColumnHandle::ColumnType::kSynthesized, "Synthesized"},
+      {HiveColumnHandle::ColumnType::kAggregated, "Aggregated"},
   };
 }
 
@@ -62,6 +63,9 @@ folly::dynamic HiveColumnHandle::serialize() const {
     requiredSubfields.push_back(subfield.toString());
   }
   obj["requiredSubfields"] = requiredSubfields;
+  if (!aggregation_.empty()) {
+    obj["aggregation"] = aggregation_;
+  }
   return obj;
 }
 
@@ -76,7 +80,11 @@ std::string HiveColumnHandle::toString() const {
   for (const auto& subfield : requiredSubfields_) {
     out << " " << subfield.toString();
   }
-  out << " ]]";
+  out << " ]";
+  if (!aggregation_.empty()) {
+    out << ", aggregation: " << aggregation_;
+  }
+  out << "]";
   return out.str();
 }
 
@@ -94,7 +102,12 @@ ColumnHandlePtr HiveColumnHandle::create(const folly::dynamic& obj) {
   }
 
   return std::make_shared<HiveColumnHandle>(
-      name, columnType, dataType, hiveType, std::move(requiredSubfields));
+      name,
+      columnType,
+      dataType,
+      hiveType,
+      std::move(requiredSubfields),
+      obj.getDefault("aggregation", "").asString());
 }
 
 void HiveColumnHandle::registerSerDe() {
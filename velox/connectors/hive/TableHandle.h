@@ -34,7 +34,11 @@ class HiveColumnHandle : public ColumnHandle {
     kSynthesized,
     /// A zero-based row number of type BIGINT auto-generated by the connector.
     /// Rows numbers are unique within a single file only.
-    kRowIndex
+    kRowIndex,
+    /// The partial result of 'aggregation()' over the data column 'name()' for
+    /// the rows of a split. The scan returns one row per split. See
+    /// SplitAggregates for the supported aggregates.
+    kAggregated
   };
 
   /// NOTE: 'dataType' is the column type in target write table. 'hiveType' is
@@ -47,17 +51,24 @@ class HiveColumnHandle : public ColumnHandle {
       ColumnType columnType,
       TypePtr dataType,
       TypePtr hiveType,
-      std::vector<common::Subfield> requiredSubfields = {})
+      std::vector<common::Subfield> requiredSubfields = {},
+      std::string aggregation = "")
       : name_(name),
         columnType_(columnType),
         dataType_(std::move(dataType)),
         hiveType_(std::move(hiveType)),
-        requiredSubfields_(std::move(requiredSubfields)) {
+        requiredSubfields_(std::move(requiredSubfields)),
+        aggregation_(std::move(aggregation)) {
     VELOX_USER_CHECK(
         dataType_->equivalent(*hiveType_),
         "data type {} and hive type {} do not match",
         dataType_->toString(),
         hiveType_->toString());
+    VELOX_USER_CHECK_EQ(
+        columnType_ == ColumnType::kAggregated,
+        !aggregation_.empty(),
+        "Only aggregated columns have an aggregation: {}",
+        name_);
   }
 
   const std::string& name() const {
@@ -98,6 +109,13 @@ class HiveColumnHandle : public ColumnHandle {
     return columnType_ == ColumnType::kPartitionKey;
   }
 
+  /// The aggregate function of a kAggregated column: one of count, min, max
+  /// and sum. An empty 'name()' with count is count(*). Empty for other
+  /// column types.
+  const std::string& aggregation() const {
+    return aggregation_;
+  }
+
   std::string toString() const;
 
   folly::dynamic serialize() const override;
@@ -117,6 +135,7 @@ class HiveColumnHandle : public ColumnHandle {
   const TypePtr dataType_;
   const TypePtr hiveType_;
   const std::vector<common::Subfield> requiredSubfields_;
+  const std::string aggregation_;
 };
 
 class HiveTableHandle : public ConnectorTableHandle {
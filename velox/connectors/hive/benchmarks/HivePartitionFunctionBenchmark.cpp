@@ -65,6 +65,14 @@ class HivePartitionFunctionBenchmark
     addRowVector(MAP(BIGINT(), BOOLEAN()));
     addRowVector(ROW({"a", "b"}, {INTEGER(), DOUBLE()}));
 
+    // Several partitioning keys hashed column by column.
+    multiKeyRowVector_ = vm.rowVector(
+        {fuzzer.fuzzFlat(BIGINT()),
+         fuzzer.fuzzFlat(INTEGER()),
+         fuzzer.fuzzFlat(VARCHAR())});
+    multiKeyFunction_ = std::make_unique<HivePartitionFunction>(
+        100, std::vector<column_index_t>{0, 1, 2});
+
     // Prepare HivePartitionFunction
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
@@ -82,6 +90,10 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  void runMultiKey() {
+    multiKeyFunction_->partition(*multiKeyRowVector_, partitions_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
@@ -105,6 +117,8 @@ class HivePartitionFunctionBenchmark
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
+  RowVectorPtr multiKeyRowVector_;
+  std::unique_ptr<HivePartitionFunction> multiKeyFunction_;
   std::vector<uint32_t> partitions_;
 };
 
@@ -325,6 +339,16 @@ BENCHMARK_RELATIVE(rowManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::ROW>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiKeyFewRows) {
+  benchmarkFew->runMultiKey();
+}
+
+BENCHMARK(multiKeyManyRows) {
+  benchmarkMany->runMultiKey();
+}
+
 BENCHMARK_DRAW_LINE();
 } // namespace
 
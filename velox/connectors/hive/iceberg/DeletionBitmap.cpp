@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeletionBitmap.h"
+
+#include <gflags/gflags.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+
+DECLARE_uint64(velox_iceberg_delete_bitmap_cache_capacity_bytes);
+
+namespace facebook::velox::connector::hive::iceberg {
+
+void DeletionBitmap::add(const int64_t* positions, int32_t numPositions) {
+  VELOX_CHECK(!finished_, "Cannot add to a finished DeletionBitmap");
+  // Positions of a delete file are mostly ascending, so consecutive
+  // positions usually fall in the same chunk.
+  std::vector<uint16_t>* offsets = nullptr;
+  uint64_t currentKey = 0;
+  for (auto i = 0; i < numPositions; ++i) {
+    VELOX_CHECK_GE(positions[i], 0, "Negative deleted row position");
+    const uint64_t key = positions[i] >> kChunkBits;
+    if (offsets == nullptr || key != currentKey) {
+      offsets = &pending_[key];
+      currentKey = key;
+    }
+    offsets->push_back(positions[i] & (kChunkRows - 1));
+  }
+}
+
+void DeletionBitmap::finish() {
+  VELOX_CHECK(!finished_, "DeletionBitmap is already finished");
+  finished_ = true;
+  std::vector<uint64_t> keys;
+  keys.reserve(pending_.size());
+  for (const auto& [key, _] : pending_) {
+    keys.push_back(key);
+  }
+  std::sort(keys.begin(), keys.end());
+  chunks_.reserve(keys.size());
+  for (auto key : keys) {
+    auto& offsets = pending_[key];
+    std::sort(offsets.begin(), offsets.end());
+    offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+    Chunk chunk{key, static_cast<int32_t>(offsets.size()), nullptr};
+    if (chunk.dense()) {
+      chunk.data = AlignedBuffer::allocate<uint64_t>(
+          bits::nwords(kChunkRows), pool_, 0);
+      auto* words = chunk.data->asMutable<uint64_t>();
+      for (auto offset : offsets) {
+        bits::setBit(words, offset);
+      }
+    } else {
+      chunk.data = AlignedBuffer::allocate<uint16_t>(offsets.size(), pool_);
+      std::memcpy(
+          chunk.data->asMutable<uint16_t>(),
+          offsets.data(),
+          offsets.size() * sizeof(uint16_t));
+    }
+    cardinality_ += chunk.numRows;
+    chunks_.push_back(std::move(chunk));
+  }
+  pending_ = decltype(pending_)();
+}
+
+bool DeletionBitmap::fill(uint64_t begin, uint64_t numRows, uint64_t* bits)
+    const {
+  VELOX_CHECK(finished_, "DeletionBitmap is not finished");
+  const uint64_t end = begin + numRows;
+  auto it = std::lower_bound(
+      chunks_.begin(),
+      chunks_.end(),
+      begin >> kChunkBits,
+      [](const Chunk& chunk, uint64_t key) { return chunk.key < key; });
+  bool anySet = false;
+  for (; it != chunks_.end() && (it->key << kChunkBits) < end; ++it) {
+    const uint64_t chunkBegin = it->key << kChunkBits;
+    // Range of offsets in the chunk that fall in [begin, end).
+    const uint32_t first = std::max(begin, chunkBegin) - chunkBegin;
+    const uint32_t last = std::min(end, chunkBegin + kChunkRows) - chunkBegin;
+    if (it->dense()) {
+      bits::forEachSetBit(
+          it->data->as<uint64_t>(), first, last, [&](int32_t offset) {
+            bits::setBit(bits, chunkBegin + offset - begin);
+            anySet = true;
+          });
+      continue;
+    }
+    const auto* offsets = it->data->as<uint16_t>();
+    const auto* offsetsEnd = offsets + it->numRows;
+    for (auto* offset = std::lower_bound(offsets, offsetsEnd, first);
+         offset < offsetsEnd && *offset < last;
+         ++offset) {
+      bits::setBit(bits, chunkBegin + *offset - begin);
+      anySet = true;
+    }
+  }
+  return anySet;
+}
+
+uint64_t DeletionBitmap::retainedBytes() const {
+  uint64_t bytes = 0;
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.data->capacity();
+  }
+  return bytes;
+}
+
+// static
+DeletionBitmapCache& DeletionBitmapCache::instance() {
+  // The cache and its pool live for the lifetime of the process. Bitmaps
+  // handed out by the cache may outlive their entries.
+  static auto* cache = new DeletionBitmapCache(
+      FLAGS_velox_iceberg_delete_bitmap_cache_capacity_bytes,
+      memory::deprecatedAddDefaultLeafMemoryPool(
+          "__sys_iceberg_delete_bitmaps__"));
+  return *cache;
+}
+
+DeletionBitmapCache::DeletionBitmapCache(
+    uint64_t capacityBytes,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : capacityBytes_(capacityBytes), pool_(std::move(pool)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+// static
+std::string DeletionBitmapCache::makeKey(
+    const std::string& dataFilePath,
+    const std::vector<IcebergDeleteFile>& deleteFiles) {
+  // Delete files are immutable. The size and record count guard against a
+  // path being reused for different contents.
+  std::vector<std::string> deleteFileKeys;
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kPositionalDeletes &&
+        deleteFile.recordCount > 0) {
+      deleteFileKeys.push_back(fmt::format(
+          "{}:{}:{}",
+          deleteFile.filePath,
+          deleteFile.fileSizeInBytes,
+          deleteFile.recordCount));
+    }
+  }
+  std::sort(deleteFileKeys.begin(), deleteFileKeys.end());
+  std::string key = dataFilePath;
+  for (const auto& deleteFileKey : deleteFileKeys) {
+    key += '\n';
+    key += deleteFileKey;
+  }
+  return key;
+}
+
+std::shared_ptr<const DeletionBitmap> DeletionBitmapCache::getOrLoad(
+    const std::string& key,
+    const std::function<std::shared_ptr<const DeletionBitmap>(
+        memory::MemoryPool*)>& load,
+    bool& hit) {
+  std::shared_ptr<BitmapPromise> promise;
+  auto loadFuture =
+      folly::SemiFuture<std::shared_ptr<const DeletionBitmap>>::makeEmpty();
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+      ++numHits_;
+      hit = true;
+      return it->second.bitmap;
+    }
+    auto loadIt = loads_.find(key);
+    if (loadIt != loads_.end()) {
+      ++numHits_;
+      loadFuture = loadIt->second->getSemiFuture();
+    } else {
+      ++numMisses_;
+      promise = std::make_shared<BitmapPromise>();
+      loads_[key] = promise;
+    }
+  }
+
+  if (promise == nullptr) {
+    // Another split of the data file is reading the delete files.
+    hit = true;
+    return std::move(loadFuture).get();
+  }
+
+  hit = false;
+  std::shared_ptr<const DeletionBitmap> bitmap;
+  try {
+    bitmap = load(pool_.get());
+    VELOX_CHECK_NOT_NULL(bitmap);
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      loads_.erase(key);
+    }
+    promise->setException(
+        folly::exception_wrapper(std::current_exception()));
+    throw;
+  }
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    loads_.erase(key);
+    insertLocked(key, bitmap);
+  }
+  promise->setValue(bitmap);
+  return bitmap;
+}
+
+void DeletionBitmapCache::insertLocked(
+    const std::string& key,
+    std::shared_ptr<const DeletionBitmap> bitmap) {
+  const auto bytes = bitmap->retainedBytes();
+  if (bytes > capacityBytes_) {
+    return;
+  }
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    numBytes_ -= it->second.bytes;
+    lru_.erase(it->second.lruPosition);
+    entries_.erase(it);
+  }
+  lru_.push_front(key);
+  numBytes_ += bytes;
+  entries_[key] = Slot{std::move(bitmap), bytes, lru_.begin()};
+  while (numBytes_ > capacityBytes_) {
+    auto evictIt = entries_.find(lru_.back());
+    numBytes_ -= evictIt->second.bytes;
+    entries_.erase(evictIt);
+    lru_.pop_back();
+    ++numEvictions_;
+  }
+}
+
+DeletionBitmapCache::Stats DeletionBitmapCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return Stats{entries_.size(), numBytes_, numHits_, numMisses_, numEvictions_};
+}
+
+void DeletionBitmapCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  numBytes_ = 0;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+#include <folly/futures/SharedPromise.h>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Set of deleted row positions of a data file, stored like a roaring bitmap.
+/// The positions are partitioned in chunks of 64K rows. A chunk with few
+/// deleted rows keeps their sorted 16 bit offsets, a chunk with many keeps a
+/// 64K bit bitmap. The chunks are allocated from the pool given at
+/// construction, so that the size of the bitmap is accounted there.
+class DeletionBitmap {
+ public:
+  explicit DeletionBitmap(memory::MemoryPool* pool) : pool_(pool) {}
+
+  /// Adds 'numPositions' row numbers. May be called several times in any
+  /// order of positions before finish().
+  void add(const int64_t* positions, int32_t numPositions);
+
+  /// Builds the chunks from the added positions. No positions may be added
+  /// after this.
+  void finish();
+
+  /// Sets the bit of 'bits' for each deleted row in [begin, begin + numRows),
+  /// where bit 0 corresponds to row 'begin'. Returns true if any bit was set.
+  bool fill(uint64_t begin, uint64_t numRows, uint64_t* bits) const;
+
+  /// Number of deleted rows.
+  uint64_t cardinality() const {
+    return cardinality_;
+  }
+
+  /// Bytes allocated for the chunks.
+  uint64_t retainedBytes() const;
+
+ private:
+  static constexpr int32_t kChunkBits = 16;
+  static constexpr uint64_t kChunkRows = 1 << kChunkBits;
+
+  // A chunk is stored as a bitmap when its sorted offsets would take more
+  // space.
+  static constexpr int32_t kMaxSparseRows = kChunkRows / 16;
+
+  struct Chunk {
+    // Row number of the first row of the chunk, shifted right by kChunkBits.
+    uint64_t key;
+    int32_t numRows;
+    // kChunkRows bits if 'numRows' > kMaxSparseRows, otherwise 'numRows'
+    // ascending uint16_t offsets from the first row of the chunk.
+    BufferPtr data;
+
+    bool dense() const {
+      return numRows > kMaxSparseRows;
+    }
+  };
+
+  memory::MemoryPool* const pool_;
+
+  // Positions added before finish(), by chunk key.
+  folly::F14FastMap<uint64_t, std::vector<uint16_t>> pending_;
+  bool finished_{false};
+
+  // Chunks ordered by key.
+  std::vector<Chunk> chunks_;
+  uint64_t cardinality_{0};
+};
+
+/// Process-wide cache of the DeletionBitmap of a data file for a set of
+/// positional delete files. Splits of the same data file and queries reading
+/// the same snapshot decode the delete files once and take the deleted rows
+/// of their row range from the cached bitmap. The bitmaps are allocated from
+/// a dedicated leaf memory pool and their total size is bounded by a
+/// capacity, beyond which the least recently used entries are evicted.
+class DeletionBitmapCache {
+ public:
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t numBytes{0};
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+  };
+
+  /// Returns the process-wide instance. Its capacity is set from the
+  /// velox_iceberg_delete_bitmap_cache_capacity_bytes flag on first use.
+  static DeletionBitmapCache& instance();
+
+  DeletionBitmapCache(
+      uint64_t capacityBytes,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Returns the key for the positional deletes of 'deleteFiles' applied to
+  /// 'dataFilePath'. Does not depend on the order of 'deleteFiles'.
+  static std::string makeKey(
+      const std::string& dataFilePath,
+      const std::vector<IcebergDeleteFile>& deleteFiles);
+
+  /// Returns the bitmap for 'key'. If there is none, the first caller makes
+  /// it with 'load', which gets the pool to allocate the bitmap from, and
+  /// concurrent callers for the same key wait for it. Sets 'hit' to false if
+  /// this call loaded the bitmap. An error of 'load' is rethrown to all the
+  /// waiting callers and nothing is cached.
+  std::shared_ptr<const DeletionBitmap> getOrLoad(
+      const std::string& key,
+      const std::function<std::shared_ptr<const DeletionBitmap>(
+          memory::MemoryPool*)>& load,
+      bool& hit);
+
+  Stats stats() const;
+
+  /// Drops all entries.
+  void clear();
+
+ private:
+  struct Slot {
+    std::shared_ptr<const DeletionBitmap> bitmap;
+    uint64_t bytes;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  using BitmapPromise =
+      folly::SharedPromise<std::shared_ptr<const DeletionBitmap>>;
+
+  // Adds 'bitmap' for 'key' and evicts least recently used entries until the
+  // size is within capacity. Requires 'mutex_'.
+  void insertLocked(
+      const std::string& key,
+      std::shared_ptr<const DeletionBitmap> bitmap);
+
+  const uint64_t capacityBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Slot> entries_;
+  // Keys of 'entries_', most recently used first.
+  std::list<std::string> lru_;
+  // Loads in progress.
+  folly::F14FastMap<std::string, std::shared_ptr<BitmapPromise>> loads_;
+  uint64_t numBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+EqualityDeleteSet::EqualityDeleteSet(
+    RowTypePtr keyType,
+    memory::MemoryPool* pool)
+    : keyType_(std::move(keyType)), pool_(pool) {
+  VELOX_CHECK_GT(keyType_->size(), 0);
+  keys_ = BaseVector::create<RowVector>(keyType_, 0, pool_);
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    hashers_.push_back(exec::VectorHasher::create(keyType_->childAt(i), i));
+  }
+}
+
+void EqualityDeleteSet::add(const RowVector& keys) {
+  VELOX_CHECK(!finished_, "Cannot add to a finished EqualityDeleteSet");
+  keys_->append(&keys);
+}
+
+void EqualityDeleteSet::finish() {
+  VELOX_CHECK(!finished_, "EqualityDeleteSet is already finished");
+  finished_ = true;
+  if (keys_->size() == 0 || tryNormalizedKeys()) {
+    return;
+  }
+
+  const auto numKeys = keys_->size();
+  SelectivityVector rows(numKeys);
+  raw_vector<uint64_t> hashes(numKeys);
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    hashers_[i]->decode(*keys_->childAt(i), rows);
+    hashers_[i]->hash(rows, i > 0, hashes);
+  }
+  lastRow_.reserve(numKeys);
+  previousRow_.resize(numKeys);
+  for (vector_size_t row = 0; row < numKeys; ++row) {
+    auto [it, inserted] = lastRow_.emplace(hashes[row], row);
+    previousRow_[row] = inserted ? -1 : it->second;
+    it->second = row;
+  }
+}
+
+bool EqualityDeleteSet::tryNormalizedKeys() {
+  for (const auto& child : keys_->children()) {
+    if (!exec::VectorHasher::typeKindSupportsValueIds(child->typeKind()) ||
+        BaseVector::countNulls(child->nulls(), child->size()) > 0) {
+      return false;
+    }
+  }
+
+  // The first pass collects the ranges and distinct values of the columns.
+  const auto numKeys = keys_->size();
+  SelectivityVector rows(numKeys);
+  raw_vector<uint64_t> ids(numKeys);
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    hashers_[i]->decode(*keys_->childAt(i), rows);
+    hashers_[i]->computeValueIds(rows, ids);
+  }
+
+  uint64_t multiplier = 1;
+  for (auto& hasher : hashers_) {
+    uint64_t asRange;
+    uint64_t asDistincts;
+    hasher->cardinality(0, asRange, asDistincts);
+    if (asRange == exec::VectorHasher::kRangeTooLarge &&
+        asDistincts == exec::VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+    multiplier = asRange <= asDistincts
+        ? hasher->enableValueRange(multiplier, 0)
+        : hasher->enableValueIds(multiplier, 0);
+    if (multiplier == exec::VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+  }
+
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    hashers_[i]->decode(*keys_->childAt(i), rows);
+    const bool ok = hashers_[i]->computeValueIds(rows, ids);
+    VELOX_CHECK(ok);
+  }
+  normalizedKeys_.reserve(numKeys);
+  normalizedKeys_.insert(ids.begin(), ids.end());
+  normalized_ = true;
+  return true;
+}
+
+std::vector<const BaseVector*> EqualityDeleteSet::keyColumns(
+    const RowVector& input) const {
+  const auto& inputType = input.type()->asRow();
+  std::vector<const BaseVector*> columns;
+  columns.reserve(keyType_->size());
+  for (const auto& name : keyType_->names()) {
+    columns.push_back(
+        input.childAt(inputType.getChildIdx(name))->loadedVector());
+  }
+  return columns;
+}
+
+vector_size_t EqualityDeleteSet::probe(
+    const RowVector& input,
+    vector_size_t numRows,
+    uint64_t* deleted) {
+  VELOX_CHECK(finished_, "EqualityDeleteSet is not finished");
+  if (keys_->size() == 0 || numRows == 0) {
+    return 0;
+  }
+  const auto columns = keyColumns(input);
+  rows_.resize(numRows);
+  rows_.setAll();
+  rows_.deselect(deleted, 0, numRows);
+  if (!rows_.hasSelections()) {
+    return 0;
+  }
+
+  vector_size_t numDeleted = 0;
+  if (normalized_) {
+    hashes_.resize(numRows);
+    for (auto i = 0; i < columns.size(); ++i) {
+      // A null never matches since the deleted keys have no nulls.
+      decoded_.decode(*columns[i], rows_);
+      if (const auto* nulls = decoded_.nulls(&rows_)) {
+        rows_.deselectNulls(nulls, rows_.begin(), rows_.end());
+      }
+      // Deselects the rows whose value has no id.
+      hashers_[i]->lookupValueIds(*columns[i], rows_, scratch_, hashes_);
+      if (!rows_.hasSelections()) {
+        return 0;
+      }
+    }
+    rows_.applyToSelected([&](vector_size_t row) {
+      if (normalizedKeys_.count(hashes_[row])) {
+        bits::setBit(deleted, row);
+        ++numDeleted;
+      }
+    });
+    return numDeleted;
+  }
+
+  hashes_.resize(numRows);
+  for (auto i = 0; i < columns.size(); ++i) {
+    hashers_[i]->decode(*columns[i], rows_);
+    hashers_[i]->hash(rows_, i > 0, hashes_);
+  }
+  rows_.applyToSelected([&](vector_size_t row) {
+    auto it = lastRow_.find(hashes_[row]);
+    if (it == lastRow_.end()) {
+      return;
+    }
+    for (auto keyRow = it->second; keyRow != -1;
+         keyRow = previousRow_[keyRow]) {
+      bool equal = true;
+      for (auto i = 0; i < columns.size() && equal; ++i) {
+        equal = columns[i]->equalValueAt(
+            keys_->childAt(i).get(), row, keyRow);
+      }
+      if (equal) {
+        bits::setBit(deleted, row);
+        ++numDeleted;
+        return;
+      }
+    }
+  });
+  return numDeleted;
+}
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      nullptr,
+      deleteSplit);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory->generate(deleteFile.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  keyType_ = deleteReader->rowType();
+  VELOX_USER_CHECK(
+      deleteFile.equalityFieldIds.empty() ||
+          deleteFile.equalityFieldIds.size() == keyType_->size(),
+      "Equality delete file {} has {} columns for {} equality field ids",
+      deleteFile.filePath,
+      keyType_->size(),
+      deleteFile.equalityFieldIds.size());
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    scanSpec->addField(keyType_->nameOf(i), i);
+  }
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts, {}, scanSpec, nullptr, keyType_, deleteSplit);
+  rowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+}
+
+void EqualityDeleteFileReader::readDeleteKeys(EqualityDeleteSet& deleteSet) {
+  VELOX_USER_CHECK(
+      keyType_->equivalent(*deleteSet.keyType()),
+      "Equality delete columns {} do not match data file columns {}",
+      keyType_->toString(),
+      deleteSet.keyType()->toString());
+  constexpr uint64_t kBatchSize = 10'000;
+  VectorPtr output = BaseVector::create(keyType_, 0, pool_);
+  while (rowReader_->next(kBatchSize, output) > 0) {
+    if (output->size() == 0) {
+      continue;
+    }
+    output->loadedVector();
+    deleteSet.add(*output->as<RowVector>());
+  }
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/exec/VectorHasher.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Set of the deleted values of the equality columns of Iceberg equality
+/// delete files. A data row is deleted if its equality columns are equal to
+/// the columns of a deleted row. Nulls are equal to nulls.
+///
+/// Keys are normalized to 64 bit integers with VectorHashers when the key
+/// columns are of types that support value ids, have no nulls and the ranges
+/// or distinct values of all the columns fit in 64 bits, e.g. one or two
+/// integer columns. Otherwise deleted rows are found by hash and compared
+/// value by value.
+class EqualityDeleteSet {
+ public:
+  /// 'keyType' has the names and types of the equality columns in the data
+  /// file. The deleted keys are allocated from 'pool'.
+  EqualityDeleteSet(RowTypePtr keyType, memory::MemoryPool* pool);
+
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Adds the rows of 'keys', whose children are the equality columns in the
+  /// order of keyType().
+  void add(const RowVector& keys);
+
+  /// Builds the lookup structures. No keys may be added after this.
+  void finish();
+
+  /// Sets the bit of 'deleted' for each of the first 'numRows' rows of 'input'
+  /// whose equality columns, found in 'input' by name, are in the set. Rows
+  /// that are already set in 'deleted' are not looked up. Returns the number
+  /// of bits set by this call.
+  vector_size_t
+  probe(const RowVector& input, vector_size_t numRows, uint64_t* deleted);
+
+  /// Number of deleted keys, including duplicates.
+  vector_size_t size() const {
+    return keys_->size();
+  }
+
+  /// True if keys are looked up as normalized keys.
+  bool normalized() const {
+    return normalized_;
+  }
+
+ private:
+  // Switches to normalized keys if the keys of 'keys_' allow.
+  bool tryNormalizedKeys();
+
+  // Returns the key columns of 'input' in the order of 'keyType_'.
+  std::vector<const BaseVector*> keyColumns(const RowVector& input) const;
+
+  const RowTypePtr keyType_;
+  memory::MemoryPool* const pool_;
+
+  RowVectorPtr keys_;
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers_;
+  bool finished_{false};
+  bool normalized_{false};
+
+  // Normalized keys of 'keys_' if 'normalized_'.
+  folly::F14FastSet<uint64_t> normalizedKeys_;
+
+  // If not 'normalized_', the last row of 'keys_' with each hash and for each
+  // row, the previous row with the same hash or -1.
+  folly::F14FastMap<uint64_t, vector_size_t> lastRow_;
+  std::vector<vector_size_t> previousRow_;
+
+  // Scratch for probe().
+  SelectivityVector rows_;
+  raw_vector<uint64_t> hashes_;
+  DecodedVector decoded_;
+  exec::VectorHasher::ScratchMemory scratch_;
+};
+
+/// Reads an Iceberg equality delete file. The columns of the file are the
+/// equality columns, which are matched to the columns of the data file by
+/// name.
+class EqualityDeleteFileReader {
+ public:
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Names and types of the equality columns in the delete file.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Adds all the rows of the delete file to 'deleteSet'.
+  void readDeleteKeys(EqualityDeleteSet& deleteSet);
+
+ private:
+  memory::MemoryPool* const pool_;
+  RowTypePtr keyType_;
+  std::unique_ptr<dwio::common::RowReader> rowReader_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
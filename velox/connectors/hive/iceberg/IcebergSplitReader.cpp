@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -58,18 +59,48 @@ void IcebergSplitReader::prepareSplit(
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
     VELOX_CHECK(emptySplit_);
+    endPreload();
     return;
   }
 
   createRowReader();
+  endPreload();
 
   std::shared_ptr<const HiveIcebergSplit> icebergSplit =
       std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  deletionBitmap_.reset();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
+  bool hasPositionalDeletes = false;
+  std::vector<const IcebergDeleteFile*> equalityDeleteFiles;
+  for (const auto& deleteFile : deleteFiles) {
+    switch (deleteFile.content) {
+      case FileContent::kPositionalDeletes:
+        hasPositionalDeletes |= deleteFile.recordCount > 0;
+        break;
+      case FileContent::kEqualityDeletes:
+        if (deleteFile.recordCount > 0) {
+          equalityDeleteFiles.push_back(&deleteFile);
+        }
+        break;
+      default:
+        VELOX_NYI();
+    }
+  }
+  prepareEqualityDeletes(equalityDeleteFiles);
+
+  if (!hasPositionalDeletes) {
+    return;
+  }
+  if (hiveConfig_->icebergDeleteBitmapCacheEnabled(
+          connectorQueryCtx_->sessionProperties())) {
+    loadDeletionBitmap(deleteFiles, runtimeStats);
+    return;
+  }
+
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
@@ -86,23 +117,174 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
-    } else {
-      VELOX_NYI();
     }
   }
 }
 
+void IcebergSplitReader::prepareEqualityDeletes(
+    const std::vector<const IcebergDeleteFile*>& deleteFiles) {
+  equalityDeleteSets_.clear();
+  equalityKeyRowReader_.reset();
+  equalityKeys_.reset();
+  numEqualityDeletedRows_ = 0;
+  if (deleteFiles.empty()) {
+    return;
+  }
+
+  // Delete files with the same equality columns share one set.
+  const auto& fileType = requestedType();
+  std::vector<std::string> keyNames;
+  std::vector<TypePtr> keyTypes;
+  for (const auto* deleteFile : deleteFiles) {
+    EqualityDeleteFileReader reader(
+        *deleteFile,
+        fileHandleFactory_,
+        connectorQueryCtx_,
+        executor_,
+        hiveConfig_,
+        ioStats_,
+        hiveSplit_->connectorId);
+    const auto& names = reader.keyType()->names();
+    auto it = std::find_if(
+        equalityDeleteSets_.begin(),
+        equalityDeleteSets_.end(),
+        [&](const auto& deleteSet) {
+          return deleteSet->keyType()->names() == names;
+        });
+    if (it == equalityDeleteSets_.end()) {
+      std::vector<TypePtr> types;
+      for (const auto& name : names) {
+        const auto channel = fileType->getChildIdxIfExists(name);
+        VELOX_USER_CHECK(
+            channel.has_value(),
+            "Equality delete column {} is not in data file {}",
+            name,
+            hiveSplit_->filePath);
+        types.push_back(fileType->childAt(*channel));
+        if (std::find(keyNames.begin(), keyNames.end(), name) ==
+            keyNames.end()) {
+          keyNames.push_back(name);
+          keyTypes.push_back(types.back());
+        }
+      }
+      equalityDeleteSets_.push_back(std::make_unique<EqualityDeleteSet>(
+          ROW(std::vector<std::string>(names), std::move(types)),
+          connectorQueryCtx_->memoryPool()));
+      it = equalityDeleteSets_.end() - 1;
+    }
+    reader.readDeleteKeys(**it);
+  }
+  for (auto& deleteSet : equalityDeleteSets_) {
+    deleteSet->finish();
+  }
+
+  // The equality columns are read by a second row reader over the same rows
+  // as the base row reader, so that deleted rows are known before the other
+  // columns are read.
+  auto keySpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyNames.size(); ++i) {
+    keySpec->addField(keyNames[i], i);
+  }
+  equalityKeyRowReader_ =
+      baseReader_->createRowReader(sharedRowReaderOptions(keySpec));
+  equalityKeys_ = BaseVector::create(
+      ROW(std::move(keyNames), std::move(keyTypes)),
+      0,
+      connectorQueryCtx_->memoryPool());
+}
+
+void IcebergSplitReader::loadDeletionBitmap(
+    const std::vector<IcebergDeleteFile>& deleteFiles,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  bool hit;
+  deletionBitmap_ = DeletionBitmapCache::instance().getOrLoad(
+      DeletionBitmapCache::makeKey(hiveSplit_->filePath, deleteFiles),
+      [&](memory::MemoryPool* bitmapPool) {
+        auto bitmap = std::make_shared<DeletionBitmap>(bitmapPool);
+        for (const auto& deleteFile : deleteFiles) {
+          if (deleteFile.content != FileContent::kPositionalDeletes ||
+              deleteFile.recordCount == 0) {
+            continue;
+          }
+          PositionalDeleteFileReader reader(
+              deleteFile,
+              hiveSplit_->filePath,
+              fileHandleFactory_,
+              connectorQueryCtx_,
+              executor_,
+              hiveConfig_,
+              ioStats_,
+              runtimeStats,
+              0,
+              hiveSplit_->connectorId);
+          reader.readAllDeletePositions(*bitmap);
+        }
+        bitmap->finish();
+        return bitmap;
+      },
+      hit);
+  if (hit) {
+    ++runtimeStats.deleteBitmapCacheHits;
+  } else {
+    ++runtimeStats.deleteBitmapCacheMisses;
+  }
+}
+
+bool IcebergSplitReader::hasDeletes() const {
+  return !positionalDeleteFileReaders_.empty() ||
+      !equalityDeleteSets_.empty() ||
+      (deletionBitmap_ && deletionBitmap_->cardinality() > 0);
+}
+
+const dwio::common::Reader* IcebergSplitReader::statisticsReader() const {
+  // The file statistics include the rows removed by delete files.
+  if (hasDeletes()) {
+    return nullptr;
+  }
+  return SplitReader::statisticsReader();
+}
+
+bool IcebergSplitReader::supportsSharedScan() const {
+  // The positional deletes are applied by next().
+  return !hasDeletes() && SplitReader::supportsSharedScan();
+}
+
+void IcebergSplitReader::updateRuntimeStats(
+    dwio::common::RuntimeStatistics& stats) const {
+  SplitReader::updateRuntimeStats(stats);
+  stats.equalityDeletedRows += numEqualityDeletedRows_;
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
-  if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
+  if (equalityKeyRowReader_) {
+    // The equality columns are read for exactly the rows the base reader
+    // reads next.
+    const auto readSize = baseRowReader_->nextReadSize(size);
+    if (readSize == RowReader::kAtEnd) {
+      return 0;
+    }
+    size = readSize;
+  }
+
+  // Deleted rows are set a word at a time.
+  const auto numBytes = bits::nwords(size) * sizeof(uint64_t);
+  if (hasDeletes()) {
     dwio::common::ensureCapacity<int8_t>(
         deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool());
     std::memset((void*)deleteBitmap_->as<int8_t>(), 0L, numBytes);
+  }
 
+  bool anyDeleted = false;
+  if (deletionBitmap_ && deletionBitmap_->cardinality() > 0) {
+    anyDeleted = deletionBitmap_->fill(
+        splitOffset_ + baseReadOffset_,
+        size,
+        deleteBitmap_->asMutable<uint64_t>());
+  } else if (!positionalDeleteFileReaders_.empty()) {
     for (auto iter = positionalDeleteFileReaders_.begin();
          iter != positionalDeleteFileReaders_.end();) {
       (*iter)->readDeletePositions(
@@ -113,7 +295,14 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
         ++iter;
       }
     }
+    anyDeleted = true;
+  }
+  if (equalityKeyRowReader_) {
+    anyDeleted |=
+        applyEqualityDeletes(size, deleteBitmap_->asMutable<uint64_t>());
+  }
 
+  if (anyDeleted) {
     deleteBitmap_->setSize(numBytes);
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
@@ -124,4 +313,37 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   return rowsScanned;
 }
 
+bool IcebergSplitReader::applyEqualityDeletes(
+    uint64_t size,
+    uint64_t* deleted) {
+  // Catches up with the base reader, which may have skipped row groups on
+  // statistics. Skipped rows are marked deleted so that they are not decoded.
+  const auto rowNumber = baseRowReader_->nextRowNumber();
+  for (;;) {
+    const auto keyRowNumber = equalityKeyRowReader_->nextRowNumber();
+    VELOX_CHECK_NE(keyRowNumber, RowReader::kAtEnd);
+    VELOX_CHECK_LE(keyRowNumber, rowNumber);
+    if (keyRowNumber == rowNumber) {
+      break;
+    }
+    const auto skipSize =
+        equalityKeyRowReader_->nextReadSize(rowNumber - keyRowNumber);
+    std::vector<uint64_t> skipped(bits::nwords(skipSize), ~0ULL);
+    Mutation skipMutation;
+    skipMutation.deletedRows = skipped.data();
+    equalityKeyRowReader_->next(skipSize, equalityKeys_, &skipMutation);
+  }
+
+  const auto numRead = equalityKeyRowReader_->next(size, equalityKeys_);
+  VELOX_CHECK_EQ(numRead, size);
+  equalityKeys_->loadedVector();
+  const auto& keys = *equalityKeys_->as<RowVector>();
+  vector_size_t numDeleted = 0;
+  for (auto& deleteSet : equalityDeleteSets_) {
+    numDeleted += deleteSet->probe(keys, size, deleted);
+  }
+  numEqualityDeletedRows_ += numDeleted;
+  return numDeleted > 0;
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
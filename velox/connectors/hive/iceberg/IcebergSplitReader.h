@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -48,7 +49,33 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  const dwio::common::Reader* statisticsReader() const override;
+
+  bool supportsSharedScan() const override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& stats) const override;
+
  private:
+  // Sets 'deletionBitmap_' to the cached deleted rows of the base file for
+  // 'deleteFiles', reading the delete files if they are not cached.
+  void loadDeletionBitmap(
+      const std::vector<IcebergDeleteFile>& deleteFiles,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  // Reads 'deleteFiles' into 'equalityDeleteSets_' and creates the reader of
+  // the equality columns of the base file.
+  void prepareEqualityDeletes(
+      const std::vector<const IcebergDeleteFile*>& deleteFiles);
+
+  // Reads the equality columns of the next 'size' rows of the base file and
+  // sets the bits of 'deleted' for the rows that are in an equality delete
+  // set. Returns true if any bit was set.
+  bool applyEqualityDeletes(uint64_t size, uint64_t* deleted);
+
+  // True if some rows of the base file are deleted.
+  bool hasDeletes() const;
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -58,6 +85,17 @@ class IcebergSplitReader : public SplitReader {
 
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
+  // Deleted rows of the base file from DeletionBitmapCache. Replaces
+  // 'positionalDeleteFileReaders_' if set.
+  std::shared_ptr<const DeletionBitmap> deletionBitmap_;
+
+  // One set per distinct list of equality columns.
+  std::vector<std::unique_ptr<EqualityDeleteSet>> equalityDeleteSets_;
+  // Reads the equality columns of all the sets from the base file.
+  std::unique_ptr<dwio::common::RowReader> equalityKeyRowReader_;
+  VectorPtr equalityKeys_;
+  uint64_t numEqualityDeletedRows_{0};
+
   BufferPtr deleteBitmap_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
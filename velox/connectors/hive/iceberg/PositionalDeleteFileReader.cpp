@@ -200,6 +200,32 @@ void PositionalDeleteFileReader::readDeletePositions(
   }
 }
 
+void PositionalDeleteFileReader::readAllDeletePositions(
+    DeletionBitmap& bitmap) {
+  if (!deleteRowReader_ || !deleteSplit_) {
+    return;
+  }
+
+  constexpr uint64_t kBatchSize = 10'000;
+  RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
+  VectorPtr output = BaseVector::create(outputRowType, 0, pool_);
+  while (deleteRowReader_->next(kBatchSize, output) > 0) {
+    VELOX_CHECK(
+        !output->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    if (output->size() == 0) {
+      continue;
+    }
+    output->loadedVector();
+    const auto* positions = std::dynamic_pointer_cast<RowVector>(output)
+                                ->childAt(0)
+                                ->as<FlatVector<int64_t>>();
+    bitmap.add(positions->rawValues(), positions->size());
+  }
+  endOfFile_ = true;
+  deleteSplit_.reset();
+}
+
 bool PositionalDeleteFileReader::endOfFile() {
   return endOfFile_;
 }
@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/DeletionBitmap.h"
 #include "velox/dwio/common/Reader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -52,6 +53,11 @@ class PositionalDeleteFileReader {
       uint64_t size,
       int8_t* deleteBitmap);
 
+  /// Adds the positions of all the rows of the base file deleted by the delete
+  /// file to 'bitmap'. The positions are relative to the start of the base
+  /// file, not of the split.
+  void readAllDeletePositions(DeletionBitmap& bitmap);
+
   bool endOfFile();
 
  private:
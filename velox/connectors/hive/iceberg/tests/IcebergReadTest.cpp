@@ -15,11 +15,14 @@
  */
 
 #include "velox/common/file/FileSystems.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/DeletionBitmap.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -94,7 +97,7 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   const static int rowCount = 20000;
 
- private:
+ protected:
   void assertPositionalDeletesInternal(
       const std::vector<std::vector<int64_t>>& deleteRowsVec,
       std::string duckdbSql,
@@ -347,4 +350,136 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, deletionBitmap) {
+  // Sparse chunks, a dense chunk and positions that are not ascending.
+  std::vector<int64_t> positions = {70'000, 3, 0, 65'535, 65'536, 3};
+  for (auto i = 0; i < 10'000; ++i) {
+    positions.push_back(200'000 + i * 3);
+  }
+  positions.push_back(1LL << 40);
+  std::set<int64_t> expected(positions.begin(), positions.end());
+
+  DeletionBitmap bitmap(pool_.get());
+  bitmap.add(positions.data(), positions.size() / 2);
+  bitmap.add(
+      positions.data() + positions.size() / 2,
+      positions.size() - positions.size() / 2);
+  bitmap.finish();
+  ASSERT_EQ(bitmap.cardinality(), expected.size());
+
+  auto checkRange = [&](uint64_t begin, uint64_t numRows) {
+    std::vector<uint64_t> bits(bits::nwords(numRows));
+    const bool anySet = bitmap.fill(begin, numRows, bits.data());
+    bool anyExpected = false;
+    for (uint64_t row = 0; row < numRows; ++row) {
+      const bool deleted = expected.count(begin + row) > 0;
+      anyExpected |= deleted;
+      ASSERT_EQ(bits::isBitSet(bits.data(), row), deleted) << begin + row;
+    }
+    ASSERT_EQ(anySet, anyExpected);
+  };
+  checkRange(0, 10);
+  checkRange(1, 2);
+  checkRange(60'000, 10'000);
+  checkRange(100'000, 10'000);
+  checkRange(199'990, 30'011);
+  checkRange(220'000, 20'000);
+  checkRange((1LL << 40) - 5, 10);
+}
+
+TEST_F(HiveIcebergTest, deleteBitmapCache) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  const auto deleteRows = makeRandomDeleteRows(rowCount);
+  auto dataFilePath = writeDataFile(1, rowCount)[0];
+  auto deleteFilePath =
+      writePositionDeleteFile(dataFilePath->getPath(), deleteRows);
+  const auto path = deleteFilePath->getPath();
+  IcebergDeleteFile deleteFile(
+      FileContent::kPositionalDeletes,
+      path,
+      fileFomat_,
+      deleteRows.size(),
+      testing::internal::GetFileSize(std::fopen(path.c_str(), "r")));
+  auto split = makeIcebergSplit(dataFilePath->getPath(), {deleteFile});
+
+  auto plan = tableScanNode();
+  auto runQuery = [&]() {
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .connectorSessionProperty(
+                        kHiveConnectorId,
+                        HiveConfig::kIcebergDeleteBitmapCacheEnabledSession,
+                        "true")
+                    .split(split)
+                    .assertResults(getQuery({deleteRows}));
+    return toPlanStats(task->taskStats()).at(plan->id()).customStats;
+  };
+
+  // The first scan reads the delete file and the second reuses its bitmap.
+  auto stats = runQuery();
+  ASSERT_EQ(stats.at("deleteBitmapCacheMisses").sum, 1);
+  ASSERT_EQ(stats.at("deleteBitmapCacheHits").sum, 0);
+  stats = runQuery();
+  ASSERT_EQ(stats.at("deleteBitmapCacheMisses").sum, 0);
+  ASSERT_EQ(stats.at("deleteBitmapCacheHits").sum, 1);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  auto dataFilePath = writeDataFile(1, rowCount)[0];
+  std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+  auto makeEqualityDeleteFile = [&](const VectorPtr& keys) {
+    deleteFilePaths.push_back(TempFilePath::create());
+    const auto path = deleteFilePaths.back()->getPath();
+    writeToFile(path, makeRowVector({"c0"}, {keys}));
+    return IcebergDeleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        keys->size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        {1});
+  };
+
+  auto plan = tableScanNode();
+  auto assertDeletes = [&](const std::vector<IcebergDeleteFile>& deleteFiles,
+                           const std::string& duckDbSql,
+                           int64_t numDeleted) {
+    auto split = makeIcebergSplit(dataFilePath->getPath(), deleteFiles);
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .split(split)
+                    .assertResults(duckDbSql);
+    auto stats = toPlanStats(task->taskStats()).at(plan->id()).customStats;
+    ASSERT_EQ(stats.at("equalityDeletedRows").sum, numDeleted);
+  };
+
+  // Keys without nulls are looked up as normalized keys. Keys that are not in
+  // the data file delete nothing.
+  assertDeletes(
+      {makeEqualityDeleteFile(
+          makeFlatVector<int64_t>({0, 5, 19'999, 30'000, 5}))},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 19999)",
+      3);
+
+  // A null key makes the set look up keys by hash. Row 5 is deleted by
+  // position and is not counted as deleted by equality.
+  deleteFilePaths.push_back(
+      writePositionDeleteFile(dataFilePath->getPath(), {5, 7}));
+  const auto positionalPath = deleteFilePaths.back()->getPath();
+  IcebergDeleteFile positionalDeletes(
+      FileContent::kPositionalDeletes,
+      positionalPath,
+      fileFomat_,
+      2,
+      testing::internal::GetFileSize(std::fopen(positionalPath.c_str(), "r")));
+  assertDeletes(
+      {makeEqualityDeleteFile(makeFlatVector<int64_t>({0, 5})),
+       makeEqualityDeleteFile(
+           makeNullableFlatVector<int64_t>({std::nullopt, 19'999})),
+       positionalDeletes},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 7, 19999)",
+      2);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
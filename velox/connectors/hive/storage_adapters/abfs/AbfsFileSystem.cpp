@@ -19,9 +19,11 @@
 #include <azure/storage/blobs/blob_client.hpp>
 #include <fmt/format.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
@@ -49,10 +51,16 @@ class AbfsConfig {
 
 class AbfsReadFile::Impl {
   constexpr static uint64_t kNaturalReadSize = 4 << 20; // 4M
-  constexpr static uint64_t kReadConcurrency = 8;
+  // Ranges of a preadv that are at most this many bytes apart are read by a
+  // single request.
+  constexpr static uint64_t kReadCoalesceGapBytes = 1 << 20; // 1M
 
  public:
-  explicit Impl(const std::string& path, const std::string& connectStr) {
+  Impl(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor)
+      : executor_(executor) {
     auto abfsAccount = AbfsAccount(path);
     fileName_ = abfsAccount.filePath();
     fileClient_ =
@@ -74,6 +82,7 @@ class AbfsReadFile::Impl {
     try {
       auto properties = fileClient_->GetProperties();
       length_ = properties.Value.BlobSize;
+      etag_ = properties.Value.ETag.ToString();
     } catch (Azure::Storage::StorageException& e) {
       throwStorageExceptionWithOperationDetails("GetProperties", fileName_, e);
     }
@@ -95,22 +104,35 @@ class AbfsReadFile::Impl {
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const {
-    size_t length = 0;
-    auto size = buffers.size();
-    for (auto& range : buffers) {
-      length += range.size();
+    auto reads = file::utils::planRangeReads(
+        offset, buffers, kReadCoalesceGapBytes);
+    if (reads.size() > 1) {
+      return preadvAsync(offset, buffers).get();
     }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+    for (const auto& read : reads) {
+      if (read.buffers.size() == 1) {
+        preadInternal(read.offset, read.length, read.buffers[0].data());
+      } else {
+        std::string staging(read.length, 0);
+        preadInternal(read.offset, read.length, staging.data());
+        file::utils::scatterRangeRead(read, staging.data());
       }
-      resultOffset += range.size();
     }
+    return totalLength(buffers);
+  }
 
-    return length;
+  // Reads the ranges of 'buffers' by parallel ranged downloads on
+  // 'executor_'. Gaps of up to kReadCoalesceGapBytes are read through.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    return file::utils::readRangesAsync(
+        file::utils::planRangeReads(offset, buffers, kReadCoalesceGapBytes),
+        totalLength(buffers),
+        executor_,
+        [this](uint64_t readOffset, uint64_t readLength, char* position) {
+          preadInternal(readOffset, readLength, position);
+        });
   }
 
   void preadv(
@@ -130,6 +152,10 @@ class AbfsReadFile::Impl {
     return length_;
   }
 
+  const std::string& etag() const {
+    return etag_;
+  }
+
   uint64_t memoryUsage() const {
     return 3 * sizeof(std::string) + sizeof(int64_t);
   }
@@ -147,6 +173,14 @@ class AbfsReadFile::Impl {
   }
 
  private:
+  static uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    uint64_t length = 0;
+    for (const auto& range : buffers) {
+      length += range.size();
+    }
+    return length;
+  }
+
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
     // Read the desired range of bytes.
     Azure::Core::Http::HttpRange range;
@@ -161,16 +195,19 @@ class AbfsReadFile::Impl {
         reinterpret_cast<uint8_t*>(position), length);
   }
 
+  folly::Executor* const executor_;
   std::string fileName_;
   std::unique_ptr<BlobClient> fileClient_;
 
   int64_t length_ = -1;
+  std::string etag_;
 };
 
 AbfsReadFile::AbfsReadFile(
     const std::string& path,
-    const std::string& connectStr) {
-  impl_ = std::make_shared<Impl>(path, connectStr);
+    const std::string& connectStr,
+    folly::Executor* executor) {
+  impl_ = std::make_shared<Impl>(path, connectStr, executor);
 }
 
 void AbfsReadFile::initialize(const FileOptions& options) {
@@ -198,10 +235,24 @@ void AbfsReadFile::preadv(
   return impl_->preadv(regions, iobufs);
 }
 
+folly::SemiFuture<uint64_t> AbfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  return impl_->preadvAsync(offset, buffers);
+}
+
+bool AbfsReadFile::hasPreadvAsync() const {
+  return true;
+}
+
 uint64_t AbfsReadFile::size() const {
   return impl_->size();
 }
 
+const std::string& AbfsReadFile::etag() const {
+  return impl_->etag();
+}
+
 uint64_t AbfsReadFile::memoryUsage() const {
   return impl_->memoryUsage();
 }
@@ -220,7 +271,15 @@ uint64_t AbfsReadFile::getNaturalReadSize() const {
 
 class AbfsFileSystem::Impl {
  public:
-  explicit Impl(const Config* config) : abfsConfig_(config) {
+  explicit Impl(const Config* config)
+      : abfsConfig_(config),
+        hiveConfig_(std::make_shared<core::MemConfig>(config->values())),
+        metadataCache_(
+            hiveConfig_.fileMetadataCacheMaxEntries(),
+            hiveConfig_.fileMetadataCacheTtlMs()),
+        ioExecutor_(std::make_shared<folly::IOThreadPoolExecutor>(
+            std::max<uint32_t>(1, hiveConfig_.abfsMaxConcurrency()),
+            std::make_shared<folly::NamedThreadFactory>("AbfsIO"))) {
     LOG(INFO) << "Init Azure Blob file system";
   }
 
@@ -233,9 +292,24 @@ class AbfsFileSystem::Impl {
     return abfsConfig_.connectionString(path);
   }
 
+  FileMetadataCache& metadataCache() {
+    return metadataCache_;
+  }
+
+  const HiveConfig& hiveConfig() const {
+    return hiveConfig_;
+  }
+
+  // Runs the ranged reads and block appends of the files.
+  folly::Executor* ioExecutor() const {
+    return ioExecutor_.get();
+  }
+
  private:
   const AbfsConfig abfsConfig_;
-  std::shared_ptr<folly::Executor> ioExecutor_;
+  const HiveConfig hiveConfig_;
+  FileMetadataCache metadataCache_;
+  const std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
 };
 
 AbfsFileSystem::AbfsFileSystem(const std::shared_ptr<const Config>& config)
@@ -251,17 +325,35 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   auto abfsfile = std::make_unique<AbfsReadFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
-  abfsfile->initialize(options);
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      impl_->ioExecutor());
+  auto& metadataCache = impl_->metadataCache();
+  const auto readOptions = metadataCache.withCachedFileSize(path, options);
+  abfsfile->initialize(readOptions);
+  if (!readOptions.fileSize.has_value()) {
+    metadataCache.put(
+        path, {static_cast<int64_t>(abfsfile->size()), abfsfile->etag()});
+  }
   return abfsfile;
 }
 
 std::unique_ptr<WriteFile> AbfsFileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& /*unused*/) {
+  impl_->metadataCache().invalidate(path);
+  const auto& hiveConfig = impl_->hiveConfig();
   auto abfsfile = std::make_unique<AbfsWriteFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      impl_->ioExecutor(),
+      hiveConfig.abfsUploadBlockSize(),
+      hiveConfig.abfsMaxConcurrency());
   abfsfile->initialize();
   return abfsfile;
 }
+
+FileMetadataCache::Stats AbfsFileSystem::metadataCacheStats() const {
+  return impl_->metadataCache().stats();
+}
 } // namespace facebook::velox::filesystems::abfs
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/file/FileMetadataCache.h"
 #include "velox/common/file/FileSystems.h"
 
 namespace facebook::velox::filesystems::abfs {
@@ -73,6 +74,10 @@ class AbfsFileSystem : public FileSystem {
     VELOX_UNSUPPORTED("rmdir for abfs not implemented");
   }
 
+  /// Returns the stats of the cache of file sizes that saves the GetProperties
+  /// request when a file is opened without a known size.
+  FileMetadataCache::Stats metadataCacheStats() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
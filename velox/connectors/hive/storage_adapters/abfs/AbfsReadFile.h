@@ -22,7 +22,11 @@
 namespace facebook::velox::filesystems::abfs {
 class AbfsReadFile final : public ReadFile {
  public:
-  explicit AbfsReadFile(const std::string& path, const std::string& connectStr);
+  /// @param executor Runs the ranged reads of preadvAsync().
+  AbfsReadFile(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor);
 
   void initialize(const FileOptions& options);
 
@@ -39,8 +43,18 @@ class AbfsReadFile final : public ReadFile {
       folly::Range<const common::Region*> regions,
       folly::Range<folly::IOBuf*> iobufs) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t size() const final;
 
+  /// Returns the entity tag from the metadata request made by initialize().
+  /// Empty if the file size was given.
+  const std::string& etag() const;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final;
@@ -17,6 +17,12 @@
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
 
 #include <azure/storage/files/datalake.hpp>
+#include <folly/futures/Future.h>
+#include <deque>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::filesystems::abfs {
 class BlobStorageFileClient final : public IBlobStorageFileClient {
@@ -51,14 +57,17 @@ class BlobStorageFileClient final : public IBlobStorageFileClient {
 
 class AbfsWriteFile::Impl {
  public:
-  explicit Impl(const std::string& path, const std::string& connectStr)
-      : path_(path), connectStr_(connectStr) {
-    // Make it a no-op if invoked twice.
-    if (position_ != -1) {
-      return;
-    }
-    position_ = 0;
-  }
+  Impl(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor,
+      uint64_t blockSize,
+      uint32_t maxConcurrency)
+      : path_(path),
+        connectStr_(connectStr),
+        executor_(executor),
+        blockSize_(std::max<uint64_t>(1, blockSize)),
+        maxConcurrency_(std::max<uint32_t>(1, maxConcurrency)) {}
 
   void initialize() {
     if (!blobStorageFileClient_) {
@@ -73,6 +82,7 @@ class AbfsWriteFile::Impl {
 
     VELOX_CHECK(!checkIfFileExists(), "File already exists");
     blobStorageFileClient_->create();
+    openTimeUs_ = getCurrentTimeMicro();
   }
 
   void testingSetFileClient(
@@ -85,33 +95,42 @@ class AbfsWriteFile::Impl {
       flush();
       blobStorageFileClient_->close();
       closed_ = true;
+      const auto elapsedUs = getCurrentTimeMicro() - openTimeUs_;
+      if (elapsedUs > 0) {
+        // Bytes per microsecond are MB per second.
+        RECORD_HISTOGRAM_METRIC_VALUE(
+            kMetricObjectStoreUploadMBPerSec, position_ / elapsedUs);
+      }
     }
   }
 
   void flush() {
     if (!closed_) {
+      if (!buffer_.empty()) {
+        appendBlock();
+      }
+      waitForAppends(0);
       blobStorageFileClient_->flush(position_);
     }
   }
 
   void append(std::string_view data) {
     VELOX_CHECK(!closed_, "File is not open");
-    if (data.size() == 0) {
-      return;
+    while (!data.empty()) {
+      const auto bytes =
+          std::min<uint64_t>(data.size(), blockSize_ - buffer_.size());
+      buffer_.append(data.data(), bytes);
+      data.remove_prefix(bytes);
+      if (buffer_.size() == blockSize_) {
+        appendBlock();
+      }
     }
-    append(data.data(), data.size());
   }
 
   uint64_t size() const {
     return blobStorageFileClient_->getProperties().FileSize;
   }
 
-  void append(const char* buffer, size_t size) {
-    blobStorageFileClient_->append(
-        reinterpret_cast<const uint8_t*>(buffer), size, position_);
-    position_ += size;
-  }
-
  private:
   bool checkIfFileExists() {
     try {
@@ -125,20 +144,74 @@ class AbfsWriteFile::Impl {
     }
   }
 
+  static void uploadBlock(
+      IBlobStorageFileClient& client,
+      const std::string& block,
+      uint64_t offset) {
+    uint64_t uploadTimeUs{0};
+    {
+      MicrosecondTimer timer(&uploadTimeUs);
+      client.append(
+          reinterpret_cast<const uint8_t*>(block.data()), block.size(), offset);
+    }
+    RECORD_METRIC_VALUE(kMetricObjectStoreUploadedBytes, block.size());
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricObjectStorePartUploadTimeMs, uploadTimeUs / 1'000);
+  }
+
+  // Appends 'buffer_' at 'position_'. With an executor, the append runs on it
+  // after waiting for a free slot.
+  void appendBlock() {
+    auto block = std::move(buffer_);
+    buffer_ = std::string();
+    const auto offset = position_;
+    position_ += block.size();
+    if (executor_ == nullptr) {
+      uploadBlock(*blobStorageFileClient_, block, offset);
+      return;
+    }
+    waitForAppends(maxConcurrency_ - 1);
+    appends_.push_back(folly::via(
+        folly::getKeepAliveToken(executor_),
+        [client = blobStorageFileClient_, block = std::move(block), offset]() {
+          uploadBlock(*client, block, offset);
+        }));
+  }
+
+  // Waits until at most 'maxPending' appends are in flight. Throws the error
+  // of a failed append.
+  void waitForAppends(size_t maxPending) {
+    while (appends_.size() > maxPending) {
+      auto append = std::move(appends_.front());
+      appends_.pop_front();
+      std::move(append).get();
+    }
+  }
+
   const std::string path_;
   const std::string connectStr_;
-  std::string fileSystem_;
-  std::string fileName_;
+  folly::Executor* const executor_;
+  const uint64_t blockSize_;
+  const uint32_t maxConcurrency_;
   std::shared_ptr<IBlobStorageFileClient> blobStorageFileClient_;
 
-  uint64_t position_ = -1;
+  // Data not yet appended, less than a block.
+  std::string buffer_;
+  std::deque<folly::Future<folly::Unit>> appends_;
+  // Offset of the next block. The size of the file after the next flush.
+  uint64_t position_{0};
+  uint64_t openTimeUs_{0};
   bool closed_ = false;
 };
 
 AbfsWriteFile::AbfsWriteFile(
     const std::string& path,
-    const std::string& connectStr) {
-  impl_ = std::make_shared<Impl>(path, connectStr);
+    const std::string& connectStr,
+    folly::Executor* executor,
+    uint64_t blockSize,
+    uint32_t maxConcurrency) {
+  impl_ = std::make_shared<Impl>(
+      path, connectStr, executor, blockSize, maxConcurrency);
 }
 
 void AbfsWriteFile::initialize() {
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 
@@ -55,14 +57,25 @@ class IBlobStorageFileClient {
 };
 
 /// Implementation of abfs write file. Nothing written to the file should be
-/// read back until it is closed.
+/// read back until it is closed. The data is appended in blocks of
+/// 'blockSize' bytes. With an executor, up to 'maxConcurrency' blocks are
+/// appended in parallel and flush() waits for them before committing.
 class AbfsWriteFile : public WriteFile {
  public:
   constexpr static uint64_t kNaturalWriteSize = 8 << 20; // 8M
   /// The constructor.
   /// @param path The file path to write.
   /// @param connectStr the connection string used to auth the storage account.
-  AbfsWriteFile(const std::string& path, const std::string& connectStr);
+  /// @param executor Runs the block appends. Blocks are appended on the
+  /// calling thread if null.
+  /// @param blockSize The size of the appended blocks.
+  /// @param maxConcurrency The maximum number of blocks in flight.
+  AbfsWriteFile(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor = nullptr,
+      uint64_t blockSize = kNaturalWriteSize,
+      uint32_t maxConcurrency = 1);
 
   /// check any issue reading file.
   void initialize();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <atomic>
 #include <filesystem>
@@ -152,6 +153,13 @@ void readData(ReadFile* readFile) {
   ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), "aaaaabbbbb");
   ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
 
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  std::memset(buff1, 0, sizeof(buff1));
+  std::memset(buff2, 0, sizeof(buff2));
+  ASSERT_EQ(10 + kOneMB - 5 + 10, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
+
   std::vector<folly::IOBuf> iobufs(2);
   std::vector<Region> regions = {{0, 10}, {10, 5}};
   readFile->preadv(
@@ -261,8 +269,7 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   const std::string abfsFile =
       filesystems::test::AzuriteABFSEndpoint + "writetest.txt";
   auto mockClient =
-      std::make_shared<filesystems::test::MockBlobStorageFileClient>(
-          filesystems::test::MockBlobStorageFileClient());
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
   auto abfsWriteFile = openFileForWrite(abfsFile, mockClient);
   EXPECT_EQ(abfsWriteFile->size(), 0);
   std::string dataContent = "";
@@ -297,6 +304,31 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   ASSERT_EQ(fileContent, dataContent);
 }
 
+TEST_F(AbfsFileSystemTest, parallelAppends) {
+  const std::string abfsFile =
+      filesystems::test::AzuriteABFSEndpoint + "parallelwritetest.txt";
+  auto mockClient =
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
+  folly::CPUThreadPoolExecutor executor(4);
+  // 1KB blocks with up to 4 appends in flight.
+  auto abfsWriteFile = std::make_unique<AbfsWriteFile>(
+      abfsFile, azuriteServer->connectionStr(), &executor, 1 << 10, 4);
+  abfsWriteFile->testingSetFileClient(mockClient);
+  abfsWriteFile->initialize();
+  std::string dataContent;
+  for (int i = 0; i < 100; ++i) {
+    const auto data = AbfsFileSystemTest::generateRandomData(100 + i * 7);
+    abfsWriteFile->append(data);
+    dataContent += data;
+  }
+  abfsWriteFile->flush();
+  EXPECT_EQ(abfsWriteFile->size(), dataContent.size());
+  abfsWriteFile->append("abc");
+  dataContent += "abc";
+  abfsWriteFile->close();
+  ASSERT_EQ(mockClient->readContent(), dataContent);
+}
+
 TEST_F(AbfsFileSystemTest, renameNotImplemented) {
   auto hiveConfig = AbfsFileSystemTest::hiveConfig(
       {{"fs.azure.account.key.test.dfs.core.windows.net",
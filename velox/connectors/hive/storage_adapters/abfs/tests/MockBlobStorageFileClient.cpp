@@ -45,11 +45,18 @@ void MockBlobStorageFileClient::append(
     const uint8_t* buffer,
     size_t size,
     uint64_t offset) {
-  fileStream_.seekp(offset);
-  fileStream_.write(reinterpret_cast<const char*>(buffer), size);
+  std::lock_guard<std::mutex> l(mutex_);
+  pendingAppends_.emplace(
+      offset, std::string(reinterpret_cast<const char*>(buffer), size));
 }
 
 void MockBlobStorageFileClient::flush(uint64_t position) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& [offset, data] : pendingAppends_) {
+    fileStream_.seekp(offset);
+    fileStream_.write(data.data(), data.size());
+  }
+  pendingAppends_.clear();
   fileStream_.flush();
 }
 
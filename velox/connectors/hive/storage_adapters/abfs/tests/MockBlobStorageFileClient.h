@@ -16,6 +16,9 @@
 
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
 
+#include <map>
+#include <mutex>
+
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 using namespace facebook::velox;
@@ -52,5 +55,9 @@ class MockBlobStorageFileClient : public IBlobStorageFileClient {
  private:
   std::string filePath_;
   std::ofstream fileStream_;
+  std::mutex mutex_;
+  // Appended data by offset. Written to the file on flush, like the service
+  // commits appended data on flush.
+  std::map<uint64_t, std::string> pendingAppends_;
 };
 } // namespace facebook::velox::filesystems::test
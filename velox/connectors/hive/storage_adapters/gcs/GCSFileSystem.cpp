@@ -15,15 +15,24 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/gcs/GCSFileSystem.h"
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GCSUtil.h"
 #include "velox/core/Config.h"
 #include "velox/core/QueryConfig.h"
 
 #include <fmt/format.h>
+#include <folly/Random.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -43,6 +52,13 @@ namespace gc = ::google::cloud;
 // upload this buffer with zero copies if possible.
 auto constexpr kUploadBufferSize = 256 * 1024;
 
+// Ranges of a preadv that are at most this many bytes apart are read by a
+// single request.
+auto constexpr kReadCoalesceGapBytes = 1 << 20;
+
+// Maximum number of source objects of a GCS compose request.
+constexpr size_t kMaxComposeSources = 32;
+
 inline void checkGCSStatus(
     const gc::Status outcome,
     const std::string_view& errorMsgPrefix,
@@ -65,8 +81,11 @@ inline void checkGCSStatus(
 
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* executor)
+      : client_(std::move(client)), executor_(executor) {
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
@@ -95,6 +114,13 @@ class GCSReadFile final : public ReadFile {
     }
     length_ = (*metadata).size();
     VELOX_CHECK_GE(length_, 0);
+    etag_ = (*metadata).etag();
+  }
+
+  // The entity tag from the metadata request. Empty if the file size was
+  // given.
+  const std::string& etag() const {
+    return etag_;
   }
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
@@ -113,24 +139,41 @@ class GCSReadFile final : public ReadFile {
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const override {
-    // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
-    // between. This call must populate the ranges (except gap ranges)
-    // sequentially starting from 'offset'. If a range pointer is nullptr, the
-    // data from stream of size range.size() will be skipped.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
+    auto reads = file::utils::planRangeReads(
+        offset, buffers, kReadCoalesceGapBytes);
+    if (reads.size() > 1) {
+      return preadvAsync(offset, buffers).get();
     }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
+    for (const auto& read : reads) {
+      if (read.buffers.size() == 1) {
+        preadInternal(read.offset, read.length, read.buffers[0].data());
+      } else {
+        std::string staging(read.length, 0);
+        preadInternal(read.offset, read.length, staging.data());
+        file::utils::scatterRangeRead(read, staging.data());
       }
-      resultOffset += range.size();
     }
-    return length;
+    return totalLength(buffers);
+  }
+
+  // 'buffers' contains Ranges(data, size) with some gaps (data = nullptr) in
+  // between. The ranges are grouped into ranged reads that read through gaps
+  // of up to kReadCoalesceGapBytes. The reads run in parallel on the executor
+  // of the file system.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    return file::utils::readRangesAsync(
+        file::utils::planRangeReads(offset, buffers, kReadCoalesceGapBytes),
+        totalLength(buffers),
+        executor_,
+        [this](uint64_t readOffset, uint64_t readLength, char* position) {
+          preadInternal(readOffset, readLength, position);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
   }
 
   uint64_t size() const override {
@@ -156,6 +199,14 @@ class GCSReadFile final : public ReadFile {
   }
 
  private:
+  static uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    uint64_t length = 0;
+    for (const auto& range : buffers) {
+      length += range.size();
+    }
+    return length;
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -175,17 +226,30 @@ class GCSReadFile final : public ReadFile {
   }
 
   std::shared_ptr<gcs::Client> client_;
+  folly::Executor* const executor_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
+  std::string etag_;
 };
 
+// Writes a GCS file in parts of 'partSize' bytes. Each full part is uploaded
+// as a temporary object on 'executor', with at most 'maxConcurrency' uploads
+// of the file in flight. On close, the parts are composed into the file and
+// deleted. A file of a single part is uploaded directly. Nothing written is
+// visible before close.
 class GCSWriteFile final : public WriteFile {
  public:
-  explicit GCSWriteFile(
+  GCSWriteFile(
       const std::string& path,
-      std::shared_ptr<gcs::Client> client)
-      : client_(client) {
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* executor,
+      uint64_t partSize,
+      uint32_t maxConcurrency)
+      : client_(std::move(client)),
+        executor_(executor),
+        partSize_(std::max<uint64_t>(1, partSize)),
+        maxConcurrency_(std::max<uint32_t>(1, maxConcurrency)) {
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
 
@@ -203,33 +267,58 @@ class GCSWriteFile final : public WriteFile {
     auto object_metadata = client_->GetObjectMetadata(bucket_, key_);
     VELOX_CHECK(!object_metadata.ok(), "File already exists");
 
-    auto stream = client_->WriteObject(bucket_, key_);
-    checkGCSStatus(
-        stream.last_status(),
-        "Failed to open GCS object for writing",
-        bucket_,
-        key_);
-    stream_ = std::move(stream);
+    uploadId_ = fmt::format("{:016x}", folly::Random::rand64());
+    openTimeUs_ = getCurrentTimeMicro();
     size_ = 0;
   }
 
-  void append(const std::string_view data) override {
+  void append(std::string_view data) override {
     VELOX_CHECK(isFileOpen(), "File is not open");
-    stream_ << data;
     size_ += data.size();
-  }
-
-  void flush() override {
-    if (isFileOpen()) {
-      stream_.flush();
+    while (!data.empty()) {
+      // A full part is uploaded when more data follows, so that the last part
+      // is always in 'buffer_' on close.
+      if (buffer_.size() == partSize_) {
+        uploadPart();
+      }
+      const auto bytes =
+          std::min<uint64_t>(data.size(), partSize_ - buffer_.size());
+      buffer_.append(data.data(), bytes);
+      data.remove_prefix(bytes);
     }
   }
 
+  // The parts are composed into the file on close.
+  void flush() override {}
+
   void close() override {
-    if (isFileOpen()) {
-      stream_.flush();
-      stream_.Close();
-      closed_ = true;
+    if (!isFileOpen()) {
+      return;
+    }
+    closed_ = true;
+    if (partNames_.empty()) {
+      uploadObject(*client_, bucket_, key_, std::move(buffer_));
+    } else {
+      try {
+        uploadPart();
+        waitForUploads(0);
+        composeParts();
+      } catch (...) {
+        for (auto& upload : uploads_) {
+          upload.wait();
+        }
+        uploads_.clear();
+        deleteParts();
+        throw;
+      }
+      deleteParts();
+    }
+    const auto elapsedUs = getCurrentTimeMicro() - openTimeUs_;
+    if (elapsedUs > 0) {
+      // Bytes per microsecond are MB per second.
+      RECORD_HISTOGRAM_METRIC_VALUE(
+          kMetricObjectStoreUploadMBPerSec,
+          static_cast<uint64_t>(size_) / elapsedUs);
     }
   }
 
@@ -239,13 +328,111 @@ class GCSWriteFile final : public WriteFile {
 
  private:
   inline bool isFileOpen() {
-    return (!closed_ && stream_.IsOpen());
+    return size_ != -1 && !closed_;
+  }
+
+  // Uploads 'data' as object 'name' of 'bucket'.
+  static void uploadObject(
+      gcs::Client& client,
+      const std::string& bucket,
+      const std::string& name,
+      std::string data) {
+    const auto bytes = data.size();
+    uint64_t uploadTimeUs{0};
+    {
+      MicrosecondTimer timer(&uploadTimeUs);
+      auto metadata = client.InsertObject(bucket, name, std::move(data));
+      checkGCSStatus(
+          metadata.status(), "Failed to upload GCS object", bucket, name);
+    }
+    RECORD_METRIC_VALUE(kMetricObjectStoreUploadedBytes, bytes);
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricObjectStorePartUploadTimeMs, uploadTimeUs / 1'000);
+  }
+
+  // Starts the upload of 'buffer_' as the next part after waiting for a free
+  // upload slot.
+  void uploadPart() {
+    waitForUploads(maxConcurrency_ - 1);
+    auto name = fmt::format("{}.{}.part{}", key_, uploadId_, partNames_.size());
+    partNames_.push_back(name);
+    uploads_.push_back(folly::via(
+        folly::getKeepAliveToken(executor_),
+        [client = client_,
+         bucket = bucket_,
+         name = std::move(name),
+         data = std::move(buffer_)]() mutable {
+          uploadObject(*client, bucket, name, std::move(data));
+        }));
+    buffer_ = std::string();
+  }
+
+  // Waits until at most 'maxPending' part uploads are in flight. Throws the
+  // error of a failed upload.
+  void waitForUploads(size_t maxPending) {
+    while (uploads_.size() > maxPending) {
+      auto upload = std::move(uploads_.front());
+      uploads_.pop_front();
+      std::move(upload).get();
+    }
+  }
+
+  // Composes the parts into the file, at most kMaxComposeSources at a time.
+  // The file composed so far is the first source of each later round.
+  void composeParts() {
+    auto source = [](const std::string& name) {
+      gcs::ComposeSourceObject object;
+      object.object_name = name;
+      return object;
+    };
+    std::vector<gcs::ComposeSourceObject> sources;
+    for (size_t i = 0; i < partNames_.size();) {
+      sources.clear();
+      if (i > 0) {
+        sources.push_back(source(key_));
+      }
+      while (sources.size() < kMaxComposeSources && i < partNames_.size()) {
+        sources.push_back(source(partNames_[i++]));
+      }
+      auto metadata = client_->ComposeObject(bucket_, sources, key_);
+      checkGCSStatus(
+          metadata.status(), "Failed to compose GCS object", bucket_, key_);
+    }
+  }
+
+  // Deletes the uploaded parts in parallel. A part that fails to be deleted is
+  // logged and left behind.
+  void deleteParts() {
+    std::vector<folly::Future<folly::Unit>> deletes;
+    deletes.reserve(partNames_.size());
+    for (auto& name : partNames_) {
+      deletes.push_back(folly::via(
+          folly::getKeepAliveToken(executor_),
+          [client = client_, bucket = bucket_, name = std::move(name)]() {
+            const auto status = client->DeleteObject(bucket, name);
+            if (!status.ok() && status.code() != gc::StatusCode::kNotFound) {
+              LOG(WARNING) << "Failed to delete GCS object "
+                           << gcsURI(bucket, name) << ": " << status.message();
+            }
+          }));
+    }
+    folly::collectAll(std::move(deletes)).wait();
+    partNames_.clear();
   }
 
-  gcs::ObjectWriteStream stream_;
   std::shared_ptr<gcs::Client> client_;
+  folly::Executor* const executor_;
+  const uint64_t partSize_;
+  const uint32_t maxConcurrency_;
   std::string bucket_;
   std::string key_;
+  // Distinguishes the part objects of this upload from those of other writers
+  // of the same path.
+  std::string uploadId_;
+  uint64_t openTimeUs_{0};
+  std::string buffer_;
+  std::vector<std::string> partNames_;
+  std::deque<folly::Future<folly::Unit>> uploads_;
   std::atomic<int64_t> size_{-1};
   std::atomic<bool> closed_{false};
 };
@@ -260,7 +447,13 @@ class GCSFileSystem::Impl {
  public:
   Impl(const Config* config)
       : hiveConfig_(std::make_shared<HiveConfig>(
-            std::make_shared<core::MemConfig>(config->values()))) {}
+            std::make_shared<core::MemConfig>(config->values()))),
+        metadataCache_(
+            hiveConfig_->fileMetadataCacheMaxEntries(),
+            hiveConfig_->fileMetadataCacheTtlMs()),
+        executor_(std::make_shared<folly::IOThreadPoolExecutor>(
+            std::max<uint32_t>(1, hiveConfig_->gcsMaxConcurrency()),
+            std::make_shared<folly::NamedThreadFactory>("GCSIO"))) {}
 
   ~Impl() = default;
 
@@ -310,8 +503,23 @@ class GCSFileSystem::Impl {
     return client_;
   }
 
+  FileMetadataCache& metadataCache() {
+    return metadataCache_;
+  }
+
+  const HiveConfig& hiveConfig() const {
+    return *hiveConfig_;
+  }
+
+  // Runs the ranged reads and part uploads of the files.
+  folly::Executor* executor() const {
+    return executor_.get();
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
+  FileMetadataCache metadataCache_;
+  const std::shared_ptr<folly::IOThreadPoolExecutor> executor_;
   std::shared_ptr<gcs::Client> client_;
 };
 
@@ -328,8 +536,15 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
-  gcsfile->initialize(options);
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath, impl_->getClient(), impl_->executor());
+  auto& metadataCache = impl_->metadataCache();
+  const auto readOptions = metadataCache.withCachedFileSize(gcspath, options);
+  gcsfile->initialize(readOptions);
+  if (!readOptions.fileSize.has_value()) {
+    metadataCache.put(
+        gcspath, {static_cast<int64_t>(gcsfile->size()), gcsfile->etag()});
+  }
   return gcsfile;
 }
 
@@ -337,7 +552,14 @@ std::unique_ptr<WriteFile> GCSFileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSWriteFile>(gcspath, impl_->getClient());
+  impl_->metadataCache().invalidate(gcspath);
+  const auto& hiveConfig = impl_->hiveConfig();
+  auto gcsfile = std::make_unique<GCSWriteFile>(
+      gcspath,
+      impl_->getClient(),
+      impl_->executor(),
+      hiveConfig.gcsUploadPartSize(),
+      hiveConfig.gcsMaxConcurrency());
   gcsfile->initialize();
   return gcsfile;
 }
@@ -352,6 +574,7 @@ void GCSFileSystem::remove(std::string_view path) {
   std::string object;
   const auto file = gcsPath(path);
   setBucketAndKeyFromGCSPath(file, bucket, object);
+  impl_->metadataCache().invalidate(file);
 
   if (!object.empty()) {
     auto stat = impl_->getClient()->GetObjectMetadata(bucket, object);
@@ -411,6 +634,10 @@ std::vector<std::string> GCSFileSystem::list(std::string_view path) {
   return result;
 }
 
+FileMetadataCache::Stats GCSFileSystem::metadataCacheStats() const {
+  return impl_->metadataCache().stats();
+}
+
 std::string GCSFileSystem::name() const {
   return "GCS";
 }
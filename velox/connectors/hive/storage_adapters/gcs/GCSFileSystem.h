@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/file/FileMetadataCache.h"
 #include "velox/common/file/FileSystems.h"
 
 namespace facebook::velox::filesystems {
@@ -86,6 +87,10 @@ class GCSFileSystem : public FileSystem {
   /// Unsupported
   void rmdir(std::string_view path) override;
 
+  /// Returns the stats of the cache of file sizes that saves the
+  /// GetObjectMetadata request when a file is opened without a known size.
+  FileMetadataCache::Stats metadataCacheStats() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -23,6 +23,7 @@
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 #include <boost/process.hpp>
+#include <fmt/format.h>
 #include <gmock/gmock-matchers.h>
 #include <gmock/gmock-more-matchers.h>
 #include <google/cloud/storage/client.h>
@@ -139,9 +140,8 @@ class GCSFileSystemTest : public testing::Test {
                              << ">, status=" << object.status();
   }
 
-  std::shared_ptr<const Config> testGcsOptions() const {
-    std::unordered_map<std::string, std::string> configOverride = {};
-
+  std::shared_ptr<const Config> testGcsOptions(
+      std::unordered_map<std::string, std::string> configOverride = {}) const {
     configOverride["hive.gcs.scheme"] = "http";
     configOverride["hive.gcs.endpoint"] = "localhost:" + testbench_->port();
     return std::make_shared<const core::MemConfig>(std::move(configOverride));
@@ -209,6 +209,15 @@ TEST_F(GCSFileSystemTest, readFile) {
   ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), kLoremIpsum.substr(0, 10));
   ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), kLoremIpsum.substr(30, 20));
   ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(80, 30));
+
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  std::memset(buff1, 0, sizeof(buff1));
+  std::memset(buff2, 0, sizeof(buff2));
+  std::memset(buff3, 0, sizeof(buff3));
+  ASSERT_EQ(10 + 20 + 20 + 30 + 30, readFile->preadvAsync(10, buffers).get());
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), kLoremIpsum.substr(10, 10));
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), kLoremIpsum.substr(40, 20));
+  ASSERT_EQ(std::string_view(buff3, sizeof(buff3)), kLoremIpsum.substr(90, 30));
 }
 
 TEST_F(GCSFileSystemTest, writeAndReadFile) {
@@ -241,6 +250,35 @@ TEST_F(GCSFileSystemTest, writeAndReadFile) {
   EXPECT_EQ(readFile->pread(0, size), dataContent);
 }
 
+TEST_F(GCSFileSystemTest, writeFileInParts) {
+  const std::string newFile = "writeFileInParts.txt";
+  const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
+
+  // 7 byte parts make more parts than a single compose request takes.
+  filesystems::GCSFileSystem gcfs(
+      testGcsOptions({{"hive.gcs.upload-part-size", "7"}}));
+  gcfs.initializeClient();
+  auto writeFile = gcfs.openFileForWrite(gcsFile);
+  std::string dataContent;
+  for (int32_t i = 0; i < 10; ++i) {
+    const auto line = fmt::format("{}: {}\n", i, kLoremIpsum.substr(i, 30));
+    writeFile->append(line);
+    dataContent += line;
+  }
+  EXPECT_EQ(writeFile->size(), dataContent.size());
+  writeFile->close();
+
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  EXPECT_EQ(readFile->size(), dataContent.size());
+  EXPECT_EQ(readFile->pread(0, dataContent.size()), dataContent);
+
+  // The parts are deleted.
+  for (const auto& name : gcfs.list(gcsFile)) {
+    EXPECT_TRUE(name == newFile || name.find(newFile) == std::string::npos)
+        << name;
+  }
+}
+
 TEST_F(GCSFileSystemTest, openExistingFileForWrite) {
   const std::string newFile = "readWriteFile.txt";
   const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
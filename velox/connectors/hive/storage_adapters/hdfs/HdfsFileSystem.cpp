@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
@@ -25,11 +28,25 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
+    const connector::hive::HiveConfig hiveConfig(
+        std::make_shared<core::MemConfig>(config->values()));
+    const auto socketPath = hiveConfig.hdfsDomainSocketPath();
+    VELOX_USER_CHECK(
+        !hiveConfig.hdfsShortCircuitRead() || !socketPath.empty(),
+        "{} requires {}",
+        connector::hive::HiveConfig::kHdfsShortCircuitRead,
+        connector::hive::HiveConfig::kHdfsDomainSocketPath);
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (hiveConfig.hdfsShortCircuitRead()) {
+      // Blocks with a replica on the local host are then read from the block
+      // files through the domain socket instead of over TCP from the datanode.
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", socketPath.c_str());
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
@@ -37,9 +54,16 @@ class HdfsFileSystem::Impl {
         "Unable to connect to HDFS: {}, got error: {}.",
         endpoint.identity(),
         hdfsGetLastError())
+    executor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+        std::max<uint32_t>(1, hiveConfig.hdfsReadMaxConcurrency()),
+        std::make_shared<folly::NamedThreadFactory>("HdfsRead"));
+    limiter_ = std::make_unique<DatanodeReadLimiter>(
+        hiveConfig.hdfsReadMaxConcurrencyPerDatanode());
   }
 
   ~Impl() {
+    // Finishes the reads in flight before the client goes away.
+    executor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -52,8 +76,19 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  // Runs the parallel reads of multi-range reads.
+  folly::Executor* executor() const {
+    return executor_.get();
+  }
+
+  DatanodeReadLimiter* limiter() const {
+    return limiter_.get();
+  }
+
  private:
   hdfsFS hdfsClient_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+  std::unique_ptr<DatanodeReadLimiter> limiter_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -77,7 +112,8 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(), path, impl_->executor(), impl_->limiter());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
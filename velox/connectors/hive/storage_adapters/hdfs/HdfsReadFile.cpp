@@ -15,13 +15,65 @@
  */
 
 #include "HdfsReadFile.h"
+#include <folly/ScopeGuard.h>
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include <unistd.h>
+#include "velox/common/file/Utils.h"
 
 namespace facebook::velox {
+namespace {
+// Ranges of a preadv that are at most this many bytes apart are read by a
+// single read.
+constexpr uint64_t kReadCoalesceGapBytes = 1 << 20;
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+// Returns 'host' up to the first '.'. Datanodes may be registered by fully
+// qualified or by short names.
+std::string_view shortHostName(std::string_view host) {
+  return host.substr(0, host.find('.'));
+}
+
+// Returns the short name of the local host. Empty if it is not known.
+const std::string& localHostName() {
+  static const std::string name = []() {
+    char buffer[256];
+    if (gethostname(buffer, sizeof(buffer)) != 0) {
+      return std::string();
+    }
+    buffer[sizeof(buffer) - 1] = '\0';
+    return std::string(shortHostName(buffer));
+  }();
+  return name;
+}
+} // namespace
+
+void DatanodeReadLimiter::acquire(const std::string& datanode) {
+  std::unique_lock<std::mutex> l(mutex_);
+  cv_.wait(l, [&]() { return numReads_[datanode] < maxReadsPerDatanode_; });
+  ++numReads_[datanode];
+}
+
+void DatanodeReadLimiter::release(const std::string& datanode) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = numReads_.find(datanode);
+    VELOX_CHECK(it != numReads_.end() && it->second > 0);
+    if (--it->second == 0) {
+      numReads_.erase(it);
+    }
+  }
+  cv_.notify_all();
+}
+
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* executor,
+    DatanodeReadLimiter* limiter)
+    : hdfsClient_(hdfs),
+      filePath_(path),
+      executor_(executor),
+      limiter_(limiter) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   if (fileInfo_ == nullptr) {
     auto error = hdfsGetLastError();
@@ -69,6 +121,107 @@ std::string HdfsReadFile::pread(uint64_t offset, uint64_t length) const {
   return result;
 }
 
+uint64_t HdfsReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ != nullptr &&
+      file::utils::planRangeReads(offset, buffers, kReadCoalesceGapBytes)
+              .size() > 1) {
+    return preadvAsync(offset, buffers).get();
+  }
+  return ReadFile::preadv(offset, buffers);
+}
+
+folly::SemiFuture<uint64_t> HdfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  return file::utils::readRangesAsync(
+      file::utils::planRangeReads(offset, buffers, kReadCoalesceGapBytes),
+      length,
+      executor_,
+      [this](uint64_t readOffset, uint64_t readLength, char* pos) {
+        limitedPread(readOffset, readLength, pos);
+      });
+}
+
+void HdfsReadFile::limitedPread(uint64_t offset, uint64_t length, char* pos)
+    const {
+  const auto& locations = blockLocations();
+  if (limiter_ == nullptr || locations.empty()) {
+    preadInternal(offset, length, pos);
+    return;
+  }
+  const auto block = std::min<uint64_t>(
+      offset / fileInfo_->mBlockSize, locations.size() - 1);
+  const auto& datanode = locations[block].datanode;
+  limiter_->acquire(datanode);
+  SCOPE_EXIT {
+    limiter_->release(datanode);
+  };
+  preadInternal(offset, length, pos);
+}
+
+std::optional<uint64_t> HdfsReadFile::localBytes(
+    uint64_t offset,
+    uint64_t length) const {
+  const auto& locations = blockLocations();
+  if (locations.empty()) {
+    return std::nullopt;
+  }
+  const uint64_t blockSize = fileInfo_->mBlockSize;
+  const auto end = offset + length;
+  uint64_t numLocal = 0;
+  for (auto block = offset / blockSize;
+       block < locations.size() && block * blockSize < end;
+       ++block) {
+    if (locations[block].local) {
+      numLocal += std::min(end, (block + 1) * blockSize) -
+          std::max(offset, block * blockSize);
+    }
+  }
+  return numLocal;
+}
+
+const std::vector<HdfsReadFile::BlockLocation>& HdfsReadFile::blockLocations()
+    const {
+  folly::call_once(blockLocationsOnce_, [&]() {
+    if (size() == 0 || fileInfo_->mBlockSize <= 0) {
+      return;
+    }
+    char*** hosts = hdfsGetHosts(hdfsClient_, filePath_.data(), 0, size());
+    if (hosts == nullptr) {
+      LOG(WARNING) << "Unable to get block locations of HDFS file "
+                   << filePath_ << ", got error: " << hdfsGetLastError();
+      return;
+    }
+    const auto& localHost = localHostName();
+    for (auto block = hosts; *block != nullptr; ++block) {
+      BlockLocation location;
+      for (auto host = *block; *host != nullptr; ++host) {
+        if (!localHost.empty() && shortHostName(*host) == localHost) {
+          // The client reads a local replica, by short-circuit if enabled.
+          location.datanode = *host;
+          location.local = true;
+          break;
+        }
+        if (location.datanode.empty()) {
+          location.datanode = *host;
+        }
+      }
+      blockLocations_.push_back(std::move(location));
+    }
+    hdfsFreeHosts(hosts);
+  });
+  return blockLocations_;
+}
+
 uint64_t HdfsReadFile::size() const {
   return fileInfo_->mSize;
 }
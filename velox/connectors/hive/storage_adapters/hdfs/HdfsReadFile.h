@@ -14,7 +14,12 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
+#include <folly/container/F14Map.h>
+#include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include <condition_variable>
+#include <mutex>
 #include "velox/common/file/File.h"
 
 namespace facebook::velox {
@@ -55,12 +60,39 @@ struct HdfsFile {
   }
 };
 
+/// Limits the number of concurrent reads from each datanode. Shared by the
+/// files of an HDFS file system.
+class DatanodeReadLimiter {
+ public:
+  explicit DatanodeReadLimiter(uint32_t maxReadsPerDatanode)
+      : maxReadsPerDatanode_(std::max<uint32_t>(1, maxReadsPerDatanode)) {}
+
+  /// Waits until fewer than the maximum number of reads from 'datanode' are in
+  /// flight and registers a read from it.
+  void acquire(const std::string& datanode);
+
+  /// Unregisters a read from 'datanode'.
+  void release(const std::string& datanode);
+
+ private:
+  const uint32_t maxReadsPerDatanode_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  folly::F14FastMap<std::string, uint32_t> numReads_;
+};
+
 /**
  * Implementation of hdfs read file.
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  /// Multi-range reads run on 'executor' if set, with at most the allowed
+  /// number of reads from a datanode in flight per 'limiter'.
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* executor = nullptr,
+      DatanodeReadLimiter* limiter = nullptr);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -68,6 +100,21 @@ class HdfsReadFile final : public ReadFile {
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return executor_ != nullptr;
+  }
+
+  std::optional<uint64_t> localBytes(uint64_t offset, uint64_t length)
+      const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -83,13 +130,33 @@ class HdfsReadFile final : public ReadFile {
   }
 
  private:
+  // Where the replicas of a block are stored.
+  struct BlockLocation {
+    // The datanode that reads of the block are attributed to.
+    std::string datanode;
+    // True if a replica is stored on the local host.
+    bool local{false};
+  };
+
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
+  // Reads 'length' bytes at 'offset' into 'pos' within the read limit of the
+  // datanode of the block at 'offset'.
+  void limitedPread(uint64_t offset, uint64_t length, char* pos) const;
+
+  // Returns the block locations, fetched from the namenode on first use.
+  // Empty if they could not be fetched.
+  const std::vector<BlockLocation>& blockLocations() const;
+
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
+  folly::Executor* const executor_;
+  DatanodeReadLimiter* const limiter_;
+  mutable folly::once_flag blockLocationsOnce_;
+  mutable std::vector<BlockLocation> blockLocations_;
 };
 
 } // namespace facebook::velox
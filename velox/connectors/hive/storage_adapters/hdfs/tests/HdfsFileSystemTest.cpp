@@ -444,3 +444,48 @@ TEST_F(HdfsFileSystemTest, readFailures) {
   auto hdfs = hdfsBuilderConnect(builder);
   verifyFailures(hdfs);
 }
+
+TEST_F(HdfsFileSystemTest, preadvAsync) {
+  auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
+  auto hdfsFileSystem =
+      filesystems::getFileSystem(fullDestinationPath, memConfig);
+  auto readFile = hdfsFileSystem->openFileForRead(fullDestinationPath);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  char buff1[10];
+  char buff2[10];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(buff1, 10),
+      folly::Range<char*>(nullptr, kOneMB - 5),
+      folly::Range<char*>(buff2, 10)};
+  ASSERT_EQ(10 + kOneMB - 5 + 10, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
+
+  // The file is stored on the mini cluster, whose host may or may not match
+  // the name of the local host.
+  const auto localBytes = readFile->localBytes(0, readFile->size());
+  ASSERT_TRUE(localBytes.has_value());
+  ASSERT_LE(localBytes.value(), readFile->size());
+}
+
+TEST(DatanodeReadLimiterTest, limitPerDatanode) {
+  DatanodeReadLimiter limiter(2);
+  limiter.acquire("a");
+  limiter.acquire("a");
+  // Reads from other datanodes are not limited by those from 'a'.
+  limiter.acquire("b");
+  std::atomic<bool> acquired{false};
+  std::thread thread([&]() {
+    limiter.acquire("a");
+    acquired = true;
+    limiter.release("a");
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_FALSE(acquired);
+  limiter.release("a");
+  thread.join();
+  ASSERT_TRUE(acquired);
+  limiter.release("a");
+  limiter.release("b");
+  VELOX_ASSERT_THROW(limiter.release("b"), "");
+}
@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -24,8 +25,11 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
@@ -72,16 +76,87 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Limits the number of concurrent GET requests of a file.
+class RequestLimiter {
+ public:
+  explicit RequestLimiter(uint32_t maxConcurrency)
+      : maxConcurrency_(std::max<uint32_t>(1, maxConcurrency)) {}
+
+  // Runs 'start' now if fewer than the maximum number of requests are in
+  // flight and otherwise when a request finishes. 'start' must call finish()
+  // when its request is done.
+  void schedule(std::function<void()> start) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (numInFlight_ >= maxConcurrency_) {
+        pending_.push_back(std::move(start));
+        return;
+      }
+      ++numInFlight_;
+    }
+    start();
+  }
+
+  void finish() {
+    std::function<void()> next;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (pending_.empty()) {
+        --numInFlight_;
+        return;
+      }
+      next = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    next();
+  }
+
+ private:
+  const uint32_t maxConcurrency_;
+  std::mutex mutex_;
+  uint32_t numInFlight_{0};
+  std::deque<std::function<void()>> pending_;
+};
+
+using file::utils::RangeRead;
+
+// Buffer for a RangeRead that spans gaps. Allocated from 'pool' if set.
+class StagingBuffer {
+ public:
+  StagingBuffer(memory::MemoryPool* pool, uint64_t size) {
+    if (pool != nullptr) {
+      poolBuffer_.emplace(*pool, size);
+    } else {
+      heapBuffer_ = std::make_unique<char[]>(size);
+    }
+  }
+
+  char* data() {
+    return poolBuffer_.has_value() ? poolBuffer_->data() : heapBuffer_.get();
+  }
+
+ private:
+  std::optional<dwio::common::DataBuffer<char>> poolBuffer_;
+  std::unique_ptr<char[]> heapBuffer_;
+};
+
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      uint32_t maxConcurrency,
+      uint64_t coalesceGapBytes)
+      : client_(client),
+        coalesceGapBytes_(coalesceGapBytes),
+        limiter_(std::make_shared<RequestLimiter>(maxConcurrency)) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
   // Gets the length of the file.
   // Checks if there are any issues reading the file.
   void initialize(const filesystems::FileOptions& options) {
+    pool_ = options.pool;
     if (options.fileSize.has_value()) {
       VELOX_CHECK_GE(
           options.fileSize.value(), 0, "File size must be non-negative");
@@ -102,6 +177,13 @@ class S3ReadFile final : public ReadFile {
         outcome, "Failed to get metadata for S3 object", bucket_, key_);
     length_ = outcome.GetResult().GetContentLength();
     VELOX_CHECK_GE(length_, 0);
+    etag_ = outcome.GetResult().GetETag();
+  }
+
+  // The entity tag from the metadata request. Empty if the file size was
+  // given.
+  const std::string& etag() const {
+    return etag_;
   }
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
@@ -120,27 +202,43 @@ class S3ReadFile final : public ReadFile {
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const override {
-    // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
-    // between. This call must populate the ranges (except gap ranges)
-    // sequentially starting from 'offset'. AWS S3 GetObject does not support
-    // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
+    auto reads = planReads(offset, buffers);
+    if (reads.size() > 1) {
+      return preadvAsync(offset, buffers).get();
     }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    for (const auto& read : reads) {
+      readRange(read);
     }
-    return length;
+    return totalLength(buffers);
+  }
+
+  // 'buffers' contains Ranges(data, size) with some gaps (data = nullptr) in
+  // between. AWS S3 GetObject does not support multi-range and charges by
+  // number of requests. The ranges are grouped into GET requests that read
+  // through gaps of up to 'coalesceGapBytes_'. The requests run in parallel,
+  // at most 'maxConcurrency' at a time for the file. A request that fills one
+  // range reads directly into it.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    const auto length = totalLength(buffers);
+    auto reads = planReads(offset, buffers);
+    if (reads.empty()) {
+      return folly::makeSemiFuture<uint64_t>(length);
+    }
+    auto [promise, future] = folly::makePromiseContract<uint64_t>();
+    auto state = std::make_shared<AsyncReadState>(
+        reads.size(), length, std::move(promise));
+    for (auto& read : reads) {
+      limiter_->schedule([this, state, read = std::move(read)]() mutable {
+        startRead(std::move(read), state);
+      });
+    }
+    return std::move(future);
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
   }
 
   uint64_t size() const override {
@@ -166,13 +264,110 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
-  // The assumption here is that "position" has space for at least "length"
-  // bytes.
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
+  // Completion of the RangeReads of a preadvAsync.
+  struct AsyncReadState {
+    AsyncReadState(
+        int32_t _numPending,
+        uint64_t _length,
+        folly::Promise<uint64_t> _promise)
+        : numPending(_numPending),
+          length(_length),
+          promise(std::move(_promise)) {}
+
+    // Records the completion of a read that failed with 'error' if set.
+    // Realizes 'promise' after the last read, so that no request writes to
+    // the buffers of the caller after that.
+    void finishRead(std::exception_ptr error) {
+      {
+        std::lock_guard<std::mutex> l(mutex);
+        if (error != nullptr && firstError == nullptr) {
+          firstError = std::move(error);
+        }
+        if (--numPending > 0) {
+          return;
+        }
+      }
+      if (firstError != nullptr) {
+        promise.setException(folly::exception_wrapper(firstError));
+      } else {
+        promise.setValue(length);
+      }
+    }
+
+    std::mutex mutex;
+    int32_t numPending;
+    const uint64_t length;
+    folly::Promise<uint64_t> promise;
+    std::exception_ptr firstError;
+  };
+
+  static uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+    uint64_t length = 0;
+    for (const auto& range : buffers) {
+      length += range.size();
+    }
+    return length;
+  }
+
+  // Groups the non-gap ranges of 'buffers' into GET requests. Gaps of up to
+  // 'coalesceGapBytes_' between ranges are read through.
+  std::vector<RangeRead> planReads(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    return file::utils::planRangeReads(offset, buffers, coalesceGapBytes_);
+  }
 
+  // Reads 'read' synchronously.
+  void readRange(const RangeRead& read) const {
+    if (read.buffers.size() == 1) {
+      preadInternal(read.offset, read.length, read.buffers[0].data());
+      return;
+    }
+    StagingBuffer staging(pool_, read.length);
+    preadInternal(read.offset, read.length, staging.data());
+    file::utils::scatterRangeRead(read, staging.data());
+  }
+
+  // Starts the GET request of 'read' and reports its completion to 'state'.
+  void startRead(RangeRead read, std::shared_ptr<AsyncReadState> state) const {
+    std::shared_ptr<StagingBuffer> staging;
+    char* position = read.buffers[0].data();
+    if (read.buffers.size() > 1) {
+      staging = std::make_shared<StagingBuffer>(pool_, read.length);
+      position = staging->data();
+    }
+    auto request = makeRequest(read.offset, read.length, position);
+    client_->GetObjectAsync(
+        request,
+        [this,
+         read = std::move(read),
+         staging = std::move(staging),
+         state = std::move(state),
+         limiter = limiter_](
+            const auto* /*client*/,
+            const auto& /*request*/,
+            auto&& outcome,
+            const auto& /*context*/) {
+          std::exception_ptr error;
+          try {
+            VELOX_CHECK_AWS_OUTCOME(
+                outcome, "Failed to get S3 object", bucket_, key_);
+            if (staging != nullptr) {
+              file::utils::scatterRangeRead(read, staging->data());
+            }
+          } catch (...) {
+            error = std::current_exception();
+          }
+          limiter->finish();
+          state->finishRead(std::move(error));
+        });
+  }
+
+  // Returns a GET request for 'length' bytes at 'offset' that writes the
+  // bytes to 'position'.
+  Aws::S3::Model::GetObjectRequest
+  makeRequest(uint64_t offset, uint64_t length, char* position) const {
+    Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(awsString(bucket_));
     request.SetKey(awsString(key_));
     std::stringstream ss;
@@ -180,14 +375,26 @@ class S3ReadFile final : public ReadFile {
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
+    return request;
+  }
+
+  // The assumption here is that "position" has space for at least "length"
+  // bytes.
+  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    // Read the desired range of bytes.
+    auto outcome = client_->GetObject(makeRequest(offset, length, position));
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
   }
 
   Aws::S3::S3Client* client_;
+  const uint64_t coalesceGapBytes_;
+  // Shared with the completion callbacks of the requests in flight.
+  const std::shared_ptr<RequestLimiter> limiter_;
+  memory::MemoryPool* pool_{nullptr};
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
+  std::string etag_;
 };
 
 Aws::Utils::Logging::LogLevel inferS3LogLevel(std::string level) {
@@ -516,9 +723,12 @@ void finalizeS3() {
 
 class S3FileSystem::Impl {
  public:
-  Impl(const Config* config) {
-    hiveConfig_ = std::make_shared<HiveConfig>(
-        std::make_shared<core::MemConfig>(config->values()));
+  Impl(const Config* config)
+      : hiveConfig_(std::make_shared<HiveConfig>(
+            std::make_shared<core::MemConfig>(config->values()))),
+        metadataCache_(
+            hiveConfig_->fileMetadataCacheMaxEntries(),
+            hiveConfig_->fileMetadataCacheTtlMs()) {
     VELOX_CHECK(getAwsInstance()->isInitialized(), "S3 is not initialized");
     Aws::Client::ClientConfiguration clientConfig;
     clientConfig.endpointOverride = hiveConfig_->s3Endpoint();
@@ -709,8 +919,21 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  uint32_t readMaxConcurrency() const {
+    return hiveConfig_->s3ReadMaxConcurrency();
+  }
+
+  uint64_t readCoalesceGapBytes() const {
+    return hiveConfig_->s3ReadCoalesceGapBytes();
+  }
+
+  FileMetadataCache& metadataCache() {
+    return metadataCache_;
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
+  FileMetadataCache metadataCache_;
   std::shared_ptr<Aws::S3::S3Client> client_;
 };
 
@@ -727,8 +950,18 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
-  s3file->initialize(options);
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      impl_->readMaxConcurrency(),
+      impl_->readCoalesceGapBytes());
+  auto& metadataCache = impl_->metadataCache();
+  const auto readOptions = metadataCache.withCachedFileSize(file, options);
+  s3file->initialize(readOptions);
+  if (!readOptions.fileSize.has_value()) {
+    metadataCache.put(
+        file, {static_cast<int64_t>(s3file->size()), s3file->etag()});
+  }
   return s3file;
 }
 
@@ -736,11 +969,16 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
+  impl_->metadataCache().invalidate(file);
   auto s3file =
       std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
   return s3file;
 }
 
+FileMetadataCache::Stats S3FileSystem::metadataCacheStats() const {
+  return impl_->metadataCache().stats();
+}
+
 std::string S3FileSystem::name() const {
   return "S3";
 }
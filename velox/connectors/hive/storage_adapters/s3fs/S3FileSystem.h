@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/file/FileMetadataCache.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConfig.h"
 
@@ -72,6 +73,10 @@ class S3FileSystem : public FileSystem {
 
   std::string getLogLevelName() const;
 
+  /// Returns the stats of the cache of file sizes that saves the HeadObject
+  /// request when a file is opened without a known size.
+  FileMetadataCache::Stats metadataCacheStats() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
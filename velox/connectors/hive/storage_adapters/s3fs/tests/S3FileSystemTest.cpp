@@ -60,6 +60,96 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, metadataCache) {
+  const char* bucketName = "metadata";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  auto hiveConfig = minioServer_->hiveConfig();
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  readData(s3fs.openFileForRead(s3File).get());
+  // The second open takes the size from the cache.
+  readData(s3fs.openFileForRead(s3File).get());
+  // A given size is used without a lookup.
+  readData(s3fs.openFileForRead(s3File, {{}, nullptr, 15 + kOneMB}).get());
+  auto stats = s3fs.metadataCacheStats();
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numHits, 1);
+  ASSERT_EQ(stats.numEntries, 1);
+
+  // Opening the file for write drops its entry.
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  ASSERT_EQ(s3fs.metadataCacheStats().numEntries, 0);
+  writeFile->append("abc");
+  writeFile->close();
+  ASSERT_EQ(s3fs.openFileForRead(s3File)->size(), 3);
+
+  auto noCacheConfig =
+      minioServer_->hiveConfig({{"file-metadata-cache-ttl-ms", "0"}});
+  filesystems::S3FileSystem noCacheFs(noCacheConfig);
+  ASSERT_EQ(noCacheFs.openFileForRead(s3File)->size(), 3);
+  ASSERT_EQ(noCacheFs.openFileForRead(s3File)->size(), 3);
+  stats = noCacheFs.metadataCacheStats();
+  ASSERT_EQ(stats.numHits, 0);
+  ASSERT_EQ(stats.numEntries, 0);
+}
+
+TEST_F(S3FileSystemTest, preadvAsync) {
+  const char* bucketName = "preadv";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // The ranges 500'000 bytes apart are read by separate requests, at most 2
+  // at a time. The ranges 2 bytes apart share one.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-coalesce-gap-bytes", "1000"},
+       {"hive.s3.read-max-concurrency", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto readFile = s3fs.openFileForRead(s3File, {{}, pool.get(), std::nullopt});
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  char head[10];
+  char middle[3];
+  char next[3];
+  char tail[5];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500'000),
+      folly::Range<char*>(middle, sizeof(middle)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)2),
+      folly::Range<char*>(next, sizeof(next)),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(kOneMB - 500'000 - sizeof(middle) - 2 -
+                            sizeof(next))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "ccc");
+  ASSERT_EQ(std::string_view(next, sizeof(next)), "ccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+
+  // A missing file fails the future.
+  auto missingFile = s3fs.openFileForRead(
+      s3URI(bucketName, "missing.txt"), {{}, nullptr, 15 + kOneMB});
+  VELOX_ASSERT_THROW(
+      missingFile->preadvAsync(0, buffers).get(), "Failed to get S3 object");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
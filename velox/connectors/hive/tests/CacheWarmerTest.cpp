@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/CacheWarmer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/ColumnAccessHistory.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::connector::hive {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class CacheWarmerTest : public HiveConnectorTestBase {
+ protected:
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    asyncDataCache_->clear();
+    file_ = TempFilePath::create();
+    data_ = makeRowVector(
+        {"c0", "c1", "c2"},
+        {makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+         makeFlatVector<int64_t>(10'000, [](auto row) { return row * 3; }),
+         makeFlatVector<std::string>(
+             10'000, [](auto row) { return std::string(row % 50, 'x'); })});
+    writeToFile(file_->getPath(), data_);
+  }
+
+  void TearDown() override {
+    cache::columnAccessHistory().clear();
+    cache::columnAccessHistory().setEnabled(false);
+    HiveConnectorTestBase::TearDown();
+  }
+
+  std::unique_ptr<CacheWarmer> makeWarmer(
+      const CacheWarmer::Options& options = {}) {
+    return std::make_unique<CacheWarmer>(
+        asyncDataCache_.get(),
+        rootPool_->addLeafChild("cacheWarmer"),
+        ioExecutor_.get(),
+        options);
+  }
+
+  std::shared_ptr<TempFilePath> file_;
+  RowVectorPtr data_;
+};
+
+TEST_F(CacheWarmerTest, warm) {
+  auto warmer = makeWarmer();
+  // No history for the table.
+  EXPECT_FALSE(
+      warmer->warm("t", file_->getPath(), dwio::common::FileFormat::DWRF));
+
+  // Scans of 't' read c1, which is node 2 in the file schema.
+  cache::columnAccessHistory().recordScan("t", {{2, 1'000}});
+  EXPECT_FALSE(
+      warmer->warm("t", file_->getPath(), dwio::common::FileFormat::PARQUET));
+  ASSERT_TRUE(
+      warmer->warm("t", file_->getPath(), dwio::common::FileFormat::DWRF));
+  warmer->waitForIdle();
+  const auto stats = warmer->stats();
+  EXPECT_EQ(stats.numFiles, 1);
+  EXPECT_EQ(stats.numSkippedFiles, 0);
+  EXPECT_GT(stats.bytes, 0);
+  EXPECT_GT(asyncDataCache_->refreshStats().numEntries, 0);
+
+  // A scan of c1 finds it in the memory cache.
+  auto plan = PlanBuilder().tableScan(ROW({"c1"}, {BIGINT()})).planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .split(makeHiveConnectorSplit(file_->getPath()))
+                  .assertResults(makeRowVector({"c1"}, {data_->childAt(1)}));
+  auto runtimeStats =
+      task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats;
+  EXPECT_GT(runtimeStats["ramReadBytes"].sum, 0);
+}
+
+TEST_F(CacheWarmerTest, maxPendingFiles) {
+  CacheWarmer::Options options;
+  options.maxPendingFiles = 0;
+  auto warmer = makeWarmer(options);
+  cache::columnAccessHistory().recordScan("t", {{2, 1'000}});
+  EXPECT_FALSE(
+      warmer->warm("t", file_->getPath(), dwio::common::FileFormat::DWRF));
+  EXPECT_EQ(warmer->stats().numSkippedFiles, 1);
+  EXPECT_EQ(warmer->stats().numFiles, 0);
+}
+
+TEST_F(CacheWarmerTest, missingFile) {
+  auto warmer = makeWarmer();
+  cache::columnAccessHistory().recordScan("t", {{2, 1'000}});
+  ASSERT_TRUE(
+      warmer->warm("t", "/nonexistent/file", dwio::common::FileFormat::DWRF));
+  warmer->waitForIdle();
+  EXPECT_EQ(warmer->stats().numFiles, 0);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive
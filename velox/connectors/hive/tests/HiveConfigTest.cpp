@@ -30,6 +30,8 @@ TEST(HiveConfigTest, defaultConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kError);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(emptySession.get()), 100);
+  ASSERT_EQ(hiveConfig.maxOpenPartitionWriters(emptySession.get()), 0);
+  ASSERT_EQ(hiveConfig.maxTargetFileSizeBytes(emptySession.get()), 0);
   ASSERT_EQ(hiveConfig.immutablePartitions(), false);
   ASSERT_EQ(hiveConfig.s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig.s3GetLogLevel(), "FATAL");
@@ -49,6 +51,7 @@ TEST(HiveConfigTest, defaultConfig) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_FALSE(hiveConfig.adaptiveCoalesce());
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -60,19 +63,28 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig.sortWriterMaxOutputBytes(emptySession.get()), 10UL << 20);
+  ASSERT_FALSE(hiveConfig.sortWriterPresortedInput(emptySession.get()));
   ASSERT_EQ(hiveConfig.isPartitionPathAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig.orcWriterMinCompressionSize(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig.orcWriterCompressionLevel(emptySession.get()), std::nullopt);
   ASSERT_EQ(
       hiveConfig.orcWriterLinearStripeSizeHeuristics(emptySession.get()), true);
+  ASSERT_FALSE(hiveConfig.parquetWriterPageIndexEnabled(emptySession.get()));
+  ASSERT_TRUE(
+      hiveConfig.parquetWriterBloomFilterColumns(emptySession.get()).empty());
   ASSERT_FALSE(hiveConfig.cacheNoRetention(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.sharedScanEnabled(emptySession.get()));
+  ASSERT_EQ(hiveConfig.sharedScanMaxBufferedBatches(), 8);
+  ASSERT_FALSE(hiveConfig.icebergDeleteBitmapCacheEnabled(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideConfig) {
   const std::unordered_map<std::string, std::string> configFromFile = {
       {HiveConfig::kInsertExistingPartitionsBehavior, "OVERWRITE"},
       {HiveConfig::kMaxPartitionsPerWriters, "120"},
+      {HiveConfig::kMaxOpenPartitionWriters, "10"},
+      {HiveConfig::kMaxTargetFileSize, "1GB"},
       {HiveConfig::kImmutablePartitions, "true"},
       {HiveConfig::kS3PathStyleAccess, "true"},
       {HiveConfig::kS3LogLevel, "Warning"},
@@ -90,16 +102,21 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kFileColumnNamesReadAsLowerCase, "true"},
       {HiveConfig::kMaxCoalescedBytes, "100"},
       {HiveConfig::kMaxCoalescedDistanceBytes, "100"},
+      {HiveConfig::kAdaptiveCoalesce, "true"},
       {HiveConfig::kNumCacheFileHandles, "100"},
       {HiveConfig::kEnableFileHandleCache, "false"},
       {HiveConfig::kOrcWriterMaxStripeSize, "100MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemory, "100MB"},
       {HiveConfig::kSortWriterMaxOutputRows, "100"},
       {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
+      {HiveConfig::kSortWriterPresortedInput, "true"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristics, "false"},
       {HiveConfig::kOrcWriterMinCompressionSize, "512"},
       {HiveConfig::kOrcWriterCompressionLevel, "1"},
-      {HiveConfig::kCacheNoRetention, "true"}};
+      {HiveConfig::kCacheNoRetention, "true"},
+      {HiveConfig::kSharedScanEnabled, "true"},
+      {HiveConfig::kSharedScanMaxBufferedBatches, "4"},
+      {HiveConfig::kIcebergDeleteBitmapCacheEnabled, "true"}};
   HiveConfig hiveConfig(std::make_shared<MemConfig>(configFromFile));
   auto emptySession = std::make_unique<MemConfig>();
   ASSERT_EQ(
@@ -107,6 +124,8 @@ TEST(HiveConfigTest, overrideConfig) {
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(emptySession.get()), 120);
+  ASSERT_EQ(hiveConfig.maxOpenPartitionWriters(emptySession.get()), 10);
+  ASSERT_EQ(hiveConfig.maxTargetFileSizeBytes(emptySession.get()), 1UL << 30);
   ASSERT_EQ(hiveConfig.immutablePartitions(), true);
   ASSERT_EQ(hiveConfig.s3UseVirtualAddressing(), false);
   ASSERT_EQ(hiveConfig.s3GetLogLevel(), "Warning");
@@ -125,6 +144,7 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig.isFileColumnNamesReadAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 100);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 100);
+  ASSERT_TRUE(hiveConfig.adaptiveCoalesce());
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 100);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), false);
   ASSERT_EQ(
@@ -136,36 +156,49 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 100);
   ASSERT_EQ(
       hiveConfig.sortWriterMaxOutputBytes(emptySession.get()), 100UL << 20);
+  ASSERT_TRUE(hiveConfig.sortWriterPresortedInput(emptySession.get()));
   ASSERT_EQ(hiveConfig.orcWriterMinCompressionSize(emptySession.get()), 512);
   ASSERT_EQ(hiveConfig.orcWriterCompressionLevel(emptySession.get()), 1);
   ASSERT_EQ(
       hiveConfig.orcWriterLinearStripeSizeHeuristics(emptySession.get()),
       false);
   ASSERT_TRUE(hiveConfig.cacheNoRetention(emptySession.get()));
+  ASSERT_TRUE(hiveConfig.sharedScanEnabled(emptySession.get()));
+  ASSERT_EQ(hiveConfig.sharedScanMaxBufferedBatches(), 4);
+  ASSERT_TRUE(hiveConfig.icebergDeleteBitmapCacheEnabled(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideSession) {
   HiveConfig hiveConfig(std::make_shared<MemConfig>());
   const std::unordered_map<std::string, std::string> sessionOverride = {
       {HiveConfig::kInsertExistingPartitionsBehaviorSession, "OVERWRITE"},
+      {HiveConfig::kMaxOpenPartitionWritersSession, "20"},
+      {HiveConfig::kMaxTargetFileSizeSession, "128MB"},
       {HiveConfig::kOrcUseColumnNamesSession, "true"},
       {HiveConfig::kFileColumnNamesReadAsLowerCaseSession, "true"},
       {HiveConfig::kOrcWriterMaxStripeSizeSession, "22MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemorySession, "22MB"},
       {HiveConfig::kSortWriterMaxOutputRowsSession, "20"},
       {HiveConfig::kSortWriterMaxOutputBytesSession, "20MB"},
+      {HiveConfig::kSortWriterPresortedInputSession, "true"},
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kOrcWriterMinCompressionSizeSession, "512"},
       {HiveConfig::kOrcWriterCompressionLevelSession, "1"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristicsSession, "false"},
-      {HiveConfig::kCacheNoRetentionSession, "true"}};
+      {HiveConfig::kParquetWriterPageIndexEnabledSession, "true"},
+      {HiveConfig::kParquetWriterBloomFilterColumnsSession, "c0, c2,,"},
+      {HiveConfig::kCacheNoRetentionSession, "true"},
+      {HiveConfig::kSharedScanEnabledSession, "true"},
+      {HiveConfig::kIcebergDeleteBitmapCacheEnabledSession, "true"}};
   const auto session = std::make_unique<MemConfig>(sessionOverride);
   ASSERT_EQ(
       hiveConfig.insertExistingPartitionsBehavior(session.get()),
       facebook::velox::connector::hive::HiveConfig::
           InsertExistingPartitionsBehavior::kOverwrite);
   ASSERT_EQ(hiveConfig.maxPartitionsPerWriters(session.get()), 100);
+  ASSERT_EQ(hiveConfig.maxOpenPartitionWriters(session.get()), 20);
+  ASSERT_EQ(hiveConfig.maxTargetFileSizeBytes(session.get()), 128UL << 20);
   ASSERT_EQ(hiveConfig.immutablePartitions(), false);
   ASSERT_EQ(hiveConfig.s3UseVirtualAddressing(), true);
   ASSERT_EQ(hiveConfig.s3GetLogLevel(), "FATAL");
@@ -184,6 +217,7 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig.maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig.maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_FALSE(hiveConfig.adaptiveCoalesce());
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig.isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -193,11 +227,18 @@ TEST(HiveConfigTest, overrideSession) {
       22L * 1024L * 1024L);
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(session.get()), 20);
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputBytes(session.get()), 20UL << 20);
+  ASSERT_TRUE(hiveConfig.sortWriterPresortedInput(session.get()));
   ASSERT_EQ(hiveConfig.isPartitionPathAsLowerCase(session.get()), false);
   ASSERT_EQ(hiveConfig.ignoreMissingFiles(session.get()), true);
   ASSERT_EQ(
       hiveConfig.orcWriterLinearStripeSizeHeuristics(session.get()), false);
   ASSERT_EQ(hiveConfig.orcWriterMinCompressionSize(session.get()), 512);
   ASSERT_EQ(hiveConfig.orcWriterCompressionLevel(session.get()), 1);
+  ASSERT_TRUE(hiveConfig.parquetWriterPageIndexEnabled(session.get()));
+  ASSERT_EQ(
+      hiveConfig.parquetWriterBloomFilterColumns(session.get()),
+      (std::vector<std::string>{"c0", "c2"}));
   ASSERT_TRUE(hiveConfig.cacheNoRetention(session.get()));
+  ASSERT_TRUE(hiveConfig.sharedScanEnabled(session.get()));
+  ASSERT_TRUE(hiveConfig.icebergDeleteBitmapCacheEnabled(session.get()));
 }
@@ -21,9 +21,11 @@
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -486,12 +488,15 @@ TEST_F(HiveDataSinkTest, basic) {
   ASSERT_TRUE(stats.empty()) << stats.toString();
   ASSERT_EQ(
       stats.toString(),
-      "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
+      "numWrittenBytes 0B numWrittenFiles 0 numWrittenIndexBytes 0B "
+      "spillRuns[0] spilledInputBytes[0B] "
       "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
+      "spilledRemoteBytes[0B] spilledRemoteFiles[0] "
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
-      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
-      "spillReadTime[0us] spillReadDeserializationTime[0us]");
+      "spillWriteWaitTime[0us] maxSpillExceededLimitCount[0] "
+      "spillReadBytes[0B] spillReads[0] spillReadTime[0us] "
+      "spillReadWaitTime[0us] spillReadDeserializationTime[0us]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -512,6 +517,31 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->getPath());
 }
 
+TEST_F(HiveDataSinkTest, maxTargetFileSize) {
+  connectorSessionProperties_->setValue(
+      HiveConfig::kOrcWriterMaxStripeSizeSession, "1KB");
+  connectorSessionProperties_->setValue(
+      HiveConfig::kMaxTargetFileSizeSession, "1B");
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = createDataSink(rowType_, outputDirectory->getPath());
+
+  const int numBatches = 10;
+  const auto vectors = createVectors(500, numBatches);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  // The file is rotated whenever a stripe has been written.
+  const auto partitions = dataSink->close();
+  const auto numFiles = listFiles(outputDirectory->getPath()).size();
+  ASSERT_GT(numFiles, 1);
+  ASSERT_LE(numFiles, numBatches);
+  ASSERT_EQ(partitions.size(), numFiles);
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, numFiles);
+
+  createDuckDbTable(vectors);
+  verifyWrittenData(outputDirectory->getPath(), numFiles);
+}
+
 TEST_F(HiveDataSinkTest, basicBucket) {
   const auto outputDirectory = TempDirectoryPath::create();
 
@@ -534,12 +564,15 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   ASSERT_TRUE(stats.empty()) << stats.toString();
   ASSERT_EQ(
       stats.toString(),
-      "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
+      "numWrittenBytes 0B numWrittenFiles 0 numWrittenIndexBytes 0B "
+      "spillRuns[0] spilledInputBytes[0B] "
       "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
+      "spilledRemoteBytes[0B] spilledRemoteFiles[0] "
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
-      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
-      "spillReadTime[0us] spillReadDeserializationTime[0us]");
+      "spillWriteWaitTime[0us] maxSpillExceededLimitCount[0] "
+      "spillReadBytes[0B] spillReads[0] spillReadTime[0us] "
+      "spillReadWaitTime[0us] spillReadDeserializationTime[0us]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -560,6 +593,174 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   verifyWrittenData(outputDirectory->getPath(), numBuckets);
 }
 
+TEST_F(HiveDataSinkTest, maxOpenPartitionWriters) {
+  connectorSessionProperties_->setValue(
+      HiveConfig::kMaxOpenPartitionWritersSession, "3");
+  const int32_t numBuckets = 8;
+  for (bool abort : {false, true}) {
+    SCOPED_TRACE(fmt::format("abort: {}", abort));
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto bucketProperty = std::make_shared<HiveBucketProperty>(
+        HiveBucketProperty::Kind::kHiveCompatible,
+        numBuckets,
+        std::vector<std::string>{"c0"},
+        std::vector<TypePtr>{BIGINT()},
+        std::vector<std::shared_ptr<const HiveSortingColumn>>{});
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {},
+        bucketProperty);
+
+    const auto vectors = createVectors(500, 10);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    // Only the first 3 buckets have a file until close.
+    ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), 3);
+
+    if (abort) {
+      dataSink->abort();
+      ASSERT_EQ(dataSink->stats().numWrittenFiles, 0);
+      continue;
+    }
+    // Each bucket is written to a single file.
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), numBuckets);
+    ASSERT_EQ(dataSink->stats().numWrittenFiles, numBuckets);
+
+    createDuckDbTable(vectors);
+    verifyWrittenData(outputDirectory->getPath(), numBuckets);
+  }
+}
+
+TEST_F(HiveDataSinkTest, zOrderSortWithStripeCuts) {
+  const auto outputDirectory = TempDirectoryPath::create();
+  connectorSessionProperties_->setValue(
+      HiveConfig::kSortWriterZOrderSession, "true");
+  connectorSessionProperties_->setValue(
+      HiveConfig::kSortWriterStripeRowsSession, "1000");
+
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      1,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{true, true}),
+          std::make_shared<HiveSortingColumn>(
+              "c2", core::SortOrder{true, true})});
+  auto dataSink = createDataSink(
+      rowType_,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {},
+      bucketProperty);
+
+  const int numBatches = 10;
+  const auto vectors = createVectors(500, numBatches);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_EQ(dataSink->close().size(), 1);
+
+  createDuckDbTable(vectors);
+  verifyWrittenData(outputDirectory->getPath());
+
+  // Each stripe is cut after between 500 and 1000 rows.
+  const auto files = listFiles(outputDirectory->getPath());
+  dwio::common::ReaderOptions readerOptions{pool()};
+  auto reader = dwrf::DwrfReader::create(
+      std::make_unique<dwio::common::BufferedInput>(
+          std::make_shared<LocalReadFile>(files[0]), *pool()),
+      readerOptions);
+  ASSERT_GE(reader->getNumberOfStripes(), 5);
+  ASSERT_LE(reader->getNumberOfStripes(), 10);
+}
+
+TEST_F(HiveDataSinkTest, presortedInput) {
+  connectorSessionProperties_->setValue(
+      HiveConfig::kSortWriterPresortedInputSession, "true");
+  const auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      1,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c0", core::SortOrder{true, true})});
+
+  // Makes batches sorted on c0, except for 'unsortedBatch' which has its
+  // rows in reverse order.
+  const int numBatches = 10;
+  const int batchSize = 500;
+  const auto makeInput = [&](std::optional<int> unsortedBatch) {
+    auto vectors = createVectors(batchSize, numBatches);
+    for (int i = 0; i < numBatches; ++i) {
+      const bool unsorted = unsortedBatch == i;
+      vectors[i]->childAt(0) =
+          makeFlatVector<int64_t>(batchSize, [&](auto row) {
+            return batchSize * i + (unsorted ? batchSize - 1 - row : row);
+          });
+    }
+    return vectors;
+  };
+
+  struct {
+    std::optional<int> unsortedBatch;
+    bool expectFailure;
+
+    std::string debugString() const {
+      return fmt::format(
+          "unsortedBatch: {}, expectFailure: {}",
+          unsortedBatch.has_value() ? std::to_string(*unsortedBatch) : "none",
+          expectFailure);
+    }
+  } testSettings[] = {
+      // Streams all rows.
+      {std::nullopt, false},
+      // Falls back to sorting all rows.
+      {0, false},
+      // Rows before the unsorted batch are already written.
+      {5, true}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {},
+        bucketProperty);
+    const auto vectors = makeInput(testData.unsortedBatch);
+    for (int i = 0; i < numBatches; ++i) {
+      if (testData.expectFailure && testData.unsortedBatch == i) {
+        VELOX_ASSERT_THROW(
+            dataSink->appendData(vectors[i]),
+            "Input declared sorted has rows out of order");
+        break;
+      }
+      dataSink->appendData(vectors[i]);
+    }
+    if (testData.expectFailure) {
+      dataSink->abort();
+      continue;
+    }
+    ASSERT_EQ(dataSink->close().size(), 1);
+
+    createDuckDbTable(vectors);
+    const auto files = listFiles(outputDirectory->getPath());
+    ASSERT_EQ(files.size(), 1);
+    assertQueryOrdered(
+        PlanBuilder().tableScan(rowType_).planNode(),
+        {makeHiveConnectorSplit(files[0])},
+        "SELECT * FROM tmp ORDER BY c0",
+        {0});
+  }
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -122,6 +122,17 @@ TEST_F(HivePartitionFunctionTest, bigint) {
   assertPartitionsWithConstChannel(values, 997);
 }
 
+TEST_F(HivePartitionFunctionTest, constantBigint) {
+  auto values = makeConstant<int64_t>(300'000'000'000, 4);
+
+  assertPartitions(values, 1, {0, 0, 0, 0});
+  assertPartitions(values, 2, {1, 1, 1, 1});
+  assertPartitions(values, 500, {497, 497, 497, 497});
+  assertPartitions(values, 997, {852, 852, 852, 852});
+
+  assertPartitionsWithConstChannel(values, 500);
+}
+
 TEST_F(HivePartitionFunctionTest, varchar) {
   auto values = makeNullableFlatVector<std::string>(
       {std::nullopt,
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/SharedScan.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/expression/ExprToSubfieldFilter.h"
+#include "velox/type/tests/SubfieldFiltersBuilder.h"
+
+namespace facebook::velox::connector::hive {
+namespace {
+
+using namespace facebook::velox::exec::test;
+
+class SharedScanTest : public HiveConnectorTestBase {
+ protected:
+  static constexpr int32_t kNumRows = 10'000;
+  static constexpr int32_t kBatchSize = 1'000;
+
+  void SetUp() override {
+    HiveConnectorTestBase::SetUp();
+    file_ = TempFilePath::create();
+    data_ = makeRowVector(
+        {"c0", "c1", "c2"},
+        {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+         makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 3; }),
+         makeFlatVector<std::string>(kNumRows, [](auto row) {
+           return std::string(row % 50, 'a' + row % 26);
+         })});
+    writeToFile(file_->getPath(), data_);
+    connectorPool_ = rootPool_->addAggregateChild("connector");
+  }
+
+  void TearDown() override {
+    queryCtxs_.clear();
+    connectorPool_.reset();
+    HiveConnectorTestBase::TearDown();
+  }
+
+  // Returns a data source of a separate scan that returns 'columns' of the
+  // rows that pass 'filters'. The scan has the session properties 'session'
+  // or 'session_' if not given.
+  std::unique_ptr<DataSource> makeDataSource(
+      const std::vector<std::string>& columns,
+      common::test::SubfieldFilters filters = {},
+      const Config* session = nullptr) {
+    std::vector<TypePtr> types;
+    for (const auto& column : columns) {
+      types.push_back(data_->type()->asRow().findChild(column));
+    }
+    const auto outputType = ROW(std::vector<std::string>(columns), types);
+    queryCtxs_.push_back(std::make_unique<ConnectorQueryCtx>(
+        pool_.get(),
+        connectorPool_.get(),
+        session != nullptr ? session : &session_,
+        nullptr,
+        nullptr,
+        asyncDataCache_.get(),
+        fmt::format("query.{}", queryCtxs_.size()),
+        "task",
+        "0",
+        0));
+    return getConnector(kHiveConnectorId)
+        ->createDataSource(
+            outputType,
+            makeTableHandle(
+                std::move(filters),
+                nullptr,
+                "hive_table",
+                asRowType(data_->type())),
+            allRegularColumns(outputType),
+            queryCtxs_.back().get());
+  }
+
+  // Adds the next batch of 'dataSource' to 'result'. Returns false at the end
+  // of the split.
+  static bool readBatch(
+      DataSource& dataSource,
+      std::vector<RowVectorPtr>& result) {
+    ContinueFuture future;
+    auto batch = dataSource.next(kBatchSize, future);
+    VELOX_CHECK(batch.has_value());
+    if (batch.value() == nullptr) {
+      return false;
+    }
+    if (batch.value()->size() > 0) {
+      result.push_back(batch.value());
+    }
+    return true;
+  }
+
+  static int64_t stat(DataSource& dataSource, const std::string& name) {
+    const auto stats = dataSource.runtimeStats();
+    const auto it = stats.find(name);
+    return it == stats.end() ? 0 : it->second.value;
+  }
+
+  std::shared_ptr<TempFilePath> file_;
+  RowVectorPtr data_;
+  core::MemConfig session_{
+      {{HiveConfig::kSharedScanEnabledSession, "true"}}};
+  std::shared_ptr<memory::MemoryPool> connectorPool_;
+  std::vector<std::unique_ptr<ConnectorQueryCtx>> queryCtxs_;
+};
+
+TEST_F(SharedScanTest, columnsToRead) {
+  const auto fileType = asRowType(data_->type());
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addFieldRecursively("c2", *VARCHAR(), 0);
+  scanSpec->addFieldRecursively("c0", *BIGINT(), 1)
+      ->setFilter(exec::lessThan(10));
+  EXPECT_EQ(
+      SharedScan::columnsToRead(*scanSpec, *fileType),
+      (std::vector<std::string>{"c2", "c0"}));
+
+  // Columns not in the file are not supported.
+  scanSpec->addFieldRecursively("c3", *BIGINT(), 2);
+  EXPECT_FALSE(SharedScan::columnsToRead(*scanSpec, *fileType).has_value());
+}
+
+TEST_F(SharedScanTest, shareDecoding) {
+  auto first = makeDataSource(
+      {"c0"},
+      common::test::singleSubfieldFilter("c0", exec::lessThan(5'000)));
+  auto second = makeDataSource({"c1", "c2"});
+  first->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  second->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  EXPECT_EQ(sharedScans().numScans(), 1);
+
+  std::vector<RowVectorPtr> firstResult;
+  std::vector<RowVectorPtr> secondResult;
+  bool firstDone = false;
+  bool secondDone = false;
+  while (!firstDone || !secondDone) {
+    firstDone = firstDone || !readBatch(*first, firstResult);
+    secondDone = secondDone || !readBatch(*second, secondResult);
+  }
+  assertEqualResults(
+      {makeRowVector(
+          {"c0"},
+          {makeFlatVector<int64_t>(5'000, [](auto row) { return row; })})},
+      firstResult);
+  assertEqualResults(
+      {makeRowVector({"c1", "c2"}, {data_->childAt(1), data_->childAt(2)})},
+      secondResult);
+
+  // Each batch is decoded once and read by both scans.
+  EXPECT_EQ(stat(*first, "sharedScanRows"), kNumRows);
+  EXPECT_EQ(stat(*second, "sharedScanRows"), kNumRows);
+  EXPECT_EQ(
+      stat(*first, "sharedScanReusedRows") +
+          stat(*second, "sharedScanReusedRows"),
+      kNumRows);
+  EXPECT_GT(stat(*second, "sharedScanReusedBytes"), 0);
+  EXPECT_EQ(sharedScans().numScans(), 0);
+}
+
+TEST_F(SharedScanTest, detachSlowScan) {
+  resetHiveConnector(std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {HiveConfig::kSharedScanMaxBufferedBatches, "2"}}));
+  auto first = makeDataSource({"c0", "c1"});
+  auto second = makeDataSource(
+      {"c2"},
+      common::test::singleSubfieldFilter("c1", exec::greaterThan(3'000)));
+  first->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  second->addSplit(makeHiveConnectorSplit(file_->getPath()));
+
+  // 'second' reads one batch and then falls behind 'first' by more than 2
+  // batches.
+  std::vector<RowVectorPtr> firstResult;
+  std::vector<RowVectorPtr> secondResult;
+  ASSERT_TRUE(readBatch(*first, firstResult));
+  ASSERT_TRUE(readBatch(*second, secondResult));
+  while (readBatch(*first, firstResult)) {
+  }
+  while (readBatch(*second, secondResult)) {
+  }
+  assertEqualResults(
+      {makeRowVector({"c0", "c1"}, {data_->childAt(0), data_->childAt(1)})},
+      firstResult);
+  assertEqualResults(
+      {makeRowVector(
+          {"c2"}, {data_->childAt(2)->slice(1'001, kNumRows - 1'001)})},
+      secondResult);
+  EXPECT_EQ(stat(*first, "numSharedScanDetached"), 0);
+  EXPECT_EQ(stat(*second, "numSharedScanDetached"), 1);
+  EXPECT_EQ(stat(*second, "sharedScanRows"), kBatchSize);
+}
+
+TEST_F(SharedScanTest, differentSessions) {
+  // The session properties may carry the credentials of the file system, so
+  // scans with different session properties do not share the reader.
+  core::MemConfig otherSession{
+      {{HiveConfig::kSharedScanEnabledSession, "true"},
+       {HiveConfig::kFileColumnNamesReadAsLowerCaseSession, "true"}}};
+  auto first = makeDataSource({"c0"});
+  auto second = makeDataSource({"c0"}, {}, &otherSession);
+  auto third = makeDataSource({"c1"});
+  first->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  second->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  third->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  EXPECT_EQ(sharedScans().numScans(), 2);
+
+  std::vector<RowVectorPtr> firstResult;
+  std::vector<RowVectorPtr> secondResult;
+  std::vector<RowVectorPtr> thirdResult;
+  bool firstDone = false;
+  bool secondDone = false;
+  bool thirdDone = false;
+  while (!firstDone || !secondDone || !thirdDone) {
+    firstDone = firstDone || !readBatch(*first, firstResult);
+    secondDone = secondDone || !readBatch(*second, secondResult);
+    thirdDone = thirdDone || !readBatch(*third, thirdResult);
+  }
+  assertEqualResults({makeRowVector({"c0"}, {data_->childAt(0)})}, firstResult);
+  assertEqualResults(
+      {makeRowVector({"c0"}, {data_->childAt(0)})}, secondResult);
+  assertEqualResults({makeRowVector({"c1"}, {data_->childAt(1)})}, thirdResult);
+  EXPECT_EQ(stat(*second, "sharedScanReusedRows"), 0);
+  EXPECT_EQ(
+      stat(*first, "sharedScanReusedRows") +
+          stat(*third, "sharedScanReusedRows"),
+      kNumRows);
+}
+
+TEST_F(SharedScanTest, memoryCapExceeded) {
+  resetHiveConnector(std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {HiveConfig::kSharedScanMaxMemoryBytes, "1"}}));
+  auto first = makeDataSource({"c0"});
+  auto second = makeDataSource(
+      {"c2"},
+      common::test::singleSubfieldFilter("c1", exec::greaterThan(3'000)));
+  first->addSplit(makeHiveConnectorSplit(file_->getPath()));
+  second->addSplit(makeHiveConnectorSplit(file_->getPath()));
+
+  // The shared scan cannot allocate its reader. Both scans read the split on
+  // their own.
+  std::vector<RowVectorPtr> firstResult;
+  std::vector<RowVectorPtr> secondResult;
+  while (readBatch(*first, firstResult)) {
+  }
+  while (readBatch(*second, secondResult)) {
+  }
+  assertEqualResults({makeRowVector({"c0"}, {data_->childAt(0)})}, firstResult);
+  assertEqualResults(
+      {makeRowVector(
+          {"c2"}, {data_->childAt(2)->slice(1'001, kNumRows - 1'001)})},
+      secondResult);
+  EXPECT_EQ(stat(*first, "numSharedScanDetached"), 1);
+  EXPECT_EQ(stat(*second, "numSharedScanDetached"), 1);
+  EXPECT_EQ(stat(*first, "sharedScanRows"), 0);
+  EXPECT_EQ(stat(*second, "sharedScanRows"), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive
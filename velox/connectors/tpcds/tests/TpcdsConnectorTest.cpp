@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include <folly/init/Init.h>
+#include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::connector::tpcds;
+
+using facebook::velox::exec::test::PlanBuilder;
+using facebook::velox::tpcds::Table;
+
+class TpcdsConnectorTest : public exec::test::OperatorTestBase {
+ public:
+  const std::string kTpcdsConnectorId = "test-tpcds";
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpcdsConnectorId);
+    OperatorTestBase::TearDown();
+  }
+
+  exec::Split makeTpcdsSplit(size_t totalParts = 1, size_t partNumber = 0)
+      const {
+    return exec::Split(std::make_shared<TpcdsConnectorSplit>(
+        kTpcdsConnectorId, totalParts, partNumber));
+  }
+
+  RowVectorPtr getResults(
+      const core::PlanNodePtr& planNode,
+      std::vector<exec::Split>&& splits) {
+    return exec::test::AssertQueryBuilder(planNode)
+        .splits(std::move(splits))
+        .copyResults(pool());
+  }
+};
+
+// Simple scan of first 3 rows of "date_dim".
+TEST_F(TpcdsConnectorTest, simple) {
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_DATE_DIM,
+                      {"d_date_sk", "d_year", "d_day_name", "d_date"})
+                  .limit(0, 3, false)
+                  .planNode();
+
+  auto output = getResults(plan, {makeTpcdsSplit()});
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({2415022, 2415023, 2415024}),
+      makeFlatVector<int32_t>({1900, 1900, 1900}),
+      makeFlatVector<StringView>({"Tuesday", "Wednesday", "Thursday"}),
+      makeFlatVector<int32_t>({-25566, -25565, -25564}, DATE()),
+  });
+  test::assertEqualVectors(expected, output);
+}
+
+TEST_F(TpcdsConnectorTest, unknownColumn) {
+  EXPECT_THROW(
+      {
+        PlanBuilder()
+            .tpcdsTableScan(Table::TBL_STORE, {"does_not_exist"})
+            .planNode();
+      },
+      VeloxUserError);
+}
+
+// Ensures that splits broken down using different configurations return the
+// same dataset in the end.
+TEST_F(TpcdsConnectorTest, multipleSplits) {
+  auto plan = PlanBuilder()
+                  .tpcdsTableScan(
+                      Table::TBL_STORE,
+                      {"s_store_sk", "s_store_id", "s_store_name", "s_state"})
+                  .planNode();
+
+  auto fullResult = getResults(plan, {makeTpcdsSplit()});
+  size_t storeRowCount = tpcds::getRowCount(Table::TBL_STORE, 1);
+  EXPECT_EQ(storeRowCount, fullResult->size());
+
+  for (size_t totalParts = 1; totalParts < (storeRowCount + 5); ++totalParts) {
+    std::vector<exec::Split> splits;
+    splits.reserve(totalParts);
+
+    for (size_t i = 0; i < totalParts; ++i) {
+      splits.emplace_back(makeTpcdsSplit(totalParts, i));
+    }
+
+    auto output = getResults(plan, std::move(splits));
+    test::assertEqualVectors(fullResult, output);
+  }
+}
+
+// Join store_sales and date_dim. All sales are between 1998 and 2003 and
+// only the sales with a null date do not match.
+TEST_F(TpcdsConnectorTest, join) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId salesScanId;
+  core::PlanNodeId dateScanId;
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .tpcdsTableScan(Table::TBL_STORE_SALES, {"ss_sold_date_sk"}, 0.001)
+          .capturePlanNodeId(salesScanId)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              PlanBuilder(planNodeIdGenerator)
+                  .tpcdsTableScan(
+                      Table::TBL_DATE_DIM, {"d_date_sk", "d_year"}, 0.001)
+                  .capturePlanNodeId(dateScanId)
+                  .planNode(),
+              "", // extra filter
+              {"d_year"})
+          .singleAggregation({}, {"min(d_year)", "max(d_year)", "count(1)"})
+          .planNode();
+
+  auto output = exec::test::AssertQueryBuilder(plan)
+                    .split(salesScanId, makeTpcdsSplit())
+                    .split(dateScanId, makeTpcdsSplit())
+                    .copyResults(pool());
+
+  auto sales = tpcds::genTpcdsStoreSales(pool(), 10'000, 0, 0.001);
+  ASSERT_EQ(2'880, sales->size());
+  auto dates = sales->childAt(0);
+  int64_t numNonNullDates = 0;
+  for (auto i = 0; i < dates->size(); ++i) {
+    numNonNullDates += !dates->isNullAt(i);
+  }
+  auto minYear = output->childAt(0)->asFlatVector<int32_t>()->valueAt(0);
+  auto maxYear = output->childAt(1)->asFlatVector<int32_t>()->valueAt(0);
+  EXPECT_LE(1998, minYear);
+  EXPECT_GE(2003, maxYear);
+  EXPECT_LT(minYear, maxYear);
+  EXPECT_EQ(
+      numNonNullDates,
+      output->childAt(2)->asFlatVector<int64_t>()->valueAt(0));
+  EXPECT_LT(numNonNullDates, sales->size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::Init init{&argc, &argv, false};
+  return RUN_ALL_TESTS();
+}
@@ -106,6 +106,7 @@ class TpchDataSource : public DataSource {
 
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
+  // Number of rows the splits divide. Orders for lineitem.
   size_t tpchTableRowCount_{0};
   RowTypePtr outputType_;
 
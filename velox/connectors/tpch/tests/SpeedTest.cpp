@@ -110,6 +110,10 @@ class TpchSpeedTest {
     LOG(INFO) << "\tTotal rows generated: " << totalRows_;
     LOG(INFO) << "\tTotal bytes generated: " << totalBytes_;
     LOG(INFO) << "\tTotal time spent: " << elapsed.count() << "s";
+    const auto rowsPerSec = totalRows_ / elapsed.count();
+    LOG(INFO) << "\tRows/s: " << static_cast<size_t>(rowsPerSec);
+    LOG(INFO) << "\tRows/s per driver: "
+              << static_cast<size_t>(rowsPerSec / FLAGS_max_drivers);
   }
 
  private:
@@ -194,6 +194,28 @@ TEST_F(TpchConnectorTest, lineitemTinyRowCount) {
   EXPECT_EQ(60'175, output->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
 }
 
+// Lineitem splits are made of orders, so that each of them generates rows.
+TEST_F(TpchConnectorTest, lineitemMultipleSplits) {
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(ROW({}, {}))
+                  .tableHandle(std::make_shared<TpchTableHandle>(
+                      kTpchConnectorId, Table::TBL_LINEITEM, 0.01))
+                  .endTableScan()
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+
+  const size_t totalParts = 4;
+  int64_t totalCount = 0;
+  for (size_t i = 0; i < totalParts; ++i) {
+    auto output = getResults(plan, {makeTpchSplit(totalParts, i)});
+    const auto count = output->childAt(0)->asFlatVector<int64_t>()->valueAt(0);
+    EXPECT_GT(count, 0);
+    totalCount += count;
+  }
+  EXPECT_EQ(60'175, totalCount);
+}
+
 TEST_F(TpchConnectorTest, unknownColumn) {
   EXPECT_THROW(
       {
@@ -224,13 +224,6 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
-    }
-  }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
   return (isFinal() || isSingle()) && preGroupedKeys().empty() &&
@@ -1546,13 +1539,15 @@ MarkDistinctNode::MarkDistinctNode(
     PlanNodeId id,
     std::string markerName,
     std::vector<FieldAccessTypedExprPtr> distinctKeys,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    bool preGrouped)
     : PlanNode(std::move(id)),
       markerName_(std::move(markerName)),
       distinctKeys_(std::move(distinctKeys)),
       sources_{std::move(source)},
       outputType_(
-          getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)) {
+          getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)),
+      preGrouped_(preGrouped) {
   VELOX_USER_CHECK_GT(markerName_.size(), 0)
   VELOX_USER_CHECK_GT(distinctKeys_.size(), 0);
 }
@@ -1561,6 +1556,7 @@ folly::dynamic MarkDistinctNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["distinctKeys"] = ISerializable::serialize(this->distinctKeys_);
   obj["markerName"] = this->markerName_;
+  obj["preGrouped"] = preGrouped_;
   return obj;
 }
 
@@ -1569,9 +1565,11 @@ PlanNodePtr MarkDistinctNode::create(const folly::dynamic& obj, void* context) {
   auto source = deserializeSingleSource(obj, context);
   auto distinctKeys = deserializeFields(obj["distinctKeys"], context);
   auto markerName = obj["markerName"].asString();
+  const bool preGrouped =
+      obj.count("preGrouped") ? obj["preGrouped"].asBool() : false;
 
   return std::make_shared<MarkDistinctNode>(
-      deserializePlanNodeId(obj), markerName, distinctKeys, source);
+      deserializePlanNodeId(obj), markerName, distinctKeys, source, preGrouped);
 }
 
 namespace {
@@ -1761,12 +1759,16 @@ PlanNodePtr TopNRowNumberNode::create(
 
 void LocalMergeNode::addDetails(std::stringstream& stream) const {
   addSortingKeys(sortingKeys_, sortingOrders_, stream);
+  if (rangePartitioned_) {
+    stream << " range partitioned";
+  }
 }
 
 folly::dynamic LocalMergeNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["sortingKeys"] = ISerializable::serialize(sortingKeys_);
   obj["sortingOrders"] = serializeSortingOrders(sortingOrders_);
+  obj["rangePartitioned"] = rangePartitioned_;
   return obj;
 }
 
@@ -1775,12 +1777,16 @@ PlanNodePtr LocalMergeNode::create(const folly::dynamic& obj, void* context) {
   auto sources = deserializeSources(obj, context);
   auto sortingKeys = deserializeFields(obj["sortingKeys"], context);
   auto sortingOrders = deserializeSortingOrders(obj["sortingOrders"]);
+  const bool rangePartitioned = obj.count("rangePartitioned")
+      ? obj["rangePartitioned"].asBool()
+      : false;
 
   return std::make_shared<LocalMergeNode>(
       deserializePlanNodeId(obj),
       std::move(sortingKeys),
       std::move(sortingOrders),
-      std::move(sources));
+      std::move(sources),
+      rangePartitioned);
 }
 
 void TableWriteNode::addDetails(std::stringstream& /*unused*/) const {}
@@ -2160,6 +2166,9 @@ PlanNodePtr OrderByNode::create(const folly::dynamic& obj, void* context) {
 
 void MarkDistinctNode::addDetails(std::stringstream& stream) const {
   addFields(stream, distinctKeys_);
+  if (preGrouped_) {
+    stream << " pre-grouped";
+  }
 }
 
 void PlanNode::toString(
@@ -912,7 +912,7 @@ class GroupIdNode : public PlanNode {
     return aggregationInputs_;
   }
 
-  const std::string& groupIdName() {
+  const std::string& groupIdName() const {
     return groupIdName_;
   }
 
@@ -1011,17 +1011,24 @@ class MergeExchangeNode : public ExchangeNode {
   const std::vector<SortOrder> sortingOrders_;
 };
 
+/// Merges the sorted outputs of its sources into a single sorted stream. If
+/// 'rangePartitioned' is true, the sources produce disjoint key ranges in
+/// increasing order of their driver ids, e.g. when they sort the partitions of
+/// a range partitioned local exchange. The merge then returns the sources one
+/// after the other instead of comparing rows.
 class LocalMergeNode : public PlanNode {
  public:
   LocalMergeNode(
       const PlanNodeId& id,
       std::vector<FieldAccessTypedExprPtr> sortingKeys,
       std::vector<SortOrder> sortingOrders,
-      std::vector<PlanNodePtr> sources)
+      std::vector<PlanNodePtr> sources,
+      bool rangePartitioned = false)
       : PlanNode(id),
         sources_{std::move(sources)},
         sortingKeys_{std::move(sortingKeys)},
-        sortingOrders_{std::move(sortingOrders)} {}
+        sortingOrders_{std::move(sortingOrders)},
+        rangePartitioned_{rangePartitioned} {}
 
   const RowTypePtr& outputType() const override {
     return sources_[0]->outputType();
@@ -1039,6 +1046,10 @@ class LocalMergeNode : public PlanNode {
     return sortingOrders_;
   }
 
+  bool rangePartitioned() const {
+    return rangePartitioned_;
+  }
+
   std::string_view name() const override {
     return "LocalMerge";
   }
@@ -1053,6 +1064,7 @@ class LocalMergeNode : public PlanNode {
   const std::vector<PlanNodePtr> sources_;
   const std::vector<FieldAccessTypedExprPtr> sortingKeys_;
   const std::vector<SortOrder> sortingOrders_;
+  const bool rangePartitioned_;
 };
 
 /// Calculates partition number for each row of the specified vector.
@@ -1709,6 +1721,13 @@ class NestedLoopJoinNode : public PlanNode {
     return joinType_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: right and full joins track the matched rows of each build vector
+    // across all the probe drivers, which requires the build side in memory.
+    return !isRightJoin(joinType_) && !isFullJoin(joinType_) &&
+        queryConfig.joinSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1821,6 +1840,10 @@ class TopNNode : public PlanNode {
     return isPartial_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopN";
   }
@@ -2259,11 +2282,15 @@ class RowNumberNode : public PlanNode {
 /// column.
 class MarkDistinctNode : public PlanNode {
  public:
+  /// @param preGrouped True if input rows with equal 'distinctKeys' are
+  /// adjacent, e.g. the input is sorted on 'distinctKeys'. The first row of
+  /// each run of equal keys is then marked without a hash table.
   MarkDistinctNode(
       PlanNodeId id,
       std::string markerName,
       std::vector<FieldAccessTypedExprPtr> distinctKeys,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      bool preGrouped = false);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -2286,6 +2313,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool isPreGrouped() const {
+    return preGrouped_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2300,6 +2331,8 @@ class MarkDistinctNode : public PlanNode {
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
+
+  const bool preGrouped_;
 };
 
 /// Optimized version of a WindowNode for a single row_number function with a
@@ -48,18 +48,21 @@ class QueryConfig {
 
   explicit QueryConfig(std::unordered_map<std::string, std::string>&& values);
 
-#ifdef VELOX_ENABLE_BACKWARD_COMPATIBILITY
+  /// If true, trees of arithmetic and comparison calls over primitive columns
+  /// and constants are compiled into fused programs that are evaluated in one
+  /// pass without intermediate vectors. See exec::FusedExpr.
   static constexpr const char* kCodegenEnabled = "codegen.enabled";
 
+  bool codegenEnabled() const {
+    return get<bool>(kCodegenEnabled, false);
+  }
+
+#ifdef VELOX_ENABLE_BACKWARD_COMPATIBILITY
   static constexpr const char* kCodegenConfigurationFilePath =
       "codegen.configuration_file_path";
 
   static constexpr const char* kCodegenLazyLoading = "codegen.lazy_loading";
 
-  bool codegenEnabled() const {
-    return get<bool>(kCodegenEnabled, false);
-  }
-
   std::string codegenConfigurationFilePath() const {
     return get<std::string>(kCodegenConfigurationFilePath, "");
   }
@@ -73,6 +76,33 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The priority class of the query in memory arbitration: "low", "normal"
+  /// or "high". Under memory pressure, the arbitrator spills and aborts lower
+  /// priority queries first.
+  static constexpr const char* kQueryPriority = "query_priority";
+
+  /// If true, a driver that needs to reserve memory before adding input to an
+  /// operator, and whose query lacks the free capacity for it, goes off thread
+  /// while the memory arbitration for the reservation runs on a separate
+  /// executor, see velox_memory_reservation_threads. The driver thread then
+  /// runs the drivers of other queries in the meantime.
+  static constexpr const char* kAsyncMemoryReservationEnabled =
+      "async_memory_reservation_enabled";
+
+  /// If true, the number of active drivers of a pipeline that reads splits of
+  /// a table scan adapts while the task runs. Drivers are parked between
+  /// splits when the pipeline is blocked more on its consumer than on its
+  /// input, and activated again when splits are queued and the consumer keeps
+  /// up. The task still creates all the drivers up front, so the number of
+  /// drivers of a pipeline is the upper bound.
+  static constexpr const char* kAdaptiveDriverCountEnabled =
+      "adaptive_driver_count_enabled";
+
+  /// The minimum time between two changes of the number of active drivers of
+  /// a pipeline if kAdaptiveDriverCountEnabled is true.
+  static constexpr const char* kAdaptiveDriverCountIntervalMs =
+      "adaptive_driver_count_interval_ms";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -106,6 +136,14 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count cycles, instructions, last level cache misses and
+  /// branch misses of the addInput and getOutput calls of operators with the
+  /// hardware counters of the driver threads. False by default. Requires
+  /// Linux and a perf_event_paranoid setting that allows it. Each counted
+  /// call reads the counters twice.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -130,6 +168,26 @@ class QueryConfig {
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// If true, PartitionedOutput serializes rows in the CompactRow format and
+  /// Exchange and MergeExchange read pages in that format instead of the
+  /// default serde. Must be the same for the producers and consumers of an
+  /// exchange.
+  static constexpr const char* kExchangeCompactRow = "exchange.compact_row";
+
+  /// If true, PartitionedOutput enqueues in-process pages that keep the rows
+  /// of each destination as a vector instead of serializing them. Exchange
+  /// returns these vectors as is when the pages are fetched from the same
+  /// process by InProcessExchangeSource. They are serialized for consumers in
+  /// other processes. Ignored if exchange.compact_row is set.
+  static constexpr const char* kExchangeVectorPages = "exchange.vector_pages";
+
+  /// Maximum CPU time in nanoseconds that PartitionedOutput spends compressing
+  /// per byte saved by the compression, sampled over recent pages of each
+  /// destination. Compression is skipped for a destination while it costs more.
+  /// 0 means no limit. Applies only if the exchange compression is enabled.
+  static constexpr const char* kExchangeCompressionMaxNanosPerSavedByte =
+      "exchange.compression_max_nanos_per_saved_byte";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -142,20 +200,94 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If non-zero, a partial aggregation that would otherwise be abandoned for
+  /// not reducing enough switches to a streaming mode instead: it keeps
+  /// aggregating into a hash table capped at this many bytes, small enough to
+  /// stay in cache, and flushes the groups whenever the cap is reached. Hot
+  /// keys still get combined while the long tail passes through at roughly
+  /// one output row per input row. The operator abandons partial aggregation
+  /// for good if the streaming mode flushes more than 90% of its input rows
+  /// as groups.
+  static constexpr const char* kStreamingPartialAggregationMemory =
+      "streaming_partial_aggregation_memory";
+
+  /// If true and the process has a SplitResultCache, a partial aggregation fed
+  /// by a TableScan through deterministic filters and projections flushes its
+  /// groups at the end of each split and caches them per split. A later run of
+  /// the same plan replays the cached groups of the splits of unchanged files
+  /// instead of reading these.
+  static constexpr const char* kSplitResultCacheEnabled =
+      "split_result_cache_enabled";
+
+  /// If non-zero, a grouping aggregation with at least this many fixed-width
+  /// aggregates keeps their accumulators in one dense array per aggregate,
+  /// indexed by group number, instead of inline in the group rows. An
+  /// aggregate then updates a compact array rather than one field of many
+  /// wide rows. Not used with spilling, distinct or sorted aggregates.
+  static constexpr const char* kColumnarAccumulatorsMinAggregates =
+      "columnar_accumulators_min_aggregates";
+
+  /// If true, the Drivers of a final or single hash aggregation insert into
+  /// one hash table split into partitions by the grouping keys, each with its
+  /// own lock, and output disjoint sets of partitions at the end. The plan
+  /// then needs no local exchange to give each Driver a disjoint set of
+  /// groups. Not used with spilling, global or distinct aggregations,
+  /// pre-grouped keys, grouping sets, or aggregates over distinct or sorted
+  /// inputs or with lambda arguments.
+  static constexpr const char* kConcurrentAggregationEnabled =
+      "concurrent_aggregation_enabled";
+
+  /// If non-zero, a final or single hash aggregation compares the number of
+  /// groups to the number of input rows after this many input batches. If at
+  /// least half of the rows were new groups, the hash table grows 4x instead
+  /// of 2x each time it fills up, which halves the number of rehashes of a
+  /// high cardinality aggregation at the price of a sparser table.
+  static constexpr const char* kHashTableGrowthEstimationBatches =
+      "hash_table_growth_estimation_batches";
+
+  /// If true, a GroupId followed by an aggregation over its output in the
+  /// same pipeline aggregates the input once by all the grouping keys and
+  /// derives each grouping set from these groups, instead of aggregating
+  /// each input row once per grouping set. Not used with spilling, masks,
+  /// distinct or sorted aggregates.
+  static constexpr const char* kAggregationRollupEnabled =
+      "aggregation_rollup_enabled";
+
+  /// If true, TopN publishes the first sorting key of its current K-th row as
+  /// a dynamic filter to the table scan of its pipeline once it holds K rows.
+  /// The scan then skips rows, row groups and stripes that cannot be in the
+  /// result. Applies to integer, date and timestamp keys.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
   static constexpr const char* kAbandonPartialTopNRowNumberMinPct =
       "abandon_partial_topn_row_number_min_pct";
 
+  /// Maximum memory in bytes of a partial TopNRowNumber. When it is exceeded,
+  /// the operator emits the rows of all its partitions and clears them before
+  /// taking more input. 0 disables flushing.
+  static constexpr const char* kMaxPartialTopNRowNumberMemory =
+      "max_partial_topn_row_number_memory";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If true, PartitionedOutput serializes pages made of the rows of a single
+  /// input batch with the dictionary and constant encodings of the batch when
+  /// that is estimated to be smaller than the flat form.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
-  /// known. Otherwise kPreferredOutputBatchRows is used.
+  /// known. Otherwise kPreferredOutputBatchRows is used. Joins, unnest and
+  /// streaming aggregation estimate the average row size from the rows they
+  /// have returned so far.
   static constexpr const char* kPreferredOutputBatchBytes =
       "preferred_output_batch_bytes";
 
@@ -204,6 +336,14 @@ class QueryConfig {
   /// Window spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
 
+  /// If true, the Window operator streams the rows of partitions restored
+  /// from spill through window functions that only read the rows of bounded
+  /// frames, e.g. row_number, rank, lag/lead with constant offsets or
+  /// aggregates over k PRECEDING/FOLLOWING ROWS frames, instead of loading
+  /// each partition fully in memory.
+  static constexpr const char* kWindowSpillStreamPartitions =
+      "window_spill_stream_partitions";
+
   /// If true, the memory arbitrator will reclaim memory from table writer by
   /// flushing its buffered data to disk.
   static constexpr const char* kWriterSpillEnabled = "writer_spill_enabled";
@@ -212,6 +352,9 @@ class QueryConfig {
   static constexpr const char* kRowNumberSpillEnabled =
       "row_number_spill_enabled";
 
+  /// TopN spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNSpillEnabled = "topn_spill_enabled";
+
   /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
@@ -244,6 +387,13 @@ class QueryConfig {
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// The compression codec used to compress the vectors retained by an
+  /// operator in memory when its memory is reclaimed. A reclaim first
+  /// compresses the retained vectors and spills only once they are all
+  /// compressed. 'none' disables the compression step.
+  static constexpr const char* kRetainedVectorCompressionKind =
+      "retained_vector_compression_codec";
+
   /// Specifies spill write buffer size in bytes. The spiller tries to buffer
   /// serialized spill data up to the specified size before write to storage
   /// underneath for io efficiency. If it is set to zero, then spill write
@@ -262,6 +412,18 @@ class QueryConfig {
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// If true, sorted spill runs are written with the sort key columns and the
+  /// other columns of each batch in separate, separately compressed streams.
+  /// The merge on restore then reads the sort keys first and only
+  /// deserializes the other columns of a batch when these are accessed.
+  static constexpr const char* kSpillColumnarFormat = "spill_columnar_format";
+
+  /// The minimum free space in bytes of the local spill file system. If the
+  /// task has a remote spill directory, new spill files are created there once
+  /// the local free space drops below this value.
+  static constexpr const char* kSpillLocalMinFreeBytes =
+      "spill_local_min_free_bytes";
+
   /// Default offset spill start partition bit.
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
@@ -316,6 +478,20 @@ class QueryConfig {
   static constexpr const char* kTaskPartitionedWriterCount =
       "task_partitioned_writer_count";
 
+  /// If true, a round-robin local exchange feeding table writers sends its
+  /// data to one table writer at first and adds another whenever the exchange
+  /// buffer is at least half full, i.e. the writers do not keep up with the
+  /// input, and each active writer has been sent at least
+  /// 'scale_writers_min_processed_bytes' on average. Small inserts then write
+  /// few well-sized files while large ones use up to 'task_writer_count'
+  /// writers.
+  static constexpr const char* kScaleWriters = "scale_writers";
+
+  /// The minimum average number of bytes sent to each active table writer
+  /// before another one is added. Used when 'scale_writers' is true.
+  static constexpr const char* kScaleWritersMinProcessedBytes =
+      "scale_writers_min_processed_bytes";
+
   /// If true, finish the hash probe on an empty build table for a specific set
   /// of hash joins.
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
@@ -326,6 +502,65 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The max size in bytes of a Bloom filter built from an integer join key
+  /// for push down into the probe side TableScan. Bloom filters are used for
+  /// join keys with too many distinct values for an exact IN-list filter. 0
+  /// disables Bloom filter push down.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// The target size in bytes of the partitions of a hash join table probed
+  /// one at a time. HashProbe groups the probe rows of each batch by the
+  /// partition of the table they hash to so that a partition stays in cache
+  /// while it is probed. Applies to tables that are not in array mode. 0
+  /// disables radix-partitioned probing.
+  static constexpr const char* kHashProbeRadixPartitionSize =
+      "hash_probe_radix_partition_size";
+
+  /// Comma separated ids of the hash join plan nodes whose build side is
+  /// broadcast, i.e. every Task of the query receives the same build rows.
+  /// The Tasks of the query on a worker build the table of such a join once
+  /// and probe it read-only. Does not apply to joins that spill or need the
+  /// build side rows not matched by the probe side.
+  static constexpr const char* kSharedHashJoinBuildNodeIds =
+      "shared_hash_join_build_node_ids";
+
+  /// If true, HashProbe returns the build side columns of the join output as
+  /// lazy vectors that are extracted from the hash table only when loaded,
+  /// and only for the rows that are loaded. Benefits joins followed by
+  /// selective filters. Does not apply when spilling is enabled.
+  static constexpr const char* kHashProbeLazyBuildColumns =
+      "hash_probe_lazy_build_columns";
+
+  /// The number of probes that hash join and aggregation tables interleave
+  /// when the keys are hashed (kHash mode). The buckets and then the first
+  /// candidate rows of all probes of a group are prefetched before any keys
+  /// are compared. 0 keeps the default interleaving of 4 probes. At most 64.
+  static constexpr const char* kHashTablePrefetchGroupSize =
+      "hash_table_prefetch_group_size";
+
+  /// The maximum number of rows of a hash join build side with a single
+  /// integer key and no duplicate keys for which a perfect hash index over the
+  /// keys is built. The probe then finds each key with a single lookup. Does
+  /// not apply to tables in array mode. 0 disables the perfect hash index.
+  static constexpr const char* kHashJoinPerfectHashMaxRows =
+      "hash_join_perfect_hash_max_rows";
+
+  /// The number of counters of the sketch of the most frequent join keys that
+  /// each HashBuild keeps. The join reports the number of keys with at least
+  /// 1% of the build rows and the share of the most frequent key as the
+  /// heavyHitterKeys and topKeyRowsPct runtime stats. 0 disables the sketch.
+  static constexpr const char* kHashBuildHeavyHitterSketchSize =
+      "hash_build_heavy_hitter_sketch_size";
+
+  /// If true, a nested loop join whose condition compares a build side column
+  /// with probe side columns, e.g. 'p.ts BETWEEN b.start AND b.end', sorts
+  /// each build vector on such a column. Each probe row is then only compared
+  /// with the build rows in the range that can satisfy the comparisons,
+  /// instead of with every build row.
+  static constexpr const char* kNestedLoopJoinRangeLookupEnabled =
+      "nested_loop_join_range_lookup_enabled";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -334,6 +569,22 @@ class QueryConfig {
   static constexpr const char* kValidateOutputFromOperators =
       "debug.validate_output_from_operators";
 
+  /// If true, the tasks of the query save the input of the plan nodes in
+  /// kQueryTraceNodeIds, with the plan fragment below each node and the query
+  /// config, so that the node can be replayed without the data of the query.
+  static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
+
+  /// Directory of the traces. Each task writes to
+  /// '<dir>/<queryId>/<taskId>/<planNodeId>'.
+  static constexpr const char* kQueryTraceDir = "query_trace_dir";
+
+  /// Comma separated ids of the plan nodes to trace.
+  static constexpr const char* kQueryTraceNodeIds = "query_trace_node_ids";
+
+  /// Maximum bytes of input that a task saves. Input after the limit is not
+  /// saved.
+  static constexpr const char* kQueryTraceMaxBytes = "query_trace_max_bytes";
+
   /// If true, enable caches in expression evaluation for performance, including
   /// ExecCtx::vectorPool_, ExecCtx::decodedVectorPool_,
   /// ExecCtx::selectivityVectorPool_, Expr::baseDictionary_,
@@ -342,6 +593,28 @@ class QueryConfig {
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
 
+  /// If true, results of deterministic expressions over the bases of
+  /// dictionary encoded inputs are memoized in a memo shared by all drivers
+  /// of the query, see exec::SharedExprMemo. Requires
+  /// kEnableExpressionEvaluationCache.
+  static constexpr const char* kExprSharedMemoEnabled =
+      "expression.shared_memo_enabled";
+
+  /// If true, the operators of a driver recycle vectors through one vector
+  /// pool instead of one pool per operator, so that a vector released by one
+  /// operator can be reused by another. New vectors of the shared pool are
+  /// allocated from the memory pool of the first operator that uses it.
+  /// Requires kEnableExpressionEvaluationCache.
+  static constexpr const char* kSharedDriverVectorPool =
+      "shared_driver_vector_pool";
+
+  /// If true, the string buffers allocated while evaluating an ExprSet are
+  /// carved from chunks of a per-thread arena that is rewound at the start
+  /// of each batch, so that the memory pool is called once per chunk instead
+  /// of once per buffer.
+  static constexpr const char* kExprEvalArenaEnabled =
+      "expression.eval_arena_enabled";
+
   // For a given shared subexpression, the maximum distinct sets of inputs we
   // cache results for. Lambdas can call the same expression with different
   // inputs many times, causing the results we cache to explode in size. Putting
@@ -353,17 +626,76 @@ class QueryConfig {
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum number of bytes of the first stripe or row group that the splits
+  /// preloaded for a driver may read ahead, divided evenly between the
+  /// preloaded splits. Set to 0 to only open the files of preloaded splits.
+  static constexpr const char* kMaxSplitPreloadBytesPerDriver =
+      "max_split_preload_bytes_per_driver";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If true, the tasks record when their drivers run, are queued, are
+  /// blocked and call operators, see exec::DriverTimeline.
+  static constexpr const char* kDriverTimelineEnabled =
+      "driver_timeline_enabled";
+
+  /// Maximum number of bytes of normalized sort keys per row in prefix sort,
+  /// used by order by and its spilling, and in the rows compared by merges.
+  /// Prefix sort and normalized merge keys are disabled if this is 0.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// Minimum number of rows to use prefix sort. Fewer rows are sorted with
+  /// std::sort.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
+  /// Number of leading bytes of a string sort key that prefix sort normalizes.
+  /// Rows with equal prefixes are compared on the full strings. String keys
+  /// are not normalized if this is 0.
+  static constexpr const char* kPrefixSortMaxStringPrefixLength =
+      "prefixsort_max_string_prefix_length";
+
+  /// Minimum number of rows for prefix sort to sort the normalized keys with a
+  /// radix sort instead of a quick sort. Radix sort is not used if this is 0.
+  static constexpr const char* kPrefixSortRadixSortMinRows =
+      "prefixsort_radix_sort_min_rows";
+
+  /// Maximum number of bytes of normalized keys per row for prefix sort to
+  /// sort them with a radix sort.
+  static constexpr const char* kPrefixSortRadixSortMaxKeyBytes =
+      "prefixsort_radix_sort_max_key_bytes";
+
+  /// If true, order by stores the string columns that are not sort keys
+  /// compressed with a symbol table built from its first input, if the table
+  /// compresses that input well.
+  static constexpr const char* kOrderByStringCompression =
+      "order_by_string_compression";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
   }
 
+  std::string queryPriority() const {
+    return get<std::string>(kQueryPriority, "normal");
+  }
+
+  bool asyncMemoryReservationEnabled() const {
+    return get<bool>(kAsyncMemoryReservationEnabled, false);
+  }
+
+  bool adaptiveDriverCountEnabled() const {
+    return get<bool>(kAdaptiveDriverCountEnabled, false);
+  }
+
+  uint64_t adaptiveDriverCountIntervalMs() const {
+    return get<uint64_t>(kAdaptiveDriverCountIntervalMs, 100);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -382,6 +714,34 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  uint64_t streamingPartialAggregationMemory() const {
+    return get<uint64_t>(kStreamingPartialAggregationMemory, 0);
+  }
+
+  bool splitResultCacheEnabled() const {
+    return get<bool>(kSplitResultCacheEnabled, false);
+  }
+
+  int32_t columnarAccumulatorsMinAggregates() const {
+    return get<int32_t>(kColumnarAccumulatorsMinAggregates, 0);
+  }
+
+  bool concurrentAggregationEnabled() const {
+    return get<bool>(kConcurrentAggregationEnabled, false);
+  }
+
+  int32_t hashTableGrowthEstimationBatches() const {
+    return get<int32_t>(kHashTableGrowthEstimationBatches, 0);
+  }
+
+  bool aggregationRollupEnabled() const {
+    return get<bool>(kAggregationRollupEnabled, true);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, true);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -390,6 +750,11 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinPct, 80);
   }
 
+  uint64_t maxPartialTopNRowNumberMemory() const {
+    static constexpr uint64_t kDefault = 1L << 24;
+    return get<uint64_t>(kMaxPartialTopNRowNumberMemory, kDefault);
+  }
+
   uint64_t maxSpillRunRows() const {
     static constexpr uint64_t kDefault = 12UL << 20;
     return get<uint64_t>(kMaxSpillRunRows, kDefault);
@@ -411,6 +776,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
   /// Returns the maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -436,6 +805,18 @@ class QueryConfig {
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  bool exchangeCompactRow() const {
+    return get<bool>(kExchangeCompactRow, false);
+  }
+
+  bool exchangeVectorPages() const {
+    return get<bool>(kExchangeVectorPages, false);
+  }
+
+  double exchangeCompressionMaxNanosPerSavedByte() const {
+    return get<double>(kExchangeCompressionMaxNanosPerSavedByte, 0);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -514,12 +895,20 @@ class QueryConfig {
     return get<bool>(kOrderBySpillEnabled, true);
   }
 
+  bool orderByStringCompression() const {
+    return get<bool>(kOrderByStringCompression, false);
+  }
+
   /// Returns true if spilling is enabled for Window operator. Must also
   /// check the spillEnabled()!
   bool windowSpillEnabled() const {
     return get<bool>(kWindowSpillEnabled, true);
   }
 
+  bool windowSpillStreamPartitions() const {
+    return get<bool>(kWindowSpillStreamPartitions, false);
+  }
+
   /// Returns 'is writer spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool writerSpillEnabled() const {
@@ -532,6 +921,12 @@ class QueryConfig {
     return get<bool>(kRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for TopN operator. Must also check
+  /// the spillEnabled()!
+  bool topNSpillEnabled() const {
+    return get<bool>(kTopNSpillEnabled, true);
+  }
+
   /// Returns true if spilling is enabled for TopNRowNumber operator. Must also
   /// check the spillEnabled()!
   bool topNRowNumberSpillEnabled() const {
@@ -588,6 +983,10 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  std::string retainedVectorCompressionKind() const {
+    return get<std::string>(kRetainedVectorCompressionKind, "none");
+  }
+
   uint64_t spillWriteBufferSize() const {
     // The default write buffer size set to 1MB.
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
@@ -602,6 +1001,15 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  bool spillColumnarFormat() const {
+    return get<bool>(kSpillColumnarFormat, false);
+  }
+
+  uint64_t spillLocalMinFreeBytes() const {
+    static constexpr uint64_t kDefault = 1L << 30;
+    return get<uint64_t>(kSpillLocalMinFreeBytes, kDefault);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -671,6 +1079,10 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -680,6 +1092,14 @@ class QueryConfig {
         .value_or(taskWriterCount());
   }
 
+  bool scaleWriters() const {
+    return get<bool>(kScaleWriters, false);
+  }
+
+  uint64_t scaleWritersMinProcessedBytes() const {
+    return get<uint64_t>(kScaleWritersMinProcessedBytes, 32UL << 20);
+  }
+
   bool hashProbeFinishEarlyOnEmptyBuild() const {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
@@ -688,14 +1108,74 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  uint64_t hashProbeRadixPartitionSize() const {
+    return get<uint64_t>(kHashProbeRadixPartitionSize, 0);
+  }
+
+  std::string sharedHashJoinBuildNodeIds() const {
+    return get<std::string>(kSharedHashJoinBuildNodeIds, "");
+  }
+
+  bool hashProbeLazyBuildColumns() const {
+    return get<bool>(kHashProbeLazyBuildColumns, false);
+  }
+
+  int32_t hashTablePrefetchGroupSize() const {
+    return get<int32_t>(kHashTablePrefetchGroupSize, 0);
+  }
+
+  uint64_t hashJoinPerfectHashMaxRows() const {
+    return get<uint64_t>(kHashJoinPerfectHashMaxRows, 0);
+  }
+
+  int32_t hashBuildHeavyHitterSketchSize() const {
+    return get<int32_t>(kHashBuildHeavyHitterSketchSize, 0);
+  }
+
+  bool nestedLoopJoinRangeLookupEnabled() const {
+    return get<bool>(kNestedLoopJoinRangeLookupEnabled, true);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
 
+  bool queryTraceEnabled() const {
+    return get<bool>(kQueryTraceEnabled, false);
+  }
+
+  std::string queryTraceDir() const {
+    return get<std::string>(kQueryTraceDir, "");
+  }
+
+  std::string queryTraceNodeIds() const {
+    return get<std::string>(kQueryTraceNodeIds, "");
+  }
+
+  uint64_t queryTraceMaxBytes() const {
+    return get<uint64_t>(kQueryTraceMaxBytes, 1UL << 30);
+  }
+
   bool isExpressionEvaluationCacheEnabled() const {
     return get<bool>(kEnableExpressionEvaluationCache, true);
   }
 
+  bool exprSharedMemoEnabled() const {
+    return get<bool>(kExprSharedMemoEnabled, false);
+  }
+
+  bool sharedDriverVectorPool() const {
+    return get<bool>(kSharedDriverVectorPool, false);
+  }
+
+  bool exprEvalArenaEnabled() const {
+    return get<bool>(kExprEvalArenaEnabled, false);
+  }
+
   uint32_t maxSharedSubexprResultsCached() const {
     // 10 was chosen as a default as there are cases where a shared
     // subexpression can be called in 2 different places and a particular
@@ -716,10 +1196,39 @@ class QueryConfig {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  uint64_t maxSplitPreloadBytesPerDriver() const {
+    static constexpr uint64_t kDefault = 64UL << 20;
+    return get<uint64_t>(kMaxSplitPreloadBytesPerDriver, kDefault);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  bool driverTimelineEnabled() const {
+    return get<bool>(kDriverTimelineEnabled, false);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
+  uint32_t prefixSortMaxStringPrefixLength() const {
+    return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
+  }
+
+  uint32_t prefixSortRadixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortRadixSortMinRows, 1024);
+  }
+
+  uint32_t prefixSortRadixSortMaxKeyBytes() const {
+    return get<uint32_t>(kPrefixSortRadixSortMaxKeyBytes, 32);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -729,6 +1238,11 @@ class QueryConfig {
     return std::optional<T>(config_->get<T>(key));
   }
 
+  /// Returns all the properties set for the query.
+  const std::unordered_map<std::string, std::string>& rawConfigs() const {
+    return config_->values();
+  }
+
   /// Test-only method to override the current query config properties.
   /// It is not thread safe.
   void testingOverrideConfigUnsafe(
@@ -54,7 +54,9 @@ QueryCtx::QueryCtx(
       cache_(cache),
       connectorSessionProperties_(connectorSessionProperties),
       pool_(std::move(pool)),
-      queryConfig_{std::move(queryConfig)} {
+      queryConfig_{std::move(queryConfig)},
+      priority_(
+          memory::arbitrationPriorityFromName(queryConfig_.queryPriority())) {
   initPool(queryId);
 }
 
@@ -65,6 +67,15 @@ QueryCtx::QueryCtx(
   return fmt::format("query.{}.{}", queryId.c_str(), seqNum++);
 }
 
+std::shared_ptr<exec::SharedExprMemo> QueryCtx::sharedExprMemo(
+    const std::function<std::shared_ptr<exec::SharedExprMemo>()>& make) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (sharedExprMemo_ == nullptr) {
+    sharedExprMemo_ = make();
+  }
+  return sharedExprMemo_;
+}
+
 void QueryCtx::maybeSetReclaimer() {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK(!underArbitration_);
@@ -108,6 +119,14 @@ uint64_t QueryCtx::MemoryReclaimer::reclaim(
   return memory::MemoryReclaimer::reclaim(pool, targetBytes, maxWaitMs, stats);
 }
 
+memory::ArbitrationPriority QueryCtx::MemoryReclaimer::priority() const {
+  auto queryCtx = ensureQueryCtx();
+  if (queryCtx == nullptr) {
+    return memory::ArbitrationPriority::kNormal;
+  }
+  return queryCtx->priority();
+}
+
 bool QueryCtx::checkUnderArbitration(ContinueFuture* future) {
   VELOX_CHECK_NOT_NULL(future);
   std::lock_guard<std::mutex> l(mutex_);
@@ -18,12 +18,17 @@
 
 #include <folly/Executor.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/buffer/BufferArena.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
 
+namespace facebook::velox::exec {
+class SharedExprMemo;
+}
+
 namespace facebook::velox::core {
 
 class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
@@ -104,6 +109,12 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
     return queryId_;
   }
 
+  /// Returns the priority class of this query in memory arbitration as set
+  /// by QueryConfig::kQueryPriority when this was created.
+  memory::ArbitrationPriority priority() const {
+    return priority_;
+  }
+
   /// Checks if the associated query is under memory arbitration or not. The
   /// function returns true if it is and set future which is fulfilled when the
   /// the memory arbiration finishes.
@@ -113,6 +124,22 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Adds 'nanos' to the CPU time the Drivers of this query have used on a
+  /// DriverScheduler, which shares its threads between queries by this time.
+  void addDriverCpuTimeNanos(uint64_t nanos) {
+    driverCpuTimeNanos_ += nanos;
+  }
+
+  uint64_t driverCpuTimeNanos() const {
+    return driverCpuTimeNanos_;
+  }
+
+  /// Returns the memo of expression results shared by the drivers of this
+  /// query, see exec::SharedExprMemo. Calls 'make' to create it on first use.
+  /// The memo and the vectors it references are freed with this.
+  std::shared_ptr<exec::SharedExprMemo> sharedExprMemo(
+      const std::function<std::shared_ptr<exec::SharedExprMemo>()>& make);
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -154,6 +181,8 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
         uint64_t maxWaitMs,
         memory::MemoryReclaimer::Stats& stats) override;
 
+    memory::ArbitrationPriority priority() const override;
+
    protected:
     MemoryReclaimer(
         const std::shared_ptr<QueryCtx>& queryCtx,
@@ -204,8 +233,12 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   std::unordered_map<std::string, std::shared_ptr<Config>>
       connectorSessionProperties_;
   std::shared_ptr<memory::MemoryPool> pool_;
+  // Allocates from a child of 'pool_', so is declared after it.
+  std::shared_ptr<exec::SharedExprMemo> sharedExprMemo_;
   QueryConfig queryConfig_;
+  const memory::ArbitrationPriority priority_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  std::atomic<uint64_t> driverCpuTimeNanos_{0};
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
@@ -216,15 +249,29 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
 // Represents the state of one thread of query execution.
 class ExecCtx {
  public:
-  ExecCtx(memory::MemoryPool* pool, QueryCtx* queryCtx)
+  /// If 'sharedVectorPool' is set, vectors are recycled through it instead of
+  /// a pool owned by 'this'. 'sharedVectorPool' must outlive 'this'.
+  ExecCtx(
+      memory::MemoryPool* pool,
+      QueryCtx* queryCtx,
+      VectorPool* sharedVectorPool = nullptr)
       : pool_(pool),
         queryCtx_(queryCtx),
         exprEvalCacheEnabled_(
             !queryCtx ||
             queryCtx->queryConfig().isExpressionEvaluationCacheEnabled()),
+        ownedVectorPool_(
+            exprEvalCacheEnabled_ && sharedVectorPool == nullptr
+                ? std::make_unique<VectorPool>(pool)
+                : nullptr),
         vectorPool_(
-            exprEvalCacheEnabled_ ? std::make_unique<VectorPool>(pool)
-                                  : nullptr) {}
+            exprEvalCacheEnabled_
+                ? (sharedVectorPool ? sharedVectorPool : ownedVectorPool_.get())
+                : nullptr),
+        bufferArena_(
+            queryCtx && queryCtx->queryConfig().exprEvalArenaEnabled()
+                ? std::make_unique<BufferArena>(pool)
+                : nullptr) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -293,7 +340,12 @@ class ExecCtx {
   }
 
   VectorPool* vectorPool() {
-    return vectorPool_.get();
+    return vectorPool_;
+  }
+
+  /// True if vectors are recycled through a pool shared with other ExecCtxs.
+  bool hasSharedVectorPool() const {
+    return vectorPool_ != nullptr && ownedVectorPool_ == nullptr;
   }
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
@@ -328,6 +380,12 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns the arena for the string buffers of expression evaluation or
+  /// nullptr if QueryConfig::exprEvalArenaEnabled() is false.
+  BufferArena* bufferArena() const {
+    return bufferArena_.get();
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -339,7 +397,11 @@ class ExecCtx {
   // A pool of preallocated SelectivityVectors for use by expressions
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
-  std::unique_ptr<VectorPool> vectorPool_;
+  std::unique_ptr<VectorPool> ownedVectorPool_;
+  // Either 'ownedVectorPool_' or a pool shared with other ExecCtxs. Null if
+  // the expression evaluation cache is disabled.
+  VectorPool* const vectorPool_;
+  std::unique_ptr<BufferArena> bufferArena_;
 };
 
 } // namespace facebook::velox::core
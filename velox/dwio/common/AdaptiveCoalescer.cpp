@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptiveCoalescer.h"
+
+#include <folly/Synchronized.h>
+#include <algorithm>
+#include <typeinfo>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::dwio::common {
+
+// static
+AdaptiveCoalescer& AdaptiveCoalescer::instance(const ReadFile& file) {
+  static auto* coalescers = new folly::Synchronized<
+      std::unordered_map<std::string, std::unique_ptr<AdaptiveCoalescer>>>();
+  const std::string name = typeid(file).name();
+  return *coalescers->withWLock([&](auto& map) {
+    auto& coalescer = map[name];
+    if (coalescer == nullptr) {
+      coalescer = std::make_unique<AdaptiveCoalescer>(name);
+    }
+    return coalescer.get();
+  });
+}
+
+void AdaptiveCoalescer::recordRead(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+  weight_ = weight_ * kDecay + 1;
+  sumBytes_ = sumBytes_ * kDecay + x;
+  sumMicros_ = sumMicros_ * kDecay + y;
+  sumBytesSquared_ = sumBytesSquared_ * kDecay + x * x;
+  sumBytesMicros_ = sumBytesMicros_ * kDecay + x * y;
+}
+
+std::optional<AdaptiveCoalescer::Model> AdaptiveCoalescer::model() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return modelLocked();
+}
+
+std::optional<AdaptiveCoalescer::Model> AdaptiveCoalescer::modelLocked()
+    const {
+  if (numReads_ < kMinSamples) {
+    return std::nullopt;
+  }
+  const double meanBytes = sumBytes_ / weight_;
+  const double meanMicros = sumMicros_ / weight_;
+  const double bytesVariance =
+      sumBytesSquared_ / weight_ - meanBytes * meanBytes;
+  // The sizes must differ by more than a few % for the slope to be
+  // meaningful.
+  if (bytesVariance <= meanBytes * meanBytes * 0.001) {
+    return std::nullopt;
+  }
+  const double covariance = sumBytesMicros_ / weight_ - meanBytes * meanMicros;
+  const double microsPerByte = covariance / bytesVariance;
+  if (microsPerByte <= 0) {
+    return std::nullopt;
+  }
+  const double latency =
+      std::max(0.0, meanMicros - microsPerByte * meanBytes);
+  return Model{latency, 1 / microsPerByte};
+}
+
+AdaptiveCoalescer::Limits AdaptiveCoalescer::limits(
+    const Limits& defaults) const {
+  const auto fit = model();
+  if (!fit.has_value()) {
+    return defaults;
+  }
+  // The bytes that transfer in the time of one latency.
+  const double latencyBytes = fit->latencyMicros * fit->bytesPerMicro;
+  Limits limits;
+  limits.maxCoalesceDistance = static_cast<int32_t>(std::clamp<double>(
+      latencyBytes, kMinCoalesceDistance, kMaxCoalesceDistance));
+  limits.maxCoalesceBytes = static_cast<int64_t>(std::clamp<double>(
+      latencyBytes * kTransferToLatencyRatio,
+      std::min(kMinCoalesceBytes, defaults.maxCoalesceBytes),
+      defaults.maxCoalesceBytes));
+  return limits;
+}
+
+std::string AdaptiveCoalescer::toString() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto fit = modelLocked();
+  if (!fit.has_value()) {
+    return fmt::format(
+        "AdaptiveCoalescer {}: {} reads, no model", name_, numReads_);
+  }
+  return fmt::format(
+      "AdaptiveCoalescer {}: {} reads, latency {:.0f}us, {:.1f}MB/s",
+      name_,
+      numReads_,
+      fit->latencyMicros,
+      fit->bytesPerMicro);
+}
+
+} // namespace facebook::velox::dwio::common
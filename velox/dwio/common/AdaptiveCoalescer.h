@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace facebook::velox {
+class ReadFile;
+}
+
+namespace facebook::velox::dwio::common {
+
+/// Chooses how far apart reads may be to be coalesced into one and how large a
+/// coalesced read may get from the latency and bandwidth observed on a kind of
+/// storage. A read of 'n' bytes is modeled to take 'latency + n / bandwidth'.
+/// Coalescing two reads 'gap' bytes apart saves one 'latency' and costs
+/// 'gap / bandwidth', so reads are coalesced if 'gap' is under 'latency *
+/// bandwidth'. This is MBs for object stores and KBs for local SSDs, which
+/// fixed limits cannot both fit.
+class AdaptiveCoalescer {
+ public:
+  struct Limits {
+    int32_t maxCoalesceDistance;
+    int64_t maxCoalesceBytes;
+  };
+
+  /// Number of reads before limits() departs from its defaults.
+  static constexpr int32_t kMinSamples = 16;
+
+  /// Weight of the previous reads when a read is recorded, so that the model
+  /// follows changes of load on the storage.
+  static constexpr double kDecay = 0.99;
+
+  static constexpr int32_t kMinCoalesceDistance = 4 << 10;
+  static constexpr int32_t kMaxCoalesceDistance = 16 << 20;
+
+  /// A coalesced read may get long enough for its transfer to take this many
+  /// times the latency. Longer reads save little and serialize IO that could
+  /// run in parallel.
+  static constexpr int32_t kTransferToLatencyRatio = 8;
+  static constexpr int64_t kMinCoalesceBytes = 1 << 20;
+
+  /// Returns the coalescer for the storage of 'file'. Storages are told apart
+  /// by the type of ReadFile, e.g. local, S3 or HDFS files.
+  static AdaptiveCoalescer& instance(const ReadFile& file);
+
+  explicit AdaptiveCoalescer(std::string name) : name_(std::move(name)) {}
+
+  /// Records a read of 'bytes' from storage that took 'micros'.
+  void recordRead(uint64_t bytes, uint64_t micros);
+
+  /// Returns the limits for the modeled latency and bandwidth, or 'defaults'
+  /// if there are too few reads or they do not fit the model. The coalesced
+  /// bytes are not raised over 'defaults'.
+  Limits limits(const Limits& defaults) const;
+
+  struct Model {
+    double latencyMicros;
+    double bytesPerMicro;
+  };
+
+  /// Returns the least squares fit of the recorded reads, or std::nullopt if
+  /// there are under kMinSamples reads, the reads are too close in size to
+  /// tell latency from bandwidth or larger reads are not slower.
+  std::optional<Model> model() const;
+
+  std::string toString() const;
+
+ private:
+  std::optional<Model> modelLocked() const;
+
+  const std::string name_;
+
+  mutable std::mutex mutex_;
+  int64_t numReads_{0};
+  // Sums of the reads, each read weighted by kDecay to the power of the
+  // number of later reads.
+  double weight_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytesSquared_{0};
+  double sumBytesMicros_{0};
+};
+
+} // namespace facebook::velox::dwio::common
@@ -141,6 +141,17 @@ class BufferedInput {
     return nullptr;
   }
 
+  /// True if the streams of 'this' should be decompressed on executor() ahead
+  /// of their use. See io::ReaderOptions::setDecompressAhead().
+  virtual bool decompressAhead() const {
+    return false;
+  }
+
+  /// Returns the IO statistics 'this' records into, if any.
+  virtual std::shared_ptr<IoStatistics> ioStatistics() const {
+    return nullptr;
+  }
+
   virtual uint64_t nextFetchSize() const;
 
  protected:
@@ -16,6 +16,9 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -231,9 +234,17 @@ void CacheInputStream::loadSync(const Region& region) {
 
     auto* entry = pin_.checkedEntry();
     if (!entry->isExclusive()) {
+      if (!bufferedInput_->cacheWarm() && entry->getAndClearWarmFlag()) {
+        RECORD_METRIC_VALUE(kMetricCacheWarmHitBytes, hitSize);
+      }
       if (!entry->getAndClearFirstUseFlag()) {
         // Hit memory cache.
         ioStats_->ramHit().increment(hitSize);
+        cache::cacheHeatMap().recordLoad(
+            groupId_, trackingId_, cache::CacheHeatMap::Source::kRam, hitSize);
+      } else {
+        cache::cacheHeatMap().recordPrefetchHit(
+            groupId_, trackingId_, hitSize);
       }
       return;
     }
@@ -242,7 +253,15 @@ void CacheInputStream::loadSync(const Region& region) {
     // missed, fall back to remote fetching.
     entry->setGroupId(groupId_);
     entry->setTrackingId(trackingId_);
+    if (bufferedInput_->cacheWarm()) {
+      entry->setWarm();
+    }
     if (loadFromSsd(region, *entry)) {
+      cache::cacheHeatMap().recordLoad(
+          groupId_,
+          trackingId_,
+          cache::CacheHeatMap::Source::kSsd,
+          region.length);
       return;
     }
     const auto ranges = makeRanges(entry, region.length);
@@ -251,8 +270,16 @@ void CacheInputStream::loadSync(const Region& region) {
       MicrosecondTimer timer(&storageReadUs);
       input_->read(ranges, region.offset, LogType::FILE);
     }
+    bufferedInput_->coalescer().recordRead(region.length, storageReadUs);
     ioStats_->read().increment(region.length);
     ioStats_->queryThreadIoLatency().increment(storageReadUs);
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricStorageReadLatencyMs, storageReadUs / 1'000);
+    cache::cacheHeatMap().recordLoad(
+        groupId_,
+        trackingId_,
+        cache::CacheHeatMap::Source::kStorage,
+        region.length);
     ioStats_->incTotalScanTime(storageReadUs * 1'000);
     entry->setExclusiveToShared(!noCacheRetention_);
   } while (pin_.empty());
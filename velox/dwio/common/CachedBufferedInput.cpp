@@ -15,8 +15,10 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -151,6 +153,26 @@ int32_t adjustedReadPct(const cache::TrackingData& trackingData) {
   }
   return (100 * trackingData.numReads) / (trackingData.numReferences - 1);
 }
+
+// Removes the requests that fit in 'budget' from 'requests' and returns them.
+// Deducts their size from 'budget'.
+std::vector<CacheRequest*> takePreloadRequests(
+    std::vector<CacheRequest*>& requests,
+    std::atomic<int64_t>& budget) {
+  std::vector<CacheRequest*> preloadRequests;
+  std::vector<CacheRequest*> otherRequests;
+  for (auto* request : requests) {
+    const int64_t size = request->size;
+    if (budget.fetch_sub(size) >= size) {
+      preloadRequests.push_back(request);
+    } else {
+      budget.fetch_add(size);
+      otherRequests.push_back(request);
+    }
+  }
+  requests = std::move(otherRequests);
+  return preloadRequests;
+}
 } // namespace
 
 void CachedBufferedInput::load(const LogType /*unused*/) {
@@ -165,6 +187,7 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
   // Extra requests made for pre-loadable regions that are larger than
   // 'loadQuantum'.
   std::vector<std::unique_ptr<CacheRequest>> extraRequests;
+  const auto& preloadBudget = options_.preloadBudget();
   // We loop over access frequency buckets. For example readPct 80 will get all
   // streams where 80% or more of the referenced data is actually loaded.
   for (const auto readPct : std::vector<int32_t>{80, 50, 20, 0}) {
@@ -205,6 +228,18 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
         }
       }
     }
+    if (!isPrefetchPct(readPct) && preloadBudget != nullptr &&
+        *preloadBudget > 0) {
+      // The split is being preloaded. Read the loads it can afford ahead
+      // instead of on first use.
+      auto preloads = takePreloadRequests(storageLoad, *preloadBudget);
+      if (ioStats_ != nullptr) {
+        for (const auto* request : preloads) {
+          ioStats_->splitPreload().increment(request->size);
+        }
+      }
+      makeLoads(std::move(preloads), true);
+    }
     makeLoads(std::move(storageLoad), isPrefetchPct(readPct));
     makeLoads(std::move(ssdLoad), isPrefetchPct(readPct));
   }
@@ -217,7 +252,16 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   const bool isSsd = !requests[0]->ssdPin.empty();
-  const int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  AdaptiveCoalescer::Limits limits{
+      options_.maxCoalesceDistance(), options_.maxCoalesceBytes()};
+  if (!isSsd && options_.adaptiveCoalesce()) {
+    limits = coalescer_->limits(limits);
+    if (ioStats_ != nullptr) {
+      ioStats_->adaptiveCoalesceDistance().increment(
+          limits.maxCoalesceDistance);
+    }
+  }
+  const int32_t maxDistance = isSsd ? 20000 : limits.maxCoalesceDistance;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -247,7 +291,7 @@ void CachedBufferedInput::makeLoads(
         return size;
       },
       [&](int32_t index) {
-        if (coalescedBytes > options_.maxCoalesceBytes()) {
+        if (coalescedBytes > limits.maxCoalesceBytes) {
           coalescedBytes = 0;
           return kNoCoalesce;
         }
@@ -263,7 +307,7 @@ void CachedBufferedInput::makeLoads(
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
         ++numNewLoads;
-        readRegion(ranges, prefetch);
+        readRegion(ranges, prefetch, limits.maxCoalesceDistance);
       });
 
   if (prefetch && (executor_ != nullptr)) {
@@ -298,11 +342,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
-      std::vector<CacheRequest*> requests)
+      std::vector<CacheRequest*> requests,
+      bool warm)
       : CoalescedLoad(makeKeys(requests), makeSizes(requests)),
         cache_(cache),
         ioStats_(std::move(ioStats)),
-        groupId_(groupId) {
+        groupId_(groupId),
+        warm_(warm) {
     requests_.reserve(requests.size());
     for (const auto& request : requests) {
       size_ += request->size;
@@ -350,6 +396,38 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
     }
   }
 
+  // Tags the entry of 'pin' with the group and column of the request at
+  // 'index' so that its uses and eviction are attributed in the heat map.
+  // Marks the entry as warm if 'this' warms the cache.
+  void setEntryIds(int32_t index, const CachePin& pin) {
+    auto* entry = pin.checkedEntry();
+    entry->setGroupId(groupId_);
+    entry->setTrackingId(requests_[index].trackingId);
+    if (warm_) {
+      entry->setWarm();
+    }
+  }
+
+  static void recordHeatMap(
+      const std::vector<CachePin>& pins,
+      bool prefetch,
+      bool ssd) {
+    auto& heatMap = cache::cacheHeatMap();
+    if (!heatMap.enabled()) {
+      return;
+    }
+    for (const auto& pin : pins) {
+      const auto* entry = pin.checkedEntry();
+      heatMap.recordLoad(
+          entry->groupId(),
+          entry->trackingId(),
+          ssd ? cache::CacheHeatMap::Source::kSsd
+              : cache::CacheHeatMap::Source::kStorage,
+          entry->size(),
+          prefetch);
+    }
+  }
+
   static std::vector<RawFileCacheKey> makeKeys(
       std::vector<CacheRequest*>& requests) {
     std::vector<RawFileCacheKey> keys;
@@ -373,6 +451,8 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   std::vector<CacheRequest> requests_;
   std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
+  // True if the load only warms the cache. See io::ReaderOptions::cacheWarm().
+  const bool warm_;
   int64_t size_{0};
 };
 
@@ -385,10 +465,18 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
+      int32_t maxCoalesceDistance,
+      AdaptiveCoalescer* coalescer,
+      bool warm)
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            std::move(requests),
+            warm),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        coalescer_(coalescer) {}
 
   std::vector<CachePin> loadData(bool prefetch) override {
     std::vector<CachePin> pins;
@@ -396,10 +484,11 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          setEntryIds(index, pin);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -415,14 +504,25 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usecs = 0;
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          uint64_t bytes = 0;
+          for (const auto& buffer : buffers) {
+            bytes += buffer.size();
+          }
+          coalescer_->recordRead(bytes, usecs);
         });
     updateStats(stats, prefetch, false);
+    recordHeatMap(pins, prefetch, false);
     return pins;
   }
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  AdaptiveCoalescer* const coalescer_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -432,8 +532,14 @@ class SsdLoad : public DwioCoalescedLoadBase {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
-      std::vector<CacheRequest*> requests)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)) {}
+      std::vector<CacheRequest*> requests,
+      bool warm)
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            std::move(requests),
+            warm) {}
 
   std::vector<CachePin> loadData(bool prefetch) override {
     std::vector<SsdPin> ssdPins;
@@ -445,6 +551,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          setEntryIds(index, pin);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -454,6 +561,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
     assert(!ssdPins.empty()); // for lint.
     const auto stats = ssdPins[0].file()->load(ssdPins, pins);
     updateStats(stats, prefetch, true);
+    recordHeatMap(pins, prefetch, true);
     return pins;
   }
 };
@@ -462,14 +570,16 @@ class SsdLoad : public DwioCoalescedLoadBase {
 
 void CachedBufferedInput::readRegion(
     const std::vector<CacheRequest*>& requests,
-    bool prefetch) {
+    bool prefetch,
+    int32_t maxCoalesceDistance) {
   if (requests.empty() || (requests.size() == 1 && !prefetch)) {
     return;
   }
 
   std::shared_ptr<cache::CoalescedLoad> load;
   if (!requests[0]->ssdPin.empty()) {
-    load = std::make_shared<SsdLoad>(*cache_, ioStats_, groupId_, requests);
+    load = std::make_shared<SsdLoad>(
+        *cache_, ioStats_, groupId_, requests, options_.cacheWarm());
   } else {
     load = std::make_shared<DwioCoalescedLoad>(
         *cache_,
@@ -477,7 +587,9 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        maxCoalesceDistance,
+        coalescer_,
+        options_.cacheWarm());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
@@ -23,6 +23,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
+#include "velox/dwio/common/AdaptiveCoalescer.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
@@ -77,6 +78,7 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
+        coalescer_(&AdaptiveCoalescer::instance(*input_->getReadFile())),
         options_(readerOptions) {
     checkLoadQuantum();
   }
@@ -98,13 +100,16 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
+        coalescer_(&AdaptiveCoalescer::instance(*input_->getReadFile())),
         options_(readerOptions) {
     checkLoadQuantum();
   }
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
-      load->cancel();
+      if (load->cancel()) {
+        ioStats_->cancelledPrefetch().increment(load->size());
+      }
     }
   }
 
@@ -152,6 +157,15 @@ class CachedBufferedInput : public BufferedInput {
     return cache_;
   }
 
+  AdaptiveCoalescer& coalescer() const {
+    return *coalescer_;
+  }
+
+  /// True if the reads only warm the cache. See io::ReaderOptions::cacheWarm().
+  bool cacheWarm() const {
+    return options_.cacheWarm();
+  }
+
   /// Returns the CoalescedLoad that contains the correlated loads for 'stream'
   /// or nullptr if none. Returns nullptr on all but first call for 'stream'
   /// since the load is to be triggered by the first access.
@@ -162,6 +176,14 @@ class CachedBufferedInput : public BufferedInput {
     return executor_;
   }
 
+  bool decompressAhead() const override {
+    return options_.decompressAhead() && executor_ != nullptr;
+  }
+
+  std::shared_ptr<IoStatistics> ioStatistics() const override {
+    return ioStats_;
+  }
+
   uint64_t nextFetchSize() const override {
     VELOX_NYI();
   }
@@ -174,8 +196,11 @@ class CachedBufferedInput : public BufferedInput {
   // Makes a CoalescedLoad for 'requests' to be read together, coalescing IO is
   // appropriate. If 'prefetch' is set, schedules the CoalescedLoad on
   // 'executor_'. Links the CoalescedLoad to all CacheInputStreams that it
-  // concerns.
-  void readRegion(const std::vector<CacheRequest*>& requests, bool prefetch);
+  // concerns. Reads from storage may span gaps up to 'maxCoalesceDistance'.
+  void readRegion(
+      const std::vector<CacheRequest*>& requests,
+      bool prefetch,
+      int32_t maxCoalesceDistance);
 
   // We only support up to 8MB load quantum size on SSD and there is no need for
   // larger SSD read size performance wise.
@@ -195,6 +220,8 @@ class CachedBufferedInput : public BufferedInput {
   const std::shared_ptr<IoStatistics> ioStats_;
   folly::Executor* const executor_;
   const uint64_t fileSize_;
+  // Models the storage of the file for adaptive coalescing.
+  AdaptiveCoalescer* const coalescer_;
   const io::ReaderOptions options_;
 
   // Regions that are candidates for loading.
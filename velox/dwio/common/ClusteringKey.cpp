@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ClusteringKey.h"
+
+#include <cstring>
+
+#include <folly/lang/Bits.h>
+
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+uint64_t mapInteger(int64_t value) {
+  return static_cast<uint64_t>(value) ^ kSignBit;
+}
+
+uint64_t mapDouble(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & kSignBit) ? ~bits : bits | kSignBit;
+}
+
+uint64_t mapString(StringView value) {
+  uint64_t bits = 0;
+  std::memcpy(
+      &bits, value.data(), std::min<size_t>(value.size(), sizeof(bits)));
+  return folly::Endian::big(bits);
+}
+
+// Maps the values of 'decoded' to unsigned integers that sort like the
+// values. Nulls are mapped to 0.
+void mapColumn(
+    const DecodedVector& decoded,
+    const Type& type,
+    vector_size_t size,
+    uint64_t* mapped) {
+  for (vector_size_t row = 0; row < size; ++row) {
+    if (decoded.isNullAt(row)) {
+      mapped[row] = 0;
+      continue;
+    }
+    switch (type.kind()) {
+      case TypeKind::BOOLEAN:
+        mapped[row] = mapInteger(decoded.valueAt<bool>(row));
+        break;
+      case TypeKind::TINYINT:
+        mapped[row] = mapInteger(decoded.valueAt<int8_t>(row));
+        break;
+      case TypeKind::SMALLINT:
+        mapped[row] = mapInteger(decoded.valueAt<int16_t>(row));
+        break;
+      case TypeKind::INTEGER:
+        mapped[row] = mapInteger(decoded.valueAt<int32_t>(row));
+        break;
+      case TypeKind::BIGINT:
+        mapped[row] = mapInteger(decoded.valueAt<int64_t>(row));
+        break;
+      case TypeKind::REAL:
+        mapped[row] = mapDouble(decoded.valueAt<float>(row));
+        break;
+      case TypeKind::DOUBLE:
+        mapped[row] = mapDouble(decoded.valueAt<double>(row));
+        break;
+      case TypeKind::TIMESTAMP:
+        mapped[row] = mapInteger(
+            decoded.valueAt<Timestamp>(row).toMillisAllowOverflow());
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        mapped[row] = mapString(decoded.valueAt<StringView>(row));
+        break;
+      default:
+        VELOX_USER_FAIL(
+            "Unsupported type for a clustering key: {}", type.toString());
+    }
+  }
+}
+
+} // namespace
+
+VectorPtr makeClusteringKeys(
+    const RowVector& input,
+    const std::vector<column_index_t>& keyChannels,
+    bool interleave,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK(!keyChannels.empty());
+  const auto size = input.size();
+  const auto numKeys = keyChannels.size();
+
+  // Mapped values of the key columns, one column after another.
+  std::vector<uint64_t> mapped(numKeys * size);
+  SelectivityVector rows(size);
+  DecodedVector decoded;
+  for (auto i = 0; i < numKeys; ++i) {
+    const auto& column = input.childAt(keyChannels[i]);
+    decoded.decode(*column, rows);
+    mapColumn(decoded, *column->type(), size, mapped.data() + i * size);
+  }
+
+  const auto keySize = numKeys * sizeof(uint64_t);
+  auto keys =
+      BaseVector::create<FlatVector<StringView>>(VARBINARY(), size, pool);
+  auto* buffer = keys->getRawStringBufferWithSpace(keySize * size, true);
+  std::memset(buffer, 0, keySize * size);
+  for (vector_size_t row = 0; row < size; ++row) {
+    auto* key = reinterpret_cast<uint8_t*>(buffer + row * keySize);
+    if (interleave) {
+      // Output bit 'bit' is bit 63 - bit / numKeys of key column
+      // bit % numKeys, counting from the most significant bit of the key.
+      for (auto bit = 0; bit < numKeys * 64; ++bit) {
+        const auto value = mapped[(bit % numKeys) * size + row];
+        if (value & (kSignBit >> (bit / numKeys))) {
+          key[bit / 8] |= 0x80 >> (bit % 8);
+        }
+      }
+    } else {
+      for (auto i = 0; i < numKeys; ++i) {
+        const auto value = folly::Endian::big(mapped[i * size + row]);
+        std::memcpy(key + i * sizeof(uint64_t), &value, sizeof(value));
+      }
+    }
+    keys->setNoCopy(row, StringView(buffer + row * keySize, keySize));
+  }
+  return keys;
+}
+
+int32_t commonPrefixBits(std::string_view left, std::string_view right) {
+  const auto size = std::min(left.size(), right.size());
+  for (auto i = 0; i < size; ++i) {
+    const uint8_t diff = left[i] ^ right[i];
+    if (diff != 0) {
+      return i * 8 + __builtin_clz(diff) - 24;
+    }
+  }
+  return size * 8;
+}
+
+} // namespace facebook::velox::dwio::common
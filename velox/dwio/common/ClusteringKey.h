@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Makes a VARBINARY key for each row of 'input' from the columns at
+/// 'keyChannels'. Each key column is first mapped to 64 bits that sort in the
+/// order of the values, with nulls as the smallest value. Strings are mapped
+/// by their first 8 bytes. If 'interleave' is true, the bits of the key
+/// columns are interleaved from the most significant down, so that the keys
+/// sort in Z-order and a range of keys with a common prefix covers a box in
+/// the space of the key columns. Otherwise the mapped columns are
+/// concatenated, so that the keys sort like the key columns in ascending
+/// order.
+VectorPtr makeClusteringKeys(
+    const RowVector& input,
+    const std::vector<column_index_t>& keyChannels,
+    bool interleave,
+    memory::MemoryPool* pool);
+
+/// Returns the number of leading bits 'left' and 'right' have in common. The
+/// fewer bits the keys of adjacent rows have in common, the coarser the
+/// boundary between the key ranges before and after them.
+int32_t commonPrefixBits(std::string_view left, std::string_view right);
+
+} // namespace facebook::velox::dwio::common
@@ -15,6 +15,9 @@
  */
 
 #include "velox/dwio/common/DirectBufferedInput.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/DirectInputStream.h"
@@ -127,13 +130,19 @@ void DirectBufferedInput::makeLoads(
     // eligible to prefetch. This will be loaded by itself on first use.
     return;
   }
-  const int32_t maxDistance = options_.maxCoalesceDistance();
+  AdaptiveCoalescer::Limits limits{
+      options_.maxCoalesceDistance(), options_.maxCoalesceBytes()};
+  if (options_.adaptiveCoalesce()) {
+    limits = coalescer_->limits(limits);
+    ioStats_->adaptiveCoalesceDistance().increment(limits.maxCoalesceDistance);
+  }
+  const int32_t maxDistance = limits.maxCoalesceDistance;
   const auto loadQuantum = options_.loadQuantum();
   // If reading densely accessed, coalesce into large for best throughput, if
   // for sparse, coalesce to quantum to reduce overread. Not all sparse access
   // is correlated.
   const auto maxCoalesceBytes =
-      prefetch ? options_.maxCoalesceBytes() : loadQuantum;
+      prefetch ? limits.maxCoalesceBytes : loadQuantum;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -198,7 +207,13 @@ void DirectBufferedInput::readRegion(
     return;
   }
   auto load = std::make_shared<DirectCoalescedLoad>(
-      input_, ioStats_, groupId_, requests, *pool_, options_.loadQuantum());
+      input_,
+      ioStats_,
+      groupId_,
+      requests,
+      *pool_,
+      options_.loadQuantum(),
+      coalescer_);
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -281,14 +296,30 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
     input_->read(buffers, requests_[0].region.offset, LogType::FILE);
   }
 
+  if (coalescer_ != nullptr) {
+    coalescer_->recordRead(size + overread, usecs);
+  }
   ioStats_->read().increment(size + overread);
   ioStats_->incRawBytesRead(size);
   ioStats_->incTotalScanTime(usecs * 1'000);
   ioStats_->queryThreadIoLatency().increment(usecs);
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricStorageReadLatencyMs, usecs / 1'000);
   ioStats_->incRawOverreadBytes(overread);
   if (prefetch) {
     ioStats_->prefetch().increment(size + overread);
   }
+  prefetched_ = prefetch;
+  auto& heatMap = cache::cacheHeatMap();
+  if (heatMap.enabled()) {
+    for (const auto& request : requests_) {
+      heatMap.recordLoad(
+          groupId_,
+          request.trackingId,
+          cache::CacheHeatMap::Source::kStorage,
+          request.loadSize,
+          prefetch);
+    }
+  }
   return {};
 }
 
@@ -298,6 +329,10 @@ int32_t DirectCoalescedLoad::getData(
     std::string& tinyData) {
   for (auto& request : requests_) {
     if (request.region.offset == offset) {
+      if (prefetched_) {
+        cache::cacheHeatMap().recordPrefetchHit(
+            groupId_, request.trackingId, request.loadSize);
+      }
       data = std::move(request.data);
       tinyData = std::move(request.tinyData);
       return request.loadSize;
@@ -23,6 +23,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
+#include "velox/dwio/common/AdaptiveCoalescer.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
@@ -56,12 +57,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t groupId,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool& pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      AdaptiveCoalescer* coalescer = nullptr)
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
         groupId_(groupId),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        coalescer_(coalescer),
         pool_(pool) {
     requests_.reserve(requests.size());
     for (auto i = 0; i < requests.size(); ++i) {
@@ -95,8 +98,12 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  // Receives the size and time of the read if not nullptr.
+  AdaptiveCoalescer* const coalescer_;
   memory::MemoryPool& pool_;
   std::vector<LoadRequest> requests_;
+  // True if loadData() ran ahead of use. getData() then counts prefetch hits.
+  bool prefetched_{false};
 };
 
 class DirectBufferedInput : public BufferedInput {
@@ -122,11 +129,14 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
+        coalescer_(&AdaptiveCoalescer::instance(*input_->getReadFile())),
         options_(readerOptions) {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
-      load->cancel();
+      if (load->cancel()) {
+        ioStats_->cancelledPrefetch().increment(load->size());
+      }
     }
   }
 
@@ -161,6 +171,10 @@ class DirectBufferedInput : public BufferedInput {
     return pool_;
   }
 
+  AdaptiveCoalescer& coalescer() const {
+    return *coalescer_;
+  }
+
   /// Returns the CoalescedLoad that contains the correlated loads for
   /// 'stream' or nullptr if none. Returns nullptr on all but first
   /// call for 'stream' since the load is to be triggered by the first
@@ -172,6 +186,14 @@ class DirectBufferedInput : public BufferedInput {
     return executor_;
   }
 
+  bool decompressAhead() const override {
+    return options_.decompressAhead() && executor_ != nullptr;
+  }
+
+  std::shared_ptr<IoStatistics> ioStatistics() const override {
+    return ioStats_;
+  }
+
   uint64_t nextFetchSize() const override {
     VELOX_NYI();
   }
@@ -193,6 +215,7 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
+        coalescer_(&AdaptiveCoalescer::instance(*input_->getReadFile())),
         options_(readerOptions) {}
 
   // Sorts requests and makes CoalescedLoads for nearby requests. If 'prefetch'
@@ -212,6 +235,9 @@ class DirectBufferedInput : public BufferedInput {
   folly::Executor* const executor_;
   const uint64_t fileSize_;
 
+  // Models the storage of the file for adaptive coalescing.
+  AdaptiveCoalescer* const coalescer_;
+
   // Regions that are candidates for loading.
   std::vector<LoadRequest> requests_;
 
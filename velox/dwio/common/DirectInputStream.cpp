@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/caching/CacheHeatMap.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/DirectBufferedInput.h"
@@ -152,8 +153,14 @@ void DirectInputStream::loadSync() {
     MicrosecondTimer timer(&usecs);
     input_->read(ranges, loadedRegion_.offset, LogType::FILE);
   }
+  bufferedInput_->coalescer().recordRead(loadedRegion_.length, usecs);
   ioStats_->read().increment(loadedRegion_.length);
   ioStats_->queryThreadIoLatency().increment(usecs);
+  cache::cacheHeatMap().recordLoad(
+      groupId_,
+      trackingId_,
+      cache::CacheHeatMap::Source::kStorage,
+      loadedRegion_.length);
   ioStats_->incTotalScanTime(usecs * 1'000);
 }
 
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileTailCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox::dwio::common {
+namespace {
+FileTailCache*& instance() {
+  static FileTailCache* cache{nullptr};
+  return cache;
+}
+} // namespace
+
+std::string FileTailKey::toString() const {
+  return fmt::format(
+      "{}:{}:{}:{}",
+      common::toString(format),
+      fileLength,
+      modificationTime,
+      path);
+}
+
+std::string FileTailCache::Stats::toString() const {
+  return fmt::format(
+      "numHits {} numMisses {} numEvicted {} numEntries {} memory {}",
+      numHits,
+      numMisses,
+      numEvicted,
+      numEntries,
+      succinctBytes(memoryBytes));
+}
+
+FileTailCache::FileTailCache(
+    uint64_t capacityBytes,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : capacityBytes_(capacityBytes), pool_(std::move(pool)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+// static
+FileTailCache* FileTailCache::getInstance() {
+  return instance();
+}
+
+// static
+void FileTailCache::setInstance(FileTailCache* cache) {
+  instance() = cache;
+}
+
+std::shared_ptr<const FileTail> FileTailCache::get(const FileTailKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key.toString());
+  if (it == entries_.end()) {
+    ++stats_.numMisses;
+    return nullptr;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.end(), lru_, it->second.position);
+  return it->second.tail;
+}
+
+void FileTailCache::put(
+    const FileTailKey& key,
+    std::shared_ptr<const FileTail> tail) {
+  VELOX_CHECK_NOT_NULL(tail);
+  const auto bytes = tail->memoryBytes();
+  if (bytes > capacityBytes_) {
+    return;
+  }
+  auto keyString = key.toString();
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(keyString);
+  if (it != entries_.end()) {
+    eraseLocked(it);
+  }
+  while (memoryBytes_ + bytes > capacityBytes_) {
+    eraseLocked(entries_.find(lru_.front()));
+    ++stats_.numEvicted;
+  }
+  lru_.push_back(keyString);
+  memoryBytes_ += bytes;
+  entries_.emplace(
+      std::move(keyString), Entry{std::move(tail), std::prev(lru_.end())});
+}
+
+void FileTailCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  memoryBytes_ = 0;
+}
+
+FileTailCache::Stats FileTailCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  stats.memoryBytes = memoryBytes_;
+  return stats;
+}
+
+void FileTailCache::eraseLocked(
+    folly::F14FastMap<std::string, Entry>::iterator it) {
+  memoryBytes_ -= it->second.tail->memoryBytes();
+  lru_.erase(it->second.position);
+  entries_.erase(it);
+}
+
+} // namespace facebook::velox::dwio::common
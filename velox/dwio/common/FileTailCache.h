@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Parsed metadata from the tail of a file, e.g. the footer of a DWRF or
+/// Parquet file, which the readers of all the splits of the file share. A
+/// FileTail must not reference the input or the memory pool of the reader
+/// that created it.
+class FileTail {
+ public:
+  explicit FileTail(uint64_t parseMicros) : parseMicros_(parseMicros) {}
+
+  virtual ~FileTail() = default;
+
+  /// Approximate memory used, counted against the capacity of FileTailCache.
+  virtual uint64_t memoryBytes() const = 0;
+
+  /// Time in microseconds it took to read and parse the tail. A reader which
+  /// finds the tail in FileTailCache saves this much.
+  uint64_t parseMicros() const {
+    return parseMicros_;
+  }
+
+ private:
+  const uint64_t parseMicros_;
+};
+
+/// Identifies the version of a file a FileTail was parsed from.
+struct FileTailKey {
+  std::string path;
+  uint64_t fileLength;
+  /// Modification time of the file if known, 0 otherwise.
+  int64_t modificationTime{0};
+  FileFormat format;
+
+  std::string toString() const;
+};
+
+/// Process-wide cache of FileTails, so that the readers of the splits of a
+/// file read and parse its footer once. Entries are evicted least recently
+/// used first when the memory of the entries exceeds 'capacityBytes'.
+/// Buffers of cached FileTails are allocated from pool(), which outlives the
+/// queries that create them. Thread-safe.
+class FileTailCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvicted{0};
+    size_t numEntries{0};
+    uint64_t memoryBytes{0};
+
+    std::string toString() const;
+  };
+
+  FileTailCache(
+      uint64_t capacityBytes,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Returns the process-wide cache, nullptr if not set. Readers only cache
+  /// their file tails if set.
+  static FileTailCache* getInstance();
+
+  static void setInstance(FileTailCache* cache);
+
+  /// Returns the tail for 'key' if cached, nullptr otherwise.
+  std::shared_ptr<const FileTail> get(const FileTailKey& key);
+
+  /// Adds 'tail' for 'key'. Does nothing if 'tail' alone exceeds the
+  /// capacity.
+  void put(const FileTailKey& key, std::shared_ptr<const FileTail> tail);
+
+  void clear();
+
+  /// Memory pool for the buffers of the cached tails.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const FileTail> tail;
+    // Position in 'lru_'.
+    std::list<std::string>::iterator position;
+  };
+
+  void eraseLocked(folly::F14FastMap<std::string, Entry>::iterator it);
+
+  const uint64_t capacityBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  // Keys of 'entries_', least recently used first.
+  std::list<std::string> lru_;
+  uint64_t memoryBytes_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -83,6 +83,7 @@ void ReadFileInputStream::read(
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime(readTimeUs * 1'000);
+    recordLocality(offset, length);
   }
 
   VELOX_CHECK_EQ(
@@ -102,6 +103,7 @@ void ReadFileInputStream::read(
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
   const auto size = readFile_->preadv(offset, buffers);
+  recordLocality(buffers, offset);
   VELOX_CHECK_EQ(
       size,
       bufferSize,
@@ -118,6 +120,7 @@ folly::SemiFuture<uint64_t> ReadFileInputStream::readAsync(
     LogType logType) {
   const int64_t bufferSize = totalBufferSize(buffers);
   logRead(offset, bufferSize, logType);
+  recordLocality(buffers, offset);
   return readFile_->preadvAsync(offset, buffers);
 }
 
@@ -141,6 +144,39 @@ void ReadFileInputStream::vread(
   if (stats_) {
     stats_->incRawBytesRead(length);
     stats_->incTotalScanTime((getCurrentTimeMicro() - readStartMicros) * 1000);
+    for (const auto& region : regions) {
+      recordLocality(region.offset, region.length);
+    }
+  }
+}
+
+void ReadFileInputStream::recordLocality(uint64_t offset, uint64_t length) {
+  if (stats_ == nullptr || length == 0) {
+    return;
+  }
+  const auto localBytes = readFile_->localBytes(offset, length);
+  if (!localBytes.has_value()) {
+    return;
+  }
+  if (localBytes.value() > 0) {
+    stats_->localStorageRead().increment(localBytes.value());
+  }
+  if (localBytes.value() < length) {
+    stats_->remoteStorageRead().increment(length - localBytes.value());
+  }
+}
+
+void ReadFileInputStream::recordLocality(
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t offset) {
+  if (stats_ == nullptr) {
+    return;
+  }
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      recordLocality(offset, range.size());
+    }
+    offset += range.size();
   }
 }
 
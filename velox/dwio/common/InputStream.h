@@ -177,6 +177,15 @@ class ReadFileInputStream final : public InputStream {
   }
 
  private:
+  // Adds the 'length' bytes at 'offset' to the local or remote storage reads
+  // of 'stats_' if the file knows where they are stored.
+  void recordLocality(uint64_t offset, uint64_t length);
+
+  // Same for the non-gap ranges of 'buffers' starting at 'offset'.
+  void recordLocality(
+      const std::vector<folly::Range<char*>>& buffers,
+      uint64_t offset);
+
   std::shared_ptr<velox::ReadFile> readFile_;
 };
 
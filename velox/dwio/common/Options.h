@@ -157,6 +157,8 @@ class RowReaderOptions {
   std::function<void(uint16_t)> stripeCountCallback_;
   bool eagerFirstStripeLoad = true;
   uint64_t skipRows_ = 0;
+  uint32_t stripePart_ = 0;
+  uint32_t numStripeParts_ = 1;
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory_;
 
   TimestampPrecision timestampPrecision_ = TimestampPrecision::kMilliseconds;
@@ -413,6 +415,25 @@ class RowReaderOptions {
     return skipRows_;
   }
 
+  /// Reads only part 'stripePart' of 'numStripeParts' parts of each stripe.
+  /// Stripes are divided at row index strides, so that several readers can
+  /// share the decoding of the large stripes of a file. Supported by DWRF and
+  /// ORC.
+  void setStripePart(uint32_t stripePart, uint32_t numStripeParts) {
+    VELOX_CHECK_GT(numStripeParts, 0);
+    VELOX_CHECK_LT(stripePart, numStripeParts);
+    stripePart_ = stripePart;
+    numStripeParts_ = numStripeParts;
+  }
+
+  uint32_t getStripePart() const {
+    return stripePart_;
+  }
+
+  uint32_t getNumStripeParts() const {
+    return numStripeParts_;
+  }
+
   void setUnitLoaderFactory(
       std::shared_ptr<UnitLoaderFactory> unitLoaderFactory) {
     unitLoaderFactory_ = std::move(unitLoaderFactory);
@@ -508,6 +529,13 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the modification time of the file if known. Tells apart the
+  /// versions of a file in FileTailCache.
+  ReaderOptions& setFileModificationTime(int64_t time) {
+    fileModificationTime_ = time;
+    return *this;
+  }
+
   ReaderOptions& setIOExecutor(std::shared_ptr<folly::Executor> executor) {
     ioExecutor_ = std::move(executor);
     return *this;
@@ -552,6 +580,10 @@ class ReaderOptions : public io::ReaderOptions {
     return ioExecutor_;
   }
 
+  int64_t fileModificationTime() const {
+    return fileModificationTime_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -594,6 +626,7 @@ class ReaderOptions : public io::ReaderOptions {
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
+  int64_t fileModificationTime_{0};
   std::shared_ptr<folly::Executor> ioExecutor_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
@@ -611,6 +644,8 @@ struct WriterOptions {
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
   std::map<std::string, std::string> serdeParameters;
   std::optional<uint8_t> parquetWriteTimestampUnit;
+  bool parquetEnablePageIndex{false};
+  std::vector<std::string> parquetBloomFilterColumns;
   std::optional<uint8_t> zlibCompressionLevel;
   std::optional<uint8_t> zstdCompressionLevel;
 };
@@ -109,6 +109,10 @@ VectorPtr RowReader::projectColumns(
       });
     }
   }
+  // Rows passing at least one filter in each disjunction.
+  std::vector<std::vector<uint64_t>> disjunctions(
+      spec.numDisjunctions(),
+      std::vector<uint64_t>(bits::nwords(input->size()), 0));
   for (auto& childSpec : spec.children()) {
     VectorPtr child;
     if (childSpec->isConstant()) {
@@ -117,7 +121,18 @@ VectorPtr RowReader::projectColumns(
     } else {
       child =
           inputRow->childAt(inputRowType.getChildIdx(childSpec->fieldName()));
-      applyFilter(*child, *childSpec, passed.data());
+      if (childSpec->disjunction() == ScanSpec::kNoDisjunction) {
+        applyFilter(*child, *childSpec, passed.data());
+      }
+    }
+    if (childSpec->disjunction() != ScanSpec::kNoDisjunction) {
+      std::vector<uint64_t> childPassed(bits::nwords(input->size()), -1);
+      applyFilter(*child, *childSpec, childPassed.data());
+      bits::orBits(
+          disjunctions[childSpec->disjunction()].data(),
+          childPassed.data(),
+          0,
+          input->size());
     }
     if (!childSpec->projectOut()) {
       continue;
@@ -127,6 +142,9 @@ VectorPtr RowReader::projectColumns(
     types[i] = child->type();
     children[i] = std::move(child);
   }
+  for (const auto& disjunction : disjunctions) {
+    bits::andBits(passed.data(), disjunction.data(), 0, input->size());
+  }
   auto rowType = ROW(std::move(names), std::move(types));
   auto size = bits::countBits(passed.data(), 0, input->size());
   if (size == 0) {
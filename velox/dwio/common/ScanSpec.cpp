@@ -347,6 +347,9 @@ std::string ScanSpec::toString() const {
     if (filter_) {
       out << " filter " << filter_->toString();
     }
+    if (disjunction_ != kNoDisjunction) {
+      out << " disjunction " << disjunction_;
+    }
     if (isConstant()) {
       out << " constant";
     }
@@ -365,9 +368,29 @@ std::string ScanSpec::toString() const {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
+  VELOX_CHECK_EQ(
+      disjunction_,
+      kNoDisjunction,
+      "Cannot add a filter to a member of a disjunction: {}",
+      fieldName_);
   filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
 }
 
+void ScanSpec::addDisjunction(const std::vector<ScanSpec*>& children) {
+  VELOX_CHECK_GE(children.size(), 2);
+  for (auto* child : children) {
+    VELOX_CHECK_EQ(childByName(child->fieldName()), child);
+    VELOX_CHECK_NOT_NULL(child->filter(), "{}", child->fieldName());
+    VELOX_CHECK(
+        !child->keepValues() && child->children().empty(),
+        "Disjunction member must be filter only: {}",
+        child->fieldName());
+    VELOX_CHECK_EQ(child->disjunction_, kNoDisjunction);
+    child->disjunction_ = numDisjunctions_;
+  }
+  ++numDisjunctions_;
+}
+
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
   auto child = getOrCreateChild(Subfield(name));
   child->setProjectOut(true);
@@ -71,6 +71,24 @@ class ScanSpec {
 
   void addFilter(const Filter&);
 
+  static constexpr int32_t kNoDisjunction = -1;
+
+  // Makes the filters of 'children' a disjunction, e.g. 'a = 1 OR b = 2'. A
+  // row passes if it passes the filter of at least one of them. The children
+  // must be filter only children of 'this' and have a filter. Their filters
+  // are not used on their own to skip row groups or splits.
+  void addDisjunction(const std::vector<ScanSpec*>& children);
+
+  int32_t numDisjunctions() const {
+    return numDisjunctions_;
+  }
+
+  // Ordinal of the disjunction of the parent 'filter_' is a part of, or
+  // kNoDisjunction.
+  int32_t disjunction() const {
+    return disjunction_;
+  }
+
   void setMaxArrayElementsCount(vector_size_t count) {
     maxArrayElementsCount_ = count;
   }
@@ -367,6 +385,8 @@ class ScanSpec {
   // returned as flat.
   bool makeFlat_ = false;
   std::unique_ptr<common::Filter> filter_;
+  int32_t disjunction_{kNoDisjunction};
+  int32_t numDisjunctions_{0};
 
   // Filters that will be only used for row group filtering based on metadata.
   // The conjunctions among these filters are tracked in MetadataFilter, with
@@ -168,10 +168,29 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  // Disjunctions are read after the other filters and before the first
+  // child without a filter.
+  bool disjunctionsRead = scanSpec_->numDisjunctions() == 0;
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
+    if (childSpec->disjunction() != velox::common::ScanSpec::kNoDisjunction) {
+      continue;
+    }
+    if (!disjunctionsRead && !childSpec->hasFilter()) {
+      disjunctionsRead = true;
+      activeRows = readDisjunctions(offset, activeRows, structNulls);
+      if (activeRows.empty()) {
+        break;
+      }
+    }
     if (isChildConstant(*childSpec)) {
+      // A field missing from the file is null on all rows.
+      if (!childSpec->isConstant() && childSpec->filter() &&
+          !childSpec->filter()->testNull()) {
+        activeRows = {};
+        break;
+      }
       continue;
     }
     auto fieldIndex = childSpec->subscript();
@@ -203,6 +222,10 @@ void SelectiveStructColumnReaderBase::read(
     }
   }
 
+  if (!disjunctionsRead && !activeRows.empty()) {
+    activeRows = readDisjunctions(offset, activeRows, structNulls);
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -235,6 +258,57 @@ void SelectiveStructColumnReaderBase::recordParentNullsInChildren(
   }
 }
 
+RowSet SelectiveStructColumnReaderBase::readDisjunctions(
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* incomingNulls) {
+  for (int32_t i = 0; i < scanSpec_->numDisjunctions() && !rows.empty(); ++i) {
+    const auto numRows = rows.back() + 1;
+    disjunctionBits_.resize(bits::nwords(numRows));
+    std::fill(disjunctionBits_.begin(), disjunctionBits_.end(), 0);
+    for (auto& childSpec : scanSpec_->children()) {
+      if (childSpec->disjunction() != i) {
+        continue;
+      }
+      if (isChildConstant(*childSpec)) {
+        // A column missing from the file is null on all rows.
+        VELOX_CHECK(
+            !childSpec->isConstant() || childSpec->constantValue()->isNullAt(0),
+            "Disjunction member cannot be a non-null constant: {}",
+            childSpec->fieldName());
+        if (childSpec->filter()->testNull()) {
+          for (auto row : rows) {
+            bits::setBit(disjunctionBits_.data(), row);
+          }
+        }
+        continue;
+      }
+      auto* reader = children_.at(childSpec->subscript());
+      advanceFieldReader(reader, offset);
+      SelectivityTimer timer(childSpec->selectivity(), rows.size());
+      reader->resetInitTimeClocks();
+      reader->read(offset, rows, incomingNulls);
+      timer.subtract(reader->initTimeClocks());
+      for (auto row : reader->outputRows()) {
+        bits::setBit(disjunctionBits_.data(), row);
+      }
+      childSpec->selectivity().addOutput(reader->outputRows().size());
+    }
+    disjunctionScratch_.resize(rows.size());
+    vector_size_t numPassed = 0;
+    for (auto row : rows) {
+      if (bits::isBitSet(disjunctionBits_.data(), row)) {
+        disjunctionScratch_[numPassed++] = row;
+      }
+    }
+    disjunctionScratch_.resize(numPassed);
+    // 'rows' may point into 'disjunctionRows_'.
+    std::swap(disjunctionRows_, disjunctionScratch_);
+    rows = disjunctionRows_;
+  }
+  return rows;
+}
+
 bool SelectiveStructColumnReaderBase::isChildConstant(
     const velox::common::ScanSpec& childSpec) const {
   // Returns true if the child has a constant set in the ScanSpec, or if the
@@ -253,7 +327,11 @@ bool SelectiveStructColumnReaderBase::isChildConstant(
        fileType_->type()->kind() !=
            TypeKind::MAP && // If this is the case it means this is a flat map,
                             // so it can't have "missing" fields.
-       childSpec.channel() >= fileType_->size());
+       childSpec.channel() >= fileType_->size()) ||
+      // A flat map read as a struct has no stream for a requested key that
+      // is not in the current stripe.
+      (fileType_->type()->kind() == TypeKind::MAP &&
+       childSpec.subscript() == kConstantChildSpecSubscript);
 }
 
 namespace {
@@ -131,6 +131,14 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     return hasDeletion_;
   }
 
+  // Reads the children that are part of a disjunction of filters on 'rows'
+  // and returns the rows that pass all the disjunctions. A row passes a
+  // disjunction if it passes the filter of at least one of its children.
+  RowSet readDisjunctions(
+      vector_size_t offset,
+      RowSet rows,
+      const uint64_t* incomingNulls);
+
   // Returns true if we'll return a constant for that childSpec (i.e. we don't
   // need to read it).
   bool isChildConstant(const velox::common::ScanSpec& childSpec) const;
@@ -148,6 +156,12 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Dense set of rows to read in next().
   raw_vector<vector_size_t> rows_;
 
+  // Rows passing the disjunctions in readDisjunctions() and scratch memory
+  // for computing them.
+  raw_vector<vector_size_t> disjunctionRows_;
+  raw_vector<vector_size_t> disjunctionScratch_;
+  std::vector<uint64_t> disjunctionBits_;
+
   const Mutation* mutation_ = nullptr;
 
   // After read() call mutation_ could go out of scope.  Need to keep this
@@ -16,21 +16,36 @@
 
 #include "velox/dwio/common/SortingWriter.h"
 
+#include "velox/dwio/common/ClusteringKey.h"
+
 namespace facebook::velox::dwio::common {
 
 SortingWriter::SortingWriter(
     std::unique_ptr<Writer> writer,
     std::unique_ptr<exec::SortBuffer> sortBuffer,
     uint32_t maxOutputRowsConfig,
-    uint64_t maxOutputBytesConfig)
+    uint64_t maxOutputBytesConfig,
+    ClusteringOptions clustering,
+    std::vector<CompareFlags> presortedCompareFlags)
     : outputWriter_(std::move(writer)),
       maxOutputRowsConfig_(maxOutputRowsConfig),
       maxOutputBytesConfig_(maxOutputBytesConfig),
       sortPool_(sortBuffer->pool()),
       canReclaim_(sortBuffer->canSpill()),
-      sortBuffer_(std::move(sortBuffer)) {
+      sortBuffer_(std::move(sortBuffer)),
+      clustering_(std::move(clustering)),
+      presortedCompareFlags_(std::move(presortedCompareFlags)),
+      streaming_(!presortedCompareFlags_.empty()) {
   VELOX_CHECK_GT(maxOutputRowsConfig_, 0);
   VELOX_CHECK_GT(maxOutputBytesConfig_, 0);
+  if (clustering_.zOrder || clustering_.stripeRows > 0) {
+    VELOX_CHECK(!clustering_.keyChannels.empty());
+  }
+  if (streaming_) {
+    VELOX_CHECK(!clustering_.zOrder);
+    VELOX_CHECK_EQ(
+        presortedCompareFlags_.size(), clustering_.keyChannels.size());
+  }
   if (sortPool_->parent()->reclaimer() != nullptr) {
     sortPool_->setReclaimer(MemoryReclaimer::create(this));
   }
@@ -43,7 +58,32 @@ SortingWriter::~SortingWriter() {
 
 void SortingWriter::write(const VectorPtr& data) {
   checkRunning();
-  sortBuffer_->addInput(data);
+  if (streaming_) {
+    auto input = std::dynamic_pointer_cast<RowVector>(data);
+    VELOX_CHECK_NOT_NULL(input, "Expected a RowVector: {}", data->toString());
+    streaming_ = writePresorted(input);
+    return;
+  }
+  if (!clustering_.zOrder) {
+    sortBuffer_->addInput(data);
+    return;
+  }
+
+  auto input = std::dynamic_pointer_cast<RowVector>(data);
+  VELOX_CHECK_NOT_NULL(input, "Expected a RowVector: {}", data->toString());
+  if (sortInputType_ == nullptr) {
+    const auto& inputType = input->type()->asRow();
+    auto names = inputType.names();
+    auto types = inputType.children();
+    names.push_back("$zorder");
+    types.push_back(VARBINARY());
+    sortInputType_ = ROW(std::move(names), std::move(types));
+  }
+  auto children = input->children();
+  children.push_back(makeClusteringKeys(
+      *input, clustering_.keyChannels, /*interleave=*/true, sortPool_));
+  sortBuffer_->addInput(std::make_shared<RowVector>(
+      sortPool_, sortInputType_, nullptr, input->size(), std::move(children)));
 }
 
 void SortingWriter::flush() {
@@ -58,11 +98,13 @@ void SortingWriter::close() {
   const auto maxOutputBatchRows = outputBatchRows();
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputBatchRows);
   while (output != nullptr) {
-    outputWriter_->write(output);
+    writeOutput(std::move(output));
     output = sortBuffer_->getOutput(maxOutputBatchRows);
   }
+  writePending();
 
   sortBuffer_.reset();
+  lastStreamedRow_.reset();
   sortPool_->release();
   outputWriter_->close();
 }
@@ -71,6 +113,7 @@ void SortingWriter::abort() {
   setState(State::kAborted);
 
   sortBuffer_.reset();
+  lastStreamedRow_.reset();
   sortPool_->release();
   outputWriter_->abort();
 }
@@ -121,6 +164,168 @@ uint32_t SortingWriter::outputBatchRows() {
   return std::min(estimatedMaxOutputRows, maxOutputRowsConfig_);
 }
 
+bool SortingWriter::writePresorted(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return true;
+  }
+  bool sorted = lastStreamedRow_ == nullptr ||
+      compareKeys(*input, 0, *lastStreamedRow_, 0) >= 0;
+  for (vector_size_t row = 1; sorted && row < numRows; ++row) {
+    sorted = compareKeys(*input, row, *input, row - 1) >= 0;
+  }
+  if (sorted) {
+    writeOutput(input);
+    if (lastStreamedRow_ == nullptr) {
+      lastStreamedRow_ =
+          BaseVector::create<RowVector>(input->type(), 1, sortPool_);
+    }
+    lastStreamedRow_->copy(input.get(), 0, numRows - 1, 1);
+    return true;
+  }
+  // Rows already written cannot be reordered.
+  VELOX_USER_CHECK_NULL(
+      lastStreamedRow_,
+      "Input declared sorted has rows out of order after rows already "
+      "written");
+  sortBuffer_->addInput(input);
+  return false;
+}
+
+int32_t SortingWriter::compareKeys(
+    const RowVector& left,
+    vector_size_t leftRow,
+    const RowVector& right,
+    vector_size_t rightRow) const {
+  for (auto i = 0; i < clustering_.keyChannels.size(); ++i) {
+    const auto channel = clustering_.keyChannels[i];
+    const auto result = left.childAt(channel)->compare(
+        right.childAt(channel).get(),
+        leftRow,
+        rightRow,
+        presortedCompareFlags_[i]);
+    VELOX_CHECK(result.has_value());
+    if (result.value() != 0) {
+      return result.value();
+    }
+  }
+  return 0;
+}
+
+void SortingWriter::writeOutput(RowVectorPtr output) {
+  VectorPtr keys;
+  if (clustering_.zOrder) {
+    // Drops the Z-order key column.
+    auto children = output->children();
+    keys = std::move(children.back());
+    children.pop_back();
+    if (outputType_ == nullptr) {
+      const auto& sortType = output->type()->asRow();
+      auto names = sortType.names();
+      auto types = sortType.children();
+      names.pop_back();
+      types.pop_back();
+      outputType_ = ROW(std::move(names), std::move(types));
+    }
+    output = std::make_shared<RowVector>(
+        sortPool_, outputType_, nullptr, output->size(), std::move(children));
+  }
+  if (clustering_.stripeRows == 0) {
+    outputWriter_->write(output);
+    return;
+  }
+  if (keys == nullptr) {
+    keys = makeClusteringKeys(
+        *output, clustering_.keyChannels, /*interleave=*/false, sortPool_);
+  }
+  const auto* flatKeys = keys->asFlatVector<StringView>();
+  VELOX_CHECK_NOT_NULL(flatKeys);
+  writeClustered(output, *flatKeys);
+}
+
+void SortingWriter::writeClustered(
+    const RowVectorPtr& output,
+    const FlatVector<StringView>& keys) {
+  // Rows before the window cannot be cut points and are written right away.
+  // Rows in the window are kept pending until the stripe is cut.
+  const uint64_t windowStart = clustering_.stripeRows / 2;
+  const auto addRows = [&](vector_size_t begin, vector_size_t end) {
+    if (begin == end) {
+      return;
+    }
+    auto rows = (begin == 0 && end == output->size())
+        ? VectorPtr(output)
+        : output->slice(begin, end - begin);
+    if (pending_.empty() && rowsInStripe_ <= windowStart) {
+      outputWriter_->write(rows);
+    } else {
+      numPendingRows_ += rows->size();
+      pending_.push_back(std::move(rows));
+    }
+  };
+
+  vector_size_t begin = 0;
+  for (vector_size_t row = 0; row < output->size(); ++row) {
+    if (rowsInStripe_ == windowStart) {
+      addRows(begin, row);
+      begin = row;
+    }
+    const auto key = keys.valueAt(row);
+    const std::string_view keyView(key.data(), key.size());
+    if (rowsInStripe_ >= windowStart && rowsInStripe_ > 0 && hasLastKey_) {
+      addCutCandidate(
+          numPendingRows_ + row - begin, commonPrefixBits(lastKey_, keyView));
+    }
+    lastKey_.assign(keyView);
+    hasLastKey_ = true;
+    if (++rowsInStripe_ == clustering_.stripeRows) {
+      addRows(begin, row + 1);
+      begin = row + 1;
+      cutStripe();
+    }
+  }
+  addRows(begin, output->size());
+}
+
+void SortingWriter::addCutCandidate(uint64_t row, int32_t prefixBits) {
+  if (!bestCut_.has_value() || prefixBits < bestCut_->prefixBits) {
+    bestCut_ = Cut{row, prefixBits};
+  }
+}
+
+void SortingWriter::cutStripe() {
+  const auto cutRow =
+      bestCut_.has_value() ? bestCut_->row : numPendingRows_;
+  writePending(cutRow);
+  outputWriter_->flush();
+  rowsInStripe_ = numPendingRows_;
+  // The rest of the rows start the next stripe. They are before its window.
+  writePending();
+  bestCut_.reset();
+}
+
+void SortingWriter::writePending(std::optional<uint64_t> numRows) {
+  auto remaining = numRows.value_or(numPendingRows_);
+  VELOX_CHECK_LE(remaining, numPendingRows_);
+  size_t i = 0;
+  for (; i < pending_.size() && remaining > 0; ++i) {
+    auto& rows = pending_[i];
+    if (rows->size() <= remaining) {
+      remaining -= rows->size();
+      numPendingRows_ -= rows->size();
+      outputWriter_->write(rows);
+      rows.reset();
+      continue;
+    }
+    outputWriter_->write(rows->slice(0, remaining));
+    rows = rows->slice(remaining, rows->size() - remaining);
+    numPendingRows_ -= remaining;
+    remaining = 0;
+    break;
+  }
+  pending_.erase(pending_.begin(), pending_.begin() + i);
+}
+
 std::unique_ptr<memory::MemoryReclaimer> SortingWriter::MemoryReclaimer::create(
     SortingWriter* writer) {
   return std::unique_ptr<memory::MemoryReclaimer>(new MemoryReclaimer(writer));
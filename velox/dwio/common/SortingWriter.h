@@ -19,17 +19,45 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/SortBuffer.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::dwio::common {
 
 /// Sorting Writer object is used to write sorted data into a single file.
 class SortingWriter : public Writer {
  public:
+  /// Controls how rows are clustered by the sort keys and where stripes or
+  /// row groups are cut in the sorted output.
+  struct ClusteringOptions {
+    /// Channels of the sort key columns in the input.
+    std::vector<column_index_t> keyChannels;
+
+    /// If true, rows are sorted in Z-order of the sort keys so that ranges of
+    /// rows are clustered on each of the keys instead of only on the first.
+    /// The sort buffer must then have the input columns followed by a
+    /// VARBINARY column for the Z-order key, and sort by that column.
+    bool zOrder{false};
+
+    /// If not zero, a stripe or row group is cut after between half of and
+    /// 'stripeRows' rows, before the row where the sort keys change at the
+    /// coarsest level. This keeps the key range of each stripe small and its
+    /// min/max statistics tight.
+    uint64_t stripeRows{0};
+  };
+
+  /// If 'presortedCompareFlags' is not empty, the input is declared to arrive
+  /// sorted on 'clustering.keyChannels' with these flags. Rows are then
+  /// written as they come instead of being buffered, while their order is
+  /// checked. If the first batch is out of order, all rows are buffered and
+  /// sorted as usual. A later batch out of order fails the write because the
+  /// rows written before cannot be reordered.
   SortingWriter(
       std::unique_ptr<Writer> writer,
       std::unique_ptr<exec::SortBuffer> sortBuffer,
       uint32_t maxOutputRowsConfig,
-      uint64_t maxOutputBytesConfig);
+      uint64_t maxOutputBytesConfig,
+      ClusteringOptions clustering = {},
+      std::vector<CompareFlags> presortedCompareFlags = {});
 
   ~SortingWriter() override;
 
@@ -75,6 +103,38 @@ class SortingWriter : public Writer {
 
   uint32_t outputBatchRows();
 
+  // Writes 'input' if its rows are in order after the rows streamed so far.
+  // Otherwise adds it to 'sortBuffer_' and returns false, which ends
+  // streaming.
+  bool writePresorted(const RowVectorPtr& input);
+
+  // Compares the sort keys of 'leftRow' in 'left' with 'rightRow' in 'right'.
+  int32_t compareKeys(
+      const RowVector& left,
+      vector_size_t leftRow,
+      const RowVector& right,
+      vector_size_t rightRow) const;
+
+  // Writes a batch of sorted output, cutting stripes as set by 'clustering_'.
+  void writeOutput(RowVectorPtr output);
+
+  // Writes 'output' with the sort keys of its rows in 'keys', cutting a
+  // stripe whenever the current stripe has 'clustering_.stripeRows' rows.
+  void writeClustered(
+      const RowVectorPtr& output,
+      const FlatVector<StringView>& keys);
+
+  // Writes the pending rows before the best cut point, flushes the stripe and
+  // starts the next stripe with the rest of the pending rows.
+  void cutStripe();
+
+  // Writes the first 'numRows' rows of 'pending_', or all if std::nullopt.
+  void writePending(std::optional<uint64_t> numRows = std::nullopt);
+
+  // Adds a stripe-cut candidate with 'prefixBits' leading key bits in common
+  // with the previous row, before pending row 'row'.
+  void addCutCandidate(uint64_t row, int32_t prefixBits);
+
   const std::unique_ptr<Writer> outputWriter_;
   const uint32_t maxOutputRowsConfig_;
   const uint64_t maxOutputBytesConfig_;
@@ -82,6 +142,35 @@ class SortingWriter : public Writer {
   const bool canReclaim_;
 
   std::unique_ptr<exec::SortBuffer> sortBuffer_;
+
+  const ClusteringOptions clustering_;
+  // Input type followed by the Z-order key column if 'clustering_.zOrder'.
+  RowTypePtr sortInputType_;
+  // Type of the sorted output without the Z-order key column.
+  RowTypePtr outputType_;
+
+  // Compare flags of the sort keys if the input is declared presorted.
+  const std::vector<CompareFlags> presortedCompareFlags_;
+  // True while the input has been in order and is written as it comes.
+  bool streaming_;
+  // The last row written while streaming.
+  RowVectorPtr lastStreamedRow_;
+
+  // Rows in the stripe being written, including 'pending_'.
+  uint64_t rowsInStripe_{0};
+  // Rows in the cut window of the current stripe that are not written yet.
+  std::vector<VectorPtr> pending_;
+  uint64_t numPendingRows_{0};
+  // Sort key of the last row added to the stripe.
+  std::string lastKey_;
+  bool hasLastKey_{false};
+
+  struct Cut {
+    uint64_t row;
+    int32_t prefixBits;
+  };
+  // The pending row with the coarsest key change so far.
+  std::optional<Cut> bestCut_;
 };
 
 } // namespace facebook::velox::dwio::common
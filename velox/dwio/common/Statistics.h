@@ -523,6 +523,29 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of data pages skipped without decoding because their page level
+  // statistics do not match the column filter.
+  int64_t skippedPages{0};
+
+  // Total compressed bytes in data pages skipped based on page level
+  // statistics.
+  int64_t skippedPageBytes{0};
+
+  // Number of strides (row groups) skipped because their Bloom filters show
+  // that no value passes a column filter. Counted in 'skippedStrides' of
+  // RuntimeStatistics as well.
+  int64_t skippedStridesByBloomFilter{0};
+
+  // Number of strides (row groups) skipped because no value in their
+  // dictionary passes a column filter. Counted in 'skippedStrides' of
+  // RuntimeStatistics as well.
+  int64_t skippedStridesByDictionary{0};
+
+  // Number of rows of string dictionary columns whose filter result was taken
+  // from a per dictionary entry cache instead of testing the string of each
+  // row.
+  int64_t stringDictionaryFilteredRows{0};
 };
 
 struct RuntimeStatistics {
@@ -532,19 +555,63 @@ struct RuntimeStatistics {
   // Total bytes in splits skipped based on statistics.
   int64_t skippedSplitBytes{0};
 
+  // Number of the skipped splits whose partition key values did not pass a
+  // dynamic filter, e.g. from a join build side. These are skipped before
+  // their files are opened.
+  int64_t skippedSplitsByDynamicFilter{0};
+
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of splits whose deleted rows were found in, respectively added to,
+  // a cache of deletion bitmaps, e.g. for Iceberg positional deletes.
+  int64_t deleteBitmapCacheHits{0};
+  int64_t deleteBitmapCacheMisses{0};
+
+  // Number of rows removed by equality deletes, e.g. Iceberg equality delete
+  // files.
+  int64_t equalityDeletedRows{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
-    return {
+    std::unordered_map<std::string, RuntimeCounter> result = {
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
         {"flattenStringDictionaryValues",
-         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)},
+        {"skippedPages", RuntimeCounter(columnReaderStatistics.skippedPages)},
+        {"skippedPageBytes",
+         RuntimeCounter(
+             columnReaderStatistics.skippedPageBytes,
+             RuntimeCounter::Unit::kBytes)},
+        {"skippedStridesByBloomFilter",
+         RuntimeCounter(columnReaderStatistics.skippedStridesByBloomFilter)},
+        {"stringDictionaryFilteredRows",
+         RuntimeCounter(columnReaderStatistics.stringDictionaryFilteredRows)}};
+    if (deleteBitmapCacheHits > 0 || deleteBitmapCacheMisses > 0) {
+      result.emplace(
+          "deleteBitmapCacheHits", RuntimeCounter(deleteBitmapCacheHits));
+      result.emplace(
+          "deleteBitmapCacheMisses", RuntimeCounter(deleteBitmapCacheMisses));
+    }
+    if (columnReaderStatistics.skippedStridesByDictionary > 0) {
+      result.emplace(
+          "skippedStridesByDictionary",
+          RuntimeCounter(columnReaderStatistics.skippedStridesByDictionary));
+    }
+    if (skippedSplitsByDynamicFilter > 0) {
+      result.emplace(
+          "skippedSplitsByDynamicFilter",
+          RuntimeCounter(skippedSplitsByDynamicFilter));
+    }
+    if (equalityDeletedRows > 0) {
+      result.emplace(
+          "equalityDeletedRows", RuntimeCounter(equalityDeletedRows));
+    }
+    return result;
   }
 };
 
@@ -74,6 +74,13 @@ class Writer {
    */
   virtual void abort() = 0;
 
+  /// Returns the bytes of the file taken by indexes and filters that readers
+  /// use to skip data, e.g. the page indexes and Bloom filters of a Parquet
+  /// file. These are included in the file size. Valid after close().
+  virtual uint64_t indexBytesWritten() const {
+    return 0;
+  }
+
  protected:
   bool isRunning() const;
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/DecompressAheadInputStream.h"
+
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+DecompressAheadInputStream::DecompressAheadInputStream(
+    std::unique_ptr<PagedInputStream> input,
+    memory::MemoryPool& pool,
+    std::shared_ptr<io::IoStatistics> ioStats)
+    : inputName_(input->getName()) {
+  std::shared_ptr<PagedInputStream> sharedInput = std::move(input);
+  source_ = std::make_shared<AsyncSource<Chunks>>(
+      [sharedInput, &pool, ioStats = std::move(ioStats)]() {
+        uint64_t decompressUs{0};
+        std::unique_ptr<Chunks> chunks;
+        {
+          MicrosecondTimer timer(&decompressUs);
+          chunks = decompress(*sharedInput, pool);
+        }
+        if (ioStats != nullptr) {
+          ioStats->decompressAhead().increment(decompressUs);
+        }
+        return chunks;
+      });
+}
+
+DecompressAheadInputStream::~DecompressAheadInputStream() {
+  // Waits for a running decompression since it reads from the BufferedInput
+  // that 'this' came from.
+  source_->close();
+}
+
+// static
+std::unique_ptr<DecompressAheadInputStream::Chunks>
+DecompressAheadInputStream::decompress(
+    PagedInputStream& input,
+    memory::MemoryPool& pool) {
+  auto chunks = std::make_unique<Chunks>();
+  const void* data;
+  int32_t size;
+  while (input.Next(&data, &size)) {
+    if (size == 0) {
+      continue;
+    }
+    // An uncompressed block can be returned in several ranges.
+    const auto blockOffset = chunks->size + size - input.bytesReadInBlock();
+    chunks->blockOffsets.emplace(input.lastHeaderOffset(), blockOffset);
+    auto& chunk = chunks->chunks.emplace_back(pool, size);
+    chunk.offset = chunks->size;
+    ::memcpy(chunk.data.data(), data, size);
+    chunks->size += size;
+  }
+  return chunks;
+}
+
+void DecompressAheadInputStream::ensureChunks() {
+  if (chunks_ != nullptr) {
+    return;
+  }
+  chunks_ = source_->move();
+  VELOX_CHECK_NOT_NULL(chunks_, "Decompressed stream is gone: {}", getName());
+}
+
+bool DecompressAheadInputStream::Next(const void** data, int32_t* size) {
+  ensureChunks();
+  if (position_ >= chunks_->size) {
+    lastSize_ = 0;
+    return false;
+  }
+  const auto& allChunks = chunks_->chunks;
+  // Chunks are visited mostly in order, so start from the last one.
+  if (chunkIndex_ >= allChunks.size() ||
+      allChunks[chunkIndex_].offset > position_) {
+    chunkIndex_ = 0;
+  }
+  while (allChunks[chunkIndex_].offset + allChunks[chunkIndex_].data.size() <=
+         position_) {
+    ++chunkIndex_;
+  }
+  const auto& chunk = allChunks[chunkIndex_];
+  const auto offsetInChunk = position_ - chunk.offset;
+  *data = chunk.data.data() + offsetInChunk;
+  *size = static_cast<int32_t>(chunk.data.size() - offsetInChunk);
+  position_ += *size;
+  lastSize_ = *size;
+  return true;
+}
+
+void DecompressAheadInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_GE(count, 0);
+  VELOX_CHECK_LE(count, lastSize_, "Backup past last Next in {}", getName());
+  position_ -= count;
+  lastSize_ -= count;
+}
+
+bool DecompressAheadInputStream::SkipInt64(int64_t count) {
+  VELOX_CHECK_GE(count, 0);
+  ensureChunks();
+  position_ = std::min<uint64_t>(position_ + count, chunks_->size);
+  lastSize_ = 0;
+  return true;
+}
+
+void DecompressAheadInputStream::seekToPosition(
+    dwio::common::PositionProvider& positionProvider) {
+  const auto compressedOffset = positionProvider.next();
+  const auto uncompressedOffset = positionProvider.next();
+  ensureChunks();
+  auto it = chunks_->blockOffsets.find(compressedOffset);
+  if (it == chunks_->blockOffsets.end()) {
+    // Only the end of the stream is not the start of a block.
+    VELOX_CHECK_EQ(
+        uncompressedOffset,
+        0,
+        "Seek to {} is not at a block start in {}",
+        compressedOffset,
+        getName());
+    position_ = chunks_->size;
+  } else {
+    position_ = it->second + uncompressedOffset;
+    VELOX_CHECK_LE(position_, chunks_->size);
+  }
+  lastSize_ = 0;
+}
+
+std::string DecompressAheadInputStream::getName() const {
+  return fmt::format("DecompressAheadInputStream of {}", inputName_);
+}
+
+} // namespace facebook::velox::dwio::common::compression
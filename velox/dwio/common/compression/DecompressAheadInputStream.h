@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+/// Decompresses a whole PagedInputStream on an executor ahead of its
+/// consumption, so that the thread reading the stream only decodes. The
+/// decompression is started by the task of decompressTask(), which is to be
+/// added to the executor once the wrapped stream's data is loaded. The
+/// decompressed stream is held in memory of 'pool' until 'this' is destroyed.
+/// If the reader gets to the stream before the executor, the reader
+/// decompresses it. Positions are the same as for the wrapped stream.
+class DecompressAheadInputStream : public dwio::common::SeekableInputStream {
+ public:
+  /// Streams of more compressed bytes are decompressed on demand, to bound the
+  /// memory held by a stream.
+  static constexpr uint64_t kMaxCompressedBytes = 16 << 20;
+
+  /// Wraps 'input', which must not have been read. The time spent
+  /// decompressing it is added to the decompressAhead() counter of 'ioStats'
+  /// if not nullptr.
+  DecompressAheadInputStream(
+      std::unique_ptr<PagedInputStream> input,
+      memory::MemoryPool& pool,
+      std::shared_ptr<io::IoStatistics> ioStats);
+
+  ~DecompressAheadInputStream() override;
+
+  /// Returns a task that decompresses the stream if the reader has not done
+  /// so yet. The task may run after 'this' is destroyed and then does nothing.
+  std::function<void()> decompressTask() const {
+    return [source = source_]() { source->prepare(); };
+  }
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override;
+
+  bool SkipInt64(int64_t count) override;
+
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override;
+
+  size_t positionSize() override {
+    return 2;
+  }
+
+ private:
+  // A range of the decompressed stream.
+  struct Chunk {
+    Chunk(memory::MemoryPool& pool, uint64_t size) : data(pool, size) {}
+
+    // Offset of the range in the decompressed stream.
+    uint64_t offset{0};
+    dwio::common::DataBuffer<char> data;
+  };
+
+  struct Chunks {
+    std::vector<Chunk> chunks;
+    // Offset in the decompressed stream of the start of each block, keyed on
+    // the offset of the block in the compressed stream.
+    folly::F14FastMap<uint64_t, uint64_t> blockOffsets;
+    // Size of the decompressed stream.
+    uint64_t size{0};
+  };
+
+  // Reads all of 'input' into Chunks.
+  static std::unique_ptr<Chunks> decompress(
+      PagedInputStream& input,
+      memory::MemoryPool& pool);
+
+  // Gets the decompressed stream, waiting for or running the decompression.
+  void ensureChunks();
+
+  const std::string inputName_;
+  std::shared_ptr<AsyncSource<Chunks>> source_;
+  std::unique_ptr<Chunks> chunks_;
+
+  // Offset of the next byte to return in the decompressed stream.
+  uint64_t position_{0};
+  // Index in 'chunks_' of the chunk containing 'position_'.
+  int32_t chunkIndex_{0};
+  // Size returned by the last Next().
+  int32_t lastSize_{0};
+};
+
+} // namespace facebook::velox::dwio::common::compression
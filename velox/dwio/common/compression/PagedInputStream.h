@@ -80,6 +80,18 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     return 2;
   }
 
+  /// Returns the offset in the compressed input of the header of the block
+  /// that the last range returned by Next() belongs to.
+  uint64_t lastHeaderOffset() const {
+    return lastHeaderOffset_;
+  }
+
+  /// Returns the number of bytes returned or skipped from the block at
+  /// lastHeaderOffset().
+  uint64_t bytesReadInBlock() const {
+    return bytesReturned_ - bytesReturnedAtLastHeaderOffset_;
+  }
+
  protected:
   // Special constructor used by ZlibDecompressionStream
   PagedInputStream(
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptiveCoalescer.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/File.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+constexpr AdaptiveCoalescer::Limits kDefaults{512 << 10, 128 << 20};
+
+// Records reads of sizes from 8KB to 8MB that take 'latencyMicros' plus the
+// transfer at 'bytesPerMicro'. Powers of 2 keep the times exact.
+void recordReads(
+    AdaptiveCoalescer& coalescer,
+    double latencyMicros,
+    double bytesPerMicro,
+    int32_t numReads) {
+  for (auto i = 0; i < numReads; ++i) {
+    const uint64_t bytes = (8 << 10) << (i % 11);
+    coalescer.recordRead(bytes, latencyMicros + bytes / bytesPerMicro);
+  }
+}
+
+TEST(AdaptiveCoalescerTest, defaultsWithFewReads) {
+  AdaptiveCoalescer coalescer("test");
+  recordReads(coalescer, 30'000, 100, AdaptiveCoalescer::kMinSamples - 1);
+  EXPECT_FALSE(coalescer.model().has_value());
+  const auto limits = coalescer.limits(kDefaults);
+  EXPECT_EQ(limits.maxCoalesceDistance, kDefaults.maxCoalesceDistance);
+  EXPECT_EQ(limits.maxCoalesceBytes, kDefaults.maxCoalesceBytes);
+}
+
+TEST(AdaptiveCoalescerTest, objectStore) {
+  // 30ms to first byte and 128MB/s: reads 3.8MB apart are worth coalescing.
+  AdaptiveCoalescer coalescer("test");
+  recordReads(coalescer, 30'000, 128, 100);
+  const auto model = coalescer.model();
+  ASSERT_TRUE(model.has_value());
+  EXPECT_NEAR(model->latencyMicros, 30'000, 1);
+  EXPECT_NEAR(model->bytesPerMicro, 128, 0.01);
+  const auto limits = coalescer.limits(kDefaults);
+  EXPECT_NEAR(limits.maxCoalesceDistance, 3'840'000, 1'000);
+  EXPECT_NEAR(limits.maxCoalesceBytes, 30'720'000, 8'000);
+
+  // The coalesced bytes do not go over the default.
+  const auto capped = coalescer.limits({512 << 10, 16 << 20});
+  EXPECT_EQ(capped.maxCoalesceBytes, 16 << 20);
+}
+
+TEST(AdaptiveCoalescerTest, localSsd) {
+  // 20us and 1GB/s: only reads a few KB apart are worth coalescing.
+  AdaptiveCoalescer coalescer("test");
+  recordReads(coalescer, 20, 1'024, 100);
+  const auto limits = coalescer.limits(kDefaults);
+  EXPECT_NEAR(limits.maxCoalesceDistance, 20'480, 10);
+  EXPECT_EQ(limits.maxCoalesceBytes, AdaptiveCoalescer::kMinCoalesceBytes);
+}
+
+TEST(AdaptiveCoalescerTest, followsChange) {
+  AdaptiveCoalescer coalescer("test");
+  recordReads(coalescer, 20, 1'024, 100);
+  recordReads(coalescer, 30'000, 128, 2'000);
+  EXPECT_NEAR(coalescer.model()->latencyMicros, 30'000, 100);
+}
+
+TEST(AdaptiveCoalescerTest, noModel) {
+  AdaptiveCoalescer coalescer("test");
+  // Same size reads cannot tell latency from bandwidth.
+  for (auto i = 0; i < 100; ++i) {
+    coalescer.recordRead(1 << 20, 1'000 + i % 7);
+  }
+  EXPECT_FALSE(coalescer.model().has_value());
+
+  // Larger reads that are not slower do not fit the model.
+  AdaptiveCoalescer flat("flat");
+  for (auto i = 0; i < 100; ++i) {
+    flat.recordRead((8 << 10) << (i % 11), 1'000);
+  }
+  EXPECT_FALSE(flat.model().has_value());
+  const auto limits = flat.limits(kDefaults);
+  EXPECT_EQ(limits.maxCoalesceDistance, kDefaults.maxCoalesceDistance);
+  EXPECT_EQ(flat.toString(), "AdaptiveCoalescer flat: 100 reads, no model");
+}
+
+TEST(AdaptiveCoalescerTest, instancePerFileType) {
+  InMemoryReadFile first(std::string("abc"));
+  InMemoryReadFile second(std::string("def"));
+  EXPECT_EQ(
+      &AdaptiveCoalescer::instance(first),
+      &AdaptiveCoalescer::instance(second));
+}
+
+} // namespace
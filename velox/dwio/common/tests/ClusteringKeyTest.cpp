@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ClusteringKey.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class ClusteringKeyTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Returns the rows of 'input' in the order of their clustering keys.
+  std::vector<vector_size_t> sortedRows(
+      const RowVectorPtr& input,
+      const std::vector<column_index_t>& keyChannels,
+      bool interleave) {
+    auto keys = makeClusteringKeys(*input, keyChannels, interleave, pool());
+    auto* flatKeys = keys->asFlatVector<StringView>();
+    std::vector<vector_size_t> rows(input->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+      return flatKeys->valueAt(left) < flatKeys->valueAt(right);
+    });
+    return rows;
+  }
+};
+
+TEST_F(ClusteringKeyTest, concatenated) {
+  auto input = makeRowVector({
+      makeNullableFlatVector<int32_t>({5, -3, std::nullopt, 5, -3, 0}),
+      makeFlatVector<double>({1.5, 2.0, 0.0, -7.25, -1.0, 0.0}),
+      makeFlatVector<std::string>({"b", "a", "c", "ab", "", "d"}),
+  });
+  EXPECT_EQ(
+      sortedRows(input, {0, 1}, false),
+      (std::vector<vector_size_t>{2, 4, 1, 5, 3, 0}));
+  EXPECT_EQ(
+      sortedRows(input, {2}, false),
+      (std::vector<vector_size_t>{4, 1, 3, 0, 2, 5}));
+}
+
+TEST_F(ClusteringKeyTest, zOrder) {
+  // All points of a 4 x 4 grid in row major order.
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(16, [](auto row) { return row / 4; }),
+      makeFlatVector<int64_t>(16, [](auto row) { return row % 4; }),
+  });
+  const auto rows = sortedRows(input, {0, 1}, true);
+  // Each run of 4 rows in Z-order covers one 2 x 2 quadrant.
+  EXPECT_EQ(
+      rows,
+      (std::vector<vector_size_t>{
+          0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15}));
+
+  auto keys = makeClusteringKeys(*input, {0, 1}, true, pool());
+  auto* flatKeys = keys->asFlatVector<StringView>();
+  const auto key = [&](auto row) {
+    const auto value = flatKeys->valueAt(row);
+    return std::string_view(value.data(), value.size());
+  };
+  ASSERT_EQ(key(0).size(), 16);
+  // The boundary between quadrants is coarser than the one within them.
+  EXPECT_LT(commonPrefixBits(key(5), key(2)), commonPrefixBits(key(4), key(5)));
+  EXPECT_LT(
+      commonPrefixBits(key(7), key(8)), commonPrefixBits(key(5), key(2)));
+}
+
+TEST_F(ClusteringKeyTest, commonPrefixBits) {
+  EXPECT_EQ(commonPrefixBits("abc", "abc"), 24);
+  EXPECT_EQ(commonPrefixBits("", "abc"), 0);
+  EXPECT_EQ(commonPrefixBits("\x80", "\x00"), 0);
+  EXPECT_EQ(commonPrefixBits("a\x01", "a\x03"), 14);
+}
+
+TEST_F(ClusteringKeyTest, unsupportedType) {
+  auto input = makeRowVector({makeArrayVector<int32_t>({{1, 2}})});
+  VELOX_ASSERT_THROW(
+      makeClusteringKeys(*input, {0}, true, pool()),
+      "Unsupported type for a clustering key: ARRAY<INTEGER>");
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
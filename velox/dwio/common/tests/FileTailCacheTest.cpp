@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileTailCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+class TestTail : public FileTail {
+ public:
+  explicit TestTail(uint64_t bytes) : FileTail(10), bytes_(bytes) {}
+
+  uint64_t memoryBytes() const override {
+    return bytes_;
+  }
+
+ private:
+  const uint64_t bytes_;
+};
+
+class FileTailCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  static FileTailKey key(const std::string& path, int64_t modificationTime) {
+    return FileTailKey{path, 1'000, modificationTime, FileFormat::DWRF};
+  }
+
+  FileTailCache cache_{1'000, memory::memoryManager()->addLeafPool()};
+};
+
+} // namespace
+
+TEST_F(FileTailCacheTest, getAndPut) {
+  ASSERT_EQ(cache_.get(key("a", 0)), nullptr);
+  auto tail = std::make_shared<TestTail>(100);
+  cache_.put(key("a", 0), tail);
+  ASSERT_EQ(cache_.get(key("a", 0)), tail);
+  ASSERT_EQ(cache_.get(key("a", 0))->parseMicros(), 10);
+  // Another version or format of the same path misses.
+  ASSERT_EQ(cache_.get(key("a", 1)), nullptr);
+  ASSERT_EQ(
+      cache_.get(FileTailKey{"a", 1'000, 0, FileFormat::PARQUET}), nullptr);
+
+  const auto stats = cache_.stats();
+  ASSERT_EQ(stats.numHits, 2);
+  ASSERT_EQ(stats.numMisses, 3);
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_EQ(stats.memoryBytes, 100);
+}
+
+TEST_F(FileTailCacheTest, evictLeastRecentlyUsed) {
+  cache_.put(key("a", 0), std::make_shared<TestTail>(400));
+  cache_.put(key("b", 0), std::make_shared<TestTail>(400));
+  // 'a' becomes the most recently used.
+  ASSERT_NE(cache_.get(key("a", 0)), nullptr);
+  cache_.put(key("c", 0), std::make_shared<TestTail>(400));
+  ASSERT_EQ(cache_.get(key("b", 0)), nullptr);
+  ASSERT_NE(cache_.get(key("a", 0)), nullptr);
+  ASSERT_NE(cache_.get(key("c", 0)), nullptr);
+
+  // A tail larger than the capacity is not cached.
+  cache_.put(key("d", 0), std::make_shared<TestTail>(2'000));
+  ASSERT_EQ(cache_.get(key("d", 0)), nullptr);
+
+  auto stats = cache_.stats();
+  ASSERT_EQ(stats.numEvicted, 1);
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_EQ(stats.memoryBytes, 800);
+
+  cache_.clear();
+  stats = cache_.stats();
+  ASSERT_EQ(stats.numEntries, 0);
+  ASSERT_EQ(stats.memoryBytes, 0);
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <folly/lang/Bits.h>
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+// Constants of the 64-bit Murmur3 hash used by the ORC Bloom filter.
+constexpr uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+constexpr int32_t kMurmurR1 = 31;
+constexpr int32_t kMurmurR2 = 27;
+constexpr uint64_t kMurmurM = 5;
+constexpr uint64_t kMurmurN1 = 0x52dce729;
+constexpr uint64_t kMurmurSeed = 104729;
+
+uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+uint64_t fmix64(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Returns the position of the bit set by the 'i'th hash function for 'hash'.
+// Wraps around like the 32-bit signed arithmetic of the writer.
+uint64_t bitPosition(uint64_t hash, int32_t i, uint64_t numBits) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  auto combined = static_cast<int32_t>(hash1 + i * hash2);
+  if (combined < 0) {
+    combined = ~combined;
+  }
+  return combined % numBits;
+}
+
+} // namespace
+
+OrcBloomFilter::OrcBloomFilter(
+    std::vector<uint64_t> bitset,
+    int32_t numHashFunctions)
+    : bitset_(std::move(bitset)), numHashFunctions_(numHashFunctions) {
+  VELOX_CHECK(!bitset_.empty(), "Bloom filter bitset must not be empty");
+  VELOX_CHECK_GT(numHashFunctions_, 0);
+}
+
+OrcBloomFilter::OrcBloomFilter(
+    std::string_view bitsetBytes,
+    int32_t numHashFunctions)
+    : numHashFunctions_(numHashFunctions) {
+  VELOX_CHECK_EQ(
+      bitsetBytes.size() % sizeof(uint64_t),
+      0,
+      "Bloom filter bitset size must be a multiple of 8");
+  bitset_.resize(bitsetBytes.size() / sizeof(uint64_t));
+  for (auto i = 0; i < bitset_.size(); ++i) {
+    bitset_[i] = folly::Endian::little(folly::loadUnaligned<uint64_t>(
+        bitsetBytes.data() + i * sizeof(uint64_t)));
+  }
+  VELOX_CHECK(!bitset_.empty(), "Bloom filter bitset must not be empty");
+  VELOX_CHECK_GT(numHashFunctions_, 0);
+}
+
+void OrcBloomFilter::addHash(uint64_t hash) {
+  const uint64_t numBits = bitset_.size() * 64;
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    const auto position = bitPosition(hash, i, numBits);
+    bitset_[position / 64] |= 1ULL << (position % 64);
+  }
+}
+
+bool OrcBloomFilter::testHash(uint64_t hash) const {
+  const uint64_t numBits = bitset_.size() * 64;
+  for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+    const auto position = bitPosition(hash, i, numBits);
+    if (!(bitset_[position / 64] & (1ULL << (position % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+uint64_t OrcBloomFilter::hash(int64_t value) {
+  // Thomas Wang's integer hash. The right shifts are arithmetic.
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key ^= static_cast<uint64_t>(static_cast<int64_t>(key) >> 24);
+  key = key + (key << 3) + (key << 8);
+  key ^= static_cast<uint64_t>(static_cast<int64_t>(key) >> 14);
+  key = key + (key << 2) + (key << 4);
+  key ^= static_cast<uint64_t>(static_cast<int64_t>(key) >> 28);
+  key = key + (key << 31);
+  return key;
+}
+
+// static
+uint64_t OrcBloomFilter::hash(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  uint64_t hash = kMurmurSeed;
+  const auto numBlocks = length / 8;
+  for (auto i = 0; i < numBlocks; ++i) {
+    auto k =
+        folly::Endian::little(folly::loadUnaligned<uint64_t>(data + i * 8));
+    k *= kMurmurC1;
+    k = rotateLeft(k, kMurmurR1);
+    k *= kMurmurC2;
+    hash ^= k;
+    hash = rotateLeft(hash, kMurmurR2) * kMurmurM + kMurmurN1;
+  }
+  const auto tailStart = numBlocks * 8;
+  if (tailStart < length) {
+    uint64_t k = 0;
+    for (auto i = 0; i < length - tailStart; ++i) {
+      k |= static_cast<uint64_t>(data[tailStart + i]) << (i * 8);
+    }
+    k *= kMurmurC1;
+    k = rotateLeft(k, kMurmurR1);
+    k *= kMurmurC2;
+    hash ^= k;
+  }
+  hash ^= length;
+  return fmix64(hash);
+}
+
+// static
+bool OrcBloomFilter::isEqualityFilter(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesRange:
+      return static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool OrcBloomFilter::mayContain(
+    const common::Filter& filter,
+    ValueKind kind) const {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      return !range.isSingleValue() || mayContainInteger(range.lower(), kind);
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](auto value) {
+        return mayContainInteger(value, kind);
+      });
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      auto values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](auto value) {
+        return mayContainInteger(value, kind);
+      });
+    }
+    case common::FilterKind::kBytesRange: {
+      if (kind != ValueKind::kBytes) {
+        return true;
+      }
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      return !range.isSingleValue() || testHash(hash(range.lower()));
+    }
+    case common::FilterKind::kBytesValues: {
+      if (kind != ValueKind::kBytes) {
+        return true;
+      }
+      auto& values = static_cast<const common::BytesValues&>(filter).values();
+      return std::any_of(values.begin(), values.end(), [&](const auto& value) {
+        return testHash(hash(std::string_view(value)));
+      });
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::dwrf
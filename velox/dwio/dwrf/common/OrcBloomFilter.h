@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::dwrf {
+
+/// The Bloom filter of the BLOOM_FILTER_UTF8 stream of ORC and DWRF files.
+/// Each value sets 'numHashFunctions' bits of a bitset of 64-bit words, chosen
+/// by double hashing of a 64-bit hash. Integers are hashed with Thomas Wang's
+/// 64-bit mix and strings with the 64-bit Murmur3 variant of Hive, over their
+/// UTF-8 bytes.
+class OrcBloomFilter {
+ public:
+  /// Type of the values in the filter. Determines how values of the Velox
+  /// filter are hashed.
+  enum class ValueKind { kInteger, kBytes };
+
+  OrcBloomFilter(std::vector<uint64_t> bitset, int32_t numHashFunctions);
+
+  /// Makes a filter from the 'utf8bitset' field of the BloomFilter proto, the
+  /// little endian bytes of the bitset.
+  OrcBloomFilter(std::string_view bitsetBytes, int32_t numHashFunctions);
+
+  void addHash(uint64_t hash);
+
+  /// Returns false if the value with 'hash' is definitely not in 'this'.
+  bool testHash(uint64_t hash) const;
+
+  /// Returns false if no value that passes 'filter' can be in 'this'. Only
+  /// equality and IN filters are tested, other filters return true.
+  bool mayContain(const common::Filter& filter, ValueKind kind) const;
+
+  /// True if 'filter' is an equality or IN filter that mayContain() can test.
+  static bool isEqualityFilter(const common::Filter& filter);
+
+  const std::vector<uint64_t>& bitset() const {
+    return bitset_;
+  }
+
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+ private:
+  bool mayContainInteger(int64_t value, ValueKind kind) const {
+    return kind != ValueKind::kInteger || testHash(hash(value));
+  }
+
+  std::vector<uint64_t> bitset_;
+  const int32_t numHashFunctions_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <folly/lang/Bits.h>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -59,9 +62,58 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     }
   }
 
+  // Reads 'numValues' consecutive values into 'result'.
+  template <typename T>
+  void bulkRead(uint64_t numValues, T* result) {
+    skipPending();
+    if constexpr (std::is_same_v<T, int64_t>) {
+      doNext(result, numValues, nullptr);
+    } else {
+      int64_t buffer[kBulkBatchSize];
+      for (uint64_t i = 0; i < numValues; i += kBulkBatchSize) {
+        const auto numInBatch = std::min(kBulkBatchSize, numValues - i);
+        doNext(buffer, numInBatch, nullptr);
+        for (uint64_t j = 0; j < numInBatch; ++j) {
+          result[i + j] = buffer[j];
+        }
+      }
+    }
+  }
+
+  // Reads the values at positions 'rows' into 'result'. 'initialRow' is the
+  // row number of the first unread value. Values between the rows are decoded
+  // in batches and dropped, which is cheaper than decoding them one by one.
+  template <typename T>
+  void bulkReadRows(
+      folly::Range<const int32_t*> rows,
+      T* result,
+      int32_t initialRow = 0) {
+    skipPending();
+    int64_t buffer[kBulkBatchSize];
+    int32_t row = initialRow;
+    for (int32_t i = 0; i < rows.size();) {
+      if (rows[i] > row) {
+        this->pendingSkip = rows[i] - row;
+        skipPending();
+        row = rows[i];
+      }
+      const auto numInBatch = std::min<int32_t>(
+          kBulkBatchSize, rows[rows.size() - 1] + 1 - row);
+      doNext(buffer, numInBatch, nullptr);
+      for (; i < rows.size() && rows[i] < row + numInBatch; ++i) {
+        result[i] = buffer[rows[i] - row];
+      }
+      row += numInBatch;
+    }
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +152,101 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  // Number of values decoded at a time by the bulk paths. Values are filtered
+  // a batch at a time while the batch is in cache.
+  static constexpr uint64_t kBulkBatchSize = 64;
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Decodes the values at 'nonNullRows' a batch at a time and passes each
+  // batch to the visitor, which applies the filter and hook to the decoded
+  // values before the next batch is decoded.
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    int32_t currentRow = 0;
+    for (int32_t rowIndex = 0; rowIndex < numRows;) {
+      const auto numInBatch =
+          std::min<int32_t>(kBulkBatchSize, numRows - rowIndex);
+      if (Visitor::dense) {
+        bulkRead(numInBatch, values + numValues);
+      } else {
+        bulkReadRows(
+            folly::Range<const int32_t*>(rows + rowIndex, numInBatch),
+            values + numValues,
+            currentRow);
+      }
+      currentRow = rows[rowIndex + numInBatch - 1] + 1;
+      visitor.template processRun<hasFilter, hasHook, scatter>(
+          values + numValues,
+          numInBatch,
+          scatterRows,
+          filterHits,
+          values,
+          numValues);
+      rowIndex += numInBatch;
+    }
+    visitor.setNumValues(hasFilter ? numValues : numAllRows);
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -158,9 +305,11 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t len,
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
+    if (!nulls && bitsLeft == 0 && unpackFromBuffer(data + offset, len, fb)) {
+      return len;
+    }
     uint64_t ret = 0;
 
-    // TODO: unroll to improve performance
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -189,6 +338,65 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Unpacks 'numValues' big endian values of 'bitWidth' bits that start at
+  // the current byte of the input buffer. Returns false without consuming
+  // anything if the values do not end inside the buffer. Reads 64 bits at a
+  // time where the buffer allows instead of one byte at a time.
+  bool unpackFromBuffer(int64_t* data, uint64_t numValues, uint64_t bitWidth) {
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const uint64_t numBits = numValues * bitWidth;
+    const uint64_t numBytes = bits::nbytes(numBits);
+    const uint64_t available =
+        dwio::common::IntDecoder<isSigned>::bufferEnd - bufferStart;
+    if (numBytes > available) {
+      return false;
+    }
+    const auto* bytes = reinterpret_cast<const uint8_t*>(bufferStart);
+    // Values that start at least 8 bytes before the end of the buffer are read
+    // with an unaligned 64 bit load. Widths that are not a multiple of 8 are at
+    // most 30 bits, so that a value and its offset in the first byte fit in 64
+    // bits.
+    uint64_t bitOffset = 0;
+    uint64_t i = 0;
+    if (bitWidth % 8 == 0) {
+      const auto shift = 64 - bitWidth;
+      for (; i < numValues && bitOffset / 8 + 8 <= available; ++i) {
+        const auto word = folly::Endian::big(
+            folly::loadUnaligned<uint64_t>(bytes + bitOffset / 8));
+        data[i] = static_cast<int64_t>(shift == 0 ? word : word >> shift);
+        bitOffset += bitWidth;
+      }
+    } else {
+      for (; i < numValues && bitOffset / 8 + 8 <= available; ++i) {
+        const auto word = folly::Endian::big(
+            folly::loadUnaligned<uint64_t>(bytes + bitOffset / 8));
+        data[i] =
+            static_cast<int64_t>((word << (bitOffset % 8)) >> (64 - bitWidth));
+        bitOffset += bitWidth;
+      }
+    }
+    for (; i < numValues; ++i) {
+      uint64_t value = 0;
+      for (auto remaining = bitWidth; remaining > 0;) {
+        const auto bitInByte = bitOffset % 8;
+        const auto take = std::min<uint64_t>(8 - bitInByte, remaining);
+        value = (value << take) |
+            ((bytes[bitOffset / 8] >> (8 - bitInByte - take)) &
+             ((1U << take) - 1));
+        bitOffset += take;
+        remaining -= take;
+      }
+      data[i] = static_cast<int64_t>(value);
+    }
+    bufferStart += numBytes;
+    if (numBits % 8 != 0) {
+      // The rest of the last byte is read by the next call.
+      curByte = bytes[numBytes - 1];
+      bitsLeft = 8 - numBits % 8;
+    }
+    return true;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
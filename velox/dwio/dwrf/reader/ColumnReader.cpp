@@ -1159,12 +1159,15 @@ StringDictionaryColumnReader::StringDictionaryColumnReader(
   lengthDecoder_ = makeRleDecoder(
       params, streamLabels.label(), false, proto::Stream_Kind_LENGTH);
 
-  // handle in dictionary stream
+  // handle in dictionary stream. ORC has no stride dictionaries and uses the
+  // number of IN_DICTIONARY for BLOOM_FILTER streams.
   std::unique_ptr<dwio::common::SeekableInputStream> inDictStream =
-      stripe.getStream(
-          encodingKey.forKind(proto::Stream_Kind_IN_DICTIONARY),
-          streamLabels.label(),
-          false);
+      stripe.format() == DwrfFormat::kDwrf
+      ? stripe.getStream(
+            encodingKey.forKind(proto::Stream_Kind_IN_DICTIONARY),
+            streamLabels.label(),
+            false)
+      : nullptr;
   if (inDictStream) {
     inDictionaryReader_ =
         createBooleanRleDecoder(std::move(inDictStream), encodingKey);
@@ -20,14 +20,44 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+// Returns how the writer hashed the values of a column of 'type' into Bloom
+// filters, or std::nullopt if Velox filter values are not hashed the same way.
+std::optional<OrcBloomFilter::ValueKind> bloomFilterValueKind(
+    const Type& type) {
+  if (type.isDecimal()) {
+    return std::nullopt;
+  }
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return OrcBloomFilter::ValueKind::kInteger;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return OrcBloomFilter::ValueKind::kBytes;
+    default:
+      return std::nullopt;
+  }
+}
+
+} // namespace
+
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    const common::ScanSpec* scanSpec,
+    dwio::common::ColumnReaderStatistics* stats)
     : memoryPool_(stripe.getMemoryPool()),
+      format_(stripe.format()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
+      bloomFilterKind_(bloomFilterValueKind(*fileType_->type())),
+      stats_(stats),
       stripeRows_{stripe.stripeRows()},
       rowsPerRowGroup_{stripe.rowsPerRowGroup()} {
   EncodingKey encodingKey{fileType_->id(), flatMapContext_.sequence};
@@ -47,6 +77,24 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+
+  // Bloom filters are only read for filters known at construct time, since
+  // they are larger than the index and rarely useful for other filters. Like
+  // the index, they are read through the stripe's cached input and decoded on
+  // first use.
+  if (bloomFilterKind_.has_value() && scanSpec && scanSpec->filter() &&
+      scanSpec->disjunction() == common::ScanSpec::kNoDisjunction &&
+      !scanSpec->filter()->testNull() &&
+      OrcBloomFilter::isEqualityFilter(*scanSpec->filter())) {
+    // ORC stripe footers are read with the DWRF protos, where the ORC
+    // BLOOM_FILTER_UTF8 kind has the number of STRIDE_DICTIONARY.
+    const auto bloomFilterKind = format_ == DwrfFormat::kOrc
+        ? static_cast<proto::Stream_Kind>(
+              proto::orc::Stream_Kind_BLOOM_FILTER_UTF8)
+        : proto::Stream_Kind_BLOOM_FILTER_UTF8;
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(bloomFilterKind), streamLabels.label(), false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -84,11 +132,64 @@ uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
 
 void DwrfData::ensureRowGroupIndex() {
   VELOX_CHECK(index_ || indexStream_, "Reader needs to have an index stream");
-  if (indexStream_) {
+  if (!indexStream_) {
+    return;
+  }
+  if (format_ == DwrfFormat::kOrc) {
+    orcIndex_ =
+        ProtoUtils::readProto<proto::orc::RowIndex>(std::move(indexStream_));
+    index_ = std::make_unique<proto::RowIndex>();
+    for (const auto& entry : orcIndex_->entry()) {
+      *index_->add_entry()->mutable_positions() = entry.positions();
+    }
+  } else {
     index_ = ProtoUtils::readProto<proto::RowIndex>(std::move(indexStream_));
   }
 }
 
+void DwrfData::ensureBloomFilters() {
+  if (!bloomFilterStream_) {
+    return;
+  }
+  auto index = ProtoUtils::readProto<proto::BloomFilterIndex>(
+      std::move(bloomFilterStream_));
+  bloomFilters_.reserve(index->bloomfilter_size());
+  for (const auto& bloomFilter : index->bloomfilter()) {
+    if (bloomFilter.numhashfunctions() == 0 ||
+        (bloomFilter.bitset_size() == 0 &&
+         (bloomFilter.utf8bitset().empty() ||
+          bloomFilter.utf8bitset().size() % sizeof(uint64_t) != 0))) {
+      // Ignores all Bloom filters of the column if any is malformed.
+      bloomFilters_.clear();
+      return;
+    }
+    if (bloomFilter.bitset_size() > 0) {
+      bloomFilters_.emplace_back(
+          std::vector<uint64_t>(
+              bloomFilter.bitset().begin(), bloomFilter.bitset().end()),
+          bloomFilter.numhashfunctions());
+    } else {
+      bloomFilters_.emplace_back(
+          std::string_view(bloomFilter.utf8bitset()),
+          bloomFilter.numhashfunctions());
+    }
+  }
+}
+
+bool DwrfData::bloomFilterMatches(
+    uint32_t index,
+    const common::Filter& filter) {
+  if (!bloomFilterKind_.has_value() || filter.testNull() ||
+      !OrcBloomFilter::isEqualityFilter(filter)) {
+    return true;
+  }
+  ensureBloomFilters();
+  if (index >= bloomFilters_.size()) {
+    return true;
+  }
+  return bloomFilters_[index].mayContain(filter, bloomFilterKind_.value());
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(uint32_t index) {
   ensureRowGroupIndex();
   tempPositions_ = toPositionsInner(index_->entry(index));
@@ -145,7 +246,10 @@ void DwrfData::filterRowGroups(
     return;
   }
   ensureRowGroupIndex();
-  auto filter = scanSpec.filter();
+  // A member of a disjunction cannot drop a stride on its own.
+  auto filter = scanSpec.disjunction() == common::ScanSpec::kNoDisjunction
+      ? scanSpec.filter()
+      : nullptr;
   auto dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
   result.totalCount = std::max(result.totalCount, index_->entry_size());
   auto nwords = bits::nwords(result.totalCount);
@@ -158,9 +262,10 @@ void DwrfData::filterRowGroups(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
   for (auto i = 0; i < index_->entry_size(); i++) {
-    const auto& entry = index_->entry(i);
     auto columnStats = buildColumnStatisticsFromProto(
-        ColumnStatisticsWrapper(&entry.statistics()), *dwrfContext);
+        orcIndex_ ? ColumnStatisticsWrapper(&orcIndex_->entry(i).statistics())
+                  : ColumnStatisticsWrapper(&index_->entry(i).statistics()),
+        *dwrfContext);
     if (filter &&
         !testFilter(
             filter, columnStats.get(), rowGroupSize, fileType_->type())) {
@@ -168,6 +273,15 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (filter && !bloomFilterMatches(i, *filter)) {
+      VLOG(1) << "Drop stride " << i << " by Bloom filter on "
+              << scanSpec.toString();
+      if (stats_ && !bits::isBitSet(result.filterResult.data(), i)) {
+        ++stats_->skippedStridesByBloomFilter;
+      }
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
       if (!testFilter(
@@ -21,8 +21,10 @@
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+#include "velox/dwio/dwrf/common/wrap/orc-proto-wrapper.h"
 #include "velox/dwio/dwrf/reader/EncodingContext.h"
 #include "velox/dwio/dwrf/reader/StripeStream.h"
 #include "velox/vector/BaseVector.h"
@@ -32,11 +34,16 @@ namespace facebook::velox::dwrf {
 // DWRF specific functions shared between all readers.
 class DwrfData : public dwio::common::FormatData {
  public:
+  /// Reads the Bloom filters of the column if 'scanSpec' is given and has an
+  /// equality or IN filter. Row groups skipped by Bloom filters are counted in
+  /// 'stats' if given.
   DwrfData(
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      const common::ScanSpec* scanSpec = nullptr,
+      dwio::common::ColumnReaderStatistics* stats = nullptr);
 
   void readNulls(
       vector_size_t numValues,
@@ -99,12 +106,32 @@ class DwrfData : public dwio::common::FormatData {
         entry.positions().begin(), entry.positions().end());
   }
 
+  // Decodes the Bloom filters of the row groups from 'bloomFilterStream_' if
+  // not already decoded.
+  void ensureBloomFilters();
+
+  // False if the Bloom filter of row group 'index' shows that no value that
+  // passes 'filter' is in the row group.
+  bool bloomFilterMatches(uint32_t index, const common::Filter& filter);
+
   memory::MemoryPool& memoryPool_;
+  const DwrfFormat format_;
   const std::shared_ptr<const dwio::common::TypeWithId> fileType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<ByteRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // The row index of an ORC file. Its statistics have different field numbers
+  // than in DWRF. 'index_' has the same positions.
+  std::unique_ptr<proto::orc::RowIndex> orcIndex_;
+  // Kind of the values in the Bloom filters of the column. Not set if the
+  // values of the column type are not hashed like filter values.
+  std::optional<OrcBloomFilter::ValueKind> bloomFilterKind_;
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  // Bloom filters of the row groups, empty if the stripe has no Bloom filters
+  // for the column or they have not been read.
+  std::vector<OrcBloomFilter> bloomFilters_;
+  dwio::common::ColumnReaderStatistics* const stats_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -132,9 +159,14 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type,
+        stripeStreams_,
+        streamLabels_,
+        flatMapContext_,
+        &scanSpec,
+        &runtimeStatistics());
   }
 
   StripeStreams& stripeStreams() {
@@ -194,6 +194,8 @@ void DwrfUnit::loadDecoders() {
   if (!preloaded_) {
     VLOG(1) << "[DWRF] Load read plan for stripe " << stripeIndex_;
     stripeStreams_->loadReadPlan();
+  } else {
+    stripeStreams_->startDecompressAhead();
   }
 
   stripeDictionaryCache_ = stripeStreams_->getStripeDictionaryCache();
@@ -505,6 +507,43 @@ void DwrfRowReader::checkSkipStrides(uint64_t strideSize) {
   }
 }
 
+bool DwrfRowReader::startStripePart(uint64_t strideSize) {
+  const uint64_t numParts = options_.getNumStripeParts();
+  if (numParts == 1) {
+    return true;
+  }
+  const uint64_t part = options_.getStripePart();
+  const uint64_t numStripeRows = currentUnit_->getNumRows();
+  uint64_t begin = 0;
+  uint64_t end = numStripeRows;
+  if (strideSize > 0) {
+    const auto numStrides =
+        bits::roundUp(numStripeRows, strideSize) / strideSize;
+    const auto partRows =
+        bits::roundUp(numStrides, numParts) / numParts * strideSize;
+    begin = std::min(numStripeRows, part * partRows);
+    end = std::min(numStripeRows, begin + partRows);
+  } else if (part > 0) {
+    // Without a row index the first part reads the whole stripe.
+    begin = numStripeRows;
+  }
+  if (begin >= end) {
+    return false;
+  }
+  rowsInCurrentStripe_ = end;
+  if (begin > 0 && currentRowInStripe_ == 0) {
+    currentRowInStripe_ = begin;
+    if (getSelectiveColumnReader()) {
+      getSelectiveColumnReader()->seekToRowGroup(begin / strideSize);
+      // The strides to skip are computed at the first row read.
+      recomputeStridesToSkip_ = true;
+    } else {
+      getColumnReader()->skip(begin);
+    }
+  }
+  return true;
+}
+
 void DwrfRowReader::readNext(
     uint64_t rowsToRead,
     const dwio::common::Mutation* mutation,
@@ -568,6 +607,9 @@ int64_t DwrfRowReader::nextRowNumber() {
         }
       }
       loadCurrentStripe();
+      if (!startStripePart(strideSize)) {
+        goto advanceToNextStripe;
+      }
     }
     checkSkipStrides(strideSize);
     if (currentRowInStripe_ < rowsInCurrentStripe_) {
@@ -785,7 +827,8 @@ DwrfReader::DwrfReader(
                                                   : FileFormat::DWRF,
           options.fileColumnNamesReadAsLowerCase(),
           options.randomSkip(),
-          options.scanSpec())),
+          options.scanSpec(),
+          options.fileModificationTime())),
       options_(options) {
   // If we are not using column names to map table columns to file columns,
   // then we use indices. In that case we need to ensure the names completely
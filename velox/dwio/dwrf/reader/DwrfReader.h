@@ -97,6 +97,10 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.skippedStrides += skippedStrides_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    stats.columnReaderStatistics.skippedStridesByBloomFilter +=
+        columnReaderStatistics_.skippedStridesByBloomFilter;
+    stats.columnReaderStatistics.stringDictionaryFilteredRows +=
+        columnReaderStatistics_.stringDictionaryFilteredRows;
   }
 
   void resetFilterCaches() override;
@@ -145,6 +149,11 @@ class DwrfRowReader : public StrideIndexProvider,
 
   void checkSkipStrides(uint64_t strideSize);
 
+  // Limits the rows of the current stripe to the stripe part set in
+  // 'options_' and positions the reader at its first row. Returns false if
+  // the part of the stripe has no rows.
+  bool startStripePart(uint64_t strideSize);
+
   void readNext(
       uint64_t rowsToRead,
       const dwio::common::Mutation*,
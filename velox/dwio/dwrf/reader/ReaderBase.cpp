@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -32,6 +33,44 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+// The parts of ReaderBase read from the tail of a DWRF or ORC file, shared
+// through FileTailCache.
+struct DwrfFileTail : public dwio::common::FileTail {
+  DwrfFileTail(
+      uint64_t parseMicros,
+      std::shared_ptr<google::protobuf::Arena> _arena,
+      std::shared_ptr<PostScript> _postScript,
+      std::shared_ptr<FooterWrapper> _footer,
+      std::shared_ptr<StripeMetadataCache> _stripeMetadata,
+      uint64_t _psLength)
+      : FileTail(parseMicros),
+        arena(std::move(_arena)),
+        postScript(std::move(_postScript)),
+        footer(std::move(_footer)),
+        stripeMetadata(std::move(_stripeMetadata)),
+        psLength(_psLength),
+        memoryBytes_(
+            sizeof(*this) + arena->SpaceUsed() +
+            (stripeMetadata != nullptr ? stripeMetadata->memoryBytes() : 0)) {
+  }
+
+  uint64_t memoryBytes() const override {
+    return memoryBytes_;
+  }
+
+  const std::shared_ptr<google::protobuf::Arena> arena;
+  const std::shared_ptr<PostScript> postScript;
+  const std::shared_ptr<FooterWrapper> footer;
+  const std::shared_ptr<StripeMetadataCache> stripeMetadata;
+  const uint64_t psLength;
+
+ private:
+  // Computed once so that the cache accounts the same size on add and evict.
+  const uint64_t memoryBytes_;
+};
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -97,9 +136,9 @@ ReaderBase::ReaderBase(
     FileFormat fileFormat,
     bool fileColumnNamesReadAsLowerCase,
     std::shared_ptr<random::RandomSkipTracker> randomSkip,
-    std::shared_ptr<velox::common::ScanSpec> scanSpec)
+    std::shared_ptr<velox::common::ScanSpec> scanSpec,
+    int64_t fileModificationTime)
     : pool_{pool},
-      arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       footerEstimatedSize_(footerEstimatedSize),
       filePreloadThreshold_(filePreloadThreshold),
@@ -112,6 +151,69 @@ ReaderBase::ReaderBase(
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
   VELOX_CHECK_GE(fileLength_, 4, "File size too small");
 
+  auto* tailCache = dwio::common::FileTailCache::getInstance();
+  if (input_->getName().empty()) {
+    tailCache = nullptr;
+  }
+  const dwio::common::FileTailKey tailKey{
+      input_->getName(), fileLength_, fileModificationTime, fileFormat};
+  std::shared_ptr<const DwrfFileTail> tail;
+  if (tailCache != nullptr) {
+    tail =
+        std::dynamic_pointer_cast<const DwrfFileTail>(tailCache->get(tailKey));
+  }
+  const auto ioStats = input_->ioStatistics();
+  if (tail != nullptr) {
+    arena_ = tail->arena;
+    postScript_ = tail->postScript;
+    footer_ = tail->footer;
+    cache_ = tail->stripeMetadata;
+    psLength_ = tail->psLength;
+    if (ioStats != nullptr) {
+      ioStats->fileTailCacheHit().increment(tail->parseMicros());
+    }
+  } else {
+    uint64_t parseMicros{0};
+    {
+      MicrosecondTimer timer(&parseMicros);
+      readTail(fileFormat, tailCache);
+    }
+    if (ioStats != nullptr) {
+      ioStats->fileTailParse().increment(parseMicros);
+    }
+    if (tailCache != nullptr) {
+      tailCache->put(
+          tailKey,
+          std::make_shared<DwrfFileTail>(
+              parseMicros, arena_, postScript_, footer_, cache_, psLength_));
+    }
+  }
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
+
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    const auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes > 0) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+void ReaderBase::readTail(
+    FileFormat fileFormat,
+    dwio::common::FileTailCache* tailCache) {
+  arena_ = std::make_shared<google::protobuf::Arena>();
   // TODO: read footer from spectrum
   {
     const void* buf;
@@ -130,11 +232,11 @@ ReaderBase::ReaderBase(
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   }
 
   const uint64_t footerSize = postScript_->footerLength();
@@ -166,54 +268,37 @@ ReaderBase::ReaderBase(
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    footer_ = std::make_shared<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
         arena_.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    footer_ = std::make_shared<FooterWrapper>(footer);
   }
 
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  VELOX_CHECK_NOT_NULL(schema_, "invalid schema");
-
   // load stripe index/footer cache
   if (cacheSize > 0) {
     VELOX_CHECK_EQ(format(), DwrfFormat::kDwrf);
     const uint64_t cacheOffset = fileLength_ - tailSize;
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
+    // A cached tail must not reference 'input_', so it copies the stripe
+    // metadata into a buffer of the cache.
+    if (input_->shouldPrefetchStripes() && tailCache == nullptr) {
+      cache_ = std::make_shared<StripeMetadataCache>(
           postScript_->cacheMode(),
           *footer_,
           input_->read(cacheOffset, cacheSize, LogType::FOOTER));
       input_->load(LogType::FOOTER);
     } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      auto cacheBuffer = std::make_shared<dwio::common::DataBuffer<char>>(
+          tailCache != nullptr ? *tailCache->pool() : pool_, cacheSize);
       input_->read(cacheOffset, cacheSize, LogType::FOOTER)
           ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
+      cache_ = std::make_shared<StripeMetadataCache>(
           postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
     }
   }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    const auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes > 0) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
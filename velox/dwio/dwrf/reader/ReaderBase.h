@@ -18,6 +18,7 @@
 
 #include "velox/common/base/RandomUtil.h"
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileTailCache.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/TypeWithId.h"
@@ -73,7 +74,8 @@ class ReaderBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
       std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
-      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr);
+      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr,
+      int64_t fileModificationTime = 0);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -145,7 +147,7 @@ class ReaderBase {
     return *input_;
   }
 
-  const std::unique_ptr<StripeMetadataCache>& getMetadataCache() const {
+  const std::shared_ptr<StripeMetadataCache>& getMetadataCache() const {
     return cache_;
   }
 
@@ -242,16 +244,25 @@ class ReaderBase {
   }
 
  private:
+  // Reads and parses the post script, the footer and the stripe metadata
+  // cache. Allocates the stripe metadata cache from 'tailCache' if set, so
+  // that the result can be cached.
+  void readTail(
+      dwio::common::FileFormat fileFormat,
+      dwio::common::FileTailCache* tailCache);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
   memory::MemoryPool& pool_;
-  std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
-  std::unique_ptr<StripeMetadataCache> cache_;
+  // The parsed tail of the file, possibly shared with other readers through
+  // FileTailCache.
+  std::shared_ptr<google::protobuf::Arena> arena_;
+  std::shared_ptr<PostScript> postScript_;
+  std::shared_ptr<FooterWrapper> footer_ = nullptr;
+  std::shared_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
@@ -180,9 +180,21 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
             scanSpec),
         keyNodes_(
             getKeyNodes<T>(requestedType, fileType, params, scanSpec, true)) {
-    VELOX_CHECK(
-        !keyNodes_.empty(),
-        "For struct encoding, keys to project must be configured");
+    // Only the streams of the requested keys are read. A requested key that
+    // is not in this stripe keeps the constant subscript and reads as null,
+    // so the subscripts of the previous stripe must not leak into this one.
+    std::unordered_map<const common::ScanSpec*, int32_t> specIndices;
+    for (auto i = 0; i < scanSpec.children().size(); ++i) {
+      auto* childSpec = scanSpec.children()[i].get();
+      specIndices[childSpec] = i;
+      if (!childSpec->isConstant()) {
+        childSpec->setSubscript(kConstantChildSpecSubscript);
+      }
+    }
+    std::sort(keyNodes_.begin(), keyNodes_.end(), [&](auto& x, auto& y) {
+      return specIndices.at(x.reader->scanSpec()) <
+          specIndices.at(y.reader->scanSpec());
+    });
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
       keyNodes_[i].reader->scanSpec()->setSubscript(i);
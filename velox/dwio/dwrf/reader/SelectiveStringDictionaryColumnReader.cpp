@@ -59,11 +59,15 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       params.streamLabels().label(),
       false);
 
-  // handle in dictionary stream
-  std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_IN_DICTIONARY),
-      params.streamLabels().label(),
-      false);
+  // handle in dictionary stream. ORC has no stride dictionaries and uses the
+  // number of IN_DICTIONARY for BLOOM_FILTER streams.
+  std::unique_ptr<SeekableInputStream> inDictStream =
+      stripe.format() == DwrfFormat::kDwrf
+      ? stripe.getStream(
+            encodingKey.forKind(proto::Stream_Kind_IN_DICTIONARY),
+            params.streamLabels().label(),
+            false)
+      : nullptr;
   if (inDictStream) {
     inDictionaryReader_ =
         createBooleanRleDecoder(std::move(inDictStream), encodingKey);
@@ -137,6 +141,7 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
   // get stride dictionary size and load it if needed
   auto& positions =
       formatData_->as<DwrfData>().index().entry(nextStride).positions();
+  const bool hadStrideDictionary = scanState_.dictionary2.numValues > 0;
   scanState_.dictionary2.numValues = positions.Get(strideDictSizeOffset_);
   if (scanState_.dictionary2.numValues > 0) {
     // seek stride dictionary related streams
@@ -150,7 +155,12 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
         *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
   }
   lastStrideIndex_ = nextStride;
-  dictionaryValues_ = nullptr;
+  // Keep the dictionary vector of the stripe while no stride has its own
+  // dictionary, so that consumers can recognize the same dictionary across
+  // batches and cache results per dictionary entry.
+  if (hadStrideDictionary || scanState_.dictionary2.numValues > 0) {
+    dictionaryValues_ = nullptr;
+  }
 
   if (DictionaryValues::hasFilter(scanSpec_->filter())) {
     scanState_.filterCache.resize(
@@ -260,6 +270,9 @@ void SelectiveStringDictionaryColumnReader::read(
     }
   }
 
+  if (DictionaryValues::hasFilter(scanSpec_->filter())) {
+    statistics_.stringDictionaryFilteredRows += rows.size();
+  }
   readOffset_ += rows.back() + 1;
   numRowsScanned_ = readOffset_ - offset;
 }
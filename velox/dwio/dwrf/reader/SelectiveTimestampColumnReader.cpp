@@ -22,6 +22,59 @@ namespace facebook::velox::dwrf {
 
 using namespace dwio::common;
 
+namespace {
+
+// DWRF stores nanos with their trailing decimal zeros removed. The low 3 bits
+// hold the number of removed zeros minus 1, or 0 if none were removed. Indexed
+// by these bits, the multiplier that restores the removed zeros.
+constexpr uint64_t kNanosMultipliers[8] = {
+    1,
+    100,
+    1'000,
+    10'000,
+    100'000,
+    1'000'000,
+    10'000'000,
+    100'000'000};
+
+template <TimestampPrecision kPrecision>
+FOLLY_ALWAYS_INLINE Timestamp decodeTimestamp(int64_t seconds, uint64_t nanos) {
+  nanos = (nanos >> 3) * kNanosMultipliers[nanos & 7];
+  seconds += EPOCH_OFFSET;
+  // Undoes the Java convention of writing negative seconds with nanos
+  // rounded towards zero.
+  seconds -= (seconds < 0) & (nanos != 0);
+  if constexpr (kPrecision == TimestampPrecision::kMilliseconds) {
+    nanos = nanos / 1'000'000 * 1'000'000;
+  } else if constexpr (kPrecision == TimestampPrecision::kMicroseconds) {
+    nanos = nanos / 1'000 * 1'000;
+  }
+  return Timestamp(seconds, nanos);
+}
+
+// Combines 'numValues' seconds and encoded nanos into 'result'. Null rows, the
+// clear bits of 'nulls', are skipped. Without nulls the loop has no branches,
+// so that the compiler can vectorize it.
+template <TimestampPrecision kPrecision>
+void decodeTimestamps(
+    const int64_t* seconds,
+    const uint64_t* nanos,
+    const uint64_t* nulls,
+    vector_size_t numValues,
+    Timestamp* result) {
+  if (nulls) {
+    bits::forEachSetBit(nulls, 0, numValues, [&](vector_size_t i) {
+      result[i] = decodeTimestamp<kPrecision>(seconds[i], nanos[i]);
+    });
+  } else {
+    for (vector_size_t i = 0; i < numValues; ++i) {
+      result[i] = decodeTimestamp<kPrecision>(seconds[i], nanos[i]);
+    }
+  }
+}
+
+} // namespace
+
 SelectiveTimestampColumnReader::SelectiveTimestampColumnReader(
     const std::shared_ptr<const TypeWithId>& fileType,
     DwrfParams& params,
@@ -136,32 +189,19 @@ void SelectiveTimestampColumnReader::readHelper(
   auto tsValues = AlignedBuffer::allocate<Timestamp>(numValues_, &memoryPool_);
   auto rawTs = tsValues->asMutable<Timestamp>();
 
-  for (vector_size_t i = 0; i < numValues_; i++) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, i)) {
-      auto nanos = nanosData[i];
-      uint64_t zeros = nanos & 0x7;
-      nanos >>= 3;
-      if (zeros != 0) {
-        for (uint64_t j = 0; j <= zeros; ++j) {
-          nanos *= 10;
-        }
-      }
-      auto seconds = secondsData[i] + EPOCH_OFFSET;
-      if (seconds < 0 && nanos != 0) {
-        seconds -= 1;
-      }
-      switch (precision_) {
-        case TimestampPrecision::kMilliseconds:
-          nanos = nanos / 1'000'000 * 1'000'000;
-          break;
-        case TimestampPrecision::kMicroseconds:
-          nanos = nanos / 1'000 * 1'000;
-          break;
-        case TimestampPrecision::kNanoseconds:
-          break;
-      }
-      rawTs[i] = Timestamp(seconds, nanos);
-    }
+  switch (precision_) {
+    case TimestampPrecision::kMilliseconds:
+      decodeTimestamps<TimestampPrecision::kMilliseconds>(
+          secondsData, nanosData, rawNulls, numValues_, rawTs);
+      break;
+    case TimestampPrecision::kMicroseconds:
+      decodeTimestamps<TimestampPrecision::kMicroseconds>(
+          secondsData, nanosData, rawNulls, numValues_, rawTs);
+      break;
+    case TimestampPrecision::kNanoseconds:
+      decodeTimestamps<TimestampPrecision::kNanoseconds>(
+          secondsData, nanosData, rawNulls, numValues_, rawTs);
+      break;
   }
   values_ = tsValues;
   rawValues_ = values_->asMutable<char>();
@@ -52,6 +52,12 @@ class StripeMetadataCache {
   StripeMetadataCache& operator=(const StripeMetadataCache&) = delete;
   StripeMetadataCache& operator=(StripeMetadataCache&&) = delete;
 
+  /// Returns the bytes of the buffered stripe metadata and its offsets.
+  uint64_t memoryBytes() const {
+    return (buffer_ != nullptr ? buffer_->capacity() : 0) +
+        offsets_.size() * sizeof(uint32_t);
+  }
+
   bool has(StripeCacheMode mode, uint64_t stripeIndex) const {
     return getIndex(mode, stripeIndex) != INVALID_INDEX;
   }
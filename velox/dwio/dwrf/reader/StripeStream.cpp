@@ -17,6 +17,7 @@
 #include <folly/ScopeGuard.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/dwio/common/compression/DecompressAheadInputStream.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/common/wrap/coded-stream-wrapper.h"
@@ -305,10 +306,35 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
-  return readState_->readerBase->createDecompressedStream(
+  auto decompressed = readState_->readerBase->createDecompressedStream(
       std::move(streamRead),
       streamDebugInfo,
       getDecrypter(si.encodingKey().node()));
+  auto& stripeInput = *readState_->stripeMetadata->stripeInput;
+  if (stripeInput.decompressAhead() && !isIndexStream(si.kind()) &&
+      info.getLength() <=
+          dwio::common::compression::DecompressAheadInputStream::
+              kMaxCompressedBytes) {
+    if (auto* paged =
+            dynamic_cast<dwio::common::compression::PagedInputStream*>(
+                decompressed.get())) {
+      decompressed.release();
+      auto stream = std::make_unique<
+          dwio::common::compression::DecompressAheadInputStream>(
+          std::unique_ptr<dwio::common::compression::PagedInputStream>(paged),
+          readState_->readerBase->getMemoryPool(),
+          stripeInput.ioStatistics());
+      // The data of the stream is read once the read plan is loaded, so that
+      // the reads of the stripe are coalesced.
+      if (decompressAheadStarted_) {
+        stripeInput.executor()->add(stream->decompressTask());
+      } else {
+        pendingDecompressions_.push_back(stream->decompressTask());
+      }
+      return stream;
+    }
+  }
+  return decompressed;
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
@@ -371,6 +397,19 @@ void StripeStreamsImpl::loadReadPlan() {
 
   auto& input = *readState_->stripeMetadata->stripeInput;
   input.load(LogType::STREAM_BUNDLE);
+  startDecompressAhead();
+}
+
+void StripeStreamsImpl::startDecompressAhead() {
+  if (decompressAheadStarted_) {
+    return;
+  }
+  decompressAheadStarted_ = true;
+  auto* executor = readState_->stripeMetadata->stripeInput->executor();
+  for (auto& task : pendingDecompressions_) {
+    executor->add(std::move(task));
+  }
+  pendingDecompressions_.clear();
 }
 
 } // namespace facebook::velox::dwrf
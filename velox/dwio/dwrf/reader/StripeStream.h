@@ -274,6 +274,11 @@ class StripeStreamsImpl : public StripeStreamsBase {
   // load data into buffer according to read plan
   void loadReadPlan();
 
+  // Starts decompressing ahead the streams made by getStream() so far and
+  // from now on. Called by loadReadPlan() or, if the stripe is preloaded
+  // instead, by the reader, so that decompression reads the loaded data.
+  void startDecompressAhead();
+
   std::unique_ptr<dwio::common::SeekableInputStream> getCompressedStream(
       const DwrfStreamIdentifier& si,
       std::string_view label) const;
@@ -350,6 +355,11 @@ class StripeStreamsImpl : public StripeStreamsBase {
 
   bool readPlanLoaded_;
 
+  // True once streams are decompressed ahead on creation.
+  mutable bool decompressAheadStarted_{false};
+  // Decompression tasks of the streams made before startDecompressAhead().
+  mutable std::vector<std::function<void()>> pendingDecompressions_;
+
   // map of stream id -> stream information
   folly::F14FastMap<
       DwrfStreamIdentifier,
@@ -488,6 +488,64 @@ TEST_F(CacheTest, window) {
   EXPECT_EQ(kMB, ioStats_->rawBytesRead() - previousRead);
 }
 
+TEST_F(CacheTest, preloadBudget) {
+  initializeCache(64 << 20);
+  auto tracker = std::make_shared<ScanTracker>(
+      "testTracker",
+      nullptr,
+      io::ReaderOptions::kDefaultLoadQuantum,
+      groupStats_);
+  uint64_t fileId;
+  uint64_t groupId;
+  auto file = inputByPath("test_for_preload_budget", fileId, groupId);
+  // The budget covers the first 10 streams. The tracker has no history, so
+  // without a budget all streams would be read on first use.
+  constexpr int32_t kNumPreloadStreams = 10;
+  auto budget =
+      std::make_shared<std::atomic<int64_t>>(streamStarts_[kNumPreloadStreams]);
+  io::ReaderOptions options(pool_.get());
+  options.setPreloadBudget(budget);
+  auto input = std::make_unique<CachedBufferedInput>(
+      file,
+      MetricsLog::voidLog(),
+      fileId,
+      cache_.get(),
+      tracker,
+      groupId,
+      ioStats_,
+      executor_.get(),
+      options);
+  auto enqueue = [&](BufferedInput& bufferedInput, int32_t streamIndex) {
+    return bufferedInput.enqueue(
+        Region{
+            streamStarts_[streamIndex],
+            streamStarts_[streamIndex + 1] - streamStarts_[streamIndex]},
+        streamIds_[streamIndex].get());
+  };
+  std::vector<std::unique_ptr<SeekableInputStream>> streams;
+  for (auto i = 0; i < 2 * kNumPreloadStreams; ++i) {
+    streams.push_back(enqueue(*input, i));
+  }
+  input->load(LogType::TEST);
+  EXPECT_EQ(0, budget->load());
+  EXPECT_EQ(kNumPreloadStreams, ioStats_->splitPreload().count());
+  EXPECT_EQ(
+      streamStarts_[kNumPreloadStreams], ioStats_->splitPreload().sum());
+
+  // A clone shares the exhausted budget and reads on first use.
+  auto clone = input->clone();
+  streams.push_back(enqueue(*clone, 2 * kNumPreloadStreams));
+  clone->load(LogType::TEST);
+  EXPECT_EQ(kNumPreloadStreams, ioStats_->splitPreload().count());
+
+  const void* buffer;
+  int32_t size;
+  for (auto& stream : streams) {
+    while (stream->Next(&buffer, &size)) {
+    }
+  }
+}
+
 TEST_F(CacheTest, bufferedInput) {
   // Size 160 MB. Frequent evictions and not everything fits in prefetch window.
   initializeCache(160 << 20);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+#include "velox/dwio/common/TypeWithId.h"
+#include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/type/Type.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+// Writes columns that are re-encoded with the dictionary encoding of the
+// writer, as when copying a dictionary encoded file. The input either is
+// flat or wraps a small dictionary of distinct values, as a scan of a
+// dictionary encoded file produces.
+
+constexpr vector_size_t kVectorSize = 10000;
+constexpr int32_t kNumIterations = 100;
+
+std::shared_ptr<memory::MemoryPool> pool;
+
+template <typename T>
+void setValue(FlatVector<T>& vector, vector_size_t row, int32_t value);
+
+template <>
+void setValue(FlatVector<int64_t>& vector, vector_size_t row, int32_t value) {
+  vector.set(row, value * 1'000'003L);
+}
+
+template <>
+void setValue(
+    FlatVector<StringView>& vector,
+    vector_size_t row,
+    int32_t value) {
+  const auto string = fmt::format("dictionary entry number {}", value);
+  vector.set(row, StringView(string));
+}
+
+// Returns a vector of 'kVectorSize' rows with 'numDistinct' distinct values.
+// The vector wraps a base of 'numDistinct' rows in a dictionary if
+// 'dictionary' is true.
+template <typename T>
+VectorPtr makeVector(vector_size_t numDistinct, bool dictionary) {
+  const auto type = CppToType<T>::create();
+  auto base = BaseVector::create<FlatVector<T>>(
+      type, dictionary ? numDistinct : kVectorSize, pool.get());
+  for (auto row = 0; row < base->size(); ++row) {
+    setValue<T>(*base, row, row % numDistinct);
+  }
+  if (!dictionary) {
+    return base;
+  }
+
+  auto indices =
+      AlignedBuffer::allocate<vector_size_t>(kVectorSize, pool.get());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (auto row = 0; row < kVectorSize; ++row) {
+    rawIndices[row] = (row * 7) % numDistinct;
+  }
+  return BaseVector::wrapInDictionary(nullptr, indices, kVectorSize, base);
+}
+
+template <typename T>
+void runBenchmark(vector_size_t numDistinct, bool dictionary) {
+  folly::BenchmarkSuspender braces;
+  auto vector = makeVector<T>(numDistinct, dictionary);
+  auto typeWithId = TypeWithId::create(vector->type(), 1);
+  braces.dismiss();
+
+  for (auto i = 0; i < kNumIterations; i++) {
+    auto config = std::make_shared<dwrf::Config>();
+    WriterContext context{
+        config,
+        memory::memoryManager()->addRootPool(
+            "DictionaryColumnWriterBenchmark")};
+    auto writer = BaseColumnWriter::create(context, *typeWithId, 0);
+    writer->write(vector, common::Ranges::of(0, kVectorSize));
+  }
+}
+
+BENCHMARK(bigintFlat100) {
+  runBenchmark<int64_t>(100, false);
+}
+
+BENCHMARK_RELATIVE(bigintDictionary100) {
+  runBenchmark<int64_t>(100, true);
+}
+
+BENCHMARK(bigintFlat1000) {
+  runBenchmark<int64_t>(1000, false);
+}
+
+BENCHMARK_RELATIVE(bigintDictionary1000) {
+  runBenchmark<int64_t>(1000, true);
+}
+
+BENCHMARK(varcharFlat100) {
+  runBenchmark<StringView>(100, false);
+}
+
+BENCHMARK_RELATIVE(varcharDictionary100) {
+  runBenchmark<StringView>(100, true);
+}
+
+BENCHMARK(varcharFlat1000) {
+  runBenchmark<StringView>(1000, false);
+}
+
+BENCHMARK_RELATIVE(varcharDictionary1000) {
+  runBenchmark<StringView>(1000, true);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  pool = memory::memoryManager()->addLeafPool();
+  folly::runBenchmarks();
+  pool.reset();
+  return 0;
+}
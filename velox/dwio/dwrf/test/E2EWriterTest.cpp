@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -377,6 +378,53 @@ TEST_F(E2EWriterTest, E2E) {
   dwrf::E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
 }
 
+// Dictionary and constant encoded input, as produced by scans of dictionary
+// encoded files, is written by adding each distinct base value to the
+// dictionary encoder once.
+TEST_F(E2EWriterTest, dictionaryEncodedInput) {
+  VectorMaker maker{leafPool_.get()};
+  const vector_size_t batchSize = 1'100;
+  const vector_size_t baseSize = 10;
+  auto type =
+      ROW({"int_val", "long_val", "string_val", "constant_val"},
+          {INTEGER(), BIGINT(), VARCHAR(), VARCHAR()});
+
+  auto ints = maker.flatVector<int32_t>(
+      baseSize,
+      [](auto row) { return row * 3; },
+      [](auto row) { return row == 2; });
+  auto longs = maker.flatVector<int64_t>(
+      baseSize, [](auto row) { return -row * 1'000'000'000'000L; });
+  auto strings = maker.flatVector<std::string>(
+      baseSize,
+      [](auto row) { return fmt::format("dictionary value {}", row); },
+      [](auto row) { return row == 7; });
+
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    auto indices =
+        AlignedBuffer::allocate<vector_size_t>(batchSize, leafPool_.get());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (auto row = 0; row < batchSize; ++row) {
+      rawIndices[row] = (row * 7 + i) % baseSize;
+    }
+    batches.push_back(maker.rowVector(
+        type->names(),
+        {BaseVector::wrapInDictionary(nullptr, indices, batchSize, ints),
+         BaseVector::wrapInDictionary(nullptr, indices, batchSize, longs),
+         BaseVector::wrapInDictionary(nullptr, indices, batchSize, strings),
+         BaseVector::createConstant(
+             VARCHAR(),
+             fmt::format("constant {}", i),
+             batchSize,
+             leafPool_.get())}));
+  }
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  dwrf::E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
+}
+
 TEST_F(E2EWriterTest, DisableLinearHeuristics) {
   const size_t batchCount = 100;
   size_t batchSize = 3000;
@@ -946,6 +994,54 @@ TEST_F(E2EWriterTest, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTest, parallelFlush) {
+  auto type = ROW({
+      {"bigint", BIGINT()},
+      {"varchar", VARCHAR()},
+      {"double", DOUBLE()},
+      {"array", ARRAY(INTEGER())},
+      {"map", MAP(INTEGER(), VARCHAR())},
+      {"row", ROW({{"a", REAL()}, {"b", SMALLINT()}})},
+  });
+  VectorFuzzer fuzzer(
+      {.vectorSize = 1'000, .nullRatio = 0.1, .stringLength = 20},
+      leafPool_.get(),
+      folly::Random::rand32());
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  const auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::COMPRESSION, common::CompressionKind_ZSTD);
+    auto sink = std::make_unique<MemorySink>(
+        64 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.flushExecutor = std::move(executor);
+    options.flushParallelism = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (size_t i = 0; i < batches.size(); ++i) {
+      writer.write(batches[i]);
+      if (i % 3 == 2) {
+        writer.flush();
+      }
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto sequential = writeFile(nullptr);
+  const auto parallel =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(sequential, parallel);
+}
+
 TEST_F(E2EWriterTest, OversizeRows) {
   auto pool = facebook::velox::memory::memoryManager()->addLeafPool();
 
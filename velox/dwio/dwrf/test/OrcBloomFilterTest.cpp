@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/OrcBloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+using ValueKind = OrcBloomFilter::ValueKind;
+
+OrcBloomFilter makeFilter(int32_t numWords = 64) {
+  return OrcBloomFilter(std::vector<uint64_t>(numWords), 3);
+}
+
+TEST(OrcBloomFilterTest, addAndTest) {
+  auto filter = makeFilter();
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.addHash(OrcBloomFilter::hash(i * 7));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter.testHash(OrcBloomFilter::hash(i * 7)));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    numFalsePositives += filter.testHash(OrcBloomFilter::hash(1'000'000 + i));
+  }
+  EXPECT_LT(numFalsePositives, 50);
+
+  // The utf8bitset field of the proto holds the same bitset as little endian
+  // bytes.
+  std::string bytes(
+      reinterpret_cast<const char*>(filter.bitset().data()),
+      filter.bitset().size() * sizeof(uint64_t));
+  OrcBloomFilter copy(std::string_view(bytes), 3);
+  EXPECT_EQ(copy.bitset(), filter.bitset());
+}
+
+TEST(OrcBloomFilterTest, hash) {
+  // Negative values use arithmetic shifts and strings of all tail lengths
+  // hash differently.
+  EXPECT_NE(OrcBloomFilter::hash(int64_t(-1)), OrcBloomFilter::hash(int64_t(1)));
+  std::string value = "abcdefghijklmnopq";
+  std::vector<uint64_t> hashes;
+  for (auto length = 0; length <= value.size(); ++length) {
+    hashes.push_back(
+        OrcBloomFilter::hash(std::string_view(value.data(), length)));
+  }
+  std::sort(hashes.begin(), hashes.end());
+  EXPECT_EQ(std::unique(hashes.begin(), hashes.end()), hashes.end());
+}
+
+TEST(OrcBloomFilterTest, mayContainBigint) {
+  auto filter = makeFilter();
+  for (int64_t i = -50; i < 50; ++i) {
+    filter.addHash(OrcBloomFilter::hash(i * 10));
+  }
+  EXPECT_TRUE(filter.mayContain(
+      common::BigintRange(-20, -20, false), ValueKind::kInteger));
+  EXPECT_FALSE(filter.mayContain(
+      common::BigintRange(1'001, 1'001, false), ValueKind::kInteger));
+  // Ranges are not tested.
+  EXPECT_TRUE(filter.mayContain(
+      common::BigintRange(1'001, 1'002, false), ValueKind::kInteger));
+
+  EXPECT_TRUE(filter.mayContain(
+      common::BigintValuesUsingHashTable(
+          1'001, 2'000'000, {1'001, 2'000'000, 490}, false),
+      ValueKind::kInteger));
+  EXPECT_FALSE(filter.mayContain(
+      common::BigintValuesUsingHashTable(
+          1'001, 2'000'000, {1'001, 1'000'003, 2'000'000}, false),
+      ValueKind::kInteger));
+  EXPECT_FALSE(filter.mayContain(
+      common::BigintValuesUsingBitmask(1'001, 1'003, {1'001, 1'003}, false),
+      ValueKind::kInteger));
+
+  // Integer filters on a string column are not tested.
+  EXPECT_TRUE(filter.mayContain(
+      common::BigintRange(1'001, 1'001, false), ValueKind::kBytes));
+}
+
+TEST(OrcBloomFilterTest, mayContainBytes) {
+  auto filter = makeFilter();
+  for (auto i = 0; i < 100; ++i) {
+    filter.addHash(OrcBloomFilter::hash(fmt::format("value {}", i)));
+  }
+  EXPECT_TRUE(filter.mayContain(
+      common::BytesRange(
+          "value 7", false, false, "value 7", false, false, false),
+      ValueKind::kBytes));
+  EXPECT_FALSE(filter.mayContain(
+      common::BytesRange("other", false, false, "other", false, false, false),
+      ValueKind::kBytes));
+  EXPECT_TRUE(filter.mayContain(
+      common::BytesValues({"other", "value 99"}, false), ValueKind::kBytes));
+  EXPECT_FALSE(filter.mayContain(
+      common::BytesValues({"other", "value 100"}, false), ValueKind::kBytes));
+  EXPECT_TRUE(filter.mayContain(
+      common::BytesValues({"other", "value 100"}, false),
+      ValueKind::kInteger));
+  EXPECT_TRUE(filter.mayContain(common::IsNotNull(), ValueKind::kBytes));
+}
+
+} // namespace
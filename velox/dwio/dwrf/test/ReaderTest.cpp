@@ -16,12 +16,14 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <folly/ScopeGuard.h>
 #include "folly/Random.h"
 #include "folly/executors/CPUThreadPoolExecutor.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/ExecutorBarrier.h"
 #include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/FileTailCache.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
@@ -811,6 +813,54 @@ TEST_F(TestReader, DISABLED_testBlockedIoCallbackFiredWithFirstStripeLoad) {
   EXPECT_EQ(metricToIncrement, metricAfterFirstStripe);
 }
 
+TEST_F(TestReader, fileTailCache) {
+  FileTailCache cache(
+      64 << 20, memory::memoryManager()->addLeafPool("fileTailCache"));
+  FileTailCache::setInstance(&cache);
+  SCOPE_EXIT {
+    FileTailCache::setInstance(nullptr);
+  };
+
+  dwio::common::ReaderOptions readerOpts{pool()};
+  auto first = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), readerOpts.memoryPool()),
+      readerOpts);
+  auto second = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), readerOpts.memoryPool()),
+      readerOpts);
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numMisses, 1);
+  ASSERT_EQ(stats.numHits, 1);
+  ASSERT_EQ(stats.numEntries, 1);
+  ASSERT_GT(stats.memoryBytes, 0);
+  ASSERT_EQ(
+      first->getFooter().rawProtoPtr(), second->getFooter().rawProtoPtr());
+  ASSERT_EQ(*first->rowType(), *second->rowType());
+
+  // Both readers read all the rows.
+  for (auto* reader : {first.get(), second.get()}) {
+    RowReaderOptions rowReaderOpts;
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr batch;
+    uint64_t numRows = 0;
+    while (rowReader->next(1'000, batch)) {
+      numRows += batch->size();
+    }
+    ASSERT_EQ(numRows, reader->numberOfRows().value());
+  }
+
+  // A different modification time is another version of the file.
+  readerOpts.setFileModificationTime(1);
+  auto third = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), readerOpts.memoryPool()),
+      readerOpts);
+  ASSERT_NE(
+      first->getFooter().rawProtoPtr(), third->getFooter().rawProtoPtr());
+  stats = cache.stats();
+  ASSERT_EQ(stats.numMisses, 2);
+  ASSERT_EQ(stats.numEntries, 2);
+}
+
 TEST_F(TestReader, testEstimatedSize) {
   dwio::common::ReaderOptions readerOpts{pool()};
   {
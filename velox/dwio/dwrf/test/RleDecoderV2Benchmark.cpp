@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/RLEv2.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr int32_t kNumValues = 100'000;
+
+// Returns RLEv2 DIRECT runs of 512 values of 'bitWidth' bits each. The widths
+// used here are encoded as 'bitWidth' - 1.
+std::vector<char> encodeDirect(uint32_t bitWidth) {
+  std::vector<char> bytes;
+  for (int32_t begin = 0; begin < kNumValues; begin += 512) {
+    const auto runLength = std::min(512, kNumValues - begin);
+    bytes.push_back(
+        0x40 | ((bitWidth - 1) << 1) | ((runLength - 1) >> 8));
+    bytes.push_back((runLength - 1) & 0xff);
+    uint32_t numBits = 0;
+    for (auto i = 0; i < runLength; ++i) {
+      const uint64_t value =
+          ((begin + i) * 0x9e3779b97f4a7c15ULL) >> (64 - bitWidth);
+      for (int32_t bit = bitWidth - 1; bit >= 0; --bit) {
+        if (numBits % 8 == 0) {
+          bytes.push_back(0);
+        }
+        bytes.back() |= ((value >> bit) & 1) << (7 - numBits % 8);
+        ++numBits;
+      }
+    }
+  }
+  return bytes;
+}
+
+struct Encoded {
+  std::vector<char> direct7{encodeDirect(7)};
+  std::vector<char> direct17{encodeDirect(17)};
+  std::vector<char> direct24{encodeDirect(24)};
+};
+
+Encoded& encoded() {
+  static Encoded encoded;
+  return encoded;
+}
+
+std::unique_ptr<RleDecoderV2<true>> makeDecoder(
+    const std::vector<char>& bytes,
+    memory::MemoryPool& pool) {
+  return std::make_unique<RleDecoderV2<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          bytes.data(), bytes.size()),
+      pool);
+}
+
+// Decodes one value per call, as the selective readers did before the bulk
+// path.
+int64_t decodeOneByOne(const std::vector<char>& bytes) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto decoder = makeDecoder(bytes, *pool);
+  int64_t sum = 0;
+  int64_t value;
+  for (auto i = 0; i < kNumValues; ++i) {
+    decoder->next(&value, 1, nullptr);
+    sum += value;
+  }
+  return sum;
+}
+
+int64_t decodeBulk(const std::vector<char>& bytes) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto decoder = makeDecoder(bytes, *pool);
+  std::vector<int64_t> values(kNumValues);
+  decoder->bulkRead(kNumValues, values.data());
+  return values[kNumValues - 1];
+}
+
+int64_t decodeEveryThird(const std::vector<char>& bytes) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto decoder = makeDecoder(bytes, *pool);
+  std::vector<int32_t> rows;
+  for (auto row = 0; row < kNumValues; row += 3) {
+    rows.push_back(row);
+  }
+  std::vector<int64_t> values(rows.size());
+  decoder->bulkReadRows(
+      folly::Range<const int32_t*>(rows.data(), rows.size()), values.data());
+  return values.back();
+}
+
+} // namespace
+
+BENCHMARK(oneByOne7) {
+  folly::doNotOptimizeAway(decodeOneByOne(encoded().direct7));
+}
+
+BENCHMARK_RELATIVE(bulk7) {
+  folly::doNotOptimizeAway(decodeBulk(encoded().direct7));
+}
+
+BENCHMARK_RELATIVE(everyThird7) {
+  folly::doNotOptimizeAway(decodeEveryThird(encoded().direct7));
+}
+
+BENCHMARK(oneByOne17) {
+  folly::doNotOptimizeAway(decodeOneByOne(encoded().direct17));
+}
+
+BENCHMARK_RELATIVE(bulk17) {
+  folly::doNotOptimizeAway(decodeBulk(encoded().direct17));
+}
+
+BENCHMARK_RELATIVE(everyThird17) {
+  folly::doNotOptimizeAway(decodeEveryThird(encoded().direct17));
+}
+
+BENCHMARK(oneByOne24) {
+  folly::doNotOptimizeAway(decodeOneByOne(encoded().direct24));
+}
+
+BENCHMARK_RELATIVE(bulk24) {
+  folly::doNotOptimizeAway(decodeBulk(encoded().direct24));
+}
+
+BENCHMARK_RELATIVE(everyThird24) {
+  folly::doNotOptimizeAway(decodeEveryThird(encoded().direct24));
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
@@ -18,11 +18,13 @@
 #include <folly/String.h>
 #include <folly/compression/Compression.h>
 #include <folly/compression/Zlib.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/DecompressAheadInputStream.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <cstdio>
@@ -997,6 +999,86 @@ TEST_F(TestSeek, uncompressed) {
   }
 }
 
+TEST_F(TestSeek, decompressAhead) {
+  constexpr size_t kInputSize = 1024;
+  constexpr size_t kOutputSize = 4096;
+  constexpr int32_t kUncompressedSize = 1000;
+  auto codec = getCodec(CodecType::ZSTD);
+  char input1[kInputSize];
+  char input2[kInputSize];
+  // Two ZSTD blocks followed by one uncompressed block.
+  char output[kOutputSize + kUncompressedSize + 3];
+  size_t offset1;
+  size_t offset2;
+  prepareTestData(
+      *codec, input1, input2, kInputSize, output, offset1, offset2);
+  writeHeader(output + offset2, kUncompressedSize, true);
+  for (auto i = 0; i < kUncompressedSize; ++i) {
+    output[offset2 + 3 + i] = static_cast<char>(i);
+  }
+  const auto streamSize = offset2 + 3 + kUncompressedSize;
+
+  folly::CPUThreadPoolExecutor executor(2);
+  auto ioStats = std::make_shared<io::IoStatistics>();
+  auto paged = createTestDecompressor(
+      CompressionKind_ZSTD,
+      std::make_unique<SeekableArrayInputStream>(output, streamSize, 100),
+      kOutputSize);
+  auto* pagedPtr =
+      dynamic_cast<compression::PagedInputStream*>(paged.release());
+  ASSERT_NE(pagedPtr, nullptr);
+  compression::DecompressAheadInputStream stream(
+      std::unique_ptr<compression::PagedInputStream>(pagedPtr),
+      *pool_,
+      ioStats);
+  executor.add(stream.decompressTask());
+
+  const void* data;
+  int32_t size;
+  ASSERT_TRUE(stream.Next(&data, &size));
+  ASSERT_EQ(size, kInputSize);
+  ASSERT_EQ(0, memcmp(data, input1, kInputSize));
+  stream.BackUp(10);
+  ASSERT_EQ(stream.ByteCount(), kInputSize - 10);
+  ASSERT_TRUE(stream.Next(&data, &size));
+  ASSERT_EQ(size, 10);
+  ASSERT_EQ(0, memcmp(data, input1 + kInputSize - 10, 10));
+  ASSERT_TRUE(stream.Next(&data, &size));
+  ASSERT_EQ(size, kInputSize);
+  ASSERT_EQ(0, memcmp(data, input2, kInputSize));
+
+  // Positions are the same as for the PagedInputStream.
+  const size_t seekPos = folly::Random::rand32() % 1000 + 1;
+  const size_t positions[][2]{
+      {0, 0}, {0, seekPos}, {offset1, seekPos}, {offset1, 0}};
+  const char* expected[]{input1, input1, input2, input2};
+  for (size_t i = 0; i < VELOX_ARRAY_SIZE(positions); ++i) {
+    std::vector<uint64_t> list{positions[i][0], positions[i][1]};
+    PositionProvider provider(list);
+    stream.seekToPosition(provider);
+    ASSERT_TRUE(stream.Next(&data, &size));
+    ASSERT_EQ(size, kInputSize - positions[i][1]);
+    ASSERT_EQ(0, memcmp(data, expected[i] + positions[i][1], size));
+  }
+
+  // The uncompressed block comes in the ranges of the inner stream.
+  std::vector<uint64_t> list{offset2, 500};
+  PositionProvider provider(list);
+  stream.seekToPosition(provider);
+  int32_t numRead = 0;
+  while (stream.Next(&data, &size)) {
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(
+          reinterpret_cast<const char*>(data)[i],
+          static_cast<char>(500 + numRead + i));
+    }
+    numRead += size;
+  }
+  ASSERT_EQ(numRead, kUncompressedSize - 500);
+  ASSERT_EQ(stream.ByteCount(), 2 * kInputSize + kUncompressedSize);
+  ASSERT_EQ(ioStats->decompressAhead().count(), 1);
+}
+
 namespace {
 // Returns the  highest header below target. Must not request an offset that
 // falls in mid-header.
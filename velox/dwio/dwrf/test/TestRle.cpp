@@ -673,6 +673,139 @@ TEST_F(RLEv2Test, bitsLeftByPreviousStream) {
   }
 };
 
+namespace {
+// Returns a DIRECT run of 'values' packed in 'bitWidth' bits.
+std::vector<unsigned char> encodeDirectRun(
+    const std::vector<uint64_t>& values,
+    uint32_t bitWidth) {
+  uint32_t encodedWidth;
+  if (bitWidth <= 24) {
+    encodedWidth = bitWidth - 1;
+  } else if (bitWidth <= 32) {
+    encodedWidth = 24 + (bitWidth - 26) / 2;
+  } else {
+    encodedWidth = 28 + (bitWidth - 40) / 8;
+  }
+  const auto runLength = values.size() - 1;
+  std::vector<unsigned char> bytes{
+      static_cast<unsigned char>(0x40 | (encodedWidth << 1) | (runLength >> 8)),
+      static_cast<unsigned char>(runLength & 0xff)};
+  uint32_t numBits = 0;
+  for (auto value : values) {
+    for (int32_t bit = bitWidth - 1; bit >= 0; --bit) {
+      if (numBits % 8 == 0) {
+        bytes.push_back(0);
+      }
+      bytes.back() |= ((value >> bit) & 1) << (7 - numBits % 8);
+      ++numBits;
+    }
+  }
+  return bytes;
+}
+} // namespace
+
+TEST_F(RLEv2Test, directAllBitWidths) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  for (uint32_t bitWidth :
+       {1, 2, 3, 5, 7, 8, 9, 12, 15, 16, 17, 23, 24, 26, 28, 30, 32, 40, 48,
+        56, 64}) {
+    // Two runs of different lengths, so that the second run starts in the
+    // middle of a byte of the buffer.
+    std::vector<unsigned char> bytes;
+    std::vector<int64_t> expected;
+    for (auto runLength : {511, 37}) {
+      std::vector<uint64_t> values(runLength);
+      for (auto i = 0; i < runLength; ++i) {
+        values[i] = (i * 0x9e3779b97f4a7c15ULL + 17) >> (64 - bitWidth);
+        expected.push_back(
+            static_cast<int64_t>(values[i] >> 1) ^ -(values[i] & 1));
+      }
+      auto run = encodeDirectRun(values, bitWidth);
+      bytes.insert(bytes.end(), run.begin(), run.end());
+    }
+    // Reads from one buffer and from buffers that split the runs, in batches
+    // of different sizes.
+    for (uint64_t blockSize : {0, 7}) {
+      for (size_t batchSize : {1, 7, 548}) {
+        auto rle = createRleDecoder<true>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                bytes.data(), bytes.size(), blockSize),
+            RleVersion_2,
+            *pool,
+            true /* doesn't matter */,
+            dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+        std::vector<int64_t> actual(expected.size());
+        for (size_t i = 0; i < expected.size(); i += batchSize) {
+          rle->next(
+              actual.data() + i,
+              std::min(batchSize, expected.size() - i),
+              nullptr);
+        }
+        ASSERT_EQ(expected, actual)
+            << "bitWidth " << bitWidth << ", blockSize " << blockSize
+            << ", batchSize " << batchSize;
+      }
+    }
+  }
+}
+
+TEST_F(RLEv2Test, bulkReadRows) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  std::vector<unsigned char> bytes;
+  std::vector<int64_t> expected;
+  // DIRECT runs of different widths followed by a SHORT_REPEAT run of 10 x 7.
+  for (auto bitWidth : {5, 17, 32}) {
+    std::vector<uint64_t> values(300);
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = (i * 0x9e3779b97f4a7c15ULL) >> (64 - bitWidth);
+      expected.push_back(
+          static_cast<int64_t>(values[i] >> 1) ^ -(values[i] & 1));
+    }
+    auto run = encodeDirectRun(values, bitWidth);
+    bytes.insert(bytes.end(), run.begin(), run.end());
+  }
+  bytes.insert(bytes.end(), {0x07, 0x0e});
+  expected.insert(expected.end(), 10, 7);
+
+  auto makeDecoder = [&]() {
+    return createRleDecoder<true>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            bytes.data(), bytes.size(), 100),
+        RleVersion_2,
+        *pool,
+        true /* doesn't matter */,
+        dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+  };
+
+  auto decoder = makeDecoder();
+  auto* rle = dynamic_cast<RleDecoderV2<true>*>(decoder.get());
+  std::vector<int32_t> values(expected.size());
+  rle->bulkRead(values.size(), values.data());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(static_cast<int32_t>(expected[i]), values[i]) << i;
+  }
+
+  // Reads every 3rd row after skipping 5, then every row of the tail.
+  std::vector<int32_t> rows;
+  for (auto row = 10; row < 600; row += 3) {
+    rows.push_back(row);
+  }
+  for (int32_t row = 600; row < expected.size(); ++row) {
+    rows.push_back(row);
+  }
+  decoder = makeDecoder();
+  rle = dynamic_cast<RleDecoderV2<true>*>(decoder.get());
+  rle->skip(5);
+  std::vector<int64_t> rowValues(rows.size());
+  rle->bulkReadRows(
+      folly::Range<const int32_t*>(rows.data(), rows.size()),
+      rowValues.data(),
+      5);
+  for (size_t i = 0; i < rows.size(); ++i) {
+    ASSERT_EQ(expected[rows[i]], rowValues[i]) << rows[i];
+  }
+}
+
 class RLEv1Test : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/test/utils/E2EWriterTestUtil.h"
+#include "velox/type/DecimalUtil.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::dwrf;
+
+// Scans DWRF files with one timestamp column with the selective reader. A
+// bigint column of the same row count gives the baseline. The DWRF writer does
+// not write decimals, so the scale adjustment of the decimal readers is
+// measured on decoded values and scales directly.
+
+namespace {
+
+constexpr vector_size_t kBatchSize = 10'000;
+constexpr int32_t kNumBatches = 100;
+
+std::shared_ptr<memory::MemoryPool> rootPool;
+std::shared_ptr<memory::MemoryPool> leafPool;
+
+struct TestFile {
+  RowTypePtr type;
+  // Owns the sink that holds the file.
+  std::unique_ptr<dwrf::Writer> writer;
+  MemorySink* sink;
+};
+
+std::unordered_map<std::string, TestFile> files;
+
+// Writes a file with a single column 'c0' of 'type'. Every 10th row is null.
+template <typename T>
+void writeFile(
+    const std::string& name,
+    const TypePtr& type,
+    std::function<T(vector_size_t)> valueAt) {
+  const auto rowType = ROW({"c0"}, {type});
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    auto values =
+        BaseVector::create<FlatVector<T>>(type, kBatchSize, leafPool.get());
+    for (auto row = 0; row < kBatchSize; ++row) {
+      if (row % 10 == 0) {
+        values->setNull(row, true);
+      } else {
+        values->set(row, valueAt(i * kBatchSize + row));
+      }
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool.get(),
+        rowType,
+        nullptr,
+        kBatchSize,
+        std::vector<VectorPtr>{values}));
+  }
+
+  auto sink = std::make_unique<MemorySink>(
+      1 << 30, FileSink::Options{.pool = leafPool.get()});
+  auto* sinkPtr = sink.get();
+  auto writer = E2EWriterTestUtil::writeData(
+      std::move(sink), rowType, batches, std::make_shared<dwrf::Config>());
+  files[name] = TestFile{rowType, std::move(writer), sinkPtr};
+}
+
+// Reads all rows of the file 'name', applying 'filter' to 'c0' if given.
+void readFile(
+    const std::string& name,
+    std::unique_ptr<common::Filter> filter = nullptr) {
+  folly::BenchmarkSuspender suspender;
+  const auto& file = files.at(name);
+  ReaderOptions readerOptions{leafPool.get()};
+  DwrfReader reader(
+      readerOptions,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(
+              std::string_view(file.sink->data(), file.sink->size())),
+          readerOptions.memoryPool()));
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*file.type);
+  if (filter) {
+    scanSpec->childByName("c0")->setFilter(std::move(filter));
+  }
+  RowReaderOptions rowReaderOptions;
+  rowReaderOptions.setScanSpec(scanSpec);
+  auto rowReader = reader.createRowReader(rowReaderOptions);
+  auto result = BaseVector::create(file.type, 0, leafPool.get());
+  suspender.dismiss();
+
+  uint64_t numRows = 0;
+  while (rowReader->next(kBatchSize, result) > 0) {
+    numRows += result->size();
+  }
+  folly::doNotOptimizeAway(numRows);
+}
+
+// Adjusts decoded values to 'targetScale' like the decimal readers. Every
+// 'mixedScaleEvery'th value has a different scale. Every 10th value is null.
+template <typename T>
+void fillDecimals(int32_t targetScale, int32_t mixedScaleEvery) {
+  folly::BenchmarkSuspender suspender;
+  constexpr int32_t kNumValues = kBatchSize;
+  std::vector<T> values(kNumValues);
+  std::vector<T> decimals(kNumValues);
+  std::vector<int64_t> scales(kNumValues);
+  std::vector<uint64_t> nulls(bits::nwords(kNumValues), bits::kNotNull64);
+  for (auto i = 0; i < kNumValues; ++i) {
+    values[i] = i * 7;
+    scales[i] = i % mixedScaleEvery == 0 ? targetScale - 1 : targetScale;
+    if (i % 10 == 0) {
+      bits::setNull(nulls.data(), i);
+      scales[i] = 0;
+    }
+  }
+  suspender.dismiss();
+
+  for (auto i = 0; i < kNumBatches; ++i) {
+    DecimalUtil::fillDecimals<T>(
+        decimals.data(),
+        nulls.data(),
+        values.data(),
+        scales.data(),
+        kNumValues,
+        targetScale);
+  }
+  folly::doNotOptimizeAway(decimals);
+}
+
+Timestamp timestampAt(vector_size_t row) {
+  // Millisecond precision with varying trailing zeros in the nanos.
+  return Timestamp(1'600'000'000 + row * 7, (row % 1'000) * 1'000'000);
+}
+
+} // namespace
+
+BENCHMARK(bigint) {
+  readFile("bigint");
+}
+
+BENCHMARK_RELATIVE(timestamp) {
+  readFile("timestamp");
+}
+
+BENCHMARK_RELATIVE(timestampFilter) {
+  readFile(
+      "timestamp",
+      std::make_unique<common::TimestampRange>(
+          timestampAt(0), timestampAt(kNumBatches * kBatchSize / 2), false));
+}
+
+BENCHMARK(shortDecimalScale) {
+  fillDecimals<int64_t>(2, kBatchSize + 1);
+}
+
+BENCHMARK_RELATIVE(shortDecimalMixedScale) {
+  fillDecimals<int64_t>(2, 101);
+}
+
+BENCHMARK(longDecimalScale) {
+  fillDecimals<int128_t>(5, kBatchSize + 1);
+}
+
+BENCHMARK_RELATIVE(longDecimalMixedScale) {
+  fillDecimals<int128_t>(5, 101);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  rootPool = memory::memoryManager()->addRootPool(
+      "TimestampDecimalReaderBenchmark");
+  leafPool = rootPool->addLeafChild("leaf");
+
+  writeFile<int64_t>("bigint", BIGINT(), [](auto row) { return row * 7; });
+  writeFile<Timestamp>("timestamp", TIMESTAMP(), timestampAt);
+
+  folly::runBenchmarks();
+  files.clear();
+  leafPool.reset();
+  rootPool.reset();
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
+#include "folly/init/Init.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+// Measures the rows per second written by the DWRF writer as a function of the
+// number of threads used to encode and compress the columns at stripe flush.
+
+constexpr int32_t kNumColumns = 32;
+constexpr vector_size_t kBatchSize = 10'000;
+constexpr int32_t kNumBatches = 20;
+
+namespace {
+
+RowTypePtr makeType() {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < kNumColumns; ++i) {
+    names.push_back(fmt::format("c{}", i));
+    switch (i % 4) {
+      case 0:
+        types.push_back(BIGINT());
+        break;
+      case 1:
+        types.push_back(VARCHAR());
+        break;
+      case 2:
+        types.push_back(DOUBLE());
+        break;
+      default:
+        types.push_back(ARRAY(INTEGER()));
+        break;
+    }
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+// Returns the number of rows written so that the results are per row.
+unsigned runBenchmark(unsigned iterations, size_t numThreads) {
+  folly::BenchmarkSuspender suspender;
+
+  auto rootPool = memory::memoryManager()->addRootPool("WriterFlushBenchmark");
+  auto leafPool = rootPool->addLeafChild("leaf");
+  const auto type = makeType();
+  VectorFuzzer fuzzer(
+      {.vectorSize = kBatchSize, .nullRatio = 0.05, .stringLength = 20},
+      leafPool.get(),
+      1);
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(fuzzer.fuzzInputRow(type));
+  }
+  auto executor = numThreads > 1
+      ? std::make_shared<folly::CPUThreadPoolExecutor>(numThreads)
+      : nullptr;
+
+  suspender.dismiss();
+
+  for (unsigned iter = 0; iter < iterations; ++iter) {
+    auto config = std::make_shared<Config>();
+    config->set(Config::COMPRESSION, common::CompressionKind_ZSTD);
+    WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool.get();
+    options.flushExecutor = executor;
+    options.flushParallelism = numThreads;
+    Writer writer{
+        std::make_unique<dwio::common::MemorySink>(
+            1L << 30, dwio::common::FileSink::Options{.pool = leafPool.get()}),
+        options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+  }
+  return iterations * kNumBatches * kBatchSize;
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM_MULTI(runBenchmark, threads_1, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(runBenchmark, threads_2, 2);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(runBenchmark, threads_4, 4);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(runBenchmark, threads_8, 8);
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  folly::runBenchmarks();
+  return 0;
+}
@@ -16,7 +16,9 @@
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
+#include <deque>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -50,6 +52,54 @@ WriterContext::LocalDecodedVector BaseColumnWriter::decode(
 
 namespace {
 
+// Writes the rows of a dictionary or constant encoded input to a dictionary
+// encoder by mapping each distinct base row once instead of adding every
+// row's value. This is the common case for columns read from a dictionary
+// encoded file and written back, where the input dictionary is much smaller
+// than the number of rows. Calls 'addBaseRow(baseRow, count)' once per
+// referenced non-null base row with the number of rows in 'ranges' that refer
+// to it. 'addBaseRow' adds the value to the encoder and statistics and returns
+// its dictionary index, which is appended to 'rows' for each of these rows in
+// order. Returns the number of null rows, or std::nullopt without writing
+// anything if the input is flat or its base has more rows than 'ranges'.
+template <typename AddBaseRow>
+std::optional<uint64_t> writeDictionaryIndices(
+    const DecodedVector& decodedVector,
+    const common::Ranges& ranges,
+    ChainedBuffer<uint32_t>& rows,
+    AddBaseRow addBaseRow) {
+  if (decodedVector.isIdentityMapping() ||
+      decodedVector.base()->size() > ranges.size()) {
+    return std::nullopt;
+  }
+
+  const auto baseSize = decodedVector.base()->size();
+  std::vector<uint32_t> counts(baseSize, 0);
+  uint64_t nullCount = 0;
+  for (auto& pos : ranges) {
+    if (decodedVector.isNullAt(pos)) {
+      ++nullCount;
+    } else {
+      ++counts[decodedVector.index(pos)];
+    }
+  }
+
+  // Reuse 'counts' for the dictionary indices of the base rows.
+  std::vector<uint32_t>& dictionaryIndices = counts;
+  for (vector_size_t baseRow = 0; baseRow < baseSize; ++baseRow) {
+    if (counts[baseRow] > 0) {
+      dictionaryIndices[baseRow] = addBaseRow(baseRow, counts[baseRow]);
+    }
+  }
+
+  for (auto& pos : ranges) {
+    if (!decodedVector.isNullAt(pos)) {
+      rows.unsafeAppend(dictionaryIndices[decodedVector.index(pos)]);
+    }
+  }
+  return nullCount;
+}
+
 template <typename T>
 class ByteRleColumnWriter : public BaseColumnWriter {
  public:
@@ -508,31 +558,41 @@ uint64_t IntegerColumnWriter<T>::writeDict(
   writeNulls(decodedVector, ranges);
   // make sure we have enough space
   rows_.reserve(rows_.size() + ranges.size());
-  auto processRow = [&](vector_size_t pos) {
-    T value = decodedVector.valueAt<T>(pos);
-    rows_.unsafeAppend(dictEncoder_.addKey(value));
-    statsBuilder.addValues(value);
-  };
+  const auto* baseValues = decodedVector.data<T>();
+  auto nullCount = writeDictionaryIndices(
+      decodedVector, ranges, rows_, [&](vector_size_t baseRow, uint32_t count) {
+        const T value = baseValues[baseRow];
+        statsBuilder.addValues(value, count);
+        return dictEncoder_.addKey(value, count);
+      });
 
-  uint64_t nullCount = 0;
-  if (decodedVector.mayHaveNulls()) {
-    for (auto& pos : ranges) {
-      if (decodedVector.isNullAt(pos)) {
-        ++nullCount;
-      } else {
+  if (!nullCount.has_value()) {
+    auto processRow = [&](vector_size_t pos) {
+      T value = decodedVector.valueAt<T>(pos);
+      rows_.unsafeAppend(dictEncoder_.addKey(value));
+      statsBuilder.addValues(value);
+    };
+
+    nullCount = 0;
+    if (decodedVector.mayHaveNulls()) {
+      for (auto& pos : ranges) {
+        if (decodedVector.isNullAt(pos)) {
+          ++nullCount.value();
+        } else {
+          processRow(pos);
+        }
+      }
+    } else {
+      for (auto& pos : ranges) {
         processRow(pos);
       }
     }
-  } else {
-    for (auto& pos : ranges) {
-      processRow(pos);
-    }
   }
 
-  uint64_t rawSize = (ranges.size() - nullCount) * sizeof(T);
-  if (nullCount > 0) {
+  uint64_t rawSize = (ranges.size() - nullCount.value()) * sizeof(T);
+  if (nullCount.value() > 0) {
     statsBuilder.setHasNull();
-    rawSize += nullCount * NULL_SIZE;
+    rawSize += nullCount.value() * NULL_SIZE;
   }
   statsBuilder.increaseRawSize(rawSize);
   return rawSize;
@@ -1113,31 +1173,42 @@ uint64_t StringColumnWriter::writeDict(
   rows_.reserve(rows_.size() + ranges.size());
   size_t strideIndex = strideOffsets_.size() - 1;
   uint64_t rawSize = 0;
-  auto processRow = [&](size_t pos) {
-    auto sp = decodedVector.valueAt<StringView>(pos);
-    rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
-    statsBuilder.addValues(sp);
-    rawSize += sp.size();
-  };
+  const auto* baseValues = decodedVector.data<StringView>();
+  auto nullCount = writeDictionaryIndices(
+      decodedVector, ranges, rows_, [&](vector_size_t baseRow, uint32_t count) {
+        const auto sp = baseValues[baseRow];
+        statsBuilder.addValues(sp, count);
+        rawSize += sp.size() * count;
+        return dictEncoder_.addKey(sp, strideIndex, count);
+      });
 
-  uint64_t nullCount = 0;
-  if (decodedVector.mayHaveNulls()) {
-    for (auto& pos : ranges) {
-      if (decodedVector.isNullAt(pos)) {
-        ++nullCount;
-      } else {
+  if (!nullCount.has_value()) {
+    auto processRow = [&](size_t pos) {
+      auto sp = decodedVector.valueAt<StringView>(pos);
+      rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
+      statsBuilder.addValues(sp);
+      rawSize += sp.size();
+    };
+
+    nullCount = 0;
+    if (decodedVector.mayHaveNulls()) {
+      for (auto& pos : ranges) {
+        if (decodedVector.isNullAt(pos)) {
+          ++nullCount.value();
+        } else {
+          processRow(pos);
+        }
+      }
+    } else {
+      for (auto& pos : ranges) {
         processRow(pos);
       }
     }
-  } else {
-    for (auto& pos : ranges) {
-      processRow(pos);
-    }
   }
 
-  if (nullCount > 0) {
+  if (nullCount.value() > 0) {
     statsBuilder.setHasNull();
-    rawSize += nullCount * NULL_SIZE;
+    rawSize += nullCount.value() * NULL_SIZE;
   }
   statsBuilder.increaseRawSize(rawSize);
   return rawSize;
@@ -1613,18 +1684,59 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
+    // Only the columns of the root struct are flushed in parallel so that
+    // nested flushes never wait on the executor from inside a flush task.
+    if (id_ == 0 && context_.flushExecutor() != nullptr &&
+        children_.size() > 1) {
+      flushChildrenInParallel(encodingFactory);
+      return;
+    }
     for (auto& c : children_) {
       c->flush(encodingFactory);
     }
   }
 
  private:
+  void flushChildrenInParallel(
+      const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
 };
 
+void StructColumnWriter::flushChildrenInParallel(
+    const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory) {
+  // Each child collects its encodings locally. They are added to the stripe
+  // footer in child order once all children are flushed, so the footer is the
+  // same as with a sequential flush. The stream order is decided afterwards by
+  // the layout planner and does not depend on the flush order either.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      childEncodings(children_.size());
+  ParallelFor(
+      context_.flushExecutor(),
+      0,
+      children_.size(),
+      std::min(children_.size(), context_.flushParallelism()))
+      .execute([&](size_t i) {
+        auto& encodings = childEncodings[i];
+        children_[i]->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
+          return encodings
+              .emplace_back(
+                  std::piecewise_construct,
+                  std::forward_as_tuple(nodeId),
+                  std::forward_as_tuple())
+              .second;
+        });
+      });
+  for (auto& encodings : childEncodings) {
+    for (auto& [nodeId, encoding] : encodings) {
+      encodingFactory(nodeId).Swap(&encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
@@ -82,6 +82,9 @@ Writer::Writer(
       "Unexpected memory usage on dwrf writer construction");
   setMemoryReclaimers(pool);
   writerBase_->initBuffers();
+  if (options.flushExecutor != nullptr) {
+    context.setFlushExecutor(options.flushExecutor, options.flushParallelism);
+  }
 
   context.buildPhysicalSizeAggregators(*schema_);
   if (options.flushPolicyFactory == nullptr) {
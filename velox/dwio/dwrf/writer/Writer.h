@@ -51,6 +51,12 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the top level columns are encoded and compressed in parallel on
+  /// this executor when a stripe is flushed, using up to 'flushParallelism'
+  /// threads including the calling thread. The output is the same as with a
+  /// sequential flush.
+  std::shared_ptr<folly::Executor> flushExecutor;
+  size_t flushParallelism{1};
 };
 
 class Writer : public dwio::common::Writer {
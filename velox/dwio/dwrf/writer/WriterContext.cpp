@@ -155,6 +155,7 @@ int64_t WriterContext::releaseMemoryReservation() {
 
 void WriterContext::abort() {
   compressionBuffer_.reset();
+  spareCompressionBuffers_.clear();
   physicalSizeAggregators_.clear();
   streams_.clear();
   dictEncoders_.clear();
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -254,8 +256,23 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  /// Column writers flushed in parallel compress their streams concurrently.
+  /// The first caller gets 'compressionBuffer_', the others get spare buffers
+  /// that are allocated on demand and kept for the following stripes.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ == nullptr && flushExecutor_ != nullptr &&
+        compression_ != common::CompressionKind_NONE) {
+      if (!spareCompressionBuffers_.empty()) {
+        auto buffer = std::move(spareCompressionBuffers_.back());
+        spareCompressionBuffers_.pop_back();
+        VELOX_CHECK_GE(buffer->size(), size);
+        return buffer;
+      }
+      return std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -264,10 +281,37 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffer_ != nullptr) {
+      VELOX_CHECK_NOT_NULL(flushExecutor_);
+      spareCompressionBuffers_.push_back(std::move(buffer));
+      return;
+    }
     compressionBuffer_ = std::move(buffer);
   }
 
+  /// Sets the executor on which the top level columns are encoded and
+  /// compressed in parallel at stripe flush, using up to 'parallelism'
+  /// threads. Not used for encrypted files since encrypters may be shared
+  /// between columns.
+  void setFlushExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelism) {
+    if (handler_->isEncrypted() || parallelism <= 1) {
+      return;
+    }
+    flushExecutor_ = std::move(executor);
+    flushParallelism_ = parallelism;
+  }
+
+  folly::Executor* flushExecutor() const {
+    return flushExecutor_.get();
+  }
+
+  size_t flushParallelism() const {
+    return flushParallelism_;
+  }
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
   }
@@ -647,6 +691,12 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Extra compression buffers used by column writers flushed in parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      spareCompressionBuffers_;
+  std::mutex compressionBufferMutex_;
+  std::shared_ptr<folly::Executor> flushExecutor_;
+  size_t flushParallelism_{1};
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+/// Decodes BYTE_STREAM_SPLIT. A page of N values of 'byteWidth' bytes is
+/// stored as 'byteWidth' streams of N bytes where stream b holds byte b of
+/// every value. Supports 4 and 8 byte FLOAT, DOUBLE, INT32 and INT64 values.
+class ByteStreamSplitDecoder {
+ public:
+  ByteStreamSplitDecoder(const char* start, const char* end, int32_t byteWidth)
+      : bufferStart_(start),
+        byteWidth_(byteWidth),
+        numValues_((end - start) / byteWidth),
+        index_(0) {
+    VELOX_CHECK(
+        byteWidth_ == sizeof(int32_t) || byteWidth_ == sizeof(int64_t),
+        "Unsupported BYTE_STREAM_SPLIT width: {}",
+        byteWidth_);
+    VELOX_CHECK_EQ(
+        (end - start) % byteWidth_,
+        0,
+        "BYTE_STREAM_SPLIT data size is not a multiple of the value width");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(index_ + numValues, numValues_);
+    index_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(read<typename Visitor::DataType>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the next value converted to T. FLOAT and INT32 are stored in 4
+  /// bytes, DOUBLE and INT64 in 8.
+  template <typename T>
+  T read() {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (byteWidth_ == sizeof(float)) {
+        return gather<float>();
+      }
+      return gather<double>();
+    } else {
+      if (byteWidth_ == sizeof(int32_t)) {
+        return gather<int32_t>();
+      }
+      return gather<int64_t>();
+    }
+  }
+
+ private:
+  // Assembles the value at 'index_' from one byte of each stream.
+  template <typename T>
+  T gather() {
+    VELOX_DCHECK_LT(index_, numValues_);
+    uint8_t bytes[sizeof(T)];
+    const char* byte = bufferStart_ + index_;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      bytes[i] = byte[i * numValues_];
+    }
+    ++index_;
+    T value;
+    memcpy(&value, bytes, sizeof(T));
+    return value;
+  }
+
+  const char* const bufferStart_;
+  const int32_t byteWidth_;
+  const int64_t numValues_;
+  int64_t index_;
+};
+
+} // namespace facebook::velox::parquet
@@ -78,6 +78,70 @@ class DeltaBpDecoder {
     }
   }
 
+  /// Number of values in the run as recorded in the header.
+  uint64_t totalValueCount() const {
+    return totalValueCount_;
+  }
+
+  /// Returns the first byte after the encoded run. Only valid after all
+  /// values have been read. DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY place
+  /// other data after a DELTA_BINARY_PACKED run.
+  const char* valuesEnd() const {
+    if (firstBlockInitialized_ && valuesRemainingCurrentMiniBlock_ > 0) {
+      // The last miniblock is padded to its full size.
+      return bufferStart_ + bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    }
+    return bufferStart_;
+  }
+
+  int64_t readLong() {
+    int64_t value = 0;
+    if (valuesRemainingCurrentMiniBlock_ == 0) {
+      if (!firstBlockInitialized_) {
+        value = lastValue_;
+        // When block is uninitialized we have two different possibilities:
+        // 1. totalValueCount_ == 1, which means that the page may have only
+        // one value (encoded in the header), and we should not initialize
+        // any block.
+        // 2. totalValueCount_ != 1, which means we should initialize the
+        // incoming block for subsequent reads.
+        if (totalValueCount_ != 1) {
+          initBlock();
+        }
+        return value;
+      } else {
+        ++miniBlockIdx_;
+        if (miniBlockIdx_ < miniBlocksPerBlock_) {
+          initMiniBlock(deltaBitWidths_[miniBlockIdx_]);
+        } else {
+          initBlock();
+        }
+      }
+    }
+
+    uint64_t consumedBits =
+        (valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_) *
+        deltaBitWidth_;
+    bits::copyBits(
+        reinterpret_cast<const uint64_t*>(bufferStart_),
+        consumedBits,
+        reinterpret_cast<uint64_t*>(&value),
+        0,
+        deltaBitWidth_);
+    // Addition between minDelta_, packed int and lastValue_ should be treated
+    // as unsigned addition. Overflow is as expected.
+    value = static_cast<uint64_t>(minDelta_) + static_cast<uint64_t>(value) +
+        static_cast<uint64_t>(lastValue_);
+    lastValue_ = value;
+    valuesRemainingCurrentMiniBlock_--;
+    totalValuesRemaining_--;
+
+    if (valuesRemainingCurrentMiniBlock_ == 0) {
+      bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    }
+    return value;
+  }
+
  private:
   bool getVlqInt(uint64_t& v) {
     uint64_t tmp = 0;
@@ -159,54 +223,6 @@ class DeltaBpDecoder {
     valuesRemainingCurrentMiniBlock_ = valuesPerMiniBlock_;
   }
 
-  int64_t readLong() {
-    int64_t value = 0;
-    if (valuesRemainingCurrentMiniBlock_ == 0) {
-      if (!firstBlockInitialized_) {
-        value = lastValue_;
-        // When block is uninitialized we have two different possibilities:
-        // 1. totalValueCount_ == 1, which means that the page may have only
-        // one value (encoded in the header), and we should not initialize
-        // any block.
-        // 2. totalValueCount_ != 1, which means we should initialize the
-        // incoming block for subsequent reads.
-        if (totalValueCount_ != 1) {
-          initBlock();
-        }
-        return value;
-      } else {
-        ++miniBlockIdx_;
-        if (miniBlockIdx_ < miniBlocksPerBlock_) {
-          initMiniBlock(deltaBitWidths_[miniBlockIdx_]);
-        } else {
-          initBlock();
-        }
-      }
-    }
-
-    uint64_t consumedBits =
-        (valuesPerMiniBlock_ - valuesRemainingCurrentMiniBlock_) *
-        deltaBitWidth_;
-    bits::copyBits(
-        reinterpret_cast<const uint64_t*>(bufferStart_),
-        consumedBits,
-        reinterpret_cast<uint64_t*>(&value),
-        0,
-        deltaBitWidth_);
-    // Addition between minDelta_, packed int and lastValue_ should be treated
-    // as unsigned addition. Overflow is as expected.
-    value = static_cast<uint64_t>(minDelta_) + static_cast<uint64_t>(value) +
-        static_cast<uint64_t>(lastValue_);
-    lastValue_ = value;
-    valuesRemainingCurrentMiniBlock_--;
-    totalValuesRemaining_--;
-
-    if (valuesRemainingCurrentMiniBlock_ == 0) {
-      bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
-    }
-    return value;
-  }
-
   static constexpr int kMaxDeltaBitWidth =
       static_cast<int>(sizeof(int64_t) * 8);
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+namespace facebook::velox::parquet {
+
+/// Decodes DELTA_BYTE_ARRAY, also known as incremental encoding. Each value is
+/// stored as the length of the prefix it shares with the previous value and
+/// the remaining suffix. The prefix lengths come first as a
+/// DELTA_BINARY_PACKED run, followed by the suffixes in
+/// DELTA_LENGTH_BYTE_ARRAY encoding. Since every value depends on the previous
+/// one, skipped values are still decoded.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(const char* start, const char* end)
+      : prefixIndex_(0), suffixDecoder_(decodePrefixes(start), end) {}
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the next value. The returned range is valid until the next call.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(prefixIndex_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[prefixIndex_++];
+    VELOX_CHECK_LE(
+        prefixLength, lastValue_.size(), "Prefix longer than previous value");
+    const auto suffix = suffixDecoder_.readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+ private:
+  // Decodes the prefix lengths and returns the start of the suffixes.
+  const char* decodePrefixes(const char* start) {
+    DeltaBpDecoder prefixDecoder(start);
+    const auto numValues = prefixDecoder.totalValueCount();
+    prefixLengths_.resize(numValues);
+    for (uint64_t i = 0; i < numValues; ++i) {
+      prefixLengths_[i] = prefixDecoder.readLong();
+    }
+    return prefixDecoder.valuesEnd();
+  }
+
+  std::vector<int32_t> prefixLengths_;
+  size_t prefixIndex_;
+  DeltaLengthByteArrayDecoder suffixDecoder_;
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
@@ -36,6 +36,11 @@ class FloatingPointColumnReader
       ParquetParams& params,
       common::ScanSpec& scanSpec);
 
+  bool hasBulkPath() const override {
+    return base::hasBulkPath() &&
+        !this->formatData_->template as<ParquetData>().isByteStreamSplit();
+  }
+
   void seekToRowGroup(uint32_t index) override {
     base::seekToRowGroup(index);
     this->scanState().clear();
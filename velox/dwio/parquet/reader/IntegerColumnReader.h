@@ -35,6 +35,7 @@ class IntegerColumnReader : public dwio::common::SelectiveIntegerColumnReader {
 
   bool hasBulkPath() const override {
     return !formatData_->as<ParquetData>().isDeltaBinaryPacked() &&
+        !formatData_->as<ParquetData>().isByteStreamSplit() &&
         !this->fileType().type()->isLongDecimal() &&
         ((this->fileType().type()->isShortDecimal())
              ? formatData_->as<ParquetData>().hasDictionary()
@@ -16,6 +16,9 @@
 
 #include "velox/dwio/parquet/reader/Metadata.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
 
 namespace facebook::velox::parquet {
 
@@ -241,6 +244,143 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::allDataPagesDictionaryEncoded() const {
+  if (!hasMetadata()) {
+    return false;
+  }
+  const auto& metadata = thriftColumnChunkPtr(ptr_)->meta_data;
+  const auto isDictionaryEncoding = [](thrift::Encoding::type encoding) {
+    return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+        encoding == thrift::Encoding::RLE_DICTIONARY;
+  };
+  if (metadata.__isset.encoding_stats) {
+    for (const auto& stats : metadata.encoding_stats) {
+      if (stats.page_type != thrift::PageType::DICTIONARY_PAGE &&
+          stats.count > 0 && !isDictionaryEncoding(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Without page encoding stats, the dictionary page itself may be listed as
+  // PLAIN, which cannot be told apart from a fallback to PLAIN. Allow only
+  // the dictionary encodings and the encodings of repetition and definition
+  // levels.
+  bool hasDictionaryEncoding = false;
+  for (const auto encoding : metadata.encodings) {
+    if (isDictionaryEncoding(encoding)) {
+      hasDictionaryEncoding = true;
+    } else if (
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return hasDictionaryEncoding;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilterOffset() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilterOffset());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  auto* columnChunk = thriftColumnChunkPtr(ptr_);
+  return columnChunk->__isset.column_index_offset &&
+      columnChunk->__isset.column_index_length &&
+      columnChunk->__isset.offset_index_offset &&
+      columnChunk->__isset.offset_index_length &&
+      columnChunk->column_index_length > 0 &&
+      columnChunk->offset_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
+namespace {
+template <typename T>
+std::unique_ptr<T> deserializeThrift(const char* data, int32_t length) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  auto result = std::make_unique<T>();
+  result->read(&protocol);
+  return result;
+}
+} // namespace
+
+PageIndex::PageIndex(
+    const char* columnIndex,
+    int32_t columnIndexLength,
+    const char* offsetIndex,
+    int32_t offsetIndexLength)
+    : columnIndex_(deserializeThrift<thrift::ColumnIndex>(
+          columnIndex,
+          columnIndexLength)),
+      offsetIndex_(deserializeThrift<thrift::OffsetIndex>(
+          offsetIndex,
+          offsetIndexLength)) {
+  VELOX_CHECK_EQ(
+      columnIndex_->null_pages.size(),
+      offsetIndex_->page_locations.size(),
+      "ColumnIndex and OffsetIndex disagree on the number of pages");
+  VELOX_CHECK_EQ(
+      columnIndex_->min_values.size(), columnIndex_->null_pages.size());
+  VELOX_CHECK_EQ(
+      columnIndex_->max_values.size(), columnIndex_->null_pages.size());
+}
+
+PageIndex::~PageIndex() = default;
+
+int32_t PageIndex::numPages() const {
+  return offsetIndex_->page_locations.size();
+}
+
+int64_t PageIndex::firstRowIndex(int32_t page) const {
+  return offsetIndex_->page_locations[page].first_row_index;
+}
+
+bool PageIndex::isNullPage(int32_t page) const {
+  return columnIndex_->null_pages[page];
+}
+
+std::unique_ptr<dwio::common::ColumnStatistics> PageIndex::pageStatistics(
+    int32_t page,
+    const TypePtr& type,
+    int64_t numRowsInPage) const {
+  thrift::Statistics stats;
+  stats.__set_min_value(columnIndex_->min_values[page]);
+  stats.__set_max_value(columnIndex_->max_values[page]);
+  if (columnIndex_->__isset.null_counts &&
+      page < columnIndex_->null_counts.size()) {
+    stats.__set_null_count(columnIndex_->null_counts[page]);
+  }
+  return buildColumnStatisticsFromThrift(stats, *type, numRowsInPage);
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
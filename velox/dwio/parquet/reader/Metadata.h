@@ -21,6 +21,11 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class ColumnIndex;
+class OffsetIndex;
+} // namespace thrift
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -55,6 +60,11 @@ class ColumnChunkMetaDataPtr {
   /// The compression.
   common::CompressionKind compression() const;
 
+  /// True if the ColumnChunk metadata shows that all data pages are dictionary
+  /// encoded, so that the dictionary page has all the values of the chunk.
+  /// False if some data page may have fallen back to another encoding.
+  bool allDataPagesDictionaryEncoded() const;
+
   /// Total byte size of all the compressed (and potentially encrypted)
   /// column data in this row group.
   /// This information is optional and may be 0 if omitted.
@@ -65,10 +75,66 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the Bloom filter offset in ColumnChunk metadata.
+  bool hasBloomFilterOffset() const;
+
+  /// File offset of the BloomFilterHeader followed by the Bloom filter bitset.
+  /// Must check for its presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
+  /// Check the presence of both the ColumnIndex and the OffsetIndex of the
+  /// ColumnChunk.
+  bool hasPageIndex() const;
+
+  /// File offset and length of the ColumnIndex. Must check for its presence
+  /// using hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// File offset and length of the OffsetIndex. Must check for its presence
+  /// using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
  private:
   const void* ptr_;
 };
 
+/// PageIndex holds the deserialized ColumnIndex and OffsetIndex of a
+/// ColumnChunk. These give per data page min/max statistics and row ranges
+/// that allow skipping pages that cannot match a filter.
+class PageIndex {
+ public:
+  /// Deserializes the ColumnIndex from 'columnIndex' and the OffsetIndex from
+  /// 'offsetIndex'.
+  PageIndex(
+      const char* columnIndex,
+      int32_t columnIndexLength,
+      const char* offsetIndex,
+      int32_t offsetIndexLength);
+
+  ~PageIndex();
+
+  /// Number of data pages in the ColumnChunk.
+  int32_t numPages() const;
+
+  /// Index of the first row of 'page' within the row group.
+  int64_t firstRowIndex(int32_t page) const;
+
+  /// True if 'page' contains only nulls.
+  bool isNullPage(int32_t page) const;
+
+  /// Returns the statistics of 'page'. 'numRowsInPage' is the number of
+  /// top level rows in 'page'.
+  std::unique_ptr<dwio::common::ColumnStatistics>
+  pageStatistics(int32_t page, const TypePtr& type, int64_t numRowsInPage)
+      const;
+
+ private:
+  std::unique_ptr<thrift::ColumnIndex> columnIndex_;
+  std::unique_ptr<thrift::OffsetIndex> offsetIndex_;
+};
+
 /// RowGroupMetaDataPtr is a proxy around pointer to thrift::RowGroup.
 class RowGroupMetaDataPtr {
  public:
@@ -31,6 +31,7 @@ using thrift::PageHeader;
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
+  pagePruned_ = false;
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
@@ -46,9 +47,11 @@ void PageReader::seekToPage(int64_t row) {
 
     switch (pageHeader.type) {
       case thrift::PageType::DATA_PAGE:
+        ++dataPageIndex_;
         prepareDataPageV1(pageHeader, row);
         break;
       case thrift::PageType::DATA_PAGE_V2:
+        ++dataPageIndex_;
         prepareDataPageV2(pageHeader, row);
         break;
       case thrift::PageType::DICTIONARY_PAGE:
@@ -189,6 +192,17 @@ void PageReader::updateRowInfoAfterPageSkipped() {
   }
 }
 
+void PageReader::skipPrunedPage(const PageHeader& pageHeader) {
+  dwio::common::skipBytes(
+      pageHeader.compressed_page_size,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  pagePruned_ = true;
+  ++stats_->skippedPages;
+  stats_->skippedPageBytes += pageHeader.compressed_page_size;
+}
+
 void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   VELOX_CHECK(
       pageHeader.type == thrift::PageType::DATA_PAGE &&
@@ -205,6 +219,10 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
 
     return;
   }
+  if (row != kRepDefOnly && isCurrentPagePruned()) {
+    skipPrunedPage(pageHeader);
+    return;
+  }
   pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
   pageData_ = decompressData(
       pageData_,
@@ -260,6 +278,10 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
         bufferEnd_);
     return;
   }
+  if (row != kRepDefOnly && isCurrentPagePruned()) {
+    skipPrunedPage(pageHeader);
+    return;
+  }
 
   uint32_t defineLength =
       pageHeader.data_page_header_v2.definition_levels_byte_length;
@@ -462,6 +484,17 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
+const dwio::common::DictionaryValues* PageReader::readDictionaryPage() {
+  VELOX_CHECK_EQ(pageStart_, 0);
+  const auto pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return nullptr;
+  }
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  prepareDictionary(pageHeader);
+  return &dictionary_;
+}
+
 void PageReader::makeFilterCache(dwio::common::ScanState& state) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
@@ -651,6 +684,49 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      switch (parquetType) {
+        case thrift::Type::BYTE_ARRAY:
+          deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+          break;
+        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+          if (type_->type()->isVarbinary()) {
+            deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+                pageData_, pageData_ + encodedDataSize_);
+            break;
+          }
+          [[fallthrough]];
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BYTE_ARRAY decoder only supports binary values");
+      }
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType));
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports 4 and 8 byte values");
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -670,6 +746,10 @@ void PageReader::skip(int64_t numRows) {
     toSkip -= rowOfPage_ - firstUnvisited_;
   }
   firstUnvisited_ += numRows;
+  if (pagePruned_) {
+    // Nothing is decoded on a pruned page.
+    return;
+  }
 
   // Skip nulls
   toSkip = skipNulls(toSkip);
@@ -677,6 +757,12 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::BYTE_STREAM_SPLIT) {
+    byteStreamSplitDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -802,6 +888,23 @@ bool PageReader::rowsForPage(
       numLeafNullsConsumed_ = rowOfPage_;
     }
   }
+  while (pagePruned_) {
+    // No row on a pruned page passes the filter. Consume the rows to visit on
+    // the page without decoding and continue at the next page with rows to
+    // visit.
+    VELOX_CHECK(hasFilter, "Pruned Parquet page read without filter");
+    const int32_t firstOnNextPage = rowOfPage_ + numRowsInPage_ - visitBase_;
+    auto it = std::lower_bound(
+        visitorRows_ + currentVisitorRow_,
+        visitorRows_ + numVisitorRows_,
+        firstOnNextPage);
+    currentVisitorRow_ = it - visitorRows_;
+    firstUnvisited_ = visitBase_ + visitorRows_[currentVisitorRow_ - 1] + 1;
+    if (currentVisitorRow_ == numVisitorRows_) {
+      return false;
+    }
+    seekToPage(visitBase_ + visitorRows_[currentVisitorRow_]);
+  }
   auto& scanState = reader.scanState();
   if (isDictionary()) {
     if (scanState.dictionary.values != dictionary_.values) {
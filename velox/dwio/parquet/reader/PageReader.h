@@ -22,7 +22,10 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -127,6 +130,10 @@ class PageReader {
     return encoding_ == thrift::Encoding::DELTA_BINARY_PACKED;
   }
 
+  bool isByteStreamSplit() const {
+    return encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT;
+  }
+
   /// Returns the range of repdefs for the top level rows covered by the last
   /// decoderepDefs().
   std::pair<int32_t, int32_t> repDefRange() const {
@@ -137,6 +144,24 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Reads the dictionary page at the start of the ColumnChunk and returns its
+  /// values. Returns nullptr if the first page is not a dictionary page. Used
+  /// for testing a filter against the dictionary without reading data pages.
+  const dwio::common::DictionaryValues* readDictionaryPage();
+
+  /// Sets the data pages of the ColumnChunk that can be skipped without
+  /// decoding because no value in them can pass the filter of the
+  /// column. 'pages[i]' corresponds to the i-th data page. Skipped pages
+  /// are counted in 'stats'. Only applies to top level columns read with a
+  /// filter.
+  void setPrunedPages(
+      std::vector<bool> pages,
+      dwio::common::ColumnReaderStatistics& stats) {
+    VELOX_CHECK(isTopLevel_);
+    prunedPages_ = std::move(pages);
+    stats_ = &stats;
+  }
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -188,6 +213,15 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // True if the current data page is marked in 'prunedPages_'.
+  bool isCurrentPagePruned() const {
+    return dataPageIndex_ < prunedPages_.size() && prunedPages_[dataPageIndex_];
+  }
+
+  // Skips the data of a page that is pruned by the page index without
+  // decompressing it.
+  void skipPrunedPage(const thrift::PageHeader& pageHeader);
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
@@ -268,6 +302,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         nullsFromFastPath = false;
         deltaBpDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        nullsFromFastPath = false;
+        byteStreamSplitDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -278,6 +315,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         deltaBpDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        byteStreamSplitDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -297,6 +336,12 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -305,6 +350,10 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -373,6 +422,21 @@ class PageReader {
   // Number of leaf values in each data page of column chunk.
   std::vector<int32_t> numLeavesInPage_;
 
+  // For each data page, true if the page index shows that no value in the page
+  // passes the filter. Empty if the page index is not used.
+  std::vector<bool> prunedPages_;
+
+  // Ordinal of the current data page in the column chunk. -1 means before
+  // first data page.
+  int32_t dataPageIndex_{-1};
+
+  // True if the current page is in 'prunedPages_'. The page's data is skipped
+  // and no decoder is set for it.
+  bool pagePruned_{false};
+
+  // Receives the count of pruned pages. Set together with 'prunedPages_'.
+  dwio::common::ColumnReaderStatistics* stats_{nullptr};
+
   // First position in '*levels_' for the range of last decodeRepDefs().
   int32_t repDefBegin_{0};
 
@@ -479,6 +543,9 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+  std::unique_ptr<ByteStreamSplitDecoder> byteStreamSplitDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,13 +17,19 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
 
 namespace facebook::velox::parquet {
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_, scanSpec, pool(), runtimeStatistics(), input_);
 }
 
 void ParquetData::filterRowGroups(
@@ -42,9 +48,13 @@ void ParquetData::filterRowGroups(
     result.metadataFilterResults.emplace_back(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
-  if (scanSpec.filter() || scanSpec.numMetadataFilters() > 0) {
+  // A member of a disjunction cannot drop a row group on its own.
+  auto* filter = scanSpec.disjunction() == common::ScanSpec::kNoDisjunction
+      ? scanSpec.filter()
+      : nullptr;
+  if (filter || scanSpec.numMetadataFilters() > 0) {
     for (auto i = 0; i < fileMetaDataPtr_.numRowGroups(); ++i) {
-      if (scanSpec.filter() && !rowGroupMatches(i, scanSpec.filter())) {
+      if (filter && !rowGroupMatches(i, filter)) {
         bits::setBit(result.filterResult.data(), i);
         continue;
       }
@@ -75,11 +85,246 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   if (columnChunk.hasStatistics()) {
     auto columnStats =
         columnChunk.getColumnStatistics(type, rowGroup.numRows());
-    return testFilter(filter, columnStats.get(), rowGroup.numRows(), type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.numRows(), type)) {
+      return false;
+    }
+  }
+  if (!bloomFilterMatches(columnChunk, *filter)) {
+    ++stats_.skippedStridesByBloomFilter;
+    return false;
+  }
+  if (!dictionaryMatches(columnChunk, *filter)) {
+    ++stats_.skippedStridesByDictionary;
+    return false;
   }
   return true;
 }
 
+namespace {
+// Size of the first read of a Bloom filter. Covers the BloomFilterHeader.
+constexpr uint64_t kBloomFilterHeaderReadSize = 256;
+
+bool isEqualityFilter(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesRange:
+      return static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the encoding of values in a Bloom filter of a column of 'type', or
+// std::nullopt if Velox filter values cannot be hashed the same way as the
+// writer hashed the column values.
+std::optional<SplitBlockBloomFilter::ValueKind> bloomFilterValueKind(
+    const ParquetTypeWithId& type) {
+  if (!type.parquetType_.has_value() || type.type()->isDecimal()) {
+    return std::nullopt;
+  }
+  if (type.logicalType_.has_value() && type.logicalType_->__isset.INTEGER &&
+      !type.logicalType_->INTEGER.isSigned) {
+    return std::nullopt;
+  }
+  switch (type.parquetType_.value()) {
+    case thrift::Type::INT32:
+      return SplitBlockBloomFilter::ValueKind::kInt32;
+    case thrift::Type::INT64:
+      return SplitBlockBloomFilter::ValueKind::kInt64;
+    case thrift::Type::BYTE_ARRAY:
+      return SplitBlockBloomFilter::ValueKind::kBytes;
+    default:
+      return std::nullopt;
+  }
+}
+
+// Physical representation of the dictionary values of a column that a filter
+// can be tested against.
+enum class DictionaryValueKind { kInt32, kInt64, kFloat, kDouble, kBytes };
+
+// Returns how to test the dictionary values of a column of 'type' against a
+// filter on the column, or std::nullopt if the filter is not applied to the
+// physical values as they are, e.g. for decimals and timestamps.
+std::optional<DictionaryValueKind> dictionaryValueKind(
+    const ParquetTypeWithId& type) {
+  if (!type.parquetType_.has_value() || type.type()->isDecimal()) {
+    return std::nullopt;
+  }
+  if (type.logicalType_.has_value() && type.logicalType_->__isset.INTEGER &&
+      !type.logicalType_->INTEGER.isSigned) {
+    return std::nullopt;
+  }
+  const auto kind = type.type()->kind();
+  switch (type.parquetType_.value()) {
+    case thrift::Type::INT32:
+      if (kind == TypeKind::TINYINT || kind == TypeKind::SMALLINT ||
+          kind == TypeKind::INTEGER || kind == TypeKind::BIGINT) {
+        return DictionaryValueKind::kInt32;
+      }
+      break;
+    case thrift::Type::INT64:
+      if (kind == TypeKind::BIGINT) {
+        return DictionaryValueKind::kInt64;
+      }
+      break;
+    case thrift::Type::FLOAT:
+      if (kind == TypeKind::REAL) {
+        return DictionaryValueKind::kFloat;
+      }
+      break;
+    case thrift::Type::DOUBLE:
+      if (kind == TypeKind::DOUBLE) {
+        return DictionaryValueKind::kDouble;
+      }
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+        return DictionaryValueKind::kBytes;
+      }
+      break;
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+template <typename T, typename Test>
+bool anyDictionaryValuePasses(
+    const dwio::common::DictionaryValues& dictionary,
+    Test test) {
+  const auto* values = dictionary.values->as<T>();
+  for (auto i = 0; i < dictionary.numValues; ++i) {
+    if (test(values[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool anyDictionaryValuePasses(
+    const dwio::common::DictionaryValues& dictionary,
+    DictionaryValueKind kind,
+    const common::Filter& filter) {
+  switch (kind) {
+    case DictionaryValueKind::kInt32:
+      return anyDictionaryValuePasses<int32_t>(
+          dictionary, [&](auto value) { return filter.testInt64(value); });
+    case DictionaryValueKind::kInt64:
+      return anyDictionaryValuePasses<int64_t>(
+          dictionary, [&](auto value) { return filter.testInt64(value); });
+    case DictionaryValueKind::kFloat:
+      return anyDictionaryValuePasses<float>(
+          dictionary, [&](auto value) { return filter.testFloat(value); });
+    case DictionaryValueKind::kDouble:
+      return anyDictionaryValuePasses<double>(
+          dictionary, [&](auto value) { return filter.testDouble(value); });
+    case DictionaryValueKind::kBytes:
+      return anyDictionaryValuePasses<StringView>(
+          dictionary, [&](const auto& value) {
+            return filter.testBytes(value.data(), value.size());
+          });
+  }
+  VELOX_UNREACHABLE();
+}
+} // namespace
+
+bool ParquetData::dictionaryMatches(
+    const ColumnChunkMetaDataPtr& chunk,
+    const common::Filter& filter) {
+  // Nulls are not in the dictionary. Only top level columns are pruned, as
+  // for the page index.
+  if (!input_ || filter.testNull() || maxRepeat_ > 0 ||
+      !chunk.hasDictionaryPageOffset() ||
+      !chunk.allDataPagesDictionaryEncoded()) {
+    return true;
+  }
+  const auto valueKind = dictionaryValueKind(*type_);
+  if (!valueKind.has_value()) {
+    return true;
+  }
+  // Some writers set the dictionary page offset without writing a dictionary
+  // page. See enqueueRowGroup().
+  const int64_t offset = chunk.dictionaryPageOffset();
+  const int64_t dataOffset = chunk.dataPageOffset();
+  if (offset < 4 || dataOffset <= offset) {
+    return true;
+  }
+  const auto size = dataOffset - offset;
+  PageReader reader(
+      input_->read(offset, size, dwio::common::LogType::STRIPE_INDEX),
+      pool_,
+      type_,
+      chunk.compression(),
+      size);
+  const auto* dictionary = reader.readDictionaryPage();
+  return dictionary == nullptr ||
+      anyDictionaryValuePasses(*dictionary, valueKind.value(), filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    const ColumnChunkMetaDataPtr& chunk,
+    const common::Filter& filter) {
+  if (!input_ || !chunk.hasBloomFilterOffset() || filter.testNull() ||
+      !isEqualityFilter(filter)) {
+    return true;
+  }
+  auto valueKind = bloomFilterValueKind(*type_);
+  if (!valueKind.has_value()) {
+    return true;
+  }
+  const uint64_t offset = chunk.bloomFilterOffset();
+  const uint64_t fileSize = input_->getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset past end of file");
+
+  // The header is read through 'input_' so that it and the bitset can be
+  // served from the cache if 'input_' is cached.
+  auto headerStream = input_->read(
+      offset,
+      std::min(kBloomFilterHeaderReadSize, fileSize - offset),
+      dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  {
+    const void* buffer;
+    int32_t size;
+    VELOX_CHECK(headerStream->Next(&buffer, &size));
+    bufferStart = reinterpret_cast<const char*>(buffer);
+    bufferEnd = bufferStart + size;
+  }
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftStreamingTransport>(
+          headerStream.get(), bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const uint64_t headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % SplitBlockBloomFilter::kBytesPerBlock != 0 ||
+      offset + headerSize + header.numBytes > fileSize) {
+    return true;
+  }
+  std::string bitset(header.numBytes, '\0');
+  auto bitsetStream = input_->read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  bufferStart = bufferEnd = nullptr;
+  dwio::common::readBytes(
+      header.numBytes,
+      bitsetStream.get(),
+      bitset.data(),
+      bufferStart,
+      bufferEnd);
+  SplitBlockBloomFilter bloomFilter(std::move(bitset));
+  return bloomFilter.mayContain(filter, valueKind.value());
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -103,7 +348,93 @@ void ParquetData::enqueueRowGroup(
       : chunk.totalCompressedSize();
 
   auto id = dwio::common::StreamIdentifier(type_->column());
+  // A BufferedInput that already has the column chunk will not be loaded
+  // again, so the page index is only read if it is also buffered.
+  const bool useIndex = shouldUsePageIndex(chunk) &&
+      (!input.isBuffered(chunkReadOffset, readSize) ||
+       (input.isBuffered(
+            chunk.columnIndexOffset(), chunk.columnIndexLength()) &&
+        input.isBuffered(
+            chunk.offsetIndexOffset(), chunk.offsetIndexLength())));
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  if (useIndex) {
+    columnIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.columnIndexOffset()),
+         static_cast<uint64_t>(chunk.columnIndexLength())},
+        &id);
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offsetIndexOffset()),
+         static_cast<uint64_t>(chunk.offsetIndexLength())},
+        &id);
+  }
+}
+
+bool ParquetData::shouldUsePageIndex(
+    const ColumnChunkMetaDataPtr& chunk) const {
+  auto* filter = scanSpec_.filter();
+  if (!filter || !chunk.hasPageIndex() ||
+      scanSpec_.disjunction() != common::ScanSpec::kNoDisjunction) {
+    return false;
+  }
+  // Page skipping is done in terms of top level rows. Null-only filters are
+  // evaluated without decoding values and are not worth the extra read.
+  return maxRepeat_ == 0 && maxDefine_ <= 1 &&
+      filter->kind() != common::FilterKind::kIsNull &&
+      filter->kind() != common::FilterKind::kIsNotNull;
+}
+
+std::vector<bool> ParquetData::prunedPages(uint32_t index) {
+  if (index >= columnIndexStreams_.size() || !columnIndexStreams_[index]) {
+    return {};
+  }
+  auto columnIndexStream = std::move(columnIndexStreams_[index]);
+  auto offsetIndexStream = std::move(offsetIndexStreams_[index]);
+  auto* filter = scanSpec_.filter();
+  if (!filter) {
+    return {};
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  auto readIndex = [&](dwio::common::SeekableInputStream& stream,
+                       int32_t length) {
+    std::string data(length, '\0');
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        length, &stream, data.data(), bufferStart, bufferEnd);
+    return data;
+  };
+  auto columnIndex = readIndex(*columnIndexStream, chunk.columnIndexLength());
+  auto offsetIndex = readIndex(*offsetIndexStream, chunk.offsetIndexLength());
+  PageIndex pageIndex(
+      columnIndex.data(),
+      columnIndex.size(),
+      offsetIndex.data(),
+      offsetIndex.size());
+
+  auto numRows = fileMetaDataPtr_.rowGroup(index).numRows();
+  auto numPages = pageIndex.numPages();
+  std::vector<bool> pruned(numPages);
+  bool anyPruned = false;
+  for (auto page = 0; page < numPages; ++page) {
+    auto numRowsInPage =
+        (page + 1 < numPages ? pageIndex.firstRowIndex(page + 1) : numRows) -
+        pageIndex.firstRowIndex(page);
+    if (pageIndex.isNullPage(page)) {
+      pruned[page] = !filter->testNull();
+    } else {
+      auto stats =
+          pageIndex.pageStatistics(page, type_->type(), numRowsInPage);
+      pruned[page] =
+          !testFilter(filter, stats.get(), numRowsInPage, type_->type());
+    }
+    anyPruned |= pruned[page];
+  }
+  if (!anyPruned) {
+    return {};
+  }
+  return pruned;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -117,6 +448,10 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.compression(),
       metadata.totalCompressedSize());
+  auto pruned = prunedPages(index);
+  if (!pruned.empty()) {
+    reader_->setPrunedPages(std::move(pruned), stats_);
+  }
   return dwio::common::PositionProvider(empty);
 }
 
@@ -35,14 +35,18 @@ class ParquetParams : public dwio::common::FormatParams {
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const FileMetaDataPtr metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const FileMetaDataPtr metaData,
+      dwio::common::BufferedInput* input = nullptr)
+      : FormatParams(pool, stats), metaData_(metaData), input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const FileMetaDataPtr metaData_;
+  // Input for reading metadata outside of row groups, e.g. Bloom filters. May
+  // be null.
+  dwio::common::BufferedInput* const input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +55,16 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
-      memory::MemoryPool& pool)
+      const common::ScanSpec& scanSpec,
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
+      dwio::common::BufferedInput* input = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
+        scanSpec_(scanSpec),
+        stats_(stats),
+        input_(input),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -179,6 +189,10 @@ class ParquetData : public dwio::common::FormatData {
     return reader_->isDeltaBinaryPacked();
   }
 
+  bool isByteStreamSplit() const {
+    return reader_->isByteStreamSplit();
+  }
+
   bool parentNullsInLeaves() const override {
     return true;
   }
@@ -191,14 +205,48 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if the Bloom filter of 'chunk' shows that no value passing 'filter'
+  /// is in the column chunk. True if there is no Bloom filter or 'filter' is
+  /// not an equality or IN filter.
+  bool bloomFilterMatches(
+      const ColumnChunkMetaDataPtr& chunk,
+      const common::Filter& filter);
+
+  /// False if all data pages of 'chunk' are dictionary encoded and no value in
+  /// the dictionary page passes 'filter'. Reads the dictionary page. True if
+  /// the values of the column cannot be tested against 'filter'.
+  bool dictionaryMatches(
+      const ColumnChunkMetaDataPtr& chunk,
+      const common::Filter& filter);
+
+  /// True if the ColumnIndex and OffsetIndex of 'chunk' should be read for
+  /// skipping pages that cannot pass the filter of the column.
+  bool shouldUsePageIndex(const ColumnChunkMetaDataPtr& chunk) const;
+
+  /// Reads the page index enqueued for 'index'th row group and returns for each
+  /// data page whether the filter of the column cannot have hits in it. Returns
+  /// an empty vector if the page index was not enqueued.
+  std::vector<bool> prunedPages(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  const common::ScanSpec& scanSpec_;
+  dwio::common::ColumnReaderStatistics& stats_;
+  dwio::common::BufferedInput* const input_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Streams for the ColumnIndex and OffsetIndex of this column in each of
+  // 'rowGroups_'. Only enqueued if the column has a filter and the file has a
+  // page index.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
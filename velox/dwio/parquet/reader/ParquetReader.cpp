@@ -19,12 +19,36 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/common/time/Timer.h"
+#include "velox/dwio/common/FileTailCache.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+// The footer of a Parquet file, shared through FileTailCache.
+struct ParquetFileTail : public dwio::common::FileTail {
+  ParquetFileTail(
+      uint64_t parseMicros,
+      std::shared_ptr<const thrift::FileMetaData> _fileMetaData,
+      uint32_t _footerLength)
+      : FileTail(parseMicros),
+        fileMetaData(std::move(_fileMetaData)),
+        footerLength(_footerLength) {}
+
+  // Approximated as a multiple of the serialized size since thrift objects do
+  // not report their memory.
+  uint64_t memoryBytes() const override {
+    return sizeof(*this) + 3 * footerLength;
+  }
+
+  const std::shared_ptr<const thrift::FileMetaData> fileMetaData;
+  const uint32_t footerLength;
+};
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -84,8 +108,8 @@ class ReaderBase {
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
  private:
-  // Reads and parses file footer.
-  void loadFileMetaData();
+  // Reads and parses file footer. Returns the size of the serialized footer.
+  uint32_t loadFileMetaData();
 
   void initializeSchema();
 
@@ -111,7 +135,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Possibly shared with other readers through FileTailCache.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -134,11 +159,47 @@ ReaderBase::ReaderBase(
   VELOX_CHECK_GT(fileLength_, 0, "Parquet file is empty");
   VELOX_CHECK_GE(fileLength_, 12, "Parquet file is too small");
 
-  loadFileMetaData();
+  auto* tailCache = dwio::common::FileTailCache::getInstance();
+  if (input_->getName().empty()) {
+    tailCache = nullptr;
+  }
+  const dwio::common::FileTailKey tailKey{
+      input_->getName(),
+      fileLength_,
+      options.fileModificationTime(),
+      dwio::common::FileFormat::PARQUET};
+  std::shared_ptr<const ParquetFileTail> tail;
+  if (tailCache != nullptr) {
+    tail = std::dynamic_pointer_cast<const ParquetFileTail>(
+        tailCache->get(tailKey));
+  }
+  const auto ioStats = input_->ioStatistics();
+  if (tail != nullptr) {
+    fileMetaData_ = tail->fileMetaData;
+    if (ioStats != nullptr) {
+      ioStats->fileTailCacheHit().increment(tail->parseMicros());
+    }
+  } else {
+    uint64_t parseMicros{0};
+    uint32_t footerLength;
+    {
+      MicrosecondTimer timer(&parseMicros);
+      footerLength = loadFileMetaData();
+    }
+    if (ioStats != nullptr) {
+      ioStats->fileTailParse().increment(parseMicros);
+    }
+    if (tailCache != nullptr) {
+      tailCache->put(
+          tailKey,
+          std::make_shared<ParquetFileTail>(
+              parseMicros, fileMetaData_, footerLength));
+    }
+  }
   initializeSchema();
 }
 
-void ReaderBase::loadFileMetaData() {
+uint32_t ReaderBase::loadFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -185,8 +246,10 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  return footerLength;
 }
 
 void ReaderBase::initializeSchema() {
@@ -757,7 +820,10 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     ParquetParams params(
-        pool_, columnReaderStats_, readerBase_->fileMetaData());
+        pool_,
+        columnReaderStats_,
+        readerBase_->fileMetaData(),
+        &readerBase_->bufferedInput());
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -765,6 +831,7 @@ class ParquetRowReader::Impl {
         readerBase_->schemaWithId(), // Id is schema id
         params,
         *options_.getScanSpec());
+    columnReader_->setIsTopLevel();
     columnReader_->setFillMutatedOutputRows(
         options_.getRowNumberColumnInfo().has_value());
 
@@ -865,6 +932,14 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.columnReaderStatistics.skippedPages +=
+        columnReaderStats_.skippedPages;
+    stats.columnReaderStatistics.skippedPageBytes +=
+        columnReaderStats_.skippedPageBytes;
+    stats.columnReaderStatistics.skippedStridesByBloomFilter +=
+        columnReaderStats_.skippedStridesByBloomFilter;
+    stats.columnReaderStatistics.skippedStridesByDictionary +=
+        columnReaderStats_.skippedStridesByDictionary;
   }
 
   void resetFilterCaches() {
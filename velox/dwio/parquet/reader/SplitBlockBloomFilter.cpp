@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "velox/common/base/BitUtil.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(std::string bitset)
+    : bitset_(std::move(bitset)) {
+  VELOX_CHECK_GE(bitset_.size(), kMinimumBytes);
+  VELOX_CHECK_EQ(
+      bitset_.size() % kBytesPerBlock,
+      0,
+      "Bloom filter bitset size must be a multiple of {}",
+      kBytesPerBlock);
+}
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(int32_t numBytes)
+    : bitset_(
+          bits::roundUp(std::max(numBytes, kMinimumBytes), kBytesPerBlock),
+          '\0') {}
+
+bool SplitBlockBloomFilter::findHash(uint64_t hash) const {
+  const auto key = static_cast<uint32_t>(hash);
+  const auto* words = block(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if (!(words[i] & (1U << ((key * kSalt[i]) >> 27)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SplitBlockBloomFilter::insertHash(uint64_t hash) {
+  const auto key = static_cast<uint32_t>(hash);
+  auto* words = block(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    words[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+// static
+int32_t SplitBlockBloomFilter::optimalNumBytes(
+    uint64_t numDistinctValues,
+    double fpp,
+    int32_t maxBytes) {
+  VELOX_CHECK(
+      fpp > 0 && fpp < 1,
+      "Bloom filter false positive probability must be in (0, 1): {}",
+      fpp);
+  const uint64_t maxSize =
+      std::max(maxBytes / kBytesPerBlock, 1) * kBytesPerBlock;
+  // Each value sets one bit in each of the 8 words of a block.
+  const double numBits = -8.0 * numDistinctValues /
+      std::log(1.0 - std::pow(fpp, 1.0 / kWordsPerBlock));
+  const auto numBytes = static_cast<uint64_t>(std::min<double>(
+      std::ceil(numBits / 8), static_cast<double>(maxSize)));
+  return std::min(
+      bits::nextPowerOfTwo(std::max<uint64_t>(numBytes, kMinimumBytes)),
+      maxSize);
+}
+
+uint64_t SplitBlockBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+uint64_t SplitBlockBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+uint64_t SplitBlockBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+bool SplitBlockBloomFilter::mayContainInteger(int64_t value, ValueKind kind)
+    const {
+  switch (kind) {
+    case ValueKind::kInt32:
+      if (value < std::numeric_limits<int32_t>::min() ||
+          value > std::numeric_limits<int32_t>::max()) {
+        return false;
+      }
+      return findHash(hash(static_cast<int32_t>(value)));
+    case ValueKind::kInt64:
+      return findHash(hash(value));
+    default:
+      return true;
+  }
+}
+
+bool SplitBlockBloomFilter::mayContain(
+    const common::Filter& filter,
+    ValueKind kind) const {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      return !range.isSingleValue() || mayContainInteger(range.lower(), kind);
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](auto value) {
+        return mayContainInteger(value, kind);
+      });
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      auto values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](auto value) {
+        return mayContainInteger(value, kind);
+      });
+    }
+    case common::FilterKind::kBytesRange: {
+      if (kind != ValueKind::kBytes) {
+        return true;
+      }
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      return !range.isSingleValue() || findHash(hash(range.lower()));
+    }
+    case common::FilterKind::kBytesValues: {
+      if (kind != ValueKind::kBytes) {
+        return true;
+      }
+      auto& values = static_cast<const common::BytesValues&>(filter).values();
+      return std::any_of(values.begin(), values.end(), [&](const auto& value) {
+        return findHash(hash(std::string_view(value)));
+      });
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// The split block Bloom filter of the Parquet format. The bitset is divided
+/// into blocks of eight 32-bit words. A hash selects one block by its upper 32
+/// bits and sets one bit in each word of the block by its lower 32 bits. Values
+/// are hashed with XXH64 over their plain encoding.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+  static constexpr int32_t kMinimumBytes = kBytesPerBlock;
+
+  /// Physical type of the values in the filter. Determines how values of the
+  /// Velox filter are encoded before hashing.
+  enum class ValueKind { kInt32, kInt64, kBytes };
+
+  /// Makes a filter from 'bitset', the bytes that follow the
+  /// BloomFilterHeader in the file. The size of 'bitset' must be a positive
+  /// multiple of kBytesPerBlock.
+  explicit SplitBlockBloomFilter(std::string bitset);
+
+  /// Makes an empty filter of 'numBytes', rounded up to a multiple of
+  /// kBytesPerBlock.
+  explicit SplitBlockBloomFilter(int32_t numBytes);
+
+  /// Returns false if the value with 'hash' is definitely not in 'this'.
+  bool findHash(uint64_t hash) const;
+
+  void insertHash(uint64_t hash);
+
+  /// Returns false if no value that passes 'filter' can be in 'this'. Only
+  /// equality and IN filters are tested, other filters return true.
+  bool mayContain(const common::Filter& filter, ValueKind kind) const;
+
+  const std::string& bitset() const {
+    return bitset_;
+  }
+
+  /// Returns the size in bytes of a filter that holds 'numDistinctValues'
+  /// with a false positive probability of at most 'fpp'. The size is a power
+  /// of two that is at least kMinimumBytes and at most 'maxBytes' rounded down
+  /// to a multiple of kBytesPerBlock.
+  static int32_t
+  optimalNumBytes(uint64_t numDistinctValues, double fpp, int32_t maxBytes);
+
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+ private:
+  bool mayContainInteger(int64_t value, ValueKind kind) const;
+
+  int32_t numBlocks() const {
+    return bitset_.size() / kBytesPerBlock;
+  }
+
+  uint32_t* block(uint64_t hash) {
+    return reinterpret_cast<uint32_t*>(bitset_.data()) +
+        blockIndex(hash) * kWordsPerBlock;
+  }
+
+  const uint32_t* block(uint64_t hash) const {
+    return reinterpret_cast<const uint32_t*>(bitset_.data()) +
+        blockIndex(hash) * kWordsPerBlock;
+  }
+
+  uint64_t blockIndex(uint64_t hash) const {
+    return ((hash >> 32) * numBlocks()) >> 32;
+  }
+
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  // The salts that give the bit to set in each word of a block.
+  static constexpr uint32_t kSalt[kWordsPerBlock] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  std::string bitset_;
+};
+
+} // namespace facebook::velox::parquet
@@ -55,6 +55,19 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       dwio::common::SelectiveColumnReader* /*reader*/,
       vector_size_t /*offset*/) override {}
 
+  /// Members of the root struct are loaded lazily. Members of nested structs
+  /// get their nulls and lengths from the repdefs gathered by the enclosing
+  /// struct's read(), so a nested struct is loaded lazily as a whole but its
+  /// own members are not.
+  void setIsTopLevel() override {
+    isTopLevel_ = true;
+    if (!fileType_->parent()) {
+      for (auto* child : children_) {
+        child->setIsTopLevel();
+      }
+    }
+  }
+
   void setNullsFromRepDefs(PageReader& pageReader);
 
   dwio::common::SelectiveColumnReader* childForRepDefs() const {
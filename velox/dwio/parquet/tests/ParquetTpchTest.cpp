@@ -171,6 +171,10 @@ TEST_F(ParquetTpchTest, Q3) {
   assertQuery(3, std::move(sortingKeys));
 }
 
+TEST_F(ParquetTpchTest, Q4) {
+  assertQuery(4);
+}
+
 TEST_F(ParquetTpchTest, Q5) {
   std::vector<uint32_t> sortingKeys{1};
   assertQuery(5, std::move(sortingKeys));
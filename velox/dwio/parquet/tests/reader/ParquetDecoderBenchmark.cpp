@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+#include "velox/dwio/parquet/writer/arrow/Encoding.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace arrowParquet = facebook::velox::parquet::arrow;
+
+namespace {
+
+constexpr int32_t kNumValues = 1'000'000;
+
+// Encodes the values with the Arrow encoders used by the Parquet writer so
+// that the benchmark decodes the same bytes a reader sees in a file.
+class ParquetDecoderBenchmark {
+ public:
+  ParquetDecoderBenchmark() {
+    strings_.reserve(kNumValues);
+    for (auto i = 0; i < kNumValues; ++i) {
+      // Sorted keys with long shared prefixes, the case DELTA_BYTE_ARRAY is
+      // designed for.
+      strings_.push_back(fmt::format("customer#{:012}", i * 7));
+    }
+    std::vector<arrowParquet::ByteArray> byteArrays(
+        strings_.begin(), strings_.end());
+    deltaLength_ = encode<arrowParquet::ByteArrayType>(
+        arrowParquet::Encoding::DELTA_LENGTH_BYTE_ARRAY, byteArrays);
+    delta_ = encode<arrowParquet::ByteArrayType>(
+        arrowParquet::Encoding::DELTA_BYTE_ARRAY, byteArrays);
+
+    doubles_.resize(kNumValues);
+    for (auto i = 0; i < kNumValues; ++i) {
+      doubles_[i] = i * 0.01;
+    }
+    byteStreamSplit_ = encode<arrowParquet::DoubleType>(
+        arrowParquet::Encoding::BYTE_STREAM_SPLIT, doubles_);
+  }
+
+  const std::string& deltaLength() const {
+    return deltaLength_;
+  }
+
+  const std::string& delta() const {
+    return delta_;
+  }
+
+  const std::string& byteStreamSplit() const {
+    return byteStreamSplit_;
+  }
+
+ private:
+  template <typename DType, typename T>
+  static std::string encode(
+      arrowParquet::Encoding::type encoding,
+      const std::vector<T>& values) {
+    auto encoder = arrowParquet::MakeTypedEncoder<DType>(encoding);
+    encoder->Put(values.data(), values.size());
+    auto buffer = encoder->FlushValues();
+    return std::string(
+        reinterpret_cast<const char*>(buffer->data()), buffer->size());
+  }
+
+  std::vector<std::string> strings_;
+  std::vector<double> doubles_;
+  std::string deltaLength_;
+  std::string delta_;
+  std::string byteStreamSplit_;
+};
+
+std::unique_ptr<ParquetDecoderBenchmark> decoderBenchmark;
+
+} // namespace
+
+BENCHMARK(deltaLengthByteArray) {
+  const auto& data = decoderBenchmark->deltaLength();
+  DeltaLengthByteArrayDecoder decoder(data.data(), data.data() + data.size());
+  size_t totalSize = 0;
+  for (auto i = 0; i < kNumValues; ++i) {
+    totalSize += decoder.readString().size();
+  }
+  folly::doNotOptimizeAway(totalSize);
+}
+
+BENCHMARK_RELATIVE(deltaByteArray) {
+  const auto& data = decoderBenchmark->delta();
+  DeltaByteArrayDecoder decoder(data.data(), data.data() + data.size());
+  size_t totalSize = 0;
+  for (auto i = 0; i < kNumValues; ++i) {
+    totalSize += decoder.readString().size();
+  }
+  folly::doNotOptimizeAway(totalSize);
+}
+
+BENCHMARK(byteStreamSplitDouble) {
+  const auto& data = decoderBenchmark->byteStreamSplit();
+  ByteStreamSplitDecoder decoder(
+      data.data(), data.data() + data.size(), sizeof(double));
+  double sum = 0;
+  for (auto i = 0; i < kNumValues; ++i) {
+    sum += decoder.read<double>();
+  }
+  folly::doNotOptimizeAway(sum);
+}
+
+BENCHMARK_RELATIVE(byteStreamSplitDoubleSkip) {
+  const auto& data = decoderBenchmark->byteStreamSplit();
+  ByteStreamSplitDecoder decoder(
+      data.data(), data.data() + data.size(), sizeof(double));
+  double sum = 0;
+  for (auto i = 0; i < kNumValues / 2; ++i) {
+    decoder.skip(1);
+    sum += decoder.read<double>();
+  }
+  folly::doNotOptimizeAway(sum);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  decoderBenchmark = std::make_unique<ParquetDecoderBenchmark>();
+  folly::runBenchmarks();
+  decoderBenchmark.reset();
+  return 0;
+}
@@ -97,6 +97,32 @@ TEST_F(ParquetReaderTest, parseSample) {
       sampleSchema(), *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, lazyLoading) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(sample, readerOptions);
+
+  // Columns without filters are returned as LazyVectors and only decoded
+  // when accessed.
+  auto scanSpec = makeScanSpec(sampleSchema());
+  scanSpec->childByName("a")->setFilter(
+      std::make_unique<common::BigintRange>(1, 5, false));
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(10, result), 10);
+  auto* rowVector = result->as<RowVector>();
+  EXPECT_FALSE(rowVector->childAt(0)->isLazy());
+  ASSERT_TRUE(rowVector->childAt(1)->isLazy());
+  test::assertEqualVectors(
+      makeRowVector({
+          makeFlatVector<int64_t>(5, [](auto row) { return row + 1; }),
+          makeFlatVector<double>(5, [](auto row) { return row + 1; }),
+      }),
+      result);
+}
+
 TEST_F(ParquetReaderTest, parseUnannotatedList) {
   // unannotated_list.parquet has the following the schema
   // the list is defined without the middle layer
@@ -647,8 +673,14 @@ TEST_F(ParquetReaderTest, parseIntDecimal) {
   rowReader->next(6, result);
   EXPECT_EQ(result->size(), 6ULL);
   auto decimals = result->as<RowVector>();
-  auto a = decimals->childAt(0)->asFlatVector<int64_t>()->rawValues();
-  auto b = decimals->childAt(1)->asFlatVector<int64_t>()->rawValues();
+  auto a = decimals->childAt(0)
+               ->loadedVector()
+               ->asFlatVector<int64_t>()
+               ->rawValues();
+  auto b = decimals->childAt(1)
+               ->loadedVector()
+               ->asFlatVector<int64_t>()
+               ->rawValues();
   for (int i = 0; i < 3; i++) {
     int index = 2 * i;
     EXPECT_EQ(a[index], expectValues[i]);
@@ -1153,8 +1185,11 @@ TEST_F(ParquetReaderTest, readVarbinaryFromFLBA) {
   rowReader->next(1, result);
   EXPECT_EQ(
       expected,
-      result->as<RowVector>()->childAt(0)->asFlatVector<StringView>()->valueAt(
-          0));
+      result->as<RowVector>()
+          ->childAt(0)
+          ->loadedVector()
+          ->asFlatVector<StringView>()
+          ->valueAt(0));
 }
 
 TEST_F(ParquetReaderTest, testV2PageWithZeroMaxDefRep) {
@@ -1200,7 +1235,8 @@ TEST_F(ParquetReaderTest, testLzoDataPage) {
   VectorPtr result = BaseVector::create(outputRowType, 0, &*leafPool_);
   rowReader->next(23'547ULL, result);
   EXPECT_EQ(23'547ULL, result->size());
-  auto values = result->as<RowVector>()->childAt(0)->as<RowVector>();
+  auto values =
+      result->as<RowVector>()->childAt(0)->loadedVector()->as<RowVector>();
   auto intField = values->childAt(0)->asFlatVector<int32_t>();
   auto stringArray = values->childAt(1)->as<ArrayVector>();
   EXPECT_EQ(intField->valueAt(0), 1);
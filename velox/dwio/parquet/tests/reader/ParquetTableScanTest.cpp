@@ -20,6 +20,7 @@
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/type/tests/SubfieldFiltersBuilder.h"
@@ -631,6 +632,73 @@ TEST_F(ParquetTableScanTest, filterNullIcebergPartition) {
           {"c0", c0}, {"c1", c1}});
 }
 
+TEST_F(ParquetTableScanTest, bloomFilterSkipsRowGroups) {
+  const vector_size_t kRows = 2'000;
+  // The row groups hold the even and the odd values, so that their min/max
+  // overlap and only the Bloom filters can tell them apart.
+  const auto value = [](auto row) { return (row % 1'000) * 2 + row / 1'000; };
+  auto data = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int64_t>(kRows, value),
+          makeFlatVector<std::string>(
+              kRows, [&](auto row) { return fmt::format("s{}", value(row)); }),
+      });
+  const auto rowType = asRowType(data->type());
+
+  auto file = TempFilePath::create();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = pool_.get();
+  writerOptions.bloomFilterColumns = {"c0", "c1"};
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(1'000, 1L << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::make_unique<dwio::common::LocalFileSink>(
+          file->getPath(),
+          dwio::common::FileSink::Options{.pool = pool_.get()}),
+      writerOptions,
+      rootPool_,
+      rowType);
+  writer->write(data);
+  writer->close();
+  loadData(file->getPath(), rowType, data);
+
+  struct {
+    std::string filter;
+    int64_t skippedStrides;
+    int64_t skippedStridesByBloomFilter;
+  } testSettings[] = {
+      // Both row groups pass their min/max and those without the values are
+      // skipped by their Bloom filters.
+      {"c0 = 1001", 1, 1},
+      {"c0 IN (4, 1001)", 0, 0},
+      {"c0 IN (5, 1001)", 1, 1},
+      {"c1 = 's1001'", 1, 1},
+      {"c1 IN ('s4', 's1001')", 0, 0},
+      // Both row groups are skipped by their min/max.
+      {"c0 = 2001", 2, 0},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.filter);
+    core::PlanNodeId scanId;
+    auto plan = PlanBuilder()
+                    .tableScan(rowType, {testData.filter})
+                    .capturePlanNodeId(scanId)
+                    .planNode();
+    auto task = assertQuery(
+        plan,
+        {makeSplit(file->getPath())},
+        fmt::format("SELECT * FROM tmp WHERE {}", testData.filter));
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(scanId).customStats;
+    ASSERT_EQ(stats.at("skippedStrides").sum, testData.skippedStrides);
+    ASSERT_EQ(
+        stats.at("skippedStridesByBloomFilter").sum,
+        testData.skippedStridesByBloomFilter);
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::Init init{&argc, &argv, false};
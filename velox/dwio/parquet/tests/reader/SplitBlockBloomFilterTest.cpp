@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+using ValueKind = SplitBlockBloomFilter::ValueKind;
+
+TEST(SplitBlockBloomFilterTest, insertAndFind) {
+  SplitBlockBloomFilter filter(1'024);
+  EXPECT_EQ(filter.bitset().size(), 1'024);
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.insertHash(SplitBlockBloomFilter::hash(i * 7));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter.findHash(SplitBlockBloomFilter::hash(i * 7)));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    numFalsePositives +=
+        filter.findHash(SplitBlockBloomFilter::hash(1'000'000 + i));
+  }
+  EXPECT_LT(numFalsePositives, 20);
+
+  // A filter made from the bitset of another filter has the same content.
+  SplitBlockBloomFilter copy(filter.bitset());
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(copy.findHash(SplitBlockBloomFilter::hash(i * 7)));
+  }
+}
+
+TEST(SplitBlockBloomFilterTest, mayContainBigint) {
+  SplitBlockBloomFilter int64Filter(4'096);
+  SplitBlockBloomFilter int32Filter(4'096);
+  for (int32_t i = 0; i < 100; ++i) {
+    int64Filter.insertHash(SplitBlockBloomFilter::hash(int64_t(i)));
+    int32Filter.insertHash(SplitBlockBloomFilter::hash(i));
+  }
+  for (auto [filter, kind] :
+       {std::make_pair(&int64Filter, ValueKind::kInt64),
+        std::make_pair(&int32Filter, ValueKind::kInt32)}) {
+    EXPECT_TRUE(filter->mayContain(common::BigintRange(10, 10, false), kind));
+    EXPECT_FALSE(filter->mayContain(
+        common::BigintRange(1'000'000, 1'000'000, false), kind));
+    // Non-equality ranges are never pruned.
+    EXPECT_TRUE(filter->mayContain(
+        common::BigintRange(1'000'000, 2'000'000, false), kind));
+    EXPECT_TRUE(filter->mayContain(
+        *common::createBigintValues({5'000'000, 7'000'000, 50}, false),
+        kind));
+    EXPECT_FALSE(filter->mayContain(
+        *common::createBigintValues(
+            {5'000'000, 7'000'000, 9'000'000}, false),
+        kind));
+  }
+
+  // Values outside of the INT32 range cannot be in an INT32 column.
+  EXPECT_FALSE(int32Filter.mayContain(
+      common::BigintRange(1LL << 40, 1LL << 40, false), ValueKind::kInt32));
+}
+
+TEST(SplitBlockBloomFilterTest, mayContainBytes) {
+  SplitBlockBloomFilter filter(4'096);
+  for (auto i = 0; i < 100; ++i) {
+    filter.insertHash(SplitBlockBloomFilter::hash(fmt::format("key{}", i)));
+  }
+  EXPECT_TRUE(filter.mayContain(
+      common::BytesRange("key5", false, false, "key5", false, false, false),
+      ValueKind::kBytes));
+  EXPECT_FALSE(filter.mayContain(
+      common::BytesRange(
+          "absent", false, false, "absent", false, false, false),
+      ValueKind::kBytes));
+  EXPECT_TRUE(filter.mayContain(
+      common::BytesValues({"absent", "key17"}, false), ValueKind::kBytes));
+  EXPECT_FALSE(filter.mayContain(
+      common::BytesValues({"absent", "missing"}, false), ValueKind::kBytes));
+}
+
+TEST(SplitBlockBloomFilterTest, optimalNumBytes) {
+  EXPECT_EQ(SplitBlockBloomFilter::optimalNumBytes(0, 0.01, 1 << 20), 32);
+  EXPECT_EQ(
+      SplitBlockBloomFilter::optimalNumBytes(1'000, 0.01, 1 << 20), 2'048);
+  EXPECT_EQ(
+      SplitBlockBloomFilter::optimalNumBytes(2'000, 0.01, 1 << 20), 4'096);
+  EXPECT_EQ(
+      SplitBlockBloomFilter::optimalNumBytes(100'000'000, 0.01, 1 << 20),
+      1 << 20);
+  EXPECT_EQ(SplitBlockBloomFilter::optimalNumBytes(1'000, 0.01, 1'000), 992);
+  VELOX_ASSERT_THROW(
+      SplitBlockBloomFilter::optimalNumBytes(1'000, 0, 1 << 20),
+      "Bloom filter false positive probability must be in (0, 1)");
+}
+
+TEST(SplitBlockBloomFilterTest, invalidBitset) {
+  VELOX_ASSERT_THROW(
+      SplitBlockBloomFilter(std::string(33, '\0')),
+      "Bloom filter bitset size must be a multiple of 32");
+}
+
+} // namespace
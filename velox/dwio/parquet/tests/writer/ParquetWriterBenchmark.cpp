@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+
+// Compares writing Parquet through the Arrow bridge with encoding directly
+// from Velox vectors, for flat and dictionary encoded input.
+
+namespace {
+
+constexpr vector_size_t kBatchSize = 10'000;
+constexpr int32_t kNumBatches = 20;
+
+class ParquetWriterBenchmark : public test::VectorTestBase {
+ public:
+  ParquetWriterBenchmark() {
+    rootPool_ = memory::memoryManager()->addRootPool("ParquetWriterBenchmark");
+  }
+
+  std::vector<RowVectorPtr> makeBatches(bool dictionary) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < kNumBatches; ++i) {
+      VectorPtr strings = makeFlatVector<std::string>(
+          kBatchSize, [](auto row) { return fmt::format("value_{}", row); });
+      if (dictionary) {
+        strings = wrapInDictionary(
+            makeIndices(kBatchSize, [](auto row) { return row % 1'000; }),
+            kBatchSize,
+            makeFlatVector<std::string>(1'000, [](auto row) {
+              return fmt::format("dictionary_value_{}", row);
+            }));
+      }
+      batches.push_back(makeRowVector({
+          makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; }),
+          makeFlatVector<int32_t>(
+              kBatchSize, [](auto row) { return row % 7; }, nullEvery(5)),
+          makeFlatVector<double>(
+              kBatchSize, [](auto row) { return row * 0.1; }),
+          strings,
+      }));
+    }
+    return batches;
+  }
+
+  // Returns the number of rows written.
+  unsigned run(
+      unsigned iterations,
+      bool nativeWriter,
+      const std::vector<RowVectorPtr>& batches) {
+    for (unsigned i = 0; i < iterations; ++i) {
+      parquet::WriterOptions options;
+      options.memoryPool = pool();
+      options.enableNativeWriter = nativeWriter;
+      parquet::Writer writer(
+          std::make_unique<dwio::common::MemorySink>(
+              1L << 30, dwio::common::FileSink::Options{.pool = pool()}),
+          options,
+          rootPool_,
+          asRowType(batches[0]->type()));
+      for (const auto& batch : batches) {
+        writer.write(batch);
+      }
+      writer.close();
+    }
+    return iterations * kNumBatches * kBatchSize;
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+};
+
+std::unique_ptr<ParquetWriterBenchmark> benchmark;
+std::vector<RowVectorPtr> flatBatches;
+std::vector<RowVectorPtr> dictionaryBatches;
+
+} // namespace
+
+BENCHMARK_MULTI(arrowFlat, n) {
+  return benchmark->run(n, false, flatBatches);
+}
+
+BENCHMARK_RELATIVE_MULTI(nativeFlat, n) {
+  return benchmark->run(n, true, flatBatches);
+}
+
+BENCHMARK_MULTI(arrowDictionary, n) {
+  return benchmark->run(n, false, dictionaryBatches);
+}
+
+BENCHMARK_RELATIVE_MULTI(nativeDictionary, n) {
+  return benchmark->run(n, true, dictionaryBatches);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<ParquetWriterBenchmark>();
+  flatBatches = benchmark->makeBatches(false);
+  dictionaryBatches = benchmark->makeBatches(true);
+  folly::runBenchmarks();
+  flatBatches.clear();
+  dictionaryBatches.clear();
+  benchmark.reset();
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
@@ -136,6 +137,305 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, pageIndexSkipsPages) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  const int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 2.0; }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_TRUE(reader->fileMetaData().rowGroup(0).columnChunk(0).hasPageIndex());
+
+  auto scanSpec = makeScanSpec(schema);
+  scanSpec->getOrCreateChild(Subfield("c0"))
+      ->setFilter(std::make_unique<BigintRange>(5'000, 5'009, false));
+  auto rowReaderOpts = getReaderOpts(schema);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto row) { return 5'000 + row; }),
+      makeFlatVector<double>(10, [](auto row) { return (5'000 + row) * 2.0; }),
+  });
+  assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_GT(stats.columnReaderStatistics.skippedPages, 0);
+  EXPECT_GT(stats.columnReaderStatistics.skippedPageBytes, 0);
+}
+
+TEST_F(ParquetWriterTest, bloomFilters) {
+  const vector_size_t kRows = 2'000;
+  // The row groups hold the even and the odd values, so that their min/max
+  // overlap and only the Bloom filters can tell them apart.
+  const auto data = makeRowVector(
+      {"c0", "c1", "c2"},
+      {
+          makeFlatVector<int64_t>(
+              kRows, [](auto row) { return (row % 1'000) * 2 + row / 1'000; }),
+          makeFlatVector<std::string>(
+              kRows,
+              [](auto row) {
+                return fmt::format("s{}", (row % 1'000) * 2 + row / 1'000);
+              }),
+          makeFlatVector<double>(kRows, [](auto row) { return row * 1.5; }),
+      });
+  const auto schema = asRowType(data->type());
+
+  for (const bool enableNativeWriter : {false, true}) {
+    SCOPED_TRACE(fmt::format("enableNativeWriter {}", enableNativeWriter));
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.enableNativeWriter = enableNativeWriter;
+    writerOptions.bloomFilterColumns = {"c0", "c1"};
+    writerOptions.flushPolicyFactory = []() {
+      return std::make_unique<DefaultFlushPolicy>(1'000, 1L << 30);
+    };
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data);
+    writer->close();
+    EXPECT_GT(writer->indexBytesWritten(), 0);
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+    for (auto i = 0; i < 2; ++i) {
+      const auto rowGroup = reader->fileMetaData().rowGroup(i);
+      EXPECT_TRUE(rowGroup.columnChunk(0).hasBloomFilterOffset());
+      EXPECT_TRUE(rowGroup.columnChunk(1).hasBloomFilterOffset());
+      EXPECT_FALSE(rowGroup.columnChunk(2).hasBloomFilterOffset());
+    }
+
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->getOrCreateChild(Subfield("c0"))
+        ->setFilter(std::make_unique<BigintRange>(1'001, 1'001, false));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    const auto expected = makeRowVector({
+        makeFlatVector<int64_t>({1'001}),
+        makeFlatVector<std::string>({"s1001"}),
+        makeFlatVector<double>({1'500 * 1.5}),
+    });
+    assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStrides, 1);
+  }
+
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.bloomFilterColumns = {"c2"};
+  VELOX_ASSERT_USER_THROW(
+      std::make_unique<facebook::velox::parquet::Writer>(
+          std::make_unique<MemorySink>(
+              1024, dwio::common::FileSink::Options{.pool = leafPool_.get()}),
+          writerOptions,
+          rootPool_,
+          schema),
+      "Bloom filters are not supported for column c2 of type DOUBLE");
+}
+
+TEST_F(ParquetWriterTest, dictionaryPrunesRowGroups) {
+  const vector_size_t kRows = 2'000;
+  // The first row group holds the multiples of 10 and the second those values
+  // plus 5, so that their min/max overlap and only the dictionaries can tell
+  // them apart.
+  const auto value = [](auto row) {
+    return (row % 100) * 10 + row / 1'000 * 5;
+  };
+  const auto data = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int64_t>(kRows, value),
+          makeFlatVector<std::string>(
+              kRows, [&](auto row) { return fmt::format("s{}", value(row)); }),
+      });
+  const auto schema = asRowType(data->type());
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(1'000, 1L << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 2);
+  for (auto i = 0; i < 2; ++i) {
+    const auto rowGroup = reader->fileMetaData().rowGroup(i);
+    EXPECT_TRUE(rowGroup.columnChunk(0).allDataPagesDictionaryEncoded());
+    EXPECT_TRUE(rowGroup.columnChunk(1).allDataPagesDictionaryEncoded());
+  }
+
+  // A range on c0 and an IN list on c1 that only values of the second row
+  // group pass.
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto /*row*/) { return 505; }),
+      makeFlatVector<std::string>(10, [](auto /*row*/) { return "s505"; }),
+  });
+  for (const auto column : {"c0", "c1"}) {
+    SCOPED_TRACE(column);
+    auto scanSpec = makeScanSpec(schema);
+    if (std::string(column) == "c0") {
+      scanSpec->getOrCreateChild(Subfield("c0"))
+          ->setFilter(std::make_unique<BigintRange>(501, 509, false));
+    } else {
+      scanSpec->getOrCreateChild(Subfield("c1"))
+          ->setFilter(std::make_unique<BytesValues>(
+              std::vector<std::string>{"s505", "s1"}, false));
+    }
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStrides, 1);
+    EXPECT_EQ(stats.columnReaderStatistics.skippedStridesByDictionary, 1);
+  }
+}
+
+TEST_F(ParquetWriterTest, deltaAndByteStreamSplitEncodings) {
+  using facebook::velox::parquet::arrow::Encoding;
+  const int64_t kRows = 10'000;
+  struct TestCase {
+    Encoding::type encoding;
+    RowVectorPtr data;
+  };
+  const std::vector<TestCase> testCases = {
+      {Encoding::DELTA_LENGTH_BYTE_ARRAY,
+       makeRowVector({makeFlatVector<std::string>(
+           kRows,
+           [](auto row) { return std::string(row % 37, 'a' + row % 26); },
+           nullEvery(11))})},
+      {Encoding::DELTA_BYTE_ARRAY,
+       makeRowVector({makeFlatVector<std::string>(
+           kRows,
+           [](auto row) { return fmt::format("prefix_{:06}", row); },
+           nullEvery(7))})},
+      {Encoding::BYTE_STREAM_SPLIT,
+       makeRowVector({makeFlatVector<double>(
+           kRows, [](auto row) { return row * 1.5; }, nullEvery(5))})},
+      {Encoding::BYTE_STREAM_SPLIT,
+       makeRowVector({makeFlatVector<float>(
+           kRows, [](auto row) { return row * 0.25f; })})},
+  };
+
+  for (const auto& testCase : testCases) {
+    SCOPED_TRACE(facebook::velox::parquet::arrow::EncodingToString(
+        testCase.encoding));
+    const auto schema = asRowType(testCase.data->type());
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    facebook::velox::parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.enableDictionary = false;
+    writerOptions.dataPageSize = 4 * 1'024;
+    writerOptions.encoding = testCase.encoding;
+    auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(testCase.data);
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(
+        schema, *rowReader, testCase.data, *leafPool_);
+  }
+}
+
+TEST_F(ParquetWriterTest, nativeWriter) {
+  const vector_size_t kRows = 10'000;
+  const auto data = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8"},
+      {
+          makeFlatVector<bool>(kRows, [](auto row) { return row % 3 == 0; }),
+          makeFlatVector<int8_t>(kRows, [](auto row) { return row % 100; }),
+          makeFlatVector<int16_t>(
+              kRows, [](auto row) { return row; }, nullEvery(7)),
+          makeFlatVector<int32_t>(kRows, [](auto row) { return row * 3; }),
+          makeFlatVector<int64_t>(
+              kRows, [](auto row) { return row - 5'000; }, nullEvery(11)),
+          makeFlatVector<float>(kRows, [](auto row) { return row * 0.5f; }),
+          makeFlatVector<double>(kRows, [](auto row) { return row * 1.5; }),
+          makeFlatVector<std::string>(
+              kRows,
+              [](auto row) { return fmt::format("a long string {}", row); },
+              nullEvery(13)),
+          wrapInDictionary(
+              makeIndices(kRows, [](auto row) { return row % 10; }),
+              kRows,
+              makeFlatVector<std::string>(
+                  10, [](auto row) { return std::string(20 + row, 'x'); })),
+      });
+  const auto schema = asRowType(data->type());
+  ASSERT_TRUE(NativeWriter::supports(*schema));
+  ASSERT_FALSE(NativeWriter::supports(*ROW({"c0"}, {ARRAY(INTEGER())})));
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableNativeWriter = true;
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(3'000, 1L << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  // The first row group spans both batches.
+  writer->write(data->slice(0, 2'000));
+  writer->write(data->slice(2'000, kRows - 2'000));
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  ASSERT_EQ(*reader->rowType(), *schema);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
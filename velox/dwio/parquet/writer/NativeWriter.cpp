@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+#include <arrow/c/bridge.h>
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Maps a Velox type to the same Parquet column type as the Arrow based writer.
+arrow::schema::NodePtr makeNode(const std::string& name, const Type& type) {
+  auto logicalType = arrow::LogicalType::None();
+  arrow::Type::type physicalType;
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+      physicalType = arrow::Type::BOOLEAN;
+      break;
+    case TypeKind::TINYINT:
+      physicalType = arrow::Type::INT32;
+      logicalType = arrow::LogicalType::Int(8, true);
+      break;
+    case TypeKind::SMALLINT:
+      physicalType = arrow::Type::INT32;
+      logicalType = arrow::LogicalType::Int(16, true);
+      break;
+    case TypeKind::INTEGER:
+      physicalType = arrow::Type::INT32;
+      if (type.isDate()) {
+        logicalType = arrow::LogicalType::Date();
+      }
+      break;
+    case TypeKind::BIGINT:
+      physicalType = arrow::Type::INT64;
+      break;
+    case TypeKind::REAL:
+      physicalType = arrow::Type::FLOAT;
+      break;
+    case TypeKind::DOUBLE:
+      physicalType = arrow::Type::DOUBLE;
+      break;
+    case TypeKind::VARCHAR:
+      physicalType = arrow::Type::BYTE_ARRAY;
+      logicalType = arrow::LogicalType::String();
+      break;
+    case TypeKind::VARBINARY:
+      physicalType = arrow::Type::BYTE_ARRAY;
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported type for native Parquet writer: {}", type.toString());
+  }
+  return arrow::schema::PrimitiveNode::Make(
+      name, arrow::Repetition::OPTIONAL, logicalType, physicalType);
+}
+
+template <typename T, typename TVelox>
+T toParquet(const TVelox& value) {
+  return static_cast<T>(value);
+}
+
+template <>
+arrow::ByteArray toParquet(const StringView& value) {
+  return arrow::ByteArray(
+      value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+}
+
+} // namespace
+
+NativeWriter::NativeWriter(
+    const RowTypePtr& schema,
+    std::shared_ptr<::arrow::io::OutputStream> sink,
+    std::shared_ptr<arrow::WriterProperties> properties,
+    memory::MemoryPool* pool)
+    : schema_(schema),
+      pool_(pool),
+      arrowProperties_(arrow::ArrowWriterProperties::Builder().build()) {
+  arrow::schema::NodeVector fields;
+  fields.reserve(schema_->size());
+  for (auto i = 0; i < schema_->size(); ++i) {
+    fields.push_back(makeNode(schema_->nameOf(i), *schema_->childAt(i)));
+  }
+  auto root = std::static_pointer_cast<arrow::schema::GroupNode>(
+      arrow::schema::GroupNode::Make(
+          "schema", arrow::Repetition::REQUIRED, fields));
+  fileWriter_ = arrow::ParquetFileWriter::Open(
+      std::move(sink), std::move(root), std::move(properties));
+  arrowContext_ = std::make_unique<arrow::ArrowWriteContext>(
+      ::arrow::default_memory_pool(), arrowProperties_.get());
+}
+
+// static
+bool NativeWriter::supports(const RowType& schema) {
+  for (const auto& type : schema.children()) {
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        break;
+      case TypeKind::INTEGER:
+        if (!type->isDate() && !type->equivalent(*INTEGER())) {
+          return false;
+        }
+        break;
+      case TypeKind::BIGINT:
+        if (!type->equivalent(*BIGINT())) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void NativeWriter::write(
+    const std::vector<RowVectorPtr>& batches,
+    uint64_t maxRowsInRowGroup) {
+  struct Segment {
+    const RowVector* batch;
+    vector_size_t begin;
+    vector_size_t end;
+  };
+
+  size_t batchIndex = 0;
+  vector_size_t offset = 0;
+  while (batchIndex < batches.size()) {
+    std::vector<Segment> segments;
+    uint64_t numRows = 0;
+    while (batchIndex < batches.size() && numRows < maxRowsInRowGroup) {
+      const auto& batch = batches[batchIndex];
+      const auto size = std::min<uint64_t>(
+          batch->size() - offset, maxRowsInRowGroup - numRows);
+      if (size > 0) {
+        segments.push_back(
+            {batch.get(), offset, static_cast<vector_size_t>(offset + size)});
+      }
+      numRows += size;
+      offset += size;
+      if (offset == batch->size()) {
+        ++batchIndex;
+        offset = 0;
+      }
+    }
+    if (numRows == 0) {
+      break;
+    }
+
+    auto* rowGroup = fileWriter_->AppendRowGroup();
+    for (auto column = 0; column < schema_->size(); ++column) {
+      auto* columnWriter = rowGroup->NextColumn();
+      for (const auto& segment : segments) {
+        writeColumn(
+            *columnWriter,
+            segment.batch->childAt(column),
+            segment.begin,
+            segment.end);
+      }
+    }
+    rowGroup->Close();
+  }
+}
+
+void NativeWriter::close() {
+  fileWriter_->Close();
+}
+
+void NativeWriter::setDefLevels(
+    const DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end) {
+  defLevels_.resize(end - begin);
+  if (!decoded.mayHaveNulls()) {
+    std::fill(defLevels_.data(), defLevels_.data() + (end - begin), 1);
+    return;
+  }
+  for (auto row = begin; row < end; ++row) {
+    defLevels_[row - begin] = decoded.isNullAt(row) ? 0 : 1;
+  }
+}
+
+template <typename TVelox, typename DType>
+void NativeWriter::writeValues(
+    arrow::ColumnWriter& writer,
+    const DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end) {
+  using T = typename DType::c_type;
+  auto& typedWriter = static_cast<arrow::TypedColumnWriter<DType>&>(writer);
+  const auto numRows = end - begin;
+  setDefLevels(decoded, begin, end);
+
+  // Flat values with the same layout in Velox and Parquet are encoded in place.
+  if constexpr (
+      std::is_same_v<TVelox, T> && !std::is_same_v<TVelox, bool>) {
+    if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+      typedWriter.WriteBatch(
+          numRows, defLevels_.data(), nullptr, decoded.data<T>() + begin);
+      return;
+    }
+  }
+
+  raw_vector<T> values(numRows);
+  vector_size_t numValues = 0;
+  for (auto row = begin; row < end; ++row) {
+    if (decoded.isNullAt(row)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<TVelox, bool>) {
+      values[numValues++] = decoded.valueAt<bool>(row);
+    } else {
+      // Reads the value in place so that strings point into the vector.
+      values[numValues++] =
+          toParquet<T>(decoded.data<TVelox>()[decoded.index(row)]);
+    }
+  }
+  typedWriter.WriteBatch(numRows, defLevels_.data(), nullptr, values.data());
+}
+
+void NativeWriter::writeDictionary(
+    arrow::ColumnWriter& writer,
+    const VectorPtr& vector,
+    const DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end) {
+  setDefLevels(decoded, begin, end);
+  const auto slice = vector->slice(begin, end - begin);
+  const ArrowOptions options{.flattenDictionary = false};
+  ArrowArray arrowArray;
+  ArrowSchema arrowSchema;
+  exportToArrow(slice, arrowArray, pool_, options);
+  exportToArrow(slice, arrowSchema, options);
+  PARQUET_ASSIGN_OR_THROW(
+      auto array, ::arrow::ImportArray(&arrowArray, &arrowSchema));
+  PARQUET_THROW_NOT_OK(writer.WriteArrow(
+      defLevels_.data(),
+      nullptr,
+      end - begin,
+      *array,
+      arrowContext_.get(),
+      /*leaf_field_nullable=*/true));
+}
+
+void NativeWriter::writeColumn(
+    arrow::ColumnWriter& writer,
+    const VectorPtr& vector,
+    vector_size_t begin,
+    vector_size_t end) {
+  SelectivityVector rows(end, false);
+  rows.setValidRange(begin, end, true);
+  rows.updateBounds();
+  DecodedVector decoded(*vector, rows);
+
+  switch (vector->typeKind()) {
+    case TypeKind::BOOLEAN:
+      return writeValues<bool, arrow::BooleanType>(writer, decoded, begin, end);
+    case TypeKind::TINYINT:
+      return writeValues<int8_t, arrow::Int32Type>(writer, decoded, begin, end);
+    case TypeKind::SMALLINT:
+      return writeValues<int16_t, arrow::Int32Type>(
+          writer, decoded, begin, end);
+    case TypeKind::INTEGER:
+      return writeValues<int32_t, arrow::Int32Type>(
+          writer, decoded, begin, end);
+    case TypeKind::BIGINT:
+      return writeValues<int64_t, arrow::Int64Type>(
+          writer, decoded, begin, end);
+    case TypeKind::REAL:
+      return writeValues<float, arrow::FloatType>(writer, decoded, begin, end);
+    case TypeKind::DOUBLE:
+      return writeValues<double, arrow::DoubleType>(
+          writer, decoded, begin, end);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (vector->encoding() == VectorEncoding::Simple::DICTIONARY &&
+          vector->valueVector()->isFlatEncoding() &&
+          writer.properties()->dictionary_enabled(writer.descr()->path())) {
+        return writeDictionary(writer, vector, decoded, begin, end);
+      }
+      return writeValues<StringView, arrow::ByteArrayType>(
+          writer, decoded, begin, end);
+    default:
+      VELOX_UNREACHABLE("Unsupported type {}", vector->type()->toString());
+  }
+}
+
+} // namespace facebook::velox::parquet
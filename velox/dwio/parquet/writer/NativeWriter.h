@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/FileWriter.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Writes top level columns of primitive types from Velox vectors directly
+/// into Parquet column chunks, without first converting the vectors to Arrow.
+/// Fixed width values are passed to the page encoders in place when the
+/// vector is flat and has no nulls, and strings are passed as views into the
+/// vector's string buffers. Dictionary encoded string vectors have their
+/// dictionary written as is instead of hashing every row.
+class NativeWriter {
+ public:
+  NativeWriter(
+      const RowTypePtr& schema,
+      std::shared_ptr<::arrow::io::OutputStream> sink,
+      std::shared_ptr<arrow::WriterProperties> properties,
+      memory::MemoryPool* pool);
+
+  /// Returns true if all the columns of 'schema' can be written by this
+  /// writer.
+  static bool supports(const RowType& schema);
+
+  /// Writes 'batches' as row groups of at most 'maxRowsInRowGroup' rows.
+  void write(
+      const std::vector<RowVectorPtr>& batches,
+      uint64_t maxRowsInRowGroup);
+
+  /// Writes the file footer. No more data may be written after this.
+  void close();
+
+  arrow::ParquetFileWriter& fileWriter() const {
+    return *fileWriter_;
+  }
+
+ private:
+  void writeColumn(
+      arrow::ColumnWriter& writer,
+      const VectorPtr& vector,
+      vector_size_t begin,
+      vector_size_t end);
+
+  template <typename TVelox, typename DType>
+  void writeValues(
+      arrow::ColumnWriter& writer,
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end);
+
+  // Writes a dictionary encoded string vector through the dictionary aware
+  // write path of the column writer.
+  void writeDictionary(
+      arrow::ColumnWriter& writer,
+      const VectorPtr& vector,
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end);
+
+  // Fills 'defLevels_' for rows [begin, end) of 'decoded'.
+  void setDefLevels(
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end);
+
+  const RowTypePtr schema_;
+  memory::MemoryPool* const pool_;
+  std::unique_ptr<arrow::ParquetFileWriter> fileWriter_;
+  std::shared_ptr<arrow::ArrowWriterProperties> arrowProperties_;
+  std::unique_ptr<arrow::ArrowWriteContext> arrowContext_;
+  raw_vector<int16_t> defLevels_;
+};
+
+} // namespace facebook::velox::parquet
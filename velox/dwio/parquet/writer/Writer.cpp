@@ -19,6 +19,8 @@
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
 #include "velox/common/testutil/TestValue.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -94,6 +96,15 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   int64_t bytesFlushed_ = 0;
 };
 
+// A column that has a Bloom filter in each row group.
+struct BloomFilterColumn {
+  column_index_t channel;
+  // Ordinal of the column among the leaf columns of the file.
+  int32_t leafColumn;
+  // Hashes of the staged values by row group of the next flush.
+  std::vector<folly::F14FastSet<uint64_t>> rowGroupHashes;
+};
+
 struct ArrowContext {
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
@@ -102,6 +113,14 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // Set instead of 'writer' when the vectors are encoded without converting
+  // them to Arrow. The staged input is kept in 'stagingBatches'.
+  std::unique_ptr<NativeWriter> nativeWriter;
+  bool useNativeWriter = false;
+  std::vector<RowVectorPtr> stagingBatches;
+  std::vector<BloomFilterColumn> bloomFilterColumns;
+  double bloomFilterFpp;
+  int32_t bloomFilterMaxBytes;
 };
 
 Compression::type getArrowParquetCompression(
@@ -144,6 +163,9 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
   properties = properties->enable_store_decimal_as_integer();
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   return properties->build();
 }
 
@@ -170,6 +192,148 @@ void validateSchemaRecursive(const RowTypePtr& schema) {
   }
 }
 
+// Returns the number of Parquet leaf columns 'type' is written as.
+int32_t numLeafColumns(const Type& type) {
+  if (type.isPrimitiveType()) {
+    return 1;
+  }
+  int32_t numLeaves = 0;
+  for (auto i = 0; i < type.size(); ++i) {
+    numLeaves += numLeafColumns(*type.childAt(i));
+  }
+  return numLeaves;
+}
+
+std::vector<BloomFilterColumn> makeBloomFilterColumns(
+    const RowType& schema,
+    const std::vector<std::string>& names) {
+  std::vector<BloomFilterColumn> columns;
+  for (const auto& name : names) {
+    const auto channel = schema.getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        channel.has_value(), "Bloom filter column not found: {}", name);
+    const auto& type = schema.childAt(channel.value());
+    switch (type->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        VELOX_USER_CHECK(
+            !type->isDecimal(),
+            "Bloom filters are not supported for column {} of type {}",
+            name,
+            type->toString());
+        break;
+      default:
+        VELOX_USER_FAIL(
+            "Bloom filters are not supported for column {} of type {}",
+            name,
+            type->toString());
+    }
+    int32_t leafColumn = 0;
+    for (auto i = 0; i < channel.value(); ++i) {
+      leafColumn += numLeafColumns(*schema.childAt(i));
+    }
+    columns.push_back({channel.value(), leafColumn, {}});
+  }
+  return columns;
+}
+
+template <typename T, typename THash>
+void addHashes(
+    const DecodedVector& decoded,
+    vector_size_t size,
+    uint64_t firstRow,
+    uint64_t rowsInRowGroup,
+    std::vector<folly::F14FastSet<uint64_t>>& rowGroupHashes) {
+  for (vector_size_t row = 0; row < size; ++row) {
+    if (decoded.isNullAt(row)) {
+      continue;
+    }
+    const auto rowGroup = (firstRow + row) / rowsInRowGroup;
+    if (rowGroup >= rowGroupHashes.size()) {
+      rowGroupHashes.resize(rowGroup + 1);
+    }
+    const auto value = decoded.valueAt<T>(row);
+    if constexpr (std::is_same_v<T, StringView>) {
+      rowGroupHashes[rowGroup].insert(SplitBlockBloomFilter::hash(
+          std::string_view(value.data(), value.size())));
+    } else {
+      rowGroupHashes[rowGroup].insert(
+          SplitBlockBloomFilter::hash(static_cast<THash>(value)));
+    }
+  }
+}
+
+// Hashes the values of the Bloom filter columns of 'data', which is staged
+// after the rows already in 'context'.
+void addBloomFilterHashes(
+    ArrowContext& context,
+    const VectorPtr& data,
+    uint64_t rowsInRowGroup) {
+  if (context.bloomFilterColumns.empty()) {
+    return;
+  }
+  const auto* input = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(input, "Expected a RowVector: {}", data->toString());
+  const auto size = input->size();
+  SelectivityVector rows(size);
+  DecodedVector decoded;
+  for (auto& column : context.bloomFilterColumns) {
+    decoded.decode(*input->childAt(column.channel), rows);
+    auto& hashes = column.rowGroupHashes;
+    const auto firstRow = context.stagingRows;
+    switch (input->childAt(column.channel)->typeKind()) {
+      case TypeKind::TINYINT:
+        addHashes<int8_t, int32_t>(
+            decoded, size, firstRow, rowsInRowGroup, hashes);
+        break;
+      case TypeKind::SMALLINT:
+        addHashes<int16_t, int32_t>(
+            decoded, size, firstRow, rowsInRowGroup, hashes);
+        break;
+      case TypeKind::INTEGER:
+        addHashes<int32_t, int32_t>(
+            decoded, size, firstRow, rowsInRowGroup, hashes);
+        break;
+      case TypeKind::BIGINT:
+        addHashes<int64_t, int64_t>(
+            decoded, size, firstRow, rowsInRowGroup, hashes);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        addHashes<StringView, StringView>(
+            decoded, size, firstRow, rowsInRowGroup, hashes);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+// Adds the Bloom filters of the row groups written by a flush to 'writer'.
+// 'firstRowGroup' is the ordinal of the first of these row groups.
+void addBloomFilters(
+    ArrowContext& context,
+    arrow::ParquetFileWriter& writer,
+    int32_t firstRowGroup) {
+  for (auto& column : context.bloomFilterColumns) {
+    for (auto i = 0; i < column.rowGroupHashes.size(); ++i) {
+      const auto& hashes = column.rowGroupHashes[i];
+      SplitBlockBloomFilter filter(SplitBlockBloomFilter::optimalNumBytes(
+          hashes.size(), context.bloomFilterFpp, context.bloomFilterMaxBytes));
+      for (auto hash : hashes) {
+        filter.insertHash(hash);
+      }
+      writer.AddBloomFilter(
+          firstRowGroup + i, column.leafColumn, filter.bitset());
+    }
+    column.rowGroupHashes.clear();
+  }
+}
+
 std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
     const std::shared_ptr<::arrow::Field>& field,
     const Type& type,
@@ -239,6 +403,12 @@ Writer::Writer(
       static_cast<TimestampUnit>(options.parquetWriteTimestampUnit);
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->useNativeWriter =
+      options.enableNativeWriter && NativeWriter::supports(*schema_);
+  arrowContext_->bloomFilterColumns =
+      makeBloomFilterColumns(*schema_, options.bloomFilterColumns);
+  arrowContext_->bloomFilterFpp = options.bloomFilterFpp;
+  arrowContext_->bloomFilterMaxBytes = options.bloomFilterMaxBytes;
   setMemoryReclaimers();
 }
 
@@ -255,6 +425,25 @@ Writer::Writer(
           std::move(schema)} {}
 
 void Writer::flush() {
+  if (arrowContext_->useNativeWriter) {
+    if (arrowContext_->stagingRows > 0) {
+      if (!arrowContext_->nativeWriter) {
+        arrowContext_->nativeWriter = std::make_unique<NativeWriter>(
+            schema_, stream_, arrowContext_->properties, generalPool_.get());
+      }
+      auto& fileWriter = arrowContext_->nativeWriter->fileWriter();
+      const auto firstRowGroup = fileWriter.num_row_groups();
+      arrowContext_->nativeWriter->write(
+          arrowContext_->stagingBatches, flushPolicy_->rowsInRowGroup());
+      addBloomFilters(*arrowContext_, fileWriter, firstRowGroup);
+      PARQUET_THROW_NOT_OK(stream_->Flush());
+      arrowContext_->stagingBatches.clear();
+      arrowContext_->stagingRows = 0;
+      arrowContext_->stagingBytes = 0;
+    }
+    return;
+  }
+
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
       auto arrowProperties = ArrowWriterProperties::Builder().build();
@@ -282,8 +471,11 @@ void Writer::flush() {
         arrowContext_->schema,
         std::move(chunks),
         static_cast<int64_t>(arrowContext_->stagingRows));
+    auto* fileWriter = arrowContext_->writer->parquet_writer();
+    const auto firstRowGroup = fileWriter->num_row_groups();
     PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
         *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
+    addBloomFilters(*arrowContext_, *fileWriter, firstRowGroup);
     PARQUET_THROW_NOT_OK(stream_->Flush());
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
@@ -313,6 +505,22 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
+  if (arrowContext_->useNativeWriter) {
+    auto rowVector = std::dynamic_pointer_cast<RowVector>(data);
+    VELOX_CHECK_NOT_NULL(
+        rowVector, "Expected a RowVector: {}", data->toString());
+    if (flushPolicy_->shouldFlush(getStripeProgress(
+            arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
+      flush();
+    }
+    addBloomFilterHashes(
+        *arrowContext_, rowVector, flushPolicy_->rowsInRowGroup());
+    arrowContext_->stagingRows += rowVector->size();
+    arrowContext_->stagingBytes += rowVector->estimateFlatSize();
+    arrowContext_->stagingBatches.push_back(std::move(rowVector));
+    return;
+  }
+
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get(), options_);
@@ -349,6 +557,7 @@ void Writer::write(const VectorPtr& data) {
     flush();
   }
 
+  addBloomFilterHashes(*arrowContext_, data, flushPolicy_->rowsInRowGroup());
   for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
     arrowContext_->stagingChunks.at(colIdx).push_back(
         recordBatch->column(colIdx));
@@ -363,6 +572,10 @@ bool Writer::isCodecAvailable(common::CompressionKind compression) {
 }
 
 void Writer::newRowGroup(int32_t numRows) {
+  if (arrowContext_->useNativeWriter) {
+    flush();
+    return;
+  }
   PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(numRows));
 }
 
@@ -371,11 +584,20 @@ void Writer::close() {
 
   if (arrowContext_->writer) {
     PARQUET_THROW_NOT_OK(arrowContext_->writer->Close());
+    indexBytesWritten_ =
+        arrowContext_->writer->parquet_writer()->index_bytes_written();
     arrowContext_->writer.reset();
   }
+  if (arrowContext_->nativeWriter) {
+    arrowContext_->nativeWriter->close();
+    indexBytesWritten_ =
+        arrowContext_->nativeWriter->fileWriter().index_bytes_written();
+    arrowContext_->nativeWriter.reset();
+  }
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingBatches.clear();
 }
 
 void Writer::abort() {
@@ -394,6 +616,8 @@ parquet::WriterOptions getParquetOptions(
     parquetOptions.parquetWriteTimestampUnit =
         options.parquetWriteTimestampUnit.value();
   }
+  parquetOptions.enablePageIndex = options.parquetEnablePageIndex;
+  parquetOptions.bloomFilterColumns = options.parquetBloomFilterColumns;
   return parquetOptions;
 }
 
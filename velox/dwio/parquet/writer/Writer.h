@@ -105,6 +105,21 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // Writes the ColumnIndex and OffsetIndex of each column chunk. Readers use
+  // these to skip data pages by min/max.
+  bool enablePageIndex = false;
+  // Names of the top level columns to write a split block Bloom filter for in
+  // each row group. Only integer, date and string columns are supported.
+  std::vector<std::string> bloomFilterColumns;
+  // False positive probability the Bloom filters are sized for, given the
+  // number of distinct values of the column in the row group.
+  double bloomFilterFpp = 0.01;
+  // Upper bound on the size of the Bloom filter of a column chunk.
+  int32_t bloomFilterMaxBytes = 1 << 20;
+  // Encodes the columns directly from the Velox vectors instead of converting
+  // them to Arrow first. Only used when all columns are of primitive types
+  // supported by NativeWriter; other schemas use the Arrow based writer.
+  bool enableNativeWriter = false;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -145,6 +160,10 @@ class Writer : public dwio::common::Writer {
 
   void abort() override;
 
+  uint64_t indexBytesWritten() const override {
+    return indexBytesWritten_;
+  }
+
  private:
   // Sets the memory reclaimers for all the memory pools used by this writer.
   void setMemoryReclaimers();
@@ -163,6 +182,9 @@ class Writer : public dwio::common::Writer {
   const RowTypePtr schema_;
 
   ArrowOptions options_{.flattenDictionary = true, .flattenConstant = true};
+
+  // Bytes of page indexes and Bloom filters, set on close().
+  uint64_t indexBytesWritten_{0};
 };
 
 class ParquetWriterFactory : public dwio::common::WriterFactory {
@@ -18,6 +18,7 @@
 
 #include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -33,6 +34,7 @@
 #include "velox/dwio/parquet/writer/arrow/PageIndex.h"
 #include "velox/dwio/parquet/writer/arrow/Platform.h"
 #include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/dwio/parquet/writer/arrow/ThriftInternal.h"
 
 using arrow::MemoryPool;
 
@@ -431,7 +433,11 @@ class FileSerializer : public ParquetFileWriter::Contents {
       }
       row_group_writer_.reset();
 
+      PARQUET_ASSIGN_OR_THROW(int64_t index_start, sink_->Tell());
+      WriteBloomFilters();
       WritePageIndex();
+      PARQUET_ASSIGN_OR_THROW(int64_t index_end, sink_->Tell());
+      index_bytes_written_ = index_end - index_start;
 
       // Write magic bytes and metadata
       auto file_encryption_properties =
@@ -500,6 +506,23 @@ class FileSerializer : public ParquetFileWriter::Contents {
     }
   }
 
+  void AddBloomFilter(int row_group, int column, std::string bitset) override {
+    if (row_group < 0 || row_group >= num_row_groups_) {
+      throw ParquetException("Invalid row group ordinal: ", row_group);
+    }
+    if (column < 0 || column >= num_columns()) {
+      throw ParquetException("Invalid column ordinal: ", column);
+    }
+    if (bitset.empty() || bitset.size() % kBloomFilterBytesPerBlock != 0) {
+      throw ParquetException("Invalid Bloom filter size: ", bitset.size());
+    }
+    bloom_filters_[{row_group, column}] = std::move(bitset);
+  }
+
+  int64_t index_bytes_written() const override {
+    return index_bytes_written_;
+  }
+
   ~FileSerializer() override {
     try {
       FileSerializer::Close();
@@ -563,6 +586,38 @@ class FileSerializer : public ParquetFileWriter::Contents {
     }
   }
 
+  // Writes each Bloom filter as a BloomFilterHeader followed by the bitset and
+  // records its offset in the metadata of the column chunk.
+  void WriteBloomFilters() {
+    if (bloom_filters_.empty()) {
+      return;
+    }
+    if (properties_->file_encryption_properties()) {
+      throw ParquetException("Encryption is not supported with Bloom filters");
+    }
+    ThriftSerializer serializer;
+    for (const auto& [location, bitset] : bloom_filters_) {
+      format::BloomFilterHeader header;
+      header.__set_numBytes(static_cast<int32_t>(bitset.size()));
+      format::BloomFilterAlgorithm algorithm;
+      algorithm.__set_BLOCK(format::SplitBlockAlgorithm());
+      header.__set_algorithm(algorithm);
+      format::BloomFilterHash hash;
+      hash.__set_XXHASH(format::XxHash());
+      header.__set_hash(hash);
+      format::BloomFilterCompression compression;
+      compression.__set_UNCOMPRESSED(format::Uncompressed());
+      header.__set_compression(compression);
+
+      PARQUET_ASSIGN_OR_THROW(int64_t offset, sink_->Tell());
+      serializer.Serialize(&header, sink_.get());
+      PARQUET_THROW_NOT_OK(sink_->Write(bitset.data(), bitset.size()));
+      metadata_->SetBloomFilterLocation(
+          location.first, location.second, offset);
+    }
+    bloom_filters_.clear();
+  }
+
   void WritePageIndex() {
     if (page_index_builder_ != nullptr) {
       if (properties_->file_encryption_properties()) {
@@ -588,6 +643,11 @@ class FileSerializer : public ParquetFileWriter::Contents {
   std::unique_ptr<RowGroupWriter> row_group_writer_;
   std::unique_ptr<PageIndexBuilder> page_index_builder_;
   std::unique_ptr<InternalFileEncryptor> file_encryptor_;
+  // Size of a block of a split block Bloom filter.
+  static constexpr size_t kBloomFilterBytesPerBlock = 32;
+  // Bitsets of Bloom filters by row group and column ordinal.
+  std::map<std::pair<int, int>, std::string> bloom_filters_;
+  int64_t index_bytes_written_ = 0;
 
   void StartFile() {
     auto file_encryption_properties = properties_->file_encryption_properties();
@@ -750,6 +810,7 @@ void ParquetFileWriter::Close() {
   if (contents_) {
     contents_->Close();
     file_metadata_ = contents_->metadata();
+    index_bytes_written_ = contents_->index_bytes_written();
     contents_.reset();
   }
 }
@@ -775,6 +836,21 @@ void ParquetFileWriter::AddKeyValueMetadata(
   }
 }
 
+void ParquetFileWriter::AddBloomFilter(
+    int row_group,
+    int column,
+    std::string bitset) {
+  if (contents_) {
+    contents_->AddBloomFilter(row_group, column, std::move(bitset));
+  } else {
+    throw ParquetException("Cannot add Bloom filter to closed file");
+  }
+}
+
+int64_t ParquetFileWriter::index_bytes_written() const {
+  return index_bytes_written_;
+}
+
 const std::shared_ptr<WriterProperties>& ParquetFileWriter::properties() const {
   return contents_->properties();
 }
@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "velox/dwio/parquet/writer/arrow/Metadata.h"
@@ -173,6 +174,11 @@ class PARQUET_EXPORT ParquetFileWriter {
     virtual void AddKeyValueMetadata(
         const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) = 0;
 
+    virtual void
+    AddBloomFilter(int row_group, int column, std::string bitset) = 0;
+
+    virtual int64_t index_bytes_written() const = 0;
+
     // Return const-pointer to make it clear that this object is not to be
     // copied
     const SchemaDescriptor* schema() const {
@@ -236,6 +242,19 @@ class PARQUET_EXPORT ParquetFileWriter {
   void AddKeyValueMetadata(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata);
 
+  /// \brief Add a split block Bloom filter for a column chunk.
+  /// \param[in] row_group the ordinal of a row group that has been appended.
+  /// \param[in] column the ordinal of the leaf column.
+  /// \param[in] bitset the bitset of the filter, a multiple of 32 bytes.
+  /// \note The filters are written before the page index when the file is
+  /// closed. The bitset of a column chunk replaces any earlier one.
+  /// \throw ParquetException if Close() has been called.
+  void AddBloomFilter(int row_group, int column, std::string bitset);
+
+  /// Bytes of Bloom filters and page indexes written to the file. Only
+  /// available after calling Close().
+  int64_t index_bytes_written() const;
+
   /// Number of columns.
   ///
   /// This number is fixed during the lifetime of the writer as it is determined
@@ -269,6 +288,7 @@ class PARQUET_EXPORT ParquetFileWriter {
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
   std::shared_ptr<FileMetaData> file_metadata_;
+  int64_t index_bytes_written_ = 0;
 };
 
 } // namespace facebook::velox::parquet::arrow
@@ -2147,6 +2147,16 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     }
   }
 
+  void SetBloomFilterLocation(int row_group, int column, int64_t offset) {
+    auto& row_group_metadata = row_groups_.at(row_group);
+    if (column >= static_cast<int>(row_group_metadata.columns.size())) {
+      throw ParquetException(
+          "Cannot find metadata for column ordinal ", column);
+    }
+    row_group_metadata.columns.at(column).meta_data.__set_bloom_filter_offset(
+        offset);
+  }
+
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
     int64_t total_rows = 0;
@@ -2300,6 +2310,13 @@ void FileMetaDataBuilder::SetPageIndexLocation(
   impl_->SetPageIndexLocation(location);
 }
 
+void FileMetaDataBuilder::SetBloomFilterLocation(
+    int row_group,
+    int column,
+    int64_t offset) {
+  impl_->SetBloomFilterLocation(row_group, column, offset);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish(
     const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
   return impl_->Finish(key_value_metadata);
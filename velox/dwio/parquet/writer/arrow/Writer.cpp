@@ -520,6 +520,10 @@ class FileWriterImpl : public FileWriter {
     return writer_->metadata();
   }
 
+  ParquetFileWriter* parquet_writer() const override {
+    return writer_.get();
+  }
+
  private:
   friend class FileWriter;
 
@@ -159,6 +159,10 @@ class PARQUET_EXPORT FileWriter {
   virtual MemoryPool* memory_pool() const = 0;
   /// \brief Return the file metadata, only available after calling Close().
   virtual const std::shared_ptr<FileMetaData> metadata() const = 0;
+
+  /// \brief Return the underlying ParquetFileWriter, e.g. to add Bloom
+  /// filters for the written column chunks.
+  virtual ParquetFileWriter* parquet_writer() const = 0;
 };
 
 /// \brief Write Parquet file metadata only to indicated Arrow OutputStream
@@ -85,6 +85,23 @@ class Aggregate {
     return false;
   }
 
+  /// Returns true if retractSingleGroupRawInput() is supported.
+  virtual bool supportsRetract() const {
+    return false;
+  }
+
+  /// Aggregates whose result is the smallest or the largest of their non-null
+  /// inputs in the order of BaseVector::compare().
+  enum class Extremum { kNone, kMin, kMax };
+
+  /// Returns kMin or kMax if the result is the smallest or the largest
+  /// non-null input, e.g. for min, max, bool_and and bool_or, so that the
+  /// result for a set of inputs can be computed from the single input
+  /// selected by the caller.
+  virtual Extremum extremum() const {
+    return Extremum::kNone;
+  }
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
@@ -202,6 +219,28 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  /// Removes raw input previously added with addSingleGroupRawInput() from the
+  /// single accumulator. Window aggregates use this to slide a frame by
+  /// removing the rows that leave it instead of aggregating it again. Only
+  /// called if supportsRetract() is true.
+  ///
+  /// The null flag of 'group' is not updated. Instead of removing the last
+  /// rows whose arguments are all non-null, the caller initializes the group
+  /// again.
+  ///
+  /// @param group Pointer to the start of the group row.
+  /// @param rows Rows of the 'args' to remove from the accumulator.
+  /// @param args Raw input to remove from the accumulator.
+  /// @return False if the input cannot be removed exactly, e.g. on an integer
+  /// overflow or if an infinite or NaN value is removed. 'group' must then be
+  /// initialized again and the remaining input added to it.
+  virtual bool retractSingleGroupRawInput(
+      char* /*group*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_UNSUPPORTED("retractSingleGroupRawInput is not supported");
+  }
+
   // Updates the single final accumulator from intermediate results for global
   // aggregation.
   // @param group Pointer to the start of the group row.
@@ -15,6 +15,10 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <folly/ScopeGuard.h>
+#include <deque>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -29,6 +33,18 @@ namespace {
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Frames whose starts and ends both move forward are computed from the
+// previous frame if the aggregate can remove inputs or returns its smallest or
+// largest input. The rows that enter the frame are added and the rows that
+// leave it are removed with retractSingleGroupRawInput(), or a monotonic deque
+// of the rows that can still be the result of a later frame is kept.
+//
+// Other frames that slide over large ranges of rows are computed from a
+// segment tree of partial aggregates over the partition if the aggregate can
+// combine its intermediate results in any order. Each frame is then made up of
+// at most 2 * (kSegmentTreeFanout - 1) nodes per level of the tree instead of
+// all its rows.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -101,6 +117,22 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    // The segment tree re-associates the inputs of the aggregate and keeps its
+    // intermediate results in vectors, so it is only used for aggregates that
+    // are not order sensitive and have fixed size accumulators.
+    const auto* entry = exec::getAggregateFunctionEntry(name);
+    supportsSegmentTree_ = entry != nullptr &&
+        !entry->metadata.orderSensitive && aggregate_->isFixedSize() &&
+        !aggregate_->accumulatorUsesExternalMemory();
+    if (supportsSegmentTree_) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+    }
+
+    supportsRetract_ = aggregate_->supportsRetract();
+    if (argTypes_.size() == 1) {
+      extremum_ = aggregate_->extremum();
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -116,6 +148,17 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    slidingFrame_ = false;
+    segmentTree_.clear();
+    segmentTreeNodeRows_ = 1;
+    segmentTreeFailed_ = false;
+  }
+
+  std::optional<RowsAccess> rowsAccess() const override {
+    RowsAccess access;
+    access.readsFrames = true;
+    access.incrementalFrames = true;
+    return access;
   }
 
   void apply(
@@ -136,6 +179,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
     FrameMetadata frameMetadata =
         analyzeFrameValues(validRows, rawFrameStarts, rawFrameEnds);
 
+    const bool sliding = !frameMetadata.incrementalAggregation &&
+        frameMetadata.slidingFrames &&
+        (supportsRetract_ || extremum_ != exec::Aggregate::Extremum::kNone);
+    if (!sliding) {
+      // The other ways of computing the frames reuse the single group.
+      slidingFrame_ = false;
+    }
+
     if (frameMetadata.incrementalAggregation) {
       vector_size_t startRow;
       if (frameMetadata.usePreviousAggregate) {
@@ -163,6 +214,27 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (sliding) {
+      slidingAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
+    } else if (
+        frameMetadata.maxFrameSize >= kMinSegmentTreeFrameSize &&
+        buildSegmentTree(frameMetadata.maxFrameSize)) {
+      fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
+      segmentTreeAggregation(
+          validRows,
+          frameMetadata.firstRow,
+          frameMetadata.lastRow,
+          rawFrameStarts,
+          rawFrameEnds,
+          resultOffset,
+          result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -178,6 +250,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
   }
 
  private:
+  // Number of children of a node of the segment tree.
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // Blocks whose frames have less rows than this are aggregated row by row
+  // since few rows are saved by the segment tree.
+  static constexpr vector_size_t kMinSegmentTreeFrameSize =
+      4 * kSegmentTreeFanout;
+
   struct FrameMetadata {
     // Min frame start row required for aggregation.
     vector_size_t firstRow;
@@ -193,6 +273,15 @@ class AggregateWindowFunction : public exec::WindowFunction {
 
     // Resume incremental aggregation from the prior block.
     bool usePreviousAggregate;
+
+    // Max number of rows in a frame of the block.
+    vector_size_t maxFrameSize;
+
+    // If the frame starts and the frame ends of the rows in the block are both
+    // non-decreasing, each frame can be computed from the previous one by
+    // adding the rows that enter the frame and removing the rows that leave
+    // it.
+    bool slidingFrames;
   };
 
   bool handleAllEmptyFrames(
@@ -201,6 +290,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
       const VectorPtr& result) {
     if (!validRows.hasSelections()) {
       setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+      // The next block does not continue the aggregation of the frames before
+      // this block. It would read the rows between these frames and its own,
+      // which a streaming partition may have removed.
+      previousFrameMetadata_.reset();
+      slidingFrame_ = false;
       return true;
     }
     return false;
@@ -223,18 +317,26 @@ class AggregateWindowFunction : public exec::WindowFunction {
     vector_size_t fixedFrameStartRow = firstRow;
     vector_size_t lastRow = rawFrameEnds[firstValidRow];
     vector_size_t prevFrameEnds = lastRow;
+    vector_size_t prevFrameStarts = firstRow;
+    vector_size_t maxFrameSize = 0;
 
     bool incrementalAggregation = true;
+    bool slidingFrames = true;
     validRows.applyToSelected([&](auto i) {
       firstRow = std::min(firstRow, rawFrameStarts[i]);
       lastRow = std::max(lastRow, rawFrameEnds[i]);
+      maxFrameSize =
+          std::max(maxFrameSize, rawFrameEnds[i] + 1 - rawFrameStarts[i]);
 
       // Incremental aggregation can be done if :
       // i) All rows have the same frameStart value.
       // ii) The frame end values are non-decreasing.
       incrementalAggregation &= (rawFrameStarts[i] == fixedFrameStartRow);
       incrementalAggregation &= rawFrameEnds[i] >= prevFrameEnds;
+      slidingFrames &= rawFrameStarts[i] >= prevFrameStarts &&
+          rawFrameEnds[i] >= prevFrameEnds;
       prevFrameEnds = rawFrameEnds[i];
+      prevFrameStarts = rawFrameStarts[i];
     });
 
     bool usePreviousAggregate = false;
@@ -251,7 +353,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
       }
     }
 
-    return {firstRow, lastRow, incrementalAggregation, usePreviousAggregate};
+    return {
+        firstRow,
+        lastRow,
+        incrementalAggregation,
+        usePreviousAggregate,
+        maxFrameSize,
+        slidingFrames};
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
@@ -328,9 +436,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       // This is a very naive algorithm.
       // It evaluates the entire aggregation for each row by iterating over
       // input rows from frameStart to frameEnd in the SelectivityVector.
-      // TODO : Try to re-use previous computations by advancing and retracting
-      // the aggregation based on the frame changes with each row. This would
-      // require adding new APIs to the Aggregate framework.
+      // Frames that slide forward are computed by slidingAggregation() if the
+      // aggregate supports it.
       aggregate_->clear();
       aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
       aggregateInitialized_ = true;
@@ -345,6 +452,362 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Computes each frame from the previous one. The single group or the deque
+  // of candidate rows holds the rows of the partition from 'slideBegin_' to
+  // 'slideEnd_'. The frames of the block have non-decreasing starts and ends
+  // and continue from the last frame of the previous block if that is before
+  // them.
+  void slidingAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const auto firstFrameStart = frameStartsVector[validRows.begin()];
+    const auto firstFrameEnd = frameEndsVector[validRows.begin()] + 1;
+    if (slidingFrame_ &&
+        (firstFrameStart < slideBegin_ || firstFrameEnd < slideEnd_)) {
+      slidingFrame_ = false;
+    }
+    // The rows removed from the single group must be in the argument vectors.
+    // They may have been released from a streaming partition, which then
+    // starts over at each block.
+    if (slidingFrame_ && extremum_ == exec::Aggregate::Extremum::kNone &&
+        partition_->isStreaming() && slideBegin_ < minFrame) {
+      slidingFrame_ = false;
+    }
+    slideArgsOffset_ = minFrame;
+    if (slidingFrame_ && extremum_ == exec::Aggregate::Extremum::kNone) {
+      slideArgsOffset_ = std::min(minFrame, slideBegin_);
+    }
+    fillArgVectors(slideArgsOffset_, maxFrame);
+    slideRows_.resizeFill(maxFrame + 1 - slideArgsOffset_, false);
+
+    validRows.applyToSelected([&](auto i) {
+      const auto frameStart = frameStartsVector[i];
+      const auto frameEnd = frameEndsVector[i] + 1;
+      if (extremum_ != exec::Aggregate::Extremum::kNone) {
+        slideExtremum(frameStart, frameEnd);
+      } else {
+        slideFrame(frameStart, frameEnd);
+      }
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  // Initializes the single group and the deque to hold no rows before
+  // 'frameStart'.
+  void startSlidingFrame(vector_size_t frameStart) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    aggregateInitialized_ = true;
+    slideBegin_ = frameStart;
+    slideEnd_ = frameStart;
+    slideNonNullRows_ = 0;
+    slideCandidates_.clear();
+    slidingFrame_ = true;
+  }
+
+  // Calls 'func' with 'slideRows_' set to the rows from 'begin' to 'end' of
+  // the partition.
+  template <typename Func>
+  auto withSlideRows(vector_size_t begin, vector_size_t end, Func func) {
+    slideRows_.setValidRange(
+        begin - slideArgsOffset_, end - slideArgsOffset_, true);
+    slideRows_.updateBounds();
+    SCOPE_EXIT {
+      slideRows_.setValidRange(
+          begin - slideArgsOffset_, end - slideArgsOffset_, false);
+    };
+    return func(slideRows_);
+  }
+
+  // Returns the number of 'rows' whose arguments are all non-null. These are
+  // the rows that the aggregate accumulates.
+  vector_size_t countNonNullRows(const SelectivityVector& rows) const {
+    vector_size_t count = 0;
+    rows.applyToSelected([&](auto row) {
+      for (const auto& arg : argVectors_) {
+        if (arg->isNullAt(row)) {
+          return;
+        }
+      }
+      ++count;
+    });
+    return count;
+  }
+
+  // Moves the single group to the frame from 'frameStart' to 'frameEnd'
+  // (exclusive) by removing the rows before 'frameStart' and adding the rows
+  // up to 'frameEnd'. Starts over from an empty group if the rows cannot be
+  // removed.
+  void slideFrame(vector_size_t frameStart, vector_size_t frameEnd) {
+    if (!slidingFrame_) {
+      startSlidingFrame(frameStart);
+    }
+    const auto removeEnd = std::min(frameStart, slideEnd_);
+    if (slideBegin_ < removeEnd) {
+      const bool removed =
+          withSlideRows(slideBegin_, removeEnd, [&](auto& rows) {
+            const auto numRemoved = countNonNullRows(rows);
+            if (numRemoved == slideNonNullRows_ ||
+                (numRemoved > 0 &&
+                 !aggregate_->retractSingleGroupRawInput(
+                     rawSingleGroupRow_, rows, argVectors_))) {
+              return false;
+            }
+            slideNonNullRows_ -= numRemoved;
+            return true;
+          });
+      if (!removed) {
+        // Nothing remains or the remaining rows need to be added again.
+        startSlidingFrame(frameStart);
+      }
+    }
+    slideBegin_ = frameStart;
+    slideEnd_ = std::max(slideEnd_, frameStart);
+    if (slideEnd_ < frameEnd) {
+      withSlideRows(slideEnd_, frameEnd, [&](auto& rows) {
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_, rows, argVectors_, false);
+        slideNonNullRows_ += countNonNullRows(rows);
+      });
+      slideEnd_ = frameEnd;
+    }
+  }
+
+  // Moves the deque of candidate rows to the frame from 'frameStart' to
+  // 'frameEnd' (exclusive) and sets the single group to the first candidate,
+  // which is the smallest or largest value of the frame. The candidates are
+  // the rows of the frame that have no smaller (for kMin) or larger (for
+  // kMax) value after them, in row order. A new row removes the candidates
+  // that are worse than it from the back of the deque, so that each row is
+  // added and removed at most once.
+  void slideExtremum(vector_size_t frameStart, vector_size_t frameEnd) {
+    if (!slidingFrame_) {
+      startSlidingFrame(frameStart);
+    }
+    while (!slideCandidates_.empty() &&
+           slideCandidates_.front() < frameStart) {
+      slideCandidates_.pop_front();
+    }
+    slideBegin_ = frameStart;
+    slideEnd_ = std::max(slideEnd_, frameStart);
+    const auto& arg = argVectors_[0];
+    // Ties keep the earlier row, which is the one the aggregate keeps.
+    const int32_t worse =
+        extremum_ == exec::Aggregate::Extremum::kMin ? 1 : -1;
+    for (auto row = slideEnd_; row < frameEnd; ++row) {
+      const auto index = row - slideArgsOffset_;
+      if (arg->isNullAt(index)) {
+        continue;
+      }
+      while (!slideCandidates_.empty()) {
+        const auto comparison = arg->compare(
+            arg.get(),
+            slideCandidates_.back() - slideArgsOffset_,
+            index,
+            CompareFlags{});
+        if (comparison.value() * worse <= 0) {
+          break;
+        }
+        slideCandidates_.pop_back();
+      }
+      slideCandidates_.push_back(row);
+    }
+    slideEnd_ = std::max(slideEnd_, frameEnd);
+
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    if (!slideCandidates_.empty()) {
+      const auto candidate = slideCandidates_.front();
+      withSlideRows(candidate, candidate + 1, [&](auto& rows) {
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_, rows, argVectors_, false);
+      });
+    }
+  }
+
+  // Adds the levels of the segment tree needed for frames of up to
+  // 'maxFrameSize' rows. Returns false if the segment tree is not supported
+  // for the aggregate or the partition, which must have all its rows, or if
+  // the aggregate failed over the rows of the partition, e.g. on an overflow
+  // that does not happen in any frame. The frames are then aggregated row by
+  // row.
+  bool buildSegmentTree(vector_size_t maxFrameSize) {
+    if (!supportsSegmentTree_ || segmentTreeFailed_ ||
+        partition_->isStreaming()) {
+      return false;
+    }
+    try {
+      while (segmentTreeNodeRows_ * kSegmentTreeFanout <= maxFrameSize) {
+        addSegmentTreeLevel();
+        segmentTreeNodeRows_ *= kSegmentTreeFanout;
+      }
+    } catch (const VeloxUserError&) {
+      segmentTree_.clear();
+      segmentTreeFailed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  // Adds a level to the segment tree. Each node of the new level holds the
+  // intermediate result of the aggregate over kSegmentTreeFanout consecutive
+  // rows of the partition for the first level or kSegmentTreeFanout
+  // consecutive nodes of the previous level otherwise.
+  void addSegmentTreeLevel() {
+    std::vector<VectorPtr> input;
+    vector_size_t numInputRows;
+    if (segmentTree_.empty()) {
+      numInputRows = partition_->numRows();
+      input.reserve(argIndices_.size());
+      for (auto i = 0; i < argIndices_.size(); ++i) {
+        if (argIndices_[i] == kConstantChannel) {
+          argVectors_[i]->resize(numInputRows);
+          input.push_back(argVectors_[i]);
+        } else {
+          auto column = BaseVector::create(argTypes_[i], numInputRows, pool_);
+          partition_->extractColumn(argIndices_[i], 0, numInputRows, 0, column);
+          input.push_back(std::move(column));
+        }
+      }
+    } else {
+      numInputRows = segmentTree_.back()->size();
+      input.push_back(segmentTree_.back());
+    }
+
+    const vector_size_t numNodes =
+        bits::roundUp(numInputRows, kSegmentTreeFanout) / kSegmentTreeFanout;
+    const auto nodeSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    auto nodesBuffer = AlignedBuffer::allocate<char>(
+        static_cast<size_t>(numNodes) * nodeSize, pool_, 0);
+    std::vector<char*> nodes(numNodes);
+    std::vector<vector_size_t> indices(numNodes);
+    for (auto i = 0; i < numNodes; ++i) {
+      nodes[i] = nodesBuffer->asMutable<char>() +
+          static_cast<size_t>(i) * nodeSize;
+      indices[i] = i;
+    }
+    std::vector<char*> groups(numInputRows);
+    for (auto i = 0; i < numInputRows; ++i) {
+      groups[i] = nodes[i / kSegmentTreeFanout];
+    }
+
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(nodes.data(), indices);
+    SelectivityVector rows(numInputRows);
+    if (segmentTree_.empty()) {
+      aggregate_->addRawInput(groups.data(), rows, input, false);
+    } else {
+      aggregate_->addIntermediateResults(groups.data(), rows, input, false);
+    }
+    auto level = BaseVector::create(intermediateType_, numNodes, pool_);
+    aggregate_->extractAccumulators(nodes.data(), numNodes, &level);
+    aggregate_->destroy(folly::Range(nodes.data(), numNodes));
+    segmentTree_.push_back(std::move(level));
+  }
+
+  // Computes each frame from the largest nodes of the segment tree that fit in
+  // it and the rows at its edges. The argument vectors hold the rows of the
+  // partition from 'minFrame' to 'maxFrame'.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    // Level 0 is the rows of the partition in 'argVectors_'. Each other level
+    // is restricted to the nodes that overlap the frames of the block.
+    const auto numLevels = segmentTree_.size() + 1;
+    treeLevelArgs_.resize(numLevels);
+    treeLevelOffsets_.resize(numLevels);
+    treeLevelRows_.resize(numLevels);
+    treeLevelOffsets_[0] = minFrame;
+    treeLevelRows_[0].resizeFill(maxFrame + 1 - minFrame, false);
+    vector_size_t levelFirst = minFrame;
+    vector_size_t levelLast = maxFrame;
+    for (auto level = 1; level < numLevels; ++level) {
+      levelFirst /= kSegmentTreeFanout;
+      levelLast /= kSegmentTreeFanout;
+      const auto numLevelRows = levelLast + 1 - levelFirst;
+      treeLevelArgs_[level] = {
+          segmentTree_[level - 1]->slice(levelFirst, numLevelRows)};
+      treeLevelOffsets_[level] = levelFirst;
+      treeLevelRows_[level].resizeFill(numLevelRows, false);
+    }
+
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      // [begin, end) is the range of the frame in units of nodes of
+      // 'level'. The nodes of the range that are not covered by nodes of the
+      // next level are added at each level.
+      vector_size_t begin = frameStartsVector[i];
+      vector_size_t end = frameEndsVector[i] + 1;
+      for (auto level = 0;; ++level) {
+        const auto parentBegin =
+            bits::roundUp(begin, kSegmentTreeFanout) / kSegmentTreeFanout;
+        const auto parentEnd = end / kSegmentTreeFanout;
+        if (level + 1 == numLevels || parentBegin >= parentEnd) {
+          addSegmentTreeRange(level, begin, end);
+          break;
+        }
+        addSegmentTreeRange(level, begin, parentBegin * kSegmentTreeFanout);
+        addSegmentTreeRange(level, parentEnd * kSegmentTreeFanout, end);
+        begin = parentBegin;
+        end = parentEnd;
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
+  // Adds the nodes from 'begin' to 'end' of 'level' of the segment tree to the
+  // single group.
+  void addSegmentTreeRange(
+      vector_size_t level,
+      vector_size_t begin,
+      vector_size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    auto& rows = treeLevelRows_[level];
+    const auto offset = treeLevelOffsets_[level];
+    rows.setValidRange(begin - offset, end - offset, true);
+    rows.updateBounds();
+    if (level == 0) {
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, rows, argVectors_, false);
+    } else {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, rows, treeLevelArgs_[level], false);
+    }
+    rows.setValidRange(begin - offset, end - offset, false);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -393,6 +856,60 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // True if the aggregate can remove inputs with
+  // retractSingleGroupRawInput().
+  bool supportsRetract_{false};
+
+  // kMin or kMax if the aggregate has a single argument and returns its
+  // smallest or largest value.
+  exec::Aggregate::Extremum extremum_{exec::Aggregate::Extremum::kNone};
+
+  // True if the single group (or 'slideCandidates_' for an extremum) holds
+  // the rows of the partition from 'slideBegin_' to 'slideEnd_' (exclusive)
+  // of the last frame computed by slidingAggregation().
+  bool slidingFrame_{false};
+  vector_size_t slideBegin_{0};
+  vector_size_t slideEnd_{0};
+
+  // Number of rows from 'slideBegin_' to 'slideEnd_' whose arguments are all
+  // non-null.
+  vector_size_t slideNonNullRows_{0};
+
+  // Rows of the current frame that can be the smallest or largest value of
+  // the current or a later frame, in row order.
+  std::deque<vector_size_t> slideCandidates_;
+
+  // First row of the partition in 'argVectors_' for slidingAggregation().
+  vector_size_t slideArgsOffset_{0};
+
+  // Rows of 'argVectors_' to add to or remove from the single group.
+  SelectivityVector slideRows_;
+
+  // True if sliding frames can be computed from a segment tree of
+  // intermediate results of the aggregate.
+  bool supportsSegmentTree_{false};
+
+  // Type of the intermediate results in the segment tree.
+  TypePtr intermediateType_;
+
+  // Levels of the segment tree over the current partition. The nodes of
+  // segmentTree_[i] hold intermediate results over kSegmentTreeFanout^(i + 1)
+  // rows each. Levels are added as larger frames are seen.
+  std::vector<VectorPtr> segmentTree_;
+
+  // Number of rows covered by each node of the last level of 'segmentTree_'.
+  int64_t segmentTreeNodeRows_{1};
+
+  // True if building the segment tree failed for the current partition.
+  bool segmentTreeFailed_{false};
+
+  // Per level of the segment tree, the argument vectors, the first row of the
+  // level they start at and the rows to add for the current block. Level 0 is
+  // the input rows in 'argVectors_'.
+  std::vector<std::vector<VectorPtr>> treeLevelArgs_;
+  std::vector<vector_size_t> treeLevelOffsets_;
+  std::vector<SelectivityVector> treeLevelRows_;
 };
 
 } // namespace
@@ -36,6 +36,10 @@ class AssignUniqueId : public Operator {
     return true;
   }
 
+  bool preservesRowCount() const override {
+    return true;
+  }
+
   bool needsInput() const override {
     return true;
   }
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/CompressedRowVector.h"
+
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+namespace {
+serializer::presto::PrestoVectorSerde::PrestoOptions makeOptions(
+    common::CompressionKind compressionKind) {
+  return serializer::presto::PrestoVectorSerde::PrestoOptions{
+      true /*useLosslessTimestamp*/, compressionKind};
+}
+} // namespace
+
+CompressedRowVector::CompressedRowVector(
+    RowTypePtr type,
+    vector_size_t size,
+    common::CompressionKind compressionKind,
+    std::unique_ptr<folly::IOBuf> data,
+    uint64_t rawBytes)
+    : type_(std::move(type)),
+      size_(size),
+      compressionKind_(compressionKind),
+      data_(std::move(data)),
+      compressedBytes_(data_->computeChainDataLength()),
+      rawBytes_(rawBytes) {}
+
+// static
+std::unique_ptr<CompressedRowVector> CompressedRowVector::compress(
+    const RowVectorPtr& vector,
+    common::CompressionKind compressionKind,
+    memory::MemoryPool* pool) {
+  const auto options = makeOptions(compressionKind);
+  auto type = asRowType(vector->type());
+  VectorStreamGroup group(pool);
+  group.createStreamTree(type, vector->size(), &options);
+  group.append(vector);
+  IOBufOutputStream stream(*pool, nullptr, group.size());
+  group.flush(&stream);
+  return std::unique_ptr<CompressedRowVector>(new CompressedRowVector(
+      std::move(type),
+      vector->size(),
+      compressionKind,
+      stream.getIOBuf(),
+      vector->retainedSize()));
+}
+
+RowVectorPtr CompressedRowVector::decompress(memory::MemoryPool* pool) const {
+  std::vector<ByteRange> ranges;
+  for (const auto& range : *data_) {
+    ranges.push_back(ByteRange{
+        const_cast<uint8_t*>(range.data()),
+        static_cast<int32_t>(range.size()),
+        0});
+  }
+  ByteInputStream input(std::move(ranges));
+  const auto options = makeOptions(compressionKind_);
+  RowVectorPtr result;
+  VectorStreamGroup::read(&input, pool, type_, &result, &options);
+  VELOX_CHECK_EQ(result->size(), size_);
+  return result;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+
+#include "velox/common/compression/Compression.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// A RowVector kept in memory in serialized and compressed form. Operators
+/// that retain their input for a long time compress it under memory pressure
+/// before resorting to spilling, and decompress it when the rows are needed.
+/// The serialized bytes are allocated from the pool given to compress().
+class CompressedRowVector {
+ public:
+  /// Serializes 'vector' in the Presto wire format with 'compressionKind'.
+  static std::unique_ptr<CompressedRowVector> compress(
+      const RowVectorPtr& vector,
+      common::CompressionKind compressionKind,
+      memory::MemoryPool* pool);
+
+  /// Returns the decompressed vector, allocated from 'pool'.
+  RowVectorPtr decompress(memory::MemoryPool* pool) const;
+
+  vector_size_t size() const {
+    return size_;
+  }
+
+  /// The number of bytes held by the compressed form.
+  uint64_t compressedBytes() const {
+    return compressedBytes_;
+  }
+
+  /// The retained size of the vector before compression.
+  uint64_t rawBytes() const {
+    return rawBytes_;
+  }
+
+ private:
+  CompressedRowVector(
+      RowTypePtr type,
+      vector_size_t size,
+      common::CompressionKind compressionKind,
+      std::unique_ptr<folly::IOBuf> data,
+      uint64_t rawBytes);
+
+  const RowTypePtr type_;
+  const vector_size_t size_;
+  const common::CompressionKind compressionKind_;
+  const std::unique_ptr<folly::IOBuf> data_;
+  const uint64_t compressedBytes_;
+  const uint64_t rawBytes_;
+};
+
+} // namespace facebook::velox::exec
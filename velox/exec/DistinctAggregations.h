@@ -86,11 +86,25 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct values of row 'index' of 'input' to 'group'. 'input' is
+  /// a spilled accumulator column, i.e. an array of the distinct values of a
+  /// group. Values already in the group are ignored.
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
       const RowVectorPtr& result) = 0;
 
+  /// Returns the estimated bytes of the distinct values extracted for spilling
+  /// so far.
+  uint64_t spilledBytes() const {
+    return spilledBytes_;
+  }
+
  protected:
   // Initializes null flags and accumulators for newly encountered groups.  This
   // function should be called only once for each group.
@@ -108,6 +122,9 @@ class DistinctAggregations {
   int32_t initializedByte_;
   uint8_t initializedMask_;
   int32_t rowSizeOffset_;
+
+  // Updated by the spill extract function of accumulator(), which is const.
+  mutable uint64_t spilledBytes_{0};
 };
 
 } // namespace facebook::velox::exec
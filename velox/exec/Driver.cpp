@@ -16,22 +16,38 @@
 
 #include "Driver.h"
 #include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <gflags/gflags.h>
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/FilterProject.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/QueryTracer.h"
 #include "velox/exec/Task.h"
 
+DECLARE_int32(velox_memory_reservation_threads);
+
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 namespace {
 
+// Returns the process-wide executor which makes the memory reservations of
+// drivers that have gone off thread with kWaitForMemoryReservation.
+folly::Executor* memoryReservationExecutor() {
+  static auto* executor = new folly::CPUThreadPoolExecutor(
+      std::max<int32_t>(1, FLAGS_velox_memory_reservation_threads),
+      std::make_shared<folly::NamedThreadFactory>("MemoryReservation"));
+  return executor;
+}
+
 // Ensures that the thread is removed from its Task's thread count on exit.
 class CancelGuard {
  public:
@@ -168,7 +184,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
-  return common::SpillConfig(
+  common::SpillConfig spillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
       spillFilePrefix,
@@ -184,7 +200,30 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillColumnarFormat(),
+      prefixSortConfig());
+  if (!task->remoteSpillDirectory().empty()) {
+    spillConfig.remoteSpillConfig = common::RemoteSpillConfig{
+        [this]() -> std::string_view {
+          return task->getOrCreateRemoteSpillDirectory();
+        },
+        queryConfig.spillLocalMinFreeBytes()};
+  }
+  return spillConfig;
+}
+
+std::optional<common::PrefixSortConfig> DriverCtx::prefixSortConfig() const {
+  const auto& queryConfig = task->queryCtx()->queryConfig();
+  if (queryConfig.prefixSortNormalizedKeyMaxBytes() == 0) {
+    return std::nullopt;
+  }
+  return common::PrefixSortConfig(
+      queryConfig.prefixSortNormalizedKeyMaxBytes(),
+      queryConfig.prefixSortMinRows(),
+      queryConfig.prefixSortMaxStringPrefixLength(),
+      queryConfig.prefixSortRadixSortMinRows(),
+      queryConfig.prefixSortRadixSortMaxKeyBytes());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -221,6 +260,20 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          driver->recordTimelineEvent(
+              DriverTimeline::EventType::kBlocked,
+              state->sinceMicros_,
+              static_cast<uint8_t>(state->reason_));
+          if (auto* controller =
+                  task->driverController(driver->driverCtx()->pipelineId)) {
+            const uint64_t nowMicros =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now()
+                        .time_since_epoch())
+                    .count();
+            controller->recordBlocked(
+                state->reason_, nowMicros - state->sinceMicros_);
+          }
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -280,6 +333,10 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
+  if (auto* scheduler = driver->task()->driverScheduler()) {
+    scheduler->enqueue(std::move(driver));
+    return;
+  }
   driver->task()->queryCtx()->executor()->add(
       [driver]() { Driver::run(driver); });
 }
@@ -294,6 +351,53 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  queryTracer_ = task()->queryTracer();
+  timelineId_ = task()->timelineId();
+}
+
+void Driver::recordTimelineEvent(
+    DriverTimeline::EventType type,
+    uint64_t startMicros,
+    uint8_t code) {
+  if (timelineId_ == 0) {
+    return;
+  }
+  DriverTimeline::Event event{};
+  event.timelineId = timelineId_;
+  event.startMicros = startMicros;
+  event.durationMicros = getCurrentTimeMicro() - startMicros;
+  event.pipelineId = ctx_->pipelineId;
+  event.driverId = ctx_->driverId;
+  event.type = type;
+  event.code = code;
+  DriverTimeline::record(event);
+}
+
+std::unique_ptr<
+    process::DeltaPerfCounter<std::function<void(const process::PerfCounts&)>>>
+Driver::createDeltaPerfCounter(Operator* op) {
+  if (!trackOperatorHardwareCounters_) {
+    return nullptr;
+  }
+  auto* counters = process::PerfCounters::forThread();
+  if (!counters) {
+    return nullptr;
+  }
+  return std::make_unique<process::DeltaPerfCounter<
+      std::function<void(const process::PerfCounts&)>>>(
+      *counters, [op](const process::PerfCounts& counts) {
+        auto lockedStats = op->stats().wlock();
+        lockedStats->addRuntimeStat(
+            Operator::kHwCycles, RuntimeCounter(counts.cycles));
+        lockedStats->addRuntimeStat(
+            Operator::kHwInstructions, RuntimeCounter(counts.instructions));
+        lockedStats->addRuntimeStat(
+            Operator::kHwCacheMisses, RuntimeCounter(counts.cacheMisses));
+        lockedStats->addRuntimeStat(
+            Operator::kHwBranchMisses, RuntimeCounter(counts.branchMisses));
+      });
 }
 
 void Driver::initializeOperators() {
@@ -301,9 +405,14 @@ void Driver::initializeOperators() {
     return;
   }
   operatorsInitialized_ = true;
-  for (auto& op : operators_) {
-    op->initialize();
+  uint64_t initializationTimeUs{0};
+  {
+    MicrosecondTimer timer(&initializationTimeUs);
+    for (auto& op : operators_) {
+      op->initialize();
+    }
   }
+  task()->addOperatorInitializationTime(initializationTimeUs);
 }
 
 void Driver::pushdownFilters(int operatorIndex) {
@@ -362,7 +471,12 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   RowVectorPtr result;
+  const auto startMicros = getCurrentTimeMicro();
   auto stop = runInternal(self, blockingState, result);
+  recordTimelineEvent(
+      DriverTimeline::EventType::kRun,
+      startMicros,
+      static_cast<uint8_t>(stop));
 
   // We get kBlock if 'result' was produced; kAtEnd if pipeline has finished
   // processing and no more results will be produced; kAlreadyTerminated on
@@ -389,6 +503,14 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
+    DriverTimeline::CallScope timelineScope(                               \
+        timelineId_,                                                       \
+        ctx_->pipelineId,                                                  \
+        ctx_->driverId,                                                    \
+        operatorId,                                                        \
+        operatorMethod);                                                   \
+    process::SamplingProfiler::OperatorScope samplingScope(                \
+        operatorPtr->planNodeId(), operatorPtr->operatorType());           \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -514,6 +636,7 @@ StopReason Driver::runInternal(
 
   // Update the queued time after entering the Task to ensure the stats have not
   // been deleted.
+  task()->addDriverQueueTime(queuedTimeUs * 1'000);
   if (curOperatorId_ < operators_.size()) {
     operators_[curOperatorId_]->addRuntimeStat(
         "queuedWallNanos",
@@ -548,6 +671,15 @@ StopReason Driver::runInternal(
     ContinueFuture future = ContinueFuture::makeEmpty();
 
     for (;;) {
+      if (FOLLY_UNLIKELY(pendingInput_ != nullptr)) {
+        stop = task()->shouldStop();
+        if (stop != StopReason::kNone) {
+          guard.notThrown();
+          return stop;
+        }
+        addPendingInput();
+      }
+
       for (int32_t i = numOperators - 1; i >= 0; --i) {
         stop = task()->shouldStop();
         if (stop != StopReason::kNone) {
@@ -631,6 +763,7 @@ StopReason Driver::runInternal(
                     processLazyTiming(*op, deltaTiming);
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto perfCounter = createDeltaPerfCounter(op);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -657,11 +790,24 @@ StopReason Driver::runInternal(
             }
             pushdownFilters(i);
             if (intermediateResult) {
+              if (FOLLY_UNLIKELY(reserveMemoryAsync(
+                      self, nextOp, intermediateResult, &future))) {
+                // Adds the input when the driver resumes.
+                pendingInput_ = std::move(intermediateResult);
+                pendingInputOperatorId_ = curOperatorId_ + 1;
+                blockedOperatorId_ = curOperatorId_ + 1;
+                blockingReason_ = BlockingReason::kWaitForMemoryReservation;
+                blockingState = std::make_shared<BlockingState>(
+                    self, std::move(future), nextOp, blockingReason_);
+                guard.notThrown();
+                return StopReason::kBlock;
+              }
               auto timer = createDeltaCpuWallTimer(
                   [nextOp, this](const CpuWallTiming& timing) {
                     auto selfDelta = processLazyTiming(*nextOp, timing);
                     nextOp->stats().wlock()->addInputTiming.add(selfDelta);
                   });
+              auto perfCounter = createDeltaPerfCounter(nextOp);
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(
@@ -670,6 +816,10 @@ StopReason Driver::runInternal(
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
+              if (FOLLY_UNLIKELY(queryTracer_ != nullptr)) {
+                queryTracer_->traceInput(
+                    nextOp->planNodeId(), op->planNodeId(), intermediateResult);
+              }
 
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
@@ -741,6 +891,7 @@ StopReason Driver::runInternal(
                   auto selfDelta = processLazyTiming(*op, timing);
                   op->stats().wlock()->getOutputTiming.add(selfDelta);
                 });
+            auto perfCounter = createDeltaPerfCounter(op);
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -794,6 +945,83 @@ StopReason Driver::runInternal(
   }
 }
 
+bool Driver::reserveMemoryAsync(
+    const std::shared_ptr<Driver>& self,
+    Operator* op,
+    const RowVectorPtr& input,
+    ContinueFuture* future) {
+  if (!ctx_->queryConfig().asyncMemoryReservationEnabled()) {
+    return false;
+  }
+  uint64_t reservationBytes{0};
+  CALL_OPERATOR(
+      reservationBytes = op->inputReservationBytes(input),
+      op,
+      curOperatorId_ + 1,
+      kOpMethodAddInput);
+  auto* pool = op->pool();
+  // A reservation within the free capacity of the query needs no memory
+  // arbitration and is cheap to make on thread.
+  if (reservationBytes == 0 || pool->root()->freeBytes() >= reservationBytes) {
+    return false;
+  }
+  auto [promise, semiFuture] = makeVeloxContinuePromiseContract(
+      fmt::format("Driver::reserveMemoryAsync {}", pool->name()));
+  *future = std::move(semiFuture);
+  memoryReservationExecutor()->add([self,
+                                    task = task(),
+                                    pool,
+                                    reservationBytes,
+                                    promise = std::move(promise)]() mutable {
+    if (!task->isRunning()) {
+      promise.setValue();
+      return;
+    }
+    TestValue::adjust(
+        "facebook::velox::exec::Driver::reserveMemoryAsync", pool);
+    try {
+      if (!pool->maybeReserve(reservationBytes)) {
+        LOG(WARNING) << "Failed to reserve " << succinctBytes(reservationBytes)
+                     << " for memory pool " << pool->name();
+      }
+    } catch (const std::exception& e) {
+      // The query has been aborted, which the driver finds out when it
+      // resumes.
+      LOG(WARNING) << "Failed to reserve " << succinctBytes(reservationBytes)
+                   << " for memory pool " << pool->name() << ": " << e.what();
+    }
+    task->releaseReservationIfNotRunning(pool);
+    promise.setValue();
+  });
+  return true;
+}
+
+void Driver::addPendingInput() {
+  VELOX_CHECK_NOT_NULL(pendingInput_);
+  curOperatorId_ = pendingInputOperatorId_;
+  auto* op = operators_[pendingInputOperatorId_].get();
+  auto input = std::move(pendingInput_);
+  auto timer = createDeltaCpuWallTimer(
+      [op, this](const CpuWallTiming& timing) {
+        auto selfDelta = processLazyTiming(*op, timing);
+        op->stats().wlock()->addInputTiming.add(selfDelta);
+      });
+  op->stats().wlock()->addInputVector(input->estimateFlatSize(), input->size());
+  TestValue::adjust(
+      "facebook::velox::exec::Driver::runInternal::addInput", op);
+  if (FOLLY_UNLIKELY(queryTracer_ != nullptr)) {
+    queryTracer_->traceInput(
+        op->planNodeId(),
+        operators_[pendingInputOperatorId_ - 1]->planNodeId(),
+        input);
+  }
+  CALL_OPERATOR(
+      op->addInput(std::move(input)),
+      op,
+      curOperatorId_,
+      kOpMethodAddInput);
+}
+
 #undef CALL_OPERATOR
 
 // static
@@ -816,7 +1044,14 @@ void Driver::run(std::shared_ptr<Driver> self) {
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
+  const auto startMicros = getCurrentTimeMicro();
+  self->recordTimelineEvent(
+      DriverTimeline::EventType::kQueued, self->queueTimeStartUs_);
   auto reason = self->runInternal(self, blockingState, nullResult);
+  self->recordTimelineEvent(
+      DriverTimeline::EventType::kRun,
+      startMicros,
+      static_cast<uint8_t>(reason));
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -872,6 +1107,7 @@ void Driver::initializeOperatorStats(std::vector<OperatorStats>& stats) {
 }
 
 void Driver::closeOperators() {
+  pendingInput_ = nullptr;
   // Close operators.
   for (auto& op : operators_) {
     op->close();
@@ -935,6 +1171,39 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+void Driver::pushdownLimit(const Operator* limit, int64_t numRows) {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    auto op = operators_[i].get();
+    if (limit == op) {
+      operators_[0]->setOutputLimit(numRows);
+      return;
+    }
+    if (!op->preservesRowCount()) {
+      return;
+    }
+  }
+  VELOX_FAIL("Limit operator not found in its Driver: {}", limit->toString());
+}
+
+bool Driver::pushdownSplitResultConsumer(
+    const Operator* aggregation,
+    SplitResultConsumer* consumer,
+    const std::string& fragmentKey) {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    auto* op = operators_[i].get();
+    if (aggregation == op) {
+      return operators_[0]->setSplitResultConsumer(consumer, fragmentKey);
+    }
+    const auto* filterProject = dynamic_cast<const FilterProject*>(op);
+    if (filterProject == nullptr || !filterProject->isDeterministic()) {
+      return false;
+    }
+  }
+  VELOX_FAIL(
+      "Aggregation operator not found in its Driver: {}",
+      aggregation->toString());
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
@@ -1117,6 +1386,12 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kYield";
     case BlockingReason::kWaitForArbitration:
       return "kWaitForArbitration";
+    case BlockingReason::kWaitForMemoryReservation:
+      return "kWaitForMemoryReservation";
+    case BlockingReason::kWaitForActivation:
+      return "kWaitForActivation";
+    case BlockingReason::kWaitForPeerDrivers:
+      return "kWaitForPeerDrivers";
   }
   VELOX_UNREACHABLE();
   return "";
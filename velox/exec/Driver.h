@@ -22,12 +22,14 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/DriverTimeline.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -36,6 +38,8 @@ class Driver;
 class ExchangeClient;
 class Operator;
 struct OperatorStats;
+class QueryTracer;
+class SplitResultConsumer;
 class Task;
 
 enum class StopReason {
@@ -214,6 +218,17 @@ enum class BlockingReason {
   /// Operator is blocked waiting for its associated query memory arbitration to
   /// finish.
   kWaitForArbitration,
+  /// Driver is off thread waiting for the memory reservation of an operator
+  /// to finish before it adds input to the operator. The reservation needs
+  /// memory arbitration and runs on a separate executor in the meantime.
+  kWaitForMemoryReservation,
+  /// Driver is parked between splits because its pipeline has more active
+  /// Drivers than it can use, see PipelineDriverController.
+  kWaitForActivation,
+  /// Operator of a Driver is blocked waiting for the same operator of its peer
+  /// Drivers to finish their input before it can produce output from state
+  /// shared by the Drivers. Used by HashAggregation with a shared table.
+  kWaitForPeerDrivers,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -278,6 +293,10 @@ struct DriverCtx {
   std::shared_ptr<Task> task;
   Driver* driver;
   facebook::velox::process::ThreadDebugInfo threadDebugInfo;
+  /// Vector pool shared by the operators of the driver if
+  /// QueryConfig::kSharedDriverVectorPool is set. Created by the first
+  /// operator that needs it.
+  std::unique_ptr<VectorPool> sharedVectorPool;
 
   DriverCtx(
       std::shared_ptr<Task> _task,
@@ -294,6 +313,10 @@ struct DriverCtx {
 
   /// Builds the spill config for the operator with specified 'operatorId'.
   std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
+
+  /// Returns the prefix sort config from the query config or std::nullopt if
+  /// prefix sort is disabled.
+  std::optional<common::PrefixSortConfig> prefixSortConfig() const;
 };
 
 constexpr const char* kOpMethodNone = "";
@@ -405,6 +428,20 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
 
+  /// Informs the source operator of 'this' that only its first 'numRows'
+  /// output rows are consumed by 'limit'. Does nothing if some operator between
+  /// the source and 'limit' may change the number of rows.
+  void pushdownLimit(const Operator* limit, int64_t numRows);
+
+  /// Makes the source operator of 'this' report the split boundaries and the
+  /// cached split results to 'consumer' if only deterministic filters and
+  /// projections are between the source and 'aggregation'. 'consumer' is
+  /// usually 'aggregation'. Returns true if the source accepted 'consumer'.
+  bool pushdownSplitResultConsumer(
+      const Operator* aggregation,
+      SplitResultConsumer* consumer,
+      const std::string& fragmentKey);
+
   /// Returns a subset of channels for which there are operators upstream from
   /// filterSource that accept dynamically generated filters.
   std::unordered_set<column_index_t> canPushdownFilters(
@@ -450,6 +487,14 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return blockingReason_;
   }
 
+  /// Records an event of 'type' from 'startMicros' to now on the timeline of
+  /// the task if the query config enables the driver timeline. 'code' is the
+  /// StopReason or BlockingReason of the event.
+  void recordTimelineEvent(
+      DriverTimeline::EventType type,
+      uint64_t startMicros,
+      uint8_t code = 0);
+
   /// Returns the process-wide number of driver cpu yields.
   static std::atomic_uint64_t& yieldCount();
 
@@ -486,6 +531,21 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   void close();
 
+  // Starts to make the memory reservation that 'op' wants before adding
+  // 'input' on a separate executor if the query has not enough free capacity
+  // for it. Returns true and sets 'future' to be fulfilled when the
+  // reservation finishes if so. Returns false if the driver can add 'input'
+  // right away.
+  bool reserveMemoryAsync(
+      const std::shared_ptr<Driver>& self,
+      Operator* op,
+      const RowVectorPtr& input,
+      ContinueFuture* future);
+
+  // Adds 'pendingInput_' to its operator once the memory reservation for it
+  // has finished.
+  void addPendingInput();
+
   // Push down dynamic filters produced by the operator at the specified
   // position in the pipeline.
   void pushdownFilters(int operatorIndex);
@@ -501,6 +561,14 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // If 'trackOperatorHardwareCounters_' is true and the thread has hardware
+  // counters, returns a counter that adds the hardware counts of an
+  // operation to the runtime stats of 'op' upon destruction. Returns null
+  // otherwise.
+  std::unique_ptr<process::DeltaPerfCounter<std::function<
+      void(const process::PerfCounts&)>>>
+  createDeltaPerfCounter(Operator* op);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -535,8 +603,23 @@ class Driver : public std::enable_shared_from_this<Driver> {
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   size_t blockedOperatorId_{0};
 
+  // The input to add to operators_[pendingInputOperatorId_] when the driver
+  // resumes from kWaitForMemoryReservation.
+  RowVectorPtr pendingInput_;
+  size_t pendingInputOperatorId_{0};
+
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorHardwareCounters_;
+
+  // Saves the input of traced plan nodes. Owned by the task. nullptr if the
+  // query is not traced.
+  QueryTracer* queryTracer_{nullptr};
+
+  // Identifies the events of the task on the driver timeline. 0 if the
+  // timeline is not enabled.
+  uint64_t timelineId_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -667,6 +750,11 @@ struct DriverFactory {
   /// based on this pipeline.
   std::vector<core::PlanNodeId> needsNestedLoopJoinBridges() const;
 
+  /// Returns true if the pipeline starts with a round-robin local exchange
+  /// that feeds a table writer. The number of table writers that receive data
+  /// from such an exchange can be scaled with the input rate.
+  bool needsScaledWriterExchange() const;
+
   static std::vector<DriverAdapter> adapters;
 };
 
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <cmath>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/CpuWallTimer.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+namespace {
+// The scheduler and index of the thread of a MultiLevelDriverScheduler the
+// current thread is. Used to keep the Drivers enqueued from a thread of the
+// scheduler, e.g. on yield, in the queue of that thread.
+thread_local const MultiLevelDriverScheduler* currentScheduler{nullptr};
+thread_local int32_t currentWorker{-1};
+} // namespace
+
+std::string MultiLevelDriverScheduler::Stats::toString() const {
+  std::stringstream out;
+  out << "numRuns " << numRuns << " numStolen " << numStolen << " queueTime "
+      << succinctNanos(queueTimeNanos) << " levelCpuTime [";
+  for (auto i = 0; i < levelCpuNanos.size(); ++i) {
+    out << (i > 0 ? ", " : "") << succinctNanos(levelCpuNanos[i]);
+  }
+  out << "]";
+  return out.str();
+}
+
+MultiLevelDriverScheduler::MultiLevelDriverScheduler(Options options)
+    : options_(std::move(options)),
+      levelCpuNanos_(options_.levelThresholdNanos.size() + 1) {
+  VELOX_CHECK_GT(options_.numThreads, 0);
+  VELOX_CHECK_GE(options_.levelTimeMultiplier, 1);
+  VELOX_CHECK(std::is_sorted(
+      options_.levelThresholdNanos.begin(),
+      options_.levelThresholdNanos.end()));
+  workers_.reserve(options_.numThreads);
+  for (auto i = 0; i < options_.numThreads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_.back()->levels.resize(levelCpuNanos_.size());
+  }
+  for (auto i = 0; i < workers_.size(); ++i) {
+    workers_[i]->thread = std::thread([this, i]() { runWorker(i); });
+  }
+}
+
+MultiLevelDriverScheduler::~MultiLevelDriverScheduler() {
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    stopped_ = true;
+  }
+  idleCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void MultiLevelDriverScheduler::enqueue(std::shared_ptr<Driver> driver) {
+  auto queryCtx = driver->task()->queryCtx();
+  add(std::move(queryCtx),
+      [driver = std::move(driver)]() { Driver::run(driver); });
+}
+
+void MultiLevelDriverScheduler::add(
+    std::shared_ptr<core::QueryCtx> queryCtx,
+    folly::Func run) {
+  const auto level = levelForCpuTime(queryCtx->driverCpuTimeNanos());
+  const auto index = currentScheduler == this
+      ? currentWorker
+      : nextWorker_++ % workers_.size();
+  {
+    auto& worker = *workers_[index];
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.levels[level].push_back(Entry{
+        std::move(queryCtx), std::move(run), level, getCurrentTimeMicro()});
+  }
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    ++numQueued_;
+  }
+  idleCv_.notify_one();
+}
+
+int32_t MultiLevelDriverScheduler::levelForCpuTime(uint64_t cpuNanos) const {
+  const auto& thresholds = options_.levelThresholdNanos;
+  return std::upper_bound(thresholds.begin(), thresholds.end(), cpuNanos) -
+      thresholds.begin();
+}
+
+int32_t MultiLevelDriverScheduler::pickLevelLocked(const Worker& worker) const {
+  // Take from the non-empty level which is furthest below its share of the
+  // CPU time. Level i is entitled to 'levelTimeMultiplier' times the CPU time
+  // of level i + 1, so the CPU time of level i is scaled up by
+  // 'levelTimeMultiplier' ^ i for the comparison.
+  int32_t picked{-1};
+  double pickedScaledNanos{0};
+  for (auto level = 0; level < worker.levels.size(); ++level) {
+    if (worker.levels[level].empty()) {
+      continue;
+    }
+    const double scaledNanos = levelCpuNanos_[level] *
+        std::pow(options_.levelTimeMultiplier, level);
+    if (picked < 0 || scaledNanos < pickedScaledNanos) {
+      picked = level;
+      pickedScaledNanos = scaledNanos;
+    }
+  }
+  return picked;
+}
+
+std::optional<MultiLevelDriverScheduler::Entry>
+MultiLevelDriverScheduler::tryTake(int32_t index, bool steal) {
+  auto& worker = *workers_[index];
+  std::optional<Entry> entry;
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    const auto level = pickLevelLocked(worker);
+    if (level < 0) {
+      return std::nullopt;
+    }
+    auto& queue = worker.levels[level];
+    if (steal) {
+      entry = std::move(queue.back());
+      queue.pop_back();
+    } else {
+      entry = std::move(queue.front());
+      queue.pop_front();
+    }
+  }
+  --numQueued_;
+  return entry;
+}
+
+bool MultiLevelDriverScheduler::waitForWork() {
+  std::unique_lock<std::mutex> l(idleMutex_);
+  idleCv_.wait(l, [&]() { return stopped_ || numQueued_ > 0; });
+  return !stopped_;
+}
+
+void MultiLevelDriverScheduler::runWorker(int32_t index) {
+  currentScheduler = this;
+  currentWorker = index;
+  while (waitForWork()) {
+    auto entry = tryTake(index, false);
+    if (entry.has_value()) {
+      run(*entry, false);
+      continue;
+    }
+    for (auto i = 1; i < workers_.size(); ++i) {
+      entry = tryTake((index + i) % workers_.size(), true);
+      if (entry.has_value()) {
+        run(*entry, true);
+        break;
+      }
+    }
+  }
+}
+
+void MultiLevelDriverScheduler::run(Entry& entry, bool stolen) {
+  ++numRuns_;
+  if (stolen) {
+    ++numStolen_;
+  }
+  queueTimeNanos_ += (getCurrentTimeMicro() - entry.enqueueTimeUs) * 1'000;
+  CpuWallTiming timing;
+  {
+    CpuWallTimer timer(timing);
+    entry.run();
+  }
+  entry.queryCtx->addDriverCpuTimeNanos(timing.cpuNanos);
+  levelCpuNanos_[entry.level] += timing.cpuNanos;
+}
+
+MultiLevelDriverScheduler::Stats MultiLevelDriverScheduler::stats() const {
+  Stats stats;
+  stats.numRuns = numRuns_;
+  stats.numStolen = numStolen_;
+  stats.queueTimeNanos = queueTimeNanos_;
+  stats.levelCpuNanos.reserve(levelCpuNanos_.size());
+  for (const auto& nanos : levelCpuNanos_) {
+    stats.levelCpuNanos.push_back(nanos);
+  }
+  return stats;
+}
+
+std::string MultiLevelDriverScheduler::toString() const {
+  return fmt::format(
+      "MultiLevelDriverScheduler[threads {} levels {} {}]",
+      workers_.size(),
+      levelCpuNanos_.size(),
+      stats().toString());
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Function.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "velox/core/QueryCtx.h"
+
+namespace facebook::velox::exec {
+
+class Driver;
+
+/// Runs the Drivers of Tasks which have been given a scheduler with
+/// Task::setDriverScheduler(). Without one, Drivers are added to the executor
+/// of their QueryCtx. Driver::enqueue() hands a Driver to the scheduler every
+/// time it becomes runnable: when its Task starts, when a blocking future is
+/// realized and when it yields after running for the configured
+/// kDriverCpuTimeSliceLimitMs.
+class DriverScheduler {
+ public:
+  virtual ~DriverScheduler() = default;
+
+  /// Schedules Driver::run() of 'driver'. Called under the mutex of the Task of
+  /// 'driver', hence must not block or call back into the Task.
+  virtual void enqueue(std::shared_ptr<Driver> driver) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// A DriverScheduler with a multi-level feedback queue per thread. The level
+/// of a runnable Driver is set by the CPU time all Drivers of its query have
+/// used so far, so that short queries are not queued behind long running ones.
+/// Levels share the threads by CPU time: each level gets
+/// 'levelTimeMultiplier' times the CPU time of the next lower priority level
+/// when both have runnable Drivers. A thread runs the Drivers it enqueued
+/// itself, e.g. after a yield, and steals from the other threads when it has
+/// none.
+class MultiLevelDriverScheduler : public DriverScheduler {
+ public:
+  struct Options {
+    /// Number of threads. Each has its own queue.
+    uint32_t numThreads{std::max<uint32_t>(
+        1,
+        std::thread::hardware_concurrency())};
+
+    /// Accumulated CPU time of a query at which its Drivers move to the next
+    /// lower priority level. Level 0 has the highest priority and there is
+    /// one more level than thresholds.
+    std::vector<uint64_t> levelThresholdNanos{
+        1'000'000'000UL,
+        10'000'000'000UL,
+        60'000'000'000UL,
+        300'000'000'000UL};
+
+    /// Ratio between the CPU time of a level and of the next lower priority
+    /// level when both have runnable Drivers.
+    double levelTimeMultiplier{2};
+  };
+
+  struct Stats {
+    /// Number of runs started.
+    uint64_t numRuns{0};
+    /// Number of runs taken from the queue of another thread.
+    uint64_t numStolen{0};
+    /// Time runs spent in the queues before starting.
+    uint64_t queueTimeNanos{0};
+    /// CPU time of runs by level.
+    std::vector<uint64_t> levelCpuNanos;
+
+    std::string toString() const;
+  };
+
+  explicit MultiLevelDriverScheduler(Options options);
+
+  /// Stops the threads. Runs still in the queues are dropped, so all the Tasks
+  /// using 'this' must have finished before.
+  ~MultiLevelDriverScheduler() override;
+
+  void enqueue(std::shared_ptr<Driver> driver) override;
+
+  /// Schedules 'run' for the query of 'queryCtx'. The CPU time of 'run' is
+  /// added to the query with QueryCtx::addDriverCpuTimeNanos().
+  void add(std::shared_ptr<core::QueryCtx> queryCtx, folly::Func run);
+
+  /// Returns the level of a query which has used 'cpuNanos' of CPU time.
+  int32_t levelForCpuTime(uint64_t cpuNanos) const;
+
+  Stats stats() const;
+
+  std::string toString() const override;
+
+ private:
+  struct Entry {
+    std::shared_ptr<core::QueryCtx> queryCtx;
+    folly::Func run;
+    int32_t level;
+    uint64_t enqueueTimeUs;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    // One FIFO per level, guarded by 'mutex'. The owner thread takes from the
+    // front and stealing threads take from the back.
+    std::vector<std::deque<Entry>> levels;
+    std::thread thread;
+  };
+
+  void runWorker(int32_t index);
+
+  // Returns the level of 'worker' to take a run from, or -1 if 'worker' has
+  // no runs. Must be called under 'worker.mutex'.
+  int32_t pickLevelLocked(const Worker& worker) const;
+
+  // Takes a run from the queue of the thread 'index'. Steals from the back of
+  // 'index' if 'steal' is true.
+  std::optional<Entry> tryTake(int32_t index, bool steal);
+
+  // Waits until there is a queued run or 'this' is stopped. Returns false in
+  // the latter case.
+  bool waitForWork();
+
+  void run(Entry& entry, bool stolen);
+
+  const Options options_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // CPU time of the runs by level, for sharing threads between levels.
+  std::vector<std::atomic<uint64_t>> levelCpuNanos_;
+
+  // Index of the thread which gets the next run enqueued from outside of the
+  // threads of 'this'.
+  std::atomic<uint32_t> nextWorker_{0};
+
+  // Guards 'numQueued_' updates together with the wait of idle threads on
+  // 'idleCv_' so that no enqueue is missed.
+  std::mutex idleMutex_;
+  std::condition_variable idleCv_;
+  std::atomic<int64_t> numQueued_{0};
+  bool stopped_{false};
+
+  std::atomic<uint64_t> numRuns_{0};
+  std::atomic<uint64_t> numStolen_{0};
+  std::atomic<uint64_t> queueTimeNanos_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverTimeline.h"
+
+#include <folly/json.h>
+#include <folly/system/ThreadId.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <set>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ThreadLocalRegistry.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/TaskStats.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+struct Ring {
+  static_assert(
+      (DriverTimeline::kCapacity & (DriverTimeline::kCapacity - 1)) == 0);
+
+  Ring() {
+    memset(events, 0, sizeof(events));
+  }
+
+  DriverTimeline::Event events[DriverTimeline::kCapacity];
+  int32_t index{0};
+};
+
+auto registry = std::make_shared<process::ThreadLocalRegistry<Ring>>();
+
+thread_local process::ThreadLocalRegistry<Ring>::Reference ring(registry);
+
+std::atomic<uint64_t> nextTimelineId{1};
+
+std::string eventName(
+    const DriverTimeline::Event& event,
+    const TaskStats& stats) {
+  switch (event.type) {
+    case DriverTimeline::EventType::kRun:
+      return "Run";
+    case DriverTimeline::EventType::kQueued:
+      return "Queued";
+    case DriverTimeline::EventType::kBlocked:
+      return fmt::format(
+          "Blocked {}",
+          blockingReasonToString(static_cast<BlockingReason>(event.code)));
+    case DriverTimeline::EventType::kOperatorCall:
+      if (event.pipelineId < stats.pipelineStats.size() &&
+          event.operatorId <
+              stats.pipelineStats[event.pipelineId].operatorStats.size()) {
+        const auto& operatorStats =
+            stats.pipelineStats[event.pipelineId]
+                .operatorStats[event.operatorId];
+        return fmt::format(
+            "{} {}::{}",
+            operatorStats.operatorType,
+            operatorStats.planNodeId,
+            event.method);
+      }
+      return fmt::format("Operator {}::{}", event.operatorId, event.method);
+  }
+  VELOX_UNREACHABLE();
+}
+
+const char* categoryName(DriverTimeline::EventType type) {
+  switch (type) {
+    case DriverTimeline::EventType::kRun:
+      return "run";
+    case DriverTimeline::EventType::kQueued:
+      return "queued";
+    case DriverTimeline::EventType::kBlocked:
+      return "blocked";
+    case DriverTimeline::EventType::kOperatorCall:
+      return "operator";
+  }
+  VELOX_UNREACHABLE();
+}
+
+folly::dynamic metadataEvent(
+    const char* name,
+    int32_t pid,
+    int32_t tid,
+    const std::string& value) {
+  folly::dynamic event = folly::dynamic::object;
+  event["name"] = name;
+  event["ph"] = "M";
+  event["pid"] = pid;
+  event["tid"] = tid;
+  event["args"] = folly::dynamic::object("name", value);
+  return event;
+}
+
+} // namespace
+
+// static
+uint64_t DriverTimeline::newTimelineId() {
+  return nextTimelineId++;
+}
+
+// static
+void DriverTimeline::record(const Event& event) {
+  ring.withValue([&](Ring& ring) {
+    ring.events[ring.index] = event;
+    ring.events[ring.index].osTid = folly::getOSThreadID();
+    ring.index = (ring.index + 1) & (kCapacity - 1);
+  });
+}
+
+// static
+std::vector<DriverTimeline::Event> DriverTimeline::events(
+    uint64_t timelineId) {
+  std::vector<Event> result;
+  if (timelineId == 0) {
+    return result;
+  }
+  registry->forAllValues([&](Ring& ring) {
+    for (const auto& event : ring.events) {
+      if (event.timelineId == timelineId) {
+        result.push_back(event);
+      }
+    }
+  });
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.startMicros < b.startMicros;
+  });
+  return result;
+}
+
+// static
+std::string DriverTimeline::toChromeTrace(
+    uint64_t timelineId,
+    const TaskStats& stats) {
+  const auto timeline = events(timelineId);
+  folly::dynamic traceEvents = folly::dynamic::array;
+  std::set<std::pair<int32_t, int32_t>> drivers;
+  // Times are relative to the first event.
+  const uint64_t baseMicros =
+      timeline.empty() ? 0 : timeline.front().startMicros;
+  for (const auto& event : timeline) {
+    folly::dynamic traceEvent = folly::dynamic::object;
+    traceEvent["name"] = eventName(event, stats);
+    traceEvent["cat"] = categoryName(event.type);
+    traceEvent["ph"] = "X";
+    traceEvent["ts"] = static_cast<int64_t>(event.startMicros - baseMicros);
+    traceEvent["dur"] = static_cast<int64_t>(event.durationMicros);
+    traceEvent["pid"] = event.pipelineId;
+    traceEvent["tid"] = event.driverId;
+    folly::dynamic args = folly::dynamic::object("osTid", event.osTid);
+    if (event.type == EventType::kRun) {
+      args["stopReason"] =
+          stopReasonString(static_cast<StopReason>(event.code));
+    }
+    traceEvent["args"] = std::move(args);
+    traceEvents.push_back(std::move(traceEvent));
+    drivers.emplace(event.pipelineId, event.driverId);
+  }
+  std::set<int32_t> pipelines;
+  for (const auto& [pipelineId, driverId] : drivers) {
+    if (pipelines.insert(pipelineId).second) {
+      traceEvents.push_back(metadataEvent(
+          "process_name",
+          pipelineId,
+          0,
+          fmt::format("Pipeline {}", pipelineId)));
+    }
+    traceEvents.push_back(metadataEvent(
+        "thread_name",
+        pipelineId,
+        driverId,
+        fmt::format("Driver {}", driverId)));
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  return folly::toJson(trace);
+}
+
+DriverTimeline::CallScope::CallScope(
+    uint64_t timelineId,
+    int32_t pipelineId,
+    int32_t driverId,
+    int32_t operatorId,
+    const char* method) {
+  if (timelineId == 0 || strcmp(method, kOpMethodIsBlocked) == 0 ||
+      strcmp(method, kOpMethodNeedsInput) == 0 ||
+      strcmp(method, kOpMethodIsFinished) == 0) {
+    return;
+  }
+  timelineId_ = timelineId;
+  pipelineId_ = pipelineId;
+  driverId_ = driverId;
+  operatorId_ = operatorId;
+  method_ = method;
+  startMicros_ = getCurrentTimeMicro();
+}
+
+DriverTimeline::CallScope::~CallScope() {
+  if (timelineId_ == 0) {
+    return;
+  }
+  Event event{};
+  event.timelineId = timelineId_;
+  event.startMicros = startMicros_;
+  event.durationMicros = getCurrentTimeMicro() - startMicros_;
+  event.method = method_;
+  event.pipelineId = pipelineId_;
+  event.driverId = driverId_;
+  event.operatorId = operatorId_;
+  event.type = EventType::kOperatorCall;
+  record(event);
+}
+
+} // namespace facebook::velox::exec
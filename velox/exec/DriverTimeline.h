@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+struct TaskStats;
+
+/// Records when the drivers of a task run, wait in the executor queue, are
+/// blocked and call their operators, so that pipeline stalls and scheduling
+/// gaps can be seen on a timeline. Enabled by the driver_timeline_enabled
+/// query config.
+///
+/// Like process::TraceHistory, the events are kept in fixed size thread
+/// local ring buffers and the oldest events of a thread are overwritten.
+/// The events of a task are exported in the Chrome trace event format,
+/// which chrome://tracing and Perfetto show.
+class DriverTimeline {
+ public:
+  enum class EventType : uint8_t {
+    // The driver is on thread. 'code' is the StopReason.
+    kRun,
+    // The driver is in the queue of the executor.
+    kQueued,
+    // The driver is off thread waiting for a future. 'code' is the
+    // BlockingReason.
+    kBlocked,
+    // A call of the operator 'operatorId'. 'method' is the method.
+    kOperatorCall,
+  };
+
+  struct Event {
+    // Identifies the task. See newTimelineId().
+    uint64_t timelineId;
+    uint64_t startMicros;
+    uint64_t durationMicros;
+    const char* method;
+    int32_t pipelineId;
+    int32_t driverId;
+    int32_t operatorId;
+    // Thread the event was recorded on.
+    int32_t osTid;
+    EventType type;
+    uint8_t code;
+  };
+
+  /// Events kept per thread. Must be a power of 2.
+  static constexpr int32_t kCapacity = 4096;
+
+  /// Returns a new id for the events of a task. Never 0.
+  static uint64_t newTimelineId();
+
+  static void record(const Event& event);
+
+  /// Returns the events of 'timelineId' in all threads by start time.
+  static std::vector<Event> events(uint64_t timelineId);
+
+  /// Returns the events of 'timelineId' as a Chrome trace. Each driver is a
+  /// thread of the process of its pipeline. Operators are named after the
+  /// operator types in 'stats'.
+  static std::string toChromeTrace(
+      uint64_t timelineId,
+      const TaskStats& stats);
+
+  /// Records the call of an operator method in scope if 'timelineId' is not
+  /// 0. The frequent calls that only check the state of the operator, like
+  /// isBlocked(), are not recorded.
+  class CallScope {
+   public:
+    CallScope(
+        uint64_t timelineId,
+        int32_t pipelineId,
+        int32_t driverId,
+        int32_t operatorId,
+        const char* method);
+
+    ~CallScope();
+
+   private:
+    uint64_t timelineId_{0};
+    int32_t pipelineId_;
+    int32_t driverId_;
+    int32_t operatorId_;
+    const char* method_;
+    uint64_t startMicros_;
+  };
+};
+
+} // namespace facebook::velox::exec
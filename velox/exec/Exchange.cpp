@@ -15,6 +15,7 @@
  */
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/CompactRowSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -114,34 +115,103 @@ RowVectorPtr Exchange::getOutput() {
     return nullptr;
   }
 
+  if (inputStream_ == nullptr && currentPages_.front()->vector() != nullptr) {
+    return nextVectorPage();
+  }
+
+  // Deserializes the pages up to the first in-process page, which is returned
+  // by the next call. Stops early when the result reaches the preferred batch
+  // size. The rest of a partially read page is read by the next call.
+  const bool supportsAppend = getSerde()->supportsAppendInDeserialize();
   uint64_t rawInputBytes{0};
+  uint64_t deserializedBytes{0};
   vector_size_t resultOffset = 0;
-  for (const auto& page : currentPages_) {
-    rawInputBytes += page->size();
-
-    auto inputStream = page->prepareStreamForDeserialize();
+  bool full = false;
+  while (!full && !currentPages_.empty()) {
+    const auto& page = currentPages_.front();
+    if (page->vector() != nullptr) {
+      break;
+    }
+    if (inputStream_ == nullptr) {
+      rawInputBytes += page->size();
+      inputStream_ = std::make_unique<ByteInputStream>(
+          page->prepareStreamForDeserialize());
+    }
 
-    while (!inputStream.atEnd()) {
+    while (!inputStream_->atEnd()) {
+      const auto position = inputStream_->tellp();
       getSerde()->deserialize(
-          &inputStream, pool(), outputType_, &result_, resultOffset, &options_);
+          inputStream_.get(),
+          pool(),
+          outputType_,
+          &result_,
+          resultOffset,
+          &options_);
       resultOffset = result_->size();
+      deserializedBytes += inputStream_->tellp() - position;
+      if (!supportsAppend || resultOffset >= preferredOutputBatchRows_ ||
+          deserializedBytes >= preferredOutputBatchBytes_) {
+        full = true;
+        break;
+      }
     }
-  }
 
-  currentPages_.clear();
+    if (inputStream_->atEnd()) {
+      inputStream_.reset();
+      currentPages_.erase(currentPages_.begin());
+    }
+  }
 
   {
     auto lockedStats = stats_.wlock();
     lockedStats->rawInputBytes += rawInputBytes;
     lockedStats->rawInputPositions += result_->size();
     lockedStats->addInputVector(result_->estimateFlatSize(), result_->size());
+    lockedStats->addRuntimeStat(
+        kDeserializedBatchRows, RuntimeCounter(result_->size()));
+    lockedStats->addRuntimeStat(
+        kDeserializedBatchBytes,
+        RuntimeCounter(deserializedBytes, RuntimeCounter::Unit::kBytes));
   }
 
   return result_;
 }
 
+RowVectorPtr Exchange::nextVectorPage() {
+  auto page = std::move(currentPages_.front());
+  currentPages_.erase(currentPages_.begin());
+  // The vector references memory of the producer, which must stay alive as
+  // long as the consumer may reference the vector.
+  exchangeClient_->retainVectorOwner(page->vectorOwner());
+  auto vector = page->vector();
+  // The producer's column names may differ from the names in the plan of the
+  // consumer.
+  if (vector->type() != outputType_) {
+    VELOX_CHECK(
+        vector->type()->equivalent(*outputType_),
+        "Vector page type {} does not match Exchange output type {}",
+        vector->type()->toString(),
+        outputType_->toString());
+    vector = std::make_shared<RowVector>(
+        pool(),
+        outputType_,
+        vector->nulls(),
+        vector->size(),
+        vector->children());
+  }
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->rawInputBytes += page->size();
+    lockedStats->rawInputPositions += vector->size();
+    lockedStats->addInputVector(page->size(), vector->size());
+    lockedStats->addRuntimeStat("numVectorPages", RuntimeCounter(1));
+  }
+  return vector;
+}
+
 void Exchange::close() {
   SourceOperator::close();
+  inputStream_.reset();
   currentPages_.clear();
   result_ = nullptr;
   if (exchangeClient_) {
@@ -177,7 +247,16 @@ void Exchange::recordExchangeClientStats() {
 }
 
 VectorSerde* Exchange::getSerde() {
+  if (compactRow_) {
+    return compactRowSerde();
+  }
   return getVectorSerde();
 }
 
+// static
+VectorSerde* Exchange::compactRowSerde() {
+  static serializer::CompactRowVectorSerde serde;
+  return &serde;
+}
+
 } // namespace facebook::velox::exec
@@ -51,7 +51,10 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        preferredOutputBatchRows_{
+            driverCtx->queryConfig().preferredOutputBatchRows()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
+        compactRow_{driverCtx->queryConfig().exchangeCompactRow()},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
@@ -61,6 +64,16 @@ class Exchange : public SourceOperator {
     close();
   }
 
+  /// Runtime stat with the number of rows of each batch deserialized from
+  /// the pages.
+  static inline const std::string kDeserializedBatchRows{
+      "deserializedBatchRows"};
+
+  /// Runtime stat with the number of serialized bytes behind each batch
+  /// deserialized from the pages.
+  static inline const std::string kDeserializedBatchBytes{
+      "deserializedBatchBytes"};
+
   RowVectorPtr getOutput() override;
 
   void close() override;
@@ -69,6 +82,10 @@ class Exchange : public SourceOperator {
 
   bool isFinished() override;
 
+  /// Returns the serde for pages written by PartitionedOutput in queries with
+  /// QueryConfig::exchangeCompactRow() set.
+  static VectorSerde* compactRowSerde();
+
  protected:
   virtual VectorSerde* getSerde();
 
@@ -88,15 +105,24 @@ class Exchange : public SourceOperator {
   /// exchangeClient_.
   bool getSplits(ContinueFuture* future);
 
+  /// Returns the vector of the in-process page at the front of
+  /// 'currentPages_' without deserializing it.
+  RowVectorPtr nextVectorPage();
+
   /// Fetches runtime stats from ExchangeClient and replaces these in this
   /// operator's stats.
   void recordExchangeClientStats();
 
   const uint64_t preferredOutputBatchBytes_;
 
+  const vector_size_t preferredOutputBatchRows_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
+
+  /// True if the pages are in the CompactRow format.
+  const bool compactRow_;
   bool noMoreSplits_ = false;
 
   /// A future received from Task::getSplitOrFuture(). It will be complete when
@@ -108,6 +134,12 @@ class Exchange : public SourceOperator {
 
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::vector<std::unique_ptr<SerializedPage>> currentPages_;
+
+  // The stream over the serialized page at the front of 'currentPages_' if
+  // the page is partially deserialized. A page may hold many serialized
+  // batches. These are deserialized a few at a time so that the output stays
+  // within the preferred batch size.
+  std::unique_ptr<ByteInputStream> inputStream_;
   bool atEnd_{false};
   std::default_random_engine rng_{std::random_device{}()};
   serializer::presto::PrestoVectorSerde::PrestoOptions options_;
@@ -50,6 +50,7 @@ void ExchangeClient::addRemoteTaskId(const std::string& taskId) {
       toClose = std::move(source);
     } else {
       sources_.push_back(source);
+      sourceFlows_[source.get()];
       queue_->addSourceLocked();
       emptySources_.push(source);
       requestSpecs = pickSourcesToRequestLocked();
@@ -105,6 +106,22 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
     }
   }
 
+  // Per source flow control stats. Each source adds one value, so that count,
+  // min and max are across the sources.
+  RuntimeMetric waitNanos(RuntimeCounter::Unit::kNanos);
+  RuntimeMetric bytesInFlight(RuntimeCounter::Unit::kBytes);
+  RuntimeMetric requestBytes(RuntimeCounter::Unit::kBytes);
+  for (const auto& [source, flow] : sourceFlows_) {
+    waitNanos.addValue(flow.waitMicros * 1'000);
+    bytesInFlight.addValue(flow.bytesInFlight);
+    requestBytes.addValue(flow.lastRequestBytes);
+  }
+  if (!sourceFlows_.empty()) {
+    stats["sourceWaitForCreditNanos"] = waitNanos;
+    stats["sourceBytesInFlight"] = bytesInFlight;
+    stats["sourceRequestBytes"] = requestBytes;
+  }
+
   stats["peakBytes"] =
       RuntimeMetric(queue_->peakBytes(), RuntimeCounter::Unit::kBytes);
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
@@ -176,6 +193,8 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
             if (self->closed_) {
               return;
             }
+            self->recordResponseLocked(
+                spec.source.get(), spec.maxBytes, response, requestTimeMs);
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
@@ -183,7 +202,8 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
                 }
                 self->producingSources_.push(
                     {std::move(spec.source),
-                     std::move(response.remainingBytes)});
+                     std::move(response.remainingBytes),
+                     getCurrentTimeMicro()});
               } else {
                 self->emptySources_.push(std::move(spec.source));
               }
@@ -214,41 +234,131 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
+  double totalBytesPerMs = 0;
+  int32_t numMeasured = 0;
+  if (availableSpace > 0 && !producingSources_.empty()) {
+    for (const auto& [source, flow] : sourceFlows_) {
+      if (!flow.atEnd && flow.bytesPerMs > 0) {
+        totalBytesPerMs += flow.bytesPerMs;
+        ++numMeasured;
+      }
+    }
+  }
+  const auto nowUs = getCurrentTimeMicro();
   while (availableSpace > 0 && !producingSources_.empty()) {
-    auto& source = producingSources_.front().source;
+    auto& producing = producingSources_.front();
+    const auto maxRequestBytes = std::min(
+        availableSpace,
+        sourceCreditLocked(
+            producing.source.get(), totalBytesPerMs, numMeasured));
     int64_t requestBytes = 0;
-    for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+    for (auto bytes : producing.remainingBytes) {
+      if (requestBytes + bytes > maxRequestBytes) {
         break;
       }
       requestBytes += bytes;
     }
     if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
-      break;
+      // The first page exceeds the credit of the source. Fetch it alone if it
+      // fits in the queue.
+      requestBytes = producing.remainingBytes.at(0);
+      if (requestBytes > availableSpace) {
+        break;
+      }
     }
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
+    availableSpace -= requestBytes;
+    requestSpecs.push_back(
+        requestProducingSourceLocked(producing, requestBytes, nowUs));
     producingSources_.pop();
-    totalPendingBytes_ += requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
     // We have full capacity but still cannot initiate one single data transfer.
     // Let the transfer happen in this case to avoid getting stuck.
-    auto& source = producingSources_.front().source;
-    auto requestBytes = producingSources_.front().remainingBytes.at(0);
+    auto& producing = producingSources_.front();
+    auto requestBytes = producing.remainingBytes.at(0);
     LOG(INFO) << "Requesting large single page " << requestBytes
               << " bytes, exceeding capacity " << maxQueuedBytes_;
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
+    requestSpecs.push_back(
+        requestProducingSourceLocked(producing, requestBytes, nowUs));
     producingSources_.pop();
-    totalPendingBytes_ += requestBytes;
   }
   return requestSpecs;
 }
 
+ExchangeClient::RequestSpec ExchangeClient::requestProducingSourceLocked(
+    ProducingSource& producing,
+    int64_t requestBytes,
+    uint64_t nowUs) {
+  VELOX_CHECK(producing.source->shouldRequestLocked());
+  auto& flow = sourceFlows_[producing.source.get()];
+  if (nowUs > producing.readyTimeUs) {
+    flow.waitMicros += nowUs - producing.readyTimeUs;
+  }
+  flow.bytesInFlight += requestBytes;
+  flow.lastRequestBytes = requestBytes;
+  totalPendingBytes_ += requestBytes;
+  return {std::move(producing.source), requestBytes};
+}
+
+int64_t ExchangeClient::sourceCreditLocked(
+    const ExchangeSource* source,
+    double totalBytesPerMs,
+    int32_t numMeasured) const {
+  const int64_t numSources = std::max<int64_t>(
+      1, static_cast<int64_t>(sourceFlows_.size()) - numSourcesAtEnd_);
+  if (numMeasured == 0) {
+    return std::max<int64_t>(1, maxQueuedBytes_ / numSources);
+  }
+  // A source without a throughput yet is assumed to be as fast as the average
+  // measured source.
+  const auto averageBytesPerMs = totalBytesPerMs / numMeasured;
+  auto it = sourceFlows_.find(source);
+  const auto bytesPerMs = it != sourceFlows_.end() && it->second.bytesPerMs > 0
+      ? it->second.bytesPerMs
+      : averageBytesPerMs;
+  const auto totalEstimate =
+      totalBytesPerMs + averageBytesPerMs * (numSources - numMeasured);
+  const auto evenShare = maxQueuedBytes_ / (2.0 * numSources);
+  const auto throughputShare =
+      maxQueuedBytes_ / 2.0 * std::min(1.0, bytesPerMs / totalEstimate);
+  return std::max<int64_t>(1, evenShare + throughputShare);
+}
+
+void ExchangeClient::recordResponseLocked(
+    const ExchangeSource* source,
+    int64_t requestBytes,
+    const ExchangeSource::Response& response,
+    uint64_t requestTimeMs) {
+  // Weight of the latest response in the moving average of the throughput.
+  constexpr double kNewSampleWeight = 0.3;
+  auto it = sourceFlows_.find(source);
+  if (it == sourceFlows_.end()) {
+    return;
+  }
+  auto& flow = it->second;
+  flow.bytesInFlight -= requestBytes;
+  if (requestBytes > 0 && response.bytes > 0) {
+    const double bytesPerMs = static_cast<double>(response.bytes) /
+        std::max<uint64_t>(1, requestTimeMs);
+    flow.bytesPerMs = flow.bytesPerMs == 0 ? bytesPerMs
+                                           : kNewSampleWeight * bytesPerMs +
+            (1 - kNewSampleWeight) * flow.bytesPerMs;
+  }
+  if (response.atEnd && !flow.atEnd) {
+    flow.atEnd = true;
+    ++numSourcesAtEnd_;
+  }
+}
+
+void ExchangeClient::retainVectorOwner(std::shared_ptr<void> owner) {
+  if (owner == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(queue_->mutex());
+  vectorOwners_.insert(std::move(owner));
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
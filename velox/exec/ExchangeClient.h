@@ -93,6 +93,11 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::vector<std::unique_ptr<SerializedPage>>
   next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future);
 
+  /// Keeps 'owner' of the vector of an in-process page alive for the lifetime
+  /// of 'this', i.e. of the consumer Task, which may reference the vector
+  /// after the page is consumed.
+  void retainVectorOwner(std::shared_ptr<void> owner);
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -109,10 +114,54 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   struct ProducingSource {
     std::shared_ptr<ExchangeSource> source;
     std::vector<int64_t> remainingBytes;
+    // Time when the source reported 'remainingBytes'. The source waits for
+    // credit from then on until it is requested.
+    uint64_t readyTimeUs{0};
+  };
+
+  // Flow control state of a source.
+  struct SourceFlow {
+    // Moving average of the throughput of the data requests to the source, in
+    // bytes per millisecond. 0 until the first data response.
+    double bytesPerMs{0};
+    // Bytes requested from the source and not received yet.
+    int64_t bytesInFlight{0};
+    // Total time the source had data to fetch but was not requested due to
+    // lack of credit.
+    uint64_t waitMicros{0};
+    // Size of the latest data request to the source.
+    int64_t lastRequestBytes{0};
+    bool atEnd{false};
   };
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Makes the request of 'requestBytes' from the source of 'producing' and
+  // updates the flow control state of the source.
+  RequestSpec requestProducingSourceLocked(
+      ProducingSource& producing,
+      int64_t requestBytes,
+      uint64_t nowUs);
+
+  // Returns the maximum number of bytes to request from 'source' at once. Half
+  // of 'maxQueuedBytes_' is divided evenly between the sources that are not at
+  // end, so that a slow source keeps making progress, and the other half in
+  // proportion to the observed throughput of the sources. 'totalBytesPerMs' is
+  // the sum of the throughput of the sources that are not at end and
+  // 'numMeasured' the number of such sources with a throughput.
+  int64_t sourceCreditLocked(
+      const ExchangeSource* source,
+      double totalBytesPerMs,
+      int32_t numMeasured) const;
+
+  // Updates the flow control state of 'source' with the response to a
+  // request of 'requestBytes' which took 'requestTimeMs'.
+  void recordResponseLocked(
+      const ExchangeSource* source,
+      int64_t requestBytes,
+      const ExchangeSource::Response& response,
+      uint64_t requestTimeMs);
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
@@ -135,6 +184,12 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  folly::F14FastMap<const ExchangeSource*, SourceFlow> sourceFlows_;
+
+  // Owners of the vectors of the in-process pages received so far.
+  std::unordered_set<std::shared_ptr<void>> vectorOwners_;
+  int32_t numSourcesAtEnd_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ExchangeQueue.h"
 
+#include "velox/vector/VectorStream.h"
+
 namespace facebook::velox::exec {
 
 SerializedPage::SerializedPage(
@@ -35,16 +37,57 @@ SerializedPage::SerializedPage(
   }
 }
 
+SerializedPage::SerializedPage(
+    RowVectorPtr vector,
+    int64_t bytes,
+    std::shared_ptr<void> owner)
+    : vector_(std::move(vector)),
+      vectorOwner_(std::move(owner)),
+      iobufBytes_(bytes),
+      numRows_(vector_->size()) {
+  VELOX_CHECK_GE(bytes, 0);
+}
+
 SerializedPage::~SerializedPage() {
-  if (onDestructionCb_) {
+  if (onDestructionCb_ && iobuf_ != nullptr) {
     onDestructionCb_(*iobuf_.get());
   }
 }
 
 ByteInputStream SerializedPage::prepareStreamForDeserialize() {
+  if (vector_ != nullptr && iobuf_ == nullptr) {
+    iobuf_ = serializeVector();
+    for (auto& buf : *iobuf_) {
+      int32_t bufSize = buf.size();
+      ranges_.push_back(ByteRange{
+          const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(buf.data())),
+          bufSize,
+          0});
+    }
+  }
   return ByteInputStream(std::move(ranges_));
 }
 
+std::unique_ptr<folly::IOBuf> SerializedPage::getIOBuf() const {
+  if (iobuf_ == nullptr) {
+    return serializeVector();
+  }
+  return iobuf_->clone();
+}
+
+std::unique_ptr<folly::IOBuf> SerializedPage::serializeVector() const {
+  VELOX_CHECK_NOT_NULL(vector_);
+  auto* pool = vector_->pool();
+  VectorStreamGroup group(pool);
+  group.createStreamTree(asRowType(vector_->type()), vector_->size());
+  group.append(vector_);
+  IOBufOutputStream stream(*pool, nullptr, group.size());
+  group.flush(&stream);
+  // The IOBuf references the memory of 'pool', which 'vectorOwner_' keeps
+  // alive.
+  return stream.getIOBuf([owner = vectorOwner_]() {});
+}
+
 void ExchangeQueue::noMoreSources() {
   std::vector<ContinuePromise> promises;
   {
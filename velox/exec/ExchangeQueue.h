@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
 
@@ -29,6 +30,15 @@ class SerializedPage {
       std::function<void(folly::IOBuf&)> onDestructionCb = nullptr,
       std::optional<int64_t> numRows = std::nullopt);
 
+  // Constructs an in-process page that holds 'vector' instead of its
+  // serialized form. 'bytes' is the size accounted for the page. 'owner' keeps
+  // the memory of 'vector' alive, e.g. the producing Task, and is retained by
+  // the consumer as long as the vector may be referenced.
+  SerializedPage(
+      RowVectorPtr vector,
+      int64_t bytes,
+      std::shared_ptr<void> owner);
+
   ~SerializedPage();
 
   // Returns the size of the serialized data in bytes.
@@ -41,14 +51,26 @@ class SerializedPage {
   }
 
   // Makes 'input' ready for deserializing 'this' with
-  // VectorStreamGroup::read().
+  // VectorStreamGroup::read(). An in-process page is serialized first.
   ByteInputStream prepareStreamForDeserialize();
 
-  std::unique_ptr<folly::IOBuf> getIOBuf() const {
-    return iobuf_->clone();
+  // Returns the serialized data. An in-process page is serialized with the
+  // default serde, e.g. when it is sent to another process.
+  std::unique_ptr<folly::IOBuf> getIOBuf() const;
+
+  // Returns the vector of an in-process page, nullptr for a serialized page.
+  const RowVectorPtr& vector() const {
+    return vector_;
+  }
+
+  const std::shared_ptr<void>& vectorOwner() const {
+    return vectorOwner_;
   }
 
  private:
+  // Serializes 'vector_' with the default serde.
+  std::unique_ptr<folly::IOBuf> serializeVector() const;
+
   static int64_t chainBytes(folly::IOBuf& iobuf) {
     int64_t size = 0;
     for (auto& range : iobuf) {
@@ -57,6 +79,10 @@ class SerializedPage {
     return size;
   }
 
+  // Set for an in-process page.
+  const RowVectorPtr vector_;
+  const std::shared_ptr<void> vectorOwner_;
+
   // Buffers containing the serialized data. The memory is owned by 'iobuf_'.
   std::vector<ByteRange> ranges_;
 
@@ -80,7 +80,10 @@ void FilterProject::initialize() {
     isIdentityProjection_ = true;
   }
   numExprs_ = allExprs.size();
-  exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
+  auto folded = operatorCtx_->task()->getOrFoldConstants(
+      planNodeId(), allExprs, operatorCtx_->execCtx());
+  exprs_ = makeExprSetFromFlag(
+      std::vector<core::TypedExprPtr>(*folded), operatorCtx_->execCtx());
 
   if (numExprs_ > 0 && !identityProjections_.empty()) {
     const auto inputType = project_ ? project_->sources()[0]->outputType()
@@ -90,10 +93,24 @@ void FilterProject::initialize() {
       auto fieldIndex = inputType->getChildIdx(field->name());
       distinctFieldIndices.insert(fieldIndex);
     }
+    std::unordered_set<uint32_t> filterFieldIndices;
+    if (hasFilter_) {
+      for (auto field : exprs_->expr(0)->distinctFields()) {
+        filterFieldIndices.insert(inputType->getChildIdx(field->name()));
+      }
+    }
     for (auto identityField : identityProjections_) {
-      if (distinctFieldIndices.find(identityField.inputChannel) !=
-          distinctFieldIndices.end()) {
-        multiplyReferencedFieldIndices_.push_back(identityField.inputChannel);
+      const auto channel = identityField.inputChannel;
+      if (distinctFieldIndices.count(channel) == 0) {
+        continue;
+      }
+      // The filter must see all rows of the fields it references. Fields
+      // referenced only by projections are needed just for the rows that
+      // pass the filter.
+      if (hasFilter_ && filterFieldIndices.count(channel) == 0) {
+        projectedFieldIndices_.push_back(channel);
+      } else {
+        multiplyReferencedFieldIndices_.push_back(channel);
       }
     }
   }
@@ -104,6 +121,37 @@ void FilterProject::initialize() {
 void FilterProject::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   numProcessedInputRows_ = 0;
+  lazyInputChannels_.clear();
+  for (auto i = 0; i < input_->childrenSize(); ++i) {
+    const auto& child = input_->childAt(i);
+    if (child != nullptr && child->encoding() == VectorEncoding::Simple::LAZY &&
+        !child->asUnchecked<LazyVector>()->isLoaded()) {
+      lazyInputChannels_.push_back(i);
+    }
+  }
+}
+
+void FilterProject::recordLazyLoads() {
+  if (lazyInputChannels_.empty()) {
+    return;
+  }
+  const auto& inputType = asRowType(input_->type());
+  auto lockedStats = stats_.wlock();
+  for (auto channel : lazyInputChannels_) {
+    const auto& child = input_->childAt(channel);
+    if (child->encoding() != VectorEncoding::Simple::LAZY ||
+        !child->asUnchecked<LazyVector>()->isLoaded()) {
+      continue;
+    }
+    const auto* lazy = child->asUnchecked<LazyVector>();
+    const auto& name = inputType->nameOf(channel);
+    lockedStats->addRuntimeStat(
+        fmt::format("lazyLoadedRows.{}", name),
+        RuntimeCounter(lazy->numLoadedRows()));
+    lockedStats->addRuntimeStat(
+        fmt::format("lazyInputRows.{}", name), RuntimeCounter(lazy->size()));
+  }
+  lazyInputChannels_.clear();
 }
 
 bool FilterProject::allInputProcessed() {
@@ -121,6 +169,16 @@ bool FilterProject::isFinished() {
   return noMoreInput_ && allInputProcessed();
 }
 
+bool FilterProject::isDeterministic() const {
+  VELOX_CHECK_NOT_NULL(exprs_);
+  for (const auto& expr : exprs_->exprs()) {
+    if (!expr->isDeterministic()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 RowVectorPtr FilterProject::getOutput() {
   if (allInputProcessed()) {
     return nullptr;
@@ -143,7 +201,7 @@ RowVectorPtr FilterProject::getOutput() {
     numProcessedInputRows_ = size;
     VELOX_CHECK(!isIdentityProjection_);
     auto results = project(*rows, evalCtx);
-
+    recordLazyLoads();
     return fillOutput(size, nullptr, results);
   }
 
@@ -151,6 +209,7 @@ RowVectorPtr FilterProject::getOutput() {
   auto numOut = filter(evalCtx, *rows);
   numProcessedInputRows_ = size;
   if (numOut == 0) { // no rows passed the filer
+    recordLazyLoads();
     input_ = nullptr;
     return nullptr;
   }
@@ -163,8 +222,12 @@ RowVectorPtr FilterProject::getOutput() {
     if (!allRowsSelected) {
       rows->setFromBits(filterEvalCtx_.selectedBits->as<uint64_t>(), size);
     }
+    for (auto fieldIdx : projectedFieldIndices_) {
+      evalCtx.ensureFieldLoaded(fieldIdx, *rows);
+    }
     results = project(*rows, evalCtx);
   }
+  recordLazyLoads();
 
   return fillOutput(
       numOut,
@@ -37,6 +37,10 @@ class FilterProject : public Operator {
     return true;
   }
 
+  bool preservesRowCount() const override {
+    return !hasFilter_;
+  }
+
   bool needsInput() const override {
     return !input_;
   }
@@ -73,6 +77,10 @@ class FilterProject : public Operator {
 
   void initialize() override;
 
+  /// Returns true if the filter and the projections are deterministic. Must be
+  /// called after initialize().
+  bool isDeterministic() const;
+
  private:
   // Tests if 'numProcessedRows_' equals to the length of input_ and clears
   // outstanding references to input_ if done. Returns true if getOutput
@@ -92,6 +100,10 @@ class FilterProject : public Operator {
       const SelectivityVector& rows,
       EvalCtx& evalCtx);
 
+  // Adds runtime stats with the number of rows loaded for each column in
+  // 'lazyInputChannels_' that got loaded while processing 'input_'.
+  void recordLazyLoads();
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
 
@@ -117,5 +129,13 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Subset of 'multiplyReferencedFieldIndices_' not referenced by the filter.
+  // These are loaded after the filter, only for the rows that passed it.
+  std::vector<column_index_t> projectedFieldIndices_;
+
+  // Input channels that were unloaded LazyVectors when the current input was
+  // received. Used to report rows loaded versus input rows per column.
+  std::vector<column_index_t> lazyInputChannels_;
 };
 } // namespace facebook::velox::exec
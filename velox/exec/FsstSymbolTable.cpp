@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/FsstSymbolTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::exec {
+namespace {
+constexpr size_t kMaxSampleBytes = 16 << 10;
+
+// The number of times the table is refined over the sample.
+constexpr int32_t kNumGenerations = 5;
+
+uint64_t loadBytes(const char* data, int32_t length) {
+  uint64_t bytes = 0;
+  memcpy(&bytes, data, length);
+  return bytes;
+}
+
+const char* symbolData(const uint64_t& bytes) {
+  return reinterpret_cast<const char*>(&bytes);
+}
+} // namespace
+
+void FsstSymbolTable::addSymbol(Symbol symbol) {
+  codesByFirstByte_[static_cast<uint8_t>(symbolData(symbol.bytes)[0])]
+      .push_back(symbols_.size());
+  symbols_.push_back(symbol);
+}
+
+void FsstSymbolTable::finalize() {
+  for (auto& codes : codesByFirstByte_) {
+    std::sort(codes.begin(), codes.end(), [&](uint8_t left, uint8_t right) {
+      return symbols_[left].length > symbols_[right].length;
+    });
+  }
+}
+
+uint8_t FsstSymbolTable::findLongest(const char* data, size_t size) const {
+  for (auto code : codesByFirstByte_[static_cast<uint8_t>(data[0])]) {
+    const auto& symbol = symbols_[code];
+    if (symbol.length <= size &&
+        memcmp(symbolData(symbol.bytes), data, symbol.length) == 0) {
+      return code;
+    }
+  }
+  return kEscape;
+}
+
+// static
+std::shared_ptr<const FsstSymbolTable> FsstSymbolTable::build(
+    const std::vector<std::string_view>& sample) {
+  std::vector<std::string_view> strings;
+  size_t sampleBytes = 0;
+  for (const auto& string : sample) {
+    if (sampleBytes >= kMaxSampleBytes) {
+      break;
+    }
+    strings.push_back(string);
+    sampleBytes += string.size();
+  }
+
+  std::shared_ptr<FsstSymbolTable> table(new FsstSymbolTable());
+  for (auto generation = 0; generation < kNumGenerations; ++generation) {
+    // The gain of a candidate symbol is the number of sample bytes it would
+    // cover. Candidates are the symbols and escaped bytes of the current
+    // compression and the concatenations of adjacent pairs of these.
+    std::array<folly::F14FastMap<uint64_t, uint64_t>, kMaxSymbolLength + 1>
+        gains;
+    for (const auto& string : strings) {
+      const char* data = string.data();
+      size_t position = 0;
+      Symbol previous{0, 0};
+      while (position < string.size()) {
+        const auto code =
+            table->findLongest(data + position, string.size() - position);
+        const Symbol current = code == kEscape
+            ? Symbol{loadBytes(data + position, 1), 1}
+            : table->symbols_[code];
+        gains[current.length][current.bytes] += current.length;
+        if (current.length > 1) {
+          gains[1][loadBytes(data + position, 1)] += 1;
+        }
+        const auto pairLength = previous.length + current.length;
+        if (previous.length > 0 && pairLength <= kMaxSymbolLength) {
+          gains[pairLength][loadBytes(
+              data + position - previous.length, pairLength)] += pairLength;
+        }
+        previous = current;
+        position += current.length;
+      }
+    }
+
+    struct Candidate {
+      uint64_t gain;
+      Symbol symbol;
+    };
+    std::vector<Candidate> candidates;
+    for (auto length = 1; length <= kMaxSymbolLength; ++length) {
+      for (const auto& [bytes, gain] : gains[length]) {
+        candidates.push_back({gain, {bytes, static_cast<uint8_t>(length)}});
+      }
+    }
+    const auto numSymbols =
+        std::min<size_t>(candidates.size(), kMaxSymbols);
+    std::partial_sort(
+        candidates.begin(),
+        candidates.begin() + numSymbols,
+        candidates.end(),
+        [](const Candidate& left, const Candidate& right) {
+          if (left.gain != right.gain) {
+            return left.gain > right.gain;
+          }
+          if (left.symbol.length != right.symbol.length) {
+            return left.symbol.length > right.symbol.length;
+          }
+          return left.symbol.bytes < right.symbol.bytes;
+        });
+
+    table.reset(new FsstSymbolTable());
+    for (auto i = 0; i < numSymbols; ++i) {
+      table->addSymbol(candidates[i].symbol);
+    }
+    table->finalize();
+  }
+  return table;
+}
+
+void FsstSymbolTable::compress(std::string_view input, std::string& out)
+    const {
+  size_t position = 0;
+  while (position < input.size()) {
+    const auto code =
+        findLongest(input.data() + position, input.size() - position);
+    out.push_back(static_cast<char>(code));
+    if (code == kEscape) {
+      out.push_back(input[position]);
+      ++position;
+    } else {
+      position += symbols_[code].length;
+    }
+  }
+}
+
+void FsstSymbolTable::decompress(std::string_view input, std::string& out)
+    const {
+  for (size_t i = 0; i < input.size(); ++i) {
+    const auto code = static_cast<uint8_t>(input[i]);
+    if (code == kEscape) {
+      out.push_back(input[++i]);
+    } else {
+      const auto& symbol = symbols_[code];
+      out.append(symbolData(symbol.bytes), symbol.length);
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Symbol table for compressing short strings in the style of FSST (Fast
+/// Static Symbol Table, Boncz et al., VLDB 2020). The table has up to 255
+/// symbols of 1 to 8 bytes each. A compressed string is a sequence of one
+/// byte codes. Code 255 escapes a byte that is not covered by a symbol and is
+/// followed by that byte. Strings are compressed one by one, so that each can
+/// be decompressed without its neighbors.
+///
+/// The compression is greedy and deterministic. Two strings compressed with
+/// the same table are equal if and only if their compressed forms are equal.
+class FsstSymbolTable {
+ public:
+  static constexpr int32_t kMaxSymbolLength = 8;
+  static constexpr int32_t kMaxSymbols = 255;
+  static constexpr uint8_t kEscape = 255;
+
+  /// Builds a table from 'sample'. Only the first strings of 'sample' with a
+  /// total of up to 16KB are looked at.
+  static std::shared_ptr<const FsstSymbolTable> build(
+      const std::vector<std::string_view>& sample);
+
+  /// Appends the compressed form of 'input' to 'out'.
+  void compress(std::string_view input, std::string& out) const;
+
+  /// Appends the decompressed form of 'input' to 'out'.
+  void decompress(std::string_view input, std::string& out) const;
+
+  int32_t numSymbols() const {
+    return symbols_.size();
+  }
+
+ private:
+  struct Symbol {
+    // The bytes of the symbol followed by zeros.
+    uint64_t bytes;
+    uint8_t length;
+  };
+
+  FsstSymbolTable() = default;
+
+  void addSymbol(Symbol symbol);
+
+  // Sorts the codes in 'codesByFirstByte_' longest symbol first.
+  void finalize();
+
+  // Returns the code of the longest symbol that prefixes 'data' or kEscape if
+  // there is none.
+  uint8_t findLongest(const char* data, size_t size) const;
+
+  std::vector<Symbol> symbols_;
+
+  // Codes of the symbols by their first byte.
+  std::array<std::vector<uint8_t>, 256> codesByFirstByte_;
+};
+
+} // namespace facebook::velox::exec
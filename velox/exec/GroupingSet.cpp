@@ -38,6 +38,28 @@ bool areAllLazyNotLoaded(const std::vector<VectorPtr>& vectors) {
   });
 }
 
+// Returns true if the accumulator of 'aggregate' is a fixed-width value that
+// does not reference memory outside of itself, so that it can be stored
+// outside of the group rows.
+bool canUseColumnarAccumulator(const AggregateInfo& aggregate) {
+  const auto& function = *aggregate.function;
+  if (aggregate.distinct || !aggregate.sortingKeys.empty() ||
+      !function.isFixedSize() || function.accumulatorUsesExternalMemory() ||
+      !function.resultType()->isFixedWidth()) {
+    return false;
+  }
+  const auto& intermediateType = aggregate.intermediateType;
+  if (intermediateType->kind() != TypeKind::ROW) {
+    return intermediateType->isFixedWidth();
+  }
+  for (auto i = 0; i < intermediateType->size(); ++i) {
+    if (!intermediateType->childAt(i)->isFixedWidth()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
 GroupingSet::GroupingSet(
@@ -70,6 +92,8 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
+      growthEstimationBatches_(
+          queryConfig_.hashTableGrowthEstimationBatches()),
       pool_(*operatorCtx->pool()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
@@ -108,6 +132,48 @@ GroupingSet::GroupingSet(
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  setupColumnarAccumulators();
+}
+
+void GroupingSet::setupColumnarAccumulators() {
+  const auto minAggregates = queryConfig_.columnarAccumulatorsMinAggregates();
+  // Spilling and the sorted and distinct aggregations address accumulators by
+  // group row.
+  if (minAggregates <= 0 || isGlobal_ || spillConfig_ != nullptr ||
+      sortedAggregations_ != nullptr) {
+    return;
+  }
+  std::vector<column_index_t> candidates;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (distinctAggregations_[i] != nullptr) {
+      return;
+    }
+    if (canUseColumnarAccumulator(aggregates_[i])) {
+      candidates.push_back(i);
+    }
+  }
+  if (candidates.size() < minAggregates) {
+    return;
+  }
+
+  columnarIndex_.resize(aggregates_.size(), -1);
+  for (auto i : candidates) {
+    const auto& function = *aggregates_[i].function;
+    const int32_t fixedSize = function.accumulatorFixedWidthSize();
+    // The null and initialized flags are in the first byte. The accumulator
+    // follows at its natural alignment.
+    const int32_t alignment = std::max<int32_t>(
+        function.accumulatorAlignmentSize(),
+        std::min<int32_t>(bits::nextPowerOfTwo(fixedSize), sizeof(int64_t)));
+    const int32_t offset = bits::roundUp(1, alignment);
+    columnarIndex_[i] = columnarAccumulators_.size();
+    columnarAccumulators_.push_back(
+        {i,
+         offset,
+         static_cast<int32_t>(bits::roundUp(offset + fixedSize, alignment)),
+         nullptr});
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -237,7 +303,11 @@ void GroupingSet::addInputForActiveRows(
   }
 
   table_->groupProbe(*lookup_);
+  updateGrowthFactor(lookup_->rows.size());
   masks_.addInput(input, activeRows_);
+  if (!columnarAccumulators_.empty()) {
+    prepareColumnarInput();
+  }
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
@@ -261,8 +331,11 @@ void GroupingSet::addInputForActiveRows(
     }
 
     auto& function = aggregates_[i].function;
+    auto* aggregateGroups = (!columnarIndex_.empty() && columnarIndex_[i] >= 0)
+        ? columnarGroupsForInput(columnarIndex_[i])
+        : groups;
     if (!newGroups.empty()) {
-      function->initializeNewGroups(groups, newGroups);
+      function->initializeNewGroups(aggregateGroups, newGroups);
     }
 
     // Check is mask is false for all rows.
@@ -277,9 +350,10 @@ void GroupingSet::addInputForActiveRows(
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      function->addRawInput(aggregateGroups, rows, tempVectors_, canPushdown);
     } else {
-      function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
+      function->addIntermediateResults(
+          aggregateGroups, rows, tempVectors_, canPushdown);
     }
   }
   tempVectors_.clear();
@@ -304,17 +378,24 @@ void GroupingSet::addRemainingInput() {
 
 namespace {
 
+// Sets the offsets of 'aggregates' to their columns in 'rows'. Aggregates with
+// a non-negative entry in 'columnarIndex' have no column in 'rows' and are
+// skipped.
 void initializeAggregates(
     const std::vector<AggregateInfo>& aggregates,
     RowContainer& rows,
-    bool excludeToIntermediate) {
+    bool excludeToIntermediate,
+    const std::vector<int32_t>& columnarIndex = {}) {
   const auto numKeys = rows.keyTypes().size();
   int i = 0;
-  for (auto& aggregate : aggregates) {
-    auto& function = aggregate.function;
+  for (auto index = 0; index < aggregates.size(); ++index) {
+    auto& function = aggregates[index].function;
     if (excludeToIntermediate && function->supportsToIntermediate()) {
       continue;
     }
+    if (!columnarIndex.empty() && columnarIndex[index] >= 0) {
+      continue;
+    }
     function->setAllocator(&rows.stringAllocator());
 
     const auto rowColumn = rows.columnAt(numKeys + i);
@@ -330,10 +411,16 @@ void initializeAggregates(
 }
 } // namespace
 
-std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
+std::vector<Accumulator> GroupingSet::accumulators(
+    bool excludeToIntermediate,
+    bool excludeColumnar) {
   std::vector<Accumulator> accumulators;
   accumulators.reserve(aggregates_.size());
-  for (auto& aggregate : aggregates_) {
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    auto& aggregate = aggregates_[i];
+    if (excludeColumnar && !columnarIndex_.empty() && columnarIndex_[i] >= 0) {
+      continue;
+    }
     if (!excludeToIntermediate ||
         !aggregate.function->supportsToIntermediate()) {
       accumulators.push_back(
@@ -350,22 +437,56 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
       accumulators.push_back(aggregation->accumulator());
     }
   }
+
+  if (excludeColumnar && !columnarAccumulators_.empty()) {
+    // The ordinal of the group, i.e. its slot in 'columnarAccumulators_'.
+    accumulators.push_back(Accumulator{
+        true,
+        sizeof(int32_t),
+        false,
+        alignof(int32_t),
+        INTEGER(),
+        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
+          VELOX_UNREACHABLE("Columnar accumulators do not spill");
+        },
+        [](folly::Range<char**> /*groups*/) {}});
+  }
   return accumulators;
 }
 
+void GroupingSet::updateGrowthFactor(vector_size_t numRows) {
+  // A partial aggregation flushes its table at a memory limit instead.
+  if (isPartial_ || numGrowthEstimationBatches_ >= growthEstimationBatches_) {
+    return;
+  }
+  numGrowthEstimationRows_ += numRows;
+  if (++numGrowthEstimationBatches_ < growthEstimationBatches_) {
+    return;
+  }
+  // If at least half of the rows so far were new groups, the table likely
+  // keeps growing with the input. Growing 4x instead of 2x at a time halves
+  // the number of rehashes and the rows moved by them.
+  constexpr int32_t kFastGrowthFactor = 4;
+  if (table_->numDistinct() * 2 >= numGrowthEstimationRows_) {
+    table_->setGrowthFactor(kFastGrowthFactor);
+  }
+}
+
 void GroupingSet::createHashTable() {
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), accumulators(false, true), &pool_);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), accumulators(false, true), &pool_);
   }
+  table_->setPrefetchGroupSize(queryConfig_.hashTablePrefetchGroupSize());
 
   RowContainer& rows = *table_->rows();
-  initializeAggregates(aggregates_, rows, false);
+  initializeAggregates(aggregates_, rows, false, columnarIndex_);
 
-  auto numColumns = rows.keyTypes().size() + aggregates_.size();
+  auto numColumns = rows.keyTypes().size() + aggregates_.size() -
+      columnarAccumulators_.size();
 
   if (sortedAggregations_) {
     sortedAggregations_->setAllocator(&rows.stringAllocator());
@@ -398,12 +519,90 @@ void GroupingSet::createHashTable() {
     }
   }
 
+  if (!columnarAccumulators_.empty()) {
+    ordinalOffset_ = rows.columnAt(numColumns).offset();
+    for (const auto& columnar : columnarAccumulators_) {
+      auto& function = aggregates_[columnar.aggregateIndex].function;
+      function->setAllocator(&rows.stringAllocator());
+      // A slot has the null flag in bit 0 and the initialized flag in bit 1
+      // of its first byte.
+      function->setOffsets(columnar.offset, 0, 1, 0, 2, 0);
+    }
+  }
+
   lookup_ = std::make_unique<HashLookup>(table_->hashers());
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode();
   }
 }
 
+void GroupingSet::prepareColumnarInput() {
+  auto* groups = lookup_->hits.data();
+  const auto& newGroups = lookup_->newGroups;
+  if (!newGroups.empty()) {
+    // Groups are never erased from 'table_' while accumulators are columnar,
+    // so the ordinals are dense and the new groups are the last ones.
+    const int64_t numGroups = table_->rows()->numRows();
+    const int32_t firstOrdinal = numGroups - newGroups.size();
+    VELOX_DCHECK_GE(firstOrdinal, 0);
+    for (auto i = 0; i < newGroups.size(); ++i) {
+      *reinterpret_cast<int32_t*>(groups[newGroups[i]] + ordinalOffset_) =
+          firstOrdinal + i;
+    }
+    for (auto& columnar : columnarAccumulators_) {
+      const int64_t size = numGroups * columnar.slotSize;
+      if (columnar.slots == nullptr) {
+        columnar.slots = AlignedBuffer::allocate<char>(size, &pool_);
+      } else if (columnar.slots->size() < size) {
+        AlignedBuffer::reallocate<char>(
+            &columnar.slots,
+            std::max<int64_t>(size, 2 * columnar.slots->size()));
+      }
+    }
+  }
+
+  groupOrdinals_.resize(lookup_->hits.size());
+  for (auto row : lookup_->rows) {
+    groupOrdinals_[row] =
+        *reinterpret_cast<const int32_t*>(groups[row] + ordinalOffset_);
+  }
+}
+
+char** GroupingSet::columnarGroupsForInput(int32_t columnarIndex) {
+  const auto& columnar = columnarAccumulators_[columnarIndex];
+  auto* slots = columnar.slots->asMutable<char>();
+  columnarGroups_.resize(lookup_->hits.size());
+  for (auto row : lookup_->rows) {
+    columnarGroups_[row] =
+        slots + static_cast<int64_t>(groupOrdinals_[row]) * columnar.slotSize;
+  }
+  for (auto row : lookup_->newGroups) {
+    ::memset(columnarGroups_[row], 0, columnar.slotSize);
+  }
+  return columnarGroups_.data();
+}
+
+char** GroupingSet::columnarGroupsForRows(
+    int32_t columnarIndex,
+    folly::Range<char**> groups) {
+  const auto& columnar = columnarAccumulators_[columnarIndex];
+  auto* slots = columnar.slots->asMutable<char>();
+  columnarGroups_.resize(groups.size());
+  for (auto i = 0; i < groups.size(); ++i) {
+    const auto ordinal =
+        *reinterpret_cast<const int32_t*>(groups[i] + ordinalOffset_);
+    columnarGroups_[i] =
+        slots + static_cast<int64_t>(ordinal) * columnar.slotSize;
+  }
+  return columnarGroups_.data();
+}
+
+void GroupingSet::freeColumnarAccumulators() {
+  for (auto& columnar : columnarAccumulators_) {
+    columnar.slots.reset();
+  }
+}
+
 void GroupingSet::initializeGlobalAggregation() {
   if (globalAggregationInitialized_) {
     return;
@@ -760,10 +959,11 @@ void GroupingSet::extractGroups(
   }
   RowContainer& rows = *table_->rows();
   auto totalKeys = rows.keyTypes().size();
-  for (int32_t i = 0; i < totalKeys; ++i) {
-    auto keyVector = result->childAt(i);
-    rows.extractColumn(groups.data(), groups.size(), i, keyVector);
-  }
+  std::vector<column_index_t> keyColumns(totalKeys);
+  std::iota(keyColumns.begin(), keyColumns.end(), 0);
+  const std::vector<VectorPtr> keyVectors(
+      result->children().begin(), result->children().begin() + totalKeys);
+  rows.extractColumns(groups.data(), groups.size(), keyColumns, 0, keyVectors);
   for (int32_t i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
@@ -771,11 +971,14 @@ void GroupingSet::extractGroups(
 
     auto& function = aggregates_[i].function;
     auto& aggregateVector = result->childAt(i + totalKeys);
+    auto* aggregateGroups = (!columnarIndex_.empty() && columnarIndex_[i] >= 0)
+        ? columnarGroupsForRows(columnarIndex_[i], groups)
+        : groups.data();
     if (isPartial_) {
       function->extractAccumulators(
-          groups.data(), groups.size(), &aggregateVector);
+          aggregateGroups, groups.size(), &aggregateVector);
     } else {
-      function->extractValues(groups.data(), groups.size(), &aggregateVector);
+      function->extractValues(aggregateGroups, groups.size(), &aggregateVector);
     }
   }
 
@@ -790,9 +993,12 @@ void GroupingSet::extractGroups(
   }
 }
 
-void GroupingSet::resetTable() {
+void GroupingSet::resetTable(bool freeTable) {
   if (table_ != nullptr) {
-    table_->clear();
+    table_->clear(freeTable);
+  }
+  if (freeTable) {
+    freeColumnarAccumulators();
   }
 }
 
@@ -819,7 +1025,13 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
 
 uint64_t GroupingSet::allocatedBytes() const {
   if (table_) {
-    return table_->allocatedBytes();
+    uint64_t columnarBytes = 0;
+    for (const auto& columnar : columnarAccumulators_) {
+      if (columnar.slots != nullptr) {
+        columnarBytes += columnar.slots->capacity();
+      }
+    }
+    return table_->allocatedBytes() + columnarBytes;
   }
 
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
@@ -1074,7 +1286,10 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      spillConfig_->executor);
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -1194,7 +1409,7 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
   }
   vector_size_t zero = 0;
   for (auto& aggregate : aggregates_) {
-    if (!aggregate.sortingKeys.empty()) {
+    if (!aggregate.sortingKeys.empty() || aggregate.distinct) {
       continue;
     }
     aggregate.function->initializeNewGroups(
@@ -1205,6 +1420,14 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     sortedAggregations_->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
+
+  // Also initializes the accumulators of the aggregate functions.
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->initializeNewGroups(
+          &row, folly::Range<const vector_size_t*>(&zero, 1));
+    }
+  }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
@@ -1226,7 +1449,7 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
       continue;
     }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
@@ -1235,12 +1458,34 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
   mergeSelection_.setValid(input.currentIndex(), false);
 
+  // The accumulators of sorted and distinct aggregations follow those of the
+  // aggregate functions in the spilled rows.
+  auto channel = aggregates_.size() + keyChannels_.size();
   if (sortedAggregations_ != nullptr) {
-    const auto& vector =
-        input.current().childAt(aggregates_.size() + keyChannels_.size());
+    const auto& vector = input.current().childAt(channel++);
     sortedAggregations_->addSingleGroupSpillInput(
         row, vector, input.currentIndex());
   }
+
+  // The spilled distinct values of a group are de-duplicated against the
+  // values of the same group from other spill files.
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      const auto& vector = input.current().childAt(channel++);
+      aggregation->addSingleGroupSpillInput(
+          row, vector, input.currentIndex());
+    }
+  }
+}
+
+uint64_t GroupingSet::distinctAggregationSpilledBytes() const {
+  uint64_t bytes = 0;
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      bytes += aggregation->spilledBytes();
+    }
+  }
+  return bytes;
 }
 
 void GroupingSet::abandonPartialAggregation() {
@@ -1266,6 +1511,7 @@ void GroupingSet::abandonPartialAggregation() {
       table_->rows()->stringAllocatorShared());
   initializeAggregates(aggregates_, *intermediateRows_, true);
   table_.reset();
+  freeColumnarAccumulators();
 }
 
 namespace {
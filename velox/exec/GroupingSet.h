@@ -78,8 +78,9 @@ class GroupingSet {
 
   /// Resets the hash table inside the grouping set when partial aggregation
   /// is full or reclaims memory from distinct aggregation after it has received
-  /// all the inputs.
-  void resetTable();
+  /// all the inputs. If 'freeTable' is true, also frees the hash table
+  /// allocation so that the next input starts from a minimal table.
+  void resetTable(bool freeTable = false);
 
   /// Returns true if 'this' should start producing partial
   /// aggregation results. Checks the memory consumption against
@@ -127,6 +128,21 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the estimated bytes of the de-duplicated inputs of aggregations
+  /// over distinct inputs that were spilled so far.
+  uint64_t distinctAggregationSpilledBytes() const;
+
+  /// Returns the estimated bytes of the inputs of aggregations over sorted
+  /// inputs that were spilled so far.
+  uint64_t sortedAggregationSpilledBytes() const {
+    return sortedAggregations_ ? sortedAggregations_->spilledBytes() : 0;
+  }
+
+  /// Returns the allocator for the variable width state of the accumulators.
+  const HashStringAllocator& stringAllocator() const {
+    return stringAllocator_;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -266,8 +282,41 @@ class GroupingSet {
   // Return a list of accumulators for 'aggregates_', plus one more accumulator
   // for 'sortedAggregations_', and one for each 'distinctAggregations_'.  When
   // 'excludeToIntermediate' is true, skip the functions that support
-  // 'toIntermediate'.
-  std::vector<Accumulator> accumulators(bool excludeToIntermediate);
+  // 'toIntermediate'. When 'excludeColumnar' is true, skip the functions in
+  // 'columnarAccumulators_' and add a trailing accumulator for the group
+  // ordinal instead.
+  std::vector<Accumulator> accumulators(
+      bool excludeToIntermediate,
+      bool excludeColumnar = false);
+
+  // Counts the 'numRows' probed rows of an input batch. After the first
+  // 'growthEstimationBatches_' batches, makes 'table_' grow faster if most of
+  // the rows so far were new groups.
+  void updateGrowthFactor(vector_size_t numRows);
+
+  // Decides which aggregates keep their accumulators in
+  // 'columnarAccumulators_'. Called from the constructor.
+  void setupColumnarAccumulators();
+
+  // Assigns ordinals to the new groups of the last group probe, grows the
+  // columnar accumulators to fit and fills 'groupOrdinals_' for the probed
+  // rows.
+  void prepareColumnarInput();
+
+  // Returns pointers to the slots of the accumulator at 'columnarIndex' in
+  // 'columnarAccumulators_' for the groups of the last group probe. The
+  // pointers are at the same positions as in 'lookup_->hits'. Slots of new
+  // groups are zeroed.
+  char** columnarGroupsForInput(int32_t columnarIndex);
+
+  // Returns pointers to the slots of the accumulator at 'columnarIndex' in
+  // 'columnarAccumulators_' for 'groups', which are rows of 'table_'.
+  char** columnarGroupsForRows(
+      int32_t columnarIndex,
+      folly::Range<char**> groups);
+
+  // Frees the memory of the columnar accumulators.
+  void freeColumnarAccumulators();
 
   std::vector<column_index_t> keyChannels_;
 
@@ -285,6 +334,34 @@ class GroupingSet {
   std::unique_ptr<SortedAggregations> sortedAggregations_;
   std::vector<std::unique_ptr<DistinctAggregations>> distinctAggregations_;
 
+  // Column-major storage for the accumulator of one fixed-width aggregate.
+  // Slot 'i' holds the null and initialized flags and the accumulator of the
+  // group with ordinal 'i' in 'table_'. The aggregate sees a slot as if it
+  // were a group row.
+  struct ColumnarAccumulator {
+    // Index of the aggregate in 'aggregates_'.
+    column_index_t aggregateIndex;
+    // Offset of the accumulator within a slot.
+    int32_t offset;
+    // Bytes per slot.
+    int32_t slotSize;
+    BufferPtr slots;
+  };
+
+  std::vector<ColumnarAccumulator> columnarAccumulators_;
+  // For each aggregate, the index in 'columnarAccumulators_' or -1 if the
+  // accumulator is in the group rows.
+  std::vector<int32_t> columnarIndex_;
+  // Offset of the int32_t group ordinal in the rows of 'table_'. Only set if
+  // 'columnarAccumulators_' is not empty.
+  int32_t ordinalOffset_{-1};
+  // Ordinals of the groups for the current input rows, indexed like
+  // 'lookup_->hits'.
+  raw_vector<int32_t> groupOrdinals_;
+  // Slot pointers for one columnar aggregate. Indexed like 'lookup_->hits'
+  // for input and from 0 for output.
+  raw_vector<char*> columnarGroups_;
+
   const bool ignoreNullKeys_;
 
   uint64_t numInputRows_ = 0;
@@ -317,6 +394,11 @@ class GroupingSet {
   HashStringAllocator stringAllocator_;
   memory::AllocationPool rows_;
   const bool isAdaptive_;
+  // See QueryConfig::kHashTableGrowthEstimationBatches.
+  const int32_t growthEstimationBatches_;
+  // Number of batches and probed rows seen by updateGrowthFactor().
+  int32_t numGrowthEstimationBatches_{0};
+  uint64_t numGrowthEstimationRows_{0};
 
   bool noMoreInput_{false};
 
@@ -14,11 +14,45 @@
  * limitations under the License.
  */
 #include "velox/exec/HashAggregation.h"
+#include <deque>
 #include <optional>
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/SharedAggregationTable.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns true if the Drivers of 'aggregationNode' can share one hash table.
+// See QueryConfig::kConcurrentAggregationEnabled. The aggregates over distinct
+// or sorted inputs and the lambdas of the aggregates use state outside of the
+// GroupingSet that is not safe to share.
+bool canShareTable(
+    const core::AggregationNode& aggregationNode,
+    const core::QueryConfig& queryConfig,
+    bool canSpill) {
+  if (!queryConfig.concurrentAggregationEnabled() || canSpill ||
+      isPartialOutput(aggregationNode.step()) ||
+      aggregationNode.groupingKeys().empty() ||
+      aggregationNode.aggregates().empty() ||
+      !aggregationNode.preGroupedKeys().empty() ||
+      !aggregationNode.globalGroupingSets().empty() ||
+      aggregationNode.groupId().has_value()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregationNode.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (dynamic_cast<const core::LambdaTypedExpr*>(input.get()) != nullptr) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
 
 HashAggregation::HashAggregation(
     int32_t operatorId,
@@ -45,6 +79,8 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      streamingPartialAggregationMemory_(
+          driverCtx->queryConfig().streamingPartialAggregationMemory()),
       maxPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
 
@@ -94,6 +130,17 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
+  const auto numDrivers = operatorCtx_->task()->numDrivers(driver());
+  if (numDrivers > 1 &&
+      canShareTable(
+          *aggregationNode_,
+          operatorCtx_->driverCtx()->queryConfig(),
+          canSpill())) {
+    initializeSharedTable(inputType, numDrivers);
+    aggregationNode_.reset();
+    return;
+  }
+
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
@@ -109,9 +156,143 @@ void HashAggregation::initialize() {
       operatorCtx_.get(),
       &spillStats_);
 
+  maybeEnableSplitResultCache();
   aggregationNode_.reset();
 }
 
+void HashAggregation::maybeEnableSplitResultCache() {
+  auto* cache = SplitResultCache::getInstance();
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (cache == nullptr || !queryConfig.splitResultCacheEnabled() ||
+      aggregationNode_->step() != core::AggregationNode::Step::kPartial ||
+      isGlobal_ || isDistinct_ || canSpill() ||
+      !aggregationNode_->preGroupedKeys().empty() ||
+      !aggregationNode_->globalGroupingSets().empty() ||
+      aggregationNode_->groupId().has_value()) {
+    return;
+  }
+  for (const auto& aggregate : aggregationNode_->aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return;
+    }
+  }
+  if (operatorCtx_->driver()->pushdownSplitResultConsumer(
+          this,
+          this,
+          SplitResultCache::fragmentKey(*aggregationNode_, queryConfig))) {
+    splitResultCache_ = cache;
+  }
+}
+
+void HashAggregation::startSplit(std::optional<std::string> key) {
+  VELOX_CHECK_NOT_NULL(splitResultCache_);
+  if (splitEndPending_) {
+    // The split of 'nextSplitKey_' had no rows that passed the filters, else
+    // these would wait for the flush in front of this operator.
+    if (nextSplitKey_.has_value()) {
+      splitResultCache_->insert(
+          nextSplitKey_.value(), std::make_shared<SplitResult>());
+    }
+    nextSplitKey_ = std::move(key);
+    return;
+  }
+  nextSplitKey_ = std::move(key);
+  const bool hasSplitRows =
+      abandonedPartialAggregation_ ? input_ != nullptr : numInputRows_ > 0;
+  if (!hasSplitRows) {
+    finishSplitResult();
+    return;
+  }
+  // The rows of the next split wait until the groups of the current split are
+  // flushed.
+  splitEndPending_ = true;
+  if (!abandonedPartialAggregation_) {
+    partialFull_ = true;
+  }
+}
+
+void HashAggregation::replaySplit(std::shared_ptr<const SplitResult> result) {
+  replayResults_.push_back(std::move(result));
+}
+
+void HashAggregation::addSplitResult(const RowVectorPtr& output) {
+  if (splitResult_ == nullptr) {
+    return;
+  }
+  splitResult_->batches.push_back(splitResultCache_->serialize(output, pool()));
+  splitResult_->bytes += splitResult_->batches.back().size();
+  if (splitResult_->bytes > splitResultCache_->maxEntryBytes()) {
+    splitResult_ = nullptr;
+  }
+}
+
+void HashAggregation::finishSplitResult() {
+  if (splitResult_ != nullptr) {
+    splitResultCache_->insert(splitKey_.value(), std::move(splitResult_));
+  }
+  splitKey_ = std::move(nextSplitKey_);
+  nextSplitKey_.reset();
+  splitResult_ =
+      splitKey_.has_value() ? std::make_shared<SplitResult>() : nullptr;
+  splitEndPending_ = false;
+}
+
+RowVectorPtr HashAggregation::getReplayOutput() {
+  while (!replayResults_.empty()) {
+    const auto& batches = replayResults_.front()->batches;
+    if (replayBatchIndex_ < batches.size()) {
+      return splitResultCache_->deserialize(
+          batches[replayBatchIndex_++], outputType_, pool());
+    }
+    replayResults_.pop_front();
+    replayBatchIndex_ = 0;
+  }
+  return nullptr;
+}
+
+void HashAggregation::initializeSharedTable(
+    const RowTypePtr& inputType,
+    uint32_t numDrivers) {
+  // A few partitions per Driver keep the lock conflicts rare. The partition
+  // bits are the lowest bits of the key hash, which the partition tables
+  // don't use to pick a bucket.
+  constexpr uint32_t kPartitionsPerDriver = 4;
+  constexpr uint32_t kMaxPartitions = 64;
+  const uint32_t numPartitions = std::min<uint32_t>(
+      kMaxPartitions, bits::nextPowerOfTwo(numDrivers * kPartitionsPerDriver));
+  const auto* driverCtx = operatorCtx_->driverCtx();
+  sharedTable_ = operatorCtx_->task()->getSharedAggregationTable(
+      driverCtx->splitGroupId, planNodeId(), numDrivers, numPartitions);
+  sharedTable_->initialize([&]() {
+    auto hashers =
+        createVectorHashers(inputType, aggregationNode_->groupingKeys());
+    const auto numHashers = hashers.size();
+    std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+    return std::make_unique<GroupingSet>(
+        inputType,
+        std::move(hashers),
+        std::vector<column_index_t>{},
+        toAggregateInfo(
+            *aggregationNode_, *operatorCtx_, numHashers, expressionEvaluator),
+        aggregationNode_->ignoreNullKeys(),
+        false,
+        isRawInput(aggregationNode_->step()),
+        std::vector<vector_size_t>{},
+        std::nullopt,
+        nullptr,
+        sharedTable_->nonReclaimableSection(),
+        operatorCtx_.get(),
+        nullptr);
+  });
+
+  std::vector<column_index_t> keyChannels;
+  for (const auto& key : aggregationNode_->groupingKeys()) {
+    keyChannels.push_back(exprToChannel(key.get(), inputType));
+  }
+  partitionFunction_ = std::make_unique<HashPartitionFunction>(
+      sharedTable_->numPartitions(), inputType, keyChannels);
+}
+
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
   VELOX_CHECK(isPartialOutput_ && !isGlobal_);
   return numInputRows_ > abandonPartialAggregationMinRows_ &&
@@ -119,6 +300,10 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
 }
 
 void HashAggregation::addInput(RowVectorPtr input) {
+  if (sharedTable_ != nullptr) {
+    addSharedInput(input);
+    return;
+  }
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
@@ -132,6 +317,7 @@ void HashAggregation::addInput(RowVectorPtr input) {
   numInputRows_ += input->size();
 
   updateRuntimeStats();
+  updateSpillRuntimeStats();
 
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
@@ -160,6 +346,48 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::addSharedInput(const RowVectorPtr& input) {
+  numInputRows_ += input->size();
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  const auto numPartitions = sharedTable_->numPartitions();
+  std::vector<RowVectorPtr> partitionInputs(numPartitions);
+  const auto singlePartition =
+      partitionFunction_->partition(*input, partitions_);
+  if (singlePartition.has_value()) {
+    partitionInputs[singlePartition.value()] = input;
+  } else {
+    const auto numInput = input->size();
+    std::vector<vector_size_t> partitionSizes(numPartitions, 0);
+    for (auto i = 0; i < numInput; ++i) {
+      ++partitionSizes[partitions_[i]];
+    }
+    std::vector<BufferPtr> indices(numPartitions);
+    std::vector<vector_size_t*> rawIndices(numPartitions);
+    for (auto i = 0; i < numPartitions; ++i) {
+      if (partitionSizes[i] > 0) {
+        indices[i] = allocateIndices(partitionSizes[i], pool());
+        rawIndices[i] = indices[i]->asMutable<vector_size_t>();
+      }
+    }
+    std::fill(partitionSizes.begin(), partitionSizes.end(), 0);
+    for (auto i = 0; i < numInput; ++i) {
+      const auto partition = partitions_[i];
+      rawIndices[partition][partitionSizes[partition]++] = i;
+    }
+    for (auto i = 0; i < numPartitions; ++i) {
+      if (partitionSizes[i] > 0) {
+        partitionInputs[i] =
+            wrap(partitionSizes[i], std::move(indices[i]), input);
+      }
+    }
+  }
+  // Drivers start at different partitions to avoid waiting for each other.
+  numLockConflicts_ += sharedTable_->addInput(
+      partitionInputs, operatorCtx_->driverCtx()->driverId);
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -188,6 +416,32 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  runtimeStats[BaseHashTable::kRehashWallNanos] = RuntimeMetric(
+      hashTableStats.rehashNanos, RuntimeCounter::Unit::kNanos);
+
+  const auto& allocator = groupingSet_->stringAllocator();
+  runtimeStats[kAccumulatorFreeBytes] =
+      RuntimeMetric(allocator.freeSpace(), RuntimeCounter::Unit::kBytes);
+  runtimeStats[kAccumulatorFragmentedBytes] = RuntimeMetric(
+      allocator.fragmentedBytes(), RuntimeCounter::Unit::kBytes);
+}
+
+void HashAggregation::updateSpillRuntimeStats() {
+  const auto distinctBytes = groupingSet_->distinctAggregationSpilledBytes();
+  const auto sortedBytes = groupingSet_->sortedAggregationSpilledBytes();
+  if (distinctBytes == 0 && sortedBytes == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  auto& runtimeStats = lockedStats->runtimeStats;
+  if (distinctBytes > 0) {
+    runtimeStats[kDistinctAggregationSpilledBytes] =
+        RuntimeMetric(distinctBytes, RuntimeCounter::Unit::kBytes);
+  }
+  if (sortedBytes > 0) {
+    runtimeStats[kSortedAggregationSpilledBytes] =
+        RuntimeMetric(sortedBytes, RuntimeCounter::Unit::kBytes);
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -215,11 +469,19 @@ void HashAggregation::resetPartialOutputIfNeed() {
     lockedStats->addRuntimeStat("flushTimes", RuntimeCounter(1));
     lockedStats->addRuntimeStat(
         "partialAggregationPct", RuntimeCounter(aggregationPct));
+    if (streamingPartialAggregation_) {
+      lockedStats->addRuntimeStat(
+          "streamingPartialAggregationPct", RuntimeCounter(aggregationPct));
+    }
   }
   groupingSet_->resetTable();
   partialFull_ = false;
   if (!finished_) {
-    maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
+    if (streamingPartialAggregation_) {
+      updateStreamingPartialAggregation();
+    } else {
+      maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
+    }
   }
   numOutputRows_ = 0;
   numInputRows_ = 0;
@@ -236,10 +498,7 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
-    pool()->release();
-    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
-    abandonedPartialAggregation_ = true;
+    abandonOrStreamPartialAggregation();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -263,22 +522,73 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
           maxPartialAggregationMemoryUsage_, RuntimeCounter::Unit::kBytes));
 }
 
+void HashAggregation::abandonOrStreamPartialAggregation() {
+  if (streamingPartialAggregationMemory_ > 0 &&
+      !streamingPartialAggregation_) {
+    // Keep a small table for the frequent keys. The table allocation sized for
+    // the previous limit is freed so that the new one stays cache resident.
+    groupingSet_->resetTable(true);
+    pool()->release();
+    maxPartialAggregationMemoryUsage_ = streamingPartialAggregationMemory_;
+    streamingPartialAggregation_ = true;
+    addRuntimeStat("streamingPartialAggregation", RuntimeCounter(1));
+    return;
+  }
+  groupingSet_->abandonPartialAggregation();
+  pool()->release();
+  addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  abandonedPartialAggregation_ = true;
+}
+
+void HashAggregation::updateStreamingPartialAggregation() {
+  VELOX_DCHECK(streamingPartialAggregation_);
+  numStreamingInputRows_ += numInputRows_;
+  numStreamingOutputRows_ += numOutputRows_;
+  // A cache resident table is cheap to probe, so keep it as long as it removes
+  // some rows. It cannot reach 'abandonPartialAggregationMinPct_' since the
+  // larger table did not.
+  constexpr int32_t kStreamingMaxOutputPct = 90;
+  // Each flush covers few rows, so judge the reduction over all the flushes
+  // since the switch.
+  if (numStreamingInputRows_ > abandonPartialAggregationMinRows_ &&
+      100 * numStreamingOutputRows_ / numStreamingInputRows_ >=
+          kStreamingMaxOutputPct) {
+    abandonOrStreamPartialAggregation();
+  }
+}
+
 RowVectorPtr HashAggregation::getOutput() {
   if (finished_) {
     input_ = nullptr;
     return nullptr;
   }
+  if (sharedTable_ != nullptr) {
+    return getSharedOutput();
+  }
+  if (auto output = getReplayOutput()) {
+    return output;
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
     }
     if (!input_) {
+      if (finished_ && splitResultCache_ != nullptr) {
+        finishSplitResult();
+      }
       return nullptr;
     }
     prepareOutput(input_->size());
     groupingSet_->toIntermediate(input_, output_);
     numOutputRows_ += input_->size();
     input_ = nullptr;
+    addSplitResult(output_);
+    if (splitEndPending_) {
+      finishSplitResult();
+    }
+    if (finished_ && splitResultCache_ != nullptr) {
+      finishSplitResult();
+    }
     return output_;
   }
 
@@ -314,12 +624,49 @@ RowVectorPtr HashAggregation::getOutput() {
       finished_ = true;
     }
     resetPartialOutputIfNeed();
+    if (splitEndPending_) {
+      finishSplitResult();
+    }
+    if (finished_ && splitResultCache_ != nullptr) {
+      // All the groups of the last split are output.
+      finishSplitResult();
+    }
     return nullptr;
   }
   numOutputRows_ += output_->size();
+  addSplitResult(output_);
   return output_;
 }
 
+RowVectorPtr HashAggregation::getSharedOutput() {
+  if (!noMoreInput_ || future_.valid()) {
+    return nullptr;
+  }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  for (;;) {
+    if (outputPartition_ == nullptr) {
+      outputPartition_ = sharedTable_->nextOutputPartition();
+      if (outputPartition_ == nullptr) {
+        finished_ = true;
+        return nullptr;
+      }
+      resultIterator_.reset();
+    }
+    const auto maxOutputRows =
+        outputBatchRows(outputPartition_->estimateOutputRowSize());
+    prepareOutput(maxOutputRows);
+    if (outputPartition_->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            resultIterator_,
+            output_)) {
+      numOutputRows_ += output_->size();
+      return output_;
+    }
+    outputPartition_ = nullptr;
+  }
+}
+
 RowVectorPtr HashAggregation::getDistinctOutput() {
   VELOX_CHECK(isDistinct_);
   VELOX_CHECK(!finished_);
@@ -380,8 +727,17 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (sharedTable_ != nullptr) {
+    addRuntimeStat(
+        kSharedTableLockConflicts, RuntimeCounter(numLockConflicts_));
+    Operator::noMoreInput();
+    // The output starts once all the Drivers have added their input.
+    sharedTable_->noMoreInput(&future_);
+    return;
+  }
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
+  updateSpillRuntimeStats();
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
@@ -428,17 +784,30 @@ void HashAggregation::reclaim(
     // having row container memory compaction support later.
     groupingSet_->spill();
   }
+  updateSpillRuntimeStats();
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
   VELOX_CHECK_EQ(groupingSet_->numDistinct(), 0);
   // Release the minimum reserved memory.
   pool()->release();
 }
 
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForPeerDrivers;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
   groupingSet_.reset();
+  outputPartition_ = nullptr;
+  sharedTable_.reset();
+  splitResult_ = nullptr;
+  replayResults_.clear();
 }
 
 void HashAggregation::updateEstimatedOutputRowSize() {
@@ -16,12 +16,38 @@
 #pragma once
 
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SplitResultCache.h"
 
 namespace facebook::velox::exec {
 
-class HashAggregation : public Operator {
+class SharedAggregationTable;
+
+class HashAggregation : public Operator, public SplitResultConsumer {
  public:
+  /// Runtime stats with the free and the fragmented bytes of the allocator for
+  /// the variable width accumulator state. See
+  /// HashStringAllocator::fragmentedBytes().
+  static inline const std::string kAccumulatorFreeBytes{
+      "accumulatorFreeBytes"};
+  static inline const std::string kAccumulatorFragmentedBytes{
+      "accumulatorFragmentedBytes"};
+
+  /// Runtime stats with the estimated bytes of the de-duplicated inputs of
+  /// aggregations over distinct inputs and of the inputs of aggregations over
+  /// sorted inputs that were spilled.
+  static inline const std::string kDistinctAggregationSpilledBytes{
+      "distinctAggregationSpilledBytes"};
+  static inline const std::string kSortedAggregationSpilledBytes{
+      "sortedAggregationSpilledBytes"};
+
+  /// Runtime stat with the number of times a Driver found a partition of the
+  /// shared hash table locked by another Driver and deferred adding input to
+  /// it. See SharedAggregationTable.
+  static inline const std::string kSharedTableLockConflicts{
+      "sharedTableLockConflicts"};
+
   HashAggregation(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -34,14 +60,13 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ && !splitEndPending_ &&
+        replayResults_.empty();
   }
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -50,9 +75,31 @@ class HashAggregation : public Operator {
 
   void close() override;
 
+  /// Flushes the groups of the previous split before the rows of the split
+  /// with 'key' are added. Called by the TableScan of the pipeline if the
+  /// results are cached per split, see maybeEnableSplitResultCache().
+  void startSplit(std::optional<std::string> key) override;
+
+  /// Outputs the cached 'result' of a split before any other output.
+  void replaySplit(std::shared_ptr<const SplitResult> result) override;
+
  private:
+  // Sets up adding input to and getting output from a hash table shared with
+  // the peer Drivers.
+  void initializeSharedTable(const RowTypePtr& inputType, uint32_t numDrivers);
+
+  // Splits 'input' by the partitions of 'sharedTable_' and adds the pieces.
+  void addSharedInput(const RowVectorPtr& input);
+
+  // Returns the output of the partitions of 'sharedTable_' taken by this
+  // Driver after all the Drivers have finished their input.
+  RowVectorPtr getSharedOutput();
+
   void updateRuntimeStats();
 
+  // Reports the spilled bytes of the distinct and sorted aggregations.
+  void updateSpillRuntimeStats();
+
   void prepareOutput(vector_size_t size);
 
   // Invoked to reset partial aggregation state if it was full and has been
@@ -70,10 +117,36 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Invoked when partial aggregation is not reducing enough. Switches to the
+  // streaming mode if 'streamingPartialAggregationMemory_' is set and the
+  // operator is not streaming already, otherwise abandons partial aggregation.
+  void abandonOrStreamPartialAggregation();
+
+  // Invoked on each flush in the streaming mode. Accumulates the reduction
+  // achieved so far and abandons partial aggregation if more than 90% of the
+  // input rows are flushed as groups.
+  void updateStreamingPartialAggregation();
+
   RowVectorPtr getDistinctOutput();
 
   void updateEstimatedOutputRowSize();
 
+  // Caches the output of this partial aggregation for each split of the
+  // TableScan that feeds it if the query enables it and only deterministic
+  // filters and projections are in between. See SplitResultCache.
+  void maybeEnableSplitResultCache();
+
+  // Adds 'output' to 'splitResult_' if the result of the current split is
+  // being cached.
+  void addSplitResult(const RowVectorPtr& output);
+
+  // Caches the result of the current split and starts the split with
+  // 'nextSplitKey_'.
+  void finishSplitResult();
+
+  // Returns the next batch of 'replayResults_' or nullptr if there is none.
+  RowVectorPtr getReplayOutput();
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
   const bool isPartialOutput_;
@@ -86,6 +159,9 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Hash table size limit in bytes for the streaming partial aggregation mode.
+  // 0 means the mode is disabled.
+  const int64_t streamingPartialAggregationMemory_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -100,6 +176,9 @@ class HashAggregation : public Operator {
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
+  // True if partial aggregation runs with a small table that is flushed every
+  // time it fills up instead of being abandoned.
+  bool streamingPartialAggregation_{false};
 
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
@@ -111,9 +190,41 @@ class HashAggregation : public Operator {
   // Count the number of output rows. It is reset on partial aggregation output
   // flush.
   int64_t numOutputRows_ = 0;
+  // Number of input and output rows since switching to the streaming mode.
+  // Not reset on flush.
+  int64_t numStreamingInputRows_ = 0;
+  int64_t numStreamingOutputRows_ = 0;
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // Set if the Drivers of the pipeline share one hash table instead of one
+  // 'groupingSet_' each. See QueryConfig::kConcurrentAggregationEnabled.
+  std::shared_ptr<SharedAggregationTable> sharedTable_;
+  std::unique_ptr<HashPartitionFunction> partitionFunction_;
+  // Partition of 'sharedTable_' for each row of the input being added.
+  std::vector<uint32_t> partitions_;
+  // The partition of 'sharedTable_' being output by this Driver.
+  GroupingSet* outputPartition_{nullptr};
+  uint64_t numLockConflicts_{0};
+  // Set while waiting for the peer Drivers to finish their input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // Set if the output is cached per split. See maybeEnableSplitResultCache().
+  SplitResultCache* splitResultCache_{nullptr};
+  // The cache key of the split whose rows are being aggregated. Not set if the
+  // split is not cached.
+  std::optional<std::string> splitKey_;
+  // The output for 'splitKey_' so far. Reset if it grows over the max entry
+  // size of 'splitResultCache_'.
+  std::shared_ptr<SplitResult> splitResult_;
+  // True while the groups of 'splitKey_' are flushed before the split with
+  // 'nextSplitKey_' starts.
+  bool splitEndPending_{false};
+  std::optional<std::string> nextSplitKey_;
+  // Cached split results to output and the next batch in the first of these.
+  std::deque<std::shared_ptr<const SplitResult>> replayResults_;
+  size_t replayBatchIndex_{0};
 };
 
 } // namespace facebook::velox::exec
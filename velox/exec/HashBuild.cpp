@@ -26,6 +26,104 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 namespace {
+// Returns a filter passing the non-null values of key 'keyIndex' in
+// 'rowContainers'. This is a Bloom filter over the values together with their
+// range, or only the range if the values cover most of it. Returns nullptr if
+// there are no values or the Bloom filter would take more than 'maxBytes'. The
+// Bloom filter is sized for the distinct values of this key, estimated from
+// the table-wide 'numDistinct' and the number and range of the key's values.
+template <typename T>
+std::shared_ptr<common::Filter> makeJoinKeyFilter(
+    const std::vector<RowContainer*>& rowContainers,
+    int32_t keyIndex,
+    uint64_t numDistinct,
+    uint64_t maxBytes) {
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  // Calls 'func' with each non-null value of the key.
+  const auto forEachValue = [&](auto func) {
+    for (auto* rowContainer : rowContainers) {
+      const auto column = rowContainer->columnAt(keyIndex);
+      RowContainerIterator iter;
+      while (auto numRows =
+                 rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+        for (auto i = 0; i < numRows; ++i) {
+          if (!RowContainer::isNullAt(rows[i], column)) {
+            func(static_cast<int64_t>(
+                RowContainer::valueAt<T>(rows[i], column.offset())));
+          }
+        }
+      }
+    }
+  };
+
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  uint64_t numValues = 0;
+  forEachValue([&](int64_t value) {
+    min = std::min(min, value);
+    max = std::max(max, value);
+    ++numValues;
+  });
+  if (numValues == 0) {
+    return nullptr;
+  }
+
+  // A key has no more distinct values than the table has distinct keys, than
+  // it has non-null values or than fit in its range.
+  const uint64_t rangeSize =
+      static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  uint64_t numKeyDistinct = std::min(numDistinct, numValues);
+  if (rangeSize < numKeyDistinct) {
+    numKeyDistinct = rangeSize + 1;
+  }
+  // BloomFilter::reset() takes 2 bytes per value after rounding up to a power
+  // of 2.
+  if (numKeyDistinct == 0 ||
+      bits::nextPowerOfTwo(numKeyDistinct) / 4 * sizeof(uint64_t) >
+          maxBytes) {
+    return nullptr;
+  }
+  // The range alone rejects nearly as many values as the Bloom filter when
+  // the keys cover at least half of it and is cheaper to evaluate.
+  if (numKeyDistinct >= rangeSize / 2) {
+    return std::make_shared<common::BigintRange>(min, max, false);
+  }
+
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(static_cast<int32_t>(std::min<uint64_t>(
+      numKeyDistinct, std::numeric_limits<int32_t>::max())));
+  std::vector<uint64_t> hashes;
+  hashes.reserve(kBatchSize);
+  forEachValue([&](int64_t value) {
+    hashes.push_back(common::BigintValuesUsingBloomFilter::hash(value));
+    if (hashes.size() == kBatchSize) {
+      bloomFilter->insert(hashes.data(), hashes.size());
+      hashes.clear();
+    }
+  });
+  bloomFilter->insert(hashes.data(), hashes.size());
+  return std::make_shared<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+
+// Returns true if 'joinNode' is listed in
+// QueryConfig::kSharedHashJoinBuildNodeIds and its table can be probed
+// read-only by several Tasks. Joins that spill or set the probed flags of the
+// table rows need a table of their own.
+bool isSharedTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& config,
+    bool canSpill) {
+  if (canSpill || needRightSideJoin(joinNode.joinType())) {
+    return false;
+  }
+  std::vector<core::PlanNodeId> nodeIds;
+  folly::split(',', config.sharedHashJoinBuildNodeIds(), nodeIds, true);
+  return std::find(nodeIds.begin(), nodeIds.end(), joinNode.id()) !=
+      nodeIds.end();
+}
+
 // Map HashBuild 'state' to the corresponding driver blocking reason.
 BlockingReason fromStateToBlockingReason(HashBuild::State state) {
   switch (state) {
@@ -72,6 +170,14 @@ HashBuild::HashBuild(
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
   joinBridge_->addBuilder();
+  if (isSharedTable(*joinNode_, driverCtx->queryConfig(), canSpill())) {
+    buildsSharedTable_ = joinBridge_->attachSharedBuild(fmt::format(
+        "{}/{}/{}",
+        operatorCtx_->task()->queryCtx()->queryId(),
+        planNodeId(),
+        driverCtx->splitGroupId));
+    dropInput_ = !buildsSharedTable_;
+  }
 
   auto inputType = joinNode_->sources()[1]->outputType();
 
@@ -187,6 +293,14 @@ void HashBuild::setupTable() {
           pool());
     }
   }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  table_->setJoinProbePartitionBytes(queryConfig.hashProbeRadixPartitionSize());
+  table_->setPrefetchGroupSize(queryConfig.hashTablePrefetchGroupSize());
+  table_->setPerfectHashMaxRows(queryConfig.hashJoinPerfectHashMaxRows());
+  if (queryConfig.hashBuildHeavyHitterSketchSize() > 0) {
+    heavyHitters_ = std::make_unique<HeavyHitterSketch>(
+        queryConfig.hashBuildHeavyHitterSketchSize());
+  }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -213,7 +327,7 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   uint8_t startPartitionBit = config->startPartitionBit;
   if (spillPartition != nullptr) {
     spillInputReader_ = spillPartition->createUnorderedReader(
-        config->readBufferSize, pool(), &spillStats_);
+        config->readBufferSize, pool(), &spillStats_, config->executor);
     startPartitionBit =
         spillPartition->id().partitionBitOffset() + config->numPartitionBits;
     // Disable spilling if exceeding the max spill level and the query might run
@@ -313,6 +427,10 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (dropInput_) {
+    numDroppedRows_ += input->size();
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -376,6 +494,11 @@ void HashBuild::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (heavyHitters_ != nullptr && !isInputFromSpill() &&
+      activeRows_.hasSelections()) {
+    addToHeavyHitters();
+  }
+
   spillInput(input);
   if (!activeRows_.hasSelections()) {
     return;
@@ -425,11 +548,11 @@ void HashBuild::addInput(RowVectorPtr input) {
   });
 }
 
-void HashBuild::ensureInputFits(RowVectorPtr& input) {
+uint64_t HashBuild::inputReservationBytes(const RowVectorPtr& input) {
   // NOTE: we don't need memory reservation if all the partitions are spilling
   // as we spill all the input rows to disk directly.
   if (!spillEnabled() || spiller_ == nullptr || spiller_->isAllSpilled()) {
-    return;
+    return 0;
   }
 
   // NOTE: we simply reserve memory all inputs even though some of them are
@@ -444,19 +567,8 @@ void HashBuild::ensureInputFits(RowVectorPtr& input) {
   auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
   const auto outOfLineBytes =
       rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
-  const auto outOfLineBytesPerRow =
-      std::max<uint64_t>(1, numRows == 0 ? 0 : outOfLineBytes / numRows);
   const auto currentUsage = pool()->usedBytes();
 
-  if (numRows != 0) {
-    // Test-only spill path.
-    if (testingTriggerSpill(pool()->name())) {
-      Operator::ReclaimableSectionGuard guard(this);
-      memory::testingRunArbitration(pool());
-      return;
-    }
-  }
-
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool()->availableReservation();
@@ -475,23 +587,43 @@ void HashBuild::ensureInputFits(RowVectorPtr& input) {
       // Enough free rows for input rows and enough variable length free
       // space for the flat size of the whole vector. If outOfLineBytes
       // is 0 there is no need for variable length space.
-      return;
+      return 0;
     }
 
     // If there is variable length data we take the flat size of the
     // input as a cap on the new variable length data needed. There must be at
     // least 2x the increments in reservation.
     if (pool()->availableReservation() > 2 * incrementBytes) {
-      return;
+      return 0;
     }
   }
 
   // Check if we can increase reservation. The increment is the larger of
   // twice the maximum increment from this input and
   // 'spillableReservationGrowthPct_' of the current reservation.
-  const auto targetIncrementBytes = std::max<int64_t>(
+  return std::max<int64_t>(
       incrementBytes * 2,
       currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+}
+
+void HashBuild::ensureInputFits(RowVectorPtr& input) {
+  if (!spillEnabled() || spiller_ == nullptr || spiller_->isAllSpilled()) {
+    return;
+  }
+
+  if (table_->rows()->numRows() != 0) {
+    // Test-only spill path.
+    if (testingTriggerSpill(pool()->name())) {
+      Operator::ReclaimableSectionGuard guard(this);
+      memory::testingRunArbitration(pool());
+      return;
+    }
+  }
+
+  const auto targetIncrementBytes = inputReservationBytes(input);
+  if (targetIncrementBytes == 0) {
+    return;
+  }
 
   {
     Operator::ReclaimableSectionGuard guard(this);
@@ -642,6 +774,13 @@ void HashBuild::noMoreInputInternal() {
 bool HashBuild::finishHashBuild() {
   checkRunning();
 
+  if (dropInput_) {
+    // Another Task of the query builds the table.
+    stats_.wlock()->addRuntimeStat(
+        kSharedTableDroppedRows, RuntimeCounter(numDroppedRows_));
+    return true;
+  }
+
   // Release the unused memory reservation before building the merged join
   // table.
   pool()->release();
@@ -697,6 +836,9 @@ bool HashBuild::finishHashBuild() {
           "Internal state for a peer is empty. It might have already"
           " been closed.");
       numRows += build->table_->rows()->numRows();
+      if (heavyHitters_ != nullptr && build->heavyHitters_ != nullptr) {
+        heavyHitters_->merge(*build->heavyHitters_);
+      }
     }
     otherBuilds.push_back(build);
   }
@@ -752,8 +894,22 @@ bool HashBuild::finishHashBuild() {
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
   addRuntimeStats();
+  std::vector<std::shared_ptr<common::Filter>> joinKeyFilters;
+  if (spillPartitions.empty() && !isInputFromSpill()) {
+    joinKeyFilters = makeJoinKeyFilters();
+  }
+  std::shared_ptr<BaseHashTable> table;
+  if (buildsSharedTable_) {
+    stats_.wlock()->addRuntimeStat(kSharedTableBuilds, RuntimeCounter(1));
+    table = makeSharedTable(std::move(table_), otherBuilds);
+  } else {
+    table = std::move(table_);
+  }
   joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+      std::move(table),
+      std::move(spillPartitions),
+      joinHasNullKeys_,
+      std::move(joinKeyFilters));
   if (spillEnabled()) {
     stateCleared_ = true;
   }
@@ -769,6 +925,28 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+std::shared_ptr<BaseHashTable> HashBuild::makeSharedTable(
+    std::unique_ptr<BaseHashTable> table,
+    const std::vector<HashBuild*>& otherBuilds) {
+  // The table holds the rows of the peers as well.
+  std::vector<std::shared_ptr<memory::MemoryPool>> pools;
+  pools.reserve(1 + otherBuilds.size());
+  pools.push_back(pool()->shared_from_this());
+  for (auto* build : otherBuilds) {
+    pools.push_back(build->pool()->shared_from_this());
+  }
+  auto* rawTable = table.get();
+  std::shared_ptr<BaseHashTable> owner = std::move(table);
+  return std::shared_ptr<BaseHashTable>(
+      rawTable,
+      [owner = std::move(owner),
+       pools = std::move(pools)](BaseHashTable* /*unused*/) mutable {
+        // Free the table before the pools it is allocated from.
+        owner.reset();
+        pools.clear();
+      });
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -900,6 +1078,68 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeJoinKeyFilters()
+    const {
+  const auto maxBytes = operatorCtx_->driverCtx()
+                            ->queryConfig()
+                            .hashProbeBloomFilterPushdownMaxSize();
+  // Same join types as HashProbe pushes down dynamic filters for.
+  if (maxBytes == 0 ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_))) {
+    return {};
+  }
+
+  const auto rowContainers = table_->allRows();
+  const auto numDistinct = table_->numDistinct();
+  const auto& hashers = table_->hashers();
+  std::vector<std::shared_ptr<common::Filter>> filters(hashers.size());
+  const bool hashMode = table_->hashMode() == BaseHashTable::HashMode::kHash;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    // HashProbe makes an exact filter from the hasher's distinct values.
+    if (!hashMode && !hashers[i]->distinctOverflow()) {
+      continue;
+    }
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+        filters[i] = makeJoinKeyFilter<int8_t>(
+            rowContainers, i, numDistinct, maxBytes);
+        break;
+      case TypeKind::SMALLINT:
+        filters[i] = makeJoinKeyFilter<int16_t>(
+            rowContainers, i, numDistinct, maxBytes);
+        break;
+      case TypeKind::INTEGER:
+        filters[i] = makeJoinKeyFilter<int32_t>(
+            rowContainers, i, numDistinct, maxBytes);
+        break;
+      case TypeKind::BIGINT:
+        filters[i] = makeJoinKeyFilter<int64_t>(
+            rowContainers, i, numDistinct, maxBytes);
+        break;
+      default:
+        break;
+    }
+  }
+  if (std::all_of(filters.begin(), filters.end(), [](const auto& filter) {
+        return filter == nullptr;
+      })) {
+    return {};
+  }
+  return filters;
+}
+
+void HashBuild::addToHeavyHitters() {
+  const auto& hashers = table_->hashers();
+  keyHashes_.resize(activeRows_.end());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->hash(activeRows_, i > 0, keyHashes_);
+  }
+  activeRows_.applyToSelected(
+      [&](auto row) { heavyHitters_->add(keyHashes_[row]); });
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -925,6 +1165,8 @@ void HashBuild::addRuntimeStats() {
       RuntimeMetric(hashTableStats.capacity);
   lockedStats->runtimeStats[BaseHashTable::kNumRehashes] =
       RuntimeMetric(hashTableStats.numRehashes);
+  lockedStats->runtimeStats[BaseHashTable::kRehashWallNanos] = RuntimeMetric(
+      hashTableStats.rehashNanos, RuntimeCounter::Unit::kNanos);
   lockedStats->runtimeStats[BaseHashTable::kNumDistinct] =
       RuntimeMetric(hashTableStats.numDistinct);
   if (hashTableStats.numTombstones != 0) {
@@ -932,6 +1174,24 @@ void HashBuild::addRuntimeStats() {
         RuntimeMetric(hashTableStats.numTombstones);
   }
 
+  // Report the skew of the join keys. A key is a heavy hitter if it has at
+  // least 1 / kHeavyHitterRatio of the build rows.
+  if (heavyHitters_ != nullptr && heavyHitters_->numValues() > 0) {
+    constexpr int64_t kHeavyHitterRatio = 100;
+    const auto numValues = heavyHitters_->numValues();
+    const auto heavyHitters = heavyHitters_->heavyHitters(
+        std::max<int64_t>(1, numValues / kHeavyHitterRatio));
+    lockedStats->addRuntimeStat(
+        "heavyHitterKeys", RuntimeCounter(heavyHitters.size()));
+    if (!heavyHitters.empty()) {
+      lockedStats->addRuntimeStat(
+          "topKeyRowsPct",
+          RuntimeCounter(heavyHitters[0].second * 100 / numValues));
+    }
+    // The input restored from spill is not added again.
+    heavyHitters_.reset();
+  }
+
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
     lockedStats->addRuntimeStat(
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HeavyHitterSketch.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
@@ -58,6 +59,13 @@ class HashBuild final : public Operator {
   };
   static std::string stateName(State state);
 
+  /// Runtime stats of the tables shared by the Tasks of a query. The first
+  /// is reported by the Task building the table, the second by the Tasks
+  /// dropping their build side input to probe the table built by another.
+  static inline const std::string kSharedTableBuilds{"sharedTableBuilds"};
+  static inline const std::string kSharedTableDroppedRows{
+      "sharedTableDroppedRows"};
+
   HashBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -67,6 +75,8 @@ class HashBuild final : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  uint64_t inputReservationBytes(const RowVectorPtr& input) override;
+
   RowVectorPtr getOutput() override {
     return nullptr;
   }
@@ -99,6 +109,12 @@ class HashBuild final : public Operator {
   // Invoked to set up hash table to build.
   void setupTable();
 
+  // Returns 'table' with the memory pools of its row containers attached so
+  // that it can be probed by other Tasks after this Task is gone.
+  std::shared_ptr<BaseHashTable> makeSharedTable(
+      std::unique_ptr<BaseHashTable> table,
+      const std::vector<HashBuild*>& otherBuilds);
+
   // Invoked when operator has finished processing the build input and wait for
   // all the other drivers to finish the processing. The last driver that
   // reaches to the hash build barrier, is responsible to build the hash table
@@ -204,6 +220,16 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Adds the key hashes of 'activeRows_' to 'heavyHitters_'.
+  void addToHeavyHitters();
+
+  // Builds Bloom filters on the integer join keys of 'table_' for push down
+  // into the probe side if enabled by query config. Only applies to keys whose
+  // hasher can not produce an exact filter, i.e. all keys of a table in kHash
+  // mode and keys with too many distinct values otherwise. Returns one entry
+  // per join key, nullptr if no filter is built for the key.
+  std::vector<std::shared_ptr<common::Filter>> makeJoinKeyFilters() const;
+
   // Indicates if this hash build operator is under non-reclaimable state or
   // not.
   bool nonReclaimableState() const;
@@ -269,6 +295,23 @@ class HashBuild final : public Operator {
   // Set of active rows during addInput().
   SelectivityVector activeRows_;
 
+  // Most frequent join keys of the build input. The last build operator
+  // merges the sketches of its peers and reports the skew of the keys. Null
+  // if QueryConfig::kHashBuildHeavyHitterSketchSize is 0.
+  std::unique_ptr<HeavyHitterSketch> heavyHitters_;
+
+  // Key hashes of the input rows for 'heavyHitters_'.
+  raw_vector<uint64_t> keyHashes_;
+
+  // True if this Task builds a table shared with the other Tasks of the query.
+  // See QueryConfig::kSharedHashJoinBuildNodeIds.
+  bool buildsSharedTable_{false};
+
+  // True if the table is built by another Task of the query. The input is
+  // dropped and counted in 'numDroppedRows_'.
+  bool dropInput_{false};
+  uint64_t numDroppedRows_{0};
+
   // True if this is a build side of an anti or left semi project join and has
   // at least one entry with null join keys.
   bool joinHasNullKeys_{false};
@@ -27,21 +27,48 @@ void HashJoinBridge::start() {
   VELOX_CHECK_GT(numBuilders_, 0);
 }
 
+void HashJoinBridge::cancel() {
+  JoinBridge::cancel();
+  std::shared_ptr<SharedJoinBuild> sharedBuild;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (ownsSharedBuild_) {
+      sharedBuild = sharedBuild_;
+    }
+  }
+  if (sharedBuild != nullptr) {
+    sharedBuild->setError(
+        "The task building the shared hash join table was cancelled");
+  }
+}
+
 void HashJoinBridge::addBuilder() {
   std::lock_guard<std::mutex> l(mutex_);
   VELOX_CHECK(!started_);
   ++numBuilders_;
 }
 
+bool HashJoinBridge::attachSharedBuild(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  if (sharedBuild_ == nullptr) {
+    std::tie(sharedBuild_, ownsSharedBuild_) =
+        SharedJoinBuildCache::instance().getOrCreate(key);
+  }
+  return ownsSharedBuild_;
+}
+
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> joinKeyFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
 
   std::vector<ContinuePromise> promises;
+  std::optional<HashBuildResult> sharedResult;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(started_);
@@ -65,11 +92,18 @@ void HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(joinKeyFilters));
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
+    if (ownsSharedBuild_) {
+      sharedResult = buildResult_;
+    }
   }
   notify(std::move(promises));
+  if (sharedResult.has_value()) {
+    sharedBuild_->setResult(std::move(sharedResult.value()));
+  }
 }
 
 void HashJoinBridge::setSpilledHashTable(SpillPartitionSet spillPartitionSet) {
@@ -103,6 +137,9 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
     promises = std::move(promises_);
   }
   notify(std::move(promises));
+  if (ownsSharedBuild_) {
+    sharedBuild_->setResult(HashBuildResult{});
+  }
 }
 
 std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
@@ -115,6 +152,12 @@ std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
       (!restoringSpillPartitionId_.has_value() &&
        restoringSpillShards_.empty()));
 
+  if (!buildResult_.has_value() && sharedBuild_ != nullptr &&
+      !ownsSharedBuild_) {
+    // The table is built by another Task of the query.
+    buildResult_ = sharedBuild_->resultOrFuture(future);
+    return buildResult_;
+  }
   if (buildResult_.has_value()) {
     return buildResult_.value();
   }
@@ -185,6 +228,94 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   return SpillInput(std::move(spillShard));
 }
 
+void SharedJoinBuild::setResult(HashJoinBridge::HashBuildResult result) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!result_.has_value());
+    result_ = std::move(result);
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+void SharedJoinBuild::setError(const std::string& error) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (result_.has_value() || error_.has_value()) {
+      return;
+    }
+    error_ = error;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+std::optional<HashJoinBridge::HashBuildResult> SharedJoinBuild::resultOrFuture(
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (error_.has_value()) {
+    VELOX_FAIL(error_.value());
+  }
+  if (result_.has_value()) {
+    return result_;
+  }
+  promises_.emplace_back("SharedJoinBuild::resultOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return std::nullopt;
+}
+
+// static
+SharedJoinBuildCache& SharedJoinBuildCache::instance() {
+  static SharedJoinBuildCache cache;
+  return cache;
+}
+
+std::pair<std::shared_ptr<SharedJoinBuild>, bool>
+SharedJoinBuildCache::getOrCreate(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = builds_.find(key);
+  if (it != builds_.end()) {
+    if (auto build = it->second.lock()) {
+      ++stats_.numShared;
+      return {std::move(build), false};
+    }
+  }
+  // Drop the entries of the tables no Task uses anymore.
+  for (auto expired = builds_.begin(); expired != builds_.end();) {
+    if (expired->second.expired()) {
+      expired = builds_.erase(expired);
+    } else {
+      ++expired;
+    }
+  }
+  auto build = std::make_shared<SharedJoinBuild>();
+  builds_[key] = build;
+  ++stats_.numBuilds;
+  return {std::move(build), true};
+}
+
+SharedJoinBuildCache::Stats SharedJoinBuildCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+size_t SharedJoinBuildCache::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t numBuilds = 0;
+  for (const auto& [key, build] : builds_) {
+    if (!build.expired()) {
+      ++numBuilds;
+    }
+  }
+  return numBuilds;
+}
+
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode) {
   return (joinNode->isAntiJoin() || joinNode->isLeftSemiProjectJoin() ||
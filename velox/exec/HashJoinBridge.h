@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -26,6 +28,8 @@ namespace test {
 class HashJoinBridgeTestHelper;
 }
 
+class SharedJoinBuild;
+
 /// Hands over a hash table from a multi-threaded build pipeline to a
 /// multi-threaded probe pipeline. This is owned by shared_ptr by all the build
 /// and probe Operator instances concerned. Corresponds to the Presto concept of
@@ -34,18 +38,34 @@ class HashJoinBridge : public JoinBridge {
  public:
   void start() override;
 
+  /// Also fails the Tasks waiting for the shared table of this bridge if this
+  /// bridge's Task is cancelled before it has built the table.
+  void cancel() override;
+
   /// Invoked by HashBuild operator ctor to add to this bridge by incrementing
   /// 'numBuilders_'. The latter is used to split the spill partition data among
   /// HashBuild operators to parallelize the restoring operation.
   void addBuilder();
 
+  /// Invoked by HashBuild operator ctor for a join with a broadcast build side
+  /// to share the table with the other Tasks of the query on this worker.
+  /// 'key' identifies the join and split group within the query. The first
+  /// Task to attach to 'key' builds the table, the others drop their build
+  /// side input and probe the table built by the first one. Returns true if
+  /// this bridge's Task builds the table.
+  bool attachSharedBuild(const std::string& key);
+
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
+  /// 'joinKeyFilters' has a filter per join key, or nullptr, for push down
+  /// into the probe side. Set only for keys the probe side can not derive an
+  /// exact filter for from the table hashers.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> joinKeyFilters = {});
 
   /// Invoked by the probe operator to set the spilled hash table while the
   /// probing. The function puts the spilled table partitions into
@@ -66,11 +86,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _joinKeyFilters = {})
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          joinKeyFilters(std::move(_joinKeyFilters)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -78,6 +100,9 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    // Filters on the join keys built from 'table' for push down into the
+    // probe side. Empty if none were built, nullptr for keys without one.
+    std::vector<std::shared_ptr<common::Filter>> joinKeyFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -117,6 +142,13 @@ class HashJoinBridge : public JoinBridge {
 
   std::optional<HashBuildResult> buildResult_;
 
+  // Set if the table is shared with the other Tasks of the query on this
+  // worker.
+  std::shared_ptr<SharedJoinBuild> sharedBuild_;
+
+  // True if this bridge's Task builds the table of 'sharedBuild_'.
+  bool ownsSharedBuild_{false};
+
   // restoringSpillPartitionXxx member variables are populated by the
   // bridge itself. When probe side finished processing, the bridge picks the
   // first partition from 'spillPartitionSets_', splits it into "even" shards
@@ -140,6 +172,60 @@ class HashJoinBridge : public JoinBridge {
   friend test::HashJoinBridgeTestHelper;
 };
 
+/// The hash table of a join with a broadcast build side. One Task of a query
+/// builds it and the other Tasks of the query on the same worker probe it
+/// read-only.
+class SharedJoinBuild {
+ public:
+  /// Invoked by the bridge of the building Task to publish the table.
+  void setResult(HashJoinBridge::HashBuildResult result);
+
+  /// Invoked if the building Task is cancelled before publishing the table.
+  /// The Tasks waiting for the table fail with 'error'. No-op if the table
+  /// has been published.
+  void setError(const std::string& error);
+
+  /// Returns the table if it has been published, otherwise sets 'future' to
+  /// wait for it.
+  std::optional<HashJoinBridge::HashBuildResult> resultOrFuture(
+      ContinueFuture* future);
+
+ private:
+  std::mutex mutex_;
+  std::optional<HashJoinBridge::HashBuildResult> result_;
+  std::optional<std::string> error_;
+  std::vector<ContinuePromise> promises_;
+};
+
+/// Process-wide registry of the hash tables shared by the Tasks of a query.
+/// An entry lives as long as one of the bridges attached to it.
+class SharedJoinBuildCache {
+ public:
+  struct Stats {
+    /// Number of tables built for sharing.
+    uint64_t numBuilds{0};
+    /// Number of Tasks that probe a table built by another Task.
+    uint64_t numShared{0};
+  };
+
+  static SharedJoinBuildCache& instance();
+
+  /// Returns the shared table for 'key' and true if the caller is the first
+  /// to attach to it and builds the table.
+  std::pair<std::shared_ptr<SharedJoinBuild>, bool> getOrCreate(
+      const std::string& key);
+
+  Stats stats() const;
+
+  /// Returns the number of live entries.
+  size_t size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::weak_ptr<SharedJoinBuild>> builds_;
+  Stats stats_;
+};
+
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
 // has filter set.
 bool isLeftNullAwareJoinWithFilter(
@@ -67,6 +67,10 @@ void extractColumns(
     const std::vector<TypePtr>& resultTypes,
     std::vector<VectorPtr>& resultVectors) {
   VELOX_CHECK_EQ(resultTypes.size(), resultVectors.size())
+  std::vector<column_index_t> columns;
+  std::vector<VectorPtr> children;
+  columns.reserve(projections.size());
+  children.reserve(projections.size());
   for (auto projection : projections) {
     const auto resultChannel = projection.outputChannel;
     VELOX_CHECK_LT(resultChannel, resultVectors.size())
@@ -78,11 +82,67 @@ void extractColumns(
       child = BaseVector::create(resultTypes[resultChannel], rows.size(), pool);
     }
     child->resize(rows.size());
-    table->rows()->extractColumn(
-        rows.data(), rows.size(), projection.inputChannel, child);
+    columns.push_back(projection.inputChannel);
+    children.push_back(child);
   }
+  table->rows()->extractColumns(rows.data(), rows.size(), columns, 0, children);
 }
 
+// Extracts a column of the hash table rows of a batch of probe output. Keeps
+// the table alive until the column is loaded.
+class BuildColumnLoader : public VectorLoader {
+ public:
+  BuildColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      std::shared_ptr<const std::vector<char*>> rows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool,
+      std::shared_ptr<std::atomic<int64_t>> numLoaded)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool),
+        numLoaded_(std::move(numLoaded)) {}
+
+ protected:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK_NULL(hook, "BuildColumnLoader does not support ValueHook");
+    VELOX_CHECK_LE(resultSize, rows_->size());
+    ++*numLoaded_;
+    if (*result && result->unique() && (*result)->isFlatEncoding()) {
+      (*result)->resize(resultSize);
+    } else {
+      *result = BaseVector::create(type_, resultSize, pool_);
+    }
+    if (rows.size() == resultSize) {
+      table_->rows()->extractColumn(
+          rows_->data(), resultSize, column_, *result);
+      return;
+    }
+    // Extracts only 'rows'. The other positions are set to null.
+    std::vector<char*> selectedRows(resultSize, nullptr);
+    for (auto row : rows) {
+      selectedRows[row] = (*rows_)[row];
+    }
+    table_->rows()->extractColumn(
+        selectedRows.data(), resultSize, column_, *result);
+  }
+
+ private:
+  const std::shared_ptr<BaseHashTable> table_;
+  const std::shared_ptr<const std::vector<char*>> rows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+  const std::shared_ptr<std::atomic<int64_t>> numLoaded_;
+};
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -184,6 +244,15 @@ void HashProbe::initialize() {
   if (nullAware_) {
     filterTableResult_.resize(1);
   }
+
+  // The table rows must stay valid until the lazy vectors are loaded, which
+  // rules out spilling the table.
+  lazyBuildColumns_ =
+      operatorCtx_->driverCtx()->queryConfig().hashProbeLazyBuildColumns() &&
+      !tableOutputProjections_.empty() && !spillEnabled();
+  if (lazyBuildColumns_) {
+    numLazyBuildColumnsLoaded_ = std::make_shared<std::atomic<int64_t>>(0);
+  }
 }
 
 void HashProbe::initializeFilter(
@@ -279,7 +348,10 @@ void HashProbe::maybeSetupSpillInputReader(
   auto partition = std::move(iter->second);
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   spillInputReader_ = partition->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->executor);
   spillPartitionSet_.erase(iter);
 }
 
@@ -331,8 +403,9 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->joinKeyFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -349,12 +422,27 @@ void HashProbe::asyncWaitForHashTable() {
     // nulls on the probe side. Hence, cannot filter these out.
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
+    const auto& joinKeyFilters = hashBuildResult->joinKeyFilters;
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
         if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+          continue;
         }
       }
+      if (i < joinKeyFilters.size() && joinKeyFilters[i] != nullptr) {
+        // Bloom or range filter from the build side. These pass rows without
+        // a match, so the join must still run.
+        std::shared_ptr<common::Filter> filter = joinKeyFilters[i];
+        if (nullAllowed) {
+          filter = filter->clone(true);
+        }
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+        hasInexactDynamicFilters_ = true;
+      }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
   }
@@ -538,7 +626,8 @@ void HashProbe::clearDynamicFilters() {
   //  * hash table has a single key with unique values,
   //  * build side has no dependent columns.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasInexactDynamicFilters_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -743,6 +832,8 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    fillLazyBuildColumns(size);
   } else {
     extractColumns(
         table_.get(),
@@ -754,6 +845,29 @@ void HashProbe::fillOutput(vector_size_t size) {
   }
 }
 
+void HashProbe::fillLazyBuildColumns(vector_size_t size) {
+  // 'outputTableRows_' is reused for the next batch, so the loaders share a
+  // copy.
+  auto rows = std::make_shared<const std::vector<char*>>(
+      outputTableRows_.begin(), outputTableRows_.begin() + size);
+  for (const auto& projection : tableOutputProjections_) {
+    const auto& type = outputType_->childAt(projection.outputChannel);
+    output_->childAt(projection.outputChannel) = std::make_shared<LazyVector>(
+        pool(),
+        type,
+        size,
+        std::make_unique<BuildColumnLoader>(
+            table_,
+            rows,
+            projection.inputChannel,
+            type,
+            pool(),
+            numLazyBuildColumnsLoaded_));
+  }
+  output_->updateContainsLazyNotLoaded();
+  numLazyBuildColumns_ += tableOutputProjections_.size();
+}
+
 RowVectorPtr HashProbe::getBuildSideOutput() {
   outputTableRows_.resize(outputBatchSize_);
   int32_t numOut;
@@ -883,6 +997,7 @@ void HashProbe::checkStateTransition(ProbeOperatorState state) {
 }
 
 RowVectorPtr HashProbe::getOutput() {
+  outputBatchSize_ = adaptiveOutputBatchRows();
   return getOutputInternal(/*toSpillOutput=*/false);
 }
 
@@ -1749,7 +1864,10 @@ void HashProbe::spillOutput() {
     return;
   }
   spillOutputReader_ = outputSpillSet.begin()->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->executor);
 }
 
 SpillPartitionSet HashProbe::spillTable() {
@@ -1888,6 +2006,12 @@ void HashProbe::prepareTableSpill(
 }
 
 void HashProbe::close() {
+  if (numLazyBuildColumns_ > 0) {
+    addRuntimeStat("lazyBuildColumns", RuntimeCounter(numLazyBuildColumns_));
+    addRuntimeStat(
+        "lazyBuildColumnsNotLoaded",
+        RuntimeCounter(numLazyBuildColumns_ - *numLazyBuildColumnsLoaded_));
+  }
   Operator::close();
 
   // Free up major memory usage.
@@ -109,6 +109,10 @@ class HashProbe : public Operator {
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
+  // Sets the build side columns of 'output_' to lazy vectors that extract the
+  // first 'size' rows of 'outputTableRows_' when loaded.
+  void fillLazyBuildColumns(vector_size_t size);
+
   // Populate 'match' output column for the left semi join project,
   void fillLeftSemiProjectMatchColumn(vector_size_t size);
 
@@ -302,8 +306,9 @@ class HashProbe : public Operator {
 
   //  std::vector<Operator*> findPeerOperators();
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Maximum number of rows in an output batch. Adapted to the average size of
+  // the output rows at the start of each getOutput() call.
+  uint32_t outputBatchSize_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -353,6 +358,11 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if some of the generated dynamic filters pass rows without a match in
+  // the hash table, e.g. Bloom filters. The join can not be replaced with such
+  // filters.
+  bool hasInexactDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -433,6 +443,17 @@ class HashProbe : public Operator {
   // Rows of table found by join probe, later filtered by 'filter_'.
   std::vector<char*> outputTableRows_;
 
+  // True if the build side columns of the probe output are lazy vectors. See
+  // QueryConfig::kHashProbeLazyBuildColumns.
+  bool lazyBuildColumns_{false};
+
+  // Number of lazy build side columns produced.
+  int64_t numLazyBuildColumns_{0};
+
+  // Number of lazy build side columns loaded. Shared with the loaders of the
+  // lazy vectors, which may be loaded after 'this' is closed.
+  std::shared_ptr<std::atomic<int64_t>> numLazyBuildColumnsLoaded_;
+
   // Indicates probe-side rows which should produce a NULL in left semi project
   // with filter.
   SelectivityVector leftSemiProjectIsNull_;
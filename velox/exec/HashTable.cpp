@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashTable.h"
+#include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -22,6 +23,7 @@
 #include "velox/common/process/ProcessBase.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/VectorTypeUtils.h"
 
@@ -465,6 +467,10 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
     groupNormalizedKeyProbe(lookup);
     return;
   }
+  if (prefetchGroupSize_ > 0) {
+    groupPrefetchProbe<false>(lookup, lookup.rows.data(), lookup.rows.size());
+    return;
+  }
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -500,6 +506,41 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+template <bool isJoin>
+void HashTable<ignoreNullKeys>::groupPrefetchProbe(
+    HashLookup& lookup,
+    const vector_size_t* rows,
+    int32_t numProbes) {
+  constexpr ProbeState::Operation op =
+      isJoin ? ProbeState::Operation::kProbe : ProbeState::Operation::kInsert;
+  const int32_t groupSize = prefetchGroupSize_;
+  ProbeState states[kMaxPrefetchGroupSize];
+  int32_t probeIndex = 0;
+  for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
+    // Prefetches the buckets of the group.
+    for (auto i = 0; i < groupSize; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, lookup.hashes[row], row);
+    }
+    // Loads the tags and prefetches the first candidate rows.
+    for (auto i = 0; i < groupSize; ++i) {
+      states[i].firstProbe<op>(*this, 0);
+    }
+    // For group by, a row inserted by an earlier probe of the group may be in
+    // the bucket of a later one, so the later probes reload their tags.
+    for (auto i = 0; i < groupSize; ++i) {
+      fullProbe<isJoin>(lookup, states[i], i > 0);
+    }
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    const int32_t row = rows[probeIndex];
+    states[0].preProbe(*this, lookup.hashes[row], row);
+    states[0].firstProbe<op>(*this, 0);
+    fullProbe<isJoin>(lookup, states[0], false);
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   ProbeState state1;
@@ -590,6 +631,10 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
+  if (perfectHash_ != nullptr) {
+    perfectHashJoinProbe(lookup);
+    return;
+  }
   if (hashMode_ == HashMode::kArray) {
     arrayJoinProbe(lookup);
     return;
@@ -600,8 +645,13 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     return;
   }
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const auto& probeRows = partitionProbeRows(lookup);
+  int32_t numProbes = probeRows.size();
+  const vector_size_t* rows = probeRows.data();
+  if (prefetchGroupSize_ > 0) {
+    groupPrefetchProbe<true>(lookup, rows, numProbes);
+    return;
+  }
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -632,6 +682,52 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+const raw_vector<vector_size_t>& HashTable<ignoreNullKeys>::partitionProbeRows(
+    HashLookup& lookup) {
+  // Average number of probes per partition below which grouping the probes
+  // does not pay for itself.
+  constexpr int32_t kMinProbesPerPartition = 16;
+  // Caps the size of the partition counts.
+  constexpr int32_t kMaxPartitionBits = 10;
+  const auto& rows = lookup.rows;
+  const uint64_t tableBytes = sizeMask_ + 1;
+  if (joinProbePartitionBytes_ == 0 ||
+      tableBytes <= joinProbePartitionBytes_ ||
+      rows.size() < 2 * kMinProbesPerPartition) {
+    return rows;
+  }
+  // The table size is a power of 2 and so is the number of partitions. The
+  // partition of a probe is given by the high bits of its bucket offset.
+  const int32_t tableBits = __builtin_ctzll(tableBytes);
+  const int32_t partitionBits = std::min<int32_t>(
+      {tableBits -
+           __builtin_ctzll(bits::nextPowerOfTwo(joinProbePartitionBytes_)),
+       kMaxPartitionBits,
+       63 - __builtin_clzll(rows.size() / kMinProbesPerPartition)});
+  if (partitionBits <= 0) {
+    return rows;
+  }
+  const int32_t shift = tableBits - partitionBits;
+  const int32_t numPartitions = 1 << partitionBits;
+  const auto* hashes = lookup.hashes.data();
+  auto& offsets = lookup.partitionOffsets;
+  offsets.resize(numPartitions + 1);
+  std::fill(offsets.begin(), offsets.end(), 0);
+  for (auto row : rows) {
+    ++offsets[(bucketOffset(hashes[row]) >> shift) + 1];
+  }
+  for (auto i = 1; i <= numPartitions; ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  auto& partitionedRows = lookup.partitionedRows;
+  partitionedRows.resize(rows.size());
+  for (auto row : rows) {
+    partitionedRows[offsets[bucketOffset(hashes[row]) >> shift]++] = row;
+  }
+  return partitionedRows;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -677,8 +773,9 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const auto& probeRows = partitionProbeRows(lookup);
+  int32_t numProbes = probeRows.size();
+  const vector_size_t* rows = probeRows.data();
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
@@ -705,6 +802,30 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::perfectHashJoinProbe(HashLookup& lookup) {
+  const auto& keys = lookup.hashers[0]->decodedVector();
+  const folly::Range<const vector_size_t*> rows(
+      lookup.rows.data(), lookup.rows.size());
+  auto* hits = lookup.hits.data();
+  switch (hashers_[0]->typeKind()) {
+    case TypeKind::TINYINT:
+      perfectHash_->find<int8_t>(keys, rows, hits);
+      break;
+    case TypeKind::SMALLINT:
+      perfectHash_->find<int16_t>(keys, rows, hits);
+      break;
+    case TypeKind::INTEGER:
+      perfectHash_->find<int32_t>(keys, rows, hits);
+      break;
+    case TypeKind::BIGINT:
+      perfectHash_->find<int64_t>(keys, rows, hits);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   VELOX_CHECK(bits::isPowerOfTwo(size), "Size is not a power of two: {}", size);
@@ -749,6 +870,7 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
   }
   numDistinct_ = 0;
   numTombstones_ = 0;
+  perfectHash_.reset();
 }
 
 template <bool ignoreNullKeys>
@@ -781,7 +903,11 @@ void HashTable<ignoreNullKeys>::checkSize(
   } else if (newNumDistincts > rehashSize()) {
     // NOTE: we need to plus one here as number itself could be power of two.
     const auto newCapacity = bits::nextPowerOfTwo(
-        std::max(newNumDistincts, capacity_ - numTombstones_) + 1);
+                                 std::max(
+                                     newNumDistincts,
+                                     capacity_ - numTombstones_) +
+                                 1) *
+        (growthFactor_ / 2);
     allocateTables(newCapacity);
     rehash(initNormalizedKeys);
   }
@@ -1277,6 +1403,18 @@ void HashTable<ignoreNullKeys>::insertForJoin(
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   ++numRehashes_;
+  // A rehash that restarts in another hash mode is timed once.
+  const bool outermost = !inRehash_;
+  std::optional<MicrosecondTimer> timer;
+  if (outermost) {
+    inRehash_ = true;
+    timer.emplace(&rehashMicros_);
+  }
+  SCOPE_EXIT {
+    if (outermost) {
+      inRehash_ = false;
+    }
+  };
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
@@ -1726,6 +1864,69 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
     decideHashMode(0);
   }
   checkHashBitsOverlap(spillInputStartPartitionBit);
+  maybeBuildPerfectHash();
+}
+
+namespace {
+int64_t integerKeyAt(TypeKind kind, const char* address) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return *reinterpret_cast<const int8_t*>(address);
+    case TypeKind::SMALLINT:
+      return *reinterpret_cast<const int16_t*>(address);
+    case TypeKind::INTEGER:
+      return *reinterpret_cast<const int32_t*>(address);
+    case TypeKind::BIGINT:
+      return *reinterpret_cast<const int64_t*>(address);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+} // namespace
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::maybeBuildPerfectHash() {
+  perfectHash_.reset();
+  // A table that keeps null keys cannot find its rows by key value alone.
+  if (!ignoreNullKeys || perfectHashMaxRows_ == 0 ||
+      numDistinct_ > perfectHashMaxRows_ || hashers_.size() != 1 ||
+      hashMode_ == HashMode::kArray || hasDuplicates_) {
+    return;
+  }
+  const auto kind = hashers_[0]->typeKind();
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return;
+  }
+
+  // Collects the keys from the table rather than the row containers, which
+  // may have rows with duplicate keys that were not inserted.
+  const auto keyOffset = rows_->columnAt(0).offset();
+  std::vector<int64_t> keys;
+  std::vector<char*> rows;
+  keys.reserve(numDistinct_);
+  rows.reserve(numDistinct_);
+  for (int64_t offset = 0; offset < sizeMask_; offset += kBucketSize) {
+    auto* bucket = bucketAt(offset);
+    for (auto slot = 0; slot < sizeof(TagVector); ++slot) {
+      const auto tag = bucket->tagAt(slot);
+      if (tag == ProbeState::kEmptyTag || tag == ProbeState::kTombstoneTag) {
+        continue;
+      }
+      char* row = bucket->pointerAt(slot);
+      keys.push_back(integerKeyAt(kind, row + keyOffset));
+      rows.push_back(row);
+    }
+  }
+  perfectHash_ = PerfectHashIndex::create(
+      folly::Range<const int64_t*>(keys.data(), keys.size()),
+      folly::Range<char* const*>(rows.data(), rows.size()),
+      rows_->pool());
 }
 
 template <bool ignoreNullKeys>
@@ -1954,6 +2155,8 @@ HashTable<true>::listNullKeyRows(NullKeyRowsIterator*, int32_t, char**) {
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::erase(folly::Range<char**> rows) {
+  // The perfect hash index is not updated.
+  perfectHash_.reset();
   auto numRows = rows.size();
   raw_vector<uint64_t> hashes;
   hashes.resize(numRows);
@@ -2147,6 +2350,12 @@ void BaseHashTable::prepareForJoinProbe(
 
   lookup.reset(rows.end());
 
+  if (hasPerfectHash()) {
+    // joinProbe() looks up the decoded keys directly.
+    populateLookupRows(rows, lookup.rows);
+    return;
+  }
+
   const auto mode = hashMode();
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
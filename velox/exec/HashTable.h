@@ -18,6 +18,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/PerfectHashIndex.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
 
@@ -95,6 +96,11 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory used by joinProbe to order 'rows' by the partition of the
+  /// table they hash to when radix-partitioned probing is enabled.
+  raw_vector<vector_size_t> partitionedRows;
+  raw_vector<int32_t> partitionOffsets;
 };
 
 struct HashTableStats {
@@ -103,6 +109,8 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Wall time spent in rehashing.
+  uint64_t rehashNanos{0};
 };
 
 class BaseHashTable {
@@ -129,6 +137,8 @@ class BaseHashTable {
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kRehashWallNanos{
+      "hashtable.rehashWallNanos"};
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
@@ -267,6 +277,36 @@ class BaseHashTable {
       folly::Executor* executor = nullptr,
       int8_t spillInputStartPartitionBit = kNoSpillInputStartPartitionBit) = 0;
 
+  /// Enables radix-partitioned join probes in kHash and kNormalizedKey modes.
+  /// The table is viewed as contiguous partitions of about 'partitionBytes'
+  /// selected by the high bits of the bucket offset. joinProbe() then probes
+  /// the rows of each partition together so that the probes of a partition
+  /// hit the cache and TLB instead of the whole table. 0 disables.
+  virtual void setJoinProbePartitionBytes(uint64_t partitionBytes) = 0;
+
+  /// Sets the number of probes that joinProbe() and groupProbe() interleave in
+  /// kHash mode. The buckets of all probes of a group are prefetched, then
+  /// their tags are loaded and the first candidate rows prefetched, and only
+  /// then are the keys compared. Larger groups hide more memory latency when
+  /// the table does not fit in cache. 0 keeps the default interleaving of 4
+  /// probes. At most kMaxPrefetchGroupSize.
+  virtual void setPrefetchGroupSize(int32_t groupSize) = 0;
+
+  static constexpr int32_t kMaxPrefetchGroupSize = 64;
+
+  /// Sets the maximum number of rows of a join table with a single integer
+  /// key and no duplicate keys for which prepareJoinTable() builds a perfect
+  /// hash index over the keys. joinProbe() then finds each key with a single
+  /// slot lookup. Does not apply to tables in array mode, which already map
+  /// keys to slots directly. Must be set before prepareJoinTable(). 0
+  /// disables.
+  virtual void setPerfectHashMaxRows(uint64_t maxRows) = 0;
+
+  /// Returns true if joinProbe() looks up the keys decoded in the hashers of
+  /// the HashLookup in a perfect hash index instead of using hash numbers or
+  /// value ids. See setPerfectHashMaxRows().
+  virtual bool hasPerfectHash() const = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -283,6 +323,11 @@ class BaseHashTable {
   /// side. This is used for sizing the internal hash table.
   virtual uint64_t numDistinct() const = 0;
 
+  /// Sets the factor by which the table grows when it fills up. This is a
+  /// power of two, 2 by default. A larger factor trades memory for fewer
+  /// rehashes when most inserts are new keys.
+  virtual void setGrowthFactor(int32_t growthFactor) = 0;
+
   /// Return a number of current stats that can help with debugging and
   /// profiling.
   virtual HashTableStats stats() const = 0;
@@ -529,7 +574,8 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    return sizeof(char*) * capacity_ + rows_->allocatedBytes() +
+        (perfectHash_ ? perfectHash_->allocatedBytes() : 0);
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -544,9 +590,19 @@ class HashTable : public BaseHashTable {
     return numDistinct_;
   }
 
+  void setGrowthFactor(int32_t growthFactor) override {
+    VELOX_CHECK_GE(growthFactor, 2);
+    VELOX_CHECK(bits::isPowerOfTwo(growthFactor));
+    growthFactor_ = growthFactor;
+  }
+
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        rehashMicros_ * 1'000};
   }
 
   bool hasDuplicateKeys() const override {
@@ -578,12 +634,30 @@ class HashTable : public BaseHashTable {
       int8_t spillInputStartPartitionBit =
           kNoSpillInputStartPartitionBit) override;
 
+  void setJoinProbePartitionBytes(uint64_t partitionBytes) override {
+    joinProbePartitionBytes_ = partitionBytes;
+  }
+
+  void setPrefetchGroupSize(int32_t groupSize) override {
+    VELOX_USER_CHECK_GE(groupSize, 0);
+    VELOX_USER_CHECK_LE(groupSize, kMaxPrefetchGroupSize);
+    prefetchGroupSize_ = groupSize;
+  }
+
+  void setPerfectHashMaxRows(uint64_t maxRows) override {
+    perfectHashMaxRows_ = maxRows;
+  }
+
+  bool hasPerfectHash() const override {
+    return perfectHash_ != nullptr;
+  }
+
   uint64_t hashTableSizeIncrease(int32_t numNewDistinct) const override {
     if (numDistinct_ + numNewDistinct > rehashSize()) {
-      // If rehashed, the table adds size_ entries (i.e. doubles),
+      // If rehashed, the table adds size_ entries for each doubling,
       // adding one pointer worth for each new position.  (16 tags, 16 6 byte
       // pointers, 16 bytes padding).
-      return capacity_ * tableSlotSize();
+      return capacity_ * tableSlotSize() * (growthFactor_ - 1);
     }
     return 0;
   }
@@ -592,10 +666,16 @@ class HashTable : public BaseHashTable {
     // Take the max of max size in array mode and estimated size in non-array
     // mode.
     const uint64_t maxByteSizeInArrayMode = kArrayHashMaxSize * tableSlotSize();
+    const uint64_t perfectHashBytes =
+        hashers_.size() == 1 && numDistinct <= perfectHashMaxRows_ &&
+            perfectHashMaxRows_ > 0
+        ? PerfectHashIndex::estimateBytes(numDistinct)
+        : 0;
     return bits::roundUp(
         std::max(
             maxByteSizeInArrayMode,
-            newHashTableEntries(numDistinct, 0) * tableSlotSize()),
+            newHashTableEntries(numDistinct, 0) * tableSlotSize()) +
+            perfectHashBytes,
         memory::AllocationTraits::kPageSize);
   }
 
@@ -832,6 +912,14 @@ class HashTable : public BaseHashTable {
   template <bool isJoin, bool isNormalizedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
+  // kHash mode probe of 'numProbes' 'rows' of 'lookup' in groups of
+  // 'prefetchGroupSize_'. Inserts missing keys if 'isJoin' is false.
+  template <bool isJoin>
+  void groupPrefetchProbe(
+      HashLookup& lookup,
+      const vector_size_t* rows,
+      int32_t numProbes);
+
   // Shortcut path for group by with normalized keys.
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
@@ -841,6 +929,18 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Looks up the decoded keys of 'lookup' in 'perfectHash_'.
+  void perfectHashJoinProbe(HashLookup& lookup);
+
+  // Builds 'perfectHash_' over the keys in the table if the table qualifies.
+  // See setPerfectHashMaxRows().
+  void maybeBuildPerfectHash();
+
+  // Returns the rows of 'lookup' to probe in the order of the table partition
+  // they hash to if radix-partitioned probing is enabled and the table is
+  // larger than a partition. Otherwise returns 'lookup.rows'.
+  const raw_vector<vector_size_t>& partitionProbeRows(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -947,6 +1047,21 @@ class HashTable : public BaseHashTable {
   // The min table size in row to trigger parallel join table build.
   const uint32_t minTableSizeForParallelJoinBuild_;
 
+  // Target size in bytes of a table partition for radix-partitioned join
+  // probes. 0 if disabled.
+  uint64_t joinProbePartitionBytes_{0};
+
+  // Number of interleaved probes in kHash mode. 0 for the default of 4.
+  int32_t prefetchGroupSize_{0};
+
+  // Maximum number of rows of a join table to build 'perfectHash_' for. 0 if
+  // disabled.
+  uint64_t perfectHashMaxRows_{0};
+
+  // Maps the keys of a join table with a single integer key and no duplicate
+  // keys to their rows. Used by joinProbe() instead of 'table_' if set.
+  std::unique_ptr<PerfectHashIndex> perfectHash_;
+
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
@@ -976,6 +1091,11 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Wall time of the rehash() calls.
+  uint64_t rehashMicros_{0};
+  bool inRehash_{false};
+  // Factor by which checkSize() grows the table. See setGrowthFactor().
+  int32_t growthFactor_{2};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "velox/exec/HeavyHitterSketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+HeavyHitterSketch::HeavyHitterSketch(int32_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+  counts_.reserve(capacity_);
+}
+
+void HeavyHitterSketch::decrementAll() {
+  for (auto it = counts_.begin(); it != counts_.end();) {
+    if (--it->second == 0) {
+      it = counts_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void HeavyHitterSketch::merge(const HeavyHitterSketch& other) {
+  numValues_ += other.numValues_;
+  for (const auto& [hash, count] : other.counts_) {
+    counts_[hash] += count;
+  }
+  if (counts_.size() <= capacity_) {
+    return;
+  }
+  // Subtracts the (capacity + 1)th largest count from all counters, which
+  // leaves at most 'capacity_' positive counters.
+  std::vector<int64_t> counts;
+  counts.reserve(counts_.size());
+  for (const auto& [hash, count] : counts_) {
+    counts.push_back(count);
+  }
+  std::nth_element(
+      counts.begin(), counts.begin() + capacity_, counts.end(), std::greater{});
+  const auto decrement = counts[capacity_];
+  for (auto it = counts_.begin(); it != counts_.end();) {
+    it->second -= decrement;
+    if (it->second <= 0) {
+      it = counts_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::vector<std::pair<uint64_t, int64_t>> HeavyHitterSketch::heavyHitters(
+    int64_t minCount) const {
+  std::vector<std::pair<uint64_t, int64_t>> result;
+  for (const auto& [hash, count] : counts_) {
+    if (count >= minCount) {
+      result.emplace_back(hash, count);
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.second > b.second;
+  });
+  return result;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::exec {
+
+/// Misra-Gries summary of the most frequent values in a stream of 64-bit key
+/// hashes. Keeps at most 'capacity' counters. A hash that occurs more than
+/// numValues() / (capacity + 1) times is guaranteed to have a counter and the
+/// count of a counter underestimates the true count by at most as much.
+/// Summaries of different streams can be merged with the same guarantee for
+/// the combined stream.
+class HeavyHitterSketch {
+ public:
+  explicit HeavyHitterSketch(int32_t capacity);
+
+  void add(uint64_t hash) {
+    ++numValues_;
+    auto it = counts_.find(hash);
+    if (it != counts_.end()) {
+      ++it->second;
+    } else if (counts_.size() < capacity_) {
+      counts_.emplace(hash, 1);
+    } else {
+      decrementAll();
+    }
+  }
+
+  /// Adds the counts of 'other' to 'this'.
+  void merge(const HeavyHitterSketch& other);
+
+  /// Number of hashes added, including the ones added to merged sketches.
+  int64_t numValues() const {
+    return numValues_;
+  }
+
+  /// Returns the hashes with an estimated count of at least 'minCount' and
+  /// their counts, most frequent first.
+  std::vector<std::pair<uint64_t, int64_t>> heavyHitters(
+      int64_t minCount) const;
+
+ private:
+  // Decrements all counters by one and drops the ones that become 0. Called
+  // for a hash without a counter when all counters are in use.
+  void decrementAll();
+
+  const int32_t capacity_;
+  int64_t numValues_{0};
+  folly::F14FastMap<uint64_t, int64_t> counts_;
+};
+
+} // namespace facebook::velox::exec
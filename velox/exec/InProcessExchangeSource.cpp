@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ExchangeSource.h"
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (taskId.compare(0, kTaskIdPrefix.size(), kTaskIdPrefix) != 0) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  // The producer is in the same process, so there is no round trip to bound.
+  // The request waits until the producer has data or is at end.
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    VELOX_CHECK(requestPending_);
+    promise_ = std::move(promise);
+    requestedSequence = sequence_;
+  }
+
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "invalid OutputBufferManager");
+  // The callback may outlive 'this'.
+  auto self = std::static_pointer_cast<InProcessExchangeSource>(
+      shared_from_this());
+  const bool found = buffers->getPages(
+      taskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, requestedSequence](
+          std::vector<std::shared_ptr<SerializedPage>> pages,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        self->onPages(
+            std::move(pages),
+            requestedSequence,
+            sequence,
+            std::move(remainingBytes));
+      });
+  if (!found) {
+    // The producer Task is not registered yet or is gone. Respond with no data
+    // after 'maxWait' so that the request is retried without spinning.
+    folly::futures::sleep(
+        std::chrono::duration_cast<folly::HighResDuration>(maxWait))
+        .via(&folly::InlineExecutor::instance())
+        .thenValue([self, requestedSequence](auto&&) {
+          self->onPages({}, requestedSequence, requestedSequence, {});
+        });
+  }
+  return future;
+}
+
+void InProcessExchangeSource::onPages(
+    std::vector<std::shared_ptr<SerializedPage>> pages,
+    int64_t requestedSequence,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !pages.empty()) {
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, pages.size());
+    pages.erase(pages.begin(), pages.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> received;
+  received.reserve(pages.size());
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  int64_t numVectorPages = 0;
+  for (auto& page : pages) {
+    if (page == nullptr) {
+      atEnd = true;
+      // Keep looping, there could be extra end markers.
+      continue;
+    }
+    totalBytes += page->size();
+    if (page->vector() != nullptr) {
+      // The vector is shared with the page in the producer's buffer and with
+      // any other consumer of a broadcast. It is not modified by either.
+      received.push_back(std::make_unique<SerializedPage>(
+          page->vector(), page->size(), page->vectorOwner()));
+      ++numVectorPages;
+    } else {
+      received.push_back(std::make_unique<SerializedPage>(
+          page->getIOBuf(), nullptr, page->numRows()));
+    }
+  }
+  numPages_ += received.size();
+  numVectorPages_ += numVectorPages;
+  totalBytes_ += totalBytes;
+
+  const auto numReceived = received.size();
+  int64_t ackSequence{0};
+  VeloxPromise<Response> requestPromise;
+  {
+    std::vector<ContinuePromise> queuePromises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      requestPromise = std::move(promise_);
+      for (auto& page : received) {
+        queue_->enqueueLocked(std::move(page), queuePromises);
+      }
+      if (atEnd) {
+        queue_->enqueueLocked(nullptr, queuePromises);
+        atEnd_ = true;
+      }
+      if (numReceived > 0) {
+        ackSequence = sequence_ = sequence + numReceived;
+      }
+    }
+    for (auto& promise : queuePromises) {
+      promise.setValue();
+    }
+  }
+
+  // Outside of the queue mutex.
+  auto buffers = OutputBufferManager::getInstance().lock();
+  if (buffers != nullptr) {
+    if (atEnd) {
+      buffers->deleteResults(taskId_, destination_);
+    } else if (numReceived > 0) {
+      buffers->acknowledge(taskId_, destination_, ackSequence);
+    }
+  }
+
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(
+        Response{totalBytes, atEnd, std::move(remainingBytes)});
+  }
+}
+
+folly::SemiFuture<ExchangeSource::Response>
+InProcessExchangeSource::requestDataSizes(std::chrono::microseconds maxWait) {
+  return request(0, maxWait);
+}
+
+void InProcessExchangeSource::close() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(taskId_, destination_);
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.numVectorPages",
+       RuntimeMetric(numVectorPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource for a producer Task in the same process. Takes the pages
+/// directly from the OutputBufferManager of the process instead of over the
+/// network. In-process pages made by PartitionedOutput with
+/// QueryConfig::exchangeVectorPages() keep their vectors, which Exchange
+/// returns without deserializing. Consumers in other processes get these pages
+/// serialized.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  /// Task IDs with this prefix are served by InProcessExchangeSource.
+  static inline const std::string kTaskIdPrefix{"inprocess://"};
+
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool) {}
+
+  /// ExchangeSource::Factory that returns an InProcessExchangeSource for a
+  /// 'taskId' that starts with kTaskIdPrefix and nullptr otherwise.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // Called with the pages of the request for 'requestedSequence'.
+  void onPages(
+      std::vector<std::shared_ptr<SerializedPage>> pages,
+      int64_t requestedSequence,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> numVectorPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
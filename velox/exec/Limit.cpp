@@ -37,6 +37,17 @@ Limit::Limit(
   }
 }
 
+void Limit::initialize() {
+  Operator::initialize();
+  // The rows past the offset plus the limit are never used, so the source of
+  // the pipeline may stop reading there.
+  if (remainingLimit_ <=
+      std::numeric_limits<int64_t>::max() - remainingOffset_) {
+    operatorCtx_->driver()->pushdownLimit(
+        this, remainingOffset_ + remainingLimit_);
+  }
+}
+
 bool Limit::needsInput() const {
   return !finished_ && input_ == nullptr;
 }
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/LocalPartition.h"
+
+#include <algorithm>
+
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -24,6 +27,19 @@ void notify(std::vector<ContinuePromise>& promises) {
     promise.setValue();
   }
 }
+
+RowVectorPtr
+wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
+  std::vector<VectorPtr> wrappedChildren;
+  wrappedChildren.reserve(input->type()->size());
+  for (auto i = 0; i < input->type()->size(); i++) {
+    wrappedChildren.emplace_back(BaseVector::wrapInDictionary(
+        BufferPtr(nullptr), indices, size, input->childAt(i)));
+  }
+
+  return std::make_shared<RowVector>(
+      input->pool(), input->type(), BufferPtr(nullptr), size, wrappedChildren);
+}
 } // namespace
 
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
@@ -55,6 +71,27 @@ std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
   return promises;
 }
 
+bool LocalExchangeMemoryManager::isHalfFull() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return bufferedBytes_ >= maxBufferSize_ / 2;
+}
+
+void ScaleWriterPartitionState::addProcessedBytes(
+    uint64_t bytes,
+    bool backedUp) {
+  const auto processedBytes = processedBytes_ += bytes;
+  if (!backedUp) {
+    return;
+  }
+  auto numActive = numActivePartitions_.load();
+  if (numActive < numPartitions_ &&
+      processedBytes >= numActive * minProcessedBytes_) {
+    // Another producer may add the same queue at the same time, in which case
+    // one of them does.
+    numActivePartitions_.compare_exchange_strong(numActive, numActive + 1);
+  }
+}
+
 void LocalExchangeQueue::addProducer() {
   queue_.withWLock([&](auto& /*queue*/) {
     VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
@@ -86,7 +123,7 @@ BlockingReason LocalExchangeQueue::enqueue(
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue.push(Entry{std::move(input), inputBytes});
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -109,6 +146,33 @@ BlockingReason LocalExchangeQueue::enqueue(
   return BlockingReason::kNotBlocked;
 }
 
+void LocalExchangeQueue::enqueuePartition(
+    std::shared_ptr<LocalExchangeSharedInput> input,
+    BufferPtr indices,
+    vector_size_t size) {
+  std::vector<ContinuePromise> consumerPromises;
+  std::vector<ContinuePromise> memoryPromises;
+  queue_.withWLock([&](auto& queue) {
+    if (closed_) {
+      if (input->releasePartition()) {
+        memoryPromises = memoryManager_->decreaseMemoryUsage(input->bytes());
+      }
+      return;
+    }
+    queue.push(Entry{nullptr, 0, std::move(input), std::move(indices), size});
+    consumerPromises = std::move(consumerPromises_);
+  });
+  notify(consumerPromises);
+  notify(memoryPromises);
+}
+
+int64_t LocalExchangeQueue::Entry::release() const {
+  if (sharedInput == nullptr) {
+    return bytes;
+  }
+  return sharedInput->releasePartition() ? sharedInput->bytes() : 0;
+}
+
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
   queue_.withWLock([&](auto& queue) {
@@ -126,6 +190,7 @@ BlockingReason LocalExchangeQueue::next(
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
   std::vector<ContinuePromise> memoryPromises;
+  Entry entry;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -139,20 +204,30 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    entry = std::move(queue.front());
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    const auto releasedBytes = entry.release();
+    if (releasedBytes > 0) {
+      memoryPromises = memoryManager_->decreaseMemoryUsage(releasedBytes);
+    }
 
     return BlockingReason::kNotBlocked;
   });
   notify(memoryPromises);
+  if (entry.sharedInput != nullptr) {
+    // Wraps the partition outside of the lock so that consumers of different
+    // queues do it in parallel.
+    *data = wrapChildren(
+        entry.sharedInput->input(), entry.size, std::move(entry.indices));
+  } else {
+    *data = std::move(entry.data);
+  }
   return blockingReason;
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<Entry>& queue) const {
   if (closed_) {
     return true;
   }
@@ -174,7 +249,7 @@ void LocalExchangeQueue::close() {
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().release();
       queue.pop();
     }
 
@@ -251,7 +326,10 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      scaleWriterState_{ctx->task->getScaleWriterPartitionState(
+          ctx->splitGroupId,
+          planNode->id())} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -280,19 +358,6 @@ std::vector<vector_size_t*> getRawIndices(
   }
   return rawIndices;
 }
-
-RowVectorPtr
-wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
-  std::vector<VectorPtr> wrappedChildren;
-  wrappedChildren.reserve(input->type()->size());
-  for (auto i = 0; i < input->type()->size(); i++) {
-    wrappedChildren.emplace_back(BaseVector::wrapInDictionary(
-        BufferPtr(nullptr), indices, size, input->childAt(i)));
-  }
-
-  return std::make_shared<RowVector>(
-      input->pool(), input->type(), BufferPtr(nullptr), size, wrappedChildren);
-}
 } // namespace
 
 void LocalPartition::addInput(RowVectorPtr input) {
@@ -316,6 +381,23 @@ void LocalPartition::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (scaleWriterState_ != nullptr) {
+    const auto inputBytes = input->estimateFlatSize();
+    const auto partition =
+        nextPartition_++ % scaleWriterState_->numActivePartitions();
+    ContinueFuture future;
+    auto blockingReason = queues_[partition]->enqueue(input, &future);
+    if (blockingReason != BlockingReason::kNotBlocked) {
+      blockingReasons_.push_back(blockingReason);
+      futures_.push_back(std::move(future));
+    }
+    scaleWriterState_->addProcessedBytes(
+        inputBytes,
+        blockingReason != BlockingReason::kNotBlocked ||
+            queues_[0]->memoryManager()->isHalfFull());
+    return;
+  }
+
   const auto singlePartition =
       partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
@@ -344,21 +426,32 @@ void LocalPartition::addInput(RowVectorPtr input) {
     ++maxIndex[partition];
   }
 
+  // The partitions are index buffers over 'input', which they all keep alive.
+  // Account the memory of 'input' once rather than per partition, and let the
+  // consumers wrap their partitions.
+  const auto numNonEmptyPartitions = numPartitions_ -
+      std::count(maxIndex.begin(), maxIndex.end(), 0);
+  if (numNonEmptyPartitions == 0) {
+    // Nothing is enqueued, so nothing would release the accounted memory.
+    return;
+  }
+  const auto inputBytes = input->estimateFlatSize();
+  auto sharedInput = std::make_shared<LocalExchangeSharedInput>(
+      input, inputBytes, numNonEmptyPartitions);
+  ContinueFuture future;
+  if (queues_[0]->memoryManager()->increaseMemoryUsage(&future, inputBytes)) {
+    blockingReasons_.push_back(BlockingReason::kWaitForConsumer);
+    futures_.push_back(std::move(future));
+  }
+
   for (auto i = 0; i < numPartitions_; i++) {
     auto partitionSize = maxIndex[i];
     if (partitionSize == 0) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
-    }
+    queues_[i]->enqueuePartition(
+        sharedInput, std::move(indexBuffers[i]), partitionSize);
   }
 }
 
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <atomic>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
@@ -36,6 +38,9 @@ class LocalExchangeMemoryManager {
   /// caller to fulfill.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
+  /// Returns true if at least half of the buffer size limit is used.
+  bool isHalfFull();
+
  private:
   const int64_t maxBufferSize_;
   std::mutex mutex_;
@@ -43,6 +48,40 @@ class LocalExchangeMemoryManager {
   std::vector<ContinuePromise> promises_;
 };
 
+/// An input vector of LocalPartition whose partitions are queued in the
+/// LocalExchangeQueues as index buffers over it, instead of as vectors of
+/// their own. The memory of the input is accounted once for all its
+/// partitions and released when the last of them is dequeued.
+class LocalExchangeSharedInput {
+ public:
+  LocalExchangeSharedInput(
+      RowVectorPtr input,
+      int64_t bytes,
+      int32_t numPartitions)
+      : input_{std::move(input)},
+        bytes_{bytes},
+        numPendingPartitions_{numPartitions} {}
+
+  const RowVectorPtr& input() const {
+    return input_;
+  }
+
+  int64_t bytes() const {
+    return bytes_;
+  }
+
+  /// Called when a partition leaves its queue. Returns true for the last
+  /// partition, which releases the memory of the input.
+  bool releasePartition() {
+    return --numPendingPartitions_ == 0;
+  }
+
+ private:
+  const RowVectorPtr input_;
+  const int64_t bytes_;
+  std::atomic<int32_t> numPendingPartitions_;
+};
+
 /// Buffers data for a single partition produced by local exchange. Allows
 /// multiple producers to enqueue data and multiple consumers fetch data. Each
 /// producer must be registered with a call to 'addProducer'. 'noMoreProducers'
@@ -69,6 +108,15 @@ class LocalExchangeQueue {
   /// completed when ready to accept more data.
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future);
 
+  /// Used by a producer to add the partition of 'input' made of the 'size'
+  /// rows at 'indices'. The partition is wrapped into a vector of its own when
+  /// dequeued. The producer accounts the memory of 'input' once for all its
+  /// partitions with LocalExchangeMemoryManager::increaseMemoryUsage().
+  void enqueuePartition(
+      std::shared_ptr<LocalExchangeSharedInput> input,
+      BufferPtr indices,
+      vector_size_t size);
+
   /// Called by a producer to indicate that no more data will be added.
   void noMoreData();
 
@@ -84,16 +132,33 @@ class LocalExchangeQueue {
 
   bool isFinished();
 
+  const std::shared_ptr<LocalExchangeMemoryManager>& memoryManager() const {
+    return memoryManager_;
+  }
+
   /// Drop remaining data from the queue and notify consumers and producers if
   /// called before all the data has been processed. No-op otherwise.
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A queued vector, or a partition of an input shared with other queues.
+  struct Entry {
+    RowVectorPtr data;
+    // The accounted memory of 'data'.
+    int64_t bytes{0};
+    std::shared_ptr<LocalExchangeSharedInput> sharedInput;
+    BufferPtr indices;
+    vector_size_t size{0};
+
+    // Called when 'this' leaves the queue. Returns the memory to release.
+    int64_t release() const;
+  };
+
+  bool isFinishedLocked(const std::queue<Entry>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<Entry>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -140,6 +205,34 @@ class LocalExchange : public SourceOperator {
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
 };
 
+/// Decides how many of the LocalExchangeQueues of a round-robin exchange that
+/// feeds table writers receive data when 'scale_writers' is set. Starts with
+/// one and adds one whenever the exchange is backed up and the active queues
+/// have been sent 'minProcessedBytes' each on average. Shared by all the
+/// producers of the exchange.
+class ScaleWriterPartitionState {
+ public:
+  ScaleWriterPartitionState(int32_t numPartitions, uint64_t minProcessedBytes)
+      : numPartitions_{numPartitions}, minProcessedBytes_{minProcessedBytes} {
+    VELOX_CHECK_GT(numPartitions_, 0);
+  }
+
+  /// Returns the number of leading queues that receive data.
+  int32_t numActivePartitions() const {
+    return numActivePartitions_;
+  }
+
+  /// Records 'bytes' sent to the active queues. 'backedUp' is true if the
+  /// exchange buffer is filling up, i.e. the writers do not keep up.
+  void addProcessedBytes(uint64_t bytes, bool backedUp);
+
+ private:
+  const int32_t numPartitions_;
+  const uint64_t minProcessedBytes_;
+  std::atomic<int32_t> numActivePartitions_{1};
+  std::atomic<uint64_t> processedBytes_{0};
+};
+
 /// Hash partitions the data using specified keys. The number of partitions is
 /// determined by the number of LocalExchangeQueues(s) found in the task.
 class LocalPartition : public Operator {
@@ -175,6 +268,10 @@ class LocalPartition : public Operator {
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // Set if the table writers fed by this exchange are scaled. Then the input
+  // vectors go round-robin to the active queues instead of being partitioned.
+  const std::shared_ptr<ScaleWriterPartitionState> scaleWriterState_;
+  uint32_t nextPartition_{0};
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
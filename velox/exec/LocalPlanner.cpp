@@ -34,8 +34,11 @@
 #include "velox/exec/NestedLoopJoinProbe.h"
 #include "velox/exec/OrderBy.h"
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/exec/RoundRobinPartitionFunction.h"
+#include "velox/exec/RollupAggregation.h"
 #include "velox/exec/RowNumber.h"
 #include "velox/exec/StreamingAggregation.h"
+#include "velox/exec/StreamingMarkDistinct.h"
 #include "velox/exec/TableScan.h"
 #include "velox/exec/TableWriteMerge.h"
 #include "velox/exec/TableWriter.h"
@@ -509,6 +512,19 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto groupIdNode =
             std::dynamic_pointer_cast<const core::GroupIdNode>(planNode)) {
+      if (i < planNodes.size() - 1) {
+        auto aggregationNode =
+            std::dynamic_pointer_cast<const core::AggregationNode>(
+                planNodes[i + 1]);
+        if (aggregationNode &&
+            RollupAggregation::canRollup(
+                *groupIdNode, *aggregationNode, ctx->queryConfig())) {
+          operators.push_back(std::make_unique<RollupAggregation>(
+              id, ctx.get(), groupIdNode, aggregationNode));
+          i++;
+          continue;
+        }
+      }
       operators.push_back(
           std::make_unique<GroupId>(id, ctx.get(), groupIdNode));
     } else if (
@@ -542,8 +558,13 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto markDistinctNode =
             std::dynamic_pointer_cast<const core::MarkDistinctNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<MarkDistinct>(id, ctx.get(), markDistinctNode));
+      if (markDistinctNode->isPreGrouped()) {
+        operators.push_back(std::make_unique<StreamingMarkDistinct>(
+            id, ctx.get(), markDistinctNode));
+      } else {
+        operators.push_back(
+            std::make_unique<MarkDistinct>(id, ctx.get(), markDistinctNode));
+      }
     } else if (
         auto localMerge =
             std::dynamic_pointer_cast<const core::LocalMergeNode>(planNode)) {
@@ -695,6 +716,18 @@ std::vector<core::PlanNodeId> DriverFactory::needsNestedLoopJoinBridges()
   return planNodeIds;
 }
 
+bool DriverFactory::needsScaledWriterExchange() const {
+  if (planNodes.size() < 2 || !needsLocalExchange().has_value()) {
+    return false;
+  }
+  const auto* localPartitionNode =
+      static_cast<const core::LocalPartitionNode*>(planNodes[0].get());
+  return dynamic_cast<const RoundRobinPartitionFunctionSpec*>(
+             &localPartitionNode->partitionFunctionSpec()) != nullptr &&
+      std::dynamic_pointer_cast<const core::TableWriteNode>(planNodes[1]) !=
+      nullptr;
+}
+
 // static
 void DriverFactory::registerAdapter(DriverAdapter adapter) {
   adapters.push_back(std::move(adapter));
@@ -30,14 +30,16 @@ Merge::Merge(
         sortingKeys,
     const std::vector<core::SortOrder>& sortingOrders,
     const std::string& planNodeId,
-    const std::string& operatorType)
+    const std::string& operatorType,
+    bool concatenateSources)
     : SourceOperator(
           driverCtx,
           std::move(outputType),
           operatorId,
           planNodeId,
           operatorType),
-      outputBatchSize_{outputBatchRows()} {
+      outputBatchSize_{outputBatchRows()},
+      concatenateSources_{concatenateSources} {
   auto numKeys = sortingKeys.size();
   sortingKeys_.reserve(numKeys);
   for (int i = 0; i < numKeys; ++i) {
@@ -53,6 +55,25 @@ Merge::Merge(
             sortingOrders[i].isAscending(),
             false});
   }
+
+  if (const auto config = driverCtx->prefixSortConfig()) {
+    std::vector<TypePtr> keyTypes;
+    std::vector<CompareFlags> compareFlags;
+    keyTypes.reserve(numKeys);
+    compareFlags.reserve(numKeys);
+    for (const auto& [channel, flags] : sortingKeys_) {
+      keyTypes.push_back(outputType_->childAt(channel));
+      compareFlags.push_back(flags);
+    }
+    auto layout = PrefixSortLayout::makeSortLayout(
+        keyTypes,
+        compareFlags,
+        config->maxNormalizedKeySize,
+        config->maxStringPrefixLength);
+    if (!layout.noNormalizedKeys) {
+      prefixSortLayout_.emplace(std::move(layout));
+    }
+  }
 }
 
 void Merge::initializeTreeOfLosers() {
@@ -60,7 +81,10 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        prefixSortLayout_.has_value() ? &prefixSortLayout_.value() : nullptr,
+        outputBatchSize_));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -88,8 +112,9 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
     return BlockingReason::kNotBlocked;
   }
 
-  // No merging is needed if there is only one source.
-  if (streams_.empty() && sources_.size() > 1) {
+  // No merging is needed if there is only one source or if the sources are
+  // read one after the other.
+  if (streams_.empty() && sources_.size() > 1 && !concatenateSources_) {
     initializeTreeOfLosers();
   }
 
@@ -117,18 +142,25 @@ RowVectorPtr Merge::getOutput() {
     return nullptr;
   }
 
-  // No merging is needed if there is only one source.
-  if (sources_.size() == 1) {
-    ContinueFuture future;
-    RowVectorPtr data;
-    auto reason = sources_[0]->next(data, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      sourceBlockingFutures_.emplace_back(std::move(future));
-      return nullptr;
+  // No merging is needed if there is only one source or if the sources hold
+  // consecutive key ranges.
+  if (sources_.size() == 1 || concatenateSources_) {
+    while (currentSource_ < sources_.size()) {
+      ContinueFuture future;
+      RowVectorPtr data;
+      auto reason = sources_[currentSource_]->next(data, &future);
+      if (reason != BlockingReason::kNotBlocked) {
+        sourceBlockingFutures_.emplace_back(std::move(future));
+        return nullptr;
+      }
+      if (data != nullptr) {
+        return data;
+      }
+      ++currentSource_;
     }
 
-    finished_ = data == nullptr;
-    return data;
+    finished_ = true;
+    return nullptr;
   }
 
   if (!output_) {
@@ -189,7 +221,18 @@ void Merge::close() {
 
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
-  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+  size_t firstKey = 0;
+  if (prefixSortLayout_ != nullptr) {
+    if (const auto result = PrefixSort::compareNormalizedKeys(
+            *prefixSortLayout_, currentPrefix(), otherCursor.currentPrefix())) {
+      return result < 0;
+    }
+    if (!prefixSortLayout_->hasNonNormalizedKey) {
+      return false;
+    }
+    firstKey = prefixSortLayout_->firstTieBreakKey();
+  }
+  for (auto i = firstKey; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
@@ -263,10 +306,25 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    if (prefixSortLayout_ != nullptr) {
+      encodePrefixes();
+    }
   }
   return false;
 }
 
+void SourceStream::encodePrefixes() {
+  const auto numRows = data_->size();
+  prefixes_.resize(
+      numRows * prefixSortLayout_->normalizedBufferSize / sizeof(uint64_t));
+  std::vector<const BaseVector*> keys(keyColumns_.begin(), keyColumns_.end());
+  PrefixSort::encodeNormalizedKeys(
+      *prefixSortLayout_,
+      keys,
+      numRows,
+      reinterpret_cast<char*>(prefixes_.data()));
+}
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -278,7 +336,8 @@ LocalMerge::LocalMerge(
           localMergeNode->sortingKeys(),
           localMergeNode->sortingOrders(),
           localMergeNode->id(),
-          "LocalMerge") {
+          "LocalMerge",
+          localMergeNode->rangePartitioned()) {
   VELOX_CHECK_EQ(
       operatorCtx_->driverCtx()->driverId,
       0,
@@ -304,7 +363,11 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange"),
+      serde_(
+          driverCtx->queryConfig().exchangeCompactRow()
+              ? Exchange::compactRowSerde()
+              : getVectorSerde()) {}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
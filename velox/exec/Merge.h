@@ -17,6 +17,7 @@
 
 #include "velox/exec/Exchange.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
@@ -25,7 +26,8 @@ class SourceStream;
 
 // Merge operator Implementation: This implementation uses priority queue
 // to perform a k-way merge of its inputs. It stops merging if any one of
-// its inputs is blocked.
+// its inputs is blocked. If 'concatenateSources' is true, the sources hold
+// consecutive key ranges and are returned one after the other.
 class Merge : public SourceOperator {
  public:
   Merge(
@@ -36,7 +38,8 @@ class Merge : public SourceOperator {
           sortingKeys,
       const std::vector<core::SortOrder>& sortingOrders,
       const std::string& planNodeId,
-      const std::string& operatorType);
+      const std::string& operatorType,
+      bool concatenateSources = false);
 
   BlockingReason isBlocked(ContinueFuture* future) override;
 
@@ -61,8 +64,17 @@ class Merge : public SourceOperator {
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
+  const bool concatenateSources_;
+
+  /// Index of the source being read when there is no merging.
+  size_t currentSource_{0};
+
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
+  /// Layout of the normalized prefixes of the sorting keys the streams compare
+  /// rows on. Not set if prefix sort is disabled or no key can be normalized.
+  std::optional<PrefixSortLayout> prefixSortLayout_;
+
   /// A list of cursors over batches of ordered source data. One per source.
   /// Aligned with 'sources'.
   std::vector<SourceStream*> streams_;
@@ -87,9 +99,11 @@ class SourceStream final : public MergeStream {
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+      const PrefixSortLayout* prefixSortLayout,
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
+        prefixSortLayout_{prefixSortLayout},
         outputRows_(outputBatchSize, false),
         sourceRows_(outputBatchSize) {
     keyColumns_.reserve(sortingKeys.size());
@@ -109,7 +123,8 @@ class SourceStream final : public MergeStream {
   }
 
   /// Returns true if current source row is less then current source row in
-  /// 'other'.
+  /// 'other'. Compares the normalized key prefixes first if
+  /// 'prefixSortLayout_' is set and the key columns only on ties.
   bool operator<(const MergeStream& other) const override;
 
   /// Advances to the next row. Returns true and appends a future to 'futures'
@@ -136,10 +151,20 @@ class SourceStream final : public MergeStream {
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Encodes the normalized keys of all rows of 'data_' into 'prefixes_'.
+  void encodePrefixes();
+
+  const char* currentPrefix() const {
+    return reinterpret_cast<const char*>(prefixes_.data()) +
+        currentSourceRow_ * prefixSortLayout_->normalizedBufferSize;
+  }
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  const PrefixSortLayout* const prefixSortLayout_;
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -147,6 +172,11 @@ class SourceStream final : public MergeStream {
   /// order as 'sortingKeys_'.
   std::vector<BaseVector*> keyColumns_;
 
+  /// Normalized key prefixes of the rows of 'data_', one entry of
+  /// 'prefixSortLayout_->normalizedBufferSize' bytes per row. Words so that
+  /// the entries are 8 byte aligned.
+  std::vector<uint64_t> prefixes_;
+
   /// Index of the current row.
   vector_size_t currentSourceRow_{0};
 
@@ -191,10 +221,16 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  /// Returns the serde for the pages of the remote sources.
+  VectorSerde* serde() const {
+    return serde_;
+  }
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
  private:
+  VectorSerde* const serde_;
   bool noMoreSplits_ = false;
   // Task Ids from all the splits we took to process so far.
   std::vector<std::string> remoteSourceTaskIds_;
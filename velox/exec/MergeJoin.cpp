@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+#include <numeric>
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -58,6 +59,22 @@ void MergeJoin::initialize() {
     rightKeys_.push_back(rightType->getChildIdx(key->name()));
   }
 
+  if (numKeys_ == 1) {
+    const auto kind = leftType->childAt(leftKeys_[0])->kind();
+    switch (kind) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        if (rightType->childAt(rightKeys_[0])->kind() == kind) {
+          singleIntegerKey_ = kind;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
   for (auto i = 0; i < leftType->size(); ++i) {
     auto name = leftType->nameOf(i);
     auto outIndex = outputType_->getChildIdxIfExists(name);
@@ -209,6 +226,98 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+namespace {
+template <typename T>
+const T* flatKeyValues(const RowVectorPtr& batch, column_index_t channel) {
+  const auto* key = batch->childAt(channel)->loadedVector();
+  if (key->encoding() != VectorEncoding::Simple::FLAT ||
+      key->mayHaveNulls()) {
+    return nullptr;
+  }
+  return key->asUnchecked<FlatVector<T>>()->rawValues();
+}
+
+// Returns the first row in [begin, end) for which 'skip' is false. 'skip' is
+// true for a prefix of the rows and false for the rest.
+template <typename T, typename TSkip>
+vector_size_t exponentialSearch(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    TSkip skip) {
+  if (begin >= end || !skip(values[begin])) {
+    return begin;
+  }
+  // 'low' is the last row known to be skipped.
+  vector_size_t low = begin;
+  vector_size_t high;
+  for (vector_size_t step = 1;; step *= 2) {
+    high = low + step;
+    if (high >= end) {
+      high = end;
+      break;
+    }
+    if (!skip(values[high])) {
+      break;
+    }
+    low = high;
+  }
+  return std::partition_point(values + low + 1, values + high, skip) - values;
+}
+
+template <typename T>
+std::optional<vector_size_t> searchKeyImpl(
+    const RowVectorPtr& batch,
+    column_index_t key,
+    vector_size_t begin,
+    const RowVectorPtr& otherBatch,
+    column_index_t otherKey,
+    vector_size_t otherIndex,
+    bool upper) {
+  const auto* values = flatKeyValues<T>(batch, key);
+  const auto* otherValues = flatKeyValues<T>(otherBatch, otherKey);
+  if (values == nullptr || otherValues == nullptr) {
+    return std::nullopt;
+  }
+  const T value = otherValues[otherIndex];
+  if (upper) {
+    return exponentialSearch(
+        values, begin, batch->size(), [&](T x) { return !(value < x); });
+  }
+  return exponentialSearch(
+      values, begin, batch->size(), [&](T x) { return x < value; });
+}
+} // namespace
+
+std::optional<vector_size_t> MergeJoin::searchKey(
+    const std::vector<column_index_t>& keys,
+    const RowVectorPtr& batch,
+    vector_size_t begin,
+    const std::vector<column_index_t>& otherKeys,
+    const RowVectorPtr& otherBatch,
+    vector_size_t otherIndex,
+    bool upper) const {
+  if (!singleIntegerKey_.has_value()) {
+    return std::nullopt;
+  }
+  switch (singleIntegerKey_.value()) {
+    case TypeKind::TINYINT:
+      return searchKeyImpl<int8_t>(
+          batch, keys[0], begin, otherBatch, otherKeys[0], otherIndex, upper);
+    case TypeKind::SMALLINT:
+      return searchKeyImpl<int16_t>(
+          batch, keys[0], begin, otherBatch, otherKeys[0], otherIndex, upper);
+    case TypeKind::INTEGER:
+      return searchKeyImpl<int32_t>(
+          batch, keys[0], begin, otherBatch, otherKeys[0], otherIndex, upper);
+    case TypeKind::BIGINT:
+      return searchKeyImpl<int64_t>(
+          batch, keys[0], begin, otherBatch, otherKeys[0], otherIndex, upper);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -223,9 +332,13 @@ bool MergeJoin::findEndOfMatch(
   auto numInput = input->size();
 
   vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
+  if (auto end = searchKey(keys, input, 0, keys, prevInput, prevIndex, true)) {
+    endIndex = end.value();
+  } else {
+    while (endIndex < numInput &&
+           compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
+      ++endIndex;
+    }
   }
 
   if (endIndex == numInput) {
@@ -342,6 +455,10 @@ bool MergeJoin::prepareOutput(
     return false;
   }
 
+  if (filter_ == nullptr) {
+    outputBatchSize_ = adaptiveOutputBatchRows();
+  }
+
   // If output is nullptr, first allocate dictionary indices for the left and
   // right side projections.
   leftIndices_ = allocateIndices(outputBatchSize_, pool());
@@ -491,6 +608,21 @@ bool MergeJoin::addToOutput() {
           rightEnd = rightStart + 1;
         }
 
+        if (!filter_ && !isRightFlattened_) {
+          // Without a filter the output rows are only dictionary indices into
+          // 'left' and 'right'. Add as many of the matching right rows as fit
+          // at once.
+          const auto numRows =
+              std::min(rightEnd - rightStart, outputBatchSize_ - outputSize_);
+          std::fill_n(rawLeftIndices_ + outputSize_, numRows, i);
+          std::iota(
+              rawRightIndices_ + outputSize_,
+              rawRightIndices_ + outputSize_ + numRows,
+              rightStart);
+          outputSize_ += numRows;
+          rightStart += numRows;
+        }
+
         for (auto j = rightStart; j < rightEnd; ++j) {
           if (outputSize_ == outputBatchSize_) {
             // If we run out of space in the current output_, we will need to
@@ -714,7 +846,26 @@ RowVectorPtr MergeJoin::doGetOutput() {
   auto compareResult = compare();
 
   for (;;) {
-    // Catch up input_ with rightInput_.
+    // Catch up input_ with rightInput_. Unless left join needs an output row
+    // for each of them, skip the left rows with smaller keys at once.
+    if (compareResult < 0 && !isLeftJoin(joinType_)) {
+      if (auto next = searchKey(
+              leftKeys_,
+              input_,
+              index_ + 1,
+              rightKeys_,
+              rightInput_,
+              rightIndex_,
+              false)) {
+        index_ = next.value();
+        if (index_ == input_->size()) {
+          // Ran out of rows on the left side.
+          input_ = nullptr;
+          return nullptr;
+        }
+        compareResult = compare();
+      }
+    }
     while (compareResult < 0) {
       if (isLeftJoin(joinType_)) {
         // If output_ is currently wrapping a different buffer, return it
@@ -740,6 +891,24 @@ RowVectorPtr MergeJoin::doGetOutput() {
     }
 
     // Catch up rightInput_ with input_.
+    if (compareResult > 0) {
+      if (auto next = searchKey(
+              rightKeys_,
+              rightInput_,
+              rightIndex_ + 1,
+              leftKeys_,
+              input_,
+              index_,
+              false)) {
+        rightIndex_ = next.value();
+        if (rightIndex_ == rightInput_->size()) {
+          // Ran out of rows on the right side.
+          rightInput_ = nullptr;
+          return nullptr;
+        }
+        compareResult = compare();
+      }
+    }
     while (compareResult > 0) {
       rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
@@ -754,8 +923,13 @@ RowVectorPtr MergeJoin::doGetOutput() {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
       vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
+      if (auto end = searchKey(
+              leftKeys_, input_, endIndex, leftKeys_, input_, index_, true)) {
+        endIndex = end.value();
+      } else {
+        while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
+          ++endIndex;
+        }
       }
 
       if (endIndex == input_->size()) {
@@ -766,9 +940,20 @@ RowVectorPtr MergeJoin::doGetOutput() {
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
       vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
+      if (auto end = searchKey(
+              rightKeys_,
+              rightInput_,
+              endRightIndex,
+              rightKeys_,
+              rightInput_,
+              rightIndex_,
+              true)) {
+        endRightIndex = end.value();
+      } else {
+        while (endRightIndex < rightInput_->size() &&
+               compareRight(endRightIndex) == 0) {
+          ++endRightIndex;
+        }
       }
 
       rightMatch_ = Match{
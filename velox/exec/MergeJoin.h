@@ -121,6 +121,21 @@ class MergeJoin : public Operator {
         rightKeys_, batch, index, rightKeys_, otherBatch, otherIndex);
   }
 
+  // Returns the first row at or after 'begin' in 'batch' whose key is greater
+  // than ('upper' is true) or not less than the key of row 'otherIndex' of
+  // 'otherBatch'. Probes rows at doubling distances from 'begin', so the cost
+  // is logarithmic in the number of rows skipped. Returns std::nullopt unless
+  // there is a single integer key and both key vectors are flat without
+  // nulls, in which case the caller compares row by row.
+  std::optional<vector_size_t> searchKey(
+      const std::vector<column_index_t>& keys,
+      const RowVectorPtr& batch,
+      vector_size_t begin,
+      const std::vector<column_index_t>& otherKeys,
+      const RowVectorPtr& otherBatch,
+      vector_size_t otherIndex,
+      bool upper) const;
+
   /// Describes a contiguous set of rows on the left or right side of the join
   /// with all join keys being the same. The set of rows may span multiple
   /// batches of input.
@@ -404,8 +419,11 @@ class MergeJoin : public Operator {
   // dictionaries wrapped around the right side input.
   bool isRightFlattened_{false};
 
-  // Maximum number of rows in the output batch.
-  const vector_size_t outputBatchSize_;
+  // Maximum number of rows in the output batch. Without a filter, adapted to
+  // the average size of the output rows whenever a new output batch is
+  // allocated. With a filter, fixed since the filter input and the left join
+  // tracker are sized once.
+  vector_size_t outputBatchSize_;
 
   // Type of join.
   const core::JoinType joinType_;
@@ -419,6 +437,10 @@ class MergeJoin : public Operator {
 
   std::vector<column_index_t> leftKeys_;
   std::vector<column_index_t> rightKeys_;
+
+  // Type of the join key if there is a single key of integer type. Enables
+  // searchKey().
+  std::optional<TypeKind> singleIntegerKey_;
   std::vector<IdentityProjection> leftProjections_;
   std::vector<IdentityProjection> rightProjections_;
 
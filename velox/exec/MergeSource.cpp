@@ -159,7 +159,7 @@ class MergeExchangeSource : public MergeSource {
     }
 
     if (!inputStream_->atEnd()) {
-      VectorStreamGroup::read(
+      mergeExchange_->serde()->deserialize(
           &inputStream_.value(),
           mergeExchange_->pool(),
           mergeExchange_->outputType(),
@@ -170,8 +170,8 @@ class MergeExchangeSource : public MergeSource {
       lockedStats->rawInputPositions += data->size();
     }
 
-    // Since VectorStreamGroup::read() may cause inputStream to be at end,
-    // check again and reset currentPage_ and inputStream_ here.
+    // Since deserialize() may cause inputStream to be at end, check again and
+    // reset currentPage_ and inputStream_ here.
     if (inputStream_->atEnd()) {
       // Reached end of the stream.
       currentPage_ = nullptr;
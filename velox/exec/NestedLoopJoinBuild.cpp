@@ -14,16 +14,20 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
-void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+void NestedLoopJoinBridge::setData(
+    std::vector<RowVectorPtr> buildVectors,
+    SpillFiles spillFiles) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
     buildVectors_ = std::move(buildVectors);
+    spillFiles_ = std::move(spillFiles);
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -41,6 +45,12 @@ std::optional<std::vector<RowVectorPtr>> NestedLoopJoinBridge::dataOrFuture(
   return std::nullopt;
 }
 
+SpillFiles NestedLoopJoinBridge::spillFiles() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(buildVectors_.has_value());
+  return spillFiles_;
+}
+
 NestedLoopJoinBuild::NestedLoopJoinBuild(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -50,7 +60,13 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      buildType_(joinNode->sources()[1]->outputType()),
+      retainedCompressionKind_(common::stringToCompressionKind(
+          driverCtx->queryConfig().retainedVectorCompressionKind())) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -58,7 +74,17 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
     for (auto& child : input->children()) {
       child->loadedVector();
     }
+    if (spiller_ != nullptr) {
+      spiller_->spill(0, input);
+      return;
+    }
     dataVectors_.emplace_back(std::move(input));
+
+    // Test-only spill path.
+    if (canSpill() && testingTriggerSpill(pool()->name())) {
+      Operator::ReclaimableSectionGuard guard(this);
+      memory::testingRunArbitration(pool());
+    }
   }
 }
 
@@ -84,6 +110,7 @@ void NestedLoopJoinBuild::noMoreInput() {
     return;
   }
 
+  SpillPartitionSet spillPartitionSet;
   {
     auto promisesGuard = folly::makeGuard([&]() {
       // Realize the promises so that the other Drivers (which were not
@@ -102,16 +129,114 @@ void NestedLoopJoinBuild::noMoreInput() {
           dataVectors_.begin(),
           build->dataVectors_.begin(),
           build->dataVectors_.end());
+      // The peer must not spill the vectors handed over to the probe side.
+      build->dataVectors_.clear();
+      for (auto& compressed : build->compressedVectors_) {
+        compressedVectors_.push_back(std::move(compressed));
+      }
+      build->compressedVectors_.clear();
+      build->finishSpill(spillPartitionSet);
     }
   }
+  finishSpill(spillPartitionSet);
+  decompress();
 
+  VELOX_CHECK_LE(spillPartitionSet.size(), 1);
+  SpillFiles spillFiles;
+  if (!spillPartitionSet.empty()) {
+    spillFiles = spillPartitionSet.begin()->second->files();
+  }
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(std::move(dataVectors_), std::move(spillFiles));
+  dataVectors_.clear();
 }
 
 bool NestedLoopJoinBuild::isFinished() {
   return !future_.valid() && noMoreInput_;
 }
+
+bool NestedLoopJoinBuild::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  for (const auto& vector : dataVectors_) {
+    reclaimableBytes += vector->retainedSize();
+  }
+  for (const auto& compressed : compressedVectors_) {
+    reclaimableBytes += compressed->compressedBytes();
+  }
+  return true;
+}
+
+void NestedLoopJoinBuild::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (dataVectors_.empty() && compressedVectors_.empty()) {
+    // Nothing to spill or the data has been handed over to the probe side.
+    return;
+  }
+  if (retainedCompressionKind_ != common::CompressionKind_NONE &&
+      !dataVectors_.empty()) {
+    compress();
+    return;
+  }
+  spill();
+}
+
+void NestedLoopJoinBuild::compress() {
+  uint64_t rawBytes{0};
+  uint64_t compressedBytes{0};
+  for (const auto& vector : dataVectors_) {
+    compressedVectors_.push_back(CompressedRowVector::compress(
+        vector, retainedCompressionKind_, pool()));
+    rawBytes += compressedVectors_.back()->rawBytes();
+    compressedBytes += compressedVectors_.back()->compressedBytes();
+  }
+  dataVectors_.clear();
+  addRuntimeStat(
+      kRetainedVectorRawBytes,
+      RuntimeCounter(rawBytes, RuntimeCounter::Unit::kBytes));
+  addRuntimeStat(
+      kRetainedVectorCompressedBytes,
+      RuntimeCounter(compressedBytes, RuntimeCounter::Unit::kBytes));
+}
+
+void NestedLoopJoinBuild::decompress() {
+  for (const auto& compressed : compressedVectors_) {
+    dataVectors_.push_back(compressed->decompress(pool()));
+  }
+  compressedVectors_.clear();
+}
+
+void NestedLoopJoinBuild::spill() {
+  if (spiller_ == nullptr) {
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kNestedLoopJoinBuild,
+        buildType_,
+        spillConfig(),
+        &spillStats_);
+  }
+  for (const auto& vector : dataVectors_) {
+    spiller_->spill(0, vector);
+  }
+  dataVectors_.clear();
+  for (const auto& compressed : compressedVectors_) {
+    spiller_->spill(0, compressed->decompress(pool()));
+  }
+  compressedVectors_.clear();
+}
+
+void NestedLoopJoinBuild::finishSpill(SpillPartitionSet& spillPartitionSet) {
+  if (spiller_ == nullptr) {
+    return;
+  }
+  spiller_->finishSpill(spillPartitionSet);
+  spiller_.reset();
+}
 } // namespace facebook::velox::exec
@@ -15,19 +15,31 @@
  */
 #pragma once
 
+#include "velox/exec/CompressedRowVector.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
 class NestedLoopJoinBridge : public JoinBridge {
  public:
-  void setData(std::vector<RowVectorPtr> buildVectors);
+  /// Hands over the build side to the probe side. 'spillFiles' are the files
+  /// of the build vectors that have been spilled, if any. These come after
+  /// 'buildVectors' in the build side.
+  void setData(
+      std::vector<RowVectorPtr> buildVectors,
+      SpillFiles spillFiles = {});
 
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the files of the spilled build vectors. Must be called after
+  /// dataOrFuture() has returned the build vectors.
+  SpillFiles spillFiles();
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  SpillFiles spillFiles_;
 };
 
 class NestedLoopJoinBuild : public Operator {
@@ -53,14 +65,50 @@ class NestedLoopJoinBuild : public Operator {
 
   bool isFinished() override;
 
+  /// The build vectors are allocated by the upstream operators, so that the
+  /// reclaimable bytes are their retained size rather than the reservation of
+  /// this operator's pool.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override {
     dataVectors_.clear();
+    compressedVectors_.clear();
+    spiller_.reset();
     Operator::close();
   }
 
  private:
+  // Moves 'dataVectors_' to 'compressedVectors_'.
+  void compress();
+
+  // Moves 'compressedVectors_' back to 'dataVectors_'.
+  void decompress();
+
+  // Spills 'dataVectors_' and 'compressedVectors_'. Once spilled, the next
+  // inputs are appended to the spill files instead of being kept in memory.
+  void spill();
+
+  // Finishes spilling of this and adds the spill files to 'spillPartitionSet'.
+  void finishSpill(SpillPartitionSet& spillPartitionSet);
+
+  const RowTypePtr buildType_;
+
+  // Compression of the vectors retained in memory on reclaim. If not NONE, a
+  // reclaim compresses 'dataVectors_' and spills only if there is nothing
+  // left to compress.
+  const common::CompressionKind retainedCompressionKind_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
+  // The build vectors that have been compressed on reclaim.
+  std::vector<std::unique_ptr<CompressedRowVector>> compressedVectors_;
+
+  // Set once 'dataVectors_' have been spilled.
+  std::unique_ptr<Spiller> spiller_;
+
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
   ContinueFuture future_{ContinueFuture::makeEmpty()};
@@ -53,7 +53,10 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinProbe"),
+          "NestedLoopJoinProbe",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinNode_(joinNode),
       joinType_(joinNode_->joinType()) {
@@ -72,6 +75,14 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    if (operatorCtx_->driverCtx()
+            ->queryConfig()
+            .nestedLoopJoinRangeLookupEnabled()) {
+      rangeKeys_ = RangeJoinKeys::create(
+          joinNode_->joinCondition(),
+          joinNode_->sources()[0]->outputType(),
+          joinNode_->sources()[1]->outputType());
+    }
   }
 
   joinNode_.reset();
@@ -103,6 +114,9 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
           buildMatched_[i].resizeFill(buildVectors_.value()[i]->size(), false);
         }
       }
+      if (rangeKeys_.has_value()) {
+        rangeIndices_.resize(buildVectors_->size());
+      }
 
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
@@ -116,6 +130,10 @@ void NestedLoopJoinProbe::close() {
   if (joinCondition_ != nullptr) {
     joinCondition_->clear();
   }
+  buildSpillReader_.reset();
+  spilledBuildVector_.reset();
+  spilledRangeIndex_.reset();
+  rangeIndices_.clear();
   buildVectors_.reset();
   Operator::close();
 }
@@ -135,6 +153,33 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (!buildSpillFiles_.empty()) {
+    VELOX_CHECK_NULL(buildSpillReader_);
+    std::vector<std::unique_ptr<BatchStream>> streams;
+    streams.reserve(buildSpillFiles_.size());
+    for (const auto& fileInfo : buildSpillFiles_) {
+      streams.push_back(FileSpillBatchStream::create(SpillReadFile::create(
+          fileInfo,
+          spillConfig()->readBufferSize,
+          pool(),
+          &spillStats_,
+          spillConfig()->executor)));
+    }
+    buildSpillReader_ = std::make_unique<UnorderedStreamReader<BatchStream>>(
+        std::move(streams));
+    readSpilledBuildVector();
+  }
+}
+
+void NestedLoopJoinProbe::readSpilledBuildVector() {
+  if (buildIndex_ < buildVectors_->size() || buildSpillReader_ == nullptr) {
+    return;
+  }
+  spilledRangeIndex_.reset();
+  if (!buildSpillReader_->nextBatch(spilledBuildVector_)) {
+    buildSpillReader_.reset();
+    spilledBuildVector_ = nullptr;
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -142,6 +187,7 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       state_ == ProbeOperatorState::kWaitForPeers) {
     return nullptr;
   }
+  outputBatchSize_ = adaptiveOutputBatchRows();
   RowVectorPtr output{nullptr};
   while (output == nullptr) {
     if (lastProbe_) {
@@ -181,8 +227,13 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
-    output = doMatch(probeCnt);
+    vector_size_t probeCnt;
+    if (rangeKeys_.has_value()) {
+      output = doRangeMatch(probeCnt);
+    } else {
+      probeCnt = getNumProbeRows();
+      output = doMatch(probeCnt);
+    }
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
         finishProbeInput();
@@ -276,6 +327,9 @@ void NestedLoopJoinProbe::finishProbeInput() {
   VELOX_CHECK_NOT_NULL(input_);
   input_.reset();
   buildIndex_ = 0;
+  buildSpillReader_.reset();
+  spilledBuildVector_ = nullptr;
+  spilledRangeIndex_.reset();
   if (!noMoreInput_) {
     return;
   }
@@ -344,7 +398,13 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   }
 
   buildVectors_ = std::move(buildData);
-  if (buildVectors_->empty()) {
+  buildSpillFiles_ =
+      operatorCtx_->task()
+          ->getNestedLoopJoinBridge(
+              operatorCtx_->driverCtx()->splitGroupId, planNodeId())
+          ->spillFiles();
+  VELOX_CHECK(buildSpillFiles_.empty() || !needsBuildMismatch(joinType_));
+  if (buildVectors_->empty() && buildSpillFiles_.empty()) {
     buildSideEmpty_ = true;
   }
   return true;
@@ -355,7 +415,7 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK(!hasProbedAllBuildData());
 
   const auto inputSize = input_->size();
-  auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
+  auto numBuildRows = buildVector()->size();
   vector_size_t numProbeRows;
   if (numBuildRows > outputBatchSize_) {
     numProbeRows = 1;
@@ -374,7 +434,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
   VELOX_CHECK_GT(probeCnt, 0);
   VELOX_CHECK(!hasProbedAllBuildData());
 
-  const auto buildSize = buildVectors_.value()[buildIndex_]->size();
+  const auto buildSize = buildVector()->size();
   const auto numOutputRows = probeCnt * buildSize;
   const bool probeCntChanged = (probeCnt != numPrevProbedRows_);
   numPrevProbedRows_ = probeCnt;
@@ -408,7 +468,7 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
       probeIndices_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      buildVector(),
       buildProjections,
       numOutputRows,
       buildIndices_);
@@ -426,8 +486,8 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   numPrevProbedRows_ = 0;
   do {
     ++buildIndex_;
-  } while (!hasProbedAllBuildData() &&
-           !buildVectors_.value()[buildIndex_]->size());
+    readSpilledBuildVector();
+  } while (!hasProbedAllBuildData() && !buildVector()->size());
   return hasProbedAllBuildData();
 }
 
@@ -445,7 +505,87 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       filterInputType_,
       filterProbeProjections_,
       filterBuildProjections_);
+  return evalJoinCondition(filterInput);
+}
+
+const RangeJoinIndex& NestedLoopJoinProbe::rangeIndex() {
+  if (buildIndex_ >= buildVectors_->size()) {
+    if (spilledRangeIndex_ == nullptr) {
+      spilledRangeIndex_ = std::make_unique<RangeJoinIndex>(
+          rangeKeys_.value(), spilledBuildVector_);
+    }
+    return *spilledRangeIndex_;
+  }
+  auto& index = rangeIndices_[buildIndex_];
+  if (index == nullptr) {
+    index = std::make_unique<RangeJoinIndex>(
+        rangeKeys_.value(), buildVectors_.value()[buildIndex_]);
+  }
+  return *index;
+}
+
+RowVectorPtr NestedLoopJoinProbe::doRangeMatch(vector_size_t& probeCnt) {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  const auto& index = rangeIndex();
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, outputBatchSize_, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, outputBatchSize_, pool());
+
+  vector_size_t numPairs{0};
+  probeCnt = 0;
+  for (auto row = probeRow_; row < input_->size(); ++row) {
+    auto [begin, end] = index.candidates(*input_, row);
+    begin += rangeOffset_;
+    const auto numCandidates = std::max<vector_size_t>(0, end - begin);
+    const auto numAdded = std::min<vector_size_t>(
+        numCandidates, outputBatchSize_ - numPairs);
+    for (auto i = 0; i < numAdded; ++i) {
+      rawProbeIndices[numPairs] = row;
+      rawBuildIndices[numPairs] = index.buildRow(begin + i);
+      ++numPairs;
+    }
+    if (numAdded < numCandidates) {
+      // Continues with the rest of the range of 'row' in the next batch.
+      rangeOffset_ += numAdded;
+      break;
+    }
+    rangeOffset_ = 0;
+    ++probeCnt;
+    if (numPairs == outputBatchSize_) {
+      break;
+    }
+  }
+  if (numPairs == 0) {
+    return nullptr;
+  }
+  addRuntimeStat("rangeLookupPairs", RuntimeCounter(numPairs));
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numPairs,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVector(),
+      filterBuildProjections_,
+      numPairs,
+      buildIndices_);
+  return evalJoinCondition(std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numPairs,
+      std::move(projectedChildren)));
+}
 
+RowVectorPtr NestedLoopJoinProbe::evalJoinCondition(
+    const RowVectorPtr& filterInput) {
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
   }
@@ -499,7 +639,7 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
       probeOutMapping_);
   projectChildren(
       projectedChildren,
-      buildVectors_.value()[buildIndex_],
+      buildVector(),
       buildProjections_,
       numOutputRows,
       buildOutMapping_);
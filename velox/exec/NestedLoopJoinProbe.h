@@ -18,6 +18,8 @@
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
+#include "velox/exec/RangeJoinIndex.h"
+#include "velox/exec/UnorderedStreamReader.h"
 
 namespace facebook::velox::exec {
 class NestedLoopJoinProbe : public Operator {
@@ -48,6 +50,12 @@ class NestedLoopJoinProbe : public Operator {
 
   void close() override;
 
+  /// The probe side only reads the spilled build side. It uses the spill
+  /// config to read the spill files but doesn't spill itself.
+  bool canReclaim() const override {
+    return false;
+  }
+
  private:
   // TODO: maybe consolidate initializeFilter routine across operators like
   // HashProbe and MergeJoin.
@@ -82,14 +90,40 @@ class NestedLoopJoinProbe : public Operator {
   // buildMatched_ accordingly.
   RowVectorPtr doMatch(vector_size_t probeCnt);
 
+  // Like doMatch() but pairs the probe rows from 'probeRow_' only with the
+  // build rows that 'rangeKeys_' allow. Sets 'probeCnt' to the number of
+  // probe rows that are done with the current build vector.
+  RowVectorPtr doRangeMatch(vector_size_t& probeCnt);
+
+  // Evaluates joinCondition on 'filterInput', the rows at 'probeIndices_'
+  // and 'buildIndices_', and returns the output for the passing pairs.
+  RowVectorPtr evalJoinCondition(const RowVectorPtr& filterInput);
+
+  // Returns the RangeJoinIndex of the build vector at 'buildIndex_'.
+  const RangeJoinIndex& rangeIndex();
+
   // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
   // Returns true if 'buildIndex_' points to the end of 'buildData_'.
   bool advanceProbeRows(vector_size_t probeCnt);
 
   bool hasProbedAllBuildData() const {
-    return (buildIndex_ == buildVectors_.value().size());
+    return buildIndex_ >= buildVectors_.value().size() &&
+        spilledBuildVector_ == nullptr;
   }
 
+  // Returns the build side vector at 'buildIndex_'. This is a vector read from
+  // 'buildSpillFiles_' if 'buildIndex_' is past the in-memory build vectors.
+  const RowVectorPtr& buildVector() const {
+    return buildIndex_ < buildVectors_.value().size()
+        ? buildVectors_.value()[buildIndex_]
+        : spilledBuildVector_;
+  }
+
+  // Reads the next spilled build vector into 'spilledBuildVector_' if
+  // 'buildIndex_' is past the in-memory build vectors. Sets
+  // 'spilledBuildVector_' to null after the last one.
+  void readSpilledBuildVector();
+
   // Wraps rows of 'data' that are not selected in 'matched' and projects
   // to the output according to 'projections'. 'nullProjections' is used to
   // create null column vectors in output for outer join. 'unmatchedMapping' is
@@ -121,8 +155,9 @@ class NestedLoopJoinProbe : public Operator {
   }
 
  private:
-  // Maximum number of rows in the output batch.
-  const uint32_t outputBatchSize_;
+  // Maximum number of rows in the output batch. Adapted to the average size of
+  // the output rows at the start of each getOutput() call.
+  uint32_t outputBatchSize_;
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
   const core::JoinType joinType_;
 
@@ -134,6 +169,17 @@ class NestedLoopJoinProbe : public Operator {
   RowTypePtr filterInputType_;
   SelectivityVector filterInputRows_;
 
+  // Set if the join condition bounds build columns by probe columns and
+  // range lookups are enabled.
+  std::optional<RangeJoinKeys> rangeKeys_;
+  // Sorted build rows of each in-memory build vector, made on first use.
+  std::vector<std::unique_ptr<RangeJoinIndex>> rangeIndices_;
+  // Sorted build rows of 'spilledBuildVector_'.
+  std::unique_ptr<RangeJoinIndex> spilledRangeIndex_;
+  // Position in the candidate build rows of the probe row at 'probeRow_' to
+  // continue from if the previous output batch filled up in its range.
+  vector_size_t rangeOffset_{0};
+
   // Probe side state
   // Input row to process on next call to getOutput().
   vector_size_t probeRow_{0};
@@ -153,6 +199,12 @@ class NestedLoopJoinProbe : public Operator {
 
   // Build side state
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  // Files of the build vectors spilled by the build side. These are re-read
+  // after 'buildVectors_' for each probe input.
+  SpillFiles buildSpillFiles_;
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> buildSpillReader_;
+  // The spilled build vector being processed.
+  RowVectorPtr spilledBuildVector_;
   bool buildSideEmpty_{false};
   // Index into buildData_ for the build side vector to process on next call to
   // getOutput().
@@ -41,12 +41,30 @@ OperatorCtx::OperatorCtx(
 
 core::ExecCtx* OperatorCtx::execCtx() const {
   if (!execCtx_) {
+    VectorPool* sharedVectorPool{nullptr};
+    const auto& queryConfig = driverCtx_->queryConfig();
+    if (queryConfig.sharedDriverVectorPool() &&
+        queryConfig.isExpressionEvaluationCacheEnabled()) {
+      if (driverCtx_->sharedVectorPool == nullptr) {
+        driverCtx_->sharedVectorPool = std::make_unique<VectorPool>(pool_);
+        ownsSharedVectorPool_ = true;
+      }
+      sharedVectorPool = driverCtx_->sharedVectorPool.get();
+    }
     execCtx_ = std::make_unique<core::ExecCtx>(
-        pool_, driverCtx_->task->queryCtx().get());
+        pool_, driverCtx_->task->queryCtx().get(), sharedVectorPool);
   }
   return execCtx_.get();
 }
 
+const VectorPool* OperatorCtx::reportedVectorPool() const {
+  if (execCtx_ == nullptr ||
+      (execCtx_->hasSharedVectorPool() && !ownsSharedVectorPool_)) {
+    return nullptr;
+  }
+  return execCtx_->vectorPool();
+}
+
 std::shared_ptr<connector::ConnectorQueryCtx>
 OperatorCtx::createConnectorQueryCtx(
     const std::string& connectorId,
@@ -273,6 +291,26 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+std::optional<uint64_t> Operator::averageOutputRowSize() const {
+  const auto lockedStats = stats_.rlock();
+  if (lockedStats->outputPositions == 0) {
+    return std::nullopt;
+  }
+  return lockedStats->outputBytes / lockedStats->outputPositions;
+}
+
+uint32_t Operator::adaptiveOutputBatchRows() {
+  const auto rowSize = averageOutputRowSize();
+  const auto numRows = outputBatchRows(rowSize);
+  if (rowSize.has_value()) {
+    addRuntimeStat(
+        kEstimatedOutputBatchBytes,
+        RuntimeCounter(
+            numRows * rowSize.value(), RuntimeCounter::Unit::kBytes));
+  }
+  return numRows;
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -290,6 +328,19 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recordVectorPoolStats() {
+  const auto* vectorPool = operatorCtx_->reportedVectorPool();
+  if (vectorPool == nullptr || vectorPool->stats().numGets == 0) {
+    return;
+  }
+  const auto& vectorPoolStats = vectorPool->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      kVectorPoolGets, RuntimeCounter(vectorPoolStats.numGets));
+  lockedStats->addRuntimeStat(
+      kVectorPoolReused, RuntimeCounter(vectorPoolStats.numReused));
+}
+
 void Operator::recordSpillStats() {
   const auto lockedSpillStats = spillStats_.wlock();
   auto lockedStats = stats_.wlock();
@@ -348,12 +399,32 @@ void Operator::recordSpillStats() {
                 Timestamp::kNanosecondsInMicrosecond),
             RuntimeCounter::Unit::kNanos});
   }
+  if (lockedSpillStats->spillWriteWaitTimeUs != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillWriteWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(
+                lockedSpillStats->spillWriteWaitTimeUs *
+                Timestamp::kNanosecondsInMicrosecond),
+            RuntimeCounter::Unit::kNanos});
+  }
   if (lockedSpillStats->spillRuns != 0) {
     lockedStats->addRuntimeStat(
         kSpillRuns,
         RuntimeCounter{static_cast<int64_t>(lockedSpillStats->spillRuns)});
     common::updateGlobalSpillRunStats(lockedSpillStats->spillRuns);
   }
+  if (lockedSpillStats->spilledRemoteFiles != 0) {
+    lockedStats->addRuntimeStat(
+        kSpilledRemoteBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledRemoteBytes),
+            RuntimeCounter::Unit::kBytes});
+    lockedStats->addRuntimeStat(
+        kSpilledRemoteFiles,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledRemoteFiles)});
+  }
 
   if (lockedSpillStats->spillMaxLevelExceededCount != 0) {
     lockedStats->addRuntimeStat(
@@ -387,6 +458,15 @@ void Operator::recordSpillStats() {
             RuntimeCounter::Unit::kNanos});
   }
 
+  if (lockedSpillStats->spillReadWaitTimeUs != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillReadWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spillReadWaitTimeUs) *
+                Timestamp::kNanosecondsInMicrosecond,
+            RuntimeCounter::Unit::kNanos});
+  }
+
   if (lockedSpillStats->spillDeserializationTimeUs != 0) {
     lockedStats->addRuntimeStat(
         kSpillDeserializationTime,
@@ -25,6 +25,8 @@
 
 namespace facebook::velox::exec {
 
+class SplitResultConsumer;
+
 // Represents a column that is copied from input to output, possibly
 // with cardinality change, i.e. values removed or duplicated.
 struct IdentityProjection {
@@ -259,6 +261,11 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Returns the vector pool whose stats 'this' reports: the pool of
+  /// 'execCtx()' if it is not shared, the driver's shared pool if 'this'
+  /// created it, nullptr otherwise.
+  const VectorPool* reportedVectorPool() const;
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -278,6 +285,9 @@ class OperatorCtx {
 
   // These members are created on demand.
   mutable std::unique_ptr<core::ExecCtx> execCtx_;
+
+  // True if 'this' created the vector pool shared by the driver.
+  mutable bool ownsSharedVectorPool_{false};
 };
 
 /// Query operator
@@ -338,16 +348,46 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillFlushTime{"spillFlushWallNanos"};
   static inline const std::string kSpillWrites{"spillWrites"};
   static inline const std::string kSpillWriteTime{"spillWriteWallNanos"};
+  static inline const std::string kSpillWriteWaitTime{
+      "spillWriteWaitWallNanos"};
   static inline const std::string kSpillRuns{"spillRuns"};
+  static inline const std::string kSpilledRemoteBytes{"spilledRemoteBytes"};
+  static inline const std::string kSpilledRemoteFiles{"spilledRemoteFiles"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
   /// The spill read stats.
   static inline const std::string kSpillReadBytes{"spillReadBytes"};
   static inline const std::string kSpillReads{"spillReads"};
   static inline const std::string kSpillReadTime{"spillReadWallNanos"};
+  static inline const std::string kSpillReadWaitTime{"spillReadWaitWallNanos"};
   static inline const std::string kSpillDeserializationTime{
       "spillDeserializationWallNanos"};
 
+  /// The number of vectors requested from the vector pool of the operator and
+  /// the number of these that were recycled.
+  static inline const std::string kVectorPoolGets{"vectorPoolGets"};
+  static inline const std::string kVectorPoolReused{"vectorPoolReused"};
+
+  /// The retained size of the input vectors an operator compressed in memory
+  /// on reclaim and the size of their compressed form.
+  static inline const std::string kRetainedVectorRawBytes{
+      "retainedVectorRawBytes"};
+  static inline const std::string kRetainedVectorCompressedBytes{
+      "retainedVectorCompressedBytes"};
+
+  /// The hardware counts of the addInput and getOutput calls of the
+  /// operator. Reported if the query config track_operator_hardware_counters
+  /// is true.
+  static inline const std::string kHwCycles{"hwCycles"};
+  static inline const std::string kHwInstructions{"hwInstructions"};
+  static inline const std::string kHwCacheMisses{"hwCacheMisses"};
+  static inline const std::string kHwBranchMisses{"hwBranchMisses"};
+
+  /// The expected size in bytes of an output batch of an operator that sizes
+  /// its output batches from the average size of the rows it has produced.
+  static inline const std::string kEstimatedOutputBatchBytes{
+      "estimatedOutputBatchBytes"};
+
   /// 'operatorId' is the initial index of the 'this' in the Driver's list of
   /// Operators. This is used as in index into OperatorStats arrays in the Task.
   /// 'planNodeId' is a query-level unique identifier of the PlanNode to which
@@ -390,6 +430,15 @@ class Operator : public BaseRuntimeStatWriter {
   /// @param input Non-empty input vector.
   virtual void addInput(RowVectorPtr input) = 0;
 
+  /// Returns the memory in bytes that 'this' wants to reserve from its memory
+  /// pool before addInput(input), or zero if it needs no reservation. If the
+  /// query has not enough free capacity for the reservation, the driver makes
+  /// it off thread before it calls addInput(), see
+  /// QueryConfig::kAsyncMemoryReservationEnabled.
+  virtual uint64_t inputReservationBytes(const RowVectorPtr& /*input*/) {
+    return 0;
+  }
+
   /// Informs 'this' that addInput will no longer be called. This means
   /// that any partial state kept by 'this' should be returned by
   /// the next call(s) to getOutput. Not used if operator is a source operator,
@@ -453,6 +502,21 @@ class Operator : public BaseRuntimeStatWriter {
         toString());
   }
 
+  /// Informs a source operator that only the first 'numRows' of its output
+  /// rows are consumed, e.g. by a downstream Limit. The operator may then read
+  /// less data and finish early. Ignored by default.
+  virtual void setOutputLimit(int64_t /*numRows*/) {}
+
+  /// Informs a source operator that its output feeds 'consumer' through
+  /// deterministic operators only, so that the results of 'consumer' for each
+  /// split can be cached under 'fragmentKey' and the split's cache key. See
+  /// SplitResultCache. Returns false if the operator doesn't support this.
+  virtual bool setSplitResultConsumer(
+      SplitResultConsumer* /*consumer*/,
+      const std::string& /*fragmentKey*/) {
+    return false;
+  }
+
   /// Returns a list of identify projections, e.g. columns that are projected
   /// as-is possibly after applying a filter.
   const std::vector<IdentityProjection>& identityProjections() const {
@@ -465,6 +529,7 @@ class Operator : public BaseRuntimeStatWriter {
     input_ = nullptr;
     results_.clear();
     recordSpillStats();
+    recordVectorPoolStats();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -478,6 +543,11 @@ class Operator : public BaseRuntimeStatWriter {
     return false;
   }
 
+  // Returns true if 'this' produces exactly one output row per input row.
+  virtual bool preservesRowCount() const {
+    return false;
+  }
+
   /// Returns copy of operator stats. If 'clear' is true, the function also
   /// clears the operator stats after retrieval.
   virtual OperatorStats stats(bool clear);
@@ -742,9 +812,27 @@ class Operator : public BaseRuntimeStatWriter {
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns the average size in bytes of the rows this operator has returned
+  /// so far, computed from the flat size of its output vectors. Returns
+  /// std::nullopt before the first output vector.
+  std::optional<uint64_t> averageOutputRowSize() const;
+
+  /// Returns the number of rows for the next output batch of an operator that
+  /// does not know its output row size upfront, e.g. a join or unnest. Uses
+  /// the average size of the rows returned so far, so that batches of wide
+  /// rows stay within preferredOutputBatchBytes and batches of narrow rows are
+  /// not limited to preferredOutputBatchRows. Returns preferredOutputBatchRows
+  /// before the first output vector. Records the expected batch size in the
+  /// kEstimatedOutputBatchBytes runtime stat.
+  uint32_t adaptiveOutputBatchRows();
+
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
+  /// Invoked on close to record the stats of the vector pool of the operator
+  /// in operator stats.
+  void recordVectorPoolStats();
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
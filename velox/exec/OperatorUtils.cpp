@@ -377,7 +377,11 @@ void addOperatorRuntimeStats(
   } else {
     VELOX_CHECK_EQ(stats.at(name).unit, value.unit);
   }
-  stats.at(name).addValue(value.value);
+  auto& metric = stats.at(name);
+  if (UNLIKELY(value.histogram)) {
+    metric.enableHistogram();
+  }
+  metric.addValue(value.value);
 }
 
 void aggregateOperatorRuntimeStats(
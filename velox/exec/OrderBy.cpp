@@ -66,7 +66,9 @@ OrderBy::OrderBy(
       pool(),
       &nonReclaimableSection_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      driverCtx->prefixSortConfig(),
+      driverCtx->queryConfig().orderByStringCompression());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
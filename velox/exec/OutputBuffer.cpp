@@ -21,6 +21,11 @@ namespace facebook::velox::exec {
 
 using core::PartitionedOutputNode;
 
+namespace {
+// Minimum time of a measurement of the consumption rate of a destination.
+constexpr uint64_t kMinRateIntervalUs = 100'000;
+} // namespace
+
 void ArbitraryBuffer::noMoreData() {
   // Drop duplicate end markers.
   if (!pages_.empty() && pages_.back() == nullptr) {
@@ -113,10 +118,60 @@ DestinationBuffer::Data DestinationBuffer::getData(
     DataAvailableCallback notify,
     DataConsumerActiveCheckCallback activeCheck,
     ArbitraryBuffer* arbitraryBuffer) {
+  return getDataOrPages(
+      maxBytes,
+      sequence,
+      false,
+      std::move(notify),
+      nullptr,
+      std::move(activeCheck),
+      arbitraryBuffer);
+}
+
+DestinationBuffer::Data DestinationBuffer::getPages(
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify,
+    ArbitraryBuffer* arbitraryBuffer) {
+  return getDataOrPages(
+      maxBytes,
+      sequence,
+      true,
+      nullptr,
+      std::move(notify),
+      nullptr,
+      arbitraryBuffer);
+}
+
+DestinationBuffer::Data DestinationBuffer::getDataOrPages(
+    uint64_t maxBytes,
+    int64_t sequence,
+    bool asPages,
+    DataAvailableCallback notify,
+    PagesAvailableCallback notifyPages,
+    DataConsumerActiveCheckCallback activeCheck,
+    ArbitraryBuffer* arbitraryBuffer) {
   VELOX_CHECK_GE(
       sequence, sequence_, "Get received for an already acknowledged item");
+  if (rateStartUs_ == 0) {
+    rateStartUs_ = getCurrentTimeMicro();
+  }
   if (arbitraryBuffer != nullptr) {
-    loadData(arbitraryBuffer, maxBytes);
+    // Takes only the bytes this fetch is missing, so that the rest of the
+    // arbitrary buffer stays available to the other destinations instead of
+    // waiting behind a slow consumer.
+    uint64_t availableBytes = 0;
+    for (auto i = sequence - sequence_;
+         i < data_.size() && availableBytes < maxBytes;
+         ++i) {
+      if (data_[i] == nullptr) {
+        break;
+      }
+      availableBytes += data_[i]->size();
+    }
+    if (availableBytes < maxBytes) {
+      loadData(arbitraryBuffer, maxBytes - availableBytes);
+    }
   }
 
   if (sequence - sequence_ >= data_.size()) {
@@ -131,10 +186,11 @@ DestinationBuffer::Data DestinationBuffer::getData(
         arbitraryBuffer->getAvailablePageSizes(remainingBytes);
       }
       if (!remainingBytes.empty()) {
-        return {{}, std::move(remainingBytes), true};
+        return {{}, {}, std::move(remainingBytes), true};
       }
     }
     notify_ = std::move(notify);
+    notifyPages_ = std::move(notifyPages);
     aliveCheck_ = std::move(activeCheck);
     if (sequence - sequence_ > data_.size()) {
       notifySequence_ = std::min(notifySequence_, sequence);
@@ -146,6 +202,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
   }
 
   std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPage>> pages;
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
@@ -153,10 +210,18 @@ DestinationBuffer::Data DestinationBuffer::getData(
       // nullptr is used as end marker
       if (data_[i] == nullptr) {
         VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
-        data.push_back(nullptr);
+        if (asPages) {
+          pages.push_back(nullptr);
+        } else {
+          data.push_back(nullptr);
+        }
         break;
       }
-      data.push_back(data_[i]->getIOBuf());
+      if (asPages) {
+        pages.push_back(data_[i]);
+      } else {
+        data.push_back(data_[i]->getIOBuf());
+      }
       resultBytes += data_[i]->size();
       if (resultBytes >= maxBytes) {
         ++i;
@@ -178,10 +243,14 @@ DestinationBuffer::Data DestinationBuffer::getData(
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
   }
-  if (data.empty() && remainingBytes.empty() && atEnd) {
-    data.push_back(nullptr);
+  if (data.empty() && pages.empty() && remainingBytes.empty() && atEnd) {
+    if (asPages) {
+      pages.push_back(nullptr);
+    } else {
+      data.push_back(nullptr);
+    }
   }
-  return {std::move(data), std::move(remainingBytes), true};
+  return {std::move(data), std::move(pages), std::move(remainingBytes), true};
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
@@ -197,15 +266,24 @@ void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
 }
 
 DataAvailable DestinationBuffer::getAndClearNotify() {
-  if (notify_ == nullptr) {
+  if (!hasNotify()) {
     VELOX_CHECK_NULL(aliveCheck_);
     return DataAvailable();
   }
   DataAvailable result;
   result.callback = notify_;
+  result.pagesCallback = notifyPages_;
   result.sequence = notifySequence_;
-  auto data = getData(notifyMaxBytes_, notifySequence_, nullptr, nullptr);
+  auto data = getDataOrPages(
+      notifyMaxBytes_,
+      notifySequence_,
+      notifyPages_ != nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr);
   result.data = std::move(data.data);
+  result.pages = std::move(data.pages);
   result.remainingBytes = std::move(data.remainingBytes);
   clearNotify();
   return result;
@@ -213,20 +291,21 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
 
 void DestinationBuffer::clearNotify() {
   notify_ = nullptr;
+  notifyPages_ = nullptr;
   aliveCheck_ = nullptr;
   notifySequence_ = 0;
   notifyMaxBytes_ = 0;
 }
 
 void DestinationBuffer::finish() {
-  VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
+  VELOX_CHECK(!hasNotify(), "notify must be cleared before finish");
   VELOX_CHECK(data_.empty(), "data must be fetched before finish");
   stats_.finished = true;
 }
 
 void DestinationBuffer::maybeLoadData(ArbitraryBuffer* buffer) {
   VELOX_CHECK(!buffer->empty() || buffer->hasNoMoreData());
-  if (notify_ == nullptr) {
+  if (!hasNotify()) {
     return;
   }
   if (aliveCheck_ != nullptr && !aliveCheck_()) {
@@ -278,9 +357,46 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
   data_.erase(data_.begin(), data_.begin() + numDeleted);
   sequence_ += numDeleted;
+  int64_t freedBytes = 0;
+  for (const auto& page : freed) {
+    freedBytes += page->size();
+  }
+  recordConsumed(freedBytes);
   return freed;
 }
 
+void DestinationBuffer::recordConsumed(int64_t bytes) {
+  if (rateStartUs_ == 0) {
+    return;
+  }
+  rateBytes_ += bytes;
+  const auto nowUs = getCurrentTimeMicro();
+  const auto intervalUs = nowUs - rateStartUs_;
+  if (intervalUs < kMinRateIntervalUs) {
+    return;
+  }
+  const int64_t rate = rateBytes_ * 1'000'000 / intervalUs;
+  stats_.bytesPerSecond = stats_.bytesPerSecond == 0
+      ? rate
+      : (stats_.bytesPerSecond + rate) / 2;
+  rateStartUs_ = nowUs;
+  rateBytes_ = 0;
+}
+
+double DestinationBuffer::consumptionRate(uint64_t nowUs) const {
+  if (rateStartUs_ == 0 || nowUs <= rateStartUs_) {
+    return stats_.bytesPerSecond;
+  }
+  const auto intervalUs = nowUs - rateStartUs_;
+  if (intervalUs < 2 * kMinRateIntervalUs) {
+    return stats_.bytesPerSecond;
+  }
+  // A consumer that stopped acknowledging is as slow as it has been since the
+  // last measurement.
+  return std::min<double>(
+      stats_.bytesPerSecond, rateBytes_ * 1'000'000.0 / intervalUs);
+}
+
 std::vector<std::shared_ptr<SerializedPage>>
 DestinationBuffer::deleteResults() {
   std::vector<std::shared_ptr<SerializedPage>> freed;
@@ -303,7 +419,7 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+      << ", " << (hasNotify() ? "notify registered, " : "") << this << "]";
   return out.str();
 }
 
@@ -521,19 +637,34 @@ void OutputBuffer::enqueueArbitraryOutputLocked(
 
   arbitraryBuffer_->enqueue(std::move(data));
   VELOX_CHECK_LT(nextArbitraryLoadBufferIndex_, buffers_.size());
+
+  // Offers the data to the waiting destinations with the fastest consumers
+  // first. Destinations of the same rate are served round robin.
+  const auto nowUs = getCurrentTimeMicro();
+  waitingArbitraryBuffers_.clear();
   int32_t bufferId = nextArbitraryLoadBufferIndex_;
   for (int32_t i = 0; i < buffers_.size();
        ++i, bufferId = (bufferId + 1) % buffers_.size()) {
+    auto* buffer = buffers_[bufferId].get();
+    if (buffer != nullptr && buffer->hasNotify()) {
+      waitingArbitraryBuffers_.emplace_back(
+          buffer->consumptionRate(nowUs), bufferId);
+    }
+  }
+  std::stable_sort(
+      waitingArbitraryBuffers_.begin(),
+      waitingArbitraryBuffers_.end(),
+      [](const auto& left, const auto& right) {
+        return left.first > right.first;
+      });
+  for (const auto& [rate, waitingId] : waitingArbitraryBuffers_) {
     if (arbitraryBuffer_->empty()) {
-      nextArbitraryLoadBufferIndex_ = bufferId;
       break;
     }
-    auto* buffer = buffers_[bufferId].get();
-    if (buffer == nullptr) {
-      continue;
-    }
+    auto* buffer = buffers_[waitingId].get();
     buffer->maybeLoadData(arbitraryBuffer_.get());
     dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
+    nextArbitraryLoadBufferIndex_ = (waitingId + 1) % buffers_.size();
   }
 }
 
@@ -741,6 +872,41 @@ void OutputBuffer::getData(
   }
 }
 
+void OutputBuffer::getPages(
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify) {
+  DestinationBuffer::Data data;
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+
+    if (!isPartitioned() && destination >= buffers_.size()) {
+      addOutputBuffersLocked(destination + 1);
+    }
+
+    VELOX_CHECK_LT(destination, buffers_.size());
+    auto* buffer = buffers_[destination].get();
+    if (buffer) {
+      freed = buffer->acknowledge(sequence, true);
+      updateAfterAcknowledgeLocked(freed, promises);
+      data =
+          buffer->getPages(maxBytes, sequence, notify, arbitraryBuffer_.get());
+    } else {
+      data.pages.emplace_back(nullptr);
+      data.immediate = true;
+      VLOG(1) << "getPages received after deleteResults for destination "
+              << destination << " and sequence " << sequence;
+    }
+  }
+  releaseAfterAcknowledge(freed, promises);
+  if (data.immediate) {
+    notify(std::move(data.pages), sequence, std::move(data.remainingBytes));
+  }
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -29,6 +29,14 @@ using DataAvailableCallback = std::function<void(
     int64_t sequence,
     std::vector<int64_t> remainingBytes)>;
 
+/// Same as DataAvailableCallback but passes the pages themselves instead of
+/// their serialized data. Used by consumers in the same process, which take the
+/// vectors of in-process pages without deserializing them.
+using PagesAvailableCallback = std::function<void(
+    std::vector<std::shared_ptr<SerializedPage>> pages,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes)>;
+
 /// Callback provided to indicate if the consumer of a destination buffer is
 /// currently active or not. It is used by arbitrary output buffer to optimize
 /// the http based streaming shuffle in Prestissimo. For instance, the arbitrary
@@ -41,13 +49,18 @@ using DataConsumerActiveCheckCallback = std::function<bool()>;
 
 struct DataAvailable {
   DataAvailableCallback callback;
+  // Set instead of 'callback' for a consumer of pages.
+  PagesAvailableCallback pagesCallback;
   int64_t sequence;
   std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPage>> pages;
   std::vector<int64_t> remainingBytes;
 
   void notify() {
     if (callback) {
       callback(std::move(data), sequence, remainingBytes);
+    } else if (pagesCallback) {
+      pagesCallback(std::move(pages), sequence, remainingBytes);
     }
   }
 };
@@ -115,6 +128,10 @@ class DestinationBuffer {
     int64_t bytesSent{0};
     int64_t rowsSent{0};
     int64_t pagesSent{0};
+
+    /// Moving average of the rate in bytes per second at which the consumer
+    /// acknowledges the data. 0 until measured.
+    int64_t bytesPerSecond{0};
   };
 
   void enqueue(std::shared_ptr<SerializedPage> data);
@@ -125,6 +142,18 @@ class DestinationBuffer {
   /// arbitrary output type when enqueue new data.
   void maybeLoadData(ArbitraryBuffer* buffer);
 
+  /// Returns true if a consumer waits for data of this buffer.
+  bool hasNotify() const {
+    return notify_ != nullptr || notifyPages_ != nullptr;
+  }
+
+  /// Returns the rate in bytes per second at which the consumer of this buffer
+  /// acknowledges data at time 'nowUs'. This is Stats::bytesPerSecond, lowered
+  /// if the consumer has acknowledged less than that since the last
+  /// measurement. Used to offer the pages of an arbitrary output to the faster
+  /// consumers first.
+  double consumptionRate(uint64_t nowUs) const;
+
   /// Invoked to load data with up to 'maxBytes' from arbitrary 'buffer' when
   /// fetch data from this destination. This only used by arbitrary output type
   /// which doesn't expect to buffer any data and is always load data from the
@@ -135,6 +164,10 @@ class DestinationBuffer {
     /// The actual data available at this buffer.
     std::vector<std::unique_ptr<folly::IOBuf>> data;
 
+    /// The pages available at this buffer. Set instead of 'data' by
+    /// getPages().
+    std::vector<std::shared_ptr<SerializedPage>> pages;
+
     /// The byte sizes of pages that can be fetched.
     std::vector<int64_t> remainingBytes;
 
@@ -161,6 +194,14 @@ class DestinationBuffer {
       DataConsumerActiveCheckCallback activeCheck,
       ArbitraryBuffer* arbitraryBuffer = nullptr);
 
+  /// Same as getData() but returns the pages themselves in Data::pages and
+  /// installs 'notify' to be called with pages.
+  Data getPages(
+      uint64_t maxBytes,
+      int64_t sequence,
+      PagesAvailableCallback notify,
+      ArbitraryBuffer* arbitraryBuffer = nullptr);
+
   /// Removes data from the queue and returns removed data. If 'fromGetData' we
   /// do not give a warning for the case where no data is removed, otherwise we
   /// expect that data does get freed. We cannot assert that data gets deleted
@@ -185,16 +226,37 @@ class DestinationBuffer {
   std::string toString();
 
  private:
+  // Implements getData() and getPages(). Returns pages instead of their data if
+  // 'asPages' is true. Installs 'notify' or 'notifyPages' if no data is
+  // available.
+  Data getDataOrPages(
+      uint64_t maxBytes,
+      int64_t sequence,
+      bool asPages,
+      DataAvailableCallback notify,
+      PagesAvailableCallback notifyPages,
+      DataConsumerActiveCheckCallback activeCheck,
+      ArbitraryBuffer* arbitraryBuffer);
+
   void clearNotify();
 
+  // Adds 'bytes' acknowledged by the consumer to the measurement of
+  // Stats::bytesPerSecond.
+  void recordConsumed(int64_t bytes);
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
   DataAvailableCallback notify_{nullptr};
+  PagesAvailableCallback notifyPages_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
   uint64_t notifyMaxBytes_{0};
+  // Start of the current measurement of the consumption rate and the bytes
+  // acknowledged since then. The measurement starts with the first fetch.
+  uint64_t rateStartUs_{0};
+  int64_t rateBytes_{0};
   Stats stats_;
 };
 
@@ -306,6 +368,13 @@ class OutputBuffer {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck);
 
+  /// Same as getData() but calls 'notify' with the pages themselves.
+  void getPages(
+      int destination,
+      uint64_t maxSize,
+      int64_t sequence,
+      PagesAvailableCallback notify);
+
   // Continues any possibly waiting producers. Called when the
   // producer task has an error or cancellation.
   void terminate();
@@ -414,8 +483,12 @@ class OutputBuffer {
   uint64_t numOutputPages_{0};
   std::vector<ContinuePromise> promises_;
   // The next buffer index in 'buffers_' to load data from arbitrary buffer
-  // which is only used by arbitrary output type.
+  // which is only used by arbitrary output type. Breaks ties between waiting
+  // destinations of the same consumption rate.
   int32_t nextArbitraryLoadBufferIndex_{0};
+  // Reusable (consumption rate, buffer index) pairs of the destinations that
+  // wait for data of the arbitrary buffer.
+  std::vector<std::pair<double, int32_t>> waitingArbitraryBuffers_;
   // One buffer per destination.
   std::vector<std::unique_ptr<DestinationBuffer>> buffers_;
   // The sizes of buffers_ and finishedBufferStats_ are the same, but
@@ -113,6 +113,19 @@ bool OutputBufferManager::getData(
   return false;
 }
 
+bool OutputBufferManager::getPages(
+    const std::string& taskId,
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify) {
+  if (auto buffer = getBufferIfExists(taskId)) {
+    buffer->getPages(destination, maxBytes, sequence, std::move(notify));
+    return true;
+  }
+  return false;
+}
+
 void OutputBufferManager::initializeTask(
     std::shared_ptr<Task> task,
     core::PartitionedOutputNode::Kind kind,
@@ -96,6 +96,16 @@ class OutputBufferManager {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck = nullptr);
 
+  /// Same as getData() but calls 'notify' with the pages themselves, so that
+  /// a consumer in the same process can take the vectors of in-process pages
+  /// without deserializing them.
+  bool getPages(
+      const std::string& taskId,
+      int destination,
+      uint64_t maxBytes,
+      int64_t sequence,
+      PagesAvailableCallback notify);
+
   void removeTask(const std::string& taskId);
 
   /// Initializes singleton with 'options'. May be called once before
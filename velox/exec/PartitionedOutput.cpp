@@ -15,15 +15,173 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include <folly/lang/Bits.h>
+#include "velox/common/time/CpuWallTimer.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 namespace detail {
+namespace {
+// Upper limit of message size with no columns.
+constexpr int32_t kMinMessageSize = 128;
+
+// A page that keeps the encodings of the input is enqueued right away instead
+// of taking rows of later batches, so it is only made if it has at least this
+// percentage of the target page size. This at most doubles the number of
+// pages.
+constexpr uint64_t kMinEncodedPagePct = 50;
+
+// Maximum estimated size of a page that keeps the encodings of the input
+// relative to its flat size.
+constexpr double kMaxEncodedSizeRatio = 0.8;
+
+// Minimum average number of rows per contiguous range of rows for a page that
+// keeps the encodings of the input. Dictionaries are sized per range, so that
+// scattered rows, e.g. of a hash partitioning, are neither estimated nor
+// serialized well.
+constexpr size_t kMinEncodedRowsPerRange = 16;
+
+bool hasEncodedChildren(const RowVector& output) {
+  for (const auto& child : output.children()) {
+    const auto encoding = child->encoding();
+    if (encoding == VectorEncoding::Simple::DICTIONARY ||
+        encoding == VectorEncoding::Simple::CONSTANT) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Adds the serializer runtime stats in 'from' to 'to'.
+void addSerdeStats(
+    const std::unordered_map<std::string, RuntimeCounter>& from,
+    std::unordered_map<std::string, RuntimeCounter>& to) {
+  for (const auto& [name, counter] : from) {
+    auto it = to.find(name);
+    if (it == to.end()) {
+      to.emplace(name, counter);
+    } else {
+      it->second.value += counter.value;
+    }
+  }
+}
+} // namespace
+
+void AdaptiveCompression::recordPage(
+    bool compressed,
+    uint64_t inputBytes,
+    uint64_t outputBytes,
+    uint64_t cpuNanos) {
+  // Weight of a new sample in the moving averages.
+  constexpr double kNewSampleWeight = 0.25;
+  if (inputBytes == 0) {
+    return;
+  }
+  const double nanosPerByte = static_cast<double>(cpuNanos) / inputBytes;
+  if (!compressed) {
+    plainNanosPerByte_ = hasPlainSample_
+        ? plainNanosPerByte_ +
+            kNewSampleWeight * (nanosPerByte - plainNanosPerByte_)
+        : nanosPerByte;
+    hasPlainSample_ = true;
+    if (numPagesToSkip_ > 0) {
+      --numPagesToSkip_;
+    }
+    return;
+  }
+
+  const double ratio = static_cast<double>(outputBytes) / inputBytes;
+  if (hasCompressedSample_) {
+    ratio_ += kNewSampleWeight * (ratio - ratio_);
+    compressedNanosPerByte_ +=
+        kNewSampleWeight * (nanosPerByte - compressedNanosPerByte_);
+  } else {
+    ratio_ = ratio;
+    compressedNanosPerByte_ = nanosPerByte;
+    hasCompressedSample_ = true;
+  }
+  const bool profitable = ratio_ <= minCompressionRatio_ &&
+      (maxNanosPerSavedByte_ == 0 ||
+       nanosPerSavedByte() <= maxNanosPerSavedByte_);
+  if (profitable) {
+    lastNumPagesSkipped_ = 0;
+    return;
+  }
+  // Skips twice as many pages as after the previous unprofitable sample.
+  numPagesToSkip_ =
+      std::min<int32_t>(kMaxPagesToSkip, 1 + 2 * lastNumPagesSkipped_);
+  lastNumPagesSkipped_ = numPagesToSkip_;
+}
+
+double AdaptiveCompression::nanosPerSavedByte() const {
+  if (!hasCompressedSample_ || !hasPlainSample_) {
+    return 0;
+  }
+  const double savedPerByte = 1 - ratio_;
+  if (savedPerByte <= 0) {
+    return std::numeric_limits<double>::max();
+  }
+  return std::max<double>(0, compressedNanosPerByte_ - plainNanosPerByte_) /
+      savedPerByte;
+}
+
+Destination::Destination(
+    const std::string& taskId,
+    int destination,
+    memory::MemoryPool* pool,
+    bool eagerFlush,
+    bool preserveEncodings,
+    std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+    std::shared_ptr<void> vectorOwner,
+    double maxCompressionNanosPerSavedByte)
+    : taskId_(taskId),
+      destination_(destination),
+      pool_(pool),
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(preserveEncodings),
+      recordEnqueued_(std::move(recordEnqueued)),
+      vectorOwner_(std::move(vectorOwner)),
+      compressionKind_(
+          OutputBufferManager::getInstance().lock()->compressionKind()),
+      compression_(
+          PartitionedOutput::minCompressionRatio(),
+          maxCompressionNanosPerSavedByte) {
+  setTargetSizePct();
+}
+
+serializer::presto::PrestoVectorSerde::PrestoOptions Destination::serdeOptions(
+    bool compress) const {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionKind = compress
+      ? compressionKind_
+      : common::CompressionKind::CompressionKind_NONE;
+  options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+  return options;
+}
+
+void Destination::recordPage(
+    bool compressed,
+    uint64_t inputBytes,
+    uint64_t outputBytes,
+    uint64_t cpuNanos) {
+  if (compressionKind_ == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  uncompressedPageBytes_ += inputBytes;
+  compressedPageBytes_ += outputBytes;
+  if (!compressed) {
+    ++numCompressionSkippedPages_;
+    compressionSkippedBytes_ += inputBytes;
+  }
+  compression_.recordPage(compressed, inputBytes, outputBytes, cpuNanos);
+}
+
 BlockingReason Destination::advance(
     uint64_t maxBytes,
     const std::vector<vector_size_t>& sizes,
     const RowVectorPtr& output,
+    row::CompactRow* compactRow,
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     bool* atEnd,
@@ -34,6 +192,11 @@ BlockingReason Destination::advance(
     return BlockingReason::kNotBlocked;
   }
 
+  if (vectorOwner_ != nullptr) {
+    *atEnd = true;
+    return enqueueVectorPage(sizes, output, bufferManager, future);
+  }
+
   const auto firstRow = rowIdx_;
   const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
   if (bytesInCurrent_ >= adjustedMaxBytes) {
@@ -41,6 +204,7 @@ BlockingReason Destination::advance(
   }
 
   // Collect rows to serialize.
+  const uint64_t firstByte = bytesInCurrent_;
   bool shouldFlush = false;
   while (rowIdx_ < rows_.size() && !shouldFlush) {
     bytesInCurrent_ += sizes[rows_[rowIdx_]];
@@ -50,18 +214,49 @@ BlockingReason Destination::advance(
         bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
   }
 
+  // A page made only of rows of 'output' can keep its encodings.
+  if (preserveEncodings_ && !compactRow &&
+      rowsInCurrent_ == rowIdx_ - firstRow &&
+      (shouldFlush ||
+       bytesInCurrent_ * 100 >= adjustedMaxBytes * kMinEncodedPagePct)) {
+    BlockingReason blockingReason;
+    if (tryEncodedPage(
+            firstRow,
+            output,
+            bufferManager,
+            bufferReleaseFn,
+            future,
+            scratch,
+            blockingReason)) {
+      if (rowIdx_ == rows_.size()) {
+        *atEnd = true;
+      }
+      return blockingReason;
+    }
+  }
+
   // Serialize
-  if (!current_) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_);
-    auto rowType = asRowType(output->type());
-    serializer::presto::PrestoVectorSerde::PrestoOptions options;
-    options.compressionKind =
-        OutputBufferManager::getInstance().lock()->compressionKind();
-    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
-    current_->createStreamTree(rowType, rowsInCurrent_, &options);
-  }
-  current_->append(
-      output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
+  if (compactRow) {
+    appendCompactRows(*compactRow, firstRow, firstByte);
+  } else {
+    const bool compress = compressNextPage();
+    if (current_ && currentCompressed_ != compress &&
+        rowsInCurrent_ == rowIdx_ - firstRow) {
+      // Compression was turned on or off. The next page starts with these
+      // rows and gets a serializer with the new options.
+      addSerdeStats(current_->runtimeStats(), replacedSerdeStats_);
+      current_.reset();
+    }
+    if (!current_) {
+      current_ = std::make_unique<VectorStreamGroup>(pool_);
+      auto rowType = asRowType(output->type());
+      auto options = serdeOptions(compress);
+      current_->createStreamTree(rowType, rowsInCurrent_, &options);
+      currentCompressed_ = compress;
+    }
+    current_->append(
+        output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
+  }
   // Update output state variable.
   if (rowIdx_ == rows_.size()) {
     *atEnd = true;
@@ -76,36 +271,201 @@ BlockingReason Destination::flush(
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
-  if (!current_ || rowsInCurrent_ == 0) {
+  if (rowsInCurrent_ == 0) {
     return BlockingReason::kNotBlocked;
   }
+  const int64_t flushedRows = rowsInCurrent_;
+
+  if (!current_) {
+    // The rows are in 'compactRows_'. The CompactRow format has no page
+    // header, hence no listener.
+    IOBufOutputStream stream(*pool_, nullptr, bytesInCurrent_);
+    stream.write(compactRows_->as<char>(), bytesInCurrent_);
+
+    bytesInCurrent_ = 0;
+    rowsInCurrent_ = 0;
+    setTargetSizePct();
+
+    return enqueue(
+        stream, flushedRows, bufferManager, bufferReleaseFn, future);
+  }
 
-  // Upper limit of message size with no columns.
-  constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
   IOBufOutputStream stream(
       *current_->pool(),
       listener.get(),
       std::max<int64_t>(kMinMessageSize, current_->size()));
-  const int64_t flushedRows = rowsInCurrent_;
 
-  current_->flush(&stream);
+  CpuWallTiming timing;
+  {
+    CpuWallTimer timer(timing);
+    current_->flush(&stream);
+  }
   current_->clear();
+  recordPage(
+      currentCompressed_, bytesInCurrent_, stream.tellp(), timing.cpuNanos);
 
-  const int64_t flushedBytes = stream.tellp();
+  bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
+  setTargetSizePct();
 
+  return enqueue(stream, flushedRows, bufferManager, bufferReleaseFn, future);
+}
+
+BlockingReason Destination::enqueueVectorPage(
+    const std::vector<vector_size_t>& sizes,
+    const RowVectorPtr& output,
+    OutputBufferManager& bufferManager,
+    ContinueFuture* future) {
+  const vector_size_t numRows = rows_.size() - rowIdx_;
+  int64_t bytes = 0;
+  for (auto i = rowIdx_; i < rows_.size(); ++i) {
+    bytes += sizes[rows_[i]];
+  }
+
+  // The rows are added in increasing order without duplicates, so that all the
+  // rows of 'output' are in order.
+  RowVectorPtr vector;
+  if (numRows == output->size()) {
+    vector = output;
+  } else {
+    auto indices = allocateIndices(numRows, pool_);
+    std::memcpy(
+        indices->asMutable<vector_size_t>(),
+        rows_.data() + rowIdx_,
+        numRows * sizeof(vector_size_t));
+    std::vector<VectorPtr> children;
+    children.reserve(output->childrenSize());
+    for (const auto& child : output->children()) {
+      children.push_back(
+          BaseVector::wrapInDictionary(nullptr, indices, numRows, child));
+    }
+    vector = std::make_shared<RowVector>(
+        pool_, output->type(), nullptr, numRows, std::move(children));
+  }
+  rowIdx_ = rows_.size();
+
+  // A page is never empty for the consumer's flow control.
+  bytes = std::max<int64_t>(1, bytes);
+  const bool blocked = bufferManager.enqueue(
+      taskId_,
+      destination_,
+      std::make_unique<SerializedPage>(std::move(vector), bytes, vectorOwner_),
+      future);
+  recordEnqueued_(bytes, numRows);
+  return blocked ? BlockingReason::kWaitForConsumer
+                 : BlockingReason::kNotBlocked;
+}
+
+void Destination::appendCompactRows(
+    row::CompactRow& compactRow,
+    vector_size_t firstRow,
+    uint64_t offset) {
+  if (!compactRows_) {
+    compactRows_ = AlignedBuffer::allocate<char>(bytesInCurrent_, pool_);
+  } else if (compactRows_->size() < bytesInCurrent_) {
+    // Grows geometrically. The size is the capacity in use.
+    AlignedBuffer::reallocate<char>(
+        &compactRows_,
+        std::max<uint64_t>(bytesInCurrent_, 2 * compactRows_->size()));
+  }
+  auto* rawRows = compactRows_->asMutable<char>();
+  for (auto i = firstRow; i < rowIdx_; ++i) {
+    const uint32_t size =
+        compactRow.serialize(rows_[i], rawRows + offset + sizeof(uint32_t));
+    // The size is in big endian order.
+    const uint32_t bigEndianSize = folly::Endian::big(size);
+    std::memcpy(rawRows + offset, &bigEndianSize, sizeof(uint32_t));
+    offset += sizeof(uint32_t) + size;
+  }
+  VELOX_DCHECK_EQ(offset, bytesInCurrent_);
+}
+
+bool Destination::tryEncodedPage(
+    vector_size_t firstRow,
+    const RowVectorPtr& output,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future,
+    Scratch& scratch,
+    BlockingReason& blockingReason) {
+  if (!hasEncodedChildren(*output)) {
+    return false;
+  }
+  const vector_size_t numRows = rowIdx_ - firstRow;
+  encodedRanges_.clear();
+  for (auto i = firstRow; i < rowIdx_; ++i) {
+    const auto row = rows_[i];
+    if (!encodedRanges_.empty() &&
+        encodedRanges_.back().begin + encodedRanges_.back().size == row) {
+      ++encodedRanges_.back().size;
+    } else {
+      encodedRanges_.push_back(IndexRange{row, 1});
+    }
+  }
+  if (encodedRanges_.size() * kMinEncodedRowsPerRange >
+      static_cast<size_t>(numRows)) {
+    return false;
+  }
+
+  const bool compress = compressNextPage();
+  if (!encodedSerializer_ || encodedCompressed_ != compress) {
+    auto options = serdeOptions(compress);
+    encodedSerializer_ =
+        getVectorSerde()->createBatchSerializer(pool_, &options);
+    encodedCompressed_ = compress;
+  }
+
+  const folly::Range<const IndexRange*> ranges(
+      encodedRanges_.data(), encodedRanges_.size());
+  vector_size_t encodedBytes = 0;
+  encodedSizes_.assign(encodedRanges_.size(), &encodedBytes);
+  for (const auto& child : output->children()) {
+    encodedSerializer_->estimateSerializedSize(
+        child, ranges, encodedSizes_.data(), scratch);
+  }
+  if (encodedBytes > bytesInCurrent_ * kMaxEncodedSizeRatio) {
+    return false;
+  }
+
+  auto listener = bufferManager.newListener();
+  IOBufOutputStream stream(
+      *pool_,
+      listener.get(),
+      std::max<int64_t>(kMinMessageSize, encodedBytes));
+  CpuWallTiming timing;
+  {
+    CpuWallTimer timer(timing);
+    encodedSerializer_->serialize(output, ranges, scratch, &stream);
+  }
+  recordPage(compress, encodedBytes, stream.tellp(), timing.cpuNanos);
+
+  ++numEncodedPages_;
+  encodedBytesSaved_ += bytesInCurrent_ - encodedBytes;
   bytesInCurrent_ = 0;
   rowsInCurrent_ = 0;
   setTargetSizePct();
 
+  blockingReason =
+      enqueue(stream, numRows, bufferManager, bufferReleaseFn, future);
+  return true;
+}
+
+BlockingReason Destination::enqueue(
+    IOBufOutputStream& stream,
+    int64_t numRows,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const int64_t bytes = stream.tellp();
   bool blocked = bufferManager.enqueue(
       taskId_,
       destination_,
       std::make_unique<SerializedPage>(
-          stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows),
+          stream.getIOBuf(bufferReleaseFn), nullptr, numRows),
       future);
 
-  recordEnqueued_(flushedBytes, flushedRows);
+  recordEnqueued_(bytes, numRows);
 
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
@@ -113,13 +473,45 @@ BlockingReason Destination::flush(
 
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
-  if (current_) {
-    const auto serializerStats = current_->runtimeStats();
+  if (current_ || !replacedSerdeStats_.empty() ||
+      compressionSkippedBytes_ > 0) {
+    auto serializerStats = replacedSerdeStats_;
+    if (current_) {
+      addSerdeStats(current_->runtimeStats(), serializerStats);
+    }
+    // Pages that were not compressed are reported like the ones the
+    // serializer skips.
+    if (compressionSkippedBytes_ > 0) {
+      addSerdeStats(
+          {{"compressionSkippedBytes",
+            RuntimeCounter(
+                compressionSkippedBytes_, RuntimeCounter::Unit::kBytes)}},
+          serializerStats);
+    }
     auto lockedStats = op->stats().wlock();
     for (auto& pair : serializerStats) {
       lockedStats->addRuntimeStat(pair.first, pair.second);
     }
   }
+  if (uncompressedPageBytes_ > 0) {
+    auto lockedStats = op->stats().wlock();
+    lockedStats->addRuntimeStat(
+        kUncompressedPageBytes,
+        RuntimeCounter(uncompressedPageBytes_, RuntimeCounter::Unit::kBytes));
+    lockedStats->addRuntimeStat(
+        kCompressedPageBytes,
+        RuntimeCounter(compressedPageBytes_, RuntimeCounter::Unit::kBytes));
+    lockedStats->addRuntimeStat(
+        kCompressionSkippedPages, RuntimeCounter(numCompressionSkippedPages_));
+  }
+  if (numEncodedPages_ > 0) {
+    auto lockedStats = op->stats().wlock();
+    lockedStats->addRuntimeStat(
+        kEncodedPages, RuntimeCounter(numEncodedPages_));
+    lockedStats->addRuntimeStat(
+        kEncodedBytesSaved,
+        RuntimeCounter(encodedBytesSaved_, RuntimeCounter::Unit::kBytes));
+  }
 }
 
 } // namespace detail
@@ -138,6 +530,8 @@ PartitionedOutput::PartitionedOutput(
       keyChannels_(toChannels(planNode->inputType(), planNode->keys())),
       numDestinations_(planNode->numPartitions()),
       replicateNullsAndAny_(planNode->isReplicateNullsAndAny()),
+      arbitraryOutput_(
+          planNode->kind() == core::PartitionedOutputNode::Kind::kArbitrary),
       partitionFunction_(
           numDestinations_ == 1
               ? nullptr
@@ -155,7 +549,14 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .partitionedOutputPreserveEncodings()),
+      compactRow_(ctx->task->queryCtx()->queryConfig().exchangeCompactRow()),
+      vectorPages_(
+          !compactRow_ &&
+          ctx->task->queryCtx()->queryConfig().exchangeVectorPages()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -190,6 +591,9 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
         input_->size(),
         outputColumns);
   }
+  if (compactRow_) {
+    outputRows_ = std::make_unique<row::CompactRow>(output_);
+  }
 }
 
 void PartitionedOutput::initializeDestinations() {
@@ -197,10 +601,19 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          preserveEncodings_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          vectorPages_ ? operatorCtx_->task() : nullptr,
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .exchangeCompressionMaxNanosPerSavedByte()));
     }
   }
 }
@@ -219,6 +632,17 @@ void PartitionedOutput::initializeSizeBuffers() {
 
 void PartitionedOutput::estimateRowSizes() {
   auto numInput = input_->size();
+  if (compactRow_) {
+    // Exact sizes of the rows with their size prefix.
+    const auto fixedRowSize =
+        row::CompactRow::fixedRowSize(asRowType(output_->type()));
+    for (vector_size_t i = 0; i < numInput; ++i) {
+      rowSize_[i] = sizeof(uint32_t) +
+          (fixedRowSize.has_value() ? fixedRowSize.value()
+                                    : outputRows_->rowSize(i));
+    }
+    return;
+  }
   std::fill(rowSize_.begin(), rowSize_.end(), 0);
   raw_vector<vector_size_t> storage;
   auto numbers = iota(numInput, storage);
@@ -328,11 +752,16 @@ RowVectorPtr PartitionedOutput::getOutput() {
   VELOX_CHECK_NOT_NULL(
       bufferManager, "OutputBufferManager was already destructed");
 
-  // Limit serialized pages to 1MB.
+  // Limit serialized pages to 1MB. The pages of an arbitrary output go to
+  // whichever consumer fetches first, so these are smaller to spread evenly
+  // over consumers of different speeds.
   static const uint64_t kMaxPageSize = 1 << 20;
+  static const uint64_t kMaxArbitraryPageSize = 256 << 10;
   const uint64_t maxPageSize = std::max<uint64_t>(
       kMinDestinationSize,
-      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+      std::min<uint64_t>(
+          arbitraryOutput_ ? kMaxArbitraryPageSize : kMaxPageSize,
+          maxBufferedBytes_ / numDestinations_));
 
   bool workLeft;
   do {
@@ -343,6 +772,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
           maxPageSize,
           rowSize_,
           output_,
+          outputRows_.get(),
           *bufferManager,
           bufferReleaseFn_,
           &atEnd,
@@ -394,6 +824,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
   // The input is fully processed, drop the reference to allow reuse.
   input_ = nullptr;
   output_ = nullptr;
+  outputRows_ = nullptr;
   return nullptr;
 }
 
@@ -18,28 +18,90 @@
 #include <folly/Random.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/row/CompactRow.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
 
 namespace detail {
+/// Decides page by page whether a Destination compresses its pages. Samples
+/// the achieved compression ratio and the CPU time of serializing the pages
+/// with and without compression. Compression is skipped while the ratio is
+/// above 'minCompressionRatio' or while the CPU time per byte saved is above
+/// 'maxNanosPerSavedByte', if this is not 0. Skipping is retried with an
+/// exponentially growing number of skipped pages between samples.
+class AdaptiveCompression {
+ public:
+  AdaptiveCompression(float minCompressionRatio, double maxNanosPerSavedByte)
+      : minCompressionRatio_(minCompressionRatio),
+        maxNanosPerSavedByte_(maxNanosPerSavedByte) {}
+
+  /// Returns true if the next page should be compressed.
+  bool shouldCompress() const {
+    return numPagesToSkip_ == 0;
+  }
+
+  /// Records a page of 'inputBytes' serialized bytes that took 'cpuNanos' to
+  /// flush into 'outputBytes', with compression if 'compressed' is true.
+  void recordPage(
+      bool compressed,
+      uint64_t inputBytes,
+      uint64_t outputBytes,
+      uint64_t cpuNanos);
+
+  /// Returns the average ratio of compressed to serialized bytes of the
+  /// recent compressed pages. 1 if there are none.
+  double compressionRatio() const {
+    return ratio_;
+  }
+
+  /// Returns the CPU time spent compressing per byte saved over the recent
+  /// pages. 0 until both compressed and uncompressed pages are sampled.
+  double nanosPerSavedByte() const;
+
+ private:
+  static constexpr int32_t kMaxPagesToSkip = 64;
+
+  const float minCompressionRatio_;
+  const double maxNanosPerSavedByte_;
+
+  // Moving averages of the compression ratio and of the flush CPU time per
+  // serialized byte of the compressed and uncompressed pages.
+  double ratio_{1};
+  double compressedNanosPerByte_{0};
+  double plainNanosPerByte_{0};
+  bool hasCompressedSample_{false};
+  bool hasPlainSample_{false};
+
+  // Number of forthcoming pages that are not compressed.
+  int32_t numPagesToSkip_{0};
+  // Number of pages skipped after the last unprofitable sample.
+  int32_t lastNumPagesSkipped_{0};
+};
+
 class Destination {
  public:
+  /// @param preserveEncodings If true, rows of a batch that make up a page by
+  /// themselves are serialized with the dictionary and constant encodings of
+  /// the batch when that is estimated to be smaller than the flat form.
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param vectorOwner If set, the rows of each batch are enqueued as an
+  /// in-process page that references the batch instead of being serialized.
+  /// 'vectorOwner' keeps the memory of the batches alive.
+  /// @param maxCompressionNanosPerSavedByte If the exchange compression is
+  /// enabled, pages are not compressed while compressing costs more CPU time
+  /// per saved byte. 0 means no limit. See AdaptiveCompression.
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
-      : taskId_(taskId),
-        destination_(destination),
-        pool_(pool),
-        eagerFlush_(eagerFlush),
-        recordEnqueued_(std::move(recordEnqueued)) {
-    setTargetSizePct();
-  }
+      bool preserveEncodings,
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      std::shared_ptr<void> vectorOwner = nullptr,
+      double maxCompressionNanosPerSavedByte = 0);
 
   // Resets the destination before starting a new batch.
   void beginBatch() {
@@ -58,10 +120,14 @@ class Destination {
   }
 
   // Serializes row from 'output' till either 'maxBytes' have been serialized or
+  // the rows of the batch are done. If 'compactRow' is set, the rows are
+  // serialized with it in the CompactRow format of
+  // serializer::CompactRowVectorSerde and 'sizes' are their exact sizes.
   BlockingReason advance(
       uint64_t maxBytes,
       const std::vector<vector_size_t>& sizes,
       const RowVectorPtr& output,
+      row::CompactRow* compactRow,
       OutputBufferManager& bufferManager,
       const std::function<void()>& bufferReleaseFn,
       bool* atEnd,
@@ -88,7 +154,79 @@ class Destination {
   /// Adds stats from 'this' to runtime stats of 'op'.
   void updateStats(Operator* op);
 
+  /// Runtime stat names for the pages serialized with the encodings of the
+  /// input and for the estimated bytes saved by not flattening them.
+  static inline const std::string kEncodedPages{"encodedPages"};
+  static inline const std::string kEncodedBytesSaved{"encodedBytesSaved"};
+
+  /// Runtime stat names for the serialized bytes of the pages before and after
+  /// compression and for the number of pages not compressed because
+  /// compression did not pay off. Reported if the exchange compression is
+  /// enabled.
+  static inline const std::string kUncompressedPageBytes{
+      "uncompressedPageBytes"};
+  static inline const std::string kCompressedPageBytes{"compressedPageBytes"};
+  static inline const std::string kCompressionSkippedPages{
+      "compressionSkippedPages"};
+
  private:
+  // Serializes the rows of 'rows_' from 'firstRow' to 'rowIdx_' of 'output'
+  // as a page of their own that keeps the dictionary and constant encodings
+  // of 'output' if this is estimated to save enough bytes over the flat form.
+  // Requires that nothing is pending in 'current_'. Returns false without
+  // serializing anything if the flat form is preferred.
+  bool tryEncodedPage(
+      vector_size_t firstRow,
+      const RowVectorPtr& output,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future,
+      Scratch& scratch,
+      BlockingReason& blockingReason);
+
+  // Enqueues the remaining rows of 'rows_' as an in-process page that wraps
+  // the columns of 'output' in a dictionary of the rows, or holds 'output'
+  // itself if it has all the rows. 'sizes' are the estimated serialized sizes
+  // of the rows, which are accounted for the page.
+  BlockingReason enqueueVectorPage(
+      const std::vector<vector_size_t>& sizes,
+      const RowVectorPtr& output,
+      OutputBufferManager& bufferManager,
+      ContinueFuture* future);
+
+  // Appends the rows of 'rows_' from 'firstRow' to 'rowIdx_' to
+  // 'compactRows_' at 'offset'. 'bytesInCurrent_' includes their sizes.
+  void appendCompactRows(
+      row::CompactRow& compactRow,
+      vector_size_t firstRow,
+      uint64_t offset);
+
+  // Returns the serde options for pages with or without compression.
+  serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions(
+      bool compress) const;
+
+  // Returns true if the next page is compressed.
+  bool compressNextPage() const {
+    return compressionKind_ != common::CompressionKind::CompressionKind_NONE &&
+        compression_.shouldCompress();
+  }
+
+  // Records a page of 'inputBytes' serialized bytes that was flushed into
+  // 'outputBytes' in 'cpuNanos'.
+  void recordPage(
+      bool compressed,
+      uint64_t inputBytes,
+      uint64_t outputBytes,
+      uint64_t cpuNanos);
+
+  // Enqueues the page in 'stream' with 'numRows' rows.
+  BlockingReason enqueue(
+      IOBufOutputStream& stream,
+      int64_t numRows,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
   // to make different destinations ready at slightly different times
@@ -106,7 +244,10 @@ class Destination {
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  const std::shared_ptr<void> vectorOwner_;
+  const common::CompressionKind compressionKind_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -120,6 +261,34 @@ class Destination {
   // The current stream where the input is serialized to. This is cleared on
   // every flush() call.
   std::unique_ptr<VectorStreamGroup> current_;
+  // True if 'current_' compresses its pages.
+  bool currentCompressed_{false};
+  // Runtime stats of the serializers replaced in 'current_' when compression
+  // was turned on or off.
+  std::unordered_map<std::string, RuntimeCounter> replacedSerdeStats_;
+
+  // Rows serialized in the CompactRow format, each preceded by its size, when
+  // these are used instead of 'current_'. The first 'bytesInCurrent_' bytes
+  // are used.
+  BufferPtr compactRows_;
+
+  // Serializer for the pages that keep the encodings of the input. Created on
+  // first use.
+  std::unique_ptr<BatchVectorSerializer> encodedSerializer_;
+  // Reusable ranges of rows and size pointers for 'encodedSerializer_'.
+  std::vector<IndexRange> encodedRanges_;
+  std::vector<vector_size_t*> encodedSizes_;
+  // True if 'encodedSerializer_' compresses its pages.
+  bool encodedCompressed_{false};
+  uint64_t numEncodedPages_{0};
+  uint64_t encodedBytesSaved_{0};
+
+  AdaptiveCompression compression_;
+  uint64_t uncompressedPageBytes_{0};
+  uint64_t compressedPageBytes_{0};
+  uint64_t numCompressionSkippedPages_{0};
+  uint64_t compressionSkippedBytes_{0};
+
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -212,6 +381,7 @@ class PartitionedOutput : public Operator {
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
+  const bool arbitraryOutput_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
   // Empty if column order in the output is exactly the same as in input.
   const std::vector<column_index_t> outputChannels_;
@@ -219,6 +389,12 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
+  // True if the rows are serialized in the CompactRow format.
+  const bool compactRow_;
+  // True if the rows are enqueued as in-process pages instead of being
+  // serialized.
+  const bool vectorPages_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -228,6 +404,8 @@ class PartitionedOutput : public Operator {
   std::vector<std::unique_ptr<detail::Destination>> destinations_;
   bool replicatedAny_{false};
   RowVectorPtr output_;
+  // Serializer of the rows of 'output_' if 'compactRow_' is true.
+  std::unique_ptr<row::CompactRow> outputRows_;
 
   // Reusable memory.
   SelectivityVector rows_;
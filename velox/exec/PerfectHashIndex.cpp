@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PerfectHashIndex.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+// Average number of keys per bucket. Fewer keys per bucket make the pilots
+// take more space but faster to find.
+constexpr uint64_t kKeysPerBucket = 2;
+
+// Number of slots per 20 keys.
+constexpr uint64_t kSlotsPer20Keys = 21;
+} // namespace
+
+// static
+uint64_t PerfectHashIndex::estimateBytes(uint64_t numKeys) {
+  return slotsForKeys(numKeys) * sizeof(Entry) +
+      bucketsForKeys(numKeys) * sizeof(uint16_t);
+}
+
+// static
+uint64_t PerfectHashIndex::slotsForKeys(uint64_t numKeys) {
+  return std::max<uint64_t>(1, numKeys * kSlotsPer20Keys / 20);
+}
+
+// static
+uint64_t PerfectHashIndex::bucketsForKeys(uint64_t numKeys) {
+  return std::max<uint64_t>(1, numKeys / kKeysPerBucket);
+}
+
+// static
+std::unique_ptr<PerfectHashIndex> PerfectHashIndex::create(
+    folly::Range<const int64_t*> keys,
+    folly::Range<char* const*> rows,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_EQ(keys.size(), rows.size());
+  VELOX_CHECK_LE(keys.size(), std::numeric_limits<uint32_t>::max());
+  const auto numKeys = keys.size();
+  std::unique_ptr<PerfectHashIndex> index(
+      new PerfectHashIndex(slotsForKeys(numKeys), bucketsForKeys(numKeys)));
+
+  // Orders the hashes of the keys by bucket.
+  std::vector<uint32_t> bucketStarts(index->numBuckets_ + 1, 0);
+  for (auto key : keys) {
+    ++bucketStarts[index->bucket(hashKey(key)) + 1];
+  }
+  for (auto i = 0; i < index->numBuckets_; ++i) {
+    bucketStarts[i + 1] += bucketStarts[i];
+  }
+  std::vector<uint64_t> hashes(numKeys);
+  {
+    auto positions = bucketStarts;
+    for (auto key : keys) {
+      const auto hash = hashKey(key);
+      hashes[positions[index->bucket(hash)]++] = hash;
+    }
+  }
+
+  index->pilotsBuffer_ =
+      AlignedBuffer::allocate<uint16_t>(index->numBuckets_, pool, 0);
+  auto* pilots = index->pilotsBuffer_->asMutable<uint16_t>();
+  if (!index->findPilots(hashes, bucketStarts, pilots)) {
+    return nullptr;
+  }
+  index->pilots_ = pilots;
+
+  index->entriesBuffer_ =
+      AlignedBuffer::allocate<char>(index->numSlots_ * sizeof(Entry), pool);
+  auto* entries = index->entriesBuffer_->asMutable<Entry>();
+  std::memset(entries, 0, index->numSlots_ * sizeof(Entry));
+  for (auto i = 0; i < numKeys; ++i) {
+    const auto hash = hashKey(keys[i]);
+    auto& entry = entries[index->slot(hash, pilots[index->bucket(hash)])];
+    VELOX_DCHECK_NULL(entry.row);
+    entry.key = keys[i];
+    entry.row = rows[i];
+  }
+  index->entries_ = entries;
+  return index;
+}
+
+bool PerfectHashIndex::findPilots(
+    const std::vector<uint64_t>& hashes,
+    const std::vector<uint32_t>& bucketStarts,
+    uint16_t* pilots) const {
+  auto bucketSize = [&](uint32_t bucket) {
+    return bucketStarts[bucket + 1] - bucketStarts[bucket];
+  };
+
+  // Places the largest buckets first, while most slots are free. Orders the
+  // buckets by decreasing size with a counting sort.
+  uint32_t maxBucketSize = 0;
+  for (auto i = 0; i < numBuckets_; ++i) {
+    maxBucketSize = std::max(maxBucketSize, bucketSize(i));
+  }
+  std::vector<uint32_t> sizeStarts(maxBucketSize + 2, 0);
+  for (auto i = 0; i < numBuckets_; ++i) {
+    ++sizeStarts[maxBucketSize - bucketSize(i) + 1];
+  }
+  for (auto i = 0; i <= maxBucketSize; ++i) {
+    sizeStarts[i + 1] += sizeStarts[i];
+  }
+  std::vector<uint32_t> order(numBuckets_);
+  for (auto i = 0; i < numBuckets_; ++i) {
+    order[sizeStarts[maxBucketSize - bucketSize(i)]++] = i;
+  }
+
+  std::vector<uint64_t> taken(bits::nwords(numSlots_), 0);
+  std::vector<uint64_t> bucketSlots;
+  for (auto bucket : order) {
+    const auto begin = bucketStarts[bucket];
+    const auto end = bucketStarts[bucket + 1];
+    if (begin == end) {
+      // The remaining buckets are empty.
+      break;
+    }
+    bool placed = false;
+    for (uint32_t pilot = 0; pilot <= std::numeric_limits<uint16_t>::max();
+         ++pilot) {
+      bucketSlots.clear();
+      bool free = true;
+      for (auto i = begin; i < end && free; ++i) {
+        const auto slotIndex = slot(hashes[i], pilot);
+        free = !bits::isBitSet(taken.data(), slotIndex) &&
+            std::find(bucketSlots.begin(), bucketSlots.end(), slotIndex) ==
+                bucketSlots.end();
+        bucketSlots.push_back(slotIndex);
+      }
+      if (free) {
+        for (auto slotIndex : bucketSlots) {
+          bits::setBit(taken.data(), slotIndex);
+        }
+        pilots[bucket] = pilot;
+        placed = true;
+        break;
+      }
+    }
+    if (!placed) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Range.h>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// Maps a set of distinct integer keys to rows with a perfect hash function,
+/// i.e. each key has a slot of its own. A lookup reads one slot and compares
+/// one key. The function is built with the hash and displace method of
+/// PTHash: the keys are hashed into buckets of a few keys each and every
+/// bucket gets a pilot value that places all its keys in free slots. There
+/// are about 5% more slots than keys.
+class PerfectHashIndex {
+ public:
+  /// Returns an index mapping 'keys[i]' to 'rows[i]'. 'keys' must be
+  /// distinct. Returns nullptr if no placement is found for some bucket,
+  /// which is very unlikely.
+  static std::unique_ptr<PerfectHashIndex> create(
+      folly::Range<const int64_t*> keys,
+      folly::Range<char* const*> rows,
+      memory::MemoryPool* pool);
+
+  /// Returns the bytes allocated by an index of 'numKeys' keys.
+  static uint64_t estimateBytes(uint64_t numKeys);
+
+  /// Returns the row for 'key' or nullptr if 'key' is not in 'this'.
+  char* find(int64_t key) const {
+    const auto hash = hashKey(key);
+    const auto& entry = entries_[slot(hash, pilots_[bucket(hash)])];
+    return entry.key == key ? entry.row : nullptr;
+  }
+
+  /// Sets 'hits[row]' to the row for the key at each of 'rows' in 'keys', or
+  /// to nullptr if the key is not in 'this'. The keys are decoded values of
+  /// type 'T' without nulls. Interleaves the lookups of consecutive rows to
+  /// hide the memory latency of the pilots and slots.
+  template <typename T>
+  void find(
+      const DecodedVector& keys,
+      folly::Range<const vector_size_t*> rows,
+      char** hits) const {
+    constexpr int32_t kGroupSize = 16;
+    uint64_t hashes[kGroupSize];
+    uint64_t slots[kGroupSize];
+    for (auto begin = 0; begin < rows.size(); begin += kGroupSize) {
+      const int32_t numRows =
+          std::min<int32_t>(kGroupSize, rows.size() - begin);
+      for (auto i = 0; i < numRows; ++i) {
+        hashes[i] = hashKey(keys.valueAt<T>(rows[begin + i]));
+        __builtin_prefetch(pilots_ + bucket(hashes[i]));
+      }
+      for (auto i = 0; i < numRows; ++i) {
+        slots[i] = slot(hashes[i], pilots_[bucket(hashes[i])]);
+        __builtin_prefetch(entries_ + slots[i]);
+      }
+      for (auto i = 0; i < numRows; ++i) {
+        const auto row = rows[begin + i];
+        const auto& entry = entries_[slots[i]];
+        hits[row] =
+            entry.key == keys.valueAt<T>(row) ? entry.row : nullptr;
+      }
+    }
+  }
+
+  uint64_t numSlots() const {
+    return numSlots_;
+  }
+
+  /// Returns the bytes allocated for the slots and pilots.
+  int64_t allocatedBytes() const {
+    return entriesBuffer_->capacity() + pilotsBuffer_->capacity();
+  }
+
+ private:
+  struct Entry {
+    int64_t key;
+    // nullptr for an empty slot.
+    char* row;
+  };
+
+  PerfectHashIndex(uint64_t numSlots, uint64_t numBuckets)
+      : numSlots_(numSlots), numBuckets_(numBuckets) {}
+
+  static uint64_t slotsForKeys(uint64_t numKeys);
+
+  static uint64_t bucketsForKeys(uint64_t numKeys);
+
+  static uint64_t hashKey(int64_t key) {
+    // Murmur3 finalizer. A bijection, so distinct keys have distinct hashes.
+    auto hash = static_cast<uint64_t>(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // Maps 'hash' to [0, 'size'), using the high bits of 'hash'.
+  static uint64_t scale(uint64_t hash, uint64_t size) {
+    return (static_cast<__uint128_t>(hash) * size) >> 64;
+  }
+
+  // Uses the low bits of 'hash'. The slot is taken from a remix of all bits,
+  // so that the keys of a bucket are spread over all slots.
+  uint64_t bucket(uint64_t hash) const {
+    return ((hash & 0xffffffff) * numBuckets_) >> 32;
+  }
+
+  uint64_t slot(uint64_t hash, uint16_t pilot) const {
+    return scale(hashKey(hash ^ (pilot * 0x9e3779b97f4a7c15ULL)), numSlots_);
+  }
+
+  // Finds the pilots of all buckets. Returns false if some bucket has no
+  // pilot that places its keys in free slots.
+  bool findPilots(
+      const std::vector<uint64_t>& hashes,
+      const std::vector<uint32_t>& bucketStarts,
+      uint16_t* pilots) const;
+
+  const uint64_t numSlots_;
+  const uint64_t numBuckets_;
+  BufferPtr entriesBuffer_;
+  const Entry* entries_;
+  BufferPtr pilotsBuffer_;
+  const uint16_t* pilots_;
+};
+
+} // namespace facebook::velox::exec
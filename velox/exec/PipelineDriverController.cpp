@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PipelineDriverController.h"
+
+#include <optional>
+
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::exec {
+
+PipelineDriverController::PipelineDriverController(
+    uint32_t numDrivers,
+    uint64_t adjustIntervalMicros)
+    : numDrivers_(numDrivers),
+      adjustIntervalMicros_(adjustIntervalMicros),
+      numActiveDrivers_(numDrivers),
+      lastAdjustMicros_(getCurrentTimeMicro()) {
+  VELOX_CHECK_GT(numDrivers_, 0);
+}
+
+void PipelineDriverController::recordBlocked(
+    BlockingReason reason,
+    uint64_t wallMicros) {
+  std::lock_guard<std::mutex> l(mutex_);
+  switch (reason) {
+    case BlockingReason::kWaitForConsumer:
+      consumerBlockedMicros_ += wallMicros;
+      break;
+    case BlockingReason::kWaitForSplit:
+    case BlockingReason::kWaitForConnector:
+      inputBlockedMicros_ += wallMicros;
+      break;
+    default:
+      break;
+  }
+}
+
+BlockingReason PipelineDriverController::admit(
+    size_t numQueuedSplits,
+    ContinueFuture* future) {
+  std::optional<ContinuePromise> activated;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (finished_) {
+      return BlockingReason::kNotBlocked;
+    }
+    const auto now = getCurrentTimeMicro();
+    if (now - lastAdjustMicros_ < adjustIntervalMicros_) {
+      return BlockingReason::kNotBlocked;
+    }
+    const bool consumerBound = consumerBlockedMicros_ > inputBlockedMicros_;
+    const bool activate = consumerBlockedMicros_ == 0 &&
+        !parkedPromises_.empty() && numQueuedSplits > 0;
+    const bool park = consumerBound && numActiveDrivers_ > 1;
+    lastAdjustMicros_ = now;
+    consumerBlockedMicros_ = 0;
+    inputBlockedMicros_ = 0;
+    if (park) {
+      --numActiveDrivers_;
+      auto [promise, parkFuture] = makeVeloxContinuePromiseContract(
+          "PipelineDriverController::admit");
+      parkedPromises_.push_back(std::move(promise));
+      *future = std::move(parkFuture);
+      return BlockingReason::kWaitForActivation;
+    }
+    if (!activate) {
+      return BlockingReason::kNotBlocked;
+    }
+    ++numActiveDrivers_;
+    activated = std::move(parkedPromises_.back());
+    parkedPromises_.pop_back();
+  }
+  // Realize the promise outside 'mutex_' as this resumes the parked Driver
+  // inline, which records its blocked time here.
+  activated->setValue();
+  return BlockingReason::kNotBlocked;
+}
+
+void PipelineDriverController::activateAll() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    finished_ = true;
+    numActiveDrivers_ += parkedPromises_.size();
+    promises.swap(parkedPromises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+uint32_t PipelineDriverController::numActiveDrivers() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numActiveDrivers_;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "velox/common/future/VeloxPromise.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+/// Adjusts the number of active Drivers of a pipeline whose Drivers take
+/// splits from a shared queue while its Task runs. All Drivers of the pipeline
+/// are created when the Task starts, so that the Driver count of the pipeline
+/// seen by peers, local exchange producers and output buffers does not change.
+/// A Driver which is not needed is parked between splits instead, and is
+/// activated again when the pipeline can use it.
+///
+/// The decisions are made from the time the Drivers of the pipeline spend
+/// blocked and from the depth of the split queue:
+/// - A Driver is parked if the pipeline is blocked more on its consumer, e.g.
+///   a full local exchange queue, than on reading its input. More Drivers
+///   would only add to the queue.
+/// - A parked Driver is activated if there are queued splits and the pipeline
+///   has not been blocked on its consumer, e.g. when the scan is bound by I/O.
+class PipelineDriverController {
+ public:
+  /// Decides at most every 'adjustIntervalMicros' for the pipeline of
+  /// 'numDrivers' Drivers, which all start active.
+  PipelineDriverController(uint32_t numDrivers, uint64_t adjustIntervalMicros);
+
+  /// Records that a Driver of the pipeline was blocked for 'wallMicros' with
+  /// 'reason'.
+  void recordBlocked(BlockingReason reason, uint64_t wallMicros);
+
+  /// Called by a Driver of the pipeline before it takes its next split, with
+  /// the number of splits in the queue. Returns kNotBlocked if the Driver
+  /// continues. Otherwise parks the Driver: returns kWaitForActivation and sets
+  /// 'future', which is realized when the Driver is activated again.
+  BlockingReason admit(size_t numQueuedSplits, ContinueFuture* future);
+
+  /// Activates all the parked Drivers and stops parking, e.g. when the
+  /// pipeline has no more splits or the Task terminates, so that the Drivers
+  /// can finish.
+  void activateAll();
+
+  uint32_t numDrivers() const {
+    return numDrivers_;
+  }
+
+  uint32_t numActiveDrivers() const;
+
+ private:
+  const uint32_t numDrivers_;
+  const uint64_t adjustIntervalMicros_;
+
+  mutable std::mutex mutex_;
+  uint32_t numActiveDrivers_;
+  // Promises of the parked Drivers.
+  std::vector<ContinuePromise> parkedPromises_;
+  bool finished_{false};
+  uint64_t lastAdjustMicros_{0};
+  // Time the Drivers were blocked on their consumer since the last decision.
+  uint64_t consumerBlockedMicros_{0};
+  // Time the Drivers were blocked reading their input since the last
+  // decision.
+  uint64_t inputBlockedMicros_{0};
+};
+
+} // namespace facebook::velox::exec
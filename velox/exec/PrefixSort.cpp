@@ -43,6 +43,25 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  std::string storage;
+  if (!RowContainer::isNullAt(
+          row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = HashStringAllocator::contiguousString(
+        *reinterpret_cast<StringView*>(row + rowColumn.offset()), storage);
+  }
+  prefixSortLayout.encoders[index].encode(
+      value,
+      prefix + prefixSortLayout.prefixOffsets[index],
+      prefixSortLayout.stringPrefixLength);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +91,71 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
+    default:
+      VELOX_UNSUPPORTED(
+          "prefix-sort does not support type kind: {}",
+          mapTypeKindToName(typeKind));
+  }
+}
+
+template <typename T>
+void encodeVectorColumn(
+    const PrefixSortLayout& layout,
+    uint32_t index,
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    char* prefixes) {
+  const auto& encoder = layout.encoders[index];
+  char* dest = prefixes + layout.prefixOffsets[index];
+  for (auto row = 0; row < numRows; ++row) {
+    std::optional<T> value;
+    if (!decoded.isNullAt(row)) {
+      value = decoded.valueAt<T>(row);
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      encoder.encode(value, dest, layout.stringPrefixLength);
+    } else {
+      encoder.encode(value, dest);
+    }
+    dest += layout.normalizedBufferSize;
+  }
+}
+
+void extractVectorColumnToPrefixes(
+    TypeKind typeKind,
+    const PrefixSortLayout& layout,
+    uint32_t index,
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    char* prefixes) {
+  switch (typeKind) {
+    case TypeKind::INTEGER:
+      encodeVectorColumn<int32_t>(layout, index, decoded, numRows, prefixes);
+      return;
+    case TypeKind::BIGINT:
+      encodeVectorColumn<int64_t>(layout, index, decoded, numRows, prefixes);
+      return;
+    case TypeKind::REAL:
+      encodeVectorColumn<float>(layout, index, decoded, numRows, prefixes);
+      return;
+    case TypeKind::DOUBLE:
+      encodeVectorColumn<double>(layout, index, decoded, numRows, prefixes);
+      return;
+    case TypeKind::TIMESTAMP:
+      encodeVectorColumn<Timestamp>(layout, index, decoded, numRows, prefixes);
+      return;
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY:
+      encodeVectorColumn<StringView>(
+          layout, index, decoded, numRows, prefixes);
+      return;
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -93,7 +177,7 @@ FOLLY_ALWAYS_INLINE void bitsSwapByWord(uint64_t* address, int32_t bytes) {
 }
 
 FOLLY_ALWAYS_INLINE int
-compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
+compareByWord(const uint64_t* left, const uint64_t* right, int32_t bytes) {
   while (bytes != 0) {
     if (*left == *right) {
       ++left;
@@ -115,27 +199,35 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
+  bool lastNormalizedKeyIsPrefix = false;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
-  // cannot be normalized is encountered.
+  // cannot be normalized is encountered. A string key is only normalized to
+  // a prefix, so that it is the last normalized key.
   for (auto i = 0; i < numKeys; ++i) {
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
+    const auto kind = types[i]->kind();
     std::optional<uint32_t> encodedSize =
-        PrefixSortEncoder::encodedSize(types[i]->kind());
+        PrefixSortEncoder::encodedSize(kind, maxStringPrefixLength);
     if (encodedSize.has_value()) {
       prefixOffsets.push_back(normalizedKeySize);
       encoders.push_back(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
+      if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+        lastNormalizedKeyIsPrefix = true;
+        break;
+      }
     } else {
       break;
     }
@@ -149,7 +241,9 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      numNormalizedKeys < numKeys || lastNormalizedKeyIsPrefix,
+      lastNormalizedKeyIsPrefix,
+      maxStringPrefixLength,
       std::move(prefixOffsets),
       std::move(encoders),
       padding};
@@ -167,10 +261,11 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   if (result != 0) {
     return result;
   }
-  // If prefixes are equal, compare the left sort keys with rowContainer.
+  // If prefixes are equal, compare the left sort keys with rowContainer. This
+  // includes the last normalized key if only a prefix of it is normalized.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  for (auto i = sortLayout_.firstTieBreakKey(); i < sortLayout_.numKeys; ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -184,9 +279,17 @@ PrefixSort::PrefixSort(
     memory::MemoryPool* pool,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& keyCompareFlags,
-    const PrefixSortConfig& config,
+    const common::PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
-    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+    : pool_(pool),
+      config_(config),
+      sortLayout_(sortLayout),
+      rowContainer_(rowContainer) {}
+
+bool PrefixSort::useRadixSort(size_t numRows) const {
+  return config_.radixSortMinRows > 0 && numRows >= config_.radixSortMinRows &&
+      sortLayout_.normalizedBufferSize <= config_.radixSortMaxKeySize;
+}
 
 void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; i++) {
@@ -213,8 +316,64 @@ void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   getAddressFromPrefix(prefix) = row;
 }
 
-void PrefixSort::sortInternal(std::vector<char*>& rows) {
-  const auto numRows = rows.size();
+// static
+void PrefixSort::encodeNormalizedKeys(
+    const PrefixSortLayout& layout,
+    const std::vector<const BaseVector*>& keys,
+    vector_size_t numRows,
+    char* prefixes) {
+  VELOX_CHECK_GE(keys.size(), layout.numNormalizedKeys);
+  const SelectivityVector rows(numRows);
+  DecodedVector decoded;
+  for (auto i = 0; i < layout.numNormalizedKeys; ++i) {
+    decoded.decode(*keys[i], rows);
+    extractVectorColumnToPrefixes(
+        keys[i]->typeKind(), layout, i, decoded, numRows, prefixes);
+  }
+  // Zero the padding and byte swap the words as in extractRowToPrefix().
+  const auto entrySize = layout.normalizedBufferSize;
+  for (auto row = 0; row < numRows; ++row) {
+    char* const prefix = prefixes + row * entrySize;
+    simd::memset(prefix + entrySize - layout.padding, 0, layout.padding);
+    bitsSwapByWord((uint64_t*)prefix, entrySize);
+  }
+}
+
+// static
+int PrefixSort::compareNormalizedKeys(
+    const PrefixSortLayout& layout,
+    const char* left,
+    const char* right) {
+  return compareByWord(
+      (const uint64_t*)left,
+      (const uint64_t*)right,
+      layout.normalizedBufferSize);
+}
+
+uint64_t PrefixSort::maxRequiredBytes(
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    const common::PrefixSortConfig& config,
+    size_t numRows) {
+  if (static_cast<int64_t>(numRows) < config.threshold) {
+    return 0;
+  }
+  const auto sortLayout = PrefixSortLayout::makeSortLayout(
+      rowContainer->keyTypes(),
+      compareFlags,
+      config.maxNormalizedKeySize,
+      config.maxStringPrefixLength);
+  if (sortLayout.noNormalizedKeys) {
+    return 0;
+  }
+  // The prefixes and the swap buffer of one entry.
+  return memory::AllocationTraits::pageBytes(
+             memory::AllocationTraits::numPages(
+                 numRows * sortLayout.entrySize)) +
+      sortLayout.entrySize;
+}
+
+void PrefixSort::sortInternal(char** rows, size_t numRows) {
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixAllocation;
   // 1. Allocate prefixes data.
@@ -226,7 +385,7 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
   char* const prefixes = prefixAllocation.data<char>();
 
   // 2. Extract rows to prefixes with row address.
-  for (auto i = 0; i < rows.size(); ++i) {
+  for (auto i = 0; i < numRows; ++i) {
     extractRowToPrefix(rows[i], prefixes + entrySize * i);
   }
 
@@ -236,7 +395,18 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     const auto start = prefixes;
     const auto end = prefixes + numRows * entrySize;
-    if (sortLayout_.hasNonNormalizedKey) {
+    const auto keySize = sortLayout_.normalizedBufferSize;
+    if (useRadixSort(numRows)) {
+      if (sortLayout_.hasNonNormalizedKey) {
+        sortRunner.radixSort(start, end, keySize, [&](char* a, char* b) {
+          return comparePartNormalizedKeys(a, b);
+        });
+      } else {
+        sortRunner.radixSort(start, end, keySize, [&](char* a, char* b) {
+          return compareAllNormalizedKeys(a, b);
+        });
+      }
+    } else if (sortLayout_.hasNonNormalizedKey) {
       sortRunner.quickSort(start, end, [&](char* a, char* b) {
         return comparePartNormalizedKeys(a, b);
       });
@@ -247,7 +417,7 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
     }
   }
   // 4. Output sorted row addresses.
-  for (int i = 0; i < rows.size(); i++) {
+  for (int i = 0; i < numRows; i++) {
     rows[i] = getAddressFromPrefix(prefixes + i * entrySize);
   }
 }
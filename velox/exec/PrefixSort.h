@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
@@ -24,8 +25,9 @@ namespace facebook::velox::exec {
 
 namespace detail {
 
+template <typename TRows>
 FOLLY_ALWAYS_INLINE void stdSort(
-    std::vector<char*>& rows,
+    TRows& rows,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
   std::sort(
@@ -41,25 +43,10 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }
 }; // namespace detail
 
-struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
-
-  /// Max number of bytes can store normalized keys in prefix-sort buffer per
-  /// entry.
-  const uint32_t maxNormalizedKeySize;
-
-  /// PrefixSort will have performance regression when the dateset is too small.
-  /// The threshold is set to 100 according to the benchmark test results by
-  /// default.
-  const int64_t threshold;
-};
-
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 1. normalized keys. A string key is normalized to its first
+/// 'maxStringPrefixLength' bytes, see 'lastNormalizedKeyIsPrefix'.
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
@@ -82,9 +69,21 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the sort keys contains non-normalized key or a key normalized to
+  /// a prefix of its value. If so, rows with equal normalized keys are
+  /// compared with the RowContainer.
   const bool hasNonNormalizedKey;
 
+  /// Whether the last normalized key is a string key of which only a prefix
+  /// is in the normalized keys. Rows with equal normalized keys are then
+  /// compared on this key and the following ones with the RowContainer. No
+  /// keys are normalized after a string key.
+  const bool lastNormalizedKeyIsPrefix;
+
+  /// The number of bytes a string key is normalized to, excluding the null
+  /// byte.
+  const uint32_t stringPrefixLength;
+
   /// Offsets of normalized keys, used to find write locations when
   /// extracting columns
   const std::vector<uint32_t> prefixOffsets;
@@ -99,7 +98,15 @@ struct PrefixSortLayout {
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength);
+
+  /// Returns the index of the first key that is compared with the RowContainer
+  /// when the normalized keys of two rows are equal.
+  uint32_t firstTieBreakKey() const {
+    return lastNormalizedKeyIsPrefix ? numNormalizedKeys - 1
+                                     : numNormalizedKeys;
+  }
 };
 
 class PrefixSort {
@@ -108,7 +115,7 @@ class PrefixSort {
       memory::MemoryPool* pool,
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& keyCompareFlags,
-      const PrefixSortConfig& config,
+      const common::PrefixSortConfig& config,
       const PrefixSortLayout& sortLayout);
 
   /// Follow the steps below to sort the data in RowContainer:
@@ -117,36 +124,42 @@ class PrefixSort {
   /// normalized, normalize it. For this kind of keys can be normalized，we
   /// combine them with the original row address ptr and store them
   /// together into a buffer, called 'Prefix'.
-  /// 3. Sort the prefixes data we got in step 2.
+  /// 3. Sort the prefixes data we got in step 2. With at least
+  /// 'config.radixSortMinRows' rows and at most 'config.radixSortMaxKeySize'
+  /// bytes of normalized keys, the prefixes are radix sorted on the normalized
+  /// keys, otherwise they are quick sorted.
   /// For keys can normalized(All fixed width types), we use 'memcmp' to compare
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For string keys, we store the first 'maxStringPrefixLength' bytes in the
+  /// prefix and compare the full values with the RowContainer only if the
+  /// prefixes are equal.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
   /// them in the prefix buffer) into the input rows vector.
   ///
   /// @param rows The result of RowContainer::listRows(), assuming that the
-  /// caller (SortBuffer etc.) has already got the result.
+  /// caller (SortBuffer etc.) has already got the result. A
+  /// std::vector<char*> with any allocator.
+  template <typename TRows>
   FOLLY_ALWAYS_INLINE static void sort(
-      std::vector<char*>& rows,
+      TRows& rows,
       memory::MemoryPool* pool,
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& compareFlags,
-      const PrefixSortConfig& config) {
-    if (rowContainer->numRows() < config.threshold) {
+      const common::PrefixSortConfig& config) {
+    if (static_cast<int64_t>(rows.size()) < config.threshold) {
       detail::stdSort(rows, rowContainer, compareFlags);
       return;
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -155,11 +168,42 @@ class PrefixSort {
     }
 
     PrefixSort prefixSort(pool, rowContainer, compareFlags, config, sortLayout);
-    prefixSort.sortInternal(rows);
+    prefixSort.sortInternal(rows.data(), rows.size());
   }
 
+  /// Returns the number of bytes sort() allocates from the pool to sort
+  /// 'numRows' rows of 'rowContainer', or 0 if it falls back to std::sort.
+  /// Callers that track memory reservations reserve this much before
+  /// sorting.
+  static uint64_t maxRequiredBytes(
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const common::PrefixSortConfig& config,
+      size_t numRows);
+
+  /// Encodes the normalized keys of the first 'numRows' rows of 'keys' into
+  /// 'prefixes', 'layout.normalizedBufferSize' bytes per row. 'keys' are the
+  /// sort key columns in the order of 'layout'. Used to compare rows of
+  /// vectors, e.g. in a merge, with compareNormalizedKeys().
+  static void encodeNormalizedKeys(
+      const PrefixSortLayout& layout,
+      const std::vector<const BaseVector*>& keys,
+      vector_size_t numRows,
+      char* prefixes);
+
+  /// Compares two rows encoded by encodeNormalizedKeys(). If the result is 0
+  /// and 'layout.hasNonNormalizedKey' is true, the rows must be compared on
+  /// the keys from 'layout.firstTieBreakKey()' on.
+  static int compareNormalizedKeys(
+      const PrefixSortLayout& layout,
+      const char* left,
+      const char* right);
+
  private:
-  void sortInternal(std::vector<char*>& rows);
+  void sortInternal(char** rows, size_t numRows);
+
+  // Returns true if 'numRows' prefixes are sorted with a radix sort.
+  bool useRadixSort(size_t numRows) const;
 
   int compareAllNormalizedKeys(char* left, char* right);
 
@@ -173,6 +217,7 @@ class PrefixSort {
   }
 
   memory::MemoryPool* const pool_;
+  const common::PrefixSortConfig config_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
 };
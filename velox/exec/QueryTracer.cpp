@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/QueryTracer.h"
+
+#include <folly/String.h>
+#include <folly/json.h>
+#include <glog/logging.h>
+#include <sstream>
+
+#include "velox/common/base/Fs.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+void addSourceIds(
+    const core::PlanNode& node,
+    std::unordered_set<core::PlanNodeId>& ids) {
+  for (const auto& source : node.sources()) {
+    ids.insert(source->id());
+    addSourceIds(*source, ids);
+  }
+}
+
+} // namespace
+
+// static
+std::unique_ptr<QueryTracer> QueryTracer::create(
+    const core::PlanNodePtr& planNode,
+    const core::QueryConfig& config,
+    const std::string& queryId,
+    const std::string& taskId) {
+  if (!config.queryTraceEnabled()) {
+    return nullptr;
+  }
+  VELOX_USER_CHECK(
+      !config.queryTraceDir().empty(),
+      "{} must be set to trace a query",
+      core::QueryConfig::kQueryTraceDir);
+  std::vector<core::PlanNodeId> nodeIds;
+  folly::split(',', config.queryTraceNodeIds(), nodeIds, true);
+  auto queryConfigs = config.rawConfigs();
+  // The replay is not traced.
+  queryConfigs.erase(core::QueryConfig::kQueryTraceEnabled);
+  return std::make_unique<QueryTracer>(
+      planNode,
+      nodeIds,
+      queryConfigs,
+      fmt::format("{}/{}/{}", config.queryTraceDir(), queryId, taskId),
+      config.queryTraceMaxBytes());
+}
+
+QueryTracer::QueryTracer(
+    const core::PlanNodePtr& planNode,
+    const std::vector<core::PlanNodeId>& nodeIds,
+    const std::unordered_map<std::string, std::string>& queryConfigs,
+    const std::string& directory,
+    uint64_t maxBytes)
+    : maxBytes_(maxBytes) {
+  folly::dynamic configJson = folly::dynamic::object;
+  for (const auto& [key, value] : queryConfigs) {
+    configJson[key] = value;
+  }
+  const auto configString = folly::toJson(configJson);
+  for (const auto& id : nodeIds) {
+    const auto* node = core::PlanNode::findFirstNode(
+        planNode.get(),
+        [&](const core::PlanNode* node) { return node->id() == id; });
+    // The node may be in the plan fragment of another task.
+    if (node == nullptr) {
+      continue;
+    }
+    auto& tracedNode = nodes_[id];
+    tracedNode.directory = fmt::format("{}/{}", directory, id);
+    addSourceIds(*node, tracedNode.sourceIds);
+    fs::create_directories(tracedNode.directory);
+    saveStringToFile(
+        folly::toJson(node->serialize()),
+        fmt::format("{}/{}", tracedNode.directory, kPlanFileName).c_str());
+    saveStringToFile(
+        configString,
+        fmt::format("{}/{}", tracedNode.directory, kQueryConfigFileName)
+            .c_str());
+  }
+}
+
+void QueryTracer::traceInput(
+    const core::PlanNodeId& planNodeId,
+    const core::PlanNodeId& sourceId,
+    const RowVectorPtr& input) {
+  auto it = nodes_.find(planNodeId);
+  if (it == nodes_.end() || it->second.sourceIds.count(sourceId) == 0) {
+    return;
+  }
+  input->loadedVector();
+  std::ostringstream out;
+  saveVector(*input, out);
+  auto data = out.str();
+
+  std::string path;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (full_) {
+      return;
+    }
+    if (tracedBytes_ + data.size() > maxBytes_) {
+      full_ = true;
+      LOG(WARNING) << "Stopped tracing input after " << tracedBytes_
+                   << " bytes in " << it->second.directory;
+      return;
+    }
+    tracedBytes_ += data.size();
+    auto& tracedNode = it->second;
+    path = fmt::format(
+        "{}/{}/{}",
+        tracedNode.directory,
+        sourceId,
+        tracedNode.numBatches[sourceId]++);
+    if (tracedNode.numBatches[sourceId] == 1) {
+      fs::create_directories(
+          fmt::format("{}/{}", tracedNode.directory, sourceId));
+    }
+  }
+  saveStringToFile(data, path.c_str());
+}
+
+uint64_t QueryTracer::tracedBytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return tracedBytes_;
+}
+
+} // namespace facebook::velox::exec
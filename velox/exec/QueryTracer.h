@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
+
+namespace facebook::velox::exec {
+
+/// Saves the input of plan nodes of a task, so that a slow node of a
+/// production query can be replayed and profiled without the data of the
+/// query. Enabled by the query_trace_* query configs.
+///
+/// The trace of a node is in '<query_trace_dir>/<queryId>/<taskId>/<nodeId>'.
+/// It has 'plan.json' with the plan fragment rooted at the node,
+/// 'query_config.json' with the query config and, for each source of the
+/// node, a subdirectory named after the id of the source with the batches
+/// the source produced in files 0, 1, 2... This is the layout that
+/// velox_operator_replay_benchmark replays.
+///
+/// The input of a node is what the operators of the node get in addInput(),
+/// so the input of source operators like TableScan and Exchange is not
+/// traced. Lazy vectors are loaded before they are saved.
+class QueryTracer {
+ public:
+  static constexpr const char* kPlanFileName = "plan.json";
+  static constexpr const char* kQueryConfigFileName = "query_config.json";
+
+  /// Returns a tracer for the task 'taskId' of 'queryId' that runs
+  /// 'planNode' if 'config' enables tracing, nullptr otherwise.
+  static std::unique_ptr<QueryTracer> create(
+      const core::PlanNodePtr& planNode,
+      const core::QueryConfig& config,
+      const std::string& queryId,
+      const std::string& taskId);
+
+  /// Traces the nodes 'nodeIds' of 'planNode' to 'directory'. Saves at most
+  /// 'maxBytes' of input.
+  QueryTracer(
+      const core::PlanNodePtr& planNode,
+      const std::vector<core::PlanNodeId>& nodeIds,
+      const std::unordered_map<std::string, std::string>& queryConfigs,
+      const std::string& directory,
+      uint64_t maxBytes);
+
+  /// Saves 'input' if it goes from the operator of 'sourceId' to the
+  /// operator of a traced node 'planNodeId'.
+  void traceInput(
+      const core::PlanNodeId& planNodeId,
+      const core::PlanNodeId& sourceId,
+      const RowVectorPtr& input);
+
+  /// Returns the bytes of input saved so far.
+  uint64_t tracedBytes() const;
+
+ private:
+  struct TracedNode {
+    std::string directory;
+
+    // The ids of the nodes below the traced node. Input from operators of
+    // other nodes is not saved.
+    std::unordered_set<core::PlanNodeId> sourceIds;
+
+    // Number of saved batches by source id.
+    std::unordered_map<core::PlanNodeId, int32_t> numBatches;
+  };
+
+  const uint64_t maxBytes_;
+  std::unordered_map<core::PlanNodeId, TracedNode> nodes_;
+
+  mutable std::mutex mutex_;
+  uint64_t tracedBytes_{0};
+  bool full_{false};
+};
+
+} // namespace facebook::velox::exec
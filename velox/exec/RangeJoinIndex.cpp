@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/RangeJoinIndex.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// A comparison 'build <op> probe' between a build and a probe column.
+enum class Comparison { kLt, kLte, kGt, kGte, kEq };
+
+std::optional<Comparison> toComparison(const std::string& name) {
+  if (name == "lt") {
+    return Comparison::kLt;
+  }
+  if (name == "lte") {
+    return Comparison::kLte;
+  }
+  if (name == "gt") {
+    return Comparison::kGt;
+  }
+  if (name == "gte") {
+    return Comparison::kGte;
+  }
+  if (name == "eq") {
+    return Comparison::kEq;
+  }
+  return std::nullopt;
+}
+
+// Returns the comparison with the sides swapped.
+Comparison flip(Comparison comparison) {
+  switch (comparison) {
+    case Comparison::kLt:
+      return Comparison::kGt;
+    case Comparison::kLte:
+      return Comparison::kGte;
+    case Comparison::kGt:
+      return Comparison::kLt;
+    case Comparison::kGte:
+      return Comparison::kLte;
+    case Comparison::kEq:
+      return Comparison::kEq;
+  }
+  VELOX_UNREACHABLE();
+}
+
+// Returns true if vectors of 'type' order values the same way as the SQL
+// comparison functions. Custom types, e.g. TIMESTAMP WITH TIME ZONE, may
+// compare differently than their physical values.
+bool canCompare(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return type->isDate() || type->isDecimal() ||
+          type->equivalent(*createScalarType(type->kind()));
+    default:
+      return false;
+  }
+}
+
+const core::FieldAccessTypedExpr* asInputColumn(
+    const core::TypedExprPtr& expr) {
+  const auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  return field != nullptr && field->isInputColumn() ? field : nullptr;
+}
+
+struct ChannelBound {
+  column_index_t buildChannel;
+  RangeJoinKeys::Bound bound;
+};
+
+// Adds the bounds that 'left <comparison> right' places on a build column if
+// one side is a build column and the other a probe column of the same type.
+void addBounds(
+    Comparison comparison,
+    const core::TypedExprPtr& left,
+    const core::TypedExprPtr& right,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType,
+    std::vector<ChannelBound>& bounds) {
+  const auto* leftColumn = asInputColumn(left);
+  const auto* rightColumn = asInputColumn(right);
+  if (leftColumn == nullptr || rightColumn == nullptr) {
+    return;
+  }
+  // Names are resolved against the probe side first, as in
+  // NestedLoopJoinProbe::initializeFilter().
+  const auto leftProbe = probeType->getChildIdxIfExists(leftColumn->name());
+  const auto rightProbe = probeType->getChildIdxIfExists(rightColumn->name());
+  std::optional<column_index_t> buildChannel;
+  std::optional<column_index_t> probeChannel;
+  if (!leftProbe.has_value() && rightProbe.has_value()) {
+    buildChannel = buildType->getChildIdxIfExists(leftColumn->name());
+    probeChannel = rightProbe;
+  } else if (leftProbe.has_value() && !rightProbe.has_value()) {
+    buildChannel = buildType->getChildIdxIfExists(rightColumn->name());
+    probeChannel = leftProbe;
+    comparison = flip(comparison);
+  }
+  if (!buildChannel.has_value()) {
+    return;
+  }
+  const auto& type = buildType->childAt(buildChannel.value());
+  if (!canCompare(type) ||
+      !type->equivalent(*probeType->childAt(probeChannel.value()))) {
+    return;
+  }
+  const auto channel = buildChannel.value();
+  const auto probe = probeChannel.value();
+  switch (comparison) {
+    case Comparison::kLt:
+      bounds.push_back({channel, {probe, false, false}});
+      break;
+    case Comparison::kLte:
+      bounds.push_back({channel, {probe, false, true}});
+      break;
+    case Comparison::kGt:
+      bounds.push_back({channel, {probe, true, false}});
+      break;
+    case Comparison::kGte:
+      bounds.push_back({channel, {probe, true, true}});
+      break;
+    case Comparison::kEq:
+      bounds.push_back({channel, {probe, true, true}});
+      bounds.push_back({channel, {probe, false, true}});
+      break;
+  }
+}
+
+// Adds the bounds placed by the conjuncts of 'expr'.
+void collectBounds(
+    const core::TypedExprPtr& expr,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType,
+    std::vector<ChannelBound>& bounds) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  const auto& inputs = call->inputs();
+  if (call->name() == "and") {
+    for (const auto& input : inputs) {
+      collectBounds(input, probeType, buildType, bounds);
+    }
+    return;
+  }
+  if (call->name() == "between" && inputs.size() == 3) {
+    addBounds(
+        Comparison::kGte, inputs[0], inputs[1], probeType, buildType, bounds);
+    addBounds(
+        Comparison::kLte, inputs[0], inputs[2], probeType, buildType, bounds);
+    return;
+  }
+  const auto comparison = toComparison(call->name());
+  if (comparison.has_value() && inputs.size() == 2) {
+    addBounds(
+        comparison.value(), inputs[0], inputs[1], probeType, buildType, bounds);
+  }
+}
+
+} // namespace
+
+// static
+std::optional<RangeJoinKeys> RangeJoinKeys::create(
+    const core::TypedExprPtr& condition,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<ChannelBound> bounds;
+  collectBounds(condition, probeType, buildType, bounds);
+  if (bounds.empty()) {
+    return std::nullopt;
+  }
+
+  auto isBounded = [&](column_index_t channel, bool lower) {
+    return std::any_of(bounds.begin(), bounds.end(), [&](const auto& bound) {
+      return bound.buildChannel == channel && bound.bound.lower == lower;
+    });
+  };
+
+  RangeJoinKeys keys;
+  // Prefers a column bounded from both sides, then a column bounded from
+  // above with another column bounded from below, i.e. build side intervals
+  // containing the probe value.
+  std::optional<column_index_t> sortChannel;
+  for (const auto& bound : bounds) {
+    if (isBounded(bound.buildChannel, true) &&
+        isBounded(bound.buildChannel, false)) {
+      sortChannel = bound.buildChannel;
+      break;
+    }
+  }
+  for (const auto& upper : bounds) {
+    if (sortChannel.has_value()) {
+      break;
+    }
+    for (const auto& lower : bounds) {
+      if (!upper.bound.lower && lower.bound.lower &&
+          lower.buildChannel != upper.buildChannel) {
+        sortChannel = upper.buildChannel;
+        keys.cutChannel = lower.buildChannel;
+        keys.cutBound = lower.bound;
+        break;
+      }
+    }
+  }
+  keys.sortChannel = sortChannel.value_or(bounds[0].buildChannel);
+  for (const auto& bound : bounds) {
+    if (bound.buildChannel == keys.sortChannel) {
+      keys.sortBounds.push_back(bound.bound);
+    }
+  }
+  return keys;
+}
+
+RangeJoinIndex::RangeJoinIndex(
+    const RangeJoinKeys& keys,
+    const RowVectorPtr& build)
+    : keys_(keys),
+      build_(build),
+      sortKey_(build->childAt(keys.sortChannel)->loadedVector()),
+      cutKey_(
+          keys.cutChannel.has_value()
+              ? build->childAt(keys.cutChannel.value())->loadedVector()
+              : nullptr) {
+  sortedRows_.reserve(build->size());
+  for (vector_size_t row = 0; row < build->size(); ++row) {
+    if (!sortKey_->isNullAt(row)) {
+      sortedRows_.push_back(row);
+    }
+  }
+  sortKey_->sortIndices(sortedRows_, CompareFlags());
+
+  if (cutKey_ == nullptr) {
+    return;
+  }
+  maxCutRows_.resize(sortedRows_.size());
+  vector_size_t maxRow = -1;
+  for (auto i = 0; i < sortedRows_.size(); ++i) {
+    const auto row = sortedRows_[i];
+    if (!cutKey_->isNullAt(row) &&
+        (maxRow < 0 || cutKey_->compare(cutKey_, row, maxRow) > 0)) {
+      maxRow = row;
+    }
+    maxCutRows_[i] = maxRow;
+  }
+}
+
+vector_size_t RangeJoinIndex::firstAbove(
+    const BaseVector& probeKey,
+    vector_size_t row,
+    bool orEqual) const {
+  const auto it = std::partition_point(
+      sortedRows_.begin(), sortedRows_.end(), [&](vector_size_t buildRow) {
+        const auto result = sortKey_->compare(&probeKey, buildRow, row);
+        return orEqual ? result < 0 : result <= 0;
+      });
+  return it - sortedRows_.begin();
+}
+
+std::pair<vector_size_t, vector_size_t> RangeJoinIndex::candidates(
+    const RowVector& probe,
+    vector_size_t row) const {
+  vector_size_t begin = 0;
+  vector_size_t end = sortedRows_.size();
+  for (const auto& bound : keys_.sortBounds) {
+    const auto* probeKey = probe.childAt(bound.probeChannel)->loadedVector();
+    if (probeKey->isNullAt(row)) {
+      return {0, 0};
+    }
+    if (bound.lower) {
+      begin = std::max(begin, firstAbove(*probeKey, row, bound.inclusive));
+    } else {
+      end = std::min(end, firstAbove(*probeKey, row, !bound.inclusive));
+    }
+  }
+  if (cutKey_ != nullptr && begin < end) {
+    const auto& bound = keys_.cutBound.value();
+    const auto* probeKey = probe.childAt(bound.probeChannel)->loadedVector();
+    if (probeKey->isNullAt(row)) {
+      return {0, 0};
+    }
+    // The rows before the first one whose running maximum of the cut key
+    // passes the bound all fail it.
+    const auto it = std::partition_point(
+        maxCutRows_.begin() + begin,
+        maxCutRows_.begin() + end,
+        [&](vector_size_t maxRow) {
+          if (maxRow < 0) {
+            return true;
+          }
+          const auto result = cutKey_->compare(probeKey, maxRow, row);
+          return bound.inclusive ? result < 0 : result <= 0;
+        });
+    begin = it - maxCutRows_.begin();
+  }
+  return {begin, std::max(begin, end)};
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// The columns of a nested loop join condition that allow finding the build
+/// rows a probe row may match with binary searches. These come from
+/// conjuncts that compare a build column with a probe column using <, <=, >,
+/// >=, = or BETWEEN. The build rows are sorted on one such build column. If
+/// that column is only bounded from above, e.g. 'b.start <= p.ts', a bound
+/// from below on another build column, e.g. 'b.end >= p.ts', is used to
+/// skip the leading rows that end before the probe value.
+struct RangeJoinKeys {
+  /// A bound on a build column by a probe column.
+  struct Bound {
+    column_index_t probeChannel;
+    /// True if the build column is at least the probe column, false if at
+    /// most.
+    bool lower;
+    /// True if the build column may equal the probe column.
+    bool inclusive;
+  };
+
+  /// Returns the keys for 'condition' or std::nullopt if no conjunct of
+  /// 'condition' bounds a build column by a probe column of the same
+  /// primitive type.
+  static std::optional<RangeJoinKeys> create(
+      const core::TypedExprPtr& condition,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  /// The build column the rows are sorted on.
+  column_index_t sortChannel;
+  std::vector<Bound> sortBounds;
+
+  /// A build column other than 'sortChannel' bounded from below, used if
+  /// 'sortChannel' is only bounded from above.
+  std::optional<column_index_t> cutChannel;
+  std::optional<Bound> cutBound;
+};
+
+/// The rows of a build vector sorted on the sort column of RangeJoinKeys.
+/// Finds the range of sorted rows that may match a probe row. The rows in
+/// the range still need to be checked against the whole join condition.
+class RangeJoinIndex {
+ public:
+  RangeJoinIndex(const RangeJoinKeys& keys, const RowVectorPtr& build);
+
+  /// Returns the positions [begin, end) in the sorted rows that may match
+  /// 'row' of 'probe'. Rows with a null sort key never match.
+  std::pair<vector_size_t, vector_size_t> candidates(
+      const RowVector& probe,
+      vector_size_t row) const;
+
+  /// Returns the build row at 'position' in sorted order.
+  vector_size_t buildRow(vector_size_t position) const {
+    return sortedRows_[position];
+  }
+
+ private:
+  // Returns the first position whose sort key is greater than, or equal to if
+  // 'orEqual' is true, the value at 'row' of 'probeKey'.
+  vector_size_t firstAbove(
+      const BaseVector& probeKey,
+      vector_size_t row,
+      bool orEqual) const;
+
+  const RangeJoinKeys& keys_;
+  const RowVectorPtr build_;
+  BaseVector* const sortKey_;
+  BaseVector* const cutKey_;
+
+  // The rows with a non-null sort key in ascending order of the key.
+  std::vector<vector_size_t> sortedRows_;
+
+  // The row with the largest non-null cut key among the first i + 1 sorted
+  // rows, or -1 if all their cut keys are null. Non-decreasing in cut key.
+  std::vector<vector_size_t> maxCutRows_;
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+
+#include <numeric>
+
+namespace facebook::velox::exec {
+namespace {
+std::vector<CompareFlags> toCompareFlags(
+    const std::vector<core::SortOrder>& sortingOrders) {
+  std::vector<CompareFlags> compareFlags;
+  compareFlags.reserve(sortingOrders.size());
+  for (const auto& order : sortingOrders) {
+    compareFlags.push_back(
+        CompareFlags{order.isNullsFirst(), order.isAscending(), false});
+  }
+  return compareFlags;
+}
+
+// Compares row 'left' of 'leftKeys' with row 'right' of 'rightKeys'.
+int32_t compareKeys(
+    const std::vector<const BaseVector*>& leftKeys,
+    vector_size_t left,
+    const std::vector<const BaseVector*>& rightKeys,
+    vector_size_t right,
+    const std::vector<CompareFlags>& compareFlags) {
+  for (auto i = 0; i < compareFlags.size(); ++i) {
+    const auto result =
+        leftKeys[i]->compare(rightKeys[i], left, right, compareFlags[i])
+            .value();
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+} // namespace
+
+RangePartitionFunction::RangePartitionFunction(
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<core::SortOrder>& sortingOrders,
+    RowVectorPtr splitters)
+    : keyChannels_{keyChannels},
+      compareFlags_{toCompareFlags(sortingOrders)},
+      splitters_{std::move(splitters)},
+      decodedKeys_(keyChannels.size()) {
+  VELOX_CHECK(!keyChannels_.empty());
+  VELOX_CHECK_EQ(keyChannels_.size(), compareFlags_.size());
+  VELOX_CHECK_NOT_NULL(splitters_);
+  VELOX_CHECK_EQ(keyChannels_.size(), splitters_->childrenSize());
+}
+
+uint32_t RangePartitionFunction::findPartition(vector_size_t row) const {
+  // Binary search for the first splitter greater than 'row'.
+  uint32_t low = 0;
+  uint32_t high = splitters_->size();
+  while (low < high) {
+    const auto middle = (low + high) / 2;
+    int32_t result = 0;
+    for (auto i = 0; i < keyChannels_.size(); ++i) {
+      const auto& decoded = decodedKeys_[i];
+      result = decoded.base()
+                   ->compare(
+                       splitters_->childAt(i).get(),
+                       decoded.index(row),
+                       middle,
+                       compareFlags_[i])
+                   .value();
+      if (result != 0) {
+        break;
+      }
+    }
+    if (result < 0) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+std::optional<uint32_t> RangePartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  if (splitters_->size() == 0) {
+    return 0u;
+  }
+
+  const auto size = input.size();
+  rows_.resize(size);
+  rows_.setAll();
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    decodedKeys_[i].decode(*input.childAt(keyChannels_[i]), rows_);
+  }
+
+  partitions.resize(size);
+  for (auto row = 0; row < size; ++row) {
+    partitions[row] = findPartition(row);
+  }
+  return std::nullopt;
+}
+
+// static
+RowVectorPtr RangePartitionFunction::computeSplitters(
+    const RowVector& sample,
+    const std::vector<column_index_t>& keyChannels,
+    const std::vector<core::SortOrder>& sortingOrders,
+    int numPartitions,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK_GT(numPartitions, 0);
+  VELOX_CHECK_EQ(keyChannels.size(), sortingOrders.size());
+  const auto compareFlags = toCompareFlags(sortingOrders);
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<const BaseVector*> keys;
+  for (const auto channel : keyChannels) {
+    names.push_back(sample.type()->asRow().nameOf(channel));
+    types.push_back(sample.childAt(channel)->type());
+    keys.push_back(sample.childAt(channel).get());
+  }
+
+  std::vector<vector_size_t> sortedRows(sample.size());
+  std::iota(sortedRows.begin(), sortedRows.end(), 0);
+  std::sort(
+      sortedRows.begin(),
+      sortedRows.end(),
+      [&](vector_size_t left, vector_size_t right) {
+        return compareKeys(keys, left, keys, right, compareFlags) < 0;
+      });
+
+  // Picks the row at each quantile, skipping the ones equal to the previous
+  // splitter.
+  std::vector<vector_size_t> splitterRows;
+  for (auto i = 1; i < numPartitions && !sortedRows.empty(); ++i) {
+    const auto row = sortedRows[(int64_t)sortedRows.size() * i / numPartitions];
+    if (!splitterRows.empty() &&
+        compareKeys(keys, splitterRows.back(), keys, row, compareFlags) == 0) {
+      continue;
+    }
+    splitterRows.push_back(row);
+  }
+
+  const auto numSplitters = splitterRows.size();
+  auto splitters = BaseVector::create<RowVector>(
+      ROW(std::move(names), std::move(types)), numSplitters, pool);
+  for (auto i = 0; i < keys.size(); ++i) {
+    auto& child = splitters->childAt(i);
+    for (auto row = 0; row < numSplitters; ++row) {
+      child->copy(keys[i], row, splitterRows[row], 1);
+    }
+  }
+  return splitters;
+}
+
+RangePartitionFunctionSpec::RangePartitionFunctionSpec(
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortingOrders,
+    RowVectorPtr splitters)
+    : inputType_{std::move(inputType)},
+      keyChannels_{std::move(keyChannels)},
+      sortingOrders_{std::move(sortingOrders)},
+      splitters_{std::move(splitters)} {
+  VELOX_CHECK_EQ(keyChannels_.size(), sortingOrders_.size());
+}
+
+std::unique_ptr<core::PartitionFunction> RangePartitionFunctionSpec::create(
+    int numPartitions) const {
+  VELOX_CHECK_LE(
+      splitters_->size() + 1,
+      numPartitions,
+      "Range partitioning has more ranges than partitions");
+  return std::make_unique<exec::RangePartitionFunction>(
+      keyChannels_, sortingOrders_, splitters_);
+}
+
+std::string RangePartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]) << " "
+         << sortingOrders_[i].toString();
+  }
+  return fmt::format("RANGE({}) {} splitters", keys.str(), splitters_->size());
+}
+
+folly::dynamic RangePartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "RangePartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  folly::dynamic sortingOrders = folly::dynamic::array;
+  for (const auto& order : sortingOrders_) {
+    sortingOrders.push_back(order.serialize());
+  }
+  obj["sortingOrders"] = sortingOrders;
+  obj["splitterType"] = splitters_->type()->serialize();
+  std::vector<velox::core::ConstantTypedExpr> splitters;
+  splitters.reserve(splitters_->size());
+  for (auto i = 0; i < splitters_->size(); ++i) {
+    splitters.emplace_back(BaseVector::wrapInConstant(1, i, splitters_));
+  }
+  obj["splitters"] = ISerializable::serialize(splitters);
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr RangePartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  auto* pool = static_cast<memory::MemoryPool*>(context);
+  std::vector<core::SortOrder> sortingOrders;
+  for (const auto& order : obj["sortingOrders"]) {
+    sortingOrders.push_back(core::SortOrder::deserialize(order));
+  }
+
+  const auto splitterExprs =
+      ISerializable::deserialize<std::vector<velox::core::ConstantTypedExpr>>(
+          obj["splitters"], context);
+  auto splitters = BaseVector::create<RowVector>(
+      ISerializable::deserialize<RowType>(obj["splitterType"]),
+      splitterExprs.size(),
+      pool);
+  for (auto i = 0; i < splitterExprs.size(); ++i) {
+    splitters->copy(splitterExprs[i]->toConstantVector(pool).get(), i, 0, 1);
+  }
+
+  return std::make_shared<RangePartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      ISerializable::deserialize<std::vector<column_index_t>>(
+          obj["keyChannels"], context),
+      std::move(sortingOrders),
+      std::move(splitters));
+}
+} // namespace facebook::velox::exec
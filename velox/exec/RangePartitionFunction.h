@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// Assigns rows to partitions by ranges of the sorting keys. 'splitters' has
+/// one column per key and N - 1 rows in increasing sort order for N
+/// partitions. A row goes to the partition given by the number of splitters
+/// that are less than or equal to the row, so that all rows of partition i
+/// sort before all rows of partition i + 1. Sorting each partition and reading
+/// the partitions in order gives a total order without merging.
+class RangePartitionFunction : public core::PartitionFunction {
+ public:
+  RangePartitionFunction(
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<core::SortOrder>& sortingOrders,
+      RowVectorPtr splitters);
+
+  ~RangePartitionFunction() override = default;
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  int numPartitions() const {
+    return splitters_->size() + 1;
+  }
+
+  /// Returns the splitters that divide 'sample' into 'numPartitions' ranges of
+  /// about equal numbers of rows. The result has one column per key channel.
+  /// Duplicate splitters are removed, so that the result may have fewer than
+  /// 'numPartitions' - 1 rows if the sample has few distinct keys.
+  static RowVectorPtr computeSplitters(
+      const RowVector& sample,
+      const std::vector<column_index_t>& keyChannels,
+      const std::vector<core::SortOrder>& sortingOrders,
+      int numPartitions,
+      memory::MemoryPool* pool);
+
+ private:
+  // Returns the number of splitters less than or equal to 'row'.
+  uint32_t findPartition(vector_size_t row) const;
+
+  const std::vector<column_index_t> keyChannels_;
+  std::vector<CompareFlags> compareFlags_;
+  const RowVectorPtr splitters_;
+
+  // Reusable memory.
+  std::vector<DecodedVector> decodedKeys_;
+  SelectivityVector rows_;
+};
+
+/// Factory class to create RangePartitionFunction. The number of partitions
+/// passed to create() must be at least the number of splitters + 1.
+class RangePartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  RangePartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortingOrders,
+      RowVectorPtr splitters);
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<core::SortOrder> sortingOrders_;
+  const RowVectorPtr splitters_;
+};
+} // namespace facebook::velox::exec
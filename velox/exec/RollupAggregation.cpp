@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RollupAggregation.h"
+#include "velox/exec/Aggregate.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+void prepareVector(
+    RowVectorPtr& vector,
+    const RowTypePtr& type,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  if (vector) {
+    VectorPtr reused = std::move(vector);
+    BaseVector::prepareForReuse(reused, size);
+    vector = std::static_pointer_cast<RowVector>(reused);
+  } else {
+    vector = std::static_pointer_cast<RowVector>(
+        BaseVector::create(type, size, pool));
+  }
+}
+} // namespace
+
+// static
+bool RollupAggregation::canRollup(
+    const core::GroupIdNode& groupIdNode,
+    const core::AggregationNode& aggregationNode,
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.aggregationRollupEnabled() ||
+      aggregationNode.sources()[0].get() != &groupIdNode ||
+      !isRawInput(aggregationNode.step()) ||
+      aggregationNode.isPreGrouped() || aggregationNode.aggregates().empty() ||
+      (queryConfig.spillEnabled() && aggregationNode.canSpill(queryConfig))) {
+    return false;
+  }
+
+  // The aggregation must group by all the grouping keys and the group ID.
+  const auto& groupIdType = groupIdNode.outputType();
+  const column_index_t numGroupingKeys = groupIdNode.numGroupingKeys();
+  const auto& groupingKeys = aggregationNode.groupingKeys();
+  if (groupingKeys.size() != numGroupingKeys + 1) {
+    return false;
+  }
+  std::unordered_set<column_index_t> keyChannels;
+  for (const auto& key : groupingKeys) {
+    const auto channel = groupIdType->getChildIdxIfExists(key->name());
+    if (!channel.has_value() ||
+        (channel.value() >= numGroupingKeys &&
+         channel.value() != groupIdType->size() - 1)) {
+      return false;
+    }
+    keyChannels.insert(channel.value());
+  }
+  if (keyChannels.size() != groupingKeys.size()) {
+    return false;
+  }
+
+  // Without any key in the grouping sets there is nothing to roll up.
+  bool hasKeys = false;
+  for (const auto& groupingSet : groupIdNode.groupingSets()) {
+    hasKeys |= !groupingSet.empty();
+  }
+  if (!hasKeys) {
+    return false;
+  }
+
+  // Aggregates over grouping keys see nulls for the keys outside of a
+  // grouping set, which the groups of the union of the keys do not have.
+  std::unordered_set<std::string> aggregationInputs;
+  for (const auto& input : groupIdNode.aggregationInputs()) {
+    aggregationInputs.insert(input->name());
+  }
+  for (const auto& aggregate : aggregationNode.aggregates()) {
+    if (aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field =
+              dynamic_cast<const core::FieldAccessTypedExpr*>(input.get())) {
+        if (aggregationInputs.count(field->name()) == 0) {
+          return false;
+        }
+      } else if (!dynamic_cast<const core::ConstantTypedExpr*>(input.get())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+RollupAggregation::RollupAggregation(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::GroupIdNode>& groupIdNode,
+    const std::shared_ptr<const core::AggregationNode>& aggregationNode)
+    : Operator(
+          driverCtx,
+          aggregationNode->outputType(),
+          operatorId,
+          aggregationNode->id(),
+          "RollupAggregation"),
+      groupIdNode_(groupIdNode),
+      aggregationNode_(aggregationNode),
+      isPartialOutput_(isPartialOutput(aggregationNode->step())),
+      maxPartialAggregationMemoryUsage_(
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+
+void RollupAggregation::initialize() {
+  Operator::initialize();
+
+  VELOX_CHECK(pool()->trackUsage());
+
+  const auto& groupIdType = groupIdNode_->outputType();
+  const auto numGroupingKeys = groupIdNode_->numGroupingKeys();
+  const auto& aggregateNames = aggregationNode_->aggregateNames();
+  const auto& aggregates = aggregationNode_->aggregates();
+
+  // The union of the keys of the grouping sets as input columns. Grouping
+  // keys that come from the same input column share a key.
+  std::unordered_set<std::string> groupingSetKeys;
+  for (const auto& groupingSet : groupIdNode_->groupingSets()) {
+    groupingSetKeys.insert(groupingSet.begin(), groupingSet.end());
+  }
+  std::vector<core::FieldAccessTypedExprPtr> keys;
+  std::unordered_map<std::string, column_index_t> keyColumns;
+  std::vector<column_index_t> groupingKeyColumns(
+      numGroupingKeys, kMissingGroupingKey);
+  for (const auto& info : groupIdNode_->groupingKeyInfos()) {
+    if (groupingSetKeys.count(info.output) == 0) {
+      continue;
+    }
+    auto it = keyColumns.find(info.input->name());
+    if (it == keyColumns.end()) {
+      it = keyColumns.emplace(info.input->name(), keys.size()).first;
+      keys.push_back(info.input);
+    }
+    groupingKeyColumns[groupIdType->getChildIdx(info.output)] = it->second;
+  }
+
+  groupingKeyMappings_.reserve(groupIdNode_->groupingSets().size());
+  for (const auto& groupingSet : groupIdNode_->groupingSets()) {
+    std::vector<column_index_t> mapping(numGroupingKeys, kMissingGroupingKey);
+    for (const auto& key : groupingSet) {
+      const auto channel = groupIdType->getChildIdx(key);
+      mapping[channel] = groupingKeyColumns[channel];
+    }
+    groupingKeyMappings_.push_back(std::move(mapping));
+  }
+
+  // Partial aggregation of the input by the union of the keys. The calls of
+  // a single aggregation return the final type and are changed to return the
+  // intermediate type.
+  std::vector<TypePtr> intermediateTypes;
+  std::vector<core::AggregationNode::Aggregate> partialAggregates;
+  for (const auto& aggregate : aggregates) {
+    intermediateTypes.push_back(Aggregate::intermediateType(
+        aggregate.call->name(), aggregate.rawInputTypes));
+    auto partial = aggregate;
+    partial.call = std::make_shared<core::CallTypedExpr>(
+        intermediateTypes.back(),
+        aggregate.call->inputs(),
+        aggregate.call->name());
+    partialAggregates.push_back(std::move(partial));
+  }
+
+  const auto& inputType = groupIdNode_->sources()[0]->outputType();
+  auto inputNode = std::make_shared<core::AggregationNode>(
+      aggregationNode_->id(),
+      core::AggregationNode::Step::kPartial,
+      keys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      partialAggregates,
+      false,
+      groupIdNode_->sources()[0]);
+  groupsType_ = inputNode->outputType();
+
+  std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
+  inputSet_ = std::make_unique<GroupingSet>(
+      inputType,
+      createVectorHashers(inputType, keys),
+      std::vector<column_index_t>{},
+      toAggregateInfo(
+          *inputNode, *operatorCtx_, keys.size(), expressionEvaluator),
+      false,
+      true,
+      true,
+      std::vector<vector_size_t>{},
+      std::nullopt,
+      nullptr,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+
+  // Intermediate or final aggregation of the groups per grouping set.
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < numGroupingKeys; ++i) {
+    names.push_back(groupIdType->nameOf(i));
+    types.push_back(groupIdType->childAt(i));
+  }
+  names.push_back(groupIdNode_->groupIdName());
+  types.push_back(BIGINT());
+
+  std::vector<core::AggregationNode::Aggregate> combineAggregates;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    const auto& intermediateType = intermediateTypes[i];
+    names.push_back(aggregateNames[i]);
+    types.push_back(intermediateType);
+
+    core::AggregationNode::Aggregate combine;
+    combine.call = std::make_shared<core::CallTypedExpr>(
+        aggregate.call->type(),
+        std::vector<core::TypedExprPtr>{
+            std::make_shared<core::FieldAccessTypedExpr>(
+                intermediateType, aggregateNames[i])},
+        aggregate.call->name());
+    combine.rawInputTypes = aggregate.rawInputTypes;
+    combineAggregates.push_back(std::move(combine));
+  }
+  groupingSetType_ = ROW(std::move(names), std::move(types));
+
+  auto outputNode = std::make_shared<core::AggregationNode>(
+      aggregationNode_->id(),
+      isPartialOutput_ ? core::AggregationNode::Step::kIntermediate
+                       : core::AggregationNode::Step::kFinal,
+      aggregationNode_->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      combineAggregates,
+      aggregationNode_->globalGroupingSets(),
+      aggregationNode_->groupId(),
+      aggregationNode_->ignoreNullKeys(),
+      std::make_shared<core::ValuesNode>(
+          groupIdNode_->id(),
+          std::vector<RowVectorPtr>{std::static_pointer_cast<RowVector>(
+              BaseVector::create(groupingSetType_, 0, pool()))}));
+
+  std::optional<column_index_t> groupIdChannel;
+  if (aggregationNode_->groupId().has_value()) {
+    groupIdChannel = outputType_->getChildIdxIfExists(
+        aggregationNode_->groupId().value()->name());
+    VELOX_CHECK(groupIdChannel.has_value());
+  }
+
+  const auto& groupingKeys = aggregationNode_->groupingKeys();
+  outputSet_ = std::make_unique<GroupingSet>(
+      groupingSetType_,
+      createVectorHashers(groupingSetType_, groupingKeys),
+      std::vector<column_index_t>{},
+      toAggregateInfo(
+          *outputNode, *operatorCtx_, groupingKeys.size(), expressionEvaluator),
+      aggregationNode_->ignoreNullKeys(),
+      isPartialOutput_,
+      false,
+      aggregationNode_->globalGroupingSets(),
+      groupIdChannel,
+      nullptr,
+      &nonReclaimableSection_,
+      operatorCtx_.get(),
+      &spillStats_);
+
+  groupIdNode_.reset();
+  aggregationNode_.reset();
+}
+
+void RollupAggregation::addInput(RowVectorPtr input) {
+  inputSet_->addInput(input, false);
+  numInputRows_ += input->size();
+  if (isPartialOutput_ &&
+      inputSet_->isPartialFull(maxPartialAggregationMemoryUsage_)) {
+    partialFull_ = true;
+  }
+}
+
+void RollupAggregation::noMoreInput() {
+  inputSet_->noMoreInput();
+  Operator::noMoreInput();
+}
+
+RowVectorPtr RollupAggregation::getOutput() {
+  if (finished_ || (!noMoreInput_ && !partialFull_)) {
+    return nullptr;
+  }
+
+  if (!rolledUp_) {
+    rollup();
+    rolledUp_ = true;
+    if (noMoreInput_) {
+      outputSet_->noMoreInput();
+    }
+  }
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows =
+      outputBatchRows(outputSet_->estimateOutputRowSize());
+  prepareVector(output_, outputType_, maxOutputRows, pool());
+  if (outputSet_->getOutput(
+          maxOutputRows,
+          queryConfig.preferredOutputBatchBytes(),
+          resultIterator_,
+          output_)) {
+    return output_;
+  }
+
+  resultIterator_.reset();
+  rolledUp_ = false;
+  partialFull_ = false;
+  finished_ = noMoreInput_;
+  return nullptr;
+}
+
+void RollupAggregation::rollup() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxGroups = outputBatchRows(inputSet_->estimateOutputRowSize());
+  RowContainerIterator iterator;
+  int64_t numGroups = 0;
+  for (;;) {
+    prepareVector(groups_, groupsType_, maxGroups, pool());
+    if (!inputSet_->getOutput(
+            maxGroups,
+            queryConfig.preferredOutputBatchBytes(),
+            iterator,
+            groups_)) {
+      break;
+    }
+    numGroups += groups_->size();
+    for (auto i = 0; i < groupingKeyMappings_.size(); ++i) {
+      outputSet_->addInput(makeGroupingSetInput(i), false);
+    }
+  }
+
+  const int64_t numGroupingSets = groupingKeyMappings_.size();
+  const auto numRollupRows = numGroups * numGroupingSets;
+  addRuntimeStat(kRollupInputRows, RuntimeCounter(numRollupRows));
+  addRuntimeStat(
+      kRollupSavedInputRows,
+      RuntimeCounter(numInputRows_ * (numGroupingSets - 1) - numRollupRows));
+  numInputRows_ = 0;
+}
+
+RowVectorPtr RollupAggregation::makeGroupingSetInput(int32_t groupingSetIndex) {
+  const auto numGroups = groups_->size();
+  const auto& mapping = groupingKeyMappings_[groupingSetIndex];
+  const auto numGroupingKeys = mapping.size();
+  const auto numAggregates = groupingSetType_->size() - numGroupingKeys - 1;
+  const auto firstAggregate = groupsType_->size() - numAggregates;
+
+  std::vector<VectorPtr> columns(groupingSetType_->size());
+  for (auto i = 0; i < numGroupingKeys; ++i) {
+    if (mapping[i] == kMissingGroupingKey) {
+      columns[i] = BaseVector::createNullConstant(
+          groupingSetType_->childAt(i), numGroups, pool());
+    } else {
+      columns[i] = groups_->childAt(mapping[i]);
+    }
+  }
+  columns[numGroupingKeys] = std::make_shared<ConstantVector<int64_t>>(
+      pool(), numGroups, false, BIGINT(), groupingSetIndex);
+  for (auto i = 0; i < numAggregates; ++i) {
+    columns[numGroupingKeys + 1 + i] = groups_->childAt(firstAggregate + i);
+  }
+
+  return std::make_shared<RowVector>(
+      pool(), groupingSetType_, nullptr, numGroups, std::move(columns));
+}
+
+void RollupAggregation::close() {
+  Operator::close();
+
+  groups_ = nullptr;
+  output_ = nullptr;
+  inputSet_.reset();
+  outputSet_.reset();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/GroupingSet.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Evaluates an aggregation over the output of a GroupId, e.g. GROUPING SETS,
+/// CUBE or ROLLUP, without making a copy of each input row per grouping set.
+/// The input is aggregated once by the union of the keys of the grouping sets
+/// into intermediate results. Each grouping set is then computed by combining
+/// these groups with the keys outside of the set replaced by nulls, the same
+/// way an intermediate or final aggregation combines partial results. Replaces
+/// the GroupId and the aggregation operators. See canRollup() for the plans
+/// this applies to.
+class RollupAggregation : public Operator {
+ public:
+  /// Runtime stats with the number of groups of the union of the keys that
+  /// were combined into the grouping sets, and with the number of rows that
+  /// GroupId would have added to the aggregation input minus these. The
+  /// latter is negative if the input has few duplicate keys.
+  static inline const std::string kRollupInputRows{"rollupInputRows"};
+  static inline const std::string kRollupSavedInputRows{
+      "rollupSavedInputRows"};
+
+  /// Returns true if 'aggregationNode' over the output of 'groupIdNode' can be
+  /// evaluated by this operator. This is the case if the aggregation takes
+  /// raw input, groups by all the grouping keys and the group ID and does not
+  /// spill, and if its aggregates have no masks and no distinct or sorted
+  /// inputs and take only constants and aggregation inputs of the GroupId as
+  /// arguments.
+  static bool canRollup(
+      const core::GroupIdNode& groupIdNode,
+      const core::AggregationNode& aggregationNode,
+      const core::QueryConfig& queryConfig);
+
+  RollupAggregation(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::GroupIdNode>& groupIdNode,
+      const std::shared_ptr<const core::AggregationNode>& aggregationNode);
+
+  void initialize() override;
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !partialFull_;
+  }
+
+  void noMoreInput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return finished_;
+  }
+
+  void close() override;
+
+ private:
+  static constexpr column_index_t kMissingGroupingKey =
+      std::numeric_limits<column_index_t>::max();
+
+  // Adds the groups of 'inputSet_' to 'outputSet_' once per grouping set and
+  // clears 'inputSet_'.
+  void rollup();
+
+  // Returns the input of 'outputSet_' for the grouping set at
+  // 'groupingSetIndex' made of the groups in 'groups_'.
+  RowVectorPtr makeGroupingSetInput(int32_t groupingSetIndex);
+
+  std::shared_ptr<const core::GroupIdNode> groupIdNode_;
+  std::shared_ptr<const core::AggregationNode> aggregationNode_;
+
+  const bool isPartialOutput_;
+  const int64_t maxPartialAggregationMemoryUsage_;
+
+  // Aggregates the input by the union of the keys of the grouping sets. Its
+  // output has the layout of 'groupsType_': the keys followed by the
+  // intermediate results of the aggregates.
+  std::unique_ptr<GroupingSet> inputSet_;
+
+  // Combines the groups of 'inputSet_' per grouping set. Its input has the
+  // layout of 'groupingSetType_': the grouping keys and the group ID column
+  // of the GroupId output followed by the intermediate results.
+  std::unique_ptr<GroupingSet> outputSet_;
+
+  RowTypePtr groupsType_;
+  RowTypePtr groupingSetType_;
+
+  // One entry per grouping set. Maps each grouping key of 'groupingSetType_'
+  // to a key column of 'groupsType_' or to kMissingGroupingKey if the key is
+  // not in the set.
+  std::vector<std::vector<column_index_t>> groupingKeyMappings_;
+
+  // Number of input rows since the last flush.
+  int64_t numInputRows_{0};
+
+  // True if a partial aggregation reached its memory limit and produces
+  // output before taking more input.
+  bool partialFull_{false};
+
+  // True if the groups of 'inputSet_' have been added to 'outputSet_' and
+  // the output is being produced.
+  bool rolledUp_{false};
+
+  bool finished_{false};
+
+  RowContainerIterator resultIterator_;
+
+  // Reusable batch of groups of 'inputSet_'.
+  RowVectorPtr groups_;
+
+  // Reusable output vector.
+  RowVectorPtr output_;
+};
+
+} // namespace facebook::velox::exec
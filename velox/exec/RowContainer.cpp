@@ -510,6 +510,10 @@ void RowContainer::store(
     vector_size_t index,
     char* row,
     int32_t column) {
+  if (compressedStrings(column)) {
+    storeCompressedString(decoded, index, row, column);
+    return;
+  }
   auto numKeys = keyTypes_.size();
   bool isKey = column < numKeys;
   if (isKey && !nullableKeys_) {
@@ -537,6 +541,158 @@ void RowContainer::store(
   }
 }
 
+bool RowContainer::supportsCompactRows() const {
+  for (auto i = 0; i < types_.size(); ++i) {
+    if (compressedStrings(i) != nullptr) {
+      return false;
+    }
+    switch (typeKinds_[i]) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::HUGEINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::TIMESTAMP:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void RowContainer::storeCompactRows(
+    const std::vector<std::string_view>& serialized,
+    folly::Range<char**> rows) {
+  VELOX_CHECK_EQ(serialized.size(), rows.size());
+  VELOX_CHECK(
+      supportsCompactRows(),
+      "Cannot store CompactRow serialized rows of {} columns",
+      types_.size());
+  // A CompactRow has null flags for all fields followed by the fields.
+  // Fixed-width fields take their width also when null. Strings are a 4 byte
+  // size followed by the bytes and take no space when null.
+  const int32_t nullBytes = bits::nbytes(types_.size());
+  for (auto i = 0; i < serialized.size(); ++i) {
+    const char* data = serialized[i].data();
+    const auto* nulls = reinterpret_cast<const uint8_t*>(data);
+    char* row = rows[i];
+    int32_t offset = nullBytes;
+    for (auto column = 0; column < types_.size(); ++column) {
+      const auto rowColumn = rowColumns_[column];
+      const auto kind = typeKinds_[column];
+      const bool isNull = bits::isBitSet(nulls, column);
+      VELOX_DCHECK(!isNull || rowColumn.nullMask());
+      if (isNull) {
+        row[rowColumn.nullByte()] |= rowColumn.nullMask();
+      }
+      if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+        if (isNull) {
+          valueAt<StringView>(row, rowColumn.offset()) = StringView();
+          continue;
+        }
+        int32_t size;
+        memcpy(&size, data + offset, sizeof(int32_t));
+        RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+        stringAllocator_->copyMultipart(
+            StringView(data + offset + sizeof(int32_t), size),
+            row,
+            rowColumn.offset());
+        offset += sizeof(int32_t) + size;
+        continue;
+      }
+      const int32_t valueBytes = kind == TypeKind::TIMESTAMP
+          ? sizeof(int64_t)
+          : types_[column]->cppSizeInBytes();
+      if (isNull) {
+        memset(row + rowColumn.offset(), 0, typeKindSize(kind));
+      } else if (kind == TypeKind::TIMESTAMP) {
+        int64_t micros;
+        memcpy(&micros, data + offset, sizeof(int64_t));
+        valueAt<Timestamp>(row, rowColumn.offset()) =
+            Timestamp::fromMicros(micros);
+      } else {
+        memcpy(row + rowColumn.offset(), data + offset, valueBytes);
+      }
+      offset += valueBytes;
+    }
+    VELOX_DCHECK_EQ(offset, serialized[i].size());
+  }
+}
+
+void RowContainer::setCompressedStrings(
+    int32_t columnIndex,
+    std::shared_ptr<const FsstSymbolTable> symbols) {
+  VELOX_CHECK_GE(columnIndex, keyTypes_.size());
+  VELOX_CHECK_LT(columnIndex, types_.size());
+  VELOX_CHECK(
+      typeKinds_[columnIndex] == TypeKind::VARCHAR ||
+          typeKinds_[columnIndex] == TypeKind::VARBINARY,
+      "Only string columns can be compressed: {}",
+      types_[columnIndex]->toString());
+  VELOX_CHECK_EQ(numRows_, 0, "Values have been stored already");
+  compressedStrings_.resize(types_.size());
+  compressedStrings_[columnIndex] = std::move(symbols);
+}
+
+void RowContainer::storeCompressedString(
+    const DecodedVector& decoded,
+    vector_size_t index,
+    char* row,
+    int32_t columnIndex) {
+  const auto rowColumn = rowColumns_[columnIndex];
+  if (decoded.isNullAt(index)) {
+    row[rowColumn.nullByte()] |= rowColumn.nullMask();
+    *reinterpret_cast<StringView*>(row + rowColumn.offset()) = StringView();
+    return;
+  }
+  const auto value = decoded.valueAt<StringView>(index);
+  compressionBuffer_.clear();
+  compressedStrings_[columnIndex]->compress(
+      std::string_view(value), compressionBuffer_);
+  RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+  stringAllocator_->copyMultipart(
+      StringView(compressionBuffer_), row, rowColumn.offset());
+}
+
+void RowContainer::extractCompressedStrings(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t columnIndex,
+    vector_size_t resultOffset,
+    const VectorPtr& result) const {
+  const auto* symbols = compressedStrings_[columnIndex].get();
+  const auto column = rowColumns_[columnIndex];
+  result->resize(numRows + resultOffset);
+  auto* values = result->asFlatVector<StringView>();
+  VELOX_CHECK_NOT_NULL(values);
+  std::string storage;
+  for (auto i = 0; i < numRows; ++i) {
+    const char* row;
+    if (rowNumbers.empty()) {
+      row = rows[i];
+    } else {
+      row = rowNumbers[i] >= 0 ? rows[rowNumbers[i]] : nullptr;
+    }
+    const auto resultIndex = resultOffset + i;
+    if (row == nullptr || isNullAt(row, column)) {
+      values->setNull(resultIndex, true);
+      continue;
+    }
+    const auto compressed = HashStringAllocator::contiguousString(
+        valueAt<StringView>(row, column.offset()), storage);
+    compressionBuffer_.clear();
+    symbols->decompress(std::string_view(compressed), compressionBuffer_);
+    values->set(resultIndex, StringView(compressionBuffer_));
+  }
+}
+
 ByteInputStream RowContainer::prepareRead(const char* row, int32_t offset) {
   const auto& view = reinterpret_cast<const std::string_view*>(row + offset);
   // We set 'stream' to range over the ranges that start at the Header
@@ -732,6 +888,116 @@ void RowContainer::storeSerializedRow(
   }
 }
 
+// static
+bool RowContainer::isBlockExtractable(const VectorPtr& result) {
+  if (!result->isFlatEncoding()) {
+    return false;
+  }
+  switch (result->typeKind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+void RowContainer::extractFixedWidthBlock(
+    const char* const* rows,
+    int32_t numRows,
+    RowColumn column,
+    int32_t resultOffset,
+    FlatVector<T>* result) {
+  VELOX_DCHECK_LE(numRows, kExtractBlockRows);
+  auto* values = result->mutableRawValues() + resultOffset;
+  const auto offset = column.offset();
+  const auto nullByte = column.nullByte();
+  const auto nullMask = column.nullMask();
+  uint64_t notNulls = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    const char* row = rows[i];
+    if (row == nullptr || (nullMask && isNullAt(row, nullByte, nullMask))) {
+      continue;
+    }
+    notNulls |= 1UL << i;
+    values[i] = valueAt<T>(row, offset);
+  }
+  if (notNulls != bits::lowMask(numRows) || result->rawNulls() != nullptr) {
+    bits::copyBits(
+        &notNulls, 0, result->mutableRawNulls(), resultOffset, numRows);
+  }
+}
+
+void RowContainer::extractColumns(
+    const char* const* rows,
+    int32_t numRows,
+    folly::Range<const column_index_t*> columnIndices,
+    int32_t resultOffset,
+    const std::vector<VectorPtr>& results) {
+  VELOX_CHECK_EQ(columnIndices.size(), results.size());
+  std::vector<int32_t> blockColumns;
+  for (auto i = 0; i < columnIndices.size(); ++i) {
+    if (isBlockExtractable(results[i])) {
+      results[i]->resize(numRows + resultOffset);
+      blockColumns.push_back(i);
+    } else {
+      extractColumn(rows, numRows, columnIndices[i], resultOffset, results[i]);
+    }
+  }
+  if (blockColumns.empty()) {
+    return;
+  }
+  for (auto begin = 0; begin < numRows; begin += kExtractBlockRows) {
+    const auto blockRows = std::min(kExtractBlockRows, numRows - begin);
+    for (auto i : blockColumns) {
+      auto* result = results[i].get();
+      auto extract = [&](auto* flatResult) {
+        extractFixedWidthBlock(
+            rows + begin,
+            blockRows,
+            columnAt(columnIndices[i]),
+            resultOffset + begin,
+            flatResult);
+      };
+      switch (result->typeKind()) {
+        case TypeKind::TINYINT:
+          extract(result->asUnchecked<FlatVector<int8_t>>());
+          break;
+        case TypeKind::SMALLINT:
+          extract(result->asUnchecked<FlatVector<int16_t>>());
+          break;
+        case TypeKind::INTEGER:
+          extract(result->asUnchecked<FlatVector<int32_t>>());
+          break;
+        case TypeKind::BIGINT:
+          extract(result->asUnchecked<FlatVector<int64_t>>());
+          break;
+        case TypeKind::HUGEINT:
+          extract(result->asUnchecked<FlatVector<int128_t>>());
+          break;
+        case TypeKind::REAL:
+          extract(result->asUnchecked<FlatVector<float>>());
+          break;
+        case TypeKind::DOUBLE:
+          extract(result->asUnchecked<FlatVector<double>>());
+          break;
+        case TypeKind::TIMESTAMP:
+          extract(result->asUnchecked<FlatVector<Timestamp>>());
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    }
+  }
+}
+
 void RowContainer::extractString(
     StringView value,
     FlatVector<StringView>* values,
@@ -19,6 +19,7 @@
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/FsstSymbolTable.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
@@ -302,6 +303,37 @@ class RowContainer {
       char* row,
       int32_t columnIndex);
 
+  /// Returns true if rows serialized with row::CompactRow can be stored with
+  /// storeCompactRows(). This requires all columns to be of fixed-width or
+  /// string types and no column to be compressed.
+  bool supportsCompactRows() const;
+
+  /// Stores rows serialized with row::CompactRow into 'rows' without first
+  /// deserializing them into vectors. The serialized rows have the keys
+  /// followed by the dependent columns. Strings are copied into the
+  /// HashStringAllocator. 'rows' must come from newRow(). Requires
+  /// supportsCompactRows().
+  void storeCompactRows(
+      const std::vector<std::string_view>& serialized,
+      folly::Range<char**> rows);
+
+  /// Stores the values of the VARCHAR or VARBINARY dependent column
+  /// 'columnIndex' compressed with 'symbols'. Must be called before any value
+  /// of the column is stored. The extractColumn() overloads that take a column
+  /// index decompress the values. The overloads that take a RowColumn return
+  /// the compressed form.
+  void setCompressedStrings(
+      int32_t columnIndex,
+      std::shared_ptr<const FsstSymbolTable> symbols);
+
+  /// Returns the symbol table of 'columnIndex' if its values are compressed,
+  /// nullptr otherwise.
+  const FsstSymbolTable* compressedStrings(int32_t columnIndex) const {
+    return columnIndex < compressedStrings_.size()
+        ? compressedStrings_[columnIndex].get()
+        : nullptr;
+  }
+
   HashStringAllocator& stringAllocator() {
     return *stringAllocator_;
   }
@@ -384,7 +416,7 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       const VectorPtr& result) {
-    extractColumn(rows, numRows, columnAt(columnIndex), result);
+    extractColumn(rows, numRows, columnIndex, 0, result);
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
@@ -396,6 +428,11 @@ class RowContainer {
       int32_t columnIndex,
       int32_t resultOffset,
       const VectorPtr& result) {
+    if (compressedStrings(columnIndex)) {
+      extractCompressedStrings(
+          rows, {}, numRows, columnIndex, resultOffset, result);
+      return;
+    }
     extractColumn(rows, numRows, columnAt(columnIndex), resultOffset, result);
   }
 
@@ -412,6 +449,16 @@ class RowContainer {
       int32_t columnIndex,
       const vector_size_t resultOffset,
       const VectorPtr& result) {
+    if (compressedStrings(columnIndex)) {
+      extractCompressedStrings(
+          rows,
+          rowNumbers,
+          rowNumbers.size(),
+          columnIndex,
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows, rowNumbers, columnAt(columnIndex), resultOffset, result);
   }
@@ -425,6 +472,19 @@ class RowContainer {
     extractNulls(rows, numRows, columnAt(columnIndex), result);
   }
 
+  /// Copies the values at 'columnIndices' into the corresponding 'results'
+  /// (starting at 'resultOffset') for the 'numRows' rows pointed to by 'rows'.
+  /// Same as extractColumn() for each column, except that fixed width columns
+  /// are extracted together in blocks of 64 rows. Each block reads the rows
+  /// once for all columns while they are in cache and writes the nulls of a
+  /// column as one word.
+  void extractColumns(
+      const char* const* rows,
+      int32_t numRows,
+      folly::Range<const column_index_t*> columnIndices,
+      int32_t resultOffset,
+      const std::vector<VectorPtr>& results);
+
   /// Copies the 'probed' flags for the specified rows into 'result'.
   /// The 'result' is expected to be flat vector of type boolean.
   /// For rows with null keys, sets null in 'result' if 'setNullForNullKeysRow'
@@ -985,6 +1045,43 @@ class RowContainer {
 
   static ByteInputStream prepareRead(const char* row, int32_t offset);
 
+  // Number of rows extracted together by extractColumns().
+  static constexpr int32_t kExtractBlockRows = 64;
+
+  // Returns true if extractColumns() extracts 'result' in blocks with
+  // extractFixedWidthBlock().
+  static bool isBlockExtractable(const VectorPtr& result);
+
+  // Copies the values of 'column' for up to kExtractBlockRows 'rows' into
+  // 'result' starting at 'resultOffset'. Null rows and null values set the
+  // corresponding nulls in 'result'.
+  template <typename T>
+  static void extractFixedWidthBlock(
+      const char* const* rows,
+      int32_t numRows,
+      RowColumn column,
+      int32_t resultOffset,
+      FlatVector<T>* result);
+
+  // Stores the 'index'th value of 'decoded' compressed with the symbol table
+  // of 'columnIndex'.
+  void storeCompressedString(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* row,
+      int32_t columnIndex);
+
+  // Extracts and decompresses the values of the compressed column
+  // 'columnIndex'. The arguments are as in extractColumn(). 'rowNumbers' is
+  // empty if the values of 'rows' are extracted in order.
+  void extractCompressedStrings(
+      const char* const* rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t columnIndex,
+      vector_size_t resultOffset,
+      const VectorPtr& result) const;
+
   template <TypeKind Kind>
   void hashTyped(
       const Type* type,
@@ -1298,6 +1395,13 @@ class RowContainer {
   memory::AllocationPool rows_;
   std::shared_ptr<HashStringAllocator> stringAllocator_;
 
+  // Symbol tables of the columns whose values are stored compressed, indexed
+  // by column. Empty if no column is compressed.
+  std::vector<std::shared_ptr<const FsstSymbolTable>> compressedStrings_;
+
+  // Scratch for compressing and decompressing strings.
+  mutable std::string compressionBuffer_;
+
   int alignment_ = 1;
 };
 
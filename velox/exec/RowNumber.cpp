@@ -128,13 +128,19 @@ void RowNumber::restoreNextSpillPartition() {
 
   auto it = spillInputPartitionSet_.begin();
   spillInputReader_ = it->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->executor);
 
   // Find matching partition for the hash table.
   auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
   if (hashTableIt != spillHashTablePartitionSet_.end()) {
     spillHashTableReader_ = hashTableIt->second->createUnorderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->executor);
 
     RowVectorPtr data;
     while (spillHashTableReader_->nextBatch(data)) {
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SharedAggregationTable.h"
+
+namespace facebook::velox::exec {
+
+SharedAggregationTable::SharedAggregationTable(
+    uint32_t numDrivers,
+    uint32_t numPartitions)
+    : numDrivers_(numDrivers) {
+  VELOX_CHECK_GT(numDrivers_, 0);
+  VELOX_CHECK_GT(numPartitions, 0);
+  partitions_.reserve(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    partitions_.push_back(std::make_unique<Partition>());
+  }
+}
+
+void SharedAggregationTable::initialize(
+    const std::function<std::unique_ptr<GroupingSet>()>& makeGroupingSet) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (initialized_) {
+    return;
+  }
+  for (auto& partition : partitions_) {
+    partition->groupingSet = makeGroupingSet();
+  }
+  initialized_ = true;
+}
+
+uint32_t SharedAggregationTable::addInput(
+    const std::vector<RowVectorPtr>& partitionInputs,
+    uint32_t firstPartition) {
+  VELOX_CHECK_EQ(partitionInputs.size(), partitions_.size());
+  const auto numPartitions = partitions_.size();
+  std::vector<uint32_t> deferred;
+  for (auto i = 0; i < numPartitions; ++i) {
+    const auto index = (firstPartition + i) % numPartitions;
+    if (partitionInputs[index] == nullptr) {
+      continue;
+    }
+    auto& partition = *partitions_[index];
+    std::unique_lock<std::mutex> l(partition.mutex, std::try_to_lock);
+    if (!l.owns_lock()) {
+      deferred.push_back(index);
+      continue;
+    }
+    partition.groupingSet->addInput(partitionInputs[index], false);
+  }
+  for (auto index : deferred) {
+    auto& partition = *partitions_[index];
+    std::lock_guard<std::mutex> l(partition.mutex);
+    partition.groupingSet->addInput(partitionInputs[index], false);
+  }
+  return deferred.size();
+}
+
+bool SharedAggregationTable::noMoreInput(ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_LT(numInputFinished_, numDrivers_);
+    if (++numInputFinished_ < numDrivers_) {
+      promises_.emplace_back("SharedAggregationTable::noMoreInput");
+      *future = promises_.back().getSemiFuture();
+      return false;
+    }
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return true;
+}
+
+GroupingSet* SharedAggregationTable::nextOutputPartition() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_EQ(numInputFinished_, numDrivers_);
+  if (nextOutputPartition_ == partitions_.size()) {
+    return nullptr;
+  }
+  auto* groupingSet = partitions_[nextOutputPartition_++]->groupingSet.get();
+  groupingSet->noMoreInput();
+  return groupingSet;
+}
+
+} // namespace facebook::velox::exec
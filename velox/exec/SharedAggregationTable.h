@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/GroupingSet.h"
+
+namespace facebook::velox::exec {
+
+/// Hash table of a final or single aggregation shared by the Drivers of its
+/// pipeline. See QueryConfig::kConcurrentAggregationEnabled. The groups are
+/// split into partitions by the hash of the grouping keys and each partition
+/// is a GroupingSet behind its own mutex. Every Driver adds its input to all
+/// the partitions, so the Drivers need no local exchange to aggregate disjoint
+/// sets of groups. Once all the Drivers have finished their input, each
+/// partition is output by one of them.
+class SharedAggregationTable {
+ public:
+  SharedAggregationTable(uint32_t numDrivers, uint32_t numPartitions);
+
+  uint32_t numPartitions() const {
+    return partitions_.size();
+  }
+
+  /// Creates the GroupingSet of each partition with 'makeGroupingSet' if not
+  /// created yet. The GroupingSets allocate from the memory pool of the
+  /// Operator of the first Driver to get here. The Task keeps the pool alive
+  /// after the Operator is gone, so the GroupingSets must not refer to any
+  /// other state of the Operator. See nonReclaimableSection().
+  void initialize(
+      const std::function<std::unique_ptr<GroupingSet>()>& makeGroupingSet);
+
+  /// Adds 'partitionInputs[i]' to partition i. Null inputs are skipped. The
+  /// partitions are visited starting at 'firstPartition', which should differ
+  /// between the Drivers. A partition locked by another Driver is deferred
+  /// until the others are done. Returns the number of deferred partitions.
+  uint32_t addInput(
+      const std::vector<RowVectorPtr>& partitionInputs,
+      uint32_t firstPartition);
+
+  /// Invoked by each Driver after its last input. Returns true if all the
+  /// Drivers have finished their input, otherwise sets 'future' to wait for
+  /// them.
+  bool noMoreInput(ContinueFuture* future);
+
+  /// The flag passed to the GroupingSets of the partitions in place of the
+  /// one of the Operator.
+  tsan_atomic<bool>* nonReclaimableSection() {
+    return &nonReclaimableSection_;
+  }
+
+  /// Returns the next partition to output or nullptr if all have been taken.
+  /// Each partition is returned to a single Driver.
+  GroupingSet* nextOutputPartition();
+
+ private:
+  struct Partition {
+    std::mutex mutex;
+    std::unique_ptr<GroupingSet> groupingSet;
+  };
+
+  const uint32_t numDrivers_;
+
+  std::vector<std::unique_ptr<Partition>> partitions_;
+
+  tsan_atomic<bool> nonReclaimableSection_{false};
+
+  std::mutex mutex_;
+  bool initialized_{false};
+  uint32_t numInputFinished_{0};
+  uint32_t nextOutputPartition_{0};
+  // Drivers waiting for the others to finish their input.
+  std::vector<ContinuePromise> promises_;
+};
+
+} // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 
 #include "SortBuffer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -26,13 +27,17 @@ SortBuffer::SortBuffer(
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig,
+    bool stringCompression)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
+      prefixSortConfig_(prefixSortConfig),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      stringCompression_(stringCompression) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -85,6 +90,9 @@ void SortBuffer::addInput(const VectorPtr& input) {
     rows[row] = data_->newRow();
   }
   auto* inputRow = input->as<RowVector>();
+  if (stringCompression_) {
+    setupStringCompression(*inputRow);
+  }
   for (const auto& columnProjection : columnMap_) {
     DecodedVector decoded(
         *inputRow->childAt(columnProjection.outputChannel), allRows);
@@ -95,6 +103,45 @@ void SortBuffer::addInput(const VectorPtr& input) {
   numInputRows_ += allRows.size();
 }
 
+void SortBuffer::setupStringCompression(const RowVector& input) {
+  // Compress a column if the symbol table shrinks its first input by at least
+  // this much.
+  constexpr double kMinCompressionRatio = 1.25;
+  // The number of bytes of the first input the compression is tried on.
+  constexpr size_t kMaxSampleBytes = 64 << 10;
+  stringCompression_ = false;
+  for (auto i = sortCompareFlags_.size(); i < columnMap_.size(); ++i) {
+    const auto& child = input.childAt(columnMap_[i].outputChannel);
+    if (child->typeKind() != TypeKind::VARCHAR &&
+        child->typeKind() != TypeKind::VARBINARY) {
+      continue;
+    }
+    DecodedVector decoded(*child);
+    std::vector<std::string> values;
+    size_t rawBytes = 0;
+    for (auto row = 0; row < child->size() && rawBytes < kMaxSampleBytes;
+         ++row) {
+      if (!decoded.isNullAt(row)) {
+        values.push_back(decoded.valueAt<StringView>(row).str());
+        rawBytes += values.back().size();
+      }
+    }
+    if (rawBytes == 0) {
+      continue;
+    }
+    std::vector<std::string_view> sample(values.begin(), values.end());
+    auto symbols = FsstSymbolTable::build(sample);
+    std::string compressed;
+    for (const auto& value : sample) {
+      symbols->compress(value, compressed);
+    }
+    if (rawBytes >= compressed.size() * kMinCompressionRatio) {
+      data_->setCompressedStrings(
+          columnMap_[i].inputChannel, std::move(symbols));
+    }
+  }
+}
+
 void SortBuffer::noMoreInput() {
   VELOX_CHECK(!noMoreInput_);
   noMoreInput_ = true;
@@ -112,19 +159,28 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          sortedRows_,
+          pool_,
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_.value());
+    } else {
+      std::sort(
+          sortedRows_.begin(),
+          sortedRows_.end(),
+          [this](const char* leftRow, const char* rightRow) {
+            for (vector_size_t index = 0; index < sortCompareFlags_.size();
+                 ++index) {
+              if (auto result = data_->compare(
+                      leftRow, rightRow, index, sortCompareFlags_[index])) {
+                return result < 0;
+              }
             }
-          }
-          return false;
-        });
+            return false;
+          });
+    }
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -324,13 +380,20 @@ void SortBuffer::prepareOutput(uint32_t maxOutputRows) {
 
 void SortBuffer::getOutputWithoutSpill() {
   VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
+  std::vector<column_index_t> columns;
+  std::vector<VectorPtr> children;
+  columns.reserve(columnMap_.size());
+  children.reserve(columnMap_.size());
   for (const auto& columnProjection : columnMap_) {
-    data_->extractColumn(
-        sortedRows_.data() + numOutputRows_,
-        output_->size(),
-        columnProjection.inputChannel,
-        output_->childAt(columnProjection.outputChannel));
+    columns.push_back(columnProjection.inputChannel);
+    children.push_back(output_->childAt(columnProjection.outputChannel));
   }
+  data_->extractColumns(
+      sortedRows_.data() + numOutputRows_,
+      output_->size(),
+      columns,
+      0,
+      children);
   numOutputRows_ += output_->size();
 }
 
@@ -385,7 +448,10 @@ void SortBuffer::finishSpill() {
   spiller_->finishSpill(spillPartitionSet);
   VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
   spillMerger_ = spillPartitionSet.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->executor);
 }
 
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
@@ -37,7 +38,10 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt,
+      bool stringCompression = false);
 
   void addInput(const VectorPtr& input);
 
@@ -72,6 +76,9 @@ class SortBuffer {
   void prepareOutput(uint32_t maxOutputRows);
   void getOutputWithoutSpill();
   void getOutputWithSpill();
+  // Sets up the compression of the non-sort-key string columns of 'data_'
+  // that compress well in the first 'input'.
+  void setupStringCompression(const RowVector& input);
   // Spill during input stage.
   void spillInput();
   // Spill during output stage.
@@ -82,6 +89,8 @@ class SortBuffer {
 
   const RowTypePtr input_;
   const std::vector<CompareFlags> sortCompareFlags_;
+  // If set, the in-memory rows are sorted with prefix sort.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   velox::memory::MemoryPool* const pool_;
   // The flag is passed from the associated operator such as OrderBy or
   // TableWriter to indicate if this sort buffer object is under non-reclaimable
@@ -89,6 +98,9 @@ class SortBuffer {
   tsan_atomic<bool>* const nonReclaimableSection_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  // True if the non-sort-key string columns may be stored compressed. Reset
+  // once the first input has decided which columns to compress.
+  bool stringCompression_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -16,6 +16,7 @@
 
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -44,11 +45,13 @@ SortWindowBuild::SortWindowBuild(
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
       spillCompareFlags_{
           makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())},
+      prefixSortConfig_(prefixSortConfig),
       pool_(pool),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(pool_);
@@ -217,21 +220,57 @@ void SortWindowBuild::sortPartitions() {
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
-  std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
-      [this](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-      });
+  if (prefixSortConfig_.has_value()) {
+    PrefixSort::sort(
+        sortedRows_,
+        pool_,
+        data_.get(),
+        spillCompareFlags_,
+        prefixSortConfig_.value());
+  } else {
+    std::sort(
+        sortedRows_.begin(),
+        sortedRows_.end(),
+        [this](const char* leftRow, const char* rightRow) {
+          return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
+        });
+  }
 
   computePartitionStartRows();
 }
 
+void SortWindowBuild::ensureSortFits() {
+  if (spillConfig_ == nullptr || spiller_ != nullptr ||
+      !prefixSortConfig_.has_value()) {
+    return;
+  }
+
+  const auto sortBytes = PrefixSort::maxRequiredBytes(
+      data_.get(), spillCompareFlags_, prefixSortConfig_.value(), numRows_);
+  if (sortBytes == 0) {
+    return;
+  }
+  {
+    memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
+    if (pool_->maybeReserve(sortBytes)) {
+      return;
+    }
+  }
+
+  LOG(WARNING) << "Failed to reserve " << succinctBytes(sortBytes)
+               << " for prefix sort of memory pool " << pool_->name()
+               << ", usage: " << succinctBytes(pool_->usedBytes())
+               << ", reservation: " << succinctBytes(pool_->reservedBytes());
+  spill();
+}
+
 void SortWindowBuild::noMoreInput() {
   if (numRows_ == 0) {
     return;
   }
 
+  ensureSortFits();
+
   if (spiller_ != nullptr) {
     // Spill remaining data to avoid running out of memory while sort-merging
     // spilled data.
@@ -242,7 +281,10 @@ void SortWindowBuild::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool_, spillStats_);
+        spillConfig_->readBufferSize,
+        pool_,
+        spillStats_,
+        spillConfig_->executor);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -256,45 +298,67 @@ void SortWindowBuild::noMoreInput() {
 void SortWindowBuild::loadNextPartitionFromSpill() {
   sortedRows_.clear();
   data_->clear();
+  readSpilledPartitionRows(
+      nullptr, std::numeric_limits<vector_size_t>::max(), sortedRows_);
+}
 
-  for (;;) {
+bool SortWindowBuild::readSpilledPartitionRows(
+    const char* lastRow,
+    vector_size_t maxRows,
+    std::vector<char*>& rows) {
+  for (vector_size_t numRead = 0; numRead < maxRows; ++numRead) {
     auto next = merge_->next();
     if (next == nullptr) {
-      break;
+      return true;
     }
 
-    bool newPartition = false;
-    if (!sortedRows_.empty()) {
+    if (lastRow != nullptr) {
       CompareFlags compareFlags =
           CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
 
       for (auto i = 0; i < numPartitionKeys_; ++i) {
         if (data_->compare(
-                sortedRows_.back(),
+                lastRow,
                 data_->columnAt(i),
                 next->decoded(i),
                 next->currentIndex(),
                 compareFlags)) {
-          newPartition = true;
-          break;
+          return true;
         }
       }
     }
 
-    if (newPartition) {
-      break;
-    }
-
     auto* newRow = data_->newRow();
     for (auto i = 0; i < inputChannels_.size(); ++i) {
       data_->store(next->decoded(i), next->currentIndex(), newRow, i);
     }
-    sortedRows_.push_back(newRow);
+    rows.push_back(newRow);
+    lastRow = newRow;
     next->pop();
   }
+  return false;
+}
+
+void SortWindowBuild::loadPartitionRows(
+    WindowPartition& partition,
+    vector_size_t numRows) {
+  VELOX_CHECK_NOT_NULL(merge_);
+  VELOX_CHECK(partition.isStreaming());
+  streamedRows_.clear();
+  const bool complete =
+      readSpilledPartitionRows(partition.lastRow(), numRows, streamedRows_);
+  partition.addRows(streamedRows_);
+  if (complete) {
+    partition.setComplete();
+  }
 }
 
 std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+  if (merge_ != nullptr && streamingPartitions_) {
+    return std::make_unique<WindowPartition>(
+        data_.get(), inversedInputChannels_, sortKeyInfo_);
+  }
+
   if (merge_ != nullptr) {
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
@@ -321,6 +385,13 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
 }
 
 bool SortWindowBuild::hasNextPartition() {
+  if (merge_ != nullptr && streamingPartitions_) {
+    // The rows of the previous partition have all been processed. The rows of
+    // the next partition are loaded as they are processed.
+    data_->clear();
+    return merge_->next() != nullptr;
+  }
+
   if (merge_ != nullptr) {
     loadNextPartitionFromSpill();
     return !sortedRows_.empty();
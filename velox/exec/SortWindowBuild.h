@@ -31,7 +31,9 @@ class SortWindowBuild : public WindowBuild {
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt);
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -55,11 +57,18 @@ class SortWindowBuild : public WindowBuild {
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  void loadPartitionRows(WindowPartition& partition, vector_size_t numRows)
+      override;
+
  private:
   void ensureInputFits(const RowVectorPtr& input);
 
   void setupSpiller();
 
+  // Reserves memory for the prefix sort of all the buffered rows. Spills if
+  // the reservation fails.
+  void ensureSortFits();
+
   // Main sorting function loop done after all input rows are received
   // by WindowBuild.
   void sortPartitions();
@@ -76,15 +85,27 @@ class SortWindowBuild : public WindowBuild {
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
   void loadNextPartitionFromSpill();
 
+  // Reads up to 'maxRows' rows of the current partition from spilled data into
+  // 'data_' and appends them to 'rows'. 'lastRow' is the previous row of the
+  // partition or nullptr for its first row. Returns true if the partition has
+  // no more rows.
+  bool readSpilledPartitionRows(
+      const char* lastRow,
+      vector_size_t maxRows,
+      std::vector<char*>& rows);
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
   // keys are set to default values. Compare flags for sorting keys match
   // sorting order specified in the plan node.
   //
-  // Used to sort 'data_' while spilling.
+  // Used to sort 'data_' while spilling and with prefix sort.
   const std::vector<CompareFlags> spillCompareFlags_;
 
+  // Sorts the buffered rows with PrefixSort if set, with std::sort otherwise.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
+
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
@@ -114,6 +135,9 @@ class SortWindowBuild : public WindowBuild {
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // Reusable rows read from spilled data for a streaming partition.
+  std::vector<char*> streamedRows_;
 };
 
 } // namespace facebook::velox::exec
@@ -191,6 +191,7 @@ void SortedAggregations::extractForSpill(
   elementsVector->resize(offset);
   inputData_->extractSerializedRows(
       folly::Range(groupRows.data(), groupRows.size()), elementsVector);
+  spilledBytes_ += elementsVector->estimateFlatSize();
 }
 
 void SortedAggregations::clear() {
@@ -85,6 +85,12 @@ class SortedAggregations {
   /// Clears all data accumulated so far. Used to release memory after spilling.
   void clear();
 
+  /// Returns the estimated bytes of the input rows extracted for spilling so
+  /// far.
+  uint64_t spilledBytes() const {
+    return spilledBytes_;
+  }
+
  private:
   void addNewRow(char* group, char* newRow);
 
@@ -161,6 +167,9 @@ class SortedAggregations {
   int32_t initializedByte_;
   uint8_t initializedMask_;
   int32_t rowSizeOffset_;
+
+  // Updated by extractForSpill(), which is const.
+  mutable uint64_t spilledBytes_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -31,8 +31,10 @@ void SpillMergeStream::pop() {
 
 int32_t SpillMergeStream::compare(const MergeStream& other) const {
   auto& otherStream = static_cast<const SpillMergeStream&>(other);
+  // Only the sort keys are compared. These are accessed directly so as not to
+  // load the other columns of a stream that reads these on demand.
   auto& children = rowVector_->children();
-  auto& otherChildren = otherStream.current().children();
+  auto& otherChildren = otherStream.rowVector_->children();
   int32_t key = 0;
   if (sortCompareFlags().empty()) {
     do {
@@ -76,7 +78,10 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool columnarFormat,
+    folly::Executor* executor,
+    const std::optional<common::RemoteSpillConfig>& remoteSpillConfig)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -87,6 +92,9 @@ SpillState::SpillState(
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
       fileCreateConfig_(fileCreateConfig),
+      columnarFormat_(columnarFormat),
+      executor_(executor),
+      remoteSpillConfig_(remoteSpillConfig),
       pool_(pool),
       stats_(stats),
       partitionWriters_(maxPartitions_) {}
@@ -132,7 +140,10 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        columnarFormat_,
+        executor_,
+        remoteSpillConfig_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -242,13 +253,14 @@ std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* executor) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillBatchStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillBatchStream::create(SpillReadFile::create(
+        fileInfo, bufferSize, pool, spillStats, executor)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -259,12 +271,13 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* executor) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, bufferSize, pool, spillStats, executor)));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -280,13 +293,19 @@ uint32_t FileSpillMergeStream::id() const {
 
 void FileSpillMergeStream::nextBatch() {
   index_ = 0;
-  if (!spillFile_->nextBatch(rowVector_)) {
+  if (!spillFile_->nextBatch(rowVector_, /*deferPayload=*/true)) {
     size_ = 0;
     return;
   }
   size_ = rowVector_->size();
 }
 
+void FileSpillMergeStream::ensurePayload() const {
+  if (rowVector_ != nullptr) {
+    spillFile_->loadPayload(*rowVector_);
+  }
+}
+
 SpillPartitionIdSet toSpillPartitionIdSet(
     const SpillPartitionSet& partitionSet) {
   SpillPartitionIdSet partitionIdSet;
@@ -54,6 +54,7 @@ class SpillMergeStream : public MergeStream {
   void pop();
 
   const RowVector& current() const {
+    ensurePayload();
     return *rowVector_;
   }
 
@@ -81,9 +82,17 @@ class SpillMergeStream : public MergeStream {
 
   virtual void nextBatch() = 0;
 
+  // Invoked before the columns after the sort keys of 'rowVector_' are
+  // accessed. Streams that read the sort keys of a batch ahead of the other
+  // columns fill in these here.
+  virtual void ensurePayload() const {}
+
   // loads the next 'rowVector' and sets 'decoded_' if this is initialized.
   void setNextBatch() {
     nextBatch();
+    if (decoded_.size() > numSortKeys()) {
+      ensurePayload();
+    }
     if (!decoded_.empty()) {
       ensureRows();
       for (auto i = 0; i < decoded_.size(); ++i) {
@@ -97,6 +106,9 @@ class SpillMergeStream : public MergeStream {
     if (index < oldSize) {
       return;
     }
+    if (index >= numSortKeys()) {
+      ensurePayload();
+    }
     ensureRows();
     decoded_.resize(index + 1);
     for (auto i = oldSize; i <= index; ++i) {
@@ -156,6 +168,8 @@ class FileSpillMergeStream : public SpillMergeStream {
 
   void nextBatch() override;
 
+  void ensurePayload() const override;
+
   std::unique_ptr<SpillReadFile> spillFile_;
 };
 
@@ -277,6 +291,13 @@ class SpillPartition {
     return files_.size();
   }
 
+  /// Returns the spill files of this partition. Unlike the stream readers
+  /// below, this doesn't take the ownership of the files, so that they can be
+  /// read multiple times.
+  const SpillFiles& files() const {
+    return files_;
+  }
+
   /// Returns the total file byte size of this spilled partition.
   uint64_t size() const {
     return size_;
@@ -293,22 +314,26 @@ class SpillPartition {
   /// 'bufferSize' specifies the read size from the storage. If the file system
   /// supports async read mode, then reader allocates two buffers with one
   /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// when reading data from spilled files. If 'executor' is set, it runs the
+  /// prefetch on file systems without native async reads.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* executor = nullptr);
 
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file system
   /// supports async read mode, then reader allocates two buffers with one
   /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// when reading data from spilled files. If 'executor' is set, it runs the
+  /// prefetch on file systems without native async reads.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* executor = nullptr);
 
   std::string toString() const;
 
@@ -332,7 +357,11 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'columnarFormat' is true, sorted spill files keep the sort
+  /// keys and the other columns in separate streams. If 'executor' is set, the
+  /// disk writes run on it in the background, see SpillWriter. If
+  /// 'remoteSpillConfig' is set, files overflow to the remote spill directory
+  /// when the local one runs low on space.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -345,7 +374,11 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      bool columnarFormat = false,
+      folly::Executor* executor = nullptr,
+      const std::optional<common::RemoteSpillConfig>& remoteSpillConfig =
+          std::nullopt);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -440,6 +473,9 @@ class SpillState {
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
   const std::string fileCreateConfig_;
+  const bool columnarFormat_;
+  folly::Executor* const executor_;
+  const std::optional<common::RemoteSpillConfig> remoteSpillConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/SpillFile.h"
+
+#include <filesystem>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
 
@@ -26,18 +29,72 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Offset of the compressed size in a serialized page header.
+constexpr int32_t kPageCompressedSizeOffset{4 + 1 + 4};
+// Size of the checksum following the compressed size in a page header.
+constexpr int32_t kPageChecksumSize{8};
+
+// Returns a RowVector with 'size' rows over the children of 'rows' in
+// ['begin', 'end').
+RowVectorPtr sliceColumns(
+    const RowVectorPtr& rows,
+    const RowTypePtr& type,
+    column_index_t begin,
+    column_index_t end) {
+  std::vector<VectorPtr> children(
+      rows->children().begin() + begin, rows->children().begin() + end);
+  return std::make_shared<RowVector>(
+      rows->pool(), type, nullptr, rows->size(), std::move(children));
+}
+
+// Returns the row type of the columns of 'type' in ['begin', 'end').
+RowTypePtr sliceType(
+    const RowTypePtr& type,
+    column_index_t begin,
+    column_index_t end) {
+  std::vector<std::string> names(
+      type->names().begin() + begin, type->names().begin() + end);
+  std::vector<TypePtr> types(
+      type->children().begin() + begin, type->children().begin() + end);
+  return ROW(std::move(names), std::move(types));
+}
+
+// Returns the free bytes of the local file system containing the file with
+// 'pathPrefix', or std::nullopt if 'pathPrefix' is not a local path or the free
+// space can't be determined.
+std::optional<uint64_t> localFreeBytes(const std::string& pathPrefix) {
+  static const std::string kFileScheme{"file:"};
+  std::string path = pathPrefix;
+  if (path.compare(0, kFileScheme.size(), kFileScheme) == 0) {
+    path = path.substr(kFileScheme.size());
+  } else if (path.find("://") != std::string::npos) {
+    return std::nullopt;
+  }
+  std::error_code ec;
+  const auto space =
+      std::filesystem::space(std::filesystem::path(path).parent_path(), ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return space.available;
+}
 } // namespace
 
 SpillInputStream::SpillInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* executor)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize - AlignedBuffer::kPaddedSize)),
       pool_(pool),
-      readaEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()),
+      executor_(executor),
+      readaEnabled_(
+          (bufferSize_ < fileSize_) &&
+          (file_->hasPreadvAsync() || executor_ != nullptr)),
       stats_(stats) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(
@@ -50,6 +107,9 @@ SpillInputStream::SpillInputStream(
 }
 
 SpillInputStream::~SpillInputStream() {
+  if (readaSource_ != nullptr) {
+    readaSource_->close();
+  }
   if (!readaWait_.valid()) {
     return;
   }
@@ -64,14 +124,11 @@ SpillInputStream::~SpillInputStream() {
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   int32_t readBytes{0};
   uint64_t readTimeUs{0};
-  if (readaWait_.valid()) {
+  uint64_t readWaitTimeUs{0};
+  if (readaWait_.valid() || readaSource_ != nullptr) {
     {
-      MicrosecondTimer timer{&readTimeUs};
-      readBytes = std::move(readaWait_)
-                      .via(&folly::QueuedImmediateExecutor::instance())
-                      .wait()
-                      .value();
-      VELOX_CHECK(!readaWait_.valid());
+      MicrosecondTimer timer{&readWaitTimeUs};
+      readBytes = waitForReadahead(readTimeUs);
     }
     VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
     advanceBuffer();
@@ -82,14 +139,33 @@ void SpillInputStream::next(bool /*throwIfPastEnd*/) {
       MicrosecondTimer timer{&readTimeUs};
       file_->pread(offset_, readBytes, buffer()->asMutable<char>());
     }
+    readWaitTimeUs = readTimeUs;
   }
   setRange({buffer()->asMutable<uint8_t>(), readBytes, 0});
-  updateSpillStats(readBytes, readTimeUs);
+  updateSpillStats(readBytes, readTimeUs, readWaitTimeUs);
 
   offset_ += readBytes;
   maybeIssueReadahead();
 }
 
+uint64_t SpillInputStream::waitForReadahead(uint64_t& readTimeUs) {
+  if (readaSource_ == nullptr) {
+    // The time of a native async read is not known apart from the wait.
+    MicrosecondTimer timer{&readTimeUs};
+    const auto readBytes = std::move(readaWait_)
+                               .via(&folly::QueuedImmediateExecutor::instance())
+                               .wait()
+                               .value();
+    VELOX_CHECK(!readaWait_.valid());
+    return readBytes;
+  }
+  auto source = std::move(readaSource_);
+  auto result = source->move();
+  VELOX_CHECK_NOT_NULL(result);
+  readTimeUs = result->readTimeUs;
+  return result->readBytes;
+}
+
 uint64_t SpillInputStream::readSize() const {
   return std::min(fileSize_ - offset_, bufferSize_);
 }
@@ -103,19 +179,40 @@ void SpillInputStream::maybeIssueReadahead() {
   if (size == 0) {
     return;
   }
-  std::vector<folly::Range<char*>> ranges;
-  ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
-  readaWait_ = file_->preadvAsync(offset_, ranges);
-  VELOX_CHECK(readaWait_.valid());
+  if (file_->hasPreadvAsync()) {
+    std::vector<folly::Range<char*>> ranges;
+    ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
+    readaWait_ = file_->preadvAsync(offset_, ranges);
+    VELOX_CHECK(readaWait_.valid());
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(executor_);
+  readaSource_ = std::make_shared<AsyncSource<ReadResult>>(
+      [file = file_.get(),
+       offset = offset_,
+       size,
+       buffer = nextBuffer()->asMutable<char>()]() {
+        uint64_t readTimeUs{0};
+        {
+          MicrosecondTimer timer{&readTimeUs};
+          file->pread(offset, size, buffer);
+        }
+        return std::make_unique<ReadResult>(ReadResult{size, readTimeUs});
+      });
+  executor_->add([source = readaSource_]() { source->prepare(); });
 }
 
-void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
-    const {
+void SpillInputStream::updateSpillStats(
+    uint64_t readBytes,
+    uint64_t readTimeUs,
+    uint64_t readWaitTimeUs) const {
   auto lockedStats = stats_->wlock();
   lockedStats->spillReadBytes += readBytes;
   lockedStats->spillReadTimeUs += readTimeUs;
+  lockedStats->spillReadWaitTimeUs += readWaitTimeUs;
   ++(lockedStats->spillReads);
   common::updateGlobalSpillReadStats(readBytes, readTimeUs);
+  common::updateGlobalSpillReadWaitTime(readWaitTimeUs);
 }
 
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
@@ -172,7 +269,10 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    bool columnarFormat,
+    folly::Executor* executor,
+    const std::optional<common::RemoteSpillConfig>& remoteSpillConfig)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -181,6 +281,10 @@ SpillWriter::SpillWriter(
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       fileCreateConfig_(fileCreateConfig),
+      columnarFormat_(
+          columnarFormat && numSortKeys_ > 0 && numSortKeys_ < type_->size()),
+      executor_(executor),
+      remoteSpillConfig_(remoteSpillConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
       stats_(stats) {
@@ -188,6 +292,16 @@ SpillWriter::SpillWriter(
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
+  if (columnarFormat_) {
+    keyType_ = sliceType(type_, 0, numSortKeys_);
+    payloadType_ = sliceType(type_, numSortKeys_, type_->size());
+  }
+}
+
+SpillWriter::~SpillWriter() {
+  if (pendingWrite_ != nullptr) {
+    pendingWrite_->close();
+  }
 }
 
 SpillWriteFile* SpillWriter::ensureFile() {
@@ -197,18 +311,43 @@ SpillWriteFile* SpillWriter::ensureFile() {
   if (currentFile_ == nullptr) {
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format("{}-{}", nextFilePathPrefix(), finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
 }
 
+std::string SpillWriter::nextFilePathPrefix() {
+  currentFileRemote_ = false;
+  if (!remoteSpillConfig_.has_value()) {
+    return pathPrefix_;
+  }
+  const auto freeBytes = localFreeBytes(pathPrefix_);
+  if (!freeBytes.has_value() ||
+      freeBytes.value() >= remoteSpillConfig_->minLocalFreeBytes) {
+    return pathPrefix_;
+  }
+  VELOX_CHECK_NOT_NULL(
+      remoteSpillConfig_->getSpillDirPathCb,
+      "Remote spill directory callback not specified.");
+  const auto remoteDir = remoteSpillConfig_->getSpillDirPathCb();
+  VELOX_CHECK(!remoteDir.empty(), "Remote spill directory does not exist");
+  currentFileRemote_ = true;
+  const auto fileNamePos = pathPrefix_.rfind('/');
+  return fmt::format(
+      "{}/{}",
+      remoteDir,
+      fileNamePos == std::string::npos ? pathPrefix_
+                                       : pathPrefix_.substr(fileNamePos + 1));
+}
+
 void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  waitForWrite();
   currentFile_->finish();
-  updateSpilledFileStats(currentFile_->size());
+  updateSpilledFileStats(currentFile_->size(), currentFileRemote_);
   finishedFiles_.push_back(SpillFileInfo{
       .id = currentFile_->id(),
       .type = type_,
@@ -216,7 +355,8 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .columnarFormat = columnarFormat_});
   currentFile_.reset();
 }
 
@@ -229,30 +369,79 @@ uint64_t SpillWriter::flush() {
     return 0;
   }
 
-  auto* file = ensureFile();
-  VELOX_CHECK_NOT_NULL(file);
-
   IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+      *pool_, nullptr, std::max<int64_t>(64 * 1024, batchSize()));
   uint64_t flushTimeUs{0};
   {
     MicrosecondTimer timer(&flushTimeUs);
     batch_->flush(&out);
+    if (payloadBatch_ != nullptr) {
+      payloadBatch_->flush(&out);
+    }
+  }
+  if (payloadBatch_ != nullptr) {
+    updateCompressionStats(*batch_, "spillKey");
+    updateCompressionStats(*payloadBatch_, "spillPayload");
+  } else {
+    updateCompressionStats(*batch_, "spill");
   }
   batch_.reset();
+  payloadBatch_.reset();
 
-  uint64_t writeTimeUs{0};
-  uint64_t writtenBytes{0};
   auto iobuf = out.getIOBuf();
-  {
-    MicrosecondTimer timer(&writeTimeUs);
-    writtenBytes = file->write(std::move(iobuf));
+  const uint64_t writtenBytes = iobuf->computeChainDataLength();
+  if (executor_ == nullptr) {
+    auto* file = ensureFile();
+    VELOX_CHECK_NOT_NULL(file);
+    uint64_t writeTimeUs{0};
+    {
+      MicrosecondTimer timer(&writeTimeUs);
+      file->write(std::move(iobuf));
+    }
+    updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
+  } else {
+    // Waits for the previous write before starting this one so that at most
+    // one buffer is in flight.
+    waitForWrite();
+    auto* file = ensureFile();
+    VELOX_CHECK_NOT_NULL(file);
+    pendingWrite_ = std::make_shared<AsyncSource<WriteResult>>(
+        [file,
+         data = std::shared_ptr<folly::IOBuf>(std::move(iobuf)),
+         writtenBytes,
+         flushTimeUs]() {
+          uint64_t writeTimeUs{0};
+          {
+            MicrosecondTimer timer(&writeTimeUs);
+            file->write(data->clone());
+          }
+          return std::make_unique<WriteResult>(
+              WriteResult{writtenBytes, flushTimeUs, writeTimeUs});
+        });
+    executor_->add([source = pendingWrite_]() { source->prepare(); });
   }
-  updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
 }
 
+void SpillWriter::waitForWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto source = std::move(pendingWrite_);
+  uint64_t waitTimeUs{0};
+  std::unique_ptr<WriteResult> result;
+  {
+    MicrosecondTimer timer(&waitTimeUs);
+    result = source->move();
+  }
+  VELOX_CHECK_NOT_NULL(result);
+  updateWriteStats(
+      result->writtenBytes, result->flushTimeUs, result->writeTimeUs);
+  stats_->wlock()->spillWriteWaitTimeUs += waitTimeUs;
+  common::updateGlobalSpillWriteWaitTime(waitTimeUs);
+}
+
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
@@ -261,24 +450,62 @@ uint64_t SpillWriter::write(
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer(&timeUs);
-    if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
-      batch_ = std::make_unique<VectorStreamGroup>(pool_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1'000,
-          &options);
+    if (columnarFormat_) {
+      if (batch_ == nullptr) {
+        batch_ = makeBatch(keyType_);
+        payloadBatch_ = makeBatch(payloadType_);
+      }
+      batch_->append(sliceColumns(rows, keyType_, 0, numSortKeys_), indices);
+      payloadBatch_->append(
+          sliceColumns(rows, payloadType_, numSortKeys_, rows->childrenSize()),
+          indices);
+    } else {
+      if (batch_ == nullptr) {
+        batch_ = makeBatch(asRowType(rows->type()));
+      }
+      batch_->append(rows, indices);
     }
-    batch_->append(rows, indices);
   }
   updateAppendStats(rows->size(), timeUs);
-  if (batch_->size() < writeBufferSize_) {
+  if (batchSize() < writeBufferSize_) {
     return 0;
   }
   return flush();
 }
 
+std::unique_ptr<VectorStreamGroup> SpillWriter::makeBatch(
+    const RowTypePtr& type) const {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+      kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+  auto batch = std::make_unique<VectorStreamGroup>(pool_);
+  batch->createStreamTree(type, 1'000, &options);
+  return batch;
+}
+
+uint64_t SpillWriter::batchSize() const {
+  uint64_t size = batch_ == nullptr ? 0 : batch_->size();
+  if (payloadBatch_ != nullptr) {
+    size += payloadBatch_->size();
+  }
+  return size;
+}
+
+void SpillWriter::updateCompressionStats(
+    VectorStreamGroup& batch,
+    const std::string& prefix) const {
+  if (compressionKind_ == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  for (const auto& [name, counter] : batch.runtimeStats()) {
+    if (counter.value == 0) {
+      continue;
+    }
+    auto statName = prefix + name;
+    statName[prefix.size()] = std::toupper(statName[prefix.size()]);
+    addThreadLocalRuntimeStat(statName, counter);
+  }
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeUs) {
@@ -301,8 +528,15 @@ void SpillWriter::updateWriteStats(
       spilledBytes, flushTimeUs, fileWriteTimeUs);
 }
 
-void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
-  ++stats_->wlock()->spilledFiles;
+void SpillWriter::updateSpilledFileStats(uint64_t fileSize, bool remote) {
+  {
+    auto statsLocked = stats_->wlock();
+    ++statsLocked->spilledFiles;
+    if (remote) {
+      ++statsLocked->spilledRemoteFiles;
+      statsLocked->spilledRemoteBytes += fileSize;
+    }
+  }
   addThreadLocalRuntimeStat(
       "spillFileSize", RuntimeCounter(fileSize, RuntimeCounter::Unit::kBytes));
   common::incrementGlobalSpilledFiles();
@@ -353,7 +587,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* executor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -363,8 +598,10 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.columnarFormat,
       pool,
-      stats));
+      stats,
+      executor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -376,8 +613,10 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    bool columnarFormat,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* executor)
     : id_(id),
       path_(path),
       size_(size),
@@ -385,6 +624,7 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      columnarFormat_(columnarFormat),
       readOptions_{
           kDefaultUseLosslessTimestamp,
           compressionKind_,
@@ -394,10 +634,19 @@ SpillReadFile::SpillReadFile(
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), bufferSize, pool_, stats_);
+      std::move(file), bufferSize, pool_, stats_, executor);
+  if (columnarFormat_) {
+    VELOX_CHECK_GT(numSortKeys_, 0);
+    VELOX_CHECK_LT(numSortKeys_, type_->size());
+    keyType_ = sliceType(type_, 0, numSortKeys_);
+    payloadType_ = sliceType(type_, numSortKeys_, type_->size());
+  }
 }
 
-bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
+bool SpillReadFile::nextBatch(RowVectorPtr& rowVector, bool deferPayload) {
+  if (payloadPending_) {
+    skipPayload();
+  }
   if (input_->atEnd()) {
     return false;
   }
@@ -405,12 +654,65 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer{&timeUs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, &rowVector, &readOptions_);
+    if (!columnarFormat_) {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, &rowVector, &readOptions_);
+    } else {
+      RowVectorPtr keys;
+      VectorStreamGroup::read(
+          input_.get(), pool_, keyType_, &keys, &readOptions_);
+      auto children = keys->children();
+      children.resize(type_->size());
+      rowVector = std::make_shared<RowVector>(
+          pool_, type_, nullptr, keys->size(), std::move(children));
+      payloadPending_ = true;
+    }
   }
   stats_->wlock()->spillDeserializationTimeUs += timeUs;
   common::updateGlobalSpillDeserializationTimeUs(timeUs);
 
+  if (payloadPending_ && !deferPayload) {
+    loadPayload(*rowVector);
+  }
   return true;
 }
+
+void SpillReadFile::loadPayload(RowVector& rowVector) {
+  if (!payloadPending_) {
+    return;
+  }
+  VELOX_CHECK(columnarFormat_);
+  VELOX_CHECK_EQ(rowVector.childrenSize(), type_->size());
+  VELOX_CHECK_NULL(rowVector.childAt(numSortKeys_));
+
+  uint64_t timeUs{0};
+  RowVectorPtr payload;
+  {
+    MicrosecondTimer timer{&timeUs};
+    VectorStreamGroup::read(
+        input_.get(), pool_, payloadType_, &payload, &readOptions_);
+  }
+  payloadPending_ = false;
+  stats_->wlock()->spillDeserializationTimeUs += timeUs;
+  common::updateGlobalSpillDeserializationTimeUs(timeUs);
+
+  VELOX_CHECK_EQ(payload->size(), rowVector.size());
+  for (auto i = 0; i < payload->childrenSize(); ++i) {
+    rowVector.childAt(numSortKeys_ + i) = payload->childAt(i);
+  }
+}
+
+void SpillReadFile::skipPayload() {
+  VELOX_CHECK(payloadPending_);
+  input_->skip(kPageCompressedSizeOffset);
+  const auto compressedSize = input_->read<int32_t>();
+  input_->skip(kPageChecksumSize + compressedSize);
+  payloadPending_ = false;
+  addThreadLocalRuntimeStat(
+      "spillPayloadSkippedBytes",
+      RuntimeCounter(
+          kPageCompressedSizeOffset + sizeof(int32_t) + kPageChecksumSize +
+              compressedSize,
+          RuntimeCounter::Unit::kBytes));
+}
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -89,6 +90,10 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// If true, each batch is stored as a serialized page with the 'numSortKeys'
+  /// leading columns followed by a page with the remaining columns. The pages
+  /// are compressed independently. Otherwise each batch is a single page.
+  bool columnarFormat{false};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -105,7 +110,14 @@ class SpillWriter {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'columnarFormat' is true and the data is sorted
+  /// with some non-key columns, the files are written in the columnar format,
+  /// see SpillFileInfo::columnarFormat. If 'executor' is set, each disk write
+  /// runs on it while the caller serializes the next buffer. At most one write
+  /// is in flight so the buffered data is bounded by twice 'writeBufferSize'.
+  /// If 'remoteSpillConfig' is set, a new file is created in the remote spill
+  /// directory with the same file name if the file system of 'pathPrefix' has
+  /// less free space than 'remoteSpillConfig->minLocalFreeBytes'.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -120,7 +132,13 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      bool columnarFormat = false,
+      folly::Executor* executor = nullptr,
+      const std::optional<common::RemoteSpillConfig>& remoteSpillConfig =
+          std::nullopt);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -158,6 +176,10 @@ class SpillWriter {
   // creates a new one. 'currentFile_' points to the current open spill file.
   SpillWriteFile* ensureFile();
 
+  // Returns the path prefix of a new spill file on the tier chosen by the free
+  // space of the local spill directory. Sets 'currentFileRemote_' accordingly.
+  std::string nextFilePathPrefix();
+
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
@@ -165,12 +187,28 @@ class SpillWriter {
   // written size.
   uint64_t flush();
 
+  // Waits for the completion of 'pendingWrite_' if any and records its stats.
+  void waitForWrite();
+
   // Invoked to increment the number of spilled files and the file size.
-  void updateSpilledFileStats(uint64_t fileSize);
+  // 'remote' specifies if the file is on the remote spill tier.
+  void updateSpilledFileStats(uint64_t fileSize, bool remote);
 
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
 
+  // Returns the buffered serialized size of 'batch_' and 'payloadBatch_'.
+  uint64_t batchSize() const;
+
+  // Creates a VectorStreamGroup for serializing 'type'.
+  std::unique_ptr<VectorStreamGroup> makeBatch(const RowTypePtr& type) const;
+
+  // Invoked on flush to record the compression stats of 'batch' as runtime
+  // stats with names starting with 'prefix'.
+  void updateCompressionStats(
+      VectorStreamGroup& batch,
+      const std::string& prefix) const;
+
   // Invoked to update the disk write stats.
   void updateWriteStats(
       uint64_t spilledBytes,
@@ -185,6 +223,13 @@ class SpillWriter {
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const std::string fileCreateConfig_;
+  const bool columnarFormat_;
+  folly::Executor* const executor_;
+  const std::optional<common::RemoteSpillConfig> remoteSpillConfig_;
+  // The types of the sort key columns and of the other columns. Set if
+  // 'columnarFormat_' is true.
+  RowTypePtr keyType_;
+  RowTypePtr payloadType_;
 
   // Updates the aggregated spill bytes of this query, and throws if exceeds
   // the max spill bytes limit.
@@ -194,9 +239,23 @@ class SpillWriter {
 
   bool finished_{false};
   uint32_t nextFileId_{0};
+  // Buffered data for the next write. Has the sort key columns if
+  // 'columnarFormat_' is true and all the columns otherwise.
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Buffered data of the non-key columns if 'columnarFormat_' is true.
+  std::unique_ptr<VectorStreamGroup> payloadBatch_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // True if 'currentFile_' is on the remote spill tier.
+  bool currentFileRemote_{false};
   SpillFiles finishedFiles_;
+
+  struct WriteResult {
+    uint64_t writtenBytes;
+    uint64_t flushTimeUs;
+    uint64_t writeTimeUs;
+  };
+  // The in-flight write to 'currentFile_' on 'executor_'.
+  std::shared_ptr<AsyncSource<WriteResult>> pendingWrite_;
 };
 
 /// Input stream backed by spill file.
@@ -206,12 +265,15 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If 'executor' is
+  /// set, the next buffer is read on it while the current one is consumed if
+  /// 'file' does not support native async reads.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* executor = nullptr);
 
   ~SpillInputStream() override;
 
@@ -221,16 +283,21 @@ class SpillInputStream : public ByteInputStream {
   }
 
  private:
-  void updateSpillStats(uint64_t readBytes, uint64_t readTimeUs) const;
+  void updateSpillStats(
+      uint64_t readBytes,
+      uint64_t readTimeUs,
+      uint64_t readWaitTimeUs) const;
 
   void next(bool throwIfPastEnd) override;
 
-  // Issues readahead if underlying fs supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues readahead if underlying fs supports async mode read or if there is
+  // an executor to run the read on.
   void maybeIssueReadahead();
 
+  // Waits for the read-ahead to complete. Returns the read size and sets
+  // 'readTimeUs' to the time spent in the read.
+  uint64_t waitForReadahead(uint64_t& readTimeUs);
+
   inline uint32_t bufferIndex() const {
     return bufferIndex_;
   }
@@ -259,6 +326,7 @@ class SpillInputStream : public ByteInputStream {
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  folly::Executor* const executor_;
   const bool readaEnabled_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -267,6 +335,13 @@ class SpillInputStream : public ByteInputStream {
   // Sets to read-ahead future if valid.
   folly::SemiFuture<uint64_t> readaWait_{
       folly::SemiFuture<uint64_t>::makeEmpty()};
+
+  struct ReadResult {
+    uint64_t readBytes;
+    uint64_t readTimeUs;
+  };
+  // The read-ahead on 'executor_' if 'file_' has no native async read.
+  std::shared_ptr<AsyncSource<ReadResult>> readaSource_;
   // Offset of first byte not in 'buffer()'.
   uint64_t offset_ = 0;
 };
@@ -284,7 +359,8 @@ class SpillReadFile {
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* executor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -298,7 +374,16 @@ class SpillReadFile {
     return sortCompareFlags_;
   }
 
-  bool nextBatch(RowVectorPtr& rowVector);
+  /// Reads the next batch into 'rowVector'. Returns false at end of file. If
+  /// 'deferPayload' is true and the file is in the columnar format, only the
+  /// sort key columns are read and the other children of 'rowVector' are left
+  /// null until loadPayload() is called. These are skipped without
+  /// deserializing if the next batch is read first.
+  bool nextBatch(RowVectorPtr& rowVector, bool deferPayload = false);
+
+  /// Fills in the children after the sort keys of 'rowVector', which is the
+  /// last batch read with 'deferPayload'. No-op if these are already set.
+  void loadPayload(RowVector& rowVector);
 
   /// Returns the file size in bytes.
   uint64_t size() const {
@@ -319,8 +404,14 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      bool columnarFormat,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* executor);
+
+  // Skips over the serialized non-key columns of the current batch in the
+  // columnar format.
+  void skipPayload();
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -333,10 +424,18 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const bool columnarFormat_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  // The types of the sort key columns and of the other columns. Set if
+  // 'columnarFormat_' is true.
+  RowTypePtr keyType_;
+  RowTypePtr payloadType_;
 
   std::unique_ptr<SpillInputStream> input_;
+  // True if the non-key columns of the last batch read with 'deferPayload'
+  // have not been read from 'input_' yet.
+  bool payloadPending_{false};
 };
 } // namespace facebook::velox::exec
@@ -20,6 +20,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
 using facebook::velox::common::testutil::TestValue;
@@ -58,6 +59,8 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -65,6 +68,9 @@ Spiller::Spiller(
       "Unexpected spiller type: {}",
       typeName(type_));
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
+  if (container_->keyTypes().size() == sortCompareFlags.size()) {
+    prefixSortConfig_ = spillConfig->prefixSortConfig;
+  }
 }
 
 Spiller::Spiller(
@@ -93,6 +99,8 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -124,6 +132,8 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -156,6 +166,8 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -189,6 +201,8 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -218,10 +232,46 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kRowNumber);
 }
 
+Spiller::Spiller(
+    Type type,
+    RowTypePtr rowType,
+    const common::SpillConfig* spillConfig,
+    folly::Synchronized<common::SpillStats>* spillStats)
+    : Spiller(
+          type,
+          nullptr,
+          std::move(rowType),
+          HashBitRange{},
+          0,
+          {},
+          false,
+          spillConfig->getSpillDirPathCb,
+          spillConfig->updateAndCheckSpillLimitCb,
+          spillConfig->fileNamePrefix,
+          spillConfig->maxFileSize,
+          spillConfig->writeBufferSize,
+          spillConfig->compressionKind,
+          spillConfig->executor,
+          0,
+          spillConfig->fileCreateConfig,
+          spillConfig->columnarFormat,
+          spillConfig->remoteSpillConfig,
+          spillStats) {
+  VELOX_CHECK_EQ(
+      type_,
+      Type::kNestedLoopJoinBuild,
+      "Unexpected spiller type: {}",
+      typeName(type_));
+  VELOX_CHECK_EQ(state_.maxPartitions(), 1);
+  state_.setPartitionSpilled(0);
+}
+
 Spiller::Spiller(
     Type type,
     RowContainer* container,
@@ -239,6 +289,8 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    bool columnarFormat,
+    const std::optional<common::RemoteSpillConfig>& remoteSpillConfig,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -260,11 +312,16 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          columnarFormat,
+          executor,
+          remoteSpillConfig) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
-  VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
+  VELOX_CHECK_EQ(
+      container_ == nullptr,
+      type_ == Type::kHashJoinProbe || type_ == Type::kNestedLoopJoinBuild);
   spillRuns_.reserve(state_.maxPartitions());
   for (int i = 0; i < state_.maxPartitions(); ++i) {
     spillRuns_.emplace_back(*memory::spillMemoryPool());
@@ -305,6 +362,7 @@ int64_t Spiller::extractSpillVector(
     RowVectorPtr& spillVector,
     size_t& nextBatchIndex) {
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NE(type_, Type::kNestedLoopJoinBuild);
 
   auto limit = std::min<size_t>(rows.size() - nextBatchIndex, maxRows);
   VELOX_CHECK(!rows.empty());
@@ -416,13 +474,22 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          run.rows,
+          container_->pool(),
+          container_,
+          state_.sortCompareFlags(),
+          prefixSortConfig_.value());
+    } else {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
 
@@ -433,6 +500,7 @@ void Spiller::ensureSorted(SpillRun& run) {
 
 std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NE(type_, Type::kNestedLoopJoinBuild);
   // Target size of a single vector of spilled content. One of
   // these will be materialized at a time for each stream of the
   // merge.
@@ -538,7 +606,7 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
 bool Spiller::needSort() const {
   return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
       type_ != Type::kRowNumber && type_ != Type::kAggregateOutput &&
-      type_ != Type::kOrderByOutput;
+      type_ != Type::kOrderByOutput && type_ != Type::kNestedLoopJoinBuild;
 }
 
 void Spiller::spill() {
@@ -553,6 +621,7 @@ void Spiller::spill(const RowContainerIterator& startRowIter) {
 void Spiller::spill(const RowContainerIterator* startRowIter) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NE(type_, Type::kNestedLoopJoinBuild);
   VELOX_CHECK_NE(type_, Type::kOrderByOutput);
 
   markAllPartitionsSpilled();
@@ -601,7 +670,7 @@ void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK(
       type_ == Type::kHashJoinProbe || type_ == Type::kHashJoinBuild ||
-          type_ == Type::kRowNumber,
+          type_ == Type::kRowNumber || type_ == Type::kNestedLoopJoinBuild,
       "Unexpected spiller type: {}",
       typeName(type_));
   if (FOLLY_UNLIKELY(!state_.isPartitionSpilled(partition))) {
@@ -736,6 +805,8 @@ std::string Spiller::typeName(Type type) {
       return "AGGREGATE_OUTPUT";
     case Type::kRowNumber:
       return "ROW_NUMBER";
+    case Type::kNestedLoopJoinBuild:
+      return "NESTED_LOOP_JOIN_BUILD";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
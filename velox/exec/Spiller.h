@@ -41,8 +41,10 @@ class Spiller {
     kOrderByOutput = 5,
     // Used for row number.
     kRowNumber = 6,
+    // Used for nested loop join build.
+    kNestedLoopJoinBuild = 7,
     // Number of spiller types.
-    kNumTypes = 7,
+    kNumTypes = 8,
   };
 
   static std::string typeName(Type);
@@ -108,6 +110,14 @@ class Spiller {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// type == Type::kNestedLoopJoinBuild. Spills vectors to a single partition
+  /// which is marked as spilling on construction.
+  Spiller(
+      Type type,
+      RowTypePtr rowType,
+      const common::SpillConfig* spillConfig,
+      folly::Synchronized<common::SpillStats>* spillStats);
+
   Type type() const {
     return type_;
   }
@@ -131,7 +141,7 @@ class Spiller {
 
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
-  /// hash join build and hash join probe.
+  /// hash join build, hash join probe and nested loop join build.
   ///
   /// NOTE: the spilling operator should first mark 'partition' as spilling and
   /// spill any data buffered in row container before call this.
@@ -218,6 +228,8 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      bool columnarFormat,
+      const std::optional<common::RemoteSpillConfig>& remoteSpillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -330,6 +342,9 @@ class Spiller {
   const bool spillProbedFlag_;
   const uint64_t maxSpillRunRows_;
 
+  // If set, sorts the spill runs of order by input with prefix sort.
+  std::optional<common::PrefixSortConfig> prefixSortConfig_;
+
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
   // True if all rows of spilling partitions are in 'spillRuns_', so
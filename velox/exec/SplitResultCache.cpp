@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitResultCache.h"
+
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/json.h>
+
+#include <cstring>
+#include <map>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+namespace {
+serializer::presto::PrestoVectorSerde::PrestoOptions makeOptions(
+    common::CompressionKind compressionKind) {
+  return serializer::presto::PrestoVectorSerde::PrestoOptions{
+      true /*useLosslessTimestamp*/, compressionKind};
+}
+
+SplitResultCache** getInstancePtr() {
+  static SplitResultCache* cache{nullptr};
+  return &cache;
+}
+} // namespace
+
+std::string SplitResultCache::Stats::toString() const {
+  return fmt::format(
+      "SplitResultCache hits: {} ssd hits: {} misses: {} inserts: {} "
+      "entries: {} ({}) ssd entries: {} ({})",
+      numHits,
+      numSsdHits,
+      numMisses,
+      numInserts,
+      numEntries,
+      succinctBytes(memoryBytes),
+      numSsdEntries,
+      succinctBytes(ssdBytes));
+}
+
+SplitResultCache::SplitResultCache(const Options& options)
+    : options_(options) {
+  if (hasSsd()) {
+    filesystems::getFileSystem(options_.ssdPath, nullptr)
+        ->mkdir(options_.ssdPath);
+  }
+}
+
+SplitResultCache::~SplitResultCache() {
+  clear();
+}
+
+// static
+SplitResultCache* SplitResultCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void SplitResultCache::setInstance(SplitResultCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+std::string SplitResultCache::fragmentKey(
+    const core::PlanNode& node,
+    const core::QueryConfig& queryConfig) {
+  // The plan nodes serialize with the table handles and column assignments of
+  // the scans, which the detailed toString() of the plan does not show. The
+  // keys are sorted since the iteration order of folly::dynamic objects may
+  // vary.
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  std::string text = folly::json::serialize(node.serialize(), opts);
+  const std::map<std::string, std::string> configs(
+      queryConfig.rawConfigs().begin(), queryConfig.rawConfigs().end());
+  for (const auto& [name, value] : configs) {
+    text.append(fmt::format("\n{}={}", name, value));
+  }
+  uint64_t hash1{0};
+  uint64_t hash2{0};
+  folly::hash::SpookyHashV2::Hash128(text.data(), text.size(), &hash1, &hash2);
+  return fmt::format("{:016x}{:016x}", hash1, hash2);
+}
+
+std::shared_ptr<const SplitResult> SplitResultCache::find(
+    const std::string& key) {
+  std::string path;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+      ++numHits_;
+      return it->second.result;
+    }
+    auto ssdIt = ssdEntries_.find(key);
+    if (ssdIt == ssdEntries_.end()) {
+      ++numMisses_;
+      return nullptr;
+    }
+    path = std::move(ssdIt->second.path);
+    ssdBytes_ -= ssdIt->second.bytes;
+    ssdLru_.erase(ssdIt->second.lruPosition);
+    ssdEntries_.erase(ssdIt);
+  }
+
+  auto result = readSsd(path);
+  removeFiles({path});
+  std::vector<std::string> deletePaths;
+  std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+      evicted;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (result == nullptr) {
+      ++numMisses_;
+      return nullptr;
+    }
+    ++numHits_;
+    ++numSsdHits_;
+    evicted = insertLocked(key, result, deletePaths);
+  }
+  removeFiles(deletePaths);
+  writeSsd(std::move(evicted));
+  return result;
+}
+
+void SplitResultCache::insert(
+    const std::string& key,
+    std::shared_ptr<const SplitResult> result) {
+  VELOX_CHECK_NOT_NULL(result);
+  if (result->bytes > options_.maxEntryBytes) {
+    return;
+  }
+  std::vector<std::string> deletePaths;
+  std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+      evicted;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (entries_.count(key) != 0) {
+      return;
+    }
+    ++numInserts_;
+    evicted = insertLocked(key, std::move(result), deletePaths);
+  }
+  removeFiles(deletePaths);
+  writeSsd(std::move(evicted));
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+SplitResultCache::insertLocked(
+    const std::string& key,
+    std::shared_ptr<const SplitResult> result,
+    std::vector<std::string>& deletePaths) {
+  std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+      evicted;
+  if (entries_.count(key) != 0) {
+    return evicted;
+  }
+  auto ssdIt = ssdEntries_.find(key);
+  if (ssdIt != ssdEntries_.end()) {
+    deletePaths.push_back(std::move(ssdIt->second.path));
+    ssdBytes_ -= ssdIt->second.bytes;
+    ssdLru_.erase(ssdIt->second.lruPosition);
+    ssdEntries_.erase(ssdIt);
+  }
+  lru_.push_front(key);
+  memoryBytes_ += result->bytes;
+  entries_.emplace(key, MemoryEntry{std::move(result), lru_.begin()});
+  while (memoryBytes_ > options_.maxMemoryBytes) {
+    auto it = entries_.find(lru_.back());
+    VELOX_CHECK(it != entries_.end());
+    memoryBytes_ -= it->second.result->bytes;
+    if (hasSsd()) {
+      evicted.emplace_back(it->first, std::move(it->second.result));
+    }
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+  return evicted;
+}
+
+void SplitResultCache::writeSsd(
+    std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+        evicted) {
+  for (auto& [key, result] : evicted) {
+    const auto path =
+        fmt::format("{}/split-result-{}", options_.ssdPath, nextFileId_++);
+    try {
+      auto file =
+          filesystems::getFileSystem(path, nullptr)->openFileForWrite(path);
+      for (const auto& batch : result->batches) {
+        const uint64_t size = batch.size();
+        file->append(std::string_view(
+            reinterpret_cast<const char*>(&size), sizeof(size)));
+        file->append(batch);
+      }
+      file->close();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to write split result to " << path << ": "
+                   << e.what();
+      removeFiles({path});
+      continue;
+    }
+
+    std::vector<std::string> deletePaths;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (entries_.count(key) != 0 || ssdEntries_.count(key) != 0) {
+        // Inserted again while being written.
+        deletePaths.push_back(path);
+      } else {
+        ssdLru_.push_front(key);
+        ssdEntries_.emplace(
+            key, SsdEntry{path, result->bytes, ssdLru_.begin()});
+        ssdBytes_ += result->bytes;
+        while (ssdBytes_ > options_.maxSsdBytes) {
+          auto it = ssdEntries_.find(ssdLru_.back());
+          VELOX_CHECK(it != ssdEntries_.end());
+          deletePaths.push_back(std::move(it->second.path));
+          ssdBytes_ -= it->second.bytes;
+          ssdEntries_.erase(it);
+          ssdLru_.pop_back();
+        }
+      }
+    }
+    removeFiles(deletePaths);
+  }
+}
+
+std::shared_ptr<const SplitResult> SplitResultCache::readSsd(
+    const std::string& path) const {
+  try {
+    auto file =
+        filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+    const auto data = file->pread(0, file->size());
+    auto result = std::make_shared<SplitResult>();
+    uint64_t offset{0};
+    while (offset < data.size()) {
+      uint64_t size;
+      VELOX_CHECK_LE(offset + sizeof(size), data.size());
+      std::memcpy(&size, data.data() + offset, sizeof(size));
+      offset += sizeof(size);
+      VELOX_CHECK_LE(offset + size, data.size());
+      result->batches.emplace_back(data.data() + offset, size);
+      result->bytes += size;
+      offset += size;
+    }
+    return result;
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to read split result from " << path << ": "
+                 << e.what();
+    return nullptr;
+  }
+}
+
+void SplitResultCache::removeFiles(
+    const std::vector<std::string>& paths) const {
+  for (const auto& path : paths) {
+    try {
+      filesystems::getFileSystem(path, nullptr)->remove(path);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to remove split result file " << path << ": "
+                   << e.what();
+    }
+  }
+}
+
+std::string SplitResultCache::serialize(
+    const RowVectorPtr& vector,
+    memory::MemoryPool* pool) const {
+  const auto options = makeOptions(options_.compressionKind);
+  VectorStreamGroup group(pool);
+  group.createStreamTree(asRowType(vector->type()), vector->size(), &options);
+  group.append(vector);
+  IOBufOutputStream stream(*pool, nullptr, group.size());
+  group.flush(&stream);
+  const auto data = stream.getIOBuf();
+  std::string batch;
+  batch.reserve(data->computeChainDataLength());
+  for (const auto& range : *data) {
+    batch.append(reinterpret_cast<const char*>(range.data()), range.size());
+  }
+  return batch;
+}
+
+RowVectorPtr SplitResultCache::deserialize(
+    const std::string& batch,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) const {
+  std::vector<ByteRange> ranges;
+  ranges.push_back(ByteRange{
+      reinterpret_cast<uint8_t*>(const_cast<char*>(batch.data())),
+      static_cast<int32_t>(batch.size()),
+      0});
+  ByteInputStream input(std::move(ranges));
+  const auto options = makeOptions(options_.compressionKind);
+  RowVectorPtr result;
+  VectorStreamGroup::read(&input, pool, type, &result, &options);
+  return result;
+}
+
+SplitResultCache::Stats SplitResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numSsdHits = numSsdHits_;
+  stats.numMisses = numMisses_;
+  stats.numInserts = numInserts_;
+  stats.numEntries = entries_.size();
+  stats.memoryBytes = memoryBytes_;
+  stats.numSsdEntries = ssdEntries_.size();
+  stats.ssdBytes = ssdBytes_;
+  return stats;
+}
+
+void SplitResultCache::clear() {
+  std::vector<std::string> deletePaths;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto& [key, entry] : ssdEntries_) {
+      deletePaths.push_back(std::move(entry.path));
+    }
+    entries_.clear();
+    ssdEntries_.clear();
+    lru_.clear();
+    ssdLru_.clear();
+    memoryBytes_ = 0;
+    ssdBytes_ = 0;
+  }
+  removeFiles(deletePaths);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+
+#include "velox/common/compression/Compression.h"
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// The output of a pipeline segment for one split, e.g. the partial
+/// aggregation of the rows a TableScan produced for the split after filters
+/// and projections. Each batch is serialized in the Presto wire format so that
+/// the result outlives the query that produced it.
+struct SplitResult {
+  std::vector<std::string> batches;
+  /// The total size of 'batches'.
+  uint64_t bytes{0};
+};
+
+/// A process wide cache of SplitResults. The key combines the plan fragment
+/// that produced the result and the identity of the split, see
+/// fragmentKey() and ConnectorSplit::cacheKey(). Queries that re-run the same
+/// plan over unchanged files replay the cached results instead of reading and
+/// aggregating the splits again. The results are kept in memory and, if
+/// 'ssdPath' is set, move to files in 'ssdPath' when evicted from memory.
+/// Both tiers evict in LRU order. Is thread safe.
+class SplitResultCache {
+ public:
+  struct Options {
+    /// The max total size of the results kept in memory.
+    uint64_t maxMemoryBytes{256 << 20};
+
+    /// Results larger than this are not cached.
+    uint64_t maxEntryBytes{16 << 20};
+
+    /// The directory for the results evicted from memory. No SSD tier if
+    /// empty.
+    std::string ssdPath;
+
+    /// The max total size of the results in 'ssdPath'.
+    uint64_t maxSsdBytes{0};
+
+    /// The compression of the serialized batches.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+  };
+
+  struct Stats {
+    /// The number of lookups that found the result in memory or on SSD.
+    uint64_t numHits{0};
+    /// The part of 'numHits' that was read from SSD.
+    uint64_t numSsdHits{0};
+    uint64_t numMisses{0};
+    uint64_t numInserts{0};
+    uint64_t numEntries{0};
+    uint64_t memoryBytes{0};
+    uint64_t numSsdEntries{0};
+    uint64_t ssdBytes{0};
+
+    std::string toString() const;
+  };
+
+  explicit SplitResultCache(const Options& options);
+
+  /// Removes the files of the SSD tier.
+  ~SplitResultCache();
+
+  /// Returns the process wide instance or nullptr if there is none.
+  static SplitResultCache* getInstance();
+
+  /// Sets the process wide instance. The caller keeps the ownership.
+  static void setInstance(SplitResultCache* cache);
+
+  /// Returns the part of the cache key that identifies the plan fragment ending
+  /// at 'node' and the query config it runs with.
+  static std::string fragmentKey(
+      const core::PlanNode& node,
+      const core::QueryConfig& queryConfig);
+
+  /// Returns the result for 'key' or nullptr if there is none. A result found
+  /// on SSD is moved back to memory.
+  std::shared_ptr<const SplitResult> find(const std::string& key);
+
+  /// Adds 'result' for 'key'. Does nothing if 'result' is larger than
+  /// 'maxEntryBytes' or 'key' is already in memory.
+  void insert(
+      const std::string& key,
+      std::shared_ptr<const SplitResult> result);
+
+  /// Serializes 'vector' for adding to a SplitResult. 'pool' is used for the
+  /// temporary buffers.
+  std::string serialize(const RowVectorPtr& vector, memory::MemoryPool* pool)
+      const;
+
+  /// Returns the vector of 'type' serialized in 'batch', allocated from 'pool'.
+  RowVectorPtr deserialize(
+      const std::string& batch,
+      const RowTypePtr& type,
+      memory::MemoryPool* pool) const;
+
+  uint64_t maxEntryBytes() const {
+    return options_.maxEntryBytes;
+  }
+
+  Stats stats() const;
+
+  /// Removes all the results from memory and SSD.
+  void clear();
+
+ private:
+  struct MemoryEntry {
+    std::shared_ptr<const SplitResult> result;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  struct SsdEntry {
+    std::string path;
+    uint64_t bytes;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  bool hasSsd() const {
+    return !options_.ssdPath.empty() && options_.maxSsdBytes > 0;
+  }
+
+  // Adds 'result' to memory. Returns the results evicted to stay within
+  // 'maxMemoryBytes'. Adds the path of an old SSD copy of 'key' to
+  // 'deletePaths'.
+  std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+  insertLocked(
+      const std::string& key,
+      std::shared_ptr<const SplitResult> result,
+      std::vector<std::string>& deletePaths);
+
+  // Writes the results evicted from memory to SSD.
+  void writeSsd(
+      std::vector<std::pair<std::string, std::shared_ptr<const SplitResult>>>
+          evicted);
+
+  // Reads the result in the file at 'path'. Returns nullptr on error.
+  std::shared_ptr<const SplitResult> readSsd(const std::string& path) const;
+
+  // Removes the files at 'paths', ignoring errors.
+  void removeFiles(const std::vector<std::string>& paths) const;
+
+  const Options options_;
+
+  std::atomic<uint64_t> nextFileId_{0};
+
+  mutable std::mutex mutex_;
+  // The keys of 'entries_' and 'ssdEntries_', most recently used first.
+  std::list<std::string> lru_;
+  std::list<std::string> ssdLru_;
+  folly::F14FastMap<std::string, MemoryEntry> entries_;
+  folly::F14FastMap<std::string, SsdEntry> ssdEntries_;
+  uint64_t memoryBytes_{0};
+  uint64_t ssdBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numSsdHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numInserts_{0};
+};
+
+/// Receives the per split results of the pipeline segment between a TableScan
+/// and a partial aggregation. The TableScan looks up each split in the
+/// SplitResultCache and either replays the cached result or tells the
+/// consumer that the rows of a new split follow. See
+/// Driver::pushdownSplitResultConsumer().
+class SplitResultConsumer {
+ public:
+  virtual ~SplitResultConsumer() = default;
+
+  /// Called before the rows of a split that is not in the cache are produced.
+  /// 'key' is the cache key of the split, std::nullopt if the split cannot be
+  /// cached.
+  virtual void startSplit(std::optional<std::string> key) = 0;
+
+  /// Called instead of producing the rows of a split whose result is cached.
+  virtual void replaySplit(std::shared_ptr<const SplitResult> result) = 0;
+};
+
+} // namespace facebook::velox::exec
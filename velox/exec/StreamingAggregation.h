@@ -83,8 +83,9 @@ class StreamingAggregation : public Operator {
   // Initialize the aggregations setting allocator and offsets.
   void initializeAggregates(uint32_t numKeys);
 
-  /// Maximum number of rows in the output batch.
-  const uint32_t outputBatchSize_;
+  /// Maximum number of rows in the output batch. Adapted to the average size
+  /// of the output rows on each input batch.
+  uint32_t outputBatchSize_;
 
   // Used at initialize() and gets reset() afterward.
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
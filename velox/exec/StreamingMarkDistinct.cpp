@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/StreamingMarkDistinct.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+StreamingMarkDistinct::StreamingMarkDistinct(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::MarkDistinctNode>& planNode)
+    : Operator(
+          driverCtx,
+          planNode->outputType(),
+          operatorId,
+          planNode->id(),
+          "StreamingMarkDistinct") {
+  VELOX_CHECK(planNode->isPreGrouped());
+  const auto& inputType = planNode->sources()[0]->outputType();
+
+  // Set all input columns as identity projection.
+  for (auto i = 0; i < inputType->size(); ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+
+  // We will use result[0] for distinct mask output.
+  resultProjections_.emplace_back(0, inputType->size());
+
+  keyChannels_.reserve(planNode->distinctKeys().size());
+  for (const auto& key : planNode->distinctKeys()) {
+    keyChannels_.push_back(exprToChannel(key.get(), inputType));
+  }
+
+  results_.resize(1);
+}
+
+void StreamingMarkDistinct::addInput(RowVectorPtr input) {
+  input_ = std::move(input);
+}
+
+bool StreamingMarkDistinct::equalsPreviousRow(vector_size_t index) const {
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (!input_->childAt(keyChannels_[i])
+             ->equalValueAt(previousKeys_[i].get(), index, 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RowVectorPtr StreamingMarkDistinct::getOutput() {
+  if (isFinished() || !input_) {
+    return nullptr;
+  }
+
+  const auto outputSize = input_->size();
+  // Re-use memory for the mask vector if possible.
+  VectorPtr& result = results_[0];
+  if (result && result.unique()) {
+    BaseVector::prepareForReuse(result, outputSize);
+  } else {
+    result = BaseVector::create(BOOLEAN(), outputSize, operatorCtx_->pool());
+  }
+  auto resultBits =
+      results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+
+  // A row starts a new run of keys unless all its keys equal those of the
+  // row before it. The first row is compared with the last row of the
+  // previous input.
+  bits::fillBits(resultBits, 0, outputSize, false);
+  if (previousKeys_.empty() || !equalsPreviousRow(0)) {
+    bits::setBit(resultBits, 0, true);
+  }
+  for (const auto channel : keyChannels_) {
+    const auto& keys = input_->childAt(channel);
+    for (auto row = 1; row < outputSize; ++row) {
+      if (!bits::isBitSet(resultBits, row) &&
+          !keys->equalValueAt(keys.get(), row, row - 1)) {
+        bits::setBit(resultBits, row, true);
+      }
+    }
+  }
+
+  // Keep the keys of the last row for the next input.
+  previousKeys_.resize(keyChannels_.size());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    const auto& keys = input_->childAt(keyChannels_[i]);
+    auto& previous = previousKeys_[i];
+    if (previous == nullptr || !previous.unique()) {
+      previous = BaseVector::create(keys->type(), 1, operatorCtx_->pool());
+    }
+    previous->copy(keys.get(), 0, outputSize - 1, 1);
+  }
+
+  auto output = fillOutput(outputSize, nullptr);
+
+  // Drop reference to input_ to make it singly-referenced at the producer and
+  // allow for memory reuse.
+  input_ = nullptr;
+
+  return output;
+}
+
+bool StreamingMarkDistinct::isFinished() {
+  return noMoreInput_ && !input_;
+}
+} // namespace facebook::velox::exec
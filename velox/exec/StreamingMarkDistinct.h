@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// MarkDistinct over input in which rows with equal distinct keys are
+/// adjacent. Marks the first row of each run of equal keys. Keeps only the
+/// keys of the last input row across batches instead of a hash table of all
+/// distinct keys.
+class StreamingMarkDistinct : public Operator {
+ public:
+  StreamingMarkDistinct(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::MarkDistinctNode>& planNode);
+
+  bool preservesOrder() const override {
+    return true;
+  }
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override;
+
+ private:
+  // Returns true if the keys of row 'index' of 'input_' equal the keys of the
+  // last row of the previous input.
+  bool equalsPreviousRow(vector_size_t index) const;
+
+  // Channels of the distinct keys in the input.
+  std::vector<column_index_t> keyChannels_;
+
+  // Keys of the last row of the previous input, one single row vector per key.
+  // Empty before the first input.
+  std::vector<VectorPtr> previousKeys_;
+};
+} // namespace facebook::velox::exec
@@ -44,6 +44,11 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      splitPreloadBytes_(
+          maxSplitPreloadPerDriver_ > 0
+              ? driverCtx_->queryConfig().maxSplitPreloadBytesPerDriver() /
+                  maxSplitPreloadPerDriver_
+              : 0),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
@@ -101,6 +106,21 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
+      if (auto* controller =
+              driverCtx_->task->driverController(driverCtx_->pipelineId)) {
+        curStatus_ = "getOutput: driverController->admit";
+        blockingReason_ = controller->admit(
+            driverCtx_->task->numQueuedSplits(
+                driverCtx_->splitGroupId, planNodeId()),
+            &blockingFuture_);
+        stats_.wlock()->addRuntimeStat(
+            "numActiveDrivers",
+            RuntimeCounter(controller->numActiveDrivers()));
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
+      }
+
       exec::Split split;
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -116,21 +136,15 @@ RowVectorPtr TableScan::getOutput() {
 
       if (!split.hasConnectorSplit()) {
         noMoreSplits_ = true;
+        if (auto* controller =
+                driverCtx_->task->driverController(driverCtx_->pipelineId)) {
+          // Let the parked peers see that there are no more splits.
+          controller->activateAll();
+        }
         dynamicFilters_.clear();
         if (dataSource_) {
           curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
-          const auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.emplace(
-                  name, RuntimeMetric(counter.unit));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
+          addConnectorStats();
         }
         return nullptr;
       }
@@ -148,6 +162,17 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (splitResultConsumer_ != nullptr &&
+          replayCachedSplit(*connectorSplit)) {
+        if (connectorSplit->dataSource != nullptr) {
+          connectorSplit->dataSource->close();
+        }
+        curStatus_ = "getOutput: task->splitFinished";
+        driverCtx_->task->splitFinished(true, currentSplitWeight_);
+        needNewSplit_ = true;
+        continue;
+      }
+
       if (dataSource_ == nullptr) {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
@@ -179,9 +204,17 @@ RowVectorPtr TableScan::getOutput() {
         // The AsyncSource returns a unique_ptr to a shared_ptr. The unique_ptr
         // will be nullptr if there was a cancellation.
         numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
-        auto preparedDataSource = connectorSplit->dataSource->move();
-        stats_.wlock()->getOutputTiming.add(
-            connectorSplit->dataSource->prepareTiming());
+        uint64_t waitUs{0};
+        std::unique_ptr<connector::DataSource> preparedDataSource;
+        {
+          MicrosecondTimer timer(&waitUs);
+          preparedDataSource = connectorSplit->dataSource->move();
+        }
+        const auto& prepareTiming = connectorSplit->dataSource->prepareTiming();
+        preloadWaitUs_ += waitUs;
+        preloadSavedNanos_ += prepareTiming.wallNanos -
+            std::min<uint64_t>(prepareTiming.wallNanos, waitUs * 1'000);
+        stats_.wlock()->getOutputTiming.add(prepareTiming);
         if (!preparedDataSource) {
           // There must be a cancellation.
           VELOX_CHECK(operatorCtx_->task()->isCancelled());
@@ -230,6 +263,13 @@ RowVectorPtr TableScan::getOutput() {
           maxReadBatchSize_,
           static_cast<int32_t>(readBatchSize / maxFilteringRatio_));
     }
+    if (remainingOutputRows_.has_value() && !dataSource_->hasFilter()) {
+      // Reads only as many rows as the pushed down limit still needs, not a
+      // full batch. A scan with filters reads full batches since a selective
+      // filter would otherwise make many small reads.
+      readBatchSize = static_cast<int32_t>(
+          std::min<int64_t>(readBatchSize, *remainingOutputRows_));
+    }
     curStatus_ = "getOutput: dataSource_->next";
     uint64_t ioTimeUs{0};
     std::optional<RowVectorPtr> dataOptional;
@@ -240,6 +280,7 @@ RowVectorPtr TableScan::getOutput() {
 
     curStatus_ = "getOutput: checkPreload";
     checkPreload();
+    RowVectorPtr data;
     {
       curStatus_ = "getOutput: updating stats_.dataSourceReadWallNanos";
       auto lockedStats = stats_.wlock();
@@ -255,34 +296,35 @@ RowVectorPtr TableScan::getOutput() {
       curStatus_ = "getOutput: updating stats_.rawInput";
       lockedStats->rawInputPositions = dataSource_->getCompletedRows();
       lockedStats->rawInputBytes = dataSource_->getCompletedBytes();
-      RowVectorPtr data = std::move(dataOptional).value();
+      data = std::move(dataOptional).value();
       if (data != nullptr) {
-        if (data->size() > 0) {
-          lockedStats->addInputVector(data->estimateFlatSize(), data->size());
-          constexpr int kMaxSelectiveBatchSizeMultiplier = 4;
-          maxFilteringRatio_ = std::max(
-              {maxFilteringRatio_,
-               1.0 * data->size() / readBatchSize,
-               1.0 / kMaxSelectiveBatchSizeMultiplier});
+        if (data->size() == 0) {
+          continue;
+        }
+        lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+        constexpr int kMaxSelectiveBatchSizeMultiplier = 4;
+        maxFilteringRatio_ = std::max(
+            {maxFilteringRatio_,
+             1.0 * data->size() / readBatchSize,
+             1.0 / kMaxSelectiveBatchSizeMultiplier});
+        if (!remainingOutputRows_.has_value()) {
+          return data;
+        }
+        *remainingOutputRows_ -= data->size();
+        if (*remainingOutputRows_ > 0) {
           return data;
         }
-        continue;
       }
     }
 
-    {
-      curStatus_ = "getOutput: updating stats_.preloadedSplits";
-      auto lockedStats = stats_.wlock();
-      if (numPreloadedSplits_ > 0) {
-        lockedStats->addRuntimeStat(
-            "preloadedSplits", RuntimeCounter(numPreloadedSplits_));
-        numPreloadedSplits_ = 0;
-      }
-      if (numReadyPreloadedSplits_ > 0) {
-        lockedStats->addRuntimeStat(
-            "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
-        numReadyPreloadedSplits_ = 0;
-      }
+    if (data != nullptr) {
+      finishAtOutputLimit();
+      return data;
+    }
+
+    addPreloadStats();
+    if (remainingOutputRows_.has_value()) {
+      limitSpansSplits_ = true;
     }
 
     curStatus_ = "getOutput: task->splitFinished";
@@ -291,6 +333,85 @@ RowVectorPtr TableScan::getOutput() {
   }
 }
 
+void TableScan::addConnectorStats() {
+  const auto connectorStats = dataSource_->runtimeStats();
+  auto lockedStats = stats_.wlock();
+  for (const auto& [name, counter] : connectorStats) {
+    if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+      lockedStats->runtimeStats.emplace(name, RuntimeMetric(counter.unit));
+    } else {
+      VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+    }
+    lockedStats->runtimeStats.at(name).addValue(counter.value);
+  }
+}
+
+void TableScan::addPreloadStats() {
+  curStatus_ = "getOutput: updating stats_.preloadedSplits";
+  auto lockedStats = stats_.wlock();
+  if (numPreloadedSplits_ > 0) {
+    lockedStats->addRuntimeStat(
+        "preloadedSplits", RuntimeCounter(numPreloadedSplits_));
+    numPreloadedSplits_ = 0;
+  }
+  if (numReadyPreloadedSplits_ > 0) {
+    lockedStats->addRuntimeStat(
+        "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
+    numReadyPreloadedSplits_ = 0;
+  }
+  if (preloadWaitUs_ > 0) {
+    lockedStats->addRuntimeStat(
+        "preloadWaitWallNanos",
+        RuntimeCounter(preloadWaitUs_ * 1'000, RuntimeCounter::Unit::kNanos));
+    preloadWaitUs_ = 0;
+  }
+  if (preloadSavedNanos_ > 0) {
+    lockedStats->addRuntimeStat(
+        "preloadSavedWallNanos",
+        RuntimeCounter(preloadSavedNanos_, RuntimeCounter::Unit::kNanos));
+    preloadSavedNanos_ = 0;
+  }
+}
+
+bool TableScan::setSplitResultConsumer(
+    SplitResultConsumer* consumer,
+    const std::string& fragmentKey) {
+  splitResultCache_ = SplitResultCache::getInstance();
+  if (splitResultCache_ == nullptr) {
+    return false;
+  }
+  splitResultConsumer_ = consumer;
+  splitResultFragmentKey_ = fragmentKey;
+  return true;
+}
+
+bool TableScan::replayCachedSplit(const connector::ConnectorSplit& split) {
+  auto splitKey = split.cacheKey();
+  if (!splitKey.has_value()) {
+    splitResultConsumer_->startSplit(std::nullopt);
+    return false;
+  }
+  auto key = fmt::format("{}:{}", splitResultFragmentKey_, splitKey.value());
+  auto result = splitResultCache_->find(key);
+  if (result == nullptr) {
+    addRuntimeStat("splitResultCacheMisses", RuntimeCounter(1));
+    splitResultConsumer_->startSplit(std::move(key));
+    return false;
+  }
+  addRuntimeStat("splitResultCacheHits", RuntimeCounter(1));
+  splitResultConsumer_->replaySplit(std::move(result));
+  return true;
+}
+
+void TableScan::finishAtOutputLimit() {
+  curStatus_ = "getOutput: output limit reached";
+  dataSource_->cancelSplit();
+  addPreloadStats();
+  driverCtx_->task->splitFinished(true, currentSplitWeight_);
+  noMoreSplits_ = true;
+  dynamicFilters_.clear();
+  addConnectorStats();
+}
 void TableScan::preload(
     const std::shared_ptr<connector::ConnectorSplit>& split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
@@ -298,13 +419,15 @@ void TableScan::preload(
   // a shared_ptr to it. This is required to keep memory pools live
   // for the duration. The callback checks for task cancellation to
   // avoid needless work.
+  auto connectorQueryCtx = operatorCtx_->createConnectorQueryCtx(
+      split->connectorId, planNodeId(), connectorPool_);
+  connectorQueryCtx->setPreloadBytesLimit(splitPreloadBytes_);
   split->dataSource = std::make_unique<AsyncSource<connector::DataSource>>(
       [type = outputType_,
        table = tableHandle_,
        columns = columnHandles_,
        connector = connector_,
-       ctx = operatorCtx_->createConnectorQueryCtx(
-           split->connectorId, planNodeId(), connectorPool_),
+       ctx = std::move(connectorQueryCtx),
        task = operatorCtx_->task(),
        dynamicFilters = dynamicFilters_,
        split]() -> std::unique_ptr<connector::DataSource> {
@@ -338,6 +461,9 @@ void TableScan::checkPreload() {
       !connector_->supportsSplitPreload()) {
     return;
   }
+  if (remainingOutputRows_.has_value() && !limitSpansSplits_) {
+    return;
+  }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         maxSplitPreloadPerDriver_;
@@ -367,7 +493,14 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // A producer may tighten its filter over time, e.g. TopN as its threshold
+  // improves. Data sources created later get the conjunction.
+  auto it = dynamicFilters_.find(outputChannel);
+  if (it == dynamicFilters_.end()) {
+    dynamicFilters_.emplace(outputChannel, filter);
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
@@ -17,6 +17,7 @@
 
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SplitResultCache.h"
 
 namespace facebook::velox::exec {
 
@@ -50,6 +51,15 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  void setOutputLimit(int64_t numRows) override {
+    // Reads at least one row so that a zero limit still finishes the scan.
+    remainingOutputRows_ = std::max<int64_t>(numRows, 1);
+  }
+
+  bool setSplitResultConsumer(
+      SplitResultConsumer* consumer,
+      const std::string& fragmentKey) override;
+
  private:
   // Checks if this table scan operator needs to yield before processing the
   // next split.
@@ -70,6 +80,23 @@ class TableScan : public SourceOperator {
   // done, it will be made when needed.
   void preload(const std::shared_ptr<connector::ConnectorSplit>& split);
 
+  // Adds the runtime stats of 'dataSource_' to the stats of 'this'.
+  void addConnectorStats();
+
+  // Adds the counters of preloaded splits to the stats of 'this' and resets
+  // them.
+  void addPreloadStats();
+
+  // Called when the rows needed by a downstream limit have been produced.
+  // Cancels the rest of the current split, including its outstanding reads,
+  // and finishes without taking more splits.
+  void finishAtOutputLimit();
+
+  // Looks up the result of 'split' in 'splitResultCache_'. If found, passes it
+  // to 'splitResultConsumer_' and returns true. Otherwise tells
+  // 'splitResultConsumer_' that the rows of 'split' follow and returns false.
+  bool replayCachedSplit(const connector::ConnectorSplit& split);
+
   const std::shared_ptr<connector::ConnectorTableHandle> tableHandle_;
   const std::
       unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
@@ -92,6 +119,10 @@ class TableScan : public SourceOperator {
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // Bytes of its first stripe or row group that each preloaded split may read
+  // ahead. The driver's budget divided by 'maxSplitPreloadPerDriver_'.
+  const uint64_t splitPreloadBytes_{0};
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -105,9 +136,32 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Time the driver waited for preloads to finish, in microseconds.
+  uint64_t preloadWaitUs_{0};
+
+  // Time spent preloading in the background that the driver did not wait for,
+  // in nanoseconds.
+  uint64_t preloadSavedNanos_{0};
+
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
+  // Number of output rows still consumed downstream if a limit was pushed
+  // down to 'this'. Batches of a scan without filters are capped to it and
+  // the scan finishes when it reaches zero.
+  std::optional<int64_t> remainingOutputRows_;
+
+  // True once a split was read to its end without reaching the pushed down
+  // limit. Splits are preloaded only after that, since a small limit is
+  // usually reached in the first split.
+  bool limitSpansSplits_{false};
+
+  // Set if the results of the operator fed by 'this' are cached per split. See
+  // setSplitResultConsumer().
+  SplitResultCache* splitResultCache_{nullptr};
+  SplitResultConsumer* splitResultConsumer_{nullptr};
+  std::string splitResultFragmentKey_;
+
   // Exits getOutput() method after this many milliseconds. Zero means 'no
   // limit'.
   size_t getOutputTimeLimitMs_{0};
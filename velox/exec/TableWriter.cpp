@@ -253,6 +253,12 @@ void TableWriter::updateStats(const connector::DataSink::Stats& stats) {
     }
     lockedStats->addRuntimeStat(
         "numWrittenFiles", RuntimeCounter(stats.numWrittenFiles));
+    if (stats.numWrittenIndexBytes > 0) {
+      lockedStats->addRuntimeStat(
+          "numWrittenIndexBytes",
+          RuntimeCounter(
+              stats.numWrittenIndexBytes, RuntimeCounter::Unit::kBytes));
+    }
   }
   if (!stats.spillStats.empty()) {
     *spillStats_.wlock() += stats.spillStats;
@@ -21,6 +21,7 @@
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Exchange.h"
@@ -31,7 +32,9 @@
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/SharedAggregationTable.h"
 #include "velox/exec/Task.h"
+#include "velox/expression/Expr.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -304,6 +307,14 @@ Task::Task(
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
+  queryTracer_ = QueryTracer::create(
+      planFragment_.planNode,
+      queryCtx_->queryConfig(),
+      queryCtx_->queryId(),
+      taskId_);
+  if (queryCtx_->queryConfig().driverTimelineEnabled()) {
+    timelineId_ = DriverTimeline::newTimelineId();
+  }
 }
 
 Task::~Task() {
@@ -343,6 +354,7 @@ Task::~Task() {
   CLEAR(childPools_.clear());
   CLEAR(pool_.reset());
   CLEAR(planFragment_ = core::PlanFragment());
+  CLEAR(process::SamplingProfiler::clear(taskId_));
   clearStage = "exiting ~Task()";
 
   // Ful-fill the task deletion promises at the end.
@@ -405,17 +417,77 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
-void Task::removeSpillDirectoryIfExists() {
-  if (spillDirectory_.empty() || !spillDirectoryCreated_) {
-    return;
+const std::string& Task::getOrCreateRemoteSpillDirectory() {
+  VELOX_CHECK(
+      !remoteSpillDirectory_.empty(), "Remote spill directory not set");
+  if (remoteSpillDirectoryCreated_) {
+    return remoteSpillDirectory_;
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (remoteSpillDirectoryCreated_) {
+    return remoteSpillDirectory_;
   }
   try {
-    auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fs->rmdir(spillDirectory_);
+    auto fileSystem =
+        filesystems::getFileSystem(remoteSpillDirectory_, nullptr);
+    fileSystem->mkdir(remoteSpillDirectory_);
   } catch (const std::exception& e) {
-    LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
-               << "' for Task " << taskId() << ": " << e.what();
+    VELOX_FAIL(
+        "Failed to create remote spill directory '{}' for Task {}: {}",
+        remoteSpillDirectory_,
+        taskId(),
+        e.what());
+  }
+  remoteSpillDirectoryCreated_ = true;
+  return remoteSpillDirectory_;
+}
+
+std::shared_ptr<const std::vector<core::TypedExprPtr>>
+Task::getOrFoldConstants(
+    const core::PlanNodeId& planNodeId,
+    const std::vector<core::TypedExprPtr>& exprs,
+    core::ExecCtx* execCtx) {
+  std::lock_guard<std::mutex> l(foldedExprsMutex_);
+  auto& folded = foldedExprs_[planNodeId];
+  if (folded == nullptr) {
+    folded = std::make_shared<const std::vector<core::TypedExprPtr>>(
+        foldConstants(exprs, execCtx));
+  }
+  return folded;
+}
+
+std::shared_ptr<SharedAggregationTable> Task::getSharedAggregationTable(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    uint32_t numDrivers,
+    uint32_t numPartitions) {
+  std::lock_guard<std::mutex> l(sharedAggregationTablesMutex_);
+  auto& entry = sharedAggregationTables_[{splitGroupId, planNodeId}];
+  auto table = entry.lock();
+  if (table == nullptr) {
+    table = std::make_shared<SharedAggregationTable>(numDrivers, numPartitions);
+    entry = table;
   }
+  return table;
+}
+
+void Task::removeSpillDirectoryIfExists() {
+  const auto removeDirectory = [&](const std::string& directory,
+                                   bool created) {
+    if (directory.empty() || !created) {
+      return;
+    }
+    try {
+      auto fs = filesystems::getFileSystem(directory, nullptr);
+      fs->rmdir(directory);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill directory '" << directory
+                 << "' for Task " << taskId() << ": " << e.what();
+    }
+  };
+  removeDirectory(spillDirectory_, spillDirectoryCreated_);
+  removeDirectory(remoteSpillDirectory_, remoteSpillDirectoryCreated_);
 }
 
 uint64_t Task::driverCpuTimeSliceLimitMs() const {
@@ -708,6 +780,7 @@ void Task::start(uint32_t maxDrivers, uint32_t concurrentSplitGroups) {
                      << errorMessageLocked();
         return;
       }
+      MicrosecondTimer timer(&taskStats_.driverFactoryCreationTimeUs);
       createDriverFactoriesLocked(maxDrivers);
     }
     initializePartitionOutput();
@@ -759,9 +832,32 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
         factory->inputDriver, factory->outputDriver);
   }
 
+  createDriverControllersLocked();
   validateGroupedExecutionLeafNodes();
 }
 
+void Task::createDriverControllersLocked() {
+  const auto& queryConfig = queryCtx_->queryConfig();
+  if (!queryConfig.adaptiveDriverCountEnabled()) {
+    return;
+  }
+  // Only the Drivers of table scan pipelines share their input, so that any
+  // of them can be parked between splits. The Drivers of the other source
+  // pipelines, e.g. local exchange consumers, each read their own partition.
+  driverControllers_.resize(driverFactories_.size());
+  for (auto i = 0; i < driverFactories_.size(); ++i) {
+    const auto& factory = driverFactories_[i];
+    if (factory->groupedExecution || factory->numDrivers < 2 ||
+        std::dynamic_pointer_cast<const core::TableScanNode>(
+            factory->planNodes.front()) == nullptr) {
+      continue;
+    }
+    driverControllers_[i] = std::make_unique<PipelineDriverController>(
+        factory->numDrivers,
+        queryConfig.adaptiveDriverCountIntervalMs() * 1'000);
+  }
+}
+
 void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   checkExecutionMode(Task::ExecutionMode::kParallel);
   std::unique_lock<std::timed_mutex> l(mutex_);
@@ -784,8 +880,11 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   if (numDriversUngrouped_ > 0) {
     createSplitGroupStateLocked(kUngroupedGroupId);
     // Create drivers.
-    std::vector<std::shared_ptr<Driver>> drivers =
-        createDriversLocked(kUngroupedGroupId);
+    std::vector<std::shared_ptr<Driver>> drivers;
+    {
+      MicrosecondTimer timer(&taskStats_.driverCreationTimeUs);
+      drivers = createDriversLocked(kUngroupedGroupId);
+    }
     if (pool_->reservedBytes() != 0) {
       VELOX_FAIL(
           "Unexpected memory pool allocations during task[{}] driver initialization: {}",
@@ -1012,7 +1111,11 @@ void Task::createSplitGroupStateLocked(uint32_t splitGroupId) {
     auto exchangeId = factory->needsLocalExchange();
     if (exchangeId.has_value()) {
       createLocalExchangeQueuesLocked(
-          splitGroupId, exchangeId.value(), factory->numDrivers);
+          splitGroupId,
+          exchangeId.value(),
+          factory->numDrivers,
+          queryCtx_->queryConfig().scaleWriters() &&
+              factory->needsScaledWriterExchange());
     }
 
     addHashJoinBridgesLocked(splitGroupId, factory->needsHashJoinBridges());
@@ -1208,6 +1311,7 @@ bool Task::addSplitWithSequence(
   std::unique_ptr<ContinuePromise> promise;
   bool added = false;
   bool isTaskRunning;
+  maybeSetBucketGroup(planNodeId, split);
   {
     std::lock_guard<std::timed_mutex> l(mutex_);
     isTaskRunning = isRunningLocked();
@@ -1239,6 +1343,7 @@ bool Task::addSplitWithSequence(
 void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
   bool isTaskRunning;
   std::unique_ptr<ContinuePromise> promise;
+  maybeSetBucketGroup(planNodeId, split);
   {
     std::lock_guard<std::timed_mutex> l(mutex_);
     isTaskRunning = isRunningLocked();
@@ -1273,6 +1378,18 @@ void Task::addRemoteSplit(
   }
 }
 
+void Task::maybeSetBucketGroup(
+    const core::PlanNodeId& planNodeId,
+    Split& split) const {
+  if (split.hasGroup() || !split.hasConnectorSplit() ||
+      !planFragment_.leafNodeRunsGroupedExecution(planNodeId)) {
+    return;
+  }
+  if (const auto bucket = split.connectorSplit->bucketId()) {
+    split.groupId = bucket.value();
+  }
+}
+
 std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     SplitsState& splitsState,
     exec::Split&& split) {
@@ -1441,6 +1558,15 @@ bool Task::isAllSplitsFinishedLocked() {
       allNodesReceivedNoMoreSplitsMessageLocked();
 }
 
+size_t Task::numQueuedSplits(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  return getPlanNodeSplitsStateLocked(planNodeId)
+      .groupSplitsStores[splitGroupId]
+      .splits.size();
+}
+
 BlockingReason Task::getSplitOrFuture(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
@@ -1580,6 +1706,13 @@ bool Task::isFinished() const {
   return isFinishedLocked();
 }
 
+void Task::releaseReservationIfNotRunning(memory::MemoryPool* pool) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  if (!isRunningLocked()) {
+    pool->release();
+  }
+}
+
 bool Task::isRunningLocked() const {
   return (state_ == TaskState::kRunning);
 }
@@ -1934,6 +2067,14 @@ ContinueFuture Task::terminate(TaskState terminalState) {
   // sources and prevent resending requests for data.
   exchangeClients.clear();
 
+  // Continue the Drivers parked by the driver controllers. A pipeline
+  // activates its parked Drivers itself once its splits are drained.
+  for (auto& controller : driverControllers_) {
+    if (controller != nullptr) {
+      controller->activateAll();
+    }
+  }
+
   std::vector<ContinuePromise> splitPromises;
   std::vector<std::shared_ptr<JoinBridge>> oldBridges;
   std::vector<SplitGroupState> splitGroupStates;
@@ -2067,6 +2208,8 @@ TaskStats Task::taskStats() const {
   // 'taskStats_' contains task stats plus stats for the completed drivers
   // (their operators).
   TaskStats taskStats = taskStats_;
+  taskStats.driverQueuedWallNanos = driverQueuedWallNanos_;
+  taskStats.operatorInitializationTimeUs = operatorInitializationTimeUs_;
 
   taskStats.numTotalDrivers = drivers_.size();
 
@@ -2120,6 +2263,14 @@ TaskStats Task::taskStats() const {
   return taskStats;
 }
 
+std::string Task::profile() const {
+  return process::SamplingProfiler::foldedStacks(taskId_);
+}
+
+std::string Task::toChromeTrace() const {
+  return DriverTimeline::toChromeTrace(timelineId_, taskStats());
+}
+
 bool Task::getLongRunningOpCalls(
     std::chrono::nanoseconds lockTimeout,
     size_t thresholdDurationMs,
@@ -2416,7 +2567,8 @@ std::shared_ptr<MergeJoinSource> Task::getMergeJoinSource(
 void Task::createLocalExchangeQueuesLocked(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
-    int numPartitions) {
+    int numPartitions,
+    bool scaleWriters) {
   auto& splitGroupState = splitGroupStates_[splitGroupId];
   VELOX_CHECK(
       splitGroupState.localExchanges.find(planNodeId) ==
@@ -2435,6 +2587,11 @@ void Task::createLocalExchangeQueuesLocked(
     exchange.queues.emplace_back(
         std::make_shared<LocalExchangeQueue>(exchange.memoryManager, i));
   }
+  if (scaleWriters && numPartitions > 1) {
+    exchange.scaleWriterState = std::make_shared<ScaleWriterPartitionState>(
+        numPartitions,
+        queryCtx_->queryConfig().scaleWritersMinProcessedBytes());
+  }
 
   splitGroupState.localExchanges.insert({planNodeId, std::move(exchange)});
 }
@@ -2478,6 +2635,22 @@ Task::getLocalExchangeQueues(
   return it->second.queues;
 }
 
+const std::shared_ptr<ScaleWriterPartitionState>&
+Task::getScaleWriterPartitionState(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+
+  auto it = splitGroupState.localExchanges.find(planNodeId);
+  VELOX_CHECK(
+      it != splitGroupState.localExchanges.end(),
+      "Incorrect local exchange ID {} for group {}, task {}",
+      planNodeId,
+      splitGroupId,
+      taskId());
+  return it->second.scaleWriterState;
+}
+
 void Task::setError(const std::exception_ptr& exception) {
   TestValue::adjust("facebook::velox::exec::Task::setError", this);
   {
@@ -17,9 +17,12 @@
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/PipelineDriverController.h"
+#include "velox/exec/QueryTracer.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
@@ -31,6 +34,7 @@ class OutputBufferManager;
 
 class HashJoinBridge;
 class NestedLoopJoinBridge;
+class SharedAggregationTable;
 
 using ConnectorSplitPreloadFunc =
     std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>;
@@ -100,6 +104,36 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specify the directory on a remote storage tier to which spill files
+  /// overflow when the local spill directory runs low on free space. The
+  /// directory is created on first use and removed with the task.
+  void setRemoteSpillDirectory(const std::string& remoteSpillDirectory) {
+    remoteSpillDirectory_ = remoteSpillDirectory;
+    remoteSpillDirectoryCreated_ = false;
+  }
+
+  /// Makes the Drivers of 'this' run on 'scheduler' instead of the executor
+  /// of the QueryCtx. Must be called before start().
+  void setDriverScheduler(std::shared_ptr<DriverScheduler> scheduler) {
+    driverScheduler_ = std::move(scheduler);
+  }
+
+  /// Returns the scheduler set by setDriverScheduler() or nullptr if the
+  /// Drivers run on the executor of the QueryCtx.
+  DriverScheduler* driverScheduler() const {
+    return driverScheduler_.get();
+  }
+
+  /// Adds the time a Driver waited to get on thread to TaskStats.
+  void addDriverQueueTime(uint64_t nanos) {
+    driverQueuedWallNanos_ += nanos;
+  }
+
+  /// Adds the time a Driver spent initializing its Operators to TaskStats.
+  void addOperatorInitializationTime(uint64_t micros) {
+    operatorInitializationTimeUs_ += micros;
+  }
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -129,6 +163,24 @@ class Task : public std::enable_shared_from_this<Task> {
     return queryCtx_;
   }
 
+  /// Returns the tracer of the input of plan nodes if the query config
+  /// enables tracing, nullptr otherwise.
+  QueryTracer* queryTracer() const {
+    return queryTracer_.get();
+  }
+
+  /// Returns the id of the events of this task on the driver timeline. 0 if
+  /// the query config does not enable the timeline.
+  uint64_t timelineId() const {
+    return timelineId_;
+  }
+
+  /// Returns the driver timeline of this task in the Chrome trace event
+  /// format. Each pipeline is a process and each driver a thread. Recent
+  /// events of busy threads may have overwritten the older events of this
+  /// task.
+  std::string toChromeTrace() const;
+
   /// Returns MemoryPool used to allocate memory during execution. This instance
   /// is a child of the MemoryPool passed in the constructor.
   memory::MemoryPool* pool() const {
@@ -218,6 +270,8 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Adds split for a source operator corresponding to plan node with
   /// specified ID. Does not require sequential id.
   /// Note that, the operation is silently ignored if Task is not running.
+  /// A split without a group for a plan node in grouped execution goes to the
+  /// split group of its bucket, if its connector split has one.
   void addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split);
 
   /// We mark that for the given group there would be no more splits coming.
@@ -246,6 +300,14 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Returns true if state is 'running'.
   bool isRunning() const;
 
+  /// Called after a memory reservation was made in 'pool' of an operator of
+  /// 'this' off the driver thread, see Driver::reserveMemoryAsync(). If 'this'
+  /// is no longer running, releases the reservation since the operator may
+  /// have been closed before the reservation was made. The state is checked
+  /// under the task lock, so a task that terminates later closes the operator
+  /// after the reservation is made.
+  void releaseReservationIfNotRunning(memory::MemoryPool* pool);
+
   /// Returns true if state is 'finished'.
   bool isFinished() const;
 
@@ -287,6 +349,13 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Returns the stack samples of the drivers of this task as folded stacks,
+  /// one line per distinct stack with the operator and the plan node id as
+  /// the root frame, e.g. "HashProbe 3;...;HashTable::joinProbe 12". The
+  /// samples are taken while process::SamplingProfiler runs. Empty if it did
+  /// not run.
+  std::string profile() const;
+
   /// Information about an operator call that helps debugging stuck calls.
   struct OpCallInfo {
     size_t durationMs;
@@ -394,6 +463,21 @@ class Task : public std::enable_shared_from_this<Task> {
   /// task manager and threads are left to finish themselves.
   static void removeDriver(std::shared_ptr<Task> self, Driver* instance);
 
+  /// Returns the number of splits queued for the source operator corresponding
+  /// to plan node with specified ID.
+  size_t numQueuedSplits(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
+  /// Returns the controller of the number of active Drivers of the pipeline,
+  /// or nullptr if the pipeline runs all its Drivers. See
+  /// QueryConfig::kAdaptiveDriverCountEnabled.
+  PipelineDriverController* driverController(int pipelineId) const {
+    return pipelineId < driverControllers_.size()
+        ? driverControllers_[pipelineId].get()
+        : nullptr;
+  }
+
   /// Returns a split for the source operator corresponding to plan
   /// node with specified ID. If there are no splits and no-more-splits
   /// signal has been received, sets split to null and returns
@@ -439,7 +523,8 @@ class Task : public std::enable_shared_from_this<Task> {
   void createLocalExchangeQueuesLocked(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
-      int numPartitions);
+      int numPartitions,
+      bool scaleWriters);
 
   void noMoreLocalExchangeProducers(uint32_t splitGroupId);
 
@@ -453,6 +538,13 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Returns the state that scales the table writers fed by the local
+  /// exchange, or nullptr if they are not scaled.
+  const std::shared_ptr<ScaleWriterPartitionState>&
+  getScaleWriterPartitionState(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   void setError(const std::exception_ptr& exception);
 
   void setError(const std::string& message);
@@ -654,6 +746,32 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  const std::string& remoteSpillDirectory() const {
+    return remoteSpillDirectory_;
+  }
+
+  /// Same as getOrCreateSpillDirectory() for the remote spill directory.
+  const std::string& getOrCreateRemoteSpillDirectory();
+
+  /// Returns 'exprs' of plan node 'planNodeId' after foldConstants(). The
+  /// first Driver to ask folds them, the other Drivers of the pipeline reuse
+  /// the result. Is thread safe.
+  std::shared_ptr<const std::vector<core::TypedExprPtr>> getOrFoldConstants(
+      const core::PlanNodeId& planNodeId,
+      const std::vector<core::TypedExprPtr>& exprs,
+      core::ExecCtx* execCtx);
+
+  /// Returns the hash table shared by the 'numDrivers' Drivers of aggregation
+  /// 'planNodeId' in split group 'splitGroupId'. See
+  /// QueryConfig::kConcurrentAggregationEnabled. The first Driver to ask
+  /// creates it with 'numPartitions' partitions. The table lives as long as
+  /// one of the Drivers holds it. Is thread safe.
+  std::shared_ptr<SharedAggregationTable> getSharedAggregationTable(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      uint32_t numDrivers,
+      uint32_t numPartitions);
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -696,6 +814,10 @@ class Task : public std::enable_shared_from_this<Task> {
   // Creates driver factories.
   void createDriverFactoriesLocked(uint32_t maxDrivers);
 
+  // Creates 'driverControllers_' for the pipelines whose number of active
+  // Drivers adapts while 'this' runs.
+  void createDriverControllersLocked();
+
   // Creates the output buffer in partitioned output buffer manager if needed.
   void initializePartitionOutput();
 
@@ -898,6 +1020,11 @@ class Task : public std::enable_shared_from_this<Task> {
   // splits coming for the task.
   bool isAllSplitsFinishedLocked();
 
+  // Sets the group of 'split' to its bucket if it has no group and
+  // 'planNodeId' runs grouped execution.
+  void maybeSetBucketGroup(const core::PlanNodeId& planNodeId, Split& split)
+      const;
+
   std::unique_ptr<ContinuePromise> addSplitLocked(
       SplitsState& splitsState,
       exec::Split&& split);
@@ -997,6 +1124,12 @@ class Task : public std::enable_shared_from_this<Task> {
   const int destination_;
   const std::shared_ptr<core::QueryCtx> queryCtx_;
 
+  // Saves the input of plan nodes if enabled by the query config.
+  std::unique_ptr<QueryTracer> queryTracer_;
+
+  // See timelineId().
+  uint64_t timelineId_{0};
+
   // The execution mode of the task. It is enforced that a task can only be
   // executed in a single mode throughout its lifetime
   const ExecutionMode mode_;
@@ -1048,6 +1181,10 @@ class Task : public std::enable_shared_from_this<Task> {
   std::function<void(std::exception_ptr)> onError_;
 
   std::vector<std::unique_ptr<DriverFactory>> driverFactories_;
+  // Controllers of the number of active Drivers by pipeline id. Set when the
+  // Task starts and not changed afterwards. Null for pipelines which run all
+  // their Drivers.
+  std::vector<std::unique_ptr<PipelineDriverController>> driverControllers_;
   std::vector<std::shared_ptr<Driver>> drivers_;
   // When Drivers are closed by the Task, there is a chance that race and/or
   // bugs can cause such Drivers to be held forever, in turn holding a pointer
@@ -1166,6 +1303,40 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Remote spill directory for this task. Spill files overflow to it when the
+  // local file system of 'spillDirectory_' runs low on free space. The
+  // directory is created under 'spillDirCreateMutex_'.
+  std::string remoteSpillDirectory_;
+
+  // Indicates whether the remote spill directory has been created.
+  std::atomic<bool> remoteSpillDirectoryCreated_{false};
+
+  std::shared_ptr<DriverScheduler> driverScheduler_;
+
+  // Total time the Drivers waited to get on thread. Kept outside 'taskStats_'
+  // to not take 'mutex_' on every Driver run.
+  std::atomic<uint64_t> driverQueuedWallNanos_{0};
+
+  // Total time the Drivers spent in Operator::initialize(). Kept outside
+  // 'taskStats_' for the same reason.
+  std::atomic<uint64_t> operatorInitializationTimeUs_{0};
+
+  // Expressions of FilterProject nodes after constant folding, keyed by plan
+  // node id. Shared by the Drivers of the node's pipeline.
+  std::mutex foldedExprsMutex_;
+  folly::F14FastMap<
+      core::PlanNodeId,
+      std::shared_ptr<const std::vector<core::TypedExprPtr>>>
+      foldedExprs_;
+
+  // Hash tables of the aggregations in the concurrent mode, keyed by split
+  // group and plan node id.
+  std::mutex sharedAggregationTablesMutex_;
+  folly::F14FastMap<
+      std::pair<uint32_t, core::PlanNodeId>,
+      std::weak_ptr<SharedAggregationTable>>
+      sharedAggregationTables_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -69,6 +69,18 @@ struct TaskStats {
   /// Epoch time (ms) when task starts to run
   uint64_t executionStartTimeMs{0};
 
+  /// Wall time (us) spent at task start building the DriverFactories of the
+  /// plan fragment in LocalPlanner.
+  uint64_t driverFactoryCreationTimeUs{0};
+
+  /// Wall time (us) spent at task start creating the Drivers and Operators
+  /// for ungrouped execution.
+  uint64_t driverCreationTimeUs{0};
+
+  /// Wall time (us) the Drivers spent in Operator::initialize() when they
+  /// first ran, e.g. compiling expressions. Summed over all Drivers.
+  uint64_t operatorInitializationTimeUs{0};
+
   /// Epoch time (ms) when last split is processed. For some tasks there might
   /// be some additional time to send buffered results before the task finishes.
   uint64_t executionEndTimeMs{0};
@@ -115,6 +127,10 @@ struct TaskStats {
   /// The longest still running operator call's duration in ms.
   size_t longestRunningOpCallMs{0};
 
+  /// Total time the Drivers waited to get on thread after being enqueued, on
+  /// either the QueryCtx executor or the Task's DriverScheduler.
+  uint64_t driverQueuedWallNanos{0};
+
   /// The total memory reclamation count.
   uint32_t memoryReclaimCount{0};
   /// The total memory reclamation time.
@@ -25,6 +25,7 @@ class JoinBridge;
 class LocalExchangeMemoryManager;
 class MergeSource;
 class MergeJoinSource;
+class ScaleWriterPartitionState;
 struct Split;
 
 /// Corresponds to Presto TaskState, needed for reporting query completion.
@@ -83,6 +84,8 @@ struct SplitsState {
 struct LocalExchangeState {
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager;
   std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  /// Set if the table writers fed by the exchange are scaled.
+  std::shared_ptr<ScaleWriterPartitionState> scaleWriterState;
 };
 
 /// Stores inter-operator state (exchange, bridges) for split groups.
@@ -20,6 +20,81 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+
+namespace {
+
+std::vector<column_index_t> reorderInputChannels(
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys) {
+  const auto size = inputType->size();
+
+  std::vector<column_index_t> channels;
+  channels.reserve(size);
+
+  std::vector<bool> isSortingKey(size);
+  for (const auto& key : sortingKeys) {
+    const auto channel = exprToChannel(key.get(), inputType);
+    if (!isSortingKey[channel]) {
+      isSortingKey[channel] = true;
+      channels.push_back(channel);
+    }
+  }
+
+  for (column_index_t i = 0; i < size; ++i) {
+    if (!isSortingKey[i]) {
+      channels.push_back(i);
+    }
+  }
+
+  return channels;
+}
+
+RowTypePtr reorderInputType(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& channels) {
+  std::vector<std::string> names;
+  names.reserve(channels.size());
+
+  std::vector<TypePtr> types;
+  types.reserve(channels.size());
+
+  for (auto channel : channels) {
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  }
+
+  return ROW(std::move(names), std::move(types));
+}
+
+// Returns the compare flags of the distinct sorting keys, in the order of
+// their first appearance.
+std::vector<CompareFlags> makeSpillCompareFlags(
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys,
+    const std::vector<core::SortOrder>& sortingOrders) {
+  std::vector<CompareFlags> compareFlags;
+  compareFlags.reserve(sortingKeys.size());
+
+  std::unordered_set<column_index_t> channels;
+  for (auto i = 0; i < sortingKeys.size(); ++i) {
+    if (channels.insert(exprToChannel(sortingKeys[i].get(), inputType))
+            .second) {
+      compareFlags.push_back(
+          {sortingOrders[i].isNullsFirst(),
+           sortingOrders[i].isAscending(),
+           false /*equalsOnly*/});
+    }
+  }
+  return compareFlags;
+}
+
+// Returns a [start, end) slice of the 'types' vector.
+std::vector<TypePtr>
+slice(const std::vector<TypePtr>& types, int32_t start, int32_t end) {
+  return std::vector<TypePtr>(types.begin() + start, types.begin() + end);
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,40 +104,75 @@ TopN::TopN(
           topNNode->outputType(),
           operatorId,
           topNNode->id(),
-          "TopN"),
+          "TopN",
+          topNNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       count_(topNNode->count()),
-      data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
-      comparator_(
+      firstKeyOrder_(topNNode->sortingOrders()[0]),
+      inputChannels_(
+          reorderInputChannels(outputType_, topNNode->sortingKeys())),
+      inputType_(reorderInputType(outputType_, inputChannels_)),
+      spillCompareFlags_(makeSpillCompareFlags(
           outputType_,
           topNNode->sortingKeys(),
+          topNNode->sortingOrders())),
+      data_(std::make_unique<RowContainer>(
+          slice(inputType_->children(), 0, spillCompareFlags_.size()),
+          slice(
+              inputType_->children(),
+              spillCompareFlags_.size(),
+              inputType_->size()),
+          pool())),
+      comparator_(
+          inputType_,
+          topNNode->sortingKeys(),
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
-  const auto numColumns{outputType_->children().size()};
-  const auto numSortingKeys{topNNode->sortingKeys().size()};
-  sortingKeyColumns_.reserve(numSortingKeys);
-  std::vector<bool> isSortingKey(numColumns);
-  for (const auto& key : topNNode->sortingKeys()) {
-    sortingKeyColumns_.emplace_back(exprToChannel(key.get(), outputType_));
-    isSortingKey[sortingKeyColumns_.back()] = true;
-  }
-  if (numColumns > numSortingKeys) {
-    nonKeyColumns_.reserve(numColumns - numSortingKeys);
-    for (column_index_t i = 0; i < numColumns; ++i) {
-      if (!isSortingKey[i]) {
-        nonKeyColumns_.emplace_back(i);
-      }
-    }
+      decodedVectors_(inputType_->size()) {}
+
+void TopN::initialize() {
+  Operator::initialize();
+  if (!operatorCtx_->driverCtx()->queryConfig().topNDynamicFilterEnabled()) {
+    return;
+  }
+  const auto channel = inputChannels_[0];
+  const auto& type = outputType_->childAt(channel);
+  if (type->isDecimal()) {
+    return;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+      break;
+    default:
+      return;
+  }
+  if (operatorCtx_->driverCtx()
+          ->driver->canPushdownFilters(this, {channel})
+          .empty()) {
+    return;
   }
+  dynamicFilterChannel_ = channel;
 }
 
 void TopN::addInput(RowVectorPtr input) {
-  for (const auto col : sortingKeyColumns_) {
-    decodedVectors_[col].decode(*input->childAt(col));
+  // Test-only spill path.
+  if (spillConfig_.has_value() && data_->numRows() > 0 &&
+      testingTriggerSpill(pool()->name())) {
+    spill();
+  }
+
+  const auto numKeys = spillCompareFlags_.size();
+  for (auto i = 0; i < numKeys; ++i) {
+    decodedVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
 
-  const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
+  const bool hasNonKeyColumn{inputChannels_.size() > numKeys};
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
@@ -82,7 +192,7 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     data_->initializeFields(newRow);
-    for (const auto col : sortingKeyColumns_) {
+    for (auto col = 0; col < numKeys; ++col) {
       data_->store(decodedVectors_[col], row, newRow, col);
     }
 
@@ -93,8 +203,8 @@ void TopN::addInput(RowVectorPtr input) {
   }
 
   if (hasNonKeyColumn && !passedRows.empty()) {
-    for (const auto col : nonKeyColumns_) {
-      decodedVectors_[col].decode(*input->childAt(col));
+    for (auto col = numKeys; col < inputChannels_.size(); ++col) {
+      decodedVectors_[col].decode(*input->childAt(inputChannels_[col]));
       for (const auto [dataRow, inputRow] : passedRows) {
         data_->store(
             decodedVectors_[col],
@@ -104,6 +214,75 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (dynamicFilterChannel_.has_value() && topRows_.size() == count_) {
+    updateDynamicFilter();
+  }
+}
+
+void TopN::updateDynamicFilter() {
+  // The first sorting key is the first column of 'data_'.
+  const auto rowColumn = data_->columnAt(0);
+  const char* topRow = topRows_.top();
+  const auto kind = inputType_->childAt(0)->kind();
+  const bool nullsFirst = firstKeyOrder_.isNullsFirst();
+
+  variant threshold = variant::null(kind);
+  if (!RowContainer::isNullAt(topRow, rowColumn)) {
+    const auto offset = rowColumn.offset();
+    switch (kind) {
+      case TypeKind::TINYINT:
+        threshold = static_cast<int64_t>(
+            RowContainer::valueAt<int8_t>(topRow, offset));
+        break;
+      case TypeKind::SMALLINT:
+        threshold = static_cast<int64_t>(
+            RowContainer::valueAt<int16_t>(topRow, offset));
+        break;
+      case TypeKind::INTEGER:
+        threshold = static_cast<int64_t>(
+            RowContainer::valueAt<int32_t>(topRow, offset));
+        break;
+      case TypeKind::BIGINT:
+        threshold = RowContainer::valueAt<int64_t>(topRow, offset);
+        break;
+      case TypeKind::TIMESTAMP:
+        threshold = RowContainer::valueAt<Timestamp>(topRow, offset);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  } else if (!nullsFirst) {
+    // All values rank before a null top row.
+    return;
+  }
+  if (dynamicFilterThreshold_.has_value() &&
+      dynamicFilterThreshold_.value() == threshold) {
+    return;
+  }
+  dynamicFilterThreshold_ = threshold;
+
+  // Rows with a key equal to the threshold may rank before the top row on the
+  // following keys. Nulls rank before the threshold if they sort first.
+  std::shared_ptr<common::Filter> filter;
+  if (threshold.isNull()) {
+    filter = std::make_shared<common::IsNull>();
+  } else if (kind == TypeKind::TIMESTAMP) {
+    const auto& value = threshold.value<TypeKind::TIMESTAMP>();
+    filter = firstKeyOrder_.isAscending()
+        ? std::make_shared<common::TimestampRange>(
+              std::numeric_limits<Timestamp>::min(), value, nullsFirst)
+        : std::make_shared<common::TimestampRange>(
+              value, std::numeric_limits<Timestamp>::max(), nullsFirst);
+  } else {
+    const auto value = threshold.value<TypeKind::BIGINT>();
+    filter = firstKeyOrder_.isAscending()
+        ? std::make_shared<common::BigintRange>(
+              std::numeric_limits<int64_t>::min(), value, nullsFirst)
+        : std::make_shared<common::BigintRange>(
+              value, std::numeric_limits<int64_t>::max(), nullsFirst);
+  }
+  dynamicFilters_[dynamicFilterChannel_.value()] = std::move(filter);
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -111,6 +290,13 @@ RowVectorPtr TopN::getOutput() {
     return nullptr;
   }
 
+  if (merge_ != nullptr) {
+    return getOutputFromSpill();
+  }
+  return getOutputFromMemory();
+}
+
+RowVectorPtr TopN::getOutputFromMemory() {
   const auto numRowsToReturn = std::min<vector_size_t>(
       outputBatchSize_, rows_.size() - numRowsReturned_);
   VELOX_CHECK_GT(numRowsToReturn, 0);
@@ -118,20 +304,78 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
     data_->extractColumn(
         rows_.data() + numRowsReturned_,
         numRowsToReturn,
         i,
-        result->childAt(i));
+        result->childAt(inputChannels_[i]));
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
 }
 
+RowVectorPtr TopN::getOutputFromSpill() {
+  // The runs are sorted, so that the first 'count_' rows of the merge are the
+  // result.
+  const auto numRowsToReturn = std::min<vector_size_t>(
+      outputBatchSize_, count_ - numRowsReturned_);
+  VELOX_CHECK_GT(numRowsToReturn, 0);
+
+  auto result =
+      BaseVector::create<RowVector>(outputType_, numRowsToReturn, pool());
+  vector_size_t index = 0;
+  while (index < numRowsToReturn) {
+    auto* next = merge_->next();
+    if (next == nullptr) {
+      break;
+    }
+    for (auto i = 0; i < inputChannels_.size(); ++i) {
+      result->childAt(inputChannels_[i])
+          ->copy(
+              next->current().childAt(i).get(), index, next->currentIndex(), 1);
+    }
+    next->pop();
+    ++index;
+  }
+  numRowsReturned_ += index;
+
+  if (index < numRowsToReturn || numRowsReturned_ == count_) {
+    finished_ = true;
+    merge_.reset();
+  }
+  if (index == 0) {
+    return nullptr;
+  }
+  result->resize(index);
+  return result;
+}
+
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+
+  updateEstimatedOutputRowSize();
+  outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+
+  if (spiller_ != nullptr) {
+    // Spill the remaining rows to merge them with the spilled runs.
+    if (data_->numRows() > 0) {
+      spill();
+    }
+
+    VELOX_CHECK_NULL(merge_);
+    SpillPartitionSet spillPartitionSet;
+    spiller_->finishSpill(spillPartitionSet);
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    merge_ = spillPartitionSet.begin()->second->createOrderedReader(
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->executor);
+    return;
+  }
+
   if (topRows_.empty()) {
     finished_ = true;
     return;
@@ -141,11 +385,71 @@ void TopN::noMoreInput() {
     rows_[i - 1] = topRows_.top();
     topRows_.pop();
   }
+}
 
-  outputBatchSize_ = outputBatchRows(data_->estimateRowSize());
+void TopN::updateEstimatedOutputRowSize() {
+  const auto rowSize = data_->estimateRowSize();
+  if (!rowSize.has_value()) {
+    return;
+  }
+  if (!estimatedOutputRowSize_.has_value() ||
+      rowSize.value() > estimatedOutputRowSize_.value()) {
+    estimatedOutputRowSize_ = rowSize.value();
+  }
 }
 
 bool TopN::isFinished() {
   return finished_;
 }
+
+void TopN::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (data_->numRows() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  if (noMoreInput_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from TopN operator which has started "
+                    "producing output: "
+                 << pool()->name()
+                 << ", usage: " << succinctBytes(pool()->usedBytes())
+                 << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    return;
+  }
+
+  spill();
+}
+
+void TopN::spill() {
+  if (spiller_ == nullptr) {
+    setupSpiller();
+  }
+
+  updateEstimatedOutputRowSize();
+
+  spiller_->spill();
+  topRows_ = decltype(topRows_)(comparator_);
+  data_->clear();
+  pool()->release();
+}
+
+void TopN::setupSpiller() {
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK(spillConfig_.has_value());
+
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kOrderByInput,
+      data_.get(),
+      inputType_,
+      spillCompareFlags_.size(),
+      spillCompareFlags_,
+      &spillConfig_.value(),
+      &spillStats_);
+}
 } // namespace facebook::velox::exec
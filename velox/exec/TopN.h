@@ -20,6 +20,11 @@
 
 namespace facebook::velox::exec {
 
+/// Returns the top 'count' rows of the input in the order of the sorting
+/// keys. Keeps the candidate rows in a RowContainer and a priority queue. If
+/// spilling is enabled, a reclaim sorts and spills the candidate rows as a
+/// run and starts over. The output then merges the spilled runs and stops
+/// after 'count' rows.
 class TopN : public Operator {
  public:
   TopN(
@@ -27,6 +32,8 @@ class TopN : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::TopNNode>& topNNode);
 
+  void initialize() override;
+
   bool needsInput() const override {
     return !noMoreInput_;
   }
@@ -43,15 +50,44 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
+  // Sets a dynamic filter on the first sorting key that passes the rows that
+  // may still replace the top of 'topRows_'. Called when 'topRows_' holds
+  // 'count_' rows.
+  void updateDynamicFilter();
+
+  // Sorts, spills and clears all of 'data_' and 'topRows_'.
+  void spill();
+
+  void setupSpiller();
+
+  RowVectorPtr getOutputFromSpill();
+
+  RowVectorPtr getOutputFromMemory();
+
+  // Called in noMoreInput() and spill().
+  void updateEstimatedOutputRowSize();
+
   const int32_t count_;
+  const core::SortOrder firstKeyOrder_;
+
+  // Input columns in the order of: sorting keys, the rest. A key that appears
+  // more than once in the sorting keys appears once.
+  const std::vector<column_index_t> inputChannels_;
+
+  // Input column types in 'inputChannels_' order.
+  const RowTypePtr inputType_;
+
+  // Compare flags for the sorting key columns at the start of
+  // 'inputChannels_'. Used to sort 'data_' while spilling.
+  const std::vector<CompareFlags> spillCompareFlags_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
 
-  std::vector<column_index_t> sortingKeyColumns_;
-  std::vector<column_index_t> nonKeyColumns_;
-
   // As the inputs are added to TopN operator, we use topRows_ (a priority
   // queue) to keep track of the pointers to rows stored in the
   // RowContainer (data_). We only update the RowContainer if a row is a
@@ -61,12 +97,34 @@ class TopN : public Operator {
   // Once all inputs are available, we copy the final set of rows to the
   // vector (rows_) in correct order. We use this vector along with the
   // RowContainer to generate the TopN's output.
+  //
+  // The columns of 'data_' are in 'inputChannels_' order, with the sorting
+  // keys as keys and the rest as dependents.
   std::unique_ptr<RowContainer> data_;
   RowComparator comparator_;
   std::priority_queue<char*, std::vector<char*>, RowComparator> topRows_;
   std::vector<char*> rows_;
 
+  // Decoded input columns in 'inputChannels_' order.
   std::vector<DecodedVector> decodedVectors_;
+
+  // Size of a single output row estimated using 'data_->estimateRowSize()'.
+  // If spilling, this is the max across all spilled runs.
+  std::optional<int64_t> estimatedOutputRowSize_;
   vector_size_t outputBatchSize_;
+
+  // Output channel of the first sorting key if a filter on it can be pushed
+  // down to the table scan of the pipeline. Set in initialize().
+  std::optional<column_index_t> dynamicFilterChannel_;
+
+  // The first sorting key of the top of 'topRows_' when the dynamic filter
+  // was last set. Null variant if the key was null.
+  std::optional<variant> dynamicFilterThreshold_;
+
+  // Spiller for contents of 'data_'.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Used to sort-merge spilled runs.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 };
 } // namespace facebook::velox::exec
@@ -128,6 +128,8 @@ TopNRowNumber::TopNRowNumber(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinRows()),
       abandonPartialMinPct_(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinPct()),
+      maxPartialMemory_(
+          driverCtx->queryConfig().maxPartialTopNRowNumberMemory()),
       data_(std::make_unique<RowContainer>(
           slice(inputType_->children(), 0, spillCompareFlags_.size()),
           slice(
@@ -214,6 +216,13 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
       abandonedPartial_ = true;
       addRuntimeStat("abandonedPartial", RuntimeCounter(1));
 
+      updateEstimatedOutputRowSize();
+      outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+      outputRows_.resize(outputBatchSize_);
+    } else if (isPartialFull()) {
+      partialFull_ = true;
+      addRuntimeStat("numPartialFlushes", RuntimeCounter(1));
+
       updateEstimatedOutputRowSize();
       outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
       outputRows_.resize(outputBatchSize_);
@@ -239,6 +248,14 @@ bool TopNRowNumber::abandonPartialEarly() const {
   return (100 * numOutput / numInput) >= abandonPartialMinPct_;
 }
 
+bool TopNRowNumber::isPartialFull() const {
+  if (table_ == nullptr || generateRowNumber_ || spiller_ != nullptr ||
+      maxPartialMemory_ == 0) {
+    return false;
+  }
+  return pool()->usedBytes() >= maxPartialMemory_;
+}
+
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
     new (lookup_->hits[index] + partitionOffset_)
@@ -290,7 +307,10 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->executor);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -399,6 +419,19 @@ RowVectorPtr TopNRowNumber::getOutput() {
     return nullptr;
   }
 
+  if (partialFull_) {
+    auto output = getOutputFromMemory();
+    if (output == nullptr) {
+      // All partitions were emitted and cleared.
+      partialFull_ = false;
+      partitionIt_.reset();
+      if (noMoreInput_) {
+        finished_ = true;
+      }
+    }
+    return output;
+  }
+
   if (!noMoreInput_) {
     return nullptr;
   }
@@ -657,7 +690,8 @@ void TopNRowNumber::reclaim(
     return;
   }
 
-  if (abandonedPartial_) {
+  if (abandonedPartial_ || partialFull_) {
+    // The rows are being emitted.
     return;
   }
 
@@ -48,6 +48,12 @@ class TopNRowNumber : public Operator {
       return false;
     }
 
+    if (partialFull_) {
+      // This operator is flushing its partitions and needs to produce output
+      // before receiving more input.
+      return false;
+    }
+
     return true;
   }
 
@@ -150,6 +156,10 @@ class TopNRowNumber : public Operator {
   // cardinality sufficiently. Returns false if spilling was triggered earlier.
   bool abandonPartialEarly() const;
 
+  // Returns true if this operator runs a 'partial' stage and uses more than
+  // 'maxPartialMemory_'. Returns false if spilling was triggered earlier.
+  bool isPartialFull() const;
+
   const int32_t limit_;
   const bool generateRowNumber_;
   const size_t numPartitionKeys_;
@@ -170,10 +180,17 @@ class TopNRowNumber : public Operator {
   const vector_size_t abandonPartialMinRows_;
   const int32_t abandonPartialMinPct_;
 
+  const uint64_t maxPartialMemory_;
+
   // True if this operator runs a 'partial' stage without sufficient reduction
   // in cardinality. In this case, it becomes a pass-through.
   bool abandonedPartial_{false};
 
+  // True if this operator runs a 'partial' stage and is emitting the rows of
+  // all partitions to free memory. Input is accepted again once all rows are
+  // emitted and the partitions are cleared.
+  bool partialFull_{false};
+
   // Hash table to keep track of partitions. Not used if there are no
   // partitioning keys. For each partition, stores an instance of TopRows
   // struct.
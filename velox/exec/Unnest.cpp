@@ -19,6 +19,21 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns true if slice() of 'vector' shares its buffers.
+bool canSlice(const BaseVector& vector) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::FLAT:
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+    case VectorEncoding::Simple::ROW:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
 Unnest::Unnest(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -111,32 +126,41 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
-
-  // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
-  vector_size_t numElements = 0;
-  for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
-
-    if (numElements >= maxOutputSize) {
-      break;
-    }
+  const auto maxOutputSize = adaptiveOutputBatchRows();
+
+  // Limit the number of output rows to 'maxOutputSize'. A row with more
+  // elements than fit in the batch continues in the next batch, so that a
+  // single row with millions of elements does not produce a giant batch.
+  RowRange range{nextInputRow_, 0, nextElement_, 0, 0};
+  for (auto row = nextInputRow_;
+       row < size && range.numElements < maxOutputSize;
+       ++row) {
+    const auto begin = row == nextInputRow_ ? nextElement_ : 0;
+    const auto numRowElements = std::min<vector_size_t>(
+        rawMaxSizes_[row] - begin, maxOutputSize - range.numElements);
+    ++range.size;
+    range.lastRowEnd = begin + numRowElements;
+    range.numElements += numRowElements;
   }
 
-  if (numElements == 0) {
+  if (range.numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastRowEnd < rawMaxSizes_[lastRow]) {
+    nextInputRow_ = lastRow;
+    nextElement_ = range.lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -146,111 +170,142 @@ RowVectorPtr Unnest::getOutput() {
   return output;
 }
 
+template <typename TFunc>
+void Unnest::forEachRow(const RowRange& range, TFunc func) const {
+  const auto end = range.start + range.size;
+  for (auto row = range.start; row < end; ++row) {
+    func(
+        row,
+        row == range.start ? range.firstRowBegin : 0,
+        row == end - 1 ? range.lastRowEnd : rawMaxSizes_[row]);
+  }
+}
+
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements,
+    const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  if (range.size == 1) {
+    // All output rows come from one input row.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          range.numElements,
+          range.start,
+          input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
-  auto repeatedIndices = allocateIndices(numElements, pool());
+  auto repeatedIndices = allocateIndices(range.numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  forEachRow(range, [&](auto row, auto begin, auto end) {
+    const auto numRowElements = end - begin;
+    std::fill_n(rawRepeatedIndices + index, numRowElements, row);
+    index += numRowElements;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
     outputs.at(projection.outputChannel) = BaseVector::wrapInDictionary(
         nullptr /*nulls*/,
         repeatedIndices,
-        numElements,
+        range.numElements,
         input_->childAt(projection.inputChannel));
   }
 }
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  BufferPtr elementIndices = allocateIndices(numElements, pool());
-  auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
-
-  auto nulls = allocateNulls(numElements, pool());
-  auto rawNulls = nulls->asMutable<uint64_t>();
-
+    const RowRange& range) {
   auto& currentDecoded = unnestDecoded_[channel];
   auto* currentSizes = rawSizes_[channel];
   auto* currentOffsets = rawOffsets_[channel];
   auto* currentIndices = rawIndices_[channel];
 
+  // The elements of the rows are output as a slice of the base vector if they
+  // follow each other in the base vector and no nulls are added.
+  const auto* base = currentDecoded.base();
+  bool contiguous = base->typeKind() == TypeKind::ARRAY
+      ? canSlice(*base->as<ArrayVector>()->elements())
+      : canSlice(*base->as<MapVector>()->mapKeys()) &&
+          canSlice(*base->as<MapVector>()->mapValues());
+  std::optional<vector_size_t> firstElement;
+  vector_size_t nextElement = 0;
+  forEachRow(range, [&](auto row, auto begin, auto end) {
+    if (!contiguous || begin == end) {
+      return;
+    }
+    if (currentDecoded.isNullAt(row) ||
+        end > currentSizes[currentIndices[row]]) {
+      contiguous = false;
+      return;
+    }
+    const auto offset = currentOffsets[currentIndices[row]];
+    if (firstElement.has_value() && offset + begin != nextElement) {
+      contiguous = false;
+      return;
+    }
+    if (!firstElement.has_value()) {
+      firstElement = offset + begin;
+    }
+    nextElement = offset + end;
+  });
+  if (contiguous) {
+    return {nullptr, nullptr, firstElement.value()};
+  }
+
+  BufferPtr elementIndices = allocateIndices(range.numElements, pool());
+  auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
+
+  auto nulls = allocateNulls(range.numElements, pool());
+  auto rawNulls = nulls->asMutable<uint64_t>();
+
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
-  bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-
+  forEachRow(range, [&](auto row, auto begin, auto end) {
+    auto nullBegin = begin;
     if (!currentDecoded.isNullAt(row)) {
       const auto offset = currentOffsets[currentIndices[row]];
       const auto unnestSize = currentSizes[currentIndices[row]];
-
-      if (index != offset || unnestSize < maxSize) {
-        identityMapping = false;
-      }
-
-      for (auto i = 0; i < unnestSize; i++) {
+      nullBegin = std::max(begin, std::min(end, unnestSize));
+      for (auto i = begin; i < nullBegin; ++i) {
         rawElementIndices[index++] = offset + i;
       }
-
-      for (auto i = unnestSize; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
-    } else if (maxSize > 0) {
-      identityMapping = false;
-
-      for (auto i = 0; i < maxSize; ++i) {
-        bits::setNull(rawNulls, index++, true);
-      }
     }
-  }
-  return {elementIndices, nulls, identityMapping};
+    for (auto i = nullBegin; i < end; ++i) {
+      bits::setNull(rawNulls, index++, true);
+    }
+  });
+  return {elementIndices, nulls};
 }
 
-VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  auto ordinalityVector =
-      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
+VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
+  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), range.numElements, pool());
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  forEachRow(range, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
-RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+RowVectorPtr Unnest::generateOutput(const RowRange& range) {
+  const auto numElements = range.numElements;
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +327,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range);
   }
 
   return std::make_shared<RowVector>(
@@ -282,8 +337,11 @@ RowVectorPtr Unnest::generateOutput(
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  if (indices == nullptr) {
+    if (offset == 0 && wrapSize == base->size()) {
+      return base;
+    }
+    return base->slice(offset, wrapSize);
   }
 
   const auto result =
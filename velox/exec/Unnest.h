@@ -39,28 +39,44 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
-  //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // The input rows of one output batch. All elements of the rows are in the
+  // batch except for the first row, which starts at 'firstRowBegin', and the
+  // last row, which ends at 'lastRowEnd'. A row with more elements than fit
+  // in one batch is split across batches.
+  struct RowRange {
+    // First input row.
+    vector_size_t start;
+    // Number of input rows.
+    vector_size_t size;
+    // Index of the first element of the first row to include.
+    vector_size_t firstRowBegin;
+    // Index past the last element of the last row to include.
+    vector_size_t lastRowEnd;
+    // Number of output rows.
+    vector_size_t numElements;
+  };
+
+  // Invokes 'func(row, begin, end)' for each input row in 'range' with the
+  // indices of the first and past the last element of the row to output.
+  // Elements past the size of an array or map are output as nulls.
+  template <typename TFunc>
+  void forEachRow(const RowRange& range, TFunc func) const;
+
+  // Generate output for the input rows and elements in 'range'.
+  RowVectorPtr generateOutput(const RowRange& range);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements,
+      const RowRange& range,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
+    // Null if the elements of all rows are a range of the base vector that
+    // starts at 'offset'. The output is then a zero-copy slice of the base.
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    vector_size_t offset{0};
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
@@ -69,15 +85,10 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+      const RowRange& range);
 
   // Invoked by generateOutput for the ordinality column.
-  VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+  VectorPtr generateOrdinalityVector(const RowRange& range);
 
   const bool withOrdinality_;
   std::vector<column_index_t> unnestChannels_;
@@ -93,5 +104,9 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // Index of the next element of 'nextInputRow_' to output. Non-zero if the
+  // row is split across output batches.
+  vector_size_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
@@ -52,6 +52,15 @@ namespace facebook::velox::exec {
   }()
 
 namespace {
+template <typename T>
+FOLLY_ALWAYS_INLINE uint64_t hashScalar(const T& value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return util::floating_point::NaNAwareHash<T>()(value);
+  } else {
+    return folly::hasher<T>()(value);
+  }
+}
+
 template <TypeKind Kind>
 uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   if constexpr (
@@ -62,10 +71,31 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   }
   // Inlined for scalars.
   using T = typename KindToFlatVector<Kind>::HashRowType;
-  if constexpr (std::is_floating_point_v<T>) {
-    return util::floating_point::NaNAwareHash<T>()(decoded.valueAt<T>(index));
-  } else {
-    return folly::hasher<T>()(decoded.valueAt<T>(index));
+  return hashScalar<T>(decoded.valueAt<T>(index));
+}
+
+// True if flat values of 'Kind' are a contiguous array of HashRowType.
+template <TypeKind Kind>
+constexpr bool isFixedWidthHashable() {
+  return TypeTraits<Kind>::isFixedWidth && Kind != TypeKind::BOOLEAN &&
+      Kind != TypeKind::UNKNOWN &&
+      std::is_same_v<
+             typename TypeTraits<Kind>::NativeType,
+             typename KindToFlatVector<Kind>::HashRowType>;
+}
+
+// Hashes a contiguous range of values without nulls. The loop has no
+// branches or indirections, so that the compiler can unroll and vectorize
+// the multiply-shift mixing over consecutive rows.
+template <typename T, bool mix>
+void hashFlatNoNulls(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t end,
+    uint64_t* result) {
+  for (auto row = begin; row < end; ++row) {
+    const auto hash = hashScalar<T>(values[row]);
+    result[row] = mix ? bits::hashMix(result[row], hash) : hash;
   }
 }
 } // namespace
@@ -83,21 +113,48 @@ void VectorHasher::hashValues(
     rows.applyToSelected([&](vector_size_t row) {
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
-  } else if (
-      !decoded_.isIdentityMapping() &&
-      rows.countSelected() > decoded_.base()->size()) {
-    cachedHashes_.resize(decoded_.base()->size());
-    std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+    return;
+  }
+  if constexpr (isFixedWidthHashable<Kind>()) {
+    if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      // Flat fixed width column without nulls. This is the common case for
+      // join, group by and partitioning keys.
+      const auto* values = decoded_.data<T>();
+      if (mix) {
+        hashFlatNoNulls<T, true>(values, rows.begin(), rows.end(), result);
+      } else {
+        hashFlatNoNulls<T, false>(values, rows.begin(), rows.end(), result);
+      }
+      return;
+    }
+  }
+  hashDecodedValues<Kind>(rows, mix, result);
+}
+
+template <TypeKind Kind>
+void VectorHasher::hashDecodedValues(
+    const SelectivityVector& rows,
+    bool mix,
+    uint64_t* result) {
+  if (auto* hashes = dictionaryHashes(); hashes != nullptr ||
+      (!decoded_.isIdentityMapping() &&
+       rows.countSelected() > decoded_.base()->size())) {
+    if (hashes == nullptr) {
+      hashes = &cachedHashes_;
+      cachedHashes_.resize(decoded_.base()->size());
+      std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
         return;
       }
       auto baseIndex = decoded_.index(row);
-      uint64_t hash = cachedHashes_[baseIndex];
+      uint64_t hash = (*hashes)[baseIndex];
       if (hash == kNullHash) {
         hash = hashOne<Kind>(decoded_, row);
-        cachedHashes_[baseIndex] = hash;
+        (*hashes)[baseIndex] = hash;
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
@@ -113,6 +170,37 @@ void VectorHasher::hashValues(
   }
 }
 
+void VectorHasher::trackDictionary(const BaseVector& vector) {
+  if (vector.encoding() != VectorEncoding::Simple::DICTIONARY ||
+      vector.valueVector().get() != decoded_.base()) {
+    return;
+  }
+  const auto& base = vector.valueVector();
+  if (lastDictionaryBase_.lock() == base) {
+    if (!keepDictionaryHashes_) {
+      keepDictionaryHashes_ = true;
+      dictionaryHashes_.resize(base->size());
+      std::fill(dictionaryHashes_.begin(), dictionaryHashes_.end(), kNullHash);
+    }
+    return;
+  }
+  lastDictionaryBase_ = base;
+  keepDictionaryHashes_ = false;
+}
+
+raw_vector<uint64_t>* VectorHasher::dictionaryHashes() {
+  if (!keepDictionaryHashes_ || decoded_.isIdentityMapping() ||
+      decoded_.isConstantMapping()) {
+    return nullptr;
+  }
+  const auto base = lastDictionaryBase_.lock();
+  if (base.get() != decoded_.base() ||
+      base->size() != dictionaryHashes_.size()) {
+    return nullptr;
+  }
+  return &dictionaryHashes_;
+}
+
 template <TypeKind Kind>
 bool VectorHasher::makeValueIds(
     const SelectivityVector& rows,
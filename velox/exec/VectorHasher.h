@@ -171,6 +171,7 @@ class VectorHasher {
         type_->toString(),
         vector.type()->toString());
     decoded_.decode(vector, rows);
+    trackDictionary(vector);
   }
 
   DecodedVector& decodedVector() {
@@ -240,6 +241,11 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if there are too many distinct values to keep track of them.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
@@ -543,6 +549,23 @@ class VectorHasher {
   template <TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Hashes 'rows' of 'decoded_' one row at a time, reusing dictionary hashes
+  // where available. Used for all encodings except flat fixed width columns
+  // without nulls.
+  template <TypeKind Kind>
+  void
+  hashDecodedValues(const SelectivityVector& rows, bool mix, uint64_t* result);
+
+  // Notes the base of 'vector' if it is a dictionary over the base that was
+  // just decoded. If the same base is seen in consecutive batches, e.g. the
+  // dictionary of a stripe returned by a string dictionary reader, the hashes
+  // of its entries are kept across batches in 'dictionaryHashes_'.
+  void trackDictionary(const BaseVector& vector);
+
+  // Returns 'dictionaryHashes_' if they are kept for the base of 'decoded_',
+  // nullptr otherwise.
+  raw_vector<uint64_t>* dictionaryHashes();
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -550,6 +573,16 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // Base of the last decoded dictionary. Not owned, so that the hasher does
+  // not keep the vector alive.
+  std::weak_ptr<const BaseVector> lastDictionaryBase_;
+
+  // True if 'lastDictionaryBase_' was seen in more than one batch, in which
+  // case 'dictionaryHashes_' has an entry for each of its values. Unset
+  // entries are kNullHash.
+  bool keepDictionaryHashes_{false};
+  raw_vector<uint64_t> dictionaryHashes_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
@@ -45,7 +45,12 @@ Window::Window(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        &spillStats_,
+        driverCtx->prefixSortConfig());
   }
 }
 
@@ -54,6 +59,7 @@ void Window::initialize() {
   VELOX_CHECK_NOT_NULL(windowNode_);
   createWindowFunctions();
   createPeerAndFrameBuffers();
+  setupStreamingPartitions();
   windowNode_.reset();
 }
 
@@ -237,6 +243,83 @@ void Window::createPeerAndFrameBuffers() {
   }
 }
 
+void Window::setupStreamingPartitions() {
+  VELOX_CHECK_NOT_NULL(windowNode_);
+  // Streaming partitions are only produced by the sort based WindowBuild.
+  // Without sort keys all the rows of a partition are peers.
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (!spillConfig_.has_value() || !queryConfig.windowSpillStreamPartitions() ||
+      windowNode_->inputsSorted() || windowNode_->sortingKeys().empty()) {
+    return;
+  }
+
+  int64_t followingRows = 0;
+  int64_t precedingRows = 0;
+  for (auto i = 0; i < windowFunctions_.size(); ++i) {
+    const auto access = windowFunctions_[i]->rowsAccess();
+    if (!access.has_value()) {
+      return;
+    }
+    followingRows = std::max(followingRows, access->following);
+    precedingRows = std::max(precedingRows, access->preceding);
+    if (!access->readsFrames) {
+      continue;
+    }
+
+    // The bounds of k RANGE frames are searched over the whole partition and
+    // offsets in columns can reach any row.
+    const auto& frame = windowFrames_[i];
+    const bool hasColumnOffset =
+        (frame.start.has_value() && !frame.start->constant.has_value()) ||
+        (frame.end.has_value() && !frame.end->constant.has_value());
+    if (hasColumnOffset ||
+        (frame.type == core::WindowNode::WindowType::kRange &&
+         (frame.start.has_value() || frame.end.has_value()))) {
+      return;
+    }
+
+    // Frames that end at CURRENT ROW of a RANGE frame end at the end of the
+    // peer group, which is complete for the rows being processed.
+    int64_t endPrecedingRows = 0;
+    switch (frame.endType) {
+      case core::WindowNode::BoundType::kFollowing:
+        followingRows = std::max(followingRows, frame.end->constant.value());
+        break;
+      case core::WindowNode::BoundType::kPreceding:
+        endPrecedingRows = frame.end->constant.value();
+        break;
+      case core::WindowNode::BoundType::kCurrentRow:
+        break;
+      default:
+        return;
+    }
+
+    switch (frame.startType) {
+      case core::WindowNode::BoundType::kUnboundedPreceding:
+        if (!access->incrementalFrames) {
+          return;
+        }
+        // Only the rows past the end of the frame of the previous row are
+        // read.
+        precedingRows = std::max(precedingRows, endPrecedingRows);
+        break;
+      case core::WindowNode::BoundType::kPreceding:
+        precedingRows = std::max(precedingRows, frame.start->constant.value());
+        break;
+      case core::WindowNode::BoundType::kCurrentRow:
+      case core::WindowNode::BoundType::kFollowing:
+        break;
+      default:
+        return;
+    }
+  }
+
+  streamingPartitions_ = true;
+  streamingFollowingRows_ = followingRows;
+  streamingPrecedingRows_ = precedingRows;
+  windowBuild_->enableStreamingPartitions();
+}
+
 void Window::noMoreInput() {
   Operator::noMoreInput();
   windowBuild_->noMoreInput();
@@ -249,6 +332,9 @@ void Window::callResetPartition() {
   currentPartition_ = nullptr;
   if (windowBuild_->hasNextPartition()) {
     currentPartition_ = windowBuild_->nextPartition();
+    if (currentPartition_->isStreaming()) {
+      addRuntimeStat("numStreamedPartitions", RuntimeCounter(1));
+    }
     for (int i = 0; i < windowFunctions_.size(); i++) {
       windowFunctions_[i]->resetPartition(currentPartition_.get());
     }
@@ -563,6 +649,36 @@ void Window::callApplyForPartitionRows(
   partitionOffset_ += numRows;
 }
 
+void Window::loadStreamingPartitionRows(vector_size_t numRows) {
+  while (!currentPartition_->isComplete() &&
+         numRowsForProcessing() < partitionOffset_ + numRows) {
+    windowBuild_->loadPartitionRows(*currentPartition_, numRowsPerOutput_);
+  }
+}
+
+vector_size_t Window::numRowsForProcessing() const {
+  if (currentPartition_->isComplete()) {
+    return currentPartition_->numRows();
+  }
+  // The rows of the last peer group and the rows whose following rows are not
+  // all loaded wait for more rows.
+  return std::max<int64_t>(
+      0,
+      std::min<int64_t>(
+          currentPartition_->lastPeerGroupStart(),
+          currentPartition_->numRows() - streamingFollowingRows_));
+}
+
+void Window::removeProcessedPartitionRows() {
+  // The peer group and the RANGE frames of the next row can start at the peer
+  // group of the last processed row.
+  const auto firstRow = std::min<int64_t>(
+      peerStartRow_, partitionOffset_ - streamingPrecedingRows_);
+  if (firstRow > 0) {
+    currentPartition_->removeRows(firstRow);
+  }
+}
+
 vector_size_t Window::callApplyLoop(
     vector_size_t numOutputRows,
     const RowVectorPtr& result) {
@@ -574,9 +690,12 @@ vector_size_t Window::callApplyLoop(
   // This function requires that the currentPartition_ is available for output.
   VELOX_DCHECK_NOT_NULL(currentPartition_);
   while (numOutputRowsLeft > 0) {
-    auto rowsForCurrentPartition =
-        currentPartition_->numRows() - partitionOffset_;
-    if (rowsForCurrentPartition <= numOutputRowsLeft) {
+    if (currentPartition_->isStreaming()) {
+      loadStreamingPartitionRows(numOutputRowsLeft);
+    }
+    auto rowsForCurrentPartition = numRowsForProcessing() - partitionOffset_;
+    if (rowsForCurrentPartition <= numOutputRowsLeft &&
+        currentPartition_->isComplete()) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
       callApplyForPartitionRows(
@@ -601,6 +720,9 @@ vector_size_t Window::callApplyLoop(
           partitionOffset_ + numOutputRowsLeft,
           resultIndex,
           result);
+      if (currentPartition_->isStreaming()) {
+        removeProcessedPartitionRows();
+      }
       numOutputRowsLeft = 0;
       break;
     }
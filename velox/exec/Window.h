@@ -101,6 +101,23 @@ class Window : public Operator {
   // indices to send in window function apply invocations.
   void createPeerAndFrameBuffers();
 
+  // Enables streaming of the partitions restored from spill if all the
+  // functions read rows of bounded frames. Sets the number of rows that need
+  // to be loaded after and kept before the rows being processed.
+  void setupStreamingPartitions();
+
+  // Loads rows of the current streaming partition until 'numRows' rows from
+  // 'partitionOffset_' can be processed or all its rows are loaded.
+  void loadStreamingPartitionRows(vector_size_t numRows);
+
+  // Returns the number of rows from the start of the current partition that
+  // can be processed with the rows loaded so far.
+  vector_size_t numRowsForProcessing() const;
+
+  // Removes the rows of the current streaming partition that are not read
+  // anymore by the processing of the rows from 'partitionOffset_' on.
+  void removeProcessedPartitionRows();
+
   // Compute the peer and frame buffers for rows between
   // startRow and endRow in the current partition.
   void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
@@ -229,6 +246,15 @@ class Window : public Operator {
   // computePeerBuffers they are saved here.
   vector_size_t peerStartRow_ = 0;
   vector_size_t peerEndRow_ = 0;
+
+  // True if partitions restored from spill are streamed through the
+  // functions.
+  bool streamingPartitions_{false};
+
+  // Rows of a streaming partition that must be loaded after a row to process it
+  // and that are kept before the next row to process.
+  int64_t streamingFollowingRows_{0};
+  int64_t streamingPrecedingRows_{0};
 };
 
 } // namespace facebook::velox::exec
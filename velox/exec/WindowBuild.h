@@ -70,6 +70,22 @@ class WindowBuild {
   // if called when no partition is available.
   virtual std::unique_ptr<WindowPartition> nextPartition() = 0;
 
+  // Makes nextPartition() return streaming partitions for the partitions
+  // restored from spill. The rows of such a partition are added by
+  // loadPartitionRows() as the Window operator processes them. Must be called
+  // before noMoreInput(). Ignored by WindowBuilds that do not spill.
+  void enableStreamingPartitions() {
+    streamingPartitions_ = true;
+  }
+
+  // Adds up to 'numRows' rows to the streaming 'partition' returned by
+  // nextPartition() and marks it complete after its last row.
+  virtual void loadPartitionRows(
+      WindowPartition& /*partition*/,
+      vector_size_t /*numRows*/) {
+    VELOX_UNREACHABLE();
+  }
+
   // Returns the average size of input rows in bytes stored in the
   // data container of the WindowBuild.
   std::optional<int64_t> estimateRowSize() {
@@ -113,6 +129,10 @@ class WindowBuild {
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
+
+  // True if partitions restored from spill are returned as streaming
+  // partitions.
+  bool streamingPartitions_{false};
 };
 
 } // namespace facebook::velox::exec
@@ -101,6 +101,32 @@ class WindowFunction {
       vector_size_t resultOffset,
       const VectorPtr& result) = 0;
 
+  /// Describes the rows of a partition a function reads to compute the results
+  /// of a block of rows. The Window operator uses it to stream the rows of a
+  /// partition through the functions instead of materializing the partition.
+  struct RowsAccess {
+    /// True if the function reads the rows of the frames of the rows. Ranking
+    /// functions that only use the peer groups do not.
+    bool readsFrames{false};
+
+    /// True if, for frames that start at the first row of the partition, the
+    /// function reads only the rows past the end of the frame of the previous
+    /// row, e.g. aggregates that are computed incrementally.
+    bool incrementalFrames{false};
+
+    /// Number of rows before and after each row the function reads in
+    /// addition to its frame, e.g. for lag and lead with a constant offset.
+    int64_t preceding{0};
+    int64_t following{0};
+  };
+
+  /// Returns the rows the function reads or std::nullopt if the function may
+  /// read any row of the partition or depends on its number of rows, e.g.
+  /// ntile or percent_rank.
+  virtual std::optional<RowsAccess> rowsAccess() const {
+    return std::nullopt;
+  }
+
   static std::unique_ptr<WindowFunction> create(
       const std::string& name,
       const std::vector<WindowFunctionArg>& args,
@@ -31,11 +31,103 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : WindowPartition(data, folly::Range<char**>(), inputMapping, sortKeyInfo) {
+  streaming_ = true;
+  complete_ = false;
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(streaming_);
+  VELOX_CHECK(!complete_);
+  for (auto* row : rows) {
+    // Rows are sorted, so a row that is not a peer of the previous row sorts
+    // after it.
+    if (!rows_.empty() && compareRowsWithSortKeys(rows_.back(), row)) {
+      lastPeerGroupStart_ = startRow_ + rows_.size();
+    }
+    rows_.push_back(row);
+  }
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void WindowPartition::removeRows(vector_size_t row) {
+  VELOX_CHECK(streaming_);
+  if (row <= startRow_ || rows_.empty()) {
+    return;
+  }
+  const vector_size_t numRemoved =
+      std::min<vector_size_t>(row - startRow_, rows_.size() - 1);
+  data_->eraseRows(folly::Range(rows_.data(), numRemoved));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemoved);
+  startRow_ += numRemoved;
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  // The rows from 'gatherBegin' to the start of the next long enough run of
+  // consecutive row numbers are gathered row by row. The runs are copied from
+  // consecutive row pointers. 'result' grows with each copy.
+  const vector_size_t numRows = rowNumbers.size();
+  vector_size_t gatherBegin = 0;
+  vector_size_t runBegin = 0;
+  while (runBegin < numRows) {
+    auto runEnd = runBegin + 1;
+    if (rowNumbers[runBegin] >= 0) {
+      while (runEnd < numRows &&
+             rowNumbers[runEnd] == rowNumbers[runEnd - 1] + 1) {
+        ++runEnd;
+      }
+    }
+    if (runEnd - runBegin >= kMinRangeExtractRows) {
+      if (gatherBegin < runBegin) {
+        gatherColumn(
+            columnIndex,
+            rowNumbers.subpiece(gatherBegin, runBegin - gatherBegin),
+            resultOffset + gatherBegin,
+            result);
+      }
+      extractColumn(
+          columnIndex,
+          rowNumbers[runBegin],
+          runEnd - runBegin,
+          resultOffset + runBegin,
+          result);
+      gatherBegin = runEnd;
+    }
+    runBegin = runEnd;
+  }
+  if (gatherBegin < numRows || numRows == 0) {
+    gatherColumn(
+        columnIndex,
+        rowNumbers.subpiece(gatherBegin),
+        resultOffset + gatherBegin,
+        result);
+  }
+}
+
+void WindowPartition::gatherColumn(
+    int32_t columnIndex,
+    folly::Range<const vector_size_t*> rowNumbers,
+    vector_size_t resultOffset,
+    const VectorPtr& result) const {
+  if (startRow_ > 0) {
+    // Negative row numbers are for nulls and stay as is.
+    rowNumbers_.resize(rowNumbers.size());
+    for (auto i = 0; i < rowNumbers.size(); ++i) {
+      const auto row = rowNumbers[i];
+      VELOX_DCHECK(row < 0 || row >= startRow_);
+      rowNumbers_[i] = row < 0 ? row : row - startRow_;
+    }
+    rowNumbers = folly::Range(rowNumbers_.data(), rowNumbers_.size());
+  }
   RowContainer::extractColumn(
       partition_.data(),
       rowNumbers,
@@ -50,8 +142,9 @@ void WindowPartition::extractColumn(
     vector_size_t numRows,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  VELOX_DCHECK_GE(partitionOffset, startRow_);
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -63,8 +156,9 @@ void WindowPartition::extractNulls(
     vector_size_t partitionOffset,
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
+  VELOX_DCHECK_GE(partitionOffset, startRow_);
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -162,7 +256,7 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
       peerStart = i;
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(rowAt(peerStart), rowAt(peerEnd))) {
           break;
         }
         peerEnd++;
@@ -192,13 +286,13 @@ vector_size_t WindowPartition::searchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   vector_size_t begin = start;
   vector_size_t finish = end;
   while (finish - begin >= 2) {
     auto mid = (begin + finish) / 2;
     auto compareResult = data_->compare(
-        partition_[mid], current, orderByColumn, frameColumn, flags);
+        rowAt(mid), current, orderByColumn, frameColumn, flags);
 
     if (compareResult >= 0) {
       // Search in the first half of the column.
@@ -221,10 +315,10 @@ vector_size_t WindowPartition::linearSearchFrameValue(
     column_index_t orderByColumn,
     column_index_t frameColumn,
     const CompareFlags& flags) const {
-  auto current = partition_[currentRow];
+  auto current = rowAt(currentRow);
   for (vector_size_t i = start; i < end; ++i) {
     auto compareResult = data_->compare(
-        partition_[i], current, orderByColumn, frameColumn, flags);
+        rowAt(i), current, orderByColumn, frameColumn, flags);
 
     // The bound value was found. Return if firstMatch required.
     // If the last match is required, then we need to find the first row that
@@ -270,7 +364,7 @@ void WindowPartition::updateKRangeFrameBounds(
   for (auto i = 0; i < numRows; i++) {
     auto currentRow = startRow + i;
     bool frameIsNull = RowContainer::isNullAt(
-        partition_[currentRow],
+        rowAt(currentRow),
         frameRowColumn.nullByte(),
         frameRowColumn.nullMask());
 
@@ -287,7 +381,7 @@ void WindowPartition::updateKRangeFrameBounds(
         end = currentRow + 1;
       } else {
         start = currentRow;
-        end = partition_.size();
+        end = numRows();
       }
       rawFrameBounds[i] = searchFrameValue(
           firstMatch,
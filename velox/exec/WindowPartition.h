@@ -42,14 +42,71 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Creates a streaming WindowPartition whose rows are added by addRows() as
+  /// they are loaded, e.g. from spilled data, and removed by removeRows() once
+  /// they are not needed anymore. Row numbers are positions from the start of
+  /// the partition also after rows are removed. The rows are freed in 'data'
+  /// when removed.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a
+  /// streaming partition, this is the number of rows added so far, including
+  /// the removed ones.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
+  }
+
+  bool isStreaming() const {
+    return streaming_;
+  }
+
+  /// Returns true if all the rows of the partition have been added. Always
+  /// true for a partition that is not streaming.
+  bool isComplete() const {
+    return complete_;
+  }
+
+  /// Marks a streaming partition as having all its rows added.
+  void setComplete() {
+    VELOX_CHECK(streaming_);
+    complete_ = true;
+  }
+
+  /// Appends 'rows' to a streaming partition. The rows must be in the order of
+  /// the sort keys.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Removes the rows before 'row' from a streaming partition. The last added
+  /// row is never removed, so that the WindowBuild can compare the next rows
+  /// with it.
+  void removeRows(vector_size_t row);
+
+  /// Returns the position of the first row not removed.
+  vector_size_t firstRow() const {
+    return startRow_;
+  }
+
+  /// Returns the last added row or nullptr if there is none.
+  const char* lastRow() const {
+    return partition_.empty() ? nullptr : partition_.back();
+  }
+
+  /// Returns the position of the first row of the peer group of the last
+  /// added row. The peer groups of the rows before it are complete.
+  vector_size_t lastPeerGroupStart() const {
+    return lastPeerGroupStart_;
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
-  /// array from the partition input data.
+  /// array from the partition input data. Negative row numbers set the
+  /// corresponding rows of 'result' to null. Runs of consecutive row numbers,
+  /// e.g. frame bounds at a constant offset from the current row, are copied
+  /// with one range extraction each.
   void extractColumn(
       int32_t columnIndex,
       folly::Range<const vector_size_t*> rowNumbers,
@@ -128,8 +185,24 @@ class WindowPartition {
       vector_size_t* rawFrameBounds) const;
 
  private:
+  // Runs of consecutive row numbers shorter than this are copied row by row.
+  static constexpr vector_size_t kMinRangeExtractRows = 16;
+
   bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
 
+  // Copies the values at 'columnIndex' for each of 'rowNumbers' row by row.
+  void gatherColumn(
+      int32_t columnIndex,
+      folly::Range<const vector_size_t*> rowNumbers,
+      vector_size_t resultOffset,
+      const VectorPtr& result) const;
+
+  // Returns the row at position 'row' from the start of the partition.
+  char* rowAt(vector_size_t row) const {
+    VELOX_DCHECK_GE(row, startRow_);
+    return partition_[row - startRow_];
+  }
+
   // Searches for 'currentRow[frameColumn]' in 'orderByColumn' of rows between
   // 'start' and 'end' in the partition. 'firstMatch' specifies if first or last
   // row is matched.
@@ -189,5 +262,22 @@ class WindowPartition {
   // corresponding indexes of their input arguments into this vector.
   // They will request for column vector values at the respective index.
   std::vector<exec::RowColumn> columns_;
+
+  // True if the rows are added and removed as they are processed.
+  bool streaming_{false};
+
+  bool complete_{true};
+
+  // Rows of a streaming partition from 'startRow_' on. 'partition_' is a range
+  // over these.
+  std::vector<char*> rows_;
+
+  // Position of the first row in 'partition_' from the start of the partition.
+  vector_size_t startRow_{0};
+
+  vector_size_t lastPeerGroupStart_{0};
+
+  // Reusable row numbers translated to positions in 'partition_'.
+  mutable std::vector<vector_size_t> rowNumbers_;
 };
 } // namespace facebook::velox::exec
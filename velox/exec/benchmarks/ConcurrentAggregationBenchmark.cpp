@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/HashAggregation.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(num_repeat, 4, "Number of repeats of each aggregation query");
+DEFINE_int32(num_batches, 20, "Number of 10k row batches read by each driver");
+
+/// Benchmarks a final aggregation over many Drivers with a hash table per
+/// Driver behind a local exchange against one hash table shared by the
+/// Drivers. See QueryConfig::kConcurrentAggregationEnabled. Each Driver
+/// aggregates a copy of the same input, grouped by a key with few or many
+/// distinct values. A final single Driver counts the groups.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+struct Counters {
+  int64_t rows{0};
+  int64_t usec{0};
+  int64_t lockConflicts{0};
+
+  std::string toString() const {
+    if (usec == 0) {
+      return "N/A";
+    }
+    return fmt::format(
+        "{} rows/s lockConflicts={}",
+        static_cast<int64_t>(rows / (usec / 1.0e6)),
+        lockConflicts);
+  }
+};
+
+class ConcurrentAggregationBenchmark : public VectorTestBase {
+ public:
+  std::vector<RowVectorPtr> makeRows(int32_t numGroups) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < FLAGS_num_batches; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              kBatchSize,
+              [&](auto row) { return (i * kBatchSize + row) % numGroups; }),
+          makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; }),
+          makeFlatVector<double>(
+              kBatchSize, [](auto row) { return row * 0.1; }),
+      }));
+    }
+    return vectors;
+  }
+
+  /// Aggregates 'vectors' in each of 'numDrivers' Drivers, either with a
+  /// local exchange on the grouping key or with a shared hash table.
+  void run(
+      const std::vector<RowVectorPtr>& vectors,
+      int32_t numGroups,
+      int32_t numDrivers,
+      bool shared,
+      Counters& counters) {
+    VELOX_CHECK(!vectors.empty());
+    const std::vector<std::string> aggregates = {
+        "sum(c1)", "count(1)", "max(c2)"};
+    core::PlanNodeId aggregationId;
+    exec::test::PlanBuilder builder;
+    builder.values(vectors, true);
+    if (!shared) {
+      builder.localPartition({"c0"});
+    }
+    auto plan = builder.singleAggregation({"c0"}, aggregates)
+                    .capturePlanNodeId(aggregationId)
+                    .localPartition(std::vector<std::string>{})
+                    .singleAggregation({}, {"count(1)"})
+                    .planNode();
+    const int64_t expectedGroups = std::min(numGroups, numRows(vectors));
+    auto expected = makeRowVector({makeFlatVector<int64_t>(
+        1, [&](auto /*row*/) { return expectedGroups; })});
+
+    for (auto repeat = 0; repeat < FLAGS_num_repeat; ++repeat) {
+      const auto startMicros = getCurrentTimeMicro();
+      auto task = exec::test::AssertQueryBuilder(plan)
+                      .config(
+                          core::QueryConfig::kConcurrentAggregationEnabled,
+                          shared ? "true" : "false")
+                      .maxDrivers(numDrivers)
+                      .assertResults(expected);
+      counters.usec += getCurrentTimeMicro() - startMicros;
+      counters.rows += numRows(vectors) * numDrivers;
+
+      auto runtimeStats =
+          toPlanStats(task->taskStats()).at(aggregationId).customStats;
+      counters.lockConflicts +=
+          runtimeStats[HashAggregation::kSharedTableLockConflicts].sum;
+    }
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 10'000;
+
+  static int32_t numRows(const std::vector<RowVectorPtr>& vectors) {
+    return vectors.size() * kBatchSize;
+  }
+};
+
+std::unique_ptr<ConcurrentAggregationBenchmark> bm;
+
+void runBenchmarks() {
+  const std::vector<int32_t> numGroups = {1'000, 1'000'000};
+  const std::vector<int32_t> numDrivers = {1, 2, 4, 8, 16, 32, 64};
+  std::vector<std::vector<RowVectorPtr>> inputs;
+  for (auto groups : numGroups) {
+    inputs.push_back(bm->makeRows(groups));
+  }
+
+  // Counters per number of groups, number of Drivers and mode.
+  std::vector<Counters> counters(numGroups.size() * numDrivers.size() * 2);
+  for (auto i = 0; i < numGroups.size(); ++i) {
+    for (auto j = 0; j < numDrivers.size(); ++j) {
+      for (const auto shared : {false, true}) {
+        const auto index = (i * numDrivers.size() + j) * 2 + shared;
+        folly::addBenchmark(
+            __FILE__,
+            fmt::format(
+                "{}_{}groups_{}",
+                shared ? "shared" : "exchange",
+                numGroups[i],
+                numDrivers[j]),
+            [&, i, j, shared, index]() {
+              bm->run(
+                  inputs[i],
+                  numGroups[i],
+                  numDrivers[j],
+                  shared,
+                  counters[index]);
+              return 1;
+            });
+      }
+    }
+  }
+
+  folly::runBenchmarks();
+  for (auto i = 0; i < numGroups.size(); ++i) {
+    for (auto j = 0; j < numDrivers.size(); ++j) {
+      for (const auto shared : {false, true}) {
+        const auto index = (i * numDrivers.size() + j) * 2 + shared;
+        std::cout << (shared ? "shared " : "exchange ") << numGroups[i]
+                  << " groups x " << numDrivers[j] << ": "
+                  << counters[index].toString() << std::endl;
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  bm = std::make_unique<ConcurrentAggregationBenchmark>();
+  runBenchmarks();
+  bm.reset();
+
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include "velox/core/QueryConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -105,25 +106,42 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  /// Shuffles 'vectors' from 'width' leaf tasks to 'numPartitions' consumer
+  /// tasks, 'width' if 0. If 'compactRow' is true, the shuffle is in the
+  /// CompactRow format. If 'vectorPages' is true, the tasks exchange
+  /// in-process pages through InProcessExchangeSource without serializing.
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      int32_t numPartitions = 0,
+      bool compactRow = false,
+      bool vectorPages = false) {
     assert(!vectors.empty());
+    if (numPartitions == 0) {
+      numPartitions = width;
+    }
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_[core::QueryConfig::kExchangeCompactRow] =
+        compactRow ? "true" : "false";
+    configSettings_[core::QueryConfig::kExchangeVectorPages] =
+        vectorPages ? "true" : "false";
+    const std::string taskIdPrefix =
+        vectorPages ? InProcessExchangeSource::kTaskIdPrefix : "local://";
     auto iteration = ++iteration_;
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
                         .values(vectors, true)
-                        .partitionedOutput({"c0"}, width)
+                        .partitionedOutput({"c0"}, numPartitions)
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
     for (int32_t counter = 0; counter < width; ++counter) {
-      auto leafTaskId = makeTaskId(iteration, "leaf", counter);
+      auto leafTaskId =
+          makeTaskId(taskIdPrefix, iteration, "leaf", counter);
       leafTaskIds.push_back(leafTaskId);
       auto leafTask = makeTask(leafTaskId, leafPlan, counter);
       tasks.push_back(leafTask);
@@ -139,8 +157,8 @@ class ExchangeBenchmark : public VectorTestBase {
                        .planNode();
 
     std::vector<exec::Split> finalAggSplits;
-    for (int i = 0; i < width; i++) {
-      auto taskId = makeTaskId(iteration, "final-agg", i);
+    for (int i = 0; i < numPartitions; i++) {
+      auto taskId = makeTaskId(taskIdPrefix, iteration, "final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
       auto task = makeTask(taskId, finalAggPlan, i);
@@ -161,6 +179,7 @@ class ExchangeBenchmark : public VectorTestBase {
 
     exec::test::AssertQueryBuilder(plan)
         .splits(finalAggSplits)
+        .configs(configSettings_)
         .assertResults(expected);
     auto elapsed = getCurrentTimeMicro() - startMicros;
     int64_t bytes = 0;
@@ -277,9 +296,12 @@ class ExchangeBenchmark : public VectorTestBase {
  private:
   static constexpr int64_t kMaxMemory = 6UL << 30; // 6GB
 
-  static std::string
-  makeTaskId(int32_t iteration, const std::string& prefix, int num) {
-    return fmt::format("local://{}-{}-{}", iteration, prefix, num);
+  static std::string makeTaskId(
+      const std::string& scheme,
+      int32_t iteration,
+      const std::string& prefix,
+      int num) {
+    return fmt::format("{}{}-{}-{}", scheme, iteration, prefix, num);
   }
 
   std::shared_ptr<Task> makeTask(
@@ -353,10 +375,16 @@ void runBenchmarks() {
 
   Counters flat10kCounters;
   Counters deep10kCounters;
+  Counters flat10kInProcessCounters;
+  Counters deep10kInProcessCounters;
   Counters flat50Counters;
   Counters deep50Counters;
   Counters localFlat10kCounters;
   Counters struct1kCounters;
+  Counters wide256Counters;
+  Counters wide256CompactCounters;
+  Counters wide1024Counters;
+  Counters wide1024CompactCounters;
 
   std::vector<std::string> flatNames = {"c0"};
   std::vector<TypePtr> flatTypes = {BIGINT()};
@@ -422,6 +450,18 @@ void runBenchmarks() {
     return 1;
   });
 
+  folly::addBenchmark(__FILE__, "exchangeFlat10kInProcess", [&]() {
+    bm->run(
+        flat10k,
+        FLAGS_width,
+        FLAGS_task_width,
+        flat10kInProcessCounters,
+        0,
+        false,
+        true);
+    return 1;
+  });
+
   folly::addBenchmark(__FILE__, "exchangeFlat50", [&]() {
     bm->run(flat50, FLAGS_width, FLAGS_task_width, flat50Counters);
     return 1;
@@ -432,6 +472,18 @@ void runBenchmarks() {
     return 1;
   });
 
+  folly::addBenchmark(__FILE__, "exchangeDeep10kInProcess", [&]() {
+    bm->run(
+        deep10k,
+        FLAGS_width,
+        FLAGS_task_width,
+        deep10kInProcessCounters,
+        0,
+        false,
+        true);
+    return 1;
+  });
+
   folly::addBenchmark(__FILE__, "exchangeDeep50", [&]() {
     bm->run(deep50, FLAGS_width, FLAGS_task_width, deep50Counters);
     return 1;
@@ -442,6 +494,28 @@ void runBenchmarks() {
     return 1;
   });
 
+  // Hash partitioning to many destinations with few rows per destination in
+  // each batch, columnar vs. CompactRow.
+  folly::addBenchmark(__FILE__, "exchangeFlat10kWide256", [&]() {
+    bm->run(flat10k, FLAGS_width, 1, wide256Counters, 256);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "exchangeFlat10kWide256CompactRow", [&]() {
+    bm->run(flat10k, FLAGS_width, 1, wide256CompactCounters, 256, true);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "exchangeFlat10kWide1024", [&]() {
+    bm->run(flat10k, FLAGS_width, 1, wide1024Counters, 1024);
+    return 1;
+  });
+
+  folly::addBenchmark(__FILE__, "exchangeFlat10kWide1024CompactRow", [&]() {
+    bm->run(flat10k, FLAGS_width, 1, wide1024CompactCounters, 1024, true);
+    return 1;
+  });
+
   folly::addBenchmark(__FILE__, "localFlat10k", [&]() {
     bm->runLocal(
         flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
@@ -450,10 +524,20 @@ void runBenchmarks() {
 
   folly::runBenchmarks();
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
+            << "flat10k in-process: " << flat10kInProcessCounters.toString()
+            << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
+            << "deep10k in-process: " << deep10kInProcessCounters.toString()
+            << std::endl
             << "deep50: " << deep50Counters.toString() << std::endl
-            << "struct1k: " << struct1kCounters.toString() << std::endl;
+            << "struct1k: " << struct1kCounters.toString() << std::endl
+            << "wide256: " << wide256Counters.toString() << std::endl
+            << "wide256 CompactRow: " << wide256CompactCounters.toString()
+            << std::endl
+            << "wide1024: " << wide1024Counters.toString() << std::endl
+            << "wide1024 CompactRow: " << wide1024CompactCounters.toString()
+            << std::endl;
 }
 
 } // namespace
@@ -466,6 +550,8 @@ int main(int argc, char** argv) {
   parse::registerTypeResolver();
   serializer::presto::PrestoVectorSerde::registerVectorSerde();
   exec::ExchangeSource::registerFactory(exec::test::createLocalExchangeSource);
+  exec::ExchangeSource::registerFactory(
+      exec::InProcessExchangeSource::create);
 
   bm = std::make_unique<ExchangeBenchmark>();
   runBenchmarks();
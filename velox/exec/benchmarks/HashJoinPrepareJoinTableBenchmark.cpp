@@ -19,15 +19,24 @@
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include <iostream>
+#include <numeric>
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::test;
 
 namespace {
+// Number of rows per joinProbe() call in the probe benchmarks.
+constexpr int32_t kProbeBatchSize = 8'192;
+constexpr int32_t kNumProbeBatches = 64;
+
+// Partition size for the radix-partitioned probe benchmarks.
+constexpr uint64_t kProbePartitionBytes = 256 << 10;
+
 struct HashTableBenchmarkParams {
   HashTableBenchmarkParams() = default;
 
@@ -130,6 +139,44 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     VELOX_CHECK_EQ(topTable_->hashMode(), params_.mode);
   }
 
+  // Builds the join table and the hashes of the probe batches for
+  // 'runProbe'. The probe keys are sampled from the build keys, so that all
+  // probes hit. A perfect hash index is built for tables of at most
+  // 'perfectHashMaxRows' unique single integer keys.
+  void prepareProbe(
+      HashTableBenchmarkParams params,
+      uint64_t perfectHashMaxRows = 0) {
+    prepare(params);
+    topTable_->setPerfectHashMaxRows(perfectHashMaxRows);
+    run();
+    VELOX_CHECK_EQ(topTable_->hasPerfectHash(), perfectHashMaxRows > 0);
+    makeProbeHashes();
+  }
+
+  // Probes the table with all probe batches. 'partitionBytes' is the
+  // partition size for radix-partitioned probing, 0 for probing in row order.
+  void runProbe(uint64_t partitionBytes) {
+    topTable_->setJoinProbePartitionBytes(partitionBytes);
+    HashLookup lookup(topTable_->hashers());
+    SelectivityVector rows(kProbeBatchSize);
+    int64_t numHits = 0;
+    for (auto batch = 0; batch < probeHashes_.size(); ++batch) {
+      const auto& hashes = probeHashes_[batch];
+      if (topTable_->hasPerfectHash()) {
+        // The perfect hash probes the decoded keys instead of the hashes.
+        topTable_->hashers()[0]->decode(*probeKeys_[batch], rows);
+      }
+      lookup.reset(hashes.size());
+      std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+      std::copy(hashes.begin(), hashes.end(), lookup.hashes.begin());
+      topTable_->joinProbe(lookup);
+      for (auto i = 0; i < hashes.size(); ++i) {
+        numHits += lookup.hits[i] != nullptr;
+      }
+    }
+    VELOX_CHECK_EQ(numHits, kNumProbeBatches * kProbeBatchSize);
+  }
+
  private:
   // Create the row vector for the build side, where the first column is used
   // as the join key, and the remaining columns are dependent fields.
@@ -205,6 +252,7 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     std::vector<TypePtr> dependentTypes;
     std::vector<RowVectorPtr> batches;
     makeBuildBatches(batches);
+    buildBatches_ = batches;
     for (auto i = 0; i < params_.numWays; ++i) {
       std::vector<std::unique_ptr<VectorHasher>> keyHashers;
       for (int j = 0; j < params_.numFields; ++j) {
@@ -228,7 +276,45 @@ class HashJoinPrepareJoinTableBenchmark : public VectorTestBase {
     }
   }
 
+  // Computes the hashes or value ids of kNumProbeBatches batches of keys
+  // picked at random from 'buildBatches_'.
+  void makeProbeHashes() {
+    probeHashes_.clear();
+    probeKeys_.clear();
+    const auto& hashers = topTable_->hashers();
+    const auto mode = topTable_->hashMode();
+    VectorHasher::ScratchMemory scratchMemory;
+    SelectivityVector rows(kProbeBatchSize);
+    for (auto i = 0; i < kNumProbeBatches; ++i) {
+      const auto& batch =
+          buildBatches_[folly::Random::rand32(buildBatches_.size())];
+      auto indices = makeIndices(kProbeBatchSize, [&](auto /*row*/) {
+        return folly::Random::rand32(batch->size());
+      });
+      raw_vector<uint64_t> hashes(kProbeBatchSize);
+      for (auto j = 0; j < hashers.size(); ++j) {
+        auto keys = BaseVector::wrapInDictionary(
+            nullptr, indices, kProbeBatchSize, batch->childAt(j));
+        if (j == 0) {
+          probeKeys_.push_back(keys);
+        }
+        if (mode == BaseHashTable::HashMode::kHash) {
+          hashers[j]->decode(*keys, rows);
+          hashers[j]->hash(rows, j > 0, hashes);
+        } else {
+          hashers[j]->lookupValueIds(*keys, rows, scratchMemory, hashes);
+        }
+      }
+      VELOX_CHECK(rows.isAllSelected());
+      probeHashes_.push_back(std::move(hashes));
+    }
+  }
+
   std::default_random_engine randomEngine_;
+  std::vector<RowVectorPtr> buildBatches_;
+  std::vector<raw_vector<uint64_t>> probeHashes_;
+  // The first key column of each probe batch.
+  std::vector<VectorPtr> probeKeys_;
   std::unique_ptr<HashTable<true>> topTable_;
   std::vector<std::unique_ptr<BaseHashTable>> otherTables_;
   HashTableBenchmarkParams params_;
@@ -319,6 +405,62 @@ int main(int argc, char** argv) {
       return 1;
     });
   }
+
+  // Compares probing in row order with radix-partitioned probing on tables
+  // that do not fit in cache.
+  std::vector<HashTableBenchmarkParams> probeParams;
+  for (auto buildSize : {(2L << 20) - 3, 2L << 23}) {
+    probeParams.push_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kNormalizedKey,
+        ROW({"k1", "k2"}, {BIGINT(), BIGINT()}),
+        buildSize,
+        buildSize,
+        1));
+    probeParams.push_back(HashTableBenchmarkParams(
+        BaseHashTable::HashMode::kHash,
+        ROW({"k1", "k2", "k3"}, {BIGINT(), BIGINT(), BIGINT()}),
+        buildSize,
+        buildSize,
+        1));
+  }
+  for (auto& param : probeParams) {
+    for (auto partitionBytes : {0UL, kProbePartitionBytes}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format(
+              "probe,{},partitioned:{}", param.title, partitionBytes > 0),
+          [param, partitionBytes, &bm]() {
+            folly::BenchmarkSuspender suspender;
+            bm->prepareProbe(param);
+            suspender.dismiss();
+            bm->runProbe(partitionBytes);
+            return 1;
+          });
+    }
+  }
+
+  // Compares the probe of the hash table with the probe of the perfect hash
+  // index on a single unique key.
+  for (auto buildSize : {(2L << 20) - 3, 2L << 23}) {
+    const HashTableBenchmarkParams param(
+        BaseHashTable::HashMode::kHash,
+        ROW({"k1"}, {BIGINT()}),
+        buildSize,
+        buildSize,
+        1);
+    for (auto perfectHash : {false, true}) {
+      folly::addBenchmark(
+          __FILE__,
+          fmt::format("probe,{},perfectHash:{}", param.title, perfectHash),
+          [param, perfectHash, &bm]() {
+            folly::BenchmarkSuspender suspender;
+            bm->prepareProbe(param, perfectHash ? param.buildSize : 0);
+            suspender.dismiss();
+            bm->runProbe(0);
+            return 1;
+          });
+    }
+  }
   folly::runBenchmarks();
   return 0;
 }
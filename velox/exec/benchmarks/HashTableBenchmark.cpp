@@ -29,6 +29,7 @@
 #include <memory>
 
 #include "velox/common/process/Profiler.h"
+#include "velox/common/time/Timer.h"
 
 DEFINE_int64(custom_size, 0, "Custom number of entries");
 DEFINE_int32(custom_hit_rate, 0, "Percentage of hits in custom test");
@@ -89,13 +90,17 @@ struct HashTableBenchmarkParams {
   // VectorHasher.
   int32_t keySpacing{1};
 
+  // Number of interleaved probes in kHash mode. 0 for the default.
+  int32_t prefetchGroupSize{0};
+
   std::string toString() const {
     return fmt::format(
-        "{}: Rows={} Hit%={} NumProbes={}",
+        "{}: Rows={} Hit%={} NumProbes={} PrefetchGroup={}",
         title,
         buildSize,
         insertPct,
-        size * numWays);
+        size * numWays,
+        prefetchGroupSize);
   }
 };
 
@@ -117,10 +122,14 @@ struct HashTableBenchmarkRun {
   // Clocks for same operation with F14FastSet if applicable.
   float f14ProbeClocks{-1};
 
+  // Probed rows per second of wall time.
+  float probesPerSec{0};
+
   std::string toString() const {
     std::stringstream out;
     out << params.toString();
-    out << " hash/row=" << hashClocks << " probe clocks=" << probeClocks;
+    out << " hash/row=" << hashClocks << " probe clocks=" << probeClocks
+        << " probes/s=" << probesPerSec;
     if (f14ProbeClocks != -1) {
       out << " f14Probe=" << f14ProbeClocks << " ("
           << (100 * f14ProbeClocks / probeClocks) << "%)";
@@ -196,6 +205,7 @@ class HashTableBenchmark : public VectorTestBase {
       startOffset += params_.size;
     }
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setPrefetchGroupSize(params_.prefetchGroupSize);
     LOG(INFO) << "Made table " << topTable_->toString();
 
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
@@ -226,6 +236,7 @@ class HashTableBenchmark : public VectorTestBase {
     testProbe();
     result.hashClocks = hashClocksPerRow_;
     result.probeClocks = clocksPerRow_;
+    result.probesPerSec = probesPerSec_;
     result.hashMode = topTable_->hashMode();
     result.numDistinct = topTable_->numDistinct();
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
@@ -421,6 +432,7 @@ class HashTableBenchmark : public VectorTestBase {
     int32_t numHashed = 0;
     int32_t numProbed = 0;
     int32_t numHit = 0;
+    uint64_t probeMicros = 0;
     auto& hashers = topTable_->hashers();
     VectorHasher::ScratchMemory scratchMemory;
     for (auto batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
@@ -463,6 +475,7 @@ class HashTableBenchmark : public VectorTestBase {
         {
           numProbed += lookup->rows.size();
           SelectivityTimer timer(probeTime, 0);
+          MicrosecondTimer wallTimer(&probeMicros);
           topTable_->joinProbe(*lookup);
         }
         for (auto i = 0; i < lookup->rows.size(); ++i) {
@@ -475,6 +488,7 @@ class HashTableBenchmark : public VectorTestBase {
     hashClocksPerRow_ = hashTime.timeToDropValue() / numHashed;
 
     clocksPerRow_ = probeTime.timeToDropValue() / numProbed;
+    probesPerSec_ = probeMicros == 0 ? 0 : numProbed * 1e6 / probeMicros;
 
     std::cout
         << fmt::format(
@@ -582,6 +596,7 @@ class HashTableBenchmark : public VectorTestBase {
   // Timing set by test*Probe().
   float hashClocksPerRow_{0};
   float clocksPerRow_{0};
+  float probesPerSec_{0};
 
   // hasher and comparer for F14 comparison test.
   struct F14TestHasher {
@@ -652,6 +667,21 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
       HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+  // kHash mode tables from L2 size to about 10x LLC size, probed with the
+  // default interleaving and with group prefetching.
+  for (auto size : {32'000, 256'000, 2'000'000, 16'000'000}) {
+    for (auto prefetchGroupSize : {0, 16, 64}) {
+      HashTableBenchmarkParams hashParams(
+          fmt::format("HashHit{}Prefetch{}", size, prefetchGroupSize),
+          size,
+          100);
+      hashParams.mode = BaseHashTable::HashMode::kHash;
+      hashParams.buildType =
+          ROW({"key"}, {ROW({"k1", "k2"}, {BIGINT(), BIGINT()})});
+      hashParams.prefetchGroupSize = prefetchGroupSize;
+      params.push_back(std::move(hashParams));
+    }
+  }
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/core/QueryConfig.h"
+#include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(num_repeat, 4, "Number of repeats of each local partition query");
+DEFINE_int32(flat_batch_mb, 1, "MB in a 10k row flat batch.");
+DEFINE_int64(
+    local_exchange_buffer_mb,
+    32,
+    "task-wide buffer in local exchange");
+DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
+
+/// Benchmarks hash partitioning by local exchange with different batch sizes
+/// and numbers of consumers. Generates a plan that hash partitions a constant
+/// input in each of n producer drivers to n consumer drivers, which count the
+/// rows and checksum the columns. A final single driver returns the sum of
+/// the counts, which is expected to be n * number of rows in constant input.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+struct Counters {
+  int64_t bytes{0};
+  int64_t usec{0};
+  int64_t repartitionNanos{0};
+  int64_t exchangeNanos{0};
+  int64_t exchangeRows{0};
+  int64_t exchangeBatches{0};
+  int64_t waitForConsumerNanos{0};
+  int64_t waitForProducerNanos{0};
+
+  std::string toString() {
+    if (exchangeBatches == 0) {
+      return "N/A";
+    }
+    return fmt::format(
+        "{}/s repartition={} exchange={} exchange batch={} "
+        "waitForConsumer={} waitForProducer={}",
+        succinctBytes(bytes / (usec / 1.0e6)),
+        succinctNanos(repartitionNanos),
+        succinctNanos(exchangeNanos),
+        exchangeRows / exchangeBatches,
+        succinctNanos(waitForConsumerNanos),
+        succinctNanos(waitForProducerNanos));
+  }
+};
+
+class LocalPartitionBenchmark : public VectorTestBase {
+ public:
+  std::vector<RowVectorPtr> makeRows(
+      RowTypePtr type,
+      int32_t numVectors,
+      int32_t rowsPerVector,
+      int32_t dictPct = 0) {
+    std::vector<RowVectorPtr> vectors;
+    BufferPtr indices;
+    for (int32_t i = 0; i < numVectors; ++i) {
+      auto vector = std::dynamic_pointer_cast<RowVector>(
+          BatchMaker::createBatch(type, rowsPerVector, *pool_));
+      auto width = vector->childrenSize();
+      for (auto child = 0; child < width; ++child) {
+        if (100 * child / width > dictPct) {
+          if (!indices) {
+            indices = makeIndices(vector->size(), [&](auto i) { return i; });
+          }
+          vector->childAt(child) = BaseVector::wrapInDictionary(
+              nullptr, indices, vector->size(), vector->childAt(child));
+        }
+      }
+      vectors.push_back(vector);
+    }
+    return vectors;
+  }
+
+  /// Hash partitions 'vectors' from 'numDrivers' producer drivers to as many
+  /// consumer drivers.
+  void run(
+      std::vector<RowVectorPtr>& vectors,
+      int32_t numDrivers,
+      Counters& counters) {
+    assert(!vectors.empty());
+    std::vector<std::string> aggregates = {"count(1)"};
+    auto& rowType = vectors[0]->type()->as<TypeKind::ROW>();
+    for (auto i = 1; i < rowType.size(); ++i) {
+      aggregates.push_back(fmt::format("checksum({})", rowType.nameOf(i)));
+    }
+    core::PlanNodeId exchangeId;
+    auto plan = exec::test::PlanBuilder()
+                    .values(vectors, true)
+                    .localPartition({"c0"})
+                    .capturePlanNodeId(exchangeId)
+                    .singleAggregation({}, aggregates)
+                    .localPartition(std::vector<std::string>{})
+                    .singleAggregation({}, {"sum(a0)"})
+                    .planNode();
+    auto expected =
+        makeRowVector({makeFlatVector<int64_t>(1, [&](auto /*row*/) {
+          return vectors.size() * vectors[0]->size() * numDrivers;
+        })});
+
+    for (auto repeat = 0; repeat < FLAGS_num_repeat; ++repeat) {
+      const auto startMicros = getCurrentTimeMicro();
+      auto task =
+          exec::test::AssertQueryBuilder(plan)
+              .config(
+                  core::QueryConfig::kMaxLocalExchangeBufferSize,
+                  fmt::format("{}", FLAGS_local_exchange_buffer_mb << 20))
+              .maxDrivers(numDrivers)
+              .assertResults(expected);
+      counters.usec += getCurrentTimeMicro() - startMicros;
+      counters.bytes +=
+          vectors[0]->retainedSize() * vectors.size() * numDrivers;
+
+      const auto taskStats = task->taskStats();
+      for (const auto& pipeline : taskStats.pipelineStats) {
+        for (const auto& op : pipeline.operatorStats) {
+          if (op.planNodeId != exchangeId) {
+            continue;
+          }
+          if (op.operatorType == "LocalPartition") {
+            counters.repartitionNanos += op.addInputTiming.cpuNanos;
+          } else if (op.operatorType == "LocalExchange") {
+            counters.exchangeRows += op.outputPositions;
+            counters.exchangeBatches += op.outputVectors;
+            counters.exchangeNanos += op.getOutputTiming.cpuNanos;
+          }
+        }
+      }
+      auto runtimeStats = toPlanStats(taskStats).at(exchangeId).customStats;
+      counters.waitForConsumerNanos +=
+          runtimeStats["blockedWaitForConsumerWallNanos"].sum;
+      counters.waitForProducerNanos +=
+          runtimeStats["blockedWaitForProducerWallNanos"].sum;
+    }
+  }
+};
+
+std::unique_ptr<LocalPartitionBenchmark> bm;
+
+void runBenchmarks() {
+  std::vector<std::string> flatNames = {"c0"};
+  std::vector<TypePtr> flatTypes = {BIGINT()};
+  std::vector<TypePtr> typeSelection = {
+      BOOLEAN(),
+      TINYINT(),
+      DECIMAL(20, 3),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DECIMAL(10, 2),
+      DOUBLE(),
+      VARCHAR()};
+
+  int64_t flatSize = 0;
+  // Add enough columns of different types to make a 10K row batch be
+  // flat_batch_mb in flat size.
+  while (flatSize * 10000 < static_cast<int64_t>(FLAGS_flat_batch_mb) << 20) {
+    flatNames.push_back(fmt::format("c{}", flatNames.size()));
+    flatTypes.push_back(typeSelection[flatTypes.size() % typeSelection.size()]);
+    if (flatTypes.back()->isFixedWidth()) {
+      flatSize += flatTypes.back()->cppSizeInBytes();
+    } else {
+      flatSize += 20;
+    }
+  }
+  auto flatType = ROW(std::move(flatNames), std::move(flatTypes));
+
+  auto flat10k = bm->makeRows(flatType, 10, 10000, FLAGS_dict_pct);
+  auto flat1k = bm->makeRows(flatType, 100, 1000, FLAGS_dict_pct);
+
+  const std::vector<int32_t> numConsumers = {8, 16, 32, 64};
+  std::vector<Counters> flat10kCounters(numConsumers.size());
+  std::vector<Counters> flat1kCounters(numConsumers.size());
+  for (auto i = 0; i < numConsumers.size(); ++i) {
+    folly::addBenchmark(
+        __FILE__, fmt::format("localFlat10k_{}", numConsumers[i]), [&, i]() {
+          bm->run(flat10k, numConsumers[i], flat10kCounters[i]);
+          return 1;
+        });
+    folly::addBenchmark(
+        __FILE__, fmt::format("localFlat1k_{}", numConsumers[i]), [&, i]() {
+          bm->run(flat1k, numConsumers[i], flat1kCounters[i]);
+          return 1;
+        });
+  }
+
+  folly::runBenchmarks();
+  for (auto i = 0; i < numConsumers.size(); ++i) {
+    std::cout << "flat10k x " << numConsumers[i] << ": "
+              << flat10kCounters[i].toString() << std::endl
+              << "flat1k x " << numConsumers[i] << ": "
+              << flat1kCounters[i].toString() << std::endl;
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  bm = std::make_unique<LocalPartitionBenchmark>();
+  runBenchmarks();
+  bm.reset();
+
+  return 0;
+}
@@ -20,7 +20,10 @@
 #include <gflags/gflags.h>
 
 #include "velox/exec/TreeOfLosers.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -29,6 +32,93 @@ TestData narrow;
 TestData medium;
 TestData wide;
 
+namespace {
+
+constexpr int32_t kNumSources = 8;
+constexpr int32_t kNumBatches = 10;
+constexpr int32_t kBatchSize = 10'000;
+
+/// Runs LocalMerge of sorted sources with the rows compared on normalized key
+/// prefixes or on the key columns.
+class LocalMergeBenchmark : public test::VectorTestBase {
+ public:
+  LocalMergeBenchmark() {
+    addCase("bigint", {"c0"}, [&](const auto& keys) {
+      return makeRowVector({makeFlatVector<int64_t>(keys)});
+    });
+    addCase("varchar", {"c0"}, [&](const auto& keys) {
+      return makeRowVector({makeFlatVector<std::string>(
+          keys.size(),
+          [&](auto row) { return fmt::format("{:012}", keys[row]); })});
+    });
+    addCase("longVarchar", {"c0"}, [&](const auto& keys) {
+      return makeRowVector(
+          {makeFlatVector<std::string>(keys.size(), [&](auto row) {
+            return fmt::format("common-prefix-{:012}", keys[row]);
+          })});
+    });
+    addCase("multiKey", {"c0", "c1", "c2"}, [&](const auto& keys) {
+      return makeRowVector({
+          makeFlatVector<int64_t>(
+              keys.size(), [&](auto row) { return keys[row] / 100; }),
+          makeFlatVector<std::string>(
+              keys.size(),
+              [&](auto row) { return fmt::format("{:06}", keys[row] % 100); }),
+          makeFlatVector<double>(
+              keys.size(), [&](auto row) { return keys[row] * 0.5; }),
+      });
+    });
+  }
+
+  void run(const std::string& name, bool normalizedKeys) {
+    AssertQueryBuilder builder(plans_.at(name));
+    if (!normalizedKeys) {
+      builder.config(core::QueryConfig::kPrefixSortNormalizedKeyMaxBytes, "0");
+    }
+    builder.copyResults(pool());
+  }
+
+ private:
+  using BatchMaker =
+      std::function<RowVectorPtr(const std::vector<int64_t>& keys)>;
+
+  // Adds a plan merging 'kNumSources' sources on 'sortingKeys'. Source 's'
+  // has the keys s, s + kNumSources, s + 2 * kNumSources... 'makeBatch'
+  // makes a batch ordered on 'sortingKeys' from consecutive keys.
+  void addCase(
+      const std::string& name,
+      const std::vector<std::string>& sortingKeys,
+      const BatchMaker& makeBatch) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources;
+    for (auto source = 0; source < kNumSources; ++source) {
+      std::vector<RowVectorPtr> batches;
+      for (auto i = 0; i < kNumBatches; ++i) {
+        std::vector<int64_t> keys(kBatchSize);
+        for (auto row = 0; row < kBatchSize; ++row) {
+          keys[row] =
+              (static_cast<int64_t>(i) * kBatchSize + row) * kNumSources +
+              source;
+        }
+        batches.push_back(makeBatch(keys));
+      }
+      sources.push_back(
+          PlanBuilder(planNodeIdGenerator).values(batches).planNode());
+    }
+    plans_.emplace(
+        name,
+        PlanBuilder(planNodeIdGenerator)
+            .localMerge(sortingKeys, std::move(sources))
+            .planNode());
+  }
+
+  std::unordered_map<std::string, core::PlanNodePtr> plans_;
+};
+
+std::unique_ptr<LocalMergeBenchmark> localMerge;
+
+} // namespace
+
 BENCHMARK(narrowTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(narrow, false);
 }
@@ -53,14 +143,57 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(bigintColumns) {
+  localMerge->run("bigint", false);
+}
+
+BENCHMARK_RELATIVE(bigintPrefixes) {
+  localMerge->run("bigint", true);
+}
+
+// Strings that differ within the normalized prefix.
+BENCHMARK(varcharColumns) {
+  localMerge->run("varchar", false);
+}
+
+BENCHMARK_RELATIVE(varcharPrefixes) {
+  localMerge->run("varchar", true);
+}
+
+// Strings with a common prefix longer than the normalized one, compared on
+// the full values.
+BENCHMARK(longVarcharColumns) {
+  localMerge->run("longVarchar", false);
+}
+
+BENCHMARK_RELATIVE(longVarcharPrefixes) {
+  localMerge->run("longVarchar", true);
+}
+
+// ORDER BY c0, c1, c2 with runs of equal c0 values.
+BENCHMARK(multiKeyColumns) {
+  localMerge->run("multiKey", false);
+}
+
+BENCHMARK_RELATIVE(multiKeyPrefixes) {
+  localMerge->run("multiKey", true);
+}
+
 int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+  memory::MemoryManager::initialize({});
   MergeTestBase test;
   test.seed(1);
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+
+  localMerge = std::make_unique<LocalMergeBenchmark>();
+
   folly::runBenchmarks();
+  localMerge.reset();
   return 0;
 }
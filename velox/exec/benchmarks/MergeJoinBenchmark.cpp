@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Benchmarks merge join of two sorted inputs on a single BIGINT key. The
+/// flat key cases use the exponential search over the key values and the bulk
+/// output of matching rows. The dictionary encoded key cases compare the keys
+/// row by row.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+constexpr int32_t kNumBatches = 100;
+constexpr int32_t kBatchSize = 10'000;
+
+class MergeJoinBenchmark : public VectorTestBase {
+ public:
+  // Returns sorted batches with keys 'step' apart. Each key repeats
+  // 'numDuplicates' times. Wraps the keys in a dictionary if 'dictionary' is
+  // true.
+  std::vector<RowVectorPtr> makeInput(
+      const std::string& prefix,
+      int32_t step,
+      int32_t numDuplicates,
+      bool dictionary) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < kNumBatches; ++i) {
+      const int64_t firstRow = static_cast<int64_t>(i) * kBatchSize;
+      VectorPtr keys = makeFlatVector<int64_t>(kBatchSize, [&](auto row) {
+        return (firstRow + row) / numDuplicates * step;
+      });
+      if (dictionary) {
+        keys = wrapInDictionary(
+            makeIndices(kBatchSize, [](auto row) { return row; }), keys);
+      }
+      batches.push_back(makeRowVector(
+          {prefix + "0", prefix + "1"},
+          {keys,
+           makeFlatVector<int64_t>(
+               kBatchSize, [](auto row) { return row; })}));
+    }
+    return batches;
+  }
+
+  void addCase(
+      const std::string& name,
+      int32_t leftStep,
+      int32_t rightStep,
+      int32_t numDuplicates,
+      bool dictionary) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        exec::test::PlanBuilder(planNodeIdGenerator)
+            .values(makeInput("t", leftStep, numDuplicates, dictionary))
+            .mergeJoin(
+                {"t0"},
+                {"u0"},
+                exec::test::PlanBuilder(planNodeIdGenerator)
+                    .values(makeInput("u", rightStep, 1, dictionary))
+                    .planNode(),
+                "",
+                {"t0", "t1", "u1"})
+            .singleAggregation({}, {"count(1)"})
+            .planNode();
+    plans_.emplace(name, std::move(plan));
+  }
+
+  void run(const std::string& name) {
+    exec::test::AssertQueryBuilder(plans_.at(name)).copyResults(pool());
+  }
+
+ private:
+  std::unordered_map<std::string, core::PlanNodePtr> plans_;
+};
+
+std::unique_ptr<MergeJoinBenchmark> bm;
+
+} // namespace
+
+// Few matches: one in 10 left keys has a match on the right.
+BENCHMARK(sparseDictionary) {
+  bm->run("sparseDictionary");
+}
+
+BENCHMARK_RELATIVE(sparseFlat) {
+  bm->run("sparseFlat");
+}
+
+// Every left key matches one right row.
+BENCHMARK(oneToOneDictionary) {
+  bm->run("oneToOneDictionary");
+}
+
+BENCHMARK_RELATIVE(oneToOneFlat) {
+  bm->run("oneToOneFlat");
+}
+
+// Runs of 100 equal keys on the left.
+BENCHMARK(duplicatesDictionary) {
+  bm->run("duplicatesDictionary");
+}
+
+BENCHMARK_RELATIVE(duplicatesFlat) {
+  bm->run("duplicatesFlat");
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  aggregate::prestosql::registerAllAggregateFunctions();
+
+  bm = std::make_unique<MergeJoinBenchmark>();
+  for (const bool dictionary : {true, false}) {
+    const std::string encoding = dictionary ? "Dictionary" : "Flat";
+    bm->addCase("sparse" + encoding, 1, 10, 1, dictionary);
+    bm->addCase("oneToOne" + encoding, 1, 1, 1, dictionary);
+    bm->addCase("duplicates" + encoding, 1, 1, 100, dictionary);
+  }
+  folly::runBenchmarks();
+  bm.reset();
+
+  return 0;
+}
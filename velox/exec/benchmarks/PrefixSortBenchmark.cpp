@@ -127,13 +127,13 @@ class TestCase {
 
 // You could config threshold, e.i. 0, to test prefix-sort for small
 // dateset.
-static const PrefixSortConfig kDefaultSortConfig(1024, 100);
+static const common::PrefixSortConfig kDefaultSortConfig(1024, 100);
 
 // For small dataset, in some test environments, if std-sort is defined in the
 // benchmark file, the test results may be strangely regressed. When the
 // threshold is particularly large, PrefixSort is actually std-sort, hence, we
 // can use this as std-sort benchmark base.
-static const PrefixSortConfig kStdSortConfig(
+static const common::PrefixSortConfig kStdSortConfig(
     1024,
     std::numeric_limits<int>::max());
 
@@ -298,6 +298,39 @@ class PrefixSortBenchmark {
         "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
   }
 
+  // String keys before and after fixed width keys. Only the keys up to and
+  // including the first string key are normalized.
+  void largeMixed() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        1'000, 10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({BIGINT(), VARCHAR()}),
+        ROW({VARCHAR(), BIGINT()}),
+        ROW({INTEGER(), BIGINT(), VARCHAR()}),
+        ROW({BIGINT(), VARCHAR(), VARCHAR()}),
+    };
+    std::vector<int> numKeys = {2, 2, 3, 3};
+    benchmark(
+        "no-payloads", "mixed", batchSizes, rowTypes, numKeys, iterations);
+  }
+
+  // Partition keys followed by sorting keys and a payload, as SortWindowBuild
+  // sorts the input of a window.
+  void largeWindow() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        1'000, 10'000, 100'000, 1'000'000};
+    std::vector<RowTypePtr> rowTypes = {
+        ROW({INTEGER(), BIGINT(), DOUBLE()}),
+        ROW({VARCHAR(), BIGINT(), DOUBLE()}),
+        ROW({INTEGER(), BIGINT(), TIMESTAMP(), DOUBLE()}),
+        ROW({BIGINT(), VARCHAR(), DOUBLE()}),
+    };
+    std::vector<int> numKeys = {2, 2, 3, 2};
+    benchmark("payload", "window", batchSizes, rowTypes, numKeys, iterations);
+  }
+
  private:
   std::vector<std::unique_ptr<TestCase>> testCases_;
   memory::MemoryPool* pool_;
@@ -318,6 +351,8 @@ int main(int argc, char** argv) {
   bm.largeBigintWithPayloads();
   bm.smallBigintWithPayload();
   bm.largeVarchar();
+  bm.largeMixed();
+  bm.largeWindow();
   folly::runBenchmarks();
 
   return 0;
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int32(num_events, 20'000, "Number of probe side events");
+DEFINE_int32(num_windows, 10'000, "Number of build side time windows");
+
+/// Benchmarks a nested loop join of events with time windows on
+/// 'ts BETWEEN w_start AND w_end', with and without an equality on a key,
+/// comparing range lookups into the sorted build side against comparing
+/// every event with every window. See
+/// QueryConfig::kNestedLoopJoinRangeLookupEnabled.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+class RangeJoinBenchmark : public VectorTestBase {
+ public:
+  RangeJoinBenchmark() {
+    constexpr int32_t kBatchSize = 1'000;
+    constexpr int32_t kNumKeys = 10;
+    // Events at random times in [0, 1'000'000) and windows of up to 1'000
+    // starting every 100.
+    for (auto i = 0; i < FLAGS_num_events; i += kBatchSize) {
+      events_.push_back(makeRowVector(
+          {"k", "ts"},
+          {makeFlatVector<int32_t>(
+               kBatchSize, [](auto row) { return row % kNumKeys; }),
+           makeFlatVector<int64_t>(kBatchSize, [](auto /*row*/) {
+             return folly::Random::rand32() % 1'000'000;
+           })}));
+    }
+    for (auto i = 0; i < FLAGS_num_windows; i += kBatchSize) {
+      windows_.push_back(makeRowVector(
+          {"w_k", "w_start", "w_end"},
+          {makeFlatVector<int32_t>(
+               kBatchSize, [](auto row) { return row % kNumKeys; }),
+           makeFlatVector<int64_t>(
+               kBatchSize, [i](auto row) { return (i + row) * 100; }),
+           makeFlatVector<int64_t>(kBatchSize, [i](auto row) {
+             return (i + row) * 100 + folly::Random::rand32() % 1'000;
+           })}));
+    }
+  }
+
+  void run(const std::string& condition, bool rangeLookup) {
+    folly::BenchmarkSuspender suspender;
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = exec::test::PlanBuilder(planNodeIdGenerator)
+                    .values(events_)
+                    .nestedLoopJoin(
+                        exec::test::PlanBuilder(planNodeIdGenerator)
+                            .values(windows_)
+                            .planNode(),
+                        condition,
+                        {"ts", "w_start"})
+                    .singleAggregation({}, {"count(1)"})
+                    .planNode();
+    suspender.dismiss();
+
+    exec::test::AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kNestedLoopJoinRangeLookupEnabled,
+            rangeLookup ? "true" : "false")
+        .copyResults(pool());
+  }
+
+ private:
+  std::vector<RowVectorPtr> events_;
+  std::vector<RowVectorPtr> windows_;
+};
+
+std::unique_ptr<RangeJoinBenchmark> bm;
+
+const std::string kBetween = "ts BETWEEN w_start AND w_end";
+const std::string kKeyAndBetween = "k = w_k AND ts BETWEEN w_start AND w_end";
+
+BENCHMARK(crossProductBetween) {
+  bm->run(kBetween, false);
+}
+
+BENCHMARK_RELATIVE(rangeLookupBetween) {
+  bm->run(kBetween, true);
+}
+
+BENCHMARK(crossProductKeyAndBetween) {
+  bm->run(kKeyAndBetween, false);
+}
+
+BENCHMARK_RELATIVE(rangeLookupKeyAndBetween) {
+  bm->run(kKeyAndBetween, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  bm = std::make_unique<RangeJoinBenchmark>();
+  folly::runBenchmarks();
+  bm.reset();
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <random>
+
+#include "velox/exec/RowContainer.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+namespace facebook::velox::test {
+namespace {
+constexpr vector_size_t kNumRows = 1'000'000;
+
+// Measures the extraction of the fixed width columns of a row container, as
+// done for the output of aggregations, sorts and join builds. Rows are
+// extracted in the order of insertion and in random order, like after a sort.
+class ExtractBenchmark {
+ public:
+  ExtractBenchmark() : pool_(memory::memoryManager()->addLeafPool()) {
+    VectorMaker vectorMaker(pool_.get());
+    std::vector<VectorPtr> columns = {
+        vectorMaker.flatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+        vectorMaker.flatVector<int32_t>(
+            kNumRows,
+            [](auto row) { return row % 1'000; },
+            VectorMaker::nullEvery(11)),
+        vectorMaker.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row * 17; }),
+        vectorMaker.flatVector<double>(
+            kNumRows,
+            [](auto row) { return row * 0.1; },
+            VectorMaker::nullEvery(7)),
+        vectorMaker.flatVector<int16_t>(
+            kNumRows, [](auto row) { return row % 100; }),
+        vectorMaker.flatVector<Timestamp>(
+            kNumRows, [](auto row) { return Timestamp(row, 0); }),
+    };
+    std::vector<TypePtr> types;
+    for (const auto& column : columns) {
+      types.push_back(column->type());
+      columnIndices_.push_back(columnIndices_.size());
+    }
+    container_ = std::make_unique<exec::RowContainer>(
+        std::vector<TypePtr>{types[0]},
+        std::vector<TypePtr>(types.begin() + 1, types.end()),
+        pool_.get());
+    std::vector<DecodedVector> decoded;
+    for (const auto& column : columns) {
+      decoded.emplace_back(*column);
+    }
+    rows_.resize(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      rows_[i] = container_->newRow();
+      for (auto column = 0; column < decoded.size(); ++column) {
+        container_->store(decoded[column], i, rows_[i], column);
+      }
+    }
+    shuffledRows_ = rows_;
+    std::shuffle(shuffledRows_.begin(), shuffledRows_.end(), std::mt19937(1));
+    for (const auto& type : types) {
+      results_.push_back(BaseVector::create(type, kNumRows, pool_.get()));
+    }
+  }
+
+  void extractByColumn(bool shuffled) {
+    const auto& rows = shuffled ? shuffledRows_ : rows_;
+    for (auto column : columnIndices_) {
+      container_->extractColumn(
+          rows.data(), kNumRows, column, results_[column]);
+    }
+  }
+
+  void extractColumns(bool shuffled) {
+    const auto& rows = shuffled ? shuffledRows_ : rows_;
+    container_->extractColumns(
+        rows.data(), kNumRows, columnIndices_, 0, results_);
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::unique_ptr<exec::RowContainer> container_;
+  std::vector<column_index_t> columnIndices_;
+  std::vector<char*> rows_;
+  std::vector<char*> shuffledRows_;
+  std::vector<VectorPtr> results_;
+};
+
+std::unique_ptr<ExtractBenchmark> benchmark;
+
+BENCHMARK(extractByColumn) {
+  benchmark->extractByColumn(false);
+}
+
+BENCHMARK_RELATIVE(extractColumns) {
+  benchmark->extractColumns(false);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(extractByColumnShuffled) {
+  benchmark->extractByColumn(true);
+}
+
+BENCHMARK_RELATIVE(extractColumnsShuffled) {
+  benchmark->extractColumns(true);
+}
+} // namespace
+} // namespace facebook::velox::test
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize({});
+  facebook::velox::test::benchmark =
+      std::make_unique<facebook::velox::test::ExtractBenchmark>();
+  folly::runBenchmarks();
+  facebook::velox::test::benchmark.reset();
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/RowContainer.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+namespace facebook::velox::test {
+namespace {
+constexpr vector_size_t kNumRows = 100'000;
+
+// Returns URL like strings, as found in logs of web requests.
+VectorPtr makeUrls(memory::MemoryPool* pool) {
+  static const std::vector<std::string> kHosts = {
+      "www.example.com",
+      "images.example.org",
+      "static.cdn.example.net",
+      "m.example.com"};
+  VectorMaker vectorMaker(pool);
+  std::string url;
+  return vectorMaker.flatVector<StringView>(kNumRows, [&](auto row) {
+    url = fmt::format(
+        "https://{}/articles/{}/view?utm_source=newsletter&session={}",
+        kHosts[row % kHosts.size()],
+        row * 7 % 10'007,
+        row * 1'000'003 % 1'000'000'007);
+    return StringView(url);
+  });
+}
+
+struct Stored {
+  std::unique_ptr<exec::RowContainer> container;
+  std::vector<char*> rows;
+};
+
+Stored store(const VectorPtr& urls, bool compress, memory::MemoryPool* pool) {
+  Stored stored;
+  stored.container = std::make_unique<exec::RowContainer>(
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<TypePtr>{VARCHAR()},
+      pool);
+  if (compress) {
+    const auto* values = urls->asFlatVector<StringView>()->rawValues();
+    std::vector<std::string_view> sample;
+    for (auto i = 0; i < 1'000; ++i) {
+      sample.emplace_back(values[i].data(), values[i].size());
+    }
+    stored.container->setCompressedStrings(
+        1, exec::FsstSymbolTable::build(sample));
+  }
+  VectorMaker vectorMaker(pool);
+  auto keys = vectorMaker.flatVector<int64_t>(
+      kNumRows, [](auto row) { return row; });
+  DecodedVector decodedKeys(*keys);
+  DecodedVector decodedUrls(*urls);
+  stored.rows.resize(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    stored.rows[i] = stored.container->newRow();
+    stored.container->store(decodedKeys, i, stored.rows[i], 0);
+    stored.container->store(decodedUrls, i, stored.rows[i], 1);
+  }
+  return stored;
+}
+
+void storeUrls(uint32_t iterations, bool compress) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto urls = makeUrls(pool.get());
+  for (auto i = 0; i < iterations; ++i) {
+    suspender.dismiss();
+    auto stored = store(urls, compress, pool.get());
+    suspender.rehire();
+  }
+}
+
+void extractUrls(uint32_t iterations, bool compress) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto stored = store(makeUrls(pool.get()), compress, pool.get());
+  auto result = BaseVector::create(VARCHAR(), kNumRows, pool.get());
+  for (auto i = 0; i < iterations; ++i) {
+    suspender.dismiss();
+    stored.container->extractColumn(
+        stored.rows.data(), kNumRows, 1, result);
+    suspender.rehire();
+    result->prepareForReuse();
+  }
+}
+
+BENCHMARK(storePlain) {
+  storeUrls(1, false);
+}
+
+BENCHMARK_RELATIVE(storeCompressed) {
+  storeUrls(1, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(extractPlain) {
+  extractUrls(1, false);
+}
+
+BENCHMARK_RELATIVE(extractCompressed) {
+  extractUrls(1, true);
+}
+
+// Prints the memory held by the containers with and without compression.
+void printMemory() {
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto urls = makeUrls(pool.get());
+  for (const auto compress : {false, true}) {
+    auto stored = store(urls, compress, pool.get());
+    LOG(INFO) << (compress ? "Compressed" : "Plain")
+              << " row container bytes: "
+              << stored.container->allocatedBytes();
+  }
+}
+} // namespace
+} // namespace facebook::velox::test
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  facebook::velox::memory::MemoryManager::initialize({});
+  facebook::velox::test::printMemory();
+  folly::runBenchmarks();
+  return 0;
+}
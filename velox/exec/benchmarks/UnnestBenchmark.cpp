@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+// Measures Unnest over wide input, many rows with a few elements each, and
+// deep input, a few rows with a million elements each. Deep rows are split
+// into output batches of preferred_output_batch_rows. The elements of
+// consecutive rows are returned as slices of the input elements.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+constexpr vector_size_t kNumElements = 4'000'000;
+
+class UnnestBenchmark : public test::VectorTestBase {
+ public:
+  UnnestBenchmark() {
+    wide_ = makeInput(kNumElements / 4, 4);
+    deep_ = makeInput(4, kNumElements / 4);
+  }
+
+  // Returns the number of output rows.
+  size_t run(bool deep, bool map, bool withOrdinality) {
+    folly::BenchmarkSuspender suspender;
+    CursorParameters params;
+    params.planNode =
+        PlanBuilder()
+            .values({deep ? deep_ : wide_})
+            .unnest(
+                {"c0"},
+                {map ? "c2" : "c1"},
+                withOrdinality ? std::optional<std::string>("ordinal")
+                               : std::nullopt)
+            .planNode();
+    params.copyResult = false;
+    auto cursor = TaskCursor::create(params);
+    suspender.dismiss();
+
+    size_t numRows = 0;
+    while (cursor->moveNext()) {
+      numRows += cursor->current()->size();
+    }
+    VELOX_CHECK_EQ(numRows, kNumElements);
+    return numRows;
+  }
+
+ private:
+  RowVectorPtr makeInput(vector_size_t numRows, vector_size_t numElements) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(numRows, [](auto row) { return row; }),
+        makeArrayVector<int64_t>(
+            numRows,
+            [&](auto /*row*/) { return numElements; },
+            [](auto row, auto index) { return row + index; }),
+        vectorMaker_.mapVector<int32_t, double>(
+            numRows,
+            [&](auto /*row*/) { return numElements; },
+            [](auto /*row*/, auto index) { return index; },
+            [](auto row, auto index) { return row * 0.5 + index; }),
+    });
+  }
+
+  RowVectorPtr wide_;
+  RowVectorPtr deep_;
+};
+
+std::unique_ptr<UnnestBenchmark> benchmark;
+
+BENCHMARK_MULTI(wideArray) {
+  return benchmark->run(false, false, false);
+}
+
+BENCHMARK_RELATIVE_MULTI(deepArray) {
+  return benchmark->run(true, false, false);
+}
+
+BENCHMARK_MULTI(wideArrayWithOrdinality) {
+  return benchmark->run(false, false, true);
+}
+
+BENCHMARK_RELATIVE_MULTI(deepArrayWithOrdinality) {
+  return benchmark->run(true, false, true);
+}
+
+BENCHMARK_MULTI(wideMap) {
+  return benchmark->run(false, true, false);
+}
+
+BENCHMARK_RELATIVE_MULTI(deepMap) {
+  return benchmark->run(true, true, false);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+
+  benchmark = std::make_unique<UnnestBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
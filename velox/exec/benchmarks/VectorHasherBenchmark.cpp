@@ -269,6 +269,45 @@ BENCHMARK(computeValueIdsDictionaryForFiltering) {
   }
 }
 
+void benchmarkHashMultipleKeys(bool withNulls) {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 10'000;
+  BenchmarkBase base;
+  auto isNullAt = withNulls ? VectorMaker::nullEvery(7) : nullptr;
+  std::vector<VectorPtr> keys = {
+      base.vectorMaker().flatVector<int64_t>(
+          size, [](vector_size_t row) { return row * 31; }, isNullAt),
+      base.vectorMaker().flatVector<int32_t>(
+          size, [](vector_size_t row) { return row % 1'000; }, isNullAt),
+      base.vectorMaker().flatVector<double>(
+          size, [](vector_size_t row) { return row * 0.1; }, isNullAt),
+  };
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < keys.size(); ++i) {
+    hashers.push_back(VectorHasher::create(keys[i]->type(), i));
+  }
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> hashes(size);
+  suspender.dismiss();
+
+  for (int i = 0; i < 1'000; i++) {
+    for (auto j = 0; j < keys.size(); ++j) {
+      hashers[j]->decode(*keys[j], rows);
+      hashers[j]->hash(rows, j > 0, hashes);
+    }
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+// Flat keys without nulls are hashed in a tight loop over the values.
+BENCHMARK(hashMultipleKeysNoNulls) {
+  benchmarkHashMultipleKeys(false);
+}
+
+BENCHMARK_RELATIVE(hashMultipleKeysWithNulls) {
+  benchmarkHashMultipleKeys(true);
+}
+
 int main(int argc, char** argv) {
   folly::Init init{&argc, &argv};
   memory::MemoryManager::initialize({});
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -159,6 +160,27 @@ class PrefixSortRunner {
         compare);
   }
 
+  // Within radixSort, partitions with fewer entries than kSmallRadixSort are
+  // sorted with quickSort. Counting the 256 byte values of a pass costs more
+  // than comparison sorting such small partitions.
+  static const int kSmallRadixSort = 128;
+
+  /// Sorts prefix data in range [start, end) by the first 'keySize' bytes of
+  /// the entries with a most significant digit radix sort, one byte per pass.
+  /// The keys are sequences of 64-bit words in native byte order that compare
+  /// as unsigned integers, as PrefixSort lays them out. Partitions smaller
+  /// than kSmallRadixSort and entries whose keys are equal are sorted with
+  /// quickSort and 'compare', which must order entries with different keys as
+  /// the keys do and may break ties on other data.
+  template <typename TCompare>
+  void radixSort(char* start, char* end, uint32_t keySize, TCompare compare)
+      const {
+    VELOX_CHECK_EQ(keySize % sizeof(uint64_t), 0);
+    VELOX_CHECK_LE(keySize, entrySize_);
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    radixSort(start, (end - start) / entrySize_, keySize, 0, compare);
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -347,6 +369,86 @@ class PrefixSortRunner {
     }
   }
 
+  // Returns the offset in an entry of the 'byte'th most significant key byte.
+  // Each 64-bit word holds its most significant byte last.
+  FOLLY_ALWAYS_INLINE static uint32_t radixByteOffset(uint32_t byte) {
+    return (byte & ~7u) + 7 - (byte & 7);
+  }
+
+  // Moves the 'numEntries' entries from 'start' into the buckets of their
+  // byte at 'offset' in place. 'counts' gives the bucket sizes.
+  void radixPartition(
+      char* start,
+      uint64_t numEntries,
+      uint32_t offset,
+      const uint64_t* counts) const {
+    uint64_t heads[256];
+    uint64_t ends[256];
+    uint64_t begin = 0;
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      heads[bucket] = begin;
+      begin += counts[bucket];
+      ends[bucket] = begin;
+    }
+    VELOX_DCHECK_EQ(begin, numEntries);
+    // Each swap puts at least one entry in its bucket.
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      while (heads[bucket] < ends[bucket]) {
+        char* entry = start + heads[bucket] * entrySize_;
+        const uint8_t digit = entry[offset];
+        if (digit == bucket) {
+          ++heads[bucket];
+        } else {
+          char* target = start + heads[digit]++ * entrySize_;
+          swap(
+              detail::PrefixSortIterator(entry, entrySize_),
+              detail::PrefixSortIterator(target, entrySize_));
+        }
+      }
+    }
+  }
+
+  // Sorts the 'numEntries' entries from 'start' whose keys are equal in the
+  // bytes before 'byte'.
+  template <typename TCompare>
+  void radixSort(
+      char* start,
+      uint64_t numEntries,
+      uint32_t keySize,
+      uint32_t byte,
+      TCompare compare) const {
+    uint64_t counts[256];
+    for (;;) {
+      if (numEntries < kSmallRadixSort || byte == keySize) {
+        quickSort(start, start + numEntries * entrySize_, compare);
+        return;
+      }
+      const auto offset = radixByteOffset(byte);
+      std::fill(counts, counts + 256, 0);
+      for (uint64_t i = 0; i < numEntries; ++i) {
+        ++counts[static_cast<uint8_t>(start[i * entrySize_ + offset])];
+      }
+      // Skips the byte without moving entries if all entries have it equal.
+      if (counts[static_cast<uint8_t>(start[offset])] != numEntries) {
+        radixPartition(start, numEntries, offset, counts);
+        break;
+      }
+      ++byte;
+    }
+    uint64_t begin = 0;
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      if (counts[bucket] > 1) {
+        radixSort(
+            start + begin * entrySize_,
+            counts[bucket],
+            keySize,
+            byte + 1,
+            compare);
+      }
+      begin += counts[bucket];
+    }
+  }
+
   const uint64_t entrySize_;
   char* const swapBuffer_;
 };
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +35,7 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp).
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -53,6 +54,37 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encodes the first 'prefixLength' bytes of a string, with a leading null
+  /// byte as above. Shorter strings are padded with zero bytes, so that the
+  /// encoding orders strings as their unsigned byte sequences except that two
+  /// strings are encoded equal if they are equal in their first
+  /// 'prefixLength' bytes or differ only by trailing zero bytes. The caller
+  /// compares such strings on their full values.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t prefixLength) const {
+    if (value.has_value()) {
+      dest[0] = nullsFirst_ ? 1 : 0;
+      encodeNoNulls(value.value(), dest + 1, prefixLength);
+    } else {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixLength);
+    }
+  }
+
+  FOLLY_ALWAYS_INLINE void
+  encodeNoNulls(StringView value, char* dest, uint32_t prefixLength) const {
+    const uint32_t copySize = std::min<uint32_t>(value.size(), prefixLength);
+    std::memcpy(dest, value.data(), copySize);
+    simd::memset(dest + copySize, 0, prefixLength - copySize);
+    if (!ascending_) {
+      for (uint32_t i = 0; i < prefixLength; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -67,9 +99,11 @@ class PrefixSortEncoder {
   }
 
   /// @return For supported types, returns the encoded size, assume nullable.
-  ///         For not supported types, returns 'std::nullopt'.
+  ///         For not supported types, returns 'std::nullopt'. Strings are
+  ///         encoded to 'stringPrefixLength' bytes plus the null byte.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
-      TypeKind typeKind) {
+      TypeKind typeKind,
+      uint32_t stringPrefixLength = 0) {
     switch ((typeKind)) {
       case ::facebook::velox::TypeKind::INTEGER: {
         return 5;
@@ -86,6 +120,13 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::VARCHAR:
+      case ::facebook::velox::TypeKind::VARBINARY: {
+        if (stringPrefixLength == 0) {
+          return std::nullopt;
+        }
+        return 1 + stringPrefixLength;
+      }
       default:
         return std::nullopt;
     }
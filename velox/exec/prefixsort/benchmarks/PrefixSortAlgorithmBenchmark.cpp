@@ -39,21 +39,45 @@ class PrefixSortAlgorithmBenchmark {
     auto sortRunner =
         prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
     sortRunner.quickSort(
-        start, start + entrySize * vec.size(), [&](char* a, char* b) {
-          return memcmp(a, b, 8);
+        start, start + entrySize * vec.size(), [](char* a, char* b) {
+          return compare(a, b);
         });
   }
 
+  void runRadixSort(std::vector<int64_t> vec) {
+    char* start = (char*)vec.data();
+    uint32_t entrySize = sizeof(int64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    sortRunner.radixSort(
+        start,
+        start + entrySize * vec.size(),
+        entrySize,
+        [](char* a, char* b) { return compare(a, b); });
+  }
+
+  // Returns normalized keys byte swapped to native order, as PrefixSort
+  // compares them.
   std::vector<int64_t> generateTestVector(int32_t size) {
     std::vector<int64_t> randomTestVec(size);
     std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
       return folly::Random::rand64(rng_);
     });
     prefixsort::test::encodeInPlace(randomTestVec);
+    for (auto& value : randomTestVec) {
+      value = __builtin_bswap64(value);
+    }
     return randomTestVec;
   }
 
  private:
+  static int compare(char* a, char* b) {
+    const auto left = *reinterpret_cast<uint64_t*>(a);
+    const auto right = *reinterpret_cast<uint64_t*>(b);
+    return left < right ? -1 : left == right ? 0 : 1;
+  }
+
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
   folly::Random::DefaultGenerator rng_;
@@ -70,18 +94,34 @@ BENCHMARK(PrefixSort_algorithm_10k) {
   bm->runQuickSort(data10k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_10k) {
+  bm->runRadixSort(data10k);
+}
+
 BENCHMARK(PrefixSort_algorithm_100k) {
   bm->runQuickSort(data100k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_100k) {
+  bm->runRadixSort(data100k);
+}
+
 BENCHMARK(PrefixSort_algorithm_1000k) {
   bm->runQuickSort(data1000k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_1000k) {
+  bm->runRadixSort(data1000k);
+}
+
 BENCHMARK(PrefixSort_algorithm_10000k) {
   bm->runQuickSort(data10000k);
 }
 
+BENCHMARK_RELATIVE(PrefixSort_radix_10000k) {
+  bm->runRadixSort(data10000k);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
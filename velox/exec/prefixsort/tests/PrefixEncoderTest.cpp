@@ -327,6 +327,32 @@ TEST_F(PrefixEncoderTest, encode) {
   }
 }
 
+TEST_F(PrefixEncoderTest, encodeString) {
+  char encoded[5];
+  const std::optional<StringView> value = StringView("abcdef");
+
+  ascNullsFirstEncoder_.encode(value, encoded, 4);
+  ASSERT_EQ(std::memcmp(encoded, "\x01" "abcd", 5), 0);
+  descNullsLastEncoder_.encode(value, encoded, 4);
+  ASSERT_EQ(std::memcmp(encoded, "\x00\x9e\x9d\x9c\x9b", 5), 0);
+
+  // Shorter strings are padded with zero bytes.
+  ascNullsLastEncoder_.encode(std::optional(StringView("ab")), encoded, 4);
+  ASSERT_EQ(std::memcmp(encoded, "\x00" "ab\x00\x00", 5), 0);
+  descNullsFirstEncoder_.encode(std::optional(StringView("ab")), encoded, 4);
+  ASSERT_EQ(std::memcmp(encoded, "\x01\x9e\x9d\xff\xff", 5), 0);
+
+  const std::optional<StringView> nullValue = std::nullopt;
+  ascNullsFirstEncoder_.encode(nullValue, encoded, 4);
+  ASSERT_EQ(std::memcmp(encoded, "\x00\x00\x00\x00\x00", 5), 0);
+  descNullsLastEncoder_.encode(nullValue, encoded, 4);
+  ASSERT_EQ(std::memcmp(encoded, "\x01\x00\x00\x00\x00", 5), 0);
+
+  ASSERT_EQ(PrefixSortEncoder::encodedSize(TypeKind::VARCHAR, 12), 13);
+  ASSERT_EQ(PrefixSortEncoder::encodedSize(TypeKind::VARBINARY, 12), 13);
+  ASSERT_FALSE(PrefixSortEncoder::encodedSize(TypeKind::VARCHAR).has_value());
+}
+
 TEST_F(PrefixEncoderTest, compare) {
   testCompare<uint64_t>();
   testCompare<uint32_t>();
@@ -70,6 +70,51 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  // Entries are a key word followed by a payload word. The compare breaks
+  // ties on the payload.
+  auto test = [&](size_t size, uint64_t keyMask) {
+    std::vector<uint64_t> data(size * 2);
+    for (auto i = 0; i < size; ++i) {
+      data[2 * i] = folly::Random::rand64() & keyMask;
+      data[2 * i + 1] = folly::Random::rand64();
+    }
+    std::vector<std::pair<uint64_t, uint64_t>> expected(size);
+    for (auto i = 0; i < size; ++i) {
+      expected[i] = {data[2 * i], data[2 * i + 1]};
+    }
+    std::sort(expected.begin(), expected.end());
+
+    const uint32_t entrySize = 2 * sizeof(uint64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+    PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+    char* start = reinterpret_cast<char*>(data.data());
+    char* end = start + entrySize * size;
+    sortRunner.radixSort(start, end, sizeof(uint64_t), [](char* a, char* b) {
+          auto* left = reinterpret_cast<uint64_t*>(a);
+          auto* right = reinterpret_cast<uint64_t*>(b);
+          if (left[0] != right[0]) {
+            return left[0] < right[0] ? -1 : 1;
+          }
+          return left[1] < right[1] ? -1 : left[1] == right[1] ? 0 : 1;
+        });
+
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(data[2 * i], expected[i].first) << i;
+      ASSERT_EQ(data[2 * i + 1], expected[i].second) << i;
+    }
+  };
+
+  test(PrefixSortRunner::kSmallRadixSort - 1, ~0ULL);
+  test(PrefixSortRunner::kSmallRadixSort, ~0ULL);
+  test(10'000, ~0ULL);
+  // Keys that differ in only a few bytes, with many duplicates.
+  test(10'000, 0xff00ff0000000000ULL);
+  test(10'000, 0x0000000000000f0fULL);
+  // All keys equal.
+  test(1'000, 0);
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
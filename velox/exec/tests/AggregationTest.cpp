@@ -25,7 +25,9 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashAggregation.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/RollupAggregation.h"
 #include "velox/exec/Values.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -955,6 +957,253 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, streamingPartialAggregation) {
+  // Three quarters of the rows hit 8 hot keys, the rest are unique. The
+  // partial aggregation does not reduce enough to be kept as is but the hot
+  // keys are worth combining.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) {
+              return row % 4 == 0 ? 1'000'000 + i * 1'000 + row : row % 8;
+            }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto streamingMemory : {0, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("streamingMemory {}", streamingMemory));
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 500)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 20)
+            .config(
+                QueryConfig::kStreamingPartialAggregationMemory,
+                std::to_string(streamingMemory))
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+    const auto& stats = toPlanStats(task->taskStats()).at(aggNodeId);
+    if (streamingMemory == 0) {
+      EXPECT_EQ(1, stats.customStats.count("abandonedPartialAggregation"));
+      EXPECT_EQ(0, stats.customStats.count("streamingPartialAggregation"));
+    } else {
+      EXPECT_EQ(0, stats.customStats.count("abandonedPartialAggregation"));
+      EXPECT_EQ(1, stats.customStats.at("streamingPartialAggregation").sum);
+      // Every flush removes at least the duplicates of the hot keys.
+      EXPECT_LT(
+          stats.customStats.at("streamingPartialAggregationPct").max, 90);
+      EXPECT_LT(stats.outputRows, stats.inputRows / 2);
+    }
+  }
+}
+
+TEST_F(AggregationTest, columnarAccumulators) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 3'001; }),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return row; }, nullEvery(7)),
+        makeFlatVector<double>(
+            1'000, [](auto row) { return row * 0.5; }, nullEvery(11)),
+        makeFlatVector<StringView>(
+            1'000,
+            [](auto row) {
+              return StringView::makeInline(std::to_string(row));
+            }),
+        makeFlatVector<bool>(1'000, [](auto row) { return row % 3 == 0; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // min(c3) has a variable-width accumulator and stays in the group rows.
+  const std::vector<std::string> aggregates = {
+      "sum(c1)",
+      "count(c1)",
+      "min(c1)",
+      "max(c1)",
+      "avg(c2)",
+      "sum(c2)",
+      "min(c3)",
+      "count(1)"};
+  const std::string sql =
+      "SELECT c0, sum(c1), count(c1), min(c1), max(c1), avg(c2), sum(c2), "
+      "min(c3), count(1) FROM tmp GROUP BY c0";
+
+  for (const auto minAggregates : {0, 1, 4}) {
+    SCOPED_TRACE(fmt::format("minAggregates {}", minAggregates));
+    const auto minAggregatesConfig = std::to_string(minAggregates);
+
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(
+            QueryConfig::kColumnarAccumulatorsMinAggregates,
+            minAggregatesConfig)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, aggregates)
+                  .planNode())
+        .assertResults(sql);
+
+    // Small partial aggregation memory makes the partial aggregation flush
+    // and reuse the columnar accumulators.
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(
+            QueryConfig::kColumnarAccumulatorsMinAggregates,
+            minAggregatesConfig)
+        .config(QueryConfig::kMaxPartialAggregationMemory, "100000")
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, aggregates)
+                  .finalAggregation()
+                  .planNode())
+        .assertResults(sql);
+
+    // Masked aggregates over the columnar accumulators.
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(
+            QueryConfig::kColumnarAccumulatorsMinAggregates,
+            minAggregatesConfig)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)", "count(c1)", "max(c2)", "count(1)"},
+                      {"c4", "", "c4", ""})
+                  .planNode())
+        .assertResults(
+            "SELECT c0, sum(c1) FILTER (WHERE c4), count(c1), "
+            "max(c2) FILTER (WHERE c4), count(1) FROM tmp GROUP BY c0");
+  }
+}
+
+TEST_F(AggregationTest, concurrentAggregation) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 3'001; }),
+        makeFlatVector<int64_t>(
+            1'000, [](auto row) { return row; }, nullEvery(7)),
+        makeFlatVector<StringView>(
+            1'000,
+            [](auto row) {
+              return StringView::makeInline(std::to_string(row % 101));
+            }),
+    }));
+  }
+  // Each Driver reads all the vectors.
+  constexpr int32_t kNumDrivers = 4;
+  std::vector<RowVectorPtr> duckDbVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    duckDbVectors.insert(duckDbVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(duckDbVectors);
+
+  struct {
+    std::vector<std::string> keys;
+    std::string sql;
+
+    std::string debugString() const {
+      return fmt::format("keys {}", folly::join(", ", keys));
+    }
+  } testSettings[] = {
+      {{"c0"},
+       "SELECT c0, sum(c1), count(1), min(c2), avg(c1) FROM tmp GROUP BY c0"},
+      {{"c2"},
+       "SELECT c2, sum(c1), count(1), min(c2), avg(c1) FROM tmp GROUP BY c2"},
+      {{"c0", "c2"},
+       "SELECT c0, c2, sum(c1), count(1), min(c2), avg(c1) FROM tmp "
+       "GROUP BY c0, c2"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    for (const auto enabled : {false, true}) {
+      SCOPED_TRACE(fmt::format("enabled {}", enabled));
+      core::PlanNodeId aggNodeId;
+      auto task =
+          AssertQueryBuilder(duckDbQueryRunner_)
+              .config(
+                  QueryConfig::kConcurrentAggregationEnabled,
+                  enabled ? "true" : "false")
+              .maxDrivers(kNumDrivers)
+              .plan(PlanBuilder()
+                        .values(vectors, true)
+                        .singleAggregation(
+                            testData.keys,
+                            {"sum(c1)", "count(1)", "min(c2)", "avg(c1)"})
+                        .capturePlanNodeId(aggNodeId)
+                        .planNode())
+              .assertResults(testData.sql);
+      const auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+      ASSERT_EQ(
+          stats.customStats.count(HashAggregation::kSharedTableLockConflicts),
+          enabled ? 1 : 0);
+    }
+  }
+
+  // Partial aggregation keeps a table per Driver.
+  core::PlanNodeId aggNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .config(QueryConfig::kConcurrentAggregationEnabled, "true")
+                  .maxDrivers(kNumDrivers)
+                  .plan(PlanBuilder()
+                            .values(vectors, true)
+                            .partialAggregation({"c0"}, {"sum(c1)"})
+                            .capturePlanNodeId(aggNodeId)
+                            .localPartition({"c0"})
+                            .finalAggregation()
+                            .planNode())
+                  .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY c0");
+  ASSERT_EQ(
+      toPlanStats(task->taskStats())
+          .at(aggNodeId)
+          .customStats.count(HashAggregation::kSharedTableLockConflicts),
+      0);
+}
+
+TEST_F(AggregationTest, hashTableGrowthEstimation) {
+  // Every row is a new group and the keys are too sparse for an array table.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 100; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (i * 1'000 + row) * 1'000'003L; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto numRehashes = [&](int32_t estimationBatches) {
+    core::PlanNodeId aggNodeId;
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .config(
+                        QueryConfig::kHashTableGrowthEstimationBatches,
+                        std::to_string(estimationBatches))
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .singleAggregation({"c0"}, {"sum(c1)"})
+                              .capturePlanNodeId(aggNodeId)
+                              .planNode())
+                    .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY c0");
+    const auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+    EXPECT_EQ(stats.customStats.count(BaseHashTable::kRehashWallNanos), 1);
+    return stats.customStats.at(BaseHashTable::kNumRehashes).max;
+  };
+  ASSERT_LT(numRehashes(2), numRehashes(0));
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1410,6 +1659,132 @@ TEST_F(AggregationTest, groupingSetsSameKey) {
       "select o_key, o_key as o_key_1, o_status FROM tmp) GROUP BY GROUPING SETS ((o_key, o_key_1), (o_key), (o_key_1), ())");
 }
 
+TEST_F(AggregationTest, groupingSetsRollup) {
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 4; ++i) {
+    data.push_back(makeRowVector(
+        {"k1", "k2", "k3", "a", "b"},
+        {
+            makeFlatVector<int64_t>(
+                size, [](auto row) { return row % 11; }, nullEvery(13)),
+            makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+            makeFlatVector<std::string>(
+                size,
+                [](auto row) { return std::string(row % 5, 'x'); },
+                nullEvery(17)),
+            makeFlatVector<int64_t>(
+                size, [i](auto row) { return row * i; }, nullEvery(5)),
+            makeFlatVector<double>(size, [](auto row) { return row * 0.1; }),
+        }));
+  }
+  createDuckDbTable(data);
+
+  const std::vector<std::string> keys = {"k1", "k2", "k3"};
+  const std::vector<std::string> aggregates = {
+      "count(1) as cnt",
+      "sum(a) as sum_a",
+      "max(a) as max_a",
+      "avg(b) as avg_b",
+      "min(b) as min_b"};
+  const std::vector<std::string> projections = {
+      "k1", "k2", "k3", "cnt", "sum_a", "max_a", "avg_b", "min_b"};
+
+  struct {
+    std::vector<std::vector<std::string>> groupingSets;
+    std::string groupBySql;
+  } testSettings[] = {
+      {{{"k1", "k2", "k3"},
+        {"k1", "k2"},
+        {"k1", "k3"},
+        {"k2", "k3"},
+        {"k1"},
+        {"k2"},
+        {"k3"},
+        {}},
+       "CUBE (k1, k2, k3)"},
+      {{{"k1", "k2", "k3"}, {"k1", "k2"}, {"k1"}, {}}, "ROLLUP (k1, k2, k3)"},
+      {{{"k1"}, {"k3"}}, "GROUPING SETS ((k1), (k3))"},
+  };
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.groupBySql);
+    const auto sql = fmt::format(
+        "SELECT k1, k2, k3, count(1), sum(a), max(a), avg(b), min(b) "
+        "FROM tmp GROUP BY {}",
+        testData.groupBySql);
+
+    for (const auto rollupEnabled : {true, false}) {
+      SCOPED_TRACE(fmt::format("rollupEnabled: {}", rollupEnabled));
+      core::PlanNodeId aggNodeId;
+      auto plan = PlanBuilder()
+                      .values(data)
+                      .groupId(keys, testData.groupingSets, {"a", "b"})
+                      .singleAggregation(
+                          {"k1", "k2", "k3", "group_id"}, aggregates)
+                      .capturePlanNodeId(aggNodeId)
+                      .project(projections)
+                      .planNode();
+      auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                      .config(
+                          QueryConfig::kAggregationRollupEnabled,
+                          rollupEnabled ? "true" : "false")
+                      .assertResults(sql);
+      auto stats = toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+      if (rollupEnabled) {
+        // The 4'000 input rows have less than 1'000 distinct keys.
+        EXPECT_GT(stats.at(RollupAggregation::kRollupInputRows).sum, 0);
+        EXPECT_GT(stats.at(RollupAggregation::kRollupSavedInputRows).sum, 0);
+      } else {
+        EXPECT_EQ(stats.count(RollupAggregation::kRollupInputRows), 0);
+      }
+
+      // Partial aggregation with an artificially low memory limit.
+      plan = PlanBuilder()
+                 .values(data)
+                 .groupId(keys, testData.groupingSets, {"a", "b"})
+                 .partialAggregation({"k1", "k2", "k3", "group_id"}, aggregates)
+                 .capturePlanNodeId(aggNodeId)
+                 .finalAggregation()
+                 .project(projections)
+                 .planNode();
+      task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                 .config(
+                     QueryConfig::kAggregationRollupEnabled,
+                     rollupEnabled ? "true" : "false")
+                 .config(QueryConfig::kMaxPartialAggregationMemory, "1")
+                 .assertResults(sql);
+      stats = toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+      if (rollupEnabled) {
+        EXPECT_GT(stats.at(RollupAggregation::kRollupInputRows).count, 0);
+      }
+    }
+  }
+
+  // Aggregates over grouping keys see nulls for the keys outside of the
+  // grouping set and are not rolled up.
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a"})
+                  .singleAggregation(
+                      {"k1", "k2", "group_id"},
+                      {"sum(a) as sum_a", "count(k2) as count_k2"})
+                  .capturePlanNodeId(aggNodeId)
+                  .project({"k1", "k2", "sum_a", "count_k2"})
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      "SELECT k1, null, sum(a), 0 FROM tmp GROUP BY k1 "
+      "UNION ALL "
+      "SELECT null, k2, sum(a), count(k2) FROM tmp GROUP BY k2");
+  EXPECT_EQ(
+      toPlanStats(task->taskStats())
+          .at(aggNodeId)
+          .customStats.count(RollupAggregation::kRollupInputRows),
+      0);
+}
+
 TEST_F(AggregationTest, groupingSetsEmptyInput) {
   auto data = makeRowVector(
       {"c1", "c2"},
@@ -1837,25 +2212,54 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
   auto spillDirectory = exec::test::TempDirectoryPath::create();
+
   core::PlanNodeId aggrNodeId;
-  TestScopedSpillInjection scopedSpillInjection(100);
-  auto task =
-      AssertQueryBuilder(duckDbQueryRunner_)
-          .spillDirectory(spillDirectory->getPath())
-          .config(QueryConfig::kSpillEnabled, true)
-          .config(QueryConfig::kAggregationSpillEnabled, true)
-          .plan(PlanBuilder()
-                    .values(vectors)
-                    .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
-                    .capturePlanNodeId(aggrNodeId)
-                    .planNode())
-          .assertResults("SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
-  const auto& queryConfig = task->queryCtx()->queryConfig();
-  ASSERT_TRUE(queryConfig.spillEnabled());
-  ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
-  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+
+  auto testPlan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    SCOPED_TRACE(sql);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .plan(plan)
+                    .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    checkSpillStats(stats, true);
+    ASSERT_GT(
+        stats.customStats.at(HashAggregation::kDistinctAggregationSpilledBytes)
+            .sum,
+        0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  testPlan(plan, "SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
+
+  // Several distinct aggregations over integer and string inputs next to a
+  // regular aggregate.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c1 % 7 AS k", "c0 % 100 AS v", "c6"})
+             .singleAggregation(
+                 {"k"},
+                 {"count(DISTINCT v)",
+                  "count(DISTINCT c6)",
+                  "sum(DISTINCT v)",
+                  "count(v)"},
+                 {})
+             .capturePlanNodeId(aggrNodeId)
+             .planNode();
+  testPlan(
+      plan,
+      "SELECT c1 % 7, count(DISTINCT c0 % 100), count(DISTINCT c6), "
+      "sum(DISTINCT c0 % 100), count(c0 % 100) FROM tmp GROUP BY 1");
 }
 
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
@@ -1878,6 +2282,10 @@ TEST_F(AggregationTest, spillingForAggrsWithSorting) {
     auto taskStats = exec::toPlanStats(task->taskStats());
     auto& stats = taskStats.at(aggrNodeId);
     checkSpillStats(stats, true);
+    ASSERT_GT(
+        stats.customStats.at(HashAggregation::kSortedAggregationSpilledBytes)
+            .sum,
+        0);
     OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
   };
 
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/CompressedRowVector.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class CompressedRowVectorTest : public testing::Test,
+                                public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    if (!isRegisteredVectorSerde()) {
+      serializer::presto::PrestoVectorSerde::registerVectorSerde();
+    }
+  }
+};
+
+TEST_F(CompressedRowVectorTest, roundTrip) {
+  constexpr vector_size_t kSize = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 17; }),
+      makeFlatVector<StringView>(
+          kSize,
+          [](auto row) {
+            return StringView::makeInline(fmt::format("value {}", row % 5));
+          },
+          nullEvery(7)),
+      makeArrayVector<int32_t>(
+          kSize,
+          [](auto row) { return row % 3; },
+          [](auto row, auto index) { return row + index; }),
+      makeFlatVector<Timestamp>(
+          kSize, [](auto row) { return Timestamp(row, 123'456); }),
+  });
+
+  for (const auto kind :
+       {common::CompressionKind_NONE,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_LZ4}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    auto compressed = CompressedRowVector::compress(data, kind, pool());
+    ASSERT_EQ(compressed->size(), kSize);
+    ASSERT_EQ(compressed->rawBytes(), data->retainedSize());
+    if (kind != common::CompressionKind_NONE) {
+      ASSERT_LT(compressed->compressedBytes(), compressed->rawBytes());
+    }
+    test::assertEqualVectors(data, compressed->decompress(pool()));
+    // A compressed vector can be decompressed any number of times.
+    test::assertEqualVectors(data, compressed->decompress(pool()));
+  }
+}
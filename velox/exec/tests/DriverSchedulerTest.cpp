@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <folly/ScopeGuard.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/process/ProcessBase.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class DriverSchedulerTest : public OperatorTestBase {
+ protected:
+  static constexpr uint64_t kSecNanos = 1'000'000'000;
+
+  // Spins on thread for at least 'nanos' of CPU time.
+  static void burnCpu(uint64_t nanos) {
+    const auto start = process::threadCpuNanos();
+    while (process::threadCpuNanos() - start < nanos) {
+    }
+  }
+
+  static MultiLevelDriverScheduler::Options options(uint32_t numThreads) {
+    MultiLevelDriverScheduler::Options options;
+    options.numThreads = numThreads;
+    options.levelThresholdNanos = {kSecNanos, 10 * kSecNanos};
+    return options;
+  }
+
+  // Waits up to 10s for 'count' to become 'expected'.
+  static bool waitFor(const std::atomic<int32_t>& count, int32_t expected) {
+    for (auto i = 0; i < 10'000 && count != expected; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return count == expected;
+  }
+};
+
+TEST_F(DriverSchedulerTest, levelForCpuTime) {
+  MultiLevelDriverScheduler scheduler(options(1));
+  ASSERT_EQ(scheduler.levelForCpuTime(0), 0);
+  ASSERT_EQ(scheduler.levelForCpuTime(kSecNanos - 1), 0);
+  ASSERT_EQ(scheduler.levelForCpuTime(kSecNanos), 1);
+  ASSERT_EQ(scheduler.levelForCpuTime(10 * kSecNanos), 2);
+  ASSERT_EQ(scheduler.levelForCpuTime(1'000 * kSecNanos), 2);
+  ASSERT_EQ(scheduler.stats().levelCpuNanos.size(), 3);
+
+  auto badOptions = options(1);
+  badOptions.levelThresholdNanos = {10 * kSecNanos, kSecNanos};
+  VELOX_ASSERT_THROW(MultiLevelDriverScheduler{badOptions}, "");
+}
+
+TEST_F(DriverSchedulerTest, shortQueryFirst) {
+  MultiLevelDriverScheduler scheduler(options(1));
+  auto longQueryCtx = core::QueryCtx::create();
+  longQueryCtx->addDriverCpuTimeNanos(20 * kSecNanos);
+  auto shortQueryCtx = core::QueryCtx::create();
+
+  // Keep the only thread busy with a run of the long query while the others
+  // are enqueued.
+  folly::Baton<> started;
+  folly::Baton<> release;
+  scheduler.add(longQueryCtx, [&]() {
+    started.post();
+    release.wait();
+    burnCpu(10'000'000);
+  });
+  started.wait();
+
+  std::mutex mutex;
+  std::vector<std::string> order;
+  std::atomic<int32_t> numDone{0};
+  for (auto i = 0; i < 3; ++i) {
+    scheduler.add(longQueryCtx, [&]() {
+      std::lock_guard<std::mutex> l(mutex);
+      order.push_back("long");
+      ++numDone;
+    });
+  }
+  for (auto i = 0; i < 3; ++i) {
+    scheduler.add(shortQueryCtx, [&]() {
+      std::lock_guard<std::mutex> l(mutex);
+      order.push_back("short");
+      ++numDone;
+    });
+  }
+  release.post();
+  ASSERT_TRUE(waitFor(numDone, 6));
+
+  const std::vector<std::string> expected{
+      "short", "short", "short", "long", "long", "long"};
+  ASSERT_EQ(order, expected);
+  const auto stats = scheduler.stats();
+  ASSERT_EQ(stats.numRuns, 7);
+  ASSERT_GE(stats.levelCpuNanos[2], 10'000'000);
+  ASSERT_GE(longQueryCtx->driverCpuTimeNanos(), 20 * kSecNanos + 10'000'000);
+}
+
+TEST_F(DriverSchedulerTest, steal) {
+  MultiLevelDriverScheduler scheduler(options(2));
+  auto queryCtx = core::QueryCtx::create();
+
+  folly::Baton<> started;
+  folly::Baton<> release;
+  scheduler.add(queryCtx, [&]() {
+    started.post();
+    release.wait();
+  });
+  started.wait();
+  auto releaseGuard = folly::makeGuard([&]() { release.post(); });
+
+  // Half of the runs are queued on the blocked thread and must be stolen by
+  // the other one.
+  constexpr int32_t kNumRuns = 10;
+  std::atomic<int32_t> numDone{0};
+  for (auto i = 0; i < kNumRuns; ++i) {
+    scheduler.add(queryCtx, [&]() { ++numDone; });
+  }
+  ASSERT_TRUE(waitFor(numDone, kNumRuns));
+  ASSERT_GE(scheduler.stats().numStolen, kNumRuns / 2);
+}
+
+TEST_F(DriverSchedulerTest, task) {
+  auto scheduler = std::make_shared<MultiLevelDriverScheduler>(options(4));
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [](auto row) { return row; })}));
+  }
+  auto plan = PlanBuilder()
+                  .values(data, true)
+                  .filter("c0 % 10 = 0")
+                  .project({"c0 * 2"})
+                  .planFragment();
+
+  auto queryCtx = core::QueryCtx::create();
+  std::atomic<int64_t> numRows{0};
+  auto task = Task::create(
+      "DriverSchedulerTest.task",
+      plan,
+      0,
+      queryCtx,
+      Task::ExecutionMode::kParallel,
+      [&](RowVectorPtr output, ContinueFuture* /*unused*/) {
+        if (output != nullptr) {
+          numRows += output->size();
+        }
+        return BlockingReason::kNotBlocked;
+      });
+  task->setDriverScheduler(scheduler);
+  ASSERT_EQ(task->driverScheduler(), scheduler.get());
+  task->start(4);
+  ASSERT_TRUE(waitForTaskCompletion(task.get(), 10'000'000));
+
+  ASSERT_EQ(numRows, 4 * 10 * 100);
+  ASSERT_GE(scheduler->stats().numRuns, 4);
+  ASSERT_GT(queryCtx->driverCpuTimeNanos(), 0);
+  task.reset();
+  waitForAllTasksToBeDeleted();
+}
@@ -602,6 +602,38 @@ TEST_F(DriverTest, pause) {
   EXPECT_EQ(operators[1].outputPositions, 10 * hits);
 }
 
+TEST_F(DriverTest, hardwareCounters) {
+  if (!process::PerfCounters::forThread()) {
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .project({"c0 * 7 + 1 AS c1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  auto countersOf = [&](bool enabled) {
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(
+            core::QueryConfig::kOperatorTrackHardwareCounters,
+            enabled ? "true" : "false")
+        .copyResults(pool(), task);
+    return toPlanStats(task->taskStats()).at(projectId).customStats;
+  };
+
+  auto customStats = countersOf(true);
+  EXPECT_LT(0, customStats.at(Operator::kHwCycles).sum);
+  EXPECT_LT(0, customStats.at(Operator::kHwInstructions).sum);
+  EXPECT_EQ(1, customStats.count(Operator::kHwCacheMisses));
+  EXPECT_EQ(1, customStats.count(Operator::kHwBranchMisses));
+
+  EXPECT_EQ(0, countersOf(false).count(Operator::kHwCycles));
+}
+
 TEST_F(DriverTest, yield) {
   constexpr int32_t kNumTasks = 20;
   constexpr int32_t kThreadsPerTask = 5;
@@ -1055,6 +1087,89 @@ class BlockedNoFutureNodeFactory : public Operator::PlanNodeTranslator {
     return 1;
   }
 };
+
+// Passes its input through and wants to reserve a fixed amount of memory
+// before each input.
+class ReserveNode : public core::PlanNode {
+ public:
+  ReserveNode(
+      const core::PlanNodeId& id,
+      uint64_t reservationBytes,
+      const core::PlanNodePtr& input)
+      : PlanNode(id), reservationBytes_(reservationBytes), sources_{input} {}
+
+  const RowTypePtr& outputType() const override {
+    return sources_[0]->outputType();
+  }
+
+  const std::vector<std::shared_ptr<const PlanNode>>& sources() const override {
+    return sources_;
+  }
+
+  std::string_view name() const override {
+    return "Reserve";
+  }
+
+  uint64_t reservationBytes() const {
+    return reservationBytes_;
+  }
+
+ private:
+  void addDetails(std::stringstream& /* stream */) const override {}
+
+  const uint64_t reservationBytes_;
+  std::vector<core::PlanNodePtr> sources_;
+};
+
+class ReserveOperator : public Operator {
+ public:
+  ReserveOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const std::shared_ptr<const ReserveNode>& node)
+      : Operator(ctx, node->outputType(), id, node->id(), "Reserve"),
+        reservationBytes_(node->reservationBytes()) {}
+
+  bool needsInput() const override {
+    return !noMoreInput_ && !input_;
+  }
+
+  uint64_t inputReservationBytes(const RowVectorPtr& /*input*/) override {
+    return reservationBytes_;
+  }
+
+  void addInput(RowVectorPtr input) override {
+    input_ = std::move(input);
+  }
+
+  RowVectorPtr getOutput() override {
+    return std::move(input_);
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+ private:
+  const uint64_t reservationBytes_;
+};
+
+class ReserveNodeFactory : public Operator::PlanNodeTranslator {
+ public:
+  std::unique_ptr<Operator> toOperator(
+      DriverCtx* ctx,
+      int32_t id,
+      const core::PlanNodePtr& node) override {
+    if (auto reserveNode = std::dynamic_pointer_cast<const ReserveNode>(node)) {
+      return std::make_unique<ReserveOperator>(ctx, id, reserveNode);
+    }
+    return nullptr;
+  }
+};
 } // namespace
 
 // Use a node for which driver factory would throw on any driver beyond id 0.
@@ -1102,6 +1217,107 @@ TEST_F(DriverTest, blockedNoFuture) {
       "by isBlocked method.");
 }
 
+TEST_F(DriverTest, asyncMemoryReservation) {
+  Operator::registerOperator(std::make_unique<ReserveNodeFactory>());
+
+  auto rows = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  // The reservation is larger than the query can ever have, so that it needs
+  // memory arbitration, which fails.
+  constexpr uint64_t kMaxQueryCapacity = 8 << 20;
+  constexpr uint64_t kReservationBytes = 64 << 20;
+  core::PlanNodeId reserveNodeId;
+  auto plan = PlanBuilder()
+                  .values({rows, rows, rows})
+                  .addNode([&](const core::PlanNodeId& id,
+                               const core::PlanNodePtr& input) {
+                    return std::make_shared<ReserveNode>(
+                        id, kReservationBytes, input);
+                  })
+                  .capturePlanNodeId(reserveNodeId)
+                  .planNode();
+
+  for (const bool asyncEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("asyncEnabled {}", asyncEnabled));
+    std::unordered_map<std::string, std::string> queryConfig{
+        {core::QueryConfig::kAsyncMemoryReservationEnabled,
+         asyncEnabled ? "true" : "false"}};
+    auto queryCtx = core::QueryCtx::create(
+        driverExecutor_.get(),
+        core::QueryConfig(std::move(queryConfig)),
+        {},
+        cache::AsyncDataCache::getInstance(),
+        memory::memoryManager()->addRootPool(
+            core::QueryCtx::generatePoolName("asyncMemoryReservation"),
+            kMaxQueryCapacity));
+    auto task = AssertQueryBuilder(plan)
+                    .queryCtx(queryCtx)
+                    .assertResults({rows, rows, rows});
+    const auto stats = toPlanStats(task->taskStats()).at(reserveNodeId);
+    const auto it =
+        stats.customStats.find("blockedWaitForMemoryReservationTimes");
+    if (asyncEnabled) {
+      ASSERT_NE(it, stats.customStats.end());
+      ASSERT_EQ(it->second.sum, 3);
+    } else {
+      ASSERT_EQ(it, stats.customStats.end());
+    }
+    ASSERT_EQ(stats.outputRows, 9);
+  }
+}
+
+DEBUG_ONLY_TEST_F(DriverTest, asyncMemoryReservationOfTerminatedTask) {
+  Operator::registerOperator(std::make_unique<ReserveNodeFactory>());
+
+  auto rows = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  // The reservation is larger than the initial capacity of the query, so that
+  // it is made off the driver thread, and succeeds.
+  constexpr uint64_t kMaxQueryCapacity = 2L << 30;
+  constexpr uint64_t kReservationBytes = 1L << 30;
+  auto plan = PlanBuilder()
+                  .values({rows})
+                  .addNode([&](const core::PlanNodeId& id,
+                               const core::PlanNodePtr& input) {
+                    return std::make_shared<ReserveNode>(
+                        id, kReservationBytes, input);
+                  })
+                  .planNode();
+
+  std::shared_ptr<Task> task;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Values::getOutput",
+      std::function<void(const exec::Values*)>([&](const exec::Values* values) {
+        task = values->testingOperatorCtx()->task();
+      }));
+  // The task terminates and closes the waiting operator while the
+  // reservation is being made.
+  std::atomic<memory::MemoryPool*> reservationPool{nullptr};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::reserveMemoryAsync",
+      std::function<void(memory::MemoryPool*)>([&](memory::MemoryPool* pool) {
+        reservationPool = pool;
+        task->requestAbort();
+      }));
+
+  std::unordered_map<std::string, std::string> queryConfig{
+      {core::QueryConfig::kAsyncMemoryReservationEnabled, "true"}};
+  auto queryCtx = core::QueryCtx::create(
+      driverExecutor_.get(),
+      core::QueryConfig(std::move(queryConfig)),
+      {},
+      cache::AsyncDataCache::getInstance(),
+      memory::memoryManager()->addRootPool(
+          core::QueryCtx::generatePoolName("asyncMemoryReservation"),
+          kMaxQueryCapacity));
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).queryCtx(queryCtx).copyResults(pool()),
+      "Aborted for external error");
+  ASSERT_TRUE(waitForTaskAborted(task.get()));
+  ASSERT_NE(reservationPool.load(), nullptr);
+  // The reservation made after the operator was closed is released.
+  ASSERT_EQ(reservationPool.load()->reservedBytes(), 0);
+  task.reset();
+}
+
 TEST_F(DriverTest, nonVeloxOperatorException) {
   Operator::registerOperator(
       std::make_unique<ThrowNodeFactory>(std::numeric_limits<uint32_t>::max()));
@@ -258,6 +258,15 @@ TEST_F(ExchangeClientTest, flowControl) {
   EXPECT_EQ(30, stats.at("numReceivedPages").sum);
   EXPECT_EQ(page->size(), stats.at("averageReceivedPageBytes").sum);
 
+  // Each source reports its flow control stats and got data requests that fit
+  // in the queue.
+  EXPECT_EQ(tasks.size(), stats.at("sourceWaitForCreditNanos").count);
+  EXPECT_EQ(tasks.size(), stats.at("sourceBytesInFlight").count);
+  const auto& requestBytes = stats.at("sourceRequestBytes");
+  EXPECT_EQ(tasks.size(), requestBytes.count);
+  EXPECT_GE(requestBytes.min, page->size());
+  EXPECT_LE(requestBytes.max, page->size() * 3.5);
+
   for (auto& task : tasks) {
     task->requestCancel();
     bufferManager_->removeTask(task->taskId());
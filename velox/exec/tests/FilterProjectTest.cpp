@@ -325,6 +325,41 @@ TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
   assertQuery(plan, "SELECT c0 < 10 AND c1 < 10, c1 FROM tmp");
 }
 
+TEST_F(FilterProjectTest, filterProjectOverLazy) {
+  // A lazy column referenced by a projection and an identity projection but
+  // not by the filter is loaded only for the rows passing the filter.
+  vector_size_t size = 1'000;
+  auto valueAt = [](auto row) -> int32_t { return row; };
+  auto lazyVectors = makeRowVector({
+      makeFlatVector<int32_t>(size, valueAt),
+      vectorMaker_.lazyFlatVector<int32_t>(size, valueAt),
+      vectorMaker_.lazyFlatVector<int32_t>(size, valueAt),
+  });
+
+  createDuckDbTable({makeRowVector({
+      makeFlatVector<int32_t>(size, valueAt),
+      makeFlatVector<int32_t>(size, valueAt),
+      makeFlatVector<int32_t>(size, valueAt),
+  })});
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({lazyVectors})
+                  .filter("c0 % 10 = 0 OR c2 < 5")
+                  .project({"c0", "c1", "c1 + 1", "c2"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto task = assertQuery(
+      plan, "SELECT c0, c1, c1 + 1, c2 FROM tmp WHERE c0 % 10 = 0 OR c2 < 5");
+
+  const auto stats = toPlanStats(task->taskStats()).at(projectId).customStats;
+  EXPECT_EQ(104, stats.at("lazyLoadedRows.c1").sum);
+  EXPECT_EQ(size, stats.at("lazyInputRows.c1").sum);
+  // c2 is referenced by the filter and projected as is, so all rows load.
+  EXPECT_EQ(size, stats.at("lazyLoadedRows.c2").sum);
+  EXPECT_EQ(size, stats.at("lazyInputRows.c2").sum);
+}
+
 // Verify the optimization of avoiding copy in null propagation does not break
 // the case when the field is shared between multiple parents.
 TEST_F(FilterProjectTest, nestedFieldReferenceSharedChild) {
@@ -363,3 +398,49 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, sharedDriverVectorPool) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  }
+  std::vector<RowVectorPtr> expected;
+  for (auto i = 0; i < 5; ++i) {
+    expected.push_back(makeRowVector({makeArrayVector<int64_t>(
+        100,
+        [](auto /*row*/) { return 2; },
+        [](auto index) { return (index / 2 + 1) * (index % 2 + 1); })}));
+  }
+
+  core::PlanNodeId firstId;
+  core::PlanNodeId secondId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 + 1 AS a"})
+                  .capturePlanNodeId(firstId)
+                  .project({"array_constructor(a, a * 2) AS b"})
+                  .capturePlanNodeId(secondId)
+                  .planNode();
+
+  for (const bool shared : {false, true}) {
+    SCOPED_TRACE(fmt::format("shared: {}", shared));
+    auto task = AssertQueryBuilder(plan)
+                    .config(
+                        core::QueryConfig::kSharedDriverVectorPool,
+                        shared ? "true" : "false")
+                    .assertResults(expected);
+    auto planStats = toPlanStats(task->taskStats());
+    // With a shared pool, only the operator that created it reports the
+    // stats.
+    int32_t numReporting = 0;
+    for (const auto& id : {firstId, secondId}) {
+      const auto& stats = planStats.at(id).customStats;
+      if (stats.count(Operator::kVectorPoolGets) > 0) {
+        ASSERT_GT(stats.at(Operator::kVectorPoolGets).sum, 0);
+        ++numReporting;
+      }
+    }
+    ASSERT_EQ(numReporting, shared ? 1 : 2);
+  }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/FsstSymbolTable.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+namespace {
+std::vector<std::string> makeUrls(int32_t count) {
+  std::vector<std::string> urls;
+  for (auto i = 0; i < count; ++i) {
+    urls.push_back(fmt::format(
+        "https://www.example{}.com/path/{}?utm_source=mail&id={}",
+        i % 3,
+        i % 101,
+        i * 7919));
+  }
+  return urls;
+}
+
+std::string compress(const FsstSymbolTable& table, std::string_view value) {
+  std::string compressed;
+  table.compress(value, compressed);
+  return compressed;
+}
+
+std::string decompress(const FsstSymbolTable& table, std::string_view value) {
+  std::string decompressed;
+  table.decompress(value, decompressed);
+  return decompressed;
+}
+} // namespace
+
+TEST(FsstSymbolTableTest, roundTrip) {
+  auto urls = makeUrls(10'000);
+  auto table = FsstSymbolTable::build({urls.begin(), urls.end()});
+  ASSERT_GT(table->numSymbols(), 0);
+  ASSERT_LE(table->numSymbols(), FsstSymbolTable::kMaxSymbols);
+
+  size_t rawBytes = 0;
+  size_t compressedBytes = 0;
+  for (const auto& url : urls) {
+    auto compressed = compress(*table, url);
+    ASSERT_EQ(decompress(*table, compressed), url);
+    rawBytes += url.size();
+    compressedBytes += compressed.size();
+  }
+  ASSERT_LT(compressedBytes * 2, rawBytes);
+
+  // Strings with bytes not in the sample are escaped.
+  for (const std::string value :
+       {std::string(),
+        std::string("\xff\xfe\x00\x01", 4),
+        std::string(100, 'q')}) {
+    ASSERT_EQ(decompress(*table, compress(*table, value)), value);
+  }
+}
+
+TEST(FsstSymbolTableTest, equality) {
+  // Equal strings have equal compressed forms and different strings have
+  // different compressed forms.
+  auto urls = makeUrls(1'000);
+  auto table = FsstSymbolTable::build({urls.begin(), urls.end()});
+  std::unordered_map<std::string, std::string> compressedToRaw;
+  for (const auto& url : urls) {
+    auto compressed = compress(*table, url);
+    ASSERT_EQ(compressed, compress(*table, url));
+    auto [it, inserted] = compressedToRaw.emplace(compressed, url);
+    ASSERT_EQ(it->second, url);
+  }
+}
+
+TEST(FsstSymbolTableTest, emptySample) {
+  auto table = FsstSymbolTable::build({});
+  ASSERT_EQ(table->numSymbols(), 0);
+  const std::string value = "abc";
+  auto compressed = compress(*table, value);
+  ASSERT_EQ(compressed.size(), 2 * value.size());
+  ASSERT_EQ(decompress(*table, compressed), value);
+}
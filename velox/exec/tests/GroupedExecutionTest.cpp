@@ -754,6 +754,52 @@ TEST_F(GroupedExecutionTest, groupedExecution) {
   EXPECT_EQ(numRead, numSplits * 10'000);
 }
 
+// Splits of a bucketed table without a group go to the split group of their
+// bucket.
+TEST_F(GroupedExecutionTest, bucketSplitGroups) {
+  auto vectors = makeVectors(2, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  const auto makeBucketSplit = [&](int32_t bucket) {
+    return exec::Split(HiveConnectorSplitBuilder(filePath->getPath())
+                           .tableBucketNumber(bucket)
+                           .build());
+  };
+
+  CursorParameters params;
+  params.planNode = tableScanNode(ROW({}, {}));
+  params.maxDrivers = 1;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds.emplace(params.planNode->id());
+  params.numSplitGroups = 2;
+  params.numConcurrentSplitGroups = 1;
+
+  auto cursor = TaskCursor::create(params);
+  auto task = cursor->task();
+  cursor->start();
+
+  task->addSplit("0", makeBucketSplit(3));
+  task->addSplit("0", makeBucketSplit(7));
+  task->addSplit("0", makeBucketSplit(3));
+
+  task->noMoreSplitsForGroup("0", 3);
+  waitForFinishedDrivers(task, 1);
+  EXPECT_EQ(std::unordered_set<int32_t>({3}), getCompletedSplitGroups(task));
+
+  task->noMoreSplitsForGroup("0", 7);
+  waitForFinishedDrivers(task, 2);
+  EXPECT_EQ(
+      std::unordered_set<int32_t>({3, 7}), getCompletedSplitGroups(task));
+  task->noMoreSplits("0");
+
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  EXPECT_EQ(numRead, 3 * 2'000);
+}
+
 TEST_F(GroupedExecutionTest, allGroupSplitsReceivedBeforeTaskStart) {
   // Create source file - we will read from it in 6 splits.
   const size_t numSplits{6};
@@ -540,6 +540,68 @@ TEST_P(HashJoinBridgeTest, multiThreading) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, sharedBuild) {
+  for (const bool cancelBuild : {false, true}) {
+    SCOPED_TRACE(fmt::format("cancelBuild: {}", cancelBuild));
+    const auto key = fmt::format("sharedBuild/{}", cancelBuild);
+    const auto statsBefore = SharedJoinBuildCache::instance().stats();
+
+    auto buildBridge = createJoinBridge();
+    auto probeBridge = createJoinBridge();
+    ASSERT_TRUE(buildBridge->attachSharedBuild(key));
+    // Attaching again from the same Task doesn't change the role.
+    ASSERT_TRUE(buildBridge->attachSharedBuild(key));
+    ASSERT_FALSE(probeBridge->attachSharedBuild(key));
+    ASSERT_EQ(SharedJoinBuildCache::instance().size(), 1);
+    const auto stats = SharedJoinBuildCache::instance().stats();
+    ASSERT_EQ(stats.numBuilds, statsBefore.numBuilds + 1);
+    ASSERT_EQ(stats.numShared, statsBefore.numShared + 1);
+
+    for (auto& bridge : {buildBridge, probeBridge}) {
+      for (int32_t i = 0; i < numBuilders_; ++i) {
+        bridge->addBuilder();
+      }
+      bridge->start();
+    }
+    // The Task probing the shared table waits for the building Task.
+    auto futures = createEmptyFutures(numProbers_);
+    for (int32_t i = 0; i < numProbers_; ++i) {
+      ASSERT_FALSE(probeBridge->tableOrFuture(&futures[i]).has_value());
+      ASSERT_TRUE(futures[i].valid());
+    }
+
+    if (cancelBuild) {
+      buildBridge->cancel();
+      for (int32_t i = 0; i < numProbers_; ++i) {
+        futures[i].wait();
+        VELOX_ASSERT_THROW(
+            probeBridge->tableOrFuture(&futures[i]),
+            "The task building the shared hash join table was cancelled");
+      }
+    } else {
+      auto table = createFakeHashTable();
+      auto* rawTable = table.get();
+      buildBridge->setHashTable(std::move(table), {}, false);
+      // Cancelling after the table is published has no effect on the other
+      // Tasks.
+      buildBridge->cancel();
+      for (int32_t i = 0; i < numProbers_; ++i) {
+        futures[i].wait();
+        auto result = probeBridge->tableOrFuture(&futures[i]);
+        ASSERT_TRUE(result.has_value());
+        ASSERT_EQ(result->table.get(), rawTable);
+        ASSERT_FALSE(result->hasNullKeys);
+      }
+    }
+
+    // The entry is gone with the last bridge attached to it.
+    buildBridge.reset();
+    ASSERT_EQ(SharedJoinBuildCache::instance().size(), 1);
+    probeBridge.reset();
+    ASSERT_EQ(SharedJoinBuildCache::instance().size(), 0);
+  }
+}
+
 TEST_P(HashJoinBridgeTest, isHashJoinMemoryPools) {
   auto root = memory::memoryManager()->addRootPool("isHashBuildMemoryPool");
   struct {
@@ -4177,6 +4177,243 @@ TEST_F(HashJoinTest, lazyVectorPartiallyLoadedInFilterLeftSemiFilter) {
       "SELECT t.c1, t.c2 FROM t WHERE c0 IN (SELECT u.c0 FROM u WHERE t.c0 = u.c0 AND NOT (t.c1 < 15 AND t.c2 >= 0))");
 }
 
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  auto probeVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row + batch; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    });
+  });
+  auto buildVectors = makeBatches(3, [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            300, [&](auto row) { return row * 3 + batch * 900; }),
+        makeFlatVector<int64_t>(
+            300, [](auto row) { return row; }, nullEvery(11)),
+        makeFlatVector<StringView>(300, [](auto row) {
+          return StringView::makeInline(fmt::format("{:010}", row));
+        }),
+    });
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    core::JoinType joinType;
+    std::string filter;
+    std::string referenceQuery;
+    // True if the varchar build side column is never loaded.
+    bool notLoaded;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "u1 % 7 = 0",
+       "SELECT t.c0, t.c1, u.c1, u.c2 FROM t, u "
+       "WHERE t.c0 = u.c0 AND u.c1 % 7 = 0",
+       false},
+      {core::JoinType::kLeft,
+       "u1 % 7 = 0",
+       "SELECT t.c0, t.c1, u.c1, u.c2 FROM t LEFT JOIN u ON t.c0 = u.c0 "
+       "WHERE u.c1 % 7 = 0",
+       false},
+      {core::JoinType::kInner,
+       "u1 < 0",
+       "SELECT t.c0, t.c1, u.c1, u.c2 FROM t, u "
+       "WHERE t.c0 = u.c0 AND u.c1 < 0",
+       true},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.filter);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .project({"c0 AS u0", "c1 AS u1", "c2 AS u2"})
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u1", "u2"},
+                        testData.joinType)
+                    .capturePlanNodeId(joinId)
+                    .filter(testData.filter)
+                    .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .injectSpill(false)
+        .config(core::QueryConfig::kHashProbeLazyBuildColumns, "true")
+        .referenceQuery(testData.referenceQuery)
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          const auto& joinStats = planStats.at(joinId).customStats;
+          const auto numLazy = joinStats.at("lazyBuildColumns").sum;
+          ASSERT_GT(numLazy, 0);
+          // 'u1' is loaded by the filter for every batch, 'u2' only if some
+          // rows pass.
+          const auto numNotLoaded =
+              joinStats.at("lazyBuildColumnsNotLoaded").sum;
+          if (testData.notLoaded) {
+            ASSERT_EQ(numNotLoaded, numLazy / 2);
+          } else {
+            ASSERT_LT(numNotLoaded, numLazy / 2);
+          }
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, sharedBuild) {
+  auto probeVectors = makeBatches(3, [&](int32_t batch) {
+    return makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return batch * 1'000 + row; })});
+  });
+  auto buildVectors = makeBatches(2, [&](int32_t batch) {
+    return makeRowVector({makeFlatVector<int64_t>(
+        500, [&](auto row) { return batch * 1'500 + row * 3; })});
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .project({"c0 AS u0"})
+                          .planNode(),
+                      "",
+                      {"c0", "u0"})
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+
+  // The Tasks of a query on a worker share the QueryCtx.
+  std::unordered_map<std::string, std::string> config{
+      {core::QueryConfig::kSharedHashJoinBuildNodeIds, joinId}};
+  auto queryCtx = core::QueryCtx::create(
+      driverExecutor_.get(),
+      core::QueryConfig(std::move(config)),
+      {},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      nullptr,
+      "sharedBuild");
+  const auto statsBefore = SharedJoinBuildCache::instance().stats();
+
+  constexpr int32_t kNumTasks = 3;
+  std::mutex mutex;
+  std::vector<RowVectorPtr> results;
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (int32_t i = 0; i < kNumTasks; ++i) {
+    tasks.push_back(Task::create(
+        fmt::format("sharedBuild.{}", i),
+        core::PlanFragment{plan},
+        0,
+        queryCtx,
+        Task::ExecutionMode::kParallel,
+        [&](RowVectorPtr output, ContinueFuture* /*unused*/) {
+          if (output != nullptr) {
+            auto copy = BaseVector::create<RowVector>(
+                output->type(), output->size(), pool_.get());
+            copy->copy(output.get(), 0, 0, output->size());
+            std::lock_guard<std::mutex> l(mutex);
+            results.push_back(std::move(copy));
+          }
+          return BlockingReason::kNotBlocked;
+        }));
+    tasks.back()->start(1);
+  }
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  }
+  assertResults(
+      results,
+      plan->outputType(),
+      fmt::format(
+          "SELECT t.c0, u.c0 FROM t, u, range({}) WHERE t.c0 = u.c0",
+          kNumTasks),
+      duckDbQueryRunner_);
+
+  // The first Task builds the table, the others drop their build side input.
+  const auto stats = SharedJoinBuildCache::instance().stats();
+  ASSERT_EQ(stats.numBuilds, statsBefore.numBuilds + 1);
+  ASSERT_EQ(stats.numShared, statsBefore.numShared + kNumTasks - 1);
+  for (int32_t i = 0; i < kNumTasks; ++i) {
+    const auto planStats = toPlanStats(tasks[i]->taskStats());
+    const auto& joinStats = planStats.at(joinId).customStats;
+    if (i == 0) {
+      ASSERT_EQ(joinStats.at(HashBuild::kSharedTableBuilds).sum, 1);
+      ASSERT_EQ(joinStats.count(HashBuild::kSharedTableDroppedRows), 0);
+    } else {
+      ASSERT_EQ(joinStats.count(HashBuild::kSharedTableBuilds), 0);
+      ASSERT_EQ(joinStats.at(HashBuild::kSharedTableDroppedRows).sum, 1'000);
+    }
+  }
+}
+
+TEST_F(HashJoinTest, heavyHitterKeys) {
+  auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; })});
+  });
+  // Half of the build rows have key 0.
+  auto buildVectors = makeBatches(4, [&](int32_t batch) {
+    return makeRowVector({makeFlatVector<int64_t>(1'000, [&](auto row) {
+      return row % 2 == 0 ? 0 : batch * 1'000 + row;
+    })});
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .project({"c0 AS u0"})
+                          .planNode(),
+                      "",
+                      {"c0"},
+                      core::JoinType::kInner)
+                  .capturePlanNodeId(joinId)
+                  .planNode();
+
+  for (const auto sketchSize : {0, 32}) {
+    SCOPED_TRACE(fmt::format("sketchSize: {}", sketchSize));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .injectSpill(false)
+        .config(
+            core::QueryConfig::kHashBuildHeavyHitterSketchSize,
+            std::to_string(sketchSize))
+        .referenceQuery("SELECT t.c0 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          const auto& joinStats = planStats.at(joinId).customStats;
+          if (sketchSize == 0) {
+            ASSERT_EQ(joinStats.count("heavyHitterKeys"), 0);
+            return;
+          }
+          // Only the last build operator reports the stats.
+          ASSERT_EQ(joinStats.at("heavyHitterKeys").count, 1);
+          ASSERT_EQ(joinStats.at("heavyHitterKeys").sum, 1);
+          ASSERT_GE(joinStats.at("topKeyRowsPct").sum, 40);
+          ASSERT_LE(joinStats.at("topKeyRowsPct").sum, 50);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFilters) {
   const int32_t numSplits = 10;
   const int32_t numRowsProbe = 333;
@@ -4871,6 +5108,169 @@ TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
       .run();
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 5;
+  const int32_t numProbeRows = 10'000;
+  // More distinct sparse keys than VectorHasher tracks, so no IN-list filter
+  // can be made.
+  const int32_t numBuildRows = 120'000;
+  const int64_t kStride = 1'000'003;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    // Every 10th probe key has a match.
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numProbeRows,
+            [&](auto row) {
+              const int64_t key = (i * numProbeRows + row) * 2;
+              return row % 10 == 0 ? key * kStride : key * kStride + 1;
+            }),
+        makeFlatVector<int64_t>(numProbeRows, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    buildVectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        numBuildRows / 4,
+        [&](auto row) { return (i * numBuildRows / 4 + row) * kStride; })}));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId joinId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(ROW({"c0", "c1"}, {BIGINT(), BIGINT()}))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .project({"c0 AS u_c0"})
+                        .planNode(),
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinId)
+                .planNode();
+
+  for (const auto maxSize : {0, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("maxSize: {}", maxSize));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .makeInputSplits([&] {
+          std::vector<exec::Split> probeSplits;
+          for (auto& file : tempFiles) {
+            probeSplits.push_back(
+                exec::Split(makeHiveConnectorSplit(file->getPath())));
+          }
+          SplitInput splits;
+          splits.emplace(probeScanId, probeSplits);
+          return splits;
+        })
+        .injectSpill(false)
+        .config(
+            core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+            std::to_string(maxSize))
+        .referenceQuery("SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          const auto& scanStats = planStats.at(probeScanId).customStats;
+          if (maxSize == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(scanStats.count("dynamicFilterPrunedRows"), 0);
+            return;
+          }
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // The join is not replaced by the inexact filter.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          ASSERT_GT(scanStats.at("dynamicFilterPrunedRows").sum, 0);
+          ASSERT_LT(getInputPositions(task, 1), numProbeRows * numSplits);
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, bloomFilterSizedPerKey) {
+  const int32_t numProbeRows = 10'000;
+  // 120K distinct values of 'c0', each with 2 values of 'c1'. A Bloom filter
+  // on 'c0' takes 256KB while one for the 240K distinct keys of the table
+  // would take 512KB.
+  const int32_t numBuildRows = 240'000;
+  const int64_t kStride = 1'000'003;
+
+  // Every 10th probe key has a match.
+  auto probeVector = makeRowVector({
+      makeFlatVector<int64_t>(
+          numProbeRows,
+          [&](auto row) {
+            const int64_t key = row * 2;
+            return row % 10 == 0 ? key * kStride : key * kStride + 1;
+          }),
+      makeFlatVector<int64_t>(numProbeRows, [](auto row) { return row % 2; }),
+  });
+  auto tempFile = TempFilePath::create();
+  writeToFile(tempFile->getPath(), probeVector);
+
+  auto buildVector = makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeFlatVector<int64_t>(
+           numBuildRows, [&](auto row) { return row / 2 * kStride; }),
+       makeFlatVector<int64_t>(
+           numBuildRows, [](auto row) { return row % 2; })});
+
+  createDuckDbTable("t", {probeVector});
+  createDuckDbTable("u", {buildVector});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(ROW({"c0", "c1"}, {BIGINT(), BIGINT()}))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0", "c1"},
+                    {"u_c0", "u_c1"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values({buildVector})
+                        .planNode(),
+                    "",
+                    {"c0", "c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  SplitInput splitInput = {
+      {probeScanId,
+       {exec::Split(makeHiveConnectorSplit(tempFile->getPath()))}},
+  };
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(op)
+      .inputSplits(splitInput)
+      .injectSpill(false)
+      .config(
+          core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize,
+          std::to_string(300 << 10))
+      .referenceQuery(
+          "SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.u_c0 AND t.c1 = u.u_c1")
+      .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+        auto planStats = toPlanStats(task->taskStats());
+        const auto& scanStats = planStats.at(probeScanId).customStats;
+        ASSERT_GE(getFiltersProduced(task, 1).sum, 1);
+        ASSERT_GT(scanStats.at("dynamicFilterPrunedRows").sum, 0);
+        ASSERT_LT(getInputPositions(task, 1), numProbeRows);
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
@@ -5177,6 +5577,70 @@ TEST_F(HashJoinTest, dynamicFiltersAppliedToPreloadedSplits) {
       .run();
 }
 
+// A dynamic filter on a partition key skips the splits of the partitions it
+// rejects before their files are opened.
+TEST_F(HashJoinTest, dynamicFiltersSkipPartitions) {
+  const vector_size_t size = 1000;
+  const int32_t numSplits = 5;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  std::vector<exec::Split> probeSplits;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector(
+        {"p0", "p1"},
+        {
+            makeFlatVector<int64_t>(size, [&](auto row) { return row + i; }),
+            makeFlatVector<int64_t>(size, [&](auto /*row*/) { return i; }),
+        });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+    auto split = HiveConnectorSplitBuilder(tempFiles.back()->getPath())
+                     .partitionKey("p1", std::to_string(i))
+                     .build();
+    probeSplits.push_back(exec::Split(split));
+  }
+  createDuckDbTable("p", probeVectors);
+
+  std::vector<RowVectorPtr> buildVectors{
+      makeRowVector({"b0"}, {makeFlatVector<int64_t>({1, 3})})};
+  createDuckDbTable("b", buildVectors);
+
+  core::PlanNodeId probeScanId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto op =
+      PlanBuilder(planNodeIdGenerator)
+          .startTableScan()
+          .outputType(ROW({"p0", "p1"}, {BIGINT(), BIGINT()}))
+          .assignments(
+              {{"p0", regularColumn("p0", BIGINT())},
+               {"p1", partitionKey("p1", BIGINT())}})
+          .endTableScan()
+          .capturePlanNodeId(probeScanId)
+          .hashJoin(
+              {"p1"},
+              {"b0"},
+              PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode(),
+              "",
+              {"p0"},
+              core::JoinType::kInner)
+          .planNode();
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(std::move(op))
+      .injectSpill(false)
+      .inputSplits({{probeScanId, probeSplits}})
+      .referenceQuery("select p.p0 from p, b where b.b0 = p.p1")
+      .checkSpillStats(false)
+      .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+        auto planStats = toPlanStats(task->taskStats());
+        const auto& customStats = planStats.at(probeScanId).customStats;
+        ASSERT_EQ(3, customStats.at("skippedSplits").sum);
+        ASSERT_EQ(3, customStats.at("skippedSplitsByDynamicFilter").sum);
+      })
+      .run();
+}
+
 // Verify the size of the join output vectors when projecting build-side
 // variable-width column.
 TEST_F(HashJoinTest, memoryUsage) {
@@ -5275,6 +5739,7 @@ TEST_F(HashJoinTest, smallOutputBatchSize) {
   HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
       .planNode(std::move(plan))
       .config(core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+      .config(core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
       .referenceQuery("SELECT c0, u_c1 FROM t, u WHERE c0 = u_c0 AND c1 < u_c1")
       .injectSpill(false)
       .run();
@@ -6474,6 +6939,8 @@ TEST_F(HashJoinTest, leftJoinWithMissAtEndOfBatch) {
         .numDrivers(1)
         .config(
             core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
         .referenceQuery(fmt::format(
             "SELECT t_k1, u_k1 from t left join u on t_k1 = u_k1 and {}",
             filter))
@@ -6525,6 +6992,8 @@ TEST_F(HashJoinTest, leftJoinWithMissAtEndOfBatchMultipleBuildMatches) {
         .numDrivers(1)
         .config(
             core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
         .referenceQuery(fmt::format(
             "SELECT t_k1, u_k1 from t left join u on t_k1 = u_k1 and {}",
             filter))
@@ -7371,6 +7840,7 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeSpillInMiddeOfLastOutputProcessing) {
       .buildVectors(std::move(buildVectors))
       .config(core::QueryConfig::kJoinSpillEnabled, "true")
       .config(core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+      .config(core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
       .joinType(core::JoinType::kRight)
       .joinOutputLayout({"t_k1", "t_k2", "u_k1", "t_v1"})
       .referenceQuery(
@@ -7445,6 +7915,8 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeSpillInMiddeOfOutputProcessing) {
         .config(core::QueryConfig::kJoinSpillEnabled, "true")
         .config(
             core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
         .joinType(core::JoinType::kRight)
         .joinOutputLayout({"t_k1", "t_k2", "u_k1", "t_v1"})
         .referenceQuery(
@@ -7553,6 +8025,8 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeSpillExceedLimit) {
         .config(core::QueryConfig::kSpillWriteBufferSize, "1")
         .config(
             core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
         .joinType(core::JoinType::kRight)
         .joinOutputLayout({"t_k1", "t_k2", "u_k1", "t_v1"})
         .referenceQuery(
@@ -7674,6 +8148,8 @@ DEBUG_ONLY_TEST_F(HashJoinTest, spillOutputWithRightSemiJoins) {
         // steps.
         .config(
             core::QueryConfig::kPreferredOutputBatchRows, std::to_string(10))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows, std::to_string(10))
         .injectSpill(false)
         .joinOutputLayout(std::move(joinOutputLayout))
         .nullAware(nullAware)
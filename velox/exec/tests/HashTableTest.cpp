@@ -155,11 +155,15 @@ class HashTableTest : public testing::TestWithParam<bool>,
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
+    topTable_->setPerfectHashMaxRows(perfectHashMaxRows_);
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setJoinProbePartitionBytes(joinProbePartitionBytes_);
+    topTable_->setPrefetchGroupSize(prefetchGroupSize_);
     ASSERT_GE(
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
     ASSERT_EQ(topTable_->hashMode(), mode);
+    ASSERT_EQ(topTable_->hasPerfectHash(), perfectHashMaxRows_ > 0);
     ASSERT_EQ(topTable_->allRows().size(), numWays);
     uint64_t rowCount{0};
     for (auto* rowContainer : topTable_->allRows()) {
@@ -233,8 +237,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
           std::make_unique<VectorHasher>(tableType->childAt(channel), channel));
     }
 
-    return HashTable<false>::createForAggregation(
+    auto table = HashTable<false>::createForAggregation(
         std::move(keyHashers), std::vector<Accumulator>{}, pool());
+    table->setPrefetchGroupSize(prefetchGroupSize_);
+    return table;
   }
 
   void insertGroups(
@@ -462,7 +468,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
         SelectivityTimer timer(hashTime, 0);
         for (auto i = 0; i < hashers.size(); ++i) {
           auto& key = batch->childAt(i);
-          if (mode != BaseHashTable::HashMode::kHash) {
+          if (topTable_->hasPerfectHash()) {
+            // The perfect hash index looks up the decoded keys.
+            hashers[i]->decode(*key, rows);
+          } else if (mode != BaseHashTable::HashMode::kHash) {
             hashers[i]->lookupValueIds(
                 *key, rows, scratchMemory, lookup->hashes);
           } else {
@@ -567,6 +576,13 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Partition size for radix-partitioned join probes. 0 disables.
+  uint64_t joinProbePartitionBytes_ = 0;
+  // Number of interleaved probes in kHash mode. 0 for the default.
+  int32_t prefetchGroupSize_ = 0;
+  // Maximum number of rows for a perfect hash index over the keys. 0
+  // disables.
+  uint64_t perfectHashMaxRows_ = 0;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -619,6 +635,58 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, int2SparseNormalizedPartitionedProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  joinProbePartitionBytes_ = 4 << 10;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, mixed6SparsePartitionedProbe) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  joinProbePartitionBytes_ = 4 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
+TEST_P(HashTableTest, structKeyPrefetchGroup) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  prefetchGroupSize_ = 16;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
+}
+
+TEST_P(HashTableTest, mixed6SparsePrefetchGroup) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  prefetchGroupSize_ = BaseHashTable::kMaxPrefetchGroupSize;
+  joinProbePartitionBytes_ = 4 << 10;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
+TEST_P(HashTableTest, int1SparseNormalizedPerfectHash) {
+  auto type = ROW({"k1"}, {BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  perfectHashMaxRows_ = 1 << 20;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 1);
+}
+
+TEST_P(HashTableTest, int1WideHashPerfectHash) {
+  // Keys spread over a range too wide for value ranges or ids.
+  auto type = ROW({"k1"}, {BIGINT()});
+  keySpacing_ = 1L << 45;
+  perfectHashMaxRows_ = 1 << 20;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "velox/exec/HeavyHitterSketch.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+TEST(HeavyHitterSketchTest, basic) {
+  HeavyHitterSketch sketch(8);
+  // Hash 1 is 1/4 and hash 2 is 1/10 of the values. The rest are unique.
+  for (auto i = 0; i < 10'000; ++i) {
+    if (i % 4 == 0) {
+      sketch.add(1);
+    } else if (i % 10 == 1) {
+      sketch.add(2);
+    } else {
+      sketch.add(1'000 + i);
+    }
+  }
+  ASSERT_EQ(sketch.numValues(), 10'000);
+
+  // Counts are underestimated by at most 10'000 / 9.
+  auto heavyHitters = sketch.heavyHitters(1'000);
+  ASSERT_EQ(heavyHitters.size(), 1);
+  ASSERT_EQ(heavyHitters[0].first, 1);
+  ASSERT_GE(heavyHitters[0].second, 2'500 - 10'000 / 9);
+  ASSERT_LE(heavyHitters[0].second, 2'500);
+
+  heavyHitters = sketch.heavyHitters(1);
+  ASSERT_GE(heavyHitters.size(), 2);
+  ASSERT_LE(heavyHitters.size(), 8);
+  ASSERT_EQ(heavyHitters[0].first, 1);
+  ASSERT_EQ(heavyHitters[1].first, 2);
+}
+
+TEST(HeavyHitterSketchTest, merge) {
+  // Each sketch sees a different frequent hash next to many unique ones. The
+  // merged sketch keeps the hashes frequent in the combined stream.
+  std::vector<HeavyHitterSketch> sketches;
+  for (auto i = 0; i < 4; ++i) {
+    sketches.emplace_back(4);
+    for (auto j = 0; j < 1'000; ++j) {
+      sketches.back().add(j % 2 == 0 ? 7 : (j % 3 == 0 ? i : 100 + j));
+    }
+  }
+  HeavyHitterSketch merged(4);
+  for (const auto& sketch : sketches) {
+    merged.merge(sketch);
+  }
+  ASSERT_EQ(merged.numValues(), 4'000);
+  const auto heavyHitters = merged.heavyHitters(1);
+  ASSERT_LE(heavyHitters.size(), 4);
+  ASSERT_EQ(heavyHitters[0].first, 7);
+  ASSERT_GE(heavyHitters[0].second, 2'000 - 4'000 / 5);
+}
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBufferManager.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -141,3 +143,80 @@ TEST_F(LimitTest, partialLimitEagerFlush) {
   test(true);
   test(false);
 }
+
+TEST_F(LimitTest, pushdownToTableScan) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  auto file = TempFilePath::create();
+  writeToFile(file->getPath(), {data});
+
+  // Returns the number of rows the scan produced for 'plan'.
+  auto runScan = [&](const core::PlanNodePtr& plan,
+                     const core::PlanNodeId& scanNodeId,
+                     const RowVectorPtr& expected) {
+    auto task = AssertQueryBuilder(plan)
+                    .split(makeHiveConnectorSplit(file->getPath()))
+                    .assertResults(expected);
+    return toPlanStats(task->taskStats()).at(scanNodeId).outputRows;
+  };
+
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(data->type()))
+                  .capturePlanNodeId(scanNodeId)
+                  .limit(0, 10, true)
+                  .planNode();
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>(10, [](auto row) { return row; })});
+  EXPECT_EQ(10, runScan(plan, scanNodeId, expected));
+
+  // A projection does not change the number of rows, so the offset plus the
+  // limit are pushed down.
+  plan = PlanBuilder()
+             .tableScan(asRowType(data->type()))
+             .capturePlanNodeId(scanNodeId)
+             .project({"c0 + 1 AS c0"})
+             .limit(5, 10, true)
+             .planNode();
+  expected = makeRowVector(
+      {makeFlatVector<int64_t>(10, [](auto row) { return row + 6; })});
+  EXPECT_EQ(15, runScan(plan, scanNodeId, expected));
+
+  // A filter between the scan and the limit prevents the pushdown.
+  plan = PlanBuilder()
+             .tableScan(asRowType(data->type()))
+             .capturePlanNodeId(scanNodeId)
+             .filter("c0 % 2 = 0")
+             .limit(0, 10, true)
+             .planNode();
+  expected = makeRowVector(
+      {makeFlatVector<int64_t>(10, [](auto row) { return row * 2; })});
+  EXPECT_LT(10, runScan(plan, scanNodeId, expected));
+}
+
+TEST_F(LimitTest, pushdownToTableScanWithFilter) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  auto file = TempFilePath::create();
+  writeToFile(file->getPath(), {data});
+
+  // Only the last 1'000 rows pass the filter of the scan. The scan reads full
+  // batches, not batches of about the size of the limit.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(data->type()), {"c0 >= 9000"})
+                  .capturePlanNodeId(scanNodeId)
+                  .limit(0, 10, true)
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan)
+          .split(makeHiveConnectorSplit(file->getPath()))
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+          .config(core::QueryConfig::kMaxOutputBatchRows, "1000")
+          .assertResults(makeRowVector({makeFlatVector<int64_t>(
+              10, [](auto row) { return 9'000 + row; })}));
+  const auto planStats = toPlanStats(task->taskStats());
+  const auto& scanStats = planStats.at(scanNodeId);
+  // 10 reads of 1'000 rows get to the first rows that pass the filter.
+  EXPECT_LE(scanStats.customStats.at("dataSourceReadWallNanos").count, 11);
+}
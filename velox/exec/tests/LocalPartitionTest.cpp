@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -625,3 +626,84 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
       "   SELECT * FROM (VALUES ('y')) as t2(c0)"
       ")");
 }
+
+TEST_F(LocalPartitionTest, sharedInputPartitions) {
+  auto input = makeRowVector({makeFlatSequence<int32_t>(0, 100)});
+  const auto inputBytes = input->estimateFlatSize();
+
+  auto memoryManager =
+      std::make_shared<LocalExchangeMemoryManager>(inputBytes);
+  std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  for (auto i = 0; i < 2; ++i) {
+    queues.push_back(std::make_shared<LocalExchangeQueue>(memoryManager, i));
+    queues.back()->addProducer();
+    queues.back()->noMoreProducers();
+  }
+
+  // Even rows go to the first queue and odd rows to the second.
+  auto sharedInput =
+      std::make_shared<LocalExchangeSharedInput>(input, inputBytes, 2);
+  ContinueFuture producerFuture;
+  ASSERT_TRUE(memoryManager->increaseMemoryUsage(&producerFuture, inputBytes));
+  for (auto i = 0; i < 2; ++i) {
+    queues[i]->enqueuePartition(
+        sharedInput,
+        makeIndices(50, [i](auto row) { return row * 2 + i; }),
+        50);
+  }
+
+  ContinueFuture future;
+  RowVectorPtr data;
+  ASSERT_EQ(
+      queues[0]->next(&future, pool(), &data), BlockingReason::kNotBlocked);
+  assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>(50, [](auto row) {
+        return row * 2;
+      })}),
+      data);
+  // The input stays accounted while the second partition is queued.
+  ASSERT_FALSE(producerFuture.isReady());
+
+  ASSERT_EQ(
+      queues[1]->next(&future, pool(), &data), BlockingReason::kNotBlocked);
+  assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>(50, [](auto row) {
+        return row * 2 + 1;
+      })}),
+      data);
+  ASSERT_TRUE(producerFuture.isReady());
+
+  // Partitions left in a closed queue release the input as well.
+  ASSERT_TRUE(memoryManager->increaseMemoryUsage(&producerFuture, inputBytes));
+  sharedInput =
+      std::make_shared<LocalExchangeSharedInput>(input, inputBytes, 2);
+  for (auto i = 0; i < 2; ++i) {
+    queues[i]->enqueuePartition(
+        sharedInput, makeIndices(50, [i](auto row) { return row * 2 + i; }), 50);
+    queues[i]->close();
+  }
+  ASSERT_TRUE(producerFuture.isReady());
+}
+
+TEST_F(LocalPartitionTest, scaleWriterPartitionState) {
+  ScaleWriterPartitionState state(3, 100);
+  ASSERT_EQ(state.numActivePartitions(), 1);
+
+  // Enough data but the writers keep up.
+  state.addProcessedBytes(150, false);
+  ASSERT_EQ(state.numActivePartitions(), 1);
+
+  // The writers are backed up and the active one has had enough data.
+  state.addProcessedBytes(0, true);
+  ASSERT_EQ(state.numActivePartitions(), 2);
+
+  // The two active writers have not had 100 bytes each yet.
+  state.addProcessedBytes(10, true);
+  ASSERT_EQ(state.numActivePartitions(), 2);
+  state.addProcessedBytes(40, true);
+  ASSERT_EQ(state.numActivePartitions(), 3);
+
+  // All writers are active.
+  state.addProcessedBytes(1'000, true);
+  ASSERT_EQ(state.numActivePartitions(), 3);
+}
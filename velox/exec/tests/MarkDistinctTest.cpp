@@ -34,13 +34,18 @@ class MarkDistinctTest : public OperatorTestBase {
 
     auto expectedResults = makeRowVector({data, isDistinct});
 
-    auto plan = PlanBuilder()
-                    .values({makeRowVector({data})})
-                    .markDistinct("c0_distinct", {"c0"})
-                    .planNode();
-
-    auto results = AssertQueryBuilder(plan).copyResults(pool());
-    assertEqualVectors(expectedResults, results);
+    // Equal values are adjacent in 'data', so the streaming operator must
+    // produce the same mask.
+    for (const bool preGrouped : {false, true}) {
+      SCOPED_TRACE(fmt::format("preGrouped: {}", preGrouped));
+      auto plan = PlanBuilder()
+                      .values({makeRowVector({data})})
+                      .markDistinct("c0_distinct", {"c0"}, preGrouped)
+                      .planNode();
+
+      auto results = AssertQueryBuilder(plan).copyResults(pool());
+      assertEqualVectors(expectedResults, results);
+    }
   }
 };
 
@@ -141,3 +146,54 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, preGrouped) {
+  // Runs of equal keys span batch boundaries.
+  std::vector<RowVectorPtr> vectors = {
+      makeRowVector({
+          makeFlatVector<int32_t>({1, 1, 1, 2}),
+          makeNullableFlatVector<int64_t>({1, 1, 2, std::nullopt}),
+          makeFlatVector<int32_t>({1, 2, 3, 4}),
+      }),
+      makeRowVector({
+          makeFlatVector<int32_t>({2, 2, 3}),
+          makeNullableFlatVector<int64_t>({std::nullopt, 5, 5}),
+          makeFlatVector<int32_t>({5, 6, 7}),
+      }),
+      makeRowVector({
+          makeFlatVector<int32_t>({3, 3}),
+          makeNullableFlatVector<int64_t>({5, 5}),
+          makeFlatVector<int32_t>({8, 9}),
+      }),
+  };
+
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .markDistinct("distinct", {"c0", "c1"}, true)
+                  .planNode();
+  std::shared_ptr<exec::Task> task;
+  auto results = AssertQueryBuilder(plan).copyResults(pool(), task);
+  auto expected = makeFlatVector<bool>(
+      {true, false, true, true, false, true, true, false, false});
+  assertEqualVectors(expected, results->childAt(3));
+  const auto& operatorStats =
+      task->taskStats().pipelineStats[0].operatorStats;
+  ASSERT_EQ(operatorStats[1].operatorType, "StreamingMarkDistinct");
+
+  // DISTINCT aggregation over input sorted on the grouping and distinct keys.
+  plan = PlanBuilder()
+             .values(vectors)
+             .markDistinct("c1_distinct", {"c0", "c1"}, true)
+             .streamingAggregation(
+                 {"c0"},
+                 {"count(c1)", "sum(c1)"},
+                 {"c1_distinct", "c1_distinct"},
+                 core::AggregationNode::Step::kSingle,
+                 false)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT c0, count(distinct c1), sum(distinct c1) FROM tmp GROUP BY 1");
+}
@@ -41,6 +41,8 @@ class MergeJoinTest : public HiveConnectorTestBase {
     params.queryCtx = queryCtx;
     params.queryCtx->testingOverrideConfigUnsafe(
         {{core::QueryConfig::kPreferredOutputBatchRows,
+          std::to_string(preferredOutputBatchSize)},
+         {core::QueryConfig::kMaxOutputBatchRows,
           std::to_string(preferredOutputBatchSize)}});
     return params;
   }
@@ -206,6 +208,18 @@ TEST_F(MergeJoinTest, duplicateMatch) {
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
 }
 
+TEST_F(MergeJoinTest, longRunsAndGaps) {
+  // Long runs of equal keys and long gaps between matching keys on flat keys
+  // of different widths.
+  testJoin<int64_t>(
+      [](auto row) { return row / 100; },
+      [](auto row) { return row / 7 * 37; });
+  testJoin<int16_t>(
+      [](auto row) { return row * 11; }, [](auto row) { return row / 50; });
+  testJoin<int8_t>(
+      [](auto row) { return row / 40; }, [](auto row) { return row / 25; });
+}
+
 TEST_F(MergeJoinTest, allRowsMatch) {
   std::vector<VectorPtr> leftKeys = {
       makeFlatVector<int32_t>(2, [](auto /* row */) { return 5; }),
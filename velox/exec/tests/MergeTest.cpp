@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/RangePartitionFunction.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -152,6 +153,32 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+/// Strings longer than the normalized prefix that differ only after it are
+/// ordered on their full values.
+TEST_F(MergeTest, longStringKeys) {
+  vector_size_t batchSize = 500;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<std::string>(
+        batchSize,
+        [&](auto row) {
+          return fmt::format("common-prefix-of-keys-{}", (row * 7 + i) % 50);
+        },
+        nullEvery(13));
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return row % 17 - i; }, nullEvery(7));
+    auto c2 = makeFlatVector<double>(
+        batchSize, [&](auto row) { return (row % 5) * 0.5 - i; });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0");
+  testTwoKeys(vectors, "c0", "c1");
+  testTwoKeys(vectors, "c1", "c0");
+  testTwoKeys(vectors, "c2", "c1");
+}
+
 /// Verifies an edge case where output batch fills up when one of the sources
 /// has only one row left.
 TEST_F(MergeTest, offByOne) {
@@ -182,3 +209,43 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+TEST_F(MergeTest, rangePartitioned) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (row * 31 + i) % 997; },
+            nullEvery(7)),
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::pair<std::string, core::SortOrder>> orderBys = {
+      {"c0 NULLS FIRST", core::SortOrder(true, true)},
+      {"c0 DESC NULLS LAST", core::SortOrder(false, false)},
+  };
+  for (const auto& [orderBy, sortOrder] : orderBys) {
+    SCOPED_TRACE(orderBy);
+    // Splitters for 4 ranges, sampled from the first batch.
+    auto splitters = exec::RangePartitionFunction::computeSplitters(
+        *vectors[0], {0}, {sortOrder}, 4, pool());
+    ASSERT_EQ(3, splitters->size());
+
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .localPartitionByRange({orderBy}, splitters)
+                    .orderBy({orderBy}, true)
+                    .localMergeRangePartitioned({orderBy})
+                    .planNode();
+
+    CursorParameters params;
+    params.planNode = plan;
+    params.maxDrivers = 4;
+    assertQueryOrdered(
+        params, fmt::format("SELECT * FROM tmp ORDER BY {}", orderBy), {0});
+  }
+}
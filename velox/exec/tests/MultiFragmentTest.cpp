@@ -21,6 +21,7 @@
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -647,6 +648,196 @@ TEST_F(MultiFragmentTest, partitionedOutputWithLargeInput) {
   }
 }
 
+TEST_F(MultiFragmentTest, partitionedOutputPreserveEncodings) {
+  constexpr vector_size_t kSize = 10'000;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 100; ++i) {
+    strings.push_back(std::string(100, 'a' + i % 26) + std::to_string(i));
+  }
+  std::vector<RowVectorPtr> encoded;
+  std::vector<RowVectorPtr> flat;
+  for (auto i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<int64_t>(kSize, [&](auto row) { return row + i; });
+    auto stringAt = [&](auto row) {
+      return StringView(strings[(row * 7) % 100]);
+    };
+    encoded.push_back(makeRowVector({
+        c0,
+        wrapInDictionary(
+            makeIndices(kSize, [](auto row) { return (row * 7) % 100; }),
+            makeFlatVector<std::string>(strings)),
+        makeConstant(StringView(strings[i]), kSize),
+    }));
+    flat.push_back(makeRowVector({
+        c0,
+        makeFlatVector<StringView>(kSize, stringAt),
+        makeFlatVector<StringView>(
+            kSize, [&](auto /*row*/) { return StringView(strings[i]); }),
+    }));
+  }
+  createDuckDbTable(flat);
+
+  auto runLeaf = [&](bool preserveEncodings, int32_t taskNum) {
+    configSettings_[core::QueryConfig::kPartitionedOutputPreserveEncodings] =
+        preserveEncodings ? "true" : "false";
+    auto leafTaskId = makeTaskId("leaf", taskNum);
+    auto leafPlan =
+        PlanBuilder().values(encoded).partitionedOutput({}, 1).planNode();
+    auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+    leafTask->start(1);
+    auto op = PlanBuilder().exchange(leafPlan->outputType()).planNode();
+    assertQuery(op, {leafTaskId}, "SELECT * FROM tmp");
+    EXPECT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+    return toPlanStats(leafTask->taskStats()).at("1");
+  };
+
+  const auto flatStats = runLeaf(false, 0);
+  ASSERT_EQ(
+      flatStats.customStats.count(detail::Destination::kEncodedPages), 0);
+
+  const auto encodedStats = runLeaf(true, 1);
+  ASSERT_LT(
+      0, encodedStats.customStats.at(detail::Destination::kEncodedPages).sum);
+  ASSERT_LT(
+      0,
+      encodedStats.customStats.at(detail::Destination::kEncodedBytesSaved)
+          .sum);
+  ASSERT_LT(encodedStats.outputBytes, flatStats.outputBytes / 2);
+}
+
+TEST_F(MultiFragmentTest, compactRow) {
+  setupSources(10, 1000);
+  configSettings_[core::QueryConfig::kExchangeCompactRow] = "true";
+
+  // Hash partitioning to many destinations.
+  {
+    constexpr int32_t kFanout = 16;
+    auto leafTaskId = makeTaskId("leaf", 0);
+    auto leafPlan = PlanBuilder()
+                        .values(vectors_)
+                        .partitionedOutput({"c0"}, kFanout)
+                        .planNode();
+    auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+    leafTask->start(4);
+
+    auto intermediatePlan = PlanBuilder()
+                                .exchange(leafPlan->outputType())
+                                .partitionedOutput({}, 1)
+                                .planNode();
+    std::vector<exec::Split> intermediateSplits;
+    for (auto i = 0; i < kFanout; ++i) {
+      auto taskId = makeTaskId("intermediate", i);
+      auto intermediateTask = makeTask(taskId, intermediatePlan, i);
+      intermediateTask->start(1);
+      addRemoteSplits(intermediateTask, {leafTaskId});
+      intermediateSplits.push_back(remoteSplit(taskId));
+    }
+
+    auto op = PlanBuilder().exchange(intermediatePlan->outputType()).planNode();
+    AssertQueryBuilder(op, duckDbQueryRunner_)
+        .config(core::QueryConfig::kExchangeCompactRow, "true")
+        .splits(std::move(intermediateSplits))
+        .assertResults("SELECT * FROM tmp");
+
+    ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+  }
+
+  // Merge exchange.
+  {
+    std::vector<std::string> sortTaskIds;
+    for (int i = 0; i < 2; ++i) {
+      sortTaskIds.push_back(makeTaskId("orderby", i));
+      auto sortPlan = PlanBuilder()
+                          .values(vectors_)
+                          .orderBy({"c0"}, false)
+                          .partitionedOutput({}, 1)
+                          .planNode();
+      auto sortTask = makeTask(sortTaskIds.back(), sortPlan, i);
+      sortTask->start(1);
+    }
+
+    auto mergePlan = PlanBuilder()
+                         .mergeExchange(asRowType(vectors_[0]->type()), {"c0"})
+                         .planNode();
+    std::vector<exec::Split> sortSplits;
+    for (const auto& taskId : sortTaskIds) {
+      sortSplits.push_back(remoteSplit(taskId));
+    }
+    AssertQueryBuilder(mergePlan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kExchangeCompactRow, "true")
+        .splits(std::move(sortSplits))
+        .assertResults(
+            "SELECT * FROM tmp UNION ALL SELECT * FROM tmp ORDER BY 1 NULLS LAST",
+            {{0}});
+  }
+}
+
+TEST_F(MultiFragmentTest, vectorPages) {
+  exec::ExchangeSource::registerFactory(InProcessExchangeSource::create);
+  setupSources(10, 1000);
+  configSettings_[core::QueryConfig::kExchangeVectorPages] = "true";
+  auto inProcessTaskId = [](const std::string& prefix, int num) {
+    return fmt::format(
+        "{}{}-{}", InProcessExchangeSource::kTaskIdPrefix, prefix, num);
+  };
+
+  // Hash partitioning to many destinations. The intermediate tasks receive
+  // the vectors of the leaf task without serialization.
+  constexpr int32_t kFanout = 4;
+  auto leafTaskId = inProcessTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .values(vectors_)
+                      .partitionedOutput({"c0"}, kFanout)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  leafTask->start(4);
+
+  core::PlanNodeId exchangeNodeId;
+  auto intermediatePlan = PlanBuilder()
+                              .exchange(leafPlan->outputType())
+                              .capturePlanNodeId(exchangeNodeId)
+                              .partitionedOutput({}, 1)
+                              .planNode();
+  std::vector<std::shared_ptr<Task>> intermediateTasks;
+  std::vector<exec::Split> intermediateSplits;
+  for (auto i = 0; i < kFanout; ++i) {
+    auto taskId = inProcessTaskId("intermediate", i);
+    auto intermediateTask = makeTask(taskId, intermediatePlan, i);
+    intermediateTask->start(1);
+    addRemoteSplits(intermediateTask, {leafTaskId});
+    intermediateTasks.push_back(intermediateTask);
+    intermediateSplits.push_back(remoteSplit(taskId));
+  }
+
+  // The consumer names the columns differently from the producers. The
+  // vectors it receives have the consumer's names.
+  const auto& producerType = intermediatePlan->outputType();
+  std::vector<std::string> names;
+  for (auto i = 0; i < producerType->size(); ++i) {
+    names.push_back(fmt::format("x{}", i));
+  }
+  auto outputType = ROW(
+      std::move(names), std::vector<TypePtr>(producerType->children()));
+  auto op = PlanBuilder().exchange(outputType).planNode();
+  auto result = AssertQueryBuilder(op)
+                    .config(core::QueryConfig::kExchangeVectorPages, "true")
+                    .splits(std::move(intermediateSplits))
+                    .copyResults(pool());
+  ASSERT_EQ(*result->type(), *outputType);
+  assertEqualResults(vectors_, {result});
+
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+  int64_t numVectorPages = 0;
+  for (auto& task : intermediateTasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+    const auto stats = toPlanStats(task->taskStats()).at(exchangeNodeId);
+    if (stats.customStats.count("numVectorPages") > 0) {
+      numVectorPages += stats.customStats.at("numVectorPages").sum;
+    }
+  }
+  ASSERT_GT(numVectorPages, 0);
+}
+
 TEST_F(MultiFragmentTest, broadcast) {
   auto data = makeRowVector(
       {makeFlatVector<int32_t>(1'000, [](auto row) { return row; })});
@@ -2032,7 +2223,61 @@ TEST_F(MultiFragmentTest, mergeSmallBatchesInExchange) {
   test(1, 1'000);
   test(1'000, 56);
   test(10'000, 6);
-  test(100'000, 1);
+  // Limited by the default preferred output batch of 1024 rows.
+  test(100'000, 3);
+}
+
+TEST_F(MultiFragmentTest, splitLargePagesInExchange) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(300, [](auto row) { return row; })});
+  const auto producerTaskId = "local://t1";
+  auto producerPlan = test::PlanBuilder()
+                          .values({data})
+                          .partitionedOutput({}, 1)
+                          .planNode();
+  auto producerTask = makeTask(producerTaskId, producerPlan);
+  bufferManager_->initializeTask(
+      producerTask, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+  auto cleanupGuard = folly::makeGuard([&]() {
+    producerTask->requestCancel();
+    bufferManager_->removeTask(producerTaskId);
+  });
+
+  // One page with 10 serialized batches of 300 rows.
+  const int32_t numBatches = 10;
+  auto iobuf = toSerializedPage(data)->getIOBuf();
+  for (auto i = 1; i < numBatches; ++i) {
+    iobuf->prependChain(toSerializedPage(data)->getIOBuf());
+  }
+  ContinueFuture unused;
+  bufferManager_->enqueue(
+      producerTaskId,
+      0,
+      std::make_unique<SerializedPage>(
+          std::move(iobuf), nullptr, numBatches * data->size()),
+      &unused);
+  bufferManager_->noMoreData(producerTaskId);
+
+  std::vector<RowVectorPtr> expected(numBatches, data);
+  auto plan = test::PlanBuilder().exchange(asRowType(data->type())).planNode();
+  auto task = test::AssertQueryBuilder(plan)
+                  .split(remoteSplit(producerTaskId))
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+                  .assertResults(expected);
+
+  // The page is returned in batches of 4 serialized batches or less.
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at("0");
+  ASSERT_EQ(3, stats.outputVectors);
+  const auto& batchRows =
+      stats.customStats.at(Exchange::kDeserializedBatchRows);
+  ASSERT_EQ(3, batchRows.count);
+  ASSERT_EQ(3'000, batchRows.sum);
+  ASSERT_EQ(1'200, batchRows.max);
+  ASSERT_EQ(600, batchRows.min);
+  ASSERT_EQ(
+      stats.rawInputBytes,
+      stats.customStats.at(Exchange::kDeserializedBatchBytes).sum);
 }
 
 TEST_F(MultiFragmentTest, compression) {
@@ -2083,8 +2328,20 @@ TEST_F(MultiFragmentTest, compression) {
           producerStats.customStats.at("compressedBytes").sum,
           producerStats.customStats.at("compressionInputBytes").sum);
       EXPECT_EQ(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+      EXPECT_LT(
+          producerStats.customStats
+              .at(detail::Destination::kCompressedPageBytes)
+              .sum,
+          producerStats.customStats
+              .at(detail::Destination::kUncompressedPageBytes)
+              .sum);
     } else {
       EXPECT_LT(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+      EXPECT_LT(
+          0,
+          producerStats.customStats
+              .at(detail::Destination::kCompressionSkippedPages)
+              .sum);
     }
   };
 
@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -488,3 +490,177 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, spill) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector({sequence<int32_t>(100, i * 100)}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 10; ++i) {
+    buildVectors.push_back(
+        makeRowVector({"u_c0"}, {sequence<int32_t>(50, i * 50 + 25)}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "c0 > u_c0",
+                        {"c0", "u_c0"},
+                        joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kJoinSpillEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(fmt::format(
+                "SELECT c0, u_c0 FROM t {} JOIN u ON c0 > u_c0",
+                core::joinTypeName(joinType)));
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(joinNodeId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
+
+TEST_F(NestedLoopJoinTest, compressBeforeSpill) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector({sequence<int32_t>(100, i * 100)}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 10; ++i) {
+    buildVectors.push_back(
+        makeRowVector({"u_c0"}, {sequence<int32_t>(50, i * 50 + 25)}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .nestedLoopJoin(
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "c0 > u_c0",
+                      {"c0", "u_c0"})
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  // Every reclaim finds a new uncompressed build vector, so the build side is
+  // compressed rather than spilled.
+  auto spillDirectory = TempDirectoryPath::create();
+  TestScopedSpillInjection scopedSpillInjection(100);
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kJoinSpillEnabled, "true")
+          .config(core::QueryConfig::kRetainedVectorCompressionKind, "lz4")
+          .spillDirectory(spillDirectory->getPath())
+          .assertResults("SELECT c0, u_c0 FROM t JOIN u ON c0 > u_c0");
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(joinNodeId);
+  ASSERT_EQ(stats.spilledBytes, 0);
+  ASSERT_GT(stats.customStats.at(Operator::kRetainedVectorRawBytes).sum, 0);
+  ASSERT_GT(
+      stats.customStats.at(Operator::kRetainedVectorCompressedBytes).sum, 0);
+}
+
+TEST_F(NestedLoopJoinTest, rangeLookup) {
+  // Events with a key and a timestamp, and windows with a key, a start and an
+  // end. Windows are at most 20 apart and long, so each event falls into a
+  // few windows.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 4; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"k", "ts"},
+        {makeFlatVector<int32_t>(250, [](auto row) { return row % 3; }),
+         makeFlatVector<int64_t>(
+             250,
+             [i](auto row) { return (i * 250 + row) * 7 % 1'000; },
+             nullEvery(50))}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 3; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"w_k", "w_start", "w_end"},
+        {makeFlatVector<int32_t>(100, [](auto row) { return row % 3; }),
+         makeFlatVector<int64_t>(
+             100,
+             [i](auto row) { return (i * 100 + row) * 1'000 / 300; },
+             nullEvery(37)),
+         makeFlatVector<int64_t>(
+             100,
+             [i](auto row) {
+               return (i * 100 + row) * 1'000 / 300 + row % 20;
+             },
+             nullEvery(41))}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const std::vector<std::string> conditions = {
+      "ts BETWEEN w_start AND w_end",
+      "ts >= w_start AND ts < w_end AND k = w_k",
+      "w_start > ts",
+      "w_end <= ts AND w_start >= ts - 30",
+  };
+  for (const auto& condition : conditions) {
+    for (const auto joinType :
+         {core::JoinType::kInner,
+          core::JoinType::kLeft,
+          core::JoinType::kRight,
+          core::JoinType::kFull}) {
+      SCOPED_TRACE(
+          fmt::format("{} {}", condition, core::joinTypeName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      core::PlanNodeId joinNodeId;
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(probeVectors)
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          condition,
+                          {"k", "ts", "w_start", "w_end"},
+                          joinType)
+                      .capturePlanNodeId(joinNodeId)
+                      .planNode();
+      const auto sql = fmt::format(
+          "SELECT k, ts, w_start, w_end FROM t {} JOIN u ON {}",
+          core::joinTypeName(joinType),
+          condition);
+
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_).assertResults(sql);
+      auto stats = exec::toPlanStats(task->taskStats()).at(joinNodeId);
+      ASSERT_LT(stats.customStats.at("rangeLookupPairs").sum, 1'000 * 300);
+
+      task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                 .config(
+                     core::QueryConfig::kNestedLoopJoinRangeLookupEnabled,
+                     "false")
+                 .assertResults(sql);
+      stats = exec::toPlanStats(task->taskStats()).at(joinNodeId);
+      ASSERT_EQ(stats.customStats.count("rangeLookupPairs"), 0);
+    }
+  }
+}
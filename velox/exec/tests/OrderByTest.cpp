@@ -391,6 +391,38 @@ TEST_F(OrderByTest, varfields) {
   testSingleKey(vectors, "c2");
 }
 
+TEST_F(OrderByTest, stringCompression) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return (row * 7919 + i) % 997; });
+    auto c1 = makeFlatVector<std::string>(
+        batchSize,
+        [&](vector_size_t row) {
+          return fmt::format(
+              "https://www.example.com/products/category-{}/item?id={}",
+              row % 13,
+              batchSize * i + row);
+        },
+        nullEvery(19));
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy({"c0 ASC NULLS LAST"}, false)
+                        .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool_.get());
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOrderByStringCompression, true)
+      .assertResults(expected);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kOrderByStringCompression, true)
+      .assertResults("SELECT * FROM tmp ORDER BY c0 NULLS LAST");
+}
+
 TEST_F(OrderByTest, unknown) {
   vector_size_t size = 1'000;
   auto vector = makeRowVector({
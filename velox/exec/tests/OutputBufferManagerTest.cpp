@@ -963,6 +963,77 @@ TEST_F(OutputBufferManagerTest, basicArbitrary) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, arbitraryFastConsumerFirst) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kArbitrary, 2, 1);
+
+  // Destination 1 consumes a page over more than the minimum time of a
+  // measurement of its consumption rate.
+  enqueue(taskId, rowType_, size);
+  fetchOne(taskId, 1, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150)); // NOLINT
+  acknowledge(taskId, 1, 1);
+  auto stats = bufferManager_->stats(taskId).value();
+  ASSERT_EQ(stats.buffersStats[0].bytesPerSecond, 0);
+  ASSERT_GT(stats.buffersStats[1].bytesPerSecond, 0);
+  ASSERT_GT(stats.buffersStats[1].bytesSent, 0);
+
+  // Both destinations wait. The next page goes to the measured destination 1
+  // although destination 0 is next in round robin order.
+  bool receivedData0{false};
+  bool receivedData1{false};
+  registerForData(taskId, 0, 0, 1, receivedData0);
+  registerForData(taskId, 1, 1, 1, receivedData1);
+  enqueue(taskId, rowType_, size);
+  ASSERT_TRUE(receivedData1);
+  ASSERT_FALSE(receivedData0);
+  enqueue(taskId, rowType_, size);
+  ASSERT_TRUE(receivedData0);
+  acknowledge(taskId, 0, 1);
+  acknowledge(taskId, 1, 2);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 1);
+  fetchEndMarker(taskId, 1, 2);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+  EXPECT_TRUE(task->isFinished());
+}
+
+TEST_F(OutputBufferManagerTest, arbitraryLoadsMissingBytesOnly) {
+  ArbitraryBuffer buffer;
+  for (int i = 0; i < 10; ++i) {
+    buffer.enqueue(makeSerializedPage(rowType_, 100));
+  }
+  DestinationBuffer destinationBuffer;
+  auto noNotify = [](std::vector<std::unique_ptr<folly::IOBuf>> /*buffers*/,
+                     int64_t /*sequence*/,
+                     std::vector<int64_t> /*remainingBytes*/) { FAIL(); };
+  auto result =
+      destinationBuffer.getData(1, 0, noNotify, [] { return true; }, &buffer);
+  ASSERT_EQ(result.data.size(), 1);
+  ASSERT_EQ(
+      buffer.toString(), "[ARBITRARY_BUFFER PAGES[9] NO MORE DATA[false]]");
+
+  // A repeated fetch is served from the page already taken by this
+  // destination and leaves the others to the other destinations.
+  const auto pageBytes = result.data[0]->computeChainDataLength();
+  result = destinationBuffer.getData(
+      pageBytes, 0, noNotify, [] { return true; }, &buffer);
+  ASSERT_EQ(result.data.size(), 1);
+  ASSERT_EQ(
+      buffer.toString(), "[ARBITRARY_BUFFER PAGES[9] NO MORE DATA[false]]");
+
+  // A larger fetch takes only the missing pages.
+  result = destinationBuffer.getData(
+      pageBytes + 1, 0, noNotify, [] { return true; }, &buffer);
+  ASSERT_EQ(result.data.size(), 2);
+  ASSERT_EQ(
+      buffer.toString(), "[ARBITRARY_BUFFER PAGES[8] NO MORE DATA[false]]");
+}
+
 TEST_F(OutputBufferManagerTest, inactiveDestinationBuffer) {
   const vector_size_t dataSize = 1'000;
   const int maxBytes = 1;
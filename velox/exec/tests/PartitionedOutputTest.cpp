@@ -15,6 +15,7 @@
  */
 #include "velox/exec/PartitionedOutput.h"
 #include <gtest/gtest.h>
+#include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -181,4 +182,39 @@ TEST_F(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_F(PartitionedOutputTest, adaptiveCompression) {
+  // Pages that compress well keep being compressed.
+  detail::AdaptiveCompression compression(0.8, 0);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_TRUE(compression.shouldCompress());
+    compression.recordPage(true, 1'000, 300, 1'000);
+  }
+  ASSERT_NEAR(compression.compressionRatio(), 0.3, 0.001);
+
+  // A poor ratio skips 1, then 3, then 7 pages between samples.
+  detail::AdaptiveCompression incompressible(0.8, 0);
+  for (auto numSkipped : {1, 3, 7}) {
+    ASSERT_TRUE(incompressible.shouldCompress());
+    incompressible.recordPage(true, 1'000, 1'000, 1'000);
+    for (auto i = 0; i < numSkipped; ++i) {
+      ASSERT_FALSE(incompressible.shouldCompress());
+      incompressible.recordPage(false, 1'000, 1'000, 100);
+    }
+  }
+  ASSERT_TRUE(incompressible.shouldCompress());
+
+  // A good ratio is not enough if compressing costs too much CPU per saved
+  // byte: (1'000 - 100) / 1'000 / (1 - 0.5) = 1.8ns.
+  detail::AdaptiveCompression expensive(0.8, 1);
+  expensive.recordPage(false, 1'000, 1'000, 100);
+  expensive.recordPage(true, 1'000, 500, 1'000);
+  ASSERT_NEAR(expensive.nanosPerSavedByte(), 1.8, 0.001);
+  ASSERT_FALSE(expensive.shouldCompress());
+
+  detail::AdaptiveCompression cheap(0.8, 2);
+  cheap.recordPage(false, 1'000, 1'000, 100);
+  cheap.recordPage(true, 1'000, 500, 1'000);
+  ASSERT_TRUE(cheap.shouldCompress());
+}
+
 } // namespace facebook::velox::exec::test
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PipelineDriverController.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class PipelineDriverControllerTest : public testing::Test {
+ protected:
+  // Parks a Driver of 'controller' after its pipeline was blocked on the
+  // consumer. Returns the future of the parked Driver.
+  static ContinueFuture park(PipelineDriverController& controller) {
+    controller.recordBlocked(BlockingReason::kWaitForConsumer, 1'000);
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    EXPECT_EQ(
+        controller.admit(10, &future), BlockingReason::kWaitForActivation);
+    EXPECT_TRUE(future.valid());
+    return future;
+  }
+};
+
+TEST_F(PipelineDriverControllerTest, park) {
+  PipelineDriverController controller(3, 0);
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 3);
+
+  // Time blocked on input outweighs time blocked on the consumer.
+  controller.recordBlocked(BlockingReason::kWaitForConsumer, 100);
+  controller.recordBlocked(BlockingReason::kWaitForConnector, 1'000);
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 3);
+
+  auto first = park(controller);
+  ASSERT_EQ(controller.numActiveDrivers(), 2);
+  auto second = park(controller);
+  ASSERT_EQ(controller.numActiveDrivers(), 1);
+
+  // The last active Driver is never parked.
+  controller.recordBlocked(BlockingReason::kWaitForConsumer, 1'000);
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 1);
+  ASSERT_FALSE(first.isReady());
+  ASSERT_FALSE(second.isReady());
+  controller.activateAll();
+}
+
+TEST_F(PipelineDriverControllerTest, activate) {
+  PipelineDriverController controller(3, 0);
+  auto first = park(controller);
+  auto second = park(controller);
+  ASSERT_EQ(controller.numActiveDrivers(), 1);
+
+  // No parked Driver is activated without queued splits or while the pipeline
+  // is blocked on its consumer.
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_EQ(controller.admit(0, &future), BlockingReason::kNotBlocked);
+  controller.recordBlocked(BlockingReason::kWaitForConsumer, 10);
+  controller.recordBlocked(BlockingReason::kWaitForConnector, 1'000);
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 1);
+  ASSERT_FALSE(first.isReady());
+  ASSERT_FALSE(second.isReady());
+
+  controller.recordBlocked(BlockingReason::kWaitForConnector, 1'000);
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 2);
+  ASSERT_TRUE(second.isReady());
+  ASSERT_FALSE(first.isReady());
+
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 3);
+  ASSERT_TRUE(first.isReady());
+}
+
+TEST_F(PipelineDriverControllerTest, activateAll) {
+  PipelineDriverController controller(4, 0);
+  std::vector<ContinueFuture> futures;
+  for (auto i = 0; i < 3; ++i) {
+    futures.push_back(park(controller));
+  }
+  ASSERT_EQ(controller.numActiveDrivers(), 1);
+
+  controller.activateAll();
+  ASSERT_EQ(controller.numActiveDrivers(), 4);
+  for (const auto& future : futures) {
+    ASSERT_TRUE(future.isReady());
+  }
+
+  // No more Drivers are parked afterwards.
+  controller.recordBlocked(BlockingReason::kWaitForConsumer, 1'000);
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 4);
+}
+
+TEST_F(PipelineDriverControllerTest, adjustInterval) {
+  PipelineDriverController controller(4, 3'600'000'000);
+  controller.recordBlocked(BlockingReason::kWaitForConsumer, 1'000);
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_EQ(controller.admit(10, &future), BlockingReason::kNotBlocked);
+  ASSERT_EQ(controller.numActiveDrivers(), 4);
+}
@@ -219,6 +219,16 @@ TEST_F(PlanNodeSerdeTest, localPartition) {
 
   plan = PlanBuilder().values({data_}).localPartition({"c0", "c1"}).planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .localPartitionByRange(
+                 {"c1 DESC"},
+                 makeRowVector({"c1"}, {makeFlatVector<int32_t>({20, 10})}))
+             .orderBy({"c1 DESC"}, true)
+             .localMergeRangePartitioned({"c1 DESC"})
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, limit) {
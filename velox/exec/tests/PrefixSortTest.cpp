@@ -41,7 +41,10 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t maxStringPrefixLength = 16,
+      uint32_t radixSortMinRows = 1024,
+      uint32_t radixSortMaxKeySize = 32) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -67,7 +70,10 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         compareFlags,
         {1024,
          // Set threshold to 0 to enable prefix-sort in small dataset.
-         0});
+         0,
+         maxStringPrefixLength,
+         radixSortMinRows,
+         radixSortMaxKeySize});
 
     // Extract data from the RowContainer in order.
     const RowVectorPtr actual =
@@ -217,6 +223,49 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings that are equal in the normalized prefix, strings that differ only
+  // by trailing zero bytes and strings longer than the prefix.
+  const std::vector<std::optional<std::string>> strings = {
+      "abcdefgh",
+      "abcdefghij",
+      "abcdefghi",
+      std::string("abc\0", 4),
+      "abc",
+      std::nullopt,
+      "abcdefgh" + std::string(20, 'z'),
+      "abcdefgh" + std::string(20, 'a'),
+      "",
+      std::string("\xff\x01", 2),
+      "abcdefgi",
+  };
+  const auto numRows = strings.size();
+  std::vector<std::optional<StringView>> views;
+  for (const auto& string : strings) {
+    views.push_back(
+        string.has_value() ? std::optional(StringView(*string)) : std::nullopt);
+  }
+  const auto data = makeRowVector({
+      makeNullableFlatVector<StringView>(views, VARCHAR()),
+      makeFlatVector<int64_t>(numRows, [&](auto row) { return numRows - row; }),
+  });
+
+  for (auto prefixLength : {0, 1, 4, 8, 16}) {
+    SCOPED_TRACE(fmt::format("prefix length: {}", prefixLength));
+    testPrefixSort({kAsc}, data, prefixLength);
+    testPrefixSort({kDesc}, data, prefixLength);
+    // The string key is the last normalized key and the bigint key is
+    // compared only if the strings are equal.
+    testPrefixSort({kAsc, kDesc}, data, prefixLength);
+    testPrefixSort({kDesc, kAsc}, data, prefixLength);
+  }
+
+  // Fixed width keys before the string key are normalized too.
+  const auto reversed = makeRowVector({data->childAt(1), data->childAt(0)});
+  testPrefixSort({kAsc, kAsc}, reversed, 4);
+  testPrefixSort({kDesc, kDesc}, reversed, 4);
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -267,5 +316,56 @@ TEST_F(PrefixSortTest, fuzzMulti) {
     testPrefixSort({kDesc, kDesc}, data);
   }
 }
+
+TEST_F(PrefixSortTest, radixSort) {
+  std::vector<TypePtr> keyTypes = {
+      INTEGER(), SMALLINT(), BIGINT(), DOUBLE(), TIMESTAMP(), VARCHAR()};
+
+  VectorFuzzer fuzzer({.vectorSize = 2'000, .nullRatio = 0.1}, pool());
+
+  for (auto i = 0; i < 10; ++i) {
+    auto type1 = fuzzer.randType(keyTypes, 0);
+    auto type2 = fuzzer.randType(keyTypes, 0);
+
+    SCOPED_TRACE(fmt::format("{}, {}", type1->toString(), type2->toString()));
+    auto data = fuzzer.fuzzRow(ROW({type1, type2, VARCHAR()}));
+
+    // Radix sort all rows, also with keys wider than the default limit.
+    testPrefixSort({kAsc, kAsc}, data, 16, 1, 1024);
+    testPrefixSort({kDesc, kAsc}, data, 16, 1, 1024);
+    // String prefixes of 2 bytes leave many ties for the RowContainer.
+    testPrefixSort({kAsc, kDesc}, data, 2, 1, 1024);
+  }
+
+  // Few distinct values give partitions that end in ties.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(5'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int32_t>(5'000, [](auto row) { return row % 3; }),
+  });
+  testPrefixSort({kAsc, kDesc}, data, 16, 1, 1024);
+  testPrefixSort({kDesc, kAsc}, data, 16, 1, 1024);
+}
+
+TEST_F(PrefixSortTest, maxRequiredBytes) {
+  const common::PrefixSortConfig config{1024, 100, 16, 1024, 32};
+
+  RowContainer bigintContainer({BIGINT(), BIGINT()}, pool_.get());
+  // Below the threshold, rows are sorted with std::sort.
+  ASSERT_EQ(
+      PrefixSort::maxRequiredBytes(&bigintContainer, {kAsc, kAsc}, config, 99),
+      0);
+  // Two normalized bigints with their null bytes plus padding and the row
+  // address take 32 bytes per row.
+  const auto bytes = PrefixSort::maxRequiredBytes(
+      &bigintContainer, {kAsc, kAsc}, config, 10'000);
+  ASSERT_GE(bytes, 10'000UL * 32);
+  ASSERT_LT(bytes, 10'000UL * 32 + memory::AllocationTraits::kPageSize + 32);
+
+  // Keys that cannot be normalized fall back to std::sort.
+  RowContainer arrayContainer({ARRAY(BIGINT())}, pool_.get());
+  ASSERT_EQ(
+      PrefixSort::maxRequiredBytes(&arrayContainer, {kAsc}, config, 10'000),
+      0);
+}
 } // namespace
 } // namespace facebook::velox::exec::prefixsort::test
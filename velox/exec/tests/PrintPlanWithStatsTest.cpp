@@ -163,6 +163,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        hashtable.capacity\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        hashtable.numDistinct\\s+sum: 100, count: 1, min: 100, max: 100"},
        {"        hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
+       {"        hashtable.rehashWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        rangeKey0\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -176,6 +177,8 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        blockedWaitForJoinBuildWallNanos\\s+sum: .+, count: 1, min: .+, max: .+",
         true},
        {"        dynamicFiltersProduced\\s+sum: 1, count: 1, min: 1, max: 1"},
+       {"        estimatedOutputBatchBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+",
         true}, // This line may or may not appear depending on how the threads
                // running the Drivers are executed, this only appears if the
@@ -187,30 +190,70 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"       Input: 2000 rows \\(.+\\), Raw Input: 20480 rows \\(.+\\), Output: 2000 rows \\(.+\\), Cpu time: .+, Blocked wall time: .+, Peak memory: .+, Memory allocations: .+, Threads: 1, Splits: 20, DynamicFilter producer plan nodes: 3"},
        {"          dataSourceAddSplitWallNanos[ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          dataSourceReadWallNanos[ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          decompressAheadWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          dynamicFilterPrunedRows\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          dynamicFiltersAccepted[ ]* sum: 1, count: 1, min: 1, max: 1"},
+       {"          fileTailCacheSavedWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          fileTailParseWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          flattenStringDictionaryValues [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          ioWaitNanos      [ ]* sum: .+, count: .+ min: .+, max: .+"},
        {"          localReadBytes      [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
+       {"          localStorageReadBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          maxSingleIoWaitNanos[ ]*sum: .+, count: 1, min: .+, max: .+"},
+       {"          numActiveDrivers\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          numCoalescedFiles\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          numDecompressAhead\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          numFileTailCacheHit\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          numFileTailParse\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          numLocalRead        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          numPrefetch         [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          numRamRead          [ ]* sum: 40, count: 1, min: 40, max: 40"},
+       {"          numSplitPreloadLoads\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          numStorageRead      [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          prefetchBytes       [ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          preloadSavedWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          preloadWaitWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          preloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
         true},
        {"          queryThreadIoLatency[ ]* sum: .+, count: .+ min: .+, max: .+"},
        {"          ramReadBytes        [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          readyPreloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
         true},
+       {"          remainingFilterDeferredColumns\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          remainingFilterSkippedRows\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          remoteStorageReadBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"          skippedPageBytes\\s+sum: .+, count: .+, min: .+, max: .+"},
+       {"          skippedPages\\s+sum: .+, count: .+, min: .+, max: .+"},
        {"          skippedSplitBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          skippedSplits       [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedStrides      [ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          skippedStridesByBloomFilter\\s+sum: .+, count: .+, min: .+, max: .+"},
+       {"          splitPreloadBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"          splitSetupWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
        {"          storageReadBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          stringDictionaryFilteredRows\\s+sum: .+, count: .+, min: .+, max: .+"},
        {"          totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
        {"          totalScanTime       [ ]* sum: .+, count: .+, min: .+, max: .+"},
        {"    -- Project\\[1\\]\\[expressions: \\(u_c0:INTEGER, ROW\\[\"c0\"\\]\\), \\(u_c1:BIGINT, ROW\\[\"c1\"\\]\\)\\] -> u_c0:INTEGER, u_c1:BIGINT"},
@@ -275,6 +318,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"      hashtable.numDistinct\\s+sum: 835, count: 1, min: 835, max: 835"},
          {"      hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
          {"      hashtable.numTombstones\\s+sum: 0, count: 1, min: 0, max: 0"},
+         {"      hashtable.rehashWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      loadedToValueHook\\s+sum: 50000, count: 5, min: 10000, max: 10000"},
          {"      runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -283,30 +327,68 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"     Input: 10000 rows \\(.+\\), Output: 10000 rows \\(.+\\), Cpu time: .+, Blocked wall time: .+, Peak memory: .+, Memory allocations: .+, Threads: 1, Splits: 1"},
          {"        dataSourceAddSplitWallNanos[ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        dataSourceReadWallNanos[ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        decompressAheadWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        fileTailCacheSavedWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        fileTailParseWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        flattenStringDictionaryValues [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        ioWaitNanos      [ ]* sum: .+, count: .+ min: .+, max: .+"},
          {"        localReadBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
+         {"        localStorageReadBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        maxSingleIoWaitNanos[ ]*sum: .+, count: 1, min: .+, max: .+"},
+         {"        numActiveDrivers\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        numCoalescedFiles\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        numDecompressAhead\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        numFileTailCacheHit\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        numFileTailParse\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        numLocalRead     [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        numPrefetch      [ ]* sum: .+, count: .+, min: .+, max: .+"},
          {"        numRamRead       [ ]* sum: 6, count: 1, min: 6, max: 6"},
+         {"        numSplitPreloadLoads\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        numStorageRead   [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
 
          {"        prefetchBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        preloadSavedWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        preloadWaitWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        preloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
           true},
          {"        queryThreadIoLatency[ ]* sum: .+, count: .+ min: .+, max: .+"},
          {"        ramReadBytes     [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        readyPreloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
           true},
+         {"        remainingFilterDeferredColumns\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        remainingFilterSkippedRows\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        remoteStorageReadBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"        skippedPageBytes\\s+sum: .+, count: .+, min: .+, max: .+"},
+         {"        skippedPages\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"        skippedSplitBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        skippedSplits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedStrides   [ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        skippedStridesByBloomFilter\\s+sum: .+, count: .+, min: .+, max: .+"},
+         {"        splitPreloadBytes\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"        splitSetupWallNanos\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
          {"        storageReadBytes [ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        stringDictionaryFilteredRows\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"        totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/RangePartitionFunction.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class RangePartitionFunctionTest : public test::VectorTestBase,
+                                   public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+};
+
+TEST_F(RangePartitionFunctionTest, function) {
+  auto vector = makeRowVector({
+      makeNullableFlatVector<int64_t>({5, 10, 11, std::nullopt, 30, 1, 20}),
+      makeFlatVector<int64_t>({0, 0, 0, 0, 0, 0, 0}),
+  });
+  auto splitters = makeRowVector({makeFlatVector<int64_t>({10, 20})});
+
+  std::vector<uint32_t> partitions;
+  RangePartitionFunction ascending(
+      {0}, {core::SortOrder(true, false)}, splitters);
+  EXPECT_EQ(3, ascending.numPartitions());
+  EXPECT_FALSE(ascending.partition(*vector, partitions).has_value());
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{0, 1, 1, 2, 2, 0, 2}));
+
+  // Nulls first.
+  RangePartitionFunction nullsFirst(
+      {0}, {core::SortOrder(true, true)}, splitters);
+  nullsFirst.partition(*vector, partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{0, 1, 1, 0, 2, 0, 2}));
+
+  // Descending order with splitters in descending order.
+  auto descendingSplitters =
+      makeRowVector({makeFlatVector<int64_t>({20, 10})});
+  RangePartitionFunction descending(
+      {0}, {core::SortOrder(false, false)}, descendingSplitters);
+  descending.partition(*vector, partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{2, 2, 1, 2, 0, 2, 1}));
+
+  // No splitters puts all rows in one partition.
+  RangePartitionFunction single(
+      {0},
+      {core::SortOrder(true, false)},
+      makeRowVector({makeFlatVector<int64_t>({})}));
+  EXPECT_EQ(0, single.partition(*vector, partitions).value());
+}
+
+TEST_F(RangePartitionFunctionTest, multipleKeys) {
+  auto vector = makeRowVector({
+      makeFlatVector<int32_t>({1, 1, 1, 2, 2, 3}),
+      makeFlatVector<std::string>({"a", "m", "z", "a", "z", "a"}),
+  });
+  auto splitters = makeRowVector({
+      makeFlatVector<int32_t>({1, 2}),
+      makeFlatVector<std::string>({"m", "b"}),
+  });
+
+  std::vector<uint32_t> partitions;
+  RangePartitionFunction function(
+      {0, 1},
+      {core::SortOrder(true, false), core::SortOrder(true, false)},
+      splitters);
+  function.partition(*vector, partitions);
+  EXPECT_EQ(partitions, (std::vector<uint32_t>{0, 1, 1, 1, 2, 2}));
+}
+
+TEST_F(RangePartitionFunctionTest, computeSplitters) {
+  const int numRows = 1'000;
+  auto sample = makeRowVector({
+      makeFlatVector<int32_t>(numRows, [](auto row) { return row * 7 % 1000; }),
+      makeFlatVector<int32_t>(numRows, [](auto row) { return row; }),
+  });
+
+  const std::vector<core::SortOrder> ascending{core::SortOrder(true, false)};
+  auto splitters = RangePartitionFunction::computeSplitters(
+      *sample, {0}, ascending, 4, pool());
+  ASSERT_EQ(1, splitters->childrenSize());
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>({250, 500, 750})}), splitters);
+
+  // Every partition gets a quarter of the sample.
+  RangePartitionFunction function({0}, ascending, splitters);
+  std::vector<uint32_t> partitions;
+  function.partition(*sample, partitions);
+  std::vector<int32_t> counts(4);
+  for (auto partition : partitions) {
+    ++counts[partition];
+  }
+  EXPECT_EQ(counts, (std::vector<int32_t>{250, 250, 250, 250}));
+
+  // Duplicate splitters are removed.
+  auto fewValues = makeRowVector(
+      {makeFlatVector<int32_t>(numRows, [](auto row) { return row % 2; })});
+  splitters = RangePartitionFunction::computeSplitters(
+      *fewValues, {0}, ascending, 8, pool());
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>({0, 1})}), splitters);
+}
+
+TEST_F(RangePartitionFunctionTest, spec) {
+  Type::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+
+  auto inputType = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), DOUBLE()});
+  auto splitters = makeRowVector(
+      {"c1", "c0"},
+      {
+          makeFlatVector<std::string>({"b", "d"}),
+          makeFlatVector<int64_t>({1, 2}),
+      });
+  auto spec = std::make_unique<RangePartitionFunctionSpec>(
+      inputType,
+      std::vector<column_index_t>{1, 0},
+      std::vector<core::SortOrder>{
+          core::SortOrder(true, false), core::SortOrder(false, true)},
+      splitters);
+  ASSERT_EQ(
+      "RANGE(c1 ASC NULLS LAST, c0 DESC NULLS FIRST) 2 splitters",
+      spec->toString());
+
+  auto serialized = spec->serialize();
+  ASSERT_EQ(serialized["splitters"].size(), 2);
+
+  auto copy = RangePartitionFunctionSpec::deserialize(serialized, pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+
+  VELOX_ASSERT_THROW(
+      spec->create(2), "Range partitioning has more ranges than partitions");
+  ASSERT_NE(spec->create(3), nullptr);
+}
@@ -19,6 +19,7 @@
 #include "velox/exec/VectorHasher.h"
 #include "velox/exec/tests/utils/RowContainerTestBase.h"
 #include "velox/expression/VectorReaders.h"
+#include "velox/row/CompactRow.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 using namespace facebook::velox;
@@ -1230,6 +1231,141 @@ TEST_F(RowContainerTest, rowSize) {
   EXPECT_EQ(rows, rowsFromContainer);
 }
 
+TEST_F(RowContainerTest, compressedStrings) {
+  constexpr int32_t kNumRows = 1'000;
+  auto data = makeRowContainer({BIGINT()}, {VARCHAR(), VARCHAR()});
+  std::string value;
+  auto urls = makeFlatVector<StringView>(
+      kNumRows,
+      [&](auto row) {
+        value = fmt::format("https://www.example.com/page/{}", row % 97);
+        return StringView(value);
+      },
+      nullEvery(7));
+  std::vector<std::string_view> sample;
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (!urls->isNullAt(i)) {
+      sample.emplace_back(
+          urls->rawValues()[i].data(), urls->rawValues()[i].size());
+    }
+  }
+  VELOX_ASSERT_THROW(
+      data->setCompressedStrings(0, FsstSymbolTable::build(sample)),
+      "");
+  data->setCompressedStrings(1, FsstSymbolTable::build(sample));
+  ASSERT_NE(data->compressedStrings(1), nullptr);
+  ASSERT_EQ(data->compressedStrings(2), nullptr);
+
+  auto keys = makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; });
+  DecodedVector decodedKeys(*keys);
+  DecodedVector decodedUrls(*urls);
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+    data->store(decodedKeys, i, rows[i], 0);
+    data->store(decodedUrls, i, rows[i], 1);
+    data->store(decodedUrls, i, rows[i], 2);
+  }
+  VELOX_ASSERT_THROW(
+      data->setCompressedStrings(2, FsstSymbolTable::build(sample)),
+      "Values have been stored already");
+
+  // Extracting by RowColumn returns the compressed values, which take less
+  // space than the plain ones.
+  auto compressed = BaseVector::create(VARCHAR(), 0, pool());
+  RowContainer::extractColumn(
+      rows.data(), kNumRows, data->columnAt(1), compressed);
+  auto* compressedValues = compressed->asFlatVector<StringView>();
+  int64_t compressedBytes = 0;
+  int64_t plainBytes = 0;
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (!urls->isNullAt(i)) {
+      compressedBytes += compressedValues->valueAt(i).size();
+      plainBytes += urls->valueAt(i).size();
+    }
+  }
+  ASSERT_LT(compressedBytes * 2, plainBytes);
+
+  auto result = BaseVector::create(VARCHAR(), 0, pool());
+  data->extractColumn(rows.data(), kNumRows, 1, result);
+  assertEqualVectors(urls, result);
+
+  // Extract with an offset and through row numbers.
+  result = BaseVector::create(VARCHAR(), 0, pool());
+  data->extractColumn(rows.data(), 10, 1, 5, result);
+  ASSERT_EQ(result->size(), 15);
+  for (auto i = 0; i < 10; ++i) {
+    if (urls->isNullAt(i)) {
+      ASSERT_TRUE(result->isNullAt(i + 5));
+    } else {
+      ASSERT_TRUE(urls->equalValueAt(result.get(), i, i + 5));
+    }
+  }
+  std::vector<vector_size_t> rowNumbers = {7, 3, -1, 3};
+  data->extractColumn(
+      rows.data(),
+      folly::Range<const vector_size_t*>(rowNumbers.data(), rowNumbers.size()),
+      1,
+      0,
+      result);
+  ASSERT_TRUE(result->isNullAt(0));
+  ASSERT_TRUE(urls->equalValueAt(result.get(), 3, 1));
+  ASSERT_TRUE(result->isNullAt(2));
+  ASSERT_TRUE(urls->equalValueAt(result.get(), 3, 3));
+}
+
+TEST_F(RowContainerTest, storeCompactRows) {
+  constexpr int32_t kNumRows = 100;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(row % 30, 'a' + row % 26); },
+          nullEvery(5)),
+      makeFlatVector<Timestamp>(
+          kNumRows,
+          [](auto row) { return Timestamp(row, row * 1'000); },
+          nullEvery(7)),
+      makeFlatVector<bool>(
+          kNumRows, [](auto row) { return row % 3 == 0; }, nullEvery(11)),
+      makeFlatVector<int128_t>(
+          kNumRows,
+          [](auto row) { return HugeInt::build(row, row * 7); },
+          nullEvery(13),
+          DECIMAL(20, 2)),
+      makeFlatVector<double>(
+          kNumRows, [](auto row) { return row * 0.5; }, nullEvery(3)),
+  });
+  auto data = makeRowContainer(
+      {BIGINT()},
+      {VARCHAR(), TIMESTAMP(), BOOLEAN(), DECIMAL(20, 2), DOUBLE()});
+  ASSERT_TRUE(data->supportsCompactRows());
+  ASSERT_FALSE(
+      makeRowContainer({BIGINT()}, {ARRAY(BIGINT())})->supportsCompactRows());
+
+  row::CompactRow compact(input);
+  std::vector<std::string> buffers(kNumRows);
+  std::vector<std::string_view> serialized;
+  for (auto i = 0; i < kNumRows; ++i) {
+    buffers[i].resize(compact.rowSize(i));
+    compact.serialize(i, buffers[i].data());
+    serialized.push_back(buffers[i]);
+  }
+
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  data->storeCompactRows(
+      serialized, folly::Range<char**>(rows.data(), kNumRows));
+
+  for (auto column = 0; column < input->childrenSize(); ++column) {
+    auto result = BaseVector::create(input->childAt(column)->type(), 0, pool());
+    data->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(input->childAt(column), result);
+  }
+}
+
 TEST_F(RowContainerTest, rowSizeWithNormalizedKey) {
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()});
   data->newRow();
@@ -2016,3 +2152,51 @@ TEST_F(RowContainerTest, hugeIntStoreWithNulls) {
   data->extractColumn(rows.data(), kNumRows, kColumnIndex, extracted);
   assertEqualVectors(source, extracted);
 }
+
+TEST_F(RowContainerTest, extractColumns) {
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1'000,
+          .nullRatio = 0.1,
+      },
+      pool());
+
+  for (auto i = 0; i < 20; ++i) {
+    SCOPED_TRACE(fmt::format("Iteration #: {}", i));
+
+    auto rowType = fuzzer.randRowType();
+    auto data = fuzzer.fuzzInputRow(rowType);
+    RowContainer rowContainer{rowType->children(), pool()};
+    auto rows = store(rowContainer, data);
+    std::vector<column_index_t> columns(rowType->size());
+    std::iota(columns.begin(), columns.end(), 0);
+
+    auto copy = BaseVector::create<RowVector>(rowType, data->size(), pool());
+    rowContainer.extractColumns(
+        rows.data(), rows.size(), columns, 0, copy->children());
+    assertEqualVectors(data, copy);
+
+    // Null row pointers extract as nulls. Extracts at an offset that is not a
+    // multiple of the block size and compares with extractColumn().
+    constexpr int32_t kOffset = 5;
+    for (auto row = 0; row < rows.size(); row += 7) {
+      rows[row] = nullptr;
+    }
+    const auto numRows = rows.size();
+    auto expected =
+        BaseVector::create<RowVector>(rowType, numRows + kOffset, pool());
+    auto actual =
+        BaseVector::create<RowVector>(rowType, numRows + kOffset, pool());
+    for (auto column : columns) {
+      rowContainer.extractColumn(
+          rows.data(), numRows, column, kOffset, expected->childAt(column));
+    }
+    rowContainer.extractColumns(
+        rows.data(), numRows, columns, kOffset, actual->children());
+    for (auto row = kOffset; row < numRows + kOffset; ++row) {
+      ASSERT_TRUE(expected->equalValueAt(actual.get(), row, row))
+          << "at " << row << ": " << expected->toString(row) << " vs "
+          << actual->toString(row);
+    }
+  }
+}
@@ -177,6 +177,40 @@ TEST_F(SortBufferTest, multipleKeys) {
   ASSERT_EQ(output->childAt(1)->asFlatVector<int32_t>()->valueAt(4), 2);
 }
 
+TEST_F(SortBufferTest, prefixSortStringKey) {
+  // Sorts on ["c5", "c1"] with a string prefix of 2 bytes, so that most rows
+  // are ordered by the full string comparison.
+  sortColumnIndices_ = {5, 1};
+  auto sortBuffer = std::make_unique<SortBuffer>(
+      inputType_,
+      sortColumnIndices_,
+      sortCompareFlags_,
+      pool_.get(),
+      &nonReclaimableSection_,
+      nullptr,
+      nullptr,
+      common::PrefixSortConfig(1024, 0, 2));
+
+  RowVectorPtr data = makeRowVector(
+      {makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6}),
+       makeFlatVector<int32_t>({1, 2, 3, 4, 5, 6}), // sorted-2 column
+       makeFlatVector<int16_t>({1, 2, 3, 4, 5, 6}),
+       makeFlatVector<float>({1.1, 2.2, 3.3, 4.4, 5.5, 6.6}),
+       makeFlatVector<double>({1.1, 2.2, 3.3, 4.4, 5.5, 6.6}),
+       makeFlatVector<std::string>(
+           {"today", "tomorrow", "to", "today", "a", "tod"})}); // sorted-1
+
+  sortBuffer->addInput(data);
+  sortBuffer->noMoreInput();
+  auto output = sortBuffer->getOutput(10000);
+  ASSERT_EQ(output->size(), 6);
+  const std::vector<int32_t> expected{5, 3, 6, 1, 4, 2};
+  for (auto i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(
+        output->childAt(1)->asFlatVector<int32_t>()->valueAt(i), expected[i]);
+  }
+}
+
 // TODO: enable it later with test utility to compare the sorted result.
 TEST_F(SortBufferTest, DISABLED_randomData) {
   struct {
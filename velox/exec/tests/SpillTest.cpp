@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -401,10 +402,12 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         fmt::format(
             "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] "
             "spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] "
+            "spilledRemoteBytes[0B] spilledRemoteFiles[0] "
             "spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] "
             "spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] "
-            "maxSpillExceededLimitCount[0] spillReadBytes[{}] spillReads[{}] "
-            "spillReadTime[{}] spillReadDeserializationTime[{}]",
+            "spillWriteWaitTime[0us] maxSpillExceededLimitCount[0] "
+            "spillReadBytes[{}] spillReads[{}] spillReadTime[{}] "
+            "spillReadWaitTime[{}] spillReadDeserializationTime[{}]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -420,6 +423,7 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctMicros(finalStats.spillReadTimeUs),
+            succinctMicros(finalStats.spillReadWaitTimeUs),
             succinctMicros(finalStats.spillDeserializationTimeUs)));
 
     // Verify the spilled files are still there after spill state destruction.
@@ -519,6 +523,202 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, columnarFormat) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const int32_t numBatches = 4;
+  const int32_t numRowsPerBatch = 100;
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      emptyCompareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      /*columnarFormat=*/true);
+  state.setPartitionSpilled(0);
+  // Writes two sorted files with interleaved keys. Each batch is flushed
+  // separately as the write buffer size is 0.
+  for (auto file = 0; file < 2; ++file) {
+    for (auto batch = 0; batch < numBatches; ++batch) {
+      auto keyAt = [&](auto row) {
+        return 2 * (batch * numRowsPerBatch + row) + file;
+      };
+      state.appendToPartition(
+          0,
+          makeRowVector(
+              {makeFlatVector<int64_t>(numRowsPerBatch, keyAt),
+               makeFlatVector<std::string>(numRowsPerBatch, [&](auto row) {
+                 return fmt::format("payload {}", keyAt(row));
+               })}));
+    }
+    state.finishFile(0);
+  }
+  auto files = state.finish(0);
+  ASSERT_EQ(files.size(), 2);
+  for (const auto& file : files) {
+    ASSERT_TRUE(file.columnarFormat);
+  }
+  if (compressionKind_ != common::CompressionKind::CompressionKind_NONE) {
+    ASSERT_TRUE(
+        runtimeStats_.count("spillKeyCompressionInputBytes") != 0 ||
+        runtimeStats_.count("spillKeyCompressionSkippedBytes") != 0);
+  }
+
+  // Reading the keys only skips over the other columns.
+  {
+    auto reader =
+        SpillReadFile::create(files[0], 1 << 20, pool(), &spillStats_);
+    RowVectorPtr batch;
+    for (auto i = 0; i < numBatches; ++i) {
+      ASSERT_TRUE(reader->nextBatch(batch, /*deferPayload=*/true));
+      ASSERT_EQ(batch->size(), numRowsPerBatch);
+      ASSERT_EQ(
+          batch->childAt(0)->asFlatVector<int64_t>()->valueAt(0),
+          2 * i * numRowsPerBatch);
+      ASSERT_EQ(batch->childAt(1), nullptr);
+      // Loads the other columns of every other batch.
+      if (i % 2 == 1) {
+        reader->loadPayload(*batch);
+        ASSERT_EQ(
+            batch->childAt(1)->asFlatVector<StringView>()->valueAt(1).str(),
+            fmt::format("payload {}", 2 * i * numRowsPerBatch + 2));
+      }
+    }
+    ASSERT_FALSE(reader->nextBatch(batch, /*deferPayload=*/true));
+    ASSERT_EQ(runtimeStats_.at("spillPayloadSkippedBytes").count, 2);
+  }
+
+  // The merge reads the other columns as these are accessed.
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge =
+      spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+  for (auto i = 0; i < 2 * numBatches * numRowsPerBatch; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    ASSERT_EQ(
+        fmt::format("payload {}", i),
+        stream->decoded(1).valueAt<StringView>(stream->currentIndex()).str());
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
+TEST_P(SpillTest, asyncWriteAndReadahead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  const int32_t numBatches = 20;
+  const int32_t numRowsPerBatch = 1'000;
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      0,
+      emptyCompareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      /*columnarFormat=*/false,
+      executor.get());
+  state.setPartitionSpilled(0);
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < numBatches; ++i) {
+    batches.push_back(makeRowVector({makeFlatVector<int64_t>(
+        numRowsPerBatch,
+        [&](auto row) { return i * numRowsPerBatch + row; })}));
+    // Each batch is flushed on append as the write buffer size is 0.
+    state.appendToPartition(0, batches.back());
+  }
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  auto stats = spillStats_.copy();
+  ASSERT_EQ(stats.spillWrites, numBatches);
+  ASSERT_EQ(stats.spilledBytes, spillPartition.size());
+
+  // Reads with a small buffer to prefetch the rest of the file on 'executor'.
+  auto reader = spillPartition.createUnorderedReader(
+      8 << 10, pool(), &spillStats_, executor.get());
+  RowVectorPtr output;
+  for (auto i = 0; i < numBatches; ++i) {
+    ASSERT_TRUE(reader->nextBatch(output));
+    velox::test::assertEqualVectors(batches[i], output);
+  }
+  ASSERT_FALSE(reader->nextBatch(output));
+  stats = spillStats_.copy();
+  ASSERT_GT(stats.spillReads, 1);
+  ASSERT_EQ(stats.spillReadBytes, stats.spilledBytes);
+  ASSERT_GE(stats.spillReadOverlapRatio(), 0);
+  ASSERT_LE(stats.spillReadOverlapRatio(), 1);
+}
+
+TEST_P(SpillTest, remoteSpillTier) {
+  auto localDirectory = exec::test::TempDirectoryPath::create();
+  auto remoteDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  const auto batch = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  const auto spill = [&](uint64_t minLocalFreeBytes) {
+    SpillState state(
+        [&]() -> const std::string& { return localDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        0,
+        emptyCompareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        /*fileCreateConfig=*/{},
+        /*columnarFormat=*/false,
+        /*executor=*/nullptr,
+        common::RemoteSpillConfig{
+            [&]() -> const std::string& { return remoteDirectory->getPath(); },
+            minLocalFreeBytes});
+    state.setPartitionSpilled(0);
+    state.appendToPartition(0, batch);
+    return state.finish(0);
+  };
+
+  // The local file system has enough free space.
+  auto files = spill(0);
+  ASSERT_EQ(files.size(), 1);
+  ASSERT_EQ(files[0].path.find(localDirectory->getPath()), 0);
+  auto stats = spillStats_.copy();
+  ASSERT_EQ(stats.spilledFiles, 1);
+  ASSERT_EQ(stats.spilledRemoteFiles, 0);
+  ASSERT_EQ(stats.spilledRemoteBytes, 0);
+
+  // The local file system is below the min free space.
+  files = spill(std::numeric_limits<uint64_t>::max());
+  ASSERT_EQ(files.size(), 1);
+  ASSERT_EQ(files[0].path.find(remoteDirectory->getPath()), 0);
+  stats = spillStats_.copy();
+  ASSERT_EQ(stats.spilledFiles, 2);
+  ASSERT_EQ(stats.spilledRemoteFiles, 1);
+  ASSERT_EQ(stats.spilledRemoteBytes, files[0].size);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto reader =
+      spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+  RowVectorPtr output;
+  ASSERT_TRUE(reader->nextBatch(output));
+  velox::test::assertEqualVectors(batch, output);
+  ASSERT_FALSE(reader->nextBatch(output));
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitResultCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class SplitResultCacheTest : public testing::Test,
+                             public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+    filesystems::registerLocalFileSystem();
+    if (!isRegisteredVectorSerde()) {
+      serializer::presto::PrestoVectorSerde::registerVectorSerde();
+    }
+  }
+
+  // Returns a result with 'numBatches' batches of 'data'.
+  std::shared_ptr<SplitResult> makeResult(
+      const SplitResultCache& cache,
+      const RowVectorPtr& data,
+      int32_t numBatches) {
+    auto result = std::make_shared<SplitResult>();
+    for (auto i = 0; i < numBatches; ++i) {
+      result->batches.push_back(cache.serialize(data, pool()));
+      result->bytes += result->batches.back().size();
+    }
+    return result;
+  }
+
+  void assertResult(
+      const SplitResultCache& cache,
+      const std::shared_ptr<const SplitResult>& result,
+      const RowVectorPtr& expected,
+      int32_t numBatches) {
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->batches.size(), numBatches);
+    for (const auto& batch : result->batches) {
+      test::assertEqualVectors(
+          expected,
+          cache.deserialize(batch, asRowType(expected->type()), pool()));
+    }
+  }
+
+  // The results of all seeds have the same serialized size.
+  RowVectorPtr makeData(int32_t seed) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return row + seed; }),
+        makeFlatVector<StringView>(
+            100,
+            [&](auto row) {
+              return StringView::makeInline(
+                  fmt::format("{:05}", row * seed));
+            },
+            nullEvery(7)),
+    });
+  }
+};
+
+TEST_F(SplitResultCacheTest, memory) {
+  const auto data = makeData(1);
+  SplitResultCache::Options options;
+  SplitResultCache probe(options);
+  const auto resultBytes = makeResult(probe, data, 2)->bytes;
+  // Room for 3 results.
+  options.maxMemoryBytes = 3 * resultBytes + resultBytes / 2;
+  options.maxEntryBytes = 2 * resultBytes;
+  SplitResultCache cache(options);
+
+  ASSERT_EQ(cache.find("a"), nullptr);
+  cache.insert("a", makeResult(cache, data, 2));
+  cache.insert("b", makeResult(cache, data, 2));
+  cache.insert("c", makeResult(cache, data, 2));
+  assertResult(cache, cache.find("a"), data, 2);
+
+  // 'b' is the least recently used.
+  cache.insert("d", makeResult(cache, data, 2));
+  ASSERT_EQ(cache.find("b"), nullptr);
+  assertResult(cache, cache.find("a"), data, 2);
+  assertResult(cache, cache.find("c"), data, 2);
+  assertResult(cache, cache.find("d"), data, 2);
+
+  // Too large to cache.
+  cache.insert("e", makeResult(cache, data, 5));
+  ASSERT_EQ(cache.find("e"), nullptr);
+
+  // An empty result is cached.
+  cache.insert("f", std::make_shared<SplitResult>());
+  assertResult(cache, cache.find("f"), data, 0);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numInserts, 5);
+  ASSERT_EQ(stats.numHits, 5);
+  ASSERT_EQ(stats.numMisses, 3);
+  ASSERT_EQ(stats.numEntries, 4);
+  ASSERT_EQ(stats.numSsdEntries, 0);
+  ASSERT_LE(stats.memoryBytes, options.maxMemoryBytes);
+
+  cache.clear();
+  ASSERT_EQ(cache.find("a"), nullptr);
+  ASSERT_EQ(cache.stats().memoryBytes, 0);
+}
+
+TEST_F(SplitResultCacheTest, ssd) {
+  auto directory = exec::test::TempDirectoryPath::create();
+  const auto data = makeData(1);
+  const auto otherData = makeData(2);
+  SplitResultCache::Options options;
+  SplitResultCache probe(options);
+  const auto resultBytes = makeResult(probe, data, 2)->bytes;
+  // Room for 1 result in memory and 2 on SSD.
+  options.maxMemoryBytes = resultBytes + resultBytes / 2;
+  options.ssdPath = directory->getPath() + "/splitResults";
+  options.maxSsdBytes = 2 * resultBytes + resultBytes / 2;
+  {
+    SplitResultCache cache(options);
+    cache.insert("a", makeResult(cache, data, 2));
+    cache.insert("b", makeResult(cache, otherData, 2));
+    cache.insert("c", makeResult(cache, data, 2));
+    auto stats = cache.stats();
+    ASSERT_EQ(stats.numEntries, 1);
+    ASSERT_EQ(stats.numSsdEntries, 2);
+
+    // 'b' moves back to memory and 'c' to SSD.
+    assertResult(cache, cache.find("b"), otherData, 2);
+    assertResult(cache, cache.find("a"), data, 2);
+    assertResult(cache, cache.find("c"), data, 2);
+    stats = cache.stats();
+    ASSERT_EQ(stats.numHits, 3);
+    ASSERT_EQ(stats.numSsdHits, 3);
+    ASSERT_EQ(stats.numEntries, 1);
+    ASSERT_EQ(stats.numSsdEntries, 2);
+
+    // 'b' is dropped from SSD as the least recently used.
+    cache.insert("d", makeResult(cache, data, 2));
+    ASSERT_EQ(cache.find("b"), nullptr);
+    ASSERT_EQ(cache.stats().numSsdEntries, 2);
+  }
+  // The destructor removes the files.
+  auto fs = filesystems::getFileSystem(options.ssdPath, nullptr);
+  ASSERT_TRUE(fs->list(options.ssdPath).empty());
+}
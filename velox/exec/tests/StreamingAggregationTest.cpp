@@ -63,6 +63,9 @@ class StreamingAggregationTest : public OperatorTestBase {
         .config(
             core::QueryConfig::kPreferredOutputBatchRows,
             std::to_string(outputBatchSize))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows,
+            std::to_string(outputBatchSize))
         .assertResults(
             "SELECT c0, count(1), min(c1), max(c1), sum(c1), sum(1), sum(cast(NULL as INT))"
             "     , approx_quantile(c1, 0.95) "
@@ -84,6 +87,9 @@ class StreamingAggregationTest : public OperatorTestBase {
         .config(
             core::QueryConfig::kPreferredOutputBatchRows,
             std::to_string(outputBatchSize))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows,
+            std::to_string(outputBatchSize))
         .assertResults(
             "SELECT c0, count(1), min(c1), max(c1), sum(c1), sum(1) FROM tmp GROUP BY 1");
 
@@ -105,6 +111,9 @@ class StreamingAggregationTest : public OperatorTestBase {
         .config(
             core::QueryConfig::kPreferredOutputBatchRows,
             std::to_string(outputBatchSize))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows,
+            std::to_string(outputBatchSize))
         .assertResults(
             "SELECT c0, count(1), min(c1) filter (where c1 % 7 = 0), "
             "max(c1) filter (where c1 % 11 = 0), sum(c1) filter (where c1 % 7 = 0) "
@@ -142,6 +151,9 @@ class StreamingAggregationTest : public OperatorTestBase {
         .config(
             core::QueryConfig::kPreferredOutputBatchRows,
             std::to_string(outputBatchSize))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows,
+            std::to_string(outputBatchSize))
         .assertResults(
             "SELECT c0, max(c1 order by c2), max(c1 order by c2 desc), array_agg(c1 order by c2) FROM tmp GROUP BY c0");
   }
@@ -179,6 +191,9 @@ class StreamingAggregationTest : public OperatorTestBase {
           .config(
               core::QueryConfig::kPreferredOutputBatchRows,
               std::to_string(outputBatchSize))
+          .config(
+              core::QueryConfig::kMaxOutputBatchRows,
+              std::to_string(outputBatchSize))
           .assertResults(
               "SELECT c0, array_agg(distinct c1), array_agg(c1 order by c2), "
               "count(distinct c1), array_agg(c2) FROM tmp GROUP BY c0");
@@ -196,6 +211,9 @@ class StreamingAggregationTest : public OperatorTestBase {
           .config(
               core::QueryConfig::kPreferredOutputBatchRows,
               std::to_string(outputBatchSize))
+          .config(
+              core::QueryConfig::kMaxOutputBatchRows,
+              std::to_string(outputBatchSize))
           .assertResults("SELECT distinct c0 FROM tmp");
     }
   }
@@ -267,6 +285,9 @@ class StreamingAggregationTest : public OperatorTestBase {
         .config(
             core::QueryConfig::kPreferredOutputBatchRows,
             std::to_string(outputBatchSize))
+        .config(
+            core::QueryConfig::kMaxOutputBatchRows,
+            std::to_string(outputBatchSize))
         .assertResults(sql);
 
     EXPECT_EQ(NonPODInt64::constructed, NonPODInt64::destructed);
@@ -313,6 +334,9 @@ class StreamingAggregationTest : public OperatorTestBase {
           .config(
               core::QueryConfig::kPreferredOutputBatchRows,
               std::to_string(outputBatchSize))
+          .config(
+              core::QueryConfig::kMaxOutputBatchRows,
+              std::to_string(outputBatchSize))
           .assertResults(sql);
 
       EXPECT_EQ(NonPODInt64::constructed, NonPODInt64::destructed);
@@ -342,6 +366,9 @@ class StreamingAggregationTest : public OperatorTestBase {
           .config(
               core::QueryConfig::kPreferredOutputBatchRows,
               std::to_string(outputBatchSize))
+          .config(
+              core::QueryConfig::kMaxOutputBatchRows,
+              std::to_string(outputBatchSize))
           .assertResults(sql);
     }
   }
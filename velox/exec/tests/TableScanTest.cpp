@@ -33,6 +33,7 @@
 #include "velox/exec/Exchange.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/SplitResultCache.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -323,6 +324,33 @@ TEST_F(TableScanTest, directBufferInputRawInputBytes) {
   EXPECT_GT(getTableScanRuntimeStats(task)["queryThreadIoLatency"].sum, 0);
 }
 
+TEST_F(TableScanTest, decompressAhead) {
+  auto vectors = makeVectors(10, 1'000);
+  createDuckDbTable(vectors);
+  // Reads a new copy of the data with or without decompress-ahead. A new file
+  // is read from storage, not from the cache.
+  const auto scanStats = [&](bool decompressAhead) {
+    resetHiveConnector(std::make_shared<core::MemConfig>(
+        std::unordered_map<std::string, std::string>{
+            {connector::hive::HiveConfig::kDecompressAhead,
+             decompressAhead ? "true" : "false"}}));
+    auto filePath = TempFilePath::create();
+    writeToFile(filePath->getPath(), vectors);
+    auto task = assertQuery(tableScanNode(), {filePath}, "SELECT * FROM tmp");
+    return getTableScanRuntimeStats(task);
+  };
+  auto baseline = scanStats(false);
+  auto stats = scanStats(true);
+  ASSERT_EQ(baseline.count("numDecompressAhead"), 0);
+  ASSERT_GT(stats.at("numDecompressAhead").sum, 0);
+  // Streams are decompressed after the reads of the stripe are coalesced and
+  // loaded, so the storage is read the same way as without decompress-ahead.
+  ASSERT_EQ(
+      stats.at("numStorageRead").sum, baseline.at("numStorageRead").sum);
+  ASSERT_EQ(
+      stats.at("storageReadBytes").sum, baseline.at("storageReadBytes").sum);
+}
+
 TEST_F(TableScanTest, connectorStats) {
   auto hiveConnector =
       std::dynamic_pointer_cast<connector::hive::HiveConnector>(
@@ -609,6 +637,48 @@ DEBUG_ONLY_TEST_F(TableScanTest, timeLimitInGetOutput) {
   EXPECT_GE(numBailed, 12);
 }
 
+TEST_F(TableScanTest, adaptiveDriverCount) {
+  constexpr int32_t kNumFiles = 20;
+  constexpr int32_t kNumDrivers = 4;
+  auto vectors = makeVectors(2, 1'000);
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> vectorsForDuckDb;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    filePaths.emplace_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), vectors);
+    vectorsForDuckDb.insert(
+        vectorsForDuckDb.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(vectorsForDuckDb);
+
+  // The tiny local exchange buffer blocks the scan drivers on their consumer
+  // after each batch, so that drivers are parked.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .capturePlanNodeId(scanNodeId)
+                  .localPartitionRoundRobin()
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .plan(plan)
+          .splits(scanNodeId, makeHiveConnectorSplits(filePaths))
+          .maxDrivers(kNumDrivers)
+          .config(QueryConfig::kAdaptiveDriverCountEnabled, "true")
+          .config(QueryConfig::kAdaptiveDriverCountIntervalMs, "0")
+          .config(QueryConfig::kMaxLocalExchangeBufferSize, "1")
+          .assertResults("SELECT * FROM tmp");
+
+  // The drivers record the number of active drivers at least before each
+  // split and once more when they find there are no more splits.
+  const auto stats = toPlanStats(task->taskStats()).at(scanNodeId);
+  const auto& activeDrivers = stats.customStats.at("numActiveDrivers");
+  ASSERT_GE(activeDrivers.count, kNumFiles + kNumDrivers);
+  ASSERT_GE(activeDrivers.min, 1);
+  ASSERT_LT(activeDrivers.min, kNumDrivers);
+  ASSERT_LE(activeDrivers.max, kNumDrivers);
+}
+
 TEST_F(TableScanTest, subfieldPruningRowType) {
   auto innerType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
   auto columnType = ROW({"c", "d"}, {innerType, BIGINT()});
@@ -1208,6 +1278,98 @@ TEST_F(TableScanTest, missingColumns) {
   assertQuery(op, filePaths, "SELECT * FROM tmp", 0);
 }
 
+TEST_F(TableScanTest, aggregatedColumns) {
+  constexpr vector_size_t kSize = 1'000;
+  auto data = makeRowVector(
+      {"c0", "c1", "c2"},
+      {
+          makeFlatVector<int64_t>(kSize, [](auto row) { return row - 500; }),
+          makeFlatVector<double>(
+              kSize, [](auto row) { return row * 0.5; }, nullEvery(7)),
+          makeFlatVector<std::string>(
+              kSize, [](auto row) { return fmt::format("s{}", row % 97); }),
+      });
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {data});
+  createDuckDbTable({data});
+  auto dataColumns = asRowType(data->type());
+
+  auto aggregatedColumn = [](const std::string& name,
+                             const std::string& aggregation,
+                             const TypePtr& type) {
+    return std::make_shared<HiveColumnHandle>(
+        name,
+        HiveColumnHandle::ColumnType::kAggregated,
+        type,
+        type,
+        std::vector<common::Subfield>{},
+        aggregation);
+  };
+  ColumnHandleMap assignments = {
+      {"a0", aggregatedColumn("", "count", BIGINT())},
+      {"a1", aggregatedColumn("c1", "count", BIGINT())},
+      {"a2", aggregatedColumn("c0", "min", BIGINT())},
+      {"a3", aggregatedColumn("c0", "max", BIGINT())},
+      {"a4", aggregatedColumn("c0", "sum", BIGINT())},
+      {"a5", aggregatedColumn("c1", "max", DOUBLE())},
+      {"a6", aggregatedColumn("c2", "min", VARCHAR())},
+  };
+  auto outputType =
+      ROW({"a0", "a1", "a2", "a3", "a4", "a5", "a6"},
+          {BIGINT(),
+           BIGINT(),
+           BIGINT(),
+           BIGINT(),
+           BIGINT(),
+           DOUBLE(),
+           VARCHAR()});
+  const std::string sql =
+      "SELECT count(*), count(c1), min(c0), max(c0), sum(c0), max(c1), "
+      "min(c2) FROM tmp";
+
+  // The split covers the whole file and no row is filtered out, so the file
+  // statistics answer the aggregates.
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(outputType)
+                  .dataColumns(dataColumns)
+                  .assignments(assignments)
+                  .endTableScan()
+                  .planNode();
+  auto task = assertQuery(plan, {filePath}, sql);
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task)["numSplitsAggregatedFromStats"].sum, 1);
+
+  // With a filter on a data column the rows that pass are aggregated.
+  plan = PlanBuilder()
+             .startTableScan()
+             .outputType(outputType)
+             .dataColumns(dataColumns)
+             .assignments(assignments)
+             .subfieldFilter("c0 > 100")
+             .endTableScan()
+             .planNode();
+  task = assertQuery(plan, {filePath}, sql + " WHERE c0 > 100");
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).count("numSplitsAggregatedFromStats"), 0);
+
+  // Aggregated columns cannot be mixed with other columns.
+  plan = PlanBuilder()
+             .startTableScan()
+             .outputType(ROW({"a0", "c0"}, {BIGINT(), BIGINT()}))
+             .dataColumns(dataColumns)
+             .assignments(
+                 {{"a0", assignments.at("a0")},
+                  {"c0", regularColumn("c0", BIGINT())}})
+             .endTableScan()
+             .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .split(makeHiveConnectorSplit(filePath->getPath()))
+          .copyResults(pool()),
+      "Aggregated columns cannot be mixed with other columns");
+}
+
 // Tests queries that use Lazy vectors with multiple layers of wrapping.
 TEST_F(TableScanTest, constDictLazy) {
   vector_size_t size = 1'000;
@@ -1469,6 +1631,46 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, multiFileSplit) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 10);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // Two splits of 8 files and one of 4 files.
+  auto makeSplits = [&]() {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    std::vector<std::shared_ptr<HiveConnectorSplit>> fileSplits;
+    for (int32_t i = 0; i < filePaths.size(); ++i) {
+      fileSplits.push_back(makeHiveConnectorSplit(filePaths[i]->getPath()));
+      if (fileSplits.size() == 8 || i == filePaths.size() - 1) {
+        splits.push_back(std::make_shared<HiveMultiFileConnectorSplit>(
+            kHiveConnectorId, std::move(fileSplits)));
+        fileSplits.clear();
+      }
+    }
+    return splits;
+  };
+
+  for (const auto numPrefetchSplit : {0, 2}) {
+    SCOPED_TRACE(fmt::format("numPrefetchSplit {}", numPrefetchSplit));
+    auto task = assertQuery(
+        tableScanNode(), makeSplits(), "SELECT * FROM tmp", numPrefetchSplit);
+    auto stats = getTableScanRuntimeStats(task);
+    ASSERT_EQ(stats.at("numCoalescedFiles").sum, 20);
+    ASSERT_GT(stats.at("splitSetupWallNanos").sum, 0);
+    ASSERT_EQ(task->taskStats().numFinishedSplits, 3);
+  }
+
+  VELOX_ASSERT_THROW(
+      std::make_shared<HiveMultiFileConnectorSplit>(
+          kHiveConnectorId,
+          std::vector<std::shared_ptr<HiveConnectorSplit>>{}),
+      "Multi-file split must have a file");
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -3229,6 +3431,74 @@ TEST_F(TableScanTest, remainingFilterLazyWithMultiReferences) {
   ASSERT_TRUE(waitForTaskCompletion(cursor->task().get()));
 }
 
+TEST_F(TableScanTest, remainingFilterConjuncts) {
+  constexpr int kSize = 1'000;
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+  });
+  auto schema = asRowType(vector->type());
+  auto file = TempFilePath::create();
+  writeToFile(file->getPath(), {vector});
+  createDuckDbTable({vector});
+
+  // c1 is loaded only for the rows that pass the filter on c0.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(schema, {}, "c0 % 2 = 0 AND c1 % 3 = 0")
+                  .capturePlanNodeId(scanNodeId)
+                  .planNode();
+  auto task = assertQuery(
+      plan, {file}, "SELECT * FROM tmp WHERE c0 % 2 = 0 AND c1 % 3 = 0");
+  auto stats = toPlanStats(task->taskStats()).at(scanNodeId).customStats;
+  EXPECT_EQ(stats.at("remainingFilterDeferredColumns").sum, 1);
+  EXPECT_EQ(stats.at("remainingFilterSkippedRows").sum, kSize / 2);
+
+  // The division by zero in the first conjunct is on a row the second
+  // conjunct is false for, so it is not raised.
+  plan = PlanBuilder()
+             .tableScan(schema, {}, "100 / c0 >= 0 AND c1 % 2 = 1")
+             .planNode();
+  assertQuery(plan, {file}, "SELECT * FROM tmp WHERE c1 % 2 = 1");
+}
+
+TEST_F(TableScanTest, disjunctionAcrossColumns) {
+  constexpr int kSize = 10'000;
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(kSize, folly::identity),
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row % 7; }, nullEvery(11)),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("{:05}", row); }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row * 2; }),
+  });
+  auto dataColumns = asRowType(vector->type());
+  auto filePaths = makeFilePaths(2);
+  for (const auto& filePath : filePaths) {
+    writeToFile(filePath->getPath(), {vector});
+  }
+  createDuckDbTable({vector, vector});
+
+  // The disjunctions are on columns that are not projected and are
+  // evaluated by the scan without a remaining filter.
+  auto outputType = ROW({"c3"}, {BIGINT()});
+  auto assertDisjunction = [&](const std::string& filter) {
+    auto plan = PlanBuilder()
+                    .tableScan(outputType, {}, filter, dataColumns)
+                    .planNode();
+    assertQuery(plan, filePaths, "SELECT c3 FROM tmp WHERE " + filter);
+  };
+  assertDisjunction("c0 < 100 OR c1 = 3");
+  assertDisjunction("c1 IS NULL OR c2 >= '09990'");
+  assertDisjunction("(c0 < 3000 OR c2 = '05000') AND c1 % 2 = 0");
+  // A column in two conjuncts is read for the remaining filter.
+  assertDisjunction(
+      "(c0 BETWEEN 10 AND 20 OR c2 = '00500') AND (c1 = 1 OR c0 > 9000)");
+  // A disjunction on a projected column stays in the remaining filter.
+  assertDisjunction("c3 = 10 OR c1 = 5");
+}
+
 TEST_F(TableScanTest, remainingFilterSkippedStrides) {
   auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}});
   std::vector<RowVectorPtr> vectors(3);
@@ -4457,6 +4727,52 @@ TEST_F(TableScanTest, readFlatMapAsStruct) {
   AssertQueryBuilder(plan).split(split).assertResults(vector);
 }
 
+TEST_F(TableScanTest, readFlatMapAsStructMissingKeys) {
+  constexpr int kSize = 10;
+  std::vector<std::string> keys = {"1", "2"};
+  auto vector = makeRowVector({makeRowVector(
+      keys,
+      {
+          makeFlatVector<int64_t>(kSize, folly::identity),
+          makeFlatVector<int64_t>(kSize, folly::identity, nullEvery(3)),
+      })});
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set<const std::vector<uint32_t>>(dwrf::Config::MAP_FLAT_COLS, {0});
+  config->set<const std::vector<std::vector<std::string>>>(
+      dwrf::Config::MAP_FLAT_COLS_STRUCT_KEYS, {keys});
+  auto file = TempFilePath::create();
+  auto writeSchema = ROW({"c0"}, {MAP(INTEGER(), BIGINT())});
+  writeToFile(file->getPath(), {vector}, config, writeSchema);
+
+  // Only the streams of keys 2 and 1 are read. Key 4 is not in the file and
+  // reads as null.
+  auto readSchema =
+      ROW({"c0"}, {ROW({"2", "4", "1"}, {BIGINT(), BIGINT(), BIGINT()})});
+  auto expected = makeRowVector({makeRowVector(
+      {"2", "4", "1"},
+      {
+          makeFlatVector<int64_t>(kSize, folly::identity, nullEvery(3)),
+          makeNullConstant(TypeKind::BIGINT, kSize),
+          makeFlatVector<int64_t>(kSize, folly::identity),
+      })});
+  auto plan =
+      PlanBuilder().tableScan(readSchema, {}, "", writeSchema).planNode();
+  auto split = makeHiveConnectorSplit(file->getPath());
+  AssertQueryBuilder(plan).split(split).assertResults(expected);
+
+  // None of the requested keys is in the file.
+  readSchema = ROW({"c0"}, {ROW({"4", "5"}, {BIGINT(), BIGINT()})});
+  expected = makeRowVector({makeRowVector(
+      {"4", "5"},
+      {
+          makeNullConstant(TypeKind::BIGINT, kSize),
+          makeNullConstant(TypeKind::BIGINT, kSize),
+      })});
+  plan = PlanBuilder().tableScan(readSchema, {}, "", writeSchema).planNode();
+  AssertQueryBuilder(plan).split(split).assertResults(expected);
+}
+
 // TODO: re-enable this test once we add back driver suspension support for
 // table scan.
 TEST_F(TableScanTest, DISABLED_memoryArbitrationWithSlowTableScan) {
@@ -4672,3 +4988,196 @@ DEBUG_ONLY_TEST_F(TableScanTest, cancellationToken) {
   }
   queryThread.join();
 }
+
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // The files hold descending runs of c0, so that after the first file the
+  // TopN threshold excludes all later rows.
+  constexpr int kNumFiles = 5;
+  constexpr int kRowsPerFile = 1'000;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kRowsPerFile,
+            [&](auto row) { return (kNumFiles - i) * kRowsPerFile - row; },
+            nullEvery(7)),
+        makeFlatVector<int64_t>(kRowsPerFile, [](auto row) { return row; }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId scanNodeId;
+  core::PlanNodeId topNNodeId;
+  for (const auto& order :
+       {"DESC NULLS LAST", "DESC NULLS FIRST", "NULLS LAST", "NULLS FIRST"}) {
+    SCOPED_TRACE(order);
+    const auto key = fmt::format("c0 {}", order);
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .tableScan(ROW({"c0", "c1"}, {BIGINT(), BIGINT()}))
+                    .capturePlanNodeId(scanNodeId)
+                    .topN({key, "c1"}, 10, false)
+                    .capturePlanNodeId(topNNodeId)
+                    .planNode();
+    for (const auto enabled : {false, true}) {
+      auto task =
+          AssertQueryBuilder(duckDbQueryRunner_)
+              .plan(plan)
+              .splits(makeHiveConnectorSplits(filePaths))
+              .config(
+                  QueryConfig::kTopNDynamicFilterEnabled,
+                  enabled ? "true" : "false")
+              .assertResults(fmt::format(
+                  "SELECT * FROM tmp ORDER BY {}, c1 LIMIT 10", key));
+      const auto planStats = toPlanStats(task->taskStats());
+      const auto& topNStats = planStats.at(topNNodeId);
+      if (!enabled) {
+        ASSERT_EQ(topNStats.inputRows, kNumFiles * kRowsPerFile);
+        ASSERT_EQ(topNStats.customStats.count("dynamicFiltersProduced"), 0);
+        continue;
+      }
+      ASSERT_GT(topNStats.customStats.at("dynamicFiltersProduced").sum, 0);
+      ASSERT_GT(
+          planStats.at(scanNodeId).customStats.at("dynamicFiltersAccepted").sum,
+          0);
+      if (std::string(order) == "DESC NULLS LAST") {
+        // Only the first file has rows above the threshold.
+        ASSERT_LT(topNStats.inputRows, 2 * kRowsPerFile);
+      }
+    }
+  }
+}
+
+TEST_F(TableScanTest, stripeParts) {
+  // A single stripe of 4 row groups with the default stride of 10'000 rows.
+  constexpr int32_t kNumRows = 31'234;
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; })})};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto makeSplits = [&](uint32_t numParts) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (uint32_t part = 0; part < numParts; ++part) {
+      splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                           .stripePart(part, numParts)
+                           .build());
+    }
+    return splits;
+  };
+
+  auto rowType = asRowType(vectors[0]->type());
+  for (uint32_t numParts : {1, 2, 3, 5}) {
+    SCOPED_TRACE(fmt::format("numParts {}", numParts));
+    AssertQueryBuilder(tableScanNode(rowType), duckDbQueryRunner_)
+        .splits(makeSplits(numParts))
+        .assertResults("SELECT * FROM tmp");
+  }
+
+  // With 3 parts of 2 row groups each, the second part has the last 2 row
+  // groups and the third part is empty.
+  auto splits = makeSplits(3);
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .singleAggregation({}, {"min(c0)", "count(1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .split(splits[1])
+      .assertResults("SELECT 20000, 11234");
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .split(splits[2])
+      .assertResults("SELECT null, 0");
+
+  // Filters are evaluated against the row groups of the part only.
+  AssertQueryBuilder(
+      PlanBuilder().tableScan(rowType, {"c0 % 1000 = 7"}).planNode(),
+      duckDbQueryRunner_)
+      .splits(makeSplits(3))
+      .assertResults("SELECT * FROM tmp WHERE c0 % 1000 = 7");
+}
+
+TEST_F(TableScanTest, splitResultCache) {
+  constexpr int32_t kNumFiles = 3;
+  std::vector<RowVectorPtr> vectors;
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  for (auto i = 0; i < kNumFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return (row + i) % 7; }),
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row * (i + 1); }),
+    }));
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  SplitResultCache cache(SplitResultCache::Options{});
+  SplitResultCache::setInstance(&cache);
+  auto guard =
+      folly::makeGuard([]() { SplitResultCache::setInstance(nullptr); });
+
+  auto makeSplits = [&](std::optional<int64_t> modificationTime) {
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      const auto fileSize =
+          static_cast<int64_t>(fs::file_size(filePath->getPath()));
+      splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                           .fileProperties({fileSize, modificationTime})
+                           .build());
+    }
+    return splits;
+  };
+
+  core::PlanNodeId scanNodeId;
+  const auto plan = PlanBuilder()
+                        .tableScan(asRowType(vectors[0]->type()))
+                        .capturePlanNodeId(scanNodeId)
+                        .filter("c1 % 3 <> 0")
+                        .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                        .finalAggregation()
+                        .planNode();
+  auto runQuery = [&](std::optional<int64_t> modificationTime,
+                      bool enabled = true) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kSplitResultCacheEnabled,
+                enabled ? "true" : "false")
+            .splits(makeSplits(modificationTime))
+            .assertResults(
+                "SELECT c0, sum(c1), count(*) FROM tmp WHERE c1 % 3 <> 0 GROUP BY c0");
+    return toPlanStats(task->taskStats()).at(scanNodeId);
+  };
+  auto countStat = [](const PlanNodeStats& stats, const std::string& name) {
+    auto it = stats.customStats.find(name);
+    return it == stats.customStats.end() ? 0 : it->second.sum;
+  };
+
+  auto stats = runQuery(1);
+  ASSERT_EQ(countStat(stats, "splitResultCacheMisses"), kNumFiles);
+  ASSERT_EQ(countStat(stats, "splitResultCacheHits"), 0);
+  ASSERT_EQ(cache.stats().numInserts, kNumFiles);
+
+  // The cached groups are replayed without reading the files.
+  stats = runQuery(1);
+  ASSERT_EQ(countStat(stats, "splitResultCacheHits"), kNumFiles);
+  ASSERT_EQ(stats.rawInputRows, 0);
+
+  // The files are read again after a modification.
+  stats = runQuery(2);
+  ASSERT_EQ(countStat(stats, "splitResultCacheMisses"), kNumFiles);
+  ASSERT_EQ(countStat(stats, "splitResultCacheHits"), 0);
+  ASSERT_EQ(cache.stats().numInserts, 2 * kNumFiles);
+
+  // Splits without a modification time and queries that don't enable the
+  // cache don't look it up.
+  stats = runQuery(std::nullopt);
+  ASSERT_EQ(countStat(stats, "splitResultCacheMisses"), 0);
+  ASSERT_GT(stats.rawInputRows, 0);
+  stats = runQuery(1, false);
+  ASSERT_EQ(countStat(stats, "splitResultCacheHits"), 0);
+  ASSERT_GT(stats.rawInputRows, 0);
+}
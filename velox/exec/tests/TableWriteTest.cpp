@@ -2419,6 +2419,34 @@ TEST_P(UnpartitionedTableWriterTest, immutableSettings) {
   }
 }
 
+TEST_P(UnpartitionedTableWriterTest, scaleWriters) {
+  if (numTableWriterCount_ == 1) {
+    return;
+  }
+  auto input = makeVectors(10, 100);
+  auto outputDirectory = TempDirectoryPath::create();
+  auto plan = createInsertPlan(
+      PlanBuilder().values(input),
+      rowType_,
+      outputDirectory->getPath(),
+      {},
+      nullptr,
+      CompressionKind_NONE,
+      numTableWriterCount_,
+      connector::hive::LocationHandle::TableType::kNew);
+  auto result = AssertQueryBuilder(plan)
+                    .config(
+                        QueryConfig::kTaskWriterCount,
+                        std::to_string(numTableWriterCount_))
+                    .config(QueryConfig::kScaleWriters, "true")
+                    .copyResults(pool());
+  assertEqualResults(
+      {makeRowVector({makeConstant<int64_t>(1'000, 1)})}, {result});
+  // The input is much smaller than 'scale_writers_min_processed_bytes', so
+  // all of it goes to the first table writer.
+  ASSERT_EQ(countRecursiveFiles(outputDirectory->getPath()), 1);
+}
+
 TEST_P(BucketedTableOnlyWriteTest, bucketCountLimit) {
   SCOPED_TRACE(testParam_.toString());
   auto input = makeVectors(1, 100);
@@ -16,10 +16,13 @@
 
 #include "velox/exec/Task.h"
 #include "folly/experimental/EventCount.h"
+#include "folly/json.h"
+#include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/exec/OutputBufferManager.h"
@@ -31,6 +34,7 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/QueryAssertions.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/VectorSaver.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 using namespace facebook::velox;
@@ -808,6 +812,142 @@ TEST_F(TaskTest, singleThreadedExecution) {
   VELOX_ASSERT_THROW(executeSingleThreaded(plan), "division by zero");
 }
 
+TEST_F(TaskTest, profile) {
+  gflags::FlagSaver saver;
+  FLAGS_profiler_sampling_interval_us = 1'000;
+  ASSERT_TRUE(process::SamplingProfiler::start());
+  auto stopGuard =
+      folly::makeGuard([]() { process::SamplingProfiler::stop(); });
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  auto plan = PlanBuilder()
+                  .values(std::vector<RowVectorPtr>(500, data))
+                  .project({"c0 * 7 % 11 + c0 / 3 as x"})
+                  .filter("x % 2 = 0")
+                  .singleAggregation({}, {"sum(x)"})
+                  .planFragment();
+  auto [task, results] = executeSingleThreaded(plan);
+  process::SamplingProfiler::stop();
+
+  // Each stack starts with the operator and its plan node id.
+  auto profile = task->profile();
+  ASSERT_NE(std::string::npos, profile.find("FilterProject "));
+  std::vector<std::string> stacks;
+  folly::split('\n', profile, stacks, true);
+  for (const auto& stack : stacks) {
+    auto root = stack.substr(0, stack.find(';'));
+    EXPECT_TRUE(
+        root == "Values 0" || root == "FilterProject 1" ||
+        root == "FilterProject 2" || root == "Aggregation 3" ||
+        root == "Driver")
+        << stack;
+  }
+}
+
+TEST_F(TaskTest, driverTimeline) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+  auto plan = PlanBuilder()
+                  .values(std::vector<RowVectorPtr>(10, data))
+                  .project({"c0 % 5 as k", "c0"})
+                  .singleAggregation({"k"}, {"sum(c0)"})
+                  .planNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kDriverTimelineEnabled, "true")
+      .copyResults(pool(), task);
+  ASSERT_NE(0, task->timelineId());
+
+  auto trace = folly::parseJson(task->toChromeTrace());
+  std::unordered_map<std::string, int32_t> numEvents;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "X") {
+      EXPECT_EQ(0, event["pid"].asInt());
+      EXPECT_LE(0, event["dur"].asInt());
+      ++numEvents[event["name"].asString()];
+    } else {
+      ++numEvents[event["args"]["name"].asString()];
+    }
+  }
+  EXPECT_LT(0, numEvents["Run"]);
+  EXPECT_LE(10, numEvents["Values 0::getOutput"]);
+  EXPECT_EQ(10, numEvents["FilterProject 1::addInput"]);
+  EXPECT_EQ(10, numEvents["Aggregation 2::addInput"]);
+  EXPECT_EQ(1, numEvents["Pipeline 0"]);
+  EXPECT_EQ(1, numEvents["Driver 0"]);
+  // The frequent calls that only check the state are not recorded.
+  EXPECT_EQ(0, numEvents.count("Values 0::isBlocked"));
+
+  // No events when the timeline is not enabled.
+  AssertQueryBuilder(plan).copyResults(pool(), task);
+  EXPECT_EQ(0, task->timelineId());
+  EXPECT_TRUE(folly::parseJson(task->toChromeTrace())["traceEvents"].empty());
+}
+
+TEST_F(TaskTest, traceInput) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+  core::PlanNodeId projectId;
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder()
+                  .values(std::vector<RowVectorPtr>(10, data))
+                  .project({"c0 % 5 as k", "c0"})
+                  .capturePlanNodeId(projectId)
+                  .singleAggregation({"k"}, {"sum(c0)"})
+                  .capturePlanNodeId(aggregationId)
+                  .planNode();
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row % 5; }),
+      data->childAt(0),
+  });
+  std::ostringstream out;
+  saveVector(*expected, out);
+  const auto batchBytes = out.str().size();
+
+  // Returns the number of saved batches. Checks that they are the input of
+  // the aggregation.
+  auto runTraced = [&](uint64_t maxBytes) {
+    auto traceDirectory = exec::test::TempDirectoryPath::create();
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kQueryTraceEnabled, "true")
+        .config(core::QueryConfig::kQueryTraceDir, traceDirectory->getPath())
+        .config(core::QueryConfig::kQueryTraceNodeIds, aggregationId)
+        .config(core::QueryConfig::kQueryTraceMaxBytes, maxBytes)
+        .copyResults(pool(), task);
+    EXPECT_EQ(task->queryTracer()->tracedBytes() % batchBytes, 0);
+
+    const auto nodeDirectory = fmt::format(
+        "{}/{}/{}/{}",
+        traceDirectory->getPath(),
+        task->queryCtx()->queryId(),
+        task->taskId(),
+        aggregationId);
+    EXPECT_TRUE(fs::exists(
+        fmt::format("{}/{}", nodeDirectory, QueryTracer::kPlanFileName)));
+    EXPECT_TRUE(fs::exists(fmt::format(
+        "{}/{}", nodeDirectory, QueryTracer::kQueryConfigFileName)));
+    int32_t numBatches = 0;
+    for (;; ++numBatches) {
+      const auto path =
+          fmt::format("{}/{}/{}", nodeDirectory, projectId, numBatches);
+      if (!fs::exists(path)) {
+        break;
+      }
+      assertEqualVectors(expected, restoreVectorFromFile(path.c_str(), pool()));
+    }
+    return numBatches;
+  };
+
+  EXPECT_EQ(10, runTraced(1UL << 30));
+  EXPECT_EQ(3, runTraced(3 * batchBytes + 1));
+  EXPECT_EQ(0, runTraced(0));
+}
+
 TEST_F(TaskTest, singleThreadedHashJoin) {
   auto left = makeRowVector(
       {"t_c0", "t_c1"},
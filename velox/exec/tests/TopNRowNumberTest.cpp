@@ -291,6 +291,50 @@ TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   }
 }
 
+TEST_F(TopNRowNumberTest, partialFlush) {
+  auto data = makeRowVector(
+      {"p", "s"},
+      {
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+          makeFlatVector<int64_t>(1'000, [](auto row) { return 1'000 - row; }),
+      });
+
+  createDuckDbTable({data});
+
+  core::PlanNodeId topNRowNumberId;
+  auto runPlan = [&](const std::string& maxMemory) {
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .topNRowNumber({"p"}, {"s"}, 5, false)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .topNRowNumber({"p"}, {"s"}, 5, true)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kMaxPartialTopNRowNumberMemory, maxMemory)
+            .assertResults(
+                "SELECT * FROM (SELECT *, row_number() over (partition by p order by s) as rn FROM tmp) "
+                "WHERE rn <= 5");
+
+    return exec::toPlanStats(task->taskStats()).at(topNRowNumberId);
+  };
+
+  // The partial operator flushes its 10 partitions after each input batch.
+  {
+    const auto stats = runPlan("1");
+    ASSERT_EQ(stats.customStats.at("numPartialFlushes").sum, 10);
+    ASSERT_EQ(stats.outputRows, 10 * 10 * 5);
+  }
+
+  // No flushes.
+  {
+    const auto stats = runPlan("0");
+    ASSERT_EQ(stats.customStats.count("numPartialFlushes"), 0);
+    ASSERT_EQ(stats.outputRows, 10 * 5);
+  }
+}
+
 TEST_F(TopNRowNumberTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b", "c", "d", "e"},
@@ -14,8 +14,12 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -284,6 +288,52 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, spill) {
+  filesystems::registerLocalFileSystem();
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (row * 7 + i) % 1'000; },
+        nullEvery(13));
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](vector_size_t row) { return i * batchSize + row; });
+    auto c2 = makeFlatVector<std::string>(batchSize, [](vector_size_t row) {
+      return fmt::format("string value {}", row);
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  auto spillDirectory = TempDirectoryPath::create();
+  // The sorting keys are not the leading columns of the input.
+  for (const auto limit : {1, 100, 2'500}) {
+    SCOPED_TRACE(fmt::format("limit: {}", limit));
+    core::PlanNodeId topNId;
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .topN({"c2 DESC", "c1"}, limit, false)
+                    .capturePlanNodeId(topNId)
+                    .planNode();
+
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kTopNSpillEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(fmt::format(
+                "SELECT * FROM tmp ORDER BY c2 DESC, c1 LIMIT {}", limit));
+
+    const auto stats = exec::toPlanStats(task->taskStats()).at(topNId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_EQ(stats.outputRows, limit);
+  }
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
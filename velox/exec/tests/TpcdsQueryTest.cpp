@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+constexpr double kScaleFactor = 0.01;
+
+// Runs the plans of TpcdsQueryBuilder over generated data and compares the
+// results with DuckDB running the same queries in SQL.
+class TpcdsQueryTest : public OperatorTestBase {
+ protected:
+  const std::string kTpcdsConnectorId = "test-tpcds";
+  static constexpr int32_t kNumSplits = 3;
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    auto tpcdsConnector =
+        connector::getConnectorFactory(
+            connector::tpcds::TpcdsConnectorFactory::kTpcdsConnectorName)
+            ->newConnector(
+                kTpcdsConnectorId, std::make_shared<core::MemConfig>());
+    connector::registerConnector(tpcdsConnector);
+
+    for (auto table : tpcds::tables) {
+      auto numRows = tpcds::getRowCount(table, kScaleFactor);
+      createDuckDbTable(
+          std::string(tpcds::toTableName(table)),
+          {tpcds::genTpcdsData(table, pool(), numRows, 0, kScaleFactor)});
+    }
+  }
+
+  void TearDown() override {
+    connector::unregisterConnector(kTpcdsConnectorId);
+    OperatorTestBase::TearDown();
+  }
+
+  void assertQuery(int queryId, const std::string& duckDbSql) {
+    TpcdsQueryBuilder builder(kScaleFactor);
+    auto tpcdsPlan = builder.getQueryPlan(queryId);
+    AssertQueryBuilder queryBuilder(tpcdsPlan.plan, duckDbQueryRunner_);
+    queryBuilder.maxDrivers(4);
+    for (const auto& nodeId : tpcdsPlan.scanNodeIds) {
+      std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+      for (auto i = 0; i < kNumSplits; ++i) {
+        splits.push_back(
+            std::make_shared<connector::tpcds::TpcdsConnectorSplit>(
+                kTpcdsConnectorId, kNumSplits, i));
+      }
+      queryBuilder.splits(nodeId, splits);
+    }
+    queryBuilder.assertResults(duckDbSql);
+  }
+};
+
+TEST_F(TpcdsQueryTest, q3) {
+  assertQuery(
+      3,
+      "SELECT d_year, i_brand_id AS brand_id, i_brand AS brand, "
+      "  sum(ss_ext_sales_price) AS sum_agg "
+      "FROM date_dim, store_sales, item "
+      "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+      "  AND i_manufact_id = 128 AND d_moy = 11 "
+      "GROUP BY d_year, i_brand, i_brand_id "
+      "ORDER BY d_year, sum_agg DESC, brand_id LIMIT 100");
+}
+
+TEST_F(TpcdsQueryTest, q27) {
+  assertQuery(
+      27,
+      "SELECT i_item_id, s_state, grouping(s_state) AS g_state, "
+      "  avg(ss_quantity) AS agg1, avg(ss_list_price) AS agg2, "
+      "  avg(ss_coupon_amt) AS agg3, avg(ss_sales_price) AS agg4 "
+      "FROM store_sales, customer_demographics, date_dim, store, item "
+      "WHERE ss_sold_date_sk = d_date_sk AND ss_item_sk = i_item_sk "
+      "  AND ss_store_sk = s_store_sk AND ss_cdemo_sk = cd_demo_sk "
+      "  AND cd_gender = 'M' AND cd_marital_status = 'S' "
+      "  AND cd_education_status = 'College' AND d_year = 2002 "
+      "  AND s_state = 'TN' "
+      "GROUP BY ROLLUP (i_item_id, s_state) "
+      "ORDER BY i_item_id NULLS LAST, s_state NULLS LAST LIMIT 100");
+}
+
+TEST_F(TpcdsQueryTest, q42) {
+  assertQuery(
+      42,
+      "SELECT d_year, i_category_id, i_category, "
+      "  sum(ss_ext_sales_price) AS total "
+      "FROM date_dim, store_sales, item "
+      "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+      "  AND i_manager_id = 1 AND d_moy = 11 AND d_year = 2000 "
+      "GROUP BY d_year, i_category_id, i_category "
+      "ORDER BY total DESC, d_year, i_category_id, i_category LIMIT 100");
+}
+
+TEST_F(TpcdsQueryTest, q55) {
+  assertQuery(
+      55,
+      "SELECT i_brand_id AS brand_id, i_brand AS brand, "
+      "  sum(ss_ext_sales_price) AS ext_price "
+      "FROM date_dim, store_sales, item "
+      "WHERE d_date_sk = ss_sold_date_sk AND ss_item_sk = i_item_sk "
+      "  AND i_manager_id = 28 AND d_moy = 11 AND d_year = 1999 "
+      "GROUP BY i_brand, i_brand_id "
+      "ORDER BY ext_price DESC, brand_id LIMIT 100");
+}
+
+TEST_F(TpcdsQueryTest, q98) {
+  assertQuery(
+      98,
+      "SELECT i_item_id, i_item_desc, i_category, i_class, i_current_price, "
+      "  sum(ss_ext_sales_price) AS itemrevenue, "
+      "  sum(ss_ext_sales_price) * 100 / "
+      "    sum(sum(ss_ext_sales_price)) OVER (PARTITION BY i_class) "
+      "    AS revenueratio "
+      "FROM store_sales, item, date_dim "
+      "WHERE ss_item_sk = i_item_sk "
+      "  AND i_category IN ('Sports', 'Books', 'Home') "
+      "  AND ss_sold_date_sk = d_date_sk "
+      "  AND d_date BETWEEN DATE '1999-02-22' AND DATE '1999-03-24' "
+      "GROUP BY i_item_id, i_item_desc, i_category, i_class, i_current_price");
+}
+
+TEST_F(TpcdsQueryTest, unsupported) {
+  VELOX_ASSERT_THROW(
+      TpcdsQueryBuilder(kScaleFactor).getQueryPlan(1),
+      "TPC-DS query 1 is not supported yet");
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
@@ -424,26 +424,28 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output splits every 6th input row across 2 outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
+                    .config(core::QueryConfig::kMaxOutputBatchRows, "17")
                     .assertResults({expected});
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits every other input row across 2 outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
+                    .config(core::QueryConfig::kMaxOutputBatchRows, "2")
                     .assertResults({expected});
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(15'000, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +460,119 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, adaptiveBatchSize) {
+  // Unnest 100 rows with 100 elements each. c0 is replicated into every
+  // output row.
+  auto makeData = [&](const VectorPtr& replicated) {
+    return makeRowVector({
+        replicated,
+        makeArrayVector<int64_t>(
+            100,
+            [](auto /*row*/) { return 100; },
+            [](auto row, auto index) { return row * 100 + index; }),
+    });
+  };
+
+  auto runUnnest = [&](const RowVectorPtr& data,
+                       const std::string& preferredRows,
+                       const std::string& preferredBytes) {
+    core::PlanNodeId unnestId;
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .unnest({"c0"}, {"c1"})
+                    .capturePlanNodeId(unnestId)
+                    .planNode();
+    auto expected =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "100000")
+            .copyResults(pool());
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, preferredRows)
+            .config(
+                core::QueryConfig::kPreferredOutputBatchBytes, preferredBytes)
+            .assertResults({expected});
+    return exec::toPlanStats(task->taskStats()).at(unnestId);
+  };
+
+  // Rows with a 1KB string. The first batch has 1000 rows. The next batches
+  // are limited to 100KB, i.e. about 100 rows.
+  {
+    auto stats = runUnnest(
+        makeData(makeFlatVector<std::string>(
+            100, [](auto row) { return std::string(1'000, 'a' + row % 26); })),
+        "1000",
+        "100000");
+    ASSERT_EQ(10'000, stats.outputRows);
+    ASSERT_GT(stats.outputVectors, 50);
+    const auto& estimatedBytes =
+        stats.customStats.at(Operator::kEstimatedOutputBatchBytes);
+    ASSERT_LE(estimatedBytes.max, 100'000);
+  }
+
+  // Rows of 2 bigints. The first batch has 100 rows. The rest fits in one
+  // batch of up to max_output_batch_rows.
+  {
+    auto stats = runUnnest(
+        makeData(makeFlatVector<int64_t>(100, [](auto row) { return row; })),
+        "100",
+        "10000000");
+    ASSERT_EQ(10'000, stats.outputRows);
+    ASSERT_EQ(2, stats.outputVectors);
+  }
+}
+
+TEST_F(UnnestTest, splitLargeRows) {
+  // Rows with 10K and 7K elements are split across output batches. c2 is
+  // shorter or longer than c1 and null in the last row, so the batches mix
+  // slices of the elements and nulls.
+  const std::vector<vector_size_t> sizes = {10'000, 5, 2'500, 0};
+  const std::vector<vector_size_t> otherSizes = {3, 7'000, 0, 0};
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(4, [](auto row) { return row; }),
+      makeArrayVector<int64_t>(
+          4,
+          [&](auto row) { return sizes[row]; },
+          [](auto row, auto index) { return row * 100'000 + index; }),
+      makeArrayVector<int32_t>(
+          4,
+          [&](auto row) { return otherSizes[row]; },
+          [](auto /*row*/, auto index) { return index; },
+          [](auto row) { return row == 3; }),
+      vectorMaker_.mapVector<int32_t, double>(
+          4,
+          [&](auto row) { return sizes[row] / 2; },
+          [](auto /*row*/, auto index) { return index; },
+          [](auto row, auto index) { return row + index * 0.5; }),
+  });
+
+  for (const auto& withOrdinality : {false, true}) {
+    SCOPED_TRACE(fmt::format("withOrdinality: {}", withOrdinality));
+    core::PlanNodeId unnestId;
+    auto plan = PlanBuilder()
+                    .values({vector})
+                    .unnest(
+                        {"c0"},
+                        {"c1", "c2", "c3"},
+                        withOrdinality ? std::optional<std::string>("ordinal")
+                                       : std::nullopt)
+                    .capturePlanNodeId(unnestId)
+                    .planNode();
+
+    auto expected =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "100000")
+            .copyResults(pool());
+    ASSERT_EQ(10'000 + 7'000 + 2'500, expected->size());
+
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+            .config(core::QueryConfig::kMaxOutputBatchRows, "1000")
+            .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+    ASSERT_EQ(expected->size(), stats.at(unnestId).outputRows);
+    ASSERT_EQ(20, stats.at(unnestId).outputVectors);
+  }
+}
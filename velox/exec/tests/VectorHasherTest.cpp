@@ -224,6 +224,41 @@ TEST_F(VectorHasherTest, flat) {
   }
 }
 
+TEST_F(VectorHasherTest, flatNoNulls) {
+  // Hashes of flat columns without nulls must match the hashes of the same
+  // values behind a dictionary, with and without mixing.
+  const vector_size_t size = 1'000;
+  const std::vector<VectorPtr> keys = {
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 7; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 11; }),
+      makeFlatVector<double>(
+          size,
+          [](auto row) {
+            return row % 13 == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                 : row * 0.5;
+          }),
+      makeFlatVector<Timestamp>(
+          size, [](auto row) { return Timestamp(row, row * 1'000); }),
+  };
+  const SelectivityVector rows(size);
+
+  raw_vector<uint64_t> flatHashes(size);
+  raw_vector<uint64_t> dictionaryHashes(size);
+  for (auto i = 0; i < keys.size(); ++i) {
+    SCOPED_TRACE(keys[i]->type()->toString());
+    auto hasher = exec::VectorHasher::create(keys[i]->type(), i);
+    hasher->decode(*keys[i], rows);
+    hasher->hash(rows, i > 0, flatHashes);
+
+    auto dictionary = makeDictionary(size, keys[i]);
+    hasher->decode(*dictionary, rows);
+    hasher->hash(rows, i > 0, dictionaryHashes);
+    for (auto row = 0; row < size; ++row) {
+      ASSERT_EQ(dictionaryHashes[row], flatHashes[row]) << "at " << row;
+    }
+  }
+}
+
 TEST_F(VectorHasherTest, nans) {
   // Sanity check to ensure the NaNs are correctly hashed, that is, all NaNs are
   // considered equal and therefore should have the same hash.
@@ -364,6 +399,41 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, dictionaryAcrossBatches) {
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  auto makeBase = [&](const std::string& prefix) {
+    return makeFlatVector<std::string>(
+        1'000,
+        [&](auto row) { return fmt::format("{}{}", prefix, row); },
+        [](auto row) { return row == 7; });
+  };
+  // Batches smaller than the dictionary, which are not worth caching hashes
+  // for unless the dictionary is repeated.
+  auto hashBatch = [&](const VectorPtr& base, int32_t firstIndex) {
+    auto indices = makeIndices(10, [&](auto row) {
+      return (firstIndex + row * 3) % base->size();
+    });
+    auto dictionary =
+        BaseVector::wrapInDictionary(BufferPtr(nullptr), indices, 10, base);
+    SelectivityVector rows(10);
+    raw_vector<uint64_t> hashes(10);
+    hasher->decode(*dictionary, rows);
+    hasher->hash(rows, false, hashes);
+    for (auto i = 0; i < 10; ++i) {
+      EXPECT_EQ(hashes[i], dictionary->hashValueAt(i)) << "at " << i;
+    }
+  };
+
+  auto base = makeBase("a");
+  hashBatch(base, 1);
+  hashBatch(base, 1);
+  hashBatch(base, 4);
+  auto otherBase = makeBase("b");
+  hashBatch(otherBase, 1);
+  hashBatch(otherBase, 1);
+  hashBatch(base, 1);
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
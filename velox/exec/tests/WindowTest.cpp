@@ -79,6 +79,105 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, prefixSort) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<std::string>(
+              size, [](auto row) { return fmt::format("p{}", row % 17); }),
+          // Sorting key.
+          makeFlatVector<int32_t>(
+              size,
+              [](auto row) { return (row * 7) % 1'000; },
+              nullEvery(13)),
+      });
+
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window({"rank() over (partition by p order by s desc)"})
+                  .planNode();
+
+  // Quick sort, radix sort and std::sort give the same results.
+  for (const auto& [normalizedKeyMaxBytes, radixSortMinRows] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"128", "0"}, {"128", "1000"}, {"0", "1000"}}) {
+    SCOPED_TRACE(fmt::format(
+        "normalizedKeyMaxBytes: {}, radixSortMinRows: {}",
+        normalizedKeyMaxBytes,
+        radixSortMinRows));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kPrefixSortNormalizedKeyMaxBytes,
+            normalizedKeyMaxBytes)
+        .config(
+            core::QueryConfig::kPrefixSortRadixSortMinRows, radixSortMinRows)
+        .assertResults(
+            "SELECT *, rank() over (partition by p order by s desc) FROM tmp");
+  }
+}
+
+TEST_F(WindowTest, spillStreamPartitions) {
+  const vector_size_t size = 3'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key. Few large partitions.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 3; }),
+          // Sorting key with peers.
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 7; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s, d)",
+      "rank() over (partition by p order by s)",
+      "lag(d, 3) over (partition by p order by s, d)",
+      "lead(d, 5) over (partition by p order by s, d)",
+      "sum(d) over (partition by p order by s, d "
+      "rows between 10 preceding and 5 following)",
+      // The frames of the first rows of each partition are empty.
+      "sum(d) over (partition by p order by s, d "
+      "rows between 20 preceding and 15 preceding)",
+      "min(d) over (partition by p order by s, d "
+      "rows between unbounded preceding and current row)",
+  };
+
+  for (const auto& function : functions) {
+    SCOPED_TRACE(function);
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .window({function})
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillStreamPartitions, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(fmt::format("SELECT *, {} FROM tmp", function));
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    ASSERT_GT(taskStats.at(windowId).spilledRows, 0);
+    ASSERT_GT(
+        taskStats.at(windowId).customStats.at("numStreamedPartitions").sum, 0);
+  }
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -273,16 +273,29 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& fileProperties(FileProperties fileProperties) {
+    fileProperties_ = fileProperties;
+    return *this;
+  }
+
   HiveConnectorSplitBuilder& connectorId(const std::string& connectorId) {
     connectorId_ = connectorId;
     return *this;
   }
 
+  HiveConnectorSplitBuilder& stripePart(
+      uint32_t stripePart,
+      uint32_t numStripeParts) {
+    stripePart_ = stripePart;
+    numStripeParts_ = numStripeParts;
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
     static const std::unordered_map<std::string, std::string> customSplitInfo;
     static const std::shared_ptr<std::string> extraFileInfo;
     static const std::unordered_map<std::string, std::string> serdeParameters;
-    return std::make_shared<connector::hive::HiveConnectorSplit>(
+    auto split = std::make_shared<connector::hive::HiveConnectorSplit>(
         connectorId_,
         filePath_.find("/") == 0 ? "file:" + filePath_ : filePath_,
         fileFormat_,
@@ -295,7 +308,10 @@ class HiveConnectorSplitBuilder {
         serdeParameters,
         splitWeight_,
         infoColumns_,
-        std::nullopt);
+        fileProperties_);
+    split->stripePart = stripePart_;
+    split->numStripeParts = numStripeParts_;
+    return split;
   }
 
  private:
@@ -309,8 +325,11 @@ class HiveConnectorSplitBuilder {
   std::shared_ptr<std::string> extraFileInfo_ = {};
   std::unordered_map<std::string, std::string> serdeParameters_ = {};
   std::unordered_map<std::string, std::string> infoColumns_ = {};
+  std::optional<FileProperties> fileProperties_;
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
+  uint32_t stripePart_{0};
+  uint32_t numStripeParts_{1};
 };
 
 } // namespace facebook::velox::exec::test
@@ -17,10 +17,12 @@
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/tpcds/TpcdsConnector.h"
 #include "velox/connectors/tpch/TpchConnector.h"
 #include "velox/duckdb/conversion/DuckParser.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/RangePartitionFunction.h"
 #include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/TableWriter.h"
 #include "velox/exec/WindowFunction.h"
@@ -43,6 +45,7 @@ namespace {
 // TODO Avoid duplication.
 static const std::string kHiveConnectorId = "test-hive";
 static const std::string kTpchConnectorId = "test-tpch";
+static const std::string kTpcdsConnectorId = "test-tpcds";
 
 core::TypedExprPtr parseExpr(
     const std::string& text,
@@ -143,6 +146,32 @@ PlanBuilder& PlanBuilder::tpchTableScan(
       .endTableScan();
 }
 
+PlanBuilder& PlanBuilder::tpcdsTableScan(
+    tpcds::Table table,
+    std::vector<std::string>&& columnNames,
+    double scaleFactor) {
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignmentsMap;
+  std::vector<TypePtr> outputTypes;
+
+  assignmentsMap.reserve(columnNames.size());
+  outputTypes.reserve(columnNames.size());
+
+  for (const auto& columnName : columnNames) {
+    assignmentsMap.emplace(
+        columnName,
+        std::make_shared<connector::tpcds::TpcdsColumnHandle>(columnName));
+    outputTypes.emplace_back(resolveTpcdsColumn(table, columnName));
+  }
+  auto rowType = ROW(std::move(columnNames), std::move(outputTypes));
+  return TableScanBuilder(*this)
+      .outputType(rowType)
+      .tableHandle(std::make_shared<connector::tpcds::TpcdsTableHandle>(
+          kTpcdsConnectorId, table, scaleFactor))
+      .assignments(assignmentsMap)
+      .endTableScan();
+}
+
 core::PlanNodePtr PlanBuilder::TableScanBuilder::build(core::PlanNodeId id) {
   VELOX_CHECK_NOT_NULL(outputType_, "outputType must be specified");
   std::unordered_map<std::string, core::TypedExprPtr> typedMapping;
@@ -919,13 +948,18 @@ core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
     const std::vector<std::string>& keys,
     std::vector<core::PlanNodePtr> sources,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    bool rangePartitioned = false) {
   const auto& inputType = sources[0]->outputType();
   auto [sortingKeys, sortingOrders] =
       parseOrderByClauses(keys, inputType, pool);
 
   return std::make_shared<core::LocalMergeNode>(
-      id, std::move(sortingKeys), std::move(sortingOrders), std::move(sources));
+      id,
+      std::move(sortingKeys),
+      std::move(sortingOrders),
+      std::move(sources),
+      rangePartitioned);
 }
 } // namespace
 
@@ -934,6 +968,13 @@ PlanBuilder& PlanBuilder::localMerge(const std::vector<std::string>& keys) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::localMergeRangePartitioned(
+    const std::vector<std::string>& keys) {
+  planNode_ = createLocalMergeNode(
+      nextPlanNodeId(), keys, {planNode_}, pool_, true);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::expand(
     const std::vector<std::vector<std::string>>& projections) {
   VELOX_CHECK(!projections.empty(), "projections must not be empty.");
@@ -1221,6 +1262,32 @@ PlanBuilder& PlanBuilder::localPartition(const std::vector<std::string>& keys) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::localPartitionByRange(
+    const std::vector<std::string>& keys,
+    const RowVectorPtr& splitters) {
+  VELOX_CHECK_NOT_NULL(planNode_, "LocalPartition cannot be the source node");
+  const auto& inputType = planNode_->outputType();
+  auto [sortingKeys, sortingOrders] =
+      parseOrderByClauses(keys, inputType, pool_);
+  std::vector<column_index_t> keyChannels;
+  keyChannels.reserve(sortingKeys.size());
+  for (const auto& key : sortingKeys) {
+    keyChannels.push_back(inputType->getChildIdx(key->name()));
+  }
+  auto rangePartitionFunctionSpec =
+      std::make_shared<RangePartitionFunctionSpec>(
+          inputType,
+          std::move(keyChannels),
+          std::move(sortingOrders),
+          splitters);
+  planNode_ = std::make_shared<core::LocalPartitionNode>(
+      nextPlanNodeId(),
+      core::LocalPartitionNode::Type::kRepartition,
+      std::move(rangePartitionFunctionSpec),
+      std::vector<core::PlanNodePtr>{planNode_});
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::localPartitionByBucket(
     const std::shared_ptr<connector::hive::HiveBucketProperty>&
         bucketProperty) {
@@ -1814,14 +1881,15 @@ PlanBuilder& PlanBuilder::topNRowNumber(
 
 PlanBuilder& PlanBuilder::markDistinct(
     std::string markerKey,
-    const std::vector<std::string>& distinctKeys) {
+    const std::vector<std::string>& distinctKeys,
+    bool preGrouped) {
   VELOX_CHECK_NOT_NULL(planNode_, "MarkDistinct cannot be the source node");
   planNode_ = std::make_shared<core::MarkDistinctNode>(
       nextPlanNodeId(),
       std::move(markerKey),
       fields(planNode_->outputType(), distinctKeys),
-
-      planNode_);
+      planNode_,
+      preGrouped);
   return *this;
 }
 
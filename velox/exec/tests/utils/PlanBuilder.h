@@ -31,6 +31,10 @@ namespace facebook::velox::tpch {
 enum class Table : uint8_t;
 }
 
+namespace facebook::velox::tpcds {
+enum class Table : uint8_t;
+}
+
 namespace facebook::velox::exec::test {
 
 /// A builder class with fluent API for building query plans. Plans are built
@@ -164,6 +168,16 @@ class PlanBuilder {
       std::vector<std::string>&& columnNames,
       double scaleFactor = 1);
 
+  /// Add a TableScanNode to scan a TPC-DS table.
+  ///
+  /// @param table The TPC-DS table to scan.
+  /// @param columnNames The columns to be returned from that table.
+  /// @param scaleFactor The TPC-DS scale factor.
+  PlanBuilder& tpcdsTableScan(
+      tpcds::Table table,
+      std::vector<std::string>&& columnNames,
+      double scaleFactor = 1);
+
   /// Helper class to build a custom TableScanNode.
   /// Uses a planBuilder instance to get the next plan id, memory pool, and
   /// parse options.
@@ -678,6 +692,11 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localMerge(const std::vector<std::string>& keys);
 
+  /// Adds a LocalMergeNode with a single source (the current plan node) whose
+  /// drivers sort consecutive key ranges, e.g. after localPartitionByRange().
+  /// The sorted ranges are returned one after the other without merging.
+  PlanBuilder& localMergeRangePartitioned(const std::vector<std::string>& keys);
+
   /// Adds an OrderByNode using specified ORDER BY clauses.
   ///
   /// For example,
@@ -788,6 +807,15 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localPartition(const std::vector<std::string>& keys);
 
+  /// Adds a LocalPartitionNode to partition the input by ranges of the
+  /// specified ORDER BY clauses using exec::RangePartitionFunction.
+  /// 'splitters' has one column per key and one row less than the number of
+  /// ranges, see RangePartitionFunction::computeSplitters(). The downstream
+  /// pipeline must run with more drivers than there are splitters.
+  PlanBuilder& localPartitionByRange(
+      const std::vector<std::string>& keys,
+      const RowVectorPtr& splitters);
+
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node) and hive bucket property.
   PlanBuilder& localPartitionByBucket(
@@ -949,9 +977,12 @@ class PlanBuilder {
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
+  /// @param preGrouped Whether rows with equal distinct keys are adjacent in
+  /// the input. Such input is marked by the streaming operator.
   PlanBuilder& markDistinct(
       std::string markerKey,
-      const std::vector<std::string>& distinctKeys);
+      const std::vector<std::string>& distinctKeys,
+      bool preGrouped = false);
 
   /// Stores the latest plan node ID into the specified variable. Useful for
   /// capturing IDs of the leaf plan nodes (table scans, exchanges, etc.) to use
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+#include "velox/tpcds/gen/TpcdsGen.h"
+
+namespace facebook::velox::exec::test {
+
+using tpcds::Table;
+
+TpcdsPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 27:
+      return getQ27Plan();
+    case 42:
+      return getQ42Plan();
+    case 55:
+      return getQ55Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+// static
+const std::vector<int>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int> kQueryIds = {3, 27, 42, 55, 98};
+  return kQueryIds;
+}
+
+PlanBuilder TpcdsQueryBuilder::makeItemSales(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    const std::string& itemFilter,
+    std::vector<std::string>&& itemColumns,
+    const std::string& dateFilter,
+    const std::vector<std::string>& outputColumns,
+    std::vector<core::PlanNodeId>& scanNodeIds) const {
+  core::PlanNodeId salesScanId;
+  core::PlanNodeId itemScanId;
+  core::PlanNodeId dateScanId;
+
+  auto items = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tpcdsTableScan(
+                       Table::TBL_ITEM, std::move(itemColumns), scaleFactor_)
+                   .capturePlanNodeId(itemScanId)
+                   .filter(itemFilter)
+                   .planNode();
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tpcdsTableScan(
+                       Table::TBL_DATE_DIM,
+                       {"d_date_sk", "d_date", "d_year", "d_moy"},
+                       scaleFactor_)
+                   .capturePlanNodeId(dateScanId)
+                   .filter(dateFilter)
+                   .planNode();
+
+  // The item filters are more selective, so the items are joined first.
+  auto itemOutput = items->outputType()->names();
+  itemOutput.insert(
+      itemOutput.end(), {"ss_sold_date_sk", "ss_ext_sales_price"});
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder
+      .tpcdsTableScan(
+          Table::TBL_STORE_SALES,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          scaleFactor_)
+      .capturePlanNodeId(salesScanId)
+      .hashJoin({"ss_item_sk"}, {"i_item_sk"}, items, "", itemOutput)
+      .hashJoin({"ss_sold_date_sk"}, {"d_date_sk"}, dates, "", outputColumns);
+
+  scanNodeIds.insert(
+      scanNodeIds.end(), {salesScanId, itemScanId, dateScanId});
+  return builder;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ3Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  context.plan =
+      makeItemSales(
+          planNodeIdGenerator,
+          "i_manufact_id = 128",
+          {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+          "d_moy = 11",
+          {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"},
+          context.scanNodeIds)
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"d_year", "sum_agg DESC", "i_brand_id"}, 100, false)
+          .project(
+              {"d_year",
+               "i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "sum_agg"})
+          .planNode();
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ27Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  core::PlanNodeId salesScanId;
+  core::PlanNodeId demographicsScanId;
+  core::PlanNodeId dateScanId;
+  core::PlanNodeId storeScanId;
+  core::PlanNodeId itemScanId;
+
+  auto demographics =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tpcdsTableScan(
+              Table::TBL_CUSTOMER_DEMOGRAPHICS,
+              {"cd_demo_sk",
+               "cd_gender",
+               "cd_marital_status",
+               "cd_education_status"},
+              scaleFactor_)
+          .capturePlanNodeId(demographicsScanId)
+          .filter(
+              "cd_gender = 'M' AND cd_marital_status = 'S' AND "
+              "cd_education_status = 'College'")
+          .planNode();
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tpcdsTableScan(
+                       Table::TBL_DATE_DIM,
+                       {"d_date_sk", "d_year"},
+                       scaleFactor_)
+                   .capturePlanNodeId(dateScanId)
+                   .filter("d_year = 2002")
+                   .planNode();
+
+  auto stores =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tpcdsTableScan(
+              Table::TBL_STORE, {"s_store_sk", "s_state"}, scaleFactor_)
+          .capturePlanNodeId(storeScanId)
+          .filter("s_state = 'TN'")
+          .planNode();
+
+  auto items =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tpcdsTableScan(
+              Table::TBL_ITEM, {"i_item_sk", "i_item_id"}, scaleFactor_)
+          .capturePlanNodeId(itemScanId)
+          .planNode();
+
+  const std::vector<std::string> aggregationInputs = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  auto withColumns = [&](std::vector<std::string> columns) {
+    columns.insert(
+        columns.end(), aggregationInputs.begin(), aggregationInputs.end());
+    return columns;
+  };
+
+  // ROLLUP (i_item_id, s_state) is a GroupId node with the grouping sets
+  // (i_item_id, s_state), (i_item_id) and (). grouping(s_state) is 0 only in
+  // the first.
+  context.plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tpcdsTableScan(
+              Table::TBL_STORE_SALES,
+              withColumns(
+                  {"ss_sold_date_sk",
+                   "ss_item_sk",
+                   "ss_cdemo_sk",
+                   "ss_store_sk"}),
+              scaleFactor_)
+          .capturePlanNodeId(salesScanId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              withColumns({"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              withColumns({"ss_item_sk", "ss_store_sk"}))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              withColumns({"ss_item_sk", "s_state"}))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              withColumns({"i_item_id", "s_state"}))
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              aggregationInputs)
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_item_id",
+               "s_state",
+               "if(group_id = 0, 0, 1) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .topN({"i_item_id", "s_state"}, 100, false)
+          .planNode();
+
+  context.scanNodeIds = {
+      salesScanId, demographicsScanId, dateScanId, storeScanId, itemScanId};
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ42Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  context.plan =
+      makeItemSales(
+          planNodeIdGenerator,
+          "i_manager_id = 1",
+          {"i_item_sk", "i_category_id", "i_category", "i_manager_id"},
+          "d_moy = 11 AND d_year = 2000",
+          {"d_year", "i_category_id", "i_category", "ss_ext_sales_price"},
+          context.scanNodeIds)
+          .partialAggregation(
+              {"d_year", "i_category_id", "i_category"},
+              {"sum(ss_ext_sales_price) AS total"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN(
+              {"total DESC", "d_year", "i_category_id", "i_category"},
+              100,
+              false)
+          .planNode();
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ55Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  context.plan =
+      makeItemSales(
+          planNodeIdGenerator,
+          "i_manager_id = 28",
+          {"i_item_sk", "i_brand_id", "i_brand", "i_manager_id"},
+          "d_moy = 11 AND d_year = 1999",
+          {"i_brand_id", "i_brand", "ss_ext_sales_price"},
+          context.scanNodeIds)
+          .partialAggregation(
+              {"i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS ext_price"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .topN({"ext_price DESC", "i_brand_id"}, 100, false)
+          .project(
+              {"i_brand_id AS brand_id", "i_brand AS brand", "ext_price"})
+          .planNode();
+  return context;
+}
+
+TpcdsPlan TpcdsQueryBuilder::getQ98Plan() const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpcdsPlan context;
+  const std::vector<std::string> itemKeys = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+  auto salesColumns = itemKeys;
+  salesColumns.push_back("ss_ext_sales_price");
+
+  // The share of each item in the revenue of its class is a window sum over
+  // the aggregated revenue of the items.
+  context.plan =
+      makeItemSales(
+          planNodeIdGenerator,
+          "i_category IN ('Sports', 'Books', 'Home')",
+          {"i_item_sk",
+           "i_item_id",
+           "i_item_desc",
+           "i_category",
+           "i_class",
+           "i_current_price"},
+          "d_date BETWEEN '1999-02-22'::DATE AND '1999-03-24'::DATE",
+          salesColumns,
+          context.scanNodeIds)
+          .partialAggregation(
+              itemKeys, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .window(
+              {"sum(itemrevenue) OVER (PARTITION BY i_class) AS class_revenue"})
+          .project(
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "itemrevenue",
+               "itemrevenue * 100 / class_revenue AS revenueratio"})
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+  return context;
+}
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Contains the query plan and the IDs of its table scan nodes. Each table
+/// scan reads from the TPC-DS connector with id "test-tpcds" and needs one or
+/// more TpcdsConnectorSplits.
+struct TpcdsPlan {
+  core::PlanNodePtr plan;
+  std::vector<core::PlanNodeId> scanNodeIds;
+};
+
+/// Builds TPC-DS queries over the tables generated by the TPC-DS connector.
+/// The plans are written by hand and cover the shapes that dominate TPC-DS:
+/// star joins of store_sales with several dimensions (q3, q42, q55),
+/// grouping sets (q27) and window functions over aggregates (q98).
+/// The TPC-DS connector does not push down filters, so these are applied
+/// after the scans.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(double scaleFactor) : scaleFactor_(scaleFactor) {}
+
+  /// Get the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number
+  TpcdsPlan getQueryPlan(int queryId) const;
+
+  /// Returns the numbers of the queries getQueryPlan() supports.
+  static const std::vector<int>& getQueryIds();
+
+ private:
+  TpcdsPlan getQ3Plan() const;
+  TpcdsPlan getQ27Plan() const;
+  TpcdsPlan getQ42Plan() const;
+  TpcdsPlan getQ55Plan() const;
+  TpcdsPlan getQ98Plan() const;
+
+  // Returns a plan that joins store_sales with the rows of 'itemColumns' of
+  // the items that pass 'itemFilter' and with the days that pass
+  // 'dateFilter'. 'dateFilter' may use d_date, d_year and d_moy. The output
+  // has 'outputColumns' of the three tables. Adds the IDs of the scans to
+  // 'scanNodeIds'.
+  PlanBuilder makeItemSales(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      const std::string& itemFilter,
+      std::vector<std::string>&& itemColumns,
+      const std::string& dateFilter,
+      const std::vector<std::string>& outputColumns,
+      std::vector<core::PlanNodeId>& scanNodeIds) const;
+
+  const double scaleFactor_;
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
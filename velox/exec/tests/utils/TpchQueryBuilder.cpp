@@ -146,6 +146,8 @@ TpchPlan TpchQueryBuilder::getQueryPlan(int queryId) const {
       return getQ2Plan();
     case 3:
       return getQ3Plan();
+    case 4:
+      return getQ4Plan();
     case 5:
       return getQ5Plan();
     case 6:
@@ -529,6 +531,66 @@ TpchPlan TpchQueryBuilder::getQ3Plan() const {
   return context;
 }
 
+TpchPlan TpchQueryBuilder::getQ4Plan() const {
+  std::vector<std::string> ordersColumns = {
+      "o_orderdate", "o_orderkey", "o_orderpriority"};
+  std::vector<std::string> lineitemColumns = {
+      "l_orderkey", "l_commitdate", "l_receiptdate"};
+
+  const auto ordersSelectedRowType = getRowType(kOrders, ordersColumns);
+  const auto& ordersFileColumns = getFileColumnNames(kOrders);
+  const auto lineitemSelectedRowType = getRowType(kLineitem, lineitemColumns);
+  const auto& lineitemFileColumns = getFileColumnNames(kLineitem);
+
+  // o_orderdate >= '1993-07-01' and o_orderdate < '1993-10-01'.
+  const auto orderDateFilter = formatDateFilter(
+      "o_orderdate", ordersSelectedRowType, "'1993-07-01'", "'1993-09-30'");
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId ordersPlanNodeId;
+  core::PlanNodeId lineitemPlanNodeId;
+
+  auto orders = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(
+                        kOrders,
+                        ordersSelectedRowType,
+                        ordersFileColumns,
+                        {orderDateFilter})
+                    .capturePlanNodeId(ordersPlanNodeId)
+                    .planNode();
+
+  // The exists subquery is a semi join that keeps each order with at least
+  // one late line item. The orders in the quarter are the build side.
+  auto plan = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kLineitem,
+                      lineitemSelectedRowType,
+                      lineitemFileColumns,
+                      {},
+                      "l_commitdate < l_receiptdate")
+                  .capturePlanNodeId(lineitemPlanNodeId)
+                  .hashJoin(
+                      {"l_orderkey"},
+                      {"o_orderkey"},
+                      orders,
+                      "",
+                      {"o_orderpriority"},
+                      core::JoinType::kRightSemiFilter)
+                  .partialAggregation(
+                      {"o_orderpriority"}, {"count(0) AS order_count"})
+                  .localPartition(std::vector<std::string>{})
+                  .finalAggregation()
+                  .orderBy({"o_orderpriority"}, false)
+                  .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[ordersPlanNodeId] = getTableFilePaths(kOrders);
+  context.dataFiles[lineitemPlanNodeId] = getTableFilePaths(kLineitem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
 TpchPlan TpchQueryBuilder::getQ5Plan() const {
   std::vector<std::string> customerColumns = {"c_custkey", "c_nationkey"};
   std::vector<std::string> ordersColumns = {
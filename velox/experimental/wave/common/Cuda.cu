@@ -109,6 +109,12 @@ void setDevice(Device* device) {
   CUDA_CHECK(cudaSetDevice(device->deviceId));
 }
 
+int64_t deviceMemoryCapacity(Device* device) {
+  cudaDeviceProp properties;
+  CUDA_CHECK(cudaGetDeviceProperties(&properties, device->deviceId));
+  return properties.totalGlobalMem;
+}
+
 Stream::Stream() {
   stream_ = std::make_unique<StreamImpl>();
   CUDA_CHECK(cudaStreamCreate(&stream_->stream));
@@ -38,6 +38,9 @@ Device* getDevice(int32_t preferredId = -1);
 /// Binds subsequent Cuda operations of the calling thread to 'device'.
 void setDevice(Device* device);
 
+/// Returns the total memory of 'device' in bytes.
+int64_t deviceMemoryCapacity(Device* device);
+
 struct StreamImpl;
 
 class Stream {
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/DeviceMemoryPool.h"
+
+#include <gflags/gflags.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/common/time/Timer.h"
+#include "velox/experimental/wave/common/Cuda.h"
+
+DEFINE_int64(
+    wave_device_memory_capacity,
+    0,
+    "Device memory for all Wave queries in bytes. 0 means the memory of the "
+    "device");
+
+DEFINE_int64(
+    wave_device_memory_max_wait_ms,
+    10'000,
+    "Maximum time a query under its fair share of device memory waits for "
+    "other queries to release memory");
+
+namespace facebook::velox::wave {
+
+// static
+std::shared_ptr<DeviceMemoryPool> DeviceMemoryPool::createRoot(
+    int64_t capacity,
+    int64_t maxWaitMs) {
+  return std::make_shared<DeviceMemoryPool>(
+      "root", nullptr, capacity, maxWaitMs);
+}
+
+// static
+DeviceMemoryPool& DeviceMemoryPool::deviceRoot() {
+  static auto root = createRoot(
+      FLAGS_wave_device_memory_capacity
+          ? FLAGS_wave_device_memory_capacity
+          : deviceMemoryCapacity(getDevice()),
+      FLAGS_wave_device_memory_max_wait_ms);
+  return *root;
+}
+
+DeviceMemoryPool::DeviceMemoryPool(
+    std::string name,
+    std::shared_ptr<DeviceMemoryPool> parent,
+    int64_t capacity,
+    int64_t maxWaitMs)
+    : name_(std::move(name)),
+      parent_(std::move(parent)),
+      root_(parent_ ? parent_->root_ : this),
+      capacity_(capacity),
+      maxWait_(maxWaitMs) {}
+
+DeviceMemoryPool::~DeviceMemoryPool() {
+  VELOX_DCHECK_EQ(
+      stats_.reservedBytes, 0, "Device memory leak in pool {}", name_);
+}
+
+std::shared_ptr<DeviceMemoryPool> DeviceMemoryPool::queryPool(
+    const std::string& queryId) {
+  VELOX_CHECK_NULL(parent_, "Query pools are added to the root");
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto it = queries_.begin(); it != queries_.end();) {
+    if (it->second.expired()) {
+      it = queries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& entry = queries_[queryId];
+  auto pool = entry.lock();
+  if (!pool) {
+    pool = std::make_shared<DeviceMemoryPool>(
+        queryId, shared_from_this(), 0, 0);
+    entry = pool;
+  }
+  return pool;
+}
+
+std::shared_ptr<DeviceMemoryPool> DeviceMemoryPool::addLeaf(
+    const std::string& name) {
+  VELOX_CHECK(
+      parent_ && !parent_->parent_, "Leaves are added to query pools");
+  return std::make_shared<DeviceMemoryPool>(
+      fmt::format("{}.{}", name_, name), shared_from_this(), 0, 0);
+}
+
+bool DeviceMemoryPool::fits(int64_t bytes) const {
+  return stats_.reservedBytes + bytes <= capacity_;
+}
+
+void DeviceMemoryPool::charge(int64_t bytes) {
+  for (auto* pool = this; pool; pool = pool->parent_.get()) {
+    pool->stats_.reservedBytes += bytes;
+    pool->stats_.peakBytes =
+        std::max(pool->stats_.peakBytes, pool->stats_.reservedBytes);
+  }
+}
+
+bool DeviceMemoryPool::maybeReserve(int64_t bytes, bool wait) {
+  VELOX_CHECK(
+      parent_ && parent_->parent_, "Memory is reserved in leaf pools");
+  auto& query = *parent_;
+  auto* root = root_;
+  std::unique_lock<std::mutex> l(root->mutex_);
+  if (root->fits(bytes)) {
+    charge(bytes);
+    return true;
+  }
+  // A query over its fair share does not wait, so that queries that use
+  // less get the memory that is released.
+  int64_t numQueries = 0;
+  for (auto& [id, pool] : root->queries_) {
+    numQueries += !pool.expired();
+  }
+  auto fairShare = root->capacity_ / std::max<int64_t>(1, numQueries);
+  if (!wait) {
+    return false;
+  }
+  if (query.stats_.reservedBytes + bytes > fairShare) {
+    ++stats_.numFailures;
+    return false;
+  }
+  ++stats_.numWaits;
+  bool reserved;
+  {
+    MicrosecondTimer timer(&stats_.waitMicros);
+    reserved = root->released_.wait_for(
+        l, maxWait_, [&]() { return root->fits(bytes); });
+  }
+  if (!reserved) {
+    ++stats_.numFailures;
+    return false;
+  }
+  charge(bytes);
+  return true;
+}
+
+void DeviceMemoryPool::reserve(int64_t bytes) {
+  if (!maybeReserve(bytes, true)) {
+    VELOX_MEM_POOL_CAP_EXCEEDED(fmt::format(
+        "Cannot reserve {} of device memory in {}. {}",
+        succinctBytes(bytes),
+        name_,
+        root_->toString()));
+  }
+}
+
+void DeviceMemoryPool::release(int64_t bytes) {
+  auto* root = root_;
+  {
+    std::lock_guard<std::mutex> l(root->mutex_);
+    VELOX_CHECK_LE(bytes, stats_.reservedBytes);
+    charge(-bytes);
+  }
+  root->released_.notify_all();
+}
+
+DeviceMemoryPool::Stats DeviceMemoryPool::stats() const {
+  std::lock_guard<std::mutex> l(root_->mutex_);
+  return stats_;
+}
+
+std::string DeviceMemoryPool::toString() const {
+  auto stats = this->stats();
+  return fmt::format(
+      "DeviceMemoryPool {}: reserved {} peak {} capacity {}",
+      name_,
+      succinctBytes(stats.reservedBytes),
+      succinctBytes(stats.peakBytes),
+      succinctBytes(capacity()));
+}
+
+} // namespace facebook::velox::wave
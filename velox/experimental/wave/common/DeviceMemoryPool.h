@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace facebook::velox::wave {
+
+/// Accounts for the device memory of GpuArenas, like MemoryPool does for
+/// host memory. The pools form a tree of three levels: the root has the
+/// capacity of the device, its children are queries and their children are
+/// leaves that each back one GpuArena. A reservation in a leaf is charged to
+/// its query and to the root.
+///
+/// The root arbitrates between queries. A reservation that fits in the free
+/// capacity of the root succeeds. If the device is full, a query that has
+/// less than its fair share, i.e. the capacity divided by the number of
+/// queries, waits for other queries to release memory. A query over its fair
+/// share, or one that waits longer than the arbitration timeout, fails to
+/// reserve. Before failing, a GpuArena calls its reclaimer to move operator
+/// state out of device memory.
+class DeviceMemoryPool : public std::enable_shared_from_this<DeviceMemoryPool> {
+ public:
+  struct Stats {
+    // Bytes reserved now.
+    int64_t reservedBytes{0};
+
+    // Maximum of 'reservedBytes'.
+    int64_t peakBytes{0};
+
+    // Number of reservations that waited for other queries to release
+    // memory.
+    int64_t numWaits{0};
+
+    // Time spent in these waits.
+    uint64_t waitMicros{0};
+
+    // Number of reservations that failed after arbitration.
+    int64_t numFailures{0};
+  };
+
+  /// Makes a root with 'capacity' bytes. Queries wait at most
+  /// 'maxWaitMs' for other queries to release memory.
+  static std::shared_ptr<DeviceMemoryPool> createRoot(
+      int64_t capacity,
+      int64_t maxWaitMs);
+
+  /// Returns the root for the memory of the device. The capacity is
+  /// --wave_device_memory_capacity or, if 0, the memory of the device.
+  static DeviceMemoryPool& deviceRoot();
+
+  DeviceMemoryPool(
+      std::string name,
+      std::shared_ptr<DeviceMemoryPool> parent,
+      int64_t capacity,
+      int64_t maxWaitMs);
+
+  ~DeviceMemoryPool();
+
+  /// Returns the pool of the query 'queryId' under 'this' root. The first
+  /// caller creates it and the pool lives while referenced.
+  std::shared_ptr<DeviceMemoryPool> queryPool(const std::string& queryId);
+
+  /// Returns a new leaf under 'this' query pool.
+  std::shared_ptr<DeviceMemoryPool> addLeaf(const std::string& name);
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  /// Returns the capacity of the root of 'this'.
+  int64_t capacity() const {
+    return root_->capacity_;
+  }
+
+  /// Reserves 'bytes' for 'this' leaf. Returns false if the reservation
+  /// does not fit in the free capacity and 'wait' is false, or if it does
+  /// not fit after waiting for other queries.
+  bool maybeReserve(int64_t bytes, bool wait);
+
+  /// Reserves 'bytes' for 'this' leaf. Throws if they do not fit.
+  void reserve(int64_t bytes);
+
+  /// Releases 'bytes' reserved in 'this' leaf.
+  void release(int64_t bytes);
+
+  Stats stats() const;
+
+  std::string toString() const;
+
+ private:
+  // Returns true if a reservation of 'bytes' fits in the free capacity.
+  // Called on the root with 'mutex_' held.
+  bool fits(int64_t bytes) const;
+
+  // Adds 'bytes' to 'this' and its ancestors. Called with the root's
+  // 'mutex_' held.
+  void charge(int64_t bytes);
+
+  const std::string name_;
+  const std::shared_ptr<DeviceMemoryPool> parent_;
+  DeviceMemoryPool* const root_;
+
+  // Capacity of the root. 0 for other pools.
+  const int64_t capacity_;
+
+  // Maximum wait in a reservation by a query under its fair share.
+  const std::chrono::milliseconds maxWait_;
+
+  // Serializes reservations under a root. Only used in the root.
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+
+  // The live query pools of a root.
+  std::unordered_map<std::string, std::weak_ptr<DeviceMemoryPool>> queries_;
+
+  // Guarded by the root's 'mutex_'.
+  Stats stats_;
+};
+
+} // namespace facebook::velox::wave
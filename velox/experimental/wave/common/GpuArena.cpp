@@ -277,8 +277,17 @@ GpuArena::Buffers::Buffers() {
   }
 }
 
-GpuArena::GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator)
-    : singleArenaCapacity_(singleArenaCapacity), allocator_(allocator) {
+GpuArena::GpuArena(
+    uint64_t singleArenaCapacity,
+    GpuAllocator* allocator,
+    std::shared_ptr<DeviceMemoryPool> pool)
+    : singleArenaCapacity_(singleArenaCapacity),
+      allocator_(allocator),
+      pool_(std::move(pool)) {
+  if (pool_) {
+    pool_->reserve(singleArenaCapacity);
+    reservedBytes_ = singleArenaCapacity;
+  }
   auto arena = std::make_shared<GpuSlab>(
       allocator_->allocate(singleArenaCapacity),
       singleArenaCapacity,
@@ -287,6 +296,12 @@ GpuArena::GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator)
   currentArena_ = arena;
 }
 
+GpuArena::~GpuArena() {
+  if (pool_) {
+    pool_->release(reservedBytes_);
+  }
+}
+
 WaveBufferPtr GpuArena::getBuffer(void* ptr, size_t size) {
   auto result = firstFreeBuffer_;
   if (!result) {
@@ -307,12 +322,10 @@ WaveBufferPtr GpuArena::getBuffer(void* ptr, size_t size) {
   return result;
 }
 
-WaveBufferPtr GpuArena::allocateBytes(uint64_t bytes) {
-  bytes = GpuSlab::roundBytes(bytes);
-  std::lock_guard<std::mutex> l(mutex_);
+void* GpuArena::allocateFromSlabs(uint64_t bytes) {
   auto* result = currentArena_->allocate(bytes);
   if (result != nullptr) {
-    return getBuffer(result, bytes);
+    return result;
   }
   for (auto pair : arenas_) {
     if (pair.second == currentArena_ || pair.second->freeBytes() < bytes) {
@@ -321,19 +334,44 @@ WaveBufferPtr GpuArena::allocateBytes(uint64_t bytes) {
     result = pair.second->allocate(bytes);
     if (result) {
       currentArena_ = pair.second;
-      return getBuffer(result, bytes);
+      return result;
     }
   }
+  return nullptr;
+}
+
+WaveBufferPtr GpuArena::allocateBytes(uint64_t bytes) {
+  bytes = GpuSlab::roundBytes(bytes);
+  std::unique_lock<std::mutex> l(mutex_);
+  if (auto* result = allocateFromSlabs(bytes)) {
+    return getBuffer(result, bytes);
+  }
 
   // If first allocation fails we create a new GpuSlab for another attempt. If
   // it ever fails again then it means requested bytes is larger than a single
   // GpuSlab's capacity. No further attempts will happen.
   auto arenaBytes = std::max<uint64_t>(singleArenaCapacity_, bytes);
+  if (pool_ && !pool_->maybeReserve(arenaBytes, false)) {
+    // The device is full. Data moved out of 'this' may leave enough space in
+    // the existing GpuSlabs. Otherwise waits for other queries or throws.
+    if (reclaimer_) {
+      l.unlock();
+      reclaimer_();
+      l.lock();
+      if (auto* result = allocateFromSlabs(bytes)) {
+        return getBuffer(result, bytes);
+      }
+    }
+    pool_->reserve(arenaBytes);
+  }
+  if (pool_) {
+    reservedBytes_ += arenaBytes;
+  }
   auto newArena = std::make_shared<GpuSlab>(
       allocator_->allocate(arenaBytes), arenaBytes, allocator_);
   arenas_.emplace(reinterpret_cast<uint64_t>(newArena->address()), newArena);
   currentArena_ = newArena;
-  result = currentArena_->allocate(bytes);
+  auto* result = currentArena_->allocate(bytes);
   if (result) {
     return getBuffer(result, bytes);
   }
@@ -356,6 +394,10 @@ void GpuArena::free(Buffer* buffer) {
   }
   iter->second->free(buffer->ptr_, buffer->size_);
   if (iter->second->empty() && iter->second != currentArena_) {
+    if (pool_) {
+      reservedBytes_ -= iter->second->byteSize();
+      pool_->release(iter->second->byteSize());
+    }
     arenas_.erase(iter);
   }
   buffer->ptr_ = firstFreeBuffer_;
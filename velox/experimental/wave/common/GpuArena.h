@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -26,6 +27,7 @@
 
 #include "velox/experimental/wave/common/Buffer.h"
 #include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/DeviceMemoryPool.h"
 
 namespace facebook::velox::wave {
 
@@ -116,10 +118,16 @@ class GpuSlab {
 
 /// A class that manages a set of GpuSlabs. It is able to adapt itself by
 /// growing the number of its managed GpuSlab's when extreme memory
-/// fragmentation happens.
+/// fragmentation happens. If 'pool' is given, the GpuSlabs are reserved from
+/// it.
 class GpuArena {
  public:
-  GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator);
+  GpuArena(
+      uint64_t singleArenaCapacity,
+      GpuAllocator* allocator,
+      std::shared_ptr<DeviceMemoryPool> pool = nullptr);
+
+  ~GpuArena();
 
   WaveBufferPtr allocateBytes(uint64_t bytes);
 
@@ -141,6 +149,16 @@ class GpuArena {
     return arenas_;
   }
 
+  DeviceMemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  /// Sets a function that frees memory of 'this' by moving data out of it.
+  /// Called without locks held when a new GpuSlab does not fit in 'pool_'.
+  void setReclaimer(std::function<void()> reclaimer) {
+    reclaimer_ = std::move(reclaimer);
+  }
+
  private:
   // A preallocated array of Buffer handles for memory of 'this'.
   struct Buffers {
@@ -152,6 +170,10 @@ class GpuArena {
   // 'ptr' and 'size'.
   WaveBufferPtr getBuffer(void* ptr, size_t size);
 
+  // Returns 'bytes' from an existing GpuSlab or nullptr if none has space.
+  // Called with 'mutex_' held.
+  void* allocateFromSlabs(uint64_t bytes);
+
   // Serializes all activity in 'this'.
   std::mutex mutex_;
 
@@ -167,6 +189,13 @@ class GpuArena {
 
   GpuAllocator* const allocator_;
 
+  const std::shared_ptr<DeviceMemoryPool> pool_;
+
+  std::function<void()> reclaimer_;
+
+  // Bytes reserved from 'pool_' for the GpuSlabs.
+  int64_t reservedBytes_{0};
+
   // A sorted list of GpuSlab by its initial address
   std::map<uint64_t, std::shared_ptr<GpuSlab>> arenas_;
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/DeviceMemoryPool.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/experimental/wave/common/GpuArena.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+namespace {
+
+class MallocAllocator : public GpuAllocator {
+ public:
+  void* allocate(size_t bytes) override {
+    return malloc(bytes);
+  }
+
+  void free(void* ptr, size_t /*size*/) override {
+    ::free(ptr);
+  }
+};
+
+constexpr int64_t kMB = 1 << 20;
+
+class DeviceMemoryPoolTest : public testing::Test {
+ protected:
+  MallocAllocator allocator_;
+};
+
+TEST_F(DeviceMemoryPoolTest, accounting) {
+  auto root = DeviceMemoryPool::createRoot(100 * kMB, 0);
+  auto query = root->queryPool("q1");
+  EXPECT_EQ(query, root->queryPool("q1"));
+  auto leaf1 = query->addLeaf("1");
+  auto leaf2 = query->addLeaf("2");
+  leaf1->reserve(10 * kMB);
+  leaf2->reserve(20 * kMB);
+  leaf1->release(5 * kMB);
+  EXPECT_EQ(5 * kMB, leaf1->stats().reservedBytes);
+  EXPECT_EQ(10 * kMB, leaf1->stats().peakBytes);
+  EXPECT_EQ(25 * kMB, query->stats().reservedBytes);
+  EXPECT_EQ(30 * kMB, query->stats().peakBytes);
+  EXPECT_EQ(25 * kMB, root->stats().reservedBytes);
+  leaf1->release(5 * kMB);
+  leaf2->release(20 * kMB);
+  EXPECT_EQ(0, root->stats().reservedBytes);
+  VELOX_ASSERT_THROW(root->addLeaf("x"), "Leaves are added to query pools");
+}
+
+TEST_F(DeviceMemoryPoolTest, arena) {
+  auto root = DeviceMemoryPool::createRoot(100 * kMB, 0);
+  auto leaf = root->queryPool("q1")->addLeaf("1");
+  {
+    GpuArena arena(kMB, &allocator_, leaf);
+    EXPECT_EQ(kMB, leaf->stats().reservedBytes);
+    std::vector<WaveBufferPtr> buffers;
+    for (auto i = 0; i < 6; ++i) {
+      buffers.push_back(arena.allocateBytes(kMB / 2));
+    }
+    EXPECT_EQ(3 * kMB, leaf->stats().reservedBytes);
+    // Freeing the buffers of a slab that is not the current one releases it.
+    buffers[0] = nullptr;
+    buffers[1] = nullptr;
+    EXPECT_EQ(2 * kMB, leaf->stats().reservedBytes);
+  }
+  EXPECT_EQ(0, leaf->stats().reservedBytes);
+  EXPECT_EQ(3 * kMB, leaf->stats().peakBytes);
+}
+
+TEST_F(DeviceMemoryPoolTest, full) {
+  auto root = DeviceMemoryPool::createRoot(2 * kMB, 0);
+  auto leaf = root->queryPool("q1")->addLeaf("1");
+  GpuArena arena(kMB, &allocator_, leaf);
+  std::vector<WaveBufferPtr> buffers;
+  for (auto i = 0; i < 4; ++i) {
+    buffers.push_back(arena.allocateBytes(kMB / 2));
+  }
+  VELOX_ASSERT_THROW(
+      arena.allocateBytes(kMB / 2), "Cannot reserve 1.00MB of device memory");
+  EXPECT_EQ(1, leaf->stats().numFailures);
+}
+
+TEST_F(DeviceMemoryPoolTest, reclaim) {
+  auto root = DeviceMemoryPool::createRoot(kMB, 0);
+  auto leaf = root->queryPool("q1")->addLeaf("1");
+  GpuArena arena(kMB, &allocator_, leaf);
+  std::vector<WaveBufferPtr> buffers;
+  buffers.push_back(arena.allocateBytes(kMB / 2));
+  buffers.push_back(arena.allocateBytes(kMB / 2));
+  int32_t numReclaims = 0;
+  arena.setReclaimer([&]() {
+    ++numReclaims;
+    buffers.pop_back();
+  });
+  // The slab is full and there is no capacity for another. The reclaimer
+  // frees space in the slab.
+  auto buffer = arena.allocateBytes(kMB / 2);
+  EXPECT_EQ(1, numReclaims);
+  EXPECT_EQ(kMB, root->stats().reservedBytes);
+}
+
+TEST_F(DeviceMemoryPoolTest, fairShare) {
+  auto root = DeviceMemoryPool::createRoot(100 * kMB, 10'000);
+  auto big = root->queryPool("big")->addLeaf("1");
+  auto small = root->queryPool("small")->addLeaf("1");
+  big->reserve(80 * kMB);
+
+  // 'big' is over its half of the device and does not wait.
+  EXPECT_FALSE(big->maybeReserve(30 * kMB, true));
+  EXPECT_EQ(0, big->stats().numWaits);
+
+  // 'small' is under its share and waits for 'big' to release.
+  std::thread releaser([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    big->release(80 * kMB);
+  });
+  EXPECT_TRUE(small->maybeReserve(40 * kMB, true));
+  releaser.join();
+  EXPECT_EQ(1, small->stats().numWaits);
+  EXPECT_LT(0, small->stats().waitMicros);
+  EXPECT_EQ(40 * kMB, root->stats().reservedBytes);
+  small->release(40 * kMB);
+}
+
+TEST_F(DeviceMemoryPoolTest, waitTimeout) {
+  auto root = DeviceMemoryPool::createRoot(100 * kMB, 10);
+  auto big = root->queryPool("big")->addLeaf("1");
+  auto small = root->queryPool("small")->addLeaf("1");
+  big->reserve(80 * kMB);
+  VELOX_ASSERT_THROW(small->reserve(40 * kMB), "Cannot reserve");
+  EXPECT_EQ(1, small->stats().numWaits);
+  EXPECT_EQ(1, small->stats().numFailures);
+  big->release(80 * kMB);
+}
+
+} // namespace
@@ -19,6 +19,12 @@
 
 DECLARE_int32(wave_reader_rows_per_tb);
 
+DEFINE_bool(
+    wave_pinned_staging,
+    true,
+    "Copy file data to device from pinned host memory on a separate stream "
+    "instead of prefetching unified memory on the decode stream");
+
 namespace facebook::velox::wave {
 
 BufferId SplitStaging::add(Staging& staging) {
@@ -47,16 +53,37 @@ void SplitStaging::transfer(WaveStream& waveStream, Stream& stream) {
   if (fill_ == 0) {
     return;
   }
+  WaveStats& stats = waveStream.stats();
+  WaveTimer timer(stats.stagingTime);
   deviceBuffer_ = waveStream.arena().allocate<char>(fill_);
-  auto universal = deviceBuffer_->as<char>();
-  for (auto i = 0; i < offsets_.size(); ++i) {
-    memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+  auto device = deviceBuffer_->as<char>();
+  if (!FLAGS_wave_pinned_staging) {
+    for (auto i = 0; i < offsets_.size(); ++i) {
+      memcpy(device + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+    stream.prefetch(getDevice(), device, deviceBuffer_->size());
+  } else {
+    hostBuffer_ = waveStream.hostArena().allocate<char>(fill_);
+    auto host = hostBuffer_->as<char>();
+    for (auto i = 0; i < offsets_.size(); ++i) {
+      memcpy(host + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+    // If the previous kernel on 'stream' is still running, the copy runs
+    // in parallel with it.
+    event_ = std::make_unique<Event>();
+    event_->record(stream);
+    if (!event_->query()) {
+      ++stats.numOverlappedTransfers;
+    }
+    auto* transferStream = waveStream.transferStream();
+    transferStream->hostToDeviceAsync(device, host, fill_);
+    event_->record(*transferStream);
+    event_->wait(stream);
   }
-  stream.prefetch(
-      getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
+  ++stats.numTransfers;
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
-        reinterpret_cast<int64_t>(universal) + offsets_[pair.first];
+        reinterpret_cast<int64_t>(device) + offsets_[pair.first];
   }
 }
 
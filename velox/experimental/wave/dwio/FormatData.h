@@ -73,16 +73,24 @@ class SplitStaging {
   int64_t bytesToDevice() const {
     return fill_;
   }
-  // Starts the transfers registered with add( on 'stream').
+  /// Starts the transfers registered with add() so that work queued on
+  /// 'stream' after this sees the data. With pinned staging, the data is
+  /// copied to pinned host memory and the copy to device runs on the
+  /// transfer stream of 'waveStream', overlapping with kernels already
+  /// queued on 'stream'.
   void transfer(WaveStream& waveStream, Stream& stream);
 
  private:
   void registerPointerInternal(BufferId id, void** ptr, bool clear);
 
-  // Pinned host memory for transfer to device. May be nullptr if using unified
-  // memory.
+  // Pinned host memory for transfer to device. Must live until the transfer
+  // is complete. nullptr if using unified memory.
   WaveBufferPtr hostBuffer_;
 
+  // Recorded on the transfer stream after the copy to device. The stream
+  // given to transfer() waits for this.
+  std::unique_ptr<Event> event_;
+
   // Device accessible memory (device or unified) with the data to read.
   WaveBufferPtr deviceBuffer_;
 
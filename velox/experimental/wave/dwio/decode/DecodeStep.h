@@ -93,9 +93,33 @@ enum class DecodeStep {
   kFlatMapNode,
   kRowCountNoFilter,
   kCountBits,
+  kRleBitpackHybrid,
+  kDefinitionLevels,
+  kDeltaBinaryPacked,
+  kPlainStrings,
+  kDeltaLengthStrings,
+  kDeltaStrings,
   kUnsupported,
 };
 
+/// Run of a Parquet RLE/bit-packed hybrid stream. Filled in by the decode.
+struct RleBitpackRun {
+  // Index of the first value of the run.
+  int32_t firstValue;
+  // Byte offset of the repeated value or of the bit-packed values.
+  int32_t offset;
+  bool isRle;
+};
+
+/// Miniblock of a Parquet DELTA_BINARY_PACKED stream. Filled in by the decode.
+struct DeltaMiniblock {
+  // Min delta of the block of the miniblock.
+  int64_t minDelta;
+  // Byte offset of the bit-packed deltas.
+  int32_t offset;
+  int32_t bitWidth;
+};
+
 class ColumnReader;
 
 /// Describes a decoding loop's input and result disposition.
@@ -351,6 +375,91 @@ struct alignas(16) GpuDecode {
     uint8_t* sourceNull;
   };
 
+  /// Parquet RLE/bit-packed hybrid encoding of dictionary indices or
+  /// definition levels. 'input' starts at the first run, after the bit width
+  /// byte of dictionary indices or the length of definition levels.
+  struct RleBitpackHybrid {
+    const uint8_t* input;
+    // Scratch for the runs. 'size' runs are always enough.
+    RleBitpackRun* runs;
+    // kRleBitpackHybrid: Dictionary values. If nullptr, the result is the
+    // indices.
+    const void* alphabet;
+    // kRleBitpackHybrid: Values or indices. kDefinitionLevels: 4 byte aligned
+    // bitmap with a 0 for null, like 'nulls'.
+    void* result;
+    // Byte size of 'input'.
+    int32_t size;
+    int32_t maxRuns;
+    int32_t bitWidth;
+    int32_t numValues;
+    // kDefinitionLevels: The level of a non-null value.
+    int32_t maxLevel;
+    // kRleBitpackHybrid: Type of 'alphabet' and result.
+    WaveTypeKind dataType;
+  };
+
+  /// Parquet DELTA_BINARY_PACKED integers.
+  struct DeltaBinaryPacked {
+    const char* input;
+    // Scratch for the miniblocks. 'maxMiniblocks' must be at least the number
+    // of values divided by the values per miniblock, rounded up.
+    DeltaMiniblock* miniblocks;
+    void* result;
+    // Byte size of 'input'.
+    int32_t size;
+    int32_t maxMiniblocks;
+    // INTEGER or BIGINT.
+    WaveTypeKind dataType;
+  };
+
+  /// Parquet PLAIN BYTE_ARRAY. Each value is a 4 byte length followed by the
+  /// bytes. The result StringViews point to 'input'.
+  struct PlainStrings {
+    const char* input;
+    // Scratch of 'numValues' ints for the offsets of the values.
+    int32_t* offsets;
+    // StringView per value.
+    void* result;
+    int32_t numValues;
+  };
+
+  /// Parquet DELTA_LENGTH_BYTE_ARRAY. The DELTA_BINARY_PACKED lengths are
+  /// followed by the concatenated bytes. The result StringViews point to
+  /// 'input'.
+  struct DeltaLengthStrings {
+    const char* input;
+    DeltaMiniblock* miniblocks;
+    // Scratch of 'numValues' ints for the lengths.
+    int32_t* lengths;
+    // StringView per value.
+    void* result;
+    int32_t size;
+    int32_t maxMiniblocks;
+    int32_t numValues;
+  };
+
+  /// Parquet DELTA_BYTE_ARRAY. The DELTA_BINARY_PACKED prefix lengths are
+  /// followed by the suffixes in DELTA_LENGTH_BYTE_ARRAY. The strings are
+  /// written to 'buffer' and the result StringViews point to it.
+  struct DeltaStrings {
+    const char* input;
+    DeltaMiniblock* miniblocks;
+    // Scratch of 4 * 'numValues' ints.
+    int32_t* temp;
+    char* buffer;
+    // Set to the total length of the strings. If this is over 'bufferSize',
+    // nothing is written to 'buffer' and the decode must be repeated with a
+    // larger buffer.
+    int32_t* totalLength;
+    // StringView per value.
+    void* result;
+    int32_t size;
+    int32_t maxMiniblocks;
+    int32_t numValues;
+    int32_t bufferSize;
+  };
+
   union {
     Trivial trivial;
     MainlyConstant mainlyConstant;
@@ -363,6 +472,11 @@ struct alignas(16) GpuDecode {
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
     CompactValues compact;
+    RleBitpackHybrid rleBitpackHybrid;
+    DeltaBinaryPacked deltaBinaryPacked;
+    PlainStrings plainStrings;
+    DeltaLengthStrings deltaLengthStrings;
+    DeltaStrings deltaStrings;
   } data;
 
   /// Returns the amount of int aligned global memory per TB needed in 'temp'
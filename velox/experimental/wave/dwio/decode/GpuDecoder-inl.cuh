@@ -18,6 +18,7 @@
 
 #include <cub/cub.cuh> // @manual
 #include "velox/experimental/wave/common/Bits.cuh"
+#include "velox/experimental/wave/common/StringView.h"
 
 namespace facebook::velox::wave {
 
@@ -859,6 +860,383 @@ __device__ void countBits(GpuDecode& step) {
   }
 }
 
+// Parses the run headers of 'op' into 'op.runs'. Returns the number of runs.
+template <int kBlockSize>
+__device__ int32_t parseRleBitpackRuns(GpuDecode::RleBitpackHybrid& op) {
+  extern __shared__ char smem[];
+  auto* numRuns = reinterpret_cast<int32_t*>(smem);
+  if (threadIdx.x == 0) {
+    auto* start = reinterpret_cast<const char*>(op.input);
+    auto* pos = start;
+    auto* end = start + op.size;
+    int32_t valueBytes = (op.bitWidth + 7) / 8;
+    int32_t numValues = 0;
+    int32_t count = 0;
+    while (numValues < op.numValues && pos < end && count < op.maxRuns) {
+      uint32_t header = readVarint32(&pos);
+      auto& run = op.runs[count++];
+      run.firstValue = numValues;
+      run.offset = pos - start;
+      run.isRle = (header & 1) == 0;
+      if (run.isRle) {
+        numValues += header >> 1;
+        pos += valueBytes;
+      } else {
+        // Bit-packed runs are a multiple of 8 values.
+        numValues += (header >> 1) * 8;
+        pos += (header >> 1) * op.bitWidth;
+      }
+    }
+    assert(numValues >= op.numValues);
+    *numRuns = count;
+  }
+  __syncthreads();
+  return *numRuns;
+}
+
+// Returns the value at 'idx' of the runs parsed by parseRleBitpackRuns().
+__device__ inline uint32_t rleBitpackValue(
+    const GpuDecode::RleBitpackHybrid& op,
+    int32_t numRuns,
+    int32_t idx) {
+  // The last run starting at or before 'idx'.
+  int32_t lo = 0;
+  int32_t hi = numRuns;
+  while (hi - lo > 1) {
+    auto mid = (lo + hi) / 2;
+    if (op.runs[mid].firstValue <= idx) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  const auto& run = op.runs[lo];
+  auto* data = op.input + run.offset;
+  if (run.isRle) {
+    uint32_t value = 0;
+    for (auto i = 0; i < (op.bitWidth + 7) / 8; ++i) {
+      value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return value;
+  }
+  auto bit = (idx - run.firstValue) * op.bitWidth;
+  if (op.bitWidth < 32) {
+    return loadBits32(data, bit, op.bitWidth);
+  }
+  return loadBits64(data, bit, op.bitWidth);
+}
+
+template <int kBlockSize, typename T>
+__device__ void decodeRleBitpackHybrid(GpuDecode::RleBitpackHybrid& op) {
+  auto numRuns = parseRleBitpackRuns<kBlockSize>(op);
+  auto* dict = reinterpret_cast<const T*>(op.alphabet);
+  auto* result = reinterpret_cast<T*>(op.result);
+  for (auto i = threadIdx.x; i < op.numValues; i += blockDim.x) {
+    auto index = rleBitpackValue(op, numRuns, i);
+    result[i] = dict ? dict[index] : static_cast<T>(index);
+  }
+  __syncthreads();
+}
+
+template <int kBlockSize>
+__device__ void decodeRleBitpackHybrid(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpackHybrid;
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpackHybrid<kBlockSize, uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpackHybrid<kBlockSize, uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpackHybrid<kBlockSize, uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+    case WaveTypeKind::VARCHAR:
+      // A dictionary of strings is a dictionary of 8 byte StringViews.
+      decodeRleBitpackHybrid<kBlockSize, uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for RleBitpackHybrid\n");
+        assert(false);
+      }
+  }
+}
+
+// Decodes definition levels of a non-nested column to a null bitmap. Each
+// warp makes a 32 bit word of the bitmap with a ballot.
+template <int kBlockSize>
+__device__ void decodeDefinitionLevels(GpuDecode::RleBitpackHybrid& op) {
+  auto numRuns = parseRleBitpackRuns<kBlockSize>(op);
+  auto* result = reinterpret_cast<uint32_t*>(op.result);
+  for (int32_t base = 0; base < op.numValues; base += blockDim.x) {
+    int32_t i = base + threadIdx.x;
+    bool notNull =
+        i < op.numValues && rleBitpackValue(op, numRuns, i) == op.maxLevel;
+    auto bits = __ballot_sync(0xffffffff, notNull);
+    if ((threadIdx.x & (kWarpThreads - 1)) == 0 && i < op.numValues) {
+      result[i / kWarpThreads] = bits;
+    }
+  }
+  __syncthreads();
+}
+
+__device__ inline int64_t zigzagDecode(uint64_t value) {
+  return (value >> 1) ^ -(value & 1);
+}
+
+// Header of a DELTA_BINARY_PACKED stream, shared by the threads of a TB.
+struct DeltaHeader {
+  uint64_t firstValue;
+  int32_t valuesPerMiniblock;
+  int32_t numValues;
+  // Byte offset of the end of the stream.
+  int32_t end;
+};
+
+constexpr int32_t kDeltaHeaderSize = 32;
+static_assert(sizeof(DeltaHeader) <= kDeltaHeaderSize);
+
+// Parses the headers of the DELTA_BINARY_PACKED stream at 'input'. Called by
+// one thread.
+__device__ inline void parseDeltaBinaryPacked(
+    const char* input,
+    DeltaMiniblock* miniblocks,
+    int32_t maxMiniblocks,
+    DeltaHeader* header) {
+  auto* pos = input;
+  auto blockSize = readVarint32(&pos);
+  auto numMiniblocks = readVarint32(&pos);
+  int32_t numValues = readVarint32(&pos);
+  header->firstValue = zigzagDecode(readVarint64(&pos));
+  header->valuesPerMiniblock = blockSize / numMiniblocks;
+  header->numValues = numValues;
+  int32_t numDeltas = numValues > 0 ? numValues - 1 : 0;
+  int32_t count = 0;
+  for (int32_t delta = 0; delta < numDeltas;) {
+    int64_t minDelta = zigzagDecode(readVarint64(&pos));
+    auto* widths = reinterpret_cast<const uint8_t*>(pos);
+    pos += numMiniblocks;
+    // The miniblocks after the last value are not present.
+    for (auto i = 0; i < numMiniblocks && delta < numDeltas; ++i) {
+      assert(count < maxMiniblocks);
+      auto& miniblock = miniblocks[count++];
+      miniblock.minDelta = minDelta;
+      miniblock.offset = pos - input;
+      miniblock.bitWidth = widths[i];
+      pos += header->valuesPerMiniblock * miniblock.bitWidth / 8;
+      delta += header->valuesPerMiniblock;
+    }
+  }
+  header->end = pos - input;
+}
+
+// Decodes the DELTA_BINARY_PACKED stream at 'input' to 'result'. The deltas
+// are unpacked in parallel and added up with a block wide scan. Returns the
+// byte offset of the end of the stream.
+template <int kBlockSize, typename T>
+__device__ int32_t decodeDeltaBinaryPacked(
+    const char* input,
+    DeltaMiniblock* miniblocks,
+    int32_t maxMiniblocks,
+    T* result) {
+  using BlockScan = cub::BlockScan<uint64_t, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* header = reinterpret_cast<DeltaHeader*>(smem);
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(
+      smem + kDeltaHeaderSize);
+  if (threadIdx.x == 0) {
+    parseDeltaBinaryPacked(input, miniblocks, maxMiniblocks, header);
+  }
+  __syncthreads();
+  auto numValues = header->numValues;
+  auto valuesPerMiniblock = header->valuesPerMiniblock;
+  // Deltas and values wrap around like in the writer.
+  uint64_t carry = header->firstValue;
+  for (int32_t base = 0; base < numValues; base += kBlockSize) {
+    int32_t i = base + threadIdx.x;
+    uint64_t delta = 0;
+    if (i > 0 && i < numValues) {
+      auto nthDelta = i - 1;
+      const auto& miniblock = miniblocks[nthDelta / valuesPerMiniblock];
+      auto width = miniblock.bitWidth;
+      auto* deltas = input + miniblock.offset;
+      auto bit = (nthDelta % valuesPerMiniblock) * width;
+      if (width == 0) {
+        delta = 0;
+      } else if (width < 32) {
+        delta = loadBits32(deltas, bit, width);
+      } else {
+        delta = loadBits64(deltas, bit, width);
+      }
+      delta += miniblock.minDelta;
+    }
+    uint64_t sum;
+    uint64_t total;
+    BlockScan(*scanStorage).InclusiveSum(delta, sum, total);
+    __syncthreads();
+    if (i < numValues) {
+      result[i] = static_cast<T>(carry + sum);
+    }
+    carry += total;
+  }
+  auto end = header->end;
+  __syncthreads();
+  return end;
+}
+
+template <int kBlockSize>
+__device__ void decodeDeltaBinaryPacked(GpuDecode& plan) {
+  auto& op = plan.data.deltaBinaryPacked;
+  switch (op.dataType) {
+    case WaveTypeKind::INTEGER:
+      decodeDeltaBinaryPacked<kBlockSize, int32_t>(
+          op.input, op.miniblocks, op.maxMiniblocks, (int32_t*)op.result);
+      break;
+    case WaveTypeKind::BIGINT:
+      decodeDeltaBinaryPacked<kBlockSize, int64_t>(
+          op.input, op.miniblocks, op.maxMiniblocks, (int64_t*)op.result);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for DeltaBinaryPacked\n");
+        assert(false);
+      }
+  }
+}
+
+__device__ inline int32_t loadLength(const char* data) {
+  auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+}
+
+// The start of each value depends on the lengths of all the values before
+// it, so one thread finds the starts and then all threads make the
+// StringViews.
+template <int kBlockSize>
+__device__ void decodePlainStrings(GpuDecode::PlainStrings& op) {
+  auto* offsets = op.offsets;
+  if (threadIdx.x == 0) {
+    int32_t offset = 0;
+    for (auto i = 0; i < op.numValues; ++i) {
+      offsets[i] = offset + sizeof(int32_t);
+      offset += sizeof(int32_t) + loadLength(op.input + offset);
+    }
+  }
+  __syncthreads();
+  auto* result = reinterpret_cast<StringView*>(op.result);
+  for (auto i = threadIdx.x; i < op.numValues; i += blockDim.x) {
+    auto* data = op.input + offsets[i];
+    result[i].init(data, loadLength(data - sizeof(int32_t)));
+  }
+  __syncthreads();
+}
+
+// Makes StringViews over the concatenated strings in 'data' with 'lengths'.
+template <int kBlockSize>
+__device__ void stringsFromLengths(
+    const char* data,
+    const int32_t* lengths,
+    int32_t numValues,
+    StringView* result) {
+  using BlockScan = cub::BlockScan<int32_t, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(smem);
+  int32_t carry = 0;
+  for (int32_t base = 0; base < numValues; base += kBlockSize) {
+    int32_t i = base + threadIdx.x;
+    int32_t length = i < numValues ? lengths[i] : 0;
+    int32_t offset;
+    int32_t total;
+    BlockScan(*scanStorage).ExclusiveSum(length, offset, total);
+    __syncthreads();
+    if (i < numValues) {
+      result[i].init(data + carry + offset, length);
+    }
+    carry += total;
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeDeltaLengthStrings(GpuDecode::DeltaLengthStrings& op) {
+  auto end = decodeDeltaBinaryPacked<kBlockSize, int32_t>(
+      op.input, op.miniblocks, op.maxMiniblocks, op.lengths);
+  stringsFromLengths<kBlockSize>(
+      op.input + end,
+      op.lengths,
+      op.numValues,
+      reinterpret_cast<StringView*>(op.result));
+  __syncthreads();
+}
+
+// Each string is the prefix of the previous string followed by its suffix.
+// Byte 'j' of string 'i' comes from the suffix of the last string at or
+// before 'i' with a prefix of at most 'j' bytes, so that each string can be
+// made by its own thread without waiting for the previous strings.
+template <int kBlockSize>
+__device__ void decodeDeltaStrings(GpuDecode::DeltaStrings& op) {
+  auto numValues = op.numValues;
+  auto* prefixLengths = op.temp;
+  auto* suffixLengths = op.temp + numValues;
+  auto* suffixOffsets = op.temp + 2 * numValues;
+  auto* offsets = op.temp + 3 * numValues;
+  auto end = decodeDeltaBinaryPacked<kBlockSize, int32_t>(
+      op.input, op.miniblocks, op.maxMiniblocks, prefixLengths);
+  end += decodeDeltaBinaryPacked<kBlockSize, int32_t>(
+      op.input + end, op.miniblocks, op.maxMiniblocks, suffixLengths);
+  auto* suffixes = op.input + end;
+
+  using BlockScan = cub::BlockScan<int32_t, kBlockSize>;
+  extern __shared__ char smem[];
+  auto* scanStorage = reinterpret_cast<typename BlockScan::TempStorage*>(smem);
+  int32_t suffixCarry = 0;
+  int32_t carry = 0;
+  for (int32_t base = 0; base < numValues; base += kBlockSize) {
+    int32_t i = base + threadIdx.x;
+    int32_t suffixLength = i < numValues ? suffixLengths[i] : 0;
+    int32_t length = i < numValues ? prefixLengths[i] + suffixLength : 0;
+    int32_t offset;
+    int32_t total;
+    BlockScan(*scanStorage).ExclusiveSum(suffixLength, offset, total);
+    __syncthreads();
+    if (i < numValues) {
+      suffixOffsets[i] = suffixCarry + offset;
+    }
+    suffixCarry += total;
+    BlockScan(*scanStorage).ExclusiveSum(length, offset, total);
+    __syncthreads();
+    if (i < numValues) {
+      offsets[i] = carry + offset;
+    }
+    carry += total;
+  }
+  if (threadIdx.x == 0) {
+    *op.totalLength = carry;
+  }
+  __syncthreads();
+  if (carry > op.bufferSize) {
+    return;
+  }
+  auto* result = reinterpret_cast<StringView*>(op.result);
+  for (auto i = threadIdx.x; i < numValues; i += blockDim.x) {
+    auto length = prefixLengths[i] + suffixLengths[i];
+    auto* string = op.buffer + offsets[i];
+    int32_t source = i;
+    for (int32_t j = length - 1; j >= 0; --j) {
+      while (prefixLengths[source] > j) {
+        --source;
+      }
+      string[j] =
+          suffixes[suffixOffsets[source] + j - prefixLengths[source]];
+    }
+    result[i].init(string, length);
+  }
+  __syncthreads();
+}
+
 template <int32_t kBlockSize>
 __device__ void decodeSwitch(GpuDecode& op) {
   switch (op.step) {
@@ -901,6 +1279,24 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRowCountNoFilter:
       detail::setRowCountNoFilter<kBlockSize>(op.data.rowCountNoFilter);
       break;
+    case DecodeStep::kRleBitpackHybrid:
+      detail::decodeRleBitpackHybrid<kBlockSize>(op);
+      break;
+    case DecodeStep::kDefinitionLevels:
+      detail::decodeDefinitionLevels<kBlockSize>(op.data.rleBitpackHybrid);
+      break;
+    case DecodeStep::kDeltaBinaryPacked:
+      detail::decodeDeltaBinaryPacked<kBlockSize>(op);
+      break;
+    case DecodeStep::kPlainStrings:
+      detail::decodePlainStrings<kBlockSize>(op.data.plainStrings);
+      break;
+    case DecodeStep::kDeltaLengthStrings:
+      detail::decodeDeltaLengthStrings<kBlockSize>(op.data.deltaLengthStrings);
+      break;
+    case DecodeStep::kDeltaStrings:
+      detail::decodeDeltaStrings<kBlockSize>(op.data.deltaStrings);
+      break;
     default:
       if (threadIdx.x == 0) {
         printf("ERROR: Unsupported DecodeStep (with shared memory)\n");
@@ -917,6 +1313,7 @@ template <int32_t kBlockSize>
 int32_t sharedMemorySizeForDecode(DecodeStep step) {
   using Reduce32 = cub::BlockReduce<int32_t, kBlockSize>;
   using BlockScan32 = cub::BlockScan<int32_t, kBlockSize>;
+  using BlockScan64 = cub::BlockScan<uint64_t, kBlockSize>;
   switch (step) {
     case DecodeStep::kSelective32:
     case DecodeStep::kSelective64:
@@ -926,6 +1323,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kCountBits:
     case DecodeStep::kSparseBool:
     case DecodeStep::kRowCountNoFilter:
+    case DecodeStep::kPlainStrings:
       return 0;
       break;
 
@@ -938,6 +1336,15 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
       return sizeof(typename BlockScan32::TempStorage);
+    case DecodeStep::kRleBitpackHybrid:
+    case DecodeStep::kDefinitionLevels:
+      // The number of runs.
+      return sizeof(int32_t);
+    case DecodeStep::kDeltaBinaryPacked:
+    case DecodeStep::kDeltaLengthStrings:
+    case DecodeStep::kDeltaStrings:
+      // Also fits the 32 bit scan of the string lengths.
+      return kDeltaHeaderSize + sizeof(typename BlockScan64::TempStorage);
     default:
       assert(false); // Undefined.
       return 0;
@@ -128,6 +128,149 @@ void makeBitpackDict(
       reinterpret_cast<T*>(memory), dictBytes + bitBytes + scatterBytes);
 }
 
+template <typename T>
+void writeVarint(T val, std::string& out) {
+  while (val >= 128) {
+    out.push_back(0x80 | (val & 0x7f));
+    val >>= 7;
+  }
+  out.push_back(val);
+}
+
+uint64_t zigzagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+}
+
+// Appends 'values' bit-packed at 'bitWidth' bits, least significant first.
+void appendBitpacked(
+    const uint64_t* values,
+    int32_t numValues,
+    int32_t bitWidth,
+    std::string& out) {
+  auto start = out.size();
+  out.resize(start + (numValues * bitWidth + 7) / 8);
+  auto* bytes = reinterpret_cast<uint8_t*>(out.data() + start);
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto bit = 0; bit < bitWidth; ++bit) {
+      if ((values[i] >> bit) & 1) {
+        setBit(bytes, i * bitWidth + bit);
+      }
+    }
+  }
+}
+
+int32_t bitsNeeded(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+// Encodes 'values' as Parquet RLE/bit-packed hybrid runs. Runs of at least 8
+// equal values are RLE, the rest are bit-packed in groups of 8.
+std::string encodeRleBitpack(
+    const std::vector<uint32_t>& values,
+    int32_t bitWidth) {
+  std::string out;
+  auto runLength = [&](int32_t i) {
+    auto end = i;
+    while (end < values.size() && values[end] == values[i]) {
+      ++end;
+    }
+    return end - i;
+  };
+  int32_t i = 0;
+  while (i < values.size()) {
+    auto length = runLength(i);
+    if (length >= 8) {
+      writeVarint<uint32_t>(length << 1, out);
+      for (auto byte = 0; byte < (bitWidth + 7) / 8; ++byte) {
+        out.push_back(values[i] >> (8 * byte));
+      }
+      i += length;
+      continue;
+    }
+    std::vector<uint64_t> group;
+    do {
+      for (auto j = 0; j < 8; ++j) {
+        group.push_back(i + j < values.size() ? values[i + j] : 0);
+      }
+      i += 8;
+    } while (i < values.size() && runLength(i) < 8 && group.size() < 63 * 8);
+    writeVarint<uint32_t>((group.size() / 8) << 1 | 1, out);
+    appendBitpacked(group.data(), group.size(), bitWidth, out);
+  }
+  return out;
+}
+
+// Encodes 'values' as Parquet DELTA_BINARY_PACKED with blocks of 128 values
+// in 4 miniblocks.
+std::string encodeDeltaBinaryPacked(const std::vector<int64_t>& values) {
+  constexpr int32_t kBlockValues = 128;
+  constexpr int32_t kNumMiniblocks = 4;
+  constexpr int32_t kMiniblockValues = kBlockValues / kNumMiniblocks;
+  std::string out;
+  writeVarint<uint32_t>(kBlockValues, out);
+  writeVarint<uint32_t>(kNumMiniblocks, out);
+  writeVarint<uint32_t>(values.size(), out);
+  writeVarint(zigzagEncode(values.empty() ? 0 : values[0]), out);
+  std::vector<int64_t> deltas;
+  for (auto i = 1; i < values.size(); ++i) {
+    deltas.push_back(
+        static_cast<uint64_t>(values[i]) -
+        static_cast<uint64_t>(values[i - 1]));
+  }
+  for (auto block = 0; block < deltas.size(); block += kBlockValues) {
+    auto blockEnd = std::min<int32_t>(deltas.size(), block + kBlockValues);
+    auto minDelta =
+        *std::min_element(deltas.begin() + block, deltas.begin() + blockEnd);
+    writeVarint(zigzagEncode(minDelta), out);
+    std::vector<std::vector<uint64_t>> miniblocks;
+    std::string widths;
+    for (auto i = 0; i < kNumMiniblocks; ++i) {
+      auto begin = block + i * kMiniblockValues;
+      int32_t width = 0;
+      if (begin < blockEnd) {
+        auto& miniblock = miniblocks.emplace_back(kMiniblockValues);
+        for (auto j = 0; j < kMiniblockValues && begin + j < blockEnd; ++j) {
+          miniblock[j] = static_cast<uint64_t>(deltas[begin + j]) -
+              static_cast<uint64_t>(minDelta);
+          width = std::max(width, bitsNeeded(miniblock[j]));
+        }
+      }
+      widths.push_back(width);
+    }
+    out += widths;
+    for (auto i = 0; i < miniblocks.size(); ++i) {
+      appendBitpacked(
+          miniblocks[i].data(), kMiniblockValues, widths[i], out);
+    }
+  }
+  return out;
+}
+
+template <typename T>
+gpu::CudaPtr<T[]> toDevice(const std::string& data) {
+  // Extra bytes for loading whole words at the end.
+  auto result = allocate<T>((data.size() + 16) / sizeof(T) + 1);
+  memcpy(result.get(), data.data(), data.size());
+  return result;
+}
+
+// Returns 'numValues' strings. If 'sorted', they are ascending with long common
+// prefixes.
+std::vector<std::string> makeStrings(int32_t numValues, bool sorted) {
+  std::vector<std::string> strings;
+  uint64_t seed = 0xafbe1647deba879LU;
+  for (auto i = 0; i < numValues; ++i) {
+    seed = (seed * 0x5def1) ^ (seed >> 21);
+    if (sorted) {
+      strings.push_back(fmt::format(
+          "customer-{:06}-{}", i / 7, std::string(seed % 13, 'a' + i % 7)));
+    } else {
+      strings.push_back(std::string(seed % 20, 'a' + seed % 26));
+    }
+  }
+  return strings;
+}
+
 class GpuDecoderTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -581,6 +724,282 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  template <typename T, int kBlockSize>
+  void testRleBitpackHybrid(
+      int32_t bitWidth,
+      int32_t numValues,
+      int32_t numBlocks,
+      bool useDict) {
+    std::vector<uint32_t> indices(numValues);
+    fillRandom(indices.data(), numValues);
+    uint32_t mask = (1u << bitWidth) - 1;
+    for (auto i = 0; i < numValues; ++i) {
+      // Alternate runs of 100 equal and of 100 random indices.
+      indices[i] = (i / 100) % 2 == 0 ? (i / 100) & mask : indices[i] & mask;
+    }
+    auto encoded = encodeRleBitpack(indices, bitWidth);
+    auto input = toDevice<uint8_t>(encoded);
+    auto dict = allocate<T>(1 << bitWidth);
+    for (auto i = 0; i < (1 << bitWidth); ++i) {
+      dict[i] = i * 3 + 1;
+    }
+    auto runs = allocate<RleBitpackRun>(encoded.size() * numBlocks);
+    auto result = allocate<T>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kRleBitpackHybrid;
+      auto& op = ops[i].data.rleBitpackHybrid;
+      op.input = input.get();
+      op.runs = runs.get() + i * encoded.size();
+      op.alphabet = useDict ? dict.get() : nullptr;
+      op.result = result.get() + i * numValues;
+      op.size = encoded.size();
+      op.maxRuns = encoded.size();
+      op.bitWidth = bitWidth;
+      op.numValues = numValues;
+      op.dataType = WaveTypeTrait<T>::typeKind;
+    }
+    testCase(
+        fmt::format(
+            "rle bitpack hybrid {} bitWidth={} useDict={}",
+            sizeof(T) * 8,
+            bitWidth,
+            useDict),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        encoded.size() * numBlocks,
+        10);
+    for (auto i = 0; i < numBlocks; ++i) {
+      auto* values = result.get() + i * numValues;
+      for (auto j = 0; j < numValues; ++j) {
+        ASSERT_EQ(
+            values[j],
+            useDict ? dict[indices[j]] : static_cast<T>(indices[j]))
+            << j;
+      }
+    }
+  }
+
+  template <int kBlockSize>
+  void testDefinitionLevels(int32_t numValues, int32_t numBlocks) {
+    std::vector<uint32_t> levels(numValues);
+    fillRandom(levels.data(), numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      // Runs of non-nulls and of nulls followed by random nulls.
+      auto nth = i % 1000;
+      levels[i] = nth < 300 ? 1 : nth < 400 ? 0 : (levels[i] >> 7) & 1;
+    }
+    auto encoded = encodeRleBitpack(levels, 1);
+    auto input = toDevice<uint8_t>(encoded);
+    auto runs = allocate<RleBitpackRun>(encoded.size() * numBlocks);
+    int32_t numWords = roundUp(numValues, 64) / 32;
+    auto result = allocate<uint32_t>(numWords * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kDefinitionLevels;
+      auto& op = ops[i].data.rleBitpackHybrid;
+      op.input = input.get();
+      op.runs = runs.get() + i * encoded.size();
+      op.result = result.get() + i * numWords;
+      op.size = encoded.size();
+      op.maxRuns = encoded.size();
+      op.bitWidth = 1;
+      op.numValues = numValues;
+      op.maxLevel = 1;
+    }
+    testCase(
+        fmt::format("definition levels numValues={}", numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        encoded.size() * numBlocks,
+        10);
+    for (auto i = 0; i < numBlocks; ++i) {
+      auto* nulls = reinterpret_cast<uint8_t*>(result.get() + i * numWords);
+      for (auto j = 0; j < numValues; ++j) {
+        ASSERT_EQ(isSet(nulls, j), levels[j] == 1) << j;
+      }
+    }
+  }
+
+  template <typename T, int kBlockSize>
+  void testDeltaBinaryPacked(int32_t numValues, int32_t numBlocks) {
+    std::vector<int64_t> values(numValues);
+    fillRandom(values.data(), numValues);
+    for (auto i = 0; i < numValues; ++i) {
+      // Mostly ascending with a few random values.
+      if (i % 1000 != 0) {
+        values[i] = static_cast<T>(i * 3 + values[i] % 10);
+      } else {
+        values[i] = static_cast<T>(values[i]);
+      }
+    }
+    auto encoded = encodeDeltaBinaryPacked(values);
+    auto input = toDevice<char>(encoded);
+    int32_t maxMiniblocks = numValues / 32 + 1;
+    auto miniblocks = allocate<DeltaMiniblock>(maxMiniblocks * numBlocks);
+    auto result = allocate<T>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kDeltaBinaryPacked;
+      auto& op = ops[i].data.deltaBinaryPacked;
+      op.input = input.get();
+      op.miniblocks = miniblocks.get() + i * maxMiniblocks;
+      op.result = result.get() + i * numValues;
+      op.size = encoded.size();
+      op.maxMiniblocks = maxMiniblocks;
+      op.dataType = WaveTypeTrait<T>::typeKind;
+    }
+    testCase(
+        fmt::format(
+            "delta binary packed {} numValues={}", sizeof(T) * 8, numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        encoded.size() * numBlocks,
+        10);
+    for (auto i = 0; i < numBlocks; ++i) {
+      auto* decoded = result.get() + i * numValues;
+      for (auto j = 0; j < numValues; ++j) {
+        ASSERT_EQ(decoded[j], values[j]) << j;
+      }
+    }
+  }
+
+  template <int kBlockSize>
+  void testPlainStrings(int32_t numValues, int32_t numBlocks) {
+    auto strings = makeStrings(numValues, false);
+    std::string encoded;
+    for (auto& string : strings) {
+      int32_t length = string.size();
+      encoded.append(reinterpret_cast<const char*>(&length), sizeof(length));
+      encoded += string;
+    }
+    auto input = toDevice<char>(encoded);
+    auto offsets = allocate<int32_t>(numValues * numBlocks);
+    auto result = allocate<StringView>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kPlainStrings;
+      auto& op = ops[i].data.plainStrings;
+      op.input = input.get();
+      op.offsets = offsets.get() + i * numValues;
+      op.result = result.get() + i * numValues;
+      op.numValues = numValues;
+    }
+    testCase(
+        fmt::format("plain strings numValues={}", numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        encoded.size() * numBlocks,
+        10);
+    checkStrings(strings, result.get(), numBlocks);
+  }
+
+  template <int kBlockSize>
+  void testDeltaLengthStrings(int32_t numValues, int32_t numBlocks) {
+    auto strings = makeStrings(numValues, false);
+    std::vector<int64_t> lengths;
+    std::string data;
+    for (auto& string : strings) {
+      lengths.push_back(string.size());
+      data += string;
+    }
+    auto encoded = encodeDeltaBinaryPacked(lengths) + data;
+    auto input = toDevice<char>(encoded);
+    int32_t maxMiniblocks = numValues / 32 + 1;
+    auto miniblocks = allocate<DeltaMiniblock>(maxMiniblocks * numBlocks);
+    auto scratch = allocate<int32_t>(numValues * numBlocks);
+    auto result = allocate<StringView>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kDeltaLengthStrings;
+      auto& op = ops[i].data.deltaLengthStrings;
+      op.input = input.get();
+      op.miniblocks = miniblocks.get() + i * maxMiniblocks;
+      op.lengths = scratch.get() + i * numValues;
+      op.result = result.get() + i * numValues;
+      op.size = encoded.size();
+      op.maxMiniblocks = maxMiniblocks;
+      op.numValues = numValues;
+    }
+    testCase(
+        fmt::format("delta length strings numValues={}", numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        encoded.size() * numBlocks,
+        10);
+    checkStrings(strings, result.get(), numBlocks);
+  }
+
+  template <int kBlockSize>
+  void testDeltaStrings(int32_t numValues, int32_t numBlocks) {
+    auto strings = makeStrings(numValues, true);
+    std::vector<int64_t> prefixLengths;
+    std::vector<int64_t> suffixLengths;
+    std::string suffixes;
+    int32_t totalLength = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      auto& string = strings[i];
+      int32_t prefix = 0;
+      if (i > 0) {
+        auto& previous = strings[i - 1];
+        while (prefix < std::min(string.size(), previous.size()) &&
+               string[prefix] == previous[prefix]) {
+          ++prefix;
+        }
+      }
+      prefixLengths.push_back(prefix);
+      suffixLengths.push_back(string.size() - prefix);
+      suffixes += string.substr(prefix);
+      totalLength += string.size();
+    }
+    auto encoded = encodeDeltaBinaryPacked(prefixLengths) +
+        encodeDeltaBinaryPacked(suffixLengths) + suffixes;
+    auto input = toDevice<char>(encoded);
+    int32_t maxMiniblocks = numValues / 32 + 1;
+    auto miniblocks = allocate<DeltaMiniblock>(maxMiniblocks * numBlocks);
+    auto scratch = allocate<int32_t>(4 * numValues * numBlocks);
+    auto buffer = allocate<char>(totalLength * numBlocks);
+    auto lengths = allocate<int32_t>(numBlocks);
+    auto result = allocate<StringView>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kDeltaStrings;
+      auto& op = ops[i].data.deltaStrings;
+      op.input = input.get();
+      op.miniblocks = miniblocks.get() + i * maxMiniblocks;
+      op.temp = scratch.get() + 4 * i * numValues;
+      op.buffer = buffer.get() + i * totalLength;
+      op.totalLength = lengths.get() + i;
+      op.result = result.get() + i * numValues;
+      op.size = encoded.size();
+      op.maxMiniblocks = maxMiniblocks;
+      op.numValues = numValues;
+      // The first decode only returns the size of the buffer.
+      op.bufferSize = 0;
+    }
+    decodeGlobal<kBlockSize>(ops.get(), numBlocks);
+    CUDA_CHECK_FATAL(cudaGetLastError());
+    CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+    for (auto i = 0; i < numBlocks; ++i) {
+      ASSERT_EQ(lengths[i], totalLength);
+      ops[i].data.deltaStrings.bufferSize = lengths[i];
+    }
+    testCase(
+        fmt::format("delta strings numValues={}", numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        encoded.size() * numBlocks,
+        10);
+    checkStrings(strings, result.get(), numBlocks);
+  }
+
+  void checkStrings(
+      const std::vector<std::string>& expected,
+      const StringView* result,
+      int32_t numBlocks) {
+    for (auto i = 0; i < numBlocks; ++i) {
+      for (auto j = 0; j < expected.size(); ++j) {
+        ASSERT_EQ(
+            std::string_view(result[i * expected.size() + j]), expected[j])
+            << j;
+      }
+    }
+  }
+
  private:
   std::unique_ptr<GpuArena> arena_;
 
@@ -638,6 +1057,35 @@ TEST_F(GpuDecoderTest, streamApi) {
   testMakeScatterIndicesStream(100, 20);
   testMakeScatterIndicesStream(999, 999);
 }
+
+TEST_F(GpuDecoderTest, rleBitpackHybrid) {
+  testRleBitpackHybrid<int32_t, 256>(11, 10'007, 256, false);
+  testRleBitpackHybrid<int64_t, 256>(11, 10'007, 256, true);
+  testRleBitpackHybrid<int64_t, 256>(1, 10'007, 256, true);
+  testRleBitpackHybrid<int64_t, 256>(20, 10'007, 256, true);
+}
+
+TEST_F(GpuDecoderTest, definitionLevels) {
+  testDefinitionLevels<256>(10'007, 256);
+}
+
+TEST_F(GpuDecoderTest, deltaBinaryPacked) {
+  testDeltaBinaryPacked<int32_t, 256>(10'007, 256);
+  testDeltaBinaryPacked<int64_t, 256>(10'007, 256);
+  testDeltaBinaryPacked<int64_t, 256>(1, 1);
+}
+
+TEST_F(GpuDecoderTest, plainStrings) {
+  testPlainStrings<256>(10'007, 256);
+}
+
+TEST_F(GpuDecoderTest, deltaLengthStrings) {
+  testDeltaLengthStrings<256>(10'007, 256);
+}
+
+TEST_F(GpuDecoderTest, deltaStrings) {
+  testDeltaStrings<256>(10'007, 256);
+}
 } // namespace
 } // namespace facebook::velox::wave
 
@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include <folly/ScopeGuard.h>
+#include <folly/Synchronized.h>
+
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+
+DECLARE_int64(velox_wave_arena_unit_size);
+
+namespace facebook::velox::wave {
+
+namespace {
+
+bool isJoinKey(const TypePtr& type) {
+  return type->kind() == TypeKind::INTEGER || type->kind() == TypeKind::BIGINT;
+}
+
+BlockStatus* allocateStatus(
+    GpuArena& arena,
+    int32_t numBlocks,
+    WaveBufferPtr& holder) {
+  auto* status = arena.allocate<BlockStatus>(numBlocks, holder);
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  return status;
+}
+
+// Returns 'numBlocks' programs that each run 'numInstructions' from
+// 'instructions'.
+join::ThreadBlockProgram* makePrograms(
+    GpuArena& arena,
+    int32_t numBlocks,
+    int32_t numInstructions,
+    join::Instruction* instructions,
+    WaveBufferPtr& holder) {
+  auto* programs = arena.allocate<join::ThreadBlockProgram>(numBlocks, holder);
+  for (auto i = 0; i < numBlocks; ++i) {
+    programs[i].numInstructions = numInstructions;
+    programs[i].instructions = instructions;
+  }
+  return programs;
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return bits::roundUp(numRows, kBlockSize) / kBlockSize;
+}
+
+} // namespace
+
+bool isSupportedJoin(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.leftKeys().size() != 1) {
+    return false;
+  }
+  if (!isJoinKey(node.leftKeys()[0]->type()) ||
+      !isJoinKey(node.rightKeys()[0]->type())) {
+    return false;
+  }
+  for (auto& type : node.sources()[1]->outputType()->children()) {
+    if (!isFixedWidth(type)) {
+      return false;
+    }
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isFixedWidth(type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+std::shared_ptr<WaveJoinBridge> WaveJoinBridge::get(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) {
+  static folly::Synchronized<
+      std::unordered_map<std::string, std::weak_ptr<WaveJoinBridge>>>
+      bridges;
+  auto locked = bridges.wlock();
+  for (auto it = locked->begin(); it != locked->end();) {
+    if (it->second.expired()) {
+      it = locked->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& entry = (*locked)[fmt::format("{}/{}", taskId, planNodeId)];
+  auto bridge = entry.lock();
+  if (!bridge) {
+    bridge = std::make_shared<WaveJoinBridge>();
+    entry = bridge;
+  }
+  return bridge;
+}
+
+void WaveJoinBridge::addBuilder() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numBuilders_;
+}
+
+int32_t WaveJoinBridge::numBuilders() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numBuilders_;
+}
+
+GpuArena& WaveJoinBridge::arena() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!arena_) {
+    arena_ = std::make_unique<GpuArena>(
+        FLAGS_velox_wave_arena_unit_size, getAllocator(getDevice()));
+  }
+  return *arena_;
+}
+
+bool WaveJoinBridge::addInput(std::vector<WaveVectorPtr> input) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& batch : input) {
+    input_.push_back(std::move(batch));
+  }
+  return ++numFinished_ == numBuilders_;
+}
+
+void WaveJoinBridge::buildTable(
+    Stream& stream,
+    const RowTypePtr& type,
+    int32_t keyChannel) {
+  auto& arena = this->arena();
+  auto numColumns = type->size();
+  int64_t numRows = 0;
+  int32_t maxBlocks = 0;
+  std::vector<bool> nullable(numColumns);
+  for (auto& batch : input_) {
+    numRows += batch->size();
+    maxBlocks = std::max(maxBlocks, numBlocks(batch->size()));
+    for (auto i = 0; i < numColumns; ++i) {
+      nullable[i] = nullable[i] || batch->childAt(i).mayHaveNulls();
+    }
+  }
+  VELOX_CHECK_LE(numRows, std::numeric_limits<int32_t>::max());
+  auto numSlots = bits::nextPowerOfTwo(std::max<int64_t>(16, 2 * numRows));
+  auto numEntries = std::max<int64_t>(1, numRows);
+  auto* table =
+      arena.allocate<join::JoinTable>(1, tableBuffers_.emplace_back());
+  table->sizeMask = numSlots - 1;
+  table->slots =
+      arena.allocate<int32_t>(numSlots, tableBuffers_.emplace_back());
+  memset(table->slots, 0xff, numSlots * sizeof(int32_t));
+  table->next =
+      arena.allocate<int32_t>(numEntries, tableBuffers_.emplace_back());
+  memset(table->next, 0xff, numEntries * sizeof(int32_t));
+  table->numRows = numRows;
+  table->numColumns = numColumns;
+  table->columns =
+      arena.allocate<Operand>(numColumns, tableBuffers_.emplace_back());
+  table->columnKinds = arena.allocate<PhysicalType::Kind>(
+      numColumns, tableBuffers_.emplace_back());
+  table->keyChannel = keyChannel;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& column =
+        columns_.emplace_back(WaveVector::create(type->childAt(i), arena));
+    column->resize(numEntries, nullable[i]);
+    column->toOperand(&table->columns[i]);
+    table->columnKinds[i] = fromCpuType(*type->childAt(i)).kind;
+  }
+
+  if (maxBlocks > 0) {
+    // Each thread block inserts its range of rows of all the batches.
+    std::vector<WaveBufferPtr> holders;
+    auto* instructions = arena.allocate<join::Instruction>(
+        input_.size(), holders.emplace_back());
+    int32_t firstRow = 0;
+    for (auto i = 0; i < input_.size(); ++i) {
+      instructions[i].opCode = join::OpCode::kInsertRows;
+      auto& insertRows = instructions[i]._.insertRows;
+      insertRows.table = table;
+      insertRows.inputs =
+          arena.allocate<Operand>(numColumns, holders.emplace_back());
+      for (auto j = 0; j < numColumns; ++j) {
+        input_[i]->childAt(j).toOperand(&insertRows.inputs[j]);
+      }
+      insertRows.firstRow = firstRow;
+      firstRow += input_[i]->size();
+    }
+    auto* programs = makePrograms(
+        arena, maxBlocks, input_.size(), instructions, holders.emplace_back());
+    auto* status = allocateStatus(arena, maxBlocks, holders.emplace_back());
+    join::call(stream, maxBlocks, programs, status);
+    stream.wait();
+  }
+  input_.clear();
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    table_ = table;
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+join::JoinTable* WaveJoinBridge::tableOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting hash table after join is aborted");
+  if (table_) {
+    return table_;
+  }
+  promises_.emplace_back("WaveJoinBridge::tableOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return nullptr;
+}
+
+HashJoinBuild::HashJoinBuild(
+    CompileState& state,
+    const core::HashJoinNode& node)
+    : WaveOperator(state, node.sources()[1]->outputType(), node.id()),
+      bridge_(WaveJoinBridge::get(state.driver().task()->taskId(), node.id())),
+      keyChannel_(exec::exprToChannel(
+          node.rightKeys()[0].get(),
+          node.sources()[1]->outputType())) {
+  bridge_->addBuilder();
+}
+
+HashJoinBuild::~HashJoinBuild() {
+  if (!finished_) {
+    // Unblocks the probe side if the build does not complete.
+    bridge_->cancel();
+  }
+}
+
+std::vector<WaveVectorPtr> HashJoinBuild::copyInput(Stream& stream) {
+  auto& arena = bridge_->arena();
+  auto numColumns = outputType_->size();
+  std::vector<WaveVectorPtr> copies;
+  std::vector<WaveBufferPtr> holders;
+  for (auto& batch : buffered_) {
+    auto size = batch->size();
+    if (size == 0) {
+      continue;
+    }
+    auto* instructions =
+        arena.allocate<join::Instruction>(numColumns, holders.emplace_back());
+    auto* operands =
+        arena.allocate<Operand>(2 * numColumns, holders.emplace_back());
+    std::vector<WaveVectorPtr> children;
+    for (auto i = 0; i < numColumns; ++i) {
+      auto& source = batch->childAt(i);
+      auto& child = children.emplace_back(
+          WaveVector::create(outputType_->childAt(i), arena));
+      child->resize(size, source.mayHaveNulls());
+      instructions[i].opCode = join::OpCode::kGather;
+      auto& gather = instructions[i]._.gather;
+      gather.source = &operands[2 * i];
+      gather.kind = fromCpuType(*outputType_->childAt(i)).kind;
+      gather.rows = nullptr;
+      gather.numRows = size;
+      gather.result = &operands[2 * i + 1];
+      source.toOperand(gather.source);
+      child->toOperand(gather.result);
+    }
+    auto blocks = numBlocks(size);
+    auto* programs = makePrograms(
+        arena, blocks, numColumns, instructions, holders.emplace_back());
+    auto* status = allocateStatus(arena, blocks, holders.emplace_back());
+    join::call(stream, blocks, programs, status);
+    copies.push_back(
+        std::make_unique<WaveVector>(outputType_, arena, std::move(children)));
+  }
+  stream.wait();
+  return copies;
+}
+
+void HashJoinBuild::flush(bool noMoreInput) {
+  if (!noMoreInput || finished_) {
+    return;
+  }
+  flushing_ = true;
+  SCOPE_EXIT {
+    flushing_ = false;
+  };
+  auto stream = WaveStream::streamFromReserve();
+  // With a single build operator, the table is built before this returns and
+  // the input can stay in the memory of the Driver.
+  auto input = bridge_->numBuilders() > 1 ? copyInput(*stream)
+                                          : std::move(buffered_);
+  buffered_.clear();
+  if (bridge_->addInput(std::move(input))) {
+    bridge_->buildTable(*stream, outputType_, keyChannel_);
+  }
+  WaveStream::releaseStream(std::move(stream));
+  finished_ = true;
+}
+
+int64_t HashJoinBuild::spill(GpuArena& arena) {
+  if (flushing_) {
+    return 0;
+  }
+  int64_t numBytes = 0;
+  for (auto& batch : buffered_) {
+    numBytes += batch->moveTo(arena);
+  }
+  return numBytes;
+}
+
+HashJoinProbe::HashJoinProbe(
+    CompileState& state,
+    const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      bridge_(WaveJoinBridge::get(state.driver().task()->taskId(), node.id())) {
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  keyChannel_ = exec::exprToChannel(node.leftKeys()[0].get(), probeType);
+  for (auto& name : outputType_->names()) {
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      outputChannels_.emplace_back(false, channel.value());
+    } else {
+      outputChannels_.emplace_back(true, buildType->getChildIdx(name));
+    }
+  }
+}
+
+HashJoinProbe::~HashJoinProbe() {
+  if (probeStream_) {
+    WaveStream::releaseStream(std::move(probeStream_));
+  }
+}
+
+void HashJoinProbe::finalize(CompileState& state) {
+  for (auto& name : outputType_->names()) {
+    auto* operand = defines(Value(state.toSubfield(name)));
+    VELOX_CHECK_NOT_NULL(operand);
+    outputColumnIds_.push_back(operand->id);
+  }
+}
+
+exec::BlockingReason HashJoinProbe::isBlocked(ContinueFuture* future) {
+  if (!table_) {
+    table_ = bridge_->tableOrFuture(future);
+  }
+  return table_ ? exec::BlockingReason::kNotBlocked
+                : exec::BlockingReason::kWaitForJoinBuild;
+}
+
+void HashJoinProbe::probe(WaveVector& input) {
+  numHits_ = 0;
+  auto size = input.size();
+  if (size == 0) {
+    return;
+  }
+  if (!probeStream_) {
+    probeStream_ = WaveStream::streamFromReserve();
+  }
+  std::vector<WaveBufferPtr> holders;
+  auto& key = input.childAt(keyChannel_);
+  auto* probeKey = arena_->allocate<Operand>(1, holders.emplace_back());
+  key.toOperand(probeKey);
+  auto* numHits = arena_->allocate<int32_t>(1, holders.emplace_back());
+  auto* instruction =
+      arena_->allocate<join::Instruction>(1, holders.emplace_back());
+  auto blocks = numBlocks(size);
+  auto* programs =
+      makePrograms(*arena_, blocks, 1, instruction, holders.emplace_back());
+  // Most joins are on a foreign key with at most one match per probe row. If
+  // there are more, the probe is repeated with space for all the matches.
+  int32_t maxHits = size;
+  for (;;) {
+    *numHits = 0;
+    instruction->opCode = join::OpCode::kProbeRows;
+    auto& probeRows = instruction->_.probeRows;
+    probeRows.table = table_;
+    probeRows.probeKey = probeKey;
+    probeRows.probeKeyKind = fromCpuType(*key.type()).kind;
+    probeRows.numHits = numHits;
+    probeRows.maxHits = maxHits;
+    probeRows.probeRows = arena_->allocate<int32_t>(maxHits, probeRows_);
+    probeRows.buildRows = arena_->allocate<int32_t>(maxHits, buildRows_);
+    auto* status = allocateStatus(*arena_, blocks, holders.emplace_back());
+    join::call(*probeStream_, blocks, programs, status);
+    probeStream_->wait();
+    if (*numHits <= maxHits) {
+      break;
+    }
+    maxHits = *numHits;
+  }
+  numHits_ = *numHits;
+}
+
+int32_t HashJoinProbe::canAdvance(WaveStream& /*stream*/) {
+  if (!table_ || finished_) {
+    return 0;
+  }
+  if (current_) {
+    return numHits_;
+  }
+  while (!buffered_.empty()) {
+    auto input = std::move(buffered_.front());
+    buffered_.pop_front();
+    probe(*input);
+    if (numHits_ > 0) {
+      current_ = std::move(input);
+      return numHits_;
+    }
+  }
+  if (noMoreInput_) {
+    finished_ = true;
+  }
+  return 0;
+}
+
+void HashJoinProbe::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK_NOT_NULL(current_);
+  VELOX_CHECK_EQ(maxRows, numHits_);
+  auto numColumns = outputType_->size();
+  auto exec = std::make_unique<Executable>();
+  auto blocks = numBlocks(maxRows);
+  auto* instructions = arena_->allocate<join::Instruction>(
+      numColumns, exec->deviceData.emplace_back());
+  auto* programs = makePrograms(
+      *arena_,
+      blocks,
+      numColumns,
+      instructions,
+      exec->deviceData.emplace_back());
+  auto* rowStatus =
+      allocateStatus(*arena_, blocks, exec->deviceData.emplace_back());
+  for (auto i = 0; i < blocks; ++i) {
+    rowStatus[i].numRows =
+        i == blocks - 1 ? maxRows - kBlockSize * i : kBlockSize;
+  }
+  auto* probeOperands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  exec->output.resize(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    auto [isBuild, channel] = outputChannels_[i];
+    instructions[i].opCode = join::OpCode::kGather;
+    auto& gather = instructions[i]._.gather;
+    bool nullable;
+    if (isBuild) {
+      gather.source = &table_->columns[channel];
+      gather.rows = buildRows_->as<int32_t>();
+      nullable = gather.source->nulls != nullptr;
+    } else {
+      auto& source = current_->childAt(channel);
+      source.toOperand(&probeOperands[i]);
+      gather.source = &probeOperands[i];
+      gather.rows = probeRows_->as<int32_t>();
+      nullable = source.mayHaveNulls();
+    }
+    gather.kind = fromCpuType(*outputType_->childAt(i)).kind;
+    gather.numRows = maxRows;
+    auto ordinal = outputIds_.ordinal(outputColumnIds_[i]);
+    gather.result = &exec->operands[ordinal];
+    auto column = WaveVector::create(outputType_->childAt(i), *arena_);
+    column->resize(maxRows, nullable);
+    column->toOperand(gather.result);
+    exec->output[ordinal] = std::move(column);
+  }
+  // The matches and the probe input must stay live until the gather is done.
+  exec->deviceData.push_back(std::move(probeRows_));
+  exec->deviceData.push_back(std::move(buildRows_));
+  exec->intermediates.push_back(std::move(current_));
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto control = std::make_unique<LaunchControl>(id_, maxRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        join::call(*stream, blocks, programs, rowStatus);
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  if (buffered_.empty() && noMoreInput_) {
+    finished_ = true;
+  }
+}
+
+} // namespace facebook::velox::wave
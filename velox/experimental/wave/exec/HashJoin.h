@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/JoinBridge.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Returns true if 'node' can run on Wave. This is an inner join without a
+/// filter on a single INTEGER or BIGINT key where the build side columns and
+/// the output columns are of fixed width types.
+bool isSupportedJoin(const core::HashJoinNode& node);
+
+/// Hands over the device side hash table of a join from the HashJoinBuild to
+/// the HashJoinProbe WaveOperators of a Task. The table and the build side
+/// rows are in a GpuArena owned by 'this', so that the table outlives the
+/// build Drivers. There is one bridge per Task and join node, shared by
+/// its build and probe operators.
+class WaveJoinBridge : public exec::JoinBridge {
+ public:
+  /// Returns the bridge of the join 'planNodeId' in the Task 'taskId'. The
+  /// first caller creates it.
+  static std::shared_ptr<WaveJoinBridge> get(
+      const std::string& taskId,
+      const core::PlanNodeId& planNodeId);
+
+  /// Called by each build operator at construction.
+  void addBuilder();
+
+  int32_t numBuilders();
+
+  GpuArena& arena();
+
+  /// Called by each build operator on no more input with its input copied to
+  /// arena() if there are many build operators. Returns true for the last
+  /// build operator, which then calls buildTable() with all the input.
+  bool addInput(std::vector<WaveVectorPtr> input);
+
+  /// Builds the table from the input of all build operators and unblocks the
+  /// probe operators. 'type' is the build side input type and 'keyChannel'
+  /// its key column.
+  void buildTable(Stream& stream, const RowTypePtr& type, int32_t keyChannel);
+
+  /// Returns the table, or nullptr and sets 'future' if the table is not
+  /// built yet.
+  join::JoinTable* tableOrFuture(ContinueFuture* future);
+
+ private:
+  int32_t numBuilders_{0};
+  int32_t numFinished_{0};
+
+  // Declared before the buffers from it so that it is destroyed after them.
+  std::unique_ptr<GpuArena> arena_;
+
+  // Build side input of all the build operators.
+  std::vector<WaveVectorPtr> input_;
+
+  // The table and the buffers backing it.
+  join::JoinTable* table_{nullptr};
+  std::vector<WaveBufferPtr> tableBuffers_;
+  std::vector<WaveVectorPtr> columns_;
+};
+
+/// Build side of a hash join. Collects the build side input and makes the
+/// hash table when there is no more input. Produces no output.
+class HashJoinBuild : public WaveOperator {
+ public:
+  HashJoinBuild(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashJoinBuild() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!finished_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int64_t spill(GpuArena& arena) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override {
+    VELOX_UNREACHABLE();
+  }
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return 0;
+  }
+
+  std::string toString() const override {
+    return "HashJoinBuild";
+  }
+
+ private:
+  // Copies 'buffered_' to the arena of 'bridge_'.
+  std::vector<WaveVectorPtr> copyInput(Stream& stream);
+
+  std::shared_ptr<WaveJoinBridge> bridge_;
+  int32_t keyChannel_;
+  std::vector<WaveVectorPtr> buffered_;
+
+  // True while 'buffered_' is made into the table. Kernels may read it and
+  // it must not be spilled.
+  bool flushing_{false};
+
+  bool finished_{false};
+};
+
+/// Probe side of a hash join. Waits for the table of the build side and
+/// looks up the probe side input one batch at a time. The output has the
+/// probe and build side columns of each match.
+class HashJoinProbe : public WaveOperator {
+ public:
+  HashJoinProbe(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashJoinProbe() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override {
+    noMoreInput_ |= noMoreInput;
+  }
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return numHits_;
+  }
+
+  void finalize(CompileState& state) override;
+
+  std::string toString() const override {
+    return "HashJoinProbe";
+  }
+
+ private:
+  // Looks up the rows of 'input' in the table. Sets 'probeRows_',
+  // 'buildRows_' and 'numHits_' to the matches.
+  void probe(WaveVector& input);
+
+  GpuArena* arena_;
+  std::shared_ptr<WaveJoinBridge> bridge_;
+  join::JoinTable* table_{nullptr};
+  int32_t keyChannel_;
+
+  // For each output column, true if from the build side, and the channel in
+  // the probe input or in the table.
+  std::vector<std::pair<bool, column_index_t>> outputChannels_;
+
+  // The output operand of each output column.
+  std::vector<OperandId> outputColumnIds_;
+
+  std::deque<WaveVectorPtr> buffered_;
+
+  // The input that 'probeRows_' and 'buildRows_' refer to.
+  WaveVectorPtr current_;
+  WaveBufferPtr probeRows_;
+  WaveBufferPtr buildRows_;
+  int32_t numHits_{0};
+
+  std::unique_ptr<Stream> probeStream_;
+  bool noMoreInput_{false};
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Hash.h"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+#ifdef NDEBUG
+#define LOG_TYPE_DISPATCH_ERROR(_kind)
+#else
+#define LOG_TYPE_DISPATCH_ERROR(_kind) \
+  printf("%s:%d: Unsupported type %d\n", __FILE__, __LINE__, _kind)
+#endif
+
+#define VALUE_TYPE_DISPATCH(_func, _kindExpr, ...) \
+  [&]() {                                          \
+    auto _kind = (_kindExpr);                      \
+    switch (_kind) {                               \
+      case PhysicalType::kInt8:                    \
+        return _func<int8_t>(__VA_ARGS__);         \
+      case PhysicalType::kInt16:                   \
+        return _func<int16_t>(__VA_ARGS__);        \
+      case PhysicalType::kInt32:                   \
+        return _func<int32_t>(__VA_ARGS__);        \
+      case PhysicalType::kInt64:                   \
+        return _func<int64_t>(__VA_ARGS__);        \
+      case PhysicalType::kFloat32:                 \
+        return _func<float>(__VA_ARGS__);          \
+      case PhysicalType::kFloat64:                 \
+        return _func<double>(__VA_ARGS__);         \
+      default:                                     \
+        LOG_TYPE_DISPATCH_ERROR(_kind);            \
+        return ErrorCode::kError;                  \
+    };                                             \
+  }()
+
+namespace facebook::velox::wave::join {
+
+namespace {
+
+__device__ inline int32_t operandIndex(const Operand* op, int32_t row) {
+  if (auto indicesInOp = op->indices) {
+    if (auto indices = indicesInOp[row / kBlockSize]) {
+      return indices[row % kBlockSize];
+    }
+    return row;
+  }
+  return row & op->indexMask;
+}
+
+template <typename T>
+__device__ ErrorCode
+copyValue(const Operand* source, int32_t row, Operand* result, int32_t i) {
+  auto index = operandIndex(source, row);
+  if (source->nulls && source->nulls[index] == kNull) {
+    result->nulls[i] = kNull;
+    return ErrorCode::kOk;
+  }
+  if (result->nulls) {
+    result->nulls[i] = kNotNull;
+  }
+  reinterpret_cast<T*>(result->base)[i] =
+      reinterpret_cast<const T*>(source->base)[index];
+  return ErrorCode::kOk;
+}
+
+// Sets 'key' to row 'row' of 'op' widened to 64 bits. Returns false if the
+// key is null.
+__device__ inline bool loadKey(
+    const Operand* op,
+    PhysicalType::Kind kind,
+    int32_t row,
+    int64_t& key) {
+  auto index = operandIndex(op, row);
+  if (op->nulls && op->nulls[index] == kNull) {
+    return false;
+  }
+  if (kind == PhysicalType::kInt32) {
+    key = reinterpret_cast<const int32_t*>(op->base)[index];
+  } else {
+    key = reinterpret_cast<const int64_t*>(op->base)[index];
+  }
+  return true;
+}
+
+__device__ inline uint32_t hashKey(int64_t key) {
+  return Hasher<int64_t, uint32_t>()(key);
+}
+
+__device__ ErrorCode run(int32_t base, InsertRows* insertRows) {
+  auto* table = insertRows->table;
+  int32_t i = base + threadIdx.x;
+  if (i >= insertRows->inputs[table->keyChannel].size) {
+    return ErrorCode::kOk;
+  }
+  auto row = insertRows->firstRow + i;
+  for (auto column = 0; column < table->numColumns; ++column) {
+    auto ec = VALUE_TYPE_DISPATCH(
+        copyValue,
+        table->columnKinds[column],
+        &insertRows->inputs[column],
+        i,
+        &table->columns[column],
+        row);
+    if (ec != ErrorCode::kOk) {
+      return ec;
+    }
+  }
+  auto* keys = &table->columns[table->keyChannel];
+  auto keyKind = table->columnKinds[table->keyChannel];
+  int64_t key;
+  if (!loadKey(keys, keyKind, row, key)) {
+    // A null key matches nothing in an inner join.
+    return ErrorCode::kOk;
+  }
+  // The key must be visible to threads that find 'row' in a slot.
+  __threadfence();
+  for (auto slot = hashKey(key) & table->sizeMask;;
+       slot = (slot + 1) & table->sizeMask) {
+    auto head = atomicCAS(&table->slots[slot], -1, row);
+    if (head == -1) {
+      return ErrorCode::kOk;
+    }
+    int64_t headKey;
+    loadKey(keys, keyKind, head, headKey);
+    if (headKey == key) {
+      table->next[row] = atomicExch(&table->next[head], row);
+      return ErrorCode::kOk;
+    }
+  }
+}
+
+__device__ ErrorCode run(int32_t base, ProbeRows* probeRows) {
+  auto* table = probeRows->table;
+  int32_t i = base + threadIdx.x;
+  if (i >= probeRows->probeKey->size) {
+    return ErrorCode::kOk;
+  }
+  int64_t key;
+  if (!loadKey(probeRows->probeKey, probeRows->probeKeyKind, i, key)) {
+    return ErrorCode::kOk;
+  }
+  auto* keys = &table->columns[table->keyChannel];
+  auto keyKind = table->columnKinds[table->keyChannel];
+  for (auto slot = hashKey(key) & table->sizeMask;;
+       slot = (slot + 1) & table->sizeMask) {
+    auto row = table->slots[slot];
+    if (row == -1) {
+      return ErrorCode::kOk;
+    }
+    int64_t rowKey;
+    loadKey(keys, keyKind, row, rowKey);
+    if (rowKey != key) {
+      continue;
+    }
+    for (; row != -1; row = table->next[row]) {
+      auto hit = atomicAdd(probeRows->numHits, 1);
+      if (hit < probeRows->maxHits) {
+        probeRows->probeRows[hit] = i;
+        probeRows->buildRows[hit] = row;
+      }
+    }
+    return ErrorCode::kOk;
+  }
+}
+
+__device__ ErrorCode run(int32_t base, Gather* gather) {
+  int32_t i = base + threadIdx.x;
+  if (i >= gather->numRows) {
+    return ErrorCode::kOk;
+  }
+  return VALUE_TYPE_DISPATCH(
+      copyValue,
+      gather->kind,
+      gather->source,
+      gather->rows ? gather->rows[i] : i,
+      gather->result,
+      i);
+}
+
+__global__ void runPrograms(
+    ThreadBlockProgram* programs,
+    BlockStatus* blockStatusArray) {
+  int32_t base = blockDim.x * blockIdx.x;
+  auto& status = blockStatusArray[blockIdx.x];
+  auto& program = programs[blockIdx.x];
+  for (auto i = 0; i < program.numInstructions; ++i) {
+    if (status.errors[threadIdx.x] != ErrorCode::kOk) {
+      break;
+    }
+    auto& instruction = program.instructions[i];
+    switch (instruction.opCode) {
+      case OpCode::kInsertRows:
+        status.errors[threadIdx.x] = run(base, &instruction._.insertRows);
+        break;
+      case OpCode::kProbeRows:
+        status.errors[threadIdx.x] = run(base, &instruction._.probeRows);
+        break;
+      case OpCode::kGather:
+        status.errors[threadIdx.x] = run(base, &instruction._.gather);
+        break;
+      default:
+#ifndef NDEBUG
+        printf(
+            "%s:%d: Unsupported OpCode %d\n",
+            __FILE__,
+            __LINE__,
+            instruction.opCode);
+#endif
+        status.errors[threadIdx.x] = ErrorCode::kError;
+    }
+  }
+  assert(status.errors[threadIdx.x] == ErrorCode::kOk);
+}
+
+} // namespace
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    BlockStatus* status) {
+  runPrograms<<<numBlocks, kBlockSize, 0, stream.stream()->stream>>>(
+      programs, status);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::join
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/exec/ErrorCode.h"
+
+namespace facebook::velox::wave::join {
+
+/// Device side hash table of an inner equi-join on a single integer key. The
+/// build side rows are numbered from 0 and their columns are stored in
+/// 'columns'. 'slots' is open addressed with linear probing. Each occupied
+/// slot has the first build row with a key, the other rows with the same key
+/// are chained through 'next'.
+struct JoinTable {
+  // Number of slots - 1. The number of slots is a power of 2.
+  int32_t sizeMask;
+
+  // Build row of the first entry of the slot, -1 if the slot is empty.
+  int32_t* slots;
+
+  // Next build row with the same key, -1 at the end of the chain.
+  int32_t* next;
+
+  // Number of build rows.
+  int32_t numRows;
+
+  // Build side columns, one operand over all the build rows per column.
+  int32_t numColumns;
+  Operand* columns;
+  PhysicalType::Kind* columnKinds;
+
+  // Index of the key in 'columns'. The key is kInt32 or kInt64.
+  int32_t keyChannel;
+};
+
+/// Copies a batch of build side input to the rows of 'table' starting at
+/// 'firstRow' and adds the rows with a non-null key to the table.
+struct InsertRows {
+  JoinTable* table;
+  Operand* inputs;
+  int32_t firstRow;
+};
+
+/// Looks up each row of 'probeKey' in 'table'. For each match, increments
+/// 'numHits' and, if there is space, adds the probe row and the build row at
+/// the previous value of 'numHits' to 'probeRows' and 'buildRows'. If
+/// 'numHits' ends up above 'maxHits', the probe must be repeated with more
+/// space.
+struct ProbeRows {
+  JoinTable* table;
+  Operand* probeKey;
+  PhysicalType::Kind probeKeyKind;
+  int32_t* numHits;
+  int32_t maxHits;
+  int32_t* probeRows;
+  int32_t* buildRows;
+};
+
+/// Sets row 'i' of 'result' to row 'rows[i]' of 'source', or to row 'i' if
+/// 'rows' is nullptr.
+struct Gather {
+  Operand* source;
+  PhysicalType::Kind kind;
+  int32_t* rows;
+  int32_t numRows;
+  Operand* result;
+};
+
+enum class OpCode {
+  kInsertRows,
+  kProbeRows,
+  kGather,
+};
+
+struct Instruction {
+  OpCode opCode;
+  union {
+    InsertRows insertRows;
+    ProbeRows probeRows;
+    Gather gather;
+  } _;
+};
+
+struct ThreadBlockProgram {
+  int32_t numInstructions;
+  Instruction* instructions;
+};
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    BlockStatus* status);
+
+} // namespace facebook::velox::wave::join
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/OrderBy.h"
+
+#include <folly/ScopeGuard.h>
+#include <numeric>
+
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+
+DEFINE_int64(
+    wave_max_device_sort_bytes,
+    1LL << 30,
+    "Maximum memory for the keys, row numbers and temporary space of a sort "
+    "on device. Larger sorts decide the order on host");
+
+namespace facebook::velox::wave {
+
+namespace {
+
+// TopN sorts its buffered input when it has more than this many rows and
+// more than twice the limit.
+constexpr int32_t kMinTopNSortRows = 10'000;
+
+BlockStatus* allocateStatus(
+    GpuArena& arena,
+    int32_t numBlocks,
+    WaveBufferPtr& holder) {
+  auto* status = arena.allocate<BlockStatus>(numBlocks, holder);
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  return status;
+}
+
+// Returns 'numBlocks' programs that each run 'numInstructions' from
+// 'instructions'.
+sort::ThreadBlockProgram* makePrograms(
+    GpuArena& arena,
+    int32_t numBlocks,
+    int32_t numInstructions,
+    sort::Instruction* instructions,
+    WaveBufferPtr& holder) {
+  auto* programs = arena.allocate<sort::ThreadBlockProgram>(numBlocks, holder);
+  for (auto i = 0; i < numBlocks; ++i) {
+    programs[i].numInstructions = numInstructions;
+    programs[i].instructions = instructions;
+  }
+  return programs;
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return bits::roundUp(numRows, kBlockSize) / kBlockSize;
+}
+
+bool isWide(PhysicalType::Kind kind) {
+  return kind == PhysicalType::kInt64 || kind == PhysicalType::kFloat64;
+}
+
+template <TypeKind Kind>
+int32_t compareValues(WaveVector& column, int32_t left, int32_t right) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto leftValue = column.values<T>()[left];
+  auto rightValue = column.values<T>()[right];
+  if constexpr (std::is_floating_point_v<T>) {
+    // NaN is above all other values.
+    bool leftNaN = std::isnan(leftValue);
+    bool rightNaN = std::isnan(rightValue);
+    if (leftNaN || rightNaN) {
+      return static_cast<int32_t>(leftNaN) - static_cast<int32_t>(rightNaN);
+    }
+  }
+  return leftValue < rightValue ? -1 : leftValue == rightValue ? 0 : 1;
+}
+
+} // namespace
+
+bool isSupportedOrderBy(
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const RowTypePtr& type) {
+  for (auto& key : keys) {
+    if (!key->inputs().empty() || !type->containsChild(key->name())) {
+      return false;
+    }
+  }
+  for (auto& child : type->children()) {
+    if (!isFixedWidth(child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+OrderBy::OrderBy(CompileState& state, const core::OrderByNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()) {
+  initialize(node.sortingKeys(), node.sortingOrders());
+}
+
+OrderBy::OrderBy(CompileState& state, const core::TopNNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      limit_(node.count()) {
+  initialize(node.sortingKeys(), node.sortingOrders());
+}
+
+OrderBy::~OrderBy() {
+  if (sortStream_) {
+    WaveStream::releaseStream(std::move(sortStream_));
+  }
+}
+
+void OrderBy::initialize(
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const std::vector<core::SortOrder>& orders) {
+  VELOX_CHECK_EQ(keys.size(), orders.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    keys_.push_back({outputType_->getChildIdx(keys[i]->name()), orders[i]});
+  }
+}
+
+void OrderBy::finalize(CompileState& state) {
+  for (auto& name : outputType_->names()) {
+    auto* operand = defines(Value(state.toSubfield(name)));
+    VELOX_CHECK_NOT_NULL(operand);
+    outputColumnIds_.push_back(operand->id);
+  }
+}
+
+WaveVectorPtr OrderBy::copyRows(
+    const std::vector<WaveVectorPtr>& batches,
+    const int32_t* rows,
+    int32_t numRows) {
+  VELOX_CHECK(!rows || batches.size() == 1);
+  auto numColumns = outputType_->size();
+  std::vector<bool> nullable(numColumns);
+  int32_t maxBlocks = 0;
+  for (auto& batch : batches) {
+    auto size = rows ? numRows : batch->size();
+    maxBlocks = std::max(maxBlocks, numBlocks(size));
+    for (auto i = 0; i < numColumns; ++i) {
+      nullable[i] = nullable[i] || batch->childAt(i).mayHaveNulls();
+    }
+  }
+  std::vector<WaveVectorPtr> children;
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& child = children.emplace_back(
+        WaveVector::create(outputType_->childAt(i), *arena_));
+    child->resize(numRows, nullable[i]);
+  }
+  auto result =
+      std::make_unique<WaveVector>(outputType_, *arena_, std::move(children));
+  if (maxBlocks == 0) {
+    return result;
+  }
+  // Each thread block copies its range of rows of all the batches.
+  std::vector<WaveBufferPtr> holders;
+  auto numInstructions = numColumns * batches.size();
+  auto* instructions = arena_->allocate<sort::Instruction>(
+      numInstructions, holders.emplace_back());
+  auto* operands =
+      arena_->allocate<Operand>(2 * numInstructions, holders.emplace_back());
+  int32_t resultOffset = 0;
+  for (auto i = 0; i < batches.size(); ++i) {
+    for (auto j = 0; j < numColumns; ++j) {
+      auto index = i * numColumns + j;
+      instructions[index].opCode = sort::OpCode::kGather;
+      auto& gather = instructions[index]._.gather;
+      gather.source = &operands[2 * index];
+      gather.kind = fromCpuType(*outputType_->childAt(j)).kind;
+      gather.rows = const_cast<int32_t*>(rows);
+      gather.numRows = rows ? numRows : batches[i]->size();
+      gather.resultOffset = resultOffset;
+      gather.result = &operands[2 * index + 1];
+      batches[i]->childAt(j).toOperand(gather.source);
+      result->childAt(j).toOperand(gather.result);
+    }
+    resultOffset += batches[i]->size();
+  }
+  auto* programs = makePrograms(
+      *arena_,
+      maxBlocks,
+      numInstructions,
+      instructions,
+      holders.emplace_back());
+  auto* status = allocateStatus(*arena_, maxBlocks, holders.emplace_back());
+  sort::call(*sortStream_, maxBlocks, programs, status);
+  sortStream_->wait();
+  return result;
+}
+
+void OrderBy::sortBuffered() {
+  if (!sortStream_) {
+    sortStream_ = WaveStream::streamFromReserve();
+  }
+  VELOX_CHECK_LE(numBuffered_, std::numeric_limits<int32_t>::max());
+  sorting_ = true;
+  SCOPE_EXIT {
+    sorting_ = false;
+  };
+  input_ = copyRows(buffered_, nullptr, numBuffered_);
+  buffered_.clear();
+  numBuffered_ = 0;
+  auto numRows = input_->size();
+  int64_t deviceBytes = sort::sortPairsTempSize(numRows) +
+      numRows * 2 * (sizeof(uint64_t) + sizeof(int32_t));
+  if (deviceBytes > FLAGS_wave_max_device_sort_bytes) {
+    sortOnHost();
+  } else {
+    sortOnDevice();
+  }
+  numRows_ = std::min(numRows, limit_);
+}
+
+void OrderBy::sortOnDevice() {
+  auto numRows = input_->size();
+  std::vector<WaveBufferPtr> holders;
+  WaveBufferPtr rowBuffers[2];
+  int32_t* rows[2];
+  uint64_t* keys[2];
+  for (auto i = 0; i < 2; ++i) {
+    rows[i] = arena_->allocate<int32_t>(numRows, rowBuffers[i]);
+    keys[i] = arena_->allocate<uint64_t>(numRows, holders.emplace_back());
+  }
+  std::iota(rows[0], rows[0] + numRows, 0);
+  auto tempSize = sort::sortPairsTempSize(numRows);
+  auto* temp = arena_->allocate<char>(tempSize, holders.emplace_back());
+  auto blocks = numBlocks(numRows);
+  // The radix sort is stable, so sorting by each key from the last to the
+  // first orders the rows by all the keys.
+  for (int32_t i = keys_.size() - 1; i >= 0; --i) {
+    auto& column = input_->childAt(keys_[i].channel);
+    auto kind = fromCpuType(*column.type()).kind;
+    auto nullable = column.mayHaveNulls();
+    auto* key = arena_->allocate<Operand>(1, holders.emplace_back());
+    column.toOperand(key);
+    // A wide key with nulls takes a second pass over the null flags.
+    for (auto nullsOnly : {false, true}) {
+      if (nullsOnly && !(nullable && isWide(kind))) {
+        break;
+      }
+      auto* instruction =
+          arena_->allocate<sort::Instruction>(1, holders.emplace_back());
+      instruction->opCode = sort::OpCode::kNormalizeKey;
+      auto& normalize = instruction->_.normalizeKey;
+      normalize.key = key;
+      normalize.kind = kind;
+      normalize.rows = rows[0];
+      normalize.numRows = numRows;
+      normalize.descending = !keys_[i].order.isAscending();
+      normalize.nullsFirst = keys_[i].order.isNullsFirst();
+      normalize.nullsOnly = nullsOnly;
+      normalize.keys = keys[0];
+      auto* programs = makePrograms(
+          *arena_, blocks, 1, instruction, holders.emplace_back());
+      auto* status = allocateStatus(*arena_, blocks, holders.emplace_back());
+      sort::call(*sortStream_, blocks, programs, status);
+      auto numBits = nullsOnly ? 1 : isWide(kind) ? 64 : nullable ? 33 : 32;
+      sort::sortPairs(
+          *sortStream_, keys, rows, numRows, numBits, temp, tempSize);
+      std::swap(rows[0], rows[1]);
+      std::swap(rowBuffers[0], rowBuffers[1]);
+    }
+  }
+  sortStream_->wait();
+  rows_ = std::move(rowBuffers[0]);
+}
+
+void OrderBy::sortOnHost() {
+  auto numRows = input_->size();
+  auto* rows = arena_->allocate<int32_t>(numRows, rows_);
+  std::iota(rows, rows + numRows, 0);
+  auto compare = [&](int32_t left, int32_t right) {
+    for (auto& key : keys_) {
+      auto& column = input_->childAt(key.channel);
+      auto* nulls = column.nulls();
+      bool leftNull = nulls && nulls[left] == kNull;
+      bool rightNull = nulls && nulls[right] == kNull;
+      if (leftNull || rightNull) {
+        if (leftNull == rightNull) {
+          continue;
+        }
+        return leftNull == key.order.isNullsFirst();
+      }
+      auto result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          compareValues, column.type()->kind(), column, left, right);
+      if (result != 0) {
+        return key.order.isAscending() ? result < 0 : result > 0;
+      }
+    }
+    return false;
+  };
+  if (limit_ < numRows) {
+    std::partial_sort(rows, rows + limit_, rows + numRows, [&](auto l, auto r) {
+      // partial_sort is not stable. Ties are broken by row number.
+      return compare(l, r) || (!compare(r, l) && l < r);
+    });
+  } else {
+    std::stable_sort(rows, rows + numRows, compare);
+  }
+}
+
+void OrderBy::flush(bool noMoreInput) {
+  if (noMoreInput_) {
+    return;
+  }
+  if (!noMoreInput) {
+    if (limit_ != kNoLimit &&
+        numBuffered_ > std::max<int64_t>(kMinTopNSortRows, 2LL * limit_)) {
+      sortBuffered();
+      std::vector<WaveVectorPtr> sorted;
+      sorted.push_back(std::move(input_));
+      auto top = copyRows(sorted, rows_->as<int32_t>(), numRows_);
+      rows_.reset();
+      numRows_ = 0;
+      enqueue(std::move(top));
+    }
+    return;
+  }
+  noMoreInput_ = true;
+  sortBuffered();
+}
+
+int64_t OrderBy::spill(GpuArena& arena) {
+  if (sorting_) {
+    return 0;
+  }
+  int64_t numBytes = 0;
+  for (auto& batch : buffered_) {
+    numBytes += batch->moveTo(arena);
+  }
+  return numBytes;
+}
+
+int32_t OrderBy::canAdvance(WaveStream& /*stream*/) {
+  if (!noMoreInput_ || finished_) {
+    return 0;
+  }
+  if (numRows_ == 0) {
+    finished_ = true;
+  }
+  return numRows_;
+}
+
+void OrderBy::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK_EQ(maxRows, numRows_);
+  auto numColumns = outputType_->size();
+  auto exec = std::make_unique<Executable>();
+  auto blocks = numBlocks(maxRows);
+  auto* instructions = arena_->allocate<sort::Instruction>(
+      numColumns, exec->deviceData.emplace_back());
+  auto* programs = makePrograms(
+      *arena_,
+      blocks,
+      numColumns,
+      instructions,
+      exec->deviceData.emplace_back());
+  auto* rowStatus =
+      allocateStatus(*arena_, blocks, exec->deviceData.emplace_back());
+  for (auto i = 0; i < blocks; ++i) {
+    rowStatus[i].numRows =
+        i == blocks - 1 ? maxRows - kBlockSize * i : kBlockSize;
+  }
+  auto* inputOperands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  exec->output.resize(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& source = input_->childAt(i);
+    source.toOperand(&inputOperands[i]);
+    instructions[i].opCode = sort::OpCode::kGather;
+    auto& gather = instructions[i]._.gather;
+    gather.source = &inputOperands[i];
+    gather.kind = fromCpuType(*outputType_->childAt(i)).kind;
+    gather.rows = rows_->as<int32_t>();
+    gather.numRows = maxRows;
+    gather.resultOffset = 0;
+    auto ordinal = outputIds_.ordinal(outputColumnIds_[i]);
+    gather.result = &exec->operands[ordinal];
+    auto column = WaveVector::create(outputType_->childAt(i), *arena_);
+    column->resize(maxRows, source.mayHaveNulls());
+    column->toOperand(gather.result);
+    exec->output[ordinal] = std::move(column);
+  }
+  // The sorted rows and the input must stay live until the gather is done.
+  exec->deviceData.push_back(std::move(rows_));
+  exec->intermediates.push_back(std::move(input_));
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto control = std::make_unique<LaunchControl>(id_, maxRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        sort::call(*stream, blocks, programs, rowStatus);
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  finished_ = true;
+}
+
+} // namespace facebook::velox::wave
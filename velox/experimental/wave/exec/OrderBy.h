@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/OrderByInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Returns true if a sort on 'keys' of rows of 'type' can run on Wave. The
+/// keys and all the columns must be of fixed width types.
+bool isSupportedOrderBy(
+    const std::vector<core::FieldAccessTypedExprPtr>& keys,
+    const RowTypePtr& type);
+
+/// Sorts all its input on device and produces it in one batch. This is
+/// OrderBy or, with a limit, TopN. The rows are sorted with a stable radix
+/// sort of their row numbers, one pass per key from the last key to the
+/// first. TopN sorts the buffered input when it has many more rows than
+/// 'limit' and keeps the first 'limit' rows. If the memory for the sort
+/// would be over --wave_max_device_sort_bytes, the order is decided on
+/// host.
+class OrderBy : public WaveOperator {
+ public:
+  OrderBy(CompileState& state, const core::OrderByNode& node);
+
+  OrderBy(CompileState& state, const core::TopNNode& node);
+
+  ~OrderBy() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    numBuffered_ += input->size();
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int64_t spill(GpuArena& arena) override;
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return numRows_;
+  }
+
+  void finalize(CompileState& state) override;
+
+  std::string toString() const override {
+    return limit_ == kNoLimit ? "OrderBy" : fmt::format("TopN {}", limit_);
+  }
+
+ private:
+  static constexpr int32_t kNoLimit = std::numeric_limits<int32_t>::max();
+
+  struct SortKey {
+    column_index_t channel;
+    core::SortOrder order;
+  };
+
+  void initialize(
+      const std::vector<core::FieldAccessTypedExprPtr>& keys,
+      const std::vector<core::SortOrder>& orders);
+
+  // Returns the rows of 'batches' one after the other in flat vectors. If
+  // 'rows' is not nullptr, there is one batch and the result has its
+  // 'numRows' rows at 'rows'.
+  WaveVectorPtr copyRows(
+      const std::vector<WaveVectorPtr>& batches,
+      const int32_t* rows,
+      int32_t numRows);
+
+  // Makes 'input_' from 'buffered_' and sets 'rows_' and 'numRows_' to the
+  // first 'limit_' rows of 'input_' in sort order.
+  void sortBuffered();
+
+  void sortOnDevice();
+
+  void sortOnHost();
+
+  GpuArena* arena_;
+  std::vector<SortKey> keys_;
+  int32_t limit_{kNoLimit};
+
+  std::vector<WaveVectorPtr> buffered_;
+  int64_t numBuffered_{0};
+
+  // The sorted input and its row numbers in sort order.
+  WaveVectorPtr input_;
+  WaveBufferPtr rows_;
+  int32_t numRows_{0};
+
+  // The output operand of each column.
+  std::vector<OperandId> outputColumnIds_;
+
+  std::unique_ptr<Stream> sortStream_;
+
+  // True while 'buffered_' is being sorted. Kernels may read it and it must
+  // not be spilled.
+  bool sorting_{false};
+
+  bool noMoreInput_{false};
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/OrderByInstructions.h"
+
+#include <cub/device/device_radix_sort.cuh>
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+namespace facebook::velox::wave::sort {
+
+namespace {
+
+__device__ inline int32_t operandIndex(const Operand* op, int32_t row) {
+  if (auto indicesInOp = op->indices) {
+    if (auto indices = indicesInOp[row / kBlockSize]) {
+      return indices[row % kBlockSize];
+    }
+    return row;
+  }
+  return row & op->indexMask;
+}
+
+// Returns the bits of 'value' as an unsigned integer that sorts like
+// 'value'. NaNs sort above all other values.
+template <typename T, typename U>
+__device__ inline U floatBits(T value) {
+  if (isnan(value)) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  }
+  constexpr U kSign = U(1) << (8 * sizeof(U) - 1);
+  auto bits = *reinterpret_cast<U*>(&value);
+  return (bits & kSign) ? ~bits : bits | kSign;
+}
+
+template <typename T>
+__device__ inline uint32_t narrowBits(const void* base, int32_t index) {
+  int32_t value = reinterpret_cast<const T*>(base)[index];
+  return static_cast<uint32_t>(value) ^ 0x80000000U;
+}
+
+__device__ ErrorCode run(int32_t base, NormalizeKey* normalize) {
+  int32_t i = base + threadIdx.x;
+  if (i >= normalize->numRows) {
+    return ErrorCode::kOk;
+  }
+  auto* key = normalize->key;
+  auto index = operandIndex(key, normalize->rows[i]);
+  bool isNull = key->nulls && key->nulls[index] == kNull;
+  uint64_t nullFlag = isNull != normalize->nullsFirst;
+  if (normalize->nullsOnly) {
+    normalize->keys[i] = nullFlag;
+    return ErrorCode::kOk;
+  }
+  uint64_t bits = 0;
+  bool wide = false;
+  if (!isNull) {
+    switch (normalize->kind) {
+      case PhysicalType::kInt8:
+        bits = narrowBits<int8_t>(key->base, index);
+        break;
+      case PhysicalType::kInt16:
+        bits = narrowBits<int16_t>(key->base, index);
+        break;
+      case PhysicalType::kInt32:
+        bits = narrowBits<int32_t>(key->base, index);
+        break;
+      case PhysicalType::kFloat32:
+        bits = floatBits<float, uint32_t>(
+            reinterpret_cast<const float*>(key->base)[index]);
+        break;
+      case PhysicalType::kInt64:
+        bits = reinterpret_cast<const uint64_t*>(key->base)[index] ^
+            (1ULL << 63);
+        wide = true;
+        break;
+      case PhysicalType::kFloat64:
+        bits = floatBits<double, uint64_t>(
+            reinterpret_cast<const double*>(key->base)[index]);
+        wide = true;
+        break;
+      default:
+        return ErrorCode::kError;
+    }
+    if (normalize->descending) {
+      bits = wide ? ~bits : ~bits & 0xffffffffULL;
+    }
+  }
+  if (key->nulls && normalize->kind != PhysicalType::kInt64 &&
+      normalize->kind != PhysicalType::kFloat64) {
+    bits |= nullFlag << 32;
+  }
+  normalize->keys[i] = bits;
+  return ErrorCode::kOk;
+}
+
+template <typename T>
+__device__ ErrorCode
+copyValue(const Operand* source, int32_t row, Operand* result, int32_t i) {
+  auto index = operandIndex(source, row);
+  if (source->nulls && source->nulls[index] == kNull) {
+    result->nulls[i] = kNull;
+    return ErrorCode::kOk;
+  }
+  if (result->nulls) {
+    result->nulls[i] = kNotNull;
+  }
+  reinterpret_cast<T*>(result->base)[i] =
+      reinterpret_cast<const T*>(source->base)[index];
+  return ErrorCode::kOk;
+}
+
+__device__ ErrorCode run(int32_t base, Gather* gather) {
+  int32_t i = base + threadIdx.x;
+  if (i >= gather->numRows) {
+    return ErrorCode::kOk;
+  }
+  auto row = gather->rows ? gather->rows[i] : i;
+  auto resultRow = gather->resultOffset + i;
+  switch (gather->kind) {
+    case PhysicalType::kInt8:
+      return copyValue<int8_t>(gather->source, row, gather->result, resultRow);
+    case PhysicalType::kInt16:
+      return copyValue<int16_t>(
+          gather->source, row, gather->result, resultRow);
+    case PhysicalType::kInt32:
+      return copyValue<int32_t>(
+          gather->source, row, gather->result, resultRow);
+    case PhysicalType::kInt64:
+      return copyValue<int64_t>(
+          gather->source, row, gather->result, resultRow);
+    case PhysicalType::kFloat32:
+      return copyValue<float>(gather->source, row, gather->result, resultRow);
+    case PhysicalType::kFloat64:
+      return copyValue<double>(gather->source, row, gather->result, resultRow);
+    default:
+      return ErrorCode::kError;
+  }
+}
+
+__global__ void runPrograms(
+    ThreadBlockProgram* programs,
+    BlockStatus* blockStatusArray) {
+  int32_t base = blockDim.x * blockIdx.x;
+  auto& status = blockStatusArray[blockIdx.x];
+  auto& program = programs[blockIdx.x];
+  for (auto i = 0; i < program.numInstructions; ++i) {
+    if (status.errors[threadIdx.x] != ErrorCode::kOk) {
+      break;
+    }
+    auto& instruction = program.instructions[i];
+    switch (instruction.opCode) {
+      case OpCode::kNormalizeKey:
+        status.errors[threadIdx.x] = run(base, &instruction._.normalizeKey);
+        break;
+      case OpCode::kGather:
+        status.errors[threadIdx.x] = run(base, &instruction._.gather);
+        break;
+      default:
+#ifndef NDEBUG
+        printf(
+            "%s:%d: Unsupported OpCode %d\n",
+            __FILE__,
+            __LINE__,
+            instruction.opCode);
+#endif
+        status.errors[threadIdx.x] = ErrorCode::kError;
+    }
+  }
+  assert(status.errors[threadIdx.x] == ErrorCode::kOk);
+}
+
+} // namespace
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    BlockStatus* status) {
+  runPrograms<<<numBlocks, kBlockSize, 0, stream.stream()->stream>>>(
+      programs, status);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+size_t sortPairsTempSize(int32_t numRows) {
+  size_t size = 0;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      nullptr,
+      size,
+      static_cast<uint64_t*>(nullptr),
+      static_cast<uint64_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      numRows));
+  return size;
+}
+
+void sortPairs(
+    Stream& stream,
+    uint64_t* keys[2],
+    int32_t* rows[2],
+    int32_t numRows,
+    int32_t numBits,
+    void* temp,
+    size_t tempSize) {
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      temp,
+      tempSize,
+      keys[0],
+      keys[1],
+      rows[0],
+      rows[1],
+      numRows,
+      0,
+      numBits,
+      stream.stream()->stream));
+}
+
+} // namespace facebook::velox::wave::sort
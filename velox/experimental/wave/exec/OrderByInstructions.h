@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/exec/ErrorCode.h"
+
+namespace facebook::velox::wave::sort {
+
+/// Sets 'keys[i]' to an unsigned integer that sorts like row 'rows[i]' of
+/// 'key' in the order given by 'descending' and 'nullsFirst'. Keys of 4
+/// bytes or less take the low 32 bits and, if 'key' has nulls, the null
+/// flag is bit 32. Wider keys take all 64 bits and are 0 for nulls. If
+/// 'nullsOnly' is true, sets 'keys[i]' to only the null flag, which is
+/// used for a second pass over wide keys with nulls.
+struct NormalizeKey {
+  Operand* key;
+  PhysicalType::Kind kind;
+  int32_t* rows;
+  int32_t numRows;
+  bool descending;
+  bool nullsFirst;
+  bool nullsOnly;
+  uint64_t* keys;
+};
+
+/// Sets row 'resultOffset + i' of 'result' to row 'rows[i]' of 'source', or
+/// to row 'i' if 'rows' is nullptr.
+struct Gather {
+  Operand* source;
+  PhysicalType::Kind kind;
+  int32_t* rows;
+  int32_t numRows;
+  int32_t resultOffset;
+  Operand* result;
+};
+
+enum class OpCode {
+  kNormalizeKey,
+  kGather,
+};
+
+struct Instruction {
+  OpCode opCode;
+  union {
+    NormalizeKey normalizeKey;
+    Gather gather;
+  } _;
+};
+
+struct ThreadBlockProgram {
+  int32_t numInstructions;
+  Instruction* instructions;
+};
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    BlockStatus* status);
+
+/// Returns the size of the temporary memory for sortPairs() of 'numRows'.
+size_t sortPairsTempSize(int32_t numRows);
+
+/// Stable sorts 'rows' by the low 'numBits' of 'keys'. Sorts from
+/// 'keys[0]' and 'rows[0]' to 'keys[1]' and 'rows[1]'. 'temp' has at
+/// least sortPairsTempSize() bytes.
+void sortPairs(
+    Stream& stream,
+    uint64_t* keys[2],
+    int32_t* rows[2],
+    int32_t numRows,
+    int32_t numBits,
+    void* temp,
+    size_t tempSize);
+
+} // namespace facebook::velox::wave::sort
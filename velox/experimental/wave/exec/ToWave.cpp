@@ -16,7 +16,10 @@
 
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/exec/Task.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
+#include "velox/experimental/wave/exec/OrderBy.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -380,8 +383,22 @@ bool CompileState::reserveMemory() {
     return true;
   }
   auto* allocator = getAllocator(getDevice());
-  arena_ =
-      std::make_unique<GpuArena>(FLAGS_velox_wave_arena_unit_size, allocator);
+  auto* task = driver_.task().get();
+  auto pool =
+      DeviceMemoryPool::deviceRoot()
+          .queryPool(task->queryCtx()->queryId())
+          ->addLeaf(fmt::format(
+              "{}.{}", task->taskId(), driver_.driverCtx()->driverId));
+  try {
+    arena_ = std::make_unique<GpuArena>(
+        FLAGS_velox_wave_arena_unit_size, allocator, std::move(pool));
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kMemCapExceeded) {
+      throw;
+    }
+    // The device is full. The operators stay on CPU.
+    return false;
+  }
   return true;
 }
 
@@ -427,6 +444,45 @@ bool CompileState::addOperator(
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "HashBuild") {
+    // The build operator is the consumer of the build side pipeline and has
+    // no plan node of its own in it.
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.consumerNode.get());
+    if (!node || !isSupportedJoin(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashJoinBuild>(*this, *node));
+    outputType = node->sources()[1]->outputType();
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!isSupportedJoin(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashJoinProbe>(*this, *node));
+    outputType = node->outputType();
+  } else if (name == "OrderBy") {
+    auto* node = dynamic_cast<const core::OrderByNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!isSupportedOrderBy(node->sortingKeys(), node->outputType()) ||
+        !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<OrderBy>(*this, *node));
+    outputType = node->outputType();
+  } else if (name == "TopN") {
+    auto* node = dynamic_cast<const core::TopNNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!isSupportedOrderBy(node->sortingKeys(), node->outputType()) ||
+        !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<OrderBy>(*this, *node));
+    outputType = node->outputType();
   } else if (name == "TableScan") {
     if (!reserveMemory()) {
       return false;
@@ -485,13 +541,16 @@ bool CompileState::compile() {
       break;
     }
     ++nodeIndex;
+    // A non-streaming operator, e.g. a hash probe, makes all its output
+    // columns, including the ones the CPU operator projects through.
+    const bool streaming = operators_.back()->isStreaming();
     for (auto newIndex = previousNumOperators; newIndex < operators_.size();
          ++newIndex) {
       for (auto i = 0; i < outputType->size(); ++i) {
         auto& name = outputType->nameOf(i);
         Value value = Value(toSubfield(name));
         int32_t inputChannel;
-        if (isProjectedThrough(identity, i, inputChannel)) {
+        if (streaming && isProjectedThrough(identity, i, inputChannel)) {
           continue;
         }
         auto operand = operators_[newIndex]->defines(value);
@@ -508,10 +567,12 @@ bool CompileState::compile() {
         }
       }
     }
-    for (auto& [op, channel] : identityProjected) {
-      Value value(toSubfield(outputType->nameOf(channel)));
-      auto newOp = addIdentityProjections(op);
-      projectedTo_[value] = newOp;
+    if (streaming) {
+      for (auto& [op, channel] : identityProjected) {
+        Value value(toSubfield(outputType->nameOf(channel)));
+        auto newOp = addIdentityProjections(op);
+        projectedTo_[value] = newOp;
+      }
     }
     inputType = outputType;
   }
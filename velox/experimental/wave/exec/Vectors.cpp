@@ -18,6 +18,20 @@
 
 namespace facebook::velox::wave {
 
+bool isFixedWidth(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
 WaveVectorPtr allocateWaveVector(const BaseVector* source, GpuArena& arena) {
   auto result = WaveVector::create(source->type(), arena);
   result->resize(source->size(), source->mayHaveNulls());
@@ -27,6 +27,10 @@ void vectorsToDevice(
     const OperandSet& ids,
     WaveStream& stream);
 
+/// Returns true if 'type' is a fixed width type that the kernels that copy
+/// and compare rows support.
+bool isFixedWidth(const TypePtr& type);
+
 WaveVectorPtr allocateWaveVector(const BaseVector* source, GpuArena& arena);
 
 void ensureWaveVector(
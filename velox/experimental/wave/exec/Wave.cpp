@@ -33,11 +33,14 @@ void WaveStats::add(const WaveStats& other) {
   numPrograms += other.numPrograms;
   numThreads += other.numThreads;
   numSync += other.numSync;
+  numTransfers += other.numTransfers;
+  numOverlappedTransfers += other.numOverlappedTransfers;
   bytesToDevice += other.bytesToDevice;
   bytesToHost += other.bytesToHost;
   hostOnlyTime += other.hostOnlyTime;
   hostParallelTime += other.hostParallelTime;
   waitTime += other.waitTime;
+  stagingTime += other.stagingTime;
 }
 
 const SubfieldMap*& threadSubfieldMap() {
@@ -122,6 +125,9 @@ WaveStream::~WaveStream() {
   for (auto& stream : streams_) {
     releaseStream(std::move(stream));
   }
+  if (transferStream_) {
+    releaseStream(std::move(transferStream_));
+  }
   for (auto& event : allEvents_) {
     std::unique_ptr<Event> temp(event);
     releaseEvent(std::move(temp));
@@ -168,6 +174,13 @@ Stream* WaveStream::newStream() {
   return result;
 }
 
+Stream* WaveStream::transferStream() {
+  if (!transferStream_) {
+    transferStream_ = streamFromReserve();
+  }
+  return transferStream_.get();
+}
+
 // static
 void WaveStream::clearReusable() {
   streamsForReuse_.clear();
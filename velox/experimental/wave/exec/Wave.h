@@ -39,7 +39,7 @@ struct WaveTime {
   }
 
   WaveTime operator-(const WaveTime right) const {
-    return {right.micros - micros, right.clocks - clocks};
+    return {micros - right.micros, clocks - right.clocks};
   }
 
   WaveTime operator+(const WaveTime right) const {
@@ -52,7 +52,9 @@ struct WaveTime {
   std::string toString() const;
 };
 
+/// Adds the time from construction to destruction to 'accumulator'.
 class WaveTimer {
+ public:
   WaveTimer(WaveTime& accumulator)
       : accumulator_(accumulator), start_(WaveTime::now()) {}
   ~WaveTimer() {
@@ -90,6 +92,14 @@ struct WaveStats {
   /// Number of times the host syncs with device.
   int64_t numSync{0};
 
+  /// Number of host to device transfers of file data.
+  int64_t numTransfers{0};
+
+  /// Number of transfers that were queued while a kernel of the same
+  /// WaveStream was still running, so that the transfer and the kernel can
+  /// overlap.
+  int64_t numOverlappedTransfers{0};
+
   /// Time a host thread runs without activity on device, e.g. after a sync or
   /// before first launch.
   WaveTime hostOnlyTime;
@@ -97,6 +107,9 @@ struct WaveStats {
   WaveTime hostParallelTime;
   /// Time a host thread waits for device.
   WaveTime waitTime;
+  /// Time a host thread copies file data to pinned staging memory and queues
+  /// its transfer to device.
+  WaveTime stagingTime;
 
   void add(const WaveStats& other);
 };
@@ -466,6 +479,11 @@ class WaveStream {
     return arena_;
   }
 
+  /// Pinned host memory for staging transfers to device.
+  GpuArena& hostArena() {
+    return hostArena_;
+  }
+
   /// Sets nullability of a source column. This is runtime, since may depend on
   /// the actual presence of nulls in the source, e.g. file. Nullability
   /// defaults to nullable.
@@ -563,6 +581,11 @@ class WaveStream {
   /// 'this'.
   Stream* newStream();
 
+  /// Returns a stream for host to device transfers. The kernels that need
+  /// the data wait for the transfer with an event, so that the transfer for
+  /// the next kernel can run while the current kernel runs.
+  Stream* transferStream();
+
   static std::unique_ptr<Stream> streamFromReserve();
   static void releaseStream(std::unique_ptr<Stream>&& stream);
 
@@ -665,6 +688,10 @@ class WaveStream {
   // stream->userData().
   std::vector<std::unique_ptr<Stream>> streams_;
 
+  // Stream for transfers from host. Not in 'streams_' because no executable
+  // is launched on it.
+  std::unique_ptr<Stream> transferStream_;
+
   // The most recent event recorded on the pairwise corresponding element of
   // 'streams_'.
   std::vector<Event*> lastEvent_;
@@ -18,6 +18,13 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    wave_max_streams,
+    2,
+    "Maximum number of WaveStreams in flight per pipeline. With more than "
+    "one, the input of the next batch is transferred while the previous "
+    "batch is decoded");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -53,15 +60,37 @@ WaveDriver::WaveDriver(
     pipelines_.back().operators.push_back(std::move(op));
   }
   pipelines_.back().needStatus = true;
+  arena_->setReclaimer([this]() { spill(); });
+}
+
+void WaveDriver::spill() {
+  ++numSpills_;
+  for (auto& pipeline : pipelines_) {
+    for (auto& op : pipeline.operators) {
+      spilledBytes_ += op->spill(*hostArena_);
+    }
+  }
 }
 
 RowVectorPtr WaveDriver::getOutput() {
   VLOG(1) << "Getting output";
   for (;;) {
     startMore();
+    if (blockingFuture_.valid()) {
+      return nullptr;
+    }
     bool running = false;
     for (int i = pipelines_.size() - 1; i >= 0; --i) {
       if (pipelines_[i].streams.empty()) {
+        // A pipeline can finish without a last stream, e.g. when a hash probe
+        // has no matches in its last batches. The next pipeline must still be
+        // told that its input is complete.
+        if (i + 1 < pipelines_.size() && !pipelines_[i].noMoreOutput &&
+            pipelines_[i].operators[0]->isFinished()) {
+          pipelines_[i].noMoreOutput = true;
+          pipelines_[i + 1].operators[0]->flush(true);
+          running = true;
+        }
         continue;
       }
       auto& op = *pipelines_[i].operators.back();
@@ -96,8 +125,9 @@ RowVectorPtr WaveDriver::getOutput() {
         }
       }
       if (i + 1 < pipelines_.size()) {
-        pipelines_[i + 1].operators[0]->flush(
-            streams.empty() && pipelines_[i].operators[0]->isFinished());
+        pipelines_[i].noMoreOutput =
+            streams.empty() && pipelines_[i].operators[0]->isFinished();
+        pipelines_[i + 1].operators[0]->flush(pipelines_[i].noMoreOutput);
       }
       running = true;
     }
@@ -157,6 +187,9 @@ void WaveDriver::startMore() {
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
       return;
     }
+    if (pipelines_[i].streams.size() >= FLAGS_wave_max_streams) {
+      continue;
+    }
     auto stream =
         std::make_unique<WaveStream>(*arena_, *hostArena_, &operands());
     stream->setState(WaveStream::State::kHost);
@@ -234,6 +267,11 @@ void WaveDriver::updateStats() {
   lockedStats->addRuntimeStat(
       "wave.bytesToHost",
       RuntimeCounter(waveStats_.bytesToHost, RuntimeCounter::Unit::kBytes));
+  lockedStats->addRuntimeStat(
+      "wave.numTransfers", RuntimeCounter(waveStats_.numTransfers));
+  lockedStats->addRuntimeStat(
+      "wave.numOverlappedTransfers",
+      RuntimeCounter(waveStats_.numOverlappedTransfers));
   lockedStats->addRuntimeStat(
       "wave.hostOnlyTime",
       RuntimeCounter(
@@ -247,6 +285,26 @@ void WaveDriver::updateStats() {
       "wave.waitTime",
       RuntimeCounter(
           waveStats_.waitTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.stagingTime",
+      RuntimeCounter(
+          waveStats_.stagingTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat("wave.numSpills", RuntimeCounter(numSpills_));
+  lockedStats->addRuntimeStat(
+      "wave.spilledBytes",
+      RuntimeCounter(spilledBytes_, RuntimeCounter::Unit::kBytes));
+  if (auto* pool = arena_->pool()) {
+    auto poolStats = pool->stats();
+    lockedStats->addRuntimeStat(
+        "wave.deviceMemoryPeakBytes",
+        RuntimeCounter(poolStats.peakBytes, RuntimeCounter::Unit::kBytes));
+    lockedStats->addRuntimeStat(
+        "wave.deviceMemoryNumWaits", RuntimeCounter(poolStats.numWaits));
+    lockedStats->addRuntimeStat(
+        "wave.deviceMemoryWaitTime",
+        RuntimeCounter(
+            poolStats.waitMicros * 1000, RuntimeCounter::Unit::kNanos));
+  }
 }
 
 } // namespace facebook::velox::wave
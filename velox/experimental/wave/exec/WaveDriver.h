@@ -105,6 +105,10 @@ class WaveDriver : public exec::SourceOperator {
   // and there is space in the arena.
   void startMore();
 
+  // Moves buffered operator state to 'hostArena_' when the device is out of
+  // memory. Called from allocations in 'arena_'.
+  void spill();
+
   void updateStats();
 
   std::unique_ptr<GpuArena> arena_;
@@ -130,6 +134,9 @@ class WaveDriver : public exec::SourceOperator {
     /// returns vectors to host or if can produce multiple batches of output for
     /// one input.
     bool needStatus{false};
+    /// True if the first operator of the next Pipeline has been told that it
+    /// has all its input.
+    bool noMoreOutput{false};
   };
 
   std::vector<Pipeline> pipelines_;
@@ -145,6 +152,10 @@ class WaveDriver : public exec::SourceOperator {
   // Operands handed over by compilation.
   std::vector<std::unique_ptr<AbstractOperand>> operands_;
   WaveStats waveStats_;
+
+  // Number of calls to spill() and the bytes they moved to host.
+  int64_t numSpills_{0};
+  int64_t spilledBytes_{0};
 };
 
 } // namespace facebook::velox::wave
@@ -67,6 +67,13 @@ class WaveOperator {
     VELOX_FAIL("Override for blocking operator");
   }
 
+  /// Moves state that no kernel is using, e.g. buffered input, to 'arena',
+  /// which is pinned host memory. Called when the device is out of memory.
+  /// Returns the number of bytes moved.
+  virtual int64_t spill(GpuArena& /*arena*/) {
+    return 0;
+  }
+
   // If 'this' is a cardinality change (filter, join, unnest...),
   // returns the instruction where the projected through columns get
   // wrapped. Columns that need to be accessed through the change are
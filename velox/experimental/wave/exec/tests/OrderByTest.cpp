@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DECLARE_int64(wave_max_device_sort_bytes);
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class OrderByTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+
+  // Returns 'numBatches' copies of 'data' as one vector with the rows in the
+  // order given by 'lessThan' on rows of 'data'. Ties keep the input order.
+  // At most 'limit' rows are returned.
+  template <typename LessThan>
+  RowVectorPtr expectedOrder(
+      const RowVectorPtr& data,
+      int32_t numBatches,
+      LessThan lessThan,
+      int32_t limit = std::numeric_limits<int32_t>::max()) {
+    std::vector<vector_size_t> rows(numBatches * data->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+      return lessThan(left % data->size(), right % data->size());
+    });
+    rows.resize(std::min<size_t>(rows.size(), limit));
+    for (auto& row : rows) {
+      row %= data->size();
+    }
+    return std::dynamic_pointer_cast<RowVector>(BaseVector::wrapInDictionary(
+        nullptr, makeIndices(rows), rows.size(), data));
+  }
+
+  void assertOrder(
+      const core::PlanNodePtr& plan,
+      const RowVectorPtr& expected) {
+    auto result = AssertQueryBuilder(plan).copyResults(pool());
+    assertEqualVectors(expected, result);
+  }
+
+  // Rows with many duplicate and null keys.
+  RowVectorPtr makeData(int32_t size) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row % 7 - 3; }, nullEvery(11)),
+        makeFlatVector<double>(size, [](auto row) { return (row * 37) % 101; }),
+        makeFlatVector<int32_t>(
+            size, [](auto row) { return (row * 13) % 29; }, nullEvery(5)),
+    });
+  }
+
+  // Sorts by c0 descending with nulls last, then by c2 ascending with nulls
+  // first.
+  void testMultipleKeys() {
+    auto data = makeData(1'000);
+    auto plan = PlanBuilder()
+                    .values({data, data})
+                    .orderBy({"c0 DESC NULLS LAST", "c2 NULLS FIRST"}, false)
+                    .planNode();
+    auto c0 = data->childAt(0)->asFlatVector<int64_t>();
+    auto c2 = data->childAt(2)->asFlatVector<int32_t>();
+    auto expected = expectedOrder(data, 2, [&](auto left, auto right) {
+      if (c0->isNullAt(left) != c0->isNullAt(right)) {
+        return c0->isNullAt(right);
+      }
+      if (!c0->isNullAt(left) && c0->valueAt(left) != c0->valueAt(right)) {
+        return c0->valueAt(left) > c0->valueAt(right);
+      }
+      if (c2->isNullAt(left) != c2->isNullAt(right)) {
+        return c2->isNullAt(left);
+      }
+      return !c2->isNullAt(left) && c2->valueAt(left) < c2->valueAt(right);
+    });
+    assertOrder(plan, expected);
+  }
+};
+
+TEST_F(OrderByTest, multipleKeys) {
+  testMultipleKeys();
+}
+
+TEST_F(OrderByTest, sortOnHost) {
+  gflags::FlagSaver saver;
+  FLAGS_wave_max_device_sort_bytes = 0;
+  testMultipleKeys();
+}
+
+TEST_F(OrderByTest, empty) {
+  auto data = makeData(0);
+  auto plan = PlanBuilder().values({data}).orderBy({"c1"}, false).planNode();
+  AssertQueryBuilder(plan).assertEmptyResults();
+}
+
+// ORDER BY c1 DESC LIMIT 100 over enough batches that the buffered input is
+// sorted and cut to the limit several times.
+TEST_F(OrderByTest, topN) {
+  auto data = makeData(1'000);
+  std::vector<RowVectorPtr> batches(30, data);
+  auto plan =
+      PlanBuilder().values(batches).topN({"c1 DESC"}, 100, false).planNode();
+  auto c1 = data->childAt(1)->asFlatVector<double>();
+  auto expected = expectedOrder(
+      data,
+      batches.size(),
+      [&](auto left, auto right) {
+        return c1->valueAt(left) > c1->valueAt(right);
+      },
+      100);
+  assertOrder(plan, expected);
+}
+
+} // namespace
+} // namespace facebook::velox::wave
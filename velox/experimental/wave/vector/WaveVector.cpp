@@ -91,6 +91,38 @@ void WaveVector::resize(
   }
 }
 
+namespace {
+WaveBufferPtr moveBuffer(const WaveBufferPtr& buffer, GpuArena& arena) {
+  auto copy = arena.allocateBytes(buffer->capacity());
+  memcpy(copy->as<char>(), buffer->as<char>(), buffer->capacity());
+  return copy;
+}
+} // namespace
+
+int64_t WaveVector::moveTo(GpuArena& arena) {
+  if (arena_ == &arena) {
+    return 0;
+  }
+  int64_t numBytes = 0;
+  if (values_) {
+    auto copy = moveBuffer(values_, arena);
+    if (nulls_) {
+      nulls_ = copy->as<uint8_t>() + (nulls_ - values_->as<uint8_t>());
+    }
+    numBytes += values_->capacity();
+    values_ = std::move(copy);
+  }
+  if (indices_) {
+    numBytes += indices_->capacity();
+    indices_ = moveBuffer(indices_, arena);
+  }
+  for (auto& child : children_) {
+    numBytes += child->moveTo(arena);
+  }
+  arena_ = &arena;
+  return numBytes;
+}
+
 void WaveVector::toOperand(Operand* operand) const {
   operand->size = size_;
   operand->nulls = nulls_;
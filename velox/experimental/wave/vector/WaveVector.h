@@ -98,6 +98,12 @@ class WaveVector {
   // with a selected size.
   void clear();
 
+  /// Copies the buffers of 'this' and its children to memory from 'arena'
+  /// and frees the old ones. Used for moving data that is not in use by
+  /// kernels to pinned host memory, which kernels can still read. Returns
+  /// the number of bytes moved.
+  int64_t moveTo(GpuArena& arena);
+
   /// Starts computation for a kLazy state vector.
   void load();
 
@@ -22,6 +22,7 @@
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/StringWriter.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/FastStringConversion.h"
 #include "velox/type/Type.h"
 #include "velox/vector/SelectivityVector.h"
 
@@ -52,6 +53,36 @@ inline std::exception_ptr makeBadCastException(
       false));
 }
 
+/// Casts the rows of a flat VARCHAR 'input' that have one of the common shapes
+/// accepted by the parsers in FastStringConversion.h in a tight loop, without
+/// exceptions or per-row error handling. 'parse' is one of these parsers.
+/// Returns the rows left for the general cast, which handles all other inputs
+/// and reports their errors. These rows are kept in 'remainingRows'.
+template <typename T, typename TParse>
+const SelectivityVector* castFromStringFast(
+    const SelectivityVector& rows,
+    const BaseVector& input,
+    FlatVector<T>& result,
+    LocalSelectivityVector& remainingRows,
+    TParse parse) {
+  if (!input.isFlatEncoding()) {
+    return &rows;
+  }
+  const auto* rawInput =
+      input.asUnchecked<FlatVector<StringView>>()->rawValues();
+  auto* remaining = remainingRows.get(rows);
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto& view = rawInput[row];
+    T value;
+    if (parse(view.data(), view.size(), value)) {
+      result.set(row, value);
+      remaining->setValid(row, false);
+    }
+  });
+  remaining->updateBounds();
+  return remaining;
+}
+
 /// @brief Convert the unscaled value of a decimal to varchar and write to raw
 /// string buffer from start position.
 /// @tparam T The type of input value.
@@ -715,21 +746,44 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  // Integers and plain decimal numbers are parsed upfront. The parsers accept
+  // a subset of the inputs of every cast policy and give the same results.
+  const SelectivityVector* kernelRows = &rows;
+  LocalSelectivityVector remainingRows(context);
+  if constexpr (FromKind == TypeKind::VARCHAR) {
+    if constexpr (
+        ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+        ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT) {
+      kernelRows = castFromStringFast(
+          rows,
+          input,
+          *resultFlatVector,
+          remainingRows,
+          util::tryParseInteger<To>);
+    } else if constexpr (ToKind == TypeKind::DOUBLE) {
+      kernelRows = castFromStringFast(
+          rows, input, *resultFlatVector, remainingRows, util::tryParseDouble);
+    }
+    if (!kernelRows->hasSelections()) {
+      return;
+    }
+  }
+
   switch (hooks_->getPolicy()) {
     case LegacyCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case PrestoCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::PrestoCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case SparkCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *kernelRows, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::SparkCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
@@ -224,7 +224,12 @@ VectorPtr CastExpr::castToDate(
   switch (fromType->kind()) {
     case TypeKind::VARCHAR: {
       auto* inputVector = input.as<SimpleVector<StringView>>();
-      applyToSelectedNoThrowLocal(context, rows, castResult, [&](int row) {
+      // Dates in the YYYY-MM-DD format are parsed upfront. All cast hooks
+      // accept them.
+      LocalSelectivityVector remainingRows(context);
+      const auto& otherRows = *castFromStringFast(
+          rows, input, *resultFlatVector, remainingRows, util::tryParseDate);
+      applyToSelectedNoThrowLocal(context, otherRows, castResult, [&](int row) {
         bool wrapException = true;
         try {
           const auto result =
@@ -131,7 +131,6 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
     if (evaluatesArgumentsOnNonIncreasingSelection()) {
       // Exclude loading rows that we know for sure will have a false result.
       for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
@@ -140,6 +139,10 @@ void ConjunctExpr::evalSpecialForm(
         }
       }
     }
+    // Loading fields referenced by more than one input is not timed. Whichever
+    // input runs first pays for it, so it is no cost of the input itself and
+    // would otherwise make the order flip between batches.
+    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
     inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
     if (context.errors()) {
       handleErrors = true;
@@ -178,22 +181,26 @@ void ConjunctExpr::evalSpecialForm(
   }
 }
 
+// Orders the inputs by the time they spend per dropped row, i.e. by their
+// measured cost per row divided by the fraction of rows they drop. A cheap
+// input that drops fewer rows can therefore go before an expensive input that
+// drops more.
 void ConjunctExpr::maybeReorderInputs() {
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
+    if (selectivity_[inputOrder_[i - 1]].costPerDroppedRow() >
+        selectivity_[inputOrder_[i]].costPerDroppedRow()) {
       reorder = true;
       break;
     }
   }
   if (reorder) {
-    std::sort(
+    std::stable_sort(
         inputOrder_.begin(),
         inputOrder_.end(),
         [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
+          return selectivity_[left].costPerDroppedRow() <
+              selectivity_[right].costPerDroppedRow();
         });
   }
 }
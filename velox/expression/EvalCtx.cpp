@@ -30,6 +30,9 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
       exprSet_(exprSet),
       row_(row),
       cacheEnabled_(execCtx->exprEvalCacheEnabled()),
+      sharedMemoEnabled_(
+          execCtx->queryCtx() &&
+          execCtx->queryCtx()->queryConfig().exprSharedMemoEnabled()),
       maxSharedSubexprResultsCached_(
           execCtx->queryCtx()
               ? execCtx->queryCtx()
@@ -57,6 +60,9 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
       exprSet_(nullptr),
       row_(nullptr),
       cacheEnabled_(execCtx->exprEvalCacheEnabled()),
+      sharedMemoEnabled_(
+          execCtx->queryCtx() &&
+          execCtx->queryCtx()->queryConfig().exprSharedMemoEnabled()),
       maxSharedSubexprResultsCached_(
           execCtx->queryCtx()
               ? execCtx->queryCtx()
@@ -512,6 +512,12 @@ class EvalCtx {
     return cacheEnabled_;
   }
 
+  /// Returns true if Expr::evalWithMemo may use the SharedExprMemo of the
+  /// query.
+  bool sharedMemoEnabled() const {
+    return sharedMemoEnabled_;
+  }
+
   /// Returns the maximum number of distinct inputs to cache results for in a
   /// given shared subexpression.
   uint32_t maxSharedSubexprResultsCached() const {
@@ -538,6 +544,7 @@ class EvalCtx {
   ExprSet* const exprSet_;
   const RowVector* row_;
   const bool cacheEnabled_;
+  const bool sharedMemoEnabled_;
   const uint32_t maxSharedSubexprResultsCached_;
   bool inputFlatNoNulls_;
 
@@ -31,6 +31,7 @@
 #include "velox/expression/FieldReference.h"
 #include "velox/expression/PeeledEncoding.h"
 #include "velox/expression/ScopedVarSetter.h"
+#include "velox/expression/SharedExprMemo.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/vector/SelectivityVector.h"
 #include "velox/vector/VectorSaver.h"
@@ -328,7 +329,7 @@ void mergeOrThrowArgumentErrors(
 }
 
 // Returns true if vector is a LazyVector that hasn't been loaded yet or
-// is not dictionary or constant encoded.
+// is not dictionary, sequence or constant encoded.
 bool isFlat(const BaseVector& vector) {
   auto encoding = vector.encoding();
   if (encoding == VectorEncoding::Simple::LAZY) {
@@ -340,6 +341,7 @@ bool isFlat(const BaseVector& vector) {
   }
   return !(
       encoding == VectorEncoding::Simple::DICTIONARY ||
+      encoding == VectorEncoding::Simple::SEQUENCE ||
       encoding == VectorEncoding::Simple::CONSTANT);
 }
 
@@ -1185,6 +1187,11 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, base);
 
+  if (context.sharedMemoEnabled() && SharedExprMemo::supportsType(*type())) {
+    evalWithSharedMemo(rows, context, base, result);
+    return;
+  }
+
   if (base.get() != baseOfDictionaryRawPtr_ ||
       baseOfDictionaryWeakPtr_.expired()) {
     baseOfDictionaryRepeats_ = 0;
@@ -1264,6 +1271,68 @@ void Expr::evalWithMemo(
   context.releaseVector(base);
 }
 
+namespace {
+// Returns a string that identifies 'expr' evaluated with the config of
+// 'context'. The config is included because the results of some functions
+// depend on session properties like the time zone.
+std::string makeSharedMemoFingerprint(const Expr& expr, EvalCtx& context) {
+  auto fingerprint = expr.toString();
+  if (auto* queryCtx = context.execCtx()->queryCtx()) {
+    const auto& configs = queryCtx->queryConfig().rawConfigs();
+    std::vector<std::pair<std::string, std::string>> sortedConfigs(
+        configs.begin(), configs.end());
+    std::sort(sortedConfigs.begin(), sortedConfigs.end());
+    for (const auto& [key, value] : sortedConfigs) {
+      fingerprint += fmt::format("|{}={}", key, value);
+    }
+  }
+  return fingerprint;
+}
+} // namespace
+
+void Expr::evalWithSharedMemo(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    const VectorPtr& base,
+    VectorPtr& result) {
+  if (sharedMemoFingerprint_.empty()) {
+    sharedMemoFingerprint_ = makeSharedMemoFingerprint(*this, context);
+  }
+  if (sharedMemo_ == nullptr) {
+    sharedMemo_ = SharedExprMemo::get(*context.execCtx()->queryCtx());
+  }
+  auto* memo = sharedMemo_.get();
+
+  LocalSelectivityVector uncachedHolder(context, rows);
+  auto uncached = uncachedHolder.get();
+  VELOX_DCHECK(uncached != nullptr);
+  if (auto entry = memo->find(sharedMemoFingerprint_, base)) {
+    LocalSelectivityVector cachedHolder(context, rows);
+    auto cached = cachedHolder.get();
+    VELOX_DCHECK(cached != nullptr);
+    cached->intersect(entry->rows);
+    if (cached->hasSelections()) {
+      context.ensureWritable(rows, type(), result);
+      result->copy(entry->values.get(), *cached, nullptr);
+    }
+    uncached->deselect(entry->rows);
+  }
+  if (!uncached->hasSelections()) {
+    ++stats_.numSharedMemoHits;
+    return;
+  }
+  ++stats_.numSharedMemoMisses;
+
+  // Preserve the rows copied from the memo, see evalWithMemo.
+  ScopedFinalSelectionSetter scopedFinalSelectionSetter(
+      context, &rows, uncached->countSelected() < rows.countSelected());
+  evalWithNulls(*uncached, context, result);
+  context.deselectErrors(*uncached);
+  if (uncached->hasSelections()) {
+    memo->insert(sharedMemoFingerprint_, base, *result, *uncached);
+  }
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1353,6 +1422,7 @@ inline bool isPeelable(VectorEncoding::Simple encoding) {
   switch (encoding) {
     case VectorEncoding::Simple::CONSTANT:
     case VectorEncoding::Simple::DICTIONARY:
+    case VectorEncoding::Simple::SEQUENCE:
       return true;
     default:
       return false;
@@ -1762,7 +1832,7 @@ void addStats(
   uniqueExprs.insert(&expr);
 
   // Do not aggregate empty stats.
-  if (expr.stats().numProcessedRows) {
+  if (expr.stats().numProcessedRows || expr.stats().numSharedMemoHits) {
     stats[expr.name()].add(expr.stats());
   }
 
@@ -1886,6 +1956,14 @@ void ExprSet::eval(
     clearSharedSubexprs();
   }
 
+  // New string buffers are carved from the arena, if any. A new batch reuses
+  // the chunks that the results of the previous batch no longer reference.
+  auto* arena = context.execCtx()->bufferArena();
+  if (arena != nullptr && initialize) {
+    arena->reset();
+  }
+  BufferArena::Scope arenaScope(arena);
+
   // Make sure LazyVectors, referenced by multiple expressions, are loaded
   // for all the "rows".
   //
@@ -1961,6 +2039,85 @@ std::unique_ptr<ExprSet> makeExprSetFromFlag(
   return std::make_unique<ExprSet>(std::move(source), execCtx);
 }
 
+namespace {
+template <TypeKind Kind>
+variant constantValue(const BaseVector& vector) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto value = vector.as<SimpleVector<T>>()->valueAt(0);
+  if constexpr (Kind == TypeKind::VARBINARY) {
+    return variant::binary(std::string(value));
+  } else if constexpr (Kind == TypeKind::VARCHAR) {
+    return variant(std::string(value));
+  } else {
+    return variant(value);
+  }
+}
+
+// Folds the constant subexpressions of 'expr' bottom up. A call or cast
+// whose inputs are all constant is compiled on its own. If the compiler
+// folded it to a scalar constant, the value replaces the call.
+core::TypedExprPtr foldConstantsRecursive(
+    const core::TypedExprPtr& expr,
+    core::ExecCtx* execCtx) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  const auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  if (call == nullptr && cast == nullptr) {
+    return expr;
+  }
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  bool changed = false;
+  bool allConstant = true;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(foldConstantsRecursive(input, execCtx));
+    changed |= inputs.back() != input;
+    allConstant &=
+        dynamic_cast<const core::ConstantTypedExpr*>(inputs.back().get()) !=
+        nullptr;
+  }
+  core::TypedExprPtr result = expr;
+  if (changed && call != nullptr) {
+    result = std::make_shared<core::CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  } else if (changed) {
+    result = std::make_shared<core::CastTypedExpr>(
+        expr->type(), std::move(inputs), cast->nullOnFailure());
+  }
+  if (!allConstant || !result->type()->isPrimitiveType()) {
+    return result;
+  }
+  ExprSet exprSet({result}, execCtx);
+  const auto* constant = exprSet.expr(0)->as<ConstantExpr>();
+  if (constant == nullptr) {
+    return result;
+  }
+  const auto& value = constant->value();
+  if (value->isNullAt(0)) {
+    return std::make_shared<core::ConstantTypedExpr>(
+        result->type(), variant::null(result->type()->kind()));
+  }
+  return std::make_shared<core::ConstantTypedExpr>(
+      result->type(),
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          constantValue, result->type()->kind(), *value));
+}
+} // namespace
+
+std::vector<core::TypedExprPtr> foldConstants(
+    const std::vector<core::TypedExprPtr>& source,
+    core::ExecCtx* execCtx) {
+  if (execCtx->queryCtx()->queryConfig().exprEvalSimplified() ||
+      FLAGS_force_eval_simplified) {
+    return source;
+  }
+  std::vector<core::TypedExprPtr> result;
+  result.reserve(source.size());
+  for (const auto& expr : source) {
+    result.push_back(foldConstantsRecursive(expr, execCtx));
+  }
+  return result;
+}
+
 std::string printExprWithStats(const exec::ExprSet& exprSet) {
   const auto& exprs = exprSet.exprs();
   std::unordered_map<const exec::Expr*, uint32_t> uniqueExprs;
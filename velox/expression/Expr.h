@@ -46,6 +46,7 @@ namespace facebook::velox::exec {
 
 class ExprSet;
 class FieldReference;
+class SharedExprMemo;
 class VectorFunction;
 
 struct ExprStats {
@@ -59,18 +60,31 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of batches over a dictionary base fully served from the
+  /// SharedExprMemo of the query.
+  uint64_t numSharedMemoHits{0};
+
+  /// Number of batches over a dictionary base for which at least some rows
+  /// were computed and added to the SharedExprMemo.
+  uint64_t numSharedMemoMisses{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numSharedMemoHits += other.numSharedMemoHits;
+    numSharedMemoMisses += other.numSharedMemoMisses;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numSharedMemoHits: {}, numSharedMemoMisses: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numSharedMemoHits,
+        numSharedMemoMisses);
   }
 };
 
@@ -428,6 +442,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Variant of evalWithMemo that memoizes the results over 'base' in the
+  // SharedExprMemo of the query.
+  void evalWithSharedMemo(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      const VectorPtr& base,
+      VectorPtr& result);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -638,6 +660,13 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // Identifies this expression and the query config it is evaluated with in
+  // the SharedExprMemo. Set on first use.
+  std::string sharedMemoFingerprint_;
+
+  // The SharedExprMemo of the query. Set on first use.
+  std::shared_ptr<SharedExprMemo> sharedMemo_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -789,6 +818,15 @@ std::unique_ptr<ExprSet> makeExprSetFromFlag(
     std::vector<core::TypedExprPtr>&& source,
     core::ExecCtx* execCtx);
 
+/// Returns 'source' with the constant subexpressions of scalar type replaced
+/// by their values, as ExprSet folds them at compilation. The result holds
+/// no vectors, so that the Drivers of a pipeline can share it and skip the
+/// folding when each compiles its own ExprSet. Returns 'source' as is if
+/// expressions are evaluated with ExprSetSimplified, which does not fold.
+std::vector<core::TypedExprPtr> foldConstants(
+    const std::vector<core::TypedExprPtr>& source,
+    core::ExecCtx* execCtx);
+
 /// Returns a string representation of the expression trees annotated with
 /// runtime statistics. Expected to be called after calling ExprSet::eval one or
 /// more times. If called before ExprSet::eval runtime statistics will be all
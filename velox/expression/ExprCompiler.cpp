@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -347,6 +348,19 @@ std::vector<VectorPtr> getConstantInputs(const std::vector<ExprPtr>& exprs) {
   return constants;
 }
 
+std::vector<TypedExprPtr> rewriteExpressionSet(
+    const std::vector<TypedExprPtr>& exprs) {
+  auto rewritten = exprs;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto next = rewrite(rewritten);
+    if (!next.empty()) {
+      VELOX_CHECK_EQ(next.size(), rewritten.size());
+      rewritten = std::move(next);
+    }
+  }
+  return rewritten;
+}
+
 core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   for (auto& rewrite : expressionRewrites()) {
     if (auto rewritten = rewrite(expr)) {
@@ -514,6 +528,9 @@ ExprPtr compileRewrittenExpression(
   auto folded = enableConstantFolding && !isConstantExpr
       ? tryFoldIfConstant(result, scope)
       : result;
+  if (config.codegenEnabled() && !folded->is<ConstantExpr>()) {
+    folded = FusedExpr::tryFuse(folded);
+  }
   scope->visited[expr.get()] = folded;
   return folded;
 }
@@ -585,11 +602,13 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  auto rewrittenSources = rewriteExpressionSet(sources);
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -546,4 +546,64 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
       "Unsupported expression for range filter: {}", expr->toString());
 }
 
+namespace {
+
+void flattenDisjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::ITypedExpr*>& disjuncts) {
+  auto* call = asCall(expr.get());
+  if (call && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenDisjuncts(input, disjuncts);
+    }
+    return;
+  }
+  disjuncts.push_back(expr.get());
+}
+
+} // namespace
+
+std::vector<std::pair<common::Subfield, std::unique_ptr<common::Filter>>>
+toDisjunctiveSubfieldFilters(
+    const core::TypedExprPtr& expr,
+    core::ExpressionEvaluator* evaluator) {
+  std::vector<const core::ITypedExpr*> disjuncts;
+  flattenDisjuncts(expr, disjuncts);
+  std::vector<std::pair<common::Subfield, std::unique_ptr<common::Filter>>>
+      filters;
+  if (disjuncts.size() < 2) {
+    return filters;
+  }
+  for (const auto* disjunct : disjuncts) {
+    auto* call = asCall(disjunct);
+    if (!call) {
+      return {};
+    }
+    common::Subfield subfield;
+    std::unique_ptr<common::Filter> filter;
+    if (call->name() == "not") {
+      if (auto* inner = asCall(call->inputs()[0].get())) {
+        filter = leafCallToSubfieldFilter(*inner, subfield, evaluator, true);
+      }
+    } else {
+      filter = leafCallToSubfieldFilter(*call, subfield, evaluator, false);
+    }
+    if (!filter) {
+      return {};
+    }
+    auto it = std::find_if(filters.begin(), filters.end(), [&](auto& other) {
+      return other.first == subfield;
+    });
+    if (it == filters.end()) {
+      filters.emplace_back(std::move(subfield), std::move(filter));
+    } else {
+      it->second = makeOrFilter(std::move(it->second), std::move(filter));
+    }
+  }
+  if (filters.size() < 2) {
+    return {};
+  }
+  return filters;
+}
+
 } // namespace facebook::velox::exec
@@ -375,6 +375,16 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
     const core::TypedExprPtr& expr,
     core::ExpressionEvaluator*);
 
+/// Converts a disjunction of leaf calls on more than one subfield, e.g.
+/// 'a = 1 OR b > 2', to a filter per subfield. A row passes the disjunction
+/// if it passes at least one of the filters. Disjuncts on the same subfield
+/// are combined into one filter. Returns an empty vector if 'expr' is not
+/// such a disjunction or if any of the disjuncts cannot be converted.
+std::vector<std::pair<common::Subfield, std::unique_ptr<common::Filter>>>
+toDisjunctiveSubfieldFilters(
+    const core::TypedExprPtr& expr,
+    core::ExpressionEvaluator*);
+
 /// Convert a leaf call expression (no conjunction like AND/OR) to subfield and
 /// filter.  Return nullptr if not supported for pushdown.  This is needed
 /// because this conversion is frequently applied when extracting filters from
@@ -0,0 +1,641 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+enum class FusedOp : uint8_t {
+  kField,
+  kConstant,
+  kPlus,
+  kMinus,
+  kMultiply,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+// Maximum number of programs in the process-wide cache. Programs for trees
+// seen after the cache is full are not shared.
+constexpr size_t kMaxCachedPrograms = 10'000;
+
+std::optional<FusedOp> toFusedOp(const std::string& name) {
+  static const folly::F14FastMap<std::string, FusedOp> kOps = {
+      {"plus", FusedOp::kPlus},
+      {"minus", FusedOp::kMinus},
+      {"multiply", FusedOp::kMultiply},
+      {"eq", FusedOp::kEq},
+      {"neq", FusedOp::kNeq},
+      {"lt", FusedOp::kLt},
+      {"lte", FusedOp::kLte},
+      {"gt", FusedOp::kGt},
+      {"gte", FusedOp::kGte},
+  };
+  auto it = kOps.find(name);
+  if (it == kOps.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+bool isComparison(FusedOp op) {
+  return op >= FusedOp::kEq;
+}
+
+// Returns the kind of 'type' if values of 'type' can be fused. Logical types
+// like DATE or DECIMAL are not equivalent to their physical types and are not
+// fused.
+std::optional<TypeKind> fusedKind(const Type& type) {
+  for (const auto& fusedType : {INTEGER(), BIGINT(), REAL(), DOUBLE()}) {
+    if (type.equivalent(*fusedType)) {
+      return fusedType->kind();
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+struct FusedInstruction {
+  FusedOp op;
+
+  // Kind of the operands of a call or of the value of a field or constant.
+  TypeKind kind;
+
+  // Instructions producing the operands of a call.
+  int32_t left{-1};
+  int32_t right{-1};
+
+  // Index into FusedProgram::fields for a field.
+  int32_t field{-1};
+
+  // Bits of the value of a constant.
+  int64_t constant{0};
+};
+
+struct FusedProgram {
+  // In evaluation order. The last instruction produces the result.
+  std::vector<FusedInstruction> instructions;
+
+  // Names of the top level columns read by the program.
+  std::vector<std::string> fields;
+};
+
+namespace {
+
+using ProgramCache = folly::Synchronized<
+    folly::F14FastMap<std::string, std::shared_ptr<const FusedProgram>>>;
+
+ProgramCache& programCache() {
+  static ProgramCache cache;
+  return cache;
+}
+
+// Translates an Expr tree into a FusedProgram and a signature that identifies
+// the program in the cache.
+class FusedProgramBuilder {
+ public:
+  // Adds the instructions for 'expr' and returns the index of the instruction
+  // producing its value, or std::nullopt if 'expr' cannot be fused.
+  std::optional<int32_t> add(const Expr& expr) {
+    if (auto* fused = dynamic_cast<const FusedExpr*>(&expr)) {
+      return add(*fused->inputs()[0]);
+    }
+    if (auto* field = dynamic_cast<const FieldReference*>(&expr)) {
+      return addField(*field);
+    }
+    if (auto* constant = dynamic_cast<const ConstantExpr*>(&expr)) {
+      return addConstant(*constant);
+    }
+    return addCall(expr);
+  }
+
+  int32_t numCalls() const {
+    return numCalls_;
+  }
+
+  const std::string& signature() const {
+    return signature_;
+  }
+
+  std::shared_ptr<const FusedProgram> build() {
+    return std::make_shared<const FusedProgram>(std::move(program_));
+  }
+
+ private:
+  std::optional<int32_t> addField(const FieldReference& field) {
+    auto kind = fusedKind(*field.type());
+    if (!field.inputs().empty() || !kind.has_value()) {
+      return std::nullopt;
+    }
+    signature_ += fmt::format(
+        "f{}:{}:{};",
+        field.field().size(),
+        field.field(),
+        field.type()->toString());
+    auto it = fieldInstructions_.find(field.field());
+    if (it != fieldInstructions_.end()) {
+      return it->second;
+    }
+    FusedInstruction instruction{FusedOp::kField, kind.value()};
+    instruction.field = program_.fields.size();
+    program_.fields.push_back(field.field());
+    const auto index = append(instruction);
+    fieldInstructions_[field.field()] = index;
+    return index;
+  }
+
+  std::optional<int32_t> addConstant(const ConstantExpr& constant) {
+    auto kind = fusedKind(*constant.type());
+    if (!kind.has_value() || constant.value()->isNullAt(0)) {
+      return std::nullopt;
+    }
+    FusedInstruction instruction{FusedOp::kConstant, kind.value()};
+    switch (kind.value()) {
+      case TypeKind::INTEGER:
+        instruction.constant = constantValue<int32_t>(constant);
+        break;
+      case TypeKind::BIGINT:
+        instruction.constant = constantValue<int64_t>(constant);
+        break;
+      case TypeKind::REAL:
+        instruction.constant = constantValue<float>(constant);
+        break;
+      case TypeKind::DOUBLE:
+        instruction.constant = constantValue<double>(constant);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    signature_ += fmt::format(
+        "c:{}:{};", instruction.constant, constant.type()->toString());
+    return append(instruction);
+  }
+
+  std::optional<int32_t> addCall(const Expr& expr) {
+    if (expr.isSpecialForm() || expr.inputs().size() != 2) {
+      return std::nullopt;
+    }
+    auto op = toFusedOp(expr.name());
+    if (!op.has_value()) {
+      return std::nullopt;
+    }
+    const auto& inputType = expr.inputs()[0]->type();
+    auto kind = fusedKind(*inputType);
+    if (!kind.has_value() ||
+        !expr.inputs()[1]->type()->equivalent(*inputType)) {
+      return std::nullopt;
+    }
+    const TypePtr resultType =
+        isComparison(op.value()) ? BOOLEAN() : inputType;
+    if (!expr.type()->equivalent(*resultType)) {
+      return std::nullopt;
+    }
+
+    auto left = add(*expr.inputs()[0]);
+    if (!left.has_value()) {
+      return std::nullopt;
+    }
+    auto right = add(*expr.inputs()[1]);
+    if (!right.has_value()) {
+      return std::nullopt;
+    }
+    ++numCalls_;
+    signature_ += fmt::format("o:{}:{};", expr.name(), inputType->toString());
+
+    FusedInstruction instruction{op.value(), kind.value()};
+    instruction.left = left.value();
+    instruction.right = right.value();
+    return append(instruction);
+  }
+
+  template <typename T>
+  static int64_t constantValue(const ConstantExpr& constant) {
+    const T value = constant.value()->as<ConstantVector<T>>()->valueAt(0);
+    int64_t bits = 0;
+    memcpy(&bits, &value, sizeof(T));
+    return bits;
+  }
+
+  int32_t append(const FusedInstruction& instruction) {
+    program_.instructions.push_back(instruction);
+    return program_.instructions.size() - 1;
+  }
+
+  FusedProgram program_;
+  folly::F14FastMap<std::string, int32_t> fieldInstructions_;
+  std::string signature_;
+  int32_t numCalls_{0};
+};
+
+// Runs an arithmetic instruction over 'size' values. Integer operations are
+// checked like the Presto functions. Returns true on overflow.
+template <typename T>
+bool runArithmetic(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    T* result,
+    int32_t size) {
+  bool overflow = false;
+  if constexpr (std::is_integral_v<T>) {
+    switch (op) {
+      case FusedOp::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_add_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case FusedOp::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_sub_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case FusedOp::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          overflow |= __builtin_mul_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  } else {
+    switch (op) {
+      case FusedOp::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] + right[i];
+        }
+        break;
+      case FusedOp::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] - right[i];
+        }
+        break;
+      case FusedOp::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] * right[i];
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return overflow;
+}
+
+template <typename T, typename Compare>
+void compareLoop(
+    const T* left,
+    const T* right,
+    uint8_t* result,
+    int32_t size,
+    Compare compare) {
+  for (auto i = 0; i < size; ++i) {
+    result[i] = compare(left[i], right[i]);
+  }
+}
+
+// Runs a comparison instruction over 'size' values, producing one byte per
+// value.
+template <typename T>
+void runComparison(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    uint8_t* result,
+    int32_t size) {
+  switch (op) {
+    case FusedOp::kEq:
+      compareLoop(left, right, result, size, std::equal_to<T>());
+      break;
+    case FusedOp::kNeq:
+      compareLoop(left, right, result, size, std::not_equal_to<T>());
+      break;
+    case FusedOp::kLt:
+      compareLoop(left, right, result, size, std::less<T>());
+      break;
+    case FusedOp::kLte:
+      compareLoop(left, right, result, size, std::less_equal<T>());
+      break;
+    case FusedOp::kGt:
+      compareLoop(left, right, result, size, std::greater<T>());
+      break;
+    case FusedOp::kGte:
+      compareLoop(left, right, result, size, std::greater_equal<T>());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+bool runInstruction(
+    const FusedInstruction& instruction,
+    const void* left,
+    const void* right,
+    void* result,
+    int32_t size) {
+  if (isComparison(instruction.op)) {
+    runComparison<T>(
+        instruction.op,
+        static_cast<const T*>(left),
+        static_cast<const T*>(right),
+        static_cast<uint8_t*>(result),
+        size);
+    return false;
+  }
+  return runArithmetic<T>(
+      instruction.op,
+      static_cast<const T*>(left),
+      static_cast<const T*>(right),
+      static_cast<T*>(result),
+      size);
+}
+
+int32_t kindWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void fillConstant(int64_t bits, std::vector<int64_t>& tile) {
+  T value;
+  memcpy(&value, &bits, sizeof(T));
+  std::fill_n(reinterpret_cast<T*>(tile.data()), FusedExpr::kTileSize, value);
+}
+
+// Copies the values of a tile starting at row 'begin' into 'result'. If not
+// all rows are selected, only the selected rows are written.
+template <typename T>
+void storeTile(
+    const T* values,
+    vector_size_t begin,
+    vector_size_t size,
+    const SelectivityVector& rows,
+    BaseVector& result) {
+  auto* rawResult = result.asUnchecked<FlatVector<T>>()->mutableRawValues();
+  if (rows.isAllSelected()) {
+    std::copy_n(values, size, rawResult + begin);
+    return;
+  }
+  for (auto i = 0; i < size; ++i) {
+    if (rows.isValid(begin + i)) {
+      rawResult[begin + i] = values[i];
+    }
+  }
+}
+
+void storeBooleanTile(
+    const uint8_t* values,
+    vector_size_t begin,
+    vector_size_t size,
+    const SelectivityVector& rows,
+    BaseVector& result) {
+  auto* rawResult = result.asUnchecked<FlatVector<bool>>()->mutableRawValues();
+  const bool allSelected = rows.isAllSelected();
+  for (auto i = 0; i < size; ++i) {
+    if (allSelected || rows.isValid(begin + i)) {
+      bits::setBit(rawResult, begin + i, values[i]);
+    }
+  }
+}
+
+} // namespace
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr) {
+  if (expr->is<FusedExpr>()) {
+    return expr;
+  }
+  FusedProgramBuilder builder;
+  auto result = builder.add(*expr);
+  if (!result.has_value() || builder.numCalls() < 2) {
+    return expr;
+  }
+
+  std::shared_ptr<const FusedProgram> program;
+  {
+    auto cache = programCache().rlock();
+    auto it = cache->find(builder.signature());
+    if (it != cache->end()) {
+      program = it->second;
+    }
+  }
+  if (!program) {
+    const auto signature = builder.signature();
+    program = builder.build();
+    auto cache = programCache().wlock();
+    auto it = cache->find(signature);
+    if (it != cache->end()) {
+      program = it->second;
+    } else if (cache->size() < kMaxCachedPrograms) {
+      cache->emplace(signature, program);
+    }
+  }
+
+  auto fused = std::make_shared<FusedExpr>(expr, std::move(program));
+  fused->computeMetadata();
+  return fused;
+}
+
+// static
+size_t FusedExpr::testingNumCachedPrograms() {
+  return programCache().rlock()->size();
+}
+
+FusedExpr::FusedExpr(ExprPtr expr, std::shared_ptr<const FusedProgram> program)
+    : SpecialForm(
+          expr->type(),
+          {expr},
+          "fused",
+          expr->supportsFlatNoNullsFastPath(),
+          false /* trackCpuUsage */),
+      program_(std::move(program)) {
+  const auto& instructions = program_->instructions;
+  registers_.resize(instructions.size());
+  operands_.resize(instructions.size());
+  for (auto i = 0; i < instructions.size(); ++i) {
+    const auto& instruction = instructions[i];
+    if (instruction.op == FusedOp::kField) {
+      continue;
+    }
+    registers_[i].resize(kTileSize);
+    if (instruction.op != FusedOp::kConstant) {
+      continue;
+    }
+    switch (instruction.kind) {
+      case TypeKind::INTEGER:
+        fillConstant<int32_t>(instruction.constant, registers_[i]);
+        break;
+      case TypeKind::BIGINT:
+        fillConstant<int64_t>(instruction.constant, registers_[i]);
+        break;
+      case TypeKind::REAL:
+        fillConstant<float>(instruction.constant, registers_[i]);
+        break;
+      case TypeKind::DOUBLE:
+        fillConstant<double>(instruction.constant, registers_[i]);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    operands_[i] = registers_[i].data();
+  }
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (!tryEvalFused(rows, context, result)) {
+    inputs_[0]->eval(rows, context, result);
+  }
+}
+
+void FusedExpr::evalSpecialFormSimplified(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  inputs_[0]->evalSimplified(rows, context, result);
+}
+
+bool FusedExpr::tryEvalFused(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  const auto& fields = program_->fields;
+  if (fieldIndices_.empty()) {
+    const auto& rowType = context.row()->type()->asRow();
+    for (const auto& field : fields) {
+      fieldIndices_.push_back(rowType.getChildIdx(field));
+    }
+    fieldValues_.resize(fields.size());
+  }
+
+  for (auto i = 0; i < fields.size(); ++i) {
+    const auto* vector = context.getField(fieldIndices_[i]).get();
+    if (isLazyNotLoaded(*vector)) {
+      return false;
+    }
+    vector = vector->loadedVector();
+    if (vector->encoding() != VectorEncoding::Simple::FLAT ||
+        vector->mayHaveNulls() || vector->size() < rows.end()) {
+      return false;
+    }
+    fieldValues_[i] = vector->valuesAsVoid();
+  }
+
+  context.ensureWritable(rows, type(), result);
+  result->clearNulls(rows);
+
+  const auto& instructions = program_->instructions;
+  const auto& root = instructions.back();
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kTileSize) {
+    const auto size = std::min<vector_size_t>(kTileSize, rows.end() - begin);
+    bool overflow = false;
+    for (auto i = 0; i < instructions.size(); ++i) {
+      const auto& instruction = instructions[i];
+      switch (instruction.op) {
+        case FusedOp::kField:
+          operands_[i] = static_cast<const char*>(
+                             fieldValues_[instruction.field]) +
+              begin * kindWidth(instruction.kind);
+          break;
+        case FusedOp::kConstant:
+          break;
+        default: {
+          const auto* left = operands_[instruction.left];
+          const auto* right = operands_[instruction.right];
+          auto* registerData = registers_[i].data();
+          switch (instruction.kind) {
+            case TypeKind::INTEGER:
+              overflow |= runInstruction<int32_t>(
+                  instruction, left, right, registerData, size);
+              break;
+            case TypeKind::BIGINT:
+              overflow |= runInstruction<int64_t>(
+                  instruction, left, right, registerData, size);
+              break;
+            case TypeKind::REAL:
+              overflow |= runInstruction<float>(
+                  instruction, left, right, registerData, size);
+              break;
+            case TypeKind::DOUBLE:
+              overflow |= runInstruction<double>(
+                  instruction, left, right, registerData, size);
+              break;
+            default:
+              VELOX_UNREACHABLE();
+          }
+          operands_[i] = registerData;
+        }
+      }
+    }
+    if (overflow) {
+      // Rows that are not selected may overflow too, so the error, if any, is
+      // left to the original tree.
+      return false;
+    }
+
+    const auto* values = operands_.back();
+    if (isComparison(root.op)) {
+      storeBooleanTile(
+          static_cast<const uint8_t*>(values), begin, size, rows, *result);
+      continue;
+    }
+    switch (root.kind) {
+      case TypeKind::INTEGER:
+        storeTile(
+            static_cast<const int32_t*>(values), begin, size, rows, *result);
+        break;
+      case TypeKind::BIGINT:
+        storeTile(
+            static_cast<const int64_t*>(values), begin, size, rows, *result);
+        break;
+      case TypeKind::REAL:
+        storeTile(
+            static_cast<const float*>(values), begin, size, rows, *result);
+        break;
+      case TypeKind::DOUBLE:
+        storeTile(
+            static_cast<const double*>(values), begin, size, rows, *result);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
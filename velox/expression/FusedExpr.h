@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Straight-line program for a fused expression tree. Immutable and shared
+/// between all FusedExprs compiled from the same tree.
+struct FusedProgram;
+
+/// Evaluates a tree of 'plus', 'minus', 'multiply', 'eq', 'neq', 'lt', 'lte',
+/// 'gt' and 'gte' calls over INTEGER, BIGINT, REAL and DOUBLE columns and
+/// constants in a single pass without materializing intermediate vectors. The
+/// rows are processed in tiles of kTileSize and every call runs a tight loop
+/// over the tile, so that the intermediate results stay in the L1 cache.
+///
+/// The original tree is kept as the only input and is evaluated instead if a
+/// column is not flat or has nulls, or if an integer operation overflows, so
+/// that null handling and errors are exactly those of the unfused tree.
+/// Enabled by QueryConfig::kCodegenEnabled.
+class FusedExpr : public SpecialForm {
+ public:
+  static constexpr int32_t kTileSize = 1'024;
+
+  /// Returns a FusedExpr over 'expr' if 'expr' is a tree of at least two
+  /// supported calls over columns and non-null constants, 'expr' otherwise.
+  /// Nested FusedExprs are looked through, so that the compiler can call this
+  /// bottom-up on every compiled node.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  FusedExpr(ExprPtr expr, std::shared_ptr<const FusedProgram> program);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  void evalSpecialFormSimplified(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return inputs_[0]->toSql(complexConstants);
+  }
+
+  /// Returns the number of programs in the process-wide program cache.
+  static size_t testingNumCachedPrograms();
+
+ private:
+  void computePropagatesNulls() override {
+    propagatesNulls_ = inputs_[0]->propagatesNulls();
+  }
+
+  // Evaluates the program over 'rows' into 'result'. Returns false if the
+  // inputs are not flat and non-null or an integer operation overflowed, in
+  // which case the original tree must be evaluated.
+  bool tryEvalFused(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  const std::shared_ptr<const FusedProgram> program_;
+
+  // Column indices of the program's fields in the input row. Resolved on
+  // first evaluation.
+  std::vector<column_index_t> fieldIndices_;
+
+  // Raw values of the program's fields for the current batch.
+  std::vector<const void*> fieldValues_;
+
+  // Tile of results for each instruction. Empty for fields, which are read in
+  // place. Filled once for constants.
+  std::vector<std::vector<int64_t>> registers_;
+
+  // Values of each instruction for the current tile.
+  std::vector<const void*> operands_;
+};
+
+} // namespace facebook::velox::exec
@@ -155,7 +155,11 @@ bool PeeledEncoding::peelInternal(
       }
       nonConstant = true;
       auto encoding = leaf->encoding();
-      if (encoding == VectorEncoding::Simple::DICTIONARY) {
+      // A sequence is peeled like a dictionary whose indices are the run
+      // numbers, so that the function is evaluated once per run. Sequences
+      // are shared between fields only if they have the same run lengths.
+      if (encoding == VectorEncoding::Simple::DICTIONARY ||
+          encoding == VectorEncoding::Simple::SEQUENCE) {
         if (!canPeelsHaveNulls && leaf->rawNulls()) {
           // A dictionary that adds nulls over an Expr that is not null for a
           // null argument cannot be peeled.
@@ -100,6 +100,13 @@ class LocalSelectivityVector;
 ///    Peeled Vectors: DictWithNulls(Flat1), Const1,
 ///                    DictWithNulls(Dict3(Flat2))
 ///    peel: DictNoNulls
+///
+/// 10. Sequence (run length) encodings are peeled like dictionaries. The peel
+///     maps each row to the index of its run, so the peeled vectors have one
+///     row per run.
+///    Input Vectors: Seq1(Flat1), Seq1(Flat2)
+///    Peeled Vectors: Flat1, Flat2
+///    peel: Seq1 => converted into a dictionary
 class PeeledEncoding {
  public:
   /// Factory method for constructing a PeeledEncoding object only if peeling
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/SharedExprMemo.h"
+
+#include <gflags/gflags.h>
+
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+DECLARE_uint64(velox_shared_expr_memo_capacity_bytes);
+
+namespace facebook::velox::exec {
+
+// static
+std::shared_ptr<SharedExprMemo> SharedExprMemo::get(core::QueryCtx& queryCtx) {
+  return queryCtx.sharedExprMemo([&]() {
+    return std::make_shared<SharedExprMemo>(
+        FLAGS_velox_shared_expr_memo_capacity_bytes,
+        queryCtx.pool()->addLeafChild("sharedExprMemo"));
+  });
+}
+
+SharedExprMemo::SharedExprMemo(
+    uint64_t capacityBytes,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : capacityBytes_(capacityBytes), pool_(std::move(pool)) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+// static
+std::string SharedExprMemo::makeKey(
+    const std::string& fingerprint,
+    const BaseVector* base) {
+  return fmt::format("{}@{}", fingerprint, static_cast<const void*>(base));
+}
+
+std::shared_ptr<const SharedExprMemo::Entry> SharedExprMemo::find(
+    const std::string& fingerprint,
+    const VectorPtr& base) {
+  const auto key = makeKey(fingerprint, base.get());
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.entry;
+}
+
+void SharedExprMemo::insert(
+    const std::string& fingerprint,
+    const VectorPtr& base,
+    const BaseVector& values,
+    const SelectivityVector& rows) {
+  VELOX_CHECK(supportsType(*values.type()), "{}", values.type()->toString());
+  VELOX_CHECK_LE(rows.end(), base->size());
+
+  auto existing = find(fingerprint, base);
+
+  // Copy outside of the lock. If another driver inserts for the same key in
+  // the meantime, the last insert wins.
+  auto entry = std::make_shared<Entry>();
+  entry->base = base;
+  entry->rows.resize(base->size(), false);
+  entry->values = BaseVector::create(values.type(), base->size(), pool_.get());
+  if (existing) {
+    SelectivityVector existingRows(existing->rows);
+    existingRows.deselect(rows);
+    if (existingRows.hasSelections()) {
+      copyValues(*existing->values, existingRows, *entry->values);
+    }
+    entry->rows.select(existing->rows);
+  }
+  copyValues(values, rows, *entry->values);
+  entry->rows.select(rows);
+  entry->bytes = entry->values->retainedSize();
+  if (entry->bytes > capacityBytes_) {
+    return;
+  }
+
+  const auto key = makeKey(fingerprint, base.get());
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it);
+  }
+  lru_.push_front(key);
+  numBytes_ += entry->bytes;
+  entries_[key] = Slot{std::move(entry), lru_.begin()};
+  evictLocked();
+}
+
+SharedExprMemo::Stats SharedExprMemo::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return Stats{entries_.size(), numBytes_, numEvictions_};
+}
+
+void SharedExprMemo::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  numBytes_ = 0;
+}
+
+// static
+void SharedExprMemo::copyValues(
+    const BaseVector& source,
+    const SelectivityVector& rows,
+    BaseVector& target) {
+  if (!target.type()->isVarchar() && !target.type()->isVarbinary()) {
+    target.copy(&source, rows, nullptr);
+    return;
+  }
+  auto* flatTarget = target.asUnchecked<FlatVector<StringView>>();
+  DecodedVector decoded(source, rows);
+  rows.applyToSelected([&](auto row) {
+    if (decoded.isNullAt(row)) {
+      flatTarget->setNull(row, true);
+    } else {
+      flatTarget->set(row, decoded.valueAt<StringView>(row));
+    }
+  });
+}
+
+void SharedExprMemo::removeLocked(
+    folly::F14FastMap<std::string, Slot>::iterator it) {
+  numBytes_ -= it->second.entry->bytes;
+  lru_.erase(it->second.lruPosition);
+  entries_.erase(it);
+}
+
+void SharedExprMemo::evictLocked() {
+  while (!lru_.empty()) {
+    auto it = entries_.find(lru_.back());
+    if (numBytes_ <= capacityBytes_ &&
+        it->second.entry->base.use_count() > 1) {
+      break;
+    }
+    removeLocked(it);
+    ++numEvictions_;
+  }
+}
+
+} // namespace facebook::velox::exec
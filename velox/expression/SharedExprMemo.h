@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/Memory.h"
+#include "velox/core/QueryCtx.h"
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::exec {
+
+/// Memo of the results of deterministic expressions over the base vectors of
+/// dictionary encoded inputs, shared by the drivers of a query. Complements
+/// the per-Expr memo of Expr::evalWithMemo: when the same dictionary base, e.g.
+/// a stripe dictionary of a file reader, is seen by many drivers, an
+/// expression is computed once per base and the other drivers copy the
+/// memoized values.
+///
+/// Entries are keyed on an expression fingerprint and the address of the base
+/// vector. Like Expr::evalWithMemo, each entry holds a reference to its base,
+/// so that the base is not reused in place and its address is not reused while
+/// the entry exists. The memo belongs to the QueryCtx, so the bases, which are
+/// allocated from the memory of the query, are released with the query. The
+/// memoized values are deep copies allocated from a leaf pool of the query and
+/// their total size is bounded by a capacity. Entries are evicted least
+/// recently used first when over capacity. Least recently used entries whose
+/// base is referenced only by the memo, i.e. the reader that produced the base
+/// has moved on, are dropped on insert.
+class SharedExprMemo {
+ public:
+  struct Entry {
+    VectorPtr base;
+
+    /// Values for 'rows' of 'base'. Flat.
+    VectorPtr values;
+
+    /// Rows of 'base' that have a value in 'values'.
+    SelectivityVector rows;
+
+    /// Retained size of 'values'.
+    uint64_t bytes{0};
+  };
+
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t numBytes{0};
+    uint64_t numEvictions{0};
+  };
+
+  /// Returns the memo of 'queryCtx', creating it on first use. Its capacity is
+  /// set from the velox_shared_expr_memo_capacity_bytes flag.
+  static std::shared_ptr<SharedExprMemo> get(core::QueryCtx& queryCtx);
+
+  SharedExprMemo(
+      uint64_t capacityBytes,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  /// Returns true if results of 'type' can be memoized.
+  static bool supportsType(const Type& type) {
+    return type.isPrimitiveType();
+  }
+
+  /// Returns the entry for 'fingerprint' over 'base' or nullptr if there is
+  /// none.
+  std::shared_ptr<const Entry> find(
+      const std::string& fingerprint,
+      const VectorPtr& base);
+
+  /// Memoizes 'rows' of 'values' as the result of 'fingerprint' over 'base'.
+  /// Values already memoized for other rows of 'base' are kept.
+  void insert(
+      const std::string& fingerprint,
+      const VectorPtr& base,
+      const BaseVector& values,
+      const SelectivityVector& rows);
+
+  Stats stats() const;
+
+  /// Drops all entries.
+  void clear();
+
+ private:
+  struct Slot {
+    std::shared_ptr<const Entry> entry;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  static std::string makeKey(
+      const std::string& fingerprint,
+      const BaseVector* base);
+
+  // Copies 'rows' of 'source' into 'target'. Strings are copied into the
+  // buffers of 'target' instead of sharing the buffers of 'source'.
+  static void copyValues(
+      const BaseVector& source,
+      const SelectivityVector& rows,
+      BaseVector& target);
+
+  // Removes the entry in 'it'. Requires 'mutex_'.
+  void removeLocked(folly::F14FastMap<std::string, Slot>::iterator it);
+
+  // Drops least recently used entries until the size is within capacity and
+  // the least recently used entry has a base referenced outside of the memo.
+  // Requires 'mutex_'.
+  void evictLocked();
+
+  const uint64_t capacityBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Slot> entries_;
+  // Keys of 'entries_', most recently used first.
+  std::list<std::string> lru_;
+  uint64_t numBytes_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::exec
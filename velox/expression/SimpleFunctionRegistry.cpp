@@ -16,9 +16,15 @@
 
 #include "velox/expression/SimpleFunctionRegistry.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::exec {
 namespace {
 
+// Bounds the memory of the resolution cache, e.g. for many distinct decimal
+// or row argument types.
+constexpr size_t kMaxResolvedFunctions = 10'000;
+
 SimpleFunctionRegistry& simpleFunctionsInternal() {
   static SimpleFunctionRegistry instance;
   return instance;
@@ -64,6 +70,7 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
 
     functions.emplace_back(
         std::make_unique<const FunctionEntry>(metadata, factory));
+    resolvedFunctions_.wlock()->clear();
     return true;
   });
 }
@@ -151,6 +158,16 @@ SimpleFunctionRegistry::resolveFunction(
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
+    ResolutionKey key{name, argTypes};
+    {
+      auto resolved = resolvedFunctions_.rlock();
+      auto it = resolved->find(key);
+      if (it != resolved->end()) {
+        selectedCandidate = it->second.entry;
+        selectedCandidateType = it->second.type;
+        return;
+      }
+    }
     if (const auto* signatureMap = getSignatureMap(name, map)) {
       for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
         SignatureBinder binder(candidateSignature, argTypes);
@@ -190,6 +207,12 @@ SimpleFunctionRegistry::resolveFunction(
         }
       }
     }
+    auto resolved = resolvedFunctions_.wlock();
+    if (resolved->size() >= kMaxResolvedFunctions) {
+      resolved->clear();
+    }
+    resolved->emplace(
+        std::move(key), Resolution{selectedCandidate, selectedCandidateType});
   });
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
@@ -200,4 +223,26 @@ SimpleFunctionRegistry::resolveFunction(
       : std::nullopt;
 }
 
+bool SimpleFunctionRegistry::ResolutionKey::operator==(
+    const ResolutionKey& other) const {
+  return name == other.name &&
+      std::equal(
+             argTypes.begin(),
+             argTypes.end(),
+             other.argTypes.begin(),
+             other.argTypes.end(),
+             [](const auto& left, const auto& right) {
+               return *left == *right;
+             });
+}
+
+size_t SimpleFunctionRegistry::ResolutionKeyHasher::operator()(
+    const ResolutionKey& key) const {
+  auto hash = std::hash<std::string>()(key.name);
+  for (const auto& type : key.argTypes) {
+    hash = bits::hashMix(hash, type->hashKind());
+  }
+  return hash;
+}
+
 } // namespace facebook::velox::exec
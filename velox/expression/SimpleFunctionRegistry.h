@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/core/SimpleFunctionMetadata.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
@@ -104,7 +106,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolvedFunctions_.wlock()->clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -144,11 +149,31 @@ class SimpleFunctionRegistry {
     const TypePtr type_;
   };
 
+  /// Returns the function to call for 'name' with 'argTypes'. Resolutions
+  /// are cached until the next registration, so that compiling the same
+  /// expressions for many Drivers and Tasks binds the signatures once.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
  private:
+  struct ResolutionKey {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const ResolutionKey& other) const;
+  };
+
+  struct ResolutionKeyHasher {
+    size_t operator()(const ResolutionKey& key) const;
+  };
+
+  // Result of resolveFunction(). 'entry' is nullptr if no function matched.
+  struct Resolution {
+    const FunctionEntry* entry;
+    TypePtr type;
+  };
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -167,6 +192,13 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Cache of resolveFunction() results. Cleared while holding the write lock
+  // of 'registeredFunctions_' and filled while holding its read lock, so
+  // that it never outlives a registration.
+  mutable folly::Synchronized<
+      folly::F14FastMap<ResolutionKey, Resolution, ResolutionKeyHasher>>
+      resolvedFunctions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
@@ -285,6 +285,21 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes the list of expressions compiled together into one
+/// ExprSet and returns an equivalent list of the same size, e.g. one where
+/// calls in different expressions that can share work are replaced by a common
+/// subexpression. Returns an empty list if re-write is not possible.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. Set re-writes are applied
+/// in the order they were registered, each to the result of the previous one,
+/// before the re-writes registered with registerExpressionRewrite.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Compares the evaluation of nested string and arithmetic expressions with
+// and without expression.eval_arena_enabled. With the arena, the string
+// buffers of the intermediate and final results are carved from arena chunks
+// instead of being allocated from the memory pool one by one. Arithmetic
+// expressions allocate no string buffers and serve as a baseline. After the
+// benchmarks, prints the number of memory pool allocations per batch of each
+// case.
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr vector_size_t kNumRows = 1'000;
+constexpr int32_t kNumBatches = 100;
+
+const std::string kStringExpr =
+    "concat(upper(c0), '-', lower(substr(concat(c1, c0), 2)), '-', "
+    "reverse(c1))";
+
+const std::string kArithmeticExpr = "(c2 + c3) * (c2 - c3) + c2 * 3 - c3 / 7";
+
+class EvalArenaBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  explicit EvalArenaBenchmark(bool arena) {
+    functions::prestosql::registerAllScalarFunctions();
+    std::unordered_map<std::string, std::string> config{
+        {core::QueryConfig::kExprEvalArenaEnabled, arena ? "true" : "false"}};
+    arenaQueryCtx_ =
+        core::QueryCtx::create(nullptr, core::QueryConfig(std::move(config)));
+    arenaExecCtx_ =
+        std::make_unique<core::ExecCtx>(pool(), arenaQueryCtx_.get());
+
+    data_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<std::string>(
+            kNumRows,
+            [](auto row) { return fmt::format("first string {}", row); }),
+        vectorMaker_.flatVector<std::string>(
+            kNumRows,
+            [](auto row) { return fmt::format("second string {}", row * 7); }),
+        vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row; }),
+        vectorMaker_.flatVector<int64_t>(
+            kNumRows, [](auto row) { return row * 11 + 1; }),
+    });
+  }
+
+  size_t run(const std::string& text) {
+    folly::BenchmarkSuspender suspender;
+    auto typed = core::Expressions::inferTypes(
+        parse::parseExpr(text, options_), data_->type(), pool());
+    exec::ExprSet exprSet({typed}, arenaExecCtx_.get());
+    suspender.dismiss();
+
+    size_t count = 0;
+    SelectivityVector rows(data_->size());
+    for (auto i = 0; i < kNumBatches; ++i) {
+      exec::EvalCtx evalCtx(arenaExecCtx_.get(), &exprSet, data_.get());
+      std::vector<VectorPtr> results(1);
+      exprSet.eval(rows, evalCtx, results);
+      count += results[0]->size();
+    }
+    return count;
+  }
+
+  // Returns the number of memory pool allocations per batch of 'text'.
+  double allocationsPerBatch(const std::string& text) {
+    const auto numAllocs = pool()->stats().numAllocs;
+    run(text);
+    return static_cast<double>(pool()->stats().numAllocs - numAllocs) /
+        kNumBatches;
+  }
+
+ private:
+  std::shared_ptr<core::QueryCtx> arenaQueryCtx_;
+  std::unique_ptr<core::ExecCtx> arenaExecCtx_;
+  RowVectorPtr data_;
+  parse::ParseOptions options_;
+};
+
+BENCHMARK_MULTI(stringNoArena) {
+  EvalArenaBenchmark benchmark(false);
+  return benchmark.run(kStringExpr);
+}
+
+BENCHMARK_RELATIVE_MULTI(stringArena) {
+  EvalArenaBenchmark benchmark(true);
+  return benchmark.run(kStringExpr);
+}
+
+BENCHMARK_MULTI(arithmeticNoArena) {
+  EvalArenaBenchmark benchmark(false);
+  return benchmark.run(kArithmeticExpr);
+}
+
+BENCHMARK_RELATIVE_MULTI(arithmeticArena) {
+  EvalArenaBenchmark benchmark(true);
+  return benchmark.run(kArithmeticExpr);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+
+  folly::runBenchmarks();
+
+  for (const auto& [name, text] :
+       {std::pair{"string", kStringExpr},
+        std::pair{"arithmetic", kArithmeticExpr}}) {
+    const auto withoutArena =
+        EvalArenaBenchmark(false).allocationsPerBatch(text);
+    const auto withArena = EvalArenaBenchmark(true).allocationsPerBatch(text);
+    std::cout << fmt::format(
+                     "{}: {} pool allocations per batch without arena, {} "
+                     "with arena",
+                     name,
+                     withoutArena,
+                     withArena)
+              << std::endl;
+  }
+  return 0;
+}
@@ -1109,6 +1109,85 @@ TEST_F(CastExprTest, primitiveValidCornerCases) {
   }
 }
 
+TEST_F(CastExprTest, stringFastPath) {
+  // Rows in the shapes parsed upfront are mixed with rows that fall back to
+  // the general cast.
+  testCast(
+      makeNullableFlatVector<std::string>(
+          {"0",
+           "-9223372036854775808",
+           "9223372036854775807",
+           "+12",
+           "0012345678901",
+           "123456789012",
+           "9223372036854775808",
+           "1a",
+           "",
+           std::nullopt}),
+      makeNullableFlatVector<int64_t>(
+          {0,
+           std::numeric_limits<int64_t>::min(),
+           std::numeric_limits<int64_t>::max(),
+           12,
+           12345678901,
+           123456789012,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt}),
+      true);
+  testCast(
+      makeNullableFlatVector<std::string>(
+          {"127", "-128", "128", "-129", "00000000000000000000001"}),
+      makeNullableFlatVector<int8_t>(
+          {127, -128, std::nullopt, std::nullopt, 1}),
+      true);
+  testCast(
+      makeNullableFlatVector<std::string>(
+          {"1.5",
+           "-0.25",
+           "0.1",
+           "-0",
+           "123456789.123456",
+           "1e3",
+           "1.",
+           "Infinity",
+           "abc"}),
+      makeNullableFlatVector<double>(
+          {1.5,
+           -0.25,
+           0.1,
+           -0.0,
+           123456789.123456,
+           1'000,
+           1,
+           kInf,
+           std::nullopt}),
+      true);
+  testCast(
+      makeNullableFlatVector<std::string>(
+          {"1970-01-01",
+           "2024-05-17",
+           "2024-02-29",
+           "2023-02-29",
+           "1970-1-2",
+           "+1970-01-02",
+           "2024-05-xx"}),
+      makeNullableFlatVector<int32_t>(
+          {0, 19860, 19782, std::nullopt, 1, 1, std::nullopt}, DATE()),
+      true);
+
+  // Errors of the rows that fall back are reported as before.
+  testInvalidCast<std::string>(
+      "bigint",
+      {"1", "9223372036854775808"},
+      "Cannot cast VARCHAR '9223372036854775808' to BIGINT.");
+  testInvalidCast<std::string>(
+      "date",
+      {"2024-05-17", "2023-02-29"},
+      "Cannot cast VARCHAR '2023-02-29' to DATE.");
+}
+
 TEST_F(CastExprTest, truncateVsRound) {
   // Testing round cast from double to int.
   testCast<double, int>(
@@ -29,6 +29,7 @@
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
+#include "velox/expression/SharedExprMemo.h"
 #include "velox/expression/SwitchExpr.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -467,13 +468,36 @@ TEST_P(ParameterizedExprTest, reorder) {
 
   // Verify that more efficient filter is first.
   for (auto i = 1; i < condition->inputs().size(); ++i) {
-    std::cout << condition->selectivityAt(i - 1).timeToDropValue() << std::endl;
     EXPECT_LE(
-        condition->selectivityAt(i - 1).timeToDropValue(),
-        condition->selectivityAt(i).timeToDropValue());
+        condition->selectivityAt(i - 1).costPerDroppedRow(),
+        condition->selectivityAt(i).costPerDroppedRow());
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderInputDroppingNoRows) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  // The first conjunct is cheap but passes all rows. It must go after the
+  // second one, which drops rows, however little the first one costs.
+  auto exprSet = compileExpression(
+      "if (c0 >= 0 and c0 % 103 < 30, 1, 2)", asRowType(data->type()));
+  evaluate(exprSet.get(), data);
+
+  auto condition = std::dynamic_pointer_cast<exec::ConjunctExpr>(
+      exprSet->expr(0)->inputs()[0]);
+  ASSERT_TRUE(condition != nullptr);
+  ASSERT_EQ(condition->inputs().size(), 2);
+
+  const auto& first = condition->selectivityAt(0);
+  const auto& second = condition->selectivityAt(1);
+  EXPECT_LT(first.numOut(), first.numIn());
+  EXPECT_EQ(second.numOut(), second.numIn());
+  EXPECT_LT(first.costPerDroppedRow(), second.costPerDroppedRow());
+  EXPECT_EQ(second.costPerDroppedRow(), std::numeric_limits<float>::max());
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -2155,6 +2179,152 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, sharedMemo) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprSharedMemoEnabled, "true"},
+  });
+  auto memo = exec::SharedExprMemo::get(*queryCtx_);
+
+  auto base = makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("shared memo value {}", row); });
+  auto evenIndices = makeIndices(100, [](auto row) { return row * 2; });
+  auto oddIndices = makeIndices(100, [](auto row) { return 1 + row * 2; });
+  auto rowType = ROW({"c0"}, {base->type()});
+
+  // Two ExprSets that stand for the same expression in two drivers.
+  auto exprSet = compileExpression("upper(c0)", rowType);
+  auto otherExprSet = compileExpression("upper(c0)", rowType);
+
+  auto expected = [](auto first) {
+    return [first](auto row) {
+      return fmt::format("SHARED MEMO VALUE {}", first + row * 2);
+    };
+  };
+  auto expectedEven = makeFlatVector<std::string>(100, expected(0));
+  auto [result, stats] = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  assertEqualVectors(expectedEven, result);
+  EXPECT_EQ(stats["upper"].numProcessedRows, 100);
+  EXPECT_EQ(stats["upper"].numSharedMemoMisses, 1);
+
+  // The other driver copies the memoized values.
+  std::tie(result, stats) = evaluateWithStats(
+      otherExprSet.get(),
+      makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+  assertEqualVectors(expectedEven, result);
+  EXPECT_EQ(stats["upper"].numProcessedRows, 0);
+  EXPECT_EQ(stats["upper"].numSharedMemoHits, 1);
+
+  // Rows that are not memoized are computed and added to the memo.
+  auto expectedOdd = makeFlatVector<std::string>(100, expected(1));
+  std::tie(result, stats) = evaluateWithStats(
+      otherExprSet.get(),
+      makeRowVector({wrapInDictionary(oddIndices, 100, base)}));
+  assertEqualVectors(expectedOdd, result);
+  EXPECT_EQ(stats["upper"].numProcessedRows, 100);
+  EXPECT_EQ(stats["upper"].numSharedMemoMisses, 1);
+  EXPECT_EQ(stats["upper"].numSharedMemoHits, 1);
+
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(), makeRowVector({wrapInDictionary(oddIndices, 100, base)}));
+  assertEqualVectors(expectedOdd, result);
+  EXPECT_EQ(stats["upper"].numProcessedRows, 100);
+  EXPECT_EQ(stats["upper"].numSharedMemoHits, 1);
+  EXPECT_EQ(memo->stats().numEntries, 1);
+
+  // The entry is dropped once only the memo references the base.
+  base.reset();
+  auto otherBase = makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("shared memo value {}", row); });
+  std::tie(result, stats) = evaluateWithStats(
+      exprSet.get(),
+      makeRowVector({wrapInDictionary(evenIndices, 100, otherBase)}));
+  assertEqualVectors(expectedEven, result);
+  EXPECT_EQ(memo->stats().numEntries, 1);
+  EXPECT_EQ(memo->stats().numEvictions, 1);
+
+  // Each query has its own memo.
+  auto otherQueryCtx = core::QueryCtx::create();
+  EXPECT_NE(exec::SharedExprMemo::get(*otherQueryCtx), memo);
+  EXPECT_EQ(exec::SharedExprMemo::get(*otherQueryCtx)->stats().numEntries, 0);
+}
+
+TEST_F(ExprTest, evalArena) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprEvalArenaEnabled, "true"},
+  });
+  auto execCtx = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+  auto* arena = execCtx->bufferArena();
+  ASSERT_NE(arena, nullptr);
+
+  auto data = makeRowVector({makeFlatVector<std::string>(
+      1'000, [](auto row) { return fmt::format("arena string {}", row); })});
+  auto expected = makeFlatVector<std::string>(1'000, [](auto row) {
+    return fmt::format("arena string {}-arena string {}", row, row);
+  });
+  auto evaluate = [&]() {
+    return evaluateMultiple(
+        {"concat(c0, '-', c0)"}, data, std::nullopt, execCtx.get())[0];
+  };
+
+  auto result = evaluate();
+  assertEqualVectors(expected, result);
+  EXPECT_GT(arena->stats().numAllocations, 0);
+  EXPECT_EQ(arena->stats().numChunks, 1);
+
+  // 'result' still references the chunk, so the next batch takes a new one.
+  auto otherResult = evaluate();
+  assertEqualVectors(expected, otherResult);
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(arena->stats().numChunks, 2);
+
+  // The chunk is rewound once no result references it.
+  result.reset();
+  otherResult.reset();
+  result = evaluate();
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(arena->stats().numChunks, 2);
+  EXPECT_EQ(arena->stats().numReusedChunks, 1);
+}
+
+TEST_F(ExprTest, foldConstants) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto folded = exec::foldConstants(
+      {parseExpression("c0 + (1 + 2) * 3", rowType),
+       parseExpression("concat('a', 'b')", rowType),
+       parseExpression("cast(null as varchar)", rowType),
+       parseExpression("rand() + 0.5", rowType)},
+      execCtx_.get());
+  ASSERT_EQ(folded.size(), 4);
+
+  // The constant argument of plus is folded, the call on c0 is kept.
+  ASSERT_EQ(folded[0]->inputs().size(), 2);
+  auto* constant = dynamic_cast<const core::ConstantTypedExpr*>(
+      folded[0]->inputs()[1].get());
+  ASSERT_NE(constant, nullptr);
+  ASSERT_EQ(constant->toString(), "9");
+  constant = dynamic_cast<const core::ConstantTypedExpr*>(folded[1].get());
+  ASSERT_NE(constant, nullptr);
+  ASSERT_EQ(constant->value(), variant("ab"));
+  constant = dynamic_cast<const core::ConstantTypedExpr*>(folded[2].get());
+  ASSERT_NE(constant, nullptr);
+  ASSERT_TRUE(constant->value().isNull());
+  ASSERT_EQ(*constant->type(), *VARCHAR());
+  // Non-deterministic calls are not folded.
+  ASSERT_NE(
+      dynamic_cast<const core::CallTypedExpr*>(folded[3]->inputs()[0].get()),
+      nullptr);
+
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  exec::ExprSet exprSet({folded[0], folded[1]}, execCtx_.get());
+  exec::EvalCtx context(execCtx_.get(), &exprSet, data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> result(2);
+  exprSet.eval(rows, context, result);
+  assertEqualVectors(makeFlatVector<int64_t>({10, 11, 12}), result[0]);
+  assertEqualVectors(makeConstant<std::string>("ab", 3), result[1]);
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -2196,6 +2366,29 @@ TEST_P(ParameterizedExprTest, memoNulls) {
 // and applyRows and rows are distinct SelectivityVectors.  This test ensures
 // we're using applyRows and rows in the right places, if not we should see a
 // SIGSEGV.
+TEST_P(ParameterizedExprTest, peelSequence) {
+  // Two columns with the same runs. The expression is evaluated once per run
+  // and the result is a dictionary over the per-run results.
+  auto lengths = AlignedBuffer::allocate<SequenceLength>(3, pool());
+  auto rawLengths = lengths->asMutable<SequenceLength>();
+  rawLengths[0] = 400;
+  rawLengths[1] = 100;
+  rawLengths[2] = 500;
+  auto c0 = BaseVector::wrapInSequence(
+      lengths, 1'000, makeFlatVector<int64_t>({1, 2, 3}));
+  auto c1 = BaseVector::wrapInSequence(
+      lengths, 1'000, makeNullableFlatVector<int64_t>({10, std::nullopt, 30}));
+
+  auto result = evaluate("c0 * 2 + c1", makeRowVector({c0, c1}));
+  ASSERT_EQ(result->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->valueVector()->size(), 3);
+  auto expected = makeFlatVector<int64_t>(
+      1'000,
+      [](auto row) { return row < 400 ? 12 : 36; },
+      [](auto row) { return row >= 400 && row < 500; });
+  assertEqualVectors(expected, result);
+}
+
 TEST_P(ParameterizedExprTest, peelNulls) {
   // Generate 5 distinct values for the c0 column.
   auto c0 = makeFlatVector<StringView>(5, [](vector_size_t row) {
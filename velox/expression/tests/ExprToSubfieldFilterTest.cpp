@@ -250,5 +250,28 @@ TEST_F(ExprToSubfieldFilterTest, dereferenceWithEmptyField) {
   ASSERT_FALSE(filter);
 }
 
+TEST_F(ExprToSubfieldFilterTest, disjunction) {
+  auto type = ROW({{"a", BIGINT()}, {"b", VARCHAR()}});
+  auto filters = toDisjunctiveSubfieldFilters(
+      parseExpr("a = 1 OR b >= 'x' OR a > 10", type), evaluator());
+  ASSERT_EQ(filters.size(), 2);
+  validateSubfield(filters[0].first, {"a"});
+  EXPECT_TRUE(filters[0].second->testInt64(1));
+  EXPECT_TRUE(filters[0].second->testInt64(11));
+  EXPECT_FALSE(filters[0].second->testInt64(5));
+  validateSubfield(filters[1].first, {"b"});
+  EXPECT_TRUE(filters[1].second->testBytes("y", 1));
+  EXPECT_FALSE(filters[1].second->testBytes("a", 1));
+
+  auto toFilters = [&](const std::string& expr) {
+    return toDisjunctiveSubfieldFilters(parseExpr(expr, type), evaluator());
+  };
+  // All disjuncts on the same column.
+  EXPECT_TRUE(toFilters("a = 1 OR a = 2").empty());
+  // A disjunct that is not a filter.
+  EXPECT_TRUE(toFilters("a = 1 OR length(b) = 2").empty());
+  EXPECT_TRUE(toFilters("a = 1").empty());
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/FusedExpr.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setCodegenEnabled(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kCodegenEnabled, enabled ? "true" : "false"},
+    });
+  }
+
+  // Evaluates 'expression' with and without fusion and checks that the
+  // results match.
+  void testFused(
+      const std::string& expression,
+      const RowVectorPtr& data,
+      const std::optional<SelectivityVector>& rows = std::nullopt) {
+    setCodegenEnabled(false);
+    auto expected = evaluate(expression, data, rows);
+    setCodegenEnabled(true);
+    auto result = evaluate(expression, data, rows);
+    if (rows.has_value()) {
+      velox::test::assertEqualVectors(expected, result, rows.value());
+    } else {
+      velox::test::assertEqualVectors(expected, result);
+    }
+  }
+
+  RowVectorPtr makeData(vector_size_t size) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(size, [](auto row) { return row % 97 - 40; }),
+        makeFlatVector<int64_t>(size, [](auto row) { return row % 13; }),
+        makeFlatVector<double>(size, [](auto row) { return row * 0.25; }),
+        makeFlatVector<double>(size, [](auto row) { return 100 - row * 0.5; }),
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 31; }),
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 7 - 3; }),
+    });
+  }
+};
+
+TEST_F(FusedExprTest, basic) {
+  // More than one tile.
+  auto data = makeData(3 * FusedExpr::kTileSize + 17);
+
+  testFused("c0 + c1 * c0 - c1", data);
+  testFused("c0 * c1 < c1 + c0", data);
+  testFused("c2 * 2.5 + c3 - c2", data);
+  testFused("c2 - c3 >= c3 * c2", data);
+  testFused("c0 + cast(3 as bigint) = c1 * cast(2 as bigint)", data);
+  testFused("c4 - c5 * c4", data);
+  testFused("c4 * c5 <> c5 + c4", data);
+  testFused("c0 + c1 > c1 - c0", data);
+  testFused("c0 * c0 <= c1 * c1", data);
+
+  // A subset of the rows.
+  SelectivityVector rows(data->size(), false);
+  for (auto i = 0; i < data->size(); i += 3) {
+    rows.setValid(i, true);
+  }
+  rows.updateBounds();
+  testFused("c0 + c1 * c0 - c1", data, rows);
+  testFused("c0 * c1 < c1 + c0", data, rows);
+  testFused("c2 * 2.5 + c3 - c2", data, rows);
+}
+
+TEST_F(FusedExprTest, compile) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+
+  setCodegenEnabled(true);
+  auto exprSet = compileExpression("c0 + c1 * c0", rowType);
+  EXPECT_EQ(exprSet->exprs()[0]->name(), "fused");
+
+  // A single call is not fused.
+  exprSet = compileExpression("c0 + c1", rowType);
+  EXPECT_EQ(exprSet->exprs()[0]->name(), "plus");
+
+  // Fusion stops at calls that are not supported.
+  exprSet = compileExpression("abs(c0 + c1 * c0)", rowType);
+  EXPECT_EQ(exprSet->exprs()[0]->name(), "abs");
+  EXPECT_EQ(exprSet->exprs()[0]->inputs()[0]->name(), "fused");
+
+  // Identical trees share a program.
+  compileExpression("c1 * c0 - c1", rowType);
+  const auto numPrograms = FusedExpr::testingNumCachedPrograms();
+  compileExpression("c1 * c0 - c1", rowType);
+  EXPECT_EQ(FusedExpr::testingNumCachedPrograms(), numPrograms);
+
+  setCodegenEnabled(false);
+  exprSet = compileExpression("c0 + c1 * c0", rowType);
+  EXPECT_EQ(exprSet->exprs()[0]->name(), "plus");
+}
+
+TEST_F(FusedExprTest, overflow) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max(), 3, 4}),
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+  });
+
+  setCodegenEnabled(true);
+  VELOX_ASSERT_THROW(
+      evaluate("c0 * c1 + c1", data), "overflow: 9223372036854775807 * 2");
+  testFused("try(c0 * c1 + c1)", data);
+
+  // The overflowing row is not selected.
+  SelectivityVector rows(data->size());
+  rows.setValid(1, false);
+  rows.updateBounds();
+  testFused("c0 * c1 + c1", data, rows);
+}
+
+TEST_F(FusedExprTest, fallback) {
+  // Nulls.
+  auto data = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4, std::nullopt}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+  });
+  testFused("c0 * c1 + c1", data);
+  testFused("c0 * c1 < c1 - c0", data);
+
+  // Dictionary and constant encodings.
+  auto base = makeData(100);
+  data = makeRowVector({
+      wrapInDictionary(makeIndicesInReverse(100), base->childAt(0)),
+      makeConstant<int64_t>(7, 100),
+  });
+  testFused("c0 * c1 + c1", data);
+  testFused("c0 * c1 < c1 - c0", data);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -443,6 +443,55 @@ TEST_P(PeeledEncodingBasicTests, intermidiateLazyLayer) {
   assertEqualVectors(peeledVectors[0], flat1, *translatedRows);
 }
 
+TEST_F(PeeledEncodingTest, sequence) {
+  // Input Vectors: Seq1(Flat1), Seq1(Flat2), Const1
+  // Peeled Vectors: Flat1, Flat2, Const1
+  // peel: Seq1 => converted into a dictionary with one index per run.
+  auto lengths = AlignedBuffer::allocate<SequenceLength>(3, pool());
+  auto rawLengths = lengths->asMutable<SequenceLength>();
+  rawLengths[0] = 4;
+  rawLengths[1] = 1;
+  rawLengths[2] = 5;
+  auto runs1 = makeFlatVector<int32_t>({1, 2, 3});
+  auto runs2 = makeNullableFlatVector<int32_t>({10, std::nullopt, 30});
+  auto input1 = BaseVector::wrapInSequence(lengths, 10, runs1);
+  auto input2 = BaseVector::wrapInSequence(lengths, 10, runs2);
+  auto input3 = makeConstant<int32_t>(7, 10);
+
+  SelectivityVector rows(10);
+  LocalDecodedVector localDecodedVector(execCtx_);
+  std::vector<VectorPtr> peeledVectors;
+  auto peeledEncoding = PeeledEncoding::peel(
+      {input1, input2, input3},
+      rows,
+      localDecodedVector,
+      true,
+      peeledVectors);
+  ASSERT_TRUE(peeledEncoding);
+  ASSERT_EQ(
+      peeledEncoding->wrapEncoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(peeledVectors[0], runs1);
+  ASSERT_EQ(peeledVectors[1], runs2);
+  ASSERT_EQ(peeledVectors[2], input3);
+
+  LocalSelectivityVector innerRowsHolder(execCtx_);
+  auto innerRows = peeledEncoding->translateToInnerRows(rows, innerRowsHolder);
+  ASSERT_EQ(innerRows->size(), 3);
+  ASSERT_EQ(innerRows->countSelected(), 3);
+
+  auto wrapped = peeledEncoding->wrap(INTEGER(), pool(), runs1, rows);
+  assertEqualVectors(
+      makeFlatVector<int32_t>({1, 1, 1, 1, 2, 3, 3, 3, 3, 3}), wrapped);
+
+  // Sequences with different run lengths are not peeled.
+  auto otherLengths = AlignedBuffer::copy(pool(), lengths);
+  auto input4 = BaseVector::wrapInSequence(otherLengths, 10, runs2);
+  peeledVectors.clear();
+  peeledEncoding = PeeledEncoding::peel(
+      {input1, input4}, rows, localDecodedVector, true, peeledVectors);
+  ASSERT_FALSE(peeledEncoding);
+}
+
 TEST_F(PeeledEncodingTest, peelingFails) {
   VectorFuzzer::Options options;
   options.nullRatio = 0.3;
@@ -1542,4 +1542,28 @@ TEST_F(SimpleFunctionTest, noThrow) {
       "Input must not be 6");
 }
 
+TEST_F(SimpleFunctionTest, resolutionCache) {
+  const auto& registry = exec::simpleFunctions();
+  const std::string name = "resolution_cache_test";
+
+  // A failed resolution is not kept across a registration.
+  EXPECT_FALSE(registry.resolveFunction(name, {BIGINT()}).has_value());
+  registerFunction<UnnamedFunction, bool, int64_t>({name});
+  auto resolved = registry.resolveFunction(name, {BIGINT()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(*BOOLEAN(), *resolved->type());
+  EXPECT_FALSE(registry.resolveFunction(name, {INTEGER()}).has_value());
+
+  // Repeated resolutions return the same function.
+  resolved = registry.resolveFunction(name, {BIGINT()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(*BOOLEAN(), *resolved->type());
+
+  // A new signature is visible after it is registered.
+  registerFunction<UnnamedFunction, bool, int32_t>({name});
+  resolved = registry.resolveFunction(name, {INTEGER()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(*BOOLEAN(), *resolved->type());
+}
+
 } // namespace
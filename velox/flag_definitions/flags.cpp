@@ -74,6 +74,22 @@ DEFINE_string(
     "vectors and expression SQL strings. This flag is ignored if "
     "velox_save_input_on_expression_any_failure_path is set.");
 
+// Used in expression/SharedExprMemo.cpp
+
+DEFINE_uint64(
+    velox_shared_expr_memo_capacity_bytes,
+    256 << 20,
+    "Maximum size of the values in the memo of expression results over "
+    "dictionary bases of each query, see expression.shared_memo_enabled");
+
+// Used in connectors/hive/iceberg/DeletionBitmap.cpp
+
+DEFINE_uint64(
+    velox_iceberg_delete_bitmap_cache_capacity_bytes,
+    256 << 20,
+    "Maximum size of the process-wide cache of Iceberg positional delete "
+    "bitmaps, see iceberg.delete-bitmap-cache-enabled");
+
 // TODO: deprecate this once all the memory leak issues have been fixed in
 // existing meta internal use cases.
 DEFINE_bool(
@@ -100,3 +116,11 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+// Used in exec/Driver.cpp
+DEFINE_int32(
+    velox_memory_reservation_threads,
+    4,
+    "Number of threads of the process-wide executor which makes the memory "
+    "reservations of drivers off the driver threads, see "
+    "async_memory_reservation_enabled");
@@ -16,6 +16,7 @@
 
 #include "velox/functions/lib/DateTimeFormatter.h"
 #include <folly/String.h>
+#include <array>
 #include <charconv>
 #include <cstring>
 #include <stdexcept>
@@ -997,8 +998,67 @@ int32_t parseFromPattern(
   return 0;
 }
 
+// "00", "01", ..., "99" without separators.
+constexpr std::array<char, 200> kTwoDigits = [] {
+  std::array<char, 200> digits{};
+  for (auto i = 0; i < 100; ++i) {
+    digits[2 * i] = '0' + i / 10;
+    digits[2 * i + 1] = '0' + i % 10;
+  }
+  return digits;
+}();
+
+// Writes 'value' in [0, 99] as two digits and returns the end of the write.
+inline char* appendTwoDigits(uint32_t value, char* result) {
+  std::memcpy(result, &kTwoDigits[2 * value], 2);
+  return result + 2;
+}
+
+// Returns true if DateTimeFormatter::formatFixedWidth() can format 'tokens'.
+bool isFixedWidthFormat(const std::vector<DateTimeToken>& tokens) {
+  for (const auto& token : tokens) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      continue;
+    }
+    const auto digits = token.pattern.minRepresentDigits;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        if (digits != 4) {
+          return false;
+        }
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+      case DateTimeFormatSpecifier::TIMEZONE_OFFSET_ID:
+        if (digits != 2) {
+          return false;
+        }
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
+DateTimeFormatter::DateTimeFormatter(
+    std::unique_ptr<char[]>&& literalBuf,
+    size_t bufSize,
+    std::vector<DateTimeToken>&& tokens,
+    DateTimeFormatterType type)
+    : literalBuf_(std::move(literalBuf)),
+      bufSize_(bufSize),
+      tokens_(std::move(tokens)),
+      type_(type),
+      fixedWidth_(isFixedWidthFormat(tokens_)) {}
+
 uint32_t DateTimeFormatter::maxResultSize(
     const date::time_zone* timezone) const {
   uint32_t size = 0;
@@ -1092,6 +1152,14 @@ int32_t DateTimeFormatter::format(
 
     offset = t.getSeconds() - utcSeconds;
   }
+  if (fixedWidth_) {
+    const auto resultSize = formatFixedWidth(t, offset, result);
+    if (resultSize >= 0) {
+      VELOX_CHECK_LE(
+          resultSize, maxResultSize, "Bad allocation size for result.");
+      return resultSize;
+    }
+  }
   const auto timePoint = t.toTimePoint(allowOverflow);
   const auto daysTimePoint = date::floor<date::days>(timePoint);
 
@@ -1333,6 +1401,80 @@ int32_t DateTimeFormatter::format(
   return resultSize;
 }
 
+int32_t DateTimeFormatter::formatFixedWidth(
+    const Timestamp& timestamp,
+    int64_t offset,
+    char* result) const {
+  static constexpr int64_t kSecondsInDay = 86'400;
+  auto days = timestamp.getSeconds() / kSecondsInDay;
+  auto secondsInDay = timestamp.getSeconds() % kSecondsInDay;
+  if (secondsInDay < 0) {
+    secondsInDay += kSecondsInDay;
+    --days;
+  }
+  // Years 0 to 9999 are within about 3M days of the epoch. Checking this
+  // first keeps the days within the range of date::days.
+  if (days < -3'000'000 || days > 3'000'000) {
+    return -1;
+  }
+  const date::year_month_day calDate{date::sys_days{date::days(days)}};
+  const auto year = static_cast<int32_t>(calDate.year());
+  if (year < 0 || year > 9999) {
+    return -1;
+  }
+  // Like format(), formats the fraction of second from milliseconds.
+  const auto millis = timestamp.getNanos() / 1'000'000;
+
+  const char* resultStart = result;
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      std::memcpy(result, token.literal.data(), token.literal.size());
+      result += token.literal.size();
+      continue;
+    }
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        result = appendTwoDigits(year / 100, result);
+        result = appendTwoDigits(year % 100, result);
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        result =
+            appendTwoDigits(static_cast<unsigned>(calDate.month()), result);
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        result = appendTwoDigits(static_cast<unsigned>(calDate.day()), result);
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        result = appendTwoDigits(secondsInDay / 3'600, result);
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        result = appendTwoDigits(secondsInDay / 60 % 60, result);
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        result = appendTwoDigits(secondsInDay % 60, result);
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND: {
+        // The leading digits of the milliseconds, padded with zeros.
+        char digits[3];
+        digits[0] = '0' + millis / 100;
+        appendTwoDigits(millis % 100, digits + 1);
+        const auto numDigits = token.pattern.minRepresentDigits;
+        std::memcpy(result, digits, std::min<size_t>(numDigits, 3));
+        if (numDigits > 3) {
+          std::memset(result + 3, '0', numDigits - 3);
+        }
+        result += numDigits;
+      } break;
+      case DateTimeFormatSpecifier::TIMEZONE_OFFSET_ID:
+        result += appendTimezoneOffset(offset, result);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return result - resultStart;
+}
+
 Expected<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input) const {
   Date date;
@@ -1438,6 +1580,22 @@ Expected<DateTimeResult> DateTimeFormatter::parse(
       util::fromDatetime(daysSinceEpoch, microsSinceMidnight), date.timezoneId};
 }
 
+const std::shared_ptr<DateTimeFormatter>& DateTimeFormatterCache::get(
+    std::string_view format) {
+  auto it = formatters_.find(format);
+  if (it != formatters_.end()) {
+    return it->second;
+  }
+  auto formatter = type_ == DateTimeFormatterType::JODA
+      ? buildJodaDateTimeFormatter(format)
+      : buildMysqlDateTimeFormatter(format);
+  if (formatters_.size() >= kMaxEntries) {
+    formatters_.clear();
+  }
+  return formatters_.emplace(std::string(format), std::move(formatter))
+      .first->second;
+}
+
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
     const std::string_view& format) {
   if (format.empty()) {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -156,11 +157,7 @@ class DateTimeFormatter {
       std::unique_ptr<char[]>&& literalBuf,
       size_t bufSize,
       std::vector<DateTimeToken>&& tokens,
-      DateTimeFormatterType type)
-      : literalBuf_(std::move(literalBuf)),
-        bufSize_(bufSize),
-        tokens_(std::move(tokens)),
-        type_(type) {}
+      DateTimeFormatterType type);
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -197,10 +194,42 @@ class DateTimeFormatter {
       bool allowOverflow = false) const;
 
  private:
+  // Formats a timestamp that is already converted to the time zone with
+  // 'offset' seconds from UTC. Used when 'fixedWidth_' is true. Returns -1 if
+  // the year is not in [0, 9999].
+  int32_t formatFixedWidth(
+      const Timestamp& timestamp,
+      int64_t offset,
+      char* result) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+
+  // True if 'tokens_' contain only literals and fixed width numeric fields,
+  // e.g. 'yyyy-MM-dd HH:mm:ss.SSS'. These are formatted without calendar
+  // types, writing two digits at a time from a lookup table.
+  bool fixedWidth_;
+};
+
+/// Builds formatters for the format strings of a function whose format
+/// argument is not constant and keeps them for the rows with the same format.
+/// Not thread-safe. Meant to be a member of a function instance.
+class DateTimeFormatterCache {
+ public:
+  explicit DateTimeFormatterCache(DateTimeFormatterType type) : type_(type) {}
+
+  /// Returns the formatter for 'format'. Throws if 'format' is not valid.
+  const std::shared_ptr<DateTimeFormatter>& get(std::string_view format);
+
+ private:
+  // The cache is cleared when it has this many formatters.
+  static constexpr size_t kMaxEntries = 1'000;
+
+  const DateTimeFormatterType type_;
+  folly::F14FastMap<std::string, std::shared_ptr<DateTimeFormatter>>
+      formatters_;
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <re2/set.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/expression/SimpleFunctionRegistry.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -265,6 +270,70 @@ class Re2Match final : public exec::VectorFunction {
   mutable detail::ReCache cache_;
 };
 
+// Returns the 1-based position of the first of a constant list of patterns
+// that has a partial match in the input or 0 if none does.
+class Re2FirstSearch final : public exec::VectorFunction {
+ public:
+  explicit Re2FirstSearch(const std::vector<std::string>& patterns)
+      : set_(RE2::Quiet, RE2::UNANCHORED) {
+    regexes_.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+      regexes_.push_back(std::make_unique<RE2>(pattern, RE2::Quiet));
+      checkForBadPattern(*regexes_.back());
+      std::string error;
+      VELOX_USER_CHECK_EQ(
+          set_.Add(pattern, &error),
+          static_cast<int>(regexes_.size()) - 1,
+          "invalid regular expression:{}",
+          error);
+    }
+    setCompiled_ = set_.Compile();
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK_EQ(args.size(), 2);
+    context.ensureWritable(rows, INTEGER(), resultRef);
+    auto* result = resultRef->asUnchecked<FlatVector<int32_t>>();
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    std::vector<int> matches;
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
+      result->set(
+          row,
+          firstMatch(
+              toStringPiece(toSearch->valueAt<StringView>(row)), matches));
+    });
+  }
+
+ private:
+  int32_t firstMatch(re2::StringPiece input, std::vector<int>& matches) const {
+    if (setCompiled_) {
+      RE2::Set::ErrorInfo error;
+      if (set_.Match(input, &matches, &error)) {
+        return *std::min_element(matches.begin(), matches.end()) + 1;
+      }
+      if (error.kind == RE2::Set::kNoError) {
+        return 0;
+      }
+    }
+    // The set could not be compiled or ran out of memory for this input.
+    for (auto i = 0; i < regexes_.size(); ++i) {
+      if (RE2::PartialMatch(input, *regexes_[i])) {
+        return i + 1;
+      }
+    }
+    return 0;
+  }
+
+  RE2::Set set_;
+  bool setCompiled_{false};
+  std::vector<std::unique_ptr<RE2>> regexes_;
+};
+
 void checkForBadGroupId(int64_t groupId, const RE2& re) {
   if (UNLIKELY(groupId < 0 || groupId > re.NumberOfCapturingGroups())) {
     VELOX_USER_FAIL("No group {} in regex '{}'", groupId, re.pattern());
@@ -645,9 +714,11 @@ bool matchSuffixPattern(
 bool matchSubstringPattern(
     const StringView& input,
     const std::string& fixedPattern) {
-  return (
-      std::string_view(input).find(std::string_view(fixedPattern)) !=
-      std::string::npos);
+  return simd::simdStrstr(
+             input.data(),
+             input.size(),
+             fixedPattern.data(),
+             fixedPattern.size()) != std::string_view::npos;
 }
 
 // Return true if the input VARCHAR argument is all-ASCII for the specified
@@ -1601,6 +1672,139 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures() {
               .build()};
 }
 
+std::shared_ptr<exec::VectorFunction> makeRe2FirstSearch(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_EQ(inputArgs.size(), 2, "{} requires 2 arguments", name);
+  BaseVector* constantPatterns = inputArgs[1].constantValue.get();
+  VELOX_USER_CHECK(
+      constantPatterns != nullptr && !constantPatterns->isNullAt(0),
+      "{} requires a constant non-null array of patterns",
+      name);
+
+  auto* constant = constantPatterns->as<ConstantVector<ComplexType>>();
+  auto* arrays = constant->valueVector()->as<ArrayVector>();
+  const auto index = constant->index();
+  DecodedVector elements(*arrays->elements());
+  std::vector<std::string> patterns;
+  patterns.reserve(arrays->sizeAt(index));
+  for (auto i = 0; i < arrays->sizeAt(index); ++i) {
+    const auto element = arrays->offsetAt(index) + i;
+    VELOX_USER_CHECK(
+        !elements.isNullAt(element), "{} requires non-null patterns", name);
+    patterns.push_back(std::string(elements.valueAt<StringView>(element)));
+  }
+  return std::make_shared<Re2FirstSearch>(patterns);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+re2FirstSearchSignatures() {
+  // varchar, array(varchar) -> integer
+  return {exec::FunctionSignatureBuilder()
+              .returnType("integer")
+              .argumentType("varchar")
+              .constantArgumentType("array(varchar)")
+              .build()};
+}
+
+namespace {
+
+// Returns the constant pattern if 'condition' is a 'searchName'(x, pattern)
+// call with a valid constant pattern and x equal to 'input'. Sets 'input' to
+// x if 'input' is null.
+std::optional<std::string> asConstantSearch(
+    const std::string& searchName,
+    const core::TypedExprPtr& condition,
+    core::TypedExprPtr& input) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(condition.get());
+  if (call == nullptr || call->name() != searchName ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto* pattern =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (pattern == nullptr || !pattern->type()->isVarchar() ||
+      pattern->hasValueVector() || pattern->value().isNull()) {
+    return std::nullopt;
+  }
+  if (input != nullptr && !(*input == *call->inputs()[0])) {
+    return std::nullopt;
+  }
+
+  auto value = pattern->value().value<TypeKind::VARCHAR>();
+  // Leave invalid patterns to 'searchName' so that the errors are unchanged.
+  if (!RE2(value, RE2::Quiet).ok()) {
+    return std::nullopt;
+  }
+  if (input == nullptr) {
+    input = call->inputs()[0];
+  }
+  return value;
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteRegexpLikeSwitch(
+    const std::string& searchName,
+    const std::string& eqName,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != "switch") {
+    return nullptr;
+  }
+
+  const auto& inputs = call->inputs();
+  const auto numCases = inputs.size() / 2;
+  core::TypedExprPtr input;
+  std::vector<variant> patterns;
+  for (auto i = 0; i < numCases; ++i) {
+    auto pattern = asConstantSearch(searchName, inputs[2 * i], input);
+    if (!pattern.has_value()) {
+      break;
+    }
+    patterns.emplace_back(std::move(pattern.value()));
+  }
+  if (patterns.size() < kMinRe2FirstSearchPatterns) {
+    return nullptr;
+  }
+  // The comparison functions may not be registered, e.g. in tests that
+  // register only the string functions.
+  if (!exec::getVectorFunctionSignatures(eqName).has_value() &&
+      !exec::simpleFunctions()
+           .resolveFunction(eqName, {INTEGER(), INTEGER()})
+           .has_value()) {
+    return nullptr;
+  }
+
+  const auto numPatterns = patterns.size();
+  auto firstMatch = std::make_shared<core::CallTypedExpr>(
+      INTEGER(),
+      std::vector<core::TypedExprPtr>{
+          input,
+          std::make_shared<core::ConstantTypedExpr>(
+              ARRAY(VARCHAR()), variant::array(std::move(patterns)))},
+      kRe2FirstSearchName);
+
+  std::vector<core::TypedExprPtr> rewrittenInputs;
+  rewrittenInputs.reserve(inputs.size());
+  for (auto i = 0; i < numPatterns; ++i) {
+    rewrittenInputs.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            firstMatch,
+            std::make_shared<core::ConstantTypedExpr>(
+                INTEGER(), variant(static_cast<int32_t>(i + 1)))},
+        eqName));
+    rewrittenInputs.push_back(inputs[2 * i + 1]);
+  }
+  for (auto i = 2 * numPatterns; i < inputs.size(); ++i) {
+    rewrittenInputs.push_back(inputs[i]);
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      call->type(), std::move(rewrittenInputs), call->name());
+}
+
 std::shared_ptr<exec::VectorFunction> makeRe2Extract(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
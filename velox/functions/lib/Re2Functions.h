@@ -173,6 +173,51 @@ std::shared_ptr<exec::VectorFunction> makeRe2Search(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures();
 
+/// Name of the internal function created by rewriteRegexpLikeSwitch.
+constexpr const char* kRe2FirstSearchName = "$internal$re2_first_search";
+
+/// re2FirstSearch(string, patterns) → integer
+///
+/// Returns the 1-based position of the first pattern in the constant array
+/// 'patterns' that re2Search would match in str or 0 if there is none. All
+/// patterns are matched in a single scan of str with an RE2::Set. If the
+/// set runs out of memory for an input, the patterns are tried one by one.
+/// If a pattern is invalid, throws an exception.
+std::shared_ptr<exec::VectorFunction> makeRe2FirstSearch(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+re2FirstSearchSignatures();
+
+/// Minimum number of patterns worth matching with re2FirstSearch.
+constexpr size_t kMinRe2FirstSearchPatterns = 3;
+
+/// Rewrites a CASE expression whose leading conditions are 'searchName'(x,
+/// 'pattern') calls over the same x and valid constant patterns, e.g.
+///
+///     CASE WHEN regexp_like(x, 'p1') THEN r1 WHEN regexp_like(x, 'p2') THEN r2
+///       ... WHEN <other condition> THEN rn ELSE e END
+///
+/// into
+///
+///     CASE WHEN eq(i, 1) THEN r1 WHEN eq(i, 2) THEN r2
+///       ... WHEN <other condition> THEN rn ELSE e END
+///
+/// where i is the common subexpression re2FirstSearch(x, ARRAY['p1', 'p2',
+/// ...]). This replaces one regex match per condition and row with one
+/// RE2::Set scan per row. Conditions after the first one that does not fit
+/// are kept. 'eqName' is the name of the equality function to use.
+///
+/// Returns nullptr if 'expr' is not such a CASE expression, if fewer than
+/// 'kMinRe2FirstSearchPatterns' leading conditions fit or if 'eqName' is not
+/// registered.
+core::TypedExprPtr rewriteRegexpLikeSwitch(
+    const std::string& searchName,
+    const std::string& eqName,
+    const core::TypedExprPtr& expr);
+
 /// re2Extract(string, pattern, group_id) → string
 /// re2Extract(string, pattern) → string
 ///
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::functions {
+
+/// A set of at most kCapacity values of a primitive type stored inline. A
+/// lookup compares the value with all the elements. For the elements of a
+/// short array this is cheaper than hashing and the comparisons vectorize.
+/// Clearing the set is free. Has the subset of the interface of
+/// util::floating_point::HashSetNaNAware used by the array set functions and,
+/// like it, treats all NaNs as equal.
+template <typename T>
+class SmallValueSet {
+ public:
+  static constexpr int32_t kCapacity = 32;
+
+  size_t count(const T& value) const {
+    bool found = false;
+    for (auto i = 0; i < size_; ++i) {
+      found |= equals(values_[i], value);
+    }
+    return found;
+  }
+
+  /// Adds 'value' unless it is already in the set. Returns a pointer to the
+  /// value in the set and true if 'value' was added. The caller must not add
+  /// more than kCapacity distinct values.
+  std::pair<const T*, bool> insert(const T& value) {
+    for (auto i = 0; i < size_; ++i) {
+      if (equals(values_[i], value)) {
+        return {&values_[i], false};
+      }
+    }
+    VELOX_DCHECK_LT(size_, kCapacity);
+    values_[size_] = value;
+    return {&values_[size_++], true};
+  }
+
+  void clear() {
+    size_ = 0;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  static bool equals(const T& left, const T& right) {
+    if constexpr (std::is_floating_point_v<T>) {
+      // Non-short-circuit form of NaNAwareEquals so that count() vectorizes.
+      return (left == right) | (std::isnan(left) & std::isnan(right));
+    } else {
+      return left == right;
+    }
+  }
+
+  T values_[kCapacity];
+  int32_t size_{0};
+};
+
+} // namespace facebook::velox::functions
@@ -52,6 +52,73 @@ struct SimpleType<TypeKind::VARCHAR> {
   using type = Varchar;
 };
 
+// Maps with fewer entries are searched linearly.
+constexpr vector_size_t kMinCachedMapSize = 100;
+
+// Hash tables over the keys of all maps with at least kMinCachedMapSize
+// entries in a MapVector. Cached on the MapVector so that several lookups
+// into the same batch, e.g. m['a'], m['b'] and m['c'], build them once.
+template <TypeKind kind>
+class MapKeyIndex : public MapVector::KeyIndex {
+ public:
+  // Makes an empty index that marks the MapVector as looked up once.
+  MapKeyIndex() = default;
+
+  MapKeyIndex(const MapVector& map, const DecodedVector& keys)
+      : table_(std::make_unique<LookupTable<kind>>(*map.pool())) {
+    using TKey = typename TypeTraits<kind>::NativeType;
+    const auto* rawSizes = map.rawSizes();
+    const auto* rawOffsets = map.rawOffsets();
+    for (vector_size_t i = 0; i < map.size(); ++i) {
+      if (rawSizes[i] < kMinCachedMapSize || map.isNullAt(i)) {
+        continue;
+      }
+      table_->ensureMapAtIndex(i);
+      auto& keyMap = table_->getMapAtIndex(i);
+      keyMap.reserve(rawSizes[i]);
+      const auto end = rawOffsets[i] + rawSizes[i];
+      for (auto offset = rawOffsets[i]; offset < end; ++offset) {
+        keyMap.emplace(keys.valueAt<TKey>(offset), offset);
+      }
+    }
+  }
+
+  // nullptr for the empty index.
+  const LookupTable<kind>* table() const {
+    return table_.get();
+  }
+
+ private:
+  const std::unique_ptr<LookupTable<kind>> table_;
+};
+
+// Returns the key index cached on 'map', building it if needed, or nullptr
+// if lookups into 'map' should search linearly. The first lookup into a
+// MapVector only leaves an empty index behind, so that a single lookup per
+// map does not pay for building hash tables. The second builds them.
+template <TypeKind kind>
+std::shared_ptr<MapKeyIndex<kind>> sharedKeyIndex(
+    const MapVector& map,
+    const DecodedVector& keys) {
+  if constexpr (kind == TypeKind::BOOLEAN) {
+    return nullptr;
+  } else {
+    if (map.mapKeys()->size() < kMinCachedMapSize) {
+      return nullptr;
+    }
+    auto index = std::dynamic_pointer_cast<MapKeyIndex<kind>>(map.keyIndex());
+    if (index == nullptr) {
+      map.setKeyIndex(std::make_shared<MapKeyIndex<kind>>());
+      return nullptr;
+    }
+    if (index->table() == nullptr) {
+      index = std::make_shared<MapKeyIndex<kind>>(map, keys);
+      map.setKeyIndex(index);
+    }
+    return index;
+  }
+}
+
 /// Decode arguments and transform result into a dictionaryVector where the
 /// dictionary maintains a mapping from a given row to the index of the input
 /// map value vector. This allows us to ensure that element_at is zero-copy.
@@ -63,7 +130,6 @@ VectorPtr applyMapTyped(
     const VectorPtr& mapArg,
     const VectorPtr& indexArg,
     exec::EvalCtx& context) {
-  static constexpr vector_size_t kMinCachedMapSize = 100;
   using TKey = typename TypeTraits<kind>::NativeType;
 
   LookupTable<kind>* typedLookupTable = nullptr;
@@ -104,6 +170,13 @@ VectorPtr applyMapTyped(
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
+  // Hash tables shared with other lookups into the same batch. Not needed
+  // when the table cached across batches is used.
+  std::shared_ptr<MapKeyIndex<kind>> keyIndex;
+  if (!triggerCaching) {
+    keyIndex = sharedKeyIndex<kind>(*baseMap, *decodedMapKeys);
+  }
+
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
     size_t mapIndex = mapIndices[row];
@@ -134,6 +207,13 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (keyIndex != nullptr && size >= kMinCachedMapSize) {
+      // Fast lookup in the tables shared with other lookups into the batch.
+      auto offset = keyIndex->table()->find(mapIndex, searchKey);
+      if (offset >= 0) {
+        rawIndices[row] = offset;
+        found = true;
+      }
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
@@ -74,6 +74,17 @@ class LookupTable : public LookupTableBase {
     return map_->find(rowIndex)->second;
   }
 
+  /// Returns the offset of 'key' in the map at 'rowIndex' or -1 if the map
+  /// does not contain 'key' or is not in the table.
+  vector_size_t find(vector_size_t rowIndex, key_t key) const {
+    auto it = map_->find(rowIndex);
+    if (it == map_->end()) {
+      return -1;
+    }
+    auto value = it->second.find(key);
+    return value == it->second.end() ? -1 : value->second;
+  }
+
  private:
   using inner_allocator_t =
       memory::StlAllocator<std::pair<key_t const, vector_size_t>>;
@@ -196,6 +196,33 @@ class AverageAggregateBase : public exec::Aggregate {
     }
   }
 
+  bool supportsRetract() const override {
+    return true;
+  }
+
+  bool retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    decodedRaw_.decode(*args[0], rows);
+    auto* sumCount = accumulator(group);
+    return rows.testSelected([&](vector_size_t i) {
+      if (decodedRaw_.isNullAt(i)) {
+        return true;
+      }
+      const TAccumulator value(decodedRaw_.valueAt<TInput>(i));
+      if constexpr (std::is_floating_point_v<TAccumulator>) {
+        // Inf - Inf is NaN.
+        if (!std::isfinite(value) || !std::isfinite(sumCount->sum)) {
+          return false;
+        }
+      }
+      sumCount->sum -= value;
+      --sumCount->count;
+      return true;
+    });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -138,10 +138,12 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      if (!sumAllRows(data, rows, accumulator)) {
+        rows.applyToSelected([&](vector_size_t i) {
+          accumulator.overflow += DecimalUtil::addWithOverflow(
+              accumulator.sum, data[i], accumulator.sum);
+        });
+      }
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -328,6 +330,29 @@ class DecimalAggregate : public exec::Aggregate {
   }
 
  private:
+  // Sums the short decimals in 'data' at 'rows' into 'accumulator' if all rows
+  // in the range of 'rows' are selected. The sum of short decimals fits in 128
+  // bits and needs no overflow tracking. Returns false if the values are not
+  // summed.
+  static bool sumAllRows(
+      const int64_t* data,
+      const SelectivityVector& rows,
+      LongDecimalWithOverflowState& accumulator) {
+    if (!rows.isAllSelected()) {
+      return false;
+    }
+    accumulator.sum = DecimalUtil::sumShortDecimals(
+        data + rows.begin(), rows.end() - rows.begin());
+    return true;
+  }
+
+  static bool sumAllRows(
+      const int128_t* /*data*/,
+      const SelectivityVector& /*rows*/,
+      LongDecimalWithOverflowState& /*accumulator*/) {
+    return false;
+  }
+
   inline LongDecimalWithOverflowState* decimalAccumulator(char* group) {
     return exec::Aggregate::value<LongDecimalWithOverflowState>(group);
   }
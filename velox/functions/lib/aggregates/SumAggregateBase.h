@@ -110,6 +110,23 @@ class SumAggregateBase
         TAccumulator(0));
   }
 
+  bool supportsRetract() const override {
+    return true;
+  }
+
+  bool retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    DecodedVector decoded(*args[0], rows);
+    auto& sum = *exec::Aggregate::value<TAccumulator>(group);
+    return rows.testSelected([&](vector_size_t row) {
+      return decoded.isNullAt(row) ||
+          retractSingleValue(
+                 sum, TAccumulator(decoded.valueAt<TInput>(row)));
+    });
+  }
+
  protected:
   // TData is used to store the updated sum state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
@@ -173,6 +190,27 @@ class SumAggregateBase
     }
   }
 
+  // Subtracts 'value' from 'result'. Returns false if the result is not exact,
+  // i.e. on an integer overflow or if 'value' or 'result' is infinite or NaN.
+  template <typename TData>
+#if defined(FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER)
+  FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER("signed-integer-overflow")
+#endif
+  static bool retractSingleValue(TData& result, TData value) {
+    if constexpr (std::is_floating_point_v<TData>) {
+      if (!std::isfinite(value) || !std::isfinite(result)) {
+        return false;
+      }
+      result -= value;
+      return true;
+    } else if constexpr (std::is_same_v<TData, int64_t> && Overflow) {
+      result -= value;
+      return true;
+    } else {
+      return !__builtin_sub_overflow(result, value, &result);
+    }
+  }
+
   // Disable undefined behavior sanitizer to not fail on signed integer
   // overflow.
   template <typename TData>
@@ -88,6 +88,47 @@ void ValueList::appendValue(
   }
 }
 
+void ValueList::appendValues(
+    const DecodedVector& decoded,
+    folly::Range<const vector_size_t*> rows,
+    HashStringAllocator* allocator) {
+  if (rows.empty()) {
+    return;
+  }
+
+  // Sets the null flags first. Writing a full word of flags is a write of its
+  // own, which cannot overlap with the write of the values.
+  bool hasNonNull = false;
+  for (auto row : rows) {
+    prepareAppend(allocator);
+    if (decoded.isNullAt(row)) {
+      lastNulls_ |= 1UL << (size_ % 64);
+    } else {
+      hasNonNull = true;
+    }
+    ++size_;
+  }
+  if (!hasNonNull) {
+    return;
+  }
+
+  const auto& base = *decoded.base();
+  ByteOutputStream stream(allocator);
+  allocator->extendWrite(dataCurrent_, stream);
+  // The stream may have a tail of a previous write.
+  const auto initialSize = stream.size();
+  static const exec::ContainerRowSerdeOptions options{};
+  for (auto row : rows) {
+    if (!decoded.isNullAt(row)) {
+      exec::ContainerRowSerde::serialize(
+          base, decoded.index(row), stream, options);
+    }
+  }
+  bytes_ += stream.size() - initialSize;
+  dataCurrent_ =
+      allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024)).second;
+}
+
 void ValueList::appendRange(
     const VectorPtr& vector,
     vector_size_t offset,
@@ -47,6 +47,14 @@ class ValueList {
     }
   }
 
+  /// Same as calling appendValue() for each of 'rows' but serializes all
+  /// non-null values with one write, so that their space is allocated in
+  /// larger pieces.
+  void appendValues(
+      const DecodedVector& decoded,
+      folly::Range<const vector_size_t*> rows,
+      HashStringAllocator* allocator);
+
   void appendRange(
       const VectorPtr& vector,
       vector_size_t offset,
@@ -116,6 +124,31 @@ class ValueList {
   uint64_t lastNulls_{0};
 };
 
+// Reorders 'rows' so that the rows of each group in 'groups' are adjacent and
+// calls 'func(group, groupRows)' for each group with the range of its rows.
+// The order of the rows of a group is kept. Used for adding the values of a
+// group with one appendValues() call.
+template <typename Func>
+void forEachGroup(
+    char* const* groups,
+    std::vector<vector_size_t>& rows,
+    Func func) {
+  std::stable_sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+    return groups[left] < groups[right];
+  });
+  for (auto begin = 0; begin < rows.size();) {
+    auto* group = groups[rows[begin]];
+    auto end = begin + 1;
+    while (end < rows.size() && groups[rows[end]] == group) {
+      ++end;
+    }
+    func(
+        group,
+        folly::Range<const vector_size_t*>(rows.data() + begin, end - begin));
+    begin = end;
+  }
+}
+
 // Extracts values from the ValueList into provided vector.
 class ValueListReader {
  public:
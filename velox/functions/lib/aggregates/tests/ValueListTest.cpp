@@ -62,6 +62,27 @@ class ValueListTest : public functions::test::FunctionBaseTest {
       assertEqualVectors(data, result);
     }
 
+    // Use ValueList::appendValues in batches of up to 100 rows.
+    {
+      DecodedVector decoded(*data);
+      std::vector<vector_size_t> rows(size);
+      std::iota(rows.begin(), rows.end(), 0);
+      aggregate::ValueList values;
+      for (auto i = 0; i < size; i += 100) {
+        const auto end = std::min<vector_size_t>(i + 100, size);
+        values.appendValues(
+            decoded,
+            folly::Range<const vector_size_t*>(
+                rows.data() + i, rows.data() + end),
+            allocator());
+      }
+
+      ASSERT_EQ(size, values.size());
+      auto result = read(values, data->type(), size);
+
+      assertEqualVectors(data, result);
+    }
+
     // Use ValueList::appendRange.
     {
       aggregate::ValueList values;
@@ -141,3 +162,66 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, forEachGroup) {
+  // Rows of 3 groups interleaved. Rows of a group keep their order.
+  char groupStorage[3];
+  std::vector<char*> groups;
+  for (auto i = 0; i < 10; ++i) {
+    groups.push_back(&groupStorage[(i * 7) % 3]);
+  }
+  std::vector<vector_size_t> rows{0, 1, 2, 4, 5, 6, 7, 9};
+  std::unordered_map<char*, std::vector<vector_size_t>> groupRows;
+  aggregate::forEachGroup(groups.data(), rows, [&](char* group, auto range) {
+    ASSERT_EQ(groupRows.count(group), 0);
+    groupRows[group] = {range.begin(), range.end()};
+  });
+  ASSERT_EQ(groupRows.size(), 3);
+  for (auto& [group, groupRowList] : groupRows) {
+    std::vector<vector_size_t> expected;
+    for (auto row : {0, 1, 2, 4, 5, 6, 7, 9}) {
+      if (groups[row] == group) {
+        expected.push_back(row);
+      }
+    }
+    EXPECT_EQ(groupRowList, expected);
+  }
+}
+
+TEST_F(ValueListTest, appendValuesInterleaved) {
+  // Appends to two lists in turn so that the writes of each list are not
+  // contiguous in the allocator.
+  auto data = makeFlatVector<std::string>(
+      1'000,
+      [](auto row) { return std::string(row % 50, 'a' + row % 26); },
+      test::VectorMaker::nullEvery(7));
+  DecodedVector decoded(*data);
+  aggregate::ValueList even;
+  aggregate::ValueList odd;
+  std::vector<vector_size_t> evenRows;
+  std::vector<vector_size_t> oddRows;
+  for (auto i = 0; i < data->size(); i += 10) {
+    evenRows.clear();
+    oddRows.clear();
+    for (auto row = i; row < i + 10; ++row) {
+      (row % 2 == 0 ? evenRows : oddRows).push_back(row);
+    }
+    even.appendValues(
+        decoded,
+        folly::Range<const vector_size_t*>(evenRows.data(), evenRows.size()),
+        allocator());
+    odd.appendValues(
+        decoded,
+        folly::Range<const vector_size_t*>(oddRows.data(), oddRows.size()),
+        allocator());
+  }
+
+  ASSERT_EQ(even.size(), 500);
+  ASSERT_EQ(odd.size(), 500);
+  auto evenData = wrapInDictionary(
+      makeIndices(500, [](auto row) { return row * 2; }), data);
+  auto oddData = wrapInDictionary(
+      makeIndices(500, [](auto row) { return row * 2 + 1; }), data);
+  assertEqualVectors(evenData, read(even, VARCHAR(), 500));
+  assertEqualVectors(oddData, read(odd, VARCHAR(), 500));
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <iostream>
 #include <random>
 
 #include <folly/Benchmark.h>
@@ -22,6 +23,7 @@
 #include <folly/Random.h>
 #include <folly/portability/GFlags.h>
 #include <folly/stats/TDigest.h>
+#include <fmt/format.h>
 
 #include "velox/functions/lib/KllSketch.h"
 
@@ -121,6 +123,84 @@ void mergeKllSketch(int iters, int maxSize, int count) {
   }
 }
 
+// Same as mergeKllSketch but merges the sketches one at a time, like a final
+// aggregation that sees the partial states of a group in separate rows.
+void mergeKllSketchOneByOne(int iters, int maxSize, int count) {
+  std::vector<KllSketch<double>> sketches;
+  BENCHMARK_SUSPEND {
+    std::vector<double> values;
+    for (int i = 0; i < count; ++i) {
+      populateValues(maxSize, values);
+      KllSketch<double> kll;
+      for (auto v : values) {
+        kll.insert(v);
+      }
+      sketches.push_back(std::move(kll));
+      values.clear();
+    }
+  }
+  for (int i = 0; i < iters; ++i) {
+    for (int j = 1; j < count; ++j) {
+      sketches[0].merge(sketches[j]);
+    }
+  }
+}
+
+// Prints the max rank error over 99 percentiles and the serialized size of a
+// t-digest and a KLL sketch made by merging 'count' digests of 'size' uniform
+// random values each.
+void printAccuracyAndSize(int size, int count) {
+  std::vector<double> values;
+  std::vector<double> allValues;
+  std::vector<folly::TDigest> digests;
+  std::vector<KllSketch<double>> sketches;
+  for (int i = 0; i < count; ++i) {
+    populateValues(size, values);
+    allValues.insert(allValues.end(), values.begin(), values.end());
+    digests.push_back(folly::TDigest().merge(values));
+    KllSketch<double> kll;
+    for (auto v : values) {
+      kll.insert(v);
+    }
+    sketches.push_back(std::move(kll));
+  }
+  auto digest = folly::TDigest::merge(digests);
+  auto& sketch = sketches[0];
+  sketch.merge(folly::Range(&sketches[1], count - 1));
+  sketch.compact();
+  sketch.finish();
+  std::sort(allValues.begin(), allValues.end());
+
+  auto rankError = [&](double quantile, double estimate) {
+    auto rank = std::lower_bound(allValues.begin(), allValues.end(), estimate) -
+        allValues.begin();
+    return std::abs(static_cast<double>(rank) / allValues.size() - quantile);
+  };
+  double digestError = 0;
+  double sketchError = 0;
+  for (int i = 1; i < 100; ++i) {
+    const double quantile = i / 100.0;
+    digestError = std::max(
+        digestError, rankError(quantile, digest.estimateQuantile(quantile)));
+    sketchError = std::max(
+        sketchError, rankError(quantile, sketch.estimateQuantile(quantile)));
+  }
+  // A t-digest serializes the mean and weight of each centroid plus sum,
+  // count, min and max.
+  const auto digestBytes =
+      digest.getCentroids().size() * 2 * sizeof(double) + 4 * sizeof(double);
+  std::cout << fmt::format(
+                   "{}x{}: t-digest max rank error {:.5f}, {} bytes; "
+                   "KLL max rank error {:.5f}, {} bytes",
+                   size,
+                   count,
+                   digestError,
+                   digestBytes,
+                   sketchError,
+                   sketch.serializedByteSize())
+            << std::endl;
+}
+
 #define DEFINE_WITH_TYPE(name, type)  \
   int name##_##type(int, int iters) { \
     return name<type>(iters);         \
@@ -156,6 +236,11 @@ BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x40, 1e6, 40);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x40, 1e6, 40);
 BENCHMARK_NAMED_PARAM(mergeTDigest, 1e6x80, 1e6, 80);
 BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e6x80, 1e6, 80);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(mergeKllSketchOneByOne, 1e4x100, 1e4, 100);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e4x100, 1e4, 100);
+BENCHMARK_NAMED_PARAM(mergeKllSketchOneByOne, 1e4x1000, 1e4, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(mergeKllSketch, 1e4x1000, 1e4, 1000);
 
 // ============================================================================
 // [...]chmarks/ApproxPercentileBenchmark.cpp     relative  time/iter   iters/s
@@ -191,5 +276,8 @@ int main(int argc, char* argv[]) {
   folly::Init init{&argc, &argv};
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   folly::runBenchmarks();
+  for (auto count : {10, 100, 1000}) {
+    facebook::velox::functions::kll::test::printAccuracyAndSize(10'000, count);
+  }
   return 0;
 }
@@ -1334,6 +1334,67 @@ TEST_F(JodaDateTimeFormatterTest, formatResultSize) {
   EXPECT_EQ(buildJodaDateTimeFormatter("CCCC")->maxResultSize(timezone), 4);
 }
 
+// Patterns of fixed width numeric fields are formatted on a separate path for
+// years 0 to 9999.
+TEST_F(JodaDateTimeFormatterTest, formatFixedWidth) {
+  auto format = [](const std::string& pattern,
+                   const Timestamp& timestamp,
+                   const std::string& timezone = "GMT") {
+    auto formatter = buildJodaDateTimeFormatter(pattern);
+    auto* zone = date::locate_zone(timezone);
+    const auto maxSize = formatter->maxResultSize(zone);
+    std::string result(maxSize, '\0');
+    result.resize(formatter->format(timestamp, zone, maxSize, result.data()));
+    return result;
+  };
+
+  const std::string pattern = "yyyy-MM-dd HH:mm:ss.SSS";
+  EXPECT_EQ(format(pattern, Timestamp(0, 0)), "1970-01-01 00:00:00.000");
+  EXPECT_EQ(
+      format(pattern, Timestamp(-1, 999'000'000)), "1969-12-31 23:59:59.999");
+  EXPECT_EQ(
+      format(pattern, Timestamp(951'786'123, 45'678'000)),
+      "2000-02-29 01:02:03.045");
+  EXPECT_EQ(
+      format(pattern, Timestamp(-62'167'219'200, 0)),
+      "0000-01-01 00:00:00.000");
+  EXPECT_EQ(
+      format(pattern, Timestamp(253'402'300'799, 0)),
+      "9999-12-31 23:59:59.000");
+
+  // Years outside of [0, 9999] are formatted on the general path.
+  EXPECT_EQ(
+      format(pattern, Timestamp(-62'198'755'200, 0)),
+      "-0001-01-01 00:00:00.000");
+  EXPECT_EQ(
+      format(pattern, Timestamp(253'402'300'800, 0)),
+      "10000-01-01 00:00:00.000");
+
+  // Fractions of other widths and time zone offsets.
+  EXPECT_EQ(
+      format("yyyyMMdd'T'HHmmss.S", Timestamp(951'786'123, 987'000'000)),
+      "20000229T010203.9");
+  EXPECT_EQ(
+      format("HH:mm:ss.SSSSSS", Timestamp(951'786'123, 987'000'000)),
+      "01:02:03.987000");
+  EXPECT_EQ(
+      format(
+          "yyyy-MM-dd'T'HH:mm:ss.SSSZZ",
+          Timestamp(1'719'835'200, 0),
+          "America/Los_Angeles"),
+      "2024-07-01T05:00:00.000-07:00");
+}
+
+TEST_F(JodaDateTimeFormatterTest, formatterCache) {
+  DateTimeFormatterCache cache(DateTimeFormatterType::JODA);
+  auto first = cache.get("yyyy-MM-dd");
+  auto second = cache.get("HH:mm:ss");
+  EXPECT_NE(first, second);
+  EXPECT_EQ(cache.get("yyyy-MM-dd"), first);
+  EXPECT_EQ(cache.get("HH:mm:ss"), second);
+  VELOX_ASSERT_THROW(cache.get("'"), "No closing single quote for literal");
+}
+
 TEST_F(JodaDateTimeFormatterTest, betterErrorMessaging) {
   VELOX_ASSERT_THROW(
       parseJoda("2057-02-29T14:48:14.891Z", "yyyy-MM-dd'T'HH:mm:ss.SSSZ"),
@@ -24,6 +24,7 @@
 
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/parse/TypeResolver.h"
 #include "velox/type/StringView.h"
@@ -337,6 +338,74 @@ TEST_F(Re2FunctionsTest, regexSearchBatch) {
   re2Search.testBatchAll();
 }
 
+TEST_F(Re2FunctionsTest, regexSearchSwitch) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"error: disk full",
+           "warn: slow",
+           "error: timeout",
+           "info",
+           std::nullopt,
+           "debug: warn",
+           "fatal"}),
+      makeFlatVector<int32_t>({1, 2, 3, 4, 5, 6, 7}),
+  });
+  auto rowType = asRowType(data->type());
+
+  // The leading regexp_like conditions are matched with one RE2::Set. The
+  // first matching pattern wins and the other conditions are kept.
+  const std::string expression =
+      "CASE WHEN regexp_like(c0, '^error.*full') THEN 'disk' "
+      "WHEN regexp_like(c0, 'error') THEN 'error' "
+      "WHEN regexp_like(c0, 'warn') THEN 'warn' "
+      "WHEN regexp_like(c0, '^debug') THEN 'debug' "
+      "WHEN c1 > 6 THEN 'other' "
+      "ELSE 'none' END";
+  auto exprSet = compileExpression(expression, rowType);
+  ASSERT_NE(exprSet->toString().find(kRe2FirstSearchName), std::string::npos);
+  auto expected = makeFlatVector<std::string>(
+      {"disk", "warn", "error", "none", "none", "warn", "other"});
+  assertEqualVectors(expected, evaluate(expression, data));
+
+  // A subset of the rows.
+  SelectivityVector rows(data->size(), false);
+  rows.setValid(1, true);
+  rows.setValid(5, true);
+  rows.updateBounds();
+  assertEqualVectors(expected, evaluate(expression, data, rows), rows);
+
+  // Conditions on other inputs end the chain.
+  exprSet = compileExpression(
+      "CASE WHEN regexp_like(c0, 'error') THEN 1 "
+      "WHEN regexp_like(c0, 'warn') THEN 2 "
+      "WHEN regexp_like(upper(c0), 'DEBUG') THEN 3 END",
+      rowType);
+  ASSERT_EQ(exprSet->toString().find(kRe2FirstSearchName), std::string::npos);
+
+  // Invalid patterns end the chain and fail as before.
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "CASE WHEN regexp_like(c0, 'error') THEN 1 "
+          "WHEN regexp_like(c0, 'warn') THEN 2 "
+          "WHEN regexp_like(c0, 'debug') THEN 3 "
+          "WHEN regexp_like(c0, '*') THEN 4 END",
+          data),
+      "invalid regular expression");
+}
+
+TEST_F(Re2FunctionsTest, regexSearchSwitchRegisteredOnce) {
+  // The string functions are already registered by SetUpTestCase().
+  const auto numRewrites = exec::expressionRewrites().size();
+  functions::prestosql::registerStringFunctions();
+  ASSERT_EQ(exec::expressionRewrites().size(), numRewrites);
+
+  // A new prefix gets a rewrite of its own.
+  functions::prestosql::registerStringFunctions("re2_test_");
+  ASSERT_EQ(exec::expressionRewrites().size(), numRewrites + 1);
+  functions::prestosql::registerStringFunctions("re2_test_");
+  ASSERT_EQ(exec::expressionRewrites().size(), numRewrites + 1);
+}
+
 template <typename F>
 void testRe2Extract(F&& regexExtract) {
   // Regex with no subgroup matches.
@@ -916,6 +985,13 @@ TEST_F(Re2FunctionsTest, likeSubstringPattern) {
       generateString(kAnyWildcardCharacter) + input +
           generateString(kAnyWildcardCharacter),
       true);
+
+  // Inputs longer than a SIMD width with the match at either end.
+  const std::string filler(100, 'x');
+  testLike("green" + filler, "%green%", true);
+  testLike(filler + "green", "%green%", true);
+  testLike(filler + "gree" + filler + "n", "%green%", false);
+  testLike(filler + "g" + filler + "een", "%green%", false);
 }
 
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
@@ -73,6 +73,12 @@ class NthValueFunction : public exec::WindowFunction {
     partitionOffset_ = 0;
   }
 
+  std::optional<RowsAccess> rowsAccess() const override {
+    RowsAccess access;
+    access.readsFrames = true;
+    return access;
+  }
+
   void apply(
       const BufferPtr& /*peerGroupStarts*/,
       const BufferPtr& /*peerGroupEnds*/,
@@ -43,6 +43,15 @@ class RankFunction : public exec::WindowFunction {
     numPartitionRows_ = partition->numRows();
   }
 
+  std::optional<RowsAccess> rowsAccess() const override {
+    // percent_rank depends on the number of rows of the partition.
+    if constexpr (TRank == RankType::kPercentRank) {
+      return std::nullopt;
+    } else {
+      return RowsAccess{};
+    }
+  }
+
   void apply(
       const BufferPtr& peerGroupStarts,
       const BufferPtr& /*peerGroupEnds*/,
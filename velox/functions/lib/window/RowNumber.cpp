@@ -32,6 +32,10 @@ class RowNumberFunction : public exec::WindowFunction {
     rowNumber_ = 1;
   }
 
+  std::optional<RowsAccess> rowsAccess() const override {
+    return RowsAccess{};
+  }
+
   void apply(
       const BufferPtr& peerGroupStarts,
       const BufferPtr& /*peerGroupEnds*/,
@@ -18,6 +18,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SmallValueSet.h"
 #include "velox/type/FloatingPointUtil.h"
 
 namespace facebook::velox::functions {
@@ -27,12 +28,26 @@ template <typename T>
 struct ValueSet {
   util::floating_point::HashSetNaNAware<T> values;
 
+  // Used instead of 'values' for arrays of up to SmallValueSet<T>::kCapacity
+  // elements.
+  SmallValueSet<T> smallValues;
+  bool small{false};
+
   bool insert(const T& value) {
+    if (small) {
+      return smallValues.insert(value).second;
+    }
     return values.insert(value).second;
   }
 
-  void reset() {
-    values.clear();
+  // Prepares the set for the elements of an array of 'size' elements.
+  void reset(vector_size_t size) {
+    small = size <= SmallValueSet<T>::kCapacity;
+    if (small) {
+      smallValues.clear();
+    } else {
+      values.clear();
+    }
   }
 };
 
@@ -65,7 +80,7 @@ struct ValueSet<ComplexType> {
     return values.insert(std::make_tuple(hash, vector, index)).second;
   }
 
-  void reset() {
+  void reset(vector_size_t /*size*/) {
     values.clear();
   }
 };
@@ -142,12 +157,14 @@ class ArrayDistinctFunction : public exec::VectorFunction {
     auto* rawNewSizes = newLengths->asMutable<vector_size_t>();
     auto* rawNewOffsets = newOffsets->asMutable<vector_size_t>();
 
-    // Process the rows: store unique values in the hash table.
+    // Process the rows: store unique values in the set. The set is reused
+    // across rows.
     ValueSet<T> uniqueSet;
 
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
       auto offset = arrayVector->offsetAt(row);
+      uniqueSet.reset(size);
 
       rawNewOffsets[row] = indicesCursor;
       bool hasNulls = false;
@@ -172,7 +189,6 @@ class ArrayDistinctFunction : public exec::VectorFunction {
         }
       }
 
-      uniqueSet.reset();
       rawNewSizes[row] = indicesCursor - rawNewOffsets[row];
     });
 
@@ -16,14 +16,19 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SmallValueSet.h"
 #include "velox/type/FloatingPointUtil.h"
 
 namespace facebook::velox::functions {
 namespace {
-template <typename T>
+// 'TSet' is either a hash set or, for the elements of short arrays, a
+// SmallValueSet<T>.
+template <typename T, typename TSet = util::floating_point::HashSetNaNAware<T>>
 struct SetWithNull {
   SetWithNull(vector_size_t initialSetSize = kInitialSetSize) {
-    set.reserve(initialSetSize);
+    if constexpr (!std::is_same_v<TSet, SmallValueSet<T>>) {
+      set.reserve(initialSetSize);
+    }
   }
 
   void reset() {
@@ -35,7 +40,7 @@ struct SetWithNull {
     return !hasNull && set.empty();
   }
 
-  util::floating_point::HashSetNaNAware<T> set;
+  TSet set;
   bool hasNull{false};
   static constexpr vector_size_t kInitialSetSize{128};
 };
@@ -43,12 +48,12 @@ struct SetWithNull {
 // Generates a set based on the elements of an ArrayVector. Note that we take
 // rightSet as a parameter (instead of returning a new one) to reuse the
 // allocated memory.
-template <typename T, typename TVector>
+template <typename T, typename TVector, typename TSet>
 void generateSet(
     const ArrayVector* arrayVector,
     const TVector* arrayElements,
     vector_size_t idx,
-    SetWithNull<T>& rightSet) {
+    SetWithNull<T, TSet>& rightSet) {
   auto size = arrayVector->sizeAt(idx);
   auto offset = arrayVector->offsetAt(idx);
   rightSet.reset();
@@ -117,6 +122,12 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
   /// If the rhs values passed to either array_intersect() or array_except()
   /// are constant (array literals) we create a set before instantiating the
   /// object and pass as a constructor parameter (constantSet).
+  ///
+  /// Short arrays:
+  ///
+  /// For arrays of up to SmallValueSet<T>::kCapacity elements, rightSet and
+  /// outputSet are SmallValueSets, which compare a value with all their
+  /// elements instead of hashing it. All sets are reused across rows.
 
   ArrayIntersectExceptFunction() = default;
 
@@ -165,9 +176,9 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
     // apply it differently based on whether the right-hand side set is constant
     // or not.
     auto processRow = [&](vector_size_t row,
-                          const SetWithNull<T>& rightSet,
-                          SetWithNull<T>& outputSet) {
-      auto idx = decodedLeftArray->index(row);
+                          vector_size_t idx,
+                          const auto& rightSet,
+                          auto& outputSet) {
       auto size = baseLeftArray->sizeAt(idx);
       auto offset = baseLeftArray->offsetAt(idx);
 
@@ -214,11 +225,22 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
     };
 
     SetWithNull<T> outputSet;
+    SetWithNull<T, SmallValueSet<T>> smallOutputSet;
+
+    // Picks the output set by the size of the left-hand side array.
+    auto processRowWithRightSet = [&](vector_size_t row, const auto& rightSet) {
+      auto idx = decodedLeftArray->index(row);
+      if (baseLeftArray->sizeAt(idx) <= SmallValueSet<T>::kCapacity) {
+        processRow(row, idx, rightSet, smallOutputSet);
+      } else {
+        processRow(row, idx, rightSet, outputSet);
+      }
+    };
 
     // Optimized case when the right-hand side array is constant.
     if (constantSet_.has_value()) {
       rows.applyToSelected([&](vector_size_t row) {
-        processRow(row, *constantSet_, outputSet);
+        processRowWithRightSet(row, *constantSet_);
       });
     }
     // General case when no arrays are constant and both sets need to be
@@ -230,11 +252,18 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
       auto decodedRightElements =
           decodeArrayElements(rightHolder, rightElementsHolder, rows);
       SetWithNull<T> rightSet;
+      SetWithNull<T, SmallValueSet<T>> smallRightSet;
       auto rightArrayVector = rightHolder.get()->base()->as<ArrayVector>();
       rows.applyToSelected([&](vector_size_t row) {
         auto idx = rightHolder.get()->index(row);
-        generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
-        processRow(row, rightSet, outputSet);
+        if (rightArrayVector->sizeAt(idx) <= SmallValueSet<T>::kCapacity) {
+          generateSet<T>(
+              rightArrayVector, decodedRightElements, idx, smallRightSet);
+          processRowWithRightSet(row, smallRightSet);
+        } else {
+          generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
+          processRowWithRightSet(row, rightSet);
+        }
       });
     }
 
@@ -284,7 +313,7 @@ class ArraysOverlapFunction : public exec::VectorFunction {
     auto baseLeftArray = decodedLeftArray->base()->as<ArrayVector>();
     context.ensureWritable(rows, BOOLEAN(), result);
     auto resultBoolVector = result->template asFlatVector<bool>();
-    auto processRow = [&](auto row, const SetWithNull<T>& rightSet) {
+    auto processRow = [&](auto row, const auto& rightSet) {
       auto idx = decodedLeftArray->index(row);
       auto offset = baseLeftArray->offsetAt(idx);
       auto size = baseLeftArray->sizeAt(idx);
@@ -327,11 +356,18 @@ class ArraysOverlapFunction : public exec::VectorFunction {
       auto decodedRightElements =
           decodeArrayElements(rightDecoder, rightElementsDecoder, rows);
       SetWithNull<T> rightSet;
+      SetWithNull<T, SmallValueSet<T>> smallRightSet;
       auto baseRightArray = rightDecoder.get()->base()->as<ArrayVector>();
       rows.applyToSelected([&](vector_size_t row) {
         auto idx = rightDecoder.get()->index(row);
-        generateSet<T>(baseRightArray, decodedRightElements, idx, rightSet);
-        processRow(row, rightSet);
+        if (baseRightArray->sizeAt(idx) <= SmallValueSet<T>::kCapacity) {
+          generateSet<T>(
+              baseRightArray, decodedRightElements, idx, smallRightSet);
+          processRow(row, smallRightSet);
+        } else {
+          generateSet<T>(baseRightArray, decodedRightElements, idx, rightSet);
+          processRow(row, rightSet);
+        }
       });
     }
   }
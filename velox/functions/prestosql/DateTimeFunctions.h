@@ -1384,12 +1384,16 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
 
  private:
   FOLLY_ALWAYS_INLINE void setFormatter(const arg_type<Varchar> formatString) {
-    mysqlDateTime_ = buildMysqlDateTimeFormatter(
+    const auto& formatter = formatters_.get(
         std::string_view(formatString.data(), formatString.size()));
-    maxResultSize_ = mysqlDateTime_->maxResultSize(sessionTimeZone_);
+    if (formatter != mysqlDateTime_) {
+      mysqlDateTime_ = formatter;
+      maxResultSize_ = mysqlDateTime_->maxResultSize(sessionTimeZone_);
+    }
   }
 
   const date::time_zone* sessionTimeZone_ = nullptr;
+  DateTimeFormatterCache formatters_{DateTimeFormatterType::MYSQL};
   std::shared_ptr<DateTimeFormatter> mysqlDateTime_;
   uint32_t maxResultSize_;
   bool isConstFormat_ = false;
@@ -1458,6 +1462,9 @@ struct DateParseFunction {
   std::optional<int64_t> sessionTzID_;
   bool isConstFormat_ = false;
 
+  // Formatters for non-constant formats.
+  DateTimeFormatterCache formatters_{DateTimeFormatterType::MYSQL};
+
   FOLLY_ALWAYS_INLINE void initialize(
       const std::vector<TypePtr>& /*inputTypes*/,
       const core::QueryConfig& config,
@@ -1480,8 +1487,7 @@ struct DateParseFunction {
       const arg_type<Varchar>& input,
       const arg_type<Varchar>& format) {
     if (!isConstFormat_) {
-      format_ = buildMysqlDateTimeFormatter(
-          std::string_view(format.data(), format.size()));
+      format_ = formatters_.get(std::string_view(format.data(), format.size()));
     }
 
     auto dateTimeResult = format_->parse((std::string_view)(input));
@@ -1531,10 +1537,15 @@ struct FormatDateTimeFunction {
 
     const auto timestamp = unpackTimestampUtc(timestampWithTimezone);
     const auto timeZoneId = unpackZoneKeyId(timestampWithTimezone);
-    auto* timezonePtr = date::locate_zone(util::getTimeZoneName(timeZoneId));
+    // Consecutive rows often have the same time zone. Looks up the zone only
+    // when it changes.
+    if (timeZoneId != timeZoneId_) {
+      timeZone_ = date::locate_zone(util::getTimeZoneName(timeZoneId));
+      timeZoneId_ = timeZoneId;
+    }
 
-    const auto maxResultSize = jodaDateTime_->maxResultSize(timezonePtr);
-    format(timestamp, timezonePtr, maxResultSize, result);
+    const auto maxResultSize = jodaDateTime_->maxResultSize(timeZone_);
+    format(timestamp, timeZone_, maxResultSize, result);
   }
 
  private:
@@ -1546,9 +1557,12 @@ struct FormatDateTimeFunction {
   }
 
   FOLLY_ALWAYS_INLINE void setFormatter(const arg_type<Varchar>& formatString) {
-    jodaDateTime_ = buildJodaDateTimeFormatter(
+    const auto& formatter = formatters_.get(
         std::string_view(formatString.data(), formatString.size()));
-    maxResultSize_ = jodaDateTime_->maxResultSize(sessionTimeZone_);
+    if (formatter != jodaDateTime_) {
+      jodaDateTime_ = formatter;
+      maxResultSize_ = jodaDateTime_->maxResultSize(sessionTimeZone_);
+    }
   }
 
   void format(
@@ -1563,9 +1577,14 @@ struct FormatDateTimeFunction {
   }
 
   const date::time_zone* sessionTimeZone_ = nullptr;
+  DateTimeFormatterCache formatters_{DateTimeFormatterType::JODA};
   std::shared_ptr<DateTimeFormatter> jodaDateTime_;
   uint32_t maxResultSize_;
   bool isConstFormat_ = false;
+
+  // Zone of the last TimestampWithTimezone row.
+  TimeZoneKey timeZoneId_{-1};
+  const date::time_zone* timeZone_{nullptr};
 };
 
 template <typename T>
@@ -1576,6 +1595,9 @@ struct ParseDateTimeFunction {
   std::optional<int64_t> sessionTzID_;
   bool isConstFormat_ = false;
 
+  // Formatters for non-constant formats.
+  DateTimeFormatterCache formatters_{DateTimeFormatterType::JODA};
+
   FOLLY_ALWAYS_INLINE void initialize(
       const std::vector<TypePtr>& /*inputTypes*/,
       const core::QueryConfig& config,
@@ -1598,8 +1620,7 @@ struct ParseDateTimeFunction {
       const arg_type<Varchar>& input,
       const arg_type<Varchar>& format) {
     if (!isConstFormat_) {
-      format_ = buildJodaDateTimeFormatter(
-          std::string_view(format.data(), format.size()));
+      format_ = formatters_.get(std::string_view(format.data(), format.size()));
     }
     auto dateTimeResult =
         format_->parse(std::string_view(input.data(), input.size()));
@@ -40,6 +40,8 @@ struct DecimalPlusFunction {
     auto bScale = getDecimalPrecisionScale(*bType).second;
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    aShortFactor_ = shortRescaleFactor(aRescale_);
+    bShortFactor_ = shortRescaleFactor(bRescale_);
   }
 
   template <typename R, typename A, typename B>
@@ -50,6 +52,20 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
+    if constexpr (
+        std::is_same_v<R, int64_t> && std::is_same_v<A, int64_t> &&
+        std::is_same_v<B, int64_t>) {
+      // Short decimals are computed in 64 bits. Only results that overflow
+      // 64 bits take the 128 bit path below.
+      int64_t aShort;
+      int64_t bShort;
+      if (!__builtin_mul_overflow(a, aShortFactor_, &aShort) &&
+          !__builtin_mul_overflow(b, bShortFactor_, &bShort) &&
+          !__builtin_add_overflow(aShort, bShort, &out)) {
+        DecimalUtil::valueInRange(out);
+        return;
+      }
+    }
     int128_t aRescaled;
     int128_t bRescaled;
     if (__builtin_mul_overflow(
@@ -69,8 +85,19 @@ struct DecimalPlusFunction {
     return std::max(0, toScale - fromScale);
   }
 
+  // Returns the 64 bit factor for 'rescale'. Scales of short decimals differ
+  // by at most 18. Larger rescales only occur with long decimal inputs, which
+  // do not take the 64 bit path.
+  inline static int64_t shortRescaleFactor(uint8_t rescale) {
+    return rescale <= ShortDecimalType::kMaxPrecision
+        ? static_cast<int64_t>(DecimalUtil::kPowersOfTen[rescale])
+        : 0;
+  }
+
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int64_t aShortFactor_;
+  int64_t bShortFactor_;
 };
 
 template <typename TExec>
@@ -89,6 +116,8 @@ struct DecimalMinusFunction {
     auto bScale = getDecimalPrecisionScale(*bType).second;
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    aShortFactor_ = shortRescaleFactor(aRescale_);
+    bShortFactor_ = shortRescaleFactor(bRescale_);
   }
 
   template <typename R, typename A, typename B>
@@ -99,6 +128,20 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
+    if constexpr (
+        std::is_same_v<R, int64_t> && std::is_same_v<A, int64_t> &&
+        std::is_same_v<B, int64_t>) {
+      // Short decimals are computed in 64 bits. Only results that overflow
+      // 64 bits take the 128 bit path below.
+      int64_t aShort;
+      int64_t bShort;
+      if (!__builtin_mul_overflow(a, aShortFactor_, &aShort) &&
+          !__builtin_mul_overflow(b, bShortFactor_, &bShort) &&
+          !__builtin_sub_overflow(aShort, bShort, &out)) {
+        DecimalUtil::valueInRange(out);
+        return;
+      }
+    }
     int128_t aRescaled;
     int128_t bRescaled;
     if (__builtin_mul_overflow(
@@ -118,8 +161,19 @@ struct DecimalMinusFunction {
     return std::max(0, toScale - fromScale);
   }
 
+  // Returns the 64 bit factor for 'rescale'. Scales of short decimals differ
+  // by at most 18. Larger rescales only occur with long decimal inputs, which
+  // do not take the 64 bit path.
+  inline static int64_t shortRescaleFactor(uint8_t rescale) {
+    return rescale <= ShortDecimalType::kMaxPrecision
+        ? static_cast<int64_t>(DecimalUtil::kPowersOfTen[rescale])
+        : 0;
+  }
+
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int64_t aShortFactor_;
+  int64_t bShortFactor_;
 };
 
 template <typename TExec>
@@ -128,7 +182,14 @@ struct DecimalMultiplyFunction {
 
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+    if constexpr (
+        std::is_same_v<R, int128_t> && std::is_same_v<A, int64_t> &&
+        std::is_same_v<B, int64_t>) {
+      // The product of two 64 bit values always fits in 128 bits.
+      out = static_cast<int128_t>(a) * b;
+    } else {
+      out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+    }
     DecimalUtil::valueInRange(out);
   }
 };
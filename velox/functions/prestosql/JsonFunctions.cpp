@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -181,6 +182,244 @@ class JsonParseFunction : public exec::VectorFunction {
   mutable std::string paddedInput_;
 };
 
+// Extracts the scalars at a constant list of JSON paths from each document
+// into an array with one element per path, like one json_extract_scalar call
+// per path, but parses each document once.
+class JsonExtractScalarsFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarsFunction(const std::vector<std::string>& paths) {
+    extractors_.reserve(paths.size());
+    for (const auto& path : paths) {
+      extractors_.push_back(SIMDJsonExtractor::create(path));
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), 2);
+    const vector_size_t numPaths = extractors_.size();
+    auto* pool = context.pool();
+    exec::LocalDecodedVector json(context, *args[0], rows);
+
+    // Rows that are not selected or fail are null empty arrays. The elements
+    // of these rows are null as well.
+    auto elements = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), rows.end() * numPaths, pool);
+    bits::fillBits(
+        elements->mutableRawNulls(), 0, elements->size(), bits::kNull);
+    auto nulls = allocateNulls(rows.end(), pool, bits::kNull);
+    auto offsets = allocateOffsets(rows.end(), pool);
+    auto sizes = allocateSizes(rows.end(), pool);
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+
+    std::optional<std::string> value;
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      const auto input = json->valueAt<StringView>(row);
+      paddedInput_.resize(input.size() + simdjson::SIMDJSON_PADDING);
+      memcpy(paddedInput_.data(), input.data(), input.size());
+      simdjson::padded_string_view paddedJson(
+          paddedInput_.data(), input.size(), paddedInput_.size());
+      simdjson::ondemand::document jsonDoc;
+      auto parseError = simdjsonParse(paddedJson).get(jsonDoc);
+
+      for (auto i = 0; i < numPaths; ++i) {
+        const auto index = row * numPaths + i;
+        value.reset();
+        if (!parseError) {
+          jsonDoc.rewind();
+          if (detail::extractJsonScalar(jsonDoc, *extractors_[i], value)) {
+            // Like json_extract_scalar, an error gives a null. The document
+            // may not be usable after the error, so parse it again.
+            value.reset();
+            parseError = simdjsonParse(paddedJson).get(jsonDoc);
+          }
+        }
+        if (value.has_value()) {
+          elements->set(index, StringView(*value));
+        }
+      }
+      bits::clearNull(rawNulls, row);
+      rawOffsets[row] = row * numPaths;
+      rawSizes[row] = numPaths;
+    });
+
+    auto localResult = std::make_shared<ArrayVector>(
+        pool, outputType, nulls, rows.end(), offsets, sizes, elements);
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+    // json|varchar, array(varchar) -> array(varchar)
+    for (const auto& jsonType : {"json", "varchar"}) {
+      signatures.push_back(exec::FunctionSignatureBuilder()
+                               .returnType("array(varchar)")
+                               .argumentType(jsonType)
+                               .constantArgumentType("array(varchar)")
+                               .build());
+    }
+    return signatures;
+  }
+
+ private:
+  std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors_;
+  // Padding is needed in case string view is inlined.
+  mutable std::string paddedInput_;
+};
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalars(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_USER_CHECK_EQ(inputArgs.size(), 2, "{} requires 2 arguments", name);
+  BaseVector* constantPaths = inputArgs[1].constantValue.get();
+  VELOX_USER_CHECK(
+      constantPaths != nullptr && !constantPaths->isNullAt(0),
+      "{} requires a constant non-null array of paths",
+      name);
+
+  auto* constant = constantPaths->as<ConstantVector<ComplexType>>();
+  auto* arrays = constant->valueVector()->as<ArrayVector>();
+  const auto index = constant->index();
+  DecodedVector elements(*arrays->elements());
+  std::vector<std::string> paths;
+  paths.reserve(arrays->sizeAt(index));
+  for (auto i = 0; i < arrays->sizeAt(index); ++i) {
+    const auto element = arrays->offsetAt(index) + i;
+    VELOX_USER_CHECK(
+        !elements.isNullAt(element), "{} requires non-null paths", name);
+    paths.push_back(std::string(elements.valueAt<StringView>(element)));
+  }
+  return std::make_shared<JsonExtractScalarsFunction>(paths);
+}
+
+// Returns the constant path if 'expr' is an 'extractName'(json, path) call with
+// a valid constant path.
+std::optional<std::string> asConstantExtract(
+    const std::string& extractName,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != extractName ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto* path =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (path == nullptr || !path->type()->isVarchar() ||
+      path->hasValueVector() || path->value().isNull()) {
+    return std::nullopt;
+  }
+
+  auto value = path->value().value<TypeKind::VARCHAR>();
+  // Leave invalid paths to 'extractName' so that the errors are unchanged.
+  try {
+    SIMDJsonExtractor::create(value);
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+// Only the inputs of calls and casts are rewritten. Lambdas in particular are
+// a different scope that does not share subexpressions with the enclosing one.
+bool canRewriteInputs(const core::ITypedExpr& expr) {
+  return dynamic_cast<const core::CallTypedExpr*>(&expr) != nullptr ||
+      dynamic_cast<const core::CastTypedExpr*>(&expr) != nullptr;
+}
+
+struct ExtractGroup {
+  core::TypedExprPtr json;
+  std::vector<std::string> paths;
+  // The $internal$json_extract_scalars call over 'json' and 'paths'. Null if
+  // 'json' has too few paths.
+  core::TypedExprPtr extractScalars;
+};
+
+ExtractGroup* findGroup(
+    std::vector<ExtractGroup>& groups,
+    const core::ITypedExpr& json) {
+  for (auto& group : groups) {
+    if (*group.json == json) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+
+void collectExtracts(
+    const std::string& extractName,
+    const core::TypedExprPtr& expr,
+    std::vector<ExtractGroup>& groups) {
+  if (auto path = asConstantExtract(extractName, expr)) {
+    const auto& json = expr->inputs()[0];
+    auto* group = findGroup(groups, *json);
+    if (group == nullptr) {
+      group = &groups.emplace_back(ExtractGroup{json});
+    }
+    if (std::find(group->paths.begin(), group->paths.end(), *path) ==
+        group->paths.end()) {
+      group->paths.push_back(std::move(path.value()));
+    }
+  }
+  if (!canRewriteInputs(*expr)) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectExtracts(extractName, input, groups);
+  }
+}
+
+core::TypedExprPtr replaceExtracts(
+    const std::string& extractName,
+    const std::string& subscriptName,
+    const core::TypedExprPtr& expr,
+    std::vector<ExtractGroup>& groups) {
+  if (!canRewriteInputs(*expr)) {
+    return expr;
+  }
+
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  bool changed = false;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(replaceExtracts(extractName, subscriptName, input, groups));
+    changed |= inputs.back() != input;
+  }
+
+  if (auto path = asConstantExtract(extractName, expr)) {
+    auto* group = findGroup(groups, *expr->inputs()[0]);
+    if (group != nullptr && group->extractScalars != nullptr) {
+      const auto position =
+          std::find(group->paths.begin(), group->paths.end(), *path) -
+          group->paths.begin();
+      return std::make_shared<core::CallTypedExpr>(
+          VARCHAR(),
+          std::vector<core::TypedExprPtr>{
+              group->extractScalars,
+              std::make_shared<core::ConstantTypedExpr>(
+                  INTEGER(), variant(static_cast<int32_t>(position + 1)))},
+          subscriptName);
+    }
+  }
+
+  if (!changed) {
+    return expr;
+  }
+  if (auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        call->type(), std::move(inputs), call->name());
+  }
+  auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  return std::make_shared<core::CastTypedExpr>(
+      cast->type(), inputs, cast->nullOnFailure());
+}
+
 } // namespace
 
 VELOX_DECLARE_VECTOR_FUNCTION(
@@ -197,4 +436,48 @@ VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
       return std::make_shared<JsonParseFunction>();
     });
 
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_json_extract_scalars,
+    JsonExtractScalarsFunction::signatures(),
+    makeJsonExtractScalars);
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& extractName,
+    const std::string& subscriptName,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  std::vector<ExtractGroup> groups;
+  for (const auto& expr : exprs) {
+    collectExtracts(extractName, expr, groups);
+  }
+
+  bool found = false;
+  for (auto& group : groups) {
+    if (group.paths.size() < kMinJsonExtractScalarsPaths) {
+      continue;
+    }
+    std::vector<variant> paths(group.paths.begin(), group.paths.end());
+    group.extractScalars = std::make_shared<core::CallTypedExpr>(
+        ARRAY(VARCHAR()),
+        std::vector<core::TypedExprPtr>{
+            group.json,
+            std::make_shared<core::ConstantTypedExpr>(
+                ARRAY(VARCHAR()), variant::array(std::move(paths)))},
+        kJsonExtractScalarsName);
+    found = true;
+  }
+  // The subscript function may not be registered, e.g. in tests that register
+  // only the JSON functions.
+  if (!found || !exec::getVectorFunctionSignatures(subscriptName).has_value()) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(
+        replaceExtracts(extractName, subscriptName, expr, groups));
+  }
+  return rewritten;
+}
+
 } // namespace facebook::velox::functions
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/ITypedExpr.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -193,6 +194,56 @@ struct JsonArrayGetFunction {
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
 // (boolean, number or string)
+namespace detail {
+
+/// Extracts the scalar at the path of 'extractor' from 'json' into 'result'
+/// like json_extract_scalar. 'json' is either a JSON string or a parsed
+/// simdjson::ondemand::document. Leaves 'result' empty if the path does not
+/// match exactly one scalar.
+template <typename TJson>
+simdjson::error_code extractJsonScalar(
+    TJson& json,
+    SIMDJsonExtractor& extractor,
+    std::optional<std::string>& result) {
+  bool resultPopulated = false;
+  auto consumer = [&result, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  return simdJsonExtract(json, extractor, consumer);
+}
+
+} // namespace detail
+
 template <typename T>
 struct JsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -209,43 +260,9 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
     std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
+    SIMDJSON_TRY(detail::extractJsonScalar(json, extractor, resultStr));
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
@@ -396,4 +413,28 @@ struct JsonSizeFunction {
   }
 };
 
+/// Name of the internal function created by rewriteJsonExtractScalars.
+constexpr const char* kJsonExtractScalarsName =
+    "$internal$json_extract_scalars";
+
+/// Minimum number of paths over one JSON input worth extracting with
+/// $internal$json_extract_scalars.
+constexpr size_t kMinJsonExtractScalarsPaths = 2;
+
+/// Rewrites the 'extractName'(json, 'path') calls with valid constant paths in
+/// 'exprs', which are compiled together into one ExprSet. Calls over the same
+/// json with at least kMinJsonExtractScalarsPaths distinct paths become
+/// 'subscriptName'(e, i), where e is the common subexpression
+/// $internal$json_extract_scalars(json, ARRAY['path1', 'path2', ...]) and i is
+/// the position of the call's path. This parses each document once instead of
+/// once per call. Calls inside lambdas and inside expressions other than calls
+/// and casts are kept.
+///
+/// Returns an empty list if there are no such calls or if 'subscriptName' is
+/// not registered.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& extractName,
+    const std::string& subscriptName,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 } // namespace facebook::velox::functions
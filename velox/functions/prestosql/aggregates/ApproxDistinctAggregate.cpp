@@ -19,6 +19,7 @@
 #include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 #include "velox/common/hyperloglog/SparseHll.h"
+#include "velox/common/hyperloglog/XxHash64.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/FunctionSignature.h"
@@ -54,6 +55,17 @@ struct HllAccumulator {
     }
   }
 
+  /// Same as calling append() for each of 'numHashes' 'hashes'.
+  void append(const uint64_t* hashes, int32_t numHashes) {
+    int32_t i = 0;
+    for (; isSparse_ && i < numHashes; ++i) {
+      append(hashes[i]);
+    }
+    if (i < numHashes) {
+      denseHll_.insertHashes(hashes + i, numHashes - i);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -125,6 +137,24 @@ inline uint64_t hashOne<StringView>(StringView value) {
   return XXH64(value.data(), value.size(), 0);
 }
 
+// True if values of type T are hashed in SIMD batches by their 4 or 8 byte
+// representation. Timestamps are hashed by their milliseconds.
+template <typename T>
+constexpr bool kBatchHash = std::is_same_v<T, Timestamp> ||
+    (std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+template <typename TBits, typename T>
+inline TBits toHashBits(T value) {
+  if constexpr (std::is_same_v<T, Timestamp>) {
+    return toHashBits<TBits>(value.toMillis());
+  } else {
+    static_assert(sizeof(T) == sizeof(TBits));
+    TBits bits;
+    memcpy(&bits, &value, sizeof(T));
+    return bits;
+  }
+}
+
 template <typename T>
 class ApproxDistinctAggregate : public exec::Aggregate {
  public:
@@ -217,21 +247,16 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addIntermediateResults(groups, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      hashValues(rows);
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
-        }
-
-        auto group = groups[row];
+      for (auto i = 0; i < hashRows_.size(); ++i) {
+        auto group = groups[hashRows_[i]];
         auto tracker = trackRowSize(group);
         auto accumulator = value<HllAccumulator>(group);
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
-      });
+        accumulator->append(hashes_[i]);
+      }
     }
   }
 
@@ -268,19 +293,15 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      hashValues(rows);
+      if (hashes_.empty()) {
+        return;
+      }
 
-      rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
-        }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
-      });
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_.data(), hashes_.size());
     }
   }
 
@@ -362,6 +383,35 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     }
   }
 
+  // Sets 'hashes_' to the hashes of the non-null values of 'decodedValue_' in
+  // 'rows' and 'hashRows_' to their row numbers.
+  void hashValues(const SelectivityVector& rows) {
+    hashRows_.resize(rows.end());
+    int32_t numRows = 0;
+    rows.applyToSelected([&](auto row) {
+      if (!decodedValue_.isNullAt(row)) {
+        hashRows_[numRows++] = row;
+      }
+    });
+    hashRows_.resize(numRows);
+    hashes_.resize(numRows);
+
+    if constexpr (kBatchHash<T>) {
+      using TBits = std::
+          conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+      hashBits_.resize(numRows);
+      auto* bits = reinterpret_cast<TBits*>(hashBits_.data());
+      for (auto i = 0; i < numRows; ++i) {
+        bits[i] = toHashBits<TBits>(decodedValue_.valueAt<T>(hashRows_[i]));
+      }
+      common::hll::xxHash64(bits, numRows, hashes_.data());
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        hashes_[i] = hashOne(decodedValue_.valueAt<T>(hashRows_[i]));
+      }
+    }
+  }
+
   void decodeArguments(
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args) {
@@ -423,6 +473,12 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+
+  // Rows, representations and hashes of the non-null values of the current
+  // input batch. See hashValues().
+  raw_vector<vector_size_t> hashRows_;
+  raw_vector<uint64_t> hashBits_;
+  raw_vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
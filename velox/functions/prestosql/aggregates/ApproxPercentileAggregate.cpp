@@ -631,6 +631,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     bool isArray;
   };
 
+  // A sketch of an intermediate input row and the group it goes to.
+  using GroupView = std::pair<char*, typename KllSketch<T>::View>;
+
   static constexpr double kMissingNormalizedValue = -1;
   const bool hasWeight_;
   const bool hasAccuracy_;
@@ -705,8 +708,11 @@ class ApproxPercentileAggregate : public exec::Aggregate {
 
     KllSketchAccumulator<T>* accumulator = nullptr;
     std::vector<typename KllSketch<T>::View> views;
+    std::vector<GroupView> groupViews;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      groupViews.reserve(rows.countSelected());
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -767,8 +773,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews.push_back({group[row], v});
       }
     });
     if constexpr (kSingleGroup) {
@@ -776,6 +781,33 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         auto tracker = trackRowSize(group);
         accumulator->append(views);
       }
+    } else {
+      mergeGroupViews(groupViews, views);
+    }
+  }
+
+  // Merges the sketches in 'groupViews' into the accumulators of their groups
+  // with one merge per group. Each KLL merge allocates scratch buffers and
+  // recompacts all levels, so a final aggregation that receives many partial
+  // states of the same group in one batch merges them together instead of one
+  // at a time. 'views' is scratch space.
+  void mergeGroupViews(
+      std::vector<GroupView>& groupViews,
+      std::vector<typename KllSketch<T>::View>& views) {
+    std::stable_sort(
+        groupViews.begin(),
+        groupViews.end(),
+        [](const auto& left, const auto& right) {
+          return left.first < right.first;
+        });
+    for (auto i = 0; i < groupViews.size();) {
+      auto* group = groupViews[i].first;
+      views.clear();
+      for (; i < groupViews.size() && groupViews[i].first == group; ++i) {
+        views.push_back(groupViews[i].second);
+      }
+      auto tracker = trackRowSize(group);
+      value<KllSketchAccumulator<T>>(group)->append(views);
     }
   }
 };
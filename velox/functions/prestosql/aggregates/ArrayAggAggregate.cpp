@@ -131,14 +131,18 @@ class ArrayAggAggregate : public exec::Aggregate {
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
     decodedElements_.decode(*args[0], rows);
+    groupRows_.clear();
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
         return;
       }
-      auto group = groups[row];
+      groupRows_.push_back(row);
+    });
+    // Appends the values of each group with one write.
+    forEachGroup(groups, groupRows_, [&](char* group, auto groupRows) {
       auto tracker = trackRowSize(group);
-      value<ArrayAccumulator>(group)->elements.appendValue(
-          decodedElements_, row, allocator_);
+      value<ArrayAccumulator>(group)->elements.appendValues(
+          decodedElements_, groupRows, allocator_);
     });
   }
 
@@ -174,12 +178,18 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     decodedElements_.decode(*args[0], rows);
     auto tracker = trackRowSize(group);
+    groupRows_.clear();
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
         return;
       }
-      values.appendValue(decodedElements_, row, allocator_);
+      groupRows_.push_back(row);
     });
+    values.appendValues(
+        decodedElements_,
+        folly::Range<const vector_size_t*>(
+            groupRows_.data(), groupRows_.size()),
+        allocator_);
   }
 
   void addSingleGroupIntermediateResults(
@@ -235,6 +245,10 @@ class ArrayAggAggregate : public exec::Aggregate {
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedElements_;
   DecodedVector decodedIntermediate_;
+
+  // Rows of the current raw input batch to add, ordered by group by
+  // forEachGroup().
+  std::vector<vector_size_t> groupRows_;
 };
 
 } // namespace
@@ -79,6 +79,11 @@ class BoolAndAggregate final : public BoolAndOrAggregate {
  public:
   explicit BoolAndAggregate() : BoolAndOrAggregate(/* initialValue = */ true) {}
 
+  // false is less than true.
+  Extremum extremum() const override {
+    return Extremum::kMin;
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
@@ -130,6 +135,11 @@ class BoolOrAggregate final : public BoolAndOrAggregate {
  public:
   explicit BoolOrAggregate() : BoolAndOrAggregate(/* initialValue = */ false) {}
 
+  // false is less than true.
+  Extremum extremum() const override {
+    return Extremum::kMax;
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
@@ -85,27 +85,19 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
-    if (args.empty()) {
-      addToGroup(group, rows.countSelected());
-      return;
-    }
+    addToGroup(group, countNonNull(rows, args));
+  }
 
-    DecodedVector decoded(*args[0], rows);
-    if (decoded.isConstantMapping()) {
-      if (!decoded.isNullAt(0)) {
-        addToGroup(group, rows.countSelected());
-      }
-    } else if (decoded.mayHaveNulls()) {
-      int64_t nonNullCount = 0;
-      rows.applyToSelected([&](vector_size_t i) {
-        if (!decoded.isNullAt(i)) {
-          ++nonNullCount;
-        }
-      });
-      addToGroup(group, nonNullCount);
-    } else {
-      addToGroup(group, rows.countSelected());
-    }
+  bool supportsRetract() const override {
+    return true;
+  }
+
+  bool retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    addToGroup(group, -countNonNull(rows, args));
+    return true;
   }
 
   void addSingleGroupIntermediateResults(
@@ -146,6 +138,30 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     *value<int64_t>(group) += count;
   }
 
+  // Returns the number of 'rows' counted by count(*) or count(x).
+  static int64_t countNonNull(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (args.empty()) {
+      return rows.countSelected();
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      return decoded.isNullAt(0) ? 0 : rows.countSelected();
+    }
+    if (!decoded.mayHaveNulls()) {
+      return rows.countSelected();
+    }
+    int64_t nonNullCount = 0;
+    rows.applyToSelected([&](vector_size_t i) {
+      if (!decoded.isNullAt(i)) {
+        ++nonNullCount;
+      }
+    });
+    return nonNullCount;
+  }
+
   DecodedVector decodedIntermediate_;
 };
 
@@ -108,37 +108,19 @@ class CountIfAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /*mayPushdown*/) override {
-    DecodedVector decoded(*args[0], rows);
+    addToGroup(group, countTrue(rows, args));
+  }
 
-    // Constant mapping - check once and add number of selected rows if true.
-    if (decoded.isConstantMapping()) {
-      if (!decoded.isNullAt(0)) {
-        auto isTrue = decoded.valueAt<bool>(0);
-        if (isTrue) {
-          addToGroup(group, rows.countSelected());
-        }
-      }
-      return;
-    }
+  bool supportsRetract() const override {
+    return true;
+  }
 
-    int64_t numTrue = 0;
-    if (decoded.mayHaveNulls()) {
-      rows.applyToSelected([&](vector_size_t i) {
-        if (decoded.isNullAt(i)) {
-          return;
-        }
-        if (decoded.valueAt<bool>(i)) {
-          ++numTrue;
-        }
-      });
-    } else {
-      rows.applyToSelected([&](vector_size_t i) {
-        if (decoded.valueAt<bool>(i)) {
-          ++numTrue;
-        }
-      });
-    }
-    addToGroup(group, numTrue);
+  bool retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    addToGroup(group, -countTrue(rows, args));
+    return true;
   }
 
   void addSingleGroupIntermediateResults(
@@ -167,6 +149,40 @@ class CountIfAggregate : public exec::Aggregate {
   inline void addToGroup(char* group, int64_t numTrue) {
     *value<int64_t>(group) += numTrue;
   }
+
+  // Returns the number of 'rows' where the argument is true.
+  static int64_t countTrue(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    DecodedVector decoded(*args[0], rows);
+
+    // Constant mapping - check once and count the selected rows if true.
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0) && decoded.valueAt<bool>(0)) {
+        return rows.countSelected();
+      }
+      return 0;
+    }
+
+    int64_t numTrue = 0;
+    if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (decoded.isNullAt(i)) {
+          return;
+        }
+        if (decoded.valueAt<bool>(i)) {
+          ++numTrue;
+        }
+      });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (decoded.valueAt<bool>(i)) {
+          ++numTrue;
+        }
+      });
+    }
+    return numTrue;
+  }
 };
 
 } // namespace
@@ -59,13 +59,26 @@ struct MapAccumulator {
       const DecodedVector& decodedValues,
       vector_size_t index,
       HashStringAllocator& allocator) {
-    // Drop duplicate keys.
-    auto cnt = keys.size();
-    if (keys.insert({decodedKeys.valueAt<T>(index), cnt}).second) {
+    if (insertKey(decodedKeys, index, allocator)) {
       values.appendValue(decodedValues, index, &allocator);
     }
   }
 
+  /// Adds the key if it doesn't exist yet. Returns true if the key was added,
+  /// in which case the caller must append the value to valueList().
+  bool insertKey(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      HashStringAllocator& /*allocator*/) {
+    // Drop duplicate keys.
+    auto cnt = keys.size();
+    return keys.insert({decodedKeys.valueAt<T>(index), cnt}).second;
+  }
+
+  ValueList& valueList() {
+    return values;
+  }
+
   /// Returns number of key-value pairs.
   size_t size() const {
     return keys.size();
@@ -126,18 +139,29 @@ struct StringViewMapAccumulator {
       const DecodedVector& decodedValues,
       vector_size_t index,
       HashStringAllocator& allocator) {
+    if (insertKey(decodedKeys, index, allocator)) {
+      base.values.appendValue(decodedValues, index, &allocator);
+    }
+  }
+
+  bool insertKey(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      HashStringAllocator& allocator) {
     auto key = decodedKeys.valueAt<StringView>(index);
     if (!key.isInline()) {
       if (base.keys.contains(key)) {
-        return;
+        return false;
       }
       key = strings.append(key, allocator);
     }
 
     auto cnt = base.keys.size();
-    if (base.keys.insert({key, cnt}).second) {
-      base.values.appendValue(decodedValues, index, &allocator);
-    }
+    return base.keys.insert({key, cnt}).second;
+  }
+
+  ValueList& valueList() {
+    return base.values;
   }
 
   size_t size() const {
@@ -180,15 +204,27 @@ struct ComplexTypeMapAccumulator {
       const DecodedVector& decodedValues,
       vector_size_t index,
       HashStringAllocator& allocator) {
+    if (insertKey(decodedKeys, index, allocator)) {
+      base.values.appendValue(decodedValues, index, &allocator);
+    }
+  }
+
+  bool insertKey(
+      const DecodedVector& decodedKeys,
+      vector_size_t index,
+      HashStringAllocator& allocator) {
     auto entry = serializedKeys.append(decodedKeys, index, &allocator);
 
     auto cnt = base.keys.size();
     if (!base.keys.insert({entry, cnt}).second) {
       serializedKeys.removeLast(entry);
-      return;
+      return false;
     }
+    return true;
+  }
 
-    base.values.appendValue(decodedValues, index, &allocator);
+  ValueList& valueList() {
+    return base.values;
   }
 
   size_t size() const {
@@ -103,18 +103,35 @@ class MapAggAggregate : public MapAggregateBase<K> {
     Base::decodedValues_.decode(*args[1], rows);
     const auto* indices = Base::decodedKeys_.indices();
 
+    groupRows_.clear();
     rows.applyToSelected([&](vector_size_t row) {
       if (velox::functions::checkNestedNulls(
               Base::decodedKeys_, indices, row, throwOnNestedNulls_)) {
         return;
       }
-
-      auto group = groups[row];
-      Base::clearNull(group);
-      auto tracker = Base::trackRowSize(group);
-      Base::accumulator(group)->insert(
-          Base::decodedKeys_, Base::decodedValues_, row, *Base::allocator_);
+      groupRows_.push_back(row);
     });
+
+    // Adds the keys of each group one by one and appends the values of the
+    // new keys with one write.
+    aggregate::forEachGroup(
+        groups, groupRows_, [&](char* group, auto groupRows) {
+          Base::clearNull(group);
+          auto tracker = Base::trackRowSize(group);
+          auto* accumulator = Base::accumulator(group);
+          newKeyRows_.clear();
+          for (auto row : groupRows) {
+            if (accumulator->insertKey(
+                    Base::decodedKeys_, row, *Base::allocator_)) {
+              newKeyRows_.push_back(row);
+            }
+          }
+          accumulator->valueList().appendValues(
+              Base::decodedValues_,
+              folly::Range<const vector_size_t*>(
+                  newKeyRows_.data(), newKeyRows_.size()),
+              Base::allocator_);
+        });
   }
 
   void addSingleGroupRawInput(
@@ -143,6 +160,11 @@ class MapAggAggregate : public MapAggregateBase<K> {
 
  private:
   const bool throwOnNestedNulls_;
+
+  // Rows of the current raw input batch to add, ordered by group by
+  // forEachGroup(), and the rows of a group that add a new key.
+  std::vector<vector_size_t> groupRows_;
+  std::vector<vector_size_t> newKeyRows_;
 };
 
 } // namespace
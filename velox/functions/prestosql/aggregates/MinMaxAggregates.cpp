@@ -104,6 +104,10 @@ class MaxAggregate : public MinMaxAggregate<T> {
  public:
   explicit MaxAggregate(TypePtr resultType) : MinMaxAggregate<T>(resultType) {}
 
+  exec::Aggregate::Extremum extremum() const override {
+    return exec::Aggregate::Extremum::kMax;
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
@@ -199,6 +203,10 @@ class MinAggregate : public MinMaxAggregate<T> {
  public:
   explicit MinAggregate(TypePtr resultType) : MinMaxAggregate<T>(resultType) {}
 
+  exec::Aggregate::Extremum extremum() const override {
+    return exec::Aggregate::Extremum::kMin;
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
@@ -462,6 +470,11 @@ class NonNumericMaxAggregate : public NonNumericMinMaxAggregateBase {
       bool throwOnNestedNulls)
       : NonNumericMinMaxAggregateBase(resultType, throwOnNestedNulls) {}
 
+  Extremum extremum() const override {
+    // Complex types may need to be checked for nested nulls.
+    return resultType_->isPrimitiveType() ? Extremum::kMax : Extremum::kNone;
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
@@ -506,6 +519,11 @@ class NonNumericMinAggregate : public NonNumericMinMaxAggregateBase {
       bool throwOnNestedNulls)
       : NonNumericMinMaxAggregateBase(resultType, throwOnNestedNulls) {}
 
+  Extremum extremum() const override {
+    // Complex types may need to be checked for nested nulls.
+    return resultType_->isPrimitiveType() ? Extremum::kMin : Extremum::kNone;
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
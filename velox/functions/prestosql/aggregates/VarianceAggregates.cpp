@@ -57,6 +57,25 @@ struct VarianceAccumulator {
     m2_ += delta * (value - mean());
   }
 
+  // Reverses update(value). Returns false if the result would not be exact,
+  // i.e. if 'value', the mean or m2 are infinite or NaN.
+  bool remove(double value) {
+    if (!std::isfinite(value) || !std::isfinite(mean_) ||
+        !std::isfinite(m2_)) {
+      return false;
+    }
+    if (count_ == 1) {
+      *this = VarianceAccumulator();
+      return true;
+    }
+    count_ -= 1;
+    double delta = value - mean();
+    mean_ -= delta / count();
+    // Rounding errors must not make m2 negative.
+    m2_ = std::max(0.0, m2_ - delta * (value - mean()));
+    return true;
+  }
+
   inline void merge(const VarianceAccumulator& other) {
     merge(other.count(), other.mean(), other.m2());
   }
@@ -240,6 +259,22 @@ class VarianceAggregate : public exec::Aggregate {
     }
   }
 
+  bool supportsRetract() const override {
+    return true;
+  }
+
+  bool retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    decodedRaw_.decode(*args[0], rows);
+    auto* accData = accumulator(group);
+    return rows.testSelected([&](vector_size_t i) {
+      return decodedRaw_.isNullAt(i) ||
+          accData->remove(decodedRaw_.valueAt<T>(i));
+    });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
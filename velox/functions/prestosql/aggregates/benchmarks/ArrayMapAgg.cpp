@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/aggregates/ValueList.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+static constexpr int32_t kNumVectors = 100;
+static constexpr int32_t kRowsPerVector = 10'000;
+
+namespace {
+
+// Measures group by queries with array_agg and map_agg, which add the values
+// of each group in a batch with one ValueList::appendValues() call. Also
+// compares appending values to ValueLists one by one and in bulk.
+class ArrayMapAggBenchmark : public OperatorTestBase {
+ public:
+  ArrayMapAggBenchmark() {
+    OperatorTestBase::SetUp();
+
+    for (auto i = 0; i < kNumVectors; ++i) {
+      std::vector<VectorPtr> children;
+      // Keys with 100 and 100K distinct values.
+      for (auto numKeys : {100, 100'000}) {
+        children.push_back(
+            makeFlatVector<int64_t>(kRowsPerVector, [&](auto row) {
+              return folly::hash::twang_mix64(i * kRowsPerVector + row) %
+                  numKeys;
+            }));
+      }
+      children.push_back(makeFlatVector<int64_t>(
+          kRowsPerVector, [&](auto row) { return i * kRowsPerVector + row; }));
+      children.push_back(makeFlatVector<std::string>(
+          kRowsPerVector,
+          [](auto row) { return fmt::format("value string {}", row); }));
+      vectors_.push_back(makeRowVector(children));
+    }
+  }
+
+  ~ArrayMapAggBenchmark() override {
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  void run(const std::string& key, const std::string& aggregate) {
+    folly::BenchmarkSuspender suspender;
+    auto plan = PlanBuilder()
+                    .values(vectors_)
+                    .singleAggregation({key}, {aggregate})
+                    .planFragment();
+    auto task = exec::Task::create(
+        "t",
+        std::move(plan),
+        0,
+        core::QueryCtx::create(executor_.get()),
+        exec::Task::ExecutionMode::kSerial);
+    suspender.dismiss();
+
+    vector_size_t numResultRows = 0;
+    while (auto result = task->next()) {
+      numResultRows += result->size();
+    }
+    folly::doNotOptimizeAway(numResultRows);
+  }
+
+  // Appends the string values of each batch to 'numLists' ValueLists, with
+  // one appendValue() call per value or one appendValues() call per list.
+  void appendToValueLists(int32_t numLists, bool bulk) {
+    folly::BenchmarkSuspender suspender;
+    HashStringAllocator allocator(pool());
+    std::vector<aggregate::ValueList> lists(numLists);
+    std::vector<std::vector<vector_size_t>> listRows(numLists);
+    for (auto row = 0; row < kRowsPerVector; ++row) {
+      listRows[row % numLists].push_back(row);
+    }
+    suspender.dismiss();
+
+    DecodedVector decoded;
+    for (const auto& vector : vectors_) {
+      decoded.decode(*vector->childAt(3));
+      for (auto i = 0; i < numLists; ++i) {
+        const auto& rows = listRows[i];
+        if (bulk) {
+          lists[i].appendValues(
+              decoded,
+              folly::Range<const vector_size_t*>(rows.data(), rows.size()),
+              &allocator);
+        } else {
+          for (auto row : rows) {
+            lists[i].appendValue(decoded, row, &allocator);
+          }
+        }
+      }
+    }
+
+    suspender.rehire();
+    for (auto& list : lists) {
+      list.free(&allocator);
+    }
+  }
+
+ private:
+  std::vector<RowVectorPtr> vectors_;
+};
+
+std::unique_ptr<ArrayMapAggBenchmark> benchmark;
+
+void doRun(uint32_t, const std::string& key, const std::string& aggregate) {
+  benchmark->run(key, aggregate);
+}
+
+void doAppend(uint32_t, int32_t numLists, bool bulk) {
+  benchmark->appendToValueLists(numLists, bulk);
+}
+
+BENCHMARK_NAMED_PARAM(doRun, array_agg_100, "c0", "array_agg(c3)");
+BENCHMARK_NAMED_PARAM(doRun, array_agg_100K, "c1", "array_agg(c3)");
+BENCHMARK_NAMED_PARAM(doRun, map_agg_100, "c0", "map_agg(c2, c3)");
+BENCHMARK_NAMED_PARAM(doRun, map_agg_100K, "c1", "map_agg(c2, c3)");
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(doAppend, appendValue_100, 100, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(doAppend, appendValues_100, 100, true);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(doAppend, appendValue_1K, 1'000, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(doAppend, appendValues_1K, 1'000, true);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  OperatorTestBase::SetUpTestCase();
+  benchmark = std::make_unique<ArrayMapAggBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  OperatorTestBase::TearDownTestCase();
+  return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+#include <string>
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+static constexpr int32_t kNumVectors = 100;
+static constexpr int32_t kRowsPerVector = 10'000;
+static constexpr int32_t kNumValueColumns = 5;
+
+namespace {
+
+// Measures group by queries with many fixed-width aggregates, with the
+// accumulators inline in the group rows and in columnar arrays, see
+// QueryConfig::kColumnarAccumulatorsMinAggregates.
+class ManyAggregatesBenchmark : public OperatorTestBase {
+ public:
+  ManyAggregatesBenchmark() {
+    OperatorTestBase::SetUp();
+
+    for (auto i = 0; i < kNumVectors; ++i) {
+      std::vector<VectorPtr> children;
+      // Keys with 1K, 100K and 1M distinct values.
+      for (auto numKeys : {1'000, 100'000, 1'000'000}) {
+        children.push_back(
+            makeFlatVector<int64_t>(kRowsPerVector, [&](auto row) {
+              return folly::hash::twang_mix64(i * kRowsPerVector + row) %
+                  numKeys;
+            }));
+      }
+      for (auto j = 0; j < kNumValueColumns; ++j) {
+        children.push_back(makeFlatVector<int64_t>(
+            kRowsPerVector, [&](auto row) { return (row * (j + 1)) % 1'000; }));
+      }
+      vectors_.push_back(makeRowVector(children));
+    }
+  }
+
+  ~ManyAggregatesBenchmark() override {
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  // Runs a single aggregation grouped by 'key' with sum, count, min, max and
+  // avg over each of the value columns.
+  void run(const std::string& key, bool columnar) {
+    folly::BenchmarkSuspender suspender;
+
+    std::vector<std::string> aggregates;
+    for (auto j = 0; j < kNumValueColumns; ++j) {
+      const auto column = fmt::format("c{}", 3 + j);
+      for (const auto& name : {"sum", "count", "min", "max", "avg"}) {
+        aggregates.push_back(fmt::format("{}({})", name, column));
+      }
+    }
+    auto plan = PlanBuilder()
+                    .values(vectors_)
+                    .singleAggregation({key}, aggregates)
+                    .planFragment();
+
+    std::unordered_map<std::string, std::string> config;
+    if (columnar) {
+      config[core::QueryConfig::kColumnarAccumulatorsMinAggregates] = "1";
+    }
+    auto task = exec::Task::create(
+        "t",
+        std::move(plan),
+        0,
+        core::QueryCtx::create(
+            executor_.get(), core::QueryConfig(std::move(config))),
+        exec::Task::ExecutionMode::kSerial);
+
+    suspender.dismiss();
+
+    vector_size_t numResultRows = 0;
+    while (auto result = task->next()) {
+      numResultRows += result->size();
+    }
+    folly::doNotOptimizeAway(numResultRows);
+  }
+
+ private:
+  std::vector<RowVectorPtr> vectors_;
+};
+
+std::unique_ptr<ManyAggregatesBenchmark> benchmark;
+
+void doRun(uint32_t, const std::string& key, bool columnar) {
+  benchmark->run(key, columnar);
+}
+
+BENCHMARK_NAMED_PARAM(doRun, rows_1K, "c0", false);
+BENCHMARK_RELATIVE_NAMED_PARAM(doRun, columnar_1K, "c0", true);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(doRun, rows_100K, "c1", false);
+BENCHMARK_RELATIVE_NAMED_PARAM(doRun, columnar_100K, "c1", true);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(doRun, rows_1M, "c2", false);
+BENCHMARK_RELATIVE_NAMED_PARAM(doRun, columnar_1M, "c2", true);
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  OperatorTestBase::SetUpTestCase();
+  benchmark = std::make_unique<ManyAggregatesBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  OperatorTestBase::TearDownTestCase();
+  return 0;
+}
@@ -400,6 +400,41 @@ TEST_F(ApproxPercentileTest, finalAggregateAccuracy) {
   assertQuery(op, "SELECT 5");
 }
 
+TEST_F(ApproxPercentileTest, finalAggregateManyPartialsPerGroup) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 5; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row * 7 % 1'000; }),
+  });
+  auto partial = AssertQueryBuilder(
+                     PlanBuilder()
+                         .values({data})
+                         .partialAggregation(
+                             {"c0"}, {"approx_percentile(c1, 0.3, 0.0001)"})
+                         .planNode())
+                     .copyResults(pool());
+
+  // One batch with 10 partial states for each group. The states of a group
+  // are merged together. With this accuracy the sketches are exact, so the
+  // result matches the final aggregation of a single copy.
+  auto partials = BaseVector::create(partial->type(), 0, pool());
+  for (auto i = 0; i < 10; ++i) {
+    partials->append(partial.get());
+  }
+  auto finalAggregation = [&](const VectorPtr& input) {
+    return PlanBuilder()
+        .values({std::dynamic_pointer_cast<RowVector>(input)})
+        .finalAggregation(
+            {"c0"},
+            {"approx_percentile(a0)"},
+            {{INTEGER(), DOUBLE(), DOUBLE()}})
+        .planNode();
+  };
+  auto expected =
+      AssertQueryBuilder(finalAggregation(partial)).copyResults(pool());
+  ASSERT_EQ(expected->size(), 5);
+  AssertQueryBuilder(finalAggregation(partials)).assertResults(expected);
+}
+
 TEST_F(ApproxPercentileTest, invalidEncoding) {
   auto indices = AlignedBuffer::allocate<vector_size_t>(3, pool());
   auto rawIndices = indices->asMutable<vector_size_t>();
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Measures array_distinct, array_intersect, array_except and arrays_overlap
+// over arrays of up to 5, 20, 50 and 200 elements. Arrays of up to 32
+// elements are processed without hashing. TINYINT arrays have many duplicate
+// and common elements, BIGINT arrays have almost none.
+
+using namespace facebook::velox;
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerArrayFunctions();
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  for (const auto& elementType : {TINYINT(), BIGINT()}) {
+    const auto inputType =
+        ROW({"c0", "c1"}, {ARRAY(elementType), ARRAY(elementType)});
+    for (size_t length : {5, 20, 50, 200}) {
+      benchmarkBuilder
+          .addBenchmarkSet(
+              fmt::format("{}_{}", elementType->toString(), length),
+              inputType)
+          .withFuzzerOptions(
+              {.vectorSize = 1'000,
+               .nullRatio = 0.01,
+               .containerLength = length})
+          .addExpression("distinct", "array_distinct(c0)")
+          .addExpression("intersect", "array_intersect(c0, c1)")
+          .addExpression("except", "array_except(c0, c1)")
+          .addExpression("overlap", "arrays_overlap(c0, c1)")
+          .withIterations(100)
+          .disableTesting();
+    }
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/type/DecimalUtil.h"
+
+namespace {
+using namespace facebook::velox;
+
+constexpr vector_size_t kSize = 10'000;
+
+// Measures decimal arithmetic on short decimals of the kind found in financial
+// data, and the sum of short decimals as done by the sum aggregate.
+class DecimalBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  DecimalBenchmark() {
+    functions::prestosql::registerArithmeticFunctions();
+    auto price = vectorMaker_.flatVector<int64_t>(
+        kSize, [](auto row) { return row * 1'999 % 10'000'000; }, nullptr,
+        DECIMAL(15, 2));
+    auto discount = vectorMaker_.flatVector<int64_t>(
+        kSize, [](auto row) { return row % 100; }, nullptr, DECIMAL(15, 4));
+    data_ = vectorMaker_.rowVector({price, discount});
+    values_ = price->asFlatVector<int64_t>()->rawValues();
+  }
+
+  void run(const std::string& expression) {
+    folly::BenchmarkSuspender suspender;
+    auto exprSet = compileExpression(expression, asRowType(data_->type()));
+    suspender.dismiss();
+    int64_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      count += evaluate(exprSet, data_)->size();
+    }
+    folly::doNotOptimizeAway(count);
+  }
+
+  int128_t sumWithOverflow() {
+    int128_t sum = 0;
+    int64_t overflow = 0;
+    for (auto i = 0; i < kSize; ++i) {
+      overflow += DecimalUtil::addWithOverflow(sum, values_[i], sum);
+    }
+    folly::doNotOptimizeAway(overflow);
+    return sum;
+  }
+
+  int128_t sumShortDecimals() {
+    return DecimalUtil::sumShortDecimals(values_, kSize);
+  }
+
+ private:
+  RowVectorPtr data_;
+  const int64_t* values_;
+};
+
+std::unique_ptr<DecimalBenchmark> benchmark;
+
+BENCHMARK(plus) {
+  benchmark->run("c0 + c1");
+}
+
+BENCHMARK(minus) {
+  benchmark->run("c0 - c1");
+}
+
+BENCHMARK(multiply) {
+  benchmark->run("c0 * c1");
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(sumWithOverflow) {
+  folly::doNotOptimizeAway(benchmark->sumWithOverflow());
+  return kSize;
+}
+
+BENCHMARK_RELATIVE_MULTI(sumShortDecimals) {
+  folly::doNotOptimizeAway(benchmark->sumShortDecimals());
+  return kSize;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize({});
+  benchmark = std::make_unique<DecimalBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <random>
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/types/JsonType.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+constexpr vector_size_t kVectorSize = 1'000;
+
+// Returns JSON objects with 'numFields' fields named f0, f1,... in random
+// order, cycling through bigint, double and varchar values, followed by an
+// unused field.
+std::string makeObject(int32_t numFields) {
+  std::vector<std::string> fields;
+  for (auto i = 0; i < numFields; ++i) {
+    auto value = folly::Random::rand32() % 1'000;
+    switch (i % 3) {
+      case 0:
+        fields.push_back(fmt::format("\"f{}\": {}", i, value));
+        break;
+      case 1:
+        fields.push_back(fmt::format("\"F{}\": {}.5", i, value));
+        break;
+      default:
+        fields.push_back(fmt::format("\"f{}\": \"value {}\"", i, value));
+        break;
+    }
+  }
+  std::shuffle(
+      fields.begin(), fields.end(), std::default_random_engine(numFields));
+  fields.push_back("\"unused\": [1, 2, 3]");
+  return fmt::format("{{{}}}", folly::join(", ", fields));
+}
+
+// Returns the target type of makeObject() results as SQL.
+std::string makeStructType(int32_t numFields) {
+  static const std::vector<std::string> kTypes = {
+      "bigint", "double", "varchar"};
+  std::vector<std::string> fields;
+  for (auto i = 0; i < numFields; ++i) {
+    fields.push_back(fmt::format("f{} {}", i, kTypes[i % 3]));
+  }
+  return fmt::format("struct({})", folly::join(", ", fields));
+}
+
+// Returns a JSON column of flat objects with 'numFields' fields.
+VectorPtr makeFlatDocuments(test::VectorMaker& vm, int32_t numFields) {
+  return vm.flatVector<std::string>(
+      kVectorSize,
+      [&](auto /*row*/) { return makeObject(numFields); },
+      nullptr,
+      JSON());
+}
+
+// Returns a JSON column of objects with an id, an array of 10 objects with
+// 'numFields' fields and a map of 10 entries.
+VectorPtr makeNestedDocuments(test::VectorMaker& vm, int32_t numFields) {
+  return vm.flatVector<std::string>(
+      kVectorSize,
+      [&](auto row) {
+        std::vector<std::string> items;
+        std::vector<std::string> attributes;
+        for (auto i = 0; i < 10; ++i) {
+          items.push_back(makeObject(numFields));
+          attributes.push_back(fmt::format("\"a{}\": {}", i, row + i));
+        }
+        return fmt::format(
+            "{{\"id\": {}, \"items\": [{}], \"attributes\": {{{}}}}}",
+            row,
+            folly::join(", ", items),
+            folly::join(", ", attributes));
+      },
+      nullptr,
+      JSON());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::MemoryManager::initialize({});
+  functions::prestosql::registerAllScalarFunctions();
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  auto& vm = benchmarkBuilder.vectorMaker();
+
+  for (auto numFields : {10, 60}) {
+    benchmarkBuilder
+        .addBenchmarkSet(
+            fmt::format("flat_{}_fields", numFields),
+            vm.rowVector({makeFlatDocuments(vm, numFields)}))
+        .addExpression(
+            "cast", fmt::format("cast(c0 as {})", makeStructType(numFields)))
+        .withIterations(100);
+
+    benchmarkBuilder
+        .addBenchmarkSet(
+            fmt::format("nested_{}_fields", numFields),
+            vm.rowVector({makeNestedDocuments(vm, numFields)}))
+        .addExpression(
+            "cast",
+            fmt::format(
+                "cast(c0 as struct(id bigint, items {}[], "
+                "attributes map(varchar, bigint)))",
+                makeStructType(numFields)))
+        .withIterations(10);
+  }
+
+  benchmarkBuilder.registerBenchmarks();
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -23,6 +23,7 @@
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/JsonExtractor.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions::prestosql {
@@ -198,6 +199,33 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     registerFunction<JsonSizeFunction, int64_t, Json, Varchar>({"json_size"});
     registerFunction<FollyJsonSizeFunction, int64_t, Json, Varchar>(
         {"folly_json_size"});
+    // With the rewrite that extracts several paths with one parse.
+    registerJsonFunctions("presto_");
+    registerGeneralFunctions("presto_");
+  }
+
+  // Returns an event-like JSON object of roughly 'jsonSize' bytes with nested
+  // objects and an array of items.
+  std::string prepareEventData(int jsonSize) {
+    std::string jsonData =
+        R"({"id":12345,"type":"purchase","ts":"2024-01-01T00:00:00Z",)"
+        R"("user":{"id":42,"name":"someone","country":"NZ",)"
+        R"("tags":["a","b","c"]},)"
+        R"("meta":{"source":"mobile","version":"1.2.3","debug":false},)"
+        R"("items":[)";
+    for (auto i = 0; jsonData.size() < size_t(jsonSize); ++i) {
+      if (i > 0) {
+        jsonData += ",";
+      }
+      jsonData += fmt::format(
+          R"({{"sku":"sku-{}","qty":{},"price":{}.99,"note":"{}"}})",
+          i,
+          i % 7,
+          i % 100,
+          std::string(40, 'x'));
+    }
+    jsonData += "]}";
+    return jsonData;
   }
 
   std::string prepareData(int jsonSize) {
@@ -253,6 +281,51 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Evaluates presto_json_extract_scalar over 'paths' either in one ExprSet,
+  // where the document is parsed once per row, or in one ExprSet per path.
+  void runWithJsonExtractPaths(
+      int iter,
+      int vectorSize,
+      const std::string& json,
+      const std::vector<std::string>& paths,
+      bool shared) {
+    folly::BenchmarkSuspender suspender;
+
+    auto jsonVector = makeJsonData(json, vectorSize);
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+    std::vector<core::TypedExprPtr> exprs;
+    for (const auto& path : paths) {
+      exprs.push_back(core::Expressions::inferTypes(
+          parse::parseExpr(
+              fmt::format("presto_json_extract_scalar(c0, '{}')", path),
+              options_),
+          rowVector->type(),
+          execCtx_.pool()));
+    }
+    std::vector<std::unique_ptr<exec::ExprSet>> exprSets;
+    if (shared) {
+      exprSets.push_back(std::make_unique<exec::ExprSet>(exprs, &execCtx_));
+    } else {
+      for (const auto& expr : exprs) {
+        exprSets.push_back(std::make_unique<exec::ExprSet>(
+            std::vector<core::TypedExprPtr>{expr}, &execCtx_));
+      }
+    }
+    SelectivityVector rows(rowVector->size());
+    suspender.dismiss();
+
+    uint32_t cnt = 0;
+    for (auto i = 0; i < iter; i++) {
+      for (auto& exprSet : exprSets) {
+        exec::EvalCtx evalCtx(&execCtx_, exprSet.get(), rowVector.get());
+        std::vector<VectorPtr> results(exprSet->size());
+        exprSet->eval(rows, evalCtx, results);
+        cnt += results.size();
+      }
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
   void runWithJsonContains(
       int iter,
       int vectorSize,
@@ -384,6 +457,35 @@ void SIMDJsonSize(int iter, int vectorSize, int jsonSize) {
   benchmark.runWithJsonExtract(iter, vectorSize, "json_size", json, "$.key");
 }
 
+const std::vector<std::string> kEventPaths = {
+    "$.id",
+    "$.type",
+    "$.user.name",
+    "$.user.country",
+    "$.meta.source",
+    "$.meta.version",
+    "$.items[0].sku",
+    "$.items[2].qty",
+};
+
+void SIMDJsonExtractScalarPerPath(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareEventData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractPaths(
+      iter, vectorSize, json, kEventPaths, false);
+}
+
+void SIMDJsonExtractScalarSharedParse(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareEventData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractPaths(
+      iter, vectorSize, json, kEventPaths, true);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(FollyIsJsonScalar, 100_iters_10bytes_size, 100, 10);
@@ -607,6 +709,30 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarPerPath,
+    100_iters_2000bytes_size,
+    100,
+    2000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarSharedParse,
+    100_iters_2000bytes_size,
+    100,
+    2000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarPerPath,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    SIMDJsonExtractScalarSharedParse,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 } // namespace facebook::velox::functions::prestosql
 
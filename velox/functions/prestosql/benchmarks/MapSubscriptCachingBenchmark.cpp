@@ -15,6 +15,7 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
@@ -112,6 +113,52 @@ int main(int argc, char** argv) {
   createSetsForType(INTEGER());
   createSetsForType(VARCHAR());
 
+  // Several lookups per row into a batch of distinct wide maps. All but the
+  // first lookup share hash tables cached on the map vector.
+  auto createWideSet = [&](const TypePtr& mapType, size_t mapLength) {
+    constexpr int32_t kNumLookups = 5;
+    VectorFuzzer::Options options;
+    options.vectorSize = 1000;
+    options.containerLength = mapLength;
+    options.complexElementsMaxSize = 10000000000;
+    options.containerVariableLength = false;
+
+    VectorFuzzer fuzzer(options, pool);
+    std::vector<VectorPtr> columns;
+    auto flatMap = fuzzer.fuzzFlat(mapType);
+    columns.push_back(flatMap);
+
+    // Random existing keys of each row's map.
+    auto* map = flatMap->as<MapVector>();
+    for (auto i = 0; i < kNumLookups; ++i) {
+      auto indices = allocateIndices(options.vectorSize, pool);
+      auto* mutableIndices = indices->asMutable<vector_size_t>();
+      for (auto row = 0; row < options.vectorSize; ++row) {
+        mutableIndices[row] = map->offsetAt(row) +
+            folly::Random::rand32() % std::max(map->sizeAt(row), 1);
+      }
+      columns.push_back(BaseVector::wrapInDictionary(
+          nullptr, indices, options.vectorSize, map->mapKeys()));
+    }
+
+    std::vector<std::string> lookups;
+    for (auto i = 1; i <= kNumLookups; ++i) {
+      lookups.push_back(fmt::format("element_at(c0, c{})", i));
+    }
+
+    auto name = fmt::format(
+        "wide_{}_{}", mapType->childAt(0)->toString(), mapLength);
+    benchmarkBuilder.addBenchmarkSet(name, vm.rowVector(columns))
+        .addExpression("one", lookups[0])
+        .addExpression(
+            "five",
+            fmt::format("array_constructor({})", folly::join(", ", lookups)))
+        .withIterations(100);
+  };
+
+  createWideSet(MAP(INTEGER(), INTEGER()), 1000);
+  createWideSet(MAP(VARCHAR(), INTEGER()), 1000);
+
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
 
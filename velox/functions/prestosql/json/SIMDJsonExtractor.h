@@ -57,6 +57,11 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new SIMDJsonExtractor for 'path' that is owned by the caller.
+  /// Use this instead of getInstance when many extractors must stay valid at
+  /// the same time. Throws if 'path' is invalid.
+  static std::unique_ptr<SIMDJsonExtractor> create(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -129,7 +134,9 @@ simdjson::error_code SIMDJsonExtractor::extract(
 
 /**
  * Extract element(s) from a JSON object using the given path.
- * @param json: A JSON object
+ * @param jsonDoc: A parsed JSON document positioned at its start, i.e. just
+ *                 parsed or rewound. Extracting several paths from one
+ *                 document parses the JSON once.
  * @param path: Path to locate a JSON object. Following operators are supported.
  *              "$"      Root member of a JSON structure no matter if it's an
  *                       object, an array, or a scalar.
@@ -147,12 +154,9 @@ simdjson::error_code SIMDJsonExtractor::extract(
  */
 template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
-    const velox::StringView& json,
+    simdjson::ondemand::document& jsonDoc,
     SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
@@ -163,4 +167,16 @@ simdjson::error_code simdJsonExtract(
   return extractor.extract(value, std::forward<TConsumer>(consumer));
 }
 
+/// Same as above for a JSON string, which is parsed for each call.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    const velox::StringView& json,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  simdjson::padded_string paddedJson(json.data(), json.size());
+  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return simdJsonExtract(
+      jsonDoc, extractor, std::forward<TConsumer>(consumer));
+}
+
 } // namespace facebook::velox::functions
@@ -71,6 +71,13 @@ void registerJsonFunctions(const std::string& prefix) {
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_format, prefix + "json_format");
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_parse, prefix + "json_parse");
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_json_extract_scalars, kJsonExtractScalarsName);
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalars(
+        prefix + "json_extract_scalar", prefix + "subscript", exprs);
+  });
 }
 
 } // namespace facebook::velox::functions
@@ -13,6 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <mutex>
+#include <unordered_set>
+
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/Re2Functions.h"
 #include "velox/functions/prestosql/RegexpReplace.h"
@@ -94,6 +97,21 @@ void registerSimpleFunctions(const std::string& prefix) {
   registerFunction<Re2RegexpSplit, Array<Varchar>, Varchar, Varchar>(
       {prefix + "regexp_split"});
 }
+
+// Registers the rewrite of regexp_like CASE chains once per 'prefix', so that
+// registering the string functions again does not add a duplicate rewrite.
+void registerRegexpLikeSwitchRewrite(const std::string& prefix) {
+  static std::mutex mutex;
+  static std::unordered_set<std::string> registeredPrefixes;
+  std::lock_guard<std::mutex> l(mutex);
+  if (!registeredPrefixes.insert(prefix).second) {
+    return;
+  }
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteRegexpLikeSwitch(
+        prefix + "regexp_like", prefix + "eq", expr);
+  });
+}
 } // namespace
 
 void registerStringFunctions(const std::string& prefix) {
@@ -123,6 +141,9 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      kRe2FirstSearchName, re2FirstSearchSignatures(), makeRe2FirstSearch);
+  registerRegexpLikeSwitchRewrite(prefix);
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
@@ -15,6 +15,7 @@
  */
 
 #include <optional>
+#include <unordered_set>
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -325,6 +326,39 @@ TEST_F(ArrayDistinctTest, nonContiguousRows) {
   assertEqualVectors(expected, result);
 }
 
+// Arrays up to and beyond the size up to which duplicates are found without
+// hashing.
+TEST_F(ArrayDistinctTest, shortAndLongArrays) {
+  // Element 'i' of each array is i % 7, or NaN if that is 3, or null if i is
+  // 5.
+  auto key = [](auto i) { return i == 5 ? -1 : i % 7; };
+  auto toValue = [](int32_t key) -> std::optional<double> {
+    if (key == -1) {
+      return std::nullopt;
+    }
+    return key == 3 ? std::nan("") : key;
+  };
+
+  std::vector<std::vector<std::optional<double>>> data;
+  std::vector<std::vector<std::optional<double>>> expected;
+  for (auto size = 0; size < 80; ++size) {
+    auto& array = data.emplace_back();
+    auto& distinct = expected.emplace_back();
+    std::unordered_set<int32_t> seen;
+    for (auto i = 0; i < size; ++i) {
+      array.push_back(toValue(key(i)));
+      if (seen.insert(key(i)).second) {
+        distinct.push_back(toValue(key(i)));
+      }
+    }
+  }
+
+  testExpr(
+      makeNullableArrayVector(expected),
+      "array_distinct(C0)",
+      {makeNullableArrayVector(data)});
+}
+
 TEST_F(ArrayDistinctTest, constant) {
   vector_size_t size = 1'000;
   auto data =
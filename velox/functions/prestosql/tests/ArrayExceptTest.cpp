@@ -15,6 +15,7 @@
  */
 
 #include <optional>
+#include <unordered_set>
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/vector/tests/TestingDictionaryArrayElementsFunction.h"
 
@@ -278,6 +279,49 @@ TEST_F(ArrayExceptTest, varbinary) {
   testExpr(expected, "array_except(c0, c1)", {right, left});
 }
 
+// Arrays up to and beyond the size up to which elements are found without
+// hashing, on either side.
+TEST_F(ArrayExceptTest, shortAndLongArrays) {
+  // Keys of the elements of the arrays. Key 3 is NaN and key -1 is null.
+  auto leftKey = [](auto i) { return i == 5 ? -1 : i % 7; };
+  auto rightKey = [](auto i) { return i == 2 ? -1 : (i * 3) % 11; };
+  auto toValue = [](int32_t key) -> std::optional<double> {
+    if (key == -1) {
+      return std::nullopt;
+    }
+    return key == 3 ? std::nan("") : key;
+  };
+
+  std::vector<std::vector<std::optional<double>>> left;
+  std::vector<std::vector<std::optional<double>>> right;
+  std::vector<std::vector<std::optional<double>>> expected;
+  for (auto row = 0; row < 80; ++row) {
+    const auto leftSize = row;
+    const auto rightSize = (row * 7) % 80;
+    std::unordered_set<int32_t> rightKeys;
+    auto& rightArray = right.emplace_back();
+    for (auto i = 0; i < rightSize; ++i) {
+      rightArray.push_back(toValue(rightKey(i)));
+      rightKeys.insert(rightKey(i));
+    }
+    std::unordered_set<int32_t> outputKeys;
+    auto& leftArray = left.emplace_back();
+    auto& expectedArray = expected.emplace_back();
+    for (auto i = 0; i < leftSize; ++i) {
+      leftArray.push_back(toValue(leftKey(i)));
+      if (rightKeys.count(leftKey(i)) == 0 &&
+          outputKeys.insert(leftKey(i)).second) {
+        expectedArray.push_back(toValue(leftKey(i)));
+      }
+    }
+  }
+
+  testExpr(
+      makeNullableArrayVector(expected),
+      "array_except(C0, C1)",
+      {makeNullableArrayVector(left), makeNullableArrayVector(right)});
+}
+
 // When one of the arrays is constant.
 TEST_F(ArrayExceptTest, constant) {
   auto array1 = makeNullableArrayVector<int32_t>({
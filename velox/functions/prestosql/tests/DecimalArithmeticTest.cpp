@@ -230,6 +230,30 @@ TEST_F(DecimalArithmeticTest, subtract) {
       "Decimal overflow: 1 - -99999999999999999999999999999999999999");
 }
 
+TEST_F(DecimalArithmeticTest, shortDecimalRescale) {
+  // Short decimals with different scales and a short result are computed in
+  // 64 bits.
+  auto a = makeFlatVector<int64_t>({12345, -99, 0}, DECIMAL(10, 2));
+  auto b = makeFlatVector<int64_t>({1, 5000, -9999}, DECIMAL(12, 4));
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({1234501, -4900, -9999}, DECIMAL(13, 4)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({1234499, -14900, 9999}, DECIMAL(13, 4)),
+      "c0 - c1",
+      {a, b});
+
+  // The largest values of a short result.
+  auto large = makeFlatVector<int64_t>(
+      {99'999'999'999'999'999, -99'999'999'999'999'999}, DECIMAL(17, 0));
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          {199'999'999'999'999'998, -199'999'999'999'999'998}, DECIMAL(18, 0)),
+      "c0 + c1",
+      {large, large});
+}
+
 TEST_F(DecimalArithmeticTest, multiply) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Multiply short and short, returning long.
@@ -1174,6 +1174,55 @@ TEST_F(ElementAtTest, testCachingOptimzation) {
   }
 }
 
+TEST_F(ElementAtTest, sharedKeyIndex) {
+  // 10 maps of 200 entries and one of 5. Keys are 0, 3, 6,... and values are
+  // 1000 * row + position in map.
+  auto rowAt = [](vector_size_t idx) { return std::min(idx / 200, 10); };
+  auto positionAt = [&](vector_size_t idx) { return idx - rowAt(idx) * 200; };
+  auto mapVector = makeMapVector<int64_t, int64_t>(
+      11,
+      [](auto row) { return row < 10 ? 200 : 5; },
+      [&](auto idx) { return positionAt(idx) * 3; },
+      [&](auto idx) { return rowAt(idx) * 1000 + positionAt(idx); });
+  auto data = makeRowVector({mapVector});
+  EXPECT_EQ(mapVector->keyIndex(), nullptr);
+
+  // The first lookup only marks the vector.
+  auto result = evaluate("element_at(c0, 3)", data);
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(11, [](auto row) { return row * 1000 + 1; }),
+      result);
+  auto marker = mapVector->keyIndex();
+  EXPECT_NE(marker, nullptr);
+
+  // The second builds the index.
+  result = evaluate("element_at(c0, 597) + element_at(c0, 6)", data);
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(
+          11,
+          [](auto row) { return row * 2000 + 201; },
+          [](auto row) { return row == 10; }),
+      result);
+  auto index = mapVector->keyIndex();
+  EXPECT_NE(index, nullptr);
+  EXPECT_NE(index, marker);
+
+  // Later lookups reuse the index.
+  result = evaluate("element_at(c0, 4)", data);
+  test::assertEqualVectors(makeNullConstant(TypeKind::BIGINT, 11), result);
+  EXPECT_EQ(mapVector->keyIndex(), index);
+
+  result = evaluate("element_at(c0, 0)", data);
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(11, [](auto row) { return row * 1000; }),
+      result);
+  EXPECT_EQ(mapVector->keyIndex(), index);
+
+  // Changing the keys drops the index.
+  mapVector->setKeysAndValues(mapVector->mapKeys(), mapVector->mapValues());
+  EXPECT_EQ(mapVector->keyIndex(), nullptr);
+}
+
 TEST_F(ElementAtTest, floatingPointCornerCases) {
   // Verify that different code paths (keys of simple types, complex types and
   // optimized caching) correctly identify NaNs and treat all NaNs with
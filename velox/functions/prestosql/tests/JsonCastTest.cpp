@@ -1100,6 +1100,31 @@ TEST_F(JsonCastTest, toRowOfArray) {
   testCast(data, expected);
 }
 
+TEST_F(JsonCastTest, toArrayOfRow) {
+  // Objects cast to the same ROW type within and across rows. Fields set in
+  // one object must not be set in the next.
+  auto data = makeFlatVector<std::string>(
+      {
+          R"([{"a": 1, "b": "x"}, {"B": "y"}, {"A": 3}])",
+          R"([{"b": "z", "a": 4}, {}])",
+          R"([{"a": 5, "b": "w", "c": 6}])",
+      },
+      JSON());
+
+  auto expected = makeArrayVector(
+      {0, 3, 5},
+      makeRowVector(
+          {"a", "b"},
+          {
+              makeNullableFlatVector<int64_t>(
+                  {1, std::nullopt, 3, 4, std::nullopt, 5}),
+              makeNullableFlatVector<std::string>(
+                  {"x", "y", std::nullopt, "z", std::nullopt, "w"}),
+          }));
+
+  testCast(data, expected);
+}
+
 TEST_F(JsonCastTest, toRowDuplicateKey) {
   std::vector<std::optional<std::string>> jsonStrings = {
       R"({"c0": 1, "c1": 1.1})",
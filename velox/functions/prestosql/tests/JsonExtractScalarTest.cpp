@@ -235,6 +235,84 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>({
+      R"({"a": 1, "b": {"c": "x"}, "d": [true]})",
+      R"({"a": "s", "d": [1, 2]})",
+      std::nullopt,
+      "not json",
+      R"({"b": {"c": 5}, "a": [1]})",
+  })});
+
+  // The calls on c0 in all expressions share one parse per document.
+  auto exprSet = compileExpressions(
+      {"json_extract_scalar(c0, '$.a')",
+       "json_extract_scalar(c0, '$.b.c')",
+       "concat(json_extract_scalar(c0, '$.a'), "
+       "json_extract_scalar(c0, '$.d[*]'))"},
+      asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find(functions::kJsonExtractScalarsName),
+      std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  std::vector<VectorPtr> results(3);
+  exprSet->eval(SelectivityVector(data->size()), context, results);
+
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"1", "s", std::nullopt, std::nullopt, std::nullopt}),
+      results[0]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"x", std::nullopt, std::nullopt, std::nullopt, "5"}),
+      results[1]);
+  velox::test::assertEqualVectors(
+      makeNullableFlatVector<std::string>(
+          {"1true", std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+      results[2]);
+
+  // Rows that are not selected are null.
+  SelectivityVector rows(data->size(), false);
+  rows.setValid(1, true);
+  rows.setValid(4, true);
+  rows.updateBounds();
+  auto result = evaluate(
+      fmt::format("\"{}\"(c0, array['$.a', '$.b.c'])", kJsonExtractScalarsName),
+      data,
+      rows);
+  ASSERT_EQ(result->size(), rows.end());
+  for (auto i = 0; i < result->size(); ++i) {
+    ASSERT_EQ(result->isNullAt(i), !rows.isValid(i)) << i;
+  }
+  velox::test::assertEqualVectors(
+      makeNullableArrayVector<std::string>({
+          std::nullopt,
+          {{"s", std::nullopt}},
+          std::nullopt,
+          std::nullopt,
+          {{std::nullopt, "5"}},
+      }),
+      result,
+      rows);
+
+  // A single path is extracted as before.
+  exprSet = compileExpressions(
+      {"json_extract_scalar(c0, '$.a')", "json_extract_scalar(c0, '$.a')"},
+      asRowType(data->type()));
+  ASSERT_EQ(
+      exprSet->toString().find(functions::kJsonExtractScalarsName),
+      std::string::npos);
+
+  // Invalid paths are not extracted together and fail as before.
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "concat(json_extract_scalar(c0, '$.a'), "
+          "json_extract_scalar(c0, '$.b'), json_extract_scalar(c0, '$.k1]'))",
+          data),
+      "Invalid JSON path");
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -642,11 +642,95 @@ simdjson::error_code appendMapKey<TypeKind::TIMESTAMP>(
   return simdjson::INCORRECT_TYPE;
 }
 
+// Mapping from lower-case field names of a target RowType to their indices.
+// Also tracks the fields set from the current JSON object.
+class FieldIndices {
+ public:
+  explicit FieldIndices(const RowType& rowType)
+      : fieldSetIn_(rowType.size(), 0) {
+    for (const auto& name : rowType.names()) {
+      allFieldsAreAscii_ &=
+          functions::stringCore::isAscii(name.data(), name.size());
+    }
+    for (column_index_t i = 0; i < rowType.size(); ++i) {
+      std::string name = rowType.nameOf(i);
+      toLower(name);
+      indices_[name] = i;
+    }
+  }
+
+  // Lower-cases 'key' in place and returns the index of the field with that
+  // name, if any.
+  std::optional<column_index_t> find(std::string& key) const {
+    toLower(key);
+    auto it = indices_.find(key);
+    if (it == indices_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  // Starts a new JSON object with no fields set.
+  void startObject() {
+    ++numObjects_;
+  }
+
+  // Marks field 'index' as set in the current object. Returns false if it was
+  // set already.
+  bool markSet(column_index_t index) {
+    if (fieldSetIn_[index] == numObjects_) {
+      return false;
+    }
+    fieldSetIn_[index] = numObjects_;
+    return true;
+  }
+
+  bool isSet(column_index_t index) const {
+    return fieldSetIn_[index] == numObjects_;
+  }
+
+ private:
+  void toLower(std::string& s) const {
+    // boost::algorithm::to_lower is very slow. Use much faster
+    // folly::toLowerAscii if possible.
+    if (allFieldsAreAscii_) {
+      folly::toLowerAscii(s);
+    } else {
+      boost::algorithm::to_lower(s);
+    }
+  }
+
+  bool allFieldsAreAscii_{true};
+  folly::F14FastMap<std::string, column_index_t> indices_;
+  // The number of the last object that set each field. Avoids clearing flags
+  // for each object.
+  std::vector<uint64_t> fieldSetIn_;
+  uint64_t numObjects_{0};
+};
+
+// FieldIndices for the target RowTypes of a cast from JSON. Built on first use
+// and shared by all rows of a batch instead of being rebuilt for every JSON
+// object.
+class FieldIndicesCache {
+ public:
+  FieldIndices& get(const RowType& rowType) {
+    auto& indices = cache_[&rowType];
+    if (indices == nullptr) {
+      indices = std::make_unique<FieldIndices>(rowType);
+    }
+    return *indices;
+  }
+
+ private:
+  folly::F14FastMap<const RowType*, std::unique_ptr<FieldIndices>> cache_;
+};
+
 template <typename Input>
 struct CastFromJsonTypedImpl {
   template <TypeKind kind>
-  static simdjson::error_code apply(Input input, exec::GenericWriter& writer) {
-    return KindDispatcher<kind>::apply(input, writer);
+  static simdjson::error_code
+  apply(Input input, exec::GenericWriter& writer, FieldIndicesCache& cache) {
+    return KindDispatcher<kind>::apply(input, writer, cache);
   }
 
  private:
@@ -654,7 +738,8 @@ struct CastFromJsonTypedImpl {
   // class.
   template <TypeKind kind, typename Dummy = void>
   struct KindDispatcher {
-    static simdjson::error_code apply(Input, exec::GenericWriter&) {
+    static simdjson::error_code
+    apply(Input, exec::GenericWriter&, FieldIndicesCache&) {
       VELOX_NYI(
           "Casting from JSON to {} is not supported.", TypeTraits<kind>::name);
       return simdjson::error_code::UNEXPECTED_ERROR; // Make compiler happy.
@@ -665,7 +750,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::VARCHAR, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
       std::string_view s;
       if (isJsonType(writer.type())) {
@@ -693,7 +779,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::BOOLEAN, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
       auto& w = writer.castTo<bool>();
       switch (type) {
@@ -735,7 +822,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::TINYINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       return castJsonToInt<int8_t>(value, writer);
     }
   };
@@ -744,7 +832,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::SMALLINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       return castJsonToInt<int16_t>(value, writer);
     }
   };
@@ -753,7 +842,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::INTEGER, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       return castJsonToInt<int32_t>(value, writer);
     }
   };
@@ -762,7 +852,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::BIGINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       return castJsonToInt<int64_t>(value, writer);
     }
   };
@@ -771,7 +862,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::REAL, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       return castJsonToFloatingPoint<float>(value, writer);
     }
   };
@@ -780,7 +872,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::DOUBLE, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& /*cache*/) {
       return castJsonToFloatingPoint<double>(value, writer);
     }
   };
@@ -789,7 +882,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::ARRAY, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& cache) {
       auto& writerTyped = writer.castTo<Array<Any>>();
       auto& elementType = writer.type()->childAt(0);
       SIMDJSON_ASSIGN_OR_RAISE(auto array, value.get_array());
@@ -804,7 +898,8 @@ struct CastFromJsonTypedImpl {
               CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
               elementType->kind(),
               element,
-              writerTyped.add_item()));
+              writerTyped.add_item(),
+              cache));
         }
       }
       return simdjson::SUCCESS;
@@ -815,7 +910,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::MAP, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& cache) {
       auto& writerTyped = writer.castTo<Map<Any, Any>>();
       auto& keyType = writer.type()->childAt(0);
       auto& valueType = writer.type()->childAt(1);
@@ -836,37 +932,20 @@ struct CastFromJsonTypedImpl {
               CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
               valueType->kind(),
               field.value(),
-              std::get<1>(writers)));
+              std::get<1>(writers),
+              cache));
         }
       }
       return simdjson::SUCCESS;
     }
   };
 
-  static folly::F14FastMap<std::string, int32_t> makeFieldIndicesMap(
-      const RowType& rowType,
-      bool allFieldsAreAscii) {
-    folly::F14FastMap<std::string, int32_t> fieldIndices;
-    const auto size = rowType.size();
-    for (auto i = 0; i < size; ++i) {
-      std::string key = rowType.nameOf(i);
-      if (allFieldsAreAscii) {
-        folly::toLowerAscii(key);
-      } else {
-        boost::algorithm::to_lower(key);
-      }
-
-      fieldIndices[key] = i;
-    }
-
-    return fieldIndices;
-  }
-
   template <typename Dummy>
   struct KindDispatcher<TypeKind::ROW, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        FieldIndicesCache& cache) {
       auto& rowType = writer.type()->asRow();
       auto& writerTyped = writer.castTo<DynamicRow>();
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
@@ -886,25 +965,15 @@ struct CastFromJsonTypedImpl {
                 CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
                 rowType.childAt(i)->kind(),
                 element,
-                writerTyped.get_writer_at(i)));
+                writerTyped.get_writer_at(i),
+                cache));
           }
           ++i;
         }
       } else {
         SIMDJSON_ASSIGN_OR_RAISE(auto object, value.get_object());
-
-        // TODO Populate this mapping once, not per-row.
-        // Mapping from lower-case field names of the target RowType to their
-        // indices.
-        bool allFieldsAreAscii = true;
-        const auto size = rowType.size();
-        for (auto i = 0; i < size; ++i) {
-          const auto& name = rowType.nameOf(i);
-          allFieldsAreAscii &=
-              functions::stringCore::isAscii(name.data(), name.size());
-        }
-
-        auto fieldIndices = makeFieldIndicesMap(rowType, allFieldsAreAscii);
+        auto& fieldIndices = cache.get(rowType);
+        fieldIndices.startObject();
 
         std::string key;
         for (auto fieldResult : object) {
@@ -912,33 +981,26 @@ struct CastFromJsonTypedImpl {
           if (!field.value().is_null()) {
             SIMDJSON_ASSIGN_OR_RAISE(key, field.unescaped_key(true));
 
-            // boost::algorithm::to_lower is very slow. Use much faster
-            // folly::toLowerAscii if possible.
-            if (allFieldsAreAscii) {
-              folly::toLowerAscii(key);
-            } else {
-              boost::algorithm::to_lower(key);
-            }
-
-            auto it = fieldIndices.find(key);
-            if (it != fieldIndices.end()) {
-              const auto index = it->second;
-
-              VELOX_USER_CHECK_GE(index, 0, "Duplicate field: {}", key);
-              it->second = -1;
+            auto index = fieldIndices.find(key);
+            if (index.has_value()) {
+              VELOX_USER_CHECK(
+                  fieldIndices.markSet(index.value()),
+                  "Duplicate field: {}",
+                  key);
 
               SIMDJSON_TRY(VELOX_DYNAMIC_TYPE_DISPATCH(
                   CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
-                  rowType.childAt(index)->kind(),
+                  rowType.childAt(index.value())->kind(),
                   field.value(),
-                  writerTyped.get_writer_at(index)));
+                  writerTyped.get_writer_at(index.value()),
+                  cache));
             }
           }
         }
 
-        for (const auto& [key, index] : fieldIndices) {
-          if (index >= 0) {
-            writerTyped.set_null_at(index);
+        for (column_index_t i = 0; i < rowType.size(); ++i) {
+          if (!fieldIndices.isSet(i)) {
+            writerTyped.set_null_at(i);
           }
         }
       }
@@ -1030,14 +1092,15 @@ struct CastFromJsonTypedImpl {
 template <TypeKind kind>
 simdjson::error_code castFromJsonOneRow(
     simdjson::padded_string_view input,
-    exec::VectorWriter<Any>& writer) {
+    exec::VectorWriter<Any>& writer,
+    FieldIndicesCache& cache) {
   SIMDJSON_ASSIGN_OR_RAISE(auto doc, simdjsonParse(input));
   if (doc.is_null()) {
     writer.commitNull();
   } else {
     SIMDJSON_TRY(
         CastFromJsonTypedImpl<simdjson::ondemand::document&>::apply<kind>(
-            doc, writer.current()));
+            doc, writer.current(), cache));
     writer.commit(true);
   }
   return simdjson::SUCCESS;
@@ -1102,6 +1165,7 @@ class JsonCastOperator : public exec::CastOperator {
       maxSize = std::max(maxSize, input.size());
     });
     paddedInput_.resize(maxSize + simdjson::SIMDJSON_PADDING);
+    FieldIndicesCache fieldIndices;
     context.applyToSelectedNoThrow(rows, [&](auto row) {
       writer.setOffset(row);
       if (inputVector->isNullAt(row)) {
@@ -1112,7 +1176,8 @@ class JsonCastOperator : public exec::CastOperator {
       memcpy(paddedInput_.data(), input.data(), input.size());
       simdjson::padded_string_view paddedInput(
           paddedInput_.data(), input.size(), paddedInput_.size());
-      if (auto error = castFromJsonOneRow<kind>(paddedInput, writer)) {
+      if (auto error =
+              castFromJsonOneRow<kind>(paddedInput, writer, fieldIndices)) {
         context.setVeloxExceptionError(row, errors_[error]);
         writer.commitNull();
       }
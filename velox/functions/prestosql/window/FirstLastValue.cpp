@@ -47,6 +47,12 @@ class FirstLastValueFunction : public exec::WindowFunction {
     partition_ = partition;
   }
 
+  std::optional<RowsAccess> rowsAccess() const override {
+    RowsAccess access;
+    access.readsFrames = true;
+    return access;
+  }
+
   void apply(
       const BufferPtr& /*peerGroupStarts*/,
       const BufferPtr& /*peerGroupEnds*/,
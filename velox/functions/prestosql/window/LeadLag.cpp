@@ -55,6 +55,23 @@ class LeadLagFunction : public exec::WindowFunction {
     }
   }
 
+  std::optional<RowsAccess> rowsAccess() const override {
+    // Nulls are ignored over the whole partition and offsets in a column can
+    // reach any row.
+    if (ignoreNulls_ ||
+        !(constantOffset_.has_value() || isConstantOffsetNull_)) {
+      return std::nullopt;
+    }
+    RowsAccess access;
+    const auto offset = constantOffset_.value_or(0);
+    if constexpr (isLag) {
+      access.preceding = offset;
+    } else {
+      access.following = offset;
+    }
+    return access;
+  }
+
   void apply(
       const BufferPtr& /*peerGroupStarts*/,
       const BufferPtr& /*peerGroupEnds*/,
@@ -65,6 +82,12 @@ class LeadLagFunction : public exec::WindowFunction {
       const VectorPtr& result) override {
     const auto numRows = frameStarts->size() / sizeof(vector_size_t);
 
+    if (constantOffset_.has_value() && !ignoreNullsForPartition_) {
+      extractAtConstantOffset(numRows, resultOffset, result);
+      partitionOffset_ += numRows;
+      return;
+    }
+
     rowNumbers_.resize(numRows);
 
     if (constantOffset_.has_value() || isConstantOffsetNull_) {
@@ -139,6 +162,51 @@ class LeadLagFunction : public exec::WindowFunction {
     }
   }
 
+  // Copies the rows at the constant offset from the current rows, which are
+  // consecutive, with one range extraction. The rows whose offset is outside
+  // of the partition are set to the default value or null.
+  void extractAtConstantOffset(
+      vector_size_t numRows,
+      int32_t resultOffset,
+      const VectorPtr& result) {
+    // Offsets past the end of the partition give the same result.
+    const int64_t offset = std::min<int64_t>(
+        constantOffset_.value(), partition_->numRows() + 1);
+    // Row of the partition for the first current row. The rows for the
+    // current rows from 'begin' to 'end' are in the partition.
+    const int64_t first =
+        isLag ? partitionOffset_ - offset : partitionOffset_ + offset;
+    const vector_size_t begin =
+        std::clamp<int64_t>(-first, 0, static_cast<int64_t>(numRows));
+    const vector_size_t end = std::clamp<int64_t>(
+        partition_->numRows() - first, begin, static_cast<int64_t>(numRows));
+    if (begin < end) {
+      partition_->extractColumn(
+          valueIndex_,
+          first + begin,
+          end - begin,
+          resultOffset + begin,
+          result);
+    }
+    if (begin == 0 && end == numRows) {
+      return;
+    }
+
+    result->resize(resultOffset + numRows);
+    for (auto i = 0; i < begin; ++i) {
+      result->setNull(resultOffset + i, true);
+    }
+    for (auto i = end; i < numRows; ++i) {
+      result->setNull(resultOffset + i, true);
+    }
+    if (constantDefaultValue_ || defaultValueIndex_) {
+      // Only the rows marked with kDefaultValueRow are used.
+      rowNumbers_.assign(numRows, kDefaultValueRow);
+      std::fill(rowNumbers_.begin() + begin, rowNumbers_.begin() + end, 0);
+      setDefaultValue(result, resultOffset);
+    }
+  }
+
   void setRowNumbersForConstantOffset(vector_size_t offset);
 
   void setRowNumbersForConstantOffset() {
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+
+static constexpr int32_t kNumVectors = 10;
+static constexpr int32_t kRowsPerVector = 10'000;
+
+namespace {
+
+// Measures aggregate window functions over frames of increasing size that
+// slide over a few large partitions.
+class WindowBenchmark : public OperatorTestBase {
+ public:
+  WindowBenchmark() {
+    OperatorTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+
+    VectorFuzzer::Options opts;
+    opts.vectorSize = kRowsPerVector;
+    opts.nullRatio = 0.1;
+    VectorFuzzer fuzzer(opts, pool(), FLAGS_fuzzer_seed);
+
+    for (auto i = 0; i < kNumVectors; ++i) {
+      vectors_.push_back(makeRowVector(
+          {"p", "s", "v"},
+          {makeFlatVector<int32_t>(
+               kRowsPerVector, [](auto row) { return row % 4; }),
+           makeFlatVector<int64_t>(
+               kRowsPerVector,
+               [i](auto row) { return i * kRowsPerVector + row; }),
+           fuzzer.fuzzFlat(INTEGER())}));
+    }
+  }
+
+  ~WindowBenchmark() override {
+    OperatorTestBase::TearDown();
+  }
+
+  void TestBody() override {}
+
+  void run(const std::string& function, const std::string& frame) {
+    folly::BenchmarkSuspender suspender;
+    auto plan = PlanBuilder()
+                    .values(vectors_)
+                    .window({fmt::format(
+                        "{} over (partition by p order by s {})",
+                        function,
+                        frame)})
+                    .planNode();
+    suspender.dismiss();
+
+    auto result = AssertQueryBuilder(plan).copyResults(pool());
+    folly::doNotOptimizeAway(result);
+  }
+
+ private:
+  std::vector<RowVectorPtr> vectors_;
+};
+
+std::unique_ptr<WindowBenchmark> benchmark;
+
+BENCHMARK(sumRunning) {
+  benchmark->run("sum(v)", "rows between unbounded preceding and current row");
+}
+
+BENCHMARK_RELATIVE(sumSliding100) {
+  benchmark->run("sum(v)", "rows between 100 preceding and current row");
+}
+
+BENCHMARK_RELATIVE(sumSliding1000) {
+  benchmark->run("sum(v)", "rows between 1000 preceding and current row");
+}
+
+BENCHMARK_RELATIVE(sumSliding10000) {
+  benchmark->run("sum(v)", "rows between 10000 preceding and current row");
+}
+
+BENCHMARK_RELATIVE(minSliding10000) {
+  benchmark->run("min(v)", "rows between 10000 preceding and current row");
+}
+
+BENCHMARK_RELATIVE(avgSliding10000) {
+  benchmark->run("avg(v)", "rows between 5000 preceding and 5000 following");
+}
+
+BENCHMARK_RELATIVE(varianceSliding10000) {
+  benchmark->run(
+      "var_samp(v)", "rows between 10000 preceding and current row");
+}
+
+BENCHMARK_RELATIVE(countSliding10000) {
+  benchmark->run("count(v)", "rows between 5000 preceding and 5000 following");
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(lag1) {
+  benchmark->run("lag(v, 1)", "");
+}
+
+BENCHMARK_RELATIVE(lead10) {
+  benchmark->run("lead(v, 10)", "");
+}
+
+BENCHMARK_RELATIVE(leadWithDefault) {
+  benchmark->run("lead(v, 10, -1)", "");
+}
+
+BENCHMARK_RELATIVE(firstValueSliding100) {
+  benchmark->run(
+      "first_value(v)", "rows between 100 preceding and 100 following");
+}
+
+BENCHMARK_RELATIVE(lastValueSliding100) {
+  benchmark->run(
+      "last_value(v)", "rows between 100 preceding and 100 following");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+
+  OperatorTestBase::SetUpTestCase();
+  benchmark = std::make_unique<WindowBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  OperatorTestBase::TearDownTestCase();
+  return 0;
+}
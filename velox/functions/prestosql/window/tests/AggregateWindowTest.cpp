@@ -210,6 +210,117 @@ TEST_F(AggregateWindowTest, nonNullEmptyResult) {
       {input}, "count(c1)", overClause, frameClause, expected);
 }
 
+// Tests frames that slide over large ranges of rows, which are computed from
+// the previous frame or from a segment tree of partial aggregates.
+TEST_F(AggregateWindowTest, largeSlidingFrames) {
+  auto makeInput = [&](vector_size_t size, vector_size_t offset) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+        makeFlatVector<int32_t>(size, [&](auto row) { return row + offset; }),
+        makeFlatVector<int64_t>(
+            size,
+            [&](auto row) { return (row + offset) * 7919 % 1000 - 500; },
+            nullEvery(11)),
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return (row + offset) % 2000; }),
+    });
+  };
+  auto input = {makeInput(10'000, 0), makeInput(5'000, 10'000)};
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 1000 preceding and current row",
+      "rows between 500 preceding and 700 following",
+      "rows between 3000 preceding and 100 following",
+      "rows between c3 preceding and c3 following",
+      "rows between c3 preceding and unbounded following",
+  };
+  const std::string overClause = "partition by c0 order by c1";
+  bool createTable = true;
+  for (const auto& function : kAggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        input, function, {overClause}, frameClauses, createTable);
+    createTable = false;
+  }
+}
+
+// Tests sliding frames of aggregates that remove the rows leaving the frame
+// and of aggregates that return their smallest or largest input.
+TEST_F(AggregateWindowTest, slidingFrames) {
+  auto makeInput = [&](vector_size_t size, vector_size_t offset) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+        makeFlatVector<int32_t>(size, [&](auto row) { return row + offset; }),
+        makeFlatVector<int64_t>(
+            size,
+            [&](auto row) { return (row + offset) * 7919 % 1000 - 500; },
+            nullEvery(7)),
+        makeFlatVector<double>(
+            size,
+            [&](auto row) { return (row + offset) % 101 * 0.5; },
+            // Long runs of nulls empty the frames.
+            [&](auto row) { return (row + offset) % 500 < 50; }),
+        makeFlatVector<bool>(
+            size,
+            [&](auto row) { return (row + offset) % 97 != 0; },
+            nullEvery(5)),
+        makeFlatVector<std::string>(
+            size,
+            [&](auto row) {
+              return fmt::format("s{}", (row + offset) * 31 % 1000);
+            },
+            nullEvery(13)),
+    });
+  };
+  auto input = {makeInput(2'000, 0), makeInput(1'000, 2'000)};
+
+  const std::vector<std::string> functions = {
+      "count(1)",
+      "count(c3)",
+      "count_if(c4)",
+      "sum(c3)",
+      "avg(c2)",
+      "var_samp(c3)",
+      "stddev_pop(c2)",
+      "min(c2)",
+      "max(c3)",
+      "min(c5)",
+      "max(c5)",
+      "bool_and(c4)",
+      "bool_or(c4)",
+  };
+  const std::vector<std::string> frameClauses = {
+      "rows between 2 preceding and current row",
+      "rows between 100 preceding and 30 following",
+      "rows between 5 following and 60 following",
+      "rows between 20 preceding and 10 preceding",
+  };
+  const std::string overClause = "partition by c0 order by c1";
+  bool createTable = true;
+  for (const auto& function : functions) {
+    WindowTestBase::testWindowFunction(
+        input, function, {overClause}, frameClauses, createTable);
+    createTable = false;
+  }
+}
+
+// Infinite values cannot be removed from a sum, which is then computed again
+// from the rows of the frame.
+TEST_F(AggregateWindowTest, slidingSumOfInfinity) {
+  const auto kInf = std::numeric_limits<double>::infinity();
+  auto c0 = makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6});
+  auto c1 = makeFlatVector<double>({1, kInf, 2, 3, -kInf, 4, 5});
+  auto input = makeRowVector({c0, c1});
+
+  auto expected = makeRowVector(
+      {c0, c1, makeFlatVector<double>({1, kInf, kInf, 5, -kInf, -kInf, 9})});
+  WindowTestBase::testWindowFunction(
+      {input},
+      "sum(c1)",
+      "order by c0",
+      "rows between 1 preceding and current row",
+      expected);
+}
+
 TEST_F(AggregateWindowTest, testDecimal) {
   auto size = 30;
   auto testAggregate = [&](const TypePtr& type) {
@@ -368,6 +368,40 @@ TEST_P(LeadLagTest, largePartitions) {
   }
 }
 
+// Constant offsets copy ranges of rows. Tests ranges that cross output batches
+// and partition boundaries.
+TEST_P(LeadLagTest, constantOffsetRanges) {
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(3'000, [](auto row) { return row / 1'000; }),
+      makeFlatVector<int32_t>(3'000, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          3'000,
+          [](auto row) { return fmt::format("value string {}", row); },
+          nullEvery(11)),
+      makeFlatVector<std::string>(
+          3'000, [](auto row) { return fmt::format("default {}", row); }),
+  });
+
+  createDuckDbTable({data});
+
+  auto assertResults = [&](const std::string& functionSql) {
+    auto queryInfo = buildWindowQuery(
+        {data}, functionSql, "partition by c0 order by c1", "");
+    SCOPED_TRACE(queryInfo.functionSql);
+    AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(queryInfo.querySql);
+  };
+
+  assertResults(fn("c2"));
+  assertResults(fn("c2, 0"));
+  assertResults(fn("c2, 37"));
+  assertResults(fn("c2, 999"));
+  assertResults(fn("c2, 1000"));
+  assertResults(fn("c2, 37, 'none'"));
+  assertResults(fn("c2, 300, c3"));
+}
+
 TEST_P(LeadLagTest, invalidOffset) {
   auto data = makeRowVector({
       // Values.
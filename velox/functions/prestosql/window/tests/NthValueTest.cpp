@@ -316,6 +316,35 @@ inline const std::vector<std::string> kIgnoreNullsPartitionClauses = {
     "partition by c0 order by c1 asc nulls first, c2, c3",
 };
 
+// Frame bounds at a constant offset from the current row are consecutive row
+// numbers, which are copied as ranges of rows.
+TEST_F(NthValueTest, largePartitions) {
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(3'000, [](auto row) { return row % 3; }),
+      makeFlatVector<int32_t>(3'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          3'000, [](auto row) { return row * 7; }, nullEvery(13)),
+  });
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 50 preceding and 20 following",
+      "rows between 5 following and 100 following",
+      "rows between unbounded preceding and 10 following",
+      "rows between 200 preceding and unbounded following",
+  };
+  bool createTable = true;
+  for (const auto& function :
+       {"first_value(c2)", "last_value(c2)", "nth_value(c2, 3)"}) {
+    testWindowFunction(
+        {input},
+        function,
+        {"partition by c0 order by c1"},
+        frameClauses,
+        createTable);
+    createTable = false;
+  }
+}
+
 TEST_F(NthValueTest, ignoreNulls) {
   auto input = makeSimpleVector(40);
   const std::vector<std::string> kFunctionsList = {
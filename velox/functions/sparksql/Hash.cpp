@@ -265,6 +265,82 @@ class RowVectorHasher : public SparkVectorHasher<HashClass> {
   std::vector<std::shared_ptr<SparkVectorHasher<HashClass>>> hashers_;
 };
 
+// Hashes the non-null 'rows' of a fixed-width or string column into
+// 'hashes', using the current hash of each row as its seed. Reads the values
+// buffer directly so that the loop has no per-row virtual call or encoding
+// check.
+template <typename HashClass, typename T>
+void hashColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    typename HashClass::ReturnType* hashes) {
+  if (decoded.isConstantMapping()) {
+    // A null constant has no selected rows and may have no values buffer.
+    if (!rows.hasSelections()) {
+      return;
+    }
+    const auto value = decoded.valueAt<T>(rows.begin());
+    rows.applyToSelected([&](auto row) INLINE_LAMBDA {
+      hashes[row] = hashOne<HashClass>(value, hashes[row]);
+    });
+    return;
+  }
+
+  const auto* rawValues = decoded.data<T>();
+  if (decoded.isIdentityMapping()) {
+    rows.applyToSelected([&](auto row) INLINE_LAMBDA {
+      hashes[row] = hashOne<HashClass>(rawValues[row], hashes[row]);
+    });
+  } else {
+    const auto* indices = decoded.indices();
+    rows.applyToSelected([&](auto row) INLINE_LAMBDA {
+      hashes[row] = hashOne<HashClass>(rawValues[indices[row]], hashes[row]);
+    });
+  }
+}
+
+// Column-at-a-time hashing for the scalar types whose values are stored
+// unpacked. Returns false for booleans and complex types, which go through
+// SparkVectorHasher.
+template <typename HashClass>
+bool tryHashColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    typename HashClass::ReturnType* hashes) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      hashColumn<HashClass, int8_t>(decoded, rows, hashes);
+      return true;
+    case TypeKind::SMALLINT:
+      hashColumn<HashClass, int16_t>(decoded, rows, hashes);
+      return true;
+    case TypeKind::INTEGER:
+      hashColumn<HashClass, int32_t>(decoded, rows, hashes);
+      return true;
+    case TypeKind::BIGINT:
+      hashColumn<HashClass, int64_t>(decoded, rows, hashes);
+      return true;
+    case TypeKind::HUGEINT:
+      hashColumn<HashClass, int128_t>(decoded, rows, hashes);
+      return true;
+    case TypeKind::REAL:
+      hashColumn<HashClass, float>(decoded, rows, hashes);
+      return true;
+    case TypeKind::DOUBLE:
+      hashColumn<HashClass, double>(decoded, rows, hashes);
+      return true;
+    case TypeKind::TIMESTAMP:
+      hashColumn<HashClass, Timestamp>(decoded, rows, hashes);
+      return true;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      hashColumn<HashClass, StringView>(decoded, rows, hashes);
+      return true;
+    default:
+      return false;
+  }
+}
+
 // ReturnType can be either int32_t or int64_t
 // HashClass contains the function like hashInt32
 template <
@@ -282,6 +358,7 @@ void applyWithType(
 
   auto& result = *resultRef->as<FlatVector<ReturnType>>();
   rows.applyToSelected([&](auto row) { result.set(row, hashSeed); });
+  auto* rawResult = result.mutableRawValues();
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
@@ -296,9 +373,13 @@ void applyWithType(
       selected = selectedMinusNulls.get();
     }
 
+    if (tryHashColumn<HashClass>(*decoded, *selected, rawResult)) {
+      continue;
+    }
+
     auto hasher = createVectorHasher<HashClass>(*decoded);
     selected->applyToSelected([&](auto row) {
-      result.set(row, hasher->hashNotNullAt(row, result.valueAt(row)));
+      rawResult[row] = hasher->hashNotNullAt(row, rawResult[row]);
     });
   }
 }
@@ -55,6 +55,10 @@ struct BloomFilterAccumulator {
     bloomFilter.insert(folly::hasher<int64_t>()(value));
   }
 
+  void insert(const uint64_t* hashes, int32_t size) {
+    bloomFilter.insert(hashes, size);
+  }
+
   BloomFilter<StlAllocator<uint64_t>> bloomFilter;
 };
 
@@ -140,12 +144,16 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       return;
     }
     auto mayHaveNulls = decodedRaw_.mayHaveNulls();
+    hashes_.resize(rows.countSelected());
+    int32_t numHashes = 0;
     rows.applyToSelected([&](vector_size_t row) {
       if (mayHaveNulls) {
         checkBloomFilterNotNull(decodedRaw_, row);
       }
-      accumulator->insert(decodedRaw_.valueAt<int64_t>(row));
+      hashes_[numHashes++] =
+          folly::hasher<int64_t>()(decodedRaw_.valueAt<int64_t>(row));
     });
+    accumulator->insert(hashes_.data(), numHashes);
   }
 
   void addSingleGroupIntermediateResults(
@@ -284,6 +292,8 @@ class BloomFilterAggAggregate : public exec::Aggregate {
   int64_t estimatedNumItems_ = kMissingArgument;
   int64_t numBits_ = kMissingArgument;
   int32_t capacity_ = kMissingArgument;
+  // Reusable buffer for the hashes of the values added to a single group.
+  std::vector<uint64_t> hashes_;
 };
 
 } // namespace
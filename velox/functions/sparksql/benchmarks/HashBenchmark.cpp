@@ -32,6 +32,10 @@ int main(int argc, char** argv) {
   ExpressionBenchmarkBuilder benchmarkBuilder;
 
   std::vector<TypePtr> inputTypes = {
+      INTEGER(),
+      BIGINT(),
+      DOUBLE(),
+      VARCHAR(),
       ARRAY(MAP(INTEGER(), VARCHAR())),
       ROW({"f_map", "f_array"}, {MAP(INTEGER(), VARCHAR()), ARRAY(INTEGER())}),
   };
@@ -47,6 +51,16 @@ int main(int argc, char** argv) {
         .withIterations(100);
   }
 
+  // Multiple partitioning keys as in a shuffle on (c0, c1, c2).
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "hash_partition_keys",
+          ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()}))
+      .withFuzzerOptions({.vectorSize = 1000, .nullRatio = 0.1})
+      .addExpression("hash", "hash(c0, c1, c2)")
+      .addExpression("xxhash64", "xxhash64(c0, c1, c2)")
+      .withIterations(100);
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
@@ -110,6 +110,33 @@ TEST_F(HashTest, StringInt32) {
   EXPECT_EQ(hash("", 0), 1143746540);
 }
 
+TEST_F(HashTest, encodings) {
+  auto strings = makeNullableFlatVector<std::string>({"", std::nullopt, ""});
+  auto ints = makeNullableFlatVector<int32_t>({0, 0, std::nullopt});
+  auto hash = [&](const VectorPtr& a, const VectorPtr& b) {
+    return evaluate("hash(c0, c1)", makeRowVector({a, b}));
+  };
+
+  assertEqualVectors(
+      makeFlatVector<int32_t>({1143746540, 933211791, 142593372}),
+      hash(strings, ints));
+
+  auto reversed = makeIndicesInReverse(3);
+  assertEqualVectors(
+      makeFlatVector<int32_t>({142593372, 933211791, 1143746540}),
+      hash(
+          wrapInDictionary(reversed, strings),
+          wrapInDictionary(reversed, ints)));
+
+  assertEqualVectors(
+      makeFlatVector<int32_t>({1143746540, 933211791, 1143746540}),
+      hash(strings, makeConstant<int32_t>(0, 3)));
+
+  assertEqualVectors(
+      makeFlatVector<int32_t>({142593372, 42, 142593372}),
+      hash(strings, makeNullConstant(TypeKind::INTEGER, 3)));
+}
+
 TEST_F(HashTest, Double) {
   using limits = std::numeric_limits<double>;
 
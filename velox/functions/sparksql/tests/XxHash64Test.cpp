@@ -120,6 +120,31 @@ TEST_F(XxHash64Test, varcharInt32) {
   EXPECT_EQ(xxhash64("", 0), 5333022629466737987);
 }
 
+TEST_F(XxHash64Test, encodings) {
+  auto strings = makeNullableFlatVector<std::string>({"", std::nullopt, ""});
+  auto ints = makeNullableFlatVector<int32_t>({0, 0, std::nullopt});
+  auto xxhash64 = [&](const VectorPtr& a, const VectorPtr& b) {
+    return evaluate("xxhash64(c0, c1)", makeRowVector({a, b}));
+  };
+
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          {5333022629466737987, 3614696996920510707, -7444071767201028348}),
+      xxhash64(strings, ints));
+
+  auto reversed = makeIndicesInReverse(3);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          {-7444071767201028348, 3614696996920510707, 5333022629466737987}),
+      xxhash64(
+          wrapInDictionary(reversed, strings),
+          wrapInDictionary(reversed, ints)));
+
+  assertEqualVectors(
+      makeFlatVector<int64_t>({-7444071767201028348, 42, -7444071767201028348}),
+      xxhash64(strings, makeNullConstant(TypeKind::INTEGER, 3)));
+}
+
 TEST_F(XxHash64Test, double) {
   using limits = std::numeric_limits<double>;
 
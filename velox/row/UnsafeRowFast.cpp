@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/row/UnsafeRowDeserializers.h"
 
 namespace facebook::velox::row {
 
@@ -31,6 +32,108 @@ int32_t alignBytes(int32_t numBytes) {
 bool isFixedWidth(const TypePtr& type) {
   return type->isFixedWidth() && !type->isLongDecimal();
 }
+
+bool isNullField(std::string_view row, column_index_t column) {
+  return bits::isBitSet(reinterpret_cast<const uint8_t*>(row.data()), column);
+}
+
+// Returns the variable-width data of a non-null field at 'fieldOffset'.
+std::string_view variableWidthField(std::string_view row, int32_t fieldOffset) {
+  const auto sizeAndOffset =
+      *reinterpret_cast<const uint64_t*>(row.data() + fieldOffset);
+  return std::string_view(
+      row.data() + (sizeAndOffset >> 32), sizeAndOffset & 0xffffffff);
+}
+
+template <TypeKind Kind>
+VectorPtr deserializePrimitiveColumn(
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    int32_t fieldOffset,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const vector_size_t numRows = data.size();
+  auto vector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
+  for (auto row = 0; row < numRows; ++row) {
+    if (isNullField(data[row], column)) {
+      vector->setNull(row, true);
+    }
+  }
+
+  if constexpr (std::is_same_v<T, StringView>) {
+    // Copy the strings that are not inlined into one buffer.
+    size_t totalBytes = 0;
+    for (auto row = 0; row < numRows; ++row) {
+      if (!vector->isNullAt(row)) {
+        const auto size = variableWidthField(data[row], fieldOffset).size();
+        if (size > StringView::kInlineSize) {
+          totalBytes += size;
+        }
+      }
+    }
+    char* rawBuffer = totalBytes > 0
+        ? vector->getRawStringBufferWithSpace(totalBytes, true)
+        : nullptr;
+    for (auto row = 0; row < numRows; ++row) {
+      if (vector->isNullAt(row)) {
+        continue;
+      }
+      const auto value = variableWidthField(data[row], fieldOffset);
+      if (value.size() <= StringView::kInlineSize) {
+        vector->setNoCopy(row, StringView(value.data(), value.size()));
+      } else {
+        memcpy(rawBuffer, value.data(), value.size());
+        vector->setNoCopy(row, StringView(rawBuffer, value.size()));
+        rawBuffer += value.size();
+      }
+    }
+  } else if constexpr (std::is_same_v<T, int128_t>) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (!vector->isNullAt(row)) {
+        vector->set(
+            row,
+            UnsafeRowPrimitiveBatchDeserializer::deserializeLongDecimal(
+                variableWidthField(data[row], fieldOffset)));
+      }
+    }
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    for (auto row = 0; row < numRows; ++row) {
+      vector->set(
+          row,
+          Timestamp::fromMicros(*reinterpret_cast<const int64_t*>(
+              data[row].data() + fieldOffset)));
+    }
+  } else if constexpr (std::is_same_v<T, bool>) {
+    for (auto row = 0; row < numRows; ++row) {
+      vector->set(
+          row, *reinterpret_cast<const bool*>(data[row].data() + fieldOffset));
+    }
+  } else {
+    // Null fields are zero, so all values can be copied.
+    auto* rawValues = vector->mutableRawValues();
+    for (auto row = 0; row < numRows; ++row) {
+      rawValues[row] =
+          *reinterpret_cast<const T*>(data[row].data() + fieldOffset);
+    }
+  }
+  return vector;
+}
+
+VectorPtr deserializeComplexColumn(
+    const std::vector<std::string_view>& data,
+    column_index_t column,
+    int32_t fieldOffset,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  std::vector<std::optional<std::string_view>> fields(data.size());
+  for (auto row = 0; row < data.size(); ++row) {
+    if (!isNullField(data[row], column)) {
+      fields[row] = variableWidthField(data[row], fieldOffset);
+    }
+  }
+  return UnsafeRowDeserializer::deserialize(fields, type, pool);
+}
 } // namespace
 
 // static
@@ -155,6 +258,194 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+const vector_size_t* UnsafeRowFast::childIndices(
+    vector_size_t offset,
+    vector_size_t size) {
+  childIndices_.resize(size);
+  for (auto i = 0; i < size; ++i) {
+    childIndices_[i] = decoded_.index(offset + i);
+  }
+  return childIndices_.data();
+}
+
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  const auto* indices = childIndices(offset, size);
+  std::fill(
+      sizes, sizes + size, rowNullBytes_ + children_.size() * kFieldWidth);
+  for (auto column = 0; column < children_.size(); ++column) {
+    if (childIsFixedWidth_[column]) {
+      continue;
+    }
+    auto& child = children_[column];
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto i = 0; i < size; ++i) {
+        if (!child.isNullAt(indices[i])) {
+          sizes[i] +=
+              alignBytes(child.decoded_.valueAt<StringView>(indices[i]).size());
+        }
+      }
+      continue;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (!child.isNullAt(indices[i])) {
+        sizes[i] += alignBytes(child.variableWidthRowSize(indices[i]));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  const auto* indices = childIndices(offset, size);
+  variableWidthOffsets_.assign(
+      size, rowNullBytes_ + kFieldWidth * children_.size());
+  for (auto column = 0; column < children_.size(); ++column) {
+    auto& child = children_[column];
+    const int32_t fieldOffset = rowNullBytes_ + column * kFieldWidth;
+
+    // Write null bits.
+    if (child.decoded_.mayHaveNulls()) {
+      for (auto i = 0; i < size; ++i) {
+        if (child.isNullAt(indices[i])) {
+          bits::setBit(buffer + bufferOffsets[i], column, true);
+        }
+      }
+    }
+
+    // Write values.
+    if (childIsFixedWidth_[column]) {
+      child.serializeFixedWidthColumn(
+          size, indices, fieldOffset, bufferOffsets, buffer);
+      continue;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (child.isNullAt(indices[i])) {
+        continue;
+      }
+      auto* row = buffer + bufferOffsets[i];
+      auto& variableWidthOffset = variableWidthOffsets_[i];
+      const auto serializedBytes =
+          child.serializeVariableWidth(indices[i], row + variableWidthOffset);
+      // Write size and offset.
+      *reinterpret_cast<uint64_t*>(row + fieldOffset) =
+          variableWidthOffset << 32 | serializedBytes;
+      variableWidthOffset += alignBytes(serializedBytes);
+    }
+  }
+}
+
+template <typename T>
+void UnsafeRowFast::scatterFixedWidth(
+    vector_size_t size,
+    const vector_size_t* indices,
+    int32_t fieldOffset,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  const auto* values = decoded_.data<T>();
+  if (values == nullptr) {
+    // All values are null.
+    return;
+  }
+  if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls()) {
+    for (auto i = 0; i < size; ++i) {
+      *reinterpret_cast<T*>(buffer + bufferOffsets[i] + fieldOffset) =
+          values[indices[i]];
+    }
+    return;
+  }
+  for (auto i = 0; i < size; ++i) {
+    if (!decoded_.isNullAt(indices[i])) {
+      *reinterpret_cast<T*>(buffer + bufferOffsets[i] + fieldOffset) =
+          values[decoded_.index(indices[i])];
+    }
+  }
+}
+
+void UnsafeRowFast::serializeFixedWidthColumn(
+    vector_size_t size,
+    const vector_size_t* indices,
+    int32_t fieldOffset,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      [[fallthrough]];
+    case TypeKind::TIMESTAMP:
+      for (auto i = 0; i < size; ++i) {
+        if (!isNullAt(indices[i])) {
+          serializeFixedWidth(
+              indices[i], buffer + bufferOffsets[i] + fieldOffset);
+        }
+      }
+      break;
+    case TypeKind::UNKNOWN:
+      // Only null values.
+      break;
+    default:
+      // Copies the values as unsigned integers of the same width.
+      switch (valueBytes_) {
+        case 1:
+          scatterFixedWidth<uint8_t>(
+              size, indices, fieldOffset, bufferOffsets, buffer);
+          break;
+        case 2:
+          scatterFixedWidth<uint16_t>(
+              size, indices, fieldOffset, bufferOffsets, buffer);
+          break;
+        case 4:
+          scatterFixedWidth<uint32_t>(
+              size, indices, fieldOffset, bufferOffsets, buffer);
+          break;
+        case 8:
+          scatterFixedWidth<uint64_t>(
+              size, indices, fieldOffset, bufferOffsets, buffer);
+          break;
+        default:
+          VELOX_UNREACHABLE("Unexpected value width: {}", valueBytes_);
+      }
+  }
+}
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  const auto numFields = rowType->size();
+  const int32_t nullBytes = alignBits(numFields);
+  std::vector<VectorPtr> columns(numFields);
+  for (auto column = 0; column < numFields; ++column) {
+    const auto& type = rowType->childAt(column);
+    const int32_t fieldOffset = nullBytes + column * kFieldWidth;
+    if (type->isUnKnown()) {
+      columns[column] =
+          BaseVector::createNullConstant(type, data.size(), pool);
+    } else if (type->isPrimitiveType()) {
+      columns[column] = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          deserializePrimitiveColumn,
+          type->kind(),
+          data,
+          column,
+          fieldOffset,
+          type,
+          pool);
+    } else {
+      columns[column] =
+          deserializeComplexColumn(data, column, fieldOffset, type, pool);
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, nullptr, data.size(), std::move(columns));
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -36,6 +36,29 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes the serialized sizes of rows [offset, offset + size) to 'sizes'.
+  /// Computes the sizes one column at a time. Use only if 'fixedRowSize'
+  /// returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes rows [offset, offset + size) one column at a time. Row
+  /// 'offset + i' is written at 'buffer + bufferOffsets[i]'. Each row must
+  /// have the space given by 'rowSizes' or 'fixedRowSize', set to all zeros.
+  /// Produces the same bytes as serializing the rows one by one.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
+  /// Deserializes 'data' into a RowVector of 'rowType' one column at a time.
+  /// Top-level columns of primitive types are read directly from the rows.
+  /// Columns of complex types are read with UnsafeRowDeserializer.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -101,6 +124,26 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Returns the indices into 'children_' of rows [offset, offset + size).
+  const vector_size_t* childIndices(vector_size_t offset, vector_size_t size);
+
+  /// Fixed-width types only. Writes the values at 'indices' to the field at
+  /// 'fieldOffset' of rows at 'buffer + bufferOffsets[i]'. Skips nulls.
+  void serializeFixedWidthColumn(
+      vector_size_t size,
+      const vector_size_t* indices,
+      int32_t fieldOffset,
+      const size_t* bufferOffsets,
+      char* buffer);
+
+  template <typename T>
+  void scatterFixedWidth(
+      vector_size_t size,
+      const vector_size_t* indices,
+      int32_t fieldOffset,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -120,5 +163,9 @@ class UnsafeRowFast {
 
   // Fixed-width types only. Number of bytes used for a single value.
   size_t valueBytes_;
+
+  // ROW type only. Scratch space for serializing rows one column at a time.
+  std::vector<vector_size_t> childIndices_;
+  std::vector<int64_t> variableWidthOffsets_;
 };
 } // namespace facebook::velox::row
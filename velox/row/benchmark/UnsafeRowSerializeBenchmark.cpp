@@ -53,6 +53,27 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(copy->size(), data->size());
   }
 
+  void serializeUnsafeColumnar(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    auto serialized = serializeColumnar(fast, rowType, data->size());
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
+  void deserializeUnsafeColumnar(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    UnsafeRowFast fast(data);
+    auto serialized = serializeColumnar(fast, rowType, data->size());
+    suspender.dismiss();
+
+    auto copy = UnsafeRowFast::deserialize(serialized, rowType, pool());
+    VELOX_CHECK_EQ(copy->size(), data->size());
+  }
+
   void serializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -152,6 +173,36 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Serializes all rows of 'unsafeRow' one column at a time.
+  std::vector<std::string_view> serializeColumnar(
+      UnsafeRowFast& unsafeRow,
+      const RowTypePtr& rowType,
+      vector_size_t numRows) {
+    std::vector<int32_t> sizes(numRows);
+    if (auto fixedRowSize = UnsafeRowFast::fixedRowSize(rowType)) {
+      std::fill(sizes.begin(), sizes.end(), fixedRowSize.value());
+    } else {
+      unsafeRow.rowSizes(0, numRows, sizes.data());
+    }
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += sizes[i];
+    }
+
+    buffer_ = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto* rawBuffer = buffer_->asMutable<char>();
+    unsafeRow.serialize(0, numRows, offsets.data(), rawBuffer);
+
+    std::vector<std::string_view> serialized;
+    serialized.reserve(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      serialized.push_back(std::string_view(rawBuffer + offsets[i], sizes[i]));
+    }
+    return serialized;
+  }
+
   size_t computeTotalSize(
       CompactRow& compactRow,
       const RowTypePtr& rowType,
@@ -203,37 +254,50 @@ class SerializeBenchmark {
 
   std::shared_ptr<memory::MemoryPool> pool_{
       memory::memoryManager()->addLeafPool()};
+
+  // Holds the rows returned by serializeColumnar().
+  BufferPtr buffer_;
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)           \
+  BENCHMARK(unsafe_serialize_##name) {            \
+    SerializeBenchmark benchmark;                 \
+    benchmark.serializeUnsafe(rowType);           \
+  }                                               \
+                                                  \
+  BENCHMARK(unsafe_columnar_serialize_##name) {   \
+    SerializeBenchmark benchmark;                 \
+    benchmark.serializeUnsafeColumnar(rowType);   \
+  }                                               \
+                                                  \
+  BENCHMARK(compact_serialize_##name) {           \
+    SerializeBenchmark benchmark;                 \
+    benchmark.serializeCompact(rowType);          \
+  }                                               \
+                                                  \
+  BENCHMARK(container_serialize_##name) {         \
+    SerializeBenchmark benchmark;                 \
+    benchmark.serializeContainer(rowType);        \
+  }                                               \
+                                                  \
+  BENCHMARK(unsafe_deserialize_##name) {          \
+    SerializeBenchmark benchmark;                 \
+    benchmark.deserializeUnsafe(rowType);         \
+  }                                               \
+                                                  \
+  BENCHMARK(unsafe_columnar_deserialize_##name) { \
+    SerializeBenchmark benchmark;                 \
+    benchmark.deserializeUnsafeColumnar(rowType); \
+  }                                               \
+                                                  \
+  BENCHMARK(compact_deserialize_##name) {         \
+    SerializeBenchmark benchmark;                 \
+    benchmark.deserializeCompact(rowType);        \
+  }                                               \
+                                                  \
+  BENCHMARK(container_deserialize_##name) {       \
+    SerializeBenchmark benchmark;                 \
+    benchmark.deserializeContainer(rowType);      \
   }
 
 SERDE_BENCHMARKS(
@@ -85,9 +85,84 @@ class UnsafeRowFuzzTests : public ::testing::Test {
           UnsafeRowDeserializer::deserialize(serialized, rowType, pool_.get());
 
       assertEqualVectors(inputVector, outputVector);
+
+      // Deserialize one column at a time.
+      std::vector<std::string_view> rows;
+      rows.reserve(serialized.size());
+      for (const auto& row : serialized) {
+        rows.push_back(row.value());
+      }
+      assertEqualVectors(
+          inputVector, UnsafeRowFast::deserialize(rows, rowType, pool_.get()));
     }
   }
 
+  static RowTypePtr fuzzRowType() {
+    return ROW({
+        BOOLEAN(),
+        TINYINT(),
+        SMALLINT(),
+        INTEGER(),
+        VARCHAR(),
+        BIGINT(),
+        REAL(),
+        DOUBLE(),
+        VARCHAR(),
+        VARBINARY(),
+        UNKNOWN(),
+        DECIMAL(20, 2),
+        DECIMAL(12, 4),
+        // Arrays.
+        ARRAY(BOOLEAN()),
+        ARRAY(TINYINT()),
+        ARRAY(SMALLINT()),
+        ARRAY(INTEGER()),
+        ARRAY(BIGINT()),
+        ARRAY(REAL()),
+        ARRAY(DOUBLE()),
+        ARRAY(VARCHAR()),
+        ARRAY(VARBINARY()),
+        ARRAY(UNKNOWN()),
+        ARRAY(DECIMAL(20, 2)),
+        ARRAY(DECIMAL(12, 4)),
+        // Nested arrays.
+        ARRAY(ARRAY(INTEGER())),
+        ARRAY(ARRAY(BIGINT())),
+        ARRAY(ARRAY(VARCHAR())),
+        ARRAY(ARRAY(UNKNOWN())),
+        // Maps.
+        MAP(BIGINT(), REAL()),
+        MAP(BIGINT(), BIGINT()),
+        MAP(BIGINT(), VARCHAR()),
+        MAP(BIGINT(), DECIMAL(20, 2)),
+        MAP(BIGINT(), DECIMAL(12, 4)),
+        MAP(INTEGER(), MAP(BIGINT(), DOUBLE())),
+        MAP(VARCHAR(), BOOLEAN()),
+        MAP(INTEGER(), MAP(BIGINT(), ARRAY(REAL()))),
+        // Timestamp and date types.
+        TIMESTAMP(),
+        DATE(),
+        ARRAY(TIMESTAMP()),
+        ARRAY(DATE()),
+        MAP(DATE(), ARRAY(TIMESTAMP())),
+        // Structs.
+        ROW(
+            {BOOLEAN(),
+             INTEGER(),
+             TIMESTAMP(),
+             DECIMAL(20, 2),
+             VARCHAR(),
+             ARRAY(BIGINT())}),
+        ROW(
+            {BOOLEAN(),
+             ROW({INTEGER(), TIMESTAMP()}),
+             VARCHAR(),
+             ARRAY(BIGINT())}),
+        ARRAY({ROW({BIGINT(), VARCHAR()})}),
+        MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
+    });
+  }
+
   static constexpr uint64_t kBufferSize = 70 << 10; // 70kb
   static constexpr uint64_t kNumBuffers = 100;
 
@@ -98,69 +173,7 @@ class UnsafeRowFuzzTests : public ::testing::Test {
 };
 
 TEST_F(UnsafeRowFuzzTests, fast) {
-  auto rowType = ROW({
-      BOOLEAN(),
-      TINYINT(),
-      SMALLINT(),
-      INTEGER(),
-      VARCHAR(),
-      BIGINT(),
-      REAL(),
-      DOUBLE(),
-      VARCHAR(),
-      VARBINARY(),
-      UNKNOWN(),
-      DECIMAL(20, 2),
-      DECIMAL(12, 4),
-      // Arrays.
-      ARRAY(BOOLEAN()),
-      ARRAY(TINYINT()),
-      ARRAY(SMALLINT()),
-      ARRAY(INTEGER()),
-      ARRAY(BIGINT()),
-      ARRAY(REAL()),
-      ARRAY(DOUBLE()),
-      ARRAY(VARCHAR()),
-      ARRAY(VARBINARY()),
-      ARRAY(UNKNOWN()),
-      ARRAY(DECIMAL(20, 2)),
-      ARRAY(DECIMAL(12, 4)),
-      // Nested arrays.
-      ARRAY(ARRAY(INTEGER())),
-      ARRAY(ARRAY(BIGINT())),
-      ARRAY(ARRAY(VARCHAR())),
-      ARRAY(ARRAY(UNKNOWN())),
-      // Maps.
-      MAP(BIGINT(), REAL()),
-      MAP(BIGINT(), BIGINT()),
-      MAP(BIGINT(), VARCHAR()),
-      MAP(BIGINT(), DECIMAL(20, 2)),
-      MAP(BIGINT(), DECIMAL(12, 4)),
-      MAP(INTEGER(), MAP(BIGINT(), DOUBLE())),
-      MAP(VARCHAR(), BOOLEAN()),
-      MAP(INTEGER(), MAP(BIGINT(), ARRAY(REAL()))),
-      // Timestamp and date types.
-      TIMESTAMP(),
-      DATE(),
-      ARRAY(TIMESTAMP()),
-      ARRAY(DATE()),
-      MAP(DATE(), ARRAY(TIMESTAMP())),
-      // Structs.
-      ROW(
-          {BOOLEAN(),
-           INTEGER(),
-           TIMESTAMP(),
-           DECIMAL(20, 2),
-           VARCHAR(),
-           ARRAY(BIGINT())}),
-      ROW(
-          {BOOLEAN(),
-           ROW({INTEGER(), TIMESTAMP()}),
-           VARCHAR(),
-           ARRAY(BIGINT())}),
-      ARRAY({ROW({BIGINT(), VARCHAR()})}),
-      MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
-  });
+  const auto rowType = fuzzRowType();
 
   doTest(rowType, [&](const RowVectorPtr& data) {
     std::vector<std::optional<std::string_view>> serialized;
@@ -179,5 +192,37 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, columnar) {
+  const auto rowType = fuzzRowType();
+
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    const auto numRows = data->size();
+    UnsafeRowFast fast(data);
+    std::vector<int32_t> sizes(numRows);
+    fast.rowSizes(0, numRows, sizes.data());
+    std::vector<size_t> offsets(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_CHECK_LE(sizes[i], kBufferSize);
+      EXPECT_EQ(sizes[i], fast.rowSize(i)) << i << ", " << data->toString(i);
+      offsets[i] = i * kBufferSize;
+    }
+    fast.serialize(
+        0, numRows, offsets.data(), reinterpret_cast<char*>(buffers_.data()));
+
+    std::vector<std::optional<std::string_view>> serialized;
+    serialized.reserve(numRows);
+    std::vector<char> row(kBufferSize);
+    for (auto i = 0; i < numRows; ++i) {
+      // The rows are the same as when serialized one by one.
+      std::fill(row.begin(), row.end(), 0);
+      EXPECT_EQ(sizes[i], fast.serialize(i, row.data()));
+      EXPECT_EQ(0, memcmp(row.data(), buffers_[i], sizes[i])) << i;
+
+      serialized.push_back(std::string_view(buffers_[i], sizes[i]));
+    }
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -21,6 +21,7 @@
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
@@ -457,6 +458,71 @@ vector_size_t sizeWithIncomingNulls(
   return numIncomingNulls == 0 ? size : numIncomingNulls;
 }
 
+raw_vector<int32_t>& threadTempEnds() {
+  thread_local raw_vector<int32_t> temp;
+  return temp;
+}
+
+// Reads the 'size' serialized end offsets of strings, arrays or maps into
+// 'ends', which must have space for 'numNewValues' values. If
+// 'incomingNulls' is given, the ends are spread to the rows that are not
+// null in 'incomingNulls' and the rows that are null repeat the previous end,
+// so that their length comes out as 0. 'firstEnd' is the end before the
+// first row.
+void readEnds(
+    ByteInputStream* source,
+    vector_size_t size,
+    const uint64_t* incomingNulls,
+    vector_size_t numNewValues,
+    int32_t firstEnd,
+    int32_t* ends) {
+  source->readBytes(ends, size * sizeof(int32_t));
+  if (incomingNulls == nullptr) {
+    return;
+  }
+  // Expand in place from the back. The next unplaced value is always at a
+  // lower position than the row being written.
+  auto numLeft = size;
+  for (auto row = numNewValues - 1; row >= 0; --row) {
+    if (bits::isBitSet(incomingNulls, row)) {
+      ends[row] = ends[--numLeft];
+    } else {
+      ends[row] = numLeft > 0 ? ends[numLeft - 1] : firstEnd;
+    }
+  }
+  VELOX_DCHECK_EQ(numLeft, 0);
+}
+
+// Sets the offsets and sizes of 'numValues' arrays or maps from their
+// cumulative 'ends'. 'firstEnd' is the end before the first array and
+// 'elementsOffset' is added to each offset.
+void endsToOffsetsAndSizes(
+    const int32_t* ends,
+    int32_t firstEnd,
+    vector_size_t numValues,
+    vector_size_t elementsOffset,
+    vector_size_t* offsets,
+    vector_size_t* sizes) {
+  if (numValues == 0) {
+    return;
+  }
+  offsets[0] = elementsOffset + firstEnd;
+  sizes[0] = ends[0] - firstEnd;
+  using Batch = xsimd::batch<int32_t>;
+  const auto bias = Batch::broadcast(elementsOffset);
+  vector_size_t i = 1;
+  for (; i + Batch::size <= numValues; i += Batch::size) {
+    const auto previous = Batch::load_unaligned(ends + i - 1);
+    const auto current = Batch::load_unaligned(ends + i);
+    (previous + bias).store_unaligned(offsets + i);
+    (current - previous).store_unaligned(sizes + i);
+  }
+  for (; i < numValues; ++i) {
+    offsets[i] = elementsOffset + ends[i - 1];
+    sizes[i] = ends[i] - ends[i - 1];
+  }
+}
+
 // Fills the nulls of 'result' from the serialized nulls in
 // 'source'. Adds nulls from 'incomingNulls' so that the null flags
 // gets padded with extra nulls where a parent RowVector has a
@@ -590,23 +656,20 @@ void read<StringView>(
   result->resize(resultOffset + numNewValues);
 
   auto flatResult = result->as<FlatVector<StringView>>();
-  BufferPtr values = flatResult->mutableValues(resultOffset + size);
+  BufferPtr values = flatResult->mutableValues(resultOffset + numNewValues);
   auto rawValues = values->asMutable<StringView>();
-  int32_t lastOffset = 0;
-  for (int32_t i = 0; i < numNewValues; ++i) {
-    // Set the first int32_t of each StringView to be the offset.
-    if (incomingNulls && bits::isBitNull(incomingNulls, i)) {
-      *reinterpret_cast<int32_t*>(&rawValues[resultOffset + i]) = lastOffset;
-      continue;
-    }
-    lastOffset = source->read<int32_t>();
-    *reinterpret_cast<int32_t*>(&rawValues[resultOffset + i]) = lastOffset;
-  }
+  auto& ends = threadTempEnds();
+  ends.resize(numNewValues);
+  readEnds(source, size, incomingNulls, numNewValues, 0, ends.data());
   readNulls(
       source, size, resultOffset, incomingNulls, numIncomingNulls, *flatResult);
 
   const int32_t dataSize = source->read<int32_t>();
   if (dataSize == 0) {
+    std::fill(
+        rawValues + resultOffset,
+        rawValues + resultOffset + numNewValues,
+        StringView());
     return;
   }
 
@@ -617,7 +680,7 @@ void read<StringView>(
   int32_t previousOffset = 0;
   auto rawChars = reinterpret_cast<char*>(rawStrings);
   for (int32_t i = 0; i < numNewValues; ++i) {
-    int32_t offset = rawValues[resultOffset + i].size();
+    const int32_t offset = ends[i];
     rawValues[resultOffset + i] =
         StringView(rawChars + previousOffset, offset - previousOffset);
     previousOffset = offset;
@@ -777,18 +840,17 @@ void readArrayVector(
   auto rawOffsets = offsets->asMutable<vector_size_t>();
   BufferPtr sizes = arrayVector->mutableSizes(resultOffset + numNewValues);
   auto rawSizes = sizes->asMutable<vector_size_t>();
-  int32_t base = source->read<int32_t>();
-  for (int32_t i = 0; i < numNewValues; ++i) {
-    if (incomingNulls && bits::isBitNull(incomingNulls, i)) {
-      rawOffsets[resultOffset + i] = 0;
-      rawSizes[resultOffset + i] = 0;
-      continue;
-    }
-    int32_t offset = source->read<int32_t>();
-    rawOffsets[resultOffset + i] = resultElementsOffset + base;
-    rawSizes[resultOffset + i] = offset - base;
-    base = offset;
-  }
+  const int32_t base = source->read<int32_t>();
+  auto& ends = threadTempEnds();
+  ends.resize(numNewValues);
+  readEnds(source, size, incomingNulls, numNewValues, base, ends.data());
+  endsToOffsetsAndSizes(
+      ends.data(),
+      base,
+      numNewValues,
+      resultElementsOffset,
+      rawOffsets + resultOffset,
+      rawSizes + resultOffset);
 
   readNulls(
       source,
@@ -838,18 +900,17 @@ void readMapVector(
   auto rawOffsets = offsets->asMutable<vector_size_t>();
   BufferPtr sizes = mapVector->mutableSizes(resultOffset + numNewValues);
   auto rawSizes = sizes->asMutable<vector_size_t>();
-  int32_t base = source->read<int32_t>();
-  for (int32_t i = 0; i < numNewValues; ++i) {
-    if (incomingNulls && bits::isBitNull(incomingNulls, i)) {
-      rawOffsets[resultOffset + i] = 0;
-      rawSizes[resultOffset + i] = 0;
-      continue;
-    }
-    int32_t offset = source->read<int32_t>();
-    rawOffsets[resultOffset + i] = resultElementsOffset + base;
-    rawSizes[resultOffset + i] = offset - base;
-    base = offset;
-  }
+  const int32_t base = source->read<int32_t>();
+  auto& ends = threadTempEnds();
+  ends.resize(numNewValues);
+  readEnds(source, size, incomingNulls, numNewValues, base, ends.data());
+  endsToOffsetsAndSizes(
+      ends.data(),
+      base,
+      numNewValues,
+      resultElementsOffset,
+      rawOffsets + resultOffset,
+      rawSizes + resultOffset);
 
   readNulls(
       source, size, resultOffset, incomingNulls, numIncomingNulls, *mapVector);
@@ -1559,21 +1620,36 @@ class VectorStream {
       int32_t numNonNull,
       LengthFunc lengthFunc) {
     const auto numRows = rows.size();
+    // The cumulative lengths are collected in a scratch array and appended
+    // to 'lengths_' in one call.
+    auto& ends = threadTempEnds();
+    ends.resize(numRows);
+    auto* rawEnds = ends.data();
     if (nulls == nullptr) {
       appendNonNull(numRows);
       for (auto i = 0; i < numRows; ++i) {
-        appendLength(lengthFunc(rows[i]));
+        totalLength_ += lengthFunc(rows[i]);
+        rawEnds[i] = totalLength_;
       }
     } else {
       appendNulls(nulls, 0, numRows, numNonNull);
-      for (auto i = 0; i < numRows; ++i) {
-        if (bits::isBitSet(nulls, i)) {
-          appendLength(lengthFunc(rows[i]));
-        } else {
-          appendLength(0);
+      if (numNonNull == numRows) {
+        for (auto i = 0; i < numRows; ++i) {
+          totalLength_ += lengthFunc(rows[i]);
+          rawEnds[i] = totalLength_;
+        }
+      } else {
+        std::fill(rawEnds, rawEnds + numRows, 0);
+        bits::forEachSetBit(nulls, 0, numRows, [&](auto i) {
+          rawEnds[i] = lengthFunc(rows[i]);
+        });
+        for (auto i = 0; i < numRows; ++i) {
+          totalLength_ += rawEnds[i];
+          rawEnds[i] = totalLength_;
         }
       }
     }
+    lengths_.append(folly::Range<const int32_t*>(rawEnds, numRows));
   }
 
   template <typename T>
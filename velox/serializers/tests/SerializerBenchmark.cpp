@@ -15,6 +15,7 @@
  */
 #include <folly/init/Init.h>
 
+#include <sstream>
 #include <vector>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/ByteStream.h"
@@ -146,6 +147,117 @@ class SerializerBenchmark : public VectorTestBase {
     }
   }
 
+  // Serializes and deserializes batches of wide rows with flat, dictionary
+  // encoded and nested columns. Strings, arrays and maps exercise the length
+  // and offset conversions and the nullable columns the null flags.
+  void timeWideRows() {
+    constexpr int32_t kNumColumns = 60;
+    constexpr int32_t kNumRepeats = 20;
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < kNumColumns; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      switch (i % 6) {
+        case 0:
+          types.push_back(BIGINT());
+          break;
+        case 1:
+          types.push_back(INTEGER());
+          break;
+        case 2:
+        case 3:
+          types.push_back(VARCHAR());
+          break;
+        case 4:
+          types.push_back(ARRAY(BIGINT()));
+          break;
+        default:
+          types.push_back(MAP(INTEGER(), VARCHAR()));
+          break;
+      }
+    }
+    auto rowType = ROW(std::move(names), std::move(types));
+
+    for (auto encoding : {"flat", "dictionary", "nested"}) {
+      VectorFuzzer::Options options;
+      options.vectorSize = 10'000;
+      options.nullRatio = 0.1;
+      options.stringLength = 20;
+      options.containerLength = 5;
+      VectorFuzzer fuzzer(options, pool_.get(), 1);
+      RowVectorPtr data;
+      if (std::string_view(encoding) == "nested") {
+        // Struct columns with nulls, so that the children are read with
+        // incoming nulls.
+        std::vector<VectorPtr> children;
+        for (auto i = 0; i < kNumColumns; i += 6) {
+          std::vector<VectorPtr> fields;
+          for (auto j = i; j < i + 6; ++j) {
+            fields.push_back(fuzzer.fuzzFlat(rowType->childAt(j)));
+          }
+          children.push_back(std::make_shared<RowVector>(
+              pool_.get(),
+              ROW({rowType->childAt(i),
+                   rowType->childAt(i + 1),
+                   rowType->childAt(i + 2),
+                   rowType->childAt(i + 3),
+                   rowType->childAt(i + 4),
+                   rowType->childAt(i + 5)}),
+              fuzzer.fuzzNulls(options.vectorSize),
+              options.vectorSize,
+              std::move(fields)));
+        }
+        data = makeRowVector(std::move(children));
+      } else if (std::string_view(encoding) == "dictionary") {
+        std::vector<VectorPtr> children;
+        for (auto& type : rowType->children()) {
+          children.push_back(fuzzer.fuzzDictionary(fuzzer.fuzzFlat(type)));
+        }
+        data = makeRowVector(rowType->names(), children);
+      } else {
+        data = fuzzer.fuzzInputFlatRow(rowType);
+      }
+      auto dataType = asRowType(data->type());
+
+      uint64_t serializeTime{0};
+      uint64_t deserializeTime{0};
+      std::string serialized;
+      for (auto repeat = 0; repeat < kNumRepeats; ++repeat) {
+        std::ostringstream out;
+        {
+          MicrosecondTimer t(&serializeTime);
+          StreamArena arena(pool_.get());
+          auto serializer = serde_->createIterativeSerializer(
+              dataType, data->size(), &arena, nullptr);
+          serializer->append(data);
+          OStreamOutputStream stream(&out);
+          serializer->flush(&stream);
+        }
+        serialized = out.str();
+        {
+          MicrosecondTimer t(&deserializeTime);
+          ByteRange range{
+              reinterpret_cast<uint8_t*>(serialized.data()),
+              static_cast<int32_t>(serialized.size()),
+              0};
+          ByteInputStream input({range});
+          RowVectorPtr result;
+          serde_->deserialize(&input, pool_.get(), dataType, &result, nullptr);
+        }
+      }
+      std::cout << fmt::format(
+                       "{} {} columns x {} rows, {} bytes: {} us serialize / "
+                       "{} us deserialize",
+                       encoding,
+                       kNumColumns,
+                       data->size(),
+                       serialized.size(),
+                       serializeTime / kNumRepeats,
+                       deserializeTime / kNumRepeats)
+                << std::endl;
+    }
+  }
+
   std::unique_ptr<serializer::presto::PrestoVectorSerde> serde_;
 };
 
@@ -155,4 +267,5 @@ int main(int argc, char** argv) {
   SerializerBenchmark bm;
   bm.setup();
   bm.timeFlat();
+  bm.timeWideRows();
 }
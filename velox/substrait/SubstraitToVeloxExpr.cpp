@@ -105,6 +105,8 @@ void setLiteralValue(
       vector->set(index, StringView(literal.string()));
     } else if (literal.has_var_char()) {
       vector->set(index, StringView(literal.var_char().value()));
+    } else if (literal.has_binary()) {
+      vector->set(index, StringView(literal.binary()));
     } else {
       VELOX_FAIL("Unexpected string literal");
     }
@@ -116,9 +118,11 @@ void setLiteralValue(
   }
 }
 
-template <TypeKind kind>
+// Writes the literals returned by 'literalAt(0)' to 'literalAt(size - 1)'
+// straight into a FlatVector, without materializing a variant per value.
+template <TypeKind kind, typename LiteralAt>
 VectorPtr constructFlatVector(
-    const ::substrait::Expression::Literal& listLiteral,
+    LiteralAt literalAt,
     const vector_size_t size,
     const TypePtr& type,
     memory::MemoryPool* pool) {
@@ -127,9 +131,8 @@ VectorPtr constructFlatVector(
   using T = typename TypeTraits<kind>::NativeType;
   auto flatVector = vector->as<FlatVector<T>>();
 
-  vector_size_t index = 0;
-  for (auto child : listLiteral.list().values()) {
-    setLiteralValue(child, flatVector, index++);
+  for (vector_size_t index = 0; index < size; ++index) {
+    setLiteralValue(literalAt(index), flatVector, index);
   }
   return vector;
 }
@@ -260,48 +263,51 @@ ArrayVectorPtr SubstraitVeloxExprConverter::literalsToArrayVector(
   if (childSize == 0) {
     return makeEmptyArrayVector(pool_);
   }
+  auto listElement = [&](vector_size_t index) -> const auto& {
+    return listLiteral.list().values(index);
+  };
   auto typeCase = listLiteral.list().values(0).literal_type_case();
   switch (typeCase) {
     case ::substrait::Expression_Literal::LiteralTypeCase::kBoolean:
       return makeArrayVector(constructFlatVector<TypeKind::BOOLEAN>(
-          listLiteral, childSize, BOOLEAN(), pool_));
+          listElement, childSize, BOOLEAN(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI8:
       return makeArrayVector(constructFlatVector<TypeKind::TINYINT>(
-          listLiteral, childSize, TINYINT(), pool_));
+          listElement, childSize, TINYINT(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI16:
       return makeArrayVector(constructFlatVector<TypeKind::SMALLINT>(
-          listLiteral, childSize, SMALLINT(), pool_));
+          listElement, childSize, SMALLINT(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI32:
       return makeArrayVector(constructFlatVector<TypeKind::INTEGER>(
-          listLiteral, childSize, INTEGER(), pool_));
+          listElement, childSize, INTEGER(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kFp32:
       return makeArrayVector(constructFlatVector<TypeKind::REAL>(
-          listLiteral, childSize, REAL(), pool_));
+          listElement, childSize, REAL(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kI64:
       return makeArrayVector(constructFlatVector<TypeKind::BIGINT>(
-          listLiteral, childSize, BIGINT(), pool_));
+          listElement, childSize, BIGINT(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kFp64:
       return makeArrayVector(constructFlatVector<TypeKind::DOUBLE>(
-          listLiteral, childSize, DOUBLE(), pool_));
+          listElement, childSize, DOUBLE(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kString:
     case ::substrait::Expression_Literal::LiteralTypeCase::kVarChar:
       return makeArrayVector(constructFlatVector<TypeKind::VARCHAR>(
-          listLiteral, childSize, VARCHAR(), pool_));
+          listElement, childSize, VARCHAR(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kNull: {
       auto veloxType = substraitParser_.parseType(listLiteral.null());
       auto kind = veloxType->kind();
       return makeArrayVector(VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
-          constructFlatVector, kind, listLiteral, childSize, veloxType, pool_));
+          constructFlatVector, kind, listElement, childSize, veloxType, pool_));
     }
     case ::substrait::Expression_Literal::LiteralTypeCase::kDate:
       return makeArrayVector(constructFlatVector<TypeKind::INTEGER>(
-          listLiteral, childSize, DATE(), pool_));
+          listElement, childSize, DATE(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kTimestamp:
       return makeArrayVector(constructFlatVector<TypeKind::TIMESTAMP>(
-          listLiteral, childSize, TIMESTAMP(), pool_));
+          listElement, childSize, TIMESTAMP(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kIntervalDayToSecond:
       return makeArrayVector(constructFlatVector<TypeKind::BIGINT>(
-          listLiteral, childSize, INTERVAL_DAY_TIME(), pool_));
+          listElement, childSize, INTERVAL_DAY_TIME(), pool_));
     case ::substrait::Expression_Literal::LiteralTypeCase::kList: {
       VectorPtr elements;
       for (auto it : listLiteral.list().values()) {
@@ -320,6 +326,52 @@ ArrayVectorPtr SubstraitVeloxExprConverter::literalsToArrayVector(
   }
 }
 
+VectorPtr SubstraitVeloxExprConverter::literalsToFlatVector(
+    const google::protobuf::RepeatedPtrField<::substrait::Expression::Literal>&
+        literals,
+    int32_t offset,
+    vector_size_t size,
+    const TypePtr& type) {
+  VELOX_CHECK_LE(offset + size, literals.size());
+  auto literalAt = [&](vector_size_t index) -> const auto& {
+    return literals.Get(offset + index);
+  };
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      constructFlatVector, type->kind(), literalAt, size, type, pool_);
+}
+
+core::TypedExprPtr SubstraitVeloxExprConverter::toVeloxExpr(
+    const ::substrait::Expression::SingularOrList& singularOrList,
+    const RowTypePtr& inputType) {
+  auto value = toVeloxExpr(singularOrList.value(), inputType);
+  const auto& options = singularOrList.options();
+  for (const auto& option : options) {
+    VELOX_USER_CHECK(
+        option.has_literal(),
+        "IN list options must be literals, got '{}'",
+        option.rex_type_case());
+  }
+  // Build the IN list in one pass over the options. Going through a
+  // ConstantTypedExpr with a variant per option dominates plan conversion
+  // time for lists with thousands of values.
+  auto optionAt = [&](vector_size_t index) -> const auto& {
+    return options.Get(index).literal();
+  };
+  auto elements = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      constructFlatVector,
+      value->type()->kind(),
+      optionAt,
+      options.size(),
+      value->type(),
+      pool_);
+  auto inList = std::make_shared<core::ConstantTypedExpr>(
+      BaseVector::wrapInConstant(1, 0, makeArrayVector(elements)));
+  return std::make_shared<const core::CallTypedExpr>(
+      BOOLEAN(),
+      std::vector<core::TypedExprPtr>{std::move(value), std::move(inList)},
+      "in");
+}
+
 core::TypedExprPtr SubstraitVeloxExprConverter::toVeloxExpr(
     const ::substrait::Expression::Cast& castExpr,
     const RowTypePtr& inputType) {
@@ -348,6 +400,8 @@ core::TypedExprPtr SubstraitVeloxExprConverter::toVeloxExpr(
       return toVeloxExpr(substraitExpr.cast(), inputType);
     case ::substrait::Expression::RexTypeCase::kIfThen:
       return toVeloxExpr(substraitExpr.if_then(), inputType);
+    case ::substrait::Expression::RexTypeCase::kSingularOrList:
+      return toVeloxExpr(substraitExpr.singular_or_list(), inputType);
     default:
       VELOX_NYI(
           "Substrait conversion not supported for Expression '{}'", typeCase);
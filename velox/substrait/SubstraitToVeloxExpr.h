@@ -64,6 +64,22 @@ class SubstraitVeloxExprConverter {
       const ::substrait::Expression::IfThen& substraitIfThen,
       const RowTypePtr& inputType);
 
+  /// Convert Substrait SingularOrList with literal options into a Velox IN
+  /// predicate.
+  core::TypedExprPtr toVeloxExpr(
+      const ::substrait::Expression::SingularOrList& singularOrList,
+      const RowTypePtr& inputType);
+
+  /// Convert 'size' literals of 'literals' starting at 'offset' into a
+  /// FlatVector of scalar 'type'. The values are written straight into the
+  /// vector, without going through variants.
+  VectorPtr literalsToFlatVector(
+      const google::protobuf::RepeatedPtrField<
+          ::substrait::Expression::Literal>& literals,
+      int32_t offset,
+      vector_size_t size,
+      const TypePtr& type);
+
  private:
   /// Convert list literal to ArrayVector.
   ArrayVectorPtr literalsToArrayVector(
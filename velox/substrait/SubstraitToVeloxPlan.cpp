@@ -16,7 +16,6 @@
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
 #include "velox/substrait/TypeUtils.h"
-#include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::substrait {
@@ -457,7 +456,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::ReadRel& readRel,
     const RowTypePtr& type) {
-  ::substrait::ReadRel_VirtualTable readVirtualTable = readRel.virtual_table();
+  const auto& readVirtualTable = readRel.virtual_table();
   int64_t numVectors = readVirtualTable.values_size();
   int64_t numColumns = type->size();
   int64_t valueFieldNums =
@@ -475,36 +474,19 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   for (int64_t index = 0; index < numVectors; ++index) {
     std::vector<VectorPtr> children;
-    ::substrait::Expression_Literal_Struct rowValue =
-        readRel.virtual_table().values(index);
+    const auto& rowValue = readVirtualTable.values(index);
     auto fieldSize = rowValue.fields_size();
     VELOX_CHECK_EQ(fieldSize, batchSize * numColumns);
 
     for (int64_t col = 0; col < numColumns; ++col) {
       const TypePtr& outputChildType = type->childAt(col);
-      std::vector<variant> batchChild;
-      batchChild.reserve(batchSize);
-      for (int64_t batchId = 0; batchId < batchSize; batchId++) {
-        // each value in the batch
-        auto fieldIdx = col * batchSize + batchId;
-        ::substrait::Expression_Literal field = rowValue.fields(fieldIdx);
-
-        auto expr = exprConverter_->toVeloxExpr(field);
-        if (auto constantExpr =
-                std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
-                    expr)) {
-          if (!constantExpr->hasValueVector()) {
-            batchChild.emplace_back(constantExpr->value());
-          } else {
-            VELOX_UNSUPPORTED(
-                "Values node with complex type values is not supported yet");
-          }
-        } else {
-          VELOX_FAIL("Expected constant expression");
-        }
+      if (!outputChildType->isPrimitiveType()) {
+        VELOX_UNSUPPORTED(
+            "Values node with complex type values is not supported yet");
       }
-      children.emplace_back(
-          setVectorFromVariants(outputChildType, batchChild, pool_));
+      // The values of a column are contiguous in the row struct.
+      children.emplace_back(exprConverter_->literalsToFlatVector(
+          rowValue.fields(), col * batchSize, batchSize, outputChildType));
     }
 
     vectors.emplace_back(
@@ -584,6 +566,82 @@ std::string SubstraitVeloxPlanConverter::nextPlanNodeId() {
   return id;
 }
 
+namespace {
+// Builds the IN filter of 'singularOrList' on a column of 'type' directly
+// from the option literals. Null options never match and are skipped.
+std::unique_ptr<common::Filter> makeInFilter(
+    const ::substrait::Expression::SingularOrList& singularOrList,
+    const TypePtr& type) {
+  using LiteralTypeCase = ::substrait::Expression_Literal::LiteralTypeCase;
+  const auto& options = singularOrList.options();
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT: {
+      std::vector<int64_t> values;
+      values.reserve(options.size());
+      for (const auto& option : options) {
+        VELOX_CHECK(option.has_literal(), "IN list options must be literals");
+        const auto& literal = option.literal();
+        switch (literal.literal_type_case()) {
+          case LiteralTypeCase::kI8:
+            values.push_back(literal.i8());
+            break;
+          case LiteralTypeCase::kI16:
+            values.push_back(literal.i16());
+            break;
+          case LiteralTypeCase::kI32:
+            values.push_back(literal.i32());
+            break;
+          case LiteralTypeCase::kI64:
+            values.push_back(literal.i64());
+            break;
+          case LiteralTypeCase::kDate:
+            values.push_back(literal.date());
+            break;
+          case LiteralTypeCase::kNull:
+            break;
+          default:
+            VELOX_NYI(
+                "IN list filter not supported for literal type case '{}'",
+                literal.literal_type_case());
+        }
+      }
+      return common::createBigintValues(values, false);
+    }
+    case TypeKind::VARCHAR: {
+      std::vector<std::string> values;
+      values.reserve(options.size());
+      for (const auto& option : options) {
+        VELOX_CHECK(option.has_literal(), "IN list options must be literals");
+        const auto& literal = option.literal();
+        switch (literal.literal_type_case()) {
+          case LiteralTypeCase::kString:
+            values.push_back(literal.string());
+            break;
+          case LiteralTypeCase::kVarChar:
+            values.push_back(literal.var_char().value());
+            break;
+          case LiteralTypeCase::kNull:
+            break;
+          default:
+            VELOX_NYI(
+                "IN list filter not supported for literal type case '{}'",
+                literal.literal_type_case());
+        }
+      }
+      if (values.empty()) {
+        return std::make_unique<common::AlwaysFalse>();
+      }
+      return std::make_unique<common::BytesValues>(values, false);
+    }
+    default:
+      VELOX_NYI("IN list filter not supported for type '{}'", type->toString());
+  }
+}
+} // namespace
+
 // This class contains the needed infos for Filter Pushdown.
 // TODO: Support different types here.
 class FilterInfo {
@@ -646,7 +704,8 @@ connector::hive::SubfieldFilters SubstraitVeloxPlanConverter::toVeloxFilter(
   }
 
   std::vector<::substrait::Expression_ScalarFunction> scalarFunctions;
-  flattenConditions(substraitFilter, scalarFunctions);
+  std::vector<::substrait::Expression_SingularOrList> singularOrLists;
+  flattenConditions(substraitFilter, scalarFunctions, singularOrLists);
   // Construct the FilterInfo for the related column.
   for (const auto& scalarFunction : scalarFunctions) {
     auto filterNameSpec = substraitParser_->findFunctionSpec(
@@ -726,12 +785,29 @@ connector::hive::SubfieldFilters SubstraitVeloxPlanConverter::toVeloxFilter(
               nullAllowed);
     }
   }
+
+  // Construct the IN filters.
+  for (const auto& singularOrList : singularOrLists) {
+    const auto& value = singularOrList.value();
+    VELOX_CHECK(
+        value.has_selection(), "IN list filters must apply to a column");
+    const auto colIdx = substraitParser_->parseReferenceSegment(
+        value.selection().direct_reference());
+    common::Subfield subfield(inputNameList[colIdx]);
+    VELOX_CHECK_EQ(
+        filters.count(subfield),
+        0,
+        "Range and IN list filters on the same column are not supported");
+    filters[std::move(subfield)] =
+        makeInFilter(singularOrList, inputTypeList[colIdx]);
+  }
   return filters;
 }
 
 void SubstraitVeloxPlanConverter::flattenConditions(
     const ::substrait::Expression& substraitFilter,
-    std::vector<::substrait::Expression_ScalarFunction>& scalarFunctions) {
+    std::vector<::substrait::Expression_ScalarFunction>& scalarFunctions,
+    std::vector<::substrait::Expression_SingularOrList>& singularOrLists) {
   auto typeCase = substraitFilter.rex_type_case();
   switch (typeCase) {
     case ::substrait::Expression::RexTypeCase::kScalarFunction: {
@@ -741,13 +817,17 @@ void SubstraitVeloxPlanConverter::flattenConditions(
       // TODO: Only and relation is supported here.
       if (getNameBeforeDelimiter(filterNameSpec, ":") == "and") {
         for (const auto& sCondition : sFunc.arguments()) {
-          flattenConditions(sCondition.value(), scalarFunctions);
+          flattenConditions(
+              sCondition.value(), scalarFunctions, singularOrLists);
         }
       } else {
         scalarFunctions.emplace_back(sFunc);
       }
       break;
     }
+    case ::substrait::Expression::RexTypeCase::kSingularOrList:
+      singularOrLists.emplace_back(substraitFilter.singular_or_list());
+      break;
     default:
       VELOX_NYI("GetFlatConditions not supported for type '{}'", typeCase);
   }
@@ -133,10 +133,12 @@ class SubstraitVeloxPlanConverter {
   /// Multiple conditions are connected to a binary tree structure with
   /// the relation key words, including AND, OR, and etc. Currently, only
   /// AND is supported. This function is used to extract all the Substrait
-  /// conditions in the binary tree structure into a vector.
+  /// conditions in the binary tree structure into a vector. IN lists go to
+  /// 'singularOrLists'.
   void flattenConditions(
       const ::substrait::Expression& substraitFilter,
-      std::vector<::substrait::Expression_ScalarFunction>& scalarFunctions);
+      std::vector<::substrait::Expression_ScalarFunction>& scalarFunctions,
+      std::vector<::substrait::Expression_SingularOrList>& singularOrLists);
 
   /// The Substrait parser used to convert Substrait representations into
   /// recognizable representations.
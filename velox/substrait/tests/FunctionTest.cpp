@@ -210,6 +210,65 @@ TEST_F(FunctionTest, setVectorFromVariants) {
   ASSERT_EQ(30, resultVec->asFlatVector<int32_t>()->valueAt(1));
 }
 
+TEST_F(FunctionTest, literalsToFlatVector) {
+  SubstraitVeloxExprConverter exprConverter(pool_.get(), {});
+  ::substrait::Expression::Literal::Struct row;
+  for (auto i = 0; i < 10; ++i) {
+    row.add_fields()->set_i32(i);
+  }
+  row.add_fields()->mutable_null();
+  row.add_fields()->set_string("asdf");
+
+  auto resultVec =
+      exprConverter.literalsToFlatVector(row.fields(), 2, 5, INTEGER());
+  ASSERT_EQ(5, resultVec->size());
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_EQ(i + 2, resultVec->asFlatVector<int32_t>()->valueAt(i));
+  }
+
+  resultVec =
+      exprConverter.literalsToFlatVector(row.fields(), 10, 2, VARCHAR());
+  ASSERT_TRUE(resultVec->isNullAt(0));
+  ASSERT_EQ("asdf", resultVec->asFlatVector<StringView>()->valueAt(1).str());
+
+  VELOX_ASSERT_THROW(
+      exprConverter.literalsToFlatVector(row.fields(), 10, 3, VARCHAR()),
+      "(13 vs. 12)");
+}
+
+TEST_F(FunctionTest, singularOrList) {
+  SubstraitVeloxExprConverter exprConverter(pool_.get(), {});
+  constexpr int32_t kNumOptions = 10'000;
+  ::substrait::Expression::SingularOrList inList;
+  inList.mutable_value()
+      ->mutable_selection()
+      ->mutable_direct_reference()
+      ->mutable_struct_field()
+      ->set_field(1);
+  for (auto i = 0; i < kNumOptions; ++i) {
+    inList.add_options()->mutable_literal()->set_i64(i * 3);
+  }
+
+  auto expr = exprConverter.toVeloxExpr(
+      inList, ROW({"c0", "c1"}, {VARCHAR(), BIGINT()}));
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  ASSERT_NE(call, nullptr);
+  ASSERT_EQ(call->name(), "in");
+  ASSERT_EQ(*call->type(), *BOOLEAN());
+  ASSERT_EQ(call->inputs().size(), 2);
+  auto options = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+      call->inputs()[1]);
+  ASSERT_NE(options, nullptr);
+  ASSERT_TRUE(options->hasValueVector());
+  ASSERT_EQ(*options->type(), *ARRAY(BIGINT()));
+  auto* array = options->valueVector()->wrappedVector()->as<ArrayVector>();
+  auto* elements = array->elements()->asFlatVector<int64_t>();
+  ASSERT_EQ(elements->size(), kNumOptions);
+  for (auto i = 0; i < kNumOptions; ++i) {
+    ASSERT_EQ(elements->valueAt(i), i * 3);
+  }
+}
+
 TEST_F(FunctionTest, getFunctionType) {
   std::vector<std::string> types =
       SubstraitParser::getSubFunctionTypes("sum:opt_i32");
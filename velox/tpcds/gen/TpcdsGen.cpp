@@ -0,0 +1,665 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include <cmath>
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::tpcds {
+
+namespace {
+
+// d_date_sk of 1900-01-02, the first row of date_dim, and its d_date in days
+// since the epoch.
+constexpr int64_t kFirstDateSk = 2'415'022;
+constexpr int32_t kFirstDate = -25'566;
+
+// The range of ss_sold_date_sk, 1998-01-02 to 2003-01-02.
+constexpr int64_t kFirstSaleDateSk = 2'450'816;
+constexpr int64_t kLastSaleDateSk = 2'452'642;
+
+// Number of store_sales rows per ticket.
+constexpr int64_t kTicketSize = 12;
+
+// One in this many tickets has a null date, store or demographics key.
+constexpr int64_t kNullKeyFrequency = 50;
+
+const std::vector<std::string> kDayNames = {
+    "Sunday",
+    "Monday",
+    "Tuesday",
+    "Wednesday",
+    "Thursday",
+    "Friday",
+    "Saturday"};
+
+const std::vector<std::string> kCategories = {
+    "Books",
+    "Children",
+    "Electronics",
+    "Home",
+    "Jewelry",
+    "Men",
+    "Music",
+    "Shoes",
+    "Sports",
+    "Women"};
+
+const std::vector<std::string> kClasses = {
+    "accessories",
+    "athletic",
+    "baseball",
+    "classical",
+    "computers",
+    "country",
+    "dresses",
+    "fiction",
+    "history",
+    "infants",
+    "mystery",
+    "pants",
+    "pop",
+    "rock",
+    "shirts",
+    "swimwear"};
+
+const std::vector<std::string> kSyllables = {
+    "ought",
+    "able",
+    "pri",
+    "ese",
+    "anti",
+    "cally",
+    "ation",
+    "eing",
+    "bar",
+    "n st"};
+
+const std::vector<std::string> kBrandPrefixes = {
+    "amalg",
+    "edu pack",
+    "export",
+    "import",
+    "brand",
+    "corp",
+    "maxi",
+    "scholar",
+    "univ",
+    "namelessmaxi"};
+
+const std::vector<std::string> kBrandSuffixes = {
+    "amalg", "exporti", "importo", "corp", "brand", "maxi", "scholar", "univ"};
+
+const std::vector<std::string> kWords = {
+    "able", "actual", "broad", "central", "common", "direct", "early", "easy",
+    "final", "free", "general", "great", "human", "large", "local", "major",
+    "modern", "new", "old", "open", "other", "public", "real", "simple",
+    "small", "social", "special", "young"};
+
+// Mostly TN, as in the spec at small scale factors.
+const std::vector<std::string> kStates = {
+    "TN", "TN", "TN", "TN", "TN", "TN", "AL", "GA", "SD", "OH", "MI", "TX"};
+
+const std::vector<std::string> kGenders = {"M", "F"};
+
+const std::vector<std::string> kMaritalStatuses = {"M", "S", "D", "W", "U"};
+
+const std::vector<std::string> kEducationStatuses = {
+    "Primary",
+    "Secondary",
+    "College",
+    "2 yr Degree",
+    "4 yr Degree",
+    "Advanced Degree",
+    "Unknown"};
+
+const std::vector<std::string> kCreditRatings = {
+    "Good", "High Risk", "Low Risk", "Unknown"};
+
+// Returns a pseudo random number that depends only on its arguments. Each
+// column of a table is an independent sequence, so that a row can be
+// generated without generating the rows before it.
+uint64_t random(Table table, int32_t column, uint64_t row) {
+  uint64_t x = (row + 1) * 0x9e3779b97f4a7c15ULL ^
+      (static_cast<uint64_t>(table) << 56) ^
+      (static_cast<uint64_t>(column) << 48);
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Returns a number in [min, max] that depends only on 'table', 'column' and
+// 'row'.
+int64_t uniform(
+    Table table,
+    int32_t column,
+    uint64_t row,
+    int64_t min,
+    int64_t max) {
+  return min + random(table, column, row) % (max - min + 1);
+}
+
+double round2(double value) {
+  return std::round(value * 100) / 100;
+}
+
+// Returns the 16 character business key of surrogate key 'key', like
+// "BAAAAAAAAAAAAAAA" for 1.
+std::string businessKey(uint64_t key) {
+  std::string result(16, 'A');
+  for (size_t i = 0; i < result.size() && key; ++i) {
+    result[i] = 'A' + (key & 15);
+    key >>= 4;
+  }
+  return result;
+}
+
+// Converts days since the epoch to year, month and day of the proleptic
+// Gregorian calendar.
+void civilFromDays(int64_t days, int32_t& year, int32_t& month, int32_t& day) {
+  days += 719'468;
+  const int64_t era = (days >= 0 ? days : days - 146'096) / 146'097;
+  const int64_t dayOfEra = days - era * 146'097;
+  const int64_t yearOfEra = (dayOfEra - dayOfEra / 1'460 +
+                             dayOfEra / 36'524 - dayOfEra / 146'096) /
+      365;
+  const int64_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+  month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+  year = yearOfEra + era * 400 + (month <= 2);
+}
+
+size_t getVectorSize(size_t rowCount, size_t maxRows, size_t offset) {
+  if (offset >= rowCount) {
+    return 0;
+  }
+  return std::min(rowCount - offset, maxRows);
+}
+
+std::vector<VectorPtr> allocateVectors(
+    const RowTypePtr& type,
+    size_t vectorSize,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> vectors;
+  vectors.reserve(type->size());
+
+  for (const auto& childType : type->children()) {
+    vectors.emplace_back(BaseVector::create(childType, vectorSize, pool));
+  }
+  return vectors;
+}
+
+} // namespace
+
+std::string_view toTableName(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return "date_dim";
+    case Table::TBL_ITEM:
+      return "item";
+    case Table::TBL_STORE:
+      return "store";
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return "customer_demographics";
+    case Table::TBL_STORE_SALES:
+      return "store_sales";
+  }
+  return ""; // make gcc happy.
+}
+
+Table fromTableName(std::string_view tableName) {
+  static std::unordered_map<std::string_view, Table> map{
+      {"date_dim", Table::TBL_DATE_DIM},
+      {"item", Table::TBL_ITEM},
+      {"store", Table::TBL_STORE},
+      {"customer_demographics", Table::TBL_CUSTOMER_DEMOGRAPHICS},
+      {"store_sales", Table::TBL_STORE_SALES},
+  };
+
+  auto it = map.find(tableName);
+  if (it != map.end()) {
+    return it->second;
+  }
+  throw std::invalid_argument(
+      fmt::format("Invalid TPC-DS table name: '{}'", tableName));
+}
+
+size_t getRowCount(Table table, double scaleFactor) {
+  VELOX_CHECK_GE(scaleFactor, 0, "Tpcds scale factor must be non-negative");
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return 73'049;
+    case Table::TBL_ITEM:
+      return std::ceil(18'000 * std::sqrt(scaleFactor));
+    case Table::TBL_STORE:
+      return std::ceil(12 * std::sqrt(scaleFactor));
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return std::ceil(1'920'800 * std::min(scaleFactor, 1.0));
+    case Table::TBL_STORE_SALES:
+      return 2'880'404 * scaleFactor;
+  }
+  return 0; // make gcc happy.
+}
+
+RowTypePtr getTableSchema(Table table) {
+  switch (table) {
+    case Table::TBL_DATE_DIM: {
+      static RowTypePtr type = ROW(
+          {
+              "d_date_sk",
+              "d_date",
+              "d_year",
+              "d_moy",
+              "d_dom",
+              "d_qoy",
+              "d_day_name",
+          },
+          {
+              BIGINT(),
+              DATE(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              INTEGER(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_ITEM: {
+      static RowTypePtr type = ROW(
+          {
+              "i_item_sk",
+              "i_item_id",
+              "i_item_desc",
+              "i_current_price",
+              "i_brand_id",
+              "i_brand",
+              "i_class_id",
+              "i_class",
+              "i_category_id",
+              "i_category",
+              "i_manufact_id",
+              "i_manager_id",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              DOUBLE(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE: {
+      static RowTypePtr type = ROW(
+          {
+              "s_store_sk",
+              "s_store_id",
+              "s_store_name",
+              "s_state",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+          });
+      return type;
+    }
+
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS: {
+      static RowTypePtr type = ROW(
+          {
+              "cd_demo_sk",
+              "cd_gender",
+              "cd_marital_status",
+              "cd_education_status",
+              "cd_purchase_estimate",
+              "cd_credit_rating",
+              "cd_dep_count",
+          },
+          {
+              BIGINT(),
+              VARCHAR(),
+              VARCHAR(),
+              VARCHAR(),
+              INTEGER(),
+              VARCHAR(),
+              INTEGER(),
+          });
+      return type;
+    }
+
+    case Table::TBL_STORE_SALES: {
+      static RowTypePtr type = ROW(
+          {
+              "ss_sold_date_sk",
+              "ss_item_sk",
+              "ss_cdemo_sk",
+              "ss_store_sk",
+              "ss_ticket_number",
+              "ss_quantity",
+              "ss_wholesale_cost",
+              "ss_list_price",
+              "ss_sales_price",
+              "ss_coupon_amt",
+              "ss_ext_sales_price",
+              "ss_net_profit",
+          },
+          {
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              BIGINT(),
+              INTEGER(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+              DOUBLE(),
+          });
+      return type;
+    }
+  }
+  return nullptr; // make gcc happy.
+}
+
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName) {
+  return getTableSchema(table)->findChild(columnName);
+}
+
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  switch (table) {
+    case Table::TBL_DATE_DIM:
+      return genTpcdsDateDim(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_ITEM:
+      return genTpcdsItem(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_STORE:
+      return genTpcdsStore(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_CUSTOMER_DEMOGRAPHICS:
+      return genTpcdsCustomerDemographics(pool, maxRows, offset, scaleFactor);
+    case Table::TBL_STORE_SALES:
+      return genTpcdsStoreSales(pool, maxRows, offset, scaleFactor);
+  }
+  return nullptr;
+}
+
+RowVectorPtr genTpcdsDateDim(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  auto rowType = getTableSchema(Table::TBL_DATE_DIM);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_DATE_DIM, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  auto dateSkVector = children[0]->asFlatVector<int64_t>();
+  auto dateVector = children[1]->asFlatVector<int32_t>();
+  auto yearVector = children[2]->asFlatVector<int32_t>();
+  auto monthVector = children[3]->asFlatVector<int32_t>();
+  auto dayVector = children[4]->asFlatVector<int32_t>();
+  auto quarterVector = children[5]->asFlatVector<int32_t>();
+  auto dayNameVector = children[6]->asFlatVector<StringView>();
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const int64_t row = offset + i;
+    const int32_t date = kFirstDate + row;
+    int32_t year;
+    int32_t month;
+    int32_t day;
+    civilFromDays(date, year, month, day);
+
+    dateSkVector->set(i, kFirstDateSk + row);
+    dateVector->set(i, date);
+    yearVector->set(i, year);
+    monthVector->set(i, month);
+    dayVector->set(i, day);
+    quarterVector->set(i, (month - 1) / 3 + 1);
+    // 1970-01-01 is a Thursday.
+    dayNameVector->set(i, StringView(kDayNames[((date % 7) + 11) % 7]));
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+RowVectorPtr genTpcdsItem(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  constexpr auto kTable = Table::TBL_ITEM;
+  auto rowType = getTableSchema(kTable);
+  size_t vectorSize =
+      getVectorSize(getRowCount(kTable, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  auto itemSkVector = children[0]->asFlatVector<int64_t>();
+  auto itemIdVector = children[1]->asFlatVector<StringView>();
+  auto descVector = children[2]->asFlatVector<StringView>();
+  auto priceVector = children[3]->asFlatVector<double>();
+  auto brandIdVector = children[4]->asFlatVector<int32_t>();
+  auto brandVector = children[5]->asFlatVector<StringView>();
+  auto classIdVector = children[6]->asFlatVector<int32_t>();
+  auto classVector = children[7]->asFlatVector<StringView>();
+  auto categoryIdVector = children[8]->asFlatVector<int32_t>();
+  auto categoryVector = children[9]->asFlatVector<StringView>();
+  auto manufactIdVector = children[10]->asFlatVector<int32_t>();
+  auto managerIdVector = children[11]->asFlatVector<int32_t>();
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = offset + i;
+    const int32_t categoryId = uniform(kTable, 9, row, 1, kCategories.size());
+    const int32_t classId = uniform(kTable, 7, row, 1, kClasses.size());
+    const int32_t brandNumber = uniform(kTable, 5, row, 1, 10);
+    std::string desc;
+    for (auto word = 0; word < 3; ++word) {
+      desc += word ? " " : "";
+      desc += kWords[uniform(kTable, 2, row * 3 + word, 0, kWords.size() - 1)];
+    }
+    const auto brand = fmt::format(
+        "{}{} #{}",
+        kBrandPrefixes[categoryId - 1],
+        kBrandSuffixes[classId % kBrandSuffixes.size()],
+        brandNumber);
+
+    itemSkVector->set(i, row + 1);
+    itemIdVector->set(i, StringView(businessKey(row + 1)));
+    descVector->set(i, StringView(desc));
+    priceVector->set(i, uniform(kTable, 3, row, 9, 9'999) / 100.0);
+    brandIdVector->set(
+        i, categoryId * 1'000'000 + classId * 1'000 + brandNumber);
+    brandVector->set(i, StringView(brand));
+    classIdVector->set(i, classId);
+    classVector->set(i, StringView(kClasses[classId - 1]));
+    categoryIdVector->set(i, categoryId);
+    categoryVector->set(i, StringView(kCategories[categoryId - 1]));
+    manufactIdVector->set(i, uniform(kTable, 10, row, 1, 1'000));
+    managerIdVector->set(i, uniform(kTable, 11, row, 1, 100));
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+RowVectorPtr genTpcdsStore(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  constexpr auto kTable = Table::TBL_STORE;
+  auto rowType = getTableSchema(kTable);
+  size_t vectorSize =
+      getVectorSize(getRowCount(kTable, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  auto storeSkVector = children[0]->asFlatVector<int64_t>();
+  auto storeIdVector = children[1]->asFlatVector<StringView>();
+  auto nameVector = children[2]->asFlatVector<StringView>();
+  auto stateVector = children[3]->asFlatVector<StringView>();
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = offset + i;
+    storeSkVector->set(i, row + 1);
+    storeIdVector->set(i, StringView(businessKey(row + 1)));
+    nameVector->set(i, StringView(kSyllables[row % kSyllables.size()]));
+    stateVector->set(
+        i, StringView(kStates[uniform(kTable, 3, row, 0, kStates.size() - 1)]));
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+RowVectorPtr genTpcdsCustomerDemographics(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  auto rowType = getTableSchema(Table::TBL_CUSTOMER_DEMOGRAPHICS);
+  size_t vectorSize = getVectorSize(
+      getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor),
+      maxRows,
+      offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  auto demoSkVector = children[0]->asFlatVector<int64_t>();
+  auto genderVector = children[1]->asFlatVector<StringView>();
+  auto maritalVector = children[2]->asFlatVector<StringView>();
+  auto educationVector = children[3]->asFlatVector<StringView>();
+  auto estimateVector = children[4]->asFlatVector<int32_t>();
+  auto creditVector = children[5]->asFlatVector<StringView>();
+  auto depCountVector = children[6]->asFlatVector<int32_t>();
+
+  // The rows enumerate the cross product of the attributes, the first
+  // attribute varying fastest.
+  for (size_t i = 0; i < vectorSize; ++i) {
+    uint64_t row = offset + i;
+    demoSkVector->set(i, row + 1);
+    genderVector->set(i, StringView(kGenders[row % kGenders.size()]));
+    row /= kGenders.size();
+    maritalVector->set(
+        i, StringView(kMaritalStatuses[row % kMaritalStatuses.size()]));
+    row /= kMaritalStatuses.size();
+    educationVector->set(
+        i, StringView(kEducationStatuses[row % kEducationStatuses.size()]));
+    row /= kEducationStatuses.size();
+    estimateVector->set(i, 500 * (row % 20 + 1));
+    row /= 20;
+    creditVector->set(
+        i, StringView(kCreditRatings[row % kCreditRatings.size()]));
+    row /= kCreditRatings.size();
+    depCountVector->set(i, row % 7);
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+RowVectorPtr genTpcdsStoreSales(
+    memory::MemoryPool* pool,
+    size_t maxRows,
+    size_t offset,
+    double scaleFactor) {
+  constexpr auto kTable = Table::TBL_STORE_SALES;
+  auto rowType = getTableSchema(kTable);
+  size_t vectorSize =
+      getVectorSize(getRowCount(kTable, scaleFactor), maxRows, offset);
+  auto children = allocateVectors(rowType, vectorSize, pool);
+
+  const int64_t numItems = getRowCount(Table::TBL_ITEM, scaleFactor);
+  const int64_t numStores = getRowCount(Table::TBL_STORE, scaleFactor);
+  const int64_t numDemographics =
+      getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, scaleFactor);
+
+  auto dateSkVector = children[0]->asFlatVector<int64_t>();
+  auto itemSkVector = children[1]->asFlatVector<int64_t>();
+  auto demoSkVector = children[2]->asFlatVector<int64_t>();
+  auto storeSkVector = children[3]->asFlatVector<int64_t>();
+  auto ticketVector = children[4]->asFlatVector<int64_t>();
+  auto quantityVector = children[5]->asFlatVector<int32_t>();
+  auto wholesaleVector = children[6]->asFlatVector<double>();
+  auto listPriceVector = children[7]->asFlatVector<double>();
+  auto salesPriceVector = children[8]->asFlatVector<double>();
+  auto couponVector = children[9]->asFlatVector<double>();
+  auto extSalesPriceVector = children[10]->asFlatVector<double>();
+  auto netProfitVector = children[11]->asFlatVector<double>();
+
+  // Sets 'vector[i]' to a key in [min, max] that is the same for all rows of
+  // 'ticket', or to null.
+  auto setTicketKey = [&](FlatVector<int64_t>* vector,
+                          int32_t column,
+                          size_t i,
+                          uint64_t ticket,
+                          int64_t min,
+                          int64_t max) {
+    if (random(kTable, column + 100, ticket) % kNullKeyFrequency == 0) {
+      vector->setNull(i, true);
+    } else {
+      vector->set(i, uniform(kTable, column, ticket, min, max));
+    }
+  };
+
+  for (size_t i = 0; i < vectorSize; ++i) {
+    const uint64_t row = offset + i;
+    const uint64_t ticket = row / kTicketSize;
+    setTicketKey(dateSkVector, 0, i, ticket, kFirstSaleDateSk, kLastSaleDateSk);
+    itemSkVector->set(i, uniform(kTable, 1, row, 1, numItems));
+    setTicketKey(demoSkVector, 2, i, ticket, 1, numDemographics);
+    setTicketKey(storeSkVector, 3, i, ticket, 1, numStores);
+    ticketVector->set(i, ticket + 1);
+
+    const int32_t quantity = uniform(kTable, 5, row, 1, 100);
+    const double wholesale = uniform(kTable, 6, row, 100, 10'000) / 100.0;
+    const double listPrice =
+        round2(wholesale * (1 + uniform(kTable, 7, row, 0, 100) / 100.0));
+    const double salesPrice =
+        round2(listPrice * (1 - uniform(kTable, 8, row, 0, 100) / 100.0));
+    const double extSalesPrice = round2(salesPrice * quantity);
+    // A coupon is applied to one in five rows.
+    const double coupon = uniform(kTable, 9, row, 0, 4) == 0
+        ? round2(extSalesPrice * uniform(kTable, 19, row, 0, 100) / 100.0)
+        : 0;
+
+    quantityVector->set(i, quantity);
+    wholesaleVector->set(i, wholesale);
+    listPriceVector->set(i, listPrice);
+    salesPriceVector->set(i, salesPrice);
+    couponVector->set(i, coupon);
+    extSalesPriceVector->set(i, extSalesPrice);
+    netProfitVector->set(
+        i, round2(extSalesPrice - coupon - wholesale * quantity));
+  }
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), vectorSize, std::move(children));
+}
+
+} // namespace facebook::velox::tpcds
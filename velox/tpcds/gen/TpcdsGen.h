@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/memory/Memory.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::tpcds {
+
+/// This file generates a subset of the TPC-DS tables encoded using Velox
+/// Vectors. The API follows velox/tpch/gen/TpchGen.h: the input is the table,
+/// the scale factor, the maximum batch size and the offset, and any range of
+/// rows can be generated independently of the others, so that clients can
+/// generate a table in parallel.
+///
+/// The data is not produced by the TPC-DS dsdgen tool. Each value is a
+/// deterministic function of the table, the column and the row number, with
+/// value ranges, key relationships and null fractions that follow the TPC-DS
+/// spec closely enough for the store sales queries to be selective in the
+/// same way. Query results are therefore not comparable with the answer sets
+/// published by the TPC.
+///
+/// Monetary columns are DOUBLE and key columns are BIGINT, as in TpchGen.
+
+enum class Table : uint8_t {
+  TBL_DATE_DIM,
+  TBL_ITEM,
+  TBL_STORE,
+  TBL_CUSTOMER_DEMOGRAPHICS,
+  TBL_STORE_SALES,
+};
+
+static constexpr auto tables = {
+    tpcds::Table::TBL_DATE_DIM,
+    tpcds::Table::TBL_ITEM,
+    tpcds::Table::TBL_STORE,
+    tpcds::Table::TBL_CUSTOMER_DEMOGRAPHICS,
+    tpcds::Table::TBL_STORE_SALES};
+
+/// Returns table name as a string.
+std::string_view toTableName(Table table);
+
+/// Returns the table enum value given a table name.
+Table fromTableName(std::string_view tableName);
+
+/// Returns the row count for a particular TPC-DS table given a scale factor.
+/// date_dim has a fixed size and customer_demographics is the full cross
+/// product of its attributes from scale factor 1 on. store_sales grows
+/// linearly with the scale factor and item and store with its square root,
+/// which approximates the sizes in the spec at:
+///
+///  https://www.tpc.org/tpcds/
+size_t getRowCount(Table table, double scaleFactor);
+
+/// Returns the schema (RowType) for a particular TPC-DS table.
+RowTypePtr getTableSchema(Table table);
+
+/// Returns the type of a particular table:column pair. Throws if `columnName`
+/// does not exist in `table`.
+TypePtr resolveTpcdsColumn(Table table, const std::string& columnName);
+
+/// Returns a row vector containing at most `maxRows` rows of `table`,
+/// starting at `offset`, and given the scale factor. Calls one of the
+/// functions below.
+RowVectorPtr genTpcdsData(
+    Table table,
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the "date_dim"
+/// table, starting at `offset`. There is one row per day from 1900-01-02 on.
+/// The row vector returned has the following schema:
+///
+///  d_date_sk: BIGINT
+///  d_date: DATE
+///  d_year: INTEGER
+///  d_moy: INTEGER
+///  d_dom: INTEGER
+///  d_qoy: INTEGER
+///  d_day_name: VARCHAR
+///
+RowVectorPtr genTpcdsDateDim(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the "item"
+/// table, starting at `offset`, and given the scale factor. The row vector
+/// returned has the following schema:
+///
+///  i_item_sk: BIGINT
+///  i_item_id: VARCHAR
+///  i_item_desc: VARCHAR
+///  i_current_price: DOUBLE
+///  i_brand_id: INTEGER
+///  i_brand: VARCHAR
+///  i_class_id: INTEGER
+///  i_class: VARCHAR
+///  i_category_id: INTEGER
+///  i_category: VARCHAR
+///  i_manufact_id: INTEGER
+///  i_manager_id: INTEGER
+///
+RowVectorPtr genTpcdsItem(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the "store"
+/// table, starting at `offset`, and given the scale factor. The row vector
+/// returned has the following schema:
+///
+///  s_store_sk: BIGINT
+///  s_store_id: VARCHAR
+///  s_store_name: VARCHAR
+///  s_state: VARCHAR
+///
+RowVectorPtr genTpcdsStore(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the
+/// "customer_demographics" table, starting at `offset`, and given the scale
+/// factor. The row vector returned has the following schema:
+///
+///  cd_demo_sk: BIGINT
+///  cd_gender: VARCHAR
+///  cd_marital_status: VARCHAR
+///  cd_education_status: VARCHAR
+///  cd_purchase_estimate: INTEGER
+///  cd_credit_rating: VARCHAR
+///  cd_dep_count: INTEGER
+///
+RowVectorPtr genTpcdsCustomerDemographics(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+/// Returns a row vector containing at most `maxRows` rows of the
+/// "store_sales" table, starting at `offset`, and given the scale factor.
+/// Consecutive rows form tickets that share the date, store and customer
+/// demographics. About 2% of the tickets have a null in each of these keys.
+/// The row vector returned has the following schema:
+///
+///  ss_sold_date_sk: BIGINT
+///  ss_item_sk: BIGINT
+///  ss_cdemo_sk: BIGINT
+///  ss_store_sk: BIGINT
+///  ss_ticket_number: BIGINT
+///  ss_quantity: INTEGER
+///  ss_wholesale_cost: DOUBLE
+///  ss_list_price: DOUBLE
+///  ss_sales_price: DOUBLE
+///  ss_coupon_amt: DOUBLE
+///  ss_ext_sales_price: DOUBLE
+///  ss_net_profit: DOUBLE
+///
+RowVectorPtr genTpcdsStoreSales(
+    memory::MemoryPool* pool,
+    size_t maxRows = 10000,
+    size_t offset = 0,
+    double scaleFactor = 1);
+
+} // namespace facebook::velox::tpcds
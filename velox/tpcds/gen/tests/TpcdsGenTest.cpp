@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "velox/tpcds/gen/TpcdsGen.h"
+#include "velox/vector/FlatVector.h"
+
+namespace {
+
+using namespace facebook::velox;
+using namespace facebook::velox::tpcds;
+
+class TpcdsGenTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    pool_ = memory::memoryManager()->addLeafPool("TpcdsGenTest");
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+TEST_F(TpcdsGenTest, rowCount) {
+  EXPECT_EQ(73'049, getRowCount(Table::TBL_DATE_DIM, 0.01));
+  EXPECT_EQ(18'000, getRowCount(Table::TBL_ITEM, 1));
+  EXPECT_EQ(12, getRowCount(Table::TBL_STORE, 1));
+  EXPECT_EQ(1'920'800, getRowCount(Table::TBL_CUSTOMER_DEMOGRAPHICS, 10));
+  EXPECT_EQ(2'880'404, getRowCount(Table::TBL_STORE_SALES, 1));
+  EXPECT_EQ(28'804, getRowCount(Table::TBL_STORE_SALES, 0.01));
+
+  for (auto table : tables) {
+    EXPECT_EQ(table, fromTableName(toTableName(table)));
+  }
+  EXPECT_THROW(fromTableName("web_sales"), std::invalid_argument);
+}
+
+TEST_F(TpcdsGenTest, dateDim) {
+  auto rowVector = genTpcdsDateDim(pool_.get(), 10, 0);
+  ASSERT_EQ(10, rowVector->size());
+  EXPECT_EQ(
+      "{2415022, 1900-01-02, 1900, 1, 2, 1, Tuesday}", rowVector->toString(0));
+
+  // The surrogate key of 2000-01-01.
+  constexpr int64_t kDateSk = 2'451'545;
+  rowVector = genTpcdsDateDim(pool_.get(), 1, kDateSk - 2'415'022);
+  EXPECT_EQ(
+      "{2451545, 2000-01-01, 2000, 1, 1, 1, Saturday}",
+      rowVector->toString(0));
+
+  rowVector = genTpcdsDateDim(pool_.get(), 1, 73'048);
+  EXPECT_EQ(
+      "{2488070, 2100-01-01, 2100, 1, 1, 1, Friday}", rowVector->toString(0));
+  EXPECT_EQ(0, genTpcdsDateDim(pool_.get(), 1, 73'049)->size());
+}
+
+// Generating a table in several batches gives the same rows as generating it
+// at once.
+TEST_F(TpcdsGenTest, offsets) {
+  constexpr double kScaleFactor = 0.01;
+  for (auto table : tables) {
+    auto numRows = std::min<size_t>(getRowCount(table, kScaleFactor), 10'000);
+    auto all = genTpcdsData(table, pool_.get(), numRows, 0, kScaleFactor);
+    ASSERT_EQ(numRows, all->size());
+    for (size_t offset = 0; offset < numRows; offset += 1'234) {
+      auto batch =
+          genTpcdsData(table, pool_.get(), 1'234, offset, kScaleFactor);
+      for (auto i = 0; i < batch->size(); ++i) {
+        ASSERT_TRUE(batch->equalValueAt(all.get(), i, offset + i))
+            << toTableName(table) << " row " << offset + i;
+      }
+    }
+  }
+}
+
+TEST_F(TpcdsGenTest, storeSalesKeys) {
+  constexpr double kScaleFactor = 0.01;
+  auto numRows = getRowCount(Table::TBL_STORE_SALES, kScaleFactor);
+  auto rowVector = genTpcdsStoreSales(pool_.get(), numRows, 0, kScaleFactor);
+  auto dateSk = rowVector->childAt(0)->asFlatVector<int64_t>();
+  auto itemSk = rowVector->childAt(1)->asFlatVector<int64_t>();
+  auto storeSk = rowVector->childAt(3)->asFlatVector<int64_t>();
+  auto ticket = rowVector->childAt(4)->asFlatVector<int64_t>();
+
+  const int64_t numItems = getRowCount(Table::TBL_ITEM, kScaleFactor);
+  const int64_t numStores = getRowCount(Table::TBL_STORE, kScaleFactor);
+  int32_t numNullDates = 0;
+  for (auto i = 0; i < rowVector->size(); ++i) {
+    EXPECT_GE(itemSk->valueAt(i), 1);
+    EXPECT_LE(itemSk->valueAt(i), numItems);
+    if (!storeSk->isNullAt(i)) {
+      EXPECT_GE(storeSk->valueAt(i), 1);
+      EXPECT_LE(storeSk->valueAt(i), numStores);
+    }
+    numNullDates += dateSk->isNullAt(i);
+    // The rows of a ticket share the sale date.
+    if (i > 0 && ticket->valueAt(i) == ticket->valueAt(i - 1)) {
+      EXPECT_TRUE(dateSk->equalValueAt(dateSk, i, i - 1));
+    }
+  }
+  EXPECT_LT(0, numNullDates);
+  EXPECT_GT(rowVector->size() / 10, numNullDates);
+}
+
+} // namespace
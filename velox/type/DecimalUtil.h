@@ -110,6 +110,27 @@ class DecimalUtil {
       const int64_t* scales,
       int32_t numValues,
       int32_t targetScale) {
+    // Writers usually store all values at the scale of the column, so that no
+    // value needs adjusting. Checks this first with a loop that the compiler
+    // can vectorize if there are no nulls.
+    bool allAtTargetScale = true;
+    if (nullsPtr) {
+      allAtTargetScale =
+          bits::testSetBits(nullsPtr, 0, numValues, [&](int32_t i) {
+            return scales[i] == targetScale;
+          });
+    } else {
+      for (int32_t i = 0; i < numValues; i++) {
+        allAtTargetScale &= scales[i] == targetScale;
+      }
+    }
+    if (allAtTargetScale) {
+      if (decimals != values) {
+        std::copy(values, values + numValues, decimals);
+      }
+      return;
+    }
+
     for (int32_t i = 0; i < numValues; i++) {
       if (!nullsPtr || !bits::isBitNull(nullsPtr, i)) {
         int32_t currentScale = scales[i];
@@ -351,6 +372,24 @@ class DecimalUtil {
     return overflow;
   }
 
+  /// Returns the sum of the 'size' short decimal 'values'. The values are
+  /// summed as their signed upper and unsigned lower 32 bits in two 64-bit
+  /// accumulators. These cannot overflow for fewer than 2^31 values, so that
+  /// the loop vectorizes without per value overflow checks and only the total
+  /// is computed in 128 bits.
+  inline static int128_t sumShortDecimals(
+      const int64_t* values,
+      int32_t size) {
+    int64_t upper = 0;
+    uint64_t lower = 0;
+    for (int32_t i = 0; i < size; ++i) {
+      upper += values[i] >> 32;
+      lower += static_cast<uint32_t>(values[i]);
+    }
+    return static_cast<int128_t>(upper) * (static_cast<int128_t>(1) << 32) +
+        lower;
+  }
+
   /// Corrects the sum result calculated using addWithOverflow. Since the sum
   /// calculated by addWithOverflow only retains the lower 127 bits,
   /// it may miss one calculation of +(1 << 127) or -(1 << 127).
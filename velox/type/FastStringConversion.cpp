@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/type/FastStringConversion.h"
+
+#include "velox/type/TimestampConversion.h"
+
+namespace facebook::velox::util {
+
+namespace {
+
+constexpr int kMaxExactDigits = 15;
+
+constexpr double kPowersOf10[kMaxExactDigits + 1] = {
+    1e0,
+    1e1,
+    1e2,
+    1e3,
+    1e4,
+    1e5,
+    1e6,
+    1e7,
+    1e8,
+    1e9,
+    1e10,
+    1e11,
+    1e12,
+    1e13,
+    1e14,
+    1e15};
+
+// Returns the value of the 2 ASCII digits at 'data' or -1 if they are not
+// digits.
+inline int32_t parseTwoDigits(const char* data) {
+  const uint8_t high = static_cast<uint8_t>(data[0] - '0');
+  const uint8_t low = static_cast<uint8_t>(data[1] - '0');
+  if (high > 9 || low > 9) {
+    return -1;
+  }
+  return high * 10 + low;
+}
+
+} // namespace
+
+bool tryParseDouble(const char* data, size_t size, double& result) {
+  bool negative = false;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    ++data;
+    --size;
+  }
+  if (size == 0 || size > kMaxExactDigits + 1) {
+    return false;
+  }
+  const char* dot = static_cast<const char*>(std::memchr(data, '.', size));
+  const size_t integerSize = dot ? dot - data : size;
+  const size_t fractionSize = dot ? size - integerSize - 1 : 0;
+  if (integerSize == 0 || (dot && fractionSize == 0) ||
+      integerSize + fractionSize > kMaxExactDigits) {
+    return false;
+  }
+  uint64_t integer;
+  if (!detail::parseDigits(data, integerSize, integer)) {
+    return false;
+  }
+  uint64_t fraction = 0;
+  if (fractionSize > 0 &&
+      !detail::parseDigits(dot + 1, fractionSize, fraction)) {
+    return false;
+  }
+  // At most 15 digits, so the mantissa is below 2^53 and exact.
+  const uint64_t mantissa =
+      integer * static_cast<uint64_t>(kPowersOf10[fractionSize]) + fraction;
+  const double value =
+      static_cast<double>(mantissa) / kPowersOf10[fractionSize];
+  result = negative ? -value : value;
+  return true;
+}
+
+bool tryParseDate(const char* data, size_t size, int32_t& result) {
+  if (size != 10 || data[4] != '-' || data[7] != '-') {
+    return false;
+  }
+  const int32_t century = parseTwoDigits(data);
+  const int32_t yearOfCentury = parseTwoDigits(data + 2);
+  const int32_t month = parseTwoDigits(data + 5);
+  const int32_t day = parseTwoDigits(data + 8);
+  if (century < 0 || yearOfCentury < 0 || month < 0 || day < 0) {
+    return false;
+  }
+  const int32_t year = century * 100 + yearOfCentury;
+  // Checked upfront to not build the error status of an invalid date.
+  if (!isValidDate(year, month, day)) {
+    return false;
+  }
+  int64_t daysSinceEpoch;
+  if (!daysSinceEpochFromDate(year, month, day, daysSinceEpoch).ok()) {
+    return false;
+  }
+  result = static_cast<int32_t>(daysSinceEpoch);
+  return true;
+}
+
+} // namespace facebook::velox::util
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace facebook::velox::util {
+
+/// Exception and allocation free parsers for the most common shapes of
+/// numbers and dates in strings. Each parser accepts a strict subset of the
+/// inputs accepted by the corresponding cast and returns false for anything
+/// else, e.g. white space, exponents, overflow or an invalid date, in which
+/// case the caller falls back to the general conversion. For the inputs they
+/// accept, the result is the same as that of the general conversion.
+
+namespace detail {
+
+/// Returns true if all 8 bytes of 'chunk' are ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  constexpr uint64_t kHighNibbles = 0xF0F0F0F0F0F0F0F0ULL;
+  constexpr uint64_t kZeros = 0x3030303030303030ULL;
+  constexpr uint64_t kSixes = 0x0606060606060606ULL;
+  // Each byte must be in [0x30, 0x3F] and stay below 0x40 after adding 6.
+  return (chunk & kHighNibbles) == kZeros &&
+      ((chunk + kSixes) & kHighNibbles) == kZeros;
+}
+
+/// Returns the value of the 8 ASCII digits in 'chunk', loaded in little endian
+/// order, i.e. the first digit is in the lowest byte.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FFULL;
+  constexpr uint64_t kMul1 = 100 + (1'000'000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10'000ULL << 32);
+  chunk -= 0x3030303030303030ULL;
+  // Pairs of digits, then groups of 4, then all 8.
+  chunk = (chunk * 10) + (chunk >> 8);
+  return static_cast<uint32_t>(
+      (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32);
+}
+
+/// Parses a run of at most 19 ASCII digits from 'data' into 'value'. Returns
+/// false if any byte is not a digit.
+inline bool parseDigits(const char* data, size_t size, uint64_t& value) {
+  value = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + i, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = static_cast<uint8_t>(data[i] - '0');
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  return true;
+}
+
+} // namespace detail
+
+/// Parses [+-]?[0-9]+ into a signed integer of type T. Returns false for
+/// other inputs, more than 19 digits and values out of the range of T.
+template <typename T>
+bool tryParseInteger(const char* data, size_t size, T& result) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  bool negative = false;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    ++data;
+    --size;
+  }
+  // 19 digits fit in a uint64_t.
+  if (size == 0 || size > 19) {
+    return false;
+  }
+  uint64_t value;
+  if (!detail::parseDigits(data, size, value)) {
+    return false;
+  }
+  const uint64_t limit =
+      static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative;
+  if (value > limit) {
+    return false;
+  }
+  result = negative ? static_cast<T>(static_cast<int64_t>(0 - value))
+                    : static_cast<T>(value);
+  return true;
+}
+
+/// Parses [+-]?[0-9]+(\.[0-9]+)? with at most 15 digits in total into a
+/// double. Such a value and the power of 10 to divide it by are exact doubles,
+/// so that the division is correctly rounded and matches the result of a
+/// full string to double conversion.
+bool tryParseDouble(const char* data, size_t size, double& result);
+
+/// Parses YYYY-MM-DD into days since epoch. Returns false for other inputs
+/// and invalid dates.
+bool tryParseDate(const char* data, size_t size, int32_t& result);
+
+} // namespace facebook::velox::util
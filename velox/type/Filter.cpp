@@ -20,6 +20,9 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +97,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +137,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +198,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -435,6 +445,45 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
   return true;
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = folly::hexlify(bits);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  std::string bits;
+  VELOX_CHECK(folly::unhexlify(obj["bloomFilter"].asString(), bits));
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloom->min_ || max_ != otherBloom->max_) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloom->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloom->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase("NegatedBigintValuesUsingHashTable");
   obj["nonNegated"] = nonNegated_->serialize();
@@ -807,6 +856,47 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+xsimd::batch_bool<int64_t> BigintValuesUsingBloomFilter::testValues(
+    xsimd::batch<int64_t> x) const {
+  auto outOfRange = (x < xsimd::broadcast<int64_t>(min_)) |
+      (x > xsimd::broadcast<int64_t>(max_));
+  if (simd::toBitMask(outOfRange) == simd::allSetBitMask<int64_t>()) {
+    return xsimd::batch_bool<int64_t>(false);
+  }
+  return genericTestValues(
+      x, [this](int64_t value) { return testInt64(value); });
+}
+
+xsimd::batch_bool<int32_t> BigintValuesUsingBloomFilter::testValues(
+    xsimd::batch<int32_t> x) const {
+  // Values of 'x' are within int32_t but min_ and max_ may not be.
+  auto min = std::max<int64_t>(min_, std::numeric_limits<int32_t>::min());
+  auto max = std::min<int64_t>(max_, std::numeric_limits<int32_t>::max());
+  auto outOfRange = (x < xsimd::broadcast<int32_t>(min)) |
+      (x > xsimd::broadcast<int32_t>(max));
+  if (min > max ||
+      simd::toBitMask(outOfRange) == simd::allSetBitMask<int32_t>()) {
+    return xsimd::batch_bool<int32_t>(false);
+  }
+  return genericTestValues(
+      x, [this](int32_t value) { return testInt64(value); });
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return !(min > max_ || max < min_);
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -877,8 +967,13 @@ xsimd::batch_bool<int64_t> BigintValuesUsingHashTable::testValues(
   if (simd::toBitMask(outOfRange) == simd::allSetBitMask<int64_t>()) {
     return xsimd::batch_bool<int64_t>(false);
   }
-  if (containsEmptyMarker_) {
-    return Filter::testValues(x);
+  if (values_.size() <= kMaxDirectCompareValues) {
+    // A few compares against broadcast values are cheaper than a gather.
+    auto result = xsimd::batch_bool<int64_t>(false);
+    for (auto value : values_) {
+      result = result | (x == xsimd::broadcast<int64_t>(value));
+    }
+    return result;
   }
   auto allEmpty = xsimd::broadcast<int64_t>(kEmptyMarker);
   // Temporarily casted to unsigned to suppress overflow error.
@@ -887,15 +982,18 @@ xsimd::batch_bool<int64_t> BigintValuesUsingHashTable::testValues(
   auto data =
       simd::maskGather(allEmpty, ~outOfRange, hashTable_.data(), indices);
   // The lanes with kEmptyMarker missed, the lanes matching x hit and the other
-  // lanes must check next positions.
-
-  auto result = x == data;
-  auto resultBits = simd::toBitMask(result);
-  auto missed = simd::toBitMask(data == allEmpty);
-  static_assert(decltype(result)::size <= 16);
+  // lanes must check next positions. Lanes where x is kEmptyMarker are not in
+  // the hash table and are resolved from 'containsEmptyMarker_'.
+  auto emptyMarkerBits = simd::toBitMask(x == allEmpty);
+  auto resultBits = simd::toBitMask(x == data) & ~emptyMarkerBits;
+  auto missed = simd::toBitMask(data == allEmpty) | emptyMarkerBits;
+  if (containsEmptyMarker_) {
+    resultBits |= emptyMarkerBits;
+  }
+  static_assert(xsimd::batch<int64_t>::size <= 16);
   uint16_t unresolved = simd::allSetBitMask<int64_t>() ^ (resultBits | missed);
   if (!unresolved) {
-    return result;
+    return simd::fromBitMask<int64_t>(resultBits);
   }
   constexpr int kAlign = xsimd::default_arch::alignment();
   constexpr int kArraySize = xsimd::batch<int64_t>::size;
@@ -941,6 +1039,31 @@ xsimd::batch_bool<int32_t> BigintValuesUsingHashTable::testValues(
       first | (second << xsimd::batch<int64_t>::size));
 }
 
+xsimd::batch_bool<int16_t> BigintValuesUsingHashTable::testValues(
+    xsimd::batch<int16_t> x) const {
+  // Widens the lanes to 64 bits and probes them one 64 bit batch at a time.
+  // There is no fromBitMask() for 16 bit lanes, so the result is loaded from
+  // an array of lane masks.
+  constexpr int kAlign = xsimd::default_arch::alignment();
+  constexpr int kSize = xsimd::batch<int16_t>::size;
+  constexpr int kWideSize = xsimd::batch<int64_t>::size;
+  alignas(kAlign) int16_t lanes[kSize];
+  alignas(kAlign) int64_t wideLanes[kSize];
+  x.store_aligned(lanes);
+  for (auto i = 0; i < kSize; ++i) {
+    wideLanes[i] = lanes[i];
+  }
+  uint32_t resultBits = 0;
+  for (auto i = 0; i < kSize; i += kWideSize) {
+    resultBits |=
+        simd::toBitMask(testValues(xsimd::load_aligned(wideLanes + i))) << i;
+  }
+  for (auto i = 0; i < kSize; ++i) {
+    lanes[i] = (resultBits >> i) & 1 ? -1 : 0;
+  }
+  return xsimd::load_aligned(lanes) != xsimd::broadcast<int16_t>(0);
+}
+
 bool BigintValuesUsingHashTable::testInt64Range(
     int64_t min,
     int64_t max,
@@ -1470,7 +1593,74 @@ bool MultiRange::testFloat(float value) const {
   return false;
 }
 
+namespace {
+// Returns the first 8 bytes of 'value' as a big endian integer, padded with
+// zeros if shorter.
+uint64_t bytesPrefix(const char* value, int32_t length) {
+  uint64_t prefix = 0;
+  if (length > 0) {
+    memcpy(&prefix, value, std::min<int32_t>(length, sizeof(prefix)));
+  }
+  return folly::Endian::big(prefix);
+}
+
+// Returns true if 'left' ends before 'right' begins. Both must be bounded on
+// the ends being compared.
+bool endsBefore(const BytesRange& left, const BytesRange& right) {
+  if (left.isUpperUnbounded() || right.isLowerUnbounded()) {
+    return false;
+  }
+  const int compare = left.upper().compare(right.lower());
+  return compare < 0 ||
+      (compare == 0 && (left.upperExclusive() || right.lowerExclusive()));
+}
+} // namespace
+
+void MultiRange::initBytesRanges() {
+  std::vector<const BytesRange*> ranges;
+  ranges.reserve(filters_.size());
+  for (const auto& filter : filters_) {
+    if (filter->kind() != FilterKind::kBytesRange) {
+      return;
+    }
+    ranges.push_back(static_cast<const BytesRange*>(filter.get()));
+  }
+  std::sort(ranges.begin(), ranges.end(), [](auto* left, auto* right) {
+    if (left->isLowerUnbounded() || right->isLowerUnbounded()) {
+      return left->isLowerUnbounded() && !right->isLowerUnbounded();
+    }
+    return left->lower() < right->lower();
+  });
+  for (auto i = 1; i < ranges.size(); ++i) {
+    if (!endsBefore(*ranges[i - 1], *ranges[i])) {
+      return;
+    }
+  }
+  lowerPrefixes_.reserve(ranges.size());
+  for (auto* range : ranges) {
+    lowerPrefixes_.push_back(
+        range->isLowerUnbounded()
+            ? 0
+            : bytesPrefix(range->lower().data(), range->lower().size()));
+  }
+  bytesRanges_ = std::move(ranges);
+}
+
 bool MultiRange::testBytes(const char* value, int32_t length) const {
+  if (!bytesRanges_.empty()) {
+    // Finds the last range whose lower bound is not above 'value'. The
+    // ranges do not overlap, so this is the only one 'value' may be in.
+    const auto prefix = bytesPrefix(value, length);
+    int32_t index = std::upper_bound(
+                        lowerPrefixes_.begin(), lowerPrefixes_.end(), prefix) -
+        lowerPrefixes_.begin() - 1;
+    while (index >= 0 && lowerPrefixes_[index] == prefix &&
+           !bytesRanges_[index]->isLowerUnbounded() &&
+           std::string_view(value, length) < bytesRanges_[index]->lower()) {
+      --index;
+    }
+    return index >= 0 && bytesRanges_[index]->testBytes(value, length);
+  }
   for (const auto& filter : filters_) {
     if (filter->testBytes(value, length)) {
       return true;
@@ -1840,6 +2030,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -1914,6 +2105,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2049,6 +2241,14 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return createBigintValues(valuesToKeep, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloom =
+          static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kNegatedBigintValuesUsingBitmask:
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2142,6 +2342,14 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return createBigintValues(valuesToKeep, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloom =
+          static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kNegatedBigintValuesUsingBitmask:
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2167,6 +2375,55 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask:
+      return other->mergeWith(this);
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // Only one Bloom filter is kept. The range is still exact.
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto min = std::max(min_, otherBloom->min_);
+      auto max = std::min(max_, otherBloom->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintMultiRange: {
+      // The conjunction cannot be expressed by one filter. Keep the exact
+      // filter and drop the Bloom filter.
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      return other->clone(bothNullAllowed);
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2187,7 +2444,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
-    case FilterKind::kBigintMultiRange: {
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2227,7 +2485,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
-    case FilterKind::kBigintMultiRange: {
+    case FilterKind::kBigintMultiRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
@@ -2267,7 +2526,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
-    case FilterKind::kBigintValuesUsingHashTable: {
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
       return other->mergeWith(this);
     }
     case FilterKind::kBigintMultiRange: {
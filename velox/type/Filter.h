@@ -16,6 +16,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 #include <sstream>
@@ -24,7 +25,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +59,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -944,9 +948,7 @@ class BigintValuesUsingHashTable final : public Filter {
   bool testInt64(int64_t value) const final;
   xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
   xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
-  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
-    return Filter::testValues(x);
-  }
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t>) const final;
   bool testInt64Range(int64_t min, int64_t max, bool hashNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -984,6 +986,9 @@ class BigintValuesUsingHashTable final : public Filter {
   static constexpr int64_t kEmptyMarker = 0xdeadbeefbadefeedL;
   // from Murmur hash
   static constexpr uint64_t M = 0xc6a4a7935bd1e995L;
+  // Up to this many values, testValues() compares a batch against each value
+  // instead of gathering from the hash table.
+  static constexpr int32_t kMaxDirectCompareValues = 8;
 
   const int64_t min_;
   const int64_t max_;
@@ -1090,6 +1095,101 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types backed by a Bloom filter. Used for
+/// dynamic filters on join keys when the build side has too many distinct
+/// values for an exact IN-list. All values inserted into the Bloom filter
+/// pass. Other values in [min, max] pass with the false positive rate of the
+/// Bloom filter, so this filter may only be used where the consumer re-checks
+/// the values, e.g. the probe side of a hash join.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum inserted value.
+  /// @param max Maximum inserted value.
+  /// @param bloomFilter Bloom filter with hash(value) of each value inserted.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(min),
+        max_(max),
+        bloomFilter_(std::move(bloomFilter)) {
+    VELOX_CHECK_LE(min_, max_);
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+  }
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash to insert into the Bloom filter for 'value'.
+  static uint64_t hash(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hash(value));
+  }
+
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return Filter::testValues(x);
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  /// Merging with an IN-list is exact. Merging with a range narrows
+  /// [min, max]. Other integral filters replace 'this', which only drops
+  /// pruning since 'this' is a superset filter to begin with.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  // Shared between clones of the filter, e.g. one per split.
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1867,6 +1967,12 @@ class BytesValues final : public Filter {
     for (const auto& value : values) {
       lengths_.insert(value.size());
       values_.insert(value);
+      if (value.size() < kMaxShortLength) {
+        shortLengths_ |= 1UL << value.size();
+      }
+      if (!value.empty()) {
+        bits::setBit(firstBytes_.data(), static_cast<uint8_t>(value[0]));
+      }
     }
 
     lower_ = *std::min_element(values_.begin(), values_.end());
@@ -1878,7 +1984,9 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        shortLengths_(other.shortLengths_),
+        firstBytes_(other.firstBytes_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1894,12 +2002,22 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
+    if (static_cast<uint32_t>(length) < kMaxShortLength) {
+      return shortLengths_ & (1UL << length);
+    }
     return lengths_.contains(length);
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    // Screens out most misses on the length and first byte before hashing.
+    if (!testLength(length)) {
+      return false;
+    }
+    if (length > 0 &&
+        !bits::isBitSet(firstBytes_.data(), static_cast<uint8_t>(value[0]))) {
+      return false;
+    }
+    return values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1916,10 +2034,16 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  static constexpr uint32_t kMaxShortLength = 64;
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // Bit i is set if there is a value of length i < kMaxShortLength.
+  uint64_t shortLengths_{0};
+  // Bit i is set if there is a value starting with byte i.
+  std::array<uint64_t, 4> firstBytes_{};
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -2041,7 +2165,9 @@ class MultiRange final : public Filter {
       bool nanAllowed)
       : Filter(true, nullAllowed, FilterKind::kMultiRange),
         filters_(std::move(filters)),
-        nanAllowed_(nanAllowed) {}
+        nanAllowed_(nanAllowed) {
+    initBytesRanges();
+  }
 
   folly::dynamic serialize() const override;
 
@@ -2080,8 +2206,22 @@ class MultiRange final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // If all of 'filters_' are disjoint BytesRanges, fills 'bytesRanges_' and
+  // 'lowerPrefixes_' so that testBytes() can binary search the range a value
+  // may fall in instead of testing every range.
+  void initBytesRanges();
+
   const std::vector<std::unique_ptr<Filter>> filters_;
   const bool nanAllowed_;
+
+  // 'filters_' sorted on lower bound. Empty unless all are BytesRanges that
+  // do not overlap.
+  std::vector<const BytesRange*> bytesRanges_;
+
+  // The first 8 bytes of the lower bound of each of 'bytesRanges_' as a big
+  // endian integer, zero padded. Comparing these orders values the same way
+  // as comparing the strings, except for values with equal prefixes.
+  std::vector<uint64_t> lowerPrefixes_;
 };
 
 // Helper for applying filters to different types
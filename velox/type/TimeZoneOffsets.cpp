@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/type/TimeZoneOffsets.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/external/date/tz.h"
+
+namespace facebook::velox {
+namespace {
+// 1900-01-01 and 2100-01-01 in UTC seconds.
+constexpr int64_t kTableBegin = -2'208'988'800;
+constexpr int64_t kTableEnd = 4'102'444'800;
+} // namespace
+
+// static
+const TimeZoneOffsets& TimeZoneOffsets::get(const date::time_zone& zone) {
+  // Queries mostly use a single session time zone. Remember the last table
+  // used by this thread to skip the lock.
+  thread_local const TimeZoneOffsets* last = nullptr;
+  if (last != nullptr && &last->zone_ == &zone) {
+    return *last;
+  }
+  static folly::Synchronized<folly::F14FastMap<
+      const date::time_zone*,
+      std::unique_ptr<TimeZoneOffsets>>>
+      tables;
+  last = tables.withWLock([&](auto& map) {
+    auto& table = map[&zone];
+    if (table == nullptr) {
+      table.reset(new TimeZoneOffsets(zone));
+    }
+    return table.get();
+  });
+  return *last;
+}
+
+TimeZoneOffsets::TimeZoneOffsets(const date::time_zone& zone) : zone_(zone) {
+  begin_ = kTableBegin;
+  end_ = kTableBegin;
+  while (end_ < kTableEnd) {
+    date::sys_info info;
+    try {
+      info = zone.get_info(date::sys_seconds(std::chrono::seconds(end_)));
+    } catch (const std::invalid_argument&) {
+      // external/date does not extend zones with repetition rules past the
+      // last materialized transition. Leave these times to the slow path so
+      // that they fail the same way.
+      break;
+    }
+    transitions_.push_back(end_);
+    offsets_.push_back(info.offset.count());
+    end_ = std::min<int64_t>(info.end.time_since_epoch().count(), kTableEnd);
+  }
+}
+
+void TimeZoneOffsets::toTimezone(Timestamp& timestamp) const {
+  if (const auto offset = offsetSeconds(timestamp.getSeconds())) {
+    timestamp =
+        Timestamp(timestamp.getSeconds() + *offset, timestamp.getNanos());
+  } else {
+    timestamp.toTimezone(zone_);
+  }
+}
+
+void TimeZoneOffsets::toTimezone(Timestamp* timestamps, int32_t size) const {
+  for (auto i = 0; i < size; ++i) {
+    toTimezone(timestamps[i]);
+  }
+}
+
+} // namespace facebook::velox
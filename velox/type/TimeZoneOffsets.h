@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "velox/type/Timestamp.h"
+
+namespace date {
+class time_zone;
+}
+
+namespace facebook::velox {
+
+/// UTC offsets of a time zone precomputed over [1900, 2100) as a sorted
+/// table of transition times. Converting a UTC timestamp to local time is a
+/// branch-free binary search over the table instead of a walk through the
+/// tz database rules. Timestamps outside of the table fall back to
+/// date::time_zone, which also produces the errors for unsupported ranges.
+class TimeZoneOffsets {
+ public:
+  /// Returns the table for 'zone'. Tables are built on first use and live
+  /// for the lifetime of the process.
+  static const TimeZoneOffsets& get(const date::time_zone& zone);
+
+  /// Returns the offset from UTC in seconds in effect at 'utcSeconds' or
+  /// std::nullopt if 'utcSeconds' is not covered by the table.
+  std::optional<int64_t> offsetSeconds(int64_t utcSeconds) const {
+    if (utcSeconds < begin_ || utcSeconds >= end_) {
+      return std::nullopt;
+    }
+    const int64_t* base = transitions_.data();
+    auto size = transitions_.size();
+    while (size > 1) {
+      const auto half = size / 2;
+      base = base[half] <= utcSeconds ? base + half : base;
+      size -= half;
+    }
+    return offsets_[base - transitions_.data()];
+  }
+
+  /// Converts 'timestamp' from UTC to local time in this time zone. Same
+  /// result as Timestamp::toTimezone(zone).
+  void toTimezone(Timestamp& timestamp) const;
+
+  /// Converts 'size' timestamps in place.
+  void toTimezone(Timestamp* timestamps, int32_t size) const;
+
+  const date::time_zone& zone() const {
+    return zone_;
+  }
+
+ private:
+  explicit TimeZoneOffsets(const date::time_zone& zone);
+
+  const date::time_zone& zone_;
+
+  // Start of each interval of constant offset in UTC seconds, ascending.
+  std::vector<int64_t> transitions_;
+
+  // Offset in seconds for the interval starting at the same position in
+  // 'transitions_'.
+  std::vector<int32_t> offsets_;
+
+  // Range of UTC seconds covered by the table.
+  int64_t begin_{0};
+  int64_t end_{0};
+};
+
+} // namespace facebook::velox
@@ -18,6 +18,7 @@
 #include <chrono>
 #include "velox/common/base/CountBits.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/TimeZoneOffsets.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox {
@@ -119,6 +120,11 @@ Timestamp::toTimePoint(bool allowOverflow) const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone, bool allowOverflow) {
+  if (const auto offset = TimeZoneOffsets::get(zone).offsetSeconds(seconds_)) {
+    seconds_ += *offset;
+    return;
+  }
+
   auto tp = toTimePoint(allowOverflow);
 
   try {
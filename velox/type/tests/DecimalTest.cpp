@@ -272,6 +272,42 @@ TEST(DecimalTest, valueInPrecisionRange) {
       DecimalUtil::kLongDecimalMin - 1, LongDecimalType::kMaxPrecision));
 }
 
+TEST(DecimalTest, fillDecimals) {
+  // All values at the target scale are copied as is. The scale of the null
+  // row does not matter.
+  {
+    const std::vector<int64_t> values = {123, -45, 0, 6789};
+    const std::vector<int64_t> scales = {2, 2, 0, 2};
+    uint64_t nulls = bits::kNotNull64;
+    bits::setNull(&nulls, 2);
+    std::vector<int64_t> decimals(values.size());
+    DecimalUtil::fillDecimals<int64_t>(
+        decimals.data(), &nulls, values.data(), scales.data(), 4, 2);
+    ASSERT_EQ(decimals[0], 123);
+    ASSERT_EQ(decimals[1], -45);
+    ASSERT_EQ(decimals[3], 6789);
+  }
+
+  // Values at other scales are adjusted to the target scale.
+  {
+    std::vector<int64_t> values = {123, -45, 6789, 5};
+    const std::vector<int64_t> scales = {2, 1, 4, 3};
+    DecimalUtil::fillDecimals<int64_t>(
+        values.data(), nullptr, values.data(), scales.data(), 4, 3);
+    ASSERT_EQ(values, std::vector<int64_t>({1230, -4500, 678, 5}));
+  }
+
+  {
+    std::vector<int128_t> values = {1, -2, 300};
+    const std::vector<int64_t> scales = {0, 20, 2};
+    DecimalUtil::fillDecimals<int128_t>(
+        values.data(), nullptr, values.data(), scales.data(), 3, 20);
+    ASSERT_EQ(values[0], DecimalUtil::kPowersOfTen[20]);
+    ASSERT_EQ(values[1], -2);
+    ASSERT_EQ(values[2], 3 * DecimalUtil::kPowersOfTen[20]);
+  }
+}
+
 TEST(DecimalTest, computeAverage) {
   auto validateSameValues = [](int128_t value, int64_t maxCount) {
     SCOPED_TRACE(fmt::format("value={} maxCount={}", value, maxCount));
@@ -342,6 +378,36 @@ TEST(DecimalAggregateTest, adjustSumForOverflow) {
   EXPECT_FALSE(accumulator.adjustedSum().has_value());
 }
 
+TEST(DecimalAggregateTest, sumShortDecimals) {
+  std::vector<int64_t> values = {
+      0,
+      1,
+      -1,
+      DecimalUtil::kShortDecimalMax,
+      DecimalUtil::kShortDecimalMin,
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min(),
+      std::numeric_limits<uint32_t>::max(),
+      -static_cast<int64_t>(std::numeric_limits<uint32_t>::max())};
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(static_cast<int64_t>(
+        (i % 2 ? 1 : -1) * (DecimalUtil::kShortDecimalMax - i * 1'234'567)));
+  }
+  int128_t expected = 0;
+  for (auto i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(expected, DecimalUtil::sumShortDecimals(values.data(), i));
+    expected += values[i];
+  }
+  EXPECT_EQ(
+      expected, DecimalUtil::sumShortDecimals(values.data(), values.size()));
+
+  // Sums of many large values exceed 64 bits.
+  std::vector<int64_t> maxValues(100, DecimalUtil::kShortDecimalMax);
+  EXPECT_EQ(
+      static_cast<int128_t>(DecimalUtil::kShortDecimalMax) * 100,
+      DecimalUtil::sumShortDecimals(maxValues.data(), maxValues.size()));
+}
+
 TEST(DecimalTest, rescaleDouble) {
   assertRescaleDouble(-3333.03, DECIMAL(10, 4), -33'330'300);
   assertRescaleDouble(-3333.03, DECIMAL(20, 1), -33'330);
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/type/FastStringConversion.h"
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace facebook::velox::util {
+namespace {
+
+template <typename T>
+std::optional<T> parseInteger(const std::string& input) {
+  T result;
+  if (tryParseInteger<T>(input.data(), input.size(), result)) {
+    return result;
+  }
+  return std::nullopt;
+}
+
+std::optional<double> parseDouble(const std::string& input) {
+  double result;
+  if (tryParseDouble(input.data(), input.size(), result)) {
+    return result;
+  }
+  return std::nullopt;
+}
+
+std::optional<int32_t> parseDate(const std::string& input) {
+  int32_t result;
+  if (tryParseDate(input.data(), input.size(), result)) {
+    return result;
+  }
+  return std::nullopt;
+}
+
+TEST(FastStringConversionTest, integer) {
+  EXPECT_EQ(parseInteger<int64_t>("0"), 0);
+  EXPECT_EQ(parseInteger<int64_t>("-1"), -1);
+  EXPECT_EQ(parseInteger<int64_t>("+1"), 1);
+  EXPECT_EQ(parseInteger<int64_t>("12345678"), 12345678);
+  EXPECT_EQ(parseInteger<int64_t>("123456789012345"), 123456789012345);
+  EXPECT_EQ(
+      parseInteger<int64_t>("9223372036854775807"),
+      std::numeric_limits<int64_t>::max());
+  EXPECT_EQ(
+      parseInteger<int64_t>("-9223372036854775808"),
+      std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(parseInteger<int32_t>("-2147483648"), -2147483648);
+  EXPECT_EQ(parseInteger<int8_t>("-128"), -128);
+  EXPECT_EQ(parseInteger<int8_t>("127"), 127);
+
+  // Out of range.
+  EXPECT_EQ(parseInteger<int64_t>("9223372036854775808"), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("-9223372036854775809"), std::nullopt);
+  EXPECT_EQ(parseInteger<int32_t>("2147483648"), std::nullopt);
+  EXPECT_EQ(parseInteger<int8_t>("128"), std::nullopt);
+
+  // Left to the general conversion.
+  EXPECT_EQ(parseInteger<int64_t>(""), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("-"), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>(" 1"), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("1 "), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("1.0"), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("1234567a"), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("1234567a9"), std::nullopt);
+  EXPECT_EQ(parseInteger<int64_t>("00000000000000000001"), std::nullopt);
+
+  for (int64_t value = 1; value < std::numeric_limits<int64_t>::max() / 7;
+       value = value * 7 + 3) {
+    EXPECT_EQ(parseInteger<int64_t>(std::to_string(value)), value);
+    EXPECT_EQ(parseInteger<int64_t>(std::to_string(-value)), -value);
+  }
+}
+
+TEST(FastStringConversionTest, floatingPoint) {
+  EXPECT_EQ(parseDouble("0"), 0.0);
+  EXPECT_EQ(parseDouble("1.5"), 1.5);
+  EXPECT_EQ(parseDouble("-0.25"), -0.25);
+  EXPECT_EQ(parseDouble("+3.0"), 3.0);
+  EXPECT_EQ(parseDouble("0.1"), 0.1);
+  EXPECT_EQ(parseDouble("123456789.123456"), 123456789.123456);
+  EXPECT_EQ(parseDouble("0.00000000000001"), 0.00000000000001);
+  EXPECT_TRUE(std::signbit(parseDouble("-0").value()));
+
+  // Left to the general conversion.
+  EXPECT_EQ(parseDouble("1234567890123456"), std::nullopt);
+  EXPECT_EQ(parseDouble("1."), std::nullopt);
+  EXPECT_EQ(parseDouble(".5"), std::nullopt);
+  EXPECT_EQ(parseDouble("1e5"), std::nullopt);
+  EXPECT_EQ(parseDouble("1.2.3"), std::nullopt);
+  EXPECT_EQ(parseDouble(" 1.5"), std::nullopt);
+  EXPECT_EQ(parseDouble("NaN"), std::nullopt);
+
+  for (int64_t mantissa = 1; mantissa < 1'000'000'000'000'000;
+       mantissa = mantissa * 7 + 3) {
+    const auto digits = std::to_string(mantissa);
+    for (size_t i = 1; i < digits.size(); ++i) {
+      const auto input = digits.substr(0, i) + "." + digits.substr(i);
+      EXPECT_EQ(parseDouble(input), std::stod(input)) << input;
+    }
+  }
+}
+
+TEST(FastStringConversionTest, date) {
+  EXPECT_EQ(parseDate("1970-01-01"), 0);
+  EXPECT_EQ(parseDate("1969-12-31"), -1);
+  EXPECT_EQ(parseDate("2024-02-29"), 19782);
+  EXPECT_EQ(parseDate("0001-01-01"), -719162);
+
+  // Left to the general conversion.
+  EXPECT_EQ(parseDate("2023-02-29"), std::nullopt);
+  EXPECT_EQ(parseDate("2024-13-01"), std::nullopt);
+  EXPECT_EQ(parseDate("2024-00-01"), std::nullopt);
+  EXPECT_EQ(parseDate("1970-1-01"), std::nullopt);
+  EXPECT_EQ(parseDate("+1970-01-01"), std::nullopt);
+  EXPECT_EQ(parseDate("1970/01/01"), std::nullopt);
+  EXPECT_EQ(parseDate("1970-01-01 "), std::nullopt);
+}
+
+} // namespace
+} // namespace facebook::velox::util
@@ -31,26 +31,41 @@ using namespace facebook::velox::common;
 std::vector<int64_t> sparseValues;
 std::vector<int64_t> denseValues;
 std::unique_ptr<BigintValuesUsingHashTable> filter;
+std::unique_ptr<BigintValuesUsingHashTable> smallFilter;
+std::vector<std::string> strings;
+std::unique_ptr<BytesValues> bytesFilter;
 
-int32_t run1x64(const std::vector<int64_t>& data) {
+int32_t run1x64(
+    const std::vector<int64_t>& data,
+    const Filter& filter = *::filter) {
   int32_t count = 0;
   for (auto i = 0; i < data.size(); ++i) {
-    count += filter->testInt64(data[i]);
+    count += filter.testInt64(data[i]);
   }
   return count;
 }
 
-int32_t run4x64(const std::vector<int64_t>& data) {
+int32_t run4x64(
+    const std::vector<int64_t>& data,
+    const Filter& filter = *::filter) {
   constexpr int kStep = xsimd::batch<int64_t>::size;
   int32_t count = 0;
   assert(data.size() % kStep == 0);
   for (auto i = 0; i < data.size(); i += kStep) {
-    auto result = filter->testValues(xsimd::load_unaligned(data.data() + i));
+    auto result = filter.testValues(xsimd::load_unaligned(data.data() + i));
     count += __builtin_popcount(simd::toBitMask(result));
   }
   return count;
 }
 
+int32_t runBytes() {
+  int32_t count = 0;
+  for (const auto& string : strings) {
+    count += bytesFilter->testBytes(string.data(), string.size());
+  }
+  return count;
+}
+
 BENCHMARK(scalarDense) {
   folly::doNotOptimizeAway(run1x64(denseValues));
 }
@@ -67,6 +82,18 @@ BENCHMARK_RELATIVE(simdSparse) {
   folly::doNotOptimizeAway(run4x64(sparseValues));
 }
 
+BENCHMARK(scalarSmall) {
+  folly::doNotOptimizeAway(run1x64(denseValues, *smallFilter));
+}
+
+BENCHMARK_RELATIVE(simdSmall) {
+  folly::doNotOptimizeAway(run4x64(denseValues, *smallFilter));
+}
+
+BENCHMARK(bytesValues) {
+  folly::doNotOptimizeAway(runBytes());
+}
+
 int32_t main(int32_t argc, char* argv[]) {
   constexpr int32_t kNumValues = 1000000;
   constexpr int32_t kFilterValues = 1000;
@@ -79,6 +106,20 @@ int32_t main(int32_t argc, char* argv[]) {
   }
   filter = std::make_unique<BigintValuesUsingHashTable>(
       filterValues.front(), filterValues.back(), filterValues, false);
+  filterValues.resize(5);
+  smallFilter = std::make_unique<BigintValuesUsingHashTable>(
+      filterValues.front(), filterValues.back(), filterValues, false);
+
+  // Strings of varying lengths of which about one in 100 passes the filter.
+  std::vector<std::string> bytesFilterValues;
+  for (auto i = 0; i < kFilterValues; ++i) {
+    bytesFilterValues.push_back(fmt::format("value-{}", i * 100));
+  }
+  bytesFilter = std::make_unique<BytesValues>(bytesFilterValues, false);
+  strings.resize(kNumValues);
+  for (auto i = 0; i < kNumValues; ++i) {
+    strings[i] = fmt::format("value-{}", folly::Random::rand32() % 100000);
+  }
   denseValues.resize(kNumValues);
   sparseValues.resize(kNumValues);
   for (auto i = 0; i < kNumValues; ++i) {
@@ -88,6 +129,8 @@ int32_t main(int32_t argc, char* argv[]) {
 
   VELOX_CHECK_EQ(run1x64(denseValues), run4x64(denseValues));
   VELOX_CHECK_EQ(run1x64(sparseValues), run4x64(sparseValues));
+  VELOX_CHECK_EQ(
+      run1x64(denseValues, *smallFilter), run4x64(denseValues, *smallFilter));
   folly::runBenchmarks();
   return 0;
 }
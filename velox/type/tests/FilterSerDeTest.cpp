@@ -106,6 +106,14 @@ TEST_F(FilterSerDeTest, valuesFilters) {
 
       testSerde(HugeintValuesUsingHashTable(
           lowerHugeint, upperHugeint, valuesHugeint, nullAllowed));
+
+      auto bloomFilter = std::make_shared<BloomFilter<>>();
+      bloomFilter->reset(sz);
+      for (auto value : values) {
+        bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+      }
+      testSerde(BigintValuesUsingBloomFilter(
+          lower, upper, std::move(bloomFilter), nullAllowed));
     }
   }
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -384,16 +385,57 @@ TEST(FilterTest, bigintValuesUsingHashTableSimd) {
   applySimdTestToVector(numbers32, *filter, verify);
 
   // Make a filter with sizeMask_'s slot filled and the kPaddingElements'
-  // slots tested
-  // numbers has 4 elements, so the sizeMask_ is 15 (1 << log2(4*5) - 1 = 15)
-  // The 15'th slot is filled by 19 (19 * 0xc6a4a7935bd1e995L & 15L = 15L)
-  // The test value 3 will also be hashed to 15'th slot
-  // (3 * 0xc6a4a7935bd1e995L & 15L = 15L), and 3 is within [min, max]
-  numbers = {0, 1, 19, 10'000};
+  // slots tested. Small filters compare against each value instead of probing
+  // the hash table, so numbers has 9 elements and the sizeMask_ is 31
+  // (1 << log2(9*5) - 1 = 31). The 31'st slot is filled by 35
+  // (35 * 0xc6a4a7935bd1e995L & 31L = 31L). The test value 3 will also be
+  // hashed to 31'st slot (3 * 0xc6a4a7935bd1e995L & 31L = 31L), and 3 is
+  // within [min, max]
+  numbers = {0, 1, 2, 4, 5, 6, 7, 35, 10'000};
   filter = createBigintValues(numbers, false);
   ASSERT_TRUE(dynamic_cast<BigintValuesUsingHashTable*>(filter.get()));
   int64_t values[] = {3, 3, 3, 3};
   checkSimd(filter.get(), values, verify);
+
+  // Small filter.
+  numbers = {0, 1, 19, 10'000};
+  filter = createBigintValues(numbers, false);
+  ASSERT_TRUE(dynamic_cast<BigintValuesUsingHashTable*>(filter.get()));
+  checkSimd(filter.get(), values, verify);
+  applySimdTestToVector(
+      std::vector<int64_t>{0, 1, 19, 10'000, 18, 2, 0, 9'999, 19, 1},
+      *filter,
+      verify);
+
+  // Lanes equal to the empty marker of the hash table.
+  constexpr int64_t kEmptyMarker = 0xdeadbeefbadefeedL;
+  for (auto containsEmptyMarker : {false, true}) {
+    numbers.clear();
+    for (auto i = 0; i < 100; ++i) {
+      numbers.push_back(kEmptyMarker + i * 1209 + 1);
+    }
+    if (containsEmptyMarker) {
+      numbers.push_back(kEmptyMarker);
+    }
+    filter = createBigintValues(numbers, false);
+    ASSERT_TRUE(dynamic_cast<BigintValuesUsingHashTable*>(filter.get()));
+    EXPECT_EQ(filter->testInt64(kEmptyMarker), containsEmptyMarker);
+    int64_t markers[] = {
+        kEmptyMarker, kEmptyMarker + 1, kEmptyMarker, kEmptyMarker + 2};
+    checkSimd(filter.get(), markers, verify);
+    applySimdTestToVector(numbers, *filter, verify);
+  }
+
+  std::vector<int16_t> numbers16;
+  for (auto i = 0; i < 1000; ++i) {
+    numbers16.push_back(i * 7);
+  }
+  filter = std::make_unique<BigintValuesUsingHashTable>(
+      0,
+      numbers16.back(),
+      std::vector<int64_t>(numbers16.begin(), numbers16.end()),
+      false);
+  applySimdTestToVector(numbers16, *filter, verify);
 }
 
 TEST(FilterTest, negatedBigintValuesUsingHashTableSimd) {
@@ -454,6 +496,66 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+std::unique_ptr<BigintValuesUsingBloomFilter> bigintValuesUsingBloomFilter(
+    const std::vector<int64_t>& values,
+    bool nullAllowed = false) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+  }
+  auto [min, max] = std::minmax_element(values.begin(), values.end());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *min, *max, std::move(bloomFilter), nullAllowed);
+}
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i * 1'001);
+  }
+  auto filter = bigintValuesUsingBloomFilter(values);
+  ASSERT_EQ(filter->min(), 0);
+  ASSERT_EQ(filter->max(), 999 * 1'001);
+
+  // No false negatives.
+  for (auto value : values) {
+    EXPECT_TRUE(filter->testInt64(value));
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(999 * 1'001 + 1));
+  EXPECT_FALSE(filter->testInt64(INT64_MAX));
+
+  // Few false positives.
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numPassed += filter->testInt64(i * 1'001 + 500);
+  }
+  EXPECT_LT(numPassed, 100);
+
+  EXPECT_TRUE(filter->testInt64Range(0, 10, false));
+  EXPECT_TRUE(filter->testInt64Range(-10, 10, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -1, false));
+  EXPECT_FALSE(filter->testInt64Range(999 * 1'001 + 1, INT64_MAX, false));
+
+  auto withNull = filter->clone(true);
+  EXPECT_TRUE(withNull->testNull());
+  EXPECT_TRUE(withNull->testInt64(1'001));
+  EXPECT_TRUE(withNull->testInt64Range(-10, -1, true));
+
+  std::vector<int64_t> numbers;
+  for (auto i = 0; i < 1'000; ++i) {
+    numbers.push_back(i % 2 == 0 ? values[i] : i * 1'001 + 7);
+  }
+  auto verify = [&](int64_t x) { return filter->testInt64(x); };
+  applySimdTestToVector(numbers, *filter, verify);
+
+  std::vector<int32_t> numbers32(numbers.begin(), numbers.end());
+  auto verify32 = [&](int32_t x) { return filter->testInt64(x); };
+  applySimdTestToVector(numbers32, *filter, verify32);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -950,6 +1052,35 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesScreening) {
+  std::string longValue(100, 'x');
+  std::vector<std::string> values({"", "a", "bc", longValue});
+  auto filter = in(values);
+  EXPECT_TRUE(filter->testBytes("", 0));
+  EXPECT_TRUE(filter->testBytes("a", 1));
+  EXPECT_TRUE(filter->testBytes("bc", 2));
+  EXPECT_TRUE(filter->testBytes(longValue.data(), longValue.size()));
+
+  // Right length, wrong first byte.
+  EXPECT_FALSE(filter->testBytes("b", 1));
+  EXPECT_FALSE(filter->testBytes("ac", 2));
+  // Right length and first byte.
+  EXPECT_FALSE(filter->testBytes("bd", 2));
+  longValue.back() = 'y';
+  EXPECT_FALSE(filter->testBytes(longValue.data(), longValue.size()));
+  // Lengths at and around the short length bitmask boundary.
+  EXPECT_FALSE(filter->testBytes(longValue.data(), 63));
+  EXPECT_FALSE(filter->testBytes(longValue.data(), 64));
+  EXPECT_FALSE(filter->testLength(3));
+  EXPECT_FALSE(filter->testLength(64));
+  EXPECT_TRUE(filter->testLength(100));
+
+  auto copy = filter->clone(true);
+  EXPECT_TRUE(copy->testBytes("bc", 2));
+  EXPECT_FALSE(copy->testBytes("ac", 2));
+  EXPECT_TRUE(copy->testLength(0));
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1052,6 +1183,41 @@ TEST(FilterTest, multiRange) {
   EXPECT_TRUE(filter->testBytes("abc", 3));
 }
 
+TEST(FilterTest, multiRangeBytesSearch) {
+  // Disjoint ranges with shared 8 byte prefixes, tested by binary search.
+  std::vector<std::unique_ptr<Filter>> ranges;
+  ranges.push_back(lessThan("apple"));
+  ranges.push_back(between("banana", "cherry"));
+  ranges.push_back(betweenExclusive("prefix00a", "prefix00c"));
+  ranges.push_back(between("prefix00c", "prefix00c"));
+  ranges.push_back(between("prefix00x", "prefix01"));
+  ranges.push_back(greaterThan("zebra"));
+  MultiRange filter(std::move(ranges), false, false);
+
+  std::vector<std::string> values = {
+      "",          "a",         "apple",     "apples",    "b",
+      "banana",    "bananas",   "cherry",    "cherry0",   "prefix",
+      "prefix00",  "prefix00a", "prefix00b", "prefix00c", "prefix00d",
+      "prefix00x", "prefix00z", "prefix01",  "prefix010", "zebra",
+      "zebras",    "zz"};
+  for (const auto& value : values) {
+    bool expected = false;
+    for (const auto& range : filter.filters()) {
+      expected |= range->testBytes(value.data(), value.size());
+    }
+    EXPECT_EQ(filter.testBytes(value.data(), value.size()), expected)
+        << value;
+  }
+  EXPECT_TRUE(filter.testBytes("prefix00b", 9));
+  EXPECT_TRUE(filter.testBytes("prefix00c", 9));
+  EXPECT_FALSE(filter.testBytes("prefix00d", 9));
+
+  // Overlapping ranges are tested one by one.
+  auto overlapping = orFilter(between("abc", "def"), between("bcd", "efg"));
+  EXPECT_TRUE(overlapping->testBytes("dog", 3));
+  EXPECT_FALSE(overlapping->testBytes("fig", 3));
+}
+
 TEST(FilterTest, multiRangeWithNaNs) {
   // x <> 1.2 with nanAllowed true
   auto filter =
@@ -1410,6 +1576,71 @@ TEST(FilterTest, mergeWithBigint) {
   }
 }
 
+TEST(FilterTest, mergeWithBigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = -500; i < 500; i += 3) {
+    values.push_back(i);
+  }
+  auto bloom = bigintValuesUsingBloomFilter(values);
+  auto bloomWithNull = bigintValuesUsingBloomFilter(values, true);
+
+  std::vector<std::unique_ptr<Filter>> filters;
+  addUntypedFilters(filters);
+  filters.push_back(between(-7, 13));
+  filters.push_back(between(-7, 13, true));
+  filters.push_back(between(600, 700));
+  filters.push_back(notEqual(123));
+  filters.push_back(notBetween(0, 100, true));
+  filters.push_back(in({1, 2, 3, 67'000'000'000, 134}));
+  filters.push_back(in({-7, -6, -5, -4, -3, -2}, true));
+  filters.push_back(notIn({1, 3, 5, 7, 67'000'000'000, 122}));
+  filters.push_back(bigintValuesUsingBloomFilter({-100, 50, 1'000}));
+
+  // The merged filter must pass all values passed by both filters and, as
+  // Bloom filters are approximate, may only pass extra values that fail the
+  // Bloom filter.
+  auto check = [](Filter* left, Filter* right, Filter* exact) {
+    auto merged = left->mergeWith(right);
+    ASSERT_EQ(merged->testNull(), left->testNull() && right->testNull())
+        << "left: " << left->toString() << ", right: " << right->toString();
+    for (int64_t i = -1'000; i <= 1'000; ++i) {
+      const bool expected = left->testInt64(i) && right->testInt64(i);
+      if (expected) {
+        ASSERT_TRUE(merged->testInt64(i))
+            << "at " << i << ", left: " << left->toString()
+            << ", right: " << right->toString()
+            << ", merged: " << merged->toString();
+      } else if (exact && !exact->testInt64(i)) {
+        ASSERT_FALSE(merged->testInt64(i))
+            << "at " << i << ", left: " << left->toString()
+            << ", right: " << right->toString()
+            << ", merged: " << merged->toString();
+      }
+    }
+  };
+
+  for (auto* bloomFilter : {bloom.get(), bloomWithNull.get()}) {
+    for (const auto& other : filters) {
+      auto* exact =
+          other->kind() == FilterKind::kBigintValuesUsingBloomFilter
+          ? nullptr
+          : other.get();
+      check(bloomFilter, other.get(), exact);
+      check(other.get(), bloomFilter, exact);
+    }
+  }
+
+  // Merging with a range keeps the Bloom filter and narrows the range.
+  auto merged = bloom->mergeWith(between(-7, 13).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  auto* narrowed = static_cast<BigintValuesUsingBloomFilter*>(merged.get());
+  EXPECT_EQ(narrowed->min(), -7);
+  EXPECT_EQ(narrowed->max(), 13);
+  EXPECT_EQ(
+      bloom->mergeWith(between(600, 700).get())->kind(),
+      FilterKind::kAlwaysFalse);
+}
+
 TEST(FilterTest, mergeWithDouble) {
   std::vector<std::unique_ptr<Filter>> filters;
   addUntypedFilters(filters);
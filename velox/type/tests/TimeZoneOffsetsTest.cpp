@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/external/date/tz.h"
+#include "velox/type/TimeZoneOffsets.h"
+
+namespace facebook::velox {
+namespace {
+
+// Converts through external/date without the transition table.
+Timestamp toTimezoneSlow(Timestamp timestamp, const date::time_zone& zone) {
+  const auto local = zone.to_local(timestamp.toTimePoint());
+  return Timestamp(
+      std::chrono::floor<std::chrono::seconds>(local.time_since_epoch())
+          .count(),
+      timestamp.getNanos());
+}
+
+class TimeZoneOffsetsTest : public testing::Test {
+ protected:
+  void testZone(const std::string& name) {
+    SCOPED_TRACE(name);
+    const auto* zone = date::locate_zone(name);
+    const auto& offsets = TimeZoneOffsets::get(*zone);
+    ASSERT_EQ(&offsets, &TimeZoneOffsets::get(*zone));
+    ASSERT_EQ(&offsets.zone(), zone);
+
+    std::vector<Timestamp> timestamps;
+    // One second around each transition between 1950 and 2037.
+    auto info =
+        zone->get_info(date::sys_seconds(std::chrono::seconds(-631152000)));
+    while (info.end.time_since_epoch().count() < 2'114'380'800) {
+      const auto transition = info.end.time_since_epoch().count();
+      for (auto delta : {-1, 0, 1}) {
+        timestamps.emplace_back(transition + delta, 999'999'999);
+      }
+      info = zone->get_info(info.end);
+    }
+    std::mt19937 rng(1);
+    for (auto i = 0; i < 1'000; ++i) {
+      timestamps.emplace_back(
+          std::uniform_int_distribution<int64_t>(
+              -2'208'988'800, 2'114'380'800)(rng),
+          i);
+    }
+    // Before the start of the table.
+    timestamps.emplace_back(-5'000'000'000, 0);
+    timestamps.emplace_back(-2'208'988'801, 0);
+
+    std::vector<Timestamp> expected;
+    for (const auto& timestamp : timestamps) {
+      expected.push_back(toTimezoneSlow(timestamp, *zone));
+      auto single = timestamp;
+      offsets.toTimezone(single);
+      ASSERT_EQ(expected.back(), single) << timestamp.toString();
+      single = timestamp;
+      single.toTimezone(*zone);
+      ASSERT_EQ(expected.back(), single) << timestamp.toString();
+    }
+    offsets.toTimezone(timestamps.data(), timestamps.size());
+    ASSERT_EQ(expected, timestamps);
+  }
+};
+
+TEST_F(TimeZoneOffsetsTest, toTimezone) {
+  testZone("America/Los_Angeles");
+  testZone("America/Sao_Paulo");
+  testZone("Asia/Kolkata");
+  testZone("Europe/London");
+  testZone("Australia/Lord_Howe");
+  testZone("UTC");
+}
+
+TEST_F(TimeZoneOffsetsTest, outOfRange) {
+  // Zones without repetition rules are covered up to the end of the table
+  // and fall back to external/date after it.
+  const auto* kolkata = date::locate_zone("Asia/Kolkata");
+  const auto& offsets = TimeZoneOffsets::get(*kolkata);
+  EXPECT_EQ(19'800, offsets.offsetSeconds(4'000'000'000));
+  EXPECT_EQ(std::nullopt, offsets.offsetSeconds(4'102'444'800));
+  Timestamp timestamp(5'000'000'000, 0);
+  offsets.toTimezone(timestamp);
+  EXPECT_EQ(Timestamp(5'000'019'800, 0), timestamp);
+
+  // Zones with repetition rules stop at the last materialized transition
+  // and keep failing past it.
+  const auto* losAngeles = date::locate_zone("America/Los_Angeles");
+  EXPECT_EQ(
+      std::nullopt,
+      TimeZoneOffsets::get(*losAngeles).offsetSeconds(32517359891));
+  timestamp = Timestamp(32517359891, 0);
+  VELOX_ASSERT_THROW(
+      TimeZoneOffsets::get(*losAngeles).toTimezone(timestamp),
+      "Unable to convert timezone 'America/Los_Angeles' past");
+}
+
+} // namespace
+} // namespace facebook::velox
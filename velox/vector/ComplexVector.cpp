@@ -1326,6 +1326,7 @@ void MapVector::copyRanges(
     const BaseVector* source,
     const folly::Range<const CopyRange*>& ranges) {
   copyRangesImpl(source, ranges, &values_, &keys_);
+  resetKeyIndex();
 }
 
 namespace {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <type_traits>
 
 #include <folly/container/F14Map.h>
@@ -596,11 +597,35 @@ class MapVector : public ArrayVectorBase {
     return sortedKeys_;
   }
 
+  /// Opaque lookup structure derived from the keys, e.g. a hash table per
+  /// map built by subscript functions. Cached on the vector so that all
+  /// lookups into the same batch share it.
+  class KeyIndex {
+   public:
+    virtual ~KeyIndex() = default;
+  };
+
+  /// Returns the index set by setKeyIndex() or nullptr if there is none or
+  /// the keys may have changed since.
+  std::shared_ptr<KeyIndex> keyIndex() const {
+    std::lock_guard<std::mutex> l(keyIndexMutex_);
+    return keyIndexKeys_ == keys_.get() ? keyIndex_ : nullptr;
+  }
+
+  /// Caches 'index' for the current keys. May be called concurrently by
+  /// threads reading the same vector. The last call wins.
+  void setKeyIndex(std::shared_ptr<KeyIndex> index) const {
+    std::lock_guard<std::mutex> l(keyIndexMutex_);
+    keyIndex_ = std::move(index);
+    keyIndexKeys_ = keys_.get();
+  }
+
   void setKeysAndValues(VectorPtr keys, VectorPtr values) {
     keys_ = BaseVector::getOrCreateEmpty(
         std::move(keys), type()->childAt(0), pool_);
     values_ = BaseVector::getOrCreateEmpty(
         std::move(values), type()->childAt(1), pool_);
+    resetKeyIndex();
   }
 
   void copyRanges(
@@ -676,6 +701,7 @@ class MapVector : public ArrayVectorBase {
   virtual void resetDataDependentFlags(const SelectivityVector* rows) override {
     BaseVector::resetDataDependentFlags(rows);
     sortedKeys_ = false;
+    resetKeyIndex();
   }
 
  private:
@@ -691,9 +717,22 @@ class MapVector : public ArrayVectorBase {
   std::shared_ptr<MapVector> updateImpl(
       const std::vector<std::shared_ptr<MapVector>>& others) const;
 
+  void resetKeyIndex() {
+    std::lock_guard<std::mutex> l(keyIndexMutex_);
+    keyIndex_.reset();
+    keyIndexKeys_ = nullptr;
+  }
+
   VectorPtr keys_;
   VectorPtr values_;
   bool sortedKeys_;
+
+  // Serializes access to 'keyIndex_' by threads reading this vector.
+  mutable std::mutex keyIndexMutex_;
+  mutable std::shared_ptr<KeyIndex> keyIndex_;
+  // The keys 'keyIndex_' was built for. Detects keys replaced via the
+  // non-const mapKeys().
+  mutable const BaseVector* keyIndexKeys_{nullptr};
 };
 
 using RowVectorPtr = std::shared_ptr<RowVector>;
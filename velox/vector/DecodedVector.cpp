@@ -31,6 +31,22 @@ std::vector<vector_size_t> makeConsecutiveIndices(size_t size) {
   }
   return consecutiveIndices;
 }
+
+// Sets 'runs[i]' to the index of the run that covers row 'i' of 'sequence'
+// for the first 'size' rows.
+void expandRuns(
+    const BaseVector& sequence,
+    vector_size_t size,
+    vector_size_t* runs) {
+  auto lengths = sequence.wrapInfo()->as<SequenceLength>();
+  auto numRuns = sequence.valueVector()->size();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns && row < size; ++run) {
+    auto end = std::min<vector_size_t>(row + lengths[run], size);
+    std::fill(runs + row, runs + end, run);
+    row = end;
+  }
+}
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -147,6 +163,12 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // A sequence adds no nulls of its own. Every row maps to its run.
+    copiedIndices_.resize(size_ > 0 ? size_ : 1);
+    expandRuns(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = vector->valueVector().get();
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -181,6 +203,11 @@ void DecodedVector::combineWrappers(
         values = values->valueVector().get();
         break;
       }
+      case VectorEncoding::Simple::SEQUENCE: {
+        applySequenceWrapper(*values, rows);
+        values = values->valueVector().get();
+        break;
+      }
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -226,6 +253,28 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    return;
+  }
+
+  std::vector<vector_size_t> runs(sequenceVector.size());
+  expandRuns(sequenceVector, runs.size(), runs.data());
+  auto currentIndices = indices_;
+  if (indicesNotCopied()) {
+    copiedIndices_.resize(size_);
+    indices_ = copiedIndices_.data();
+  }
+
+  applyToRows(rows, [&](vector_size_t row) {
+    if (!nulls_ || !bits::isBitNull(nulls_, row)) {
+      copiedIndices_[row] = runs[currentIndices[row]];
+    }
+  });
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
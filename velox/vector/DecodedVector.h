@@ -339,6 +339,11 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Maps the current indices through the run lengths of 'sequenceVector'.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices();
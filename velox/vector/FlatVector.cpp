@@ -15,6 +15,7 @@
  */
 
 #include "velox/vector/FlatVector.h"
+#include "velox/buffer/BufferArena.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/ConstantVector.h"
 #include "velox/vector/TypeAliases.h"
@@ -62,9 +63,17 @@ Buffer* FlatVector<StringView>::getBufferWithSpace(
     return buffer;
   }
 
-  // Allocate a new buffer.
+  // Allocate a new buffer. Takes it from the arena of the calling thread if
+  // there is one for the same pool.
   const size_t newSize = exactSize ? size : std::max(kInitialStringSize, size);
-  BufferPtr newBuffer = AlignedBuffer::allocate<char>(newSize, pool());
+  BufferPtr newBuffer;
+  auto* arena = BufferArena::current();
+  if (arena != nullptr && arena->pool() == pool()) {
+    newBuffer = arena->allocate(newSize);
+  }
+  if (newBuffer == nullptr) {
+    newBuffer = AlignedBuffer::allocate<char>(newSize, pool());
+  }
   newBuffer->setSize(0);
   addStringBuffer(newBuffer);
   return newBuffer.get();
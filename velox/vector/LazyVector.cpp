@@ -253,6 +253,7 @@ void LazyVector::load(RowSet rows, ValueHook* hook) const {
   VELOX_CHECK(!allLoaded_, "A LazyVector can be loaded at most once");
 
   allLoaded_ = true;
+  numLoadedRows_ = rows.size();
   if (rows.empty()) {
     vector_ = BaseVector::createNullConstant(type_, size(), pool_);
     return;
@@ -278,6 +279,7 @@ void LazyVector::loadVectorInternal() const {
     }
     SelectivityVector allRows(BaseVector::length_);
     loader_->load(allRows, nullptr, size(), &vector_);
+    numLoadedRows_ = size();
     VELOX_CHECK(vector_);
     if (vector_->encoding() == VectorEncoding::Simple::LAZY) {
       vector_ = vector_->asUnchecked<LazyVector>()->loadedVectorShared();
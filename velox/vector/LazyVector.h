@@ -147,6 +147,7 @@ class LazyVector : public BaseVector {
     BaseVector::length_ = size;
     loader_ = std::move(loader);
     allLoaded_ = false;
+    numLoadedRows_ = 0;
     containsLazyAndIsWrapped_ = false;
     resetNulls();
   }
@@ -155,6 +156,12 @@ class LazyVector : public BaseVector {
     return allLoaded_;
   }
 
+  // Number of rows passed to the loader. Equals size() if all rows were
+  // loaded and is less for selective loads. 0 if not loaded.
+  vector_size_t numLoadedRows() const {
+    return numLoadedRows_;
+  }
+
   // Loads the positions in 'rows' into loadedVector_. If 'hook' is
   // non-nullptr, the hook is instead called on the values and
   // loadedVector is not updated. This method is const because call
@@ -282,6 +289,8 @@ class LazyVector : public BaseVector {
 
   // True if all values are loaded.
   mutable tsan_atomic<bool> allLoaded_{false};
+  // Number of rows requested from 'loader_'. See numLoadedRows().
+  mutable vector_size_t numLoadedRows_{0};
   // Vector to hold loaded values. This may be present before load for
   // reuse. If loading is with ValueHook, this will not be created.
   mutable VectorPtr vector_;
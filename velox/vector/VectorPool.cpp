@@ -47,12 +47,48 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+FOLLY_ALWAYS_INLINE bool isComplexEncoding(const BaseVector& vector) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+    case VectorEncoding::Simple::ROW:
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  for (auto& [cachedType, typePool] : complexVectors_) {
+    if (cachedType == type || *cachedType == *type) {
+      return &typePool;
+    }
+  }
+  if (!add || complexVectors_.size() >= kMaxComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool());
+  return &complexVectors_.back().second;
+}
+
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  ++stats_.numGets;
+  if (size <= kMaxRecycleSize) {
+    TypePool* typePool{nullptr};
+    auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      typePool = &vectors_[cacheIndex];
+    } else if (!complexVectors_.empty() && !type->isPrimitiveType()) {
+      typePool = complexTypePool(type, false);
+    }
+    if (typePool != nullptr && typePool->size > 0) {
+      ++stats_.numReused;
+      return typePool->pop(type, size, *pool_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -66,10 +102,15 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+  if (!isComplexEncoding(*vector) || !vector->isWritable() ||
+      vector->retainedSize() > kMaxComplexRecycleBytes) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto* typePool = complexTypePool(vector->type(), true);
+  return typePool != nullptr && typePool->maybePushBack(vector);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -85,14 +126,23 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 }
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
+  if (size >= kNumPerType) {
+    return false;
+  }
+  if (isComplexEncoding(*vector)) {
+    // The caller checked that the vector is recursively writable. Keeps the
+    // offsets, sizes and children with size 0. pop() grows them to the
+    // requested size.
+    vector->prepareForReuse();
+    vector->resize(0);
+    vectors[size++] = std::move(vector);
+    return true;
+  }
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
   if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
     return false;
   }
-  if (size >= kNumPerType) {
-    return false;
-  }
 
   vector->prepareForReuse();
   vectors[size++] = std::move(vector);
@@ -105,6 +155,11 @@ VectorPtr VectorPool::TypePool::pop(
     memory::MemoryPool& pool) {
   if (size) {
     auto result = std::move(vectors[--size]);
+    if (isComplexEncoding(*result)) {
+      // All rows are new and are set to not null by resize().
+      result->resize(vectorSize);
+      return result;
+    }
     if (UNLIKELY(result->rawNulls() != nullptr)) {
       // This is a recyclable vector, no need to check uniqueness.
       simd::memset(
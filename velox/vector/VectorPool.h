@@ -20,33 +20,50 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
+/// A thread-level cache of pre-allocated vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
+/// recyclable if it is flat, array, map or row encoded and recursively
+/// singly-referenced. Flat vectors are supported for singleton built-in types.
+/// Decimal types, fixed-size array type and custom types are not supported at
+/// the top level. Array, map and row vectors are recycled with their offsets,
+/// sizes and children for up to 8 distinct complex types. Calling 'get' for an
 /// unsupported type already returns a newly allocated vector. Calling 'release'
 /// for an unsupported type is a no-op.
 class VectorPool {
  public:
+  struct Stats {
+    /// Number of calls to get().
+    uint64_t numGets{0};
+    /// Number of calls to get() that returned a recycled vector.
+    uint64_t numReused{0};
+  };
+
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
-  /// Moves vector into 'this' if it is flat, recursively singly referenced and
-  /// there is space. The function returns true if 'vector' is not null and has
-  /// been returned back to this pool, otherwise returns false.
+  /// Moves vector into 'this' if it is recyclable, recursively singly
+  /// referenced and there is space. The function returns true if 'vector' is
+  /// not null and has been returned back to this pool, otherwise returns false.
   bool release(VectorPtr& vector);
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  const Stats& stats() const {
+    return stats_;
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
+  /// Max retained bytes of a recyclable complex vector, which include the
+  /// capacity of its children.
+  static constexpr uint64_t kMaxComplexRecycleBytes = 8 << 20;
   static constexpr int32_t kNumPerType = 10;
+  static constexpr int32_t kMaxComplexTypes = 8;
 
   struct TypePool {
     int32_t size{0};
@@ -65,8 +82,17 @@ class VectorPool {
   static constexpr int32_t kNumCachedVectorTypes =
       static_cast<int32_t>(TypeKind::HUGEINT) + 1;
 
+  /// Returns the cache for complex 'type'. Adds a cache if there is space.
+  /// Returns nullptr if 'type' has no cache.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated array, map and row vectors by type.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
+
+  Stats stats_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -31,7 +31,7 @@ namespace facebook::velox {
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). String views use a variable number of buffers.
 static constexpr size_t kMaxBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
@@ -39,9 +39,14 @@ static constexpr size_t kMaxBuffers{3};
 class VeloxToArrowBridgeHolder {
  public:
   VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+    resizeBuffers(kMaxBuffers);
+  }
+
+  // Sets the number of buffers. Invalidates the pointer returned by
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +63,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +94,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -247,11 +252,12 @@ const char* exportArrowFormatStr(
     case TypeKind::DOUBLE:
       return "g"; // float64
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
-    // format string), which uses 32 bit offsets.
+    // format string), which uses 32 bit offsets, unless string views are
+    // requested.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -548,6 +554,94 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Arrow's view of a string that is longer than StringView::kInlineSize. Views
+// of shorter strings have the same layout as StringView: the size followed by
+// the zero padded characters.
+struct ArrowStringViewRef {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+
+static_assert(sizeof(ArrowStringViewRef) == sizeof(StringView));
+
+// Returns true if 'ref' has the layout of StringView. Garbage sizes of null
+// views that are negative count as not inline.
+inline bool isInlineView(const ArrowStringViewRef& ref) {
+  return static_cast<uint32_t>(ref.size) <= StringView::kInlineSize;
+}
+
+// Imports strings in the utf8_view or binary_view layout. The views of strings
+// up to StringView::kInlineSize bytes have the layout of StringView, so that
+// the views buffer is used as is if there are no longer strings. Otherwise the
+// views are rewritten to point into the data buffers instead of referring to
+// them by index and offset. The data buffers are never copied.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* refs =
+      static_cast<const ArrowStringViewRef*>(arrowArray.buffers[1]);
+
+  bool allInline = true;
+  for (int64_t i = 0; i < length; ++i) {
+    if (!isInlineView(refs[i])) {
+      allInline = false;
+      break;
+    }
+  }
+
+  BufferPtr stringViews;
+  std::vector<BufferPtr> stringViewBuffers;
+  if (allInline) {
+    stringViews =
+        wrapInBufferView(arrowArray.buffers[1], length * sizeof(StringView));
+  } else {
+    stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+    auto* rawStringViews = stringViews->asMutable<StringView>();
+    const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+    for (int64_t i = 0; i < length; ++i) {
+      const auto& ref = refs[i];
+      if (isInlineView(ref)) {
+        memcpy(&rawStringViews[i], &ref, sizeof(StringView));
+      } else if (rawNulls && bits::isBitNull(rawNulls, i)) {
+        rawStringViews[i] = StringView();
+      } else {
+        VELOX_USER_CHECK_LT(ref.bufferIndex, numDataBuffers);
+        const auto* data =
+            static_cast<const char*>(arrowArray.buffers[ref.bufferIndex + 2]);
+        rawStringViews[i] = StringView(data + ref.offset, ref.size);
+      }
+    }
+    const auto* sizes =
+        static_cast<const int64_t*>(arrowArray.buffers[numDataBuffers + 2]);
+    for (int64_t k = 0; k < numDataBuffers; ++k) {
+      stringViewBuffers.emplace_back(
+          wrapInBufferView(arrowArray.buffers[k + 2], sizes[k]));
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +758,87 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings in the utf8_view or binary_view layout. The views point into
+// the string buffers of 'vec', which are shared with the ArrowArray instead of
+// being copied. Strings that are not in a string buffer of 'vec' are copied to
+// an additional buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<StringView>();
+  BufferPtr copied;
+  size_t copiedSize = 0;
+  size_t bufferIndex = 0;
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[j++];
+    if (vec.isNullAt(i)) {
+      view = StringView();
+      return;
+    }
+    const auto value = vec.valueAtFast(i);
+    if (value.isInline()) {
+      view = value;
+      return;
+    }
+    // Consecutive strings are usually in the same buffer.
+    const auto inBuffer = [&](size_t index) {
+      const auto* start = stringBuffers[index]->as<char>();
+      return value.data() >= start &&
+          value.data() + value.size() <= start + stringBuffers[index]->size();
+    };
+    if (bufferIndex >= stringBuffers.size() || !inBuffer(bufferIndex)) {
+      bufferIndex = 0;
+      while (bufferIndex < stringBuffers.size() && !inBuffer(bufferIndex)) {
+        ++bufferIndex;
+      }
+    }
+    ArrowStringViewRef ref;
+    ref.size = value.size();
+    memcpy(ref.prefix, value.data(), sizeof(ref.prefix));
+    if (bufferIndex < stringBuffers.size()) {
+      ref.bufferIndex = bufferIndex;
+      ref.offset = value.data() - stringBuffers[bufferIndex]->as<char>();
+    } else {
+      if (!copied) {
+        copied = AlignedBuffer::allocate<char>(value.size(), pool);
+      } else {
+        AlignedBuffer::reallocate<char>(&copied, copiedSize + value.size());
+      }
+      memcpy(
+          copied->asMutable<char>() + copiedSize, value.data(), value.size());
+      ref.bufferIndex = stringBuffers.size();
+      ref.offset = copiedSize;
+      copiedSize += value.size();
+      VELOX_CHECK_LE(copiedSize, std::numeric_limits<int32_t>::max());
+    }
+    memcpy(&view, &ref, sizeof(view));
+  });
+
+  // Nulls, views, data buffers and the sizes of the data buffers.
+  const size_t numDataBuffers = stringBuffers.size() + (copied ? 1 : 0);
+  holder.resizeBuffers(numDataBuffers + 3);
+  out.buffers = holder.getArrowBuffers();
+  out.n_buffers = numDataBuffers + 3;
+  holder.setBuffer(1, views);
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (size_t k = 0; k < stringBuffers.size(); ++k) {
+    holder.setBuffer(k + 2, stringBuffers[k]);
+    rawSizes[k] = stringBuffers[k]->size();
+  }
+  if (copied) {
+    holder.setBuffer(numDataBuffers + 1, copied);
+    rawSizes[numDataBuffers - 1] = copiedSize;
+  }
+  holder.setBuffer(numDataBuffers + 2, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +863,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -1082,6 +1270,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // String views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1512,11 +1710,12 @@ VectorPtr createVectorFromReeArray(
     auto indices = allocateIndices(arrowArray.length, pool);
     auto rawIndices = indices->asMutable<vector_size_t>();
 
-    size_t cursor = 0;
-    for (size_t i = 0; i < runsArray.length; ++i) {
-      while (cursor < runsBuffer[i]) {
-        rawIndices[cursor++] = i;
-      }
+    int32_t runStart = 0;
+    for (int32_t i = 0; i < runsArray.length; ++i) {
+      VELOX_CHECK_LE(runStart, runsBuffer[i]);
+      VELOX_CHECK_LE(runsBuffer[i], arrowArray.length);
+      std::fill(rawIndices + runStart, rawIndices + runsBuffer[i], i);
+      runStart = runsBuffer[i];
     }
     return BaseVector::wrapInDictionary(
         nullptr, indices, arrowArray.length, values);
@@ -1712,7 +1911,11 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
-  if (type->isVarchar() || type->isVarbinary()) {
+  if ((type->isVarchar() || type->isVarbinary()) &&
+      arrowSchema.format[0] == 'v') {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  } else if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
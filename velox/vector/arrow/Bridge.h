@@ -36,6 +36,9 @@ struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
+  // Export VARCHAR and VARBINARY in the utf8_view and binary_view layouts,
+  // which share the string buffers of the Velox vector instead of copying.
+  bool exportToStringView{false};
 };
 
 namespace facebook::velox {
@@ -564,6 +564,44 @@ TEST_F(ArrowBridgeArrayExportTest, flatString) {
   testFlatVector<std::string>({});
 }
 
+TEST_F(ArrowBridgeArrayExportTest, flatStringView) {
+  auto vec = vectorMaker_.flatVectorNullable<std::string>({
+      "inlined",
+      std::nullopt,
+      "a string that is not inlined",
+      "",
+      "another string that is not inlined",
+  });
+  options_.exportToStringView = true;
+  auto array = toArrow(vec, options_, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(*array->type(), *arrow::utf8_view());
+  EXPECT_EQ(array->null_count(), 1);
+  const auto& views = static_cast<const arrow::StringViewArray&>(*array);
+  auto* flat = vec->asFlatVector<StringView>();
+  for (auto i = 0; i < vec->size(); ++i) {
+    if (vec->isNullAt(i)) {
+      EXPECT_TRUE(views.IsNull(i));
+      continue;
+    }
+    const auto value = flat->valueAt(i);
+    EXPECT_EQ(views.GetView(i), std::string_view(value));
+  }
+  // The string buffers are shared instead of copied.
+  const auto notInlined = flat->valueAt(2);
+  EXPECT_EQ(views.GetView(2).data(), notInlined.data());
+
+  // A subset of the rows of a dictionary.
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr, makeBuffer<vector_size_t>({4, 2}), 2, vec);
+  options_.flattenDictionary = true;
+  array = toArrow(dictionary, options_, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  const auto& flattened = static_cast<const arrow::StringViewArray&>(*array);
+  EXPECT_EQ(flattened.GetView(0), "another string that is not inlined");
+  EXPECT_EQ(flattened.GetView(1), "a string that is not inlined");
+}
+
 TEST_F(ArrowBridgeArrayExportTest, rowVector) {
   std::vector<std::optional<int64_t>> col1 = {1, 2, 3, 4};
   std::vector<std::optional<double>> col2 = {99.9, 88.8, 77.7, std::nullopt};
@@ -1543,6 +1581,74 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     });
   }
 
+  void testImportStringView() {
+    arrow::StringViewBuilder builder;
+    ASSERT_OK(builder.Append("short"));
+    ASSERT_OK(builder.AppendNull());
+    ASSERT_OK(builder.Append("a string that is not inlined"));
+    ASSERT_OK(builder.Append(""));
+    ASSERT_OK(builder.Append("another string that is not inlined"));
+    ASSERT_OK_AND_ASSIGN(auto array, builder.Finish());
+    const auto& views = static_cast<const arrow::StringViewArray&>(*array);
+
+    options_.exportToStringView = true;
+    testArrowRoundTrip(*array, [&](const BaseVector& vec) {
+      ASSERT_EQ(*vec.type(), *VARCHAR());
+      ASSERT_EQ(vec.size(), 5);
+      auto* flat = vec.asFlatVector<StringView>();
+      EXPECT_EQ(flat->valueAt(0), StringView("short"));
+      EXPECT_TRUE(flat->isNullAt(1));
+      EXPECT_EQ(flat->valueAt(3), StringView(""));
+      // Strings that are not inlined point into the Arrow data buffer.
+      for (auto i : {2, 4}) {
+        const auto value = flat->valueAt(i);
+        EXPECT_EQ(value.data(), views.GetView(i).data());
+      }
+    });
+
+    // The views buffer of inlined strings is used as is.
+    arrow::BinaryViewBuilder binaryBuilder;
+    ASSERT_OK(binaryBuilder.Append("a"));
+    ASSERT_OK(binaryBuilder.AppendNull());
+    ASSERT_OK(binaryBuilder.Append("twelve bytes"));
+    ASSERT_OK_AND_ASSIGN(array, binaryBuilder.Finish());
+    testArrowRoundTrip(*array, [&](const BaseVector& vec) {
+      ASSERT_EQ(*vec.type(), *VARBINARY());
+      EXPECT_EQ(
+          vec.values()->as<uint8_t>(), array->data()->buffers[1]->data());
+      EXPECT_EQ(
+          vec.asFlatVector<StringView>()->valueAt(2),
+          StringView("twelve bytes"));
+    });
+    options_.exportToStringView = false;
+  }
+
+  void testImportNestedDictionary() {
+    auto inner = BaseVector::wrapInDictionary(
+        nullptr,
+        makeBuffer<vector_size_t>({2, 1, 0, 2}),
+        4,
+        vectorMaker_.flatVector<std::string>(
+            {"a", "string that is not inlined", "c"}));
+    auto outer = BaseVector::wrapInDictionary(
+        nullptr, makeBuffer<vector_size_t>({3, 0, 0, 1, 2}), 5, inner);
+
+    ArrowSchema schema;
+    ArrowArray data;
+    velox::exportToArrow(outer, schema, options_);
+    velox::exportToArrow(outer, data, pool_.get(), options_);
+    auto imported = importFromArrow(schema, data, pool_.get());
+    ASSERT_EQ(imported->encoding(), VectorEncoding::Simple::DICTIONARY);
+    EXPECT_EQ(
+        imported->valueVector()->encoding(),
+        VectorEncoding::Simple::DICTIONARY);
+    assertEqualVectors(outer, imported);
+    if (isViewer()) {
+      schema.release(&schema);
+      data.release(&data);
+    }
+  }
+
   void testImportREE() {
     testImportREENoRuns();
     testImportREESingleRun();
@@ -1768,6 +1874,14 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, dictionary) {
   testImportDictionary();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, nestedDictionary) {
+  testImportNestedDictionary();
+}
+
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, ree) {
   testImportREE();
 }
@@ -1821,6 +1935,14 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, dictionary) {
   testImportDictionary();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, nestedDictionary) {
+  testImportNestedDictionary();
+}
+
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, ree) {
   testImportREE();
 }
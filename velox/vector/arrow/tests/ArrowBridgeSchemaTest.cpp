@@ -191,6 +191,10 @@ TEST_F(ArrowBridgeSchemaExportTest, scalar) {
 
   testScalarType(VARCHAR(), "u");
   testScalarType(VARBINARY(), "z");
+  options_.exportToStringView = true;
+  testScalarType(VARCHAR(), "vu");
+  testScalarType(VARBINARY(), "vz");
+  options_.exportToStringView = false;
 
   options_.timestampUnit = TimestampUnit::kSecond;
   testScalarType(TIMESTAMP(), "tss:");
@@ -370,6 +374,8 @@ TEST_F(ArrowBridgeSchemaImportTest, scalar) {
   EXPECT_EQ(*VARCHAR(), *testSchemaImport("U"));
   EXPECT_EQ(*VARBINARY(), *testSchemaImport("z"));
   EXPECT_EQ(*VARBINARY(), *testSchemaImport("Z"));
+  EXPECT_EQ(*VARCHAR(), *testSchemaImport("vu"));
+  EXPECT_EQ(*VARBINARY(), *testSchemaImport("vz"));
 
   // Temporal.
   EXPECT_EQ(*TIMESTAMP(), *testSchemaImport("tsn:"));
@@ -674,6 +674,38 @@ TEST_F(DecodedVectorTest, dictionaryOverConstant) {
   testDictionaryOverConstant(arrayVector, 5); // null
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  auto sequence = vectorMaker_.sequenceVector<int64_t>(
+      {1, 1, 1, std::nullopt, 2, 2, 3, 3, 3, 3});
+  auto expected = makeNullableFlatVector<int64_t>(
+      {1, 1, 1, std::nullopt, 2, 2, 3, 3, 3, 3});
+
+  DecodedVector decoded(*sequence);
+  ASSERT_FALSE(decoded.isIdentityMapping());
+  ASSERT_FALSE(decoded.isConstantMapping());
+  ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+  ASSERT_EQ(decoded.base()->size(), 4);
+  for (auto i = 0; i < expected->size(); ++i) {
+    ASSERT_EQ(decoded.isNullAt(i), expected->isNullAt(i)) << i;
+    if (!expected->isNullAt(i)) {
+      ASSERT_EQ(decoded.valueAt<int64_t>(i), expected->valueAt(i)) << i;
+    }
+  }
+
+  // A dictionary over the sequence maps through the runs.
+  auto indices = makeIndices({9, 0, 4, 3, 6});
+  auto dictionary = BaseVector::wrapInDictionary(nullptr, indices, 5, sequence);
+  SelectivityVector rows(5);
+  rows.setValid(1, false);
+  rows.updateBounds();
+  decoded.decode(*dictionary, &rows);
+  ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+  ASSERT_EQ(decoded.index(0), 3);
+  ASSERT_EQ(decoded.index(2), 1);
+  ASSERT_TRUE(decoded.isNullAt(3));
+  ASSERT_EQ(decoded.index(4), 3);
+}
+
 TEST_F(DecodedVectorTest, wrapOnDictionaryEncoding) {
   // This test exercises the use-case of unnesting the children of a rowVector
   // and making sure the wrap over the row vector is correctly applied on its
@@ -151,4 +151,72 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  auto array = makeArrayVector<int64_t>({{1, 2, 3}, {}, {4}});
+  auto map = makeMapVector<int32_t, int32_t>(
+      10,
+      [](auto row) { return row % 3; },
+      [](auto row) { return row; },
+      [](auto row) { return row + 10; },
+      nullEvery(4));
+  auto row = makeRowVector(
+      {makeFlatVector<int32_t>({1, 2}),
+       makeArrayVector<int32_t>({{1}, {2, 3}})});
+  const auto* arrayPtr = array.get();
+  const auto* mapPtr = map.get();
+  const auto* rowPtr = row.get();
+  const auto mapType = map->type();
+  const auto rowType = row->type();
+
+  ASSERT_TRUE(vectorPool.release(array));
+  ASSERT_TRUE(vectorPool.release(map));
+  ASSERT_TRUE(vectorPool.release(row));
+
+  // Recycled vectors have all rows not null and empty arrays and maps.
+  auto recycledArray = vectorPool.get(ARRAY(BIGINT()), 5);
+  ASSERT_EQ(recycledArray.get(), arrayPtr);
+  ASSERT_EQ(recycledArray->size(), 5);
+  auto* arrayVector = recycledArray->as<ArrayVector>();
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_FALSE(arrayVector->isNullAt(i));
+    ASSERT_EQ(arrayVector->sizeAt(i), 0);
+  }
+  ASSERT_EQ(arrayVector->elements()->size(), 0);
+
+  auto recycledMap = vectorPool.get(mapType, 2);
+  ASSERT_EQ(recycledMap.get(), mapPtr);
+  ASSERT_FALSE(recycledMap->isNullAt(0));
+  ASSERT_EQ(recycledMap->as<MapVector>()->sizeAt(0), 0);
+
+  auto recycledRow = vectorPool.get(rowType, 4);
+  ASSERT_EQ(recycledRow.get(), rowPtr);
+  auto* rowVector = recycledRow->as<RowVector>();
+  ASSERT_EQ(rowVector->childAt(0)->size(), 4);
+  ASSERT_EQ(rowVector->childAt(1)->size(), 4);
+  ASSERT_EQ(rowVector->childAt(1)->as<ArrayVector>()->sizeAt(3), 0);
+
+  // Recycled vectors can be written to like new ones.
+  auto* elements = arrayVector->elements()->asFlatVector<int64_t>();
+  elements->resize(2);
+  elements->set(0, 10);
+  elements->set(1, 11);
+  arrayVector->setOffsetAndSize(4, 0, 2);
+  test::assertEqualVectors(
+      makeArrayVector<int64_t>({{}, {}, {}, {}, {10, 11}}), recycledArray);
+
+  // A shared child makes a vector not recyclable.
+  auto shared = makeArrayVector<int64_t>({{1}});
+  auto elementsCopy = shared->as<ArrayVector>()->elements();
+  ASSERT_FALSE(vectorPool.release(shared));
+
+  // A new vector is allocated if there is no recycled one.
+  auto newArray = vectorPool.get(ARRAY(BIGINT()), 5);
+  ASSERT_NE(newArray.get(), arrayPtr);
+
+  ASSERT_EQ(vectorPool.stats().numGets, 4);
+  ASSERT_EQ(vectorPool.stats().numReused, 3);
+}
 } // namespace facebook::velox::test